@@ -11,11 +11,29 @@
 #include "api/audio/audio_frame.h"
 
 #include <string.h>
+#include <algorithm>
+#include <limits>
 
 #include "rtc_base/checks.h"
 #include "rtc_base/timeutils.h"
 
 namespace webrtc {
+namespace {
+
+// Same rounding as FloatS16ToS16() in common_audio/include/audio_util.h, which
+// cannot be used from here.
+int16_t RoundFloatS16(float v) {
+  static const float kMaxRound = std::numeric_limits<int16_t>::max() - 0.5f;
+  static const float kMinRound = std::numeric_limits<int16_t>::min() + 0.5f;
+  if (v > 0) {
+    return v >= kMaxRound ? std::numeric_limits<int16_t>::max()
+                          : static_cast<int16_t>(v + 0.5f);
+  }
+  return v <= kMinRound ? std::numeric_limits<int16_t>::min()
+                        : static_cast<int16_t>(v - 0.5f);
+}
+
+}  // namespace
 
 AudioFrame::AudioFrame() {
   // Visual Studio doesn't like this in the class definition.
@@ -60,6 +78,8 @@ void AudioFrame::UpdateFrame(uint32_t timestamp,
   if (data != nullptr) {
     memcpy(data_, data, sizeof(int16_t) * length);
     muted_ = false;
+    float_data_valid_ = false;
+    data_stale_ = false;
   } else {
     muted_ = true;
   }
@@ -82,7 +102,15 @@ void AudioFrame::CopyFrom(const AudioFrame& src) {
   const size_t length = samples_per_channel_ * num_channels_;
   RTC_CHECK_LE(length, kMaxDataSizeSamples);
   if (!src.muted()) {
-    memcpy(data_, src.data(), sizeof(int16_t) * length);
+    if (src.has_float_data()) {
+      if (!float_data_)
+        float_data_.reset(new float[kMaxDataSizeSamples]);
+      memcpy(float_data_.get(), src.float_data_.get(), sizeof(float) * length);
+    }
+    float_data_valid_ = src.has_float_data();
+    data_stale_ = src.data_stale_;
+    if (!data_stale_)
+      memcpy(data_, src.data_, sizeof(int16_t) * length);
     muted_ = false;
   }
 }
@@ -100,7 +128,11 @@ int64_t AudioFrame::ElapsedProfileTimeMs() const {
 }
 
 const int16_t* AudioFrame::data() const {
-  return muted_ ? empty_data() : data_;
+  if (muted_)
+    return empty_data();
+  if (data_stale_)
+    UpdateDataFromFloat();
+  return data_;
 }
 
 // TODO(henrik.lundin) Can we skip zeroing the buffer?
@@ -109,10 +141,41 @@ int16_t* AudioFrame::mutable_data() {
   if (muted_) {
     memset(data_, 0, kMaxDataSizeBytes);
     muted_ = false;
+  } else if (data_stale_) {
+    UpdateDataFromFloat();
   }
+  data_stale_ = false;
+  float_data_valid_ = false;
   return data_;
 }
 
+bool AudioFrame::has_float_data() const {
+  return !muted_ && float_data_valid_;
+}
+
+const float* AudioFrame::float_data() const {
+  RTC_DCHECK(has_float_data());
+  return float_data_.get();
+}
+
+float* AudioFrame::mutable_float_data() {
+  if (!float_data_)
+    float_data_.reset(new float[kMaxDataSizeSamples]);
+  if (muted_) {
+    // Samples beyond the frame length read through data() must stay zeroed.
+    memset(data_, 0, kMaxDataSizeBytes);
+    std::fill(float_data_.get(), float_data_.get() + kMaxDataSizeSamples, 0.f);
+    muted_ = false;
+  } else if (!float_data_valid_) {
+    const size_t length = samples_per_channel_ * num_channels_;
+    RTC_CHECK_LE(length, kMaxDataSizeSamples);
+    std::copy(data_, data_ + length, float_data_.get());
+  }
+  float_data_valid_ = true;
+  data_stale_ = true;
+  return float_data_.get();
+}
+
 void AudioFrame::Mute() {
   muted_ = true;
 }
@@ -121,6 +184,16 @@ bool AudioFrame::muted() const {
   return muted_;
 }
 
+void AudioFrame::UpdateDataFromFloat() const {
+  RTC_DCHECK(float_data_valid_);
+  const size_t length = samples_per_channel_ * num_channels_;
+  RTC_CHECK_LE(length, kMaxDataSizeSamples);
+  for (size_t i = 0; i < length; ++i) {
+    data_[i] = RoundFloatS16(float_data_[i]);
+  }
+  data_stale_ = false;
+}
+
 // static
 const int16_t* AudioFrame::empty_data() {
   static int16_t* null_data = new int16_t[kMaxDataSizeSamples]();
@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <memory>
 
 #include "rtc_base/constructormagic.h"
 
@@ -90,6 +91,22 @@ class AudioFrame {
   const int16_t* data() const;
   int16_t* mutable_data();
 
+  // Frames can also carry their samples in FloatS16 format, i.e. as floats in
+  // the int16 range. Producers and consumers that work in float can then pass
+  // samples without rounding them to int16 in between. data() rounds the
+  // float samples to int16 on first use after they have been written, and
+  // writing through mutable_data() drops them.
+  //
+  // has_float_data() returns true if the frame is not muted and carries float
+  // samples, which float_data() then returns.
+  bool has_float_data() const;
+  const float* float_data() const;
+  // Returns a buffer of kMaxDataSizeSamples floats and makes it the primary
+  // representation of the samples. If the frame does not carry float samples
+  // yet, the buffer is first filled with the current samples, or zeros if the
+  // frame is muted, and the frame is marked unmuted.
+  float* mutable_float_data();
+
   // Prefer to mute frames using AudioFrameOperations::Mute.
   void Mute();
   // Frame is muted by default.
@@ -121,8 +138,18 @@ class AudioFrame {
   // buffer per translation unit is to wrap a static in an inline function.
   static const int16_t* empty_data();
 
-  int16_t data_[kMaxDataSizeSamples];
+  // Rounds the float samples into |data_|.
+  void UpdateDataFromFloat() const;
+
+  // Refreshed from |float_data_| in const data() when stale.
+  mutable int16_t data_[kMaxDataSizeSamples];
   bool muted_ = true;
+  // Allocated on the first call to mutable_float_data().
+  std::unique_ptr<float[]> float_data_;
+  // True if |float_data_| holds the current samples.
+  bool float_data_valid_ = false;
+  // True if |data_| is behind |float_data_|.
+  mutable bool data_stale_ = false;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioFrame);
 };
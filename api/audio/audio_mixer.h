@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "api/audio/audio_frame.h"
 #include "rtc_base/refcount.h"
 
@@ -48,6 +49,20 @@ class AudioMixer : public rtc::RefCountInterface {
     // with this sample rate or higher will not cause quality loss.
     virtual int PreferredSampleRate() const = 0;
 
+    // Level of the audio the source receives, in -dBov (0 is the loudest and
+    // 127 is silence) as in the RFC 6464 audio level RTP header extension.
+    // Unlike the audio returned by GetAudioFrameWithInfo(), it is known
+    // without decoding. Returns nullopt if the level is unknown, in which case
+    // SetAudioNeeded(false) is never called.
+    virtual absl::optional<int> ReceivedAudioLevel() const {
+      return absl::nullopt;
+    }
+
+    // A mixer that doesn't mix the source for a while may tell it that its
+    // audio isn't needed. GetAudioFrameWithInfo() is then not called until
+    // the audio is needed again, so the source may stop decoding meanwhile.
+    virtual void SetAudioNeeded(bool needed) {}
+
     virtual ~Source() {}
   };
 
@@ -111,4 +111,68 @@ TEST(AudioFrameTest, CopyFrom) {
   EXPECT_EQ(0, memcmp(frame2.data(), frame1.data(), sizeof(samples)));
 }
 
+TEST(AudioFrameTest, MutedFrameFloatBufferIsZeroed) {
+  AudioFrame frame;
+  EXPECT_FALSE(frame.has_float_data());
+  const float* float_data = frame.mutable_float_data();
+  EXPECT_FALSE(frame.muted());
+  EXPECT_TRUE(frame.has_float_data());
+  for (size_t i = 0; i < AudioFrame::kMaxDataSizeSamples; i++) {
+    EXPECT_EQ(0.f, float_data[i]);
+  }
+  EXPECT_TRUE(AllSamplesAre(0, frame));
+  frame.Mute();
+  EXPECT_FALSE(frame.has_float_data());
+}
+
+TEST(AudioFrameTest, FloatDataIsRoundedToInt16) {
+  AudioFrame frame;
+  int16_t samples[kNumChannels * kSamplesPerChannel] = {17, -3};
+  frame.UpdateFrame(kTimestamp, samples, kSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kPLC, AudioFrame::kVadActive, kNumChannels);
+  float* float_data = frame.mutable_float_data();
+  // The float buffer starts with the current samples.
+  EXPECT_EQ(17.f, float_data[0]);
+  EXPECT_EQ(-3.f, float_data[1]);
+
+  float_data[0] = 1.4f;
+  float_data[1] = -1.6f;
+  float_data[2] = 40000.f;
+  float_data[3] = -40000.f;
+  EXPECT_EQ(1, frame.data()[0]);
+  EXPECT_EQ(-2, frame.data()[1]);
+  EXPECT_EQ(32767, frame.data()[2]);
+  EXPECT_EQ(-32768, frame.data()[3]);
+  EXPECT_TRUE(frame.has_float_data());
+  EXPECT_EQ(1.4f, frame.float_data()[0]);
+}
+
+TEST(AudioFrameTest, MutableDataDropsFloatData) {
+  AudioFrame frame;
+  frame.UpdateFrame(kTimestamp, nullptr /* data */, kSamplesPerChannel,
+                    kSampleRateHz, AudioFrame::kPLC, AudioFrame::kVadActive,
+                    kNumChannels);
+  frame.mutable_float_data()[0] = 2.6f;
+  int16_t* frame_data = frame.mutable_data();
+  EXPECT_FALSE(frame.has_float_data());
+  EXPECT_EQ(3, frame_data[0]);
+  frame_data[0] = 5;
+  EXPECT_EQ(5.f, frame.mutable_float_data()[0]);
+}
+
+TEST(AudioFrameTest, CopyFromFloatData) {
+  AudioFrame frame1;
+  AudioFrame frame2;
+  frame2.UpdateFrame(kTimestamp, nullptr /* data */, kSamplesPerChannel,
+                     kSampleRateHz, AudioFrame::kPLC, AudioFrame::kVadActive,
+                     kNumChannels);
+  frame2.mutable_float_data()[0] = -7.25f;
+  frame1.CopyFrom(frame2);
+
+  EXPECT_FALSE(frame1.muted());
+  ASSERT_TRUE(frame1.has_float_data());
+  EXPECT_EQ(-7.25f, frame1.float_data()[0]);
+  EXPECT_EQ(-7, frame1.data()[0]);
+}
+
 }  // namespace webrtc
@@ -57,6 +57,11 @@ void AudioDecoderOpus::AppendSupportedDecoders(
 std::unique_ptr<AudioDecoder> AudioDecoderOpus::MakeAudioDecoder(
     Config config,
     absl::optional<AudioCodecPairId> /*codec_pair_id*/) {
+  if (config.num_channels > 2) {
+    return absl::make_unique<AudioDecoderOpusImpl>(
+        config.num_channels, config.num_streams, config.coupled_streams,
+        config.channel_mapping);
+  }
   return absl::make_unique<AudioDecoderOpusImpl>(config.num_channels);
 }
 
@@ -27,6 +27,11 @@ namespace webrtc {
 struct RTC_EXPORT AudioDecoderOpus {
   struct Config {
     int num_channels;
+    // For more than two channels, the layout of the multistream packets; see
+    // AudioEncoderOpusConfig. Unused for mono and stereo.
+    int num_streams = 1;
+    int coupled_streams = 0;
+    std::vector<unsigned char> channel_mapping;
   };
   static absl::optional<Config> SdpToConfig(const SdpAudioFormat& audio_format);
   static void AppendSupportedDecoders(std::vector<AudioCodecSpec>* specs);
@@ -34,6 +34,8 @@ constexpr int AudioEncoderOpusConfig::kMaxBitrateBps;
 AudioEncoderOpusConfig::AudioEncoderOpusConfig()
     : frame_size_ms(kDefaultFrameSizeMs),
       num_channels(1),
+      num_streams(1),
+      coupled_streams(0),
       application(ApplicationMode::kVoip),
       bitrate_bps(32000),
       fec_enabled(false),
@@ -55,8 +57,19 @@ AudioEncoderOpusConfig& AudioEncoderOpusConfig::operator=(
 bool AudioEncoderOpusConfig::IsOk() const {
   if (frame_size_ms <= 0 || frame_size_ms % 10 != 0)
     return false;
-  if (num_channels != 1 && num_channels != 2)
+  if (num_channels == 0 || num_channels > 255)
     return false;
+  if (num_channels > 2) {
+    if (num_streams < 1 || coupled_streams < 0 ||
+        coupled_streams > num_streams || num_streams + coupled_streams > 255)
+      return false;
+    if (channel_mapping.size() != num_channels)
+      return false;
+    for (unsigned char channel : channel_mapping) {
+      if (channel != 255 && channel >= num_streams + coupled_streams)
+        return false;
+    }
+  }
   if (!bitrate_bps)
     return false;
   if (*bitrate_bps < kMinBitrateBps || *bitrate_bps > kMaxBitrateBps)
@@ -37,6 +37,16 @@ struct RTC_EXPORT AudioEncoderOpusConfig {
 
   int frame_size_ms;
   size_t num_channels;
+
+  // For more than two channels, the audio is coded as |num_streams| Opus
+  // streams in each packet, of which the first |coupled_streams| are stereo.
+  // Input channel i goes to decoded channel |channel_mapping[i]|, where the
+  // channels of the coupled streams come first, and 255 drops the channel
+  // (RFC 7845 section 5.1.1). Unused for mono and stereo.
+  int num_streams;
+  int coupled_streams;
+  std::vector<unsigned char> channel_mapping;
+
   enum class ApplicationMode { kVoip, kAudio };
   ApplicationMode application;
 
@@ -34,6 +34,9 @@ struct BitrateAllocationUpdate {
   TimeDelta round_trip_time = TimeDelta::PlusInfinity();
   // |bwe_period| is deprecated, use the link capacity allocation instead.
   TimeDelta bwe_period = TimeDelta::PlusInfinity();
+  // The fraction of frames that should be dropped before encoding because the
+  // congestion window or the pacer queue is full.
+  double cwnd_reduce_ratio = 0;
 };
 
 }  // namespace webrtc
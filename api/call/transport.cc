@@ -20,4 +20,9 @@ PacketOptions::PacketOptions(const PacketOptions&) = default;
 
 PacketOptions::~PacketOptions() = default;
 
+bool Transport::SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                              const PacketOptions& options) {
+  return SendRtp(packet.cdata(), packet.size(), options);
+}
+
 }  // namespace webrtc
@@ -15,6 +15,8 @@
 #include <stdint.h>
 #include <vector>
 
+#include "rtc_base/copyonwritebuffer.h"
+
 namespace webrtc {
 
 // TODO(holmer): Look into unifying this with the PacketOptions in
@@ -41,6 +43,11 @@ class Transport {
   virtual bool SendRtp(const uint8_t* packet,
                        size_t length,
                        const PacketOptions& options) = 0;
+  // Same as SendRtp(), but hands over a reference to the packet buffer so that
+  // the transport can keep it and e.g. apply SRTP in place instead of copying
+  // the packet. The default implementation forwards to SendRtp().
+  virtual bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                             const PacketOptions& options);
   virtual bool SendRtcp(const uint8_t* packet, size_t length) = 0;
 
  protected:
@@ -108,6 +108,7 @@
 #include "rtc_base/bitrateallocationstrategy.h"
 #include "rtc_base/network.h"
 #include "rtc_base/platform_file.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/rtccertificate.h"
 #include "rtc_base/rtccertificategenerator.h"
 #include "rtc_base/socketaddress.h"
@@ -1248,6 +1249,10 @@ struct PeerConnectionFactoryDependencies final {
   std::unique_ptr<FecControllerFactoryInterface> fec_controller_factory;
   std::unique_ptr<NetworkControllerFactoryInterface> network_controller_factory;
   std::unique_ptr<MediaTransportFactory> media_transport_factory;
+  // If set, replaces the process-wide placement policy for the threads WebRTC
+  // starts, including the network and worker threads of the factory. See
+  // rtc::SetThreadPlacementPolicy().
+  std::unique_ptr<rtc::ThreadPlacementPolicy> thread_placement_policy;
 };
 
 // PeerConnectionFactoryInterface is the factory interface used for creating
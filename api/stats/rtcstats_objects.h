@@ -449,6 +449,47 @@ class RTC_EXPORT RTCTransportStats final : public RTCStats {
   RTCStatsMember<std::string> remote_certificate_id;
 };
 
+// Non-standard. Load of one of the threads of a peer connection, counted
+// since the thread started. Times are in seconds.
+class RTC_EXPORT RTCThreadStats final : public RTCStats {
+ public:
+  WEBRTC_RTCSTATS_DECL();
+
+  RTCThreadStats(const std::string& id, int64_t timestamp_us);
+  RTCThreadStats(std::string&& id, int64_t timestamp_us);
+  RTCThreadStats(const RTCThreadStats& other);
+  ~RTCThreadStats() override;
+
+  // "signaling", "worker" or "network".
+  RTCStatsMember<std::string> name;
+  RTCStatsMember<uint64_t> tasks_run;
+  RTCStatsMember<double> total_busy_time;
+  RTCStatsMember<double> total_queue_wait_time;
+  RTCStatsMember<double> max_task_duration;
+};
+
+// Non-standard. Timeline of the setup of a peer connection. Each member is the
+// time, in seconds since the peer connection was created, at which a stage of
+// the setup was first reached, and is undefined until then.
+class RTC_EXPORT RTCCallSetupStats final : public RTCStats {
+ public:
+  WEBRTC_RTCSTATS_DECL();
+
+  RTCCallSetupStats(const std::string& id, int64_t timestamp_us);
+  RTCCallSetupStats(std::string&& id, int64_t timestamp_us);
+  RTCCallSetupStats(const RTCCallSetupStats& other);
+  ~RTCCallSetupStats() override;
+
+  RTCStatsMember<double> create_offer_time;
+  RTCStatsMember<double> create_answer_time;
+  RTCStatsMember<double> set_local_description_time;
+  RTCStatsMember<double> set_remote_description_time;
+  RTCStatsMember<double> ice_gathering_complete_time;
+  RTCStatsMember<double> ice_connected_time;
+  // ICE and DTLS are connected, so SRTP keys are set up.
+  RTCStatsMember<double> connected_time;
+};
+
 }  // namespace webrtc
 
 #endif  // API_STATS_RTCSTATS_OBJECTS_H_
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_STATS_RTCSTATSBINARYWRITER_H_
+#define API_STATS_RTCSTATSBINARYWRITER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "api/stats/rtcstats.h"
+#include "api/stats/rtcstatsreport.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Writes a stream of |RTCStatsReport|s in a compact binary encoding, an
+// alternative to |RTCStatsReport::ToJson| for exporting stats in bulk. Every
+// string (stats types and ids, member names and string values) is interned:
+// it is written once in the stream and referred to by index after that, so a
+// stream of reports of the same session mostly consists of numbers.
+//
+// Each call to |WriteReport| appends a chunk. A reader must read the chunks
+// of a stream in order, since later chunks refer to strings of earlier ones.
+// Integers are written as base 128 varints, least significant group first;
+// signed integers are zigzag encoded first. A chunk consists of:
+//   signed   report timestamp in microseconds
+//   unsigned number of new strings, followed by each new string as
+//     unsigned length, bytes
+//     The new strings are given the next indices, starting at 0.
+//   unsigned number of stats objects, followed by each stats object as
+//     unsigned string index of the type
+//     unsigned string index of the id
+//     signed   stats timestamp minus report timestamp
+//     unsigned number of defined members, followed by each member as
+//       unsigned string index of the name
+//       one byte |RTCStatsMemberInterface::Type|
+//       value
+// Values are written as: bool as one byte, 0 or 1; int32 and int64 as signed;
+// uint32 and uint64 as unsigned; double as 8 bytes of IEEE 754, little endian;
+// string as unsigned string index; sequences as unsigned number of elements,
+// followed by each element.
+class RTC_EXPORT RTCStatsBinaryWriter {
+ public:
+  RTCStatsBinaryWriter();
+  ~RTCStatsBinaryWriter();
+
+  // Appends the chunk of |report| to |output|.
+  void WriteReport(const RTCStatsReport& report, std::string* output);
+
+  // The number of strings interned so far.
+  size_t num_strings() const { return strings_.size(); }
+
+ private:
+  void WriteStats(const RTCStats& stats, int64_t report_timestamp_us);
+  void WriteMember(const RTCStatsMemberInterface& member);
+  void WriteString(const std::string& value);
+
+  // The index of each interned string. The strings added by the chunk being
+  // written are collected in |new_strings_|, to be written ahead of the stats.
+  std::map<std::string, uint64_t> strings_;
+  std::vector<const std::string*> new_strings_;
+  // The encoded stats of the chunk being written.
+  std::string body_;
+};
+
+}  // namespace webrtc
+
+#endif  // API_STATS_RTCSTATSBINARYWRITER_H_
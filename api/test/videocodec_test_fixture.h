@@ -129,6 +129,10 @@ class VideoCodecTestFixture {
     // Print out frame level stats.
     bool print_frame_level_stats = false;
 
+    // If set, frame level stats are also written to this file as CSV, for
+    // processing by scripts.
+    std::string frame_stats_csv_path;
+
     // Should video be saved persistently to disk for post-run visualization?
     struct VisualizationParams {
       bool save_encoded_ivf = false;
@@ -185,6 +185,10 @@ struct TargetTransferRate {
   // The estimate on which the target rate is based on.
   NetworkEstimate network_estimate;
   DataRate target_rate = DataRate::Zero();
+  // The fraction of |target_rate| that congestion pushback asks the encoder to
+  // skip by dropping frames, rather than by encoding at a lower rate. Zero
+  // unless pushback is applied by dropping frames.
+  double cwnd_reduce_ratio = 0;
 };
 
 // Contains updates of network controller comand state. Using optionals to
@@ -0,0 +1,33 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_ENCODED_FRAME_SINK_INTERFACE_H_
+#define API_VIDEO_ENCODED_FRAME_SINK_INTERFACE_H_
+
+#include "api/video/encoded_frame.h"
+
+namespace webrtc {
+
+// Receives complete, decodable encoded frames as they leave the jitter buffer
+// of a video receive stream, e.g. to forward them to another send stream
+// without decoding and re-encoding them.
+// NOTE: This class is still under development and may change without notice.
+class EncodedFrameSinkInterface {
+ public:
+  virtual ~EncodedFrameSinkInterface() = default;
+
+  // Called on the decoder thread of the receive stream. The frame is only
+  // valid for the duration of the call.
+  virtual void OnEncodedFrame(const video_coding::EncodedFrame& frame) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_ENCODED_FRAME_SINK_INTERFACE_H_
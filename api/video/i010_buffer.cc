@@ -148,6 +148,9 @@ rtc::scoped_refptr<I010Buffer> I010Buffer::Rotate(
 }
 
 rtc::scoped_refptr<I420BufferInterface> I010Buffer::ToI420() {
+  rtc::CritScope lock(&crit_);
+  if (i420_buffer_)
+    return i420_buffer_;
   rtc::scoped_refptr<I420Buffer> i420_buffer =
       I420Buffer::Create(width(), height());
   libyuv::I010ToI420(DataY(), StrideY(), DataU(), StrideU(), DataV(), StrideV(),
@@ -155,7 +158,8 @@ rtc::scoped_refptr<I420BufferInterface> I010Buffer::ToI420() {
                      i420_buffer->MutableDataU(), i420_buffer->StrideU(),
                      i420_buffer->MutableDataV(), i420_buffer->StrideV(),
                      width(), height());
-  return i420_buffer;
+  i420_buffer_ = i420_buffer;
+  return i420_buffer_;
 }
 
 int I010Buffer::width() const {
@@ -16,8 +16,10 @@
 
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/memory/aligned_malloc.h"
 #include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -37,7 +39,9 @@ class I010Buffer : public I010BufferInterface {
   static rtc::scoped_refptr<I010Buffer> Rotate(const I010BufferInterface& src,
                                                VideoRotation rotation);
 
-  // VideoFrameBuffer implementation.
+  // VideoFrameBuffer implementation. The conversion is made once and shared
+  // by all callers, e.g. all sinks of a broadcast frame, so the pixel data
+  // must not be modified after the first call.
   rtc::scoped_refptr<I420BufferInterface> ToI420() override;
 
   // PlanarYuv16BBuffer implementation.
@@ -82,6 +86,8 @@ class I010Buffer : public I010BufferInterface {
   const int stride_u_;
   const int stride_v_;
   const std::unique_ptr<uint16_t, AlignedFreeDeleter> data_;
+  rtc::CriticalSection crit_;
+  rtc::scoped_refptr<I420BufferInterface> i420_buffer_ RTC_GUARDED_BY(crit_);
 };
 
 }  // namespace webrtc
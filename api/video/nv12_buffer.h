@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_NV12_BUFFER_H_
+#define API_VIDEO_NV12_BUFFER_H_
+
+#include <stdint.h>
+#include <memory>
+
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/memory/aligned_malloc.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Plain NV12 buffer in standard memory.
+class NV12Buffer : public NV12BufferInterface {
+ public:
+  // Create a new buffer.
+  static rtc::scoped_refptr<NV12Buffer> Create(int width, int height);
+  static rtc::scoped_refptr<NV12Buffer> Create(int width,
+                                               int height,
+                                               int stride_y,
+                                               int stride_uv);
+
+  // Create a new buffer and copy the pixel data.
+  static rtc::scoped_refptr<NV12Buffer> Copy(const NV12BufferInterface& buffer);
+
+  // Convert and put I420 buffer into a new buffer.
+  static rtc::scoped_refptr<NV12Buffer> Copy(const I420BufferInterface& buffer);
+
+  // VideoFrameBuffer implementation. The conversion is made once and shared
+  // by all callers, e.g. all sinks of a broadcast frame, so the pixel data
+  // must not be modified after the first call.
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+  // BiplanarYuv8Buffer implementation.
+  int width() const override;
+  int height() const override;
+  const uint8_t* DataY() const override;
+  const uint8_t* DataUV() const override;
+  int StrideY() const override;
+  int StrideUV() const override;
+
+  uint8_t* MutableDataY();
+  uint8_t* MutableDataUV();
+
+ protected:
+  NV12Buffer(int width, int height, int stride_y, int stride_uv);
+  ~NV12Buffer() override;
+
+ private:
+  const int width_;
+  const int height_;
+  const int stride_y_;
+  const int stride_uv_;
+  const std::unique_ptr<uint8_t, AlignedFreeDeleter> data_;
+  rtc::CriticalSection crit_;
+  rtc::scoped_refptr<I420BufferInterface> i420_buffer_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_NV12_BUFFER_H_
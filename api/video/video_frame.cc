@@ -10,6 +10,8 @@
 
 #include "api/video/video_frame.h"
 
+#include <algorithm>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/timeutils.h"
 
@@ -21,7 +23,7 @@ VideoFrame::Builder::~Builder() = default;
 
 VideoFrame VideoFrame::Builder::build() {
   return VideoFrame(video_frame_buffer_, timestamp_us_, timestamp_rtp_,
-                    ntp_time_ms_, rotation_, color_space_);
+                    ntp_time_ms_, rotation_, color_space_, update_rect_);
 }
 
 VideoFrame::Builder& VideoFrame::Builder::set_video_frame_buffer(
@@ -71,6 +73,33 @@ VideoFrame::Builder& VideoFrame::Builder::set_color_space(
   return *this;
 }
 
+VideoFrame::Builder& VideoFrame::Builder::set_update_rect(
+    const UpdateRect& update_rect) {
+  update_rect_ = update_rect;
+  return *this;
+}
+
+void VideoFrame::UpdateRect::Union(const UpdateRect& other) {
+  if (other.IsEmpty())
+    return;
+  if (IsEmpty()) {
+    *this = other;
+    return;
+  }
+  const int right = std::max(offset_x + width, other.offset_x + other.width);
+  const int bottom =
+      std::max(offset_y + height, other.offset_y + other.height);
+  offset_x = std::min(offset_x, other.offset_x);
+  offset_y = std::min(offset_y, other.offset_y);
+  width = right - offset_x;
+  height = bottom - offset_y;
+}
+
+bool VideoFrame::UpdateRect::operator==(const UpdateRect& other) const {
+  return offset_x == other.offset_x && offset_y == other.offset_y &&
+         width == other.width && height == other.height;
+}
+
 VideoFrame::VideoFrame(const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
                        webrtc::VideoRotation rotation,
                        int64_t timestamp_us)
@@ -97,13 +126,15 @@ VideoFrame::VideoFrame(const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
                        uint32_t timestamp_rtp,
                        int64_t ntp_time_ms,
                        VideoRotation rotation,
-                       const absl::optional<ColorSpace>& color_space)
+                       const absl::optional<ColorSpace>& color_space,
+                       const absl::optional<UpdateRect>& update_rect)
     : video_frame_buffer_(buffer),
       timestamp_rtp_(timestamp_rtp),
       ntp_time_ms_(ntp_time_ms),
       timestamp_us_(timestamp_us),
       rotation_(rotation),
-      color_space_(color_space) {}
+      color_space_(color_space),
+      update_rect_(update_rect) {}
 
 VideoFrame::~VideoFrame() = default;
 
@@ -25,6 +25,21 @@ namespace webrtc {
 
 class RTC_EXPORT VideoFrame {
  public:
+  // Region of the frame, in pixels, that has changed since the previous frame
+  // from the same source. Used by screen capture, where most of the frame is
+  // typically static.
+  struct RTC_EXPORT UpdateRect {
+    int offset_x;
+    int offset_y;
+    int width;
+    int height;
+
+    // Extends this rectangle to the bounding box of both rectangles.
+    void Union(const UpdateRect& other);
+    bool IsEmpty() const { return width <= 0 || height <= 0; }
+    bool operator==(const UpdateRect& other) const;
+  };
+
   // Preferred way of building VideoFrame objects.
   class Builder {
    public:
@@ -41,6 +56,7 @@ class RTC_EXPORT VideoFrame {
     Builder& set_rotation(VideoRotation rotation);
     Builder& set_color_space(const ColorSpace& color_space);
     Builder& set_color_space(const ColorSpace* color_space);
+    Builder& set_update_rect(const UpdateRect& update_rect);
 
    private:
     rtc::scoped_refptr<webrtc::VideoFrameBuffer> video_frame_buffer_;
@@ -49,6 +65,7 @@ class RTC_EXPORT VideoFrame {
     int64_t ntp_time_ms_ = 0;
     VideoRotation rotation_ = kVideoRotation_0;
     absl::optional<ColorSpace> color_space_;
+    absl::optional<UpdateRect> update_rect_;
   };
 
   // To be deprecated. Migrate all use to Builder.
@@ -123,6 +140,13 @@ class RTC_EXPORT VideoFrame {
         color_space ? absl::make_optional(*color_space) : absl::nullopt;
   }
 
+  // The part of the frame that changed since the previous frame, or nullopt
+  // if unknown, in which case the whole frame must be assumed to have changed.
+  const absl::optional<UpdateRect>& update_rect() const { return update_rect_; }
+  void set_update_rect(const absl::optional<UpdateRect>& update_rect) {
+    update_rect_ = update_rect;
+  }
+
   // Get render time in milliseconds.
   // TODO(nisse): Deprecated. Migrate all users to timestamp_us().
   int64_t render_time_ms() const;
@@ -143,7 +167,8 @@ class RTC_EXPORT VideoFrame {
              uint32_t timestamp_rtp,
              int64_t ntp_time_ms,
              VideoRotation rotation,
-             const absl::optional<ColorSpace>& color_space);
+             const absl::optional<ColorSpace>& color_space,
+             const absl::optional<UpdateRect>& update_rect);
 
   // An opaque reference counted handle that stores the pixel data.
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> video_frame_buffer_;
@@ -152,6 +177,7 @@ class RTC_EXPORT VideoFrame {
   int64_t timestamp_us_;
   VideoRotation rotation_;
   absl::optional<ColorSpace> color_space_;
+  absl::optional<UpdateRect> update_rect_;
 };
 
 }  // namespace webrtc
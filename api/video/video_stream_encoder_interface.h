@@ -78,11 +78,17 @@ class VideoStreamEncoderInterface : public rtc::VideoSinkInterface<VideoFrame> {
   // Request a key frame. Used for signalling from the remote receiver.
   virtual void SendKeyFrame() = 0;
 
+  // Request a key frame for a single simulcast stream. Encoders that can not
+  // produce key frames per stream will send one on all of them.
+  virtual void SendKeyFrameForStream(size_t stream_index) = 0;
+
   // Set the currently estimated network properties. A |bitrate_bps|
-  // of zero pauses the encoder.
+  // of zero pauses the encoder. |cwnd_reduce_ratio| is the fraction of frames
+  // that should be dropped because the congestion window is full.
   virtual void OnBitrateUpdated(uint32_t bitrate_bps,
                                 uint8_t fraction_lost,
-                                int64_t round_trip_time_ms) = 0;
+                                int64_t round_trip_time_ms,
+                                double cwnd_reduce_ratio) = 0;
 
   // Register observer for the bitrate allocation between the temporal
   // and spatial layers.
@@ -95,6 +101,11 @@ class VideoStreamEncoderInterface : public rtc::VideoSinkInterface<VideoFrame> {
   virtual void ConfigureEncoder(VideoEncoderConfig config,
                                 size_t max_data_payload_length) = 0;
 
+  // Activates or suspends the simulcast layers of the current configuration,
+  // without reinitializing the encoder. Suspended layers get no bitrate, and
+  // are not encoded.
+  virtual void UpdateActiveLayers(const std::vector<bool>& active_layers) = 0;
+
   // Permanently stop encoding. After this method has returned, it is
   // guaranteed that no encoded frames will be delivered to the sink.
   virtual void Stop() = 0;
@@ -60,6 +60,24 @@ class VideoStreamEncoderObserver : public CpuOveruseMetricsObserver {
     kMediaOptimization
   };
 
+  // Time an encoded frame spent in each stage of VideoStreamEncoder, in
+  // microseconds.
+  struct FrameEncodeTimeline {
+    // From capture until the frame was delivered to VideoStreamEncoder.
+    int64_t capture_to_incoming_us = 0;
+    // Waiting on the encoder task queue.
+    int64_t encoder_queue_us = 0;
+    // From leaving the encoder queue until the frame was passed to the
+    // encoder. Includes frame drop decisions, reconfiguration, cropping and
+    // time held as pending frame while the encoder was paused.
+    int64_t pre_encode_us = 0;
+    // From passing the frame to the encoder until the encoded image callback.
+    int64_t encode_us = 0;
+    // Time spent in the encoded image sink, i.e. packetization and insertion
+    // into the pacer queue.
+    int64_t packetize_us = 0;
+  };
+
   ~VideoStreamEncoderObserver() override = default;
 
   virtual void OnIncomingFrame(int width, int height) = 0;
@@ -69,6 +87,15 @@ class VideoStreamEncoderObserver : public CpuOveruseMetricsObserver {
   virtual void OnSendEncodedImage(const EncodedImage& encoded_image,
                                   const CodecSpecificInfo* codec_info) = 0;
 
+  // Called once per encoded image, after it has been delivered to the sink.
+  virtual void OnFrameEncodeTimeline(const FrameEncodeTimeline& timeline) = 0;
+
+  // Thread CPU time spent on a frame in the encoder, and in packetization
+  // including FEC. Packetization is not part of |encode_cpu_time_us|. Time
+  // spent on threads owned by the encoder implementation is not included.
+  virtual void OnEncodeCpuTimeMeasured(int64_t encode_cpu_time_us) {}
+  virtual void OnPacketizeCpuTimeMeasured(int64_t packetize_cpu_time_us) {}
+
   virtual void OnEncoderImplementationChanged(
       const std::string& implementation_name) = 0;
 
@@ -33,6 +33,7 @@
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "rtc_base/fakeclock.h"
 #include "rtc_base/scoped_ref_ptr.h"
+#include "system_wrappers/include/metrics.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -245,6 +246,30 @@ TEST_F(VideoEncoderSoftwareFallbackWrapperTest, InitializesEncoder) {
   EXPECT_EQ(1, fake_encoder_->init_encode_count_);
 }
 
+TEST_F(VideoEncoderSoftwareFallbackWrapperTest, CountsHardwareSessions) {
+  const int sessions = GetActiveHardwareEncoderSessions();
+  VideoCodec codec = {};
+  fallback_wrapper_->InitEncode(&codec, 2, kMaxPayloadSize);
+  EXPECT_EQ(sessions + 1, GetActiveHardwareEncoderSessions());
+  // Initializing again keeps the same session.
+  fallback_wrapper_->InitEncode(&codec, 2, kMaxPayloadSize);
+  EXPECT_EQ(sessions + 1, GetActiveHardwareEncoderSessions());
+  fallback_wrapper_->Release();
+  EXPECT_EQ(sessions, GetActiveHardwareEncoderSessions());
+}
+
+TEST_F(VideoEncoderSoftwareFallbackWrapperTest,
+       FallbackEndsHardwareSessionAndIsReported) {
+  metrics::Reset();
+  const int sessions = GetActiveHardwareEncoderSessions();
+  FallbackFromEncodeRequest();
+  EXPECT_EQ(sessions, GetActiveHardwareEncoderSessions());
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.HardwareEncoder.FallbackReason",
+                                  1));
+  EXPECT_EQ(1, metrics::NumSamples(
+                   "WebRTC.Video.HardwareEncoder.SessionsAtFallback"));
+}
+
 TEST_F(VideoEncoderSoftwareFallbackWrapperTest, EncodeRequestsFallback) {
   FallbackFromEncodeRequest();
   // After fallback, further encodes shouldn't hit the fake encoder.
@@ -86,6 +86,7 @@ constexpr VideoEncoder::ScalingSettings::KOff
 VideoEncoder::EncoderInfo::EncoderInfo()
     : scaling_settings(VideoEncoder::ScalingSettings::kOff),
       supports_native_handle(false),
+      supported_input_buffer_types({VideoFrameBuffer::Type::kI420}),
       implementation_name("unknown"),
       has_trusted_rate_controller(false),
       is_hardware_accelerated(false),
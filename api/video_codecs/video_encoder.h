@@ -132,6 +132,12 @@ class RTC_EXPORT VideoEncoder {
     // handle for hw codecs) rather than requiring a raw I420 buffer.
     bool supports_native_handle;
 
+    // Memory-backed frame buffer types that Encode() accepts as is. Frames
+    // with any other buffer type, except native ones accepted as per
+    // |supports_native_handle|, are converted to I420 before being passed to
+    // the encoder. Always contains VideoFrameBuffer::Type::kI420.
+    std::vector<VideoFrameBuffer::Type> supported_input_buffer_types;
+
     // The name of this particular encoder implementation, e.g. "libvpx".
     std::string implementation_name;
 
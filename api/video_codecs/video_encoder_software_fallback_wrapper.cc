@@ -23,9 +23,11 @@
 #include "api/video_codecs/video_codec.h"
 #include "common_types.h"  // NOLINT(build/include)
 #include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/atomicops.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 
@@ -34,6 +36,18 @@ namespace {
 const char kVp8ForceFallbackEncoderFieldTrial[] =
     "WebRTC-VP8-Forced-Fallback-Encoder-v2";
 
+// Reasons for falling back to the software encoder, reported to
+// WebRTC.Video.HardwareEncoder.FallbackReason. Don't change the values.
+enum class FallbackReason {
+  kInitEncodeFailed = 0,
+  kEncodeRequested = 1,
+  kForced = 2,
+  kMaxValue = kForced,
+};
+
+// Number of wrapped hardware encoders that are initialized in this process.
+volatile int g_hardware_encoder_sessions = 0;
+
 bool EnableForcedFallback() {
   return field_trial::IsEnabled(kVp8ForceFallbackEncoderFieldTrial);
 }
@@ -95,7 +109,9 @@ class VideoEncoderSoftwareFallbackWrapper final : public VideoEncoder {
   EncoderInfo GetEncoderInfo() const override;
 
  private:
-  bool InitFallbackEncoder();
+  bool InitFallbackEncoder(FallbackReason reason);
+  // Keeps |g_hardware_encoder_sessions| up to date.
+  void SetHardwareSessionActive(bool active);
 
   // If |forced_fallback_possible_| is true:
   // The forced fallback is requested if the resolution is less than or equal to
@@ -135,6 +151,7 @@ class VideoEncoderSoftwareFallbackWrapper final : public VideoEncoder {
   int64_t rtt_;
 
   bool use_fallback_encoder_;
+  bool hardware_session_active_;
   const std::unique_ptr<webrtc::VideoEncoder> encoder_;
 
   const std::unique_ptr<webrtc::VideoEncoder> fallback_encoder_;
@@ -155,6 +172,7 @@ VideoEncoderSoftwareFallbackWrapper::VideoEncoderSoftwareFallbackWrapper(
       packet_loss_(0),
       rtt_(0),
       use_fallback_encoder_(false),
+      hardware_session_active_(false),
       encoder_(std::move(hw_encoder)),
       fallback_encoder_(std::move(sw_encoder)),
       callback_(nullptr),
@@ -166,10 +184,12 @@ VideoEncoderSoftwareFallbackWrapper::VideoEncoderSoftwareFallbackWrapper(
             1);  // No HW below.
   }
 }
-VideoEncoderSoftwareFallbackWrapper::~VideoEncoderSoftwareFallbackWrapper() =
-    default;
+VideoEncoderSoftwareFallbackWrapper::~VideoEncoderSoftwareFallbackWrapper() {
+  SetHardwareSessionActive(false);
+}
 
-bool VideoEncoderSoftwareFallbackWrapper::InitFallbackEncoder() {
+bool VideoEncoderSoftwareFallbackWrapper::InitFallbackEncoder(
+    FallbackReason reason) {
   RTC_LOG(LS_WARNING) << "Encoder falling back to software encoding.";
 
   const int ret = fallback_encoder_->InitEncode(
@@ -180,6 +200,16 @@ bool VideoEncoderSoftwareFallbackWrapper::InitFallbackEncoder() {
     fallback_encoder_->Release();
     return false;
   }
+  RTC_HISTOGRAM_ENUMERATION("WebRTC.Video.HardwareEncoder.FallbackReason",
+                            static_cast<int>(reason),
+                            static_cast<int>(FallbackReason::kMaxValue) + 1);
+  if (reason != FallbackReason::kForced) {
+    // Shows how many hardware sessions were in use when the hardware encoder
+    // could not be used, e.g. due to a limit on the number of sessions.
+    RTC_HISTOGRAM_COUNTS_100(
+        "WebRTC.Video.HardwareEncoder.SessionsAtFallback",
+        rtc::AtomicOps::AcquireLoad(&g_hardware_encoder_sessions));
+  }
   // Replay callback, rates, and channel parameters.
   if (callback_)
     fallback_encoder_->RegisterEncodeCompleteCallback(callback_);
@@ -190,9 +220,24 @@ bool VideoEncoderSoftwareFallbackWrapper::InitFallbackEncoder() {
   // may be re-initialized via InitEncode later, and it will continue to get
   // Set calls for rates and channel parameters in the meantime.
   encoder_->Release();
+  SetHardwareSessionActive(false);
   return true;
 }
 
+void VideoEncoderSoftwareFallbackWrapper::SetHardwareSessionActive(
+    bool active) {
+  if (active == hardware_session_active_)
+    return;
+  hardware_session_active_ = active;
+  if (active) {
+    RTC_HISTOGRAM_COUNTS_100(
+        "WebRTC.Video.HardwareEncoder.Sessions",
+        rtc::AtomicOps::Increment(&g_hardware_encoder_sessions));
+  } else {
+    rtc::AtomicOps::Decrement(&g_hardware_encoder_sessions);
+  }
+}
+
 int32_t VideoEncoderSoftwareFallbackWrapper::InitEncode(
     const VideoCodec* codec_settings,
     int32_t number_of_cores,
@@ -218,6 +263,7 @@ int32_t VideoEncoderSoftwareFallbackWrapper::InitEncode(
 
   int32_t ret =
       encoder_->InitEncode(codec_settings, number_of_cores, max_payload_size);
+  SetHardwareSessionActive(ret == WEBRTC_VIDEO_CODEC_OK);
   if (ret == WEBRTC_VIDEO_CODEC_OK) {
     if (use_fallback_encoder_) {
       RTC_LOG(LS_WARNING)
@@ -230,7 +276,7 @@ int32_t VideoEncoderSoftwareFallbackWrapper::InitEncode(
     return ret;
   }
   // Try to instantiate software codec.
-  if (InitFallbackEncoder()) {
+  if (InitFallbackEncoder(FallbackReason::kInitEncodeFailed)) {
     return WEBRTC_VIDEO_CODEC_OK;
   }
   // Software encoder failed, use original return code.
@@ -247,8 +293,10 @@ int32_t VideoEncoderSoftwareFallbackWrapper::RegisterEncodeCompleteCallback(
 }
 
 int32_t VideoEncoderSoftwareFallbackWrapper::Release() {
-  return use_fallback_encoder_ ? fallback_encoder_->Release()
-                               : encoder_->Release();
+  if (use_fallback_encoder_)
+    return fallback_encoder_->Release();
+  SetHardwareSessionActive(false);
+  return encoder_->Release();
 }
 
 int32_t VideoEncoderSoftwareFallbackWrapper::Encode(
@@ -260,7 +308,8 @@ int32_t VideoEncoderSoftwareFallbackWrapper::Encode(
   int32_t ret = encoder_->Encode(frame, codec_specific_info, frame_types);
   // If requested, try a software fallback.
   bool fallback_requested = (ret == WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE);
-  if (fallback_requested && InitFallbackEncoder()) {
+  if (fallback_requested &&
+      InitFallbackEncoder(FallbackReason::kEncodeRequested)) {
     // Start using the fallback with this frame.
     return fallback_encoder_->Encode(frame, codec_specific_info, frame_types);
   }
@@ -320,7 +369,7 @@ bool VideoEncoderSoftwareFallbackWrapper::TryInitForcedFallbackEncoder() {
   // Settings valid, try to instantiate software codec.
   RTC_LOG(LS_INFO) << "Request forced SW encoder fallback: "
                    << codec_settings_.width << "x" << codec_settings_.height;
-  if (!InitFallbackEncoder()) {
+  if (!InitFallbackEncoder(FallbackReason::kForced)) {
     return false;
   }
   forced_fallback_.active_ = true;
@@ -369,4 +418,8 @@ std::unique_ptr<VideoEncoder> CreateVideoEncoderSoftwareFallbackWrapper(
       std::move(sw_fallback_encoder), std::move(hw_encoder));
 }
 
+int GetActiveHardwareEncoderSessions() {
+  return rtc::AtomicOps::AcquireLoad(&g_hardware_encoder_sessions);
+}
+
 }  // namespace webrtc
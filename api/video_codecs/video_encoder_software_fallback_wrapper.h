@@ -24,6 +24,12 @@ std::unique_ptr<VideoEncoder> CreateVideoEncoderSoftwareFallbackWrapper(
     std::unique_ptr<VideoEncoder> sw_fallback_encoder,
     std::unique_ptr<VideoEncoder> hw_encoder);
 
+// Returns the number of hardware encoders that are currently initialized by
+// the wrappers above, in this process. Since platforms limit the number of
+// hardware encoder sessions, this can be used to decide which streams should
+// use them.
+int GetActiveHardwareEncoderSessions();
+
 }  // namespace webrtc
 
 #endif  // API_VIDEO_CODECS_VIDEO_ENCODER_SOFTWARE_FALLBACK_WRAPPER_H_
@@ -257,6 +257,14 @@ int AudioReceiveStream::PreferredSampleRate() const {
   return channel_receive_->PreferredSampleRate();
 }
 
+absl::optional<int> AudioReceiveStream::ReceivedAudioLevel() const {
+  return channel_receive_->GetReceivedAudioLevel();
+}
+
+void AudioReceiveStream::SetAudioNeeded(bool needed) {
+  channel_receive_->SetDecodingPaused(!needed);
+}
+
 int AudioReceiveStream::id() const {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   return config_.rtp.remote_ssrc;
@@ -77,6 +77,8 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
                                        AudioFrame* audio_frame) override;
   int Ssrc() const override;
   int PreferredSampleRate() const override;
+  absl::optional<int> ReceivedAudioLevel() const override;
+  void SetAudioNeeded(bool needed) override;
 
   // Syncable
   int id() const override;
@@ -320,6 +320,18 @@ TEST(AudioReceiveStreamTest, SetGain) {
   recv_stream->SetGain(0.765f);
 }
 
+TEST(AudioReceiveStreamTest, PausesDecodingWhileAudioNotNeeded) {
+  ConfigHelper helper;
+  auto recv_stream = helper.CreateAudioReceiveStream();
+  EXPECT_CALL(*helper.channel_receive(), GetReceivedAudioLevel())
+      .WillOnce(Return(absl::optional<int>(30)));
+  EXPECT_EQ(30, recv_stream->ReceivedAudioLevel());
+  EXPECT_CALL(*helper.channel_receive(), SetDecodingPaused(true));
+  recv_stream->SetAudioNeeded(false);
+  EXPECT_CALL(*helper.channel_receive(), SetDecodingPaused(false));
+  recv_stream->SetAudioNeeded(true);
+}
+
 TEST(AudioReceiveStreamTest, StreamsShouldBeAddedToMixerOnceOnStart) {
   ConfigHelper helper1;
   ConfigHelper helper2(helper1.audio_mixer());
@@ -11,6 +11,7 @@
 #include "audio/channel_receive.h"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -55,6 +56,10 @@ constexpr double kAudioSampleDurationSeconds = 0.01;
 constexpr int64_t kMaxRetransmissionWindowMs = 1000;
 constexpr int64_t kMinRetransmissionWindowMs = 30;
 
+// Audio level reported when no RTP packet has been received for a while.
+constexpr int kSilentReceivedAudioLevel = 127;
+constexpr int64_t kReceivedAudioLevelTimeoutMs = 500;
+
 // Video Sync.
 constexpr int kVoiceEngineMinMinPlayoutDelayMs = 0;
 constexpr int kVoiceEngineMaxMinPlayoutDelayMs = 10000;
@@ -164,6 +169,9 @@ class ChannelReceive : public ChannelReceiveInterface,
 
   int PreferredSampleRate() const override;
 
+  absl::optional<int> GetReceivedAudioLevel() const override;
+  void SetDecodingPaused(bool paused) override;
+
   // Associate to a send channel.
   // Used for obtaining RTT for a receive-only channel.
   void SetAssociatedSendChannel(const ChannelSendInterface* channel) override;
@@ -193,6 +201,11 @@ class ChannelReceive : public ChannelReceiveInterface,
     return playing_;
   }
 
+  bool InsertIntoNetEq() const {
+    rtc::CritScope lock(&playing_lock_);
+    return playing_ && !decoding_paused_;
+  }
+
   // Thread checkers document and lock usage of some methods to specific threads
   // we know about. The goal is to eventually split up voe::ChannelReceive into
   // parts with single-threaded semantics, and thereby reduce the need for
@@ -210,6 +223,7 @@ class ChannelReceive : public ChannelReceiveInterface,
 
   rtc::CriticalSection playing_lock_;
   bool playing_ RTC_GUARDED_BY(&playing_lock_) = false;
+  bool decoding_paused_ RTC_GUARDED_BY(&playing_lock_) = false;
 
   RtcEventLog* const event_log_;
 
@@ -240,9 +254,10 @@ class ChannelReceive : public ChannelReceiveInterface,
   // Timestamp of the audio pulled from NetEq.
   absl::optional<uint32_t> jitter_buffer_playout_timestamp_;
 
-  rtc::CriticalSection video_sync_lock_;
-  uint32_t playout_timestamp_rtp_ RTC_GUARDED_BY(video_sync_lock_);
-  uint32_t playout_delay_ms_ RTC_GUARDED_BY(video_sync_lock_);
+  // Written on the audio threads and read on the video render thread for
+  // every frame, so they are atomic rather than guarded by a lock.
+  std::atomic<uint32_t> playout_timestamp_rtp_;
+  std::atomic<uint32_t> playout_delay_ms_;
 
   rtc::CriticalSection ts_stats_lock_;
 
@@ -281,9 +296,9 @@ int32_t ChannelReceive::OnReceivedPayloadData(
   // We should not be receiving any RTP packets if media_transport is set.
   RTC_CHECK(!media_transport_);
 
-  if (!Playing()) {
-    // Avoid inserting into NetEQ when we are not playing. Count the
-    // packet as discarded.
+  if (!InsertIntoNetEq()) {
+    // Avoid inserting into NetEQ when we are not playing or decoding is
+    // paused. Count the packet as discarded.
     return 0;
   }
 
@@ -312,9 +327,9 @@ void ChannelReceive::OnData(uint64_t channel_id,
                             MediaTransportEncodedAudioFrame frame) {
   RTC_CHECK(media_transport_);
 
-  if (!Playing()) {
-    // Avoid inserting into NetEQ when we are not playing. Count the
-    // packet as discarded.
+  if (!InsertIntoNetEq()) {
+    // Avoid inserting into NetEQ when we are not playing or decoding is
+    // paused. Count the packet as discarded.
     return;
   }
 
@@ -423,13 +438,13 @@ AudioMixer::Source::AudioFrameInfo ChannelReceive::GetAudioFrameWithInfo(
     RTC_HISTOGRAM_COUNTS_1000("WebRTC.Audio.TargetJitterBufferDelayMs",
                               audio_coding_->TargetDelayMs());
     const int jitter_buffer_delay = audio_coding_->FilteredCurrentDelayMs();
-    rtc::CritScope lock(&video_sync_lock_);
+    const int playout_delay_ms = playout_delay_ms_.load();
     RTC_HISTOGRAM_COUNTS_1000("WebRTC.Audio.ReceiverDelayEstimateMs",
-                              jitter_buffer_delay + playout_delay_ms_);
+                              jitter_buffer_delay + playout_delay_ms);
     RTC_HISTOGRAM_COUNTS_1000("WebRTC.Audio.ReceiverJitterBufferDelayMs",
                               jitter_buffer_delay);
     RTC_HISTOGRAM_COUNTS_1000("WebRTC.Audio.ReceiverDeviceDelayMs",
-                              playout_delay_ms_);
+                              playout_delay_ms);
   }
 
   return muted ? AudioMixer::Source::AudioFrameInfo::kMuted
@@ -443,6 +458,30 @@ int ChannelReceive::PreferredSampleRate() const {
                   audio_coding_->PlayoutFrequency());
 }
 
+absl::optional<int> ChannelReceive::GetReceivedAudioLevel() const {
+  {
+    rtc::CritScope cs(&_callbackCritSect);
+    if (audio_sink_)
+      return absl::nullopt;
+  }
+  rtc::CritScope cs(&rtp_sources_lock_);
+  if (!last_received_rtp_audio_level_)
+    return absl::nullopt;
+  // A stream that stopped sending is silent.
+  if (rtc::TimeMillis() - *last_received_rtp_system_time_ms_ >
+      kReceivedAudioLevelTimeoutMs) {
+    return kSilentReceivedAudioLevel;
+  }
+  return *last_received_rtp_audio_level_;
+}
+
+void ChannelReceive::SetDecodingPaused(bool paused) {
+  rtc::CritScope lock(&playing_lock_);
+  decoding_paused_ = paused;
+  if (paused)
+    _outputAudioLevel.Clear();
+}
+
 ChannelReceive::ChannelReceive(
     ProcessThread* module_process_thread,
     AudioDeviceModule* audio_device_module,
@@ -846,8 +885,7 @@ AudioDecodingCallStats ChannelReceive::GetDecodingCallStatistics() const {
 uint32_t ChannelReceive::GetDelayEstimate() const {
   RTC_DCHECK(worker_thread_checker_.CalledOnValidThread() ||
              module_process_thread_checker_.CalledOnValidThread());
-  rtc::CritScope lock(&video_sync_lock_);
-  return audio_coding_->FilteredCurrentDelayMs() + playout_delay_ms_;
+  return audio_coding_->FilteredCurrentDelayMs() + playout_delay_ms_.load();
 }
 
 void ChannelReceive::SetMinimumPlayoutDelay(int delay_ms) {
@@ -868,10 +906,7 @@ void ChannelReceive::SetMinimumPlayoutDelay(int delay_ms) {
 
 uint32_t ChannelReceive::GetPlayoutTimestamp() const {
   RTC_DCHECK_RUNS_SERIALIZED(&video_capture_thread_race_checker_);
-  {
-    rtc::CritScope lock(&video_sync_lock_);
-    return playout_timestamp_rtp_;
-  }
+  return playout_timestamp_rtp_.load();
 }
 
 absl::optional<Syncable::Info> ChannelReceive::GetSyncInfo() const {
@@ -916,13 +951,10 @@ void ChannelReceive::UpdatePlayoutTimestamp(bool rtcp) {
   // Remove the playout delay.
   playout_timestamp -= (delay_ms * (GetRtpTimestampRateHz() / 1000));
 
-  {
-    rtc::CritScope lock(&video_sync_lock_);
-    if (!rtcp) {
-      playout_timestamp_rtp_ = playout_timestamp;
-    }
-    playout_delay_ms_ = delay_ms;
+  if (!rtcp) {
+    playout_timestamp_rtp_.store(playout_timestamp);
   }
+  playout_delay_ms_.store(delay_ms);
 }
 
 int ChannelReceive::GetRtpTimestampRateHz() const {
@@ -121,6 +121,15 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
 
   virtual int PreferredSampleRate() const = 0;
 
+  // Level, in -dBov, of the audio in the received RTP packets. Returns nullopt
+  // if no level has been received, or while an audio sink is set, since the
+  // sink needs decoded audio.
+  virtual absl::optional<int> GetReceivedAudioLevel() const = 0;
+  // While paused, received packets are not inserted into NetEq, as when not
+  // playing, so nothing is decoded. RTP statistics and the received audio
+  // level are still updated.
+  virtual void SetDecodingPaused(bool paused) = 0;
+
   // Associate to a send channel.
   // Used for obtaining RTT for a receive-only channel.
   virtual void SetAssociatedSendChannel(
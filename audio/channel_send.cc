@@ -31,6 +31,7 @@
 #include "modules/pacing/packet_router.h"
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/event.h"
 #include "rtc_base/format_macros.h"
@@ -299,6 +300,9 @@ class ChannelSend
 
   rtc::CriticalSection bitrate_crit_section_;
   int configured_bitrate_bps_ RTC_GUARDED_BY(bitrate_crit_section_) = 0;
+
+  rtc::CriticalSection encode_cpu_time_crit_;
+  int64_t encode_cpu_time_us_ RTC_GUARDED_BY(encode_cpu_time_crit_) = 0;
 };
 
 const int kTelephoneEventAttenuationdB = 10;
@@ -1101,6 +1105,9 @@ CallSendStatistics ChannelSend::GetRTCPStatistics() const {
   stats.bytesSent = bytesSent;
   stats.packetsSent = packetsSent;
 
+  rtc::CritScope lock(&encode_cpu_time_crit_);
+  stats.encode_cpu_time_us = encode_cpu_time_us_;
+
   return stats;
 }
 
@@ -1153,7 +1160,15 @@ void ChannelSend::ProcessAndEncodeAudioOnTaskQueue(AudioFrame* audio_input) {
   // This call will trigger AudioPacketizationCallback::SendData if encoding
   // is done and payload is ready for packetization and transmission.
   // Otherwise, it will return without invoking the callback.
-  if (audio_coding_->Add10MsData(*audio_input) < 0) {
+  const int64_t encode_start_cpu_ns = rtc::GetThreadCpuTimeNanos();
+  const int add_result = audio_coding_->Add10MsData(*audio_input);
+  {
+    rtc::CritScope lock(&encode_cpu_time_crit_);
+    encode_cpu_time_us_ +=
+        (rtc::GetThreadCpuTimeNanos() - encode_start_cpu_ns) /
+        rtc::kNumNanosecsPerMicrosec;
+  }
+  if (add_result < 0) {
     RTC_DLOG(LS_ERROR) << "ACM::Add10MsData() failed.";
     return;
   }
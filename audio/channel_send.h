@@ -35,6 +35,8 @@ struct CallSendStatistics {
   int64_t rttMs;
   size_t bytesSent;
   int packetsSent;
+  // Thread CPU time spent encoding and packetizing, summed over all frames.
+  int64_t encode_cpu_time_us;
 };
 
 // See section 6.4.2 in http://www.ietf.org/rfc/rfc3550.txt for details.
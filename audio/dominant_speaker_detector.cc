@@ -0,0 +1,215 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/dominant_speaker_detector.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Audio levels are in -dBov. Levels of -70 dBov and below are treated as
+// silence, which keeps typical background noise from scoring.
+constexpr int kSilenceLevel = 70;
+// Smoothing factors per evaluation interval, corresponding to time constants
+// of about 300 ms and 2 s.
+constexpr double kShortTermAlpha = 0.3;
+constexpr double kLongTermAlpha = 0.05;
+// Score, in dB above silence, that a stream must exceed the dominant speaker
+// by to replace it.
+constexpr double kSwitchMargin = 6.0;
+// Streams scoring lower are considered silent.
+constexpr double kMinSpeechScore = 1.0;
+// Scores have decayed to silence well within this many evaluations, so more
+// are not needed to catch up after a gap in the packets.
+constexpr int64_t kMaxCatchUpEvaluations = 100;
+
+}  // namespace
+
+constexpr int64_t DominantSpeakerDetector::kEvaluationIntervalMs;
+constexpr int64_t DominantSpeakerDetector::kSwitchHoldMs;
+
+DominantSpeakerDetector::DominantSpeakerDetector(
+    size_t max_selected_streams,
+    DominantSpeakerObserver* observer)
+    : max_selected_streams_(max_selected_streams), observer_(observer) {
+  RTC_DCHECK_GT(max_selected_streams_, 0);
+  RTC_DCHECK(observer_);
+  sequenced_checker_.Detach();
+}
+
+DominantSpeakerDetector::~DominantSpeakerDetector() = default;
+
+void DominantSpeakerDetector::AddStream(uint32_t ssrc,
+                                        RtpPacketSinkInterface* sink) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  bool inserted = streams_.emplace(ssrc, Stream(sink)).second;
+  RTC_DCHECK(inserted) << "Stream " << ssrc << " already added.";
+}
+
+void DominantSpeakerDetector::RemoveStream(uint32_t ssrc) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  auto it = streams_.find(ssrc);
+  if (it == streams_.end())
+    return;
+  const bool was_selected = it->second.selected;
+  streams_.erase(it);
+  if (challenger_ssrc_ == ssrc)
+    challenger_ssrc_ = absl::nullopt;
+  if (dominant_ssrc_ == ssrc)
+    SetDominantSpeaker(absl::nullopt);
+  if (was_selected) {
+    selected_ssrcs_.erase(
+        std::find(selected_ssrcs_.begin(), selected_ssrcs_.end(), ssrc));
+    observer_->OnSelectedStreamsChanged(selected_ssrcs_);
+  }
+}
+
+void DominantSpeakerDetector::OnRtpPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  const int64_t now_ms = packet.arrival_time_ms();
+  if (!next_evaluation_ms_)
+    next_evaluation_ms_ = now_ms + kEvaluationIntervalMs;
+  if (now_ms >= *next_evaluation_ms_) {
+    const int64_t num_evaluations =
+        (now_ms - *next_evaluation_ms_) / kEvaluationIntervalMs + 1;
+    for (int64_t i = std::max<int64_t>(0, num_evaluations -
+                                              kMaxCatchUpEvaluations);
+         i < num_evaluations; ++i) {
+      Evaluate(*next_evaluation_ms_ + i * kEvaluationIntervalMs);
+    }
+    *next_evaluation_ms_ += num_evaluations * kEvaluationIntervalMs;
+  }
+
+  auto it = streams_.find(packet.Ssrc());
+  if (it == streams_.end())
+    return;
+  Stream& stream = it->second;
+  // The voice activity flag is ignored, since senders that don't run a VAD
+  // leave it unset.
+  bool voice_activity;
+  uint8_t audio_level;
+  if (packet.GetExtension<AudioLevel>(&voice_activity, &audio_level)) {
+    stream.activity_sum += std::max(0, kSilenceLevel - audio_level);
+    ++stream.num_packets;
+  }
+  if (stream.selected && stream.sink)
+    stream.sink->OnRtpPacket(packet);
+}
+
+absl::optional<uint32_t> DominantSpeakerDetector::dominant_speaker() const {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  return dominant_ssrc_;
+}
+
+bool DominantSpeakerDetector::IsSelected(uint32_t ssrc) const {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  auto it = streams_.find(ssrc);
+  return it != streams_.end() && it->second.selected;
+}
+
+void DominantSpeakerDetector::Evaluate(int64_t now_ms) {
+  for (auto& kv : streams_) {
+    Stream& stream = kv.second;
+    double activity =
+        stream.num_packets > 0
+            ? static_cast<double>(stream.activity_sum) / stream.num_packets
+            : 0.0;
+    stream.short_term_score +=
+        kShortTermAlpha * (activity - stream.short_term_score);
+    stream.long_term_score +=
+        kLongTermAlpha * (activity - stream.long_term_score);
+    stream.activity_sum = 0;
+    stream.num_packets = 0;
+  }
+  UpdateDominantSpeaker(now_ms);
+  UpdateSelectedStreams();
+}
+
+void DominantSpeakerDetector::UpdateDominantSpeaker(int64_t now_ms) {
+  const std::pair<const uint32_t, Stream>* loudest = nullptr;
+  for (const auto& kv : streams_) {
+    if (!loudest ||
+        kv.second.short_term_score > loudest->second.short_term_score) {
+      loudest = &kv;
+    }
+  }
+  if (!loudest || loudest->second.short_term_score < kMinSpeechScore ||
+      loudest->first == dominant_ssrc_) {
+    challenger_ssrc_ = absl::nullopt;
+    return;
+  }
+  if (!dominant_ssrc_) {
+    SetDominantSpeaker(loudest->first);
+    return;
+  }
+
+  const Stream& dominant = streams_.at(*dominant_ssrc_);
+  if (loudest->second.short_term_score <
+      dominant.short_term_score + kSwitchMargin) {
+    challenger_ssrc_ = absl::nullopt;
+    return;
+  }
+  if (challenger_ssrc_ != loudest->first) {
+    challenger_ssrc_ = loudest->first;
+    challenger_since_ms_ = now_ms;
+  }
+  if (now_ms - challenger_since_ms_ >= kSwitchHoldMs) {
+    challenger_ssrc_ = absl::nullopt;
+    SetDominantSpeaker(loudest->first);
+  }
+}
+
+void DominantSpeakerDetector::UpdateSelectedStreams() {
+  // The dominant speaker is always selected, then the streams with the
+  // highest long-term scores that aren't silent.
+  std::vector<std::pair<double, uint32_t>> candidates;
+  for (const auto& kv : streams_) {
+    if (kv.first != dominant_ssrc_ &&
+        kv.second.long_term_score >= kMinSpeechScore) {
+      candidates.emplace_back(-kv.second.long_term_score, kv.first);
+    }
+  }
+  const size_t num_candidates =
+      std::min(candidates.size(),
+               max_selected_streams_ - (dominant_ssrc_ ? 1 : 0));
+  std::partial_sort(candidates.begin(), candidates.begin() + num_candidates,
+                    candidates.end());
+
+  std::vector<uint32_t> selected_ssrcs;
+  if (dominant_ssrc_)
+    selected_ssrcs.push_back(*dominant_ssrc_);
+  for (size_t i = 0; i < num_candidates; ++i)
+    selected_ssrcs.push_back(candidates[i].second);
+  std::sort(selected_ssrcs.begin(), selected_ssrcs.end());
+  if (selected_ssrcs == selected_ssrcs_)
+    return;
+
+  for (uint32_t ssrc : selected_ssrcs_)
+    streams_.at(ssrc).selected = false;
+  for (uint32_t ssrc : selected_ssrcs)
+    streams_.at(ssrc).selected = true;
+  selected_ssrcs_ = std::move(selected_ssrcs);
+  observer_->OnSelectedStreamsChanged(selected_ssrcs_);
+}
+
+void DominantSpeakerDetector::SetDominantSpeaker(
+    absl::optional<uint32_t> ssrc) {
+  dominant_ssrc_ = ssrc;
+  observer_->OnDominantSpeakerChanged(ssrc);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef AUDIO_DOMINANT_SPEAKER_DETECTOR_H_
+#define AUDIO_DOMINANT_SPEAKER_DETECTOR_H_
+
+#include <map>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "rtc_base/sequenced_task_checker.h"
+
+namespace webrtc {
+
+class DominantSpeakerObserver {
+ public:
+  // Called when another stream becomes the dominant speaker, or with nullopt
+  // when the dominant stream is removed.
+  virtual void OnDominantSpeakerChanged(absl::optional<uint32_t> ssrc) = 0;
+  // Called with the SSRCs, in ascending order, of the streams whose packets
+  // are now forwarded to their sinks.
+  virtual void OnSelectedStreamsChanged(const std::vector<uint32_t>& ssrcs) = 0;
+
+ protected:
+  virtual ~DominantSpeakerObserver() = default;
+};
+
+// Identifies the dominant speaker among many incoming audio streams from the
+// audio level RTP header extension (RFC 6464), without decoding any audio, for
+// use on servers that receive far more streams than they can decode.
+//
+// Packets, typically from an RtpDemuxer, are scored by their audio level as
+// they arrive, and every |kEvaluationIntervalMs| of arrival time the scores
+// are smoothed over a short and a long term. A stream replaces the dominant
+// speaker once its short-term score has exceeded the dominant speaker's by a
+// margin for |kSwitchHoldMs|, which ignores short noises. The dominant speaker
+// and the streams with the highest long-term scores, up to
+// |max_selected_streams| in total, are selected, and only packets of selected
+// streams are forwarded to the sink of their stream, e.g. an
+// AudioReceiveStream. Streams that are never selected are never decoded.
+//
+// Must be used on a single sequence. Observer callbacks are made from
+// OnRtpPacket().
+class DominantSpeakerDetector : public RtpPacketSinkInterface {
+ public:
+  static constexpr int64_t kEvaluationIntervalMs = 100;
+  static constexpr int64_t kSwitchHoldMs = 400;
+
+  DominantSpeakerDetector(size_t max_selected_streams,
+                          DominantSpeakerObserver* observer);
+  ~DominantSpeakerDetector() override;
+
+  // Adds a stream. Its packets are passed to |sink|, which may be null, while
+  // the stream is selected.
+  void AddStream(uint32_t ssrc, RtpPacketSinkInterface* sink);
+  void RemoveStream(uint32_t ssrc);
+
+  // RtpPacketSinkInterface. Packets of unknown streams are ignored.
+  void OnRtpPacket(const RtpPacketReceived& packet) override;
+
+  absl::optional<uint32_t> dominant_speaker() const;
+  bool IsSelected(uint32_t ssrc) const;
+
+ private:
+  struct Stream {
+    explicit Stream(RtpPacketSinkInterface* sink) : sink(sink) {}
+
+    RtpPacketSinkInterface* const sink;
+    // Sum of the speech activity of the packets since the last evaluation.
+    int activity_sum = 0;
+    int num_packets = 0;
+    double short_term_score = 0;
+    double long_term_score = 0;
+    bool selected = false;
+  };
+
+  void Evaluate(int64_t now_ms) RTC_RUN_ON(&sequenced_checker_);
+  void UpdateDominantSpeaker(int64_t now_ms) RTC_RUN_ON(&sequenced_checker_);
+  void UpdateSelectedStreams() RTC_RUN_ON(&sequenced_checker_);
+  void SetDominantSpeaker(absl::optional<uint32_t> ssrc)
+      RTC_RUN_ON(&sequenced_checker_);
+
+  rtc::SequencedTaskChecker sequenced_checker_;
+  const size_t max_selected_streams_;
+  DominantSpeakerObserver* const observer_;
+  std::map<uint32_t, Stream> streams_ RTC_GUARDED_BY(&sequenced_checker_);
+  absl::optional<int64_t> next_evaluation_ms_
+      RTC_GUARDED_BY(&sequenced_checker_);
+  absl::optional<uint32_t> dominant_ssrc_ RTC_GUARDED_BY(&sequenced_checker_);
+  // Stream that has been loudest by the switch margin since
+  // |challenger_since_ms_|.
+  absl::optional<uint32_t> challenger_ssrc_
+      RTC_GUARDED_BY(&sequenced_checker_);
+  int64_t challenger_since_ms_ RTC_GUARDED_BY(&sequenced_checker_) = 0;
+  std::vector<uint32_t> selected_ssrcs_ RTC_GUARDED_BY(&sequenced_checker_);
+};
+
+}  // namespace webrtc
+
+#endif  // AUDIO_DOMINANT_SPEAKER_DETECTOR_H_
@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/dominant_speaker_detector.h"
+
+#include <map>
+#include <vector>
+
+#include "call/test/mock_rtp_packet_sink_interface.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr int64_t kPacketIntervalMs = 20;
+constexpr uint8_t kSilence = 127;
+constexpr uint8_t kSpeech = 30;
+constexpr uint8_t kLoudSpeech = 20;
+
+class ObserverRecorder : public DominantSpeakerObserver {
+ public:
+  void OnDominantSpeakerChanged(absl::optional<uint32_t> ssrc) override {
+    dominant_speakers.push_back(ssrc);
+  }
+  void OnSelectedStreamsChanged(const std::vector<uint32_t>& ssrcs) override {
+    selected_ssrcs = ssrcs;
+  }
+
+  std::vector<absl::optional<uint32_t>> dominant_speakers;
+  std::vector<uint32_t> selected_ssrcs;
+};
+
+class DominantSpeakerDetectorTest : public ::testing::Test {
+ protected:
+  DominantSpeakerDetectorTest() : detector_(2, &observer_) {
+    extensions_.Register<AudioLevel>(1);
+  }
+
+  // Sends a packet every |kPacketIntervalMs| on each stream in |levels|, with
+  // its audio level, for |duration_ms|.
+  void SendPackets(const std::map<uint32_t, uint8_t>& levels,
+                   int64_t duration_ms) {
+    for (int64_t end_ms = time_ms_ + duration_ms; time_ms_ < end_ms;
+         time_ms_ += kPacketIntervalMs) {
+      for (const auto& kv : levels) {
+        RtpPacketReceived packet(&extensions_);
+        packet.SetSsrc(kv.first);
+        packet.SetExtension<AudioLevel>(true, kv.second);
+        packet.set_arrival_time_ms(time_ms_);
+        detector_.OnRtpPacket(packet);
+      }
+    }
+  }
+
+  RtpHeaderExtensionMap extensions_;
+  ObserverRecorder observer_;
+  DominantSpeakerDetector detector_;
+  int64_t time_ms_ = 1000;
+};
+
+}  // namespace
+
+TEST_F(DominantSpeakerDetectorTest, SilentStreamsAreNotSelected) {
+  detector_.AddStream(1, nullptr);
+  detector_.AddStream(2, nullptr);
+  SendPackets({{1, kSilence}, {2, kSilence}}, 1000);
+  EXPECT_FALSE(detector_.dominant_speaker());
+  EXPECT_THAT(observer_.dominant_speakers, IsEmpty());
+  EXPECT_FALSE(detector_.IsSelected(1));
+  EXPECT_FALSE(detector_.IsSelected(2));
+}
+
+TEST_F(DominantSpeakerDetectorTest, ForwardsPacketsOfSelectedStreams) {
+  MockRtpPacketSink sink_1;
+  MockRtpPacketSink sink_2;
+  detector_.AddStream(1, &sink_1);
+  detector_.AddStream(2, &sink_2);
+
+  EXPECT_CALL(sink_1, OnRtpPacket(_)).Times(AnyNumber());
+  EXPECT_CALL(sink_2, OnRtpPacket(_)).Times(0);
+  SendPackets({{1, kSpeech}, {2, kSilence}}, 1000);
+  EXPECT_EQ(1u, detector_.dominant_speaker());
+  EXPECT_THAT(observer_.dominant_speakers, ElementsAre(1u));
+  EXPECT_THAT(observer_.selected_ssrcs, ElementsAre(1u));
+
+  // Once selected, every packet is forwarded.
+  EXPECT_CALL(sink_1, OnRtpPacket(_)).Times(10);
+  SendPackets({{1, kSpeech}, {2, kSilence}}, 10 * kPacketIntervalMs);
+}
+
+TEST_F(DominantSpeakerDetectorTest, IgnoresShortNoise) {
+  detector_.AddStream(1, nullptr);
+  detector_.AddStream(2, nullptr);
+  SendPackets({{1, kSpeech}, {2, kSilence}}, 2000);
+  ASSERT_EQ(1u, detector_.dominant_speaker());
+
+  SendPackets({{1, kSilence}, {2, kLoudSpeech}},
+              DominantSpeakerDetector::kSwitchHoldMs / 2);
+  SendPackets({{1, kSpeech}, {2, kSilence}}, 1000);
+  EXPECT_THAT(observer_.dominant_speakers, ElementsAre(1u));
+}
+
+TEST_F(DominantSpeakerDetectorTest, SwitchesToNewSpeaker) {
+  detector_.AddStream(1, nullptr);
+  detector_.AddStream(2, nullptr);
+  detector_.AddStream(3, nullptr);
+  SendPackets({{1, kSpeech}, {2, kSilence}, {3, kSilence}}, 2000);
+  ASSERT_EQ(1u, detector_.dominant_speaker());
+
+  SendPackets({{1, kSilence}, {2, kSpeech}, {3, kSilence}}, 1000);
+  EXPECT_EQ(2u, detector_.dominant_speaker());
+  EXPECT_THAT(observer_.dominant_speakers, ElementsAre(1u, 2u));
+  // The previous speaker stays selected while its long-term score decays.
+  EXPECT_THAT(observer_.selected_ssrcs, ElementsAre(1u, 2u));
+
+  // At most two streams are selected.
+  SendPackets({{1, kSilence}, {2, kSpeech}, {3, kLoudSpeech}}, 10000);
+  EXPECT_EQ(3u, detector_.dominant_speaker());
+  EXPECT_THAT(observer_.selected_ssrcs, ElementsAre(2u, 3u));
+  EXPECT_FALSE(detector_.IsSelected(1));
+}
+
+TEST_F(DominantSpeakerDetectorTest, ScoresDecayWithoutPackets) {
+  detector_.AddStream(1, nullptr);
+  SendPackets({{1, kSpeech}}, 1000);
+  ASSERT_EQ(1u, detector_.dominant_speaker());
+
+  // Stream 1 stops sending while stream 2 starts.
+  detector_.AddStream(2, nullptr);
+  time_ms_ += 60000;
+  SendPackets({{2, kSpeech}}, 1000);
+  EXPECT_EQ(2u, detector_.dominant_speaker());
+  EXPECT_THAT(observer_.selected_ssrcs, ElementsAre(2u));
+}
+
+TEST_F(DominantSpeakerDetectorTest, RemovesDominantSpeaker) {
+  detector_.AddStream(1, nullptr);
+  SendPackets({{1, kSpeech}}, 1000);
+  ASSERT_EQ(1u, detector_.dominant_speaker());
+
+  detector_.RemoveStream(1);
+  EXPECT_FALSE(detector_.dominant_speaker());
+  EXPECT_THAT(observer_.dominant_speakers,
+              ElementsAre(1u, absl::optional<uint32_t>()));
+  EXPECT_THAT(observer_.selected_ssrcs, IsEmpty());
+}
+
+}  // namespace webrtc
@@ -48,6 +48,8 @@ class MockChannelReceive : public voe::ChannelReceiveInterface {
                AudioMixer::Source::AudioFrameInfo(int sample_rate_hz,
                                                   AudioFrame* audio_frame));
   MOCK_CONST_METHOD0(PreferredSampleRate, int());
+  MOCK_CONST_METHOD0(GetReceivedAudioLevel, absl::optional<int>());
+  MOCK_METHOD1(SetDecodingPaused, void(bool paused));
   MOCK_METHOD1(SetAssociatedSendChannel,
                void(const voe::ChannelSendInterface* send_channel));
   MOCK_CONST_METHOD0(GetPlayoutTimestamp, uint32_t());
@@ -24,6 +24,35 @@ namespace {
 const size_t kMuteFadeFrames = 128;
 const float kMuteFadeInc = 1.0f / kMuteFadeFrames;
 
+// Surround downmix gains in Q14, for the front channels and for the center and
+// each surround channel, which are mixed in at -3 dB. Each pair of gains sums
+// to at most 1 so that the downmix cannot clip.
+const int32_t kSurround51FrontGainQ14 = 6786;  // 1 / (1 + 2 / sqrt(2)).
+const int32_t kSurround51OtherGainQ14 = 4799;
+const int32_t kSurround71FrontGainQ14 = 5249;  // 1 / (1 + 3 / sqrt(2)).
+const int32_t kSurround71OtherGainQ14 = 3711;
+
+// The channel count is a template parameter so that the compiler can unroll
+// the inner loop and vectorize the outer one.
+template <size_t kChannels>
+void SurroundToStereoImpl(const int16_t* src_audio,
+                          size_t samples_per_channel,
+                          int32_t front_gain_q14,
+                          int32_t other_gain_q14,
+                          int16_t* dst_audio) {
+  for (size_t i = 0; i < samples_per_channel; i++) {
+    const int16_t* src = &src_audio[kChannels * i];
+    int32_t left = front_gain_q14 * src[0] + other_gain_q14 * src[2];
+    int32_t right = front_gain_q14 * src[1] + other_gain_q14 * src[2];
+    for (size_t c = 4; c < kChannels; c += 2) {
+      left += other_gain_q14 * src[c];
+      right += other_gain_q14 * src[c + 1];
+    }
+    dst_audio[2 * i] = static_cast<int16_t>(left >> 14);
+    dst_audio[2 * i + 1] = static_cast<int16_t>(right >> 14);
+  }
+}
+
 }  // namespace
 
 void AudioFrameOperations::Add(const AudioFrame& frame_to_add,
@@ -182,6 +211,40 @@ int AudioFrameOperations::QuadToMono(AudioFrame* frame) {
   return 0;
 }
 
+void AudioFrameOperations::SurroundToStereo(const int16_t* src_audio,
+                                            size_t src_channels,
+                                            size_t samples_per_channel,
+                                            int16_t* dst_audio) {
+  if (src_channels == 6) {
+    SurroundToStereoImpl<6>(src_audio, samples_per_channel,
+                            kSurround51FrontGainQ14, kSurround51OtherGainQ14,
+                            dst_audio);
+  } else if (src_channels == 8) {
+    SurroundToStereoImpl<8>(src_audio, samples_per_channel,
+                            kSurround71FrontGainQ14, kSurround71OtherGainQ14,
+                            dst_audio);
+  } else {
+    RTC_NOTREACHED() << "src_channels: " << src_channels;
+  }
+}
+
+int AudioFrameOperations::SurroundToStereo(AudioFrame* frame) {
+  if (frame->num_channels_ != 6 && frame->num_channels_ != 8) {
+    return -1;
+  }
+
+  RTC_DCHECK_LE(frame->samples_per_channel_ * frame->num_channels_,
+                AudioFrame::kMaxDataSizeSamples);
+
+  if (!frame->muted()) {
+    SurroundToStereo(frame->data(), frame->num_channels_,
+                     frame->samples_per_channel_, frame->mutable_data());
+  }
+  frame->num_channels_ = 2;
+
+  return 0;
+}
+
 void AudioFrameOperations::DownmixChannels(const int16_t* src_audio,
                                            size_t src_channels,
                                            size_t samples_per_channel,
@@ -196,6 +259,12 @@ void AudioFrameOperations::DownmixChannels(const int16_t* src_audio,
   } else if (src_channels == 4 && dst_channels == 1) {
     QuadToMono(src_audio, samples_per_channel, dst_audio);
     return;
+  } else if ((src_channels == 6 || src_channels == 8) &&
+             (dst_channels == 1 || dst_channels == 2)) {
+    SurroundToStereo(src_audio, src_channels, samples_per_channel, dst_audio);
+    if (dst_channels == 1)
+      StereoToMono(dst_audio, samples_per_channel, dst_audio);
+    return;
   }
 
   RTC_NOTREACHED() << "src_channels: " << src_channels
@@ -210,6 +279,11 @@ int AudioFrameOperations::DownmixChannels(size_t dst_channels,
     return QuadToStereo(frame);
   } else if (frame->num_channels_ == 4 && dst_channels == 1) {
     return QuadToMono(frame);
+  } else if ((frame->num_channels_ == 6 || frame->num_channels_ == 8) &&
+             (dst_channels == 1 || dst_channels == 2)) {
+    if (SurroundToStereo(frame) != 0)
+      return -1;
+    return dst_channels == 1 ? StereoToMono(frame) : 0;
   }
 
   return -1;
@@ -77,10 +77,27 @@ class AudioFrameOperations {
   // |num_channels_| is 4 channels.
   static int QuadToMono(AudioFrame* frame);
 
+  // Downmixes 5.1 or 7.1 channels |src_audio| to stereo |dst_audio|. The
+  // channels are ordered L, R, C, LFE, followed by pairs of left and right
+  // surround channels. The LFE channel is dropped, and the center and
+  // surround channels are mixed into both sides at -3 dB relative to the
+  // front channels, with a gain that prevents clipping. This is an in-place
+  // operation, meaning |src_audio| and |dst_audio| may point to the same
+  // buffer.
+  static void SurroundToStereo(const int16_t* src_audio,
+                               size_t src_channels,
+                               size_t samples_per_channel,
+                               int16_t* dst_audio);
+
+  // |frame.num_channels_| will be updated. This version checks that
+  // |num_channels_| is 6 or 8 channels.
+  static int SurroundToStereo(AudioFrame* frame);
+
   // Downmixes |src_channels| |src_audio| to |dst_channels| |dst_audio|.
   // This is an in-place operation, meaning |src_audio| and |dst_audio|
   // may point to the same buffer. Supported channel combinations are
-  // Stereo to Mono, Quad to Mono, and Quad to Stereo.
+  // Stereo to Mono, Quad to Mono, Quad to Stereo, and 5.1 or 7.1 to Stereo or
+  // Mono.
   static void DownmixChannels(const int16_t* src_audio,
                               size_t src_channels,
                               size_t samples_per_channel,
@@ -90,7 +107,7 @@ class AudioFrameOperations {
   // |frame.num_channels_| will be updated. This version checks that
   // |num_channels_| and |dst_channels| are valid and performs relevant
   // downmix.  Supported channel combinations are Stereo to Mono, Quad to Mono,
-  // and Quad to Stereo.
+  // Quad to Stereo, and 5.1 or 7.1 to Stereo or Mono.
   static int DownmixChannels(size_t dst_channels, AudioFrame* frame);
 
   // Swap the left and right channels of |frame|. Fails silently if |frame| is
@@ -8,6 +8,9 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include "audio/utility/audio_frame_operations.h"
 #include "rtc_base/checks.h"
 #include "test/gtest.h"
@@ -48,6 +51,15 @@ void SetFrameData(int16_t left, int16_t right, AudioFrame* frame) {
   }
 }
 
+void SetFrameData(const std::vector<int16_t>& channels, AudioFrame* frame) {
+  RTC_DCHECK_EQ(channels.size(), frame->num_channels_);
+  int16_t* frame_data = frame->mutable_data();
+  for (size_t i = 0; i < frame->samples_per_channel_ * channels.size();
+       i += channels.size()) {
+    std::copy(channels.begin(), channels.end(), &frame_data[i]);
+  }
+}
+
 void SetFrameData(int16_t data, AudioFrame* frame) {
   int16_t* frame_data = frame->mutable_data();
   for (size_t i = 0; i < frame->samples_per_channel_ * frame->num_channels_;
@@ -310,6 +322,69 @@ TEST_F(AudioFrameOperationsTest, QuadToStereoDoesNotWrapAround) {
   VerifyFramesAreEqual(stereo_frame, frame_);
 }
 
+TEST_F(AudioFrameOperationsTest, SurroundToStereoFailsWithBadParameters) {
+  frame_.num_channels_ = 4;
+  EXPECT_EQ(-1, AudioFrameOperations::SurroundToStereo(&frame_));
+  frame_.num_channels_ = 7;
+  EXPECT_EQ(-1, AudioFrameOperations::SurroundToStereo(&frame_));
+}
+
+TEST_F(AudioFrameOperationsTest, Surround51ToStereoSucceeds) {
+  frame_.num_channels_ = 6;
+  SetFrameData({1000, 2000, 3000, 30000, 4000, -4000}, &frame_);
+  EXPECT_EQ(0, AudioFrameOperations::SurroundToStereo(&frame_));
+
+  AudioFrame stereo_frame;
+  stereo_frame.samples_per_channel_ = 320;
+  stereo_frame.num_channels_ = 2;
+  SetFrameData(2464, 535, &stereo_frame);
+  VerifyFramesAreEqual(stereo_frame, frame_);
+}
+
+TEST_F(AudioFrameOperationsTest, Surround71ToStereoSucceeds) {
+  frame_.num_channels_ = 8;
+  SetFrameData({16384, 0, 16384, 30000, 16384, 0, 16384, 0}, &frame_);
+  EXPECT_EQ(0, AudioFrameOperations::SurroundToStereo(&frame_));
+
+  AudioFrame stereo_frame;
+  stereo_frame.samples_per_channel_ = 320;
+  stereo_frame.num_channels_ = 2;
+  SetFrameData(16382, 3711, &stereo_frame);
+  VerifyFramesAreEqual(stereo_frame, frame_);
+}
+
+TEST_F(AudioFrameOperationsTest, SurroundToStereoMuted) {
+  frame_.num_channels_ = 6;
+  ASSERT_TRUE(frame_.muted());
+  EXPECT_EQ(0, AudioFrameOperations::SurroundToStereo(&frame_));
+  EXPECT_TRUE(frame_.muted());
+  EXPECT_EQ(2u, frame_.num_channels_);
+}
+
+TEST_F(AudioFrameOperationsTest, SurroundToStereoDoesNotWrapAround) {
+  frame_.num_channels_ = 6;
+  SetFrameData({-32768, -32768, -32768, 0, -32768, -32768}, &frame_);
+  EXPECT_EQ(0, AudioFrameOperations::SurroundToStereo(&frame_));
+
+  AudioFrame stereo_frame;
+  stereo_frame.samples_per_channel_ = 320;
+  stereo_frame.num_channels_ = 2;
+  SetFrameData(-32768, -32768, &stereo_frame);
+  VerifyFramesAreEqual(stereo_frame, frame_);
+}
+
+TEST_F(AudioFrameOperationsTest, DownmixSurroundToMonoSucceeds) {
+  frame_.num_channels_ = 6;
+  SetFrameData({1000, 2000, 3000, 30000, 4000, -4000}, &frame_);
+  EXPECT_EQ(0, AudioFrameOperations::DownmixChannels(1, &frame_));
+
+  AudioFrame mono_frame;
+  mono_frame.samples_per_channel_ = 320;
+  mono_frame.num_channels_ = 1;
+  SetFrameData(1499, &mono_frame);
+  VerifyFramesAreEqual(mono_frame, frame_);
+}
+
 TEST_F(AudioFrameOperationsTest, SwapStereoChannelsSucceedsOnStereo) {
   SetFrameData(0, 1, &frame_);
 
@@ -61,6 +61,9 @@ class AudioSendStream {
     AudioProcessingStats apm_statistics;
 
     int64_t target_bitrate_bps = 0;
+    // Thread CPU time spent encoding and packetizing, excluding audio
+    // processing which is shared by all send streams.
+    int64_t total_encode_cpu_time_us = 0;
   };
 
   struct Config {
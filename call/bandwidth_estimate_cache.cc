@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/bandwidth_estimate_cache.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+BandwidthEstimateCache::BandwidthEstimateCache()
+    : BandwidthEstimateCache(Config()) {}
+
+BandwidthEstimateCache::BandwidthEstimateCache(const Config& config)
+    : config_(config) {
+  RTC_DCHECK_GT(config_.start_fraction, 0);
+  RTC_DCHECK(config_.half_life > TimeDelta::Zero());
+  RTC_DCHECK_GT(config_.max_networks, 0);
+}
+
+BandwidthEstimateCache::~BandwidthEstimateCache() = default;
+
+void BandwidthEstimateCache::OnEstimate(const std::string& network_key,
+                                        DataRate estimate,
+                                        Timestamp at_time) {
+  if (!estimate.IsFinite() || estimate <= DataRate::Zero())
+    return;
+  rtc::CritScope cs(&crit_);
+  auto it = estimates_.find(network_key);
+  if (it != estimates_.end()) {
+    it->second = {estimate, at_time};
+    return;
+  }
+  if (estimates_.size() >= config_.max_networks) {
+    auto oldest = std::min_element(
+        estimates_.begin(), estimates_.end(),
+        [](const std::pair<const std::string, Entry>& a,
+           const std::pair<const std::string, Entry>& b) {
+          return a.second.at_time < b.second.at_time;
+        });
+    estimates_.erase(oldest);
+  }
+  estimates_.emplace(network_key, Entry{estimate, at_time});
+}
+
+absl::optional<DataRate> BandwidthEstimateCache::GetStartRate(
+    const std::string& network_key,
+    Timestamp at_time) const {
+  rtc::CritScope cs(&crit_);
+  auto it = estimates_.find(network_key);
+  if (it == estimates_.end())
+    return absl::nullopt;
+  // An entry from the future, e.g. after a clock change, counts as new.
+  TimeDelta age = std::max(at_time - it->second.at_time, TimeDelta::Zero());
+  if (age > config_.max_age)
+    return absl::nullopt;
+  double decay = pow(0.5, age / config_.half_life);
+  return it->second.estimate * (config_.start_fraction * decay);
+}
+
+bool BandwidthEstimateCache::SeedStartBitrate(
+    const std::string& network_key,
+    Timestamp at_time,
+    BitrateConstraints* constraints) const {
+  absl::optional<DataRate> start_rate = GetStartRate(network_key, at_time);
+  if (!start_rate)
+    return false;
+  int start_bitrate_bps = start_rate->bps<int>();
+  if (constraints->max_bitrate_bps > 0)
+    start_bitrate_bps =
+        std::min(start_bitrate_bps, constraints->max_bitrate_bps);
+  if (start_bitrate_bps <= constraints->start_bitrate_bps)
+    return false;
+  constraints->start_bitrate_bps = start_bitrate_bps;
+  return true;
+}
+
+}  // namespace webrtc
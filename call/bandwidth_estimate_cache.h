@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_BANDWIDTH_ESTIMATE_CACHE_H_
+#define CALL_BANDWIDTH_ESTIMATE_CACHE_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+
+#include "absl/types/optional.h"
+#include "api/bitrate_constraints.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Remembers the bandwidth estimate of earlier calls per network, so that a new
+// call on a known network can start at a rate close to what was available,
+// instead of ramping up from the default start bitrate. Since the initial
+// probes of GoogCC are multiples of the start bitrate, they follow as well.
+//
+// The network key is chosen by the user, e.g. the name and type of the local
+// rtc::Network and a prefix of the remote address. Report estimates, e.g. the
+// send bandwidth from Call::GetStats(), with OnEstimate(), and apply the cache
+// to the BitrateConstraints of the next call on the network with
+// SeedStartBitrate().
+//
+// To not overshoot on a network whose capacity changed, a cached estimate is
+// only partly trusted, is decayed with its age and is forgotten after a while.
+//
+// Thread safe.
+class BandwidthEstimateCache {
+ public:
+  struct Config {
+    // Fraction of the cached estimate to start at.
+    double start_fraction = 0.7;
+    // The cached estimate is halved every |half_life|.
+    TimeDelta half_life = TimeDelta::seconds(6 * 3600);
+    // Estimates older than this are not used.
+    TimeDelta max_age = TimeDelta::seconds(24 * 3600);
+    // The least recently updated network is forgotten when more are cached.
+    size_t max_networks = 32;
+  };
+
+  BandwidthEstimateCache();
+  explicit BandwidthEstimateCache(const Config& config);
+  ~BandwidthEstimateCache();
+
+  void OnEstimate(const std::string& network_key,
+                  DataRate estimate,
+                  Timestamp at_time);
+
+  // Returns the rate to start at on the network, if an estimate that is
+  // recent enough is cached.
+  absl::optional<DataRate> GetStartRate(const std::string& network_key,
+                                        Timestamp at_time) const;
+
+  // Raises the start bitrate of |constraints| to the start rate of the
+  // network, capped at the max bitrate. Returns true if it was raised.
+  bool SeedStartBitrate(const std::string& network_key,
+                        Timestamp at_time,
+                        BitrateConstraints* constraints) const;
+
+ private:
+  struct Entry {
+    DataRate estimate;
+    Timestamp at_time;
+  };
+
+  const Config config_;
+  rtc::CriticalSection crit_;
+  std::map<std::string, Entry> estimates_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_BANDWIDTH_ESTIMATE_CACHE_H_
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/bandwidth_estimate_cache.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+BandwidthEstimateCache::Config TestConfig() {
+  BandwidthEstimateCache::Config config;
+  config.start_fraction = 0.5;
+  config.half_life = TimeDelta::seconds(100);
+  config.max_age = TimeDelta::seconds(300);
+  config.max_networks = 2;
+  return config;
+}
+
+}  // namespace
+
+TEST(BandwidthEstimateCacheTest, StartsAtFractionOfEstimate) {
+  BandwidthEstimateCache cache(TestConfig());
+  const Timestamp now = Timestamp::seconds(1000);
+  EXPECT_FALSE(cache.GetStartRate("wifi", now));
+  cache.OnEstimate("wifi", DataRate::kbps(4000), now);
+  EXPECT_EQ(DataRate::kbps(2000), cache.GetStartRate("wifi", now));
+  EXPECT_FALSE(cache.GetStartRate("cellular", now));
+}
+
+TEST(BandwidthEstimateCacheTest, DecaysAndForgetsOldEstimates) {
+  BandwidthEstimateCache cache(TestConfig());
+  const Timestamp now = Timestamp::seconds(1000);
+  cache.OnEstimate("wifi", DataRate::kbps(4000), now);
+  EXPECT_EQ(DataRate::kbps(1000),
+            cache.GetStartRate("wifi", now + TimeDelta::seconds(100)));
+  EXPECT_EQ(DataRate::kbps(250),
+            cache.GetStartRate("wifi", now + TimeDelta::seconds(300)));
+  EXPECT_FALSE(cache.GetStartRate("wifi", now + TimeDelta::seconds(301)));
+}
+
+TEST(BandwidthEstimateCacheTest, ForgetsLeastRecentlyUpdatedNetwork) {
+  BandwidthEstimateCache cache(TestConfig());
+  const Timestamp now = Timestamp::seconds(1000);
+  cache.OnEstimate("a", DataRate::kbps(1000), now);
+  cache.OnEstimate("b", DataRate::kbps(1000), now + TimeDelta::seconds(1));
+  cache.OnEstimate("a", DataRate::kbps(1000), now + TimeDelta::seconds(2));
+  cache.OnEstimate("c", DataRate::kbps(1000), now + TimeDelta::seconds(3));
+  EXPECT_TRUE(cache.GetStartRate("a", now + TimeDelta::seconds(3)));
+  EXPECT_FALSE(cache.GetStartRate("b", now + TimeDelta::seconds(3)));
+  EXPECT_TRUE(cache.GetStartRate("c", now + TimeDelta::seconds(3)));
+}
+
+TEST(BandwidthEstimateCacheTest, SeedsStartBitrateWithinMax) {
+  BandwidthEstimateCache cache(TestConfig());
+  const Timestamp now = Timestamp::seconds(1000);
+  BitrateConstraints constraints;
+  constraints.min_bitrate_bps = 30000;
+  constraints.start_bitrate_bps = 300000;
+  constraints.max_bitrate_bps = 2000000;
+  EXPECT_FALSE(cache.SeedStartBitrate("wifi", now, &constraints));
+
+  // A lower estimate does not lower the start bitrate.
+  cache.OnEstimate("wifi", DataRate::kbps(400), now);
+  EXPECT_FALSE(cache.SeedStartBitrate("wifi", now, &constraints));
+  EXPECT_EQ(300000, constraints.start_bitrate_bps);
+
+  cache.OnEstimate("wifi", DataRate::kbps(3000), now);
+  EXPECT_TRUE(cache.SeedStartBitrate("wifi", now, &constraints));
+  EXPECT_EQ(1500000, constraints.start_bitrate_bps);
+
+  cache.OnEstimate("wifi", DataRate::kbps(8000), now);
+  EXPECT_TRUE(cache.SeedStartBitrate("wifi", now, &constraints));
+  EXPECT_EQ(2000000, constraints.start_bitrate_bps);
+}
+
+}  // namespace webrtc
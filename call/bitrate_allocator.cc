@@ -52,12 +52,15 @@ double MediaRatio(uint32_t allocated_bitrate, uint32_t protection_bitrate) {
 
 BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer)
     : limit_observer_(limit_observer),
+      sum_min_bitrates_(0),
+      sum_max_bitrates_(0),
       last_target_bps_(0),
       last_link_capacity_bps_(0),
       last_non_zero_bitrate_bps_(kDefaultBitrateBps),
       last_fraction_loss_(0),
       last_rtt_(0),
       last_bwe_period_ms_(1000),
+      last_cwnd_reduce_ratio_(0),
       num_pause_events_(0),
       clock_(Clock::GetRealTimeClock()),
       last_bwe_log_time_(0),
@@ -100,7 +103,8 @@ void BitrateAllocator::OnNetworkChanged(uint32_t target_bitrate_bps,
                                         uint32_t link_capacity_bps,
                                         uint8_t fraction_loss,
                                         int64_t rtt,
-                                        int64_t bwe_period_ms) {
+                                        int64_t bwe_period_ms,
+                                        double cwnd_reduce_ratio) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
   last_target_bps_ = target_bitrate_bps;
   last_link_capacity_bps_ = link_capacity_bps;
@@ -109,6 +113,7 @@ void BitrateAllocator::OnNetworkChanged(uint32_t target_bitrate_bps,
   last_fraction_loss_ = fraction_loss;
   last_rtt_ = rtt;
   last_bwe_period_ms_ = bwe_period_ms;
+  last_cwnd_reduce_ratio_ = cwnd_reduce_ratio;
 
   // Periodically log the incoming BWE.
   int64_t now = clock_->TimeInMilliseconds();
@@ -118,17 +123,24 @@ void BitrateAllocator::OnNetworkChanged(uint32_t target_bitrate_bps,
   }
 
   ObserverAllocation allocation = AllocateBitrates(target_bitrate_bps);
-  ObserverAllocation bandwidth_allocation = AllocateBitrates(link_capacity_bps);
-
-  for (auto& config : bitrate_observer_configs_) {
-    uint32_t allocated_bitrate = allocation[config.observer];
-    uint32_t allocated_bandwidth = bandwidth_allocation[config.observer];
+  // The allocation only depends on the bitrate and the previous allocation,
+  // so it can be reused when the link capacity equals the target.
+  ObserverAllocation bandwidth_allocation =
+      link_capacity_bps == target_bitrate_bps
+          ? allocation
+          : AllocateBitrates(link_capacity_bps);
+
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    ObserverConfig& config = bitrate_observer_configs_[i];
+    uint32_t allocated_bitrate = allocation[i];
+    uint32_t allocated_bandwidth = bandwidth_allocation[i];
     BitrateAllocationUpdate update;
     update.target_bitrate = DataRate::bps(allocated_bitrate);
     update.link_capacity = DataRate::bps(allocated_bandwidth);
     update.packet_loss_ratio = last_fraction_loss_ / 256.0;
     update.round_trip_time = TimeDelta::ms(last_rtt_);
     update.bwe_period = TimeDelta::ms(last_bwe_period_ms_);
+    update.cwnd_reduce_ratio = last_cwnd_reduce_ratio_;
     uint32_t protection_bitrate = config.observer->OnBitrateUpdated(update);
 
     if (allocated_bitrate == 0 && config.allocated_bitrate_bps > 0) {
@@ -169,16 +181,20 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
 
   // Update settings if the observer already exists, create a new one otherwise.
   if (it != bitrate_observer_configs_.end()) {
+    const size_t index = it - bitrate_observer_configs_.begin();
+    RemoveFromSortedState(index);
     it->min_bitrate_bps = config.min_bitrate_bps;
     it->max_bitrate_bps = config.max_bitrate_bps;
     it->pad_up_bitrate_bps = config.pad_up_bitrate_bps;
     it->enforce_min_bitrate = config.enforce_min_bitrate;
     it->bitrate_priority = config.bitrate_priority;
+    AddToSortedState(index);
   } else {
     bitrate_observer_configs_.push_back(ObserverConfig(
         observer, config.min_bitrate_bps, config.max_bitrate_bps,
         config.pad_up_bitrate_bps, config.enforce_min_bitrate, config.track_id,
         config.bitrate_priority, config.has_packet_feedback));
+    AddToSortedState(bitrate_observer_configs_.size() - 1);
   }
 
   if (last_target_bps_ > 0) {
@@ -186,16 +202,20 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
 
     ObserverAllocation allocation = AllocateBitrates(last_target_bps_);
     ObserverAllocation bandwidth_allocation =
-        AllocateBitrates(last_link_capacity_bps_);
-    for (auto& config : bitrate_observer_configs_) {
-      uint32_t allocated_bitrate = allocation[config.observer];
-      uint32_t bandwidth = bandwidth_allocation[config.observer];
+        last_link_capacity_bps_ == last_target_bps_
+            ? allocation
+            : AllocateBitrates(last_link_capacity_bps_);
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      ObserverConfig& config = bitrate_observer_configs_[i];
+      uint32_t allocated_bitrate = allocation[i];
+      uint32_t bandwidth = bandwidth_allocation[i];
       BitrateAllocationUpdate update;
       update.target_bitrate = DataRate::bps(allocated_bitrate);
       update.link_capacity = DataRate::bps(bandwidth);
       update.packet_loss_ratio = last_fraction_loss_ / 256.0;
       update.round_trip_time = TimeDelta::ms(last_rtt_);
       update.bwe_period = TimeDelta::ms(last_bwe_period_ms_);
+      update.cwnd_reduce_ratio = last_cwnd_reduce_ratio_;
       uint32_t protection_bitrate = config.observer->OnBitrateUpdated(update);
       config.allocated_bitrate_bps = allocated_bitrate;
       if (allocated_bitrate > 0)
@@ -212,6 +232,7 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
     update.packet_loss_ratio = last_fraction_loss_ / 256.0;
     update.round_trip_time = TimeDelta::ms(last_rtt_);
     update.bwe_period = TimeDelta::ms(last_bwe_period_ms_);
+    update.cwnd_reduce_ratio = last_cwnd_reduce_ratio_;
     observer->OnBitrateUpdated(update);
   }
   UpdateAllocationLimits();
@@ -279,7 +300,18 @@ void BitrateAllocator::RemoveObserver(BitrateAllocatorObserver* observer) {
 
   auto it = FindObserverConfig(observer);
   if (it != bitrate_observer_configs_.end()) {
+    const size_t index = it - bitrate_observer_configs_.begin();
+    RemoveFromSortedState(index);
     bitrate_observer_configs_.erase(it);
+    // Shift the indices of the configs after the erased one.
+    for (size_t& i : max_bitrate_order_) {
+      if (i > index)
+        --i;
+    }
+    for (size_t& i : relative_capacity_order_) {
+      if (i > index)
+        --i;
+    }
   }
 
   UpdateAllocationLimits();
@@ -331,6 +363,65 @@ BitrateAllocator::FindObserverConfig(const BitrateAllocatorObserver* observer) {
   return bitrate_observer_configs_.end();
 }
 
+void BitrateAllocator::AddToSortedState(size_t index) {
+  const ObserverConfig& config = bitrate_observer_configs_[index];
+  sum_min_bitrates_ += config.min_bitrate_bps;
+  sum_max_bitrates_ += config.max_bitrate_bps;
+  max_bitrate_order_.insert(
+      std::upper_bound(max_bitrate_order_.begin(), max_bitrate_order_.end(),
+                       index,
+                       [this](size_t a, size_t b) {
+                         RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+                         return MaxBitrateLess(a, b);
+                       }),
+      index);
+  relative_capacity_order_.insert(
+      std::upper_bound(relative_capacity_order_.begin(),
+                       relative_capacity_order_.end(), index,
+                       [this](size_t a, size_t b) {
+                         RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+                         return RelativeCapacityLess(a, b);
+                       }),
+      index);
+}
+
+void BitrateAllocator::RemoveFromSortedState(size_t index) {
+  const ObserverConfig& config = bitrate_observer_configs_[index];
+  sum_min_bitrates_ -= config.min_bitrate_bps;
+  sum_max_bitrates_ -= config.max_bitrate_bps;
+  max_bitrate_order_.erase(
+      std::find(max_bitrate_order_.begin(), max_bitrate_order_.end(), index));
+  relative_capacity_order_.erase(std::find(relative_capacity_order_.begin(),
+                                           relative_capacity_order_.end(),
+                                           index));
+}
+
+bool BitrateAllocator::MaxBitrateLess(size_t a, size_t b) const {
+  uint32_t max_bitrate_a = bitrate_observer_configs_[a].max_bitrate_bps;
+  uint32_t max_bitrate_b = bitrate_observer_configs_[b].max_bitrate_bps;
+  return max_bitrate_a < max_bitrate_b ||
+         (max_bitrate_a == max_bitrate_b && a < b);
+}
+
+// We want to sort by which observers will be allocated their full capacity
+// first. By dividing each observer's capacity by its bitrate priority we are
+// "normalizing" the capacity of an observer by the rate it will be filled.
+// This is because the amount allocated is based upon bitrate priority. We
+// allocate twice as much bitrate to an observer with twice the bitrate
+// priority of another.
+bool BitrateAllocator::RelativeCapacityLess(size_t a, size_t b) const {
+  const ObserverConfig& config_a = bitrate_observer_configs_[a];
+  const ObserverConfig& config_b = bitrate_observer_configs_[b];
+  double relative_capacity_a =
+      (config_a.max_bitrate_bps - config_a.min_bitrate_bps) /
+      config_a.bitrate_priority;
+  double relative_capacity_b =
+      (config_b.max_bitrate_bps - config_b.min_bitrate_bps) /
+      config_b.bitrate_priority;
+  return relative_capacity_a < relative_capacity_b ||
+         (relative_capacity_a == relative_capacity_b && a < b);
+}
+
 BitrateAllocator::ObserverAllocation BitrateAllocator::AllocateBitrates(
     uint32_t bitrate) const {
   if (bitrate_observer_configs_.empty())
@@ -347,72 +438,60 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::AllocateBitrates(
             bitrate, std::move(track_configs));
     // The strategy should return allocation for all tracks.
     RTC_CHECK(track_allocations.size() == bitrate_observer_configs_.size());
-    ObserverAllocation allocation;
-    auto track_allocations_it = track_allocations.begin();
-    for (const auto& observer_config : bitrate_observer_configs_) {
-      allocation[observer_config.observer] = *track_allocations_it++;
-    }
-    return allocation;
+    return ObserverAllocation(track_allocations.begin(),
+                              track_allocations.end());
   }
 
   if (bitrate == 0)
     return ZeroRateAllocation();
 
-  uint32_t sum_min_bitrates = 0;
-  uint32_t sum_max_bitrates = 0;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    sum_min_bitrates += observer_config.min_bitrate_bps;
-    sum_max_bitrates += observer_config.max_bitrate_bps;
-  }
-
   // Not enough for all observers to get an allocation, allocate according to:
   // enforced min bitrate -> allocated bitrate previous round -> restart paused
   // streams.
-  if (!EnoughBitrateForAllObservers(bitrate, sum_min_bitrates))
+  if (!EnoughBitrateForAllObservers(bitrate, sum_min_bitrates_))
     return LowRateAllocation(bitrate);
 
   // All observers will get their min bitrate plus a share of the rest. This
   // share is allocated to each observer based on its bitrate_priority.
-  if (bitrate <= sum_max_bitrates)
-    return NormalRateAllocation(bitrate, sum_min_bitrates);
+  if (bitrate <= sum_max_bitrates_)
+    return NormalRateAllocation(bitrate, sum_min_bitrates_);
 
   // All observers will get up to transmission_max_bitrate_multiplier_ x max.
-  return MaxRateAllocation(bitrate, sum_max_bitrates);
+  return MaxRateAllocation(bitrate, sum_max_bitrates_);
 }
 
 BitrateAllocator::ObserverAllocation BitrateAllocator::ZeroRateAllocation()
     const {
-  ObserverAllocation allocation;
-  for (const auto& observer_config : bitrate_observer_configs_)
-    allocation[observer_config.observer] = 0;
-  return allocation;
+  return ObserverAllocation(bitrate_observer_configs_.size(), 0);
 }
 
 BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
     uint32_t bitrate) const {
-  ObserverAllocation allocation;
+  ObserverAllocation allocation(bitrate_observer_configs_.size(), 0);
   // Start by allocating bitrate to observers enforcing a min bitrate, hence
   // remaining_bitrate might turn negative.
   int64_t remaining_bitrate = bitrate;
-  for (const auto& observer_config : bitrate_observer_configs_) {
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    const ObserverConfig& observer_config = bitrate_observer_configs_[i];
     int32_t allocated_bitrate = 0;
     if (observer_config.enforce_min_bitrate)
       allocated_bitrate = observer_config.min_bitrate_bps;
 
-    allocation[observer_config.observer] = allocated_bitrate;
+    allocation[i] = allocated_bitrate;
     remaining_bitrate -= allocated_bitrate;
   }
 
   // Allocate bitrate to all previously active streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : bitrate_observer_configs_) {
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      const ObserverConfig& observer_config = bitrate_observer_configs_[i];
       if (observer_config.enforce_min_bitrate ||
           observer_config.LastAllocatedBitrate() == 0)
         continue;
 
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        allocation[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -420,14 +499,15 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
 
   // Allocate bitrate to previously paused streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : bitrate_observer_configs_) {
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      const ObserverConfig& observer_config = bitrate_observer_configs_[i];
       if (observer_config.LastAllocatedBitrate() != 0)
         continue;
 
       // Add a hysteresis to avoid toggling.
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        allocation[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -452,18 +532,15 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::NormalRateAllocation(
     uint32_t bitrate,
     uint32_t sum_min_bitrates) const {
   ObserverAllocation allocation;
-  ObserverAllocation observers_capacities;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    allocation[observer_config.observer] = observer_config.min_bitrate_bps;
-    observers_capacities[observer_config.observer] =
-        observer_config.max_bitrate_bps - observer_config.min_bitrate_bps;
-  }
+  allocation.reserve(bitrate_observer_configs_.size());
+  for (const auto& observer_config : bitrate_observer_configs_)
+    allocation.push_back(observer_config.min_bitrate_bps);
 
   bitrate -= sum_min_bitrates;
   // From the remaining bitrate, allocate a proportional amount to each observer
   // above the min bitrate already allocated.
   if (bitrate > 0)
-    DistributeBitrateRelatively(bitrate, observers_capacities, &allocation);
+    DistributeBitrateRelatively(bitrate, &allocation);
 
   return allocation;
 }
@@ -472,11 +549,11 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::MaxRateAllocation(
     uint32_t bitrate,
     uint32_t sum_max_bitrates) const {
   ObserverAllocation allocation;
+  allocation.reserve(bitrate_observer_configs_.size());
+  for (const auto& observer_config : bitrate_observer_configs_)
+    allocation.push_back(observer_config.max_bitrate_bps);
 
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    allocation[observer_config.observer] = observer_config.max_bitrate_bps;
-    bitrate -= observer_config.max_bitrate_bps;
-  }
+  bitrate -= sum_max_bitrates;
   DistributeBitrateEvenly(bitrate, true, transmission_max_bitrate_multiplier_,
                           &allocation);
   return allocation;
@@ -514,31 +591,31 @@ void BitrateAllocator::DistributeBitrateEvenly(
     ObserverAllocation* allocation) const {
   RTC_DCHECK_EQ(allocation->size(), bitrate_observer_configs_.size());
 
-  ObserverSortingMap list_max_bitrates;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    if (include_zero_allocations ||
-        allocation->at(observer_config.observer) != 0) {
-      list_max_bitrates.insert(std::pair<uint32_t, const ObserverConfig*>(
-          observer_config.max_bitrate_bps, &observer_config));
-    }
+  // Only the observers visited so far have their allocation changed, so the
+  // ones to skip can be decided on the way.
+  size_t num_remaining_observers = 0;
+  for (int allocated_bitrate : *allocation) {
+    if (include_zero_allocations || allocated_bitrate != 0)
+      ++num_remaining_observers;
   }
-  auto it = list_max_bitrates.begin();
-  while (it != list_max_bitrates.end()) {
+  for (size_t index : max_bitrate_order_) {
+    if (!include_zero_allocations && (*allocation)[index] == 0)
+      continue;
     RTC_DCHECK_GT(bitrate, 0);
+    uint32_t max_bitrate_bps = bitrate_observer_configs_[index].max_bitrate_bps;
     uint32_t extra_allocation =
-        bitrate / static_cast<uint32_t>(list_max_bitrates.size());
-    uint32_t total_allocation =
-        extra_allocation + allocation->at(it->second->observer);
+        bitrate / static_cast<uint32_t>(num_remaining_observers);
+    uint32_t total_allocation = extra_allocation + (*allocation)[index];
     bitrate -= extra_allocation;
-    if (total_allocation > max_multiplier * it->first) {
+    if (total_allocation > max_multiplier * max_bitrate_bps) {
       // There is more than we can fit for this observer, carry over to the
       // remaining observers.
-      bitrate += total_allocation - max_multiplier * it->first;
-      total_allocation = max_multiplier * it->first;
+      bitrate += total_allocation - max_multiplier * max_bitrate_bps;
+      total_allocation = max_multiplier * max_bitrate_bps;
     }
     // Finally, update the allocation for this observer.
-    allocation->at(it->second->observer) = total_allocation;
-    it = list_max_bitrates.erase(it);
+    (*allocation)[index] = total_allocation;
+    --num_remaining_observers;
   }
 }
 
@@ -562,75 +639,44 @@ bool BitrateAllocator::EnoughBitrateForAllObservers(
 
 void BitrateAllocator::DistributeBitrateRelatively(
     uint32_t remaining_bitrate,
-    const ObserverAllocation& observers_capacities,
     ObserverAllocation* allocation) const {
   RTC_DCHECK_EQ(allocation->size(), bitrate_observer_configs_.size());
-  RTC_DCHECK_EQ(observers_capacities.size(), bitrate_observer_configs_.size());
-
-  struct PriorityRateObserverConfig {
-    PriorityRateObserverConfig(BitrateAllocatorObserver* allocation_key,
-                               uint32_t capacity_bps,
-                               double bitrate_priority)
-        : allocation_key(allocation_key),
-          capacity_bps(capacity_bps),
-          bitrate_priority(bitrate_priority) {}
-
-    BitrateAllocatorObserver* allocation_key;
-    // The amount of bitrate bps that can be allocated to this observer.
-    uint32_t capacity_bps;
-    double bitrate_priority;
-
-    // We want to sort by which observers will be allocated their full capacity
-    // first. By dividing each observer's capacity by its bitrate priority we
-    // are "normalizing" the capacity of an observer by the rate it will be
-    // filled. This is because the amount allocated is based upon bitrate
-    // priority. We allocate twice as much bitrate to an observer with twice the
-    // bitrate priority of another.
-    bool operator<(const PriorityRateObserverConfig& other) const {
-      return capacity_bps / bitrate_priority <
-             other.capacity_bps / other.bitrate_priority;
-    }
-  };
 
   double bitrate_priority_sum = 0;
-  std::vector<PriorityRateObserverConfig> priority_rate_observers;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    uint32_t capacity_bps = observers_capacities.at(observer_config.observer);
-    priority_rate_observers.emplace_back(observer_config.observer, capacity_bps,
-                                         observer_config.bitrate_priority);
+  for (const auto& observer_config : bitrate_observer_configs_)
     bitrate_priority_sum += observer_config.bitrate_priority;
-  }
 
   // Iterate in the order observers can be allocated their full capacity.
-  std::sort(priority_rate_observers.begin(), priority_rate_observers.end());
   size_t i;
-  for (i = 0; i < priority_rate_observers.size(); ++i) {
-    const auto& priority_rate_observer = priority_rate_observers[i];
+  for (i = 0; i < relative_capacity_order_.size(); ++i) {
+    const size_t index = relative_capacity_order_[i];
+    const ObserverConfig& observer_config = bitrate_observer_configs_[index];
+    uint32_t capacity_bps =
+        observer_config.max_bitrate_bps - observer_config.min_bitrate_bps;
     // We allocate the full capacity to an observer only if its relative
     // portion from the remaining bitrate is sufficient to allocate its full
     // capacity. This means we aren't greedily allocating the full capacity, but
     // that it is only done when there is also enough bitrate to allocate the
     // proportional amounts to all other observers.
     double observer_share =
-        priority_rate_observer.bitrate_priority / bitrate_priority_sum;
+        observer_config.bitrate_priority / bitrate_priority_sum;
     double allocation_bps = observer_share * remaining_bitrate;
-    bool enough_bitrate = allocation_bps >= priority_rate_observer.capacity_bps;
+    bool enough_bitrate = allocation_bps >= capacity_bps;
     if (!enough_bitrate)
       break;
-    allocation->at(priority_rate_observer.allocation_key) +=
-        priority_rate_observer.capacity_bps;
-    remaining_bitrate -= priority_rate_observer.capacity_bps;
-    bitrate_priority_sum -= priority_rate_observer.bitrate_priority;
+    (*allocation)[index] += capacity_bps;
+    remaining_bitrate -= capacity_bps;
+    bitrate_priority_sum -= observer_config.bitrate_priority;
   }
 
   // From the remaining bitrate, allocate the proportional amounts to the
   // observers that aren't allocated their max capacity.
-  for (; i < priority_rate_observers.size(); ++i) {
-    const auto& priority_rate_observer = priority_rate_observers[i];
+  for (; i < relative_capacity_order_.size(); ++i) {
+    const size_t index = relative_capacity_order_[i];
     double fraction_allocated =
-        priority_rate_observer.bitrate_priority / bitrate_priority_sum;
-    allocation->at(priority_rate_observer.allocation_key) +=
-        fraction_allocated * remaining_bitrate;
+        bitrate_observer_configs_[index].bitrate_priority /
+        bitrate_priority_sum;
+    (*allocation)[index] += fraction_allocated * remaining_bitrate;
   }
 }
 
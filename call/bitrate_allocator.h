@@ -13,7 +13,6 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -107,7 +106,8 @@ class BitrateAllocator : public BitrateAllocatorInterface {
                         uint32_t link_capacity_bps,
                         uint8_t fraction_loss,
                         int64_t rtt,
-                        int64_t bwe_period_ms);
+                        int64_t bwe_period_ms,
+                        double cwnd_reduce_ratio);
 
   // Set the configuration used by the bandwidth management.
   // |observer| updates bitrates if already in use.
@@ -178,8 +178,20 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   ObserverConfigs::iterator FindObserverConfig(
       const BitrateAllocatorObserver* observer) RTC_RUN_ON(&sequenced_checker_);
 
-  typedef std::multimap<uint32_t, const ObserverConfig*> ObserverSortingMap;
-  typedef std::map<BitrateAllocatorObserver*, int> ObserverAllocation;
+  // Updates the bitrate sums and sorted orders below for the config at
+  // |index|, which must be removed before the config is changed or erased and
+  // added again after it has been changed or added.
+  void AddToSortedState(size_t index) RTC_RUN_ON(&sequenced_checker_);
+  void RemoveFromSortedState(size_t index) RTC_RUN_ON(&sequenced_checker_);
+  // Strict orders of config indices, with ties broken by insertion order.
+  bool MaxBitrateLess(size_t a, size_t b) const
+      RTC_RUN_ON(&sequenced_checker_);
+  bool RelativeCapacityLess(size_t a, size_t b) const
+      RTC_RUN_ON(&sequenced_checker_);
+
+  // Allocated bitrate per observer, in the order of
+  // |bitrate_observer_configs_|.
+  typedef std::vector<int> ObserverAllocation;
 
   ObserverAllocation AllocateBitrates(uint32_t bitrate) const
       RTC_RUN_ON(&sequenced_checker_);
@@ -217,14 +229,14 @@ class BitrateAllocator : public BitrateAllocatorInterface {
 
   // From the available |bitrate|, each observer will be allocated a
   // proportional amount based upon its bitrate priority. If that amount is
-  // more than the observer's capacity, it will be allocated its capacity, and
-  // the excess bitrate is still allocated proportionally to other observers.
-  // Allocating the proportional amount means an observer with twice the
-  // bitrate_priority of another will be allocated twice the bitrate.
-  void DistributeBitrateRelatively(
-      uint32_t bitrate,
-      const ObserverAllocation& observers_capacities,
-      ObserverAllocation* allocation) const RTC_RUN_ON(&sequenced_checker_);
+  // more than the observer's capacity, max minus min bitrate, it will be
+  // allocated its capacity, and the excess bitrate is still allocated
+  // proportionally to other observers. Allocating the proportional amount
+  // means an observer with twice the bitrate_priority of another will be
+  // allocated twice the bitrate.
+  void DistributeBitrateRelatively(uint32_t bitrate,
+                                   ObserverAllocation* allocation) const
+      RTC_RUN_ON(&sequenced_checker_);
 
   // Allow packets to be transmitted in up to 2 times max video bitrate if the
   // bandwidth estimate allows it.
@@ -237,12 +249,23 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   LimitObserver* const limit_observer_ RTC_GUARDED_BY(&sequenced_checker_);
   // Stored in a list to keep track of the insertion order.
   ObserverConfigs bitrate_observer_configs_ RTC_GUARDED_BY(&sequenced_checker_);
+  // Kept up to date as observers are added, changed and removed, so that
+  // allocating the bitrate on network changes doesn't need to sort.
+  uint32_t sum_min_bitrates_ RTC_GUARDED_BY(&sequenced_checker_);
+  uint32_t sum_max_bitrates_ RTC_GUARDED_BY(&sequenced_checker_);
+  // Indices into |bitrate_observer_configs_| in the order of MaxBitrateLess,
+  // used by DistributeBitrateEvenly, and of RelativeCapacityLess, used by
+  // DistributeBitrateRelatively.
+  std::vector<size_t> max_bitrate_order_ RTC_GUARDED_BY(&sequenced_checker_);
+  std::vector<size_t> relative_capacity_order_
+      RTC_GUARDED_BY(&sequenced_checker_);
   uint32_t last_target_bps_ RTC_GUARDED_BY(&sequenced_checker_);
   uint32_t last_link_capacity_bps_ RTC_GUARDED_BY(&sequenced_checker_);
   uint32_t last_non_zero_bitrate_bps_ RTC_GUARDED_BY(&sequenced_checker_);
   uint8_t last_fraction_loss_ RTC_GUARDED_BY(&sequenced_checker_);
   int64_t last_rtt_ RTC_GUARDED_BY(&sequenced_checker_);
   int64_t last_bwe_period_ms_ RTC_GUARDED_BY(&sequenced_checker_);
+  double last_cwnd_reduce_ratio_ RTC_GUARDED_BY(&sequenced_checker_);
   // Number of mute events based on too low BWE, not network up/down.
   int num_pause_events_ RTC_GUARDED_BY(&sequenced_checker_);
   Clock* const clock_ RTC_GUARDED_BY(&sequenced_checker_);
@@ -82,7 +82,7 @@ class BitrateAllocatorForTest : public BitrateAllocator {
                         int64_t rtt,
                         int64_t bwe_period_ms) {
     BitrateAllocator::OnNetworkChanged(target_bitrate_bps, target_bitrate_bps,
-                                       fraction_loss, rtt, bwe_period_ms);
+                                       fraction_loss, rtt, bwe_period_ms, 0);
   }
 };
 
@@ -224,6 +224,40 @@ TEST_F(BitrateAllocatorTest, RemoveObserverTriggersLimitObserver) {
   allocator_->RemoveObserver(&bitrate_observer);
 }
 
+TEST_F(BitrateAllocatorTest, AllocatesAfterObserversAreRemovedAndChanged) {
+  TestBitrateObserver bitrate_observer_1;
+  TestBitrateObserver bitrate_observer_2;
+  TestBitrateObserver bitrate_observer_3;
+  AddObserver(&bitrate_observer_1, 100000, 300000, 0, true, "",
+              kDefaultBitratePriority);
+  AddObserver(&bitrate_observer_2, 100000, 200000, 0, true, "",
+              kDefaultBitratePriority);
+  AddObserver(&bitrate_observer_3, 100000, 400000, 0, true, "",
+              kDefaultBitratePriority);
+  allocator_->RemoveObserver(&bitrate_observer_2);
+  // Observer 1 now has the highest max bitrate.
+  AddObserver(&bitrate_observer_1, 100000, 500000, 0, true, "",
+              kDefaultBitratePriority);
+
+  // The 100 kbps above the sum of max bitrates is split evenly, starting with
+  // the observer with the lowest max bitrate.
+  allocator_->OnNetworkChanged(1000000, 0, 0, kDefaultProbingIntervalMs);
+  EXPECT_EQ(550000u, bitrate_observer_1.last_bitrate_bps_);
+  EXPECT_EQ(450000u, bitrate_observer_3.last_bitrate_bps_);
+
+  // Observer 3 has the lowest capacity above its min bitrate, and is the only
+  // one allocated its max.
+  allocator_->OnNetworkChanged(800000, 0, 0, kDefaultProbingIntervalMs);
+  EXPECT_EQ(400000u, bitrate_observer_1.last_bitrate_bps_);
+  EXPECT_EQ(400000u, bitrate_observer_3.last_bitrate_bps_);
+  allocator_->OnNetworkChanged(600000, 0, 0, kDefaultProbingIntervalMs);
+  EXPECT_EQ(300000u, bitrate_observer_1.last_bitrate_bps_);
+  EXPECT_EQ(300000u, bitrate_observer_3.last_bitrate_bps_);
+
+  allocator_->RemoveObserver(&bitrate_observer_1);
+  allocator_->RemoveObserver(&bitrate_observer_3);
+}
+
 class BitrateAllocatorTestNoEnforceMin : public ::testing::Test {
  protected:
   BitrateAllocatorTestNoEnforceMin()
@@ -244,8 +244,8 @@ class Call final : public webrtc::Call,
       RTC_EXCLUSIVE_LOCKS_REQUIRED(receive_crit_);
 
   void NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
-                                 MediaType media_type)
-      RTC_SHARED_LOCKS_REQUIRED(receive_crit_);
+                                 MediaType media_type,
+                                 bool use_send_side_bwe);
 
   void UpdateSendHistograms(int64_t first_sent_packet_ms)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&bitrate_crit_);
@@ -313,8 +313,13 @@ class Call final : public webrtc::Call,
     // send side BWE are negotiated.
     const bool use_send_side_bwe;
   };
+  // Only modified on |configuration_sequence_checker_|, with |receive_crit_|
+  // held for writing. Packets are delivered on that sequence too, so they can
+  // look up the configs without the lock, see FindReceiveRtpConfig.
   std::map<uint32_t, ReceiveRtpConfig> receive_rtp_config_
       RTC_GUARDED_BY(receive_crit_);
+  const ReceiveRtpConfig* FindReceiveRtpConfig(uint32_t ssrc) const
+      RTC_NO_THREAD_SAFETY_ANALYSIS;
 
   std::unique_ptr<RWLockWrapper> send_crit_;
   // Audio and Video send streams are owned by the client that creates them.
@@ -1138,7 +1143,8 @@ void Call::OnTargetTransferRate(TargetTransferRate msg) {
   receive_side_cc_.OnBitrateChanged(target_bitrate_bps);
   bitrate_allocator_->OnNetworkChanged(target_bitrate_bps, bandwidth_bps,
                                        fraction_loss, rtt_ms,
-                                       probing_interval_ms);
+                                       probing_interval_ms,
+                                       msg.cwnd_reduce_ratio);
 
   // Ignore updates if bitrate is zero (the aggregate network state is down).
   if (target_bitrate_bps == 0) {
@@ -1313,9 +1319,12 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
   RTC_DCHECK(media_type == MediaType::AUDIO || media_type == MediaType::VIDEO ||
              is_keep_alive_packet);
 
-  ReadLockScoped read_lock(*receive_crit_);
-  auto it = receive_rtp_config_.find(parsed_packet.Ssrc());
-  if (it == receive_rtp_config_.end()) {
+  // Receive streams are created and destroyed on the sequence that delivers
+  // packets, so a stream can't be torn down while a packet is delivered to
+  // it, and neither the lookup nor the delivery needs |receive_crit_|.
+  const ReceiveRtpConfig* receive_rtp_config =
+      FindReceiveRtpConfig(parsed_packet.Ssrc());
+  if (!receive_rtp_config) {
     RTC_LOG(LS_ERROR) << "receive_rtp_config_ lookup failed for ssrc "
                       << parsed_packet.Ssrc();
     // Destruction of the receive stream, including deregistering from the
@@ -1326,9 +1335,10 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
     // which is being torned down.
     return DELIVERY_UNKNOWN_SSRC;
   }
-  parsed_packet.IdentifyExtensions(it->second.extensions);
+  parsed_packet.IdentifyExtensions(receive_rtp_config->extensions);
 
-  NotifyBweOfReceivedPacket(parsed_packet, media_type);
+  NotifyBweOfReceivedPacket(parsed_packet, media_type,
+                            receive_rtp_config->use_send_side_bwe);
 
   // RateCounters expect input parameter as int, save it as int,
   // instead of converting each time it is passed to RateCounter::Add below.
@@ -1402,12 +1412,15 @@ void Call::OnRecoveredPacket(const uint8_t* packet, size_t length) {
   video_receiver_controller_.OnRtpPacket(parsed_packet);
 }
 
-void Call::NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
-                                     MediaType media_type) {
-  auto it = receive_rtp_config_.find(packet.Ssrc());
-  bool use_send_side_bwe =
-      (it != receive_rtp_config_.end()) && it->second.use_send_side_bwe;
+const Call::ReceiveRtpConfig* Call::FindReceiveRtpConfig(uint32_t ssrc) const {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&configuration_sequence_checker_);
+  auto it = receive_rtp_config_.find(ssrc);
+  return it != receive_rtp_config_.end() ? &it->second : nullptr;
+}
 
+void Call::NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
+                                     MediaType media_type,
+                                     bool use_send_side_bwe) {
   RTPHeader header;
   packet.GetHeader(&header);
 
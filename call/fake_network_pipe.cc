@@ -10,7 +10,6 @@
 
 #include <string.h>
 #include <algorithm>
-#include <queue>
 #include <utility>
 #include <vector>
 
@@ -206,7 +205,7 @@ size_t FakeNetworkPipe::SentPackets() {
 
 void FakeNetworkPipe::Process() {
   int64_t time_now_us;
-  std::queue<NetworkPacket> packets_to_deliver;
+  std::vector<NetworkPacket> packets_to_deliver;
   {
     rtc::CritScope crit(&process_lock_);
     time_now_us = clock_->TimeInMicroseconds();
@@ -223,6 +222,7 @@ void FakeNetworkPipe::Process() {
 
     std::vector<PacketDeliveryInfo> delivery_infos =
         network_behavior_->DequeueDeliverablePackets(time_now_us);
+    packets_to_deliver.reserve(delivery_infos.size());
     for (auto& delivery_info : delivery_infos) {
       // In the common case where no reordering happens, find will return early
       // as the first packet will be a match.
@@ -250,7 +250,7 @@ void FakeNetworkPipe::Process() {
         int64_t added_delay_us =
             delivery_info.receive_time_us - packet.send_time();
         packet.IncrementArrivalTime(added_delay_us);
-        packets_to_deliver.emplace(std::move(packet));
+        packets_to_deliver.emplace_back(std::move(packet));
         // |time_now_us| might be later than when the packet should have
         // arrived, due to NetworkProcess being called too late. For stats, use
         // the time it should have been on the link.
@@ -263,11 +263,8 @@ void FakeNetworkPipe::Process() {
   }
 
   rtc::CritScope crit(&config_lock_);
-  while (!packets_to_deliver.empty()) {
-    NetworkPacket packet = std::move(packets_to_deliver.front());
-    packets_to_deliver.pop();
+  for (NetworkPacket& packet : packets_to_deliver)
     DeliverNetworkPacket(&packet);
-  }
 }
 
 void FakeNetworkPipe::DeliverNetworkPacket(NetworkPacket* packet) {
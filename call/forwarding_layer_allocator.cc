@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/forwarding_layer_allocator.h"
+
+#include <algorithm>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Fraction of the bitrate of a higher layer that must be available in
+// addition to the bitrate increase, before upgrading to it.
+constexpr double kUpgradeMargin = 0.1;
+// A source is not upgraded for this long after it was downgraded.
+constexpr TimeDelta kUpgradeHoldTime = TimeDelta::Seconds<2>();
+
+}  // namespace
+
+ForwardingLayerAllocator::ForwardingLayerAllocator(
+    LayerSelectionObserver* observer)
+    : observer_(observer) {
+  RTC_DCHECK(observer_);
+  sequenced_checker_.Detach();
+}
+
+ForwardingLayerAllocator::~ForwardingLayerAllocator() = default;
+
+void ForwardingLayerAllocator::AddOrUpdateSource(uint32_t source_id,
+                                                 const SourceConfig& config) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  RTC_DCHECK_GT(config.priority, 0);
+  auto it = sources_.find(source_id);
+  if (it == sources_.end()) {
+    sources_.emplace(source_id, Source(config));
+  } else {
+    it->second.config = config;
+  }
+  Allocate();
+}
+
+void ForwardingLayerAllocator::RemoveSource(uint32_t source_id) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  if (sources_.erase(source_id) > 0)
+    Allocate();
+}
+
+void ForwardingLayerAllocator::OnTargetTransferRate(TargetTransferRate msg) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  target_rate_ = msg.target_rate;
+  last_update_time_ = msg.at_time;
+  Allocate();
+}
+
+absl::optional<size_t> ForwardingLayerAllocator::GetSelectedLayer(
+    uint32_t source_id) const {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  auto it = sources_.find(source_id);
+  if (it == sources_.end())
+    return absl::nullopt;
+  return it->second.selected_layer;
+}
+
+DataRate ForwardingLayerAllocator::allocated_bitrate() const {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  return allocated_bitrate_;
+}
+
+void ForwardingLayerAllocator::Allocate() {
+  if (!target_rate_)
+    return;
+
+  // Sources in order of decreasing priority. The sort is stable, so sources
+  // of equal priority stay in order of their ids.
+  std::vector<std::pair<const uint32_t, Source>*> sources;
+  sources.reserve(sources_.size());
+  for (auto& kv : sources_)
+    sources.push_back(&kv);
+  std::stable_sort(sources.begin(), sources.end(),
+                   [](const std::pair<const uint32_t, Source>* a,
+                      const std::pair<const uint32_t, Source>* b) {
+                     return a->second.config.priority >
+                            b->second.config.priority;
+                   });
+
+  std::vector<absl::optional<size_t>> layers(sources.size());
+  DataRate remaining = *target_rate_;
+  // Selects |layer| for source |i| if it fits in the remaining bitrate.
+  const auto try_select = [&](size_t i, size_t layer) {
+    const Source& source = sources[i]->second;
+    const std::vector<DataRate>& bitrates = source.config.layer_bitrates;
+    if (layer >= bitrates.size())
+      return false;
+    const DataRate current =
+        layers[i] ? bitrates[*layers[i]] : DataRate::Zero();
+    DataRate needed = bitrates[layer];
+    if (!source.selected_layer || layer > *source.selected_layer) {
+      if (last_update_time_ - source.last_downgrade_time < kUpgradeHoldTime)
+        return false;
+      needed += bitrates[layer] * kUpgradeMargin;
+    }
+    if (needed > remaining + current)
+      return false;
+    remaining = remaining + current - bitrates[layer];
+    layers[i] = layer;
+    return true;
+  };
+
+  for (size_t i = 0; i < sources.size(); ++i)
+    try_select(i, 0);
+
+  for (size_t begin = 0; begin < sources.size();) {
+    // Sources [begin, end) have the same priority.
+    size_t end = begin + 1;
+    while (end < sources.size() && sources[end]->second.config.priority ==
+                                       sources[begin]->second.config.priority) {
+      ++end;
+    }
+    bool upgraded;
+    do {
+      upgraded = false;
+      for (size_t i = begin; i < end; ++i) {
+        if (layers[i] && try_select(i, *layers[i] + 1))
+          upgraded = true;
+      }
+    } while (upgraded);
+    begin = end;
+  }
+
+  allocated_bitrate_ = *target_rate_ - remaining;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    Source& source = sources[i]->second;
+    if (layers[i] == source.selected_layer)
+      continue;
+    if (!layers[i] ||
+        (source.selected_layer && *layers[i] < *source.selected_layer)) {
+      source.last_downgrade_time = last_update_time_;
+    }
+    source.selected_layer = layers[i];
+    observer_->OnLayerSelected(sources[i]->first, layers[i]);
+  }
+}
+
+}  // namespace webrtc
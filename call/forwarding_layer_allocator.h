@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_FORWARDING_LAYER_ALLOCATOR_H_
+#define CALL_FORWARDING_LAYER_ALLOCATOR_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_control.h"
+#include "api/units/data_rate.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/sequenced_task_checker.h"
+
+namespace webrtc {
+
+class LayerSelectionObserver {
+ public:
+  // Called when another layer of the source is to be forwarded. |layer|
+  // indexes the layer bitrates of the source, nullopt means that the source
+  // is not forwarded at all.
+  virtual void OnLayerSelected(uint32_t source_id,
+                               absl::optional<size_t> layer) = 0;
+
+ protected:
+  virtual ~LayerSelectionObserver() = default;
+};
+
+// Chooses which simulcast stream or SVC layer of each of many remote senders a
+// forwarding server (SFU) sends to one receiver, within the bandwidth
+// estimated for the link to that receiver. Register it as the target transfer
+// rate observer of the RtpTransportControllerSend of the receiver, which runs
+// GoogCC on the feedback of the receiver.
+//
+// Every source first gets its lowest layer, in order of priority. Then the
+// sources of the highest priority are upgraded one layer at a time, taking
+// turns, before those of the next priority, until nothing more fits. To avoid
+// switching back and forth, a source is upgraded only if its new layer fits
+// with a margin, and not shortly after it was downgraded, while it keeps its
+// current layer as long as that fits.
+//
+// Must be used on a single sequence, on which the observer is called.
+class ForwardingLayerAllocator : public TargetTransferRateObserver {
+ public:
+  struct SourceConfig {
+    // Sources of higher priority, e.g. the current speaker, are upgraded
+    // first.
+    double priority = 1.0;
+    // Bitrate needed to forward each layer, from the lowest quality to the
+    // highest. For simulcast this is the bitrate of the stream, for SVC the
+    // sum of the bitrates of the layer and the layers it depends on.
+    std::vector<DataRate> layer_bitrates;
+  };
+
+  explicit ForwardingLayerAllocator(LayerSelectionObserver* observer);
+  ~ForwardingLayerAllocator() override;
+
+  // Adds a source, or updates it, e.g. as the measured layer bitrates change.
+  void AddOrUpdateSource(uint32_t source_id, const SourceConfig& config);
+  void RemoveSource(uint32_t source_id);
+
+  // Implements TargetTransferRateObserver. Nothing is forwarded before the
+  // first call.
+  void OnTargetTransferRate(TargetTransferRate msg) override;
+
+  absl::optional<size_t> GetSelectedLayer(uint32_t source_id) const;
+  // Sum of the bitrates of the selected layers.
+  DataRate allocated_bitrate() const;
+
+ private:
+  struct Source {
+    explicit Source(const SourceConfig& config) : config(config) {}
+
+    SourceConfig config;
+    absl::optional<size_t> selected_layer;
+    Timestamp last_downgrade_time = Timestamp::MinusInfinity();
+  };
+
+  void Allocate() RTC_RUN_ON(&sequenced_checker_);
+
+  rtc::SequencedTaskChecker sequenced_checker_;
+  LayerSelectionObserver* const observer_;
+  std::map<uint32_t, Source> sources_ RTC_GUARDED_BY(&sequenced_checker_);
+  absl::optional<DataRate> target_rate_ RTC_GUARDED_BY(&sequenced_checker_);
+  Timestamp last_update_time_ RTC_GUARDED_BY(&sequenced_checker_) =
+      Timestamp::MinusInfinity();
+  DataRate allocated_bitrate_ RTC_GUARDED_BY(&sequenced_checker_) =
+      DataRate::Zero();
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_FORWARDING_LAYER_ALLOCATOR_H_
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/forwarding_layer_allocator.h"
+
+#include <map>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+// Three simulcast streams of 150, 500 and 1500 kbps.
+ForwardingLayerAllocator::SourceConfig SimulcastSource(double priority) {
+  ForwardingLayerAllocator::SourceConfig config;
+  config.priority = priority;
+  config.layer_bitrates = {DataRate::kbps(150), DataRate::kbps(500),
+                           DataRate::kbps(1500)};
+  return config;
+}
+
+class LayerRecorder : public LayerSelectionObserver {
+ public:
+  void OnLayerSelected(uint32_t source_id,
+                       absl::optional<size_t> layer) override {
+    layers[source_id] = layer;
+    ++num_changes;
+  }
+
+  std::map<uint32_t, absl::optional<size_t>> layers;
+  int num_changes = 0;
+};
+
+class ForwardingLayerAllocatorTest : public ::testing::Test {
+ protected:
+  ForwardingLayerAllocatorTest() : allocator_(&observer_) {}
+
+  void SetTargetRate(int kbps) {
+    TargetTransferRate msg;
+    msg.at_time = now_;
+    msg.target_rate = DataRate::kbps(kbps);
+    allocator_.OnTargetTransferRate(msg);
+  }
+
+  LayerRecorder observer_;
+  ForwardingLayerAllocator allocator_;
+  Timestamp now_ = Timestamp::seconds(100);
+};
+
+}  // namespace
+
+TEST_F(ForwardingLayerAllocatorTest, ForwardsNothingWithoutEstimate) {
+  allocator_.AddOrUpdateSource(1, SimulcastSource(1.0));
+  EXPECT_FALSE(allocator_.GetSelectedLayer(1));
+  EXPECT_EQ(0, observer_.num_changes);
+}
+
+TEST_F(ForwardingLayerAllocatorTest, GivesAllSourcesLowestLayerFirst) {
+  allocator_.AddOrUpdateSource(1, SimulcastSource(1.0));
+  allocator_.AddOrUpdateSource(2, SimulcastSource(1.0));
+  allocator_.AddOrUpdateSource(3, SimulcastSource(1.0));
+  SetTargetRate(700);
+  // 3 * 150 kbps leaves too little to upgrade any source to 500 kbps.
+  EXPECT_THAT(observer_.layers, ElementsAre(Pair(1u, 0u), Pair(2u, 0u),
+                                            Pair(3u, 0u)));
+  EXPECT_EQ(DataRate::kbps(450), allocator_.allocated_bitrate());
+}
+
+TEST_F(ForwardingLayerAllocatorTest, DropsLowestPrioritySourcesFirst) {
+  allocator_.AddOrUpdateSource(1, SimulcastSource(1.0));
+  allocator_.AddOrUpdateSource(2, SimulcastSource(2.0));
+  allocator_.AddOrUpdateSource(3, SimulcastSource(1.0));
+  SetTargetRate(350);
+  // Sources of equal priority are served in order of their ids.
+  EXPECT_THAT(observer_.layers, ElementsAre(Pair(1u, 0u), Pair(2u, 0u)));
+  EXPECT_FALSE(allocator_.GetSelectedLayer(3));
+}
+
+TEST_F(ForwardingLayerAllocatorTest, UpgradesHighestPriorityFirst) {
+  allocator_.AddOrUpdateSource(1, SimulcastSource(1.0));
+  allocator_.AddOrUpdateSource(2, SimulcastSource(2.0));
+  SetTargetRate(2000);
+  // Source 2 gets its highest layer, which leaves room for only the lowest
+  // layer of source 1.
+  EXPECT_EQ(2u, allocator_.GetSelectedLayer(2));
+  EXPECT_EQ(0u, allocator_.GetSelectedLayer(1));
+
+  // Equal priorities take turns.
+  allocator_.AddOrUpdateSource(2, SimulcastSource(1.0));
+  SetTargetRate(1500);
+  EXPECT_EQ(1u, allocator_.GetSelectedLayer(1));
+  EXPECT_EQ(1u, allocator_.GetSelectedLayer(2));
+}
+
+TEST_F(ForwardingLayerAllocatorTest, UpgradesOnlyWithMargin) {
+  allocator_.AddOrUpdateSource(1, SimulcastSource(1.0));
+  SetTargetRate(520);
+  EXPECT_EQ(0u, allocator_.GetSelectedLayer(1));
+  SetTargetRate(560);
+  EXPECT_EQ(1u, allocator_.GetSelectedLayer(1));
+  // Once upgraded, the layer is kept while it fits without the margin.
+  SetTargetRate(510);
+  EXPECT_EQ(1u, allocator_.GetSelectedLayer(1));
+  EXPECT_EQ(2, observer_.num_changes);
+}
+
+TEST_F(ForwardingLayerAllocatorTest, HoldsUpgradeAfterDowngrade) {
+  allocator_.AddOrUpdateSource(1, SimulcastSource(1.0));
+  SetTargetRate(2000);
+  EXPECT_EQ(2u, allocator_.GetSelectedLayer(1));
+
+  now_ += TimeDelta::ms(100);
+  SetTargetRate(1000);
+  EXPECT_EQ(1u, allocator_.GetSelectedLayer(1));
+
+  now_ += TimeDelta::ms(1000);
+  SetTargetRate(2000);
+  EXPECT_EQ(1u, allocator_.GetSelectedLayer(1));
+
+  now_ += TimeDelta::ms(1000);
+  SetTargetRate(2000);
+  EXPECT_EQ(2u, allocator_.GetSelectedLayer(1));
+}
+
+TEST_F(ForwardingLayerAllocatorTest, ReallocatesWhenSourcesChange) {
+  allocator_.AddOrUpdateSource(1, SimulcastSource(1.0));
+  allocator_.AddOrUpdateSource(2, SimulcastSource(1.0));
+  SetTargetRate(1800);
+  EXPECT_EQ(1u, allocator_.GetSelectedLayer(1));
+  EXPECT_EQ(1u, allocator_.GetSelectedLayer(2));
+
+  allocator_.RemoveSource(2);
+  EXPECT_EQ(2u, allocator_.GetSelectedLayer(1));
+  EXPECT_FALSE(allocator_.GetSelectedLayer(2));
+
+  // Higher measured layer bitrates no longer fit.
+  ForwardingLayerAllocator::SourceConfig config = SimulcastSource(1.0);
+  config.layer_bitrates[2] = DataRate::kbps(2500);
+  allocator_.AddOrUpdateSource(1, config);
+  EXPECT_EQ(1u, allocator_.GetSelectedLayer(1));
+  EXPECT_EQ(DataRate::kbps(500), allocator_.allocated_bitrate());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/rtcp_coalescing_transport.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/utility/include/process_thread.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Time until Process() when nothing is pending.
+constexpr int64_t kIdleProcessIntervalMs = 1000;
+
+}  // namespace
+
+RtcpCoalescingTransport::RtcpCoalescingTransport(Transport* transport,
+                                                 Clock* clock,
+                                                 size_t max_packet_size,
+                                                 int64_t max_delay_ms)
+    : transport_(transport),
+      clock_(clock),
+      max_packet_size_(max_packet_size),
+      max_delay_ms_(max_delay_ms) {
+  RTC_DCHECK(transport_);
+  RTC_DCHECK(clock_);
+  RTC_DCHECK_GE(max_delay_ms_, 0);
+  // Allocated once, since packets are at most |max_packet_size_| long.
+  pending_.EnsureCapacity(max_packet_size_);
+}
+
+RtcpCoalescingTransport::~RtcpCoalescingTransport() {
+  Flush();
+}
+
+bool RtcpCoalescingTransport::SendRtp(const uint8_t* packet,
+                                      size_t length,
+                                      const PacketOptions& options) {
+  return transport_->SendRtp(packet, length, options);
+}
+
+bool RtcpCoalescingTransport::SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                                            const PacketOptions& options) {
+  return transport_->SendRtpBuffer(std::move(packet), options);
+}
+
+bool RtcpCoalescingTransport::SendRtcp(const uint8_t* packet, size_t length) {
+  bool first_pending = false;
+  {
+    rtc::CritScope cs(&crit_);
+    if (pending_.size() + length > max_packet_size_)
+      FlushLocked();
+    if (length >= max_packet_size_ || max_delay_ms_ == 0)
+      return transport_->SendRtcp(packet, length);
+    if (pending_.empty()) {
+      flush_time_ms_ = clock_->TimeInMilliseconds() + max_delay_ms_;
+      first_pending = true;
+    }
+    pending_.AppendData(packet, length);
+  }
+  if (first_pending) {
+    // Let the process thread ask for the new flush time.
+    rtc::CritScope cs(&process_thread_lock_);
+    if (process_thread_)
+      process_thread_->WakeUp(this);
+  }
+  return true;
+}
+
+void RtcpCoalescingTransport::Flush() {
+  rtc::CritScope cs(&crit_);
+  FlushLocked();
+}
+
+int64_t RtcpCoalescingTransport::TimeUntilNextProcess() {
+  rtc::CritScope cs(&crit_);
+  if (pending_.empty())
+    return kIdleProcessIntervalMs;
+  return std::max<int64_t>(flush_time_ms_ - clock_->TimeInMilliseconds(), 0);
+}
+
+void RtcpCoalescingTransport::Process() {
+  rtc::CritScope cs(&crit_);
+  if (!pending_.empty() && clock_->TimeInMilliseconds() >= flush_time_ms_)
+    FlushLocked();
+}
+
+void RtcpCoalescingTransport::ProcessThreadAttached(
+    ProcessThread* process_thread) {
+  rtc::CritScope cs(&process_thread_lock_);
+  process_thread_ = process_thread;
+}
+
+void RtcpCoalescingTransport::FlushLocked() {
+  if (pending_.empty())
+    return;
+  transport_->SendRtcp(pending_.data(), pending_.size());
+  pending_.Clear();
+}
+
+}  // namespace webrtc
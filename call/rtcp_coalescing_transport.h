@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_RTCP_COALESCING_TRANSPORT_H_
+#define CALL_RTCP_COALESCING_TRANSPORT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/call/transport.h"
+#include "modules/include/module.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class Clock;
+
+// Sends the RTCP packets of all RTP modules, i.e. streams, on one network
+// transport in as few datagrams as possible. Compound packets handed to
+// SendRtcp(), e.g. receiver reports, NACK, PLI, REMB and XR from RTCPSender
+// and transport-cc feedback from the RemoteEstimatorProxy through the
+// PacketRouter, are concatenated, which still is a valid compound packet
+// (RFC 3550, section 6.1), up to |max_packet_size| bytes. The pending packets
+// are sent at the latest |max_delay_ms| after the first of them, from
+// Process(), or when the next packet would not fit. With many streams on a
+// transport this cuts the number of RTCP packets sent, and of SRTCP
+// protections made.
+//
+// RTP packets are passed through. Register the object with a ProcessThread,
+// and use it as the Transport of the RTP modules of the transport.
+class RtcpCoalescingTransport : public Transport, public Module {
+ public:
+  RtcpCoalescingTransport(Transport* transport,
+                          Clock* clock,
+                          size_t max_packet_size,
+                          int64_t max_delay_ms);
+  ~RtcpCoalescingTransport() override;
+
+  // Implements Transport.
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override;
+  bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                     const PacketOptions& options) override;
+  // Returns true if the packet is queued or sent. Since sending is deferred,
+  // failing to send queued packets is not reported.
+  bool SendRtcp(const uint8_t* packet, size_t length) override;
+
+  // Sends the pending RTCP packets now.
+  void Flush();
+
+  // Implements Module.
+  int64_t TimeUntilNextProcess() override;
+  void Process() override;
+  void ProcessThreadAttached(ProcessThread* process_thread) override;
+
+ private:
+  void FlushLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  Transport* const transport_;
+  Clock* const clock_;
+  const size_t max_packet_size_;
+  const int64_t max_delay_ms_;
+
+  // Held while sending, to keep the RTCP packets in order.
+  rtc::CriticalSection crit_;
+  rtc::Buffer pending_ RTC_GUARDED_BY(crit_);
+  int64_t flush_time_ms_ RTC_GUARDED_BY(crit_) = 0;
+
+  rtc::CriticalSection process_thread_lock_;
+  ProcessThread* process_thread_ RTC_GUARDED_BY(process_thread_lock_) =
+      nullptr;
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_RTCP_COALESCING_TRANSPORT_H_
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/rtcp_coalescing_transport.h"
+
+#include <vector>
+
+#include "modules/utility/include/mock/mock_process_thread.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/mock_transport.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::ElementsAreArray;
+using ::testing::Invoke;
+using ::testing::Return;
+
+constexpr size_t kMaxPacketSize = 100;
+constexpr int64_t kMaxDelayMs = 5;
+
+class RtcpCoalescingTransportTest : public ::testing::Test {
+ protected:
+  RtcpCoalescingTransportTest()
+      : clock_(1000),
+        coalescer_(&transport_, &clock_, kMaxPacketSize, kMaxDelayMs) {
+    ON_CALL(transport_, SendRtcp(_, _))
+        .WillByDefault(Invoke([this](const uint8_t* data, size_t length) {
+          sent_.emplace_back(data, data + length);
+          return true;
+        }));
+    EXPECT_CALL(transport_, SendRtcp(_, _)).Times(::testing::AnyNumber());
+  }
+
+  // Sends a packet of |length| bytes with the value |value|.
+  void SendRtcp(size_t length, uint8_t value) {
+    std::vector<uint8_t> packet(length, value);
+    EXPECT_TRUE(coalescer_.SendRtcp(packet.data(), packet.size()));
+  }
+
+  SimulatedClock clock_;
+  MockTransport transport_;
+  std::vector<std::vector<uint8_t>> sent_;
+  RtcpCoalescingTransport coalescer_;
+};
+
+}  // namespace
+
+TEST_F(RtcpCoalescingTransportTest, CoalescesPacketsUntilMaxDelay) {
+  EXPECT_EQ(1000, coalescer_.TimeUntilNextProcess());
+  SendRtcp(20, 1);
+  EXPECT_EQ(kMaxDelayMs, coalescer_.TimeUntilNextProcess());
+  clock_.AdvanceTimeMilliseconds(2);
+  SendRtcp(30, 2);
+  EXPECT_EQ(kMaxDelayMs - 2, coalescer_.TimeUntilNextProcess());
+
+  coalescer_.Process();
+  EXPECT_TRUE(sent_.empty());
+
+  clock_.AdvanceTimeMilliseconds(kMaxDelayMs - 2);
+  EXPECT_EQ(0, coalescer_.TimeUntilNextProcess());
+  coalescer_.Process();
+  ASSERT_EQ(1u, sent_.size());
+  std::vector<uint8_t> expected(20, 1);
+  expected.insert(expected.end(), 30, 2);
+  EXPECT_THAT(sent_[0], ElementsAreArray(expected));
+  EXPECT_EQ(1000, coalescer_.TimeUntilNextProcess());
+}
+
+TEST_F(RtcpCoalescingTransportTest, FlushesWhenPacketDoesNotFit) {
+  SendRtcp(60, 1);
+  SendRtcp(40, 2);
+  EXPECT_TRUE(sent_.empty());
+  SendRtcp(10, 3);
+  ASSERT_EQ(1u, sent_.size());
+  EXPECT_EQ(100u, sent_[0].size());
+
+  // A packet of the maximum size is sent right away, after the pending ones.
+  SendRtcp(kMaxPacketSize, 4);
+  ASSERT_EQ(3u, sent_.size());
+  EXPECT_THAT(sent_[1], ElementsAreArray(std::vector<uint8_t>(10, 3)));
+  EXPECT_EQ(kMaxPacketSize, sent_[2].size());
+}
+
+TEST_F(RtcpCoalescingTransportTest, WakesUpProcessThreadForFirstPacket) {
+  MockProcessThread process_thread;
+  coalescer_.ProcessThreadAttached(&process_thread);
+  EXPECT_CALL(process_thread, WakeUp(&coalescer_)).Times(1);
+  SendRtcp(10, 1);
+  SendRtcp(10, 2);
+  coalescer_.ProcessThreadAttached(nullptr);
+}
+
+TEST_F(RtcpCoalescingTransportTest, PassesRtpThroughAndFlushesOnDestruction) {
+  MockTransport transport;
+  std::vector<uint8_t> packet(10);
+  {
+    RtcpCoalescingTransport coalescer(&transport, &clock_, kMaxPacketSize,
+                                      kMaxDelayMs);
+    EXPECT_CALL(transport, SendRtp(packet.data(), packet.size(), _))
+        .WillOnce(Return(true));
+    EXPECT_TRUE(coalescer.SendRtp(packet.data(), packet.size(),
+                                  PacketOptions()));
+    EXPECT_TRUE(coalescer.SendRtcp(packet.data(), packet.size()));
+    EXPECT_CALL(transport, SendRtcp(_, packet.size())).WillOnce(Return(true));
+  }
+}
+
+}  // namespace webrtc
@@ -187,8 +187,13 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
 
   std::string* mid = nullptr;
   if (has_mid) {
-    mid_by_ssrc_[ssrc] = packet_mid;
-    mid = &packet_mid;
+    // Most packets carry the MID that is already latched for their SSRC, so
+    // only write it when it changes.
+    std::string& latched_mid = mid_by_ssrc_[ssrc];
+    if (latched_mid != packet_mid) {
+      latched_mid = packet_mid;
+    }
+    mid = &latched_mid;
   } else {
     // If the packet does not include a MID header extension, check if there is
     // a latched MID for the SSRC.
@@ -200,8 +205,11 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
 
   std::string* rsid = nullptr;
   if (has_rsid) {
-    rsid_by_ssrc_[ssrc] = packet_rsid;
-    rsid = &packet_rsid;
+    std::string& latched_rsid = rsid_by_ssrc_[ssrc];
+    if (latched_rsid != packet_rsid) {
+      latched_rsid = packet_rsid;
+    }
+    rsid = &latched_rsid;
   } else {
     // If the packet does not include an RRID/RSID header extension, check if
     // there is a latched RSID for the SSRC.
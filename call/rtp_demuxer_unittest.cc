@@ -13,6 +13,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "call/ssrc_binding_observer.h"
@@ -1477,6 +1478,44 @@ TEST_F(RtpDemuxerTest, MaliciousPeerCannotCauseMemoryOveruse) {
   }
 }
 
+class CountingRtpPacketSink : public RtpPacketSinkInterface {
+ public:
+  void OnRtpPacket(const RtpPacketReceived& packet) override { ++count_; }
+  int count() const { return count_; }
+
+ private:
+  int count_ = 0;
+};
+
+// Demuxes packets round robin over many streams, half of them bound by SSRC
+// and half by a MID the packets carry.
+TEST_F(RtpDemuxerTest, DISABLED_PerformanceDemuxManyStreams) {
+  constexpr int kNumStreams = 500;
+  constexpr int kNumRounds = 2000;
+  std::vector<CountingRtpPacketSink> sinks(kNumStreams);
+  std::vector<std::unique_ptr<RtpPacketReceived>> packets;
+  for (int i = 0; i < kNumStreams; ++i) {
+    uint32_t ssrc = 1000 + 7919 * i;
+    if (i % 2 == 0) {
+      ASSERT_TRUE(AddSinkOnlySsrc(ssrc, &sinks[i]));
+      packets.push_back(CreatePacketWithSsrc(ssrc));
+    } else {
+      const std::string mid = std::to_string(i);
+      ASSERT_TRUE(AddSinkOnlyMid(mid, &sinks[i]));
+      packets.push_back(CreatePacketWithSsrcMid(ssrc, mid));
+    }
+  }
+
+  for (int round = 0; round < kNumRounds; ++round) {
+    for (const auto& packet : packets) {
+      demuxer_.OnRtpPacket(*packet);
+    }
+  }
+  for (const CountingRtpPacketSink& sink : sinks) {
+    EXPECT_EQ(kNumRounds, sink.count());
+  }
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 TEST_F(RtpDemuxerTest, CriteriaMustBeNonEmpty) {
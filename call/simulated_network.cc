@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <utility>
 
 #include "api/units/data_rate.h"
@@ -61,20 +62,19 @@ void SimulatedNetwork::PauseTransmissionUntil(int64_t until_us) {
 }
 
 bool SimulatedNetwork::EnqueuePacket(PacketInFlightInfo packet) {
-  Config config;
-  {
-    rtc::CritScope crit(&config_lock_);
-    config = config_;
-  }
   rtc::CritScope crit(&process_lock_);
-  if (config.queue_length_packets > 0 &&
-      capacity_link_.size() >= config.queue_length_packets) {
-    // Too many packet on the link, drop this one.
-    return false;
-  }
+  Config config;
   int64_t network_start_time_us = packet.send_time_us;
   {
+    // Take the config lock once per packet, high packet rates through many
+    // links otherwise spend a noticeable time contending for it.
     rtc::CritScope crit(&config_lock_);
+    if (config_.queue_length_packets > 0 &&
+        capacity_link_.size() >= config_.queue_length_packets) {
+      // Too many packet on the link, drop this one.
+      return false;
+    }
+    config = config_;
     if (reset_capacity_delay_error_) {
       capacity_delay_error_bytes_ = 0;
       reset_capacity_delay_error_ = false;
@@ -133,7 +133,6 @@ std::vector<PacketDeliveryInfo> SimulatedNetwork::DequeueDeliverablePackets(
     if (!capacity_link_.empty()) {
       int64_t last_arrival_time_us =
           delay_link_.empty() ? -1 : delay_link_.back().arrival_time_us;
-      bool needs_sort = false;
       while (!capacity_link_.empty() &&
              time_now_us >= capacity_link_.front().arrival_time_us) {
         // Time to get this packet.
@@ -166,30 +165,32 @@ std::vector<PacketDeliveryInfo> SimulatedNetwork::DequeueDeliverablePackets(
         packet.arrival_time_us += arrival_time_jitter_us;
         if (packet.arrival_time_us >= last_arrival_time_us) {
           last_arrival_time_us = packet.arrival_time_us;
+          delay_link_.emplace_back(std::move(packet));
         } else {
-          needs_sort = true;
+          // The packet overtakes packets already on the link. Insert it in
+          // place rather than sorting the whole link, reordered packets
+          // usually land close to the back.
+          auto it = std::upper_bound(
+              delay_link_.begin(), delay_link_.end(), packet.arrival_time_us,
+              [](int64_t arrival_time_us, const PacketInfo& p) {
+                return arrival_time_us < p.arrival_time_us;
+              });
+          delay_link_.insert(it, std::move(packet));
         }
-        delay_link_.emplace_back(std::move(packet));
-      }
-
-      if (needs_sort) {
-        // Packet(s) arrived out of order, make sure list is sorted.
-        std::sort(delay_link_.begin(), delay_link_.end(),
-                  [](const PacketInfo& p1, const PacketInfo& p2) {
-                    return p1.arrival_time_us < p2.arrival_time_us;
-                  });
       }
     }
 
+    // Check the extra delay queue. All deliverable packets are handed out as
+    // one batch.
+    auto end = std::find_if(delay_link_.begin(), delay_link_.end(),
+                            [time_now_us](const PacketInfo& p) {
+                              return p.arrival_time_us > time_now_us;
+                            });
     std::vector<PacketDeliveryInfo> packets_to_deliver;
-    // Check the extra delay queue.
-    while (!delay_link_.empty() &&
-           time_now_us >= delay_link_.front().arrival_time_us) {
-      PacketInfo packet_info = delay_link_.front();
-      packets_to_deliver.emplace_back(
-          PacketDeliveryInfo(packet_info.packet, packet_info.arrival_time_us));
-      delay_link_.pop_front();
-    }
+    packets_to_deliver.reserve(std::distance(delay_link_.begin(), end));
+    for (auto it = delay_link_.begin(); it != end; ++it)
+      packets_to_deliver.emplace_back(it->packet, it->arrival_time_us);
+    delay_link_.erase(delay_link_.begin(), end);
     return packets_to_deliver;
   }
 }
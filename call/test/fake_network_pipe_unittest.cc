@@ -368,6 +368,34 @@ TEST_F(FakeNetworkPipeTest, DisallowReorderingThenAllowReordering) {
   EXPECT_TRUE(reordering_has_occured);
 }
 
+// Reordered packets are delivered in batches sorted by arrival time.
+TEST(SimulatedNetworkTest, DeliversReorderedPacketsByArrivalTime) {
+  BuiltInNetworkBehaviorConfig config;
+  config.queue_delay_ms = 100;
+  config.delay_standard_deviation_ms = 50;
+  config.allow_reordering = true;
+  SimulatedNetwork network(config);
+
+  const size_t kNumPackets = 1000;
+  for (size_t i = 0; i < kNumPackets; ++i)
+    EXPECT_TRUE(network.EnqueuePacket(PacketInFlightInfo(100, i * 100, i)));
+
+  int64_t last_receive_time_us = 0;
+  size_t num_delivered = 0;
+  for (int64_t time_us = 0; num_delivered < kNumPackets; time_us += 5000) {
+    std::vector<PacketDeliveryInfo> delivered =
+        network.DequeueDeliverablePackets(time_us);
+    for (const PacketDeliveryInfo& info : delivered) {
+      EXPECT_LE(info.receive_time_us, time_us);
+      EXPECT_GE(info.receive_time_us, last_receive_time_us);
+      last_receive_time_us = info.receive_time_us;
+    }
+    num_delivered += delivered.size();
+    ASSERT_LT(time_us, 10 * 1000 * 1000);
+  }
+  EXPECT_FALSE(network.NextDeliveryTimeUs());
+}
+
 TEST_F(FakeNetworkPipeTest, BurstLoss) {
   const int kLossPercent = 5;
   const int kAvgBurstLength = 3;
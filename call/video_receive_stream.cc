@@ -48,8 +48,11 @@ std::string VideoReceiveStream::Stats::ToString(int64_t time_ms) const {
   ss << "render_fps: " << render_frame_rate << ", ";
   ss << "decode_ms: " << decode_ms << ", ";
   ss << "max_decode_ms: " << max_decode_ms << ", ";
+  if (qp_quality_score)
+    ss << "qp_quality_score: " << *qp_quality_score << ", ";
   ss << "first_frame_received_to_decoded_ms: "
      << first_frame_received_to_decoded_ms << ", ";
+  ss << "receive_to_render_delay_ms: " << receive_to_render_delay_ms << ", ";
   ss << "cur_delay_ms: " << current_delay_ms << ", ";
   ss << "targ_delay_ms: " << target_delay_ms << ", ";
   ss << "jb_delay_ms: " << jitter_buffer_ms << ", ";
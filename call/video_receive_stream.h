@@ -31,6 +31,7 @@
 
 namespace webrtc {
 
+class EncodedFrameSinkInterface;
 class FrameDecryptorInterface;
 class RtpPacketSinkInterface;
 class VideoDecoderFactory;
@@ -78,8 +79,19 @@ class VideoReceiveStream {
     int render_delay_ms = 10;
     int64_t interframe_delay_max_ms = -1;
     uint32_t frames_decoded = 0;
+    // Thread CPU time spent in the decoder, summed over all frames.
+    int64_t total_decode_cpu_time_us = 0;
     int64_t first_frame_received_to_decoded_ms = -1;
+    // Time from the last packet of the most recently rendered frame being
+    // received until the frame was passed to the renderer.
+    int64_t receive_to_render_delay_ms = -1;
     absl::optional<uint64_t> qp_sum;
+    // No-reference estimate of the quality of the decoded video, from 0
+    // (worst) to 100 (best), smoothed over recent frames. Derived from the QP
+    // of the frames relative to the QP range of the codec, so it is cheap but
+    // only comparable between streams of the same codec. Unset until a frame
+    // with a QP is decoded.
+    absl::optional<int> qp_quality_score;
 
     int current_payload_type = -1;
 
@@ -246,6 +258,22 @@ class VideoReceiveStream {
 
   virtual std::vector<RtpSource> GetSources() const = 0;
 
+  // Taps every complete frame leaving the jitter buffer, before it is decoded.
+  // If |decode_frames| is false the frames are only forwarded to |sink| and
+  // the decoder and renderer are bypassed. Pass null to remove the sink.
+  virtual void SetEncodedFrameSink(EncodedFrameSinkInterface* sink,
+                                   bool decode_frames) = 0;
+
+  // Asks the remote sender for a key frame, e.g. on behalf of a downstream
+  // receiver of forwarded frames.
+  virtual void RequestKeyFrame() = 0;
+
+  // Pauses decoding, e.g. while the renderer isn't visible. Frames still
+  // leave the jitter buffer, but only the latest key frame is kept and
+  // nothing is decoded or rendered. On resume that key frame is decoded and a
+  // new key frame is requested, from which decoding continues.
+  virtual void SetDecodingPaused(bool paused) = 0;
+
  protected:
   virtual ~VideoReceiveStream() {}
 };
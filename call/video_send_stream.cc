@@ -53,7 +53,13 @@ std::string VideoSendStream::Stats::ToString(int64_t time_ms) const {
   ss << "target_bps: " << target_media_bitrate_bps << ", ";
   ss << "media_bps: " << media_bitrate_bps << ", ";
   ss << "suspended: " << (suspended ? "true" : "false") << ", ";
-  ss << "bw_adapted: " << (bw_limited_resolution ? "true" : "false");
+  ss << "bw_adapted: " << (bw_limited_resolution ? "true" : "false") << ", ";
+  ss << "key_frame_requests: " << key_frame_requests_received << ", ";
+  ss << "key_frame_requests_coalesced: " << key_frame_requests_coalesced
+     << ", ";
+  ss << "key_frames_encoded: " << key_frames_encoded << ", ";
+  ss << "encode_cpu_us: " << total_encode_cpu_time_us << ", ";
+  ss << "packetize_cpu_us: " << total_packetize_cpu_time_us;
   ss << '}';
   for (const auto& substream : substreams) {
     if (!substream.second.is_rtx && !substream.second.is_flexfec) {
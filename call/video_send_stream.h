@@ -32,7 +32,11 @@
 
 namespace webrtc {
 
+class EncodedImage;
 class FrameEncryptorInterface;
+class KeyFrameRequestSender;
+class RTPFragmentationHeader;
+struct CodecSpecificInfo;
 
 class VideoSendStream {
  public:
@@ -91,6 +95,16 @@ class VideoSendStream {
     webrtc::VideoContentType content_type =
         webrtc::VideoContentType::UNSPECIFIED;
     uint32_t huge_frames_sent = 0;
+    // PLI/FIR requests received on any of the substreams, and how many of them
+    // were coalesced with an earlier request instead of reaching the encoder.
+    uint32_t key_frame_requests_received = 0;
+    uint32_t key_frame_requests_coalesced = 0;
+    // Key frames produced by the encoder, counting each simulcast stream.
+    uint32_t key_frames_encoded = 0;
+    // Thread CPU time spent encoding, and packetizing including FEC, summed
+    // over all frames. Used to attribute load to the stream.
+    int64_t total_encode_cpu_time_us = 0;
+    int64_t total_packetize_cpu_time_us = 0;
   };
 
   struct Config {
@@ -181,6 +195,21 @@ class VideoSendStream {
 
   virtual Stats GetStats() = 0;
 
+  // Packetizes and sends an already encoded frame, e.g. one forwarded from a
+  // video receive stream, bypassing the encoder. The stream should not have a
+  // source set while frames are injected. |fragmentation| may be null, in
+  // which case it is derived from the bitstream where the packetizer needs it.
+  // May be called on any thread.
+  virtual void InjectEncodedImage(
+      const EncodedImage& encoded_image,
+      const CodecSpecificInfo& codec_specific_info,
+      const RTPFragmentationHeader* fragmentation) = 0;
+
+  // Redirects key frame requests (PLI/FIR) from the remote side to |sender|
+  // instead of the encoder, e.g. to the receive stream the injected frames
+  // originate from. Pass null to restore the default behavior.
+  virtual void SetKeyFrameRequestSender(KeyFrameRequestSender* sender) = 0;
+
  protected:
   virtual ~VideoSendStream() {}
 };
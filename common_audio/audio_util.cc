@@ -46,4 +46,13 @@ void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                                  num_channels, deinterleaved);
 }
 
+template <>
+void DownmixInterleavedToMono<float>(const float* interleaved,
+                                     size_t num_frames,
+                                     int num_channels,
+                                     float* deinterleaved) {
+  DownmixInterleavedToMonoImpl<float, float>(interleaved, num_frames,
+                                             num_channels, deinterleaved);
+}
+
 }  // namespace webrtc
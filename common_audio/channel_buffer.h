@@ -18,12 +18,15 @@
 #include "common_audio/include/audio_util.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/gtest_prod_util.h"
+#include "rtc_base/memory/aligned_malloc.h"
 
 namespace webrtc {
 
 // Helper to encapsulate a contiguous data buffer, full or split into frequency
 // bands, with access to a pointer arrays of the deinterleaved channels and
-// bands. The buffer is zero initialized at creation.
+// bands. The buffer is zero initialized at creation, and aligned to
+// |kChannelBufferAlignment| bytes so that SIMD code can process it in place.
+// With the usual band lengths, e.g. 160 samples, every band then is aligned.
 //
 // The buffer structure is showed below for a 2 channel and 2 bands case:
 //
@@ -37,11 +40,14 @@ namespace webrtc {
 //
 // |bands_|:
 // { [ b1ch1* ] [ b2ch1* ] [ b1ch2* ] [ b2ch2* ] }
+constexpr size_t kChannelBufferAlignment = 32;
+
 template <typename T>
 class ChannelBuffer {
  public:
   ChannelBuffer(size_t num_frames, size_t num_channels, size_t num_bands = 1)
-      : data_(new T[num_frames * num_channels]()),
+      : data_(AlignedMalloc<T>(num_frames * num_channels * sizeof(T),
+                               kChannelBufferAlignment)),
         channels_(new T*[num_channels * num_bands]),
         bands_(new T*[num_channels * num_bands]),
         num_frames_(num_frames),
@@ -49,6 +55,7 @@ class ChannelBuffer {
         num_allocated_channels_(num_channels),
         num_channels_(num_channels),
         num_bands_(num_bands) {
+    memset(data_.get(), 0, size() * sizeof(T));
     for (size_t i = 0; i < num_allocated_channels_; ++i) {
       for (size_t j = 0; j < num_bands_; ++j) {
         channels_[j * num_allocated_channels_ + i] =
@@ -130,7 +137,7 @@ class ChannelBuffer {
   }
 
  private:
-  std::unique_ptr<T[]> data_;
+  std::unique_ptr<T[], AlignedFreeDeleter> data_;
   std::unique_ptr<T* []> channels_;
   std::unique_ptr<T* []> bands_;
   const size_t num_frames_;
@@ -34,6 +34,19 @@ TEST(ChannelBufferTest, SetNumChannelsSetsNumChannels) {
   EXPECT_EQ(chb.num_channels(), kMono);
 }
 
+TEST(ChannelBufferTest, DataIsAlignedAndZeroed) {
+  ChannelBuffer<float> chb(kNumFrames, kStereo, 3u);
+  for (size_t band = 0; band < chb.num_bands(); ++band) {
+    for (size_t ch = 0; ch < chb.num_channels(); ++ch) {
+      const float* data = chb.channels(band)[ch];
+      EXPECT_EQ(0u,
+                reinterpret_cast<uintptr_t>(data) % kChannelBufferAlignment);
+      for (size_t i = 0; i < chb.num_frames_per_band(); ++i)
+        EXPECT_EQ(0.f, data[i]);
+    }
+  }
+}
+
 TEST(IFChannelBufferTest, SetNumChannelsSetsChannelBuffersNumChannels) {
   IFChannelBuffer ifchb(kNumFrames, kStereo);
   ExpectNumChannels(ifchb, kStereo);
@@ -209,6 +209,12 @@ void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                        int num_channels,
                                        int16_t* deinterleaved);
 
+template <>
+void DownmixInterleavedToMono<float>(const float* interleaved,
+                                     size_t num_frames,
+                                     int num_channels,
+                                     float* deinterleaved);
+
 }  // namespace webrtc
 
 #endif  // COMMON_AUDIO_INCLUDE_AUDIO_UTIL_H_
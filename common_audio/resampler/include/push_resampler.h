@@ -41,13 +41,9 @@ class PushResampler {
   int dst_sample_rate_hz_;
   size_t num_channels_;
 
-  struct ChannelResampler {
-    std::unique_ptr<PushSincResampler> resampler;
-    std::vector<T> source;
-    std::vector<T> destination;
-  };
-
-  std::vector<ChannelResampler> channel_resamplers_;
+  // One resampler per channel. They read from and write to the interleaved
+  // buffers directly.
+  std::vector<std::unique_ptr<PushSincResampler>> channel_resamplers_;
 };
 }  // namespace webrtc
 
@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <vector>
+
 #include "common_audio/resampler/include/push_resampler.h"
 #include "rtc_base/checks.h"  // RTC_DCHECK_IS_ON
 #include "test/gtest.h"
@@ -49,4 +51,65 @@ TEST(PushResamplerTest, VerifiesBadInputParameters3) {
 #endif
 #endif
 
+namespace {
+
+// Resamples an interleaved signal with |kNumChannels| channels, each channel a
+// differently scaled ramp, and checks that the output is identical to
+// resampling each channel separately.
+template <typename T>
+void VerifyInterleavedMatchesPerChannel() {
+  constexpr int kSrcRateHz = 48000;
+  constexpr int kDstRateHz = 44100;
+  constexpr size_t kNumChannels = 3;
+  constexpr size_t kSrcFrames = kSrcRateHz / 100;
+  constexpr size_t kDstFrames = kDstRateHz / 100;
+
+  PushResampler<T> multi_channel_resampler;
+  ASSERT_EQ(0, multi_channel_resampler.InitializeIfNeeded(
+                   kSrcRateHz, kDstRateHz, kNumChannels));
+  std::vector<PushResampler<T>> mono_resamplers(kNumChannels);
+  for (auto& resampler : mono_resamplers) {
+    ASSERT_EQ(0, resampler.InitializeIfNeeded(kSrcRateHz, kDstRateHz, 1));
+  }
+
+  std::vector<T> interleaved_src(kSrcFrames * kNumChannels);
+  std::vector<T> interleaved_dst(kDstFrames * kNumChannels);
+  std::vector<T> mono_src(kSrcFrames);
+  std::vector<T> mono_dst(kDstFrames);
+  for (int frame = 0; frame < 5; ++frame) {
+    for (size_t i = 0; i < kSrcFrames; ++i) {
+      for (size_t ch = 0; ch < kNumChannels; ++ch) {
+        interleaved_src[i * kNumChannels + ch] =
+            static_cast<T>((ch + 1) * ((frame * kSrcFrames + i) % 300));
+      }
+    }
+    EXPECT_EQ(static_cast<int>(interleaved_dst.size()),
+              multi_channel_resampler.Resample(
+                  interleaved_src.data(), interleaved_src.size(),
+                  interleaved_dst.data(), interleaved_dst.size()));
+
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      for (size_t i = 0; i < kSrcFrames; ++i) {
+        mono_src[i] = interleaved_src[i * kNumChannels + ch];
+      }
+      EXPECT_EQ(static_cast<int>(kDstFrames),
+                mono_resamplers[ch].Resample(mono_src.data(), mono_src.size(),
+                                             mono_dst.data(), mono_dst.size()));
+      for (size_t i = 0; i < kDstFrames; ++i) {
+        ASSERT_EQ(mono_dst[i], interleaved_dst[i * kNumChannels + ch]);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(PushResamplerTest, InterleavedMatchesPerChannelInt16) {
+  VerifyInterleavedMatchesPerChannel<int16_t>();
+}
+
+TEST(PushResamplerTest, InterleavedMatchesPerChannelFloat) {
+  VerifyInterleavedMatchesPerChannel<float>();
+}
+
 }  // namespace webrtc
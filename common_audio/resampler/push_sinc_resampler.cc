@@ -24,6 +24,7 @@ PushSincResampler::PushSincResampler(size_t source_frames,
                                    this)),
       source_ptr_(nullptr),
       source_ptr_int_(nullptr),
+      source_stride_(1),
       destination_frames_(destination_frames),
       first_pass_(true),
       source_available_(0) {}
@@ -34,14 +35,53 @@ size_t PushSincResampler::Resample(const int16_t* source,
                                    size_t source_length,
                                    int16_t* destination,
                                    size_t destination_capacity) {
+  return ResampleStrided(source, source_length, 1, destination,
+                         destination_capacity);
+}
+
+size_t PushSincResampler::ResampleStrided(const int16_t* source,
+                                          size_t source_length,
+                                          size_t stride,
+                                          int16_t* destination,
+                                          size_t destination_capacity) {
+  RTC_DCHECK_GT(stride, 0);
+  RTC_CHECK_GE(destination_capacity, destination_frames_);
   if (!float_buffer_.get())
     float_buffer_.reset(new float[destination_frames_]);
 
   source_ptr_int_ = source;
+  source_stride_ = stride;
   // Pass nullptr as the float source to have Run() read from the int16 source.
   Resample(nullptr, source_length, float_buffer_.get(), destination_frames_);
-  FloatS16ToS16(float_buffer_.get(), destination_frames_, destination);
+  if (stride == 1) {
+    FloatS16ToS16(float_buffer_.get(), destination_frames_, destination);
+  } else {
+    for (size_t i = 0; i < destination_frames_; ++i)
+      destination[i * stride] = FloatS16ToS16(float_buffer_[i]);
+  }
   source_ptr_int_ = nullptr;
+  source_stride_ = 1;
+  return destination_frames_;
+}
+
+size_t PushSincResampler::ResampleStrided(const float* source,
+                                          size_t source_length,
+                                          size_t stride,
+                                          float* destination,
+                                          size_t destination_capacity) {
+  RTC_DCHECK_GT(stride, 0);
+  if (stride == 1)
+    return Resample(source, source_length, destination, destination_capacity);
+
+  RTC_CHECK_GE(destination_capacity, destination_frames_);
+  if (!float_buffer_.get())
+    float_buffer_.reset(new float[destination_frames_]);
+
+  source_stride_ = stride;
+  Resample(source, source_length, float_buffer_.get(), destination_frames_);
+  for (size_t i = 0; i < destination_frames_; ++i)
+    destination[i * stride] = float_buffer_[i];
+  source_stride_ = 1;
   return destination_frames_;
 }
 
@@ -91,10 +131,15 @@ void PushSincResampler::Run(size_t frames, float* destination) {
   }
 
   if (source_ptr_) {
-    std::memcpy(destination, source_ptr_, frames * sizeof(*destination));
+    if (source_stride_ == 1) {
+      std::memcpy(destination, source_ptr_, frames * sizeof(*destination));
+    } else {
+      for (size_t i = 0; i < frames; ++i)
+        destination[i] = source_ptr_[i * source_stride_];
+    }
   } else {
     for (size_t i = 0; i < frames; ++i)
-      destination[i] = static_cast<float>(source_ptr_int_[i]);
+      destination[i] = static_cast<float>(source_ptr_int_[i * source_stride_]);
   }
   source_available_ -= frames;
 }
@@ -46,6 +46,23 @@ class PushSincResampler : public SincResamplerCallback {
                   float* destination,
                   size_t destination_capacity);
 
+  // Same as Resample(), but for one channel of an interleaved multi-channel
+  // signal: every |stride|th sample of |source| is read, starting with the
+  // first, and the output is written to every |stride|th sample of
+  // |destination|. |source_frames| and |destination_capacity| count the
+  // samples of this channel only. This avoids deinterleaving into, and
+  // interleaving from, separate channel buffers.
+  size_t ResampleStrided(const int16_t* source,
+                         size_t source_frames,
+                         size_t stride,
+                         int16_t* destination,
+                         size_t destination_capacity);
+  size_t ResampleStrided(const float* source,
+                         size_t source_frames,
+                         size_t stride,
+                         float* destination,
+                         size_t destination_capacity);
+
   // Delay due to the filter kernel. Essentially, the time after which an input
   // sample will appear in the resampled output.
   static float AlgorithmicDelaySeconds(int source_rate_hz) {
@@ -64,6 +81,7 @@ class PushSincResampler : public SincResamplerCallback {
   std::unique_ptr<float[]> float_buffer_;
   const float* source_ptr_;
   const int16_t* source_ptr_int_;
+  size_t source_stride_;
   const size_t destination_frames_;
 
   // True on the first call to Resample(), to prime the SincResampler buffer.
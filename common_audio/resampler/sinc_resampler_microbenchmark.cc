@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "common_audio/resampler/sinc_resampler.h"
+#include "test/gtest.h"
+#include "test/testsupport/microbenchmark.h"
+
+namespace webrtc {
+
+namespace {
+
+// Feeds a constant signal; the kernel cost doesn't depend on the content.
+class ConstantSource : public SincResamplerCallback {
+ public:
+  void Run(size_t frames, float* destination) override {
+    std::fill(destination, destination + frames, 0.25f);
+  }
+};
+
+}  // namespace
+
+TEST(SincResamplerMicrobenchmark, Resample) {
+  struct {
+    const char* name;
+    int input_rate_hz;
+    int output_rate_hz;
+  } const kConversions[] = {
+      {"SincResampler_Resample44100To48000", 44100, 48000},
+      {"SincResampler_Resample48000To16000", 48000, 16000},
+      {"SincResampler_Resample16000To48000", 16000, 48000},
+  };
+  for (const auto& conversion : kConversions) {
+    ConstantSource source;
+    SincResampler resampler(
+        static_cast<double>(conversion.input_rate_hz) /
+            conversion.output_rate_hz,
+        SincResampler::kDefaultRequestSize, &source);
+    std::vector<float> output(conversion.output_rate_hz / 100);
+    test::RunMicrobenchmark(conversion.name, [&] {
+      resampler.Resample(output.size(), output.data());
+    });
+    test::DoNotOptimizeAway(output.data());
+  }
+}
+
+}  // namespace webrtc
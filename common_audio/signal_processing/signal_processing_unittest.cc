@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <iterator>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "rtc_base/strings/string_builder.h"
@@ -497,10 +498,10 @@ TEST_F(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
+  if (WebRtcSpl_CrossCorrelation == WebRtcSpl_CrossCorrelationNeon) {
     expected = kExpectedNeon;
   }
 #endif
@@ -509,6 +510,40 @@ TEST_F(SplTest, CrossCorrelationTest) {
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST_F(SplTest, CrossCorrelationSSE2IsBitExact) {
+  // Long enough to use both the vectorized loop and the tail, and with values
+  // that make the sums wrap around.
+  const size_t kSeqDimension = 203;
+  const size_t kCrossCorrelationDimension = 7;
+  int16_t seq1[kSeqDimension];
+  int16_t seq2[kSeqDimension + 2 * kCrossCorrelationDimension];
+  uint32_t seed = 1;
+  auto random_sample = [&seed] {
+    seed = seed * 69069 + 1;
+    return static_cast<int16_t>(seed >> 16);
+  };
+  std::generate(std::begin(seq1), std::end(seq1), random_sample);
+  std::generate(std::begin(seq2), std::end(seq2), random_sample);
+
+  for (int shift : {0, 2, 15}) {
+    for (int step : {1, -1}) {
+      const int16_t* seq2_start =
+          step > 0 ? seq2 : seq2 + 2 * kCrossCorrelationDimension;
+      int32_t expected[kCrossCorrelationDimension];
+      int32_t result[kCrossCorrelationDimension];
+      WebRtcSpl_CrossCorrelationC(expected, seq1, seq2_start, kSeqDimension,
+                                  kCrossCorrelationDimension, shift, step);
+      WebRtcSpl_CrossCorrelationSSE2(result, seq1, seq2_start, kSeqDimension,
+                                     kCrossCorrelationDimension, shift, step);
+      for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
+        EXPECT_EQ(expected[i], result[i]);
+      }
+    }
+  }
+}
+#endif
+
 TEST_F(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
@@ -9,7 +9,7 @@
  */
 
 /* The global function contained in this file initializes SPL function
- * pointers, currently only for ARM platforms.
+ * pointers, currently only for ARM, MIPS and x86 platforms.
  *
  * Some code came from common/rtcd.c in the WebM project.
  */
@@ -60,6 +60,14 @@ static void InitPointersToNeon(void) {
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* Initialize function pointers to the SSE2 version where there is one. */
+static void InitPointersToSSE2(void) {
+  InitPointersToC();
+  WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationSSE2;
+}
+#endif
+
 #if defined(MIPS32_LE)
 /* Initialize function pointers to the MIPS version. */
 static void InitPointersToMIPS(void) {
@@ -87,6 +95,12 @@ static void InitFunctionPointers(void) {
   InitPointersToNeon();
 #elif defined(MIPS32_LE)
   InitPointersToMIPS();
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    InitPointersToSSE2();
+  } else {
+    InitPointersToC();
+  }
 #else
   InitPointersToC();
 #endif  /* WEBRTC_HAS_NEON */
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <string.h>
+#include <limits>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+EncodedImageBuffer::EncodedImageBuffer(size_t capacity)
+    : data_(new uint8_t[capacity]), capacity_(capacity) {}
+
+EncodedImageBuffer::~EncodedImageBuffer() = default;
+
+EncodedImageBufferPool::EncodedImageBufferPool()
+    : EncodedImageBufferPool(std::numeric_limits<size_t>::max()) {}
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_number_of_buffers)
+    : max_number_of_buffers_(max_number_of_buffers) {}
+EncodedImageBufferPool::~EncodedImageBufferPool() = default;
+
+void EncodedImageBufferPool::Release() {
+  buffers_.clear();
+}
+
+rtc::scoped_refptr<EncodedImageBuffer> EncodedImageBufferPool::CreateBuffer(
+    size_t min_capacity) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  // Look for the smallest free buffer that is large enough, and release free
+  // buffers that are too small.
+  PooledEncodedImageBuffer* best = nullptr;
+  for (auto it = buffers_.begin(); it != buffers_.end();) {
+    // If the buffer is in use, the ref count will be >= 2, one from the list we
+    // are looping over and one from the application. If the ref count is 1,
+    // then the list we are looping over holds the only reference and it's safe
+    // to reuse.
+    if (!(*it)->HasOneRef()) {
+      ++it;
+    } else if ((*it)->capacity() < min_capacity) {
+      it = buffers_.erase(it);
+    } else {
+      if (!best || (*it)->capacity() < best->capacity())
+        best = it->get();
+      ++it;
+    }
+  }
+  if (best)
+    return best;
+
+  if (buffers_.size() >= max_number_of_buffers_)
+    return nullptr;
+  // Allocate new buffer.
+  rtc::scoped_refptr<PooledEncodedImageBuffer> buffer =
+      new PooledEncodedImageBuffer(min_capacity);
+  buffers_.push_back(buffer);
+  return buffer;
+}
+
+rtc::scoped_refptr<EncodedImageBuffer> EncodedImageBufferPool::GrowBuffer(
+    const rtc::scoped_refptr<EncodedImageBuffer>& buffer,
+    size_t size,
+    size_t min_capacity) {
+  rtc::scoped_refptr<EncodedImageBuffer> grown = CreateBuffer(min_capacity);
+  if (grown && buffer) {
+    RTC_DCHECK_LE(size, buffer->capacity());
+    RTC_DCHECK_LE(size, grown->capacity());
+    memcpy(grown->data(), buffer->data(), size);
+  }
+  return grown;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(TestEncodedImageBufferPool, SimpleBufferReuse) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(1000);
+  EXPECT_EQ(1000u, buffer->capacity());
+  const uint8_t* data = buffer->data();
+  // Release buffer so that it is returned to the pool.
+  buffer = nullptr;
+  // Check that the memory is reused, also for smaller requests.
+  buffer = pool.CreateBuffer(500);
+  EXPECT_EQ(data, buffer->data());
+  EXPECT_EQ(1000u, buffer->capacity());
+}
+
+TEST(TestEncodedImageBufferPool, DoesNotReuseBufferInUse) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer1 = pool.CreateBuffer(1000);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer2 = pool.CreateBuffer(1000);
+  EXPECT_NE(buffer1->data(), buffer2->data());
+}
+
+TEST(TestEncodedImageBufferPool, DoesNotReuseTooSmallBuffer) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(1000);
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(2000);
+  EXPECT_EQ(2000u, buffer->capacity());
+}
+
+TEST(TestEncodedImageBufferPool, PicksSmallestSufficientBuffer) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> large = pool.CreateBuffer(4000);
+  rtc::scoped_refptr<EncodedImageBuffer> small = pool.CreateBuffer(2000);
+  const uint8_t* small_data = small->data();
+  large = nullptr;
+  small = nullptr;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(1500);
+  EXPECT_EQ(small_data, buffer->data());
+}
+
+TEST(TestEncodedImageBufferPool, GrowBufferKeepsContent) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(4);
+  const uint8_t kData[] = {1, 2, 3, 4};
+  memcpy(buffer->data(), kData, sizeof(kData));
+  buffer = pool.GrowBuffer(buffer, sizeof(kData), 100);
+  EXPECT_GE(buffer->capacity(), 100u);
+  EXPECT_EQ(0, memcmp(kData, buffer->data(), sizeof(kData)));
+}
+
+TEST(TestEncodedImageBufferPool, BufferValidAfterPoolDestruction) {
+  rtc::scoped_refptr<EncodedImageBuffer> buffer;
+  {
+    EncodedImageBufferPool pool;
+    buffer = pool.CreateBuffer(1000);
+  }
+  EXPECT_EQ(1000u, buffer->capacity());
+  memset(buffer->data(), 0, buffer->capacity());
+}
+
+TEST(TestEncodedImageBufferPool, MaxNumberOfBuffers) {
+  EncodedImageBufferPool pool(1);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer1 = pool.CreateBuffer(16);
+  EXPECT_NE(nullptr, buffer1.get());
+  EXPECT_EQ(nullptr, pool.CreateBuffer(16).get());
+}
+
+}  // namespace webrtc
@@ -12,24 +12,72 @@
 
 #include <cstdint>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
 namespace H264 {
 
 const uint8_t kNaluTypeMask = 0x1F;
 
+namespace {
+
+// Returns the first position from |i| at which two zero bytes start, which
+// any start sequence begins with, checking 16 positions at a time. Without
+// SIMD support |i| is returned as is.
+size_t SkipToZeroBytePair(const uint8_t* buffer, size_t i, size_t end) {
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 17 <= end; i += 16) {
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&buffer[i]));
+    const __m128i b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&buffer[i + 1]));
+    if (_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, zero), _mm_cmpeq_epi8(b, zero)))) {
+      break;
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  for (; i + 17 <= end; i += 16) {
+    const uint8x16_t pairs =
+        vandq_u8(vceqq_u8(vld1q_u8(&buffer[i]), vdupq_n_u8(0)),
+                 vceqq_u8(vld1q_u8(&buffer[i + 1]), vdupq_n_u8(0)));
+    const uint64x2_t pairs64 = vreinterpretq_u64_u8(pairs);
+    if (vgetq_lane_u64(pairs64, 0) | vgetq_lane_u64(pairs64, 1))
+      break;
+  }
+#endif
+#if defined(__SSE2__) || defined(WEBRTC_HAS_NEON)
+  // Find the pair within the 16 positions, or in the last few bytes.
+  while (i + 1 < end && (buffer[i] != 0 || buffer[i + 1] != 0))
+    ++i;
+#endif
+  return i;
+}
+
+}  // namespace
+
 std::vector<NaluIndex> FindNaluIndices(const uint8_t* buffer,
                                        size_t buffer_size) {
   // This is sorta like Boyer-Moore, but with only the first optimization step:
   // given a 3-byte sequence we're looking at, if the 3rd byte isn't 1 or 0,
   // skip ahead to the next 3-byte sequence. 0s and 1s are relatively rare, so
-  // this will skip the majority of reads/checks.
+  // this will skip the majority of reads/checks. With SIMD support, positions
+  // not starting with two zero bytes are first skipped 16 at a time.
   std::vector<NaluIndex> sequences;
   if (buffer_size < kNaluShortStartSequenceSize)
     return sequences;
 
   const size_t end = buffer_size - kNaluShortStartSequenceSize;
   for (size_t i = 0; i < end;) {
-    if (buffer[i + 2] > 1) {
+    i = SkipToZeroBytePair(buffer, i, end);
+    if (i >= end) {
+      break;
+    } else if (buffer[i + 2] > 1) {
       i += 3;
     } else if (buffer[i + 2] == 1 && buffer[i + 1] == 0 && buffer[i] == 0) {
       // We found a start sequence, now check if it was a 3 of 4 byte one.
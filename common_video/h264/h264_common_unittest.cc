@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h264/h264_common.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace H264 {
+namespace {
+
+// Appends |size| bytes of payload, which only has zero bytes in pairs
+// followed by a byte above three, as emulation prevention guarantees.
+void AppendPayload(Random* random, size_t size, std::vector<uint8_t>* buffer) {
+  for (size_t i = 0; i < size; ++i) {
+    if (i + 3 <= size && random->Rand(0, 7) == 0) {
+      buffer->insert(buffer->end(),
+                     {0, 0, static_cast<uint8_t>(random->Rand(4, 255))});
+      i += 2;
+    } else {
+      buffer->push_back(static_cast<uint8_t>(random->Rand(1, 255)));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(H264CommonTest, FindsNoNalusWithoutStartSequence) {
+  const uint8_t buffer[] = {0, 0, 2, 0, 1, 0, 0, 0, 4, 5};
+  EXPECT_TRUE(FindNaluIndices(buffer, sizeof(buffer)).empty());
+}
+
+TEST(H264CommonTest, FindsShortAndLongStartSequences) {
+  const uint8_t buffer[] = {0, 0, 0, 1, 0x65, 7, 8, 0, 0, 1, 0x41, 9};
+  std::vector<NaluIndex> indices = FindNaluIndices(buffer, sizeof(buffer));
+  ASSERT_EQ(2u, indices.size());
+  EXPECT_EQ(0u, indices[0].start_offset);
+  EXPECT_EQ(4u, indices[0].payload_start_offset);
+  EXPECT_EQ(3u, indices[0].payload_size);
+  EXPECT_EQ(7u, indices[1].start_offset);
+  EXPECT_EQ(10u, indices[1].payload_start_offset);
+  EXPECT_EQ(2u, indices[1].payload_size);
+}
+
+TEST(H264CommonTest, FindsStartSequencesInLongBuffers) {
+  Random random(0x1234);
+  for (int trial = 0; trial < 100; ++trial) {
+    std::vector<uint8_t> buffer;
+    std::vector<NaluIndex> expected;
+    const int num_nalus = random.Rand(1, 10);
+    for (int n = 0; n < num_nalus; ++n) {
+      NaluIndex index;
+      index.start_offset = buffer.size();
+      if (random.Rand<bool>())
+        buffer.push_back(0);
+      buffer.insert(buffer.end(), {0, 0, 1});
+      index.payload_start_offset = buffer.size();
+      AppendPayload(&random, random.Rand(1, 100), &buffer);
+      index.payload_size = buffer.size() - index.payload_start_offset;
+      expected.push_back(index);
+    }
+
+    std::vector<NaluIndex> indices =
+        FindNaluIndices(buffer.data(), buffer.size());
+    ASSERT_EQ(expected.size(), indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      EXPECT_EQ(expected[i].start_offset, indices[i].start_offset);
+      EXPECT_EQ(expected[i].payload_start_offset,
+                indices[i].payload_start_offset);
+      EXPECT_EQ(expected[i].payload_size, indices[i].payload_size);
+    }
+  }
+}
+
+}  // namespace H264
+}  // namespace webrtc
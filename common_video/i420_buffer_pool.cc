@@ -10,53 +10,207 @@
 
 #include "common_video/include/i420_buffer_pool.h"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <utility>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/refcounter.h"
 
 namespace webrtc {
 
+namespace {
+
+// Size of the pixel data of a buffer created by the pool.
+size_t BufferSize(int width, int height) {
+  return width * height + 2 * ((width + 1) / 2) * ((height + 1) / 2);
+}
+
+}  // namespace
+
+// Stack of released buffers. Any thread may push, but only the pool pops, so
+// the stack is free from ABA problems without tagged pointers. Once the pool
+// is gone the list is detached, and buffers released after that delete
+// themselves.
+class I420BufferPool::FreeList : public rtc::RefCountInterface {
+ public:
+  void Push(PooledI420Buffer* buffer);
+  // Must only be called by the pool.
+  PooledI420Buffer* Pop();
+  // Deletes all buffers currently on the list.
+  void DeleteAll();
+  // Called by the pool when it no longer accepts buffers.
+  void Detach();
+  // Called by a buffer when its last reference is released.
+  void Recycle(PooledI420Buffer* buffer);
+
+  // May briefly lag behind concurrent pushes.
+  size_t size() const {
+    return std::max<int>(0, size_.load(std::memory_order_relaxed));
+  }
+
+ protected:
+  ~FreeList() override { RTC_DCHECK(!head_.load()); }
+
+ private:
+  std::atomic<PooledI420Buffer*> head_{nullptr};
+  std::atomic<int> size_{0};
+  std::atomic<bool> detached_{false};
+};
+
+class I420BufferPool::PooledI420Buffer : public I420Buffer {
+ public:
+  PooledI420Buffer(int width,
+                   int height,
+                   rtc::scoped_refptr<FreeList> free_list)
+      : I420Buffer(width, height), free_list_(std::move(free_list)) {}
+  ~PooledI420Buffer() override = default;
+
+  void AddRef() const override { ref_count_.IncRef(); }
+  rtc::RefCountReleaseStatus Release() const override {
+    const rtc::RefCountReleaseStatus status = ref_count_.DecRef();
+    if (status == rtc::RefCountReleaseStatus::kDroppedLastRef)
+      free_list_->Recycle(const_cast<PooledI420Buffer*>(this));
+    return status;
+  }
+
+  // Link to the next buffer while on the free list.
+  PooledI420Buffer* next_free = nullptr;
+
+ private:
+  mutable webrtc_impl::RefCounter ref_count_{0};
+  const rtc::scoped_refptr<FreeList> free_list_;
+};
+
+void I420BufferPool::FreeList::Push(PooledI420Buffer* buffer) {
+  PooledI420Buffer* head = head_.load();
+  do {
+    buffer->next_free = head;
+  } while (!head_.compare_exchange_weak(head, buffer));
+  size_.fetch_add(1, std::memory_order_relaxed);
+}
+
+I420BufferPool::PooledI420Buffer* I420BufferPool::FreeList::Pop() {
+  PooledI420Buffer* head = head_.load();
+  // |head->next_free| can't change under us, since no one else pops.
+  while (head && !head_.compare_exchange_weak(head, head->next_free)) {
+  }
+  if (head)
+    size_.fetch_sub(1, std::memory_order_relaxed);
+  return head;
+}
+
+void I420BufferPool::FreeList::DeleteAll() {
+  PooledI420Buffer* buffer = head_.exchange(nullptr);
+  while (buffer) {
+    PooledI420Buffer* next = buffer->next_free;
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    delete buffer;
+    buffer = next;
+  }
+}
+
+void I420BufferPool::FreeList::Detach() {
+  detached_.store(true);
+  DeleteAll();
+}
+
+void I420BufferPool::FreeList::Recycle(PooledI420Buffer* buffer) {
+  // Deleting the buffer may drop the last other reference to this list.
+  rtc::scoped_refptr<FreeList> self(this);
+  if (detached_.load()) {
+    delete buffer;
+    return;
+  }
+  Push(buffer);
+  // If the pool was detached after the check above, its DeleteAll() may have
+  // missed |buffer|.
+  if (detached_.load())
+    DeleteAll();
+}
+
 I420BufferPool::I420BufferPool() : I420BufferPool(false) {}
 I420BufferPool::I420BufferPool(bool zero_initialize)
     : I420BufferPool(zero_initialize, std::numeric_limits<size_t>::max()) {}
 I420BufferPool::I420BufferPool(bool zero_initialize,
                                size_t max_number_of_buffers)
-    : zero_initialize_(zero_initialize),
-      max_number_of_buffers_(max_number_of_buffers) {}
-I420BufferPool::~I420BufferPool() = default;
+    : free_list_(new rtc::RefCountedObject<FreeList>()),
+      zero_initialize_(zero_initialize),
+      max_number_of_buffers_(max_number_of_buffers),
+      memory_account_("I420BufferPool") {}
+
+I420BufferPool::~I420BufferPool() {
+  free_list_->Detach();
+}
 
 void I420BufferPool::Release() {
-  buffers_.clear();
+  free_list_->Detach();
+  free_list_ = new rtc::RefCountedObject<FreeList>();
+  memory_account_.Subtract(memory_account_.bytes());
+  stats_.num_buffers = 0;
+}
+
+void I420BufferPool::SetMemoryBudget(absl::optional<size_t> budget_bytes) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  memory_account_.set_budget_bytes(budget_bytes);
+}
+
+I420BufferPool::Stats I420BufferPool::GetStats() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  Stats stats = stats_;
+  stats.num_free_buffers = free_list_->size();
+  stats.bytes = memory_account_.bytes();
+  return stats;
+}
+
+void I420BufferPool::DeleteBuffer(PooledI420Buffer* buffer) {
+  memory_account_.Subtract(BufferSize(buffer->width(), buffer->height()));
+  RTC_DCHECK_GT(stats_.num_buffers, 0);
+  --stats_.num_buffers;
+  delete buffer;
+}
+
+void I420BufferPool::TrimFreeBuffers() {
+  while (PooledI420Buffer* buffer = free_list_->Pop()) {
+    DeleteBuffer(buffer);
+    ++stats_.num_trimmed;
+  }
 }
 
 rtc::scoped_refptr<I420Buffer> I420BufferPool::CreateBuffer(int width,
                                                             int height) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-  // Release buffers with wrong resolution.
-  for (auto it = buffers_.begin(); it != buffers_.end();) {
-    if ((*it)->width() != width || (*it)->height() != height)
-      it = buffers_.erase(it);
-    else
-      ++it;
-  }
-  // Look for a free buffer.
-  for (const rtc::scoped_refptr<PooledI420Buffer>& buffer : buffers_) {
-    // If the buffer is in use, the ref count will be >= 2, one from the list we
-    // are looping over and one from the application. If the ref count is 1,
-    // then the list we are looping over holds the only reference and it's safe
-    // to reuse.
-    if (buffer->HasOneRef())
+  // Release buffers with wrong resolution right away, rather than keeping
+  // them until they would be popped.
+  if (width != width_ || height != height_) {
+    width_ = width;
+    height_ = height;
+    TrimFreeBuffers();
+  }
+  // Look for a free buffer. Buffers of an old resolution that were in use at
+  // the last resolution change come back later and are trimmed here.
+  while (PooledI420Buffer* buffer = free_list_->Pop()) {
+    if (buffer->width() == width && buffer->height() == height) {
+      ++stats_.num_reused;
       return buffer;
+    }
+    DeleteBuffer(buffer);
+    ++stats_.num_trimmed;
   }
 
-  if (buffers_.size() >= max_number_of_buffers_)
+  if (stats_.num_buffers >= max_number_of_buffers_ ||
+      memory_account_.IsOverBudget(BufferSize(width, height))) {
+    ++stats_.num_failed;
     return nullptr;
+  }
   // Allocate new buffer.
-  rtc::scoped_refptr<PooledI420Buffer> buffer =
-      new PooledI420Buffer(width, height);
+  PooledI420Buffer* buffer = new PooledI420Buffer(width, height, free_list_);
   if (zero_initialize_)
     buffer->InitializeData();
-  buffers_.push_back(buffer);
+  memory_account_.Add(BufferSize(width, height));
+  ++stats_.num_buffers;
+  ++stats_.num_allocated;
   return buffer;
 }
 
@@ -74,4 +74,61 @@ TEST(TestI420BufferPool, MaxNumberOfBuffers) {
   EXPECT_EQ(nullptr, pool.CreateBuffer(16, 16).get());
 }
 
+TEST(TestI420BufferPool, MemoryBudget) {
+  I420BufferPool pool;
+  // Room for one 16x16 buffer (384 bytes) but not two.
+  pool.SetMemoryBudget(700);
+  rtc::scoped_refptr<I420BufferInterface> buffer1 = pool.CreateBuffer(16, 16);
+  EXPECT_NE(nullptr, buffer1.get());
+  EXPECT_EQ(nullptr, pool.CreateBuffer(16, 16).get());
+  // Changing resolution releases the old buffer.
+  buffer1 = nullptr;
+  EXPECT_NE(nullptr, pool.CreateBuffer(8, 8).get());
+}
+
+TEST(TestI420BufferPool, Stats) {
+  I420BufferPool pool(false, 2);
+  rtc::scoped_refptr<I420BufferInterface> buffer1 = pool.CreateBuffer(16, 16);
+  rtc::scoped_refptr<I420BufferInterface> buffer2 = pool.CreateBuffer(16, 16);
+  EXPECT_EQ(nullptr, pool.CreateBuffer(16, 16).get());
+  buffer1 = nullptr;
+  I420BufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(2u, stats.num_buffers);
+  EXPECT_EQ(1u, stats.num_free_buffers);
+  EXPECT_EQ(2 * 384, stats.bytes);
+  EXPECT_EQ(2, stats.num_allocated);
+  EXPECT_EQ(1, stats.num_failed);
+
+  buffer1 = pool.CreateBuffer(16, 16);
+  stats = pool.GetStats();
+  EXPECT_EQ(1, stats.num_reused);
+  EXPECT_EQ(0u, stats.num_free_buffers);
+}
+
+TEST(TestI420BufferPool, TrimsBuffersOfOldResolution) {
+  I420BufferPool pool;
+  rtc::scoped_refptr<I420BufferInterface> buffer1 = pool.CreateBuffer(16, 16);
+  rtc::scoped_refptr<I420BufferInterface> buffer2 = pool.CreateBuffer(16, 16);
+  // |buffer1| is freed before the resolution change, |buffer2| after it.
+  buffer1 = nullptr;
+  buffer1 = pool.CreateBuffer(8, 8);
+  EXPECT_EQ(1, pool.GetStats().num_trimmed);
+  buffer2 = nullptr;
+  rtc::scoped_refptr<I420BufferInterface> buffer3 = pool.CreateBuffer(8, 8);
+  EXPECT_EQ(8, buffer3->width());
+  I420BufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(2, stats.num_trimmed);
+  EXPECT_EQ(2u, stats.num_buffers);
+  EXPECT_EQ(2 * 96, stats.bytes);
+}
+
+TEST(TestI420BufferPool, FrameReleasedAfterPoolRelease) {
+  I420BufferPool pool;
+  rtc::scoped_refptr<I420BufferInterface> buffer = pool.CreateBuffer(16, 16);
+  pool.Release();
+  EXPECT_EQ(0u, pool.GetStats().num_buffers);
+  buffer = nullptr;
+  EXPECT_EQ(0u, pool.GetStats().num_free_buffers);
+}
+
 }  // namespace webrtc
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+#define COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <list>
+#include <memory>
+
+#include "rtc_base/race_checker.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/scoped_ref_ptr.h"
+
+namespace webrtc {
+
+// Reference counted storage for the bitstream of an EncodedImage. The
+// EncodedImage only points into the buffer, so whoever sets |_buffer| to
+// data() must keep a reference for as long as the image is in use.
+class EncodedImageBuffer : public rtc::RefCountInterface {
+ public:
+  uint8_t* data() { return data_.get(); }
+  const uint8_t* data() const { return data_.get(); }
+  size_t capacity() const { return capacity_; }
+
+ protected:
+  explicit EncodedImageBuffer(size_t capacity);
+  ~EncodedImageBuffer() override;
+
+ private:
+  const std::unique_ptr<uint8_t[]> data_;
+  const size_t capacity_;
+};
+
+// Simple buffer pool to avoid unnecessary allocations of encoded image buffers,
+// analogous to I420BufferPool. When the last reference to a buffer returned by
+// CreateBuffer is dropped, the memory is returned to the pool for use by
+// subsequent calls to CreateBuffer. Free buffers that are too small for a
+// request are purged from the pool.
+class EncodedImageBufferPool {
+ public:
+  EncodedImageBufferPool();
+  explicit EncodedImageBufferPool(size_t max_number_of_buffers);
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer from the pool with a capacity of at least |min_capacity|
+  // bytes. If no suitable buffer exist in the pool and there are less than
+  // |max_number_of_buffers| pending, a buffer is created. Returns null
+  // otherwise.
+  rtc::scoped_refptr<EncodedImageBuffer> CreateBuffer(size_t min_capacity);
+  // Returns a buffer of at least |min_capacity| bytes holding a copy of the
+  // first |size| bytes of |buffer|. Used to grow a buffer while encoding.
+  rtc::scoped_refptr<EncodedImageBuffer> GrowBuffer(
+      const rtc::scoped_refptr<EncodedImageBuffer>& buffer,
+      size_t size,
+      size_t min_capacity);
+  // Clears buffers_ and detaches the race checker so that it can be reused
+  // later from another thread. Buffers still referenced elsewhere stay valid.
+  void Release();
+
+ private:
+  // Explicitly use a RefCountedObject to get access to HasOneRef,
+  // needed by the pool to check exclusive access.
+  using PooledEncodedImageBuffer = rtc::RefCountedObject<EncodedImageBuffer>;
+
+  rtc::RaceChecker race_checker_;
+  std::list<rtc::scoped_refptr<PooledEncodedImageBuffer>> buffers_;
+  // Max number of buffers this pool can have pending.
+  const size_t max_number_of_buffers_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
@@ -12,9 +12,11 @@
 #define COMMON_VIDEO_INCLUDE_I420_BUFFER_POOL_H_
 
 #include <stddef.h>
-#include <list>
+#include <stdint.h>
 
+#include "absl/types/optional.h"
 #include "api/video/i420_buffer.h"
+#include "rtc_base/memory/memory_account.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/refcountedobject.h"
 #include "rtc_base/scoped_ref_ptr.h"
@@ -23,13 +25,31 @@ namespace webrtc {
 
 // Simple buffer pool to avoid unnecessary allocations of I420Buffer objects.
 // The pool manages the memory of the I420Buffer returned from CreateBuffer.
-// When the I420Buffer is destructed, the memory is returned to the pool for use
-// by subsequent calls to CreateBuffer. If the resolution passed to CreateBuffer
-// changes, old buffers will be purged from the pool.
+// When the last reference to an I420Buffer is released, on any thread, the
+// buffer is pushed onto a lock-free free list for use by subsequent calls to
+// CreateBuffer, which therefore takes constant time. If the resolution passed
+// to CreateBuffer changes, old buffers will be purged from the pool.
 // Note that CreateBuffer will crash if more than kMaxNumberOfFramesBeforeCrash
 // are created. This is to prevent memory leaks where frames are not returned.
 class I420BufferPool {
  public:
+  struct Stats {
+    // Buffers allocated by the pool that have not been deleted, whether free
+    // or in use.
+    size_t num_buffers = 0;
+    // Buffers waiting on the free list.
+    size_t num_free_buffers = 0;
+    // Memory of the |num_buffers| buffers.
+    int64_t bytes = 0;
+    // Calls to CreateBuffer that reused a buffer, allocated a new one, or
+    // returned null because of the buffer count limit or the memory budget.
+    int64_t num_reused = 0;
+    int64_t num_allocated = 0;
+    int64_t num_failed = 0;
+    // Buffers deleted because the resolution changed.
+    int64_t num_trimmed = 0;
+  };
+
   I420BufferPool();
   explicit I420BufferPool(bool zero_initialize);
   I420BufferPool(bool zero_initialze, size_t max_number_of_buffers);
@@ -39,17 +59,33 @@ class I420BufferPool {
   // and there are less than |max_number_of_buffers| pending, a buffer is
   // created. Returns null otherwise.
   rtc::scoped_refptr<I420Buffer> CreateBuffer(int width, int height);
-  // Clears buffers_ and detaches the thread checker so that it can be reused
-  // later from another thread.
+  // Clears the pool and detaches the thread checker so that it can be reused
+  // later from another thread. Buffers still in use are deleted when they are
+  // released instead of being returned to the pool.
   void Release();
 
+  // Limits the memory of the buffers in the pool. CreateBuffer returns null
+  // instead of allocating a buffer that would exceed the budget.
+  void SetMemoryBudget(absl::optional<size_t> budget_bytes);
+
+  Stats GetStats() const;
+
  private:
-  // Explicitly use a RefCountedObject to get access to HasOneRef,
-  // needed by the pool to check exclusive access.
-  using PooledI420Buffer = rtc::RefCountedObject<I420Buffer>;
+  class PooledI420Buffer;
+  class FreeList;
+
+  // Deletes a buffer that was taken off the free list.
+  void DeleteBuffer(PooledI420Buffer* buffer);
+  // Deletes all buffers on the free list.
+  void TrimFreeBuffers();
 
   rtc::RaceChecker race_checker_;
-  std::list<rtc::scoped_refptr<PooledI420Buffer>> buffers_;
+  // Shared with all buffers handed out, which push themselves onto it when
+  // released.
+  rtc::scoped_refptr<FreeList> free_list_;
+  // Resolution of the last call to CreateBuffer.
+  int width_ = 0;
+  int height_ = 0;
   // If true, newly allocated buffers are zero-initialized. Note that recycled
   // buffers are not zero'd before reuse. This is required of buffers used by
   // FFmpeg according to http://crbug.com/390941, which only requires it for the
@@ -58,6 +94,9 @@ class I420BufferPool {
   const bool zero_initialize_;
   // Max number of buffers this pool can have pending.
   const size_t max_number_of_buffers_;
+  // Memory held by the buffers counted in |stats_.num_buffers|.
+  rtc::MemoryAccount memory_account_;
+  Stats stats_;
 };
 
 }  // namespace webrtc
@@ -16,8 +16,10 @@
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
 #include "common_video/video_render_frames.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_base/thread_checker.h"
 
 namespace webrtc {
@@ -31,12 +33,18 @@ class IncomingVideoStream : public rtc::VideoSinkInterface<VideoFrame> {
  private:
   void OnFrame(const VideoFrame& video_frame) override;
   void Dequeue();
+  void OnQueuedFramesDone(int num_frames);
 
   rtc::ThreadChecker main_thread_checker_;
   rtc::RaceChecker decoder_race_checker_;
 
   VideoRenderFrames render_buffers_;  // Only touched on the TaskQueue.
   rtc::VideoSinkInterface<VideoFrame>* const callback_;
+  // Number of frames posted to |incoming_render_queue_| that have not yet been
+  // rendered or dropped. Frames to be rendered as soon as possible are passed
+  // on directly while this is zero.
+  rtc::CriticalSection pending_crit_;
+  int num_pending_frames_ RTC_GUARDED_BY(pending_crit_) = 0;
   rtc::TaskQueue incoming_render_queue_;
 };
 
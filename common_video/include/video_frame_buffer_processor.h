@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_VIDEO_FRAME_BUFFER_PROCESSOR_H_
+#define COMMON_VIDEO_INCLUDE_VIDEO_FRAME_BUFFER_PROCESSOR_H_
+
+#include <vector>
+
+#include "api/video/video_frame_buffer.h"
+#include "api/video/video_rotation.h"
+#include "rtc_base/scoped_ref_ptr.h"
+
+namespace webrtc {
+
+// Pipeline stage that crops, scales, rotates and converts frame buffers.
+// Implementations backed by a GPU can process their own native buffers
+// without downloading the pixel data, and return a native buffer that is only
+// converted when a CPU consumer calls ToI420(). Frames then stay on the GPU
+// all the way to a hardware encoder that accepts them.
+class VideoFrameBufferProcessor {
+ public:
+  // Operations are applied in the order crop, scale, rotate.
+  struct Operation {
+    // Area of the input to keep. A zero width or height means the full
+    // input.
+    int crop_x = 0;
+    int crop_y = 0;
+    int crop_width = 0;
+    int crop_height = 0;
+    // Size of the cropped area after scaling, before rotation. A zero width
+    // or height means no scaling.
+    int scaled_width = 0;
+    int scaled_height = 0;
+    VideoRotation rotation = kVideoRotation_0;
+    // Type of the output buffer; kI420 or kNV12. If |allow_native_output| is
+    // set, processors may instead return a kNative buffer, which converts to
+    // |output_type| lazily.
+    VideoFrameBuffer::Type output_type = VideoFrameBuffer::Type::kI420;
+    bool allow_native_output = false;
+  };
+
+  virtual ~VideoFrameBufferProcessor() {}
+
+  // Returns true if |buffer| can be processed by this processor.
+  virtual bool CanProcess(const VideoFrameBuffer& buffer,
+                          const Operation& operation) const = 0;
+
+  // Returns the processed buffer, or null on failure. Must only be called if
+  // CanProcess() returned true.
+  virtual rtc::scoped_refptr<VideoFrameBuffer> Process(
+      const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+      const Operation& operation) = 0;
+};
+
+// Processes any buffer on the CPU using libyuv, downloading native buffers
+// with ToI420() first.
+class LibyuvVideoFrameBufferProcessor : public VideoFrameBufferProcessor {
+ public:
+  bool CanProcess(const VideoFrameBuffer& buffer,
+                  const Operation& operation) const override;
+  rtc::scoped_refptr<VideoFrameBuffer> Process(
+      const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+      const Operation& operation) override;
+};
+
+// Hands each buffer to the first of the added processors that can process
+// it, e.g. a GPU processor for its native buffers, and falls back to libyuv
+// for everything else.
+class VideoFrameBufferProcessorChain : public VideoFrameBufferProcessor {
+ public:
+  VideoFrameBufferProcessorChain();
+  ~VideoFrameBufferProcessorChain() override;
+
+  // |processor| must outlive the chain.
+  void AddProcessor(VideoFrameBufferProcessor* processor);
+
+  bool CanProcess(const VideoFrameBuffer& buffer,
+                  const Operation& operation) const override;
+  rtc::scoped_refptr<VideoFrameBuffer> Process(
+      const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+      const Operation& operation) override;
+
+ private:
+  std::vector<VideoFrameBufferProcessor*> processors_;
+  LibyuvVideoFrameBufferProcessor fallback_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_VIDEO_FRAME_BUFFER_PROCESSOR_H_
@@ -39,12 +39,36 @@ void IncomingVideoStream::OnFrame(const VideoFrame& video_frame) {
   TRACE_EVENT0("webrtc", "IncomingVideoStream::OnFrame");
   RTC_CHECK_RUNS_SERIALIZED(&decoder_race_checker_);
   RTC_DCHECK(!incoming_render_queue_.IsCurrent());
+  // A zero render time means the sender asked for a zero playout delay. Skip
+  // the render queue and its thread hop unless earlier frames are still
+  // waiting in it, in which case the frame is queued behind them to keep the
+  // order. Only this thread adds to the queue, so it stays empty until the
+  // frame has been delivered.
+  if (video_frame.render_time_ms() == 0) {
+    bool queue_empty;
+    {
+      rtc::CritScope lock(&pending_crit_);
+      queue_empty = num_pending_frames_ == 0;
+    }
+    if (queue_empty) {
+      callback_->OnFrame(video_frame);
+      return;
+    }
+  }
+  {
+    rtc::CritScope lock(&pending_crit_);
+    ++num_pending_frames_;
+  }
   // TODO(srte): This struct should be replaced by a lambda with move capture
   // when C++14 lambdas are allowed.
   struct NewFrameTask {
     void operator()() {
       RTC_DCHECK(stream->incoming_render_queue_.IsCurrent());
-      if (stream->render_buffers_.AddFrame(std::move(frame)) == 1)
+      const int32_t num_frames =
+          stream->render_buffers_.AddFrame(std::move(frame));
+      if (num_frames == -1)
+        stream->OnQueuedFramesDone(1);
+      else if (num_frames == 1)
         stream->Dequeue();
     }
     IncomingVideoStream* stream;
@@ -56,9 +80,12 @@ void IncomingVideoStream::OnFrame(const VideoFrame& video_frame) {
 void IncomingVideoStream::Dequeue() {
   TRACE_EVENT0("webrtc", "IncomingVideoStream::Dequeue");
   RTC_DCHECK(incoming_render_queue_.IsCurrent());
+  const size_t num_frames_before = render_buffers_.NumPendingFrames();
   absl::optional<VideoFrame> frame_to_render = render_buffers_.FrameToRender();
   if (frame_to_render)
     callback_->OnFrame(*frame_to_render);
+  OnQueuedFramesDone(
+      static_cast<int>(num_frames_before - render_buffers_.NumPendingFrames()));
 
   if (render_buffers_.HasPendingFrames()) {
     uint32_t wait_time = render_buffers_.TimeToNextFrameRelease();
@@ -66,4 +93,11 @@ void IncomingVideoStream::Dequeue() {
   }
 }
 
+void IncomingVideoStream::OnQueuedFramesDone(int num_frames) {
+  RTC_DCHECK(incoming_render_queue_.IsCurrent());
+  rtc::CritScope lock(&pending_crit_);
+  num_pending_frames_ -= num_frames;
+  RTC_DCHECK_GE(num_pending_frames_, 0);
+}
+
 }  // namespace webrtc
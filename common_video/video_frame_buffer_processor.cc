@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/video_frame_buffer_processor.h"
+
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+bool IsSupportedOutputType(VideoFrameBuffer::Type type) {
+  return type == VideoFrameBuffer::Type::kI420 ||
+         type == VideoFrameBuffer::Type::kNV12;
+}
+
+}  // namespace
+
+bool LibyuvVideoFrameBufferProcessor::CanProcess(
+    const VideoFrameBuffer& buffer,
+    const Operation& operation) const {
+  if (!IsSupportedOutputType(operation.output_type))
+    return false;
+  if (operation.crop_width == 0 || operation.crop_height == 0)
+    return true;
+  return operation.crop_x >= 0 && operation.crop_y >= 0 &&
+         operation.crop_x + operation.crop_width <= buffer.width() &&
+         operation.crop_y + operation.crop_height <= buffer.height();
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> LibyuvVideoFrameBufferProcessor::Process(
+    const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+    const Operation& operation) {
+  RTC_DCHECK(CanProcess(*buffer, operation));
+  const bool crop = operation.crop_width != 0 && operation.crop_height != 0;
+  const int crop_x = crop ? operation.crop_x : 0;
+  const int crop_y = crop ? operation.crop_y : 0;
+  const int crop_width = crop ? operation.crop_width : buffer->width();
+  const int crop_height = crop ? operation.crop_height : buffer->height();
+  const bool scale = operation.scaled_width != 0 &&
+                     operation.scaled_height != 0 &&
+                     (operation.scaled_width != crop_width ||
+                      operation.scaled_height != crop_height);
+  const bool resize = scale || crop_width != buffer->width() ||
+                      crop_height != buffer->height();
+
+  if (!resize && operation.rotation == kVideoRotation_0 &&
+      (buffer->type() == operation.output_type ||
+       (operation.allow_native_output &&
+        buffer->type() == VideoFrameBuffer::Type::kNative))) {
+    return buffer;
+  }
+
+  rtc::scoped_refptr<I420BufferInterface> i420 = buffer->ToI420();
+  if (!i420)
+    return nullptr;
+  if (resize) {
+    rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(
+        scale ? operation.scaled_width : crop_width,
+        scale ? operation.scaled_height : crop_height);
+    scaled->CropAndScaleFrom(*i420, crop_x, crop_y, crop_width, crop_height);
+    i420 = scaled;
+  }
+  if (operation.rotation != kVideoRotation_0)
+    i420 = I420Buffer::Rotate(*i420, operation.rotation);
+
+  if (operation.output_type == VideoFrameBuffer::Type::kNV12)
+    return NV12Buffer::Copy(*i420);
+  return i420;
+}
+
+VideoFrameBufferProcessorChain::VideoFrameBufferProcessorChain() = default;
+VideoFrameBufferProcessorChain::~VideoFrameBufferProcessorChain() = default;
+
+void VideoFrameBufferProcessorChain::AddProcessor(
+    VideoFrameBufferProcessor* processor) {
+  RTC_DCHECK(processor);
+  processors_.push_back(processor);
+}
+
+bool VideoFrameBufferProcessorChain::CanProcess(
+    const VideoFrameBuffer& buffer,
+    const Operation& operation) const {
+  for (const VideoFrameBufferProcessor* processor : processors_) {
+    if (processor->CanProcess(buffer, operation))
+      return true;
+  }
+  return fallback_.CanProcess(buffer, operation);
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> VideoFrameBufferProcessorChain::Process(
+    const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+    const Operation& operation) {
+  for (VideoFrameBufferProcessor* processor : processors_) {
+    if (processor->CanProcess(*buffer, operation))
+      return processor->Process(buffer, operation);
+  }
+  return fallback_.Process(buffer, operation);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/video_frame_buffer_processor.h"
+
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "rtc_base/refcountedobject.h"
+#include "test/fake_texture_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+// Stands in for a GPU processor, which keeps native buffers native.
+class FakeNativeProcessor : public VideoFrameBufferProcessor {
+ public:
+  bool CanProcess(const VideoFrameBuffer& buffer,
+                  const Operation& operation) const override {
+    return buffer.type() == VideoFrameBuffer::Type::kNative &&
+           operation.allow_native_output;
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> Process(
+      const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+      const Operation& operation) override {
+    ++num_processed;
+    const bool transpose = operation.rotation == kVideoRotation_90 ||
+                           operation.rotation == kVideoRotation_270;
+    return new rtc::RefCountedObject<test::FakeNativeBuffer>(
+        transpose ? buffer->height() : buffer->width(),
+        transpose ? buffer->width() : buffer->height());
+  }
+
+  int num_processed = 0;
+};
+
+}  // namespace
+
+TEST(LibyuvVideoFrameBufferProcessorTest, ReturnsInputForNoop) {
+  LibyuvVideoFrameBufferProcessor processor;
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(64, 48);
+  VideoFrameBufferProcessor::Operation operation;
+  ASSERT_TRUE(processor.CanProcess(*buffer, operation));
+  EXPECT_EQ(buffer.get(), processor.Process(buffer, operation).get());
+}
+
+TEST(LibyuvVideoFrameBufferProcessorTest, CropsScalesAndRotates) {
+  LibyuvVideoFrameBufferProcessor processor;
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(64, 48);
+  I420Buffer::SetBlack(buffer);
+  VideoFrameBufferProcessor::Operation operation;
+  operation.crop_x = 8;
+  operation.crop_y = 0;
+  operation.crop_width = 48;
+  operation.crop_height = 48;
+  operation.scaled_width = 24;
+  operation.scaled_height = 24;
+  operation.rotation = kVideoRotation_90;
+  ASSERT_TRUE(processor.CanProcess(*buffer, operation));
+  rtc::scoped_refptr<VideoFrameBuffer> result =
+      processor.Process(buffer, operation);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(VideoFrameBuffer::Type::kI420, result->type());
+  EXPECT_EQ(24, result->width());
+  EXPECT_EQ(24, result->height());
+
+  operation.crop_width = 0;
+  operation.scaled_width = 32;
+  operation.scaled_height = 16;
+  result = processor.Process(buffer, operation);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(16, result->width());
+  EXPECT_EQ(32, result->height());
+}
+
+TEST(LibyuvVideoFrameBufferProcessorTest, ConvertsBetweenI420AndNV12) {
+  LibyuvVideoFrameBufferProcessor processor;
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(64, 48);
+  I420Buffer::SetBlack(buffer);
+  VideoFrameBufferProcessor::Operation operation;
+  operation.output_type = VideoFrameBuffer::Type::kNV12;
+  rtc::scoped_refptr<VideoFrameBuffer> nv12 =
+      processor.Process(buffer, operation);
+  ASSERT_TRUE(nv12);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12, nv12->type());
+  EXPECT_EQ(64, nv12->width());
+  EXPECT_EQ(48, nv12->height());
+
+  operation.output_type = VideoFrameBuffer::Type::kI420;
+  rtc::scoped_refptr<VideoFrameBuffer> i420 = processor.Process(nv12, operation);
+  ASSERT_TRUE(i420);
+  EXPECT_EQ(VideoFrameBuffer::Type::kI420, i420->type());
+}
+
+TEST(LibyuvVideoFrameBufferProcessorTest, RejectsInvalidOperations) {
+  LibyuvVideoFrameBufferProcessor processor;
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(64, 48);
+  VideoFrameBufferProcessor::Operation operation;
+  operation.output_type = VideoFrameBuffer::Type::kI444;
+  EXPECT_FALSE(processor.CanProcess(*buffer, operation));
+  operation.output_type = VideoFrameBuffer::Type::kI420;
+  operation.crop_x = 32;
+  operation.crop_width = 48;
+  operation.crop_height = 48;
+  EXPECT_FALSE(processor.CanProcess(*buffer, operation));
+}
+
+TEST(VideoFrameBufferProcessorChainTest, KeepsNativeBuffersNative) {
+  FakeNativeProcessor native_processor;
+  VideoFrameBufferProcessorChain chain;
+  chain.AddProcessor(&native_processor);
+
+  VideoFrameBufferProcessor::Operation operation;
+  operation.rotation = kVideoRotation_90;
+  operation.allow_native_output = true;
+  rtc::scoped_refptr<VideoFrameBuffer> native =
+      new rtc::RefCountedObject<test::FakeNativeBuffer>(64, 48);
+  rtc::scoped_refptr<VideoFrameBuffer> result =
+      chain.Process(native, operation);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNative, result->type());
+  EXPECT_EQ(48, result->width());
+  EXPECT_EQ(64, result->height());
+  EXPECT_EQ(1, native_processor.num_processed);
+
+  // Memory buffers fall back to libyuv.
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(64, 48);
+  I420Buffer::SetBlack(buffer);
+  result = chain.Process(buffer, operation);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(VideoFrameBuffer::Type::kI420, result->type());
+  EXPECT_EQ(48, result->width());
+  EXPECT_EQ(1, native_processor.num_processed);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/strings/string_builder.h"
+#include "test/gtest.h"
+#include "test/testsupport/microbenchmark.h"
+
+namespace webrtc {
+
+TEST(VideoFrameMicrobenchmark, I420BufferScaleFrom) {
+  struct {
+    int src_width;
+    int src_height;
+    int dst_width;
+    int dst_height;
+  } const kScalings[] = {
+      {1280, 720, 640, 360},
+      {1920, 1080, 1280, 720},
+      {3840, 2160, 1920, 1080},
+  };
+  for (const auto& scaling : kScalings) {
+    rtc::scoped_refptr<I420Buffer> src =
+        I420Buffer::Create(scaling.src_width, scaling.src_height);
+    I420Buffer::SetBlack(src);
+    rtc::scoped_refptr<I420Buffer> dst =
+        I420Buffer::Create(scaling.dst_width, scaling.dst_height);
+    rtc::StringBuilder name;
+    name << "I420Buffer_ScaleFrom" << scaling.src_height << "pTo"
+         << scaling.dst_height << "p";
+    test::RunMicrobenchmark(name.str(), [&] { dst->ScaleFrom(*src); });
+  }
+}
+
+}  // namespace webrtc
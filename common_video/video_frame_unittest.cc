@@ -13,6 +13,7 @@
 
 #include "api/video/i010_buffer.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_frame.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/timeutils.h"
@@ -354,6 +355,60 @@ TEST(TestVideoFrame, TextureInitialValues) {
   EXPECT_EQ(20, frame.timestamp_us());
 }
 
+TEST(TestVideoFrame, UpdateRect) {
+  VideoFrame frame = VideoFrame::Builder()
+                         .set_video_frame_buffer(I420Buffer::Create(64, 48))
+                         .set_update_rect({16, 8, 4, 4})
+                         .build();
+  ASSERT_TRUE(frame.update_rect());
+  VideoFrame copy = frame;
+  EXPECT_EQ(frame.update_rect(), copy.update_rect());
+
+  VideoFrame::UpdateRect rect = {0, 0, 0, 0};
+  EXPECT_TRUE(rect.IsEmpty());
+  rect.Union(*frame.update_rect());
+  EXPECT_EQ(*frame.update_rect(), rect);
+  rect.Union({4, 20, 8, 8});
+  EXPECT_EQ(VideoFrame::UpdateRect({4, 8, 16, 20}), rect);
+  rect.Union({0, 0, 0, 0});
+  EXPECT_EQ(VideoFrame::UpdateRect({4, 8, 16, 20}), rect);
+}
+
+TEST(TestNV12Buffer, CopiesFromAndConvertsToI420) {
+  rtc::scoped_refptr<PlanarYuvBuffer> i420 =
+      CreateGradient(VideoFrameBuffer::Type::kI420, 17, 9);
+  rtc::scoped_refptr<NV12Buffer> nv12 = NV12Buffer::Copy(*i420->GetI420());
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12, nv12->type());
+  EXPECT_EQ(17, nv12->width());
+  EXPECT_EQ(9, nv12->height());
+  EXPECT_EQ(9, nv12->ChromaWidth());
+  EXPECT_EQ(5, nv12->ChromaHeight());
+  EXPECT_GE(nv12->StrideUV(), 2 * nv12->ChromaWidth());
+  // Chroma samples are interleaved.
+  EXPECT_EQ(i420->GetI420()->DataU()[3], nv12->DataUV()[6]);
+  EXPECT_EQ(i420->GetI420()->DataV()[3], nv12->DataUV()[7]);
+
+  EXPECT_TRUE(test::FrameBufsEqual(i420, nv12->ToI420()));
+}
+
+TEST(TestNV12Buffer, Copy) {
+  rtc::scoped_refptr<PlanarYuvBuffer> i420 =
+      CreateGradient(VideoFrameBuffer::Type::kI420, 16, 8);
+  rtc::scoped_refptr<NV12Buffer> nv12 = NV12Buffer::Copy(*i420->GetI420());
+  rtc::scoped_refptr<NV12Buffer> copy = NV12Buffer::Copy(*nv12);
+  EXPECT_NE(nv12->DataY(), copy->DataY());
+  EXPECT_TRUE(test::FrameBufsEqual(i420, copy->ToI420()));
+}
+
+TEST(TestNV12Buffer, SharesI420Conversion) {
+  rtc::scoped_refptr<PlanarYuvBuffer> i420 =
+      CreateGradient(VideoFrameBuffer::Type::kI420, 16, 8);
+  rtc::scoped_refptr<NV12Buffer> nv12 = NV12Buffer::Copy(*i420->GetI420());
+  rtc::scoped_refptr<I420BufferInterface> converted = nv12->ToI420();
+  EXPECT_EQ(converted, nv12->ToI420());
+  EXPECT_TRUE(test::FrameBufsEqual(i420, converted));
+}
+
 class TestPlanarYuvBuffer
     : public ::testing::TestWithParam<VideoFrameBuffer::Type> {};
 
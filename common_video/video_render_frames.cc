@@ -51,6 +51,13 @@ VideoRenderFrames::~VideoRenderFrames() {
 int32_t VideoRenderFrames::AddFrame(VideoFrame&& new_frame) {
   const int64_t time_now = rtc::TimeMillis();
 
+  // A zero render time means render as soon as possible, so such a frame is
+  // neither too old nor out of order.
+  if (new_frame.render_time_ms() == 0) {
+    incoming_frames_.emplace_back(std::move(new_frame));
+    return static_cast<int32_t>(incoming_frames_.size());
+  }
+
   // Drop old frames only when there are other frames in the queue, otherwise, a
   // really slow system never renders any frames.
   if (!incoming_frames_.empty() &&
@@ -113,4 +120,8 @@ bool VideoRenderFrames::HasPendingFrames() const {
   return !incoming_frames_.empty();
 }
 
+size_t VideoRenderFrames::NumPendingFrames() const {
+  return incoming_frames_.size();
+}
+
 }  // namespace webrtc
@@ -38,6 +38,8 @@ class VideoRenderFrames {
 
   bool HasPendingFrames() const;
 
+  size_t NumPendingFrames() const;
+
  private:
   // Sorted list with framed to be rendered, oldest first.
   std::list<VideoFrame> incoming_frames_;
@@ -248,6 +248,15 @@ class FixedLengthDeltaEncoder final {
       uint64_t* max_pos_signed_delta,
       uint64_t* min_neg_signed_delta);
 
+  // Update the min/max values of unsigned/signed deltas with the delta from
+  // |previous| to |current|, for values of width |bit_mask|.
+  static void UpdateMinAndMaxDeltas(uint64_t previous,
+                                    uint64_t current,
+                                    uint64_t bit_mask,
+                                    uint64_t* max_unsigned_delta,
+                                    uint64_t* max_pos_signed_delta,
+                                    uint64_t* min_neg_signed_delta);
+
   // No effect outside of unit tests.
   // In unit tests, may lead to forcing signed/unsigned deltas, etc.
   static void ConsiderTestOverrides(FixedLengthEncodingParameters* params,
@@ -303,27 +312,28 @@ class FixedLengthDeltaEncoder final {
   RTC_DISALLOW_COPY_AND_ASSIGN(FixedLengthDeltaEncoder);
 };
 
-// TODO(eladalon): Reduce the number of passes.
 std::string FixedLengthDeltaEncoder::EncodeDeltas(
     absl::optional<uint64_t> base,
     const std::vector<absl::optional<uint64_t>>& values) {
   RTC_DCHECK(!values.empty());
 
-  // As a special case, if all of the elements are identical to the base,
-  // (including, for optional fields, about their existence/non-existence),
-  // the empty string is used to signal that.
-  if (std::all_of(
-          values.cbegin(), values.cend(),
-          [base](absl::optional<uint64_t> val) { return val == base; })) {
-    return std::string();
-  }
-
+  // A single pass collects everything needed for the encoding parameters,
+  // including the deltas for 64-bit values. Only sequences that are not
+  // non-decreasing, and whose values are narrower, need a second pass.
+  bool all_identical_to_base = true;
   bool non_decreasing = true;
   uint64_t max_value_including_base = base.value_or(0u);
   size_t existent_values_count = 0;
+  const uint64_t full_width_bit_mask =
+      MaxUnsignedValueOfBitWidth(kDefaultValueWidthBits);
+  uint64_t max_unsigned_delta = 0;
+  uint64_t max_pos_signed_delta = 0;
+  uint64_t min_neg_signed_delta = 0;
   {
     uint64_t previous = base.value_or(0u);
+    bool previous_exists = base.has_value();
     for (size_t i = 0; i < values.size(); ++i) {
+      all_identical_to_base &= (values[i] == base);
       if (!values[i].has_value()) {
         continue;
       }
@@ -331,20 +341,35 @@ std::string FixedLengthDeltaEncoder::EncodeDeltas(
       non_decreasing &= (previous <= values[i].value());
       max_value_including_base =
           std::max(max_value_including_base, values[i].value());
+      // If the base is non-existent, the first existent value is encoded as
+      // a varint, rather than as a delta.
+      if (previous_exists) {
+        UpdateMinAndMaxDeltas(previous, values[i].value(), full_width_bit_mask,
+                              &max_unsigned_delta, &max_pos_signed_delta,
+                              &min_neg_signed_delta);
+      }
       previous = values[i].value();
+      previous_exists = true;
     }
   }
 
+  // As a special case, if all of the elements are identical to the base,
+  // (including, for optional fields, about their existence/non-existence),
+  // the empty string is used to signal that.
+  if (all_identical_to_base) {
+    return std::string();
+  }
+
   // If the sequence is non-decreasing, it may be assumed to have width = 64;
   // there's no reason to encode the actual max width in the encoding header.
   const uint64_t value_width_bits =
       non_decreasing ? 64 : UnsignedBitWidth(max_value_including_base);
 
-  uint64_t max_unsigned_delta;
-  uint64_t max_pos_signed_delta;
-  uint64_t min_neg_signed_delta;
-  CalculateMinAndMaxDeltas(base, values, value_width_bits, &max_unsigned_delta,
-                           &max_pos_signed_delta, &min_neg_signed_delta);
+  if (value_width_bits != kDefaultValueWidthBits) {
+    CalculateMinAndMaxDeltas(base, values, value_width_bits,
+                             &max_unsigned_delta, &max_pos_signed_delta,
+                             &min_neg_signed_delta);
+  }
 
   const uint64_t delta_width_bits_unsigned =
       UnsignedBitWidth(max_unsigned_delta);
@@ -404,18 +429,8 @@ void FixedLengthDeltaEncoder::CalculateMinAndMaxDeltas(
     }
 
     const uint64_t current = values[i].value();
-
-    const uint64_t forward_delta = UnsignedDelta(*prev, current, bit_mask);
-    const uint64_t backward_delta = UnsignedDelta(current, *prev, bit_mask);
-
-    max_unsigned_delta = std::max(max_unsigned_delta, forward_delta);
-
-    if (forward_delta < backward_delta) {
-      max_pos_signed_delta = std::max(max_pos_signed_delta, forward_delta);
-    } else {
-      min_neg_signed_delta = std::max(min_neg_signed_delta, backward_delta);
-    }
-
+    UpdateMinAndMaxDeltas(*prev, current, bit_mask, &max_unsigned_delta,
+                          &max_pos_signed_delta, &min_neg_signed_delta);
     prev = current;
   }
 
@@ -424,6 +439,25 @@ void FixedLengthDeltaEncoder::CalculateMinAndMaxDeltas(
   *min_neg_signed_delta_out = min_neg_signed_delta;
 }
 
+void FixedLengthDeltaEncoder::UpdateMinAndMaxDeltas(
+    uint64_t previous,
+    uint64_t current,
+    uint64_t bit_mask,
+    uint64_t* max_unsigned_delta,
+    uint64_t* max_pos_signed_delta,
+    uint64_t* min_neg_signed_delta) {
+  const uint64_t forward_delta = UnsignedDelta(previous, current, bit_mask);
+  const uint64_t backward_delta = UnsignedDelta(current, previous, bit_mask);
+
+  *max_unsigned_delta = std::max(*max_unsigned_delta, forward_delta);
+
+  if (forward_delta < backward_delta) {
+    *max_pos_signed_delta = std::max(*max_pos_signed_delta, forward_delta);
+  } else {
+    *min_neg_signed_delta = std::max(*min_neg_signed_delta, backward_delta);
+  }
+}
+
 void FixedLengthDeltaEncoder::ConsiderTestOverrides(
     FixedLengthEncodingParameters* params,
     uint64_t delta_width_bits_signed,
@@ -51,6 +51,18 @@ class RtcEventLog {
 
   // Log an RTC event (the type of event is determined by the subclass).
   virtual void Log(std::unique_ptr<RtcEvent> event) = 0;
+
+  // Keeps the events of the last |window_ms| milliseconds in memory, encoded
+  // in batches, while no output is active. The recording can be written to an
+  // output at any time with DumpFlightRecorder, without stopping it. Returns
+  // false if flight recording isn't supported.
+  virtual bool StartFlightRecorder(int64_t window_ms) { return false; }
+
+  // Writes the configuration events and the recorded events to |output| as a
+  // complete log. The write happens asynchronously.
+  virtual bool DumpFlightRecorder(std::unique_ptr<RtcEventLogOutput> output) {
+    return false;
+  }
 };
 
 // No-op implementation is used if flag is not set, or in tests.
@@ -14,6 +14,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -41,6 +42,11 @@ constexpr size_t kMaxEventsInHistory = 10000;
 // The config-history is supposed to be unbounded, but needs to have some bound
 // to prevent an attack via unreasonable memory use.
 constexpr size_t kMaxEventsInConfigHistory = 1000;
+// In flight recorder mode, non-config events are encoded in batches spanning at
+// most this long, or holding at most this many events. The recording is
+// trimmed one batch at a time.
+constexpr int64_t kFlightRecorderBatchMs = 1000;
+constexpr size_t kMaxEventsInFlightRecorderBatch = 1000;
 
 // TODO(eladalon): This class exists because C++11 doesn't allow transferring a
 // unique_ptr to a lambda (a copy constructor is required). We should get
@@ -94,8 +100,17 @@ class RtcEventLogImpl final : public RtcEventLog {
 
   void Log(std::unique_ptr<RtcEvent> event) override;
 
+  bool StartFlightRecorder(int64_t window_ms) override;
+  bool DumpFlightRecorder(std::unique_ptr<RtcEventLogOutput> output) override;
+
  private:
+  struct EncodedBatch {
+    int64_t last_timestamp_ms;
+    std::string encoded;
+  };
+
   void LogToMemory(std::unique_ptr<RtcEvent> event) RTC_RUN_ON(task_queue_);
+  void MoveHistoryToFlightRecorder() RTC_RUN_ON(task_queue_);
   void LogEventsFromMemoryToOutput() RTC_RUN_ON(task_queue_);
 
   void StopOutput() RTC_RUN_ON(task_queue_);
@@ -120,6 +135,12 @@ class RtcEventLogImpl final : public RtcEventLog {
   // History containing the most recent (non-configuration) events (~10s).
   std::deque<std::unique_ptr<RtcEvent>> history_ RTC_GUARDED_BY(*task_queue_);
 
+  // In flight recorder mode, the encoded batches of non-config events of the
+  // last |flight_recorder_window_ms_|, oldest first.
+  absl::optional<int64_t> flight_recorder_window_ms_
+      RTC_GUARDED_BY(*task_queue_);
+  std::deque<EncodedBatch> flight_recorder_ RTC_GUARDED_BY(*task_queue_);
+
   size_t max_size_bytes_ RTC_GUARDED_BY(*task_queue_);
   size_t written_bytes_ RTC_GUARDED_BY(*task_queue_);
 
@@ -241,6 +262,50 @@ void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
       std::move(event), event_handler));
 }
 
+bool RtcEventLogImpl::StartFlightRecorder(int64_t window_ms) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&owner_sequence_checker_);
+  RTC_DCHECK_GT(window_ms, 0);
+
+  // Binding to |this| is safe because |this| outlives the |task_queue_|.
+  task_queue_->PostTask([this, window_ms]() {
+    RTC_DCHECK_RUN_ON(task_queue_.get());
+    flight_recorder_window_ms_ = window_ms;
+  });
+  return true;
+}
+
+bool RtcEventLogImpl::DumpFlightRecorder(
+    std::unique_ptr<RtcEventLogOutput> output) {
+  if (!output->IsActive())
+    return false;
+
+  const int64_t timestamp_us = rtc::TimeMicros();
+  const int64_t utc_time_us = rtc::TimeUTCMicros();
+
+  // Binding to |this| is safe because |this| outlives the |task_queue_|.
+  auto dump = [this, timestamp_us,
+               utc_time_us](std::unique_ptr<RtcEventLogOutput> output) {
+    RTC_DCHECK_RUN_ON(task_queue_.get());
+    // The events not yet moved to |flight_recorder_| are encoded as well, but
+    // are kept in |history_| so the recording is left unchanged.
+    std::string encoded =
+        event_encoder_->EncodeLogStart(timestamp_us, utc_time_us);
+    encoded += event_encoder_->EncodeBatch(config_history_.begin(),
+                                           config_history_.end());
+    for (const EncodedBatch& batch : flight_recorder_)
+      encoded += batch.encoded;
+    encoded += event_encoder_->EncodeBatch(history_.begin(), history_.end());
+    encoded += event_encoder_->EncodeLogEnd(rtc::TimeMicros());
+    if (!output->Write(encoded))
+      RTC_LOG(LS_ERROR) << "Failed to write flight recorder to output.";
+  };
+
+  task_queue_->PostTask(
+      absl::make_unique<ResourceOwningTask<RtcEventLogOutput>>(
+          std::move(output), dump));
+  return true;
+}
+
 void RtcEventLogImpl::ScheduleOutput() {
   RTC_DCHECK(event_output_ && event_output_->IsActive());
   if (history_.size() >= kMaxEventsInHistory) {
@@ -288,6 +353,26 @@ void RtcEventLogImpl::LogToMemory(std::unique_ptr<RtcEvent> event) {
     container.pop_front();
   }
   container.push_back(std::move(event));
+
+  if (flight_recorder_window_ms_ && !event_output_ && !history_.empty() &&
+      (history_.size() >= kMaxEventsInFlightRecorderBatch ||
+       history_.back()->timestamp_ms() - history_.front()->timestamp_ms() >=
+           kFlightRecorderBatchMs)) {
+    MoveHistoryToFlightRecorder();
+  }
+}
+
+void RtcEventLogImpl::MoveHistoryToFlightRecorder() {
+  const int64_t last_timestamp_ms = history_.back()->timestamp_ms();
+  flight_recorder_.push_back(
+      {last_timestamp_ms,
+       event_encoder_->EncodeBatch(history_.begin(), history_.end())});
+  history_.clear();
+
+  while (last_timestamp_ms - flight_recorder_.front().last_timestamp_ms >
+         *flight_recorder_window_ms_) {
+    flight_recorder_.pop_front();
+  }
 }
 
 void RtcEventLogImpl::LogEventsFromMemoryToOutput() {
@@ -12,6 +12,12 @@
 
 #include <stdint.h>
 #include <string.h>
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <algorithm>
 #include <fstream>
@@ -365,6 +371,8 @@ std::vector<RtpExtension> GetRuntimeRtpHeaderExtensionConfig(
 }
 // End of conversion functions.
 
+constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
+
 // Reads a VarInt from |stream| and returns it. Also writes the read bytes to
 // |buffer| starting |bytes_written| bytes into the buffer. |bytes_written| is
 // incremented for each written byte.
@@ -394,6 +402,20 @@ absl::optional<uint64_t> ParseVarInt(
   return absl::nullopt;
 }
 
+// Reads a VarInt from the buffer at |*data| and returns it. |*data| is advanced
+// past the read bytes. Reads no further than |end|.
+absl::optional<uint64_t> ParseVarInt(const char** data, const char* end) {
+  uint64_t varint = 0;
+  for (size_t bytes_read = 0; bytes_read < 10 && *data < end; ++bytes_read) {
+    const uint8_t byte = static_cast<uint8_t>(*(*data)++);
+    varint |= static_cast<uint64_t>(byte & 0x7F) << (7 * bytes_read);
+    if ((byte & 0x80) == 0) {
+      return varint;
+    }
+  }
+  return absl::nullopt;
+}
+
 void GetHeaderExtensions(std::vector<RtpExtension>* header_extensions,
                          const RepeatedPtrField<rtclog::RtpHeaderExtension>&
                              proto_header_extensions) {
@@ -919,6 +941,36 @@ void ParsedRtcEventLog::Clear() {
 }
 
 bool ParsedRtcEventLog::ParseFile(const std::string& filename) {
+#if defined(WEBRTC_POSIX)
+  // Map the file instead of reading it through a stream, so that the messages
+  // can be parsed in place and the file contents are paged in on demand.
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    RTC_LOG(LS_WARNING) << "Could not open file for reading.";
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    RTC_LOG(LS_WARNING) << "Could not get size of file.";
+    return false;
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  if (size == 0) {
+    close(fd);
+    return ParseBuffer(nullptr, 0);
+  }
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    RTC_LOG(LS_WARNING) << "Could not map file for reading.";
+    return false;
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+  bool success = ParseBuffer(static_cast<const char*>(data), size);
+  munmap(data, size);
+  return success;
+#else
   std::ifstream file(  // no-presubmit-check TODO(webrtc:8982)
       filename, std::ios_base::in | std::ios_base::binary);
   if (!file.good() || !file.is_open()) {
@@ -927,19 +979,29 @@ bool ParsedRtcEventLog::ParseFile(const std::string& filename) {
   }
 
   return ParseStream(file);
+#endif
 }
 
 bool ParsedRtcEventLog::ParseString(const std::string& s) {
-  std::istringstream stream(  // no-presubmit-check TODO(webrtc:8982)
-      s, std::ios_base::in | std::ios_base::binary);
-  return ParseStream(stream);
+  return ParseBuffer(s.data(), s.size());
+}
+
+bool ParsedRtcEventLog::ParseBuffer(const char* data, size_t size) {
+  Clear();
+  bool success = ParseBufferInternal(data, size);
+  StoreDerivedEvents();
+  return success;
 }
 
 bool ParsedRtcEventLog::ParseStream(
     std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
   Clear();
   bool success = ParseStreamInternal(stream);
+  StoreDerivedEvents();
+  return success;
+}
 
+void ParsedRtcEventLog::StoreDerivedEvents() {
   // Cache the configured SSRCs.
   for (const auto& video_recv_config : video_recv_configs()) {
     incoming_video_ssrcs_.insert(video_recv_config.config.remote_ssrc);
@@ -1039,13 +1101,10 @@ bool ParsedRtcEventLog::ParseStream(
   }
   StoreFirstAndLastTimestamp(incoming_rtcp_packets());
   StoreFirstAndLastTimestamp(outgoing_rtcp_packets());
-
-  return success;
 }
 
 bool ParsedRtcEventLog::ParseStreamInternal(
     std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
-  constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
   std::vector<char> buffer(0xFFFF);
 
   RTC_DCHECK(stream.good());
@@ -1062,7 +1121,6 @@ bool ParsedRtcEventLog::ParseStreamInternal(
     // is supposed to be 1 and the wire type for a length-delimited field is 2.
     // In the new encoding we still expect the wire type to be 2, but the field
     // number will be greater than 1.
-    constexpr uint64_t kExpectedV1Tag = (1 << 3) | 2;
     size_t bytes_written = 0;
     absl::optional<uint64_t> tag =
         ParseVarInt(stream, buffer.data(), &bytes_written);
@@ -1101,26 +1159,74 @@ bool ParsedRtcEventLog::ParseStreamInternal(
     }
     size_t buffer_size = bytes_written + *message_length;
 
-    if (*tag == kExpectedV1Tag) {
-      // Parse the protobuf event from the buffer.
-      rtclog::EventStream event_stream;
-      if (!event_stream.ParseFromArray(buffer.data(), buffer_size)) {
-        RTC_LOG(LS_WARNING)
-            << "Failed to parse legacy-format protobuf message.";
-        return false;
-      }
+    if (!ParseMessage(*tag, buffer.data(), buffer_size))
+      return false;
+  }
+  return true;
+}
 
-      RTC_CHECK_EQ(event_stream.stream_size(), 1);
-      StoreParsedLegacyEvent(event_stream.stream(0));
-    } else {
-      // Parse the protobuf event from the buffer.
-      rtclog2::EventStream event_stream;
-      if (!event_stream.ParseFromArray(buffer.data(), buffer_size)) {
-        RTC_LOG(LS_WARNING) << "Failed to parse new-format protobuf message.";
-        return false;
-      }
-      StoreParsedNewFormatEvent(event_stream);
+bool ParsedRtcEventLog::ParseBufferInternal(const char* data, size_t size) {
+  const char* const end = data + size;
+  while (data < end) {
+    // See ParseStreamInternal for the framing. The message is parsed directly
+    // from the buffer, including its tag and length.
+    const char* const message = data;
+    absl::optional<uint64_t> tag = ParseVarInt(&data, end);
+    if (!tag) {
+      RTC_LOG(LS_WARNING)
+          << "Missing field tag from beginning of protobuf event.";
+      return false;
+    }
+    constexpr uint64_t kWireTypeMask = 0x07;
+    const uint64_t wire_type = *tag & kWireTypeMask;
+    if (wire_type != 2) {
+      RTC_LOG(LS_WARNING) << "Expected field tag with wire type 2 (length "
+                             "delimited message). Found wire type "
+                          << wire_type;
+      return false;
+    }
+
+    absl::optional<uint64_t> message_length = ParseVarInt(&data, end);
+    if (!message_length) {
+      RTC_LOG(LS_WARNING) << "Missing message length after protobuf field tag.";
+      return false;
+    } else if (*message_length > kMaxEventSize) {
+      RTC_LOG(LS_WARNING) << "Protobuf message length is too large.";
+      return false;
+    } else if (*message_length > static_cast<uint64_t>(end - data)) {
+      RTC_LOG(LS_WARNING) << "Failed to read protobuf message from buffer.";
+      return false;
+    }
+    data += *message_length;
+
+    if (!ParseMessage(*tag, message, data - message))
+      return false;
+  }
+  return true;
+}
+
+bool ParsedRtcEventLog::ParseMessage(uint64_t tag,
+                                     const char* message,
+                                     size_t size) {
+  constexpr uint64_t kExpectedV1Tag = (1 << 3) | 2;
+  if (tag == kExpectedV1Tag) {
+    // Parse the protobuf event from the buffer.
+    rtclog::EventStream event_stream;
+    if (!event_stream.ParseFromArray(message, size)) {
+      RTC_LOG(LS_WARNING) << "Failed to parse legacy-format protobuf message.";
+      return false;
+    }
+
+    RTC_CHECK_EQ(event_stream.stream_size(), 1);
+    StoreParsedLegacyEvent(event_stream.stream(0));
+  } else {
+    // Parse the protobuf event from the buffer.
+    rtclog2::EventStream event_stream;
+    if (!event_stream.ParseFromArray(message, size)) {
+      RTC_LOG(LS_WARNING) << "Failed to parse new-format protobuf message.";
+      return false;
     }
+    StoreParsedNewFormatEvent(event_stream);
   }
   return true;
 }
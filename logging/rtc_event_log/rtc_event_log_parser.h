@@ -267,6 +267,10 @@ class ParsedRtcEventLog {
   // Reads an RtcEventLog from a string and returns true if successful.
   bool ParseString(const std::string& s);
 
+  // Reads an RtcEventLog from a buffer and returns true if successful. The
+  // messages are parsed in place, without copying the buffer.
+  bool ParseBuffer(const char* data, size_t size);
+
   // Reads an RtcEventLog from an istream and returns true if successful.
   bool ParseStream(
       std::istream& stream);  // no-presubmit-check TODO(webrtc:8982)
@@ -462,6 +466,13 @@ class ParsedRtcEventLog {
  private:
   bool ParseStreamInternal(
       std::istream& stream);  // no-presubmit-check TODO(webrtc:8982)
+  bool ParseBufferInternal(const char* data, size_t size);
+  // Parses one length-delimited EventStream message, including its tag and
+  // length, and stores its events.
+  bool ParseMessage(uint64_t tag, const char* message, size_t size);
+
+  // Fills in the events and lookups derived from the parsed events.
+  void StoreDerivedEvents();
 
   void StoreParsedLegacyEvent(const rtclog::Event& event);
 
@@ -822,6 +822,48 @@ TEST_P(RtcEventLogCircularBufferTest, KeepsMostRecentEvents) {
   }
 }
 
+TEST_P(RtcEventLogCircularBufferTest, FlightRecorderKeepsRecentEvents) {
+  constexpr size_t kNumEvents = 100;
+  constexpr int64_t kEventIntervalUs = 100000;
+  constexpr int64_t kWindowMs = 2000;
+  constexpr int32_t kStartBitrate = 1000000;
+
+  auto test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+  std::string test_name =
+      std::string(test_info->test_case_name()) + "_" + test_info->name();
+  std::replace(test_name.begin(), test_name.end(), '/', '_');
+  const std::string temp_filename = test::OutputPath() + test_name;
+
+  rtc::ScopedFakeClock fake_clock;
+  fake_clock.SetTimeMicros(1000000);
+
+  std::unique_ptr<RtcEventLog> log_dumper(RtcEventLog::Create(encoding_type_));
+  ASSERT_TRUE(log_dumper->StartFlightRecorder(kWindowMs));
+  for (size_t i = 0; i < kNumEvents; i++) {
+    log_dumper->Log(absl::make_unique<RtcEventProbeResultSuccess>(
+        i, kStartBitrate + i * 1000));
+    fake_clock.AdvanceTimeMicros(kEventIntervalUs);
+  }
+  ASSERT_TRUE(log_dumper->DumpFlightRecorder(
+      absl::make_unique<RtcEventLogOutputFile>(temp_filename, 10000000)));
+  // Destroying the log waits for the dump to be written.
+  log_dumper.reset();
+
+  ParsedRtcEventLog parsed_log;
+  ASSERT_TRUE(parsed_log.ParseFile(temp_filename));
+  EXPECT_EQ(1u, parsed_log.start_log_events().size());
+  EXPECT_EQ(1u, parsed_log.stop_log_events().size());
+
+  // The recording is trimmed one batch (up to a second of events) at a time.
+  const auto& events = parsed_log.bwe_probe_success_events();
+  const size_t kEventsInWindow = kWindowMs * 1000 / kEventIntervalUs;
+  ASSERT_GE(events.size(), kEventsInWindow);
+  EXPECT_LE(events.size(), kEventsInWindow + 1000000 / kEventIntervalUs + 1);
+  for (size_t i = 0; i < events.size(); ++i) {
+    EXPECT_EQ(kNumEvents - events.size() + i, events[i].id);
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
     RtcEventLogTest,
     RtcEventLogCircularBufferTest,
@@ -51,15 +51,25 @@ void AdaptedVideoTrackSource::OnFrame(const webrtc::VideoFrame& frame) {
      true was just added. The VideoBroadcaster enforces
      synchronization for us in this case, by not passing the frame on
      to sinks which don't want it. */
-  if (apply_rotation() && frame.rotation() != webrtc::kVideoRotation_0 &&
-      buffer->type() == webrtc::VideoFrameBuffer::Type::kI420) {
-    /* Apply pending rotation. */
-    broadcaster_.OnFrame(webrtc::VideoFrame(
-        webrtc::I420Buffer::Rotate(*buffer->GetI420(), frame.rotation()),
-        webrtc::kVideoRotation_0, frame.timestamp_us()));
-  } else {
-    broadcaster_.OnFrame(frame);
+  if (apply_rotation() && frame.rotation() != webrtc::kVideoRotation_0) {
+    webrtc::VideoFrameBufferProcessor::Operation operation;
+    operation.rotation = frame.rotation();
+    operation.allow_native_output = true;
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer> rotated;
+    if (frame_buffer_processor_ &&
+        frame_buffer_processor_->CanProcess(*buffer, operation)) {
+      rotated = frame_buffer_processor_->Process(buffer, operation);
+    } else if (buffer->type() == webrtc::VideoFrameBuffer::Type::kI420) {
+      rotated = webrtc::I420Buffer::Rotate(*buffer->GetI420(), frame.rotation());
+    }
+    if (rotated) {
+      /* Apply pending rotation. */
+      broadcaster_.OnFrame(webrtc::VideoFrame(
+          rotated, webrtc::kVideoRotation_0, frame.timestamp_us()));
+      return;
+    }
   }
+  broadcaster_.OnFrame(frame);
 }
 
 void AdaptedVideoTrackSource::AddOrUpdateSink(
@@ -19,6 +19,7 @@
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
 #include "api/video/video_source_interface.h"
+#include "common_video/include/video_frame_buffer_processor.h"
 #include "media/base/videoadapter.h"
 #include "media/base/videobroadcaster.h"
 #include "rtc_base/criticalsection.h"
@@ -42,10 +43,20 @@ class AdaptedVideoTrackSource
   // alignment.
   explicit AdaptedVideoTrackSource(int required_alignment);
   // Checks the apply_rotation() flag. If the frame needs rotation, and it is a
-  // plain memory frame, it is rotated. Subclasses producing native frames must
-  // handle apply_rotation() themselves.
+  // plain memory frame or a buffer the frame buffer processor can process, it
+  // is rotated. Subclasses producing other native frames must handle
+  // apply_rotation() themselves.
   void OnFrame(const webrtc::VideoFrame& frame);
 
+  // Sets a processor, e.g. a GPU backed one, used to rotate frames before
+  // they are passed to sinks. Native frames it returns are passed on
+  // without being converted. Must be called before frames are delivered, and
+  // |processor| must outlive the source.
+  void set_frame_buffer_processor(
+      webrtc::VideoFrameBufferProcessor* processor) {
+    frame_buffer_processor_ = processor;
+  }
+
   // Reports the appropriate frame size after adaptation. Returns true
   // if a frame is wanted. Returns false if there are no interested
   // sinks, or if the VideoAdapter decides to drop the frame.
@@ -87,6 +98,8 @@ class AdaptedVideoTrackSource
   absl::optional<Stats> stats_ RTC_GUARDED_BY(stats_crit_);
 
   VideoBroadcaster broadcaster_;
+
+  webrtc::VideoFrameBufferProcessor* frame_buffer_processor_ = nullptr;
 };
 
 }  // namespace rtc
@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "api/call/audio_sink.h"
+#include "api/video/encoded_image.h"
 #include "media/base/rtputils.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/gunit.h"
@@ -262,11 +263,13 @@ void FakeVideoSendStream::ReconfigureVideoEncoder(
 void FakeVideoSendStream::UpdateActiveSimulcastLayers(
     const std::vector<bool> active_layers) {
   sending_ = false;
-  for (const bool active_layer : active_layers) {
-    if (active_layer) {
+  for (size_t i = 0; i < active_layers.size(); ++i) {
+    if (active_layers[i])
       sending_ = true;
-      break;
-    }
+    if (i < encoder_config_.simulcast_layers.size())
+      encoder_config_.simulcast_layers[i].active = active_layers[i];
+    if (i < video_streams_.size())
+      video_streams_[i].active = active_layers[i];
   }
 }
 
@@ -314,6 +317,18 @@ void FakeVideoSendStream::InjectVideoSinkWants(
   source_->AddOrUpdateSink(this, wants);
 }
 
+void FakeVideoSendStream::InjectEncodedImage(
+    const webrtc::EncodedImage& encoded_image,
+    const webrtc::CodecSpecificInfo& codec_specific_info,
+    const webrtc::RTPFragmentationHeader* fragmentation) {
+  injected_timestamps_.push_back(encoded_image.Timestamp());
+}
+
+void FakeVideoSendStream::SetKeyFrameRequestSender(
+    webrtc::KeyFrameRequestSender* sender) {
+  key_frame_request_sender_ = sender;
+}
+
 FakeVideoReceiveStream::FakeVideoReceiveStream(
     webrtc::VideoReceiveStream::Config config)
     : config_(std::move(config)),
@@ -369,6 +384,21 @@ int FakeVideoReceiveStream::GetNumRemovedSecondarySinks() const {
   return num_removed_secondary_sinks_;
 }
 
+void FakeVideoReceiveStream::SetEncodedFrameSink(
+    webrtc::EncodedFrameSinkInterface* sink,
+    bool decode_frames) {
+  encoded_frame_sink_ = sink;
+  decode_frames_ = decode_frames;
+}
+
+void FakeVideoReceiveStream::RequestKeyFrame() {
+  ++num_key_frame_requests_;
+}
+
+void FakeVideoReceiveStream::SetDecodingPaused(bool paused) {
+  decoding_paused_ = paused;
+}
+
 FakeFlexfecReceiveStream::FakeFlexfecReceiveStream(
     const webrtc::FlexfecReceiveStream::Config& config)
     : config_(config) {}
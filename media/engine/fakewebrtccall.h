@@ -153,6 +153,21 @@ class FakeVideoSendStream final
     return source_;
   }
 
+  void InjectEncodedImage(
+      const webrtc::EncodedImage& encoded_image,
+      const webrtc::CodecSpecificInfo& codec_specific_info,
+      const webrtc::RTPFragmentationHeader* fragmentation) override;
+  void SetKeyFrameRequestSender(
+      webrtc::KeyFrameRequestSender* sender) override;
+
+  // RTP timestamps of the encoded images injected so far.
+  const std::vector<uint32_t>& injected_timestamps() const {
+    return injected_timestamps_;
+  }
+  webrtc::KeyFrameRequestSender* key_frame_request_sender() const {
+    return key_frame_request_sender_;
+  }
+
  private:
   // rtc::VideoSinkInterface<VideoFrame> implementation.
   void OnFrame(const webrtc::VideoFrame& frame) override;
@@ -187,6 +202,8 @@ class FakeVideoSendStream final
   absl::optional<webrtc::VideoFrame> last_frame_;
   webrtc::VideoSendStream::Stats stats_;
   int num_encoder_reconfigurations_ = 0;
+  std::vector<uint32_t> injected_timestamps_;
+  webrtc::KeyFrameRequestSender* key_frame_request_sender_ = nullptr;
 };
 
 class FakeVideoReceiveStream final : public webrtc::VideoReceiveStream {
@@ -211,6 +228,18 @@ class FakeVideoReceiveStream final : public webrtc::VideoReceiveStream {
     return std::vector<webrtc::RtpSource>();
   }
 
+  void SetEncodedFrameSink(webrtc::EncodedFrameSinkInterface* sink,
+                           bool decode_frames) override;
+  void RequestKeyFrame() override;
+  void SetDecodingPaused(bool paused) override;
+
+  webrtc::EncodedFrameSinkInterface* encoded_frame_sink() const {
+    return encoded_frame_sink_;
+  }
+  bool decode_frames() const { return decode_frames_; }
+  int num_key_frame_requests() const { return num_key_frame_requests_; }
+  bool decoding_paused() const { return decoding_paused_; }
+
  private:
   // webrtc::VideoReceiveStream implementation.
   void Start() override;
@@ -224,6 +253,10 @@ class FakeVideoReceiveStream final : public webrtc::VideoReceiveStream {
 
   int num_added_secondary_sinks_;
   int num_removed_secondary_sinks_;
+  webrtc::EncodedFrameSinkInterface* encoded_frame_sink_ = nullptr;
+  bool decode_frames_ = true;
+  int num_key_frame_requests_ = 0;
+  bool decoding_paused_ = false;
 };
 
 class FakeFlexfecReceiveStream final : public webrtc::FlexfecReceiveStream {
@@ -17,6 +17,7 @@
 #include <string>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video/video_frame_buffer.h"
@@ -26,6 +27,7 @@
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "rtc_base/atomicops.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/scoped_ref_ptr.h"
 #include "system_wrappers/include/field_trial.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
@@ -127,13 +129,30 @@ class AdapterEncodedImageCallback : public webrtc::EncodedImageCallback {
 
 namespace webrtc {
 
+struct SimulcastEncoderAdapter::LayerEncode {
+  LayerEncode(size_t stream_idx,
+              const VideoFrame& frame,
+              std::vector<FrameType> frame_types)
+      : stream_idx(stream_idx),
+        frame(frame),
+        frame_types(std::move(frame_types)) {}
+  size_t stream_idx;
+  VideoFrame frame;
+  std::vector<FrameType> frame_types;
+  int result = WEBRTC_VIDEO_CODEC_OK;
+};
+
 SimulcastEncoderAdapter::SimulcastEncoderAdapter(VideoEncoderFactory* factory,
                                                  const SdpVideoFormat& format)
     : inited_(0),
       factory_(factory),
       video_format_(format),
       encoded_complete_callback_(nullptr),
-      experimental_boosted_screenshare_qp_(GetScreenshareBoostedQpValue()) {
+      experimental_boosted_screenshare_qp_(GetScreenshareBoostedQpValue()),
+      cascaded_scaling_(webrtc::field_trial::IsEnabled(
+          "WebRTC-SimulcastEncoderAdapter-CascadedScaling")),
+      parallel_encode_(webrtc::field_trial::IsEnabled(
+          "WebRTC-SimulcastEncoderAdapter-ParallelEncode")) {
   RTC_DCHECK(factory_);
   encoder_info_.implementation_name = "SimulcastEncoderAdapter";
 
@@ -211,6 +230,13 @@ int SimulcastEncoderAdapter::InitEncode(const VideoCodec* inst,
 
   encoder_info_.supports_native_handle = true;
   encoder_info_.scaling_settings.thresholds = absl::nullopt;
+  if (parallel_encode_) {
+    while (encode_queues_.size() + 1 < static_cast<size_t>(number_of_streams)) {
+      encode_queues_.push_back(absl::make_unique<rtc::TaskQueue>(
+          "SimulcastEncode", rtc::TaskQueue::Priority::HIGH));
+    }
+  }
+
   // Create |number_of_streams| of encoder instances and init them.
   for (int i = 0; i < number_of_streams; ++i) {
     VideoCodec stream_codec;
@@ -282,6 +308,8 @@ int SimulcastEncoderAdapter::InitEncode(const VideoCodec* inst,
 
         encoder_info_.supports_native_handle =
             encoder_impl_info.supports_native_handle;
+        encoder_info_.supported_input_buffer_types =
+            encoder_impl_info.supported_input_buffer_types;
         encoder_info_.has_trusted_rate_controller =
             encoder_impl_info.has_trusted_rate_controller;
         encoder_info_.is_hardware_accelerated =
@@ -297,6 +325,20 @@ int SimulcastEncoderAdapter::InitEncode(const VideoCodec* inst,
         encoder_info_.supports_native_handle &=
             encoder_impl_info.supports_native_handle;
 
+        // Unscaled streams get the input frame as is, so a buffer type is
+        // supported only if all encoders support it.
+        const std::vector<VideoFrameBuffer::Type>& impl_types =
+            encoder_impl_info.supported_input_buffer_types;
+        auto& buffer_types = encoder_info_.supported_input_buffer_types;
+        buffer_types.erase(
+            std::remove_if(buffer_types.begin(), buffer_types.end(),
+                           [&impl_types](VideoFrameBuffer::Type type) {
+                             return std::find(impl_types.begin(),
+                                              impl_types.end(),
+                                              type) == impl_types.end();
+                           }),
+            buffer_types.end());
+
         // Trusted rate controller only if all encoders have it.
         encoder_info_.has_trusted_rate_controller &=
             encoder_impl_info.has_trusted_rate_controller;
@@ -359,8 +401,10 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> scaled_buffers;
+  ScaleInputForStreams(input_image, &scaled_buffers);
+
+  std::vector<LayerEncode> layers;
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (!streaminfos_[stream_idx].send_stream) {
@@ -375,53 +419,146 @@ int SimulcastEncoderAdapter::Encode(
       stream_frame_types.push_back(kVideoFrameDelta);
     }
 
-    int dst_width = streaminfos_[stream_idx].width;
-    int dst_height = streaminfos_[stream_idx].height;
-    // If scaling isn't required, because the input resolution
-    // matches the destination or the input image is empty (e.g.
-    // a keyframe request for encoders with internal camera
-    // sources) or the source image has a native handle, pass the image on
-    // directly. Otherwise, we'll scale it to match what the encoder expects
-    // (below).
-    // For texture frames, the underlying encoder is expected to be able to
-    // correctly sample/scale the source texture.
-    // TODO(perkj): ensure that works going forward, and figure out how this
-    // affects webrtc:5683.
-    if ((dst_width == src_width && dst_height == src_height) ||
-        input_image.video_frame_buffer()->type() ==
-            VideoFrameBuffer::Type::kNative) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          input_image, codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+    if (!scaled_buffers[stream_idx]) {
+      layers.emplace_back(stream_idx, input_image,
+                          std::move(stream_frame_types));
     } else {
-      rtc::scoped_refptr<I420Buffer> dst_buffer =
-          I420Buffer::Create(dst_width, dst_height);
-      rtc::scoped_refptr<I420BufferInterface> src_buffer =
-          input_image.video_frame_buffer()->ToI420();
-      libyuv::I420Scale(src_buffer->DataY(), src_buffer->StrideY(),
-                        src_buffer->DataU(), src_buffer->StrideU(),
-                        src_buffer->DataV(), src_buffer->StrideV(), src_width,
-                        src_height, dst_buffer->MutableDataY(),
-                        dst_buffer->StrideY(), dst_buffer->MutableDataU(),
-                        dst_buffer->StrideU(), dst_buffer->MutableDataV(),
-                        dst_buffer->StrideV(), dst_width, dst_height,
-                        libyuv::kFilterBilinear);
-
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          VideoFrame(dst_buffer, input_image.timestamp(),
+      layers.emplace_back(
+          stream_idx,
+          VideoFrame(scaled_buffers[stream_idx], input_image.timestamp(),
                      input_image.render_time_ms(), webrtc::kVideoRotation_0),
-          codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+          std::move(stream_frame_types));
     }
   }
 
+  if (parallel_encode_ && layers.size() > 1)
+    return EncodeLayersInParallel(&layers, codec_specific_info);
+
+  for (LayerEncode& layer : layers) {
+    int ret = streaminfos_[layer.stream_idx].encoder->Encode(
+        layer.frame, codec_specific_info, &layer.frame_types);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
+    }
+  }
+
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int SimulcastEncoderAdapter::EncodeLayersInParallel(
+    std::vector<LayerEncode>* layers,
+    const CodecSpecificInfo* codec_specific_info) {
+  rtc::Event done(false, false);
+  volatile int pending = 0;
+  for (const LayerEncode& layer : *layers) {
+    if (layer.stream_idx > 0)
+      ++pending;
+  }
+  for (LayerEncode& layer : *layers) {
+    if (layer.stream_idx == 0)
+      continue;
+    RTC_DCHECK_LE(layer.stream_idx, encode_queues_.size());
+    VideoEncoder* encoder = streaminfos_[layer.stream_idx].encoder.get();
+    encode_queues_[layer.stream_idx - 1]->PostTask(
+        [encoder, &layer, codec_specific_info, &pending, &done]() {
+          layer.result = encoder->Encode(layer.frame, codec_specific_info,
+                                         &layer.frame_types);
+          if (rtc::AtomicOps::Decrement(&pending) == 0)
+            done.Set();
+        });
+  }
+  // The lowest stream, if active, is encoded while the others are running.
+  if (layers->front().stream_idx == 0) {
+    LayerEncode& layer = layers->front();
+    layer.result = streaminfos_[0].encoder->Encode(
+        layer.frame, codec_specific_info, &layer.frame_types);
+  }
+  if (rtc::AtomicOps::AcquireLoad(&pending) > 0)
+    done.Wait(rtc::Event::kForever);
+
+  for (const LayerEncode& layer : *layers) {
+    if (layer.result != WEBRTC_VIDEO_CODEC_OK)
+      return layer.result;
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+void SimulcastEncoderAdapter::ScaleInputForStreams(
+    const VideoFrame& input_image,
+    std::vector<rtc::scoped_refptr<I420BufferInterface>>* scaled_buffers) {
+  scaled_buffers->assign(streaminfos_.size(), nullptr);
+  // If scaling isn't required, because the input resolution
+  // matches the destination or the input image is empty (e.g.
+  // a keyframe request for encoders with internal camera
+  // sources) or the source image has a native handle, the image is passed on
+  // directly. Otherwise, we'll scale it to match what the encoder expects.
+  // For texture frames, the underlying encoder is expected to be able to
+  // correctly sample/scale the source texture.
+  // TODO(perkj): ensure that works going forward, and figure out how this
+  // affects webrtc:5683.
+  if (input_image.video_frame_buffer()->type() ==
+      VideoFrameBuffer::Type::kNative) {
+    return;
+  }
+  const int src_width = input_image.width();
+  const int src_height = input_image.height();
+  std::vector<size_t> streams_to_scale;
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    const StreamInfo& info = streaminfos_[stream_idx];
+    if (info.send_stream &&
+        (info.width != src_width || info.height != src_height)) {
+      streams_to_scale.push_back(stream_idx);
+    }
+  }
+  if (streams_to_scale.empty())
+    return;
+  // Visit the streams from the highest resolution to the lowest, so that
+  // buffers already scaled for this frame can be used as scaling source.
+  std::sort(streams_to_scale.begin(), streams_to_scale.end(),
+            [this](size_t a, size_t b) {
+              return streaminfos_[a].width * streaminfos_[a].height >
+                     streaminfos_[b].width * streaminfos_[b].height;
+            });
+
+  rtc::scoped_refptr<I420BufferInterface> src_buffer =
+      input_image.video_frame_buffer()->ToI420();
+  // Buffers scaled for this frame, in order of decreasing resolution. Streams
+  // with the same resolution share a buffer.
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> frame_buffers;
+  for (size_t stream_idx : streams_to_scale) {
+    const int dst_width = streaminfos_[stream_idx].width;
+    const int dst_height = streaminfos_[stream_idx].height;
+    rtc::scoped_refptr<I420BufferInterface> scale_from = src_buffer;
+    rtc::scoped_refptr<I420BufferInterface> dst_buffer;
+    for (const auto& buffer : frame_buffers) {
+      if (buffer->width() == dst_width && buffer->height() == dst_height) {
+        dst_buffer = buffer;
+        break;
+      }
+      if (cascaded_scaling_ && buffer->width() >= dst_width &&
+          buffer->height() >= dst_height) {
+        scale_from = buffer;
+      }
+    }
+    if (!dst_buffer) {
+      rtc::scoped_refptr<I420Buffer> buffer =
+          streaminfos_[stream_idx].scaled_buffer_pool->CreateBuffer(
+              dst_width, dst_height);
+      libyuv::I420Scale(scale_from->DataY(), scale_from->StrideY(),
+                        scale_from->DataU(), scale_from->StrideU(),
+                        scale_from->DataV(), scale_from->StrideV(),
+                        scale_from->width(), scale_from->height(),
+                        buffer->MutableDataY(), buffer->StrideY(),
+                        buffer->MutableDataU(), buffer->StrideU(),
+                        buffer->MutableDataV(), buffer->StrideV(), dst_width,
+                        dst_height, libyuv::kFilterBilinear);
+      dst_buffer = buffer;
+      frame_buffers.push_back(dst_buffer);
+    }
+    (*scaled_buffers)[stream_idx] = dst_buffer;
+  }
+}
+
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&encoder_queue_);
@@ -498,6 +635,7 @@ EncodedImageCallback::Result SimulcastEncoderAdapter::OnEncodedImage(
 
   stream_image.SetSpatialIndex(stream_idx);
 
+  rtc::CritScope lock(&encoded_callback_crit_);
   return encoded_complete_callback_->OnEncodedImage(
       stream_image, &stream_codec_specific, fragmentation);
 }
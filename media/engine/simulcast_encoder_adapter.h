@@ -20,9 +20,12 @@
 
 #include "absl/types/optional.h"
 #include "api/video_codecs/sdp_video_format.h"
+#include "common_video/include/i420_buffer_pool.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/atomicops.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/sequenced_task_checker.h"
+#include "rtc_base/task_queue.h"
 
 namespace webrtc {
 
@@ -33,6 +36,9 @@ class VideoEncoderFactory;
 // webrtc::VideoEncoder instances with the given VideoEncoderFactory.
 // The object is created and destroyed on the worker thread, but all public
 // interfaces should be called from the encoder task queue.
+// With the field trial "WebRTC-SimulcastEncoderAdapter-ParallelEncode", the
+// streams of a frame are encoded concurrently, each stream but the lowest one
+// on its own task queue, and Encode() returns once all of them are done.
 class SimulcastEncoderAdapter : public VideoEncoder {
  public:
   explicit SimulcastEncoderAdapter(VideoEncoderFactory* factory,
@@ -63,6 +69,9 @@ class SimulcastEncoderAdapter : public VideoEncoder {
   EncoderInfo GetEncoderInfo() const override;
 
  private:
+  // A frame to encode on one stream.
+  struct LayerEncode;
+
   struct StreamInfo {
     StreamInfo(std::unique_ptr<VideoEncoder> encoder,
                std::unique_ptr<EncodedImageCallback> callback,
@@ -74,13 +83,16 @@ class SimulcastEncoderAdapter : public VideoEncoder {
           width(width),
           height(height),
           key_frame_request(false),
-          send_stream(send_stream) {}
+          send_stream(send_stream),
+          scaled_buffer_pool(new I420BufferPool()) {}
     std::unique_ptr<VideoEncoder> encoder;
     std::unique_ptr<EncodedImageCallback> callback;
     uint16_t width;
     uint16_t height;
     bool key_frame_request;
     bool send_stream;
+    // Buffers for input frames scaled to |width| x |height|.
+    std::unique_ptr<I420BufferPool> scaled_buffer_pool;
   };
 
   // Populate the codec settings for each simulcast stream.
@@ -92,6 +104,17 @@ class SimulcastEncoderAdapter : public VideoEncoder {
 
   bool Initialized() const;
 
+  // Encodes |layers| on |encode_queues_| and waits for all of them to finish.
+  // Returns the first error in stream order, if any.
+  int EncodeLayersInParallel(std::vector<LayerEncode>* layers,
+                             const CodecSpecificInfo* codec_specific_info);
+
+  // Scales |input_image| for every active stream that doesn't take the input
+  // as is. Entries of |scaled_buffers| are left null for those that do.
+  void ScaleInputForStreams(
+      const VideoFrame& input_image,
+      std::vector<rtc::scoped_refptr<I420BufferInterface>>* scaled_buffers);
+
   void DestroyStoredEncoders();
 
   volatile int inited_;  // Accessed atomically.
@@ -100,6 +123,8 @@ class SimulcastEncoderAdapter : public VideoEncoder {
   VideoCodec codec_;
   std::vector<StreamInfo> streaminfos_;
   EncodedImageCallback* encoded_complete_callback_;
+  // Serializes callbacks from concurrently running stream encoders.
+  rtc::CriticalSection encoded_callback_crit_;
   EncoderInfo encoder_info_;
 
   // Used for checking the single-threaded access of the encoder interface.
@@ -110,6 +135,14 @@ class SimulcastEncoderAdapter : public VideoEncoder {
   std::stack<std::unique_ptr<VideoEncoder>> stored_encoders_;
 
   const absl::optional<unsigned int> experimental_boosted_screenshare_qp_;
+  // If true, lower resolutions are scaled from the closest higher resolution
+  // stream instead of from the input frame.
+  const bool cascaded_scaling_;
+  const bool parallel_encode_;
+  // Task queues for encoding stream i + 1 when |parallel_encode_| is set.
+  // Stream 0 is encoded on the calling thread. Each encoder always runs on
+  // the same queue.
+  std::vector<std::unique_ptr<rtc::TaskQueue>> encode_queues_;
 };
 
 }  // namespace webrtc
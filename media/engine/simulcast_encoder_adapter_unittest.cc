@@ -26,10 +26,12 @@
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/simulcast_test_fixture_impl.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
 using ::testing::_;
+using ::testing::Invoke;
 using ::testing::Return;
 
 namespace webrtc {
@@ -895,6 +897,82 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, nullptr, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake,
+       CascadedScalingProducesStreamResolutions) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-CascadedScaling/Enabled/");
+  // Recreate the adapter so that it picks up the field trial.
+  adapter_.reset(helper_->CreateMockEncoderAdapter());
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  // Enough start bitrate for all streams.
+  codec_.startBitrate = 5000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame(input_buffer, 0, 0, webrtc::kVideoRotation_0);
+  for (int i = 0; i < 3; ++i) {
+    const int width = codec_.simulcastStream[i].width;
+    const int height = codec_.simulcastStream[i].height;
+    EXPECT_CALL(*helper_->factory()->encoders()[i], Encode(_, _, _))
+        .WillOnce(Invoke([width, height](const VideoFrame& frame,
+                                         const CodecSpecificInfo*,
+                                         const std::vector<FrameType>*) {
+          EXPECT_EQ(width, frame.width());
+          EXPECT_EQ(height, frame.height());
+          return WEBRTC_VIDEO_CODEC_OK;
+        }));
+  }
+  std::vector<FrameType> frame_types(3, kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake, ParallelEncodeEncodesAllStreams) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-ParallelEncode/Enabled/");
+  // Recreate the adapter so that it picks up the field trial.
+  adapter_.reset(helper_->CreateMockEncoderAdapter());
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  // Enough start bitrate for all streams.
+  codec_.startBitrate = 5000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame(input_buffer, 0, 0, webrtc::kVideoRotation_0);
+  for (int i = 0; i < 3; ++i) {
+    const int width = codec_.simulcastStream[i].width;
+    const int height = codec_.simulcastStream[i].height;
+    EXPECT_CALL(*helper_->factory()->encoders()[i], Encode(_, _, _))
+        .WillOnce(Invoke([width, height](const VideoFrame& frame,
+                                         const CodecSpecificInfo*,
+                                         const std::vector<FrameType>*) {
+          EXPECT_EQ(width, frame.width());
+          EXPECT_EQ(height, frame.height());
+          return WEBRTC_VIDEO_CODEC_OK;
+        }))
+        .WillOnce(Return(i == 1 ? WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE
+                                : WEBRTC_VIDEO_CODEC_OK));
+  }
+  std::vector<FrameType> frame_types(3, kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+  // An error from any of the streams is returned once all of them are done.
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE,
+            adapter_->Encode(input_frame, nullptr, &frame_types));
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestInitFailureCleansUpEncoders) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
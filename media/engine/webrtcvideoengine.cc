@@ -1544,7 +1544,12 @@ std::vector<webrtc::RtpSource> WebRtcVideoChannel::GetSources(
 bool WebRtcVideoChannel::SendRtp(const uint8_t* data,
                                  size_t len,
                                  const webrtc::PacketOptions& options) {
-  rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+  return SendRtpBuffer(rtc::CopyOnWriteBuffer(data, len, kMaxRtpPacketLen),
+                       options);
+}
+
+bool WebRtcVideoChannel::SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                                       const webrtc::PacketOptions& options) {
   rtc::PacketOptions rtc_options;
   rtc_options.packet_id = options.packet_id;
   if (DscpEnabled()) {
@@ -1852,9 +1857,9 @@ webrtc::RTCError WebRtcVideoChannel::WebRtcVideoSendStream::SetRtpParameters(
       new_param || (new_parameters.encodings[0].bitrate_priority !=
                     rtp_parameters_.encodings[0].bitrate_priority);
 
-  // TODO(bugs.webrtc.org/8807): The active field as well should not require
-  // a full encoder reconfiguration, but it needs to update both the bitrate
-  // allocator and the video bitrate allocator.
+  // While sending, changes of the active field are applied by
+  // UpdateSendState(), which suspends or resumes the layers in the
+  // VideoSendStream and its encoder without reinitializing the encoder.
   bool new_send_state = false;
   for (size_t i = 0; i < rtp_parameters_.encodings.size(); ++i) {
     if (new_parameters.encodings[i].active !=
@@ -1865,8 +1870,17 @@ webrtc::RTCError WebRtcVideoChannel::WebRtcVideoSendStream::SetRtpParameters(
   rtp_parameters_ = new_parameters;
   // Codecs are currently handled at the WebRtcVideoChannel level.
   rtp_parameters_.codecs.clear();
-  if (reconfigure_encoder || new_send_state) {
+  if (reconfigure_encoder || (new_send_state && !sending_)) {
     ReconfigureEncoder();
+  } else if (new_send_state) {
+    // Keep the stored configuration in sync, for a recreated stream.
+    for (size_t i = 0;
+         i < parameters_.encoder_config.simulcast_layers.size() &&
+         i < rtp_parameters_.encodings.size();
+         ++i) {
+      parameters_.encoder_config.simulcast_layers[i].active =
+          rtp_parameters_.encodings[i].active;
+    }
   }
   if (new_send_state) {
     UpdateSendState();
@@ -6416,8 +6416,8 @@ TEST_F(WebRtcVideoChannelTest, SetRtpSendParametersOneEncodingActive) {
 }
 
 // Tests that when active is updated for any simulcast layer then the send
-// stream's sending state will be updated and it will be reconfigured with the
-// new appropriate active simulcast streams.
+// stream's sending state and active simulcast streams will be updated, without
+// reconfiguring the encoder.
 TEST_F(WebRtcVideoChannelTest, SetRtpSendParametersMultipleEncodingsActive) {
   // Create the stream params with multiple ssrcs for simulcast.
   const size_t kNumSimulcastStreams = 3;
@@ -6447,6 +6447,8 @@ TEST_F(WebRtcVideoChannelTest, SetRtpSendParametersMultipleEncodingsActive) {
   EXPECT_TRUE(parameters.encodings[1].active);
   EXPECT_TRUE(parameters.encodings[2].active);
   EXPECT_TRUE(fake_video_send_stream->IsSending());
+  const int num_encoder_reconfigurations =
+      fake_video_send_stream->num_encoder_reconfigurations();
 
   // Only turn on only the middle stream.
   parameters.encodings[0].active = false;
@@ -6460,7 +6462,7 @@ TEST_F(WebRtcVideoChannelTest, SetRtpSendParametersMultipleEncodingsActive) {
   EXPECT_TRUE(parameters.encodings[1].active);
   EXPECT_FALSE(parameters.encodings[2].active);
   // Check that the VideoSendStream is updated appropriately. This means its
-  // send state was updated and it was reconfigured.
+  // send state and active layers were updated.
   EXPECT_TRUE(fake_video_send_stream->IsSending());
   std::vector<webrtc::VideoStream> simulcast_streams =
       fake_video_send_stream->GetVideoStreams();
@@ -6487,6 +6489,8 @@ TEST_F(WebRtcVideoChannelTest, SetRtpSendParametersMultipleEncodingsActive) {
   EXPECT_FALSE(simulcast_streams[0].active);
   EXPECT_FALSE(simulcast_streams[1].active);
   EXPECT_FALSE(simulcast_streams[2].active);
+  EXPECT_EQ(num_encoder_reconfigurations,
+            fake_video_send_stream->num_encoder_reconfigurations());
 
   EXPECT_TRUE(channel_->SetVideoSend(primary_ssrc, nullptr, nullptr));
 }
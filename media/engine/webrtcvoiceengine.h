@@ -216,7 +216,12 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   bool SendRtp(const uint8_t* data,
                size_t len,
                const webrtc::PacketOptions& options) override {
-    rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+    return SendRtpBuffer(rtc::CopyOnWriteBuffer(data, len, kMaxRtpPacketLen),
+                         options);
+  }
+
+  bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                     const webrtc::PacketOptions& options) override {
     rtc::PacketOptions rtc_options;
     rtc_options.packet_id = options.packet_id;
     if (DscpEnabled()) {
@@ -25,6 +25,7 @@ enum PreservedErrno {
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "media/base/codec.h"
 #include "media/base/mediaconstants.h"
@@ -38,6 +39,7 @@ enum PreservedErrno {
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/thread_checker.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 #include "usrsctplib/usrsctp.h"
 
 namespace {
@@ -259,18 +261,28 @@ class SctpTransport::UsrSctpWrapper {
     VerboseLogPacket(data, length, SCTP_DUMP_OUTBOUND);
     // Note: We have to copy the data; the caller will delete it.
     rtc::CopyOnWriteBuffer buf(reinterpret_cast<uint8_t*>(data), length);
+    bool first_queued;
+    {
+      rtc::CritScope cs(&transport->outbound_packets_lock_);
+      first_queued = transport->outbound_packets_.empty();
+      transport->outbound_packets_.push_back(std::move(buf));
+    }
+    // Packets queued after the first are sent by the task already posted.
     // TODO(deadbeef): Why do we need an AsyncInvoke here? We're already on the
     // right thread and don't need to unwind the stack.
-    transport->invoker_.AsyncInvoke<void>(
-        RTC_FROM_HERE, transport->network_thread_,
-        rtc::Bind(&SctpTransport::OnPacketFromSctpToNetwork, transport, buf));
+    if (first_queued) {
+      transport->invoker_.AsyncInvoke<void>(
+          RTC_FROM_HERE, transport->network_thread_,
+          rtc::Bind(&SctpTransport::OnPacketsFromSctpToNetwork, transport));
+    }
     return 0;
   }
 
   // This is the callback called from usrsctp when data has been received, after
   // a packet has been interpreted and parsed by usrsctp and found to contain
-  // payload data. It is called by a usrsctp thread. It is assumed this function
-  // will free the memory used by 'data'.
+  // payload data. It is called by a usrsctp thread, or by the network thread
+  // from usrsctp_conninput. It is assumed this function will free the memory
+  // used by 'data'.
   static int OnSctpInboundPacket(struct socket* sock,
                                  union sctp_sockstore addr,
                                  void* data,
@@ -279,9 +291,8 @@ class SctpTransport::UsrSctpWrapper {
                                  int flags,
                                  void* ulp_info) {
     SctpTransport* transport = static_cast<SctpTransport*>(ulp_info);
-    // Post data to the transport's receiver thread (copying it).
-    // TODO(ldixon): Unclear if copy is needed as this method is responsible for
-    // memory cleanup. But this does simplify code.
+    // Post data to the transport's receiver thread (copying it, since |data|
+    // is allocated by usrsctp).
     const PayloadProtocolIdentifier ppid =
         static_cast<PayloadProtocolIdentifier>(
             rtc::HostToNetwork32(rcv.rcv_ppid));
@@ -306,13 +317,19 @@ class SctpTransport::UsrSctpWrapper {
         // A message with a new sid, but haven't seen the EOR for the
         // previous message. Deliver the previous partial message to avoid
         // merging messages from different sid's.
-        transport->invoker_.AsyncInvoke<void>(
-            RTC_FROM_HERE, transport->network_thread_,
-            rtc::Bind(&SctpTransport::OnInboundPacketFromSctpToTransport,
-                      transport, transport->partial_message_,
-                      transport->partial_params_, transport->partial_flags_));
+        DeliverInboundPacket(transport, std::move(transport->partial_message_),
+                             transport->partial_params_,
+                             transport->partial_flags_);
+        transport->partial_message_ = rtc::CopyOnWriteBuffer();
+      }
 
-        transport->partial_message_.Clear();
+      if ((flags & MSG_EOR) && transport->partial_message_.size() == 0) {
+        // A complete message, copy it once into a buffer of its own size.
+        rtc::CopyOnWriteBuffer message(reinterpret_cast<uint8_t*>(data),
+                                       length);
+        free(data);
+        DeliverInboundPacket(transport, std::move(message), params, flags);
+        return 1;
       }
 
       transport->partial_message_.AppendData(reinterpret_cast<uint8_t*>(data),
@@ -331,18 +348,38 @@ class SctpTransport::UsrSctpWrapper {
         return 1;
       }
 
-      // The ownership of the packet transfers to |invoker_|. Using
-      // CopyOnWriteBuffer is the most convenient way to do this.
-      transport->invoker_.AsyncInvoke<void>(
-          RTC_FROM_HERE, transport->network_thread_,
-          rtc::Bind(&SctpTransport::OnInboundPacketFromSctpToTransport,
-                    transport, transport->partial_message_, params, flags));
-
-      transport->partial_message_.Clear();
+      // Hand over the reassembled buffer rather than clearing it, which would
+      // allocate a new buffer of its full capacity for every later message
+      // while the receiver still holds this one.
+      DeliverInboundPacket(transport, std::move(transport->partial_message_),
+                           params, flags);
+      transport->partial_message_ = rtc::CopyOnWriteBuffer();
     }
     return 1;
   }
 
+  // Hands a received message or notification to the transport on the network
+  // thread. usrsctp calls back on the thread that fed it the packet, which for
+  // received packets is the network thread, unless the callback is the result
+  // of one of usrsctp's timers.
+  static void DeliverInboundPacket(SctpTransport* transport,
+                                   rtc::CopyOnWriteBuffer buffer,
+                                   const ReceiveDataParams& params,
+                                   int flags) {
+    if (transport->inline_delivery_ && transport->network_thread_->IsCurrent()) {
+      // usrsctp releases its locks around the receive callback, so the
+      // transport may be used again from the handlers of the message.
+      transport->OnInboundPacketFromSctpToTransport(buffer, params, flags);
+      return;
+    }
+    // The ownership of the packet transfers to |invoker_|. Using
+    // CopyOnWriteBuffer is the most convenient way to do this.
+    transport->invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, transport->network_thread_,
+        rtc::Bind(&SctpTransport::OnInboundPacketFromSctpToTransport, transport,
+                  buffer, params, flags));
+  }
+
   static SctpTransport* GetTransportFromSocket(struct socket* sock) {
     struct sockaddr* addrs = nullptr;
     int naddrs = usrsctp_getladdrs(sock, 0, &addrs);
@@ -382,6 +419,8 @@ class SctpTransport::UsrSctpWrapper {
 SctpTransport::SctpTransport(rtc::Thread* network_thread,
                              rtc::PacketTransportInternal* transport)
     : network_thread_(network_thread),
+      inline_delivery_(
+          webrtc::field_trial::IsEnabled("WebRTC-SctpInlineDelivery")),
       transport_(transport),
       was_ever_writable_(transport->writable()) {
   RTC_DCHECK(network_thread_);
@@ -905,6 +944,17 @@ sockaddr_conn SctpTransport::GetSctpSockAddr(int port) {
   return sconn;
 }
 
+void SctpTransport::OnPacketsFromSctpToNetwork() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  {
+    rtc::CritScope cs(&outbound_packets_lock_);
+    packets.swap(outbound_packets_);
+  }
+  for (const rtc::CopyOnWriteBuffer& packet : packets)
+    OnPacketFromSctpToNetwork(packet);
+}
+
 void SctpTransport::OnPacketFromSctpToNetwork(
     const rtc::CopyOnWriteBuffer& buffer) {
   RTC_DCHECK_RUN_ON(network_thread_);
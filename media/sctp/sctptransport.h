@@ -22,6 +22,7 @@
 #include "rtc_base/asyncinvoker.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
 // For SendDataParams/ReceiveDataParams.
@@ -45,8 +46,9 @@ struct SctpInboundPacket;
 //  2.  usrsctp_sendv(data)
 // [network thread returns; sctp thread then calls the following]
 //  3.  OnSctpOutboundPacket(wrapped_data)
-// [sctp thread returns having async invoked on the network thread]
-//  4.  SctpTransport::OnPacketFromSctpToNetwork(wrapped_data)
+// [sctp thread returns having queued the packet and, unless packets are
+//  already queued, async invoked on the network thread]
+//  4.  SctpTransport::OnPacketsFromSctpToNetwork()
 //  5.  DtlsTransport::SendPacket(wrapped_data)
 //  6.  ... across network ... a packet is sent back ...
 //  7.  SctpTransport::OnPacketReceived(wrapped_data)
@@ -120,7 +122,9 @@ class SctpTransport : public SctpTransportInternal,
   void OnSendThresholdCallback();
   sockaddr_conn GetSctpSockAddr(int port);
 
-  // Called using |invoker_| to send packet on the network.
+  // Called using |invoker_| to send the packets in |outbound_packets_| on the
+  // network.
+  void OnPacketsFromSctpToNetwork();
   void OnPacketFromSctpToNetwork(const rtc::CopyOnWriteBuffer& buffer);
   // Called using |invoker_| to decide what to do with the packet.
   // The |flags| parameter is used by SCTP to distinguish notification packets
@@ -138,10 +142,19 @@ class SctpTransport : public SctpTransportInternal,
   // Responsible for marshalling incoming data to the channels listeners, and
   // outgoing data to the network interface.
   rtc::Thread* network_thread_;
+  // If set, messages received while usrsctp processes a packet on the network
+  // thread are delivered right away instead of in a separate task.
+  const bool inline_delivery_;
   // Helps pass inbound/outbound packets asynchronously to the network thread.
   rtc::AsyncInvoker invoker_;
   // Underlying DTLS channel.
   rtc::PacketTransportInternal* transport_ = nullptr;
+  // Packets from usrsctp waiting to be sent on the network thread. usrsctp may
+  // produce them on its own threads; a burst of packets is handed over with a
+  // single invoke instead of one per packet.
+  rtc::CriticalSection outbound_packets_lock_;
+  std::vector<rtc::CopyOnWriteBuffer> outbound_packets_
+      RTC_GUARDED_BY(outbound_packets_lock_);
 
   // Track the data received from usrsctp between callbacks until the EOR bit
   // arrives.
@@ -22,6 +22,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/messagequeue.h"
 #include "rtc_base/thread.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace {
@@ -467,6 +468,22 @@ TEST_F(SctpTransportTest, SendDataHighPorts) {
                    kDefaultTimeout);
 }
 
+TEST_F(SctpTransportTest, SendDataWithInlineDelivery) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-SctpInlineDelivery/Enabled/");
+  SetupConnectedTransportsWithTwoStreams();
+
+  SendDataResult result;
+  ASSERT_TRUE(SendData(transport1(), 1, "hello?", &result));
+  EXPECT_EQ(SDR_SUCCESS, result);
+  EXPECT_TRUE_WAIT(ReceivedData(receiver2(), 1, "hello?"), kDefaultTimeout);
+
+  ASSERT_TRUE(SendData(transport2(), 2, "hi transport1", &result));
+  EXPECT_EQ(SDR_SUCCESS, result);
+  EXPECT_TRUE_WAIT(ReceivedData(receiver1(), 2, "hi transport1"),
+                   kDefaultTimeout);
+}
+
 TEST_F(SctpTransportTest, ClosesRemoteStream) {
   SetupConnectedTransportsWithTwoStreams();
   SctpTransportObserver transport1_observer(transport1());
@@ -111,6 +111,15 @@ void AudioNetworkAdaptorImpl::SetOverhead(size_t overhead_bytes_per_packet) {
   UpdateNetworkMetrics(network_metrics);
 }
 
+void AudioNetworkAdaptorImpl::SetCpuLoad(float cpu_load) {
+  last_metrics_.cpu_load = cpu_load;
+  DumpNetworkMetrics();
+
+  Controller::NetworkMetrics network_metrics;
+  network_metrics.cpu_load = cpu_load;
+  UpdateNetworkMetrics(network_metrics);
+}
+
 AudioEncoderRuntimeConfig AudioNetworkAdaptorImpl::GetEncoderRuntimeConfig() {
   AudioEncoderRuntimeConfig config;
   for (auto& controller :
@@ -56,6 +56,8 @@ class AudioNetworkAdaptorImpl final : public AudioNetworkAdaptor {
 
   void SetOverhead(size_t overhead_bytes_per_packet) override;
 
+  void SetCpuLoad(float cpu_load) override;
+
   AudioEncoderRuntimeConfig GetEncoderRuntimeConfig() override;
 
   void StartDebugDump(FILE* file_handle) override;
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ComplexityController::Config::Config(int min_complexity,
+                                     int max_complexity,
+                                     float low_cpu_load,
+                                     float high_cpu_load)
+    : min_complexity(min_complexity),
+      max_complexity(max_complexity),
+      low_cpu_load(low_cpu_load),
+      high_cpu_load(high_cpu_load) {}
+
+ComplexityController::ComplexityController(const Config& config)
+    : config_(config), max_complexity_(config_.max_complexity) {
+  RTC_DCHECK_LE(config_.min_complexity, config_.max_complexity);
+  RTC_DCHECK_LT(config_.low_cpu_load, config_.high_cpu_load);
+}
+
+ComplexityController::~ComplexityController() = default;
+
+void ComplexityController::UpdateNetworkMetrics(
+    const NetworkMetrics& network_metrics) {
+  if (network_metrics.cpu_load)
+    cpu_load_ = network_metrics.cpu_load;
+}
+
+void ComplexityController::MakeDecision(AudioEncoderRuntimeConfig* config) {
+  // Decision on |max_complexity| should not have been made.
+  RTC_DCHECK(!config->max_complexity);
+
+  // Step at most once per CPU load update, since it takes an update to see
+  // the effect of the previous step.
+  if (cpu_load_) {
+    if (*cpu_load_ > config_.high_cpu_load &&
+        max_complexity_ > config_.min_complexity) {
+      --max_complexity_;
+    } else if (*cpu_load_ < config_.low_cpu_load &&
+               max_complexity_ < config_.max_complexity) {
+      ++max_complexity_;
+    }
+    cpu_load_ = absl::nullopt;
+  }
+  config->max_complexity = max_complexity_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+#define MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+
+#include "absl/types/optional.h"
+#include "modules/audio_coding/audio_network_adaptor/controller.h"
+#include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor_config.h"
+#include "rtc_base/constructormagic.h"
+
+namespace webrtc {
+
+// Limits the encoder complexity when the CPU of the process is overloaded, so
+// that encoding keeps up with real time. Each CPU load update above
+// |high_cpu_load| lowers the limit by one, down to |min_complexity|, and each
+// update below |low_cpu_load| raises it by one, up to |max_complexity|.
+class ComplexityController final : public Controller {
+ public:
+  struct Config {
+    Config(int min_complexity,
+           int max_complexity,
+           float low_cpu_load,
+           float high_cpu_load);
+    int min_complexity;
+    int max_complexity;
+    float low_cpu_load;
+    float high_cpu_load;
+  };
+
+  explicit ComplexityController(const Config& config);
+
+  ~ComplexityController() override;
+
+  void UpdateNetworkMetrics(const NetworkMetrics& network_metrics) override;
+
+  void MakeDecision(AudioEncoderRuntimeConfig* config) override;
+
+ private:
+  const Config config_;
+  int max_complexity_;
+  // The CPU load reported since the last decision, if any.
+  absl::optional<float> cpu_load_;
+  RTC_DISALLOW_COPY_AND_ASSIGN(ComplexityController);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
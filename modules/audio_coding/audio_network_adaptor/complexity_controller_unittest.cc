@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+
+#include "modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kMinComplexity = 3;
+constexpr int kMaxComplexity = 5;
+constexpr float kLowCpuLoad = 0.7f;
+constexpr float kHighCpuLoad = 0.9f;
+constexpr float kMediumCpuLoad = (kLowCpuLoad + kHighCpuLoad) / 2;
+
+std::unique_ptr<ComplexityController> CreateController() {
+  std::unique_ptr<ComplexityController> controller(
+      new ComplexityController(ComplexityController::Config(
+          kMinComplexity, kMaxComplexity, kLowCpuLoad, kHighCpuLoad)));
+  return controller;
+}
+
+void CheckDecision(ComplexityController* controller,
+                   const absl::optional<float>& cpu_load,
+                   int expected_max_complexity) {
+  if (cpu_load) {
+    Controller::NetworkMetrics network_metrics;
+    network_metrics.cpu_load = cpu_load;
+    controller->UpdateNetworkMetrics(network_metrics);
+  }
+  AudioEncoderRuntimeConfig config;
+  controller->MakeDecision(&config);
+  EXPECT_EQ(expected_max_complexity, config.max_complexity);
+}
+
+}  // namespace
+
+TEST(ComplexityControllerTest, OutputMaxComplexityWhenCpuLoadUnknown) {
+  auto controller = CreateController();
+  CheckDecision(controller.get(), absl::nullopt, kMaxComplexity);
+}
+
+TEST(ComplexityControllerTest, LowerComplexityOncePerHighCpuLoadUpdate) {
+  auto controller = CreateController();
+  CheckDecision(controller.get(), kHighCpuLoad + 0.01f, kMaxComplexity - 1);
+  // No new update, so no further step.
+  CheckDecision(controller.get(), absl::nullopt, kMaxComplexity - 1);
+  CheckDecision(controller.get(), kHighCpuLoad + 0.01f, kMaxComplexity - 2);
+}
+
+TEST(ComplexityControllerTest, DoNotLowerComplexityBelowMin) {
+  auto controller = CreateController();
+  for (int i = 0; i < 10; ++i)
+    CheckDecision(controller.get(), 1.0f, std::max(kMinComplexity,
+                                                   kMaxComplexity - i - 1));
+}
+
+TEST(ComplexityControllerTest, MaintainComplexityForMediumCpuLoad) {
+  auto controller = CreateController();
+  CheckDecision(controller.get(), 1.0f, kMaxComplexity - 1);
+  CheckDecision(controller.get(), kMediumCpuLoad, kMaxComplexity - 1);
+  CheckDecision(controller.get(), kHighCpuLoad, kMaxComplexity - 1);
+  CheckDecision(controller.get(), kLowCpuLoad, kMaxComplexity - 1);
+}
+
+TEST(ComplexityControllerTest, RaiseComplexityUpToMaxForLowCpuLoad) {
+  auto controller = CreateController();
+  CheckDecision(controller.get(), 1.0f, kMaxComplexity - 1);
+  CheckDecision(controller.get(), 1.0f, kMaxComplexity - 2);
+  CheckDecision(controller.get(), 0.1f, kMaxComplexity - 1);
+  CheckDecision(controller.get(), 0.1f, kMaxComplexity);
+  CheckDecision(controller.get(), 0.1f, kMaxComplexity);
+}
+
+}  // namespace webrtc
@@ -27,6 +27,9 @@ class Controller {
     absl::optional<int> target_audio_bitrate_bps;
     absl::optional<int> rtt_ms;
     absl::optional<size_t> overhead_bytes_per_packet;
+    // Fraction of the capacity of all cores used by the process. Not a
+    // network metric, but it reaches the controllers the same way.
+    absl::optional<float> cpu_load;
   };
 
   virtual ~Controller() = default;
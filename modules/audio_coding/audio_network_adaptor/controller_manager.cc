@@ -10,11 +10,14 @@
 
 #include "modules/audio_coding/audio_network_adaptor/controller_manager.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 #include "modules/audio_coding/audio_network_adaptor/bitrate_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/channel_controller.h"
+#include "modules/audio_coding/audio_network_adaptor/complexity_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/debug_dump_writer.h"
 #include "modules/audio_coding/audio_network_adaptor/dtx_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/fec_controller_plr_based.h"
@@ -183,6 +186,22 @@ std::unique_ptr<DtxController> CreateDtxController(
       dtx_config.dtx_disabling_bandwidth_bps())));
 }
 
+std::unique_ptr<ComplexityController> CreateComplexityController(
+    const audio_network_adaptor::config::ComplexityController&
+        complexity_config) {
+  RTC_CHECK(complexity_config.has_min_complexity());
+  RTC_CHECK(complexity_config.has_max_complexity());
+  RTC_CHECK(complexity_config.has_low_cpu_load());
+  RTC_CHECK(complexity_config.has_high_cpu_load());
+
+  return std::unique_ptr<ComplexityController>(
+      new ComplexityController(ComplexityController::Config(
+          complexity_config.min_complexity(),
+          complexity_config.max_complexity(),
+          complexity_config.low_cpu_load(),
+          complexity_config.high_cpu_load())));
+}
+
 using audio_network_adaptor::BitrateController;
 std::unique_ptr<BitrateController> CreateBitrateController(
     const audio_network_adaptor::config::BitrateController& bitrate_config,
@@ -281,6 +300,10 @@ std::unique_ptr<ControllerManager> ControllerManagerImpl::Create(
             controller_config.bitrate_controller(), initial_bitrate_bps,
             initial_frame_length_ms);
         break;
+      case audio_network_adaptor::config::Controller::kComplexityController:
+        controller = CreateComplexityController(
+            controller_config.complexity_controller());
+        break;
       default:
         RTC_NOTREACHED();
     }
@@ -370,22 +393,29 @@ std::vector<Controller*> ControllerManagerImpl::GetSortedControllers(
   // 1) they are less important than any controller that has a scoring point,
   // 2) they are equally important to any controller that has no scoring point,
   //    and their relative order will follow |default_sorted_controllers_|.
-  std::vector<Controller*> sorted_controllers(default_sorted_controllers_);
-  std::stable_sort(
-      sorted_controllers.begin(), sorted_controllers.end(),
-      [this, &scoring_point](const Controller* lhs, const Controller* rhs) {
-        auto lhs_scoring_point = controller_scoring_points_.find(lhs);
-        auto rhs_scoring_point = controller_scoring_points_.find(rhs);
-
-        if (lhs_scoring_point == controller_scoring_points_.end())
-          return false;
-
-        if (rhs_scoring_point == controller_scoring_points_.end())
-          return true;
-
-        return lhs_scoring_point->second.SquaredDistanceTo(scoring_point) <
-               rhs_scoring_point->second.SquaredDistanceTo(scoring_point);
-      });
+  //
+  // The distances are computed once per controller, rather than in every
+  // comparison, and controllers without a scoring point get an infinite one.
+  std::vector<std::pair<float, Controller*>> distances;
+  distances.reserve(default_sorted_controllers_.size());
+  for (Controller* controller : default_sorted_controllers_) {
+    auto controller_scoring_point = controller_scoring_points_.find(controller);
+    distances.emplace_back(
+        controller_scoring_point == controller_scoring_points_.end()
+            ? std::numeric_limits<float>::infinity()
+            : controller_scoring_point->second.SquaredDistanceTo(
+                  scoring_point),
+        controller);
+  }
+  std::stable_sort(distances.begin(), distances.end(),
+                   [](const std::pair<float, Controller*>& lhs,
+                      const std::pair<float, Controller*>& rhs) {
+                     return lhs.first < rhs.first;
+                   });
+  std::vector<Controller*> sorted_controllers;
+  sorted_controllers.reserve(distances.size());
+  for (const auto& distance : distances)
+    sorted_controllers.push_back(distance.second);
 
   if (sorted_controllers_ != sorted_controllers) {
     sorted_controllers_ = sorted_controllers;
@@ -399,12 +429,6 @@ std::vector<Controller*> ControllerManagerImpl::GetControllers() const {
   return default_sorted_controllers_;
 }
 
-ControllerManagerImpl::ScoringPoint::ScoringPoint(
-    int uplink_bandwidth_bps,
-    float uplink_packet_loss_fraction)
-    : uplink_bandwidth_bps(uplink_bandwidth_bps),
-      uplink_packet_loss_fraction(uplink_packet_loss_fraction) {}
-
 namespace {
 
 constexpr int kMinUplinkBandwidthBps = 0;
@@ -426,14 +450,21 @@ float NormalizePacketLossFraction(float uplink_packet_loss_fraction) {
 
 }  // namespace
 
+ControllerManagerImpl::ScoringPoint::ScoringPoint(
+    int uplink_bandwidth_bps,
+    float uplink_packet_loss_fraction)
+    : normalized_uplink_bandwidth(
+          NormalizeUplinkBandwidth(uplink_bandwidth_bps)),
+      normalized_uplink_packet_loss_fraction(
+          NormalizePacketLossFraction(uplink_packet_loss_fraction)) {}
+
 float ControllerManagerImpl::ScoringPoint::SquaredDistanceTo(
     const ScoringPoint& scoring_point) const {
   float diff_normalized_bitrate_bps =
-      NormalizeUplinkBandwidth(scoring_point.uplink_bandwidth_bps) -
-      NormalizeUplinkBandwidth(uplink_bandwidth_bps);
+      scoring_point.normalized_uplink_bandwidth - normalized_uplink_bandwidth;
   float diff_normalized_packet_loss =
-      NormalizePacketLossFraction(scoring_point.uplink_packet_loss_fraction) -
-      NormalizePacketLossFraction(uplink_packet_loss_fraction);
+      scoring_point.normalized_uplink_packet_loss_fraction -
+      normalized_uplink_packet_loss_fraction;
   return std::pow(diff_normalized_bitrate_bps, 2) +
          std::pow(diff_normalized_packet_loss, 2);
 }
@@ -96,8 +96,9 @@ class ControllerManagerImpl final : public ControllerManager {
     // Calculate the normalized [0,1] distance between two scoring points.
     float SquaredDistanceTo(const ScoringPoint& scoring_point) const;
 
-    int uplink_bandwidth_bps;
-    float uplink_packet_loss_fraction;
+    // Normalized to [0, 1] on construction, for SquaredDistanceTo().
+    float normalized_uplink_bandwidth;
+    float normalized_uplink_packet_loss_fraction;
   };
 
   const Config config_;
@@ -110,6 +110,9 @@ void DebugDumpWriterImpl::DumpNetworkMetrics(
         *metrics.uplink_recoverable_packet_loss_fraction);
   }
 
+  if (metrics.cpu_load)
+    dump_metrics->set_cpu_load(*metrics.cpu_load);
+
   DumpEventToFile(event, dump_file_.get());
 #endif  // WEBRTC_ENABLE_PROTOBUF
 }
@@ -143,6 +146,9 @@ void DebugDumpWriterImpl::DumpEncoderRuntimeConfig(
   if (config.num_channels)
     dump_config->set_num_channels(*config.num_channels);
 
+  if (config.max_complexity)
+    dump_config->set_max_complexity(*config.max_complexity);
+
   DumpEventToFile(event, dump_file_.get());
 #endif  // WEBRTC_ENABLE_PROTOBUF
 }
@@ -38,6 +38,10 @@ class AudioNetworkAdaptor {
 
   virtual void SetOverhead(size_t overhead_bytes_per_packet) = 0;
 
+  // Sets the CPU load of the process, as a fraction of the capacity of all
+  // cores.
+  virtual void SetCpuLoad(float cpu_load) = 0;
+
   virtual AudioEncoderRuntimeConfig GetEncoderRuntimeConfig() = 0;
 
   virtual void StartDebugDump(FILE* file_handle) = 0;
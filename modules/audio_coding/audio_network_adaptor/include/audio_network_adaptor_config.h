@@ -36,6 +36,10 @@ struct AudioEncoderRuntimeConfig {
   // to encode.
   absl::optional<size_t> num_channels;
 
+  // Upper limit on the encoder complexity, lowered when the CPU is
+  // overloaded. The encoder may use a lower complexity, e.g. at high bitrates.
+  absl::optional<int> max_complexity;
+
   // This is true if the last frame length change was an increase, and otherwise
   // false.
   // The value of this boolean is used to apply a different offset to the
@@ -76,6 +76,19 @@ AudioDecoderOpusImpl::AudioDecoderOpusImpl(size_t num_channels)
   WebRtcOpus_DecoderInit(dec_state_);
 }
 
+AudioDecoderOpusImpl::AudioDecoderOpusImpl(
+    size_t num_channels,
+    size_t num_streams,
+    size_t coupled_streams,
+    const std::vector<unsigned char>& channel_mapping)
+    : channels_(num_channels) {
+  RTC_DCHECK_EQ(num_channels, channel_mapping.size());
+  RTC_CHECK_EQ(0, WebRtcOpus_MultistreamDecoderCreate(
+                      &dec_state_, channels_, num_streams, coupled_streams,
+                      channel_mapping.data()));
+  WebRtcOpus_DecoderInit(dec_state_);
+}
+
 AudioDecoderOpusImpl::~AudioDecoderOpusImpl() {
   WebRtcOpus_DecoderFree(dec_state_);
 }
@@ -157,6 +170,10 @@ int AudioDecoderOpusImpl::PacketDurationRedundant(const uint8_t* encoded,
 
 bool AudioDecoderOpusImpl::PacketHasFec(const uint8_t* encoded,
                                         size_t encoded_len) const {
+  // Only the first stream of a multistream packet could be inspected, and it
+  // uses self-delimiting framing, so its FEC is not decoded separately.
+  if (channels_ > 2)
+    return false;
   int fec;
   fec = WebRtcOpus_PacketHasFec(encoded, encoded_len);
   return (fec == 1);
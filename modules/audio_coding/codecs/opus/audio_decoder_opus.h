@@ -25,6 +25,12 @@ namespace webrtc {
 class AudioDecoderOpusImpl final : public AudioDecoder {
  public:
   explicit AudioDecoderOpusImpl(size_t num_channels);
+  // Decodes packets of |num_streams| Opus streams into |num_channels|
+  // interleaved channels; see WebRtcOpus_MultistreamDecoderCreate().
+  AudioDecoderOpusImpl(size_t num_channels,
+                       size_t num_streams,
+                       size_t coupled_streams,
+                       const std::vector<unsigned char>& channel_mapping);
   ~AudioDecoderOpusImpl() override;
 
   std::vector<ParseResult> ParsePayload(rtc::Buffer&& payload,
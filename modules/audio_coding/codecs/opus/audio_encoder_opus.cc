@@ -29,6 +29,7 @@
 #include "rtc_base/string_to_number.h"
 #include "rtc_base/timeutils.h"
 #include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/process_cpu_load.h"
 
 namespace webrtc {
 
@@ -52,6 +53,9 @@ constexpr int kOpusBitrateFbBps = 32000;
 constexpr int kSampleRateHz = 48000;
 constexpr int kDefaultMaxPlaybackRate = 48000;
 
+// How often the CPU load of the process is fed to the audio network adaptor.
+constexpr int64_t kCpuLoadUpdateIntervalMs = 1000;
+
 // These two lists must be sorted from low to high
 #if WEBRTC_OPUS_SUPPORT_120MS_PTIME
 constexpr int kANASupportedFrameLengths[] = {20, 60, 120};
@@ -565,6 +569,10 @@ bool AudioEncoderOpusImpl::EnableAudioNetworkAdaptor(
 
 void AudioEncoderOpusImpl::DisableAudioNetworkAdaptor() {
   audio_network_adaptor_.reset(nullptr);
+  if (max_complexity_) {
+    max_complexity_ = absl::nullopt;
+    ApplyComplexity();
+  }
 }
 
 void AudioEncoderOpusImpl::OnReceivedUplinkPacketLossFraction(
@@ -676,6 +684,7 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
     rtc::ArrayView<const int16_t> audio,
     rtc::Buffer* encoded) {
   MaybeUpdateUplinkBandwidth();
+  MaybeUpdateCpuLoad();
 
   if (input_buffer_.empty())
     first_timestamp_in_buffer_ = rtp_timestamp;
@@ -761,12 +770,19 @@ bool AudioEncoderOpusImpl::RecreateEncoderInstance(
     RTC_CHECK_EQ(0, WebRtcOpus_EncoderFree(inst_));
   input_buffer_.clear();
   input_buffer_.reserve(Num10msFramesPerPacket() * SamplesPer10msFrame());
-  RTC_CHECK_EQ(0, WebRtcOpus_EncoderCreate(
-                      &inst_, config.num_channels,
-                      config.application ==
-                              AudioEncoderOpusConfig::ApplicationMode::kVoip
-                          ? 0
-                          : 1));
+  const int application =
+      config.application == AudioEncoderOpusConfig::ApplicationMode::kVoip
+          ? 0
+          : 1;
+  if (config.num_channels > 2) {
+    RTC_CHECK_EQ(0, WebRtcOpus_MultistreamEncoderCreate(
+                        &inst_, config.num_channels, application,
+                        config.num_streams, config.coupled_streams,
+                        config.channel_mapping.data()));
+  } else {
+    RTC_CHECK_EQ(0, WebRtcOpus_EncoderCreate(&inst_, config.num_channels,
+                                             application));
+  }
   RTC_CHECK_EQ(0, WebRtcOpus_SetBitRate(inst_, GetBitrateBps(config)));
   if (config.fec_enabled) {
     RTC_CHECK_EQ(0, WebRtcOpus_EnableFec(inst_));
@@ -778,7 +794,7 @@ bool AudioEncoderOpusImpl::RecreateEncoderInstance(
   // Use the default complexity if the start bitrate is within the hysteresis
   // window.
   complexity_ = GetNewComplexity(config).value_or(config.complexity);
-  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
+  ApplyComplexity();
   bitrate_changed_ = true;
   if (config.dtx_enabled) {
     RTC_CHECK_EQ(0, WebRtcOpus_EnableDtx(inst_));
@@ -809,6 +825,10 @@ void AudioEncoderOpusImpl::SetNumChannelsToEncode(
 
   if (num_channels_to_encode_ == num_channels_to_encode)
     return;
+  // Forcing the channel count of every stream is not meaningful for a
+  // multistream encoder, whose mono streams reject it.
+  if (config_.num_channels > 2)
+    return;
 
   RTC_CHECK_EQ(0, WebRtcOpus_SetForceChannels(inst_, num_channels_to_encode));
   num_channels_to_encode_ = num_channels_to_encode;
@@ -838,7 +858,7 @@ void AudioEncoderOpusImpl::SetTargetBitrate(int bits_per_second) {
   const auto new_complexity = GetNewComplexity(config_);
   if (new_complexity && complexity_ != *new_complexity) {
     complexity_ = *new_complexity;
-    RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
+    ApplyComplexity();
   }
   bitrate_changed_ = true;
 }
@@ -858,6 +878,16 @@ void AudioEncoderOpusImpl::ApplyAudioNetworkAdaptor() {
     SetDtx(*config.enable_dtx);
   if (config.num_channels)
     SetNumChannelsToEncode(*config.num_channels);
+  if (config.max_complexity && config.max_complexity != max_complexity_) {
+    max_complexity_ = config.max_complexity;
+    ApplyComplexity();
+  }
+}
+
+void AudioEncoderOpusImpl::ApplyComplexity() {
+  const int complexity =
+      max_complexity_ ? std::min(complexity_, *max_complexity_) : complexity_;
+  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity));
 }
 
 std::unique_ptr<AudioNetworkAdaptor>
@@ -894,6 +924,24 @@ void AudioEncoderOpusImpl::MaybeUpdateUplinkBandwidth() {
   }
 }
 
+void AudioEncoderOpusImpl::MaybeUpdateCpuLoad() {
+  if (!audio_network_adaptor_)
+    return;
+  int64_t now_ms = rtc::TimeMillis();
+  if (cpu_load_last_update_time_ &&
+      now_ms - *cpu_load_last_update_time_ < kCpuLoadUpdateIntervalMs) {
+    return;
+  }
+  cpu_load_last_update_time_ = now_ms;
+  // The load is shared by all encoders in the process, and measured by the
+  // first one to ask after each interval.
+  absl::optional<float> cpu_load = ProcessCpuLoad::Get()->GetLoad();
+  if (cpu_load) {
+    audio_network_adaptor_->SetCpuLoad(*cpu_load);
+    ApplyAudioNetworkAdaptor();
+  }
+}
+
 ANAStats AudioEncoderOpusImpl::GetANAStats() const {
   if (audio_network_adaptor_) {
     return audio_network_adaptor_->GetStats();
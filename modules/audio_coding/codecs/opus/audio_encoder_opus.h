@@ -175,6 +175,10 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
       RtcEventLog* event_log) const;
 
   void MaybeUpdateUplinkBandwidth();
+  // Feeds the CPU load of the process to the audio network adaptor.
+  void MaybeUpdateCpuLoad();
+  // Sets the complexity chosen for the bitrate, capped by |max_complexity_|.
+  void ApplyComplexity();
 
   AudioEncoderOpusConfig config_;
   const int payload_type_;
@@ -191,12 +195,14 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   size_t num_channels_to_encode_;
   int next_frame_length_ms_;
   int complexity_;
+  absl::optional<int> max_complexity_;
   std::unique_ptr<PacketLossFractionSmoother> packet_loss_fraction_smoother_;
   const AudioNetworkAdaptorCreator audio_network_adaptor_creator_;
   std::unique_ptr<AudioNetworkAdaptor> audio_network_adaptor_;
   absl::optional<size_t> overhead_bytes_per_packet_;
   const std::unique_ptr<SmoothingFilter> bitrate_smoother_;
   absl::optional<int64_t> bitrate_smoother_last_update_time_;
+  absl::optional<int64_t> cpu_load_last_update_time_;
   absl::optional<int64_t> link_capacity_allocation_bps_;
   int consecutive_dtx_frames_;
 
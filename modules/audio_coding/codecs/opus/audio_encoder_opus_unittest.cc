@@ -11,6 +11,7 @@
 #include <array>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "api/audio_codecs/opus/audio_encoder_opus.h"
@@ -697,6 +698,45 @@ TEST(AudioEncoderOpusTest, EncodeAtMinBitrate) {
   }
 }
 
+TEST(AudioEncoderOpusTest, MultistreamConfigIsOk) {
+  AudioEncoderOpusConfig config;
+  config.num_channels = 6;
+  config.num_streams = 4;
+  config.coupled_streams = 2;
+  config.channel_mapping = {0, 1, 4, 5, 2, 3};
+  EXPECT_TRUE(config.IsOk());
+
+  // Maps to a channel beyond the streams.
+  config.channel_mapping = {0, 1, 4, 6, 2, 3};
+  EXPECT_FALSE(config.IsOk());
+  // Wrong number of entries.
+  config.channel_mapping = {0, 1, 4, 5, 2};
+  EXPECT_FALSE(config.IsOk());
+  // More coupled streams than streams.
+  config.channel_mapping = {0, 1, 4, 5, 2, 3};
+  config.coupled_streams = 5;
+  EXPECT_FALSE(config.IsOk());
+}
+
+TEST(AudioEncoderOpusTest, EncodeMultistream) {
+  AudioEncoderOpusConfig config;
+  config.num_channels = 6;
+  config.num_streams = 4;
+  config.coupled_streams = 2;
+  config.channel_mapping = {0, 1, 4, 5, 2, 3};
+  config.bitrate_bps = 256000;
+  config.application = AudioEncoderOpusConfig::ApplicationMode::kAudio;
+  AudioEncoderOpusImpl encoder(config, kDefaultOpusPayloadType);
+  EXPECT_EQ(6u, encoder.NumChannels());
+
+  std::vector<int16_t> audio(480 * 6, 0);
+  rtc::Buffer encoded;
+  encoder.Encode(0, audio, &encoded);
+  EXPECT_EQ(0u, encoded.size());
+  encoder.Encode(480, audio, &encoded);
+  EXPECT_GT(encoded.size(), 0u);
+}
+
 TEST(AudioEncoderOpusTest, TestConfigDefaults) {
   const auto config_opt = AudioEncoderOpus::SdpToConfig({"opus", 48000, 2});
   ASSERT_TRUE(config_opt);
@@ -17,16 +17,21 @@
 
 RTC_PUSH_IGNORING_WUNDEF()
 #include "opus.h"
+#include "opus_multistream.h"
 RTC_POP_IGNORING_WUNDEF()
 
+// Exactly one of |encoder| and |multistream_encoder| is set, depending on
+// which create function made the instance; likewise for the decoder.
 struct WebRtcOpusEncInst {
   OpusEncoder* encoder;
+  OpusMSEncoder* multistream_encoder;
   size_t channels;
   int in_dtx_mode;
 };
 
 struct WebRtcOpusDecInst {
   OpusDecoder* decoder;
+  OpusMSDecoder* multistream_decoder;
   int prev_decoded_samples;
   size_t channels;
   int in_dtx_mode;
@@ -47,6 +47,40 @@ int16_t WebRtcOpus_EncoderCreate(OpusEncInst** inst,
                                  size_t channels,
                                  int32_t application);
 
+/****************************************************************************
+ * WebRtcOpus_MultistreamEncoderCreate(...)
+ *
+ * This function creates an Opus encoder for more than two channels, which
+ * are coded as a number of mono and stereo Opus streams in one packet
+ * (RFC 7845 section 5.1.1). The other functions take the instance in the
+ * same way as one made by WebRtcOpus_EncoderCreate().
+ *
+ * Input:
+ *      - channels           : number of input channels.
+ *      - application        : 0 - VOIP applications.
+ *                                 Favor speech intelligibility.
+ *                             1 - Audio applications.
+ *                                 Favor faithfulness to the original input.
+ *      - streams            : number of streams in each packet.
+ *      - coupled_streams    : number of those streams that are stereo.
+ *      - channel_mapping    : |channels| entries, mapping each input channel
+ *                             to a decoded stream channel.
+ *
+ * Output:
+ *      - inst               : a pointer to Encoder context that is created
+ *                             if success.
+ *
+ * Return value              : 0 - Success
+ *                            -1 - Error
+ */
+int16_t WebRtcOpus_MultistreamEncoderCreate(
+    OpusEncInst** inst,
+    size_t channels,
+    int32_t application,
+    size_t streams,
+    size_t coupled_streams,
+    const unsigned char* channel_mapping);
+
 int16_t WebRtcOpus_EncoderFree(OpusEncInst* inst);
 
 /****************************************************************************
@@ -279,6 +313,35 @@ int16_t WebRtcOpus_SetBandwidth(OpusEncInst* inst, int32_t bandwidth);
 int16_t WebRtcOpus_SetForceChannels(OpusEncInst* inst, size_t num_channels);
 
 int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst, size_t channels);
+
+/****************************************************************************
+ * WebRtcOpus_MultistreamDecoderCreate(...)
+ *
+ * This function creates an Opus decoder for packets made by an encoder from
+ * WebRtcOpus_MultistreamEncoderCreate(). Decoded audio is interleaved with
+ * |channels| channels.
+ *
+ * Input:
+ *      - channels           : number of output channels.
+ *      - streams            : number of streams in each packet.
+ *      - coupled_streams    : number of those streams that are stereo.
+ *      - channel_mapping    : |channels| entries, mapping each output channel
+ *                             to a decoded stream channel.
+ *
+ * Output:
+ *      - inst               : a pointer to Decoder context that is created
+ *                             if success.
+ *
+ * Return value              : 0 - Success
+ *                            -1 - Error
+ */
+int16_t WebRtcOpus_MultistreamDecoderCreate(
+    OpusDecInst** inst,
+    size_t channels,
+    size_t streams,
+    size_t coupled_streams,
+    const unsigned char* channel_mapping);
+
 int16_t WebRtcOpus_DecoderFree(OpusDecInst* inst);
 
 /****************************************************************************
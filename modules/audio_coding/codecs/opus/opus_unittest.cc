@@ -8,8 +8,10 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <cmath>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/audio_coding/codecs/opus/opus_inst.h"
 #include "modules/audio_coding/codecs/opus/opus_interface.h"
@@ -357,10 +359,16 @@ TEST(OpusTest, OpusCreateFail) {
   EXPECT_EQ(-1, WebRtcOpus_EncoderCreate(&opus_encoder, 3, 0));
   // Invalid applciation mode.
   EXPECT_EQ(-1, WebRtcOpus_EncoderCreate(&opus_encoder, 1, 2));
+  // Channel mapping to a stream channel that does not exist.
+  const unsigned char kChannelMapping[] = {0, 1, 3};
+  EXPECT_EQ(-1, WebRtcOpus_MultistreamEncoderCreate(&opus_encoder, 3, 0, 2, 0,
+                                                    kChannelMapping));
 
   EXPECT_EQ(-1, WebRtcOpus_DecoderCreate(NULL, 1));
   // Invalid channel number.
   EXPECT_EQ(-1, WebRtcOpus_DecoderCreate(&opus_decoder, 3));
+  EXPECT_EQ(-1, WebRtcOpus_MultistreamDecoderCreate(&opus_decoder, 3, 2, 0,
+                                                    kChannelMapping));
 }
 
 // Test failing Free.
@@ -370,6 +378,49 @@ TEST(OpusTest, OpusFreeFail) {
   EXPECT_EQ(-1, WebRtcOpus_DecoderFree(NULL));
 }
 
+// Encodes and decodes 5.1 audio as two stereo and two mono streams.
+TEST(OpusTest, OpusMultistreamEncodeDecode) {
+  const size_t kChannels = 6;
+  const unsigned char kChannelMapping[kChannels] = {0, 1, 4, 5, 2, 3};
+  WebRtcOpusEncInst* opus_encoder;
+  WebRtcOpusDecInst* opus_decoder;
+  ASSERT_EQ(0, WebRtcOpus_MultistreamEncoderCreate(&opus_encoder, kChannels, 1,
+                                                   4, 2, kChannelMapping));
+  ASSERT_EQ(0, WebRtcOpus_MultistreamDecoderCreate(&opus_decoder, kChannels, 4,
+                                                   2, kChannelMapping));
+  EXPECT_EQ(kChannels, WebRtcOpus_DecoderChannels(opus_decoder));
+  EXPECT_EQ(0, WebRtcOpus_SetBitRate(opus_encoder, 256000));
+  EXPECT_EQ(0, WebRtcOpus_SetComplexity(opus_encoder, 5));
+
+  // A tone of a different frequency in each channel.
+  std::vector<int16_t> input(kOpus20msFrameSamples * kChannels);
+  for (size_t i = 0; i < kOpus20msFrameSamples; ++i) {
+    for (size_t c = 0; c < kChannels; ++c) {
+      input[i * kChannels + c] = static_cast<int16_t>(
+          8000 * std::sin(2 * M_PI * 200 * (c + 1) * i / 48000));
+    }
+  }
+  uint8_t bitstream[kMaxBytes * kChannels];
+  std::vector<int16_t> output(kOpus20msFrameSamples * kChannels);
+  for (int i = 0; i < 10; ++i) {
+    const int encoded_bytes =
+        WebRtcOpus_Encode(opus_encoder, input.data(), kOpus20msFrameSamples,
+                          sizeof(bitstream), bitstream);
+    ASSERT_GT(encoded_bytes, 0);
+    EXPECT_EQ(static_cast<int>(kOpus20msFrameSamples),
+              WebRtcOpus_DurationEst(opus_decoder, bitstream, encoded_bytes));
+    int16_t audio_type;
+    EXPECT_EQ(static_cast<int>(kOpus20msFrameSamples),
+              WebRtcOpus_Decode(opus_decoder, bitstream, encoded_bytes,
+                                output.data(), &audio_type));
+  }
+  EXPECT_EQ(static_cast<int>(kOpus20msFrameSamples),
+            WebRtcOpus_DecodePlc(opus_decoder, output.data(), 1));
+
+  EXPECT_EQ(0, WebRtcOpus_EncoderFree(opus_encoder));
+  EXPECT_EQ(0, WebRtcOpus_DecoderFree(opus_decoder));
+}
+
 // Test normal Create and Free.
 TEST_P(OpusTest, OpusCreateFree) {
   EXPECT_EQ(0,
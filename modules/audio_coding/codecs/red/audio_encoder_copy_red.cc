@@ -18,14 +18,29 @@
 
 namespace webrtc {
 
+namespace {
+
+// Limits of the timestamp offset and block length fields of a RED header.
+constexpr uint32_t kMaxTimestampOffset = (1 << 14) - 1;
+constexpr size_t kMaxBlockLength = (1 << 10) - 1;
+
+}  // namespace
+
+constexpr size_t AudioEncoderCopyRed::kMaxRedundantFrames;
+
 AudioEncoderCopyRed::Config::Config() = default;
 AudioEncoderCopyRed::Config::Config(Config&&) = default;
 AudioEncoderCopyRed::Config::~Config() = default;
 
 AudioEncoderCopyRed::AudioEncoderCopyRed(Config&& config)
     : speech_encoder_(std::move(config.speech_encoder)),
-      red_payload_type_(config.payload_type) {
+      red_payload_type_(config.payload_type),
+      num_redundant_frames_(config.num_redundant_frames) {
   RTC_CHECK(speech_encoder_) << "Speech encoder not provided.";
+  RTC_CHECK_GE(num_redundant_frames_, 1);
+  RTC_CHECK_LE(num_redundant_frames_, kMaxRedundantFrames);
+  // Reserve the history up front, so that encoding does not allocate.
+  redundant_info_.reserve(num_redundant_frames_ + 1);
 }
 
 AudioEncoderCopyRed::~AudioEncoderCopyRed() = default;
@@ -68,17 +83,34 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
     // |info| will be implicitly cast to an EncodedInfoLeaf struct, effectively
     // discarding the (empty) vector of redundant information. This is
     // intentional.
+    info.redundant.reserve(redundant_info_.size() + 1);
     info.redundant.push_back(info);
     RTC_DCHECK_EQ(info.redundant.size(), 1);
-    if (secondary_info_.encoded_bytes > 0) {
-      encoded->AppendData(secondary_encoded_);
-      info.redundant.push_back(secondary_info_);
-      RTC_DCHECK_EQ(info.redundant.size(), 2);
+    // The earlier encodings are stored back to back, so they are appended at
+    // once. Stop at the first one that does not fit in a RED header.
+    size_t redundant_bytes = 0;
+    for (const EncodedInfoLeaf& redundant : redundant_info_) {
+      if (info.encoded_timestamp - redundant.encoded_timestamp >
+              kMaxTimestampOffset ||
+          redundant.encoded_bytes > kMaxBlockLength) {
+        break;
+      }
+      redundant_bytes += redundant.encoded_bytes;
+      info.redundant.push_back(redundant);
     }
-    // Save primary to secondary.
-    secondary_encoded_.SetData(encoded->data() + primary_offset,
-                               info.encoded_bytes);
-    secondary_info_ = info;
+    encoded->AppendData(redundant_encoded_.data(), redundant_bytes);
+
+    // The newest encodings, which are now back to back in |encoded|, are to be
+    // repeated in the next packet. Copying them reuses the memory of
+    // |redundant_encoded_|.
+    redundant_info_.assign(info.redundant.begin(), info.redundant.end());
+    if (redundant_info_.size() > num_redundant_frames_)
+      redundant_info_.pop_back();
+    redundant_bytes = 0;
+    for (const EncodedInfoLeaf& redundant : redundant_info_)
+      redundant_bytes += redundant.encoded_bytes;
+    redundant_encoded_.SetData(encoded->data() + primary_offset,
+                               redundant_bytes);
     RTC_DCHECK_EQ(info.speech, info.redundant[0].speech);
   }
   // Update main EncodedInfo.
@@ -93,8 +125,8 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
 
 void AudioEncoderCopyRed::Reset() {
   speech_encoder_->Reset();
-  secondary_encoded_.Clear();
-  secondary_info_.encoded_bytes = 0;
+  redundant_encoded_.Clear();
+  redundant_info_.clear();
 }
 
 bool AudioEncoderCopyRed::SetFec(bool enable) {
@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
@@ -25,16 +26,21 @@ namespace webrtc {
 
 // This class implements redundant audio coding. The class object will have an
 // underlying AudioEncoder object that performs the actual encodings. The
-// current class will gather the two latest encodings from the underlying codec
-// into one packet.
+// current class will gather the latest encoding from the underlying codec and
+// up to |num_redundant_frames| earlier encodings into one packet.
 class AudioEncoderCopyRed final : public AudioEncoder {
  public:
+  static constexpr size_t kMaxRedundantFrames = 3;
+
   struct Config {
     Config();
     Config(Config&&);
     ~Config();
     int payload_type;
     std::unique_ptr<AudioEncoder> speech_encoder;
+    // Number of earlier encodings to repeat in each packet, 1 to
+    // |kMaxRedundantFrames|.
+    size_t num_redundant_frames = 1;
   };
 
   explicit AudioEncoderCopyRed(Config&& config);
@@ -70,8 +76,10 @@ class AudioEncoderCopyRed final : public AudioEncoder {
  private:
   std::unique_ptr<AudioEncoder> speech_encoder_;
   int red_payload_type_;
-  rtc::Buffer secondary_encoded_;
-  EncodedInfoLeaf secondary_info_;
+  const size_t num_redundant_frames_;
+  // The encodings to repeat in the next packet, newest first, back to back.
+  rtc::Buffer redundant_encoded_;
+  std::vector<EncodedInfoLeaf> redundant_info_;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderCopyRed);
 };
 
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -244,6 +245,47 @@ TEST_F(AudioEncoderCopyRedTest, CheckPayloads) {
   }
 }
 
+// Checks that up to three earlier encodings are repeated, newest first.
+TEST_F(AudioEncoderCopyRedTest, CheckThreeRedundantFrames) {
+  mock_encoder_ = new MockAudioEncoder;
+  AudioEncoderCopyRed::Config config;
+  config.payload_type = red_payload_type_;
+  config.speech_encoder = std::unique_ptr<AudioEncoder>(mock_encoder_);
+  config.num_redundant_frames = 3;
+  red_.reset(new AudioEncoderCopyRed(std::move(config)));
+  EXPECT_CALL(*mock_encoder_, NumChannels()).WillRepeatedly(Return(1U));
+  EXPECT_CALL(*mock_encoder_, SampleRateHz())
+      .WillRepeatedly(Return(sample_rate_hz_));
+
+  // Let the mock encoder write payloads of sizes 1, 2, 3, ... with the size
+  // as the value of every byte.
+  static const int kNumPackets = 6;
+  uint8_t payload[kNumPackets];
+  InSequence s;
+  for (int i = 1; i <= kNumPackets; ++i) {
+    EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+        .WillOnce(Invoke(MockAudioEncoder::CopyEncoding(
+            rtc::ArrayView<const uint8_t>(payload, i))));
+  }
+
+  for (size_t i = 1; i <= kNumPackets; ++i) {
+    for (size_t j = 0; j < i; ++j)
+      payload[j] = i;
+    Encode();
+    const size_t num_encodings = std::min<size_t>(i, 4);
+    ASSERT_EQ(num_encodings, encoded_info_.redundant.size());
+    size_t offset = 0;
+    for (size_t j = 0; j < num_encodings; ++j) {
+      const size_t size = i - j;
+      EXPECT_EQ(size, encoded_info_.redundant[j].encoded_bytes);
+      for (size_t k = 0; k < size; ++k)
+        EXPECT_EQ(size, encoded_.data()[offset + k]);
+      offset += size;
+    }
+    EXPECT_EQ(offset, encoded_info_.encoded_bytes);
+  }
+}
+
 // Checks correct propagation of payload type.
 // Checks that the correct timestamps are returned.
 TEST_F(AudioEncoderCopyRedTest, CheckPayloadType) {
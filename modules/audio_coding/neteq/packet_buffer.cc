@@ -8,14 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. The packets are kept
+// in a fixed-size ring of slots, sorted at all times so that the next packet to
+// decode is at the front of the ring.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -29,17 +28,6 @@
 
 namespace webrtc {
 namespace {
-// Predicate used when inserting packets in the buffer list.
-// Operator() returns true when |packet| goes before |new_packet|.
-class NewTimestampIsLarger {
- public:
-  explicit NewTimestampIsLarger(const Packet& new_packet)
-      : new_packet_(new_packet) {}
-  bool operator()(const Packet& packet) { return (new_packet_ >= packet); }
-
- private:
-  const Packet& new_packet_;
-};
 
 // Returns true if both payload types are known to the decoder database, and
 // have the same sample rate.
@@ -64,7 +52,12 @@ void LogPacketDiscarded(int codec_level, StatisticsCalculator* stats) {
 
 PacketBuffer::PacketBuffer(size_t max_number_of_packets,
                            const TickTimer* tick_timer)
-    : max_number_of_packets_(max_number_of_packets), tick_timer_(tick_timer) {}
+    : max_number_of_packets_(max_number_of_packets),
+      // A full buffer is flushed before the next packet is inserted, so the
+      // buffer holds at most |max_number_of_packets| packets, but always room
+      // for at least one.
+      slots_(std::max<size_t>(max_number_of_packets, 1)),
+      tick_timer_(tick_timer) {}
 
 // Destructor. All packets in the buffer will be destroyed.
 PacketBuffer::~PacketBuffer() {
@@ -73,11 +66,15 @@ PacketBuffer::~PacketBuffer() {
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
-  buffer_.clear();
+  for (size_t i = 0; i < size_; ++i) {
+    At(i) = Packet();
+  }
+  begin_ = 0;
+  size_ = 0;
 }
 
 bool PacketBuffer::Empty() const {
-  return buffer_.empty();
+  return size_ == 0;
 }
 
 int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
@@ -93,7 +90,7 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
 
   packet.waiting_time = tick_timer_->GetNewStopwatch();
 
-  if (buffer_.size() >= max_number_of_packets_) {
+  if (size_ >= max_number_of_packets_) {
     // Buffer is full. Flush it.
     Flush();
     stats->FlushedPacketBuffer();
@@ -101,29 +98,31 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
     return_val = kFlushed;
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(), NewTimestampIsLarger(packet));
+  // Find the position in the buffer where the new packet should be inserted.
+  // The buffer is searched from the back, since the most likely case is that
+  // the new packet should be near the end of the buffer.
+  size_t index = size_;
+  while (index > 0 && !(packet >= At(index - 1))) {
+    --index;
+  }
 
-  // The new packet is to be inserted to the right of |rit|. If it has the same
-  // timestamp as |rit|, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
+  // The new packet is to be inserted to the right of |index - 1|. If it has
+  // the same timestamp as that packet, which has a higher priority, do not
+  // insert the new packet to the buffer.
+  if (index > 0 && packet.timestamp == At(index - 1).timestamp) {
     LogPacketDiscarded(packet.priority.codec_level, stats);
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of |it|. If it has the same
-  // timestamp as |it|, which has a lower priority, replace |it| with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() && packet.timestamp == it->timestamp) {
-    LogPacketDiscarded(it->priority.codec_level, stats);
-    it = buffer_.erase(it);
+  // The new packet is to be inserted to the left of |index|. If it has the
+  // same timestamp as that packet, which has a lower priority, replace it with
+  // the new packet.
+  if (index < size_ && packet.timestamp == At(index).timestamp) {
+    LogPacketDiscarded(At(index).priority.codec_level, stats);
+    At(index) = std::move(packet);
+    return return_val;
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+  InsertAt(index, std::move(packet));  // Insert the packet at that position.
 
   return return_val;
 }
@@ -181,7 +180,7 @@ int PacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  *next_timestamp = buffer_.front().timestamp;
+  *next_timestamp = At(0).timestamp;
   return kOK;
 }
 
@@ -193,11 +192,10 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (size_t i = 0; i < size_; ++i) {
+    if (At(i).timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = At(i).timestamp;
       return kOK;
     }
   }
@@ -205,7 +203,7 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
 }
 
 const Packet* PacketBuffer::PeekNextPacket() const {
-  return buffer_.empty() ? nullptr : &buffer_.front();
+  return Empty() ? nullptr : &At(0);
 }
 
 absl::optional<Packet> PacketBuffer::GetNextPacket() {
@@ -214,10 +212,10 @@ absl::optional<Packet> PacketBuffer::GetNextPacket() {
     return absl::nullopt;
   }
 
-  absl::optional<Packet> packet(std::move(buffer_.front()));
+  absl::optional<Packet> packet(std::move(At(0)));
   // Assert that the packet sanity checks in InsertPacket method works.
   RTC_DCHECK(!packet->empty());
-  buffer_.pop_front();
+  PopFront();
 
   return packet;
 }
@@ -227,17 +225,17 @@ int PacketBuffer::DiscardNextPacket(StatisticsCalculator* stats) {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  const Packet& packet = buffer_.front();
+  const Packet& packet = At(0);
   RTC_DCHECK(!packet.empty());
   LogPacketDiscarded(packet.priority.codec_level, stats);
-  buffer_.pop_front();
+  PopFront();
   return kOK;
 }
 
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples,
                                      StatisticsCalculator* stats) {
-  buffer_.remove_if([timestamp_limit, horizon_samples, stats](const Packet& p) {
+  RemoveIf([timestamp_limit, horizon_samples, stats](const Packet& p) {
     if (timestamp_limit == p.timestamp ||
         !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
       return false;
@@ -254,7 +252,7 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
                                                  StatisticsCalculator* stats) {
-  buffer_.remove_if([payload_type, stats](const Packet& p) {
+  RemoveIf([payload_type, stats](const Packet& p) {
     if (p.payload_type != payload_type) {
       return false;
     }
@@ -264,13 +262,14 @@ void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
-  return buffer_.size();
+  return size_;
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
     if (packet.frame) {
       // TODO(hlundin): Verify that it's fine to count all packets and remove
       // this check.
@@ -290,7 +289,8 @@ size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
 bool PacketBuffer::ContainsDtxOrCngPacket(
     const DecoderDatabase* decoder_database) const {
   RTC_DCHECK(decoder_database);
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
     if ((packet.frame && packet.frame->IsDtxPacket()) ||
         decoder_database->IsComfortNoise(packet.payload_type)) {
       return true;
@@ -299,4 +299,54 @@ bool PacketBuffer::ContainsDtxOrCngPacket(
   return false;
 }
 
+Packet& PacketBuffer::At(size_t index) {
+  RTC_DCHECK_LT(index, slots_.size());
+  return slots_[(begin_ + index) % slots_.size()];
+}
+
+const Packet& PacketBuffer::At(size_t index) const {
+  RTC_DCHECK_LT(index, slots_.size());
+  return slots_[(begin_ + index) % slots_.size()];
+}
+
+void PacketBuffer::InsertAt(size_t index, Packet&& packet) {
+  RTC_DCHECK_LE(index, size_);
+  RTC_DCHECK_LT(size_, slots_.size());
+  if (index == 0 && size_ > 0) {
+    // Inserting at the front; grow the ring backwards instead of moving all
+    // packets.
+    begin_ = (begin_ + slots_.size() - 1) % slots_.size();
+  } else {
+    for (size_t i = size_; i > index; --i) {
+      At(i) = std::move(At(i - 1));
+    }
+  }
+  At(index) = std::move(packet);
+  ++size_;
+}
+
+void PacketBuffer::PopFront() {
+  RTC_DCHECK_GT(size_, 0);
+  // Release the resources held by the slot right away.
+  At(0) = Packet();
+  begin_ = (begin_ + 1) % slots_.size();
+  --size_;
+}
+
+template <typename Predicate>
+void PacketBuffer::RemoveIf(Predicate predicate) {
+  size_t kept = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    if (predicate(At(i)))
+      continue;
+    if (kept != i)
+      At(kept) = std::move(At(i));
+    ++kept;
+  }
+  for (size_t i = kept; i < size_; ++i) {
+    At(i) = Packet();
+  }
+  size_ = kept;
+}
+
 }  // namespace webrtc
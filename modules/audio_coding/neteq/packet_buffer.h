@@ -11,6 +11,8 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
@@ -23,7 +25,9 @@ class DecoderDatabase;
 class StatisticsCalculator;
 class TickTimer;
 
-// This is the actual buffer holding the packets before decoding.
+// This is the actual buffer holding the packets before decoding. The packets
+// are stored sorted in a ring of preallocated slots, so that inserting and
+// extracting packets does not allocate memory in the buffer itself.
 class PacketBuffer {
  public:
   enum BufferReturnCodes {
@@ -36,7 +40,8 @@ class PacketBuffer {
   };
 
   // Constructor creates a buffer which can hold a maximum of
-  // |max_number_of_packets| packets.
+  // |max_number_of_packets| packets. Storage for all of them is allocated
+  // up front.
   PacketBuffer(size_t max_number_of_packets, const TickTimer* tick_timer);
 
   // Deletes all packets in the buffer before destroying the buffer.
@@ -140,8 +145,27 @@ class PacketBuffer {
   }
 
  private:
+  // Returns the packet at position |index| in sorted order, where 0 is the
+  // next packet to decode.
+  Packet& At(size_t index);
+  const Packet& At(size_t index) const;
+  // Inserts |packet| at sorted position |index|, moving the packets after it
+  // one step towards the back.
+  void InsertAt(size_t index, Packet&& packet);
+  void PopFront();
+  // Removes all packets for which |predicate| returns true, keeping the order
+  // of the remaining packets. |predicate| is called once per packet, from the
+  // front to the back.
+  template <typename Predicate>
+  void RemoveIf(Predicate predicate);
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  // Ring of packet slots. The packets in the buffer occupy |size_| consecutive
+  // slots (modulo the ring size) starting at |begin_|; the other slots hold
+  // empty packets.
+  std::vector<Packet> slots_;
+  size_t begin_ = 0;
+  size_t size_ = 0;
   const TickTimer* tick_timer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
@@ -434,6 +434,38 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Inserts packets out of order and extracts them again many times over, so that
+// the packets wrap around the end of the buffer's storage.
+TEST(PacketBuffer, ReorderingAcrossWrapAround) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(5, &tick_timer);  // 5 packets.
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(0, 0, 0, ts_increment);
+  const int payload_len = 10;
+  StrictMock<MockStatisticsCalculator> mock_stats;
+
+  uint32_t expected_ts = 0;
+  for (int round = 0; round < 20; ++round) {
+    // Generate three packets and insert them in the order 2, 0, 1.
+    Packet packets[3] = {gen.NextPacket(payload_len),
+                         gen.NextPacket(payload_len),
+                         gen.NextPacket(payload_len)};
+    for (int i : {2, 0, 1}) {
+      ASSERT_EQ(PacketBuffer::kOK,
+                buffer.InsertPacket(std::move(packets[i]), &mock_stats));
+    }
+    // Leave one packet in the buffer every other round.
+    const int num_to_extract = round % 2 ? 4 : 2;
+    for (int i = 0; i < num_to_extract; ++i) {
+      const absl::optional<Packet> packet = buffer.GetNextPacket();
+      ASSERT_TRUE(packet);
+      EXPECT_EQ(expected_ts, packet->timestamp);
+      expected_ts += ts_increment;
+    }
+  }
+  EXPECT_TRUE(buffer.Empty());
+}
+
 // The test first inserts a packet with narrow-band CNG, then a packet with
 // wide-band speech. The expected behavior of the packet buffer is to detect a
 // change in sample rate, even though no speech packet has been inserted before,
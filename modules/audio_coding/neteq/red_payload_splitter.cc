@@ -12,10 +12,11 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <string.h>
 #include <cstdint>
+#include <iterator>
 #include <list>
 #include <utility>
-#include <vector>
 
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
@@ -26,22 +27,21 @@
 namespace webrtc {
 
 // The method loops through a list of packets {A, B, C, ...}. Each packet is
-// split into its corresponding RED payloads, {A1, A2, ...}, which is
-// temporarily held in the list |new_packets|.
-// When the first packet in |packet_list| has been processed, the orignal packet
-// is replaced by the new ones in |new_packets|, so that |packet_list| becomes:
-// {A1, A2, ..., B, C, ...}. The method then continues with B, and C, until all
-// the original packets have been replaced by their split payloads.
+// split into its corresponding RED payloads, {A1, A2, ...}. The primary payload
+// A1 is moved to the front of the payload of A, which is kept in the list,
+// while the redundant payloads are copied into new packets which are inserted
+// after it, so that |packet_list| becomes: {A1, A2, ..., B, C, ...}. The method
+// then continues with B, and C, until all the original packets have been
+// replaced by their split payloads. Redundant payloads for timestamps that have
+// already been split out of an earlier packet are skipped without copying.
 bool RedPayloadSplitter::SplitRed(PacketList* packet_list) {
-  // Too many RED blocks indicates that something is wrong. Clamp it at some
-  // reasonable value.
-  const size_t kMaxRedBlocks = 32;
   bool ret = true;
   PacketList::iterator it = packet_list->begin();
   while (it != packet_list->end()) {
-    const Packet& red_packet = *it;
+    Packet& red_packet = *it;
     assert(!red_packet.payload.empty());
     const uint8_t* payload_ptr = red_packet.payload.data();
+    const uint8_t* const payload_end = payload_ptr + red_packet.payload.size();
 
     // Read RED headers (according to RFC 2198):
     //
@@ -62,11 +62,21 @@ bool RedPayloadSplitter::SplitRed(PacketList* packet_list) {
       size_t payload_length;
     };
 
-    std::vector<RedHeader> new_headers;
+    RedHeader new_headers[kMaxRedBlocks];
+    size_t num_headers = 0;
     bool last_block = false;
     size_t sum_length = 0;
     while (!last_block) {
-      RedHeader new_header;
+      if (num_headers == kMaxRedBlocks) {
+        RTC_LOG(LS_WARNING) << "SplitRed too many blocks";
+        break;
+      }
+      if (payload_ptr >= payload_end ||
+          ((*payload_ptr & 0x80) != 0 && payload_end - payload_ptr < 4)) {
+        RTC_LOG(LS_WARNING) << "SplitRed truncated header";
+        break;
+      }
+      RedHeader& new_header = new_headers[num_headers++];
       // Check the F bit. If F == 0, this was the last block.
       last_block = ((*payload_ptr & 0x80) == 0);
       // Bits 1 through 7 are payload type.
@@ -89,52 +99,84 @@ bool RedPayloadSplitter::SplitRed(PacketList* packet_list) {
       }
       sum_length += new_header.payload_length;
       sum_length += 4;  // Account for RED header size of 4 bytes.
-      // Store in new list of packets.
-      new_headers.push_back(new_header);
     }
 
-    if (new_headers.size() <= kMaxRedBlocks) {
-      // Populate the new packets with payload data.
-      // |payload_ptr| now points at the first payload byte.
-      PacketList new_packets;  // An empty list to store the split packets in.
-      for (size_t i = 0; i != new_headers.size(); ++i) {
-        const auto& new_header = new_headers[i];
-        size_t payload_length = new_header.payload_length;
-        if (payload_ptr + payload_length >
-            red_packet.payload.data() + red_packet.payload.size()) {
-          // The block lengths in the RED headers do not match the overall
-          // packet length. Something is corrupt. Discard this and the remaining
-          // payloads from this packet.
-          RTC_LOG(LS_WARNING) << "SplitRed length mismatch";
-          ret = false;
-          break;
-        }
+    if (!last_block) {
+      ret = false;
+      it = packet_list->erase(it);
+      continue;
+    }
+
+    // Populate the new packets with payload data.
+    // |payload_ptr| now points at the first payload byte.
+    PacketList new_packets;  // An empty list to store the split packets in.
+    const uint8_t* primary_ptr = nullptr;
+    for (size_t i = 0; i != num_headers; ++i) {
+      const auto& new_header = new_headers[i];
+      size_t payload_length = new_header.payload_length;
+      if (payload_ptr + payload_length > payload_end) {
+        // The block lengths in the RED headers do not match the overall
+        // packet length. Something is corrupt. Discard this and the remaining
+        // payloads from this packet.
+        RTC_LOG(LS_WARNING) << "SplitRed length mismatch";
+        ret = false;
+        break;
+      }
 
+      const size_t red_level = (num_headers - 1) - i;
+      if (red_level == 0) {
+        primary_ptr = payload_ptr;
+      } else if (!WasSplit(new_header.timestamp)) {
         Packet new_packet;
         new_packet.timestamp = new_header.timestamp;
         new_packet.payload_type = new_header.payload_type;
         new_packet.sequence_number = red_packet.sequence_number;
-        new_packet.priority.red_level =
-            rtc::dchecked_cast<int>((new_headers.size() - 1) - i);
+        new_packet.priority.red_level = rtc::dchecked_cast<int>(red_level);
         new_packet.payload.SetData(payload_ptr, payload_length);
         new_packets.push_front(std::move(new_packet));
-        payload_ptr += payload_length;
       }
-      // Insert new packets into original list, before the element pointed to by
-      // iterator |it|.
-      packet_list->splice(it, std::move(new_packets));
+      RememberSplit(new_header.timestamp);
+      payload_ptr += payload_length;
+    }
+
+    // Insert new packets into original list, after the element pointed to by
+    // iterator |it|.
+    PacketList::iterator next = std::next(it);
+    packet_list->splice(next, std::move(new_packets));
+    if (primary_ptr) {
+      // Reuse the RED packet, and its buffer, for the primary payload.
+      const RedHeader& primary_header = new_headers[num_headers - 1];
+      memmove(red_packet.payload.data(), primary_ptr,
+              primary_header.payload_length);
+      red_packet.payload.SetSize(primary_header.payload_length);
+      red_packet.payload_type = primary_header.payload_type;
+      red_packet.priority.red_level = 0;
     } else {
-      RTC_LOG(LS_WARNING) << "SplitRed too many blocks: " << new_headers.size();
-      ret = false;
+      packet_list->erase(it);
     }
-    // Remove |it| from the packet list. This operation effectively moves the
-    // iterator |it| to the next packet in the list. Thus, we do not have to
-    // increment it manually.
-    it = packet_list->erase(it);
+    // Continue with the next RED packet.
+    it = next;
   }
   return ret;
 }
 
+bool RedPayloadSplitter::WasSplit(uint32_t timestamp) const {
+  for (size_t i = 0; i < num_split_timestamps_; ++i) {
+    if (split_timestamps_[i] == timestamp)
+      return true;
+  }
+  return false;
+}
+
+void RedPayloadSplitter::RememberSplit(uint32_t timestamp) {
+  if (WasSplit(timestamp))
+    return;
+  split_timestamps_[next_split_index_] = timestamp;
+  next_split_index_ = (next_split_index_ + 1) % kMaxRedBlocks;
+  if (num_split_timestamps_ < kMaxRedBlocks)
+    ++num_split_timestamps_;
+}
+
 void RedPayloadSplitter::CheckRedPayloads(
     PacketList* packet_list,
     const DecoderDatabase& decoder_database) {
@@ -11,6 +11,9 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_RED_PAYLOAD_SPLITTER_H_
 #define MODULES_AUDIO_CODING_NETEQ_RED_PAYLOAD_SPLITTER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "modules/audio_coding/neteq/packet.h"
 #include "rtc_base/constructormagic.h"
 
@@ -29,7 +32,9 @@ class RedPayloadSplitter {
 
   // Splits each packet in |packet_list| into its separate RED payloads. Each
   // RED payload is packetized into a Packet. The original elements in
-  // |packet_list| are properly deleted, and replaced by the new packets.
+  // |packet_list| are reused for the primary payloads, and the redundant
+  // payloads are inserted after them. Redundant payloads with the timestamp of
+  // a payload that was split out of an earlier packet are dropped.
   // Note that all packets in |packet_list| must be RED payloads, i.e., have
   // RED headers according to RFC 2198 at the very beginning of the payload.
   // Returns kOK or an error.
@@ -42,6 +47,18 @@ class RedPayloadSplitter {
                                 const DecoderDatabase& decoder_database);
 
  private:
+  // Too many RED blocks indicates that something is wrong. Clamp it at some
+  // reasonable value.
+  static constexpr size_t kMaxRedBlocks = 32;
+
+  bool WasSplit(uint32_t timestamp) const;
+  void RememberSplit(uint32_t timestamp);
+
+  // Timestamps of the most recently split payloads.
+  uint32_t split_timestamps_[kMaxRedBlocks];
+  size_t num_split_timestamps_ = 0;
+  size_t next_split_index_ = 0;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(RedPayloadSplitter);
 };
 
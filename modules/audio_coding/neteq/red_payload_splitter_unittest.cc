@@ -226,15 +226,16 @@ TEST(RedPayloadSplitter, TwoPacketsOnePayload) {
                kSequenceNumber + 1, kBaseTimestamp + kTimestampOffset, 0, true);
 }
 
-// Packets A and B are split into packets A1, A2, A3, B1, B2, B3, with
-// attributes as follows:
+// Packets A and B are split into packets A1, A2, A3, B1, with attributes as
+// follows:
 //
 //                  A1*   A2    A3    B1*   B2    B3
 // Payload type     0     1     2     0     1     2
 // Timestamp        b     b-o   b-2o  b+o   b     b-o
 // Sequence number  0     0     0     1     1     1
 //
-// b = kBaseTimestamp, o = kTimestampOffset, * = primary.
+// b = kBaseTimestamp, o = kTimestampOffset, * = primary. B2 and B3 are dropped
+// since they repeat A1 and A2.
 TEST(RedPayloadSplitter, TwoPacketsThreePayloads) {
   uint8_t payload_types[] = {2, 1, 0};  // Primary is the last one.
   const int kTimestampOffset = 160;
@@ -251,7 +252,7 @@ TEST(RedPayloadSplitter, TwoPacketsThreePayloads) {
   }
   RedPayloadSplitter splitter;
   EXPECT_TRUE(splitter.SplitRed(&packet_list));
-  ASSERT_EQ(6u, packet_list.size());
+  ASSERT_EQ(4u, packet_list.size());
   // Check first packet, A1.
   VerifyPacket(packet_list.front(), kPayloadLength, payload_types[2],
                kSequenceNumber, kBaseTimestamp, 2, {0, 0});
@@ -269,15 +270,49 @@ TEST(RedPayloadSplitter, TwoPacketsThreePayloads) {
   VerifyPacket(packet_list.front(), kPayloadLength, payload_types[2],
                kSequenceNumber + 1, kBaseTimestamp + kTimestampOffset, 2,
                {0, 0});
-  packet_list.pop_front();
-  // Check fifth packet, B2.
+}
+
+// Redundant payloads are dropped also when they repeat a payload that was
+// split in an earlier call, but a late primary payload is always kept.
+TEST(RedPayloadSplitter, DropsRepeatedRedundantPayloads) {
+  uint8_t payload_types[] = {0, 0};
+  const int kTimestampOffset = 160;
+  RedPayloadSplitter splitter;
+
+  // Packet B, which repeats A, arrives before A.
+  PacketList packet_list;
+  {
+    Packet packet = CreateRedPayload(2, payload_types, kTimestampOffset);
+    packet.timestamp += kTimestampOffset;
+    packet.sequence_number++;
+    packet_list.push_back(std::move(packet));
+  }
+  EXPECT_TRUE(splitter.SplitRed(&packet_list));
+  ASSERT_EQ(2u, packet_list.size());
+  VerifyPacket(packet_list.back(), kPayloadLength, payload_types[0],
+               kSequenceNumber + 1, kBaseTimestamp, 0, false);
+
+  // The primary payload of A is kept, while its redundant payload is new.
+  packet_list.clear();
+  packet_list.push_back(CreateRedPayload(2, payload_types, kTimestampOffset));
+  EXPECT_TRUE(splitter.SplitRed(&packet_list));
+  ASSERT_EQ(2u, packet_list.size());
   VerifyPacket(packet_list.front(), kPayloadLength, payload_types[1],
-               kSequenceNumber + 1, kBaseTimestamp, 1, {0, 1});
-  packet_list.pop_front();
-  // Check sixth packet, B3.
-  VerifyPacket(packet_list.front(), kPayloadLength, payload_types[0],
-               kSequenceNumber + 1, kBaseTimestamp - kTimestampOffset, 0,
-               {0, 2});
+               kSequenceNumber, kBaseTimestamp, 1, true);
+
+  // Packet C repeats B, which is dropped.
+  packet_list.clear();
+  {
+    Packet packet = CreateRedPayload(2, payload_types, kTimestampOffset);
+    packet.timestamp += 2 * kTimestampOffset;
+    packet.sequence_number += 2;
+    packet_list.push_back(std::move(packet));
+  }
+  EXPECT_TRUE(splitter.SplitRed(&packet_list));
+  ASSERT_EQ(1u, packet_list.size());
+  VerifyPacket(packet_list.front(), kPayloadLength, payload_types[1],
+               kSequenceNumber + 2, kBaseTimestamp + 2 * kTimestampOffset, 1,
+               true);
 }
 
 // Creates a list with 4 packets with these payload types:
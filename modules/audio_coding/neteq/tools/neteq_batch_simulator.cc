@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/neteq_batch_simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "modules/audio_coding/neteq/tools/neteq_delay_analyzer.h"
+#include "modules/audio_coding/neteq/tools/neteq_test.h"
+#include "modules/audio_coding/neteq/tools/neteq_test_factory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// Forwards to another callback and counts the number of GetAudio calls.
+class GetAudioCounter : public NetEqGetAudioCallback {
+ public:
+  explicit GetAudioCounter(NetEqGetAudioCallback* other_callback)
+      : other_callback_(other_callback) {}
+
+  void BeforeGetAudio(NetEq* neteq) override {
+    other_callback_->BeforeGetAudio(neteq);
+  }
+
+  void AfterGetAudio(int64_t time_now_ms,
+                     const AudioFrame& audio_frame,
+                     bool muted,
+                     NetEq* neteq) override {
+    ++count_;
+    other_callback_->AfterGetAudio(time_now_ms, audio_frame, muted, neteq);
+  }
+
+  int64_t count() const { return count_; }
+
+ private:
+  NetEqGetAudioCallback* const other_callback_;
+  int64_t count_ = 0;
+};
+
+}  // namespace
+
+double NetEqBatchSimulator::Summary::GetAudioCallsPerSecond() const {
+  if (wall_clock_time_ms <= 0)
+    return 0.0;
+  return 1000.0 * total_get_audio_calls / wall_clock_time_ms;
+}
+
+double NetEqBatchSimulator::Summary::RealTimeFactor() const {
+  if (wall_clock_time_ms <= 0)
+    return 0.0;
+  return static_cast<double>(total_simulation_time_ms) / wall_clock_time_ms;
+}
+
+NetEqBatchSimulator::NetEqBatchSimulator(size_t num_threads)
+    : num_threads_(num_threads > 0 ? num_threads
+                                   : CpuInfo::DetectNumberOfCores()) {}
+
+NetEqBatchSimulator::~NetEqBatchSimulator() = default;
+
+NetEqBatchSimulator::Summary NetEqBatchSimulator::Run(
+    const std::vector<std::string>& input_file_names) {
+  input_file_names_ = &input_file_names;
+  {
+    rtc::CritScope lock(&crit_);
+    next_file_index_ = 0;
+  }
+  results_.clear();
+  results_.resize(input_file_names.size());
+
+  const int64_t start_time_ms = rtc::TimeMillis();
+  const size_t num_threads = std::min(num_threads_, input_file_names.size());
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.push_back(absl::make_unique<rtc::PlatformThread>(
+        &NetEqBatchSimulator::WorkerThread, this, "NetEqBatchWorker"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads) {
+    thread->Stop();
+  }
+  const int64_t wall_clock_time_ms = rtc::TimeMillis() - start_time_ms;
+
+  input_file_names_ = nullptr;
+  return Summarize(wall_clock_time_ms);
+}
+
+// static
+float NetEqBatchSimulator::Percentile(std::vector<float>* values,
+                                      double percentile) {
+  RTC_DCHECK_GE(percentile, 0.0);
+  RTC_DCHECK_LE(percentile, 100.0);
+  if (values->empty())
+    return 0.f;
+  size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 *
+                                              values->size()));
+  rank = std::max<size_t>(rank, 1) - 1;
+  std::nth_element(values->begin(), values->begin() + rank, values->end());
+  return (*values)[rank];
+}
+
+// static
+void NetEqBatchSimulator::WorkerThread(void* obj) {
+  static_cast<NetEqBatchSimulator*>(obj)->ProcessFiles();
+}
+
+void NetEqBatchSimulator::ProcessFiles() {
+  while (true) {
+    size_t index;
+    {
+      rtc::CritScope lock(&crit_);
+      if (next_file_index_ >= input_file_names_->size())
+        return;
+      index = next_file_index_++;
+    }
+    results_[index] = Simulate((*input_file_names_)[index]);
+  }
+}
+
+// static
+NetEqBatchSimulator::Result NetEqBatchSimulator::Simulate(
+    const std::string& input_file_name) {
+  // The factory must stay alive while the test is running.
+  NetEqTestFactory factory;
+  NetEqStatsGetter stats_getter(absl::make_unique<NetEqDelayAnalyzer>());
+  GetAudioCounter get_audio_counter(&stats_getter);
+  NetEqTest::Callbacks callbacks;
+  callbacks.post_insert_packet = stats_getter.delay_analyzer();
+  callbacks.get_audio_callback = &get_audio_counter;
+  std::unique_ptr<NetEqTest> test =
+      factory.InitializeTest(input_file_name, callbacks);
+
+  Result result;
+  result.input_file_name = input_file_name;
+  result.simulation_time_ms = test->Run();
+  result.num_get_audio_calls = get_audio_counter.count();
+  result.stats = stats_getter.AverageStats();
+
+  NetEqDelayAnalyzer::Delays arrival_delay_ms;
+  NetEqDelayAnalyzer::Delays corrected_arrival_delay_ms;
+  NetEqDelayAnalyzer::Delays playout_delay_ms;
+  NetEqDelayAnalyzer::Delays target_delay_ms;
+  stats_getter.delay_analyzer()->CreateGraphs(
+      &arrival_delay_ms, &corrected_arrival_delay_ms, &playout_delay_ms,
+      &target_delay_ms);
+  result.playout_delay_ms.reserve(playout_delay_ms.size());
+  for (const auto& delay : playout_delay_ms) {
+    result.playout_delay_ms.push_back(delay.second);
+  }
+  return result;
+}
+
+NetEqBatchSimulator::Summary NetEqBatchSimulator::Summarize(
+    int64_t wall_clock_time_ms) const {
+  Summary summary;
+  summary.num_simulations = results_.size();
+  summary.wall_clock_time_ms = wall_clock_time_ms;
+  std::vector<float> playout_delay_ms;
+  for (const Result& result : results_) {
+    summary.total_simulation_time_ms += result.simulation_time_ms;
+    summary.total_get_audio_calls += result.num_get_audio_calls;
+    const double weight = result.simulation_time_ms;
+    summary.expand_rate += weight * result.stats.expand_rate;
+    summary.speech_expand_rate += weight * result.stats.speech_expand_rate;
+    summary.accelerate_rate += weight * result.stats.accelerate_rate;
+    summary.preemptive_rate += weight * result.stats.preemptive_rate;
+    summary.packet_loss_rate += weight * result.stats.packet_loss_rate;
+    playout_delay_ms.insert(playout_delay_ms.end(),
+                            result.playout_delay_ms.begin(),
+                            result.playout_delay_ms.end());
+  }
+  if (summary.total_simulation_time_ms > 0) {
+    const double total = summary.total_simulation_time_ms;
+    summary.expand_rate /= total;
+    summary.speech_expand_rate /= total;
+    summary.accelerate_rate /= total;
+    summary.preemptive_rate /= total;
+    summary.packet_loss_rate /= total;
+  }
+  summary.playout_delay_p50_ms = Percentile(&playout_delay_ms, 50);
+  summary.playout_delay_p90_ms = Percentile(&playout_delay_ms, 90);
+  summary.playout_delay_p95_ms = Percentile(&playout_delay_ms, 95);
+  summary.playout_delay_p99_ms = Percentile(&playout_delay_ms, 99);
+  return summary;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BATCH_SIMULATOR_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BATCH_SIMULATOR_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "modules/audio_coding/neteq/tools/neteq_stats_getter.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace test {
+
+// Replays a set of RTP dumps or RTC event logs through NetEq, running one
+// NetEqTest per input file on a pool of worker threads. Each simulation runs
+// on simulated time, so the wall-clock time of the batch is bounded by the
+// CPU time spent in NetEq and the decoders. This makes the batch usable both
+// for collecting statistics over a large corpus and as a throughput benchmark
+// for changes to the jitter buffer logic.
+//
+// The tests are created with NetEqTestFactory and hence configured with the
+// same command line flags as neteq_rtpplay.
+class NetEqBatchSimulator {
+ public:
+  struct Result {
+    std::string input_file_name;
+    // Duration of the produced audio.
+    int64_t simulation_time_ms = 0;
+    // Number of GetAudio calls, i.e., jitter buffer decisions, made.
+    int64_t num_get_audio_calls = 0;
+    NetEqStatsGetter::Stats stats;
+    // Playout delay of each decoded packet.
+    std::vector<float> playout_delay_ms;
+  };
+
+  struct Summary {
+    size_t num_simulations = 0;
+    int64_t total_simulation_time_ms = 0;
+    int64_t total_get_audio_calls = 0;
+    int64_t wall_clock_time_ms = 0;
+    // Rates averaged over all simulations, weighted by simulation time.
+    double expand_rate = 0.0;
+    double speech_expand_rate = 0.0;
+    double accelerate_rate = 0.0;
+    double preemptive_rate = 0.0;
+    double packet_loss_rate = 0.0;
+    // Percentiles of the playout delay over all packets in all simulations.
+    double playout_delay_p50_ms = 0.0;
+    double playout_delay_p90_ms = 0.0;
+    double playout_delay_p95_ms = 0.0;
+    double playout_delay_p99_ms = 0.0;
+
+    // Throughput of the batch, in GetAudio calls per wall-clock second.
+    double GetAudioCallsPerSecond() const;
+    // Simulated time processed per wall-clock time.
+    double RealTimeFactor() const;
+  };
+
+  // Zero threads means one thread per CPU core.
+  explicit NetEqBatchSimulator(size_t num_threads);
+  ~NetEqBatchSimulator();
+
+  // Runs one simulation per file in |input_file_names| and blocks until all of
+  // them have finished. Results are available through results() afterwards,
+  // in the same order as |input_file_names|.
+  Summary Run(const std::vector<std::string>& input_file_names);
+
+  const std::vector<Result>& results() const { return results_; }
+
+  // Returns the |percentile| (in [0, 100]) of |values|, using the nearest-rank
+  // method. Reorders |values|. Returns 0 for an empty vector.
+  static float Percentile(std::vector<float>* values, double percentile);
+
+ private:
+  static void WorkerThread(void* obj);
+  void ProcessFiles();
+  static Result Simulate(const std::string& input_file_name);
+  Summary Summarize(int64_t wall_clock_time_ms) const;
+
+  const size_t num_threads_;
+  const std::vector<std::string>* input_file_names_ = nullptr;
+  rtc::CriticalSection crit_;
+  size_t next_file_index_ RTC_GUARDED_BY(crit_) = 0;
+  // Each slot is written by exactly one worker thread, and only read after all
+  // workers have been joined.
+  std::vector<Result> results_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(NetEqBatchSimulator);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BATCH_SIMULATOR_H_
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "modules/audio_coding/neteq/tools/neteq_batch_simulator.h"
+#include "rtc_base/flags.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/field_trial.h"
+
+WEBRTC_DEFINE_int(threads,
+                  0,
+                  "Number of simulations to run in parallel; 0 means one per "
+                  "CPU core");
+WEBRTC_DEFINE_string(input_list,
+                     "",
+                     "A text file with one input file name per line, used in "
+                     "addition to the input files given on the command line");
+WEBRTC_DEFINE_bool(per_file_stats, false, "Prints statistics for each input");
+WEBRTC_DEFINE_string(
+    force_fieldtrials,
+    "",
+    "Field trials control experimental feature code which can be forced. "
+    "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enable/"
+    " will assign the group Enable to field trial WebRTC-FooFeature.");
+WEBRTC_DEFINE_bool(help, false, "Prints this message");
+
+int main(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage =
+      "Tool for running many NetEq simulations of RTP dump files or RTC event "
+      "logs in parallel, and printing aggregate statistics and throughput.\n"
+      "The flags of neteq_rtpplay are also accepted.\n"
+      "Run " +
+      program_name +
+      " --help for usage.\n"
+      "Example usage:\n" +
+      program_name + " --threads=8 input1.rtp input2.rtp ...\n";
+  if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true)) {
+    exit(1);
+  }
+  if (FLAG_help) {
+    std::cout << usage;
+    rtc::FlagList::Print(nullptr, false);
+    exit(0);
+  }
+  if (FLAG_threads < 0) {
+    std::cout << "--threads must be non-negative" << std::endl;
+    exit(1);
+  }
+
+  std::vector<std::string> input_file_names(argv + 1, argv + argc);
+  if (strlen(FLAG_input_list) > 0) {
+    std::ifstream input_list(FLAG_input_list);
+    if (!input_list) {
+      std::cout << "Cannot open " << FLAG_input_list << std::endl;
+      exit(1);
+    }
+    std::string line;
+    while (std::getline(input_list, line)) {
+      if (!line.empty())
+        input_file_names.push_back(line);
+    }
+  }
+  if (input_file_names.empty()) {
+    std::cout << usage;
+    exit(0);
+  }
+
+  webrtc::test::ValidateFieldTrialsStringOrDie(FLAG_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(FLAG_force_fieldtrials);
+
+  webrtc::test::NetEqBatchSimulator simulator(FLAG_threads);
+  const webrtc::test::NetEqBatchSimulator::Summary summary =
+      simulator.Run(input_file_names);
+
+  if (FLAG_per_file_stats) {
+    for (const auto& result : simulator.results()) {
+      std::vector<float> delays = result.playout_delay_ms;
+      printf("%s: duration %" PRId64
+             " ms, expand_rate %f %%, accelerate_rate %f %%, "
+             "preemptive_rate %f %%, median playout delay %f ms\n",
+             result.input_file_name.c_str(), result.simulation_time_ms,
+             100.0 * result.stats.expand_rate,
+             100.0 * result.stats.accelerate_rate,
+             100.0 * result.stats.preemptive_rate,
+             webrtc::test::NetEqBatchSimulator::Percentile(&delays, 50));
+    }
+  }
+
+  printf("Batch statistics:\n");
+  printf("  simulations: %zu\n", summary.num_simulations);
+  printf("  total output duration: %" PRId64 " ms\n",
+         summary.total_simulation_time_ms);
+  printf("  expand_rate: %f %%\n", 100.0 * summary.expand_rate);
+  printf("  speech_expand_rate: %f %%\n", 100.0 * summary.speech_expand_rate);
+  printf("  accelerate_rate: %f %%\n", 100.0 * summary.accelerate_rate);
+  printf("  preemptive_rate: %f %%\n", 100.0 * summary.preemptive_rate);
+  printf("  packet_loss_rate: %f %%\n", 100.0 * summary.packet_loss_rate);
+  printf("  playout_delay_p50: %f ms\n", summary.playout_delay_p50_ms);
+  printf("  playout_delay_p90: %f ms\n", summary.playout_delay_p90_ms);
+  printf("  playout_delay_p95: %f ms\n", summary.playout_delay_p95_ms);
+  printf("  playout_delay_p99: %f ms\n", summary.playout_delay_p99_ms);
+  printf("Throughput:\n");
+  printf("  wall clock time: %" PRId64 " ms\n", summary.wall_clock_time_ms);
+  printf("  GetAudio decisions: %" PRId64 "\n", summary.total_get_audio_calls);
+  printf("  decisions per second: %f\n", summary.GetAudioCallsPerSecond());
+  printf("  real-time factor: %f\n", summary.RealTimeFactor());
+  return 0;
+}
@@ -24,6 +24,7 @@
 #include "absl/memory/memory.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "modules/audio_coding/neteq/include/neteq.h"
+#include "modules/audio_coding/neteq/tools/audio_sink.h"
 #include "modules/audio_coding/neteq/tools/fake_decode_from_file.h"
 #include "modules/audio_coding/neteq/tools/input_audio_file.h"
 #include "modules/audio_coding/neteq/tools/neteq_delay_analyzer.h"
@@ -295,6 +296,19 @@ void NetEqTestFactory::PrintCodecMap() {
 std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
     std::string input_file_name,
     std::string output_file_name) {
+  return CreateTest(input_file_name, output_file_name, absl::nullopt);
+}
+
+std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
+    std::string input_file_name,
+    NetEqTest::Callbacks callbacks) {
+  return CreateTest(input_file_name, "", callbacks);
+}
+
+std::unique_ptr<NetEqTest> NetEqTestFactory::CreateTest(
+    const std::string& input_file_name,
+    const std::string& output_file_name,
+    absl::optional<NetEqTest::Callbacks> external_callbacks) {
   RTC_CHECK(ValidatePayloadType(FLAG_pcmu));
   RTC_CHECK(ValidatePayloadType(FLAG_pcma));
   RTC_CHECK(ValidatePayloadType(FLAG_ilbc));
@@ -386,9 +400,11 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
   }
 
   // Open the output file now that we know the sample rate. (Rate is only needed
-  // for wav files.)
+  // for wav files.) Without an output file name, the audio is discarded.
   std::unique_ptr<AudioSink> output;
-  if (output_file_name.size() >= 4 &&
+  if (output_file_name.empty()) {
+    output.reset(new VoidAudioSink);
+  } else if (output_file_name.size() >= 4 &&
       output_file_name.substr(output_file_name.size() - 4) == ".wav") {
     // Open a wav file.
     output.reset(new OutputWavFile(output_file_name, *sample_rate_hz));
@@ -397,7 +413,8 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
     output.reset(new OutputAudioFile(output_file_name));
   }
 
-  std::cout << "Output file: " << output_file_name << std::endl;
+  if (!output_file_name.empty())
+    std::cout << "Output file: " << output_file_name << std::endl;
 
   NetEqTest::DecoderMap codecs = {
     {FLAG_pcmu, std::make_pair(NetEqDecoder::kDecoderPCMu, "pcmu")},
@@ -481,21 +498,25 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
 
   // Create a text log file if needed.
   std::unique_ptr<std::ofstream> text_log;
-  if (FLAG_textlog) {
+  if (FLAG_textlog && !output_file_name.empty()) {
     text_log =
         absl::make_unique<std::ofstream>(output_file_name + ".text_log.txt");
   }
 
   NetEqTest::Callbacks callbacks;
-  stats_plotter_.reset(new NetEqStatsPlotter(FLAG_matlabplot, FLAG_pythonplot,
-                                             FLAG_concealment_events,
-                                             output_file_name));
-
-  ssrc_switch_detector_.reset(
-      new SsrcSwitchDetector(stats_plotter_->stats_getter()->delay_analyzer()));
-  callbacks.post_insert_packet = ssrc_switch_detector_.get();
-  callbacks.get_audio_callback = stats_plotter_->stats_getter();
-  callbacks.simulation_ended_callback = stats_plotter_.get();
+  if (external_callbacks) {
+    callbacks = *external_callbacks;
+  } else {
+    stats_plotter_.reset(new NetEqStatsPlotter(
+        FLAG_matlabplot, FLAG_pythonplot, FLAG_concealment_events,
+        output_file_name));
+
+    ssrc_switch_detector_.reset(new SsrcSwitchDetector(
+        stats_plotter_->stats_getter()->delay_analyzer()));
+    callbacks.post_insert_packet = ssrc_switch_detector_.get();
+    callbacks.get_audio_callback = stats_plotter_->stats_getter();
+    callbacks.simulation_ended_callback = stats_plotter_.get();
+  }
   NetEq::Config config;
   config.sample_rate_hz = *sample_rate_hz;
   config.max_packets_in_buffer = FLAG_max_nr_packets_in_buffer;
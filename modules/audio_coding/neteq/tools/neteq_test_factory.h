@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 
+#include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/tools/neteq_test.h"
 
 namespace webrtc {
@@ -32,8 +33,20 @@ class NetEqTestFactory {
   void PrintCodecMap();
   std::unique_ptr<NetEqTest> InitializeTest(std::string input_filename,
                                             std::string output_filename);
+  // Creates a test which discards the output audio and reports to |callbacks|
+  // instead of printing statistics and writing plot scripts. The objects
+  // referenced by |callbacks| must outlive the returned test. This is what the
+  // batch simulator uses to run many tests side by side.
+  std::unique_ptr<NetEqTest> InitializeTest(std::string input_filename,
+                                            NetEqTest::Callbacks callbacks);
 
  private:
+  std::unique_ptr<NetEqTest> CreateTest(
+      const std::string& input_filename,
+      const std::string& output_filename,
+      absl::optional<NetEqTest::Callbacks> external_callbacks);
+
+
   std::unique_ptr<SsrcSwitchDetector> ssrc_switch_detector_;
   std::unique_ptr<NetEqStatsPlotter> stats_plotter_;
 };
@@ -64,6 +64,9 @@ class FineAudioBuffer {
                            int record_delay_ms);
 
  private:
+  // Delivers a 10ms chunk of recorded audio to the ADB.
+  void DeliverRecorded10ms(const int16_t* audio_10ms, int record_delay_ms);
+
   // Device buffer that works with 10ms chunks of data both for playout and
   // for recording. I.e., the WebRTC side will always be asked for audio to be
   // played out in 10ms chunks and recorded audio will be sent to WebRTC in
@@ -79,11 +82,15 @@ class FineAudioBuffer {
   // |audio_device_buffer|.
   const size_t playout_channels_;
   const size_t record_channels_;
-  // Storage for output samples from which a consumer can read audio buffers
-  // in any size using GetPlayoutData().
+  // Storage for the 10ms chunk of output samples that was only partly read by
+  // the last call to GetPlayoutData(). Complete 10ms chunks are written
+  // directly to the buffer of the consumer.
   rtc::BufferT<int16_t> playout_buffer_;
-  // Storage for input samples that are about to be delivered to the WebRTC
-  // ADB or remains from the last successful delivery of a 10ms audio buffer.
+  // Index of the first sample in |playout_buffer_| that has not been read.
+  size_t playout_read_index_ = 0;
+  // Storage for the input samples, less than 10ms, that remain from the last
+  // call to DeliverRecordedData(). Complete 10ms chunks are delivered to the
+  // ADB directly from the buffer of the producer.
   rtc::BufferT<int16_t> record_buffer_;
   // Contains latest delay estimate given to GetPlayoutData().
   int playout_delay_ms_ = 0;
@@ -0,0 +1,274 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/include/server_audio_device.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/audio_device/include/audio_device_default.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kFrameLengthUs = 10000;
+
+}  // namespace
+
+// Audio device whose capture and playout pulls are made by the clock thread of
+// a ServerAudioDeviceClock.
+class ServerAudioDevice
+    : public webrtc_impl::AudioDeviceModuleDefault<AudioDeviceModule> {
+ public:
+  ServerAudioDevice(rtc::scoped_refptr<ServerAudioDeviceClock> clock,
+                    std::unique_ptr<TestAudioDeviceModule::Capturer> capturer,
+                    std::unique_ptr<TestAudioDeviceModule::Renderer> renderer)
+      : clock_(std::move(clock)),
+        capturer_(std::move(capturer)),
+        renderer_(std::move(renderer)) {
+    RTC_DCHECK(clock_);
+    if (renderer_) {
+      playout_buffer_.resize(TestAudioDeviceModule::SamplesPerFrame(
+                                 renderer_->SamplingFrequency()) *
+                                 renderer_->NumChannels(),
+                             0);
+    }
+  }
+
+  ~ServerAudioDevice() override { Terminate(); }
+
+  int32_t Init() override {
+    {
+      rtc::CritScope cs(&lock_);
+      if (initialized_)
+        return 0;
+      initialized_ = true;
+    }
+    // The clock lock is taken before the device lock when processing, so the
+    // device lock must not be held here.
+    clock_->AddDevice(this);
+    return 0;
+  }
+
+  int32_t Terminate() override {
+    {
+      rtc::CritScope cs(&lock_);
+      if (!initialized_)
+        return 0;
+      initialized_ = false;
+      rendering_ = false;
+      capturing_ = false;
+    }
+    // Blocks while the clock thread is processing a tick, so no pull is in
+    // progress or will be made once this returns.
+    clock_->RemoveDevice(this);
+    return 0;
+  }
+
+  bool Initialized() const override {
+    rtc::CritScope cs(&lock_);
+    return initialized_;
+  }
+
+  int32_t RegisterAudioCallback(AudioTransport* callback) override {
+    rtc::CritScope cs(&lock_);
+    audio_callback_ = callback;
+    return 0;
+  }
+
+  int32_t StartPlayout() override {
+    rtc::CritScope cs(&lock_);
+    RTC_CHECK(renderer_);
+    rendering_ = true;
+    return 0;
+  }
+
+  int32_t StopPlayout() override {
+    rtc::CritScope cs(&lock_);
+    rendering_ = false;
+    return 0;
+  }
+
+  int32_t StartRecording() override {
+    rtc::CritScope cs(&lock_);
+    RTC_CHECK(capturer_);
+    capturing_ = true;
+    return 0;
+  }
+
+  int32_t StopRecording() override {
+    rtc::CritScope cs(&lock_);
+    capturing_ = false;
+    return 0;
+  }
+
+  bool Playing() const override {
+    rtc::CritScope cs(&lock_);
+    return rendering_;
+  }
+
+  bool Recording() const override {
+    rtc::CritScope cs(&lock_);
+    return capturing_;
+  }
+
+  // Called on the clock thread once per tick.
+  void ProcessFrame() {
+    rtc::CritScope cs(&lock_);
+    if (!audio_callback_)
+      return;
+    if (capturing_) {
+      capturing_ = capturer_->Capture(&recording_buffer_);
+      if (recording_buffer_.size() > 0) {
+        uint32_t new_mic_level = 0;
+        audio_callback_->RecordedDataIsAvailable(
+            recording_buffer_.data(),
+            recording_buffer_.size() / capturer_->NumChannels(),
+            2 * capturer_->NumChannels(), capturer_->NumChannels(),
+            capturer_->SamplingFrequency(), 0, 0, 0, false, new_mic_level);
+      }
+    }
+    if (rendering_) {
+      size_t samples_out = 0;
+      int64_t elapsed_time_ms = -1;
+      int64_t ntp_time_ms = -1;
+      const int sampling_frequency = renderer_->SamplingFrequency();
+      audio_callback_->NeedMorePlayData(
+          TestAudioDeviceModule::SamplesPerFrame(sampling_frequency),
+          2 * renderer_->NumChannels(), renderer_->NumChannels(),
+          sampling_frequency, playout_buffer_.data(), samples_out,
+          &elapsed_time_ms, &ntp_time_ms);
+      rendering_ = renderer_->Render(
+          rtc::ArrayView<const int16_t>(playout_buffer_.data(), samples_out));
+    }
+  }
+
+ private:
+  const rtc::scoped_refptr<ServerAudioDeviceClock> clock_;
+
+  rtc::CriticalSection lock_;
+  const std::unique_ptr<TestAudioDeviceModule::Capturer> capturer_
+      RTC_GUARDED_BY(lock_);
+  const std::unique_ptr<TestAudioDeviceModule::Renderer> renderer_
+      RTC_GUARDED_BY(lock_);
+  AudioTransport* audio_callback_ RTC_GUARDED_BY(lock_) = nullptr;
+  bool initialized_ RTC_GUARDED_BY(lock_) = false;
+  bool rendering_ RTC_GUARDED_BY(lock_) = false;
+  bool capturing_ RTC_GUARDED_BY(lock_) = false;
+  std::vector<int16_t> playout_buffer_ RTC_GUARDED_BY(lock_);
+  rtc::BufferT<int16_t> recording_buffer_ RTC_GUARDED_BY(lock_);
+};
+
+constexpr int ServerAudioDeviceClock::kMaxBacklogMs;
+
+rtc::scoped_refptr<ServerAudioDeviceClock> ServerAudioDeviceClock::Create() {
+  return new rtc::RefCountedObject<ServerAudioDeviceClock>();
+}
+
+rtc::scoped_refptr<AudioDeviceModule> ServerAudioDeviceClock::CreateAudioDevice(
+    rtc::scoped_refptr<ServerAudioDeviceClock> clock,
+    std::unique_ptr<TestAudioDeviceModule::Capturer> capturer,
+    std::unique_ptr<TestAudioDeviceModule::Renderer> renderer) {
+  return new rtc::RefCountedObject<ServerAudioDevice>(
+      std::move(clock), std::move(capturer), std::move(renderer));
+}
+
+ServerAudioDeviceClock::ServerAudioDeviceClock()
+    : stop_event_(/*manual_reset=*/true, /*initially_signaled=*/false),
+      thread_(&ServerAudioDeviceClock::Run,
+              this,
+              "ServerAudioDeviceClock",
+              rtc::kRealtimePriority) {
+  thread_.Start();
+}
+
+ServerAudioDeviceClock::~ServerAudioDeviceClock() {
+  stop_event_.Set();
+  thread_.Stop();
+  RTC_DCHECK(devices_.empty());
+}
+
+ServerAudioDeviceClock::Stats ServerAudioDeviceClock::GetStats() const {
+  rtc::CritScope cs(&lock_);
+  Stats stats = stats_;
+  stats.num_devices = static_cast<int>(devices_.size());
+  return stats;
+}
+
+void ServerAudioDeviceClock::AddDevice(ServerAudioDevice* device) {
+  rtc::CritScope cs(&lock_);
+  RTC_DCHECK(std::find(devices_.begin(), devices_.end(), device) ==
+             devices_.end());
+  devices_.push_back(device);
+}
+
+void ServerAudioDeviceClock::RemoveDevice(ServerAudioDevice* device) {
+  rtc::CritScope cs(&lock_);
+  auto it = std::find(devices_.begin(), devices_.end(), device);
+  RTC_DCHECK(it != devices_.end());
+  if (it != devices_.end())
+    devices_.erase(it);
+}
+
+void ServerAudioDeviceClock::Run(void* obj) {
+  static_cast<ServerAudioDeviceClock*>(obj)->ProcessAudio();
+}
+
+void ServerAudioDeviceClock::ProcessAudio() {
+  int64_t next_tick_us = rtc::TimeMicros() + kFrameLengthUs;
+  for (;;) {
+    const int64_t wait_us = next_tick_us - rtc::TimeMicros();
+    const int wait_ms = static_cast<int>(std::max<int64_t>(0, wait_us) /
+                                         rtc::kNumMicrosecsPerMillisec);
+    if (stop_event_.Wait(wait_ms))
+      return;
+    if (rtc::TimeMicros() < next_tick_us)
+      continue;
+
+    // Each tick is due at the end of its 10 ms frame.
+    ProcessTick(next_tick_us + kFrameLengthUs);
+    next_tick_us += kFrameLengthUs;
+
+    const int64_t backlog_us = rtc::TimeMicros() - next_tick_us;
+    if (backlog_us > kMaxBacklogMs * rtc::kNumMicrosecsPerMillisec) {
+      const int64_t skipped_ticks = backlog_us / kFrameLengthUs;
+      RTC_LOG(LS_WARNING) << "ServerAudioDeviceClock skipping "
+                          << skipped_ticks << " ticks";
+      next_tick_us += skipped_ticks * kFrameLengthUs;
+      rtc::CritScope cs(&lock_);
+      stats_.num_skipped_ticks += skipped_ticks;
+    }
+  }
+}
+
+void ServerAudioDeviceClock::ProcessTick(int64_t deadline_us) {
+  rtc::CritScope cs(&lock_);
+  const int64_t start_us = rtc::TimeMicros();
+  for (ServerAudioDevice* device : devices_)
+    device->ProcessFrame();
+  const int64_t end_us = rtc::TimeMicros();
+
+  ++stats_.num_ticks;
+  stats_.max_tick_duration_us =
+      std::max(stats_.max_tick_duration_us, end_us - start_us);
+  if (end_us > deadline_us) {
+    ++stats_.num_missed_deadlines;
+    stats_.max_lateness_us =
+        std::max(stats_.max_lateness_us, end_us - deadline_us);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MODULES_AUDIO_DEVICE_INCLUDE_SERVER_AUDIO_DEVICE_H_
+#define MODULES_AUDIO_DEVICE_INCLUDE_SERVER_AUDIO_DEVICE_H_
+
+#include <memory>
+#include <vector>
+
+#include "modules/audio_device/include/audio_device.h"
+#include "modules/audio_device/include/test_audio_device.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class ServerAudioDevice;
+
+// ServerAudioDeviceClock drives any number of headless audio devices from a
+// single high priority thread. Every 10 ms of virtual time it pulls one frame
+// of captured audio and one frame of playout audio for all started devices in
+// a single batch, instead of every device running its own timer thread. When
+// the thread falls behind, ticks are processed back to back until it has
+// caught up, so that each device still sees exactly 100 frames per second.
+class ServerAudioDeviceClock : public rtc::RefCountInterface {
+ public:
+  struct Stats {
+    // Number of devices currently attached to the clock.
+    int num_devices = 0;
+    // Number of 10 ms ticks processed.
+    int64_t num_ticks = 0;
+    // Ticks whose processing completed after the next tick was due.
+    int64_t num_missed_deadlines = 0;
+    // Ticks dropped because the clock fell more than kMaxBacklogMs behind.
+    int64_t num_skipped_ticks = 0;
+    // Longest time spent processing all devices for a single tick.
+    int64_t max_tick_duration_us = 0;
+    // Largest amount by which a tick completed after it was due.
+    int64_t max_lateness_us = 0;
+  };
+
+  // Maximum backlog that the clock catches up on by processing ticks back to
+  // back. Anything older is dropped, as audio that late is no longer useful.
+  static constexpr int kMaxBacklogMs = 100;
+
+  static rtc::scoped_refptr<ServerAudioDeviceClock> Create();
+
+  // Creates a device that is driven by |clock|. |capturer| and |renderer|
+  // have the same meaning as for TestAudioDeviceModule, but are only accessed
+  // on the clock thread. Either may be null if the device is never used in
+  // that direction.
+  static rtc::scoped_refptr<AudioDeviceModule> CreateAudioDevice(
+      rtc::scoped_refptr<ServerAudioDeviceClock> clock,
+      std::unique_ptr<TestAudioDeviceModule::Capturer> capturer,
+      std::unique_ptr<TestAudioDeviceModule::Renderer> renderer);
+
+  Stats GetStats() const;
+
+ protected:
+  ServerAudioDeviceClock();
+  ~ServerAudioDeviceClock() override;
+
+ private:
+  friend class ServerAudioDevice;
+
+  void AddDevice(ServerAudioDevice* device);
+  void RemoveDevice(ServerAudioDevice* device);
+
+  static void Run(void* obj);
+  void ProcessAudio();
+  void ProcessTick(int64_t deadline_us);
+
+  rtc::Event stop_event_;
+  rtc::PlatformThread thread_;
+
+  rtc::CriticalSection lock_;
+  std::vector<ServerAudioDevice*> devices_ RTC_GUARDED_BY(lock_);
+  Stats stats_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_DEVICE_INCLUDE_SERVER_AUDIO_DEVICE_H_
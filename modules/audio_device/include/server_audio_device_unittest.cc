@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "modules/audio_device/include/mock_audio_transport.h"
+#include "modules/audio_device/include/server_audio_device.h"
+#include "rtc_base/event.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::AtLeast;
+using ::testing::DoAll;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::SetArgReferee;
+
+constexpr int kSampleRate = 48000;
+constexpr int kNumFrames = 10;
+constexpr int kTimeoutMs = 5000;
+
+// Renders a fixed number of frames and then signals |done|.
+class CountingRenderer : public TestAudioDeviceModule::Renderer {
+ public:
+  explicit CountingRenderer(rtc::Event* done) : done_(done) {}
+
+  int SamplingFrequency() const override { return kSampleRate; }
+  int NumChannels() const override { return 1; }
+  bool Render(rtc::ArrayView<const int16_t> data) override {
+    if (++num_frames_ < kNumFrames)
+      return true;
+    done_->Set();
+    return false;
+  }
+
+ private:
+  rtc::Event* const done_;
+  int num_frames_ = 0;
+};
+
+TEST(ServerAudioDeviceTest, DrivesAllDevicesFromOneClock) {
+  rtc::scoped_refptr<ServerAudioDeviceClock> clock =
+      ServerAudioDeviceClock::Create();
+
+  const size_t kNumDevices = 3;
+  std::vector<std::unique_ptr<rtc::Event>> done;
+  std::vector<std::unique_ptr<test::MockAudioTransport>> transports;
+  std::vector<rtc::scoped_refptr<AudioDeviceModule>> devices;
+  for (size_t i = 0; i < kNumDevices; ++i) {
+    done.push_back(absl::make_unique<rtc::Event>(false, false));
+    transports.push_back(absl::make_unique<test::MockAudioTransport>());
+    EXPECT_CALL(*transports.back(),
+                NeedMorePlayData(kSampleRate / 100, 2, 1, kSampleRate, _, _,
+                                 _, _))
+        .Times(kNumFrames)
+        .WillRepeatedly(DoAll(SetArgReferee<5>(kSampleRate / 100), Return(0)));
+    devices.push_back(ServerAudioDeviceClock::CreateAudioDevice(
+        clock, nullptr, absl::make_unique<CountingRenderer>(done.back().get())));
+    devices.back()->RegisterAudioCallback(transports.back().get());
+    devices.back()->Init();
+    devices.back()->StartPlayout();
+  }
+  EXPECT_EQ(static_cast<int>(kNumDevices), clock->GetStats().num_devices);
+
+  for (size_t i = 0; i < kNumDevices; ++i) {
+    EXPECT_TRUE(done[i]->Wait(kTimeoutMs));
+    EXPECT_FALSE(devices[i]->Playing());
+  }
+  EXPECT_GE(clock->GetStats().num_ticks, kNumFrames);
+
+  devices.clear();
+  EXPECT_EQ(0, clock->GetStats().num_devices);
+}
+
+TEST(ServerAudioDeviceTest, StopsPullingAfterTerminate) {
+  rtc::scoped_refptr<ServerAudioDeviceClock> clock =
+      ServerAudioDeviceClock::Create();
+  rtc::Event pulled(false, false);
+  test::MockAudioTransport transport;
+  EXPECT_CALL(transport, RecordedDataIsAvailable(_, _, _, _, _, _, _, _, _, _))
+      .Times(AtLeast(1))
+      .WillRepeatedly(DoAll(Invoke([&pulled](const void*, size_t, size_t,
+                                             size_t, uint32_t, uint32_t,
+                                             int32_t, uint32_t, bool,
+                                             uint32_t&) { pulled.Set(); }),
+                            Return(0)));
+
+  rtc::scoped_refptr<AudioDeviceModule> device =
+      ServerAudioDeviceClock::CreateAudioDevice(
+          clock, TestAudioDeviceModule::CreatePulsedNoiseCapturer(
+                     1000, kSampleRate),
+          nullptr);
+  device->RegisterAudioCallback(&transport);
+  device->Init();
+  device->StartRecording();
+  EXPECT_TRUE(pulled.Wait(kTimeoutMs));
+
+  device->Terminate();
+  EXPECT_FALSE(device->Recording());
+  EXPECT_EQ(0, clock->GetStats().num_devices);
+  pulled.Reset();
+  ::testing::Mock::VerifyAndClearExpectations(&transport);
+  EXPECT_CALL(transport, RecordedDataIsAvailable(_, _, _, _, _, _, _, _, _, _))
+      .Times(0);
+  EXPECT_FALSE(pulled.Wait(50));
+}
+
+}  // namespace
+}  // namespace webrtc
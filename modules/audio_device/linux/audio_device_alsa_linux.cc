@@ -12,8 +12,10 @@
 
 #include "modules/audio_device/audio_device_config.h"
 #include "modules/audio_device/linux/audio_device_alsa_linux.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/system/arch.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/sleep.h"
 
 WebRTCAlsaSymbolTable* GetAlsaSymbolTable() {
@@ -60,6 +62,28 @@ static const unsigned int ALSA_CAPTURE_FREQ = 48000;
 static const unsigned int ALSA_CAPTURE_CH = 2;
 static const unsigned int ALSA_CAPTURE_LATENCY = 40 * 1000;  // in us
 static const unsigned int ALSA_CAPTURE_WAIT_TIMEOUT = 5;     // in ms
+// Number of periods in the device ring buffer in mmap mode.
+static const unsigned int ALSA_MMAP_PERIODS_PER_BUFFER = 3;
+
+namespace {
+
+struct MmapConfig {
+  bool enabled = false;
+  uint32_t period_ms = 0;
+};
+
+MmapConfig GetMmapConfig() {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialConstrained<int> period_ms("period_ms", 20, 5, 100);
+  ParseFieldTrial({&enabled, &period_ms},
+                  field_trial::FindFullName("WebRTC-Audio-AlsaMmap"));
+  MmapConfig config;
+  config.enabled = enabled.Get();
+  config.period_ms = period_ms.Get();
+  return config;
+}
+
+}  // namespace
 
 #define FUNC_GET_NUM_OF_DEVICE 0
 #define FUNC_GET_DEVICE_NAME 1
@@ -96,6 +120,9 @@ AudioDeviceLinuxALSA::AudioDeviceLinuxALSA()
       _playIsInitialized(false),
       _recordingDelay(0),
       _playoutDelay(0) {
+  const MmapConfig mmap_config = GetMmapConfig();
+  _useMmap = mmap_config.enabled;
+  _mmapPeriodMs = mmap_config.period_ms;
   memset(_oldKeyState, 0, sizeof(_oldKeyState));
   RTC_LOG(LS_INFO) << __FUNCTION__ << " created";
 }
@@ -804,20 +831,8 @@ int32_t AudioDeviceLinuxALSA::InitPlayout() {
   }
 
   _playoutFramesIn10MS = _playoutFreq / 100;
-  if ((errVal = LATE(snd_pcm_set_params)(
-           _handlePlayout,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-           SND_PCM_FORMAT_S16_BE,
-#else
-           SND_PCM_FORMAT_S16_LE,                             // format
-#endif
-           SND_PCM_ACCESS_RW_INTERLEAVED,  // access
-           _playChannels,                  // channels
-           _playoutFreq,                   // rate
-           1,                              // soft_resample
-           ALSA_PLAYOUT_LATENCY  // 40*1000 //latency required overall latency
-                                 // in us
-           )) < 0) {             /* 0.5sec */
+  if ((errVal = SetPcmParams(_handlePlayout, _playChannels, _playoutFreq,
+                             ALSA_PLAYOUT_LATENCY)) < 0) {
     _playoutFramesIn10MS = 0;
     RTC_LOG(LS_ERROR) << "unable to set playback device: "
                       << LATE(snd_strerror)(errVal) << " (" << errVal << ")";
@@ -927,38 +942,16 @@ int32_t AudioDeviceLinuxALSA::InitRecording() {
   }
 
   _recordingFramesIn10MS = _recordingFreq / 100;
-  if ((errVal =
-           LATE(snd_pcm_set_params)(_handleRecord,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-                                    SND_PCM_FORMAT_S16_BE,  // format
-#else
-                                    SND_PCM_FORMAT_S16_LE,    // format
-#endif
-                                    SND_PCM_ACCESS_RW_INTERLEAVED,  // access
-                                    _recChannels,                   // channels
-                                    _recordingFreq,                 // rate
-                                    1,                    // soft_resample
-                                    ALSA_CAPTURE_LATENCY  // latency in us
-                                    )) < 0) {
+  if ((errVal = SetPcmParams(_handleRecord, _recChannels, _recordingFreq,
+                             ALSA_CAPTURE_LATENCY)) < 0) {
     // Fall back to another mode then.
     if (_recChannels == 1)
       _recChannels = 2;
     else
       _recChannels = 1;
 
-    if ((errVal =
-             LATE(snd_pcm_set_params)(_handleRecord,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-                                      SND_PCM_FORMAT_S16_BE,  // format
-#else
-                                      SND_PCM_FORMAT_S16_LE,  // format
-#endif
-                                      SND_PCM_ACCESS_RW_INTERLEAVED,  // access
-                                      _recChannels,         // channels
-                                      _recordingFreq,       // rate
-                                      1,                    // soft_resample
-                                      ALSA_CAPTURE_LATENCY  // latency in us
-                                      )) < 0) {
+    if ((errVal = SetPcmParams(_handleRecord, _recChannels, _recordingFreq,
+                               ALSA_CAPTURE_LATENCY)) < 0) {
       _recordingFramesIn10MS = 0;
       RTC_LOG(LS_ERROR) << "unable to set record settings: "
                         << LATE(snd_strerror)(errVal) << " (" << errVal << ")";
@@ -1025,6 +1018,10 @@ int32_t AudioDeviceLinuxALSA::StartRecording() {
     _recording = false;
     return -1;
   }
+  if (_useMmap) {
+    _recordingFineBuffer.reset(new FineAudioBuffer(_ptrAudioBuffer));
+  }
+
   // RECORDING
   _ptrThreadRec.reset(new rtc::PlatformThread(
       RecThreadFunc, this, "webrtc_audio_module_capture_thread"));
@@ -1080,6 +1077,7 @@ int32_t AudioDeviceLinuxALSA::StopRecording() {
 
   rtc::CritScope lock(&_critSect);
   _recordingFramesLeft = 0;
+  _recordingFineBuffer.reset();
   if (_recordingBuffer) {
     delete[] _recordingBuffer;
     _recordingBuffer = NULL;
@@ -1143,6 +1141,10 @@ int32_t AudioDeviceLinuxALSA::StartPlayout() {
     return -1;
   }
 
+  if (_useMmap) {
+    _playoutFineBuffer.reset(new FineAudioBuffer(_ptrAudioBuffer));
+  }
+
   // PLAYOUT
   _ptrThreadPlay.reset(new rtc::PlatformThread(
       PlayThreadFunc, this, "webrtc_audio_module_play_thread"));
@@ -1186,6 +1188,7 @@ int32_t AudioDeviceLinuxALSA::StopPlayout() {
   _playoutFramesLeft = 0;
   delete[] _playoutBuffer;
   _playoutBuffer = NULL;
+  _playoutFineBuffer.reset();
 
   // stop and close pcm playout device
   int errVal = LATE(snd_pcm_drop)(_handlePlayout);
@@ -1374,6 +1377,64 @@ int32_t AudioDeviceLinuxALSA::OutputSanityCheckAfterUnlockedPeriod() const {
   return 0;
 }
 
+int AudioDeviceLinuxALSA::SetPcmParams(snd_pcm_t* handle,
+                                       uint8_t channels,
+                                       uint32_t freq,
+                                       unsigned int latency_us) {
+#if defined(WEBRTC_ARCH_BIG_ENDIAN)
+  const snd_pcm_format_t format = SND_PCM_FORMAT_S16_BE;
+#else
+  const snd_pcm_format_t format = SND_PCM_FORMAT_S16_LE;
+#endif
+  if (!_useMmap) {
+    return LATE(snd_pcm_set_params)(handle, format,
+                                    SND_PCM_ACCESS_RW_INTERLEAVED, channels,
+                                    freq,
+                                    1,  // soft_resample
+                                    latency_us);
+  }
+
+  snd_pcm_hw_params_t* params = NULL;
+  int err = LATE(snd_pcm_hw_params_malloc)(&params);
+  if (err < 0) {
+    return err;
+  }
+  unsigned int rate = freq;
+  snd_pcm_uframes_t period_size = freq * _mmapPeriodMs / 1000;
+  snd_pcm_uframes_t buffer_size = period_size * ALSA_MMAP_PERIODS_PER_BUFFER;
+  err = LATE(snd_pcm_hw_params_any)(handle, params);
+  if (err >= 0) {
+    err = LATE(snd_pcm_hw_params_set_access)(handle, params,
+                                             SND_PCM_ACCESS_MMAP_INTERLEAVED);
+  }
+  if (err >= 0) {
+    err = LATE(snd_pcm_hw_params_set_format)(handle, params, format);
+  }
+  if (err >= 0) {
+    err = LATE(snd_pcm_hw_params_set_channels)(handle, params, channels);
+  }
+  if (err >= 0) {
+    err = LATE(snd_pcm_hw_params_set_rate_near)(handle, params, &rate, NULL);
+  }
+  if (err >= 0 && rate != freq) {
+    // The AudioDeviceBuffer has already been told about |freq|.
+    err = -EINVAL;
+  }
+  if (err >= 0) {
+    err = LATE(snd_pcm_hw_params_set_period_size_near)(handle, params,
+                                                       &period_size, NULL);
+  }
+  if (err >= 0) {
+    err = LATE(snd_pcm_hw_params_set_buffer_size_near)(handle, params,
+                                                       &buffer_size);
+  }
+  if (err >= 0) {
+    err = LATE(snd_pcm_hw_params)(handle, params);
+  }
+  LATE(snd_pcm_hw_params_free)(params);
+  return err;
+}
+
 int32_t AudioDeviceLinuxALSA::ErrorRecovery(int32_t error,
                                             snd_pcm_t* deviceHandle) {
   int st = LATE(snd_pcm_state)(deviceHandle);
@@ -1468,6 +1529,9 @@ bool AudioDeviceLinuxALSA::PlayThreadProcess() {
   if (!_playing)
     return false;
 
+  if (_useMmap)
+    return PlayThreadProcessMmap();
+
   int err;
   snd_pcm_sframes_t frames;
   snd_pcm_sframes_t avail_frames;
@@ -1530,6 +1594,9 @@ bool AudioDeviceLinuxALSA::RecThreadProcess() {
   if (!_recording)
     return false;
 
+  if (_useMmap)
+    return RecThreadProcessMmap();
+
   int err;
   snd_pcm_sframes_t frames;
   snd_pcm_sframes_t avail_frames;
@@ -1627,6 +1694,139 @@ bool AudioDeviceLinuxALSA::RecThreadProcess() {
   return true;
 }
 
+bool AudioDeviceLinuxALSA::PlayThreadProcessMmap() {
+  Lock();
+  snd_pcm_sframes_t avail_frames = LATE(snd_pcm_avail_update)(_handlePlayout);
+  if (avail_frames < 0) {
+    RTC_LOG(LS_ERROR) << "playout snd_pcm_avail_update error: "
+                      << LATE(snd_strerror)(avail_frames);
+    ErrorRecovery(avail_frames, _handlePlayout);
+    UnLock();
+    return true;
+  }
+  if (static_cast<snd_pcm_uframes_t>(avail_frames) <
+      _playoutPeriodSizeInFrame) {
+    // The ring buffer is full. A prepared stream is only started once it has
+    // been filled, so that it begins with the full buffer as headroom.
+    if (LATE(snd_pcm_state)(_handlePlayout) == SND_PCM_STATE_PREPARED) {
+      int err = LATE(snd_pcm_start)(_handlePlayout);
+      if (err < 0) {
+        RTC_LOG(LS_ERROR) << "playout snd_pcm_start error: "
+                          << LATE(snd_strerror)(err);
+        ErrorRecovery(err, _handlePlayout);
+      }
+      UnLock();
+      return true;
+    }
+    UnLock();
+    LATE(snd_pcm_wait)(_handlePlayout, _mmapPeriodMs);
+    return true;
+  }
+
+  const snd_pcm_channel_area_t* areas = NULL;
+  snd_pcm_uframes_t offset = 0;
+  snd_pcm_uframes_t frames = _playoutPeriodSizeInFrame;
+  int err = LATE(snd_pcm_mmap_begin)(_handlePlayout, &areas, &offset, &frames);
+  if (err < 0) {
+    RTC_LOG(LS_ERROR) << "playout snd_pcm_mmap_begin error: "
+                      << LATE(snd_strerror)(err);
+    ErrorRecovery(err, _handlePlayout);
+    UnLock();
+    return true;
+  }
+  // With interleaved access all channels share the first area.
+  int16_t* data = reinterpret_cast<int16_t*>(
+      static_cast<uint8_t*>(areas[0].addr) +
+      (areas[0].first + offset * areas[0].step) / 8);
+
+  if (LATE(snd_pcm_delay)(_handlePlayout, &_playoutDelay) < 0) {
+    _playoutDelay = 0;
+  }
+  const int playout_delay_ms = _playoutDelay * 1000 / _playoutFreq;
+
+  // The device thread is only stopped, and the device closed, after this
+  // function has returned, so the mapped area stays valid while unlocked.
+  UnLock();
+  _playoutFineBuffer->GetPlayoutData(
+      rtc::ArrayView<int16_t>(data, frames * _playChannels), playout_delay_ms);
+  Lock();
+
+  snd_pcm_sframes_t committed =
+      LATE(snd_pcm_mmap_commit)(_handlePlayout, offset, frames);
+  if (committed < 0 || static_cast<snd_pcm_uframes_t>(committed) != frames) {
+    RTC_LOG(LS_ERROR) << "playout snd_pcm_mmap_commit returned " << committed
+                      << " of " << frames << " frames";
+    ErrorRecovery(committed >= 0 ? -EPIPE : committed, _handlePlayout);
+  }
+  UnLock();
+  return true;
+}
+
+bool AudioDeviceLinuxALSA::RecThreadProcessMmap() {
+  Lock();
+  snd_pcm_sframes_t avail_frames = LATE(snd_pcm_avail_update)(_handleRecord);
+  if (avail_frames < 0) {
+    RTC_LOG(LS_ERROR) << "capture snd_pcm_avail_update error: "
+                      << LATE(snd_strerror)(avail_frames);
+    ErrorRecovery(avail_frames, _handleRecord);
+    UnLock();
+    return true;
+  }
+  if (static_cast<snd_pcm_uframes_t>(avail_frames) <
+      _recordingPeriodSizeInFrame) {
+    UnLock();
+    LATE(snd_pcm_wait)(_handleRecord, _mmapPeriodMs);
+    return true;
+  }
+
+  const snd_pcm_channel_area_t* areas = NULL;
+  snd_pcm_uframes_t offset = 0;
+  snd_pcm_uframes_t frames = _recordingPeriodSizeInFrame;
+  int err = LATE(snd_pcm_mmap_begin)(_handleRecord, &areas, &offset, &frames);
+  if (err < 0) {
+    RTC_LOG(LS_ERROR) << "capture snd_pcm_mmap_begin error: "
+                      << LATE(snd_strerror)(err);
+    ErrorRecovery(err, _handleRecord);
+    UnLock();
+    return true;
+  }
+  const int16_t* data = reinterpret_cast<const int16_t*>(
+      static_cast<const uint8_t*>(areas[0].addr) +
+      (areas[0].first + offset * areas[0].step) / 8);
+
+  _playoutDelay = 0;
+  _recordingDelay = 0;
+  if (_handlePlayout &&
+      LATE(snd_pcm_delay)(_handlePlayout, &_playoutDelay) < 0) {
+    _playoutDelay = 0;
+  }
+  if (LATE(snd_pcm_delay)(_handleRecord, &_recordingDelay) < 0) {
+    _recordingDelay = 0;
+  }
+  // The FineAudioBuffer only knows the playout delay of its own playout side,
+  // so the playout delay of the other direction is folded into the record
+  // delay. The AudioDeviceBuffer only uses their sum.
+  const int total_delay_ms = _playoutDelay * 1000 / _playoutFreq +
+                             _recordingDelay * 1000 / _recordingFreq;
+  _ptrAudioBuffer->SetTypingStatus(KeyPressed());
+
+  UnLock();
+  _recordingFineBuffer->DeliverRecordedData(
+      rtc::ArrayView<const int16_t>(data, frames * _recChannels),
+      total_delay_ms);
+  Lock();
+
+  snd_pcm_sframes_t committed =
+      LATE(snd_pcm_mmap_commit)(_handleRecord, offset, frames);
+  if (committed < 0 || static_cast<snd_pcm_uframes_t>(committed) != frames) {
+    RTC_LOG(LS_ERROR) << "capture snd_pcm_mmap_commit returned " << committed
+                      << " of " << frames << " frames";
+    ErrorRecovery(committed >= 0 ? -EPIPE : committed, _handleRecord);
+  }
+  UnLock();
+  return true;
+}
+
 bool AudioDeviceLinuxALSA::KeyPressed() const {
 #if defined(WEBRTC_USE_X11)
   char szKey[32];
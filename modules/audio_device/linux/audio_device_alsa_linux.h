@@ -14,6 +14,7 @@
 #include <memory>
 
 #include "modules/audio_device/audio_device_generic.h"
+#include "modules/audio_device/fine_audio_buffer.h"
 #include "modules/audio_device/linux/audio_mixer_manager_alsa_linux.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/platform_thread.h"
@@ -141,6 +142,16 @@ class AudioDeviceLinuxALSA : public AudioDeviceGeneric {
   static bool PlayThreadFunc(void*);
   bool RecThreadProcess();
   bool PlayThreadProcess();
+  bool RecThreadProcessMmap();
+  bool PlayThreadProcessMmap();
+
+  // Configures |handle| for 16-bit interleaved audio. |latency_us| is only
+  // used for read/write access; in mmap mode the buffer holds a fixed number
+  // of |_mmapPeriodMs| periods. Returns a negative ALSA error code on failure.
+  int SetPcmParams(snd_pcm_t* handle,
+                   uint8_t channels,
+                   uint32_t freq,
+                   unsigned int latency_us);
 
   AudioDeviceBuffer* _ptrAudioBuffer;
 
@@ -190,6 +201,15 @@ class AudioDeviceLinuxALSA : public AudioDeviceGeneric {
   snd_pcm_sframes_t _recordingDelay;
   snd_pcm_sframes_t _playoutDelay;
 
+  // Set by the WebRTC-Audio-AlsaMmap field trial. In mmap mode audio is read
+  // from and written to the device ring buffer directly, one period of
+  // |_mmapPeriodMs| at a time, and the FineAudioBuffers convert between the
+  // period size and the 10 ms chunks of the AudioDeviceBuffer.
+  bool _useMmap;
+  uint32_t _mmapPeriodMs;
+  std::unique_ptr<FineAudioBuffer> _recordingFineBuffer;
+  std::unique_ptr<FineAudioBuffer> _playoutFineBuffer;
+
   char _oldKeyState[32];
 #if defined(WEBRTC_USE_X11)
   Display* _XDisplay;
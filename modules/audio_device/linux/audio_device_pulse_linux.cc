@@ -10,10 +10,14 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include "modules/audio_device/linux/audio_device_pulse_linux.h"
 #include "modules/audio_device/linux/latebindingsymboltable_linux.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 
 WebRTCPulseSymbolTable* GetPulseSymbolTable() {
   static WebRTCPulseSymbolTable* pulse_symbol_table =
@@ -29,6 +33,25 @@ WebRTCPulseSymbolTable* GetPulseSymbolTable() {
               GetPulseSymbolTable(), sym)
 
 namespace webrtc {
+namespace {
+
+struct ZeroCopyConfig {
+  bool enabled = false;
+  uint32_t period_ms = 0;
+};
+
+ZeroCopyConfig GetZeroCopyConfig() {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialConstrained<int> period_ms("period_ms", 20, 10, 100);
+  ParseFieldTrial({&enabled, &period_ms},
+                  field_trial::FindFullName("WebRTC-Audio-PulseZeroCopy"));
+  ZeroCopyConfig config;
+  config.enabled = enabled.Get();
+  config.period_ms = period_ms.Get();
+  return config;
+}
+
+}  // namespace
 
 AudioDeviceLinuxPulse::AudioDeviceLinuxPulse()
     : _ptrAudioBuffer(NULL),
@@ -85,6 +108,10 @@ AudioDeviceLinuxPulse::AudioDeviceLinuxPulse()
   memset(&_playBufferAttr, 0, sizeof(_playBufferAttr));
   memset(&_recBufferAttr, 0, sizeof(_recBufferAttr));
   memset(_oldKeyState, 0, sizeof(_oldKeyState));
+
+  const ZeroCopyConfig zero_copy_config = GetZeroCopyConfig();
+  _zeroCopyPlayout = zero_copy_config.enabled;
+  _playoutPeriodMs = zero_copy_config.period_ms;
 }
 
 AudioDeviceLinuxPulse::~AudioDeviceLinuxPulse() {
@@ -920,6 +947,15 @@ int32_t AudioDeviceLinuxPulse::InitPlayout() {
     _playBufferAttr.tlength = latency;    // target fill level of play buffer
     // minimum free num bytes before server request more data
     _playBufferAttr.minreq = latency / WEBRTC_PA_PLAYBACK_REQUEST_FACTOR;
+    if (_zeroCopyPlayout) {
+      // Let the server ask for whole periods, with two of them buffered.
+      const uint32_t period = bytesPerSec * _playoutPeriodMs /
+                              WEBRTC_PA_MSECS_PER_SEC;
+      _playBufferAttr.minreq = std::max(_playBufferAttr.minreq, period);
+      latency = std::max(latency, 2 * _playBufferAttr.minreq);
+      _playBufferAttr.maxlength = latency;
+      _playBufferAttr.tlength = latency;
+    }
     // prebuffer tlength before starting playout
     _playBufferAttr.prebuf = _playBufferAttr.tlength - _playBufferAttr.minreq;
 
@@ -930,6 +966,9 @@ int32_t AudioDeviceLinuxPulse::InitPlayout() {
   _playbackBufferSize = sample_rate_hz_ / 100 * 2 * _playChannels;
   _playbackBufferUnused = _playbackBufferSize;
   _playBuffer = new int8_t[_playbackBufferSize];
+  if (_zeroCopyPlayout && _ptrAudioBuffer) {
+    _playoutFineBuffer.reset(new FineAudioBuffer(_ptrAudioBuffer));
+  }
 
   // Enable underflow callback
   LATE(pa_stream_set_underflow_callback)
@@ -1248,6 +1287,7 @@ int32_t AudioDeviceLinuxPulse::StopPlayout() {
     delete[] _playBuffer;
     _playBuffer = NULL;
   }
+  _playoutFineBuffer.reset();
 
   return 0;
 }
@@ -2077,6 +2117,18 @@ bool AudioDeviceLinuxPulse::PlayThreadProcess() {
       _sndCardPlayDelay = (uint32_t)(LatencyUsecs(_playStream) / 1000);
     }
 
+    if (_playoutFineBuffer) {
+      WriteZeroCopyPlayoutData();
+      if (!_playing) {
+        return true;
+      }
+      _tempBufferSpace = 0;
+      PaLock();
+      EnableWriteCallback();
+      PaUnLock();
+      return true;
+    }
+
     if (_playbackBufferUnused < _playbackBufferSize) {
       size_t write = _playbackBufferSize - _playbackBufferUnused;
       if (_tempBufferSpace < write) {
@@ -2153,6 +2205,53 @@ bool AudioDeviceLinuxPulse::PlayThreadProcess() {
   return true;
 }
 
+void AudioDeviceLinuxPulse::WriteZeroCopyPlayoutData() {
+  const size_t frame_size = sizeof(int16_t) * _playChannels;
+  size_t write = _tempBufferSpace - _tempBufferSpace % frame_size;
+  if (write == 0) {
+    return;
+  }
+
+  void* data = NULL;
+  PaLock();
+  int err = LATE(pa_stream_begin_write)(_playStream, &data, &write);
+  PaUnLock();
+  if (err != PA_OK || !data) {
+    RTC_LOG(LS_ERROR) << "pa_stream_begin_write failed, err="
+                      << LATE(pa_context_errno)(_paContext);
+    return;
+  }
+  // The server may hand out less than was asked for.
+  write -= write % frame_size;
+
+  // Ensure that the ADB callback is executed without taking the audio-thread
+  // lock. The memory block belongs to |_playStream| and is released with it if
+  // playout is stopped meanwhile.
+  UnLock();
+  _playoutFineBuffer->GetPlayoutData(
+      rtc::ArrayView<int16_t>(static_cast<int16_t*>(data),
+                              write / sizeof(int16_t)),
+      _sndCardPlayDelay);
+  Lock();
+
+  // We have been unlocked - check the flag again.
+  if (!_playing) {
+    return;
+  }
+
+  PaLock();
+  if (LATE(pa_stream_write)(_playStream, data, write, NULL, (int64_t)0,
+                            PA_SEEK_RELATIVE) != PA_OK) {
+    _writeErrors++;
+    if (_writeErrors > 10) {
+      RTC_LOG(LS_ERROR) << "Playout error: _writeErrors=" << _writeErrors
+                        << ", error=" << LATE(pa_context_errno)(_paContext);
+      _writeErrors = 0;
+    }
+  }
+  PaUnLock();
+}
+
 bool AudioDeviceLinuxPulse::RecThreadProcess() {
   if (!_timeEventRec.Wait(1000)) {
     return true;
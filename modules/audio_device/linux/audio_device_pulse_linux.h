@@ -15,6 +15,7 @@
 
 #include "modules/audio_device/audio_device_buffer.h"
 #include "modules/audio_device/audio_device_generic.h"
+#include "modules/audio_device/fine_audio_buffer.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "modules/audio_device/include/audio_device_defines.h"
 #include "modules/audio_device/linux/audio_mixer_manager_pulse_linux.h"
@@ -258,6 +259,8 @@ class AudioDeviceLinuxPulse : public AudioDeviceGeneric {
   static bool PlayThreadFunc(void*);
   bool RecThreadProcess();
   bool PlayThreadProcess();
+  // Renders directly into a buffer obtained from pa_stream_begin_write().
+  void WriteZeroCopyPlayoutData() RTC_EXCLUSIVE_LOCKS_REQUIRED(_critSect);
 
   AudioDeviceBuffer* _ptrAudioBuffer;
 
@@ -325,6 +328,15 @@ class AudioDeviceLinuxPulse : public AudioDeviceGeneric {
   int32_t _configuredLatencyPlay;
   int32_t _configuredLatencyRec;
 
+  // Set by the WebRTC-Audio-PulseZeroCopy field trial. Playout audio is then
+  // written into server memory obtained from pa_stream_begin_write() instead
+  // of being staged in |_playBuffer|, and the server requests data in
+  // |_playoutPeriodMs| periods that |_playoutFineBuffer| splits into the 10 ms
+  // chunks of the AudioDeviceBuffer.
+  bool _zeroCopyPlayout;
+  uint32_t _playoutPeriodMs;
+  std::unique_ptr<FineAudioBuffer> _playoutFineBuffer;
+
   // PulseAudio
   uint16_t _paDeviceIndex;
   bool _paStateChanged;
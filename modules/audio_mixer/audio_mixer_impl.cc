@@ -21,10 +21,15 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/refcountedobject.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
 
+// Received audio levels, in -dBov, of this and above are treated as silence,
+// which never resumes a paused source.
+constexpr int kSilentAudioLevel = 70;
+
 struct SourceFrame {
   SourceFrame(AudioMixerImpl::SourceStatus* source_status,
               AudioFrame* audio_frame,
@@ -99,7 +104,10 @@ AudioMixerImpl::AudioMixerImpl(
       output_frequency_(0),
       sample_size_(0),
       audio_source_list_(),
-      frame_combiner_(use_limiter) {}
+      frame_combiner_(use_limiter),
+      use_limiter_(use_limiter),
+      pause_unmixed_sources_(
+          field_trial::IsEnabled("WebRTC-Audio-PauseUnmixedSources")) {}
 
 AudioMixerImpl::~AudioMixerImpl() {}
 
@@ -135,6 +143,45 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
   return;
 }
 
+void AudioMixerImpl::MixMinusOne(
+    size_t number_of_channels,
+    rtc::ArrayView<Source* const> sources,
+    rtc::ArrayView<AudioFrame* const> minus_one_frames,
+    AudioFrame* audio_frame_for_mixing) {
+  RTC_DCHECK(number_of_channels == 1 || number_of_channels == 2);
+  RTC_DCHECK_EQ(sources.size(), minus_one_frames.size());
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+
+  CalculateOutputFrequency();
+
+  rtc::CritScope lock(&crit_);
+  const size_t number_of_streams = audio_source_list_.size();
+  const AudioFrameList mix_list = GetAudioFromSources();
+  frame_combiner_.Combine(mix_list, number_of_channels, OutputFrequency(),
+                          number_of_streams, audio_frame_for_mixing);
+
+  for (size_t i = 0; i < sources.size(); ++i) {
+    RTC_DCHECK(minus_one_frames[i]);
+    const auto iter = FindSourceInList(sources[i], &audio_source_list_);
+    RTC_DCHECK(iter != audio_source_list_.end())
+        << "Source not present in mixer";
+    SourceStatus* const source_status =
+        iter != audio_source_list_.end() ? iter->get() : nullptr;
+    if (!source_status ||
+        std::find(mix_list.begin(), mix_list.end(),
+                  &source_status->audio_frame) == mix_list.end()) {
+      minus_one_frames[i]->CopyFrom(*audio_frame_for_mixing);
+      continue;
+    }
+    if (!source_status->minus_one_combiner) {
+      source_status->minus_one_combiner.reset(new FrameCombiner(use_limiter_));
+    }
+    source_status->minus_one_combiner->CombineExcluding(
+        frame_combiner_, mix_list, &source_status->audio_frame,
+        minus_one_frames[i]);
+  }
+}
+
 void AudioMixerImpl::CalculateOutputFrequency() {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
   rtc::CritScope lock(&crit_);
@@ -171,6 +218,8 @@ void AudioMixerImpl::RemoveSource(Source* audio_source) {
   rtc::CritScope lock(&crit_);
   const auto iter = FindSourceInList(audio_source, &audio_source_list_);
   RTC_DCHECK(iter != audio_source_list_.end()) << "Source not present in mixer";
+  if (!(*iter)->audio_needed)
+    audio_source->SetAudioNeeded(true);
   audio_source_list_.erase(iter);
 }
 
@@ -179,9 +228,15 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   AudioFrameList result;
   std::vector<SourceFrame> audio_source_mixing_data_list;
   std::vector<SourceFrame> ramp_list;
+  std::vector<SourceStatus*> paused_sources;
 
   // Get audio from the audio sources and put it in the SourceFrame vector.
   for (auto& source_and_status : audio_source_list_) {
+    if (!source_and_status->audio_needed) {
+      source_and_status->is_mixed = false;
+      paused_sources.push_back(source_and_status.get());
+      continue;
+    }
     const auto audio_frame_info =
         source_and_status->audio_source->GetAudioFrameWithInfo(
             OutputFrequency(), &source_and_status->audio_frame);
@@ -195,9 +250,14 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
         audio_frame_info == Source::AudioFrameInfo::kMuted);
   }
 
-  // Sort frames by sorting function.
-  std::sort(audio_source_mixing_data_list.begin(),
-            audio_source_mixing_data_list.end(), ShouldMixBefore);
+  // Only the first kMaximumAmountOfMixedAudioSources frames have to be in
+  // order, which saves most of the sorting for a large number of sources.
+  const size_t number_to_sort =
+      std::min(audio_source_mixing_data_list.size(),
+               static_cast<size_t>(kMaximumAmountOfMixedAudioSources));
+  std::partial_sort(audio_source_mixing_data_list.begin(),
+                    audio_source_mixing_data_list.begin() + number_to_sort,
+                    audio_source_mixing_data_list.end(), ShouldMixBefore);
 
   int max_audio_frame_counter = kMaximumAmountOfMixedAudioSources;
 
@@ -220,9 +280,62 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
     p.source_status->is_mixed = is_mixed;
   }
   RampAndUpdateGain(ramp_list);
+  if (pause_unmixed_sources_)
+    UpdatePausedSources(paused_sources);
   return result;
 }
 
+void AudioMixerImpl::UpdatePausedSources(
+    const std::vector<SourceStatus*>& paused_sources) {
+  int num_mixed = 0;
+  // Sources that don't report their received audio level count as loudest.
+  int quietest_mixed_level = 0;
+  for (auto& source_status : audio_source_list_) {
+    if (source_status->is_mixed) {
+      ++num_mixed;
+      source_status->rounds_not_mixed = 0;
+      quietest_mixed_level = std::max(
+          quietest_mixed_level,
+          source_status->audio_source->ReceivedAudioLevel().value_or(0));
+      continue;
+    }
+    if (source_status->rounds_not_mixed < kRoundsNotMixedBeforePause)
+      ++source_status->rounds_not_mixed;
+    if (source_status->audio_needed &&
+        source_status->rounds_not_mixed == kRoundsNotMixedBeforePause &&
+        source_status->audio_source->ReceivedAudioLevel()) {
+      source_status->audio_needed = false;
+      source_status->audio_source->SetAudioNeeded(false);
+    }
+  }
+
+  const auto resume = [](SourceStatus* source_status) {
+    source_status->audio_needed = true;
+    source_status->rounds_not_mixed = 0;
+    source_status->audio_source->SetAudioNeeded(true);
+  };
+  // Sources that stopped reporting a level are resumed at once. Of the others,
+  // at most one is resumed per round, which limits the decoders started at
+  // the same time.
+  SourceStatus* loudest_paused_source = nullptr;
+  int loudest_paused_level = kSilentAudioLevel;
+  for (SourceStatus* source_status : paused_sources) {
+    const absl::optional<int> level =
+        source_status->audio_source->ReceivedAudioLevel();
+    if (!level) {
+      resume(source_status);
+    } else if (*level < loudest_paused_level) {
+      loudest_paused_source = source_status;
+      loudest_paused_level = *level;
+    }
+  }
+  if (loudest_paused_source &&
+      (num_mixed < kMaximumAmountOfMixedAudioSources ||
+       loudest_paused_level < quietest_mixed_level)) {
+    resume(loudest_paused_source);
+  }
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
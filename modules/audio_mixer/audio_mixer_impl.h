@@ -15,6 +15,7 @@
 #include <memory>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/audio/audio_frame.h"
 #include "api/audio/audio_mixer.h"
 #include "modules/audio_mixer/frame_combiner.h"
@@ -38,8 +39,17 @@ class AudioMixerImpl : public AudioMixer {
     bool is_mixed = false;
     float gain = 0.0f;
 
+    // False while the source is paused, see Source::SetAudioNeeded().
+    bool audio_needed = true;
+    // Number of consecutive mixing rounds the source wasn't mixed in.
+    int rounds_not_mixed = 0;
+
     // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
     AudioFrame audio_frame;
+
+    // Produces the mix without this source in MixMinusOne(). Created the
+    // first time the source is mixed there.
+    std::unique_ptr<FrameCombiner> minus_one_combiner;
   };
 
   using SourceStatusList = std::vector<std::unique_ptr<SourceStatus>>;
@@ -47,6 +57,11 @@ class AudioMixerImpl : public AudioMixer {
   // AudioProcessing only accepts 10 ms frames.
   static const int kFrameDurationInMs = 10;
   static const int kMaximumAmountOfMixedAudioSources = 3;
+  // With the "WebRTC-Audio-PauseUnmixedSources" field trial, sources that
+  // report their received audio level are paused after not being mixed for
+  // this many rounds. A paused source isn't asked for audio, and is resumed
+  // when its received audio level shows that it would be mixed.
+  static const int kRoundsNotMixedBeforePause = 50;
 
   static rtc::scoped_refptr<AudioMixerImpl> Create();
 
@@ -64,6 +79,19 @@ class AudioMixerImpl : public AudioMixer {
            AudioFrame* audio_frame_for_mixing) override
       RTC_LOCKS_EXCLUDED(crit_);
 
+  // Does the same mix as Mix(), and in addition writes to
+  // |minus_one_frames[i]| the mix without the audio of |sources[i]| ("N-1"
+  // mix), as needed by a conference server sending every participant the
+  // audio of all others. The sources are only asked for audio once. The N-1
+  // mixes are derived from the full mix by subtracting the excluded source,
+  // and sources that are not mixed get a copy of the full mix. All |sources|
+  // must have been added to the mixer.
+  void MixMinusOne(size_t number_of_channels,
+                   rtc::ArrayView<Source* const> sources,
+                   rtc::ArrayView<AudioFrame* const> minus_one_frames,
+                   AudioFrame* audio_frame_for_mixing)
+      RTC_LOCKS_EXCLUDED(crit_);
+
   // Returns true if the source was mixed last round. Returns
   // false and logs an error if the source was never added to the
   // mixer.
@@ -84,6 +112,11 @@ class AudioMixerImpl : public AudioMixer {
   // kMaximumAmountOfMixedAudioSources audio sources.
   AudioFrameList GetAudioFromSources() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Pauses sources that haven't been mixed for a while, and resumes the
+  // loudest of |paused_sources| if it is louder than a mixed source.
+  void UpdatePausedSources(const std::vector<SourceStatus*>& paused_sources)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Add/remove the MixerAudioSource to the specified
   // MixerAudioSource list.
   bool AddAudioSourceToList(Source* audio_source,
@@ -107,6 +140,8 @@ class AudioMixerImpl : public AudioMixer {
 
   // Component that handles actual adding of audio frames.
   FrameCombiner frame_combiner_ RTC_GUARDED_BY(race_checker_);
+  const bool use_limiter_;
+  const bool pause_unmixed_sources_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioMixerImpl);
 };
@@ -10,10 +10,12 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "api/audio/audio_mixer.h"
 #include "modules/audio_mixer/audio_mixer_impl.h"
@@ -22,6 +24,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/task_queue_for_test.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 
 using testing::_;
@@ -77,6 +80,8 @@ class MockMixerAudioSource : public testing::NiceMock<AudioMixer::Source> {
 
   MOCK_CONST_METHOD0(PreferredSampleRate, int());
   MOCK_CONST_METHOD0(Ssrc, int());
+  MOCK_CONST_METHOD0(ReceivedAudioLevel, absl::optional<int>());
+  MOCK_METHOD1(SetAudioNeeded, void(bool needed));
 
   AudioFrame* fake_frame() { return &fake_frame_; }
   AudioFrameInfo fake_info() { return fake_audio_frame_info_; }
@@ -530,4 +535,126 @@ TEST(AudioMixer, AnyRateIsPossibleWithNoLimiter) {
     }
   }
 }
+
+TEST(AudioMixer, MixMinusOneLeavesOutEachMixedSource) {
+  const auto mixer = AudioMixerImpl::Create(
+      std::unique_ptr<OutputRateCalculator>(new DefaultOutputRateCalculator()),
+      false);
+  // The quietest source is not mixed.
+  const std::vector<int16_t> source_values = {100, 200, 300, 50};
+  std::vector<MockMixerAudioSource> sources(source_values.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    ResetFrame(sources[i].fake_frame());
+    int16_t* data = sources[i].fake_frame()->mutable_data();
+    std::fill(data, data + kDefaultSampleRateHz / 100, source_values[i]);
+    EXPECT_TRUE(mixer->AddSource(&sources[i]));
+    // Audio is only fetched once per call.
+    EXPECT_CALL(sources[i], GetAudioFrameWithInfo(kDefaultSampleRateHz, _))
+        .Times(Exactly(2));
+  }
+  std::vector<AudioMixer::Source*> source_pointers;
+  std::vector<AudioFrame> minus_one_frames(sources.size());
+  std::vector<AudioFrame*> minus_one_frame_pointers;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    source_pointers.push_back(&sources[i]);
+    minus_one_frame_pointers.push_back(&minus_one_frames[i]);
+  }
+
+  // Mix twice, so that the sources are no longer ramped in.
+  for (int k = 0; k < 2; ++k) {
+    mixer->MixMinusOne(1, source_pointers, minus_one_frame_pointers,
+                       &frame_for_mixing);
+  }
+
+  EXPECT_EQ(600, frame_for_mixing.data()[0]);
+  const std::vector<int16_t> expected_minus_one = {500, 400, 300, 600};
+  for (size_t i = 0; i < sources.size(); ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_EQ(kDefaultSampleRateHz, minus_one_frames[i].sample_rate_hz_);
+    EXPECT_EQ(1u, minus_one_frames[i].num_channels_);
+    const int16_t* data = minus_one_frames[i].data();
+    for (int j = 0; j < kDefaultSampleRateHz / 100; ++j) {
+      EXPECT_EQ(expected_minus_one[i], data[j]);
+    }
+  }
+}
+
+TEST(AudioMixer, PausesUnmixedSourceAndResumesItWhenLouder) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Audio-PauseUnmixedSources/Enabled/");
+  const auto mixer = AudioMixerImpl::Create();
+  // The quietest source is not mixed.
+  const std::vector<int16_t> source_values = {100, 200, 300, 50};
+  std::vector<MockMixerAudioSource> sources(source_values.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    ResetFrame(sources[i].fake_frame());
+    int16_t* data = sources[i].fake_frame()->mutable_data();
+    std::fill(data, data + kDefaultSampleRateHz / 100, source_values[i]);
+    ON_CALL(sources[i], ReceivedAudioLevel()).WillByDefault(Return(40));
+    EXPECT_TRUE(mixer->AddSource(&sources[i]));
+  }
+  MockMixerAudioSource& quiet_source = sources.back();
+
+  EXPECT_CALL(quiet_source, SetAudioNeeded(false));
+  EXPECT_CALL(quiet_source, GetAudioFrameWithInfo(_, _))
+      .Times(AudioMixerImpl::kRoundsNotMixedBeforePause);
+  for (int i = 0; i < AudioMixerImpl::kRoundsNotMixedBeforePause; ++i)
+    mixer->Mix(1, &frame_for_mixing);
+  testing::Mock::VerifyAndClearExpectations(&quiet_source);
+
+  // A paused source isn't asked for audio while it isn't louder than the
+  // quietest mixed source.
+  EXPECT_CALL(quiet_source, GetAudioFrameWithInfo(_, _)).Times(0);
+  EXPECT_CALL(quiet_source, SetAudioNeeded(_)).Times(0);
+  for (int i = 0; i < 10; ++i)
+    mixer->Mix(1, &frame_for_mixing);
+  EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&quiet_source));
+  testing::Mock::VerifyAndClearExpectations(&quiet_source);
+
+  ON_CALL(quiet_source, ReceivedAudioLevel()).WillByDefault(Return(20));
+  EXPECT_CALL(quiet_source, SetAudioNeeded(true));
+  mixer->Mix(1, &frame_for_mixing);
+  testing::Mock::VerifyAndClearExpectations(&quiet_source);
+
+  EXPECT_CALL(quiet_source, GetAudioFrameWithInfo(_, _));
+  mixer->Mix(1, &frame_for_mixing);
+}
+
+TEST(AudioMixer, DoesNotPauseSourcesWithoutReceivedAudioLevel) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Audio-PauseUnmixedSources/Enabled/");
+  const auto mixer = AudioMixerImpl::Create();
+  constexpr int kAudioSources =
+      AudioMixerImpl::kMaximumAmountOfMixedAudioSources + 1;
+  MockMixerAudioSource participants[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    participants[i].fake_frame()->mutable_data()[80] = i;
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+    EXPECT_CALL(participants[i], SetAudioNeeded(_)).Times(0);
+    EXPECT_CALL(participants[i], GetAudioFrameWithInfo(_, _))
+        .Times(2 * AudioMixerImpl::kRoundsNotMixedBeforePause);
+  }
+  for (int i = 0; i < 2 * AudioMixerImpl::kRoundsNotMixedBeforePause; ++i)
+    mixer->Mix(1, &frame_for_mixing);
+}
+
+TEST(AudioMixer, ResumesPausedSourceWhenRemoved) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Audio-PauseUnmixedSources/Enabled/");
+  const auto mixer = AudioMixerImpl::Create();
+  MockMixerAudioSource source;
+  ResetFrame(source.fake_frame());
+  source.set_fake_info(AudioMixer::Source::AudioFrameInfo::kMuted);
+  ON_CALL(source, ReceivedAudioLevel()).WillByDefault(Return(127));
+  EXPECT_TRUE(mixer->AddSource(&source));
+
+  EXPECT_CALL(source, SetAudioNeeded(false));
+  for (int i = 0; i < AudioMixerImpl::kRoundsNotMixedBeforePause; ++i)
+    mixer->Mix(1, &frame_for_mixing);
+  testing::Mock::VerifyAndClearExpectations(&source);
+
+  EXPECT_CALL(source, SetAudioNeeded(true));
+  mixer->RemoveSource(&source);
+}
 }  // namespace webrtc
@@ -14,10 +14,10 @@
 #include <array>
 #include <cstdint>
 #include <iterator>
+#include <limits>
 #include <string>
 
 #include "api/array_view.h"
-#include "common_audio/include/audio_util.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/audio_mixer_impl.h"
 #include "modules/audio_processing/include/audio_frame_view.h"
@@ -25,8 +25,15 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_minmax.h"
 #include "system_wrappers/include/metrics.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
 namespace {
 
@@ -68,25 +75,101 @@ void MixFewFramesWithNoLimiter(const std::vector<AudioFrame*>& mix_list,
     return;
   }
   RTC_DCHECK_LE(mix_list.size(), 1);
-  std::copy(mix_list[0]->data(),
-            mix_list[0]->data() +
-                mix_list[0]->num_channels_ * mix_list[0]->samples_per_channel_,
-            audio_frame_for_mixing->mutable_data());
+  const size_t size =
+      mix_list[0]->num_channels_ * mix_list[0]->samples_per_channel_;
+  if (mix_list[0]->has_float_data()) {
+    std::copy(mix_list[0]->float_data(), mix_list[0]->float_data() + size,
+              audio_frame_for_mixing->mutable_float_data());
+  } else {
+    std::copy(mix_list[0]->data(), mix_list[0]->data() + size,
+              audio_frame_for_mixing->mutable_data());
+  }
+}
+
+// Adds |size| samples to |accumulator|.
+void AccumulateS16(const int16_t* samples, size_t size, float* accumulator) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 8 <= size; i += 8) {
+    const __m128i s16 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&samples[i]));
+    // Sign extend to 32 bits by unpacking into the upper halves and shifting.
+    const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(s16, s16), 16);
+    const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(s16, s16), 16);
+    _mm_storeu_ps(&accumulator[i], _mm_add_ps(_mm_loadu_ps(&accumulator[i]),
+                                              _mm_cvtepi32_ps(low)));
+    _mm_storeu_ps(&accumulator[i + 4],
+                  _mm_add_ps(_mm_loadu_ps(&accumulator[i + 4]),
+                             _mm_cvtepi32_ps(high)));
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  for (; i + 8 <= size; i += 8) {
+    const int16x8_t s16 = vld1q_s16(&samples[i]);
+    const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s16)));
+    const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s16)));
+    vst1q_f32(&accumulator[i], vaddq_f32(vld1q_f32(&accumulator[i]), low));
+    vst1q_f32(&accumulator[i + 4],
+              vaddq_f32(vld1q_f32(&accumulator[i + 4]), high));
+  }
+#endif
+  for (; i < size; ++i) {
+    accumulator[i] += samples[i];
+  }
+}
+
+// Adds the first |size| samples of |frame| to |accumulator|, using the float
+// samples if the frame carries them.
+void AccumulateFrame(const AudioFrame& frame, size_t size, float* accumulator) {
+  if (frame.has_float_data()) {
+    const float* const samples = frame.float_data();
+    for (size_t i = 0; i < size; ++i) {
+      accumulator[i] += samples[i];
+    }
+  } else {
+    AccumulateS16(frame.data(), size, accumulator);
+  }
+}
+
+// Sums the interleaved frames in |mix_list| into |mix_sum|. The frames are
+// summed in their interleaved layout, which keeps the inner loop contiguous
+// for any number of channels.
+void MixToInterleavedFloat(const std::vector<AudioFrame*>& mix_list,
+                           size_t size,
+                           float* mix_sum) {
+  std::fill(mix_sum, mix_sum + size, 0.f);
+  for (const AudioFrame* frame : mix_list) {
+    AccumulateFrame(*frame, size, mix_sum);
+  }
 }
 
-std::array<OneChannelBuffer, kMaximumAmountOfChannels> MixToFloatFrame(
-    const std::vector<AudioFrame*>& mix_list,
+// Converts the interleaved FloatS16 sum to one buffer per channel, leaving out
+// |excluded_frame| if it is not null.
+std::array<OneChannelBuffer, kMaximumAmountOfChannels> DeinterleaveMix(
+    const float* mix_sum,
+    const AudioFrame* excluded_frame,
     size_t samples_per_channel,
     size_t number_of_channels) {
-  // Convert to FloatS16 and mix.
-  using OneChannelBuffer = std::array<float, kMaximumChannelSize>;
-  std::array<OneChannelBuffer, kMaximumAmountOfChannels> mixing_buffer{};
-
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
+  std::array<OneChannelBuffer, kMaximumAmountOfChannels> mixing_buffer;
+  if (excluded_frame && excluded_frame->has_float_data()) {
+    const float* const excluded = excluded_frame->float_data();
     for (size_t j = 0; j < number_of_channels; ++j) {
       for (size_t k = 0; k < samples_per_channel; ++k) {
-        mixing_buffer[j][k] += frame->data()[number_of_channels * k + j];
+        const size_t index = number_of_channels * k + j;
+        mixing_buffer[j][k] = mix_sum[index] - excluded[index];
+      }
+    }
+  } else if (excluded_frame) {
+    const int16_t* const excluded = excluded_frame->data();
+    for (size_t j = 0; j < number_of_channels; ++j) {
+      for (size_t k = 0; k < samples_per_channel; ++k) {
+        const size_t index = number_of_channels * k + j;
+        mixing_buffer[j][k] = mix_sum[index] - excluded[index];
+      }
+    }
+  } else {
+    for (size_t j = 0; j < number_of_channels; ++j) {
+      for (size_t k = 0; k < samples_per_channel; ++k) {
+        mixing_buffer[j][k] = mix_sum[number_of_channels * k + j];
       }
     }
   }
@@ -101,25 +184,52 @@ void RunLimiter(AudioFrameView<float> mixing_buffer_view, Limiter* limiter) {
   limiter->Process(mixing_buffer_view);
 }
 
-// Both interleaves and rounds.
+// Interleaves and saturates to the int16 range. The float samples are kept
+// in the result frame; they are only rounded if the int16 data is read.
 void InterleaveToAudioFrame(AudioFrameView<const float> mixing_buffer_view,
                             AudioFrame* audio_frame_for_mixing) {
   const size_t number_of_channels = mixing_buffer_view.num_channels();
   const size_t samples_per_channel = mixing_buffer_view.samples_per_channel();
+  float* const output = audio_frame_for_mixing->mutable_float_data();
   // Put data in the result frame.
   for (size_t i = 0; i < number_of_channels; ++i) {
     for (size_t j = 0; j < samples_per_channel; ++j) {
-      audio_frame_for_mixing->mutable_data()[number_of_channels * j + i] =
-          FloatS16ToS16(mixing_buffer_view.channel(i)[j]);
+      output[number_of_channels * j + i] = rtc::SafeClamp(
+          mixing_buffer_view.channel(i)[j],
+          static_cast<float>(std::numeric_limits<int16_t>::min()),
+          static_cast<float>(std::numeric_limits<int16_t>::max()));
     }
   }
 }
+// Runs the limiter, if any, on the per-channel mix and writes the result to
+// |audio_frame_for_mixing|.
+void LimitAndInterleave(
+    std::array<OneChannelBuffer, kMaximumAmountOfChannels>* mixing_buffer,
+    size_t number_of_channels,
+    size_t samples_per_channel,
+    Limiter* limiter,
+    AudioFrame* audio_frame_for_mixing) {
+  // Put float data in an AudioFrameView.
+  std::array<float*, kMaximumAmountOfChannels> channel_pointers{};
+  for (size_t i = 0; i < number_of_channels; ++i) {
+    channel_pointers[i] = &(*mixing_buffer)[i][0];
+  }
+  AudioFrameView<float> mixing_buffer_view(
+      &channel_pointers[0], number_of_channels, samples_per_channel);
+
+  if (limiter) {
+    RunLimiter(mixing_buffer_view, limiter);
+  }
+
+  InterleaveToAudioFrame(mixing_buffer_view, audio_frame_for_mixing);
+}
 }  // namespace
 
 FrameCombiner::FrameCombiner(bool use_limiter)
     : data_dumper_(new ApmDataDumper(0)),
       limiter_(static_cast<size_t>(48000), data_dumper_.get(), "AudioMixer"),
-      use_limiter_(use_limiter) {}
+      use_limiter_(use_limiter),
+      mix_sum_(kMaximumAmountOfChannels * kMaximumChannelSize) {}
 
 FrameCombiner::~FrameCombiner() = default;
 
@@ -149,27 +259,66 @@ void FrameCombiner::Combine(const std::vector<AudioFrame*>& mix_list,
     RemixFrame(number_of_channels, frame);
   }
 
+  mixed_number_of_channels_ = number_of_channels;
+  mixed_sample_rate_ = sample_rate;
+  mixed_number_of_streams_ = number_of_streams;
+
   if (number_of_streams <= 1) {
     MixFewFramesWithNoLimiter(mix_list, audio_frame_for_mixing);
     return;
   }
 
+  MixToInterleavedFloat(mix_list, samples_per_channel * number_of_channels,
+                        mix_sum_.data());
   std::array<OneChannelBuffer, kMaximumAmountOfChannels> mixing_buffer =
-      MixToFloatFrame(mix_list, samples_per_channel, number_of_channels);
+      DeinterleaveMix(mix_sum_.data(), nullptr, samples_per_channel,
+                      number_of_channels);
+  LimitAndInterleave(&mixing_buffer, number_of_channels, samples_per_channel,
+                     use_limiter_ ? &limiter_ : nullptr,
+                     audio_frame_for_mixing);
+}
 
-  // Put float data in an AudioFrameView.
-  std::array<float*, kMaximumAmountOfChannels> channel_pointers{};
-  for (size_t i = 0; i < number_of_channels; ++i) {
-    channel_pointers[i] = &mixing_buffer[i][0];
-  }
-  AudioFrameView<float> mixing_buffer_view(
-      &channel_pointers[0], number_of_channels, samples_per_channel);
+void FrameCombiner::CombineExcluding(const FrameCombiner& full_mix,
+                                     const std::vector<AudioFrame*>& mix_list,
+                                     const AudioFrame* excluded_frame,
+                                     AudioFrame* audio_frame_for_mixing) {
+  RTC_DCHECK(excluded_frame);
+  RTC_DCHECK(audio_frame_for_mixing);
+  RTC_DCHECK(std::find(mix_list.begin(), mix_list.end(), excluded_frame) !=
+             mix_list.end());
+
+  std::vector<AudioFrame*> remaining_frames;
+  remaining_frames.reserve(mix_list.size());
+  std::copy_if(mix_list.begin(), mix_list.end(),
+               std::back_inserter(remaining_frames),
+               [excluded_frame](const AudioFrame* frame) {
+                 return frame != excluded_frame;
+               });
 
-  if (use_limiter_) {
-    RunLimiter(mixing_buffer_view, &limiter_);
+  const size_t number_of_channels = full_mix.mixed_number_of_channels_;
+  const int sample_rate = full_mix.mixed_sample_rate_;
+  const size_t number_of_streams = full_mix.mixed_number_of_streams_ - 1;
+  SetAudioFrameFields(remaining_frames, number_of_channels, sample_rate,
+                      number_of_streams, audio_frame_for_mixing);
+
+  if (full_mix.mixed_number_of_streams_ <= 1) {
+    // The full mix was a copy of |excluded_frame|.
+    audio_frame_for_mixing->Mute();
+    return;
+  }
+  if (number_of_streams <= 1) {
+    MixFewFramesWithNoLimiter(remaining_frames, audio_frame_for_mixing);
+    return;
   }
 
-  InterleaveToAudioFrame(mixing_buffer_view, audio_frame_for_mixing);
+  const size_t samples_per_channel =
+      audio_frame_for_mixing->samples_per_channel_;
+  std::array<OneChannelBuffer, kMaximumAmountOfChannels> mixing_buffer =
+      DeinterleaveMix(full_mix.mix_sum_.data(), excluded_frame,
+                      samples_per_channel, number_of_channels);
+  LimitAndInterleave(&mixing_buffer, number_of_channels, samples_per_channel,
+                     use_limiter_ ? &limiter_ : nullptr,
+                     audio_frame_for_mixing);
 }
 
 void FrameCombiner::LogMixingStats(const std::vector<AudioFrame*>& mix_list,
@@ -38,6 +38,19 @@ class FrameCombiner {
                size_t number_of_streams,
                AudioFrame* audio_frame_for_mixing);
 
+  // Writes the mix of the frames in |mix_list| except |excluded_frame| to
+  // |audio_frame_for_mixing|. |mix_list| must be the list that was last passed
+  // to Combine() on |full_mix|, after which the frames must not have been
+  // modified. The result is obtained by subtracting |excluded_frame| from the
+  // float sum kept by |full_mix| instead of summing the other frames again,
+  // which makes producing an N-1 mix for every mixed conference participant
+  // cheap. The limiter of this combiner is used, so that every N-1 output
+  // keeps its own limiter state.
+  void CombineExcluding(const FrameCombiner& full_mix,
+                        const std::vector<AudioFrame*>& mix_list,
+                        const AudioFrame* excluded_frame,
+                        AudioFrame* audio_frame_for_mixing);
+
  private:
   void LogMixingStats(const std::vector<AudioFrame*>& mix_list,
                       int sample_rate,
@@ -47,6 +60,13 @@ class FrameCombiner {
   Limiter limiter_;
   const bool use_limiter_;
   mutable int uma_logging_counter_ = 0;
+
+  // Interleaved FloatS16 sum of the frames of the last Combine() call, before
+  // limiting, together with the parameters it was mixed with.
+  std::vector<float> mix_sum_;
+  size_t mixed_number_of_channels_ = 0;
+  int mixed_sample_rate_ = 0;
+  size_t mixed_number_of_streams_ = 0;
 };
 }  // namespace webrtc
 
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <initializer_list>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "modules/audio_mixer/frame_combiner.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "test/gtest.h"
+#include "test/testsupport/microbenchmark.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kSamplesPerChannel = kSampleRateHz / 100;
+constexpr size_t kNumChannels = 2;
+
+}  // namespace
+
+TEST(FrameCombinerMicrobenchmark, Combine) {
+  Random random(42);
+  for (size_t num_streams : {1, 3, 10}) {
+    std::vector<AudioFrame> frames(num_streams);
+    std::vector<AudioFrame*> mix_list;
+    std::vector<int16_t> samples(kSamplesPerChannel * kNumChannels);
+    for (AudioFrame& frame : frames) {
+      for (int16_t& sample : samples)
+        sample = random.Rand(-8000, 8000);
+      frame.UpdateFrame(0, samples.data(), kSamplesPerChannel, kSampleRateHz,
+                        AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                        kNumChannels);
+      mix_list.push_back(&frame);
+    }
+
+    FrameCombiner combiner(/*use_limiter=*/true);
+    AudioFrame mixed;
+    rtc::StringBuilder name;
+    name << "FrameCombiner_Combine" << num_streams << "Streams";
+    test::RunMicrobenchmark(name.str(), [&] {
+      combiner.Combine(mix_list, kNumChannels, kSampleRateHz, num_streams,
+                       &mixed);
+    });
+    test::DoNotOptimizeAway(mixed.data());
+  }
+}
+
+}  // namespace webrtc
@@ -11,6 +11,7 @@
 #include "modules/audio_mixer/frame_combiner.h"
 
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <numeric>
 #include <string>
@@ -156,6 +157,94 @@ TEST(FrameCombiner, CombiningOneFrameShouldNotChangeFrame) {
   }
 }
 
+TEST(FrameCombiner, CombiningTwoFramesShouldSumThem) {
+  FrameCombiner combiner(false);
+  for (const int rate : {8000, 10000, 11000, 32000, 44100}) {
+    for (const int number_of_channels : {1, 2}) {
+      SCOPED_TRACE(ProduceDebugText(rate, number_of_channels, 2));
+
+      SetUpFrames(rate, number_of_channels);
+      const size_t size = number_of_channels * rate / 100;
+      int16_t* frame1_data = frame1.mutable_data();
+      int16_t* frame2_data = frame2.mutable_data();
+      std::iota(frame1_data, frame1_data + size, -1000);
+      std::iota(frame2_data, frame2_data + size, 3);
+      const std::vector<AudioFrame*> frames_to_combine = {&frame1, &frame2};
+      combiner.Combine(frames_to_combine, number_of_channels, rate,
+                       frames_to_combine.size(), &audio_frame_for_mixing);
+
+      const int16_t* mixed_data = audio_frame_for_mixing.data();
+      for (size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(-997 + 2 * static_cast<int>(i), mixed_data[i]);
+      }
+    }
+  }
+}
+
+TEST(FrameCombiner, CombiningFloatFramesKeepsFloatSamples) {
+  FrameCombiner combiner(false);
+  constexpr int kRate = 48000;
+  for (const int number_of_channels : {1, 2}) {
+    SCOPED_TRACE(ProduceDebugText(kRate, number_of_channels, 2));
+    SetUpFrames(kRate, number_of_channels);
+    const size_t size = number_of_channels * kRate / 100;
+    std::fill(frame1.mutable_float_data(), frame1.mutable_float_data() + size,
+              0.3f);
+    std::fill(frame2.mutable_data(), frame2.mutable_data() + size, 2);
+    const std::vector<AudioFrame*> frames_to_combine = {&frame1, &frame2};
+    combiner.Combine(frames_to_combine, number_of_channels, kRate,
+                     frames_to_combine.size(), &audio_frame_for_mixing);
+
+    ASSERT_TRUE(audio_frame_for_mixing.has_float_data());
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(2.3f, audio_frame_for_mixing.float_data()[i]);
+      EXPECT_EQ(2, audio_frame_for_mixing.data()[i]);
+    }
+  }
+}
+
+TEST(FrameCombiner, CombineExcludingMatchesCombiningTheOtherFrames) {
+  AudioFrame frame3;
+  for (const bool use_limiter : {false, true}) {
+    for (const int number_of_channels : {1, 2}) {
+      constexpr int kRate = 48000;
+      SCOPED_TRACE(ProduceDebugText(kRate, number_of_channels, 3));
+      SetUpFrames(kRate, number_of_channels);
+      frame3.CopyFrom(frame1);
+      const size_t size = number_of_channels * kRate / 100;
+      // Loud enough for the limiter to be active.
+      std::iota(frame1.mutable_data(), frame1.mutable_data() + size, 0);
+      std::fill(frame2.mutable_data(), frame2.mutable_data() + size, 15000);
+      std::fill(frame3.mutable_data(), frame3.mutable_data() + size, -2000);
+      const std::vector<AudioFrame*> all_frames = {&frame1, &frame2, &frame3};
+
+      FrameCombiner full_combiner(use_limiter);
+      full_combiner.Combine(all_frames, number_of_channels, kRate,
+                            all_frames.size(), &audio_frame_for_mixing);
+
+      for (size_t excluded = 0; excluded < all_frames.size(); ++excluded) {
+        std::vector<AudioFrame*> other_frames = all_frames;
+        other_frames.erase(other_frames.begin() + excluded);
+        AudioFrame expected_frame;
+        FrameCombiner(use_limiter)
+            .Combine(other_frames, number_of_channels, kRate,
+                     other_frames.size(), &expected_frame);
+
+        AudioFrame minus_one_frame;
+        FrameCombiner(use_limiter)
+            .CombineExcluding(full_combiner, all_frames, all_frames[excluded],
+                              &minus_one_frame);
+
+        ASSERT_EQ(expected_frame.samples_per_channel_,
+                  minus_one_frame.samples_per_channel_);
+        ASSERT_EQ(expected_frame.num_channels_, minus_one_frame.num_channels_);
+        EXPECT_EQ(0, memcmp(expected_frame.data(), minus_one_frame.data(),
+                            size * sizeof(int16_t)));
+      }
+    }
+  }
+}
+
 // Send a sine wave through the FrameCombiner, and check that the
 // difference between input and output varies smoothly. Also check
 // that it is inside reasonable bounds. This is to catch issues like
@@ -214,6 +214,63 @@ TEST(AdaptiveFirFilter, FilterAdaptationSse2Optimizations) {
   }
 }
 
+// Verifies that the optimized methods for filter adaptation are bitexact to
+// their reference counterparts.
+TEST(AdaptiveFirFilter, FilterAdaptationAvx2Optimizations) {
+  bool use_avx2 =
+      WebRtc_GetCPUInfo(kAVX2) != 0 && WebRtc_GetCPUInfo(kFMA3) != 0;
+  if (use_avx2) {
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(EchoCanceller3Config(), 3));
+    Random random_generator(42U);
+    std::vector<std::vector<float>> x(3, std::vector<float>(kBlockSize, 0.f));
+    FftData S_C;
+    FftData S_AVX2;
+    FftData G;
+    Aec3Fft fft;
+    std::vector<FftData> H_C(10);
+    std::vector<FftData> H_AVX2(10);
+    for (auto& H_j : H_C) {
+      H_j.Clear();
+    }
+    for (auto& H_j : H_AVX2) {
+      H_j.Clear();
+    }
+
+    for (size_t k = 0; k < 500; ++k) {
+      RandomizeSampleVector(&random_generator, x[0]);
+      render_delay_buffer->Insert(x);
+      if (k == 0) {
+        render_delay_buffer->Reset();
+      }
+      render_delay_buffer->PrepareCaptureProcessing();
+      auto* const render_buffer = render_delay_buffer->GetRenderBuffer();
+
+      ApplyFilter_AVX2(*render_buffer, H_AVX2, &S_AVX2);
+      ApplyFilter(*render_buffer, H_C, &S_C);
+      for (size_t j = 0; j < S_C.re.size(); ++j) {
+        EXPECT_FLOAT_EQ(S_C.re[j], S_AVX2.re[j]);
+        EXPECT_FLOAT_EQ(S_C.im[j], S_AVX2.im[j]);
+      }
+
+      std::for_each(G.re.begin(), G.re.end(),
+                    [&](float& a) { a = random_generator.Rand<float>(); });
+      std::for_each(G.im.begin(), G.im.end(),
+                    [&](float& a) { a = random_generator.Rand<float>(); });
+
+      AdaptPartitions_AVX2(*render_buffer, G, H_AVX2);
+      AdaptPartitions(*render_buffer, G, H_C);
+
+      for (size_t k = 0; k < H_C.size(); ++k) {
+        for (size_t j = 0; j < H_C[k].re.size(); ++j) {
+          EXPECT_FLOAT_EQ(H_C[k].re[j], H_AVX2[k].re[j]);
+          EXPECT_FLOAT_EQ(H_C[k].im[j], H_AVX2[k].im[j]);
+        }
+      }
+    }
+  }
+}
+
 // Verifies that the optimized method for frequency response computation is
 // bitexact to the reference counterpart.
 TEST(AdaptiveFirFilter, UpdateFrequencyResponseSse2Optimization) {
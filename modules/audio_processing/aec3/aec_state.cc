@@ -56,7 +56,7 @@ int AecState::instance_count_ = 0;
 void AecState::GetResidualEchoScaling(
     rtc::ArrayView<float> residual_scaling) const {
   bool filter_has_had_time_to_converge;
-  if (config_.filter.conservative_initial_phase) {
+  if (conservative_initial_phase_) {
     filter_has_had_time_to_converge =
         strong_not_saturated_render_blocks_ >= 1.5f * kNumBlocksPerSecond;
   } else {
@@ -78,25 +78,30 @@ absl::optional<float> AecState::ErleUncertainty() const {
 AecState::AecState(const EchoCanceller3Config& config)
     : data_dumper_(
           new ApmDataDumper(rtc::AtomicOps::Increment(&instance_count_))),
-      config_(config),
+      conservative_initial_phase_(config.filter.conservative_initial_phase),
+      use_stationary_properties_(
+          config.echo_audibility.use_stationary_properties),
+      reverb_based_on_render_(config.ep_strength.reverb_based_on_render),
+      erle_onset_detection_(config.erle.onset_detection),
+      active_render_limit_(config.render_levels.active_render_limit),
       use_legacy_saturation_behavior_(EnableLegacySaturationBehavior()),
       enable_erle_resets_at_gain_changes_(EnableErleResetsAtGainChanges()),
       enable_erle_updates_during_reverb_(EnableErleUpdatesDuringReverb()),
       use_legacy_filter_quality_(UseLegacyFilterQualityState()),
       use_suppressor_gain_limiter_(UseSuppressionGainLimiter()),
-      initial_state_(config_),
-      delay_state_(config_),
-      transparent_state_(config_),
-      filter_quality_state_(config_),
-      legacy_filter_quality_state_(config_),
-      legacy_saturation_detector_(config_),
+      initial_state_(config),
+      delay_state_(config),
+      transparent_state_(config),
+      filter_quality_state_(config),
+      legacy_filter_quality_state_(config),
+      legacy_saturation_detector_(config),
       erl_estimator_(2 * kNumBlocksPerSecond),
-      erle_estimator_(2 * kNumBlocksPerSecond, config_),
-      suppression_gain_limiter_(config_),
-      filter_analyzer_(config_),
+      erle_estimator_(2 * kNumBlocksPerSecond, config),
+      suppression_gain_limiter_(config),
+      filter_analyzer_(config),
       echo_audibility_(
-          config_.echo_audibility.use_stationarity_properties_at_init),
-      reverb_model_estimator_(config_) {}
+          config.echo_audibility.use_stationarity_properties_at_init),
+      reverb_model_estimator_(config) {}
 
 AecState::~AecState() = default;
 
@@ -165,8 +170,7 @@ void AecState::Update(
       aligned_render_block.begin(), aligned_render_block.end(),
       aligned_render_block.begin(), 0.f);
   const bool active_render =
-      render_energy > (config_.render_levels.active_render_limit *
-                       config_.render_levels.active_render_limit) *
+      render_energy > (active_render_limit_ * active_render_limit_) *
                           kFftLengthBy2;
   blocks_with_active_render_ += active_render ? 1 : 0;
   strong_not_saturated_render_blocks_ +=
@@ -186,10 +190,10 @@ void AecState::Update(
   std::array<float, kFftLengthBy2Plus1> X2_reverb;
   render_reverb_.Apply(
       render_buffer.GetSpectrumBuffer(), delay_state_.DirectPathFilterDelay(),
-      config_.ep_strength.reverb_based_on_render ? ReverbDecay() : 0.f,
+      reverb_based_on_render_ ? ReverbDecay() : 0.f,
       X2_reverb);
 
-  if (config_.echo_audibility.use_stationary_properties) {
+  if (use_stationary_properties_) {
     // Update the echo audibility evaluator.
     echo_audibility_.Update(render_buffer,
                             render_reverb_.GetReverbContributionPowerSpectrum(),
@@ -209,7 +213,7 @@ void AecState::Update(
   erle_estimator_.Update(render_buffer, adaptive_filter_frequency_response,
                          X2_input_erle, Y2, E2_main,
                          subtractor_output_analyzer_.ConvergedFilter(),
-                         config_.erle.onset_detection);
+                         erle_onset_detection_);
 
   erl_estimator_.Update(subtractor_output_analyzer_.ConvergedFilter(), X2, Y2);
 
@@ -248,8 +252,7 @@ void AecState::Update(
 
   // Update the reverb estimate.
   const bool stationary_block =
-      config_.echo_audibility.use_stationary_properties &&
-      echo_audibility_.IsBlockStationary();
+      use_stationary_properties_ && echo_audibility_.IsBlockStationary();
 
   reverb_model_estimator_.Update(filter_analyzer_.GetAdjustedFilter(),
                                  adaptive_filter_frequency_response,
@@ -73,7 +73,7 @@ class AecState {
   // Returns whether the stationary properties of the signals are used in the
   // aec.
   bool UseStationaryProperties() const {
-    return config_.echo_audibility.use_stationary_properties;
+    return use_stationary_properties_;
   }
 
   // Returns the ERLE.
@@ -169,7 +169,11 @@ class AecState {
  private:
   static int instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
-  const EchoCanceller3Config config_;
+  const bool conservative_initial_phase_;
+  const bool use_stationary_properties_;
+  const bool reverb_based_on_render_;
+  const bool erle_onset_detection_;
+  const float active_render_limit_;
   const bool use_legacy_saturation_behavior_;
   const bool enable_erle_resets_at_gain_changes_;
   const bool enable_erle_updates_during_reverb_;
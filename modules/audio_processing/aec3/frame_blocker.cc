@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/aec3/frame_blocker.h"
 
+#include <algorithm>
+
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "rtc_base/checks.h"
 
@@ -36,12 +38,10 @@ void FrameBlocker::InsertSubFrameAndExtractBlock(
     RTC_DCHECK_EQ(kBlockSize, (*block)[i].size());
     RTC_DCHECK_EQ(kSubFrameLength, sub_frame[i].size());
     const int samples_to_block = kBlockSize - buffer_[i].size();
-    (*block)[i].clear();
-    (*block)[i].insert((*block)[i].begin(), buffer_[i].begin(),
-                       buffer_[i].end());
-    (*block)[i].insert((*block)[i].begin() + buffer_[i].size(),
-                       sub_frame[i].begin(),
-                       sub_frame[i].begin() + samples_to_block);
+    // The block is always kBlockSize long, so it is overwritten in place.
+    std::copy(buffer_[i].begin(), buffer_[i].end(), (*block)[i].begin());
+    std::copy(sub_frame[i].begin(), sub_frame[i].begin() + samples_to_block,
+              (*block)[i].begin() + buffer_[i].size());
     buffer_[i].clear();
     buffer_[i].insert(buffer_[i].begin(),
                       sub_frame[i].begin() + samples_to_block,
@@ -60,9 +60,7 @@ void FrameBlocker::ExtractBlock(std::vector<std::vector<float>>* block) {
   for (size_t i = 0; i < num_bands_; ++i) {
     RTC_DCHECK_EQ(kBlockSize, buffer_[i].size());
     RTC_DCHECK_EQ(kBlockSize, (*block)[i].size());
-    (*block)[i].clear();
-    (*block)[i].insert((*block)[i].begin(), buffer_[i].begin(),
-                       buffer_[i].end());
+    std::copy(buffer_[i].begin(), buffer_[i].end(), (*block)[i].begin());
     buffer_[i].clear();
   }
 }
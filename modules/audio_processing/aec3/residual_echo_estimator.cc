@@ -79,15 +79,16 @@ void GetRenderIndexesToAnalyze(
 }  // namespace
 
 ResidualEchoEstimator::ResidualEchoEstimator(const EchoCanceller3Config& config)
-    : config_(config),
+    : echo_model_config_(config.echo_model),
+      ep_strength_lf_(config.ep_strength.lf),
+      filter_length_blocks_(config.filter.main.length_blocks),
       soft_transparent_mode_(EnableSoftTransparentMode()),
       override_estimated_echo_path_gain_(OverrideEstimatedEchoPathGain()),
       use_fixed_nonlinear_reverb_model_(UseFixedNonLinearReverbModel()) {
-  if (config_.ep_strength.reverb_based_on_render) {
+  if (config.ep_strength.reverb_based_on_render) {
     echo_reverb_.reset(new ReverbModel());
   } else {
-    echo_reverb_fallback.reset(
-        new ReverbModelFallback(config_.filter.main.length_blocks));
+    echo_reverb_fallback.reset(new ReverbModelFallback(filter_length_blocks_));
   }
   Reset();
 }
@@ -134,7 +135,7 @@ void ResidualEchoEstimator::Estimate(
     // Estimate the echo generating signal power.
     std::array<float, kFftLengthBy2Plus1> X2;
 
-    EchoGeneratingPower(render_buffer.GetSpectrumBuffer(), config_.echo_model,
+    EchoGeneratingPower(render_buffer.GetSpectrumBuffer(), echo_model_config_,
                         render_buffer.Headroom(), aec_state.FilterDelayBlocks(),
                         aec_state.IsSuppressionGainLimitActive(),
                         !aec_state.UseStationaryProperties(), &X2);
@@ -144,14 +145,14 @@ void ResidualEchoEstimator::Estimate(
     std::transform(X2.begin(), X2.end(), X2_noise_floor_.begin(), X2.begin(),
                    [&](float a, float b) {
                      return std::max(
-                         0.f, a - config_.echo_model.stationary_gate_slope * b);
+                         0.f, a - echo_model_config_.stationary_gate_slope * b);
                    });
 
     float echo_path_gain;
     if (override_estimated_echo_path_gain_) {
       echo_path_gain = aec_state.TransparentMode() && soft_transparent_mode_
                            ? 0.01f
-                           : config_.ep_strength.lf;
+                           : ep_strength_lf_;
     } else {
       echo_path_gain = aec_state.TransparentMode() && soft_transparent_mode_
                            ? 0.01f
@@ -173,7 +174,7 @@ void ResidualEchoEstimator::Estimate(
       } else {
         RTC_DCHECK(echo_reverb_fallback);
         echo_reverb_fallback->AddEchoReverb(*R2,
-                                            config_.filter.main.length_blocks,
+                                            filter_length_blocks_,
                                             aec_state.ReverbDecay(), R2);
       }
     }
@@ -209,8 +210,8 @@ void ResidualEchoEstimator::Reset() {
     RTC_DCHECK(echo_reverb_fallback);
     echo_reverb_fallback->Reset();
   }
-  X2_noise_floor_counter_.fill(config_.echo_model.noise_floor_hold);
-  X2_noise_floor_.fill(config_.echo_model.min_noise_floor_power);
+  X2_noise_floor_counter_.fill(echo_model_config_.noise_floor_hold);
+  X2_noise_floor_.fill(echo_model_config_.min_noise_floor_power);
   R2_old_.fill(0.f);
   R2_hold_counter_.fill(0.f);
 }
@@ -252,10 +253,10 @@ void ResidualEchoEstimator::NonLinearEstimate(
       // Compute the residual echo by holding a maximum echo powers and an echo
       // fading corresponding to a room with an RT60 value of about 50 ms.
       (*R2)[k] =
-          R2_hold_counter_[k] < config_.echo_model.nonlinear_hold
+          R2_hold_counter_[k] < echo_model_config_.nonlinear_hold
               ? std::max((*R2)[k], R2_old_[k])
               : std::min((*R2)[k] +
-                             R2_old_[k] * config_.echo_model.nonlinear_release,
+                             R2_old_[k] * echo_model_config_.nonlinear_release,
                          Y2[k]);
     }
   }
@@ -272,7 +273,7 @@ void ResidualEchoEstimator::EchoGeneratingPower(
   int idx_stop, idx_start;
 
   RTC_DCHECK(X2);
-  GetRenderIndexesToAnalyze(spectrum_buffer, config_.echo_model,
+  GetRenderIndexesToAnalyze(spectrum_buffer, echo_model_config_,
                             filter_delay_blocks, gain_limiter_running,
                             headroom_spectrum_buffer, &idx_start, &idx_stop);
 
@@ -286,9 +287,9 @@ void ResidualEchoEstimator::EchoGeneratingPower(
   if (apply_noise_gating) {
     // Apply soft noise gate.
     std::for_each(X2->begin(), X2->end(), [&](float& a) {
-      if (config_.echo_model.noise_gate_power > a) {
-        a = std::max(0.f, a - config_.echo_model.noise_gate_slope *
-                                  (config_.echo_model.noise_gate_power - a));
+      if (echo_model_config_.noise_gate_power > a) {
+        a = std::max(0.f, a - echo_model_config_.noise_gate_slope *
+                                  (echo_model_config_.noise_gate_power - a));
       }
     });
   }
@@ -314,10 +315,10 @@ void ResidualEchoEstimator::RenderNoisePower(
     } else {
       // Increase in a delayed, leaky manner.
       if ((*X2_noise_floor_counter)[k] >=
-          static_cast<int>(config_.echo_model.noise_floor_hold)) {
+          static_cast<int>(echo_model_config_.noise_floor_hold)) {
         (*X2_noise_floor)[k] =
             std::max((*X2_noise_floor)[k] * 1.1f,
-                     config_.echo_model.min_noise_floor_power);
+                     echo_model_config_.min_noise_floor_power);
       } else {
         ++(*X2_noise_floor_counter)[k];
       }
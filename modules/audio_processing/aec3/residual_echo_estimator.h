@@ -83,7 +83,9 @@ class ResidualEchoEstimator {
       std::array<float, kFftLengthBy2Plus1>* X2_noise_floor,
       std::array<int, kFftLengthBy2Plus1>* X2_noise_floor_counter) const;
 
-  const EchoCanceller3Config config_;
+  const EchoCanceller3Config::EchoModel echo_model_config_;
+  const float ep_strength_lf_;
+  const size_t filter_length_blocks_;
   std::array<float, kFftLengthBy2Plus1> R2_old_;
   std::array<int, kFftLengthBy2Plus1> R2_hold_counter_;
   std::array<float, kFftLengthBy2Plus1> X2_noise_floor_;
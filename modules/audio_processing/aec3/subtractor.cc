@@ -105,7 +105,7 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
     : fft_(),
       data_dumper_(data_dumper),
       optimization_(optimization),
-      config_(config),
+      filter_config_(config.filter),
       adaptation_during_saturation_(EnableAdaptationDuringSaturation()),
       enable_misadjustment_estimator_(EnableMisadjustmentEstimator()),
       enable_agc_gain_change_response_(EnableAgcGainChangeResponse()),
@@ -113,19 +113,19 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
       enable_shadow_filter_boosted_jumpstart_(
           EnableShadowFilterBoostedJumpstart()),
       enable_early_shadow_filter_jumpstart_(EnableEarlyShadowFilterJumpstart()),
-      main_filter_(config_.filter.main.length_blocks,
-                   config_.filter.main_initial.length_blocks,
+      main_filter_(filter_config_.main.length_blocks,
+                   filter_config_.main_initial.length_blocks,
                    config.filter.config_change_duration_blocks,
                    optimization,
                    data_dumper_),
-      shadow_filter_(config_.filter.shadow.length_blocks,
-                     config_.filter.shadow_initial.length_blocks,
+      shadow_filter_(filter_config_.shadow.length_blocks,
+                     filter_config_.shadow_initial.length_blocks,
                      config.filter.config_change_duration_blocks,
                      optimization,
                      data_dumper_),
-      G_main_(config_.filter.main_initial,
-              config_.filter.config_change_duration_blocks),
-      G_shadow_(config_.filter.shadow_initial,
+      G_main_(filter_config_.main_initial,
+              filter_config_.config_change_duration_blocks),
+      G_shadow_(filter_config_.shadow_initial,
                 config.filter.config_change_duration_blocks) {
   RTC_DCHECK(data_dumper_);
 }
@@ -139,12 +139,12 @@ void Subtractor::HandleEchoPathChange(
     shadow_filter_.HandleEchoPathChange();
     G_main_.HandleEchoPathChange(echo_path_variability);
     G_shadow_.HandleEchoPathChange();
-    G_main_.SetConfig(config_.filter.main_initial, true);
-    G_shadow_.SetConfig(config_.filter.shadow_initial, true);
-    main_filter_.SetSizePartitions(config_.filter.main_initial.length_blocks,
+    G_main_.SetConfig(filter_config_.main_initial, true);
+    G_shadow_.SetConfig(filter_config_.shadow_initial, true);
+    main_filter_.SetSizePartitions(filter_config_.main_initial.length_blocks,
                                    true);
     shadow_filter_.SetSizePartitions(
-        config_.filter.shadow_initial.length_blocks, true);
+        filter_config_.shadow_initial.length_blocks, true);
   };
 
   if (echo_path_variability.delay_change !=
@@ -158,10 +158,10 @@ void Subtractor::HandleEchoPathChange(
 }
 
 void Subtractor::ExitInitialState() {
-  G_main_.SetConfig(config_.filter.main, false);
-  G_shadow_.SetConfig(config_.filter.shadow, false);
-  main_filter_.SetSizePartitions(config_.filter.main.length_blocks, false);
-  shadow_filter_.SetSizePartitions(config_.filter.shadow.length_blocks, false);
+  G_main_.SetConfig(filter_config_.main, false);
+  G_shadow_.SetConfig(filter_config_.shadow, false);
+  main_filter_.SetSizePartitions(filter_config_.main.length_blocks, false);
+  shadow_filter_.SetSizePartitions(filter_config_.shadow.length_blocks, false);
 }
 
 void Subtractor::Process(const RenderBuffer& render_buffer,
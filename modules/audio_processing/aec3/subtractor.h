@@ -106,7 +106,7 @@ class Subtractor {
   const Aec3Fft fft_;
   ApmDataDumper* data_dumper_;
   const Aec3Optimization optimization_;
-  const EchoCanceller3Config config_;
+  const EchoCanceller3Config::Filter filter_config_;
   const bool adaptation_during_saturation_;
   const bool enable_misadjustment_estimator_;
   const bool enable_agc_gain_change_response_;
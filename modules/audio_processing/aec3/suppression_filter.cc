@@ -155,12 +155,11 @@ void SuppressionFilter::ApplyGain(
       });
     }
 
-    std::array<float, kFftLengthBy2> tmp;
+    // Delay the upper bands by one block to match the lowest band.
     for (size_t k = 1; k < e->size(); ++k) {
-      std::copy((*e)[k].begin(), (*e)[k].end(), tmp.begin());
-      std::copy(e_output_old_[k].begin(), e_output_old_[k].end(),
-                (*e)[k].begin());
-      std::copy(tmp.begin(), tmp.end(), e_output_old_[k].begin());
+      RTC_DCHECK_EQ(kFftLengthBy2, (*e)[k].size());
+      std::swap_ranges(e_output_old_[k].begin(), e_output_old_[k].end(),
+                       (*e)[k].begin());
     }
   }
 }
@@ -43,9 +43,10 @@ void AdjustForExternalFilters(std::array<float, kFftLengthBy2Plus1>* gain) {
 }
 
 // Scales the echo according to assessed audibility at the other end.
-void WeightEchoForAudibility(const EchoCanceller3Config& config,
-                             rtc::ArrayView<const float> echo,
-                             rtc::ArrayView<float> weighted_echo) {
+void WeightEchoForAudibility(
+    const EchoCanceller3Config::EchoAudibility& config,
+    rtc::ArrayView<const float> echo,
+    rtc::ArrayView<float> weighted_echo) {
   RTC_DCHECK_EQ(kFftLengthBy2Plus1, echo.size());
   RTC_DCHECK_EQ(kFftLengthBy2Plus1, weighted_echo.size());
 
@@ -62,19 +63,16 @@ void WeightEchoForAudibility(const EchoCanceller3Config& config,
     }
   };
 
-  float threshold = config.echo_audibility.floor_power *
-                    config.echo_audibility.audibility_threshold_lf;
-  float normalizer = 1.f / (threshold - config.echo_audibility.floor_power);
+  float threshold = config.floor_power * config.audibility_threshold_lf;
+  float normalizer = 1.f / (threshold - config.floor_power);
   weigh(threshold, normalizer, 0, 3, echo, weighted_echo);
 
-  threshold = config.echo_audibility.floor_power *
-              config.echo_audibility.audibility_threshold_mf;
-  normalizer = 1.f / (threshold - config.echo_audibility.floor_power);
+  threshold = config.floor_power * config.audibility_threshold_mf;
+  normalizer = 1.f / (threshold - config.floor_power);
   weigh(threshold, normalizer, 3, 7, echo, weighted_echo);
 
-  threshold = config.echo_audibility.floor_power *
-              config.echo_audibility.audibility_threshold_hf;
-  normalizer = 1.f / (threshold - config.echo_audibility.floor_power);
+  threshold = config.floor_power * config.audibility_threshold_hf;
+  normalizer = 1.f / (threshold - config.floor_power);
   weigh(threshold, normalizer, 7, kFftLengthBy2Plus1, echo, weighted_echo);
 }
 
@@ -160,7 +158,7 @@ float SuppressionGain::UpperBandsGain(
   };
   const float echo_sum = low_frequency_energy(echo_spectrum);
   const float noise_sum = low_frequency_energy(comfort_noise_spectrum);
-  const auto& cfg = config_.suppressor.high_bands_suppression;
+  const auto& cfg = suppressor_config_.high_bands_suppression;
   float gain_bound = 1.f;
   if (echo_sum > cfg.enr_threshold * noise_sum &&
       !dominant_nearend_detector_.IsNearendState()) {
@@ -204,8 +202,8 @@ void SuppressionGain::GetMinGain(
     rtc::ArrayView<float> min_gain) const {
   if (!saturated_echo) {
     const float min_echo_power =
-        low_noise_render ? config_.echo_audibility.low_render_limit
-                         : config_.echo_audibility.normal_render_limit;
+        low_noise_render ? echo_audibility_config_.low_render_limit
+                         : echo_audibility_config_.normal_render_limit;
 
     for (size_t k = 0; k < suppressor_input.size(); ++k) {
       const float denom =
@@ -236,7 +234,7 @@ void SuppressionGain::GetMaxGain(rtc::ArrayView<float> max_gain) const {
   const auto& inc = dominant_nearend_detector_.IsNearendState()
                         ? nearend_params_.max_inc_factor
                         : normal_params_.max_inc_factor;
-  const auto& floor = config_.suppressor.floor_first_increase;
+  const auto& floor = suppressor_config_.floor_first_increase;
   for (size_t k = 0; k < max_gain.size(); ++k) {
     max_gain[k] = std::min(std::max(last_gain_[k] * inc, floor), 1.f);
   }
@@ -256,7 +254,8 @@ void SuppressionGain::LowerBandGain(
   // Weight echo power in terms of audibility. // Precompute 1/weighted echo
   // (note that when the echo is zero, the precomputed value is never used).
   std::array<float, kFftLengthBy2Plus1> weighted_residual_echo;
-  WeightEchoForAudibility(config_, residual_echo, weighted_residual_echo);
+  WeightEchoForAudibility(echo_audibility_config_, residual_echo,
+                          weighted_residual_echo);
 
   std::array<float, kFftLengthBy2Plus1> min_gain;
   GetMinGain(suppressor_input, weighted_residual_echo, low_noise_render,
@@ -292,15 +291,16 @@ SuppressionGain::SuppressionGain(const EchoCanceller3Config& config,
     : data_dumper_(
           new ApmDataDumper(rtc::AtomicOps::Increment(&instance_count_))),
       optimization_(optimization),
-      config_(config),
+      suppressor_config_(config.suppressor),
+      echo_audibility_config_(config.echo_audibility),
       state_change_duration_blocks_(
-          static_cast<int>(config_.filter.config_change_duration_blocks)),
+          static_cast<int>(config.filter.config_change_duration_blocks)),
       moving_average_(kFftLengthBy2Plus1,
                       config.suppressor.nearend_average_blocks),
-      nearend_params_(config_.suppressor.nearend_tuning),
-      normal_params_(config_.suppressor.normal_tuning),
+      nearend_params_(suppressor_config_.nearend_tuning),
+      normal_params_(suppressor_config_.normal_tuning),
       dominant_nearend_detector_(
-          config_.suppressor.dominant_nearend_detection) {
+          suppressor_config_.dominant_nearend_detection) {
   RTC_DCHECK_LT(0, state_change_duration_blocks_);
   one_by_state_change_duration_blocks_ = 1.f / state_change_duration_blocks_;
   last_gain_.fill(1.f);
@@ -325,7 +325,7 @@ void SuppressionGain::GetGain(
     std::array<float, kFftLengthBy2Plus1>* low_band_gain) {
   RTC_DCHECK(high_bands_gain);
   RTC_DCHECK(low_band_gain);
-  const auto& cfg = config_.suppressor;
+  const auto& cfg = suppressor_config_;
 
   if (cfg.enforce_transparent) {
     low_band_gain->fill(1.f);
@@ -136,7 +136,8 @@ class SuppressionGain {
   static int instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
   const Aec3Optimization optimization_;
-  const EchoCanceller3Config config_;
+  const EchoCanceller3Config::Suppressor suppressor_config_;
+  const EchoCanceller3Config::EchoAudibility echo_audibility_config_;
   const int state_change_duration_blocks_;
   float one_by_state_change_duration_blocks_;
   std::array<float, kFftLengthBy2Plus1> last_gain_;
@@ -58,7 +58,8 @@ FullyConnectedLayer::FullyConnectedLayer(
       output_size_(output_size),
       bias_(bias),
       weights_(weights),
-      activation_function_(activation_function) {
+      activation_function_(activation_function),
+      vector_matrix_product_(GetVectorMatrixProductFunction()) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayersMaxUnits)
       << "Static over-allocation of fully-connected layers output vectors is "
          "not sufficient.";
@@ -75,15 +76,15 @@ rtc::ArrayView<const float> FullyConnectedLayer::GetOutput() const {
 }
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
+  RTC_DCHECK_GE(input.size(), input_size_);
   for (size_t o = 0; o < output_size_; ++o) {
     output_[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| change the performance across different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {
-      output_[o] += input[i] * weights_[i * output_size_ + o];
-    }
+  }
+  vector_matrix_product_(
+      rtc::ArrayView<const float>(input.data(), input_size_), {},
+      weights_.data(), output_size_,
+      rtc::ArrayView<float>(output_.data(), output_size_));
+  for (size_t o = 0; o < output_size_; ++o) {
     output_[o] = (*activation_function_)(kWeightsScale * output_[o]);
   }
 }
@@ -100,7 +101,8 @@ GatedRecurrentLayer::GatedRecurrentLayer(
       bias_(bias),
       weights_(weights),
       recurrent_weights_(recurrent_weights),
-      activation_function_(activation_function) {
+      activation_function_(activation_function),
+      vector_matrix_product_(GetVectorMatrixProductFunction()) {
   RTC_DCHECK_LE(output_size_, kRecurrentLayersMaxUnits)
       << "Static over-allocation of recurrent layers state vectors is not "
       << "sufficient.";
@@ -125,63 +127,68 @@ void GatedRecurrentLayer::Reset() {
 }
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
-  // Stride and offset used to read parameter arrays.
+  ComputeOutput(input, rtc::ArrayView<float>(state_.data(), output_size_));
+}
+
+void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input,
+                                        rtc::ArrayView<float> state) const {
+  RTC_DCHECK_GE(input.size(), input_size_);
+  RTC_DCHECK_EQ(state.size(), output_size_);
+  input = rtc::ArrayView<const float>(input.data(), input_size_);
+  // Stride and offset used to read parameter arrays. Each gate uses
+  // |output_size_| consecutive columns of the weight matrices.
   const size_t stride = 3 * output_size_;
   size_t offset = 0;
 
   // Compute update gates.
   std::array<float, kRecurrentLayersMaxUnits> update;
+  rtc::ArrayView<float> update_view(update.data(), output_size_);
   for (size_t o = 0; o < output_size_; ++o) {
     update[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| and |recurrent_weights_| change the performance across
-    // different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      update[o] += input[i] * weights_[i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {
-      update[o] += state_[s] * recurrent_weights_[s * stride + o];
-    }  // Add state.
+  }
+  vector_matrix_product_(input, {}, weights_.data(), stride, update_view);
+  vector_matrix_product_(state, {}, recurrent_weights_.data(), stride,
+                         update_view);
+  for (size_t o = 0; o < output_size_; ++o) {
     update[o] = SigmoidApproximated(kWeightsScale * update[o]);
   }
 
   // Compute reset gates.
   offset += output_size_;
   std::array<float, kRecurrentLayersMaxUnits> reset;
+  rtc::ArrayView<float> reset_view(reset.data(), output_size_);
   for (size_t o = 0; o < output_size_; ++o) {
     reset[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      reset[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {  // Add state.
-      reset[o] += state_[s] * recurrent_weights_[offset + s * stride + o];
-    }
+  }
+  vector_matrix_product_(input, {}, weights_.data() + offset, stride,
+                         reset_view);
+  vector_matrix_product_(state, {}, recurrent_weights_.data() + offset, stride,
+                         reset_view);
+  for (size_t o = 0; o < output_size_; ++o) {
     reset[o] = SigmoidApproximated(kWeightsScale * reset[o]);
   }
 
   // Compute output.
   offset += output_size_;
   std::array<float, kRecurrentLayersMaxUnits> output;
+  rtc::ArrayView<float> output_view(output.data(), output_size_);
   for (size_t o = 0; o < output_size_; ++o) {
     output[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      output[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_;
-         ++s) {  // Add state through reset gates.
-      output[o] +=
-          state_[s] * recurrent_weights_[offset + s * stride + o] * reset[s];
-    }
+  }
+  vector_matrix_product_(input, {}, weights_.data() + offset, stride,
+                         output_view);
+  // Add state through reset gates.
+  vector_matrix_product_(state, reset_view, recurrent_weights_.data() + offset,
+                         stride, output_view);
+  for (size_t o = 0; o < output_size_; ++o) {
     output[o] = (*activation_function_)(kWeightsScale * output[o]);
     // Update output through the update gates.
-    output[o] = update[o] * state_[o] + (1.f - update[o]) * output[o];
+    output[o] = update[o] * state[o] + (1.f - update[o]) * output[o];
   }
 
   // Update the state. Not done in the previous loop since that would pollute
   // the current state and lead to incorrect output values.
-  std::copy(output.begin(), output.end(), state_.begin());
+  std::copy(output_view.begin(), output_view.end(), state.begin());
 }
 
 RnnBasedVad::RnnBasedVad()
@@ -228,5 +235,62 @@ float RnnBasedVad::ComputeVadProbability(
   return vad_output[0];
 }
 
+RnnBasedVadBatch::RnnBasedVadBatch(size_t num_streams)
+    : num_streams_(num_streams),
+      input_layer_(kInputLayerInputSize,
+                   kInputLayerOutputSize,
+                   kInputDenseBias,
+                   kInputDenseWeights,
+                   TansigApproximated),
+      hidden_layer_(kInputLayerOutputSize,
+                    kHiddenLayerOutputSize,
+                    kHiddenGruBias,
+                    kHiddenGruWeights,
+                    kHiddenGruRecurrentWeights,
+                    RectifiedLinearUnit),
+      output_layer_(kHiddenLayerOutputSize,
+                    kOutputLayerOutputSize,
+                    kOutputDenseBias,
+                    kOutputDenseWeights,
+                    SigmoidApproximated),
+      hidden_states_(num_streams * kHiddenLayerOutputSize, 0.f) {}
+
+RnnBasedVadBatch::~RnnBasedVadBatch() = default;
+
+void RnnBasedVadBatch::Reset() {
+  std::fill(hidden_states_.begin(), hidden_states_.end(), 0.f);
+}
+
+void RnnBasedVadBatch::Reset(size_t stream) {
+  RTC_DCHECK_LT(stream, num_streams_);
+  std::fill(hidden_states_.begin() + stream * kHiddenLayerOutputSize,
+            hidden_states_.begin() + (stream + 1) * kHiddenLayerOutputSize,
+            0.f);
+}
+
+void RnnBasedVadBatch::ComputeVadProbabilities(
+    rtc::ArrayView<const float> feature_vectors,
+    rtc::ArrayView<const bool> is_silence,
+    rtc::ArrayView<float> vad_probabilities) {
+  RTC_DCHECK_EQ(feature_vectors.size(), num_streams_ * kFeatureVectorSize);
+  RTC_DCHECK_EQ(is_silence.size(), num_streams_);
+  RTC_DCHECK_EQ(vad_probabilities.size(), num_streams_);
+  for (size_t stream = 0; stream < num_streams_; ++stream) {
+    if (is_silence[stream]) {
+      Reset(stream);
+      vad_probabilities[stream] = 0.f;
+      continue;
+    }
+    rtc::ArrayView<float> state(
+        &hidden_states_[stream * kHiddenLayerOutputSize],
+        kHiddenLayerOutputSize);
+    input_layer_.ComputeOutput(feature_vectors.subview(
+        stream * kFeatureVectorSize, kFeatureVectorSize));
+    hidden_layer_.ComputeOutput(input_layer_.GetOutput(), state);
+    output_layer_.ComputeOutput(state);
+    vad_probabilities[stream] = output_layer_.GetOutput()[0];
+  }
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -14,9 +14,11 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <array>
+#include <vector>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
+#include "modules/audio_processing/agc2/rnn_vad/vector_matrix_product.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -56,6 +58,7 @@ class FullyConnectedLayer {
   const rtc::ArrayView<const int8_t> bias_;
   const rtc::ArrayView<const int8_t> weights_;
   float (*const activation_function_)(float);
+  const VectorMatrixProductFunction vector_matrix_product_;
   // The output vector of a recurrent layer has length equal to |output_size_|.
   // However, for efficiency, over-allocation is used.
   std::array<float, kFullyConnectedLayersMaxUnits> output_;
@@ -79,6 +82,11 @@ class GatedRecurrentLayer {
   void Reset();
   // Computes the recurrent layer output and updates the status.
   void ComputeOutput(rtc::ArrayView<const float> input);
+  // Same as above, but reads and updates the externally owned |state| of
+  // length output_size() instead of the layer's own state. This allows one
+  // layer to serve several independent streams.
+  void ComputeOutput(rtc::ArrayView<const float> input,
+                     rtc::ArrayView<float> state) const;
 
  private:
   const size_t input_size_;
@@ -87,6 +95,7 @@ class GatedRecurrentLayer {
   const rtc::ArrayView<const int8_t> weights_;
   const rtc::ArrayView<const int8_t> recurrent_weights_;
   float (*const activation_function_)(float);
+  const VectorMatrixProductFunction vector_matrix_product_;
   // The state vector of a recurrent layer has length equal to |output_size_|.
   // However, to avoid dynamic allocation, over-allocation is used.
   std::array<float, kRecurrentLayersMaxUnits> state_;
@@ -111,6 +120,37 @@ class RnnBasedVad {
   FullyConnectedLayer output_layer_;
 };
 
+// Recurrent network based VAD for several independent streams. The network
+// weights are shared by all the streams, and only the recurrent state is kept
+// per stream. Evaluating the streams back to back keeps the weights in cache.
+class RnnBasedVadBatch {
+ public:
+  explicit RnnBasedVadBatch(size_t num_streams);
+  RnnBasedVadBatch(const RnnBasedVadBatch&) = delete;
+  RnnBasedVadBatch& operator=(const RnnBasedVadBatch&) = delete;
+  ~RnnBasedVadBatch();
+  size_t num_streams() const { return num_streams_; }
+  // Resets the state of all the streams.
+  void Reset();
+  // Resets the state of one stream.
+  void Reset(size_t stream);
+  // Computes the probability of voice (range: [0.0, 1.0]) for every stream.
+  // |feature_vectors| contains num_streams() feature vectors back to back;
+  // |is_silence| and |vad_probabilities| have one element per stream. Gives
+  // the same results as one RnnBasedVad per stream.
+  void ComputeVadProbabilities(rtc::ArrayView<const float> feature_vectors,
+                               rtc::ArrayView<const bool> is_silence,
+                               rtc::ArrayView<float> vad_probabilities);
+
+ private:
+  const size_t num_streams_;
+  FullyConnectedLayer input_layer_;
+  GatedRecurrentLayer hidden_layer_;
+  FullyConnectedLayer output_layer_;
+  // The hidden layer states of all the streams, back to back.
+  std::vector<float> hidden_states_;
+};
+
 }  // namespace rnn_vad
 }  // namespace webrtc
 
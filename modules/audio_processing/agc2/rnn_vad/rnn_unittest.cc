@@ -174,6 +174,49 @@ TEST(RnnVadTest, RnnBitExactness) {
   }
 }
 
+// Checks that evaluating several streams with shared weights gives the same
+// VAD probabilities as one independent VAD per stream.
+TEST(RnnVadTest, BatchMatchesIndependentVads) {
+  auto features_reader = CreateSilenceFlagsFeatureMatrixReader();
+  const size_t num_frames = features_reader.second;
+  std::vector<float> silence_flags(num_frames);
+  std::vector<float> features(num_frames * kFeatureVectorSize);
+  for (size_t i = 0; i < num_frames; ++i) {
+    RTC_CHECK(features_reader.first->ReadValue(&silence_flags[i]));
+    RTC_CHECK(features_reader.first->ReadChunk(rtc::ArrayView<float>(
+        &features[i * kFeatureVectorSize], kFeatureVectorSize)));
+  }
+
+  // Each stream starts at a different frame so that the streams differ.
+  constexpr size_t kNumStreams = 3;
+  constexpr size_t kStreamOffset = 17;
+  std::vector<RnnBasedVad> vads(kNumStreams);
+  RnnBasedVadBatch batch(kNumStreams);
+  ASSERT_EQ(kNumStreams, batch.num_streams());
+  std::array<float, kNumStreams * kFeatureVectorSize> batch_features;
+  bool batch_is_silence[kNumStreams];
+  std::array<float, kNumStreams> batch_probabilities;
+  for (size_t i = 0; i < num_frames; ++i) {
+    SCOPED_TRACE(i);
+    for (size_t s = 0; s < kNumStreams; ++s) {
+      const size_t frame = (i + s * kStreamOffset) % num_frames;
+      std::copy(features.begin() + frame * kFeatureVectorSize,
+                features.begin() + (frame + 1) * kFeatureVectorSize,
+                batch_features.begin() + s * kFeatureVectorSize);
+      batch_is_silence[s] = silence_flags[frame] == 1.f;
+    }
+    batch.ComputeVadProbabilities(batch_features, batch_is_silence,
+                                  batch_probabilities);
+    for (size_t s = 0; s < kNumStreams; ++s) {
+      const float vad_probability = vads[s].ComputeVadProbability(
+          rtc::ArrayView<const float, kFeatureVectorSize>(
+              &batch_features[s * kFeatureVectorSize], kFeatureVectorSize),
+          batch_is_silence[s]);
+      EXPECT_EQ(vad_probability, batch_probabilities[s]);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -0,0 +1,147 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/vector_matrix_product.h"
+
+#include <string.h>
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace rnn_vad {
+namespace {
+
+// Computes the columns [begin, output.size()) without SIMD.
+void VectorMatrixProductColumns(rtc::ArrayView<const float> input,
+                                rtc::ArrayView<const float> scaling,
+                                const int8_t* weights,
+                                size_t stride,
+                                size_t begin,
+                                rtc::ArrayView<float> output) {
+  for (size_t o = begin; o < output.size(); ++o) {
+    float sum = output[o];
+    if (scaling.empty()) {
+      for (size_t r = 0; r < input.size(); ++r) {
+        sum += input[r] * weights[r * stride + o];
+      }
+    } else {
+      for (size_t r = 0; r < input.size(); ++r) {
+        sum += input[r] * weights[r * stride + o] * scaling[r];
+      }
+    }
+    output[o] = sum;
+  }
+}
+
+}  // namespace
+
+void VectorMatrixProduct_C(rtc::ArrayView<const float> input,
+                           rtc::ArrayView<const float> scaling,
+                           const int8_t* weights,
+                           size_t stride,
+                           rtc::ArrayView<float> output) {
+  RTC_DCHECK(scaling.empty() || scaling.size() == input.size());
+  RTC_DCHECK_LE(output.size(), stride);
+  VectorMatrixProductColumns(input, scaling, weights, stride, 0, output);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void VectorMatrixProduct_SSE2(rtc::ArrayView<const float> input,
+                              rtc::ArrayView<const float> scaling,
+                              const int8_t* weights,
+                              size_t stride,
+                              rtc::ArrayView<float> output) {
+  RTC_DCHECK(scaling.empty() || scaling.size() == input.size());
+  RTC_DCHECK_LE(output.size(), stride);
+  const size_t num_columns_sse2 = output.size() & ~static_cast<size_t>(3);
+  for (size_t o = 0; o < num_columns_sse2; o += 4) {
+    __m128 sum = _mm_loadu_ps(&output[o]);
+    for (size_t r = 0; r < input.size(); ++r) {
+      // Sign-extend four int8 weights to int32 by replicating each byte over
+      // a 32-bit lane and shifting it down arithmetically.
+      int32_t packed_weights;
+      memcpy(&packed_weights, &weights[r * stride + o], 4);
+      __m128i w = _mm_cvtsi32_si128(packed_weights);
+      w = _mm_unpacklo_epi8(w, w);
+      w = _mm_unpacklo_epi16(w, w);
+      w = _mm_srai_epi32(w, 24);
+      __m128 product = _mm_mul_ps(_mm_set1_ps(input[r]), _mm_cvtepi32_ps(w));
+      if (!scaling.empty()) {
+        product = _mm_mul_ps(product, _mm_set1_ps(scaling[r]));
+      }
+      sum = _mm_add_ps(sum, product);
+    }
+    _mm_storeu_ps(&output[o], sum);
+  }
+  VectorMatrixProductColumns(input, scaling, weights, stride, num_columns_sse2,
+                             output);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void VectorMatrixProduct_NEON(rtc::ArrayView<const float> input,
+                              rtc::ArrayView<const float> scaling,
+                              const int8_t* weights,
+                              size_t stride,
+                              rtc::ArrayView<float> output) {
+  RTC_DCHECK(scaling.empty() || scaling.size() == input.size());
+  RTC_DCHECK_LE(output.size(), stride);
+  const size_t num_columns_neon = output.size() & ~static_cast<size_t>(7);
+  for (size_t o = 0; o < num_columns_neon; o += 8) {
+    float32x4_t sum_low = vld1q_f32(&output[o]);
+    float32x4_t sum_high = vld1q_f32(&output[o + 4]);
+    for (size_t r = 0; r < input.size(); ++r) {
+      const int16x8_t w = vmovl_s8(vld1_s8(&weights[r * stride + o]));
+      const float32x4_t w_low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(w)));
+      const float32x4_t w_high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(w)));
+      const float32x4_t x = vdupq_n_f32(input[r]);
+      // Multiply and add separately, since a fused multiply-add would round
+      // differently from the other implementations.
+      float32x4_t product_low = vmulq_f32(x, w_low);
+      float32x4_t product_high = vmulq_f32(x, w_high);
+      if (!scaling.empty()) {
+        const float32x4_t s = vdupq_n_f32(scaling[r]);
+        product_low = vmulq_f32(product_low, s);
+        product_high = vmulq_f32(product_high, s);
+      }
+      sum_low = vaddq_f32(sum_low, product_low);
+      sum_high = vaddq_f32(sum_high, product_high);
+    }
+    vst1q_f32(&output[o], sum_low);
+    vst1q_f32(&output[o + 4], sum_high);
+  }
+  VectorMatrixProductColumns(input, scaling, weights, stride, num_columns_neon,
+                             output);
+}
+#endif
+
+VectorMatrixProductFunction GetVectorMatrixProductFunction() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return VectorMatrixProduct_AVX2;
+  }
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    return VectorMatrixProduct_SSE2;
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  return VectorMatrixProduct_NEON;
+#endif
+  return VectorMatrixProduct_C;
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_VECTOR_MATRIX_PRODUCT_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_VECTOR_MATRIX_PRODUCT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+// Kernels computing the product of a row vector and an int8 weight matrix, as
+// used by the layers of the recurrent network. For each output column |o|,
+//   output[o] += sum_r input[r] * weights[r * stride + o]
+// or, if |scaling| is not empty,
+//   output[o] += sum_r input[r] * weights[r * stride + o] * scaling[r].
+// The rows are accumulated in order and without fused multiply-adds, so all
+// the implementations are bitexact to each other and to a scalar loop over
+// |r| for each |o|.
+using VectorMatrixProductFunction =
+    void (*)(rtc::ArrayView<const float> input,
+             rtc::ArrayView<const float> scaling,
+             const int8_t* weights,
+             size_t stride,
+             rtc::ArrayView<float> output);
+
+void VectorMatrixProduct_C(rtc::ArrayView<const float> input,
+                           rtc::ArrayView<const float> scaling,
+                           const int8_t* weights,
+                           size_t stride,
+                           rtc::ArrayView<float> output);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void VectorMatrixProduct_SSE2(rtc::ArrayView<const float> input,
+                              rtc::ArrayView<const float> scaling,
+                              const int8_t* weights,
+                              size_t stride,
+                              rtc::ArrayView<float> output);
+void VectorMatrixProduct_AVX2(rtc::ArrayView<const float> input,
+                              rtc::ArrayView<const float> scaling,
+                              const int8_t* weights,
+                              size_t stride,
+                              rtc::ArrayView<float> output);
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void VectorMatrixProduct_NEON(rtc::ArrayView<const float> input,
+                              rtc::ArrayView<const float> scaling,
+                              const int8_t* weights,
+                              size_t stride,
+                              rtc::ArrayView<float> output);
+#endif
+
+// Returns the fastest implementation supported by the CPU.
+VectorMatrixProductFunction GetVectorMatrixProductFunction();
+
+}  // namespace rnn_vad
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_VECTOR_MATRIX_PRODUCT_H_
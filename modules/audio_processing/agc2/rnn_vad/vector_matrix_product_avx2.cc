@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/vector_matrix_product.h"
+
+#include <immintrin.h>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+void VectorMatrixProduct_AVX2(rtc::ArrayView<const float> input,
+                              rtc::ArrayView<const float> scaling,
+                              const int8_t* weights,
+                              size_t stride,
+                              rtc::ArrayView<float> output) {
+  RTC_DCHECK(scaling.empty() || scaling.size() == input.size());
+  RTC_DCHECK_LE(output.size(), stride);
+  const size_t num_columns_avx2 = output.size() & ~static_cast<size_t>(7);
+  for (size_t o = 0; o < num_columns_avx2; o += 8) {
+    __m256 sum = _mm256_loadu_ps(&output[o]);
+    for (size_t r = 0; r < input.size(); ++r) {
+      const __m128i packed_weights = _mm_loadl_epi64(
+          reinterpret_cast<const __m128i*>(&weights[r * stride + o]));
+      const __m256 w = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(packed_weights));
+      __m256 product = _mm256_mul_ps(_mm256_set1_ps(input[r]), w);
+      if (!scaling.empty()) {
+        product = _mm256_mul_ps(product, _mm256_set1_ps(scaling[r]));
+      }
+      sum = _mm256_add_ps(sum, product);
+    }
+    _mm256_storeu_ps(&output[o], sum);
+  }
+  // The remaining columns, e.g., the single one of the output layer, are
+  // handled by the SSE2 version.
+  VectorMatrixProduct_SSE2(
+      input, scaling, weights + num_columns_avx2, stride,
+      output.subview(num_columns_avx2, output.size() - num_columns_avx2));
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/vector_matrix_product.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace rnn_vad {
+namespace test {
+namespace {
+
+std::vector<VectorMatrixProductFunction> GetOptimizedFunctions() {
+  std::vector<VectorMatrixProductFunction> functions;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    functions.push_back(VectorMatrixProduct_SSE2);
+  }
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    functions.push_back(VectorMatrixProduct_AVX2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  functions.push_back(VectorMatrixProduct_NEON);
+#endif
+  return functions;
+}
+
+// Checks that the optimized kernels are bitexact to the reference one for
+// a |rows| x |columns| sub-matrix of a matrix with |stride| columns.
+void VerifyBitexactness(size_t rows,
+                        size_t columns,
+                        size_t stride,
+                        bool use_scaling) {
+  Random random(42);
+  std::vector<float> input(rows);
+  std::vector<float> scaling(use_scaling ? rows : 0);
+  std::vector<int8_t> weights(rows * stride);
+  std::vector<float> initial_output(columns);
+  for (auto& x : input) {
+    x = random.Rand<float>() * 2.f - 1.f;
+  }
+  for (auto& s : scaling) {
+    s = random.Rand<float>();
+  }
+  for (auto& w : weights) {
+    w = static_cast<int8_t>(random.Rand(-128, 127));
+  }
+  for (auto& y : initial_output) {
+    y = random.Rand<float>() * 256.f - 128.f;
+  }
+
+  std::vector<float> expected(initial_output);
+  VectorMatrixProduct_C(input, scaling, weights.data(), stride, expected);
+  for (auto function : GetOptimizedFunctions()) {
+    std::vector<float> output(initial_output);
+    function(input, scaling, weights.data(), stride, output);
+    for (size_t o = 0; o < columns; ++o) {
+      EXPECT_EQ(expected[o], output[o]) << "column " << o;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(RnnVadTest, VectorMatrixProductReference) {
+  const std::vector<float> input = {1.f, -2.f};
+  const std::vector<float> scaling = {0.5f, 0.25f};
+  const std::vector<int8_t> weights = {1, 2, 3, 4, 5, 6};
+  std::vector<float> output = {10.f, 20.f};
+  VectorMatrixProduct_C(input, {}, weights.data(), 3, output);
+  EXPECT_EQ(10.f + 1.f - 8.f, output[0]);
+  EXPECT_EQ(20.f + 2.f - 10.f, output[1]);
+  output = {0.f, 0.f};
+  VectorMatrixProduct_C(input, scaling, weights.data(), 3, output);
+  EXPECT_EQ(0.5f - 2.f, output[0]);
+  EXPECT_EQ(1.f - 2.5f, output[1]);
+}
+
+TEST(RnnVadTest, OptimizedVectorMatrixProductBitexactness) {
+  for (size_t columns : {1, 7, 8, 13, 24, 33}) {
+    for (bool use_scaling : {false, true}) {
+      SCOPED_TRACE(columns);
+      SCOPED_TRACE(use_scaling);
+      VerifyBitexactness(24, columns, columns, use_scaling);
+      VerifyBitexactness(24, columns, 3 * columns, use_scaling);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace rnn_vad
+}  // namespace webrtc
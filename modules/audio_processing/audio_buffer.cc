@@ -379,21 +379,16 @@ void AudioBuffer::DeinterleaveFrom(AudioFrame* frame) {
   }
   activity_ = frame->vad_activity_;
 
-  int16_t* const* deinterleaved;
-  if (input_num_frames_ == proc_num_frames_) {
-    deinterleaved = data_->ibuf()->channels();
-  } else {
-    deinterleaved = input_buffer_->ibuf()->channels();
-  }
+  IFChannelBuffer* const input_buffer =
+      input_num_frames_ == proc_num_frames_ ? data_.get() : input_buffer_.get();
   // TODO(yujo): handle muted frames more efficiently.
-  if (num_proc_channels_ == 1) {
-    // Downmix and deinterleave simultaneously.
-    DownmixInterleavedToMono(frame->data(), input_num_frames_,
-                             num_input_channels_, deinterleaved[0]);
+  if (frame->has_float_data()) {
+    // The frame carries FloatS16 samples, which are used as is instead of
+    // being converted from int16.
+    DeinterleaveFrameData(frame->float_data(),
+                          input_buffer->fbuf()->channels());
   } else {
-    RTC_DCHECK_EQ(num_proc_channels_, num_input_channels_);
-    Deinterleave(frame->data(), input_num_frames_, num_proc_channels_,
-                 deinterleaved);
+    DeinterleaveFrameData(frame->data(), input_buffer->ibuf()->channels());
   }
 
   // Resample.
@@ -427,12 +422,39 @@ void AudioBuffer::InterleaveTo(AudioFrame* frame, bool data_changed) const {
   }
 
   // TODO(yujo): handle muted frames more efficiently.
-  if (frame->num_channels_ == num_channels_) {
-    Interleave(data_ptr->ibuf()->channels(), output_num_frames_, num_channels_,
-               frame->mutable_data());
+  if (frame->has_float_data()) {
+    // Keep the output in FloatS16 if the input was.
+    InterleaveFrameData(data_ptr->fbuf_const()->channels(),
+                        frame->num_channels_, frame->mutable_float_data());
+  } else {
+    InterleaveFrameData(data_ptr->ibuf()->channels(),
+                        frame->num_channels_, frame->mutable_data());
+  }
+}
+
+template <typename T>
+void AudioBuffer::DeinterleaveFrameData(const T* interleaved,
+                                        T* const* deinterleaved) const {
+  if (num_proc_channels_ == 1) {
+    // Downmix and deinterleave simultaneously.
+    DownmixInterleavedToMono(interleaved, input_num_frames_,
+                             num_input_channels_, deinterleaved[0]);
+  } else {
+    RTC_DCHECK_EQ(num_proc_channels_, num_input_channels_);
+    Deinterleave(interleaved, input_num_frames_, num_proc_channels_,
+                 deinterleaved);
+  }
+}
+
+template <typename T>
+void AudioBuffer::InterleaveFrameData(const T* const* deinterleaved,
+                                      size_t num_frame_channels,
+                                      T* interleaved) const {
+  if (num_frame_channels == num_channels_) {
+    Interleave(deinterleaved, output_num_frames_, num_channels_, interleaved);
   } else {
-    UpmixMonoToInterleaved(data_ptr->ibuf()->channels()[0], output_num_frames_,
-                           frame->num_channels_, frame->mutable_data());
+    UpmixMonoToInterleaved(deinterleaved[0], output_num_frames_,
+                           num_frame_channels, interleaved);
   }
 }
 
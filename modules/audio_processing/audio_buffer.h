@@ -104,10 +104,11 @@ class AudioBuffer {
   void set_activity(AudioFrame::VADActivity activity);
   AudioFrame::VADActivity activity() const;
 
-  // Use for int16 interleaved data.
+  // Use for interleaved data in AudioFrames. The float samples are used if the
+  // frame carries them, and the int16 samples otherwise.
   void DeinterleaveFrom(AudioFrame* audioFrame);
   // If |data_changed| is false, only the non-audio data members will be copied
-  // to |frame|.
+  // to |frame|. Writes float samples if |frame| carries them.
   void InterleaveTo(AudioFrame* frame, bool data_changed) const;
 
   // Use for float deinterleaved data.
@@ -125,6 +126,15 @@ class AudioBuffer {
                            SetNumChannelsSetsChannelBuffersNumChannels);
   // Called from DeinterleaveFrom() and CopyFrom().
   void InitForNewData();
+  // Helpers of DeinterleaveFrom() and InterleaveTo() for int16 and float
+  // samples.
+  template <typename T>
+  void DeinterleaveFrameData(const T* interleaved,
+                             T* const* deinterleaved) const;
+  template <typename T>
+  void InterleaveFrameData(const T* const* deinterleaved,
+                           size_t num_frame_channels,
+                           T* interleaved) const;
 
   // The audio is passed into DeinterleaveFrom() or CopyFrom() with input
   // format (samples per channel and number of channels).
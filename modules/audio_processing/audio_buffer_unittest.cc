@@ -38,6 +38,34 @@ TEST(AudioBufferTest, SetNumChannelsSetsChannelBuffersNumChannels) {
   ExpectNumChannels(ab, kStereo);
 }
 
+TEST(AudioBufferTest, FloatFrameSamplesAreNotRounded) {
+  AudioFrame frame;
+  frame.UpdateFrame(0, nullptr, kNumFrames, 48000, AudioFrame::kNormalSpeech,
+                    AudioFrame::kVadActive, kStereo);
+  float* frame_data = frame.mutable_float_data();
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    frame_data[2 * i] = i + 0.25f;
+    frame_data[2 * i + 1] = -0.5f * i;
+  }
+
+  AudioBuffer ab(kNumFrames, kStereo, kNumFrames, kStereo, kNumFrames);
+  ab.DeinterleaveFrom(&frame);
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    EXPECT_EQ(i + 0.25f, ab.data_f()->channels()[0][i]);
+    EXPECT_EQ(-0.5f * i, ab.data_f()->channels()[1][i]);
+  }
+
+  ab.channels_f()[0][0] = 7.75f;
+  ab.InterleaveTo(&frame, true);
+  ASSERT_TRUE(frame.has_float_data());
+  EXPECT_EQ(7.75f, frame.float_data()[0]);
+  EXPECT_EQ(8, frame.data()[0]);
+  for (size_t i = 1; i < kNumFrames; ++i) {
+    EXPECT_EQ(i + 0.25f, frame.float_data()[2 * i]);
+    EXPECT_EQ(-0.5f * i, frame.float_data()[2 * i + 1]);
+  }
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 TEST(AudioBufferTest, SetNumChannelsDeathTest) {
   AudioBuffer ab(kNumFrames, kMono, kNumFrames, kMono, kNumFrames);
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/audio_processing_batch.h"
+
+#include <algorithm>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/atomicops.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+
+namespace webrtc {
+
+AudioProcessingBatch::AudioProcessingBatch(size_t num_worker_queues) {
+  worker_queues_.reserve(num_worker_queues);
+  for (size_t i = 0; i < num_worker_queues; ++i) {
+    worker_queues_.push_back(absl::make_unique<rtc::TaskQueue>(
+        "AudioProcessingBatch", rtc::TaskQueue::Priority::HIGH));
+  }
+}
+
+AudioProcessingBatch::~AudioProcessingBatch() = default;
+
+void AudioProcessingBatch::AddStream(rtc::scoped_refptr<AudioProcessing> apm) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK(apm);
+  streams_.push_back(std::move(apm));
+}
+
+void AudioProcessingBatch::RemoveStream(AudioProcessing* apm) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  auto it = std::find_if(streams_.begin(), streams_.end(),
+                         [apm](const rtc::scoped_refptr<AudioProcessing>& s) {
+                           return s.get() == apm;
+                         });
+  RTC_DCHECK(it != streams_.end());
+  if (it != streams_.end())
+    streams_.erase(it);
+}
+
+size_t AudioProcessingBatch::num_streams() const {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  return streams_.size();
+}
+
+int AudioProcessingBatch::ProcessStreams(
+    rtc::ArrayView<AudioFrame* const> frames) {
+  return ProcessAll(frames, &AudioProcessing::ProcessStream);
+}
+
+int AudioProcessingBatch::ProcessReverseStreams(
+    rtc::ArrayView<AudioFrame* const> frames) {
+  return ProcessAll(frames, &AudioProcessing::ProcessReverseStream);
+}
+
+int AudioProcessingBatch::ProcessAll(
+    rtc::ArrayView<AudioFrame* const> frames,
+    int (AudioProcessing::*process)(AudioFrame*)) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK_EQ(streams_.size(), frames.size());
+  const size_t num_streams = std::min(streams_.size(), frames.size());
+  const size_t num_shards =
+      std::max<size_t>(1, std::min(worker_queues_.size() + 1, num_streams));
+
+  // The first error of each shard, written only by the thread running it.
+  std::vector<int> shard_errors(num_shards, AudioProcessing::kNoError);
+  auto process_shard = [&](size_t shard) {
+    const size_t begin = shard * num_streams / num_shards;
+    const size_t end = (shard + 1) * num_streams / num_shards;
+    for (size_t i = begin; i < end; ++i) {
+      const int error = ((*streams_[i]).*process)(frames[i]);
+      if (error != AudioProcessing::kNoError &&
+          shard_errors[shard] == AudioProcessing::kNoError) {
+        shard_errors[shard] = error;
+      }
+    }
+  };
+
+  rtc::Event done(false, false);
+  volatile int pending_shards = static_cast<int>(num_shards - 1);
+  for (size_t shard = 1; shard < num_shards; ++shard) {
+    worker_queues_[shard - 1]->PostTask([&, shard] {
+      process_shard(shard);
+      if (rtc::AtomicOps::Decrement(&pending_shards) == 0)
+        done.Set();
+    });
+  }
+  process_shard(0);
+  if (num_shards > 1)
+    done.Wait(rtc::Event::kForever);
+
+  for (int error : shard_errors) {
+    if (error != AudioProcessing::kNoError)
+      return error;
+  }
+  return AudioProcessing::kNoError;
+}
+
+}  // namespace webrtc
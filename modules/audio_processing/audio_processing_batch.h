@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
+#define MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_checker.h"
+
+namespace webrtc {
+
+class AudioFrame;
+
+// Processes the 10 ms frames of many independent streams, each with its own
+// AudioProcessing instance, in one call. Intended for servers that run one
+// AudioProcessing instance per participant.
+//
+// The streams are split into contiguous shards, one per worker task queue
+// plus one for the calling thread, so that the streams of a shard are always
+// processed on the same thread, one after the other. With zero worker queues
+// all streams are processed on the calling thread.
+//
+// All methods must be called on the same thread.
+class AudioProcessingBatch {
+ public:
+  explicit AudioProcessingBatch(size_t num_worker_queues);
+  ~AudioProcessingBatch();
+
+  // Adds |apm| as the last stream of the batch.
+  void AddStream(rtc::scoped_refptr<AudioProcessing> apm);
+  // Removes |apm| from the batch. The order of the remaining streams is kept.
+  void RemoveStream(AudioProcessing* apm);
+  size_t num_streams() const;
+
+  // Calls ProcessStream(frames[i]) on the i-th stream for all streams.
+  // |frames| must have one frame per stream. Returns
+  // AudioProcessing::kNoError if all streams succeeded, and otherwise the
+  // error of the first stream that failed.
+  int ProcessStreams(rtc::ArrayView<AudioFrame* const> frames);
+
+  // Calls ProcessReverseStream(frames[i]) on the i-th stream for all streams,
+  // with the same requirements and return value as ProcessStreams().
+  int ProcessReverseStreams(rtc::ArrayView<AudioFrame* const> frames);
+
+ private:
+  // Runs |process| for each stream and frame, sharded over the worker queues
+  // and the calling thread.
+  int ProcessAll(rtc::ArrayView<AudioFrame* const> frames,
+                 int (AudioProcessing::*process)(AudioFrame*));
+
+  rtc::ThreadChecker thread_checker_;
+  std::vector<rtc::scoped_refptr<AudioProcessing>> streams_
+      RTC_GUARDED_BY(thread_checker_);
+  std::vector<std::unique_ptr<rtc::TaskQueue>> worker_queues_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AudioProcessingBatch);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
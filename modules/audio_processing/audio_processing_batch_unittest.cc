@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/audio_processing_batch.h"
+
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "modules/audio_processing/include/mock_audio_processing.h"
+#include "rtc_base/refcountedobject.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+using ::testing::Return;
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumStreams = 7;
+
+struct BatchTestStreams {
+  BatchTestStreams() : frames(kNumStreams), frame_ptrs(kNumStreams) {
+    for (size_t i = 0; i < kNumStreams; ++i) {
+      apms.push_back(new rtc::RefCountedObject<test::MockAudioProcessing>());
+      frame_ptrs[i] = &frames[i];
+    }
+  }
+
+  void AddTo(AudioProcessingBatch* batch) {
+    for (auto& apm : apms)
+      batch->AddStream(apm);
+  }
+
+  std::vector<rtc::scoped_refptr<test::MockAudioProcessing>> apms;
+  std::vector<AudioFrame> frames;
+  std::vector<AudioFrame*> frame_ptrs;
+};
+
+}  // namespace
+
+TEST(AudioProcessingBatchTest, ProcessesEachFrameWithItsStream) {
+  for (size_t num_worker_queues : {0, 1, 3, 10}) {
+    AudioProcessingBatch batch(num_worker_queues);
+    BatchTestStreams streams;
+    streams.AddTo(&batch);
+    EXPECT_EQ(kNumStreams, batch.num_streams());
+
+    for (size_t i = 0; i < kNumStreams; ++i) {
+      EXPECT_CALL(*streams.apms[i], ProcessStream(&streams.frames[i]))
+          .WillOnce(Return(AudioProcessing::kNoError));
+      EXPECT_CALL(*streams.apms[i], ProcessReverseStream(&streams.frames[i]))
+          .WillOnce(Return(AudioProcessing::kNoError));
+    }
+    EXPECT_EQ(AudioProcessing::kNoError,
+              batch.ProcessStreams(streams.frame_ptrs));
+    EXPECT_EQ(AudioProcessing::kNoError,
+              batch.ProcessReverseStreams(streams.frame_ptrs));
+  }
+}
+
+TEST(AudioProcessingBatchTest, ReturnsErrorOfFirstFailingStream) {
+  for (size_t num_worker_queues : {0, 3}) {
+    AudioProcessingBatch batch(num_worker_queues);
+    BatchTestStreams streams;
+    streams.AddTo(&batch);
+
+    for (size_t i = 0; i < kNumStreams; ++i) {
+      int result = AudioProcessing::kNoError;
+      if (i == 2)
+        result = AudioProcessing::kBadDataLengthError;
+      else if (i == 5)
+        result = AudioProcessing::kBadSampleRateError;
+      EXPECT_CALL(*streams.apms[i], ProcessStream(&streams.frames[i]))
+          .WillOnce(Return(result));
+    }
+    EXPECT_EQ(AudioProcessing::kBadDataLengthError,
+              batch.ProcessStreams(streams.frame_ptrs));
+  }
+}
+
+TEST(AudioProcessingBatchTest, RemoveStreamKeepsOrderOfRemainingStreams) {
+  AudioProcessingBatch batch(2);
+  BatchTestStreams streams;
+  streams.AddTo(&batch);
+  batch.RemoveStream(streams.apms[3].get());
+  ASSERT_EQ(kNumStreams - 1, batch.num_streams());
+
+  std::vector<AudioFrame*> frame_ptrs = streams.frame_ptrs;
+  frame_ptrs.erase(frame_ptrs.begin() + 3);
+  EXPECT_CALL(*streams.apms[3], ProcessStream(testing::_)).Times(0);
+  for (size_t i = 0; i < kNumStreams; ++i) {
+    if (i == 3)
+      continue;
+    EXPECT_CALL(*streams.apms[i], ProcessStream(&streams.frames[i]))
+        .WillOnce(Return(AudioProcessing::kNoError));
+  }
+  EXPECT_EQ(AudioProcessing::kNoError, batch.ProcessStreams(frame_ptrs));
+}
+
+}  // namespace webrtc
@@ -386,12 +386,6 @@ AudioProcessingImpl::AudioProcessingImpl(
         new GainControlForExperimentalAgc(
             public_submodules_->gain_control.get(), &crit_capture_));
 
-    // If no echo detector is injected, use the ResidualEchoDetector.
-    if (!private_submodules_->echo_detector) {
-      private_submodules_->echo_detector =
-          new rtc::RefCountedObject<ResidualEchoDetector>();
-    }
-
     private_submodules_->echo_cancellation.reset(new EchoCancellationImpl());
     private_submodules_->echo_control_mobile.reset(new EchoControlMobileImpl());
     // TODO(alessiob): Move the injected gain controller once injection is
@@ -692,6 +686,11 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
     private_submodules_->output_level_estimator->Enable(true);
   }
 
+  if (config_.residual_echo_detector.enabled &&
+      !private_submodules_->echo_detector) {
+    InitializeResidualEchoDetector();
+  }
+
   if (config_.voice_detection.enabled && !private_submodules_->voice_detector) {
     private_submodules_->voice_detector.reset(
         new VoiceDetectionImpl(&crit_capture_));
@@ -835,6 +834,7 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
   TRACE_EVENT0("webrtc", "AudioProcessing::ProcessStream_StreamConfig");
   ProcessingConfig processing_config;
   bool reinitialization_required = false;
+  bool format_changed = false;
   {
     // Acquire the capture lock in order to safely call the function
     // that retrieves the render side data. This function accesses apm
@@ -848,13 +848,14 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
 
     processing_config = formats_.api_format;
     reinitialization_required = UpdateActiveSubmoduleStates();
+    processing_config.input_stream() = input_config;
+    processing_config.output_stream() = output_config;
+    format_changed = processing_config != formats_.api_format;
   }
 
-  processing_config.input_stream() = input_config;
-  processing_config.output_stream() = output_config;
-
-  {
-    // Do conditional reinitialization.
+  if (reinitialization_required || format_changed) {
+    // Do conditional reinitialization. The render lock is only taken when
+    // needed, to not make the capture side wait for render processing.
     rtc::CritScope cs_render(&crit_render_);
     RETURN_ON_ERR(
         MaybeInitializeCapture(processing_config, reinitialization_required));
@@ -933,12 +934,13 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
 
   // Insert the samples into the queue.
   if (!aec_render_signal_queue_->Insert(&aec_render_queue_buffer_)) {
-    // The data queue is full and needs to be emptied.
-    EmptyQueuedRenderAudio();
-
-    // Retry the insert (should always work).
-    bool result = aec_render_signal_queue_->Insert(&aec_render_queue_buffer_);
-    RTC_DCHECK(result);
+    // The data queue is full and needs to be emptied. If the capture side
+    // is busy it will empty the queue itself, and the frame is dropped.
+    if (TryEmptyQueuedRenderAudio()) {
+      // Retry the insert (should always work).
+      bool result = aec_render_signal_queue_->Insert(&aec_render_queue_buffer_);
+      RTC_DCHECK(result);
+    }
   }
 
   EchoControlMobileImpl::PackRenderAudioBuffer(audio, num_output_channels(),
@@ -947,24 +949,28 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
 
   // Insert the samples into the queue.
   if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_)) {
-    // The data queue is full and needs to be emptied.
-    EmptyQueuedRenderAudio();
-
-    // Retry the insert (should always work).
-    bool result = aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
-    RTC_DCHECK(result);
+    // The data queue is full and needs to be emptied. If the capture side
+    // is busy it will empty the queue itself, and the frame is dropped.
+    if (TryEmptyQueuedRenderAudio()) {
+      // Retry the insert (should always work).
+      bool result =
+          aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
+      RTC_DCHECK(result);
+    }
   }
 
   if (!constants_.use_experimental_agc) {
     GainControlImpl::PackRenderAudioBuffer(audio, &agc_render_queue_buffer_);
     // Insert the samples into the queue.
     if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. If the capture side
+      // is busy it will empty the queue itself, and the frame is dropped.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
+        RTC_DCHECK(result);
+      }
     }
   }
 }
@@ -974,12 +980,13 @@ void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
 
   // Insert the samples into the queue.
   if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_)) {
-    // The data queue is full and needs to be emptied.
-    EmptyQueuedRenderAudio();
-
-    // Retry the insert (should always work).
-    bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
-    RTC_DCHECK(result);
+    // The data queue is full and needs to be emptied. If the capture side
+    // is busy it will empty the queue itself, and the frame is dropped.
+    if (TryEmptyQueuedRenderAudio()) {
+      // Retry the insert (should always work).
+      bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
+      RTC_DCHECK(result);
+    }
   }
 }
 
@@ -1106,6 +1113,17 @@ void AudioProcessingImpl::EmptyQueuedRenderAudio() {
   }
 }
 
+bool AudioProcessingImpl::TryEmptyQueuedRenderAudio() {
+  // Never block the render side on the capture lock, as that would make the
+  // render thread wait for a complete capture frame to be processed.
+  rtc::TryCritScope cs_capture(&crit_capture_);
+  if (!cs_capture.locked()) {
+    return false;
+  }
+  EmptyQueuedRenderAudio();
+  return true;
+}
+
 int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
   TRACE_EVENT0("webrtc", "AudioProcessing::ProcessStream_AudioFrame");
   {
@@ -1129,6 +1147,7 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
 
   ProcessingConfig processing_config;
   bool reinitialization_required = false;
+  bool format_changed = false;
   {
     // Aquire lock for the access of api_format.
     // The lock is released immediately due to the conditional
@@ -1139,14 +1158,17 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
     processing_config = formats_.api_format;
 
     reinitialization_required = UpdateActiveSubmoduleStates();
+    processing_config.input_stream().set_sample_rate_hz(frame->sample_rate_hz_);
+    processing_config.input_stream().set_num_channels(frame->num_channels_);
+    processing_config.output_stream().set_sample_rate_hz(
+        frame->sample_rate_hz_);
+    processing_config.output_stream().set_num_channels(frame->num_channels_);
+    format_changed = processing_config != formats_.api_format;
   }
-  processing_config.input_stream().set_sample_rate_hz(frame->sample_rate_hz_);
-  processing_config.input_stream().set_num_channels(frame->num_channels_);
-  processing_config.output_stream().set_sample_rate_hz(frame->sample_rate_hz_);
-  processing_config.output_stream().set_num_channels(frame->num_channels_);
 
-  {
-    // Do conditional reinitialization.
+  if (reinitialization_required || format_changed) {
+    // Do conditional reinitialization. The render lock is only taken when
+    // needed, to not make the capture side wait for render processing.
     rtc::CritScope cs_render(&crit_render_);
     RETURN_ON_ERR(
         MaybeInitializeCapture(processing_config, reinitialization_required));
@@ -1520,7 +1542,9 @@ int AudioProcessingImpl::ProcessRenderStreamLocked() {
     private_submodules_->render_pre_processor->Process(render_buffer);
   }
 
-  QueueNonbandedRenderAudio(render_buffer);
+  if (private_submodules_->echo_detector) {
+    QueueNonbandedRenderAudio(render_buffer);
+  }
 
   if (submodule_states_.RenderMultiBandSubModulesActive() &&
       SampleRateSupportsMultiBand(
@@ -1772,7 +1796,16 @@ void AudioProcessingImpl::InitializePreAmplifier() {
 }
 
 void AudioProcessingImpl::InitializeResidualEchoDetector() {
-  RTC_DCHECK(private_submodules_->echo_detector);
+  // If no echo detector is injected, the ResidualEchoDetector is created when
+  // it is first enabled, to not allocate its buffers when it is not used.
+  if (config_.residual_echo_detector.enabled &&
+      !private_submodules_->echo_detector) {
+    private_submodules_->echo_detector =
+        new rtc::RefCountedObject<ResidualEchoDetector>();
+  }
+  if (!private_submodules_->echo_detector) {
+    return;
+  }
   private_submodules_->echo_detector->Initialize(
       proc_sample_rate_hz(), 1,
       formats_.render_processing_format.sample_rate_hz(), 1);
@@ -257,6 +257,9 @@ class AudioProcessingImpl : public AudioProcessing {
   void HandleRenderRuntimeSettings() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
 
   void EmptyQueuedRenderAudio();
+  // Empties the render queues if the capture lock can be taken without
+  // blocking. Returns false if the capture side currently holds the lock.
+  bool TryEmptyQueuedRenderAudio();
   void AllocateRenderQueue()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_, crit_capture_);
   void QueueBandedRenderAudio(AudioBuffer* audio)
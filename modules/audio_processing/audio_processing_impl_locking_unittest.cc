@@ -1100,6 +1100,74 @@ void RenderProcessor::ApplyRuntimeSettingScheme() {
                frame_data_.input_number_of_channels);
 }
 
+// Calls one side of APM a fixed number of times without pacing it against the
+// other side, so that the render side can run far ahead of the capture side.
+class UnpacedStreamProcessor {
+ public:
+  UnpacedStreamProcessor(AudioProcessing* apm,
+                         bool render_side,
+                         int num_calls,
+                         int max_sleep_ms)
+      : apm_(apm),
+        render_side_(render_side),
+        max_sleep_ms_(max_sleep_ms),
+        num_calls_(num_calls),
+        thread_(ThreadFunc,
+                this,
+                render_side ? "render" : "capture",
+                rtc::kRealtimePriority) {
+    frame_.sample_rate_hz_ = 16000;
+    frame_.num_channels_ = 1;
+    frame_.samples_per_channel_ = 160;
+  }
+
+  void Start() { thread_.Start(); }
+
+  // Waits for all calls to be done and returns false on timeout.
+  bool WaitAndStop(int timeout_ms) {
+    const bool done = done_.Wait(timeout_ms);
+    thread_.Stop();
+    return done;
+  }
+
+  int num_errors() const { return num_errors_; }
+
+ private:
+  static void ThreadFunc(void* context) {
+    static_cast<UnpacedStreamProcessor*>(context)->Process();
+  }
+
+  void Process() {
+    for (int k = 0; k < num_calls_; ++k) {
+      PopulateAudioFrame(&frame_, render_side_ ? 16384 : 1024, &rand_gen_);
+      int result;
+      if (render_side_) {
+        result = apm_->ProcessReverseStream(&frame_);
+      } else {
+        apm_->set_stream_delay_ms(30);
+        result = apm_->ProcessStream(&frame_);
+      }
+      if (result != AudioProcessing::kNoError) {
+        ++num_errors_;
+      }
+      if (max_sleep_ms_ > 0) {
+        SleepRandomMs(max_sleep_ms_, &rand_gen_);
+      }
+    }
+    done_.Set();
+  }
+
+  AudioProcessing* const apm_;
+  const bool render_side_;
+  const int max_sleep_ms_;
+  const int num_calls_;
+  int num_errors_ = 0;
+  AudioFrame frame_;
+  RandomGenerator rand_gen_;
+  rtc::Event done_;
+  rtc::PlatformThread thread_;
+};
+
 }  // anonymous namespace
 
 TEST_P(AudioProcessingImplLockTest, LockTest) {
@@ -1107,6 +1175,34 @@ TEST_P(AudioProcessingImplLockTest, LockTest) {
   ASSERT_TRUE(RunTest());
 }
 
+// Lets the render side run unpaced while the capture side is slow, which makes
+// the render queues overflow while capture processing is ongoing. The render
+// side must neither block on nor deadlock with the capture side. The echo
+// canceller is left disabled, as its own far-end buffer does not allow the
+// render side to be this far ahead.
+TEST(AudioProcessingImplLockStressTest, UnpacedRenderWithSlowCapture) {
+  constexpr int kNumRenderCalls = 2000;
+  constexpr int kNumCaptureCalls = 200;
+  constexpr int kTimeOutMs = 60 * 1000;
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  ASSERT_EQ(AudioProcessing::kNoError, apm->gain_control()->Enable(true));
+  ASSERT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->set_mode(GainControl::kAdaptiveDigital));
+  ASSERT_EQ(AudioProcessing::kNoError, apm->noise_suppression()->Enable(true));
+  AudioProcessing::Config apm_config;
+  apm_config.residual_echo_detector.enabled = true;
+  apm->ApplyConfig(apm_config);
+
+  UnpacedStreamProcessor render(apm.get(), true, kNumRenderCalls, 0);
+  UnpacedStreamProcessor capture(apm.get(), false, kNumCaptureCalls, 2);
+  capture.Start();
+  render.Start();
+  EXPECT_TRUE(render.WaitAndStop(kTimeOutMs));
+  EXPECT_TRUE(capture.WaitAndStop(kTimeOutMs));
+  EXPECT_EQ(0, render.num_errors());
+  EXPECT_EQ(0, capture.num_errors());
+}
+
 // Instantiate tests from the extreme test configuration set.
 INSTANTIATE_TEST_CASE_P(
     DISABLED_AudioProcessingImplLockExtensive,
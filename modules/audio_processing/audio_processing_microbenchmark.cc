@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/adaptive_fir_filter.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+#include "test/testsupport/microbenchmark.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumFrames = kSampleRateHz / 100;
+
+void RandomizeSamples(Random* random, float scale, std::vector<float>* v) {
+  for (float& sample : *v)
+    sample = scale * (random->Rand<float>() - 0.5f);
+}
+
+void RandomizeFftData(Random* random, FftData* data) {
+  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+    data->re[k] = random->Rand<float>() - 0.5f;
+    data->im[k] = random->Rand<float>() - 0.5f;
+  }
+  data->im[0] = data->im[kFftLengthBy2] = 0.f;
+}
+
+}  // namespace
+
+TEST(AudioProcessingMicrobenchmark, AudioBufferSplitAndMergeBands) {
+  Random random(42);
+  std::vector<float> input(kNumFrames);
+  RandomizeSamples(&random, 32767.f, &input);
+  const float* channels[] = {input.data()};
+
+  AudioBuffer buffer(kNumFrames, 1, kNumFrames, 1, kNumFrames);
+  buffer.CopyFrom(channels, StreamConfig(kSampleRateHz, 1));
+  test::RunMicrobenchmark("AudioBuffer_SplitIntoFrequencyBands48kHz",
+                          [&] { buffer.SplitIntoFrequencyBands(); });
+  test::RunMicrobenchmark("AudioBuffer_MergeFrequencyBands48kHz",
+                          [&] { buffer.MergeFrequencyBands(); });
+}
+
+TEST(AudioProcessingMicrobenchmark, Aec3AdaptiveFirFilter) {
+  ApmDataDumper data_dumper(42);
+  EchoCanceller3Config config;
+  AdaptiveFirFilter filter(config.filter.main.length_blocks,
+                           config.filter.main.length_blocks,
+                           config.filter.config_change_duration_blocks,
+                           DetectOptimization(), &data_dumper);
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, 3));
+
+  // Fill the render buffer, so that every filter partition sees render data.
+  Random random(42);
+  std::vector<std::vector<float>> x(3, std::vector<float>(kBlockSize, 0.f));
+  for (size_t i = 0; i < 2 * config.filter.main.length_blocks; ++i) {
+    for (auto& band : x)
+      RandomizeSamples(&random, 32767.f, &band);
+    render_delay_buffer->Insert(x);
+    render_delay_buffer->PrepareCaptureProcessing();
+  }
+  const RenderBuffer& render_buffer = *render_delay_buffer->GetRenderBuffer();
+
+  FftData S;
+  test::RunMicrobenchmark("AdaptiveFirFilter_Filter",
+                          [&] { filter.Filter(render_buffer, &S); });
+  test::DoNotOptimizeAway(&S);
+
+  FftData G;
+  RandomizeFftData(&random, &G);
+  // Keep the gain small, so that the coefficients stay finite.
+  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+    G.re[k] *= 1e-6f;
+    G.im[k] *= 1e-6f;
+  }
+  test::RunMicrobenchmark("AdaptiveFirFilter_Adapt",
+                          [&] { filter.Adapt(render_buffer, G); });
+}
+
+}  // namespace webrtc
@@ -16,12 +16,15 @@
 #include <vector>
 
 #include "api/array_view.h"
+#include "common_audio/channel_buffer.h"
+#include "modules/audio_processing/splitting_filter.h"
 #include "modules/audio_processing/test/test_utils.h"
 #include "rtc_base/atomicops.h"
 #include "rtc_base/event.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gtest.h"
 #include "test/testsupport/perf_test.h"
@@ -626,4 +629,40 @@ INSTANTIATE_TEST_CASE_P(
     CallSimulator,
     ::testing::ValuesIn(SimulationConfig::GenerateSimulationConfigs()));
 
+// Measures the band splitting and merging done by the AudioBuffer on every
+// capture frame, i.e. the QMF at 32 kHz and the three band filter bank at
+// 48 kHz.
+TEST(AudioProcessingPerformanceTest, DISABLED_BandSplittingDurationTest) {
+  constexpr int kNumFrames = 10000;
+  constexpr size_t kNumChannels = 2;
+  const int kSampleRatesHz[] = {32000, 48000};
+  for (int sample_rate_hz : kSampleRatesHz) {
+    const size_t num_frames_per_channel = sample_rate_hz / 100;
+    const size_t num_bands = sample_rate_hz / 16000;
+    SplittingFilter splitting_filter(kNumChannels, num_bands,
+                                     num_frames_per_channel);
+    IFChannelBuffer data(num_frames_per_channel, kNumChannels);
+    IFChannelBuffer bands(num_frames_per_channel, kNumChannels, num_bands);
+    Random rand_gen(42);
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      for (size_t k = 0; k < num_frames_per_channel; ++k) {
+        data.fbuf()->channels()[ch][k] =
+            (rand_gen.Rand<float>() - 0.5f) * 32767.f;
+      }
+    }
+
+    const int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumFrames; ++i) {
+      splitting_filter.Analysis(&data, &bands);
+      splitting_filter.Synthesis(&bands, &data);
+    }
+    const int64_t duration_us = rtc::TimeMicros() - start_us;
+
+    webrtc::test::PrintResultMeanAndError(
+        "apm_band_splitting", "_" + std::to_string(sample_rate_hz) + "Hz",
+        "analysis_and_synthesis",
+        static_cast<double>(duration_us) / kNumFrames, 0.0, "us", false);
+  }
+}
+
 }  // namespace webrtc
@@ -18,6 +18,19 @@
 #include "modules/audio_processing/ns/noise_suppression.h"
 #include "modules/audio_processing/ns/ns_core.h"
 #include "modules/audio_processing/ns/windows_private.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+MagnitudeSpectrum WebRtcNs_MagnitudeSpectrum;
+DdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+
+static void MagnitudeSpectrumC(const float* time_data,
+                               size_t magnitude_length,
+                               float* real,
+                               float* imag,
+                               float* magn);
+static void ComputeDdBasedWienerFilterC(const NoiseSuppressionC* self,
+                                        const float* magn,
+                                        float* theFilter);
 
 // Set Feature Extraction Parameters.
 static void set_feature_extraction_parameters(NoiseSuppressionC* self) {
@@ -211,6 +224,17 @@ int WebRtcNs_InitCore(NoiseSuppressionC* self, uint32_t fs) {
   // Default mode.
   WebRtcNs_set_policy_core(self, 0);
 
+  // Initialize function pointers.
+  WebRtcNs_MagnitudeSpectrum = MagnitudeSpectrumC;
+  WebRtcNs_ComputeDdBasedWienerFilter = ComputeDdBasedWienerFilterC;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcNs_MagnitudeSpectrum = WebRtcNs_MagnitudeSpectrumSse2;
+    WebRtcNs_ComputeDdBasedWienerFilter =
+        WebRtcNs_ComputeDdBasedWienerFilterSse2;
+  }
+#endif
+
   self->initFlag = 1;
   return 0;
 }
@@ -893,12 +917,22 @@ static void FFT(NoiseSuppressionC* self,
                 float* real,
                 float* imag,
                 float* magn) {
-  size_t i;
-
   RTC_DCHECK_EQ(magnitude_length, time_data_length / 2 + 1);
 
   WebRtc_rdft(time_data_length, 1, time_data, self->ip, self->wfft);
 
+  WebRtcNs_MagnitudeSpectrum(time_data, magnitude_length, real, imag, magn);
+}
+
+// Splits the packed output of WebRtc_rdft() and computes the magnitude
+// spectrum.
+static void MagnitudeSpectrumC(const float* time_data,
+                               size_t magnitude_length,
+                               float* real,
+                               float* imag,
+                               float* magn) {
+  size_t i;
+
   imag[0] = 0;
   real[0] = time_data[0];
   magn[0] = fabsf(real[0]) + 1.f;
@@ -985,9 +1019,9 @@ static void Windowing(const float* window,
 //   * |magn| is the signal magnitude spectrum estimate.
 // Output:
 //   * |theFilter| is the frequency response of the computed Wiener filter.
-static void ComputeDdBasedWienerFilter(const NoiseSuppressionC* self,
-                                       const float* magn,
-                                       float* theFilter) {
+static void ComputeDdBasedWienerFilterC(const NoiseSuppressionC* self,
+                                        const float* magn,
+                                        float* theFilter) {
   size_t i;
   float snrPrior, previousEstimateStsa, currentEstimateStsa;
 
@@ -1275,7 +1309,7 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
     }
   }
 
-  ComputeDdBasedWienerFilter(self, magn, theFilter);
+  WebRtcNs_ComputeDdBasedWienerFilter(self, magn, theFilter);
 
   for (i = 0; i < self->magnLen; i++) {
     // Flooring bottom.
@@ -11,7 +11,11 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NS_CORE_H_
 #define MODULES_AUDIO_PROCESSING_NS_NS_CORE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "modules/audio_processing/ns/defines.h"
+#include "rtc_base/system/arch.h"
 
 typedef struct NSParaExtract_ {
   // Bin size of histogram.
@@ -183,6 +187,40 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
                           size_t num_bands,
                           float* const* outFrame);
 
+/****************************************************************************
+ * Some function pointers, for internal functions with SSE2 optimized versions.
+ * They are set by WebRtcNs_InitCore().
+ */
+// Splits the packed output of the forward FFT in |time_data| into |real| and
+// |imag|, and computes the magnitude spectrum |magn|.
+typedef void (*MagnitudeSpectrum)(const float* time_data,
+                                  size_t magnitude_length,
+                                  float* real,
+                                  float* imag,
+                                  float* magn);
+extern MagnitudeSpectrum WebRtcNs_MagnitudeSpectrum;
+
+// Estimates the prior SNR decision-directed and computes the DD based Wiener
+// filter |theFilter| for the signal magnitude spectrum |magn|.
+typedef void (*DdBasedWienerFilter)(const NoiseSuppressionC* self,
+                                    const float* magn,
+                                    float* theFilter);
+extern DdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// For the above function pointers, functions for generic platforms are declared
+// and defined as static in file ns_core.c, while those for SSE2 are declared
+// below and defined in file ns_core_sse2.c. Both produce the same output.
+void WebRtcNs_MagnitudeSpectrumSse2(const float* time_data,
+                                    size_t magnitude_length,
+                                    float* real,
+                                    float* imag,
+                                    float* magn);
+void WebRtcNs_ComputeDdBasedWienerFilterSse2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
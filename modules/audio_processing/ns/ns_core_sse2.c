@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/ns_core.h"
+
+#include <emmintrin.h>
+#include <math.h>
+
+// The functions below compute four frequency bins at a time. Since the
+// operations, and their order, are the same as in the generic versions, the
+// output is bit-exact.
+
+void WebRtcNs_MagnitudeSpectrumSse2(const float* time_data,
+                                    size_t magnitude_length,
+                                    float* real,
+                                    float* imag,
+                                    float* magn) {
+  const __m128 one = _mm_set1_ps(1.f);
+  size_t i = 1;
+
+  imag[0] = 0;
+  real[0] = time_data[0];
+  magn[0] = fabsf(real[0]) + 1.f;
+  imag[magnitude_length - 1] = 0;
+  real[magnitude_length - 1] = time_data[1];
+  magn[magnitude_length - 1] = fabsf(real[magnitude_length - 1]) + 1.f;
+  for (; i + 4 < magnitude_length; i += 4) {
+    // Deinterleave the real and imaginary parts of bins i to i + 3.
+    const __m128 a = _mm_loadu_ps(&time_data[2 * i]);
+    const __m128 b = _mm_loadu_ps(&time_data[2 * i + 4]);
+    const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 energy =
+        _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+    _mm_storeu_ps(&real[i], re);
+    _mm_storeu_ps(&imag[i], im);
+    _mm_storeu_ps(&magn[i], _mm_add_ps(_mm_sqrt_ps(energy), one));
+  }
+  for (; i < magnitude_length - 1; ++i) {
+    real[i] = time_data[2 * i];
+    imag[i] = time_data[2 * i + 1];
+    magn[i] = sqrtf(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
+  }
+}
+
+void WebRtcNs_ComputeDdBasedWienerFilterSse2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter) {
+  const __m128 offset = _mm_set1_ps(0.0001f);
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 dd = _mm_set1_ps(DD_PR_SNR);
+  const __m128 one_minus_dd = _mm_set1_ps(1.f - DD_PR_SNR);
+  const __m128 overdrive = _mm_set1_ps(self->overdrive);
+  size_t i = 0;
+  float snrPrior, previousEstimateStsa, currentEstimateStsa;
+
+  for (; i + 4 <= self->magnLen; i += 4) {
+    const __m128 m = _mm_loadu_ps(&magn[i]);
+    const __m128 noise = _mm_loadu_ps(&self->noise[i]);
+    // Previous estimate: based on previous frame with gain filter.
+    const __m128 previous = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&self->magnPrevProcess[i]),
+                   _mm_add_ps(_mm_loadu_ps(&self->noisePrev[i]), offset)),
+        _mm_loadu_ps(&self->smooth[i]));
+    // Current estimate, zero where the magnitude is below the noise.
+    const __m128 current =
+        _mm_and_ps(_mm_cmpgt_ps(m, noise),
+                   _mm_sub_ps(_mm_div_ps(m, _mm_add_ps(noise, offset)), one));
+    const __m128 snr_prior = _mm_add_ps(_mm_mul_ps(dd, previous),
+                                        _mm_mul_ps(one_minus_dd, current));
+    _mm_storeu_ps(&theFilter[i],
+                  _mm_div_ps(snr_prior, _mm_add_ps(overdrive, snr_prior)));
+  }
+  for (; i < self->magnLen; i++) {
+    previousEstimateStsa = self->magnPrevProcess[i] /
+                           (self->noisePrev[i] + 0.0001f) * self->smooth[i];
+    currentEstimateStsa = 0.f;
+    if (magn[i] > self->noise[i]) {
+      currentEstimateStsa = magn[i] / (self->noise[i] + 0.0001f) - 1.f;
+    }
+    snrPrior = DD_PR_SNR * previousEstimateStsa +
+               (1.f - DD_PR_SNR) * currentEstimateStsa;
+    theFilter[i] = snrPrior / (self->overdrive + snrPrior);
+  }
+}
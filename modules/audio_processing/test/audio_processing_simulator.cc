@@ -28,6 +28,7 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "modules/audio_processing/test/fake_recording_device.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/json.h"
 #include "rtc_base/strings/string_builder.h"
@@ -35,6 +36,7 @@
 namespace webrtc {
 namespace test {
 namespace {
+
 // Helper for reading JSON from a file and parsing it to an AEC3 configuration.
 EchoCanceller3Config ReadAec3ConfigFromJsonFile(const std::string& filename) {
   std::string json_string;
@@ -120,6 +122,7 @@ AudioProcessingSimulator::AudioProcessingSimulator(
     : settings_(settings),
       ap_builder_(ap_builder ? std::move(ap_builder)
                              : absl::make_unique<AudioProcessingBuilder>()),
+      capture_cpu_time_us_(kCpuTimeLongTailBoundaryUs),
       analog_mic_level_(settings.initial_mic_level),
       fake_recording_device_(
           settings.initial_mic_level,
@@ -151,7 +154,20 @@ AudioProcessingSimulator::~AudioProcessingSimulator() {
   }
 }
 
+AudioProcessingSimulator::ScopedTimer::ScopedTimer(
+    TickIntervalStats* proc_time,
+    rtc::HistogramPercentileCounter* cpu_time_us)
+    : proc_time_(proc_time),
+      cpu_time_us_(cpu_time_us),
+      start_time_(rtc::TimeNanos()),
+      start_cpu_time_(cpu_time_us ? rtc::GetThreadCpuTimeNanos() : 0) {}
+
 AudioProcessingSimulator::ScopedTimer::~ScopedTimer() {
+  if (cpu_time_us_) {
+    cpu_time_us_->Add(static_cast<uint32_t>(
+        (rtc::GetThreadCpuTimeNanos() - start_cpu_time_) /
+        rtc::kNumNanosecsPerMicrosec));
+  }
   int64_t interval = rtc::TimeNanos() - start_time_;
   proc_time_->sum += interval;
   proc_time_->max = std::max(proc_time_->max, interval);
@@ -189,12 +205,14 @@ void AudioProcessingSimulator::ProcessStream(bool fixed_interface) {
   // Process the current audio frame.
   if (fixed_interface) {
     {
-      const auto st = ScopedTimer(mutable_proc_time());
+      const auto st =
+          ScopedTimer(mutable_proc_time(), mutable_capture_cpu_time_us());
       RTC_CHECK_EQ(AudioProcessing::kNoError, ap_->ProcessStream(&fwd_frame_));
     }
     CopyFromAudioFrame(fwd_frame_, out_buf_.get());
   } else {
-    const auto st = ScopedTimer(mutable_proc_time());
+    const auto st =
+        ScopedTimer(mutable_proc_time(), mutable_capture_cpu_time_us());
     RTC_CHECK_EQ(AudioProcessing::kNoError,
                  ap_->ProcessStream(in_buf_->channels(), in_config_,
                                     out_config_, out_buf_->channels()));
@@ -23,6 +23,7 @@
 #include "modules/audio_processing/test/fake_recording_device.h"
 #include "modules/audio_processing/test/test_utils.h"
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/numerics/histogram_percentile_counter.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/timeutils.h"
 
@@ -115,6 +116,9 @@ void CopyToAudioFrame(const ChannelBuffer<float>& src, AudioFrame* dest);
 class AudioProcessingSimulator {
  public:
   static const int kChunksPerSecond = 1000 / AudioProcessing::kChunkSizeMs;
+  // A chunk taking longer than its 10 ms duration to process can't run in real
+  // time, so the CPU time histogram has finer granularity only below that.
+  static const uint32_t kCpuTimeLongTailBoundaryUs = 10000;
 
   AudioProcessingSimulator(const SimulationSettings& settings,
                            std::unique_ptr<AudioProcessingBuilder> ap_builder);
@@ -126,6 +130,12 @@ class AudioProcessingSimulator {
   // Returns the execution time of all AudioProcessing calls.
   const TickIntervalStats& proc_time() const { return proc_time_; }
 
+  // Returns the histogram of the thread CPU time, in microseconds, spent in
+  // each forward stream AudioProcessing call.
+  const rtc::HistogramPercentileCounter& capture_cpu_time_us() const {
+    return capture_cpu_time_us_;
+  }
+
   // Reports whether the processed recording was bitexact.
   bool OutputWasBitexact() { return bitexact_output_; }
 
@@ -137,20 +147,26 @@ class AudioProcessingSimulator {
  protected:
   // RAII class for execution time measurement. Updates the provided
   // TickIntervalStats based on the time between ScopedTimer creation and
-  // leaving the enclosing scope.
+  // leaving the enclosing scope, and optionally adds the thread CPU time spent
+  // in the scope to |cpu_time_us|.
   class ScopedTimer {
    public:
-    explicit ScopedTimer(TickIntervalStats* proc_time)
-        : proc_time_(proc_time), start_time_(rtc::TimeNanos()) {}
+    explicit ScopedTimer(TickIntervalStats* proc_time,
+                         rtc::HistogramPercentileCounter* cpu_time_us = nullptr);
 
     ~ScopedTimer();
 
    private:
     TickIntervalStats* const proc_time_;
+    rtc::HistogramPercentileCounter* const cpu_time_us_;
     int64_t start_time_;
+    int64_t start_cpu_time_;
   };
 
   TickIntervalStats* mutable_proc_time() { return &proc_time_; }
+  rtc::HistogramPercentileCounter* mutable_capture_cpu_time_us() {
+    return &capture_cpu_time_us_;
+  }
   void ProcessStream(bool fixed_interface);
   void ProcessReverseStream(bool fixed_interface);
   void CreateAudioProcessor();
@@ -192,6 +208,7 @@ class AudioProcessingSimulator {
   std::unique_ptr<ChannelBufferWavWriter> buffer_writer_;
   std::unique_ptr<ChannelBufferWavWriter> reverse_buffer_writer_;
   TickIntervalStats proc_time_;
+  rtc::HistogramPercentileCounter capture_cpu_time_us_;
   std::ofstream residual_echo_likelihood_graph_writer_;
   int analog_mic_level_;
   FakeRecordingDevice fake_recording_device_;
@@ -10,12 +10,16 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 #include "modules/audio_processing/include/audio_processing.h"
 #include "modules/audio_processing/test/aec_dump_based_simulator.h"
@@ -24,7 +28,10 @@
 #include "modules/audio_processing/test/wav_based_simulator.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/flags.h"
+#include "rtc_base/numerics/histogram_percentile_counter.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/strings/string_builder.h"
+#include "system_wrappers/include/cpu_info.h"
 
 namespace webrtc {
 namespace test {
@@ -36,12 +43,24 @@ const char kUsageDescription[] =
     "Usage: audioproc_f [options] -i <input.wav>\n"
     "                   or\n"
     "       audioproc_f [options] -dump_input <aec_dump>\n"
+    "                   or\n"
+    "       audioproc_f [options] -dump_input_list <aec_dump_list>\n"
     "\n\n"
     "Command-line tool to simulate a call using the audio "
     "processing module, either based on wav files or "
     "protobuf debug dump recordings.\n";
 
 WEBRTC_DEFINE_string(dump_input, "", "Aec dump input filename");
+WEBRTC_DEFINE_string(dump_input_list,
+                     "",
+                     "File listing one aec dump filename per line. The dumps "
+                     "are replayed in parallel with default AudioProcessing "
+                     "components, reporting bitexactness and the CPU time per "
+                     "forward stream chunk");
+WEBRTC_DEFINE_int(num_threads,
+                  0,
+                  "Number of dumps replayed concurrently with "
+                  "--dump_input_list, 0 uses one thread per core");
 WEBRTC_DEFINE_string(dump_output, "", "Aec dump output filename");
 WEBRTC_DEFINE_string(i, "", "Forward stream input wav filename");
 WEBRTC_DEFINE_string(o, "", "Forward stream output wav filename");
@@ -517,6 +536,106 @@ void PerformBasicParameterSanityChecks(const SimulationSettings& settings) {
       "Error: --dump_data_output_dir cannot be set without --dump_data.\n");
 }
 
+void PerformBatchParameterSanityChecks(const SimulationSettings& settings) {
+  ReportConditionalErrorAndExit(
+      settings.aec_dump_input_filename || settings.input_filename ||
+          settings.reverse_input_filename ||
+          settings.artificial_nearend_filename,
+      "Error: --dump_input_list cannot be combined with other inputs.\n");
+  ReportConditionalErrorAndExit(
+      settings.output_filename || settings.reverse_output_filename ||
+          settings.aec_dump_output_filename ||
+          settings.ed_graph_output_filename || settings.dump_internal_data,
+      "Error: --dump_input_list does not support output files.\n");
+  ReportConditionalErrorAndExit(
+      FLAG_num_threads < 0, "Error: --num_threads must be non-negative.\n");
+}
+
+struct BatchJobResult {
+  std::string aec_dump_filename;
+  bool bitexact = false;
+  size_t num_process_stream_calls = 0;
+  std::unique_ptr<rtc::HistogramPercentileCounter> capture_cpu_time_us;
+};
+
+void PrintCpuTimePercentiles(rtc::HistogramPercentileCounter* cpu_time_us) {
+  std::cout << "cpu_us_per_chunk p50="
+            << cpu_time_us->GetPercentile(0.5f).value_or(0)
+            << " p99=" << cpu_time_us->GetPercentile(0.99f).value_or(0);
+}
+
+// Replays each aec dump in |aec_dump_list_filename| through its own
+// AudioProcessing instance, running |num_threads| simulations concurrently.
+// Returns 0 if all dumps were reproduced bitexactly.
+int RunAecDumpBatch(const SimulationSettings& base_settings,
+                    const std::string& aec_dump_list_filename,
+                    int num_threads) {
+  std::ifstream list_stream(aec_dump_list_filename);
+  ReportConditionalErrorAndExit(!list_stream.is_open(),
+                                "Error: Cannot open --dump_input_list file.\n");
+  std::vector<BatchJobResult> results;
+  std::string line;
+  while (std::getline(list_stream, line)) {
+    if (line.empty())
+      continue;
+    results.emplace_back();
+    results.back().aec_dump_filename = line;
+  }
+
+  std::atomic<size_t> next_job(0);
+  auto run_jobs = [&]() {
+    for (size_t i = next_job++; i < results.size(); i = next_job++) {
+      BatchJobResult& result = results[i];
+      SimulationSettings settings = base_settings;
+      settings.aec_dump_input_filename = result.aec_dump_filename;
+      settings.report_bitexactness = true;
+      settings.use_quiet_output = true;
+      settings.use_verbose_logging = false;
+      AecDumpBasedSimulator simulator(settings, nullptr);
+      simulator.Process();
+      result.bitexact = simulator.OutputWasBitexact();
+      result.num_process_stream_calls =
+          simulator.get_num_process_stream_calls();
+      result.capture_cpu_time_us =
+          absl::make_unique<rtc::HistogramPercentileCounter>(
+              simulator.capture_cpu_time_us());
+    }
+  };
+
+  if (num_threads == 0)
+    num_threads = CpuInfo::DetectNumberOfCores();
+  num_threads = std::max(
+      1, std::min(num_threads, static_cast<int>(results.size())));
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(absl::make_unique<rtc::PlatformThread>(
+        [](void* obj) { (*static_cast<decltype(run_jobs)*>(obj))(); },
+        &run_jobs, "AecDumpReplay"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+
+  rtc::HistogramPercentileCounter total_cpu_time_us(
+      AudioProcessingSimulator::kCpuTimeLongTailBoundaryUs);
+  int num_not_bitexact = 0;
+  for (BatchJobResult& result : results) {
+    std::cout << result.aec_dump_filename << ": "
+              << (result.bitexact ? "bitexact" : "NOT bitexact")
+              << ", chunks=" << result.num_process_stream_calls << ", ";
+    PrintCpuTimePercentiles(result.capture_cpu_time_us.get());
+    std::cout << std::endl;
+    total_cpu_time_us.Add(*result.capture_cpu_time_us);
+    if (!result.bitexact)
+      ++num_not_bitexact;
+  }
+  std::cout << "Replayed " << results.size() << " aec dumps, "
+            << num_not_bitexact << " not bitexact, ";
+  PrintCpuTimePercentiles(&total_cpu_time_us);
+  std::cout << std::endl;
+  return num_not_bitexact == 0 ? 0 : 1;
+}
+
 }  // namespace
 
 int AudioprocFloatImpl(std::unique_ptr<AudioProcessingBuilder> ap_builder,
@@ -533,6 +652,10 @@ int AudioprocFloatImpl(std::unique_ptr<AudioProcessingBuilder> ap_builder,
   }
 
   SimulationSettings settings = CreateSettings();
+  if (strlen(FLAG_dump_input_list) > 0) {
+    PerformBatchParameterSanityChecks(settings);
+    return RunAecDumpBatch(settings, FLAG_dump_input_list, FLAG_num_threads);
+  }
   PerformBasicParameterSanityChecks(settings);
   std::unique_ptr<AudioProcessingSimulator> processor;
 
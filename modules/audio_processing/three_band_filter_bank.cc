@@ -37,7 +37,14 @@
 
 #include <cmath>
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 namespace {
@@ -111,6 +118,9 @@ void Upsample(const float* in, size_t split_length, size_t offset, float* out) {
 ThreeBandFilterBank::ThreeBandFilterBank(size_t length)
     : in_buffer_(rtc::CheckedDivExact(length, kNumBands)),
       out_buffer_(in_buffer_.size()) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  use_sse2_ = WebRtc_GetCPUInfo(kSSE2) != 0;
+#endif
   for (size_t i = 0; i < kSparsity; ++i) {
     for (size_t j = 0; j < kNumBands; ++j) {
       analysis_filters_.push_back(
@@ -182,32 +192,96 @@ void ThreeBandFilterBank::Synthesis(const float* const* in,
 // Modulates |in| by |dct_modulation_| and accumulates it in each of the
 // |kNumBands| bands of |out|. |offset| is the index in the period of the
 // cosines used for modulation. |split_length| is the length of |in| and each
-// band of |out|.
+// band of |out|. The bands are updated in one pass over |in|, four samples at a
+// time with SSE2 or NEON. Multiplications and additions are not fused, so all
+// implementations round alike.
 void ThreeBandFilterBank::DownModulate(const float* in,
                                        size_t split_length,
                                        size_t offset,
                                        float* const* out) {
-  for (size_t i = 0; i < kNumBands; ++i) {
-    for (size_t j = 0; j < split_length; ++j) {
-      out[i][j] += dct_modulation_[offset][i] * in[j];
+  static_assert(kNumBands == 3, "The modulation is unrolled for 3 bands");
+  const float c0 = dct_modulation_[offset][0];
+  const float c1 = dct_modulation_[offset][1];
+  const float c2 = dct_modulation_[offset][2];
+  float* out0 = out[0];
+  float* out1 = out[1];
+  float* out2 = out[2];
+  size_t j = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (use_sse2_) {
+    const __m128 v0 = _mm_set1_ps(c0);
+    const __m128 v1 = _mm_set1_ps(c1);
+    const __m128 v2 = _mm_set1_ps(c2);
+    for (; j + 4 <= split_length; j += 4) {
+      const __m128 x = _mm_loadu_ps(&in[j]);
+      _mm_storeu_ps(&out0[j],
+                    _mm_add_ps(_mm_loadu_ps(&out0[j]), _mm_mul_ps(v0, x)));
+      _mm_storeu_ps(&out1[j],
+                    _mm_add_ps(_mm_loadu_ps(&out1[j]), _mm_mul_ps(v1, x)));
+      _mm_storeu_ps(&out2[j],
+                    _mm_add_ps(_mm_loadu_ps(&out2[j]), _mm_mul_ps(v2, x)));
     }
   }
+#elif defined(WEBRTC_HAS_NEON)
+  for (; j + 4 <= split_length; j += 4) {
+    const float32x4_t x = vld1q_f32(&in[j]);
+    vst1q_f32(&out0[j], vaddq_f32(vld1q_f32(&out0[j]), vmulq_n_f32(x, c0)));
+    vst1q_f32(&out1[j], vaddq_f32(vld1q_f32(&out1[j]), vmulq_n_f32(x, c1)));
+    vst1q_f32(&out2[j], vaddq_f32(vld1q_f32(&out2[j]), vmulq_n_f32(x, c2)));
+  }
+#endif
+  for (; j < split_length; ++j) {
+    out0[j] += c0 * in[j];
+    out1[j] += c1 * in[j];
+    out2[j] += c2 * in[j];
+  }
 }
 
 // Modulates each of the |kNumBands| bands of |in| by |dct_modulation_| and
-// accumulates them in |out|. |out| is cleared before starting to accumulate.
-// |offset| is the index in the period of the cosines used for modulation.
-// |split_length| is the length of each band of |in| and |out|.
+// accumulates them in |out|. |out| is overwritten. |offset| is the index in
+// the period of the cosines used for modulation. |split_length| is the length
+// of each band of |in| and |out|.
 void ThreeBandFilterBank::UpModulate(const float* const* in,
                                      size_t split_length,
                                      size_t offset,
                                      float* out) {
-  memset(out, 0, split_length * sizeof(*out));
-  for (size_t i = 0; i < kNumBands; ++i) {
-    for (size_t j = 0; j < split_length; ++j) {
-      out[j] += dct_modulation_[offset][i] * in[i][j];
+  const float c0 = dct_modulation_[offset][0];
+  const float c1 = dct_modulation_[offset][1];
+  const float c2 = dct_modulation_[offset][2];
+  const float* in0 = in[0];
+  const float* in1 = in[1];
+  const float* in2 = in[2];
+  size_t j = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (use_sse2_) {
+    const __m128 v0 = _mm_set1_ps(c0);
+    const __m128 v1 = _mm_set1_ps(c1);
+    const __m128 v2 = _mm_set1_ps(c2);
+    for (; j + 4 <= split_length; j += 4) {
+      // Starts from zero, like the accumulation in the scalar loop.
+      __m128 sum = _mm_add_ps(_mm_setzero_ps(),
+                              _mm_mul_ps(v0, _mm_loadu_ps(&in0[j])));
+      sum = _mm_add_ps(sum, _mm_mul_ps(v1, _mm_loadu_ps(&in1[j])));
+      sum = _mm_add_ps(sum, _mm_mul_ps(v2, _mm_loadu_ps(&in2[j])));
+      _mm_storeu_ps(&out[j], sum);
     }
   }
+#elif defined(WEBRTC_HAS_NEON)
+  for (; j + 4 <= split_length; j += 4) {
+    float32x4_t sum =
+        vaddq_f32(vdupq_n_f32(0.f), vmulq_n_f32(vld1q_f32(&in0[j]), c0));
+    sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(&in1[j]), c1));
+    sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(&in2[j]), c2));
+    vst1q_f32(&out[j], sum);
+  }
+#endif
+  for (; j < split_length; ++j) {
+    float sum = 0.f;
+    sum += c0 * in0[j];
+    sum += c1 * in1[j];
+    sum += c2 * in2[j];
+    out[j] = sum;
+  }
 }
 
 }  // namespace webrtc
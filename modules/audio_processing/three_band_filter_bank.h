@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "common_audio/sparse_fir_filter.h"
+#include "rtc_base/system/arch.h"
 
 namespace webrtc {
 
@@ -62,6 +63,9 @@ class ThreeBandFilterBank final {
   std::vector<std::unique_ptr<SparseFIRFilter>> analysis_filters_;
   std::vector<std::unique_ptr<SparseFIRFilter>> synthesis_filters_;
   std::vector<std::vector<float>> dct_modulation_;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  bool use_sse2_;
+#endif
 };
 
 }  // namespace webrtc
@@ -37,6 +37,9 @@ static const size_t kMaxVoiceBin = 60;
 
 namespace {
 
+// Length of the transforms of OouraFft.
+constexpr size_t kOouraFftLength = 128;
+
 float ComplexMagnitude(float a, float b) {
   return std::abs(a) + std::abs(b);
 }
@@ -231,7 +234,13 @@ void TransientSuppressor::Suppress(float* in_ptr,
     fft_buffer_[i] = in_ptr[i] * window_[i];
   }
 
-  WebRtc_rdft(analysis_length_, 1, fft_buffer_.get(), ip_.get(), wfft_.get());
+  // OouraFft computes the same transform as rdft(), but uses SSE2 or NEON.
+  if (analysis_length_ == kOouraFftLength) {
+    ooura_fft_.Fft(fft_buffer_.get());
+  } else {
+    WebRtc_rdft(analysis_length_, 1, fft_buffer_.get(), ip_.get(),
+                wfft_.get());
+  }
 
   // Since WebRtc_rdft puts R[n/2] in fft_buffer_[1], we move it to the end
   // for convenience.
@@ -262,7 +271,12 @@ void TransientSuppressor::Suppress(float* in_ptr,
   // Put R[n/2] back in fft_buffer_[1].
   fft_buffer_[1] = fft_buffer_[analysis_length_];
 
-  WebRtc_rdft(analysis_length_, -1, fft_buffer_.get(), ip_.get(), wfft_.get());
+  if (analysis_length_ == kOouraFftLength) {
+    ooura_fft_.InverseFft(fft_buffer_.get());
+  } else {
+    WebRtc_rdft(analysis_length_, -1, fft_buffer_.get(), ip_.get(),
+                wfft_.get());
+  }
   const float fft_scaling = 2.f / analysis_length_;
 
   for (size_t i = 0; i < analysis_length_; ++i) {
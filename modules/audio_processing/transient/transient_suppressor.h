@@ -15,6 +15,7 @@
 #include <stdint.h>
 #include <memory>
 
+#include "modules/audio_processing/utility/ooura_fft.h"
 #include "rtc_base/gtest_prod_util.h"
 
 namespace webrtc {
@@ -87,6 +88,8 @@ class TransientSuppressor {
   // Arrays for fft.
   std::unique_ptr<size_t[]> ip_;
   std::unique_ptr<float[]> wfft_;
+  // SIMD optimized fft, used instead of rdft() for 128 point transforms.
+  const OouraFft ooura_fft_;
 
   std::unique_ptr<float[]> spectral_mean_;
 
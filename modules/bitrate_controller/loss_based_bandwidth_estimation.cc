@@ -89,7 +89,10 @@ LossBasedControlConfig::LossBasedControlConfig()
       loss_bandwidth_balance_exponent("exponent", 0.5),
       allow_resets("resets", false),
       decrease_interval("decr_intvl", TimeDelta::ms(300)),
-      loss_report_timeout("timeout", TimeDelta::ms(6000)) {
+      loss_report_timeout("timeout", TimeDelta::ms(6000)),
+      random_loss_weight("rand_loss_weight", 1.0),
+      congestion_queue_delay("cong_delay", TimeDelta::ms(20)),
+      min_delay_window("min_delay_win", TimeDelta::seconds(10)) {
   std::string trial_string = field_trial::FindFullName(kBweLossBasedControl);
   ParseFieldTrial(
       {&min_increase_factor, &max_increase_factor, &increase_low_rtt,
@@ -97,7 +100,8 @@ LossBasedControlConfig::LossBasedControlConfig()
        &acknowledged_rate_max_window, &increase_offset,
        &loss_bandwidth_balance_increase, &loss_bandwidth_balance_decrease,
        &loss_bandwidth_balance_exponent, &allow_resets, &decrease_interval,
-       &loss_report_timeout},
+       &loss_report_timeout, &random_loss_weight, &congestion_queue_delay,
+       &min_delay_window},
       trial_string);
 }
 LossBasedControlConfig::LossBasedControlConfig(const LossBasedControlConfig&) =
@@ -114,7 +118,8 @@ LossBasedBandwidthEstimation::LossBasedBandwidthEstimation()
       time_last_decrease_(Timestamp::MinusInfinity()),
       has_decreased_since_last_loss_report_(false),
       last_loss_packet_report_(Timestamp::MinusInfinity()),
-      last_loss_ratio_(0) {}
+      last_loss_ratio_(0),
+      last_received_queued_(false) {}
 
 void LossBasedBandwidthEstimation::UpdateLossStatistics(
     const std::vector<PacketResult>& packet_results,
@@ -123,11 +128,27 @@ void LossBasedBandwidthEstimation::UpdateLossStatistics(
     RTC_DCHECK(false);
     return;
   }
-  int loss_count = 0;
-  for (auto pkt : packet_results) {
-    loss_count += pkt.receive_time.IsInfinite() ? 1 : 0;
+  // Losses are classified when the next packet is received, as caused by
+  // congestion if the packet before or after them was queued.
+  auto loss_weight = [this](bool congested) {
+    return congested ? 1.0 : config_.random_loss_weight.Get();
+  };
+  double loss_count = 0;
+  int unclassified_losses = 0;
+  for (const PacketResult& pkt : packet_results) {
+    if (pkt.receive_time.IsInfinite()) {
+      ++unclassified_losses;
+      continue;
+    }
+    bool queued = pkt.sent_packet.send_time.IsFinite() &&
+                  UpdateQueueDelay(pkt) >= config_.congestion_queue_delay;
+    loss_count +=
+        unclassified_losses * loss_weight(queued || last_received_queued_);
+    unclassified_losses = 0;
+    last_received_queued_ = queued;
   }
-  last_loss_ratio_ = static_cast<double>(loss_count) / packet_results.size();
+  loss_count += unclassified_losses * loss_weight(last_received_queued_);
+  last_loss_ratio_ = loss_count / packet_results.size();
   const TimeDelta time_passed = last_loss_packet_report_.IsFinite()
                                     ? at_time - last_loss_packet_report_
                                     : TimeDelta::seconds(1);
@@ -145,6 +166,21 @@ void LossBasedBandwidthEstimation::UpdateLossStatistics(
   }
 }
 
+TimeDelta LossBasedBandwidthEstimation::UpdateQueueDelay(
+    const PacketResult& packet) {
+  const TimeDelta delay = packet.receive_time - packet.sent_packet.send_time;
+  while (!min_delay_candidates_.empty() &&
+         min_delay_candidates_.back().second >= delay) {
+    min_delay_candidates_.pop_back();
+  }
+  min_delay_candidates_.emplace_back(packet.receive_time, delay);
+  while (packet.receive_time - min_delay_candidates_.front().first >
+         config_.min_delay_window) {
+    min_delay_candidates_.pop_front();
+  }
+  return delay - min_delay_candidates_.front().second;
+}
+
 void LossBasedBandwidthEstimation::UpdateAcknowledgedBitrate(
     DataRate acknowledged_bitrate,
     Timestamp at_time) {
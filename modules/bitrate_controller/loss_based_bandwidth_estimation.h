@@ -11,6 +11,8 @@
 #ifndef MODULES_BITRATE_CONTROLLER_LOSS_BASED_BANDWIDTH_ESTIMATION_H_
 #define MODULES_BITRATE_CONTROLLER_LOSS_BASED_BANDWIDTH_ESTIMATION_H_
 
+#include <deque>
+#include <utility>
 #include <vector>
 
 #include "api/units/data_rate.h"
@@ -42,6 +44,15 @@ struct LossBasedControlConfig {
   FieldTrialParameter<bool> allow_resets;
   FieldTrialParameter<TimeDelta> decrease_interval;
   FieldTrialParameter<TimeDelta> loss_report_timeout;
+  // Losses are classified as caused by congestion if the packets received
+  // around them were queued for at least |congestion_queue_delay| more than
+  // the lowest delay seen over |min_delay_window|. Other losses are considered
+  // random, e.g. caused by a wireless link, and are weighted by
+  // |random_loss_weight| in the loss statistics. The default weight of 1 makes
+  // no distinction between the two.
+  FieldTrialParameter<double> random_loss_weight;
+  FieldTrialParameter<TimeDelta> congestion_queue_delay;
+  FieldTrialParameter<TimeDelta> min_delay_window;
 };
 
 class LossBasedBandwidthEstimation {
@@ -63,6 +74,11 @@ class LossBasedBandwidthEstimation {
   DataRate GetEstimate() const { return loss_based_bitrate_; }
 
  private:
+  // Returns how long |packet| was queued, relative to the lowest one-way delay
+  // within the window. Updates the windowed minimum with the delay of
+  // |packet|, which must have been received.
+  TimeDelta UpdateQueueDelay(const PacketResult& packet);
+
   LossBasedControlConfig config_;
   double average_loss_;
   double average_loss_max_;
@@ -73,6 +89,12 @@ class LossBasedBandwidthEstimation {
   bool has_decreased_since_last_loss_report_;
   Timestamp last_loss_packet_report_;
   double last_loss_ratio_;
+  // Candidates for the minimum one-way delay, as (receive time, delay) pairs
+  // with increasing delays.
+  std::deque<std::pair<Timestamp, TimeDelta>> min_delay_candidates_;
+  // Whether the last received packet had built up a queue, carried over
+  // between reports for losses at the start of the next report.
+  bool last_received_queued_;
 };
 
 }  // namespace webrtc
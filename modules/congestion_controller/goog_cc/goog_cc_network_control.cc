@@ -39,6 +39,10 @@ const char kCwndExperiment[] = "WebRTC-CwndExperiment";
 // the congestion window. The relation between outstanding data and
 // the congestion window affects encoder allocations directly.
 const char kCongestionPushbackExperiment[] = "WebRTC-CongestionWindowPushback";
+// When enabled with CongestionWindowPushback, the target rate is not pushed
+// back. Instead the encoder is asked to drop frames in proportion, which saves
+// encoding of frames that would only queue up.
+const char kPushbackDropFrameExperiment[] = "WebRTC-Pushback-DropFrame";
 
 const int64_t kDefaultAcceptedQueueMs = 250;
 
@@ -141,6 +145,8 @@ GoogCcNetworkController::GoogCcNetworkController(RtcEventLog* event_log,
       probe_controller_(new ProbeController()),
       congestion_window_pushback_controller_(
           MaybeInitalizeCongestionWindowPushbackController()),
+      pushback_drop_frame_(
+          field_trial::IsEnabled(kPushbackDropFrameExperiment)),
       bandwidth_estimation_(
           absl::make_unique<SendSideBandwidthEstimation>(event_log_)),
       alr_detector_(absl::make_unique<AlrDetector>()),
@@ -643,20 +649,27 @@ void GoogCcNetworkController::MaybeTriggerOnNetworkChanged(
                         estimated_bitrate_bps / 1000);
 
   DataRate target_rate = DataRate::bps(estimated_bitrate_bps);
+  DataRate pushback_target_rate = target_rate;
   if (congestion_window_pushback_controller_) {
     int64_t pushback_rate =
         congestion_window_pushback_controller_->UpdateTargetBitrate(
             target_rate.bps());
     pushback_rate = std::max<int64_t>(bandwidth_estimation_->GetMinBitrate(),
                                       pushback_rate);
-    target_rate = DataRate::bps(pushback_rate);
+    pushback_target_rate = DataRate::bps(pushback_rate);
+    if (!pushback_drop_frame_)
+      target_rate = pushback_target_rate;
+  }
+  double cwnd_reduce_ratio = 0;
+  if (target_rate > pushback_target_rate) {
+    cwnd_reduce_ratio = (target_rate - pushback_target_rate) / target_rate;
   }
 
   if ((estimated_bitrate_bps != last_estimated_bitrate_bps_) ||
       (fraction_loss != last_estimated_fraction_loss_) ||
       (rtt_ms != last_estimated_rtt_ms_) ||
-      (target_rate != last_pushback_target_rate_)) {
-    last_pushback_target_rate_ = target_rate;
+      (pushback_target_rate != last_pushback_target_rate_)) {
+    last_pushback_target_rate_ = pushback_target_rate;
     last_estimated_bitrate_bps_ = estimated_bitrate_bps;
     last_estimated_fraction_loss_ = fraction_loss;
     last_estimated_rtt_ms_ = rtt_ms;
@@ -676,6 +689,7 @@ void GoogCcNetworkController::MaybeTriggerOnNetworkChanged(
     TargetTransferRate target_rate_msg;
     target_rate_msg.at_time = at_time;
     target_rate_msg.target_rate = target_rate;
+    target_rate_msg.cwnd_reduce_ratio = cwnd_reduce_ratio;
     target_rate_msg.network_estimate.at_time = at_time;
     target_rate_msg.network_estimate.round_trip_time = TimeDelta::ms(rtt_ms);
     target_rate_msg.network_estimate.bandwidth = bandwidth;
@@ -78,6 +78,7 @@ class GoogCcNetworkController : public NetworkControllerInterface {
   const std::unique_ptr<ProbeController> probe_controller_;
   const std::unique_ptr<CongestionWindowPushbackController>
       congestion_window_pushback_controller_;
+  const bool pushback_drop_frame_;
 
   std::unique_ptr<SendSideBandwidthEstimation> bandwidth_estimation_;
   std::unique_ptr<AlrDetector> alr_detector_;
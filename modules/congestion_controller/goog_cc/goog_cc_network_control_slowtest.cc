@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string>
+
 #include "api/transport/goog_cc_factory.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
@@ -15,6 +17,37 @@
 
 namespace webrtc {
 namespace test {
+namespace {
+// Runs a simulated call over a link with random loss under |field_trials| and
+// returns the final target rate.
+DataRate RunLossyLink(const std::string& field_trials,
+                      const std::string& log_name,
+                      DataRate link_capacity,
+                      double loss_rate) {
+  ScopedFieldTrials trial(field_trials);
+  Scenario s("googcc_unit/" + log_name, false);
+  SimulatedTimeClientConfig config;
+  config.transport.cc =
+      TransportControllerConfig::CongestionController::kGoogCcFeedback;
+  config.transport.rates.min_rate = DataRate::kbps(10);
+  config.transport.rates.max_rate = DataRate::kbps(5000);
+  config.transport.rates.start_rate = DataRate::kbps(300);
+  auto send_net = s.CreateSimulationNode([&](NetworkNodeConfig* c) {
+    c->simulation.bandwidth = link_capacity;
+    c->simulation.delay = TimeDelta::ms(50);
+    c->simulation.loss_rate = loss_rate;
+    c->update_frequency = TimeDelta::ms(5);
+  });
+  auto ret_net = s.CreateSimulationNode([](NetworkNodeConfig* c) {
+    c->simulation.delay = TimeDelta::ms(50);
+    c->update_frequency = TimeDelta::ms(5);
+  });
+  SimulatedTimeClient* client = s.CreateSimulatedTimeClient(
+      "send", config, {PacketStreamConfig()}, {send_net}, {ret_net});
+  s.RunFor(TimeDelta::seconds(60));
+  return DataRate::kbps(client->target_rate_kbps());
+}
+}  // namespace
 
 TEST(GoogCcNetworkControllerTest, MaintainsLowRateInSafeResetTrial) {
   const DataRate kLinkCapacity = DataRate::kbps(200);
@@ -114,5 +147,32 @@ TEST(GoogCcNetworkControllerTest, DetectsHighRateInSafeResetTrial) {
   EXPECT_GT(client->send_bandwidth().kbps(), kNewLinkCapacity.kbps() - 300);
 }
 
+TEST(GoogCcNetworkControllerTest,
+     LossBasedControlIgnoringRandomLossGivesHigherRateOnLossyLink) {
+  const DataRate kLinkCapacity = DataRate::kbps(5000);
+  const double kLossRate = 0.05;
+  DataRate rate_all_losses =
+      RunLossyLink("WebRTC-Bwe-LossBasedControl/Enabled/",
+                   "random_loss_all_losses", kLinkCapacity, kLossRate);
+  DataRate rate_congestion_losses = RunLossyLink(
+      "WebRTC-Bwe-LossBasedControl/Enabled,rand_loss_weight:0.1/",
+      "random_loss_congestion_losses", kLinkCapacity, kLossRate);
+  // Random losses are not caused by the sent rate, so the rate should not be
+  // cut as much for them.
+  EXPECT_GT(rate_congestion_losses, rate_all_losses * 1.2);
+}
+
+TEST(GoogCcNetworkControllerTest,
+     LossBasedControlIgnoringRandomLossStaysBelowLinkCapacity) {
+  const DataRate kLinkCapacity = DataRate::kbps(1000);
+  DataRate rate = RunLossyLink(
+      "WebRTC-Bwe-LossBasedControl/Enabled,rand_loss_weight:0.1/",
+      "random_loss_constrained", kLinkCapacity, 0.05);
+  // The losses ignored as random must not make the rate overshoot a link that
+  // is actually congested.
+  EXPECT_LT(rate, kLinkCapacity * 1.2);
+  EXPECT_GT(rate, kLinkCapacity * 0.5);
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -38,6 +38,10 @@ class ReceiveSideCongestionController : public CallStatsObserver,
   virtual void OnReceivedPacket(int64_t arrival_time_ms,
                                 size_t payload_size,
                                 const RTPHeader& header);
+  // Same as calling OnReceivedPacket() for each of |packets|, but lets the
+  // receive-side estimator update its state and notify once per batch.
+  virtual void OnReceivedPackets(
+      const std::vector<RemoteBitrateEstimator::ReceivedPacket>& packets);
 
   // TODO(nisse): Delete these methods, design a more specific interface.
   virtual RemoteBitrateEstimator* GetRemoteBitrateEstimator(bool send_side_bwe);
@@ -66,6 +70,8 @@ class ReceiveSideCongestionController : public CallStatsObserver,
                         size_t payload_size,
                         const RTPHeader& header) override;
 
+    void IncomingPackets(const std::vector<ReceivedPacket>& packets) override;
+
     void Process() override;
 
     int64_t TimeUntilNextProcess() override;
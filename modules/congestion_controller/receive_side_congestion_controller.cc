@@ -44,6 +44,25 @@ void ReceiveSideCongestionController::WrappingBitrateEstimator::IncomingPacket(
   rbe_->IncomingPacket(arrival_time_ms, payload_size, header);
 }
 
+void ReceiveSideCongestionController::WrappingBitrateEstimator::IncomingPackets(
+    const std::vector<ReceivedPacket>& packets) {
+  rtc::CritScope cs(&crit_sect_);
+  // Packets before a switch of estimator would only have updated the replaced
+  // one, so only the packets after the last switch are passed on.
+  auto first = packets.begin();
+  for (auto it = packets.begin(); it != packets.end(); ++it) {
+    const RemoteBitrateEstimator* rbe = rbe_.get();
+    PickEstimatorFromHeader(it->header);
+    if (rbe_.get() != rbe)
+      first = it;
+  }
+  if (first == packets.begin()) {
+    rbe_->IncomingPackets(packets);
+  } else {
+    rbe_->IncomingPackets(std::vector<ReceivedPacket>(first, packets.end()));
+  }
+}
+
 void ReceiveSideCongestionController::WrappingBitrateEstimator::Process() {
   rtc::CritScope cs(&crit_sect_);
   rbe_->Process();
@@ -140,6 +159,21 @@ void ReceiveSideCongestionController::OnReceivedPacket(
   }
 }
 
+void ReceiveSideCongestionController::OnReceivedPackets(
+    const std::vector<RemoteBitrateEstimator::ReceivedPacket>& packets) {
+  std::vector<RemoteBitrateEstimator::ReceivedPacket> receive_side_packets;
+  for (const RemoteBitrateEstimator::ReceivedPacket& packet : packets) {
+    if (packet.header.extension.hasTransportSequenceNumber) {
+      remote_estimator_proxy_.IncomingPacket(
+          packet.arrival_time_ms, packet.payload_size, packet.header);
+    } else {
+      receive_side_packets.push_back(packet);
+    }
+  }
+  if (!receive_side_packets.empty())
+    remote_bitrate_estimator_.IncomingPackets(receive_side_packets);
+}
+
 RemoteBitrateEstimator*
 ReceiveSideCongestionController::GetRemoteBitrateEstimator(bool send_side_bwe) {
   if (send_side_bwe) {
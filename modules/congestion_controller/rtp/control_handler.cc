@@ -28,6 +28,12 @@ bool IsPacerPushbackExperimentEnabled() {
   return field_trial::IsEnabled("WebRTC-PacerPushbackExperiment");
 }
 
+// When enabled with PacerPushbackExperiment, the target rate is not pushed
+// back. Instead the encoder is asked to drop frames in proportion.
+bool IsPushbackDropFrameEnabled() {
+  return field_trial::IsEnabled("WebRTC-Pushback-DropFrame");
+}
+
 // By default, pacer emergency stops encoder when buffer reaches a high level.
 bool IsPacerEmergencyStopDisabled() {
   return field_trial::IsEnabled("WebRTC-DisablePacerEmergencyStop");
@@ -36,6 +42,7 @@ bool IsPacerEmergencyStopDisabled() {
 }  // namespace
 CongestionControlHandler::CongestionControlHandler()
     : pacer_pushback_experiment_(IsPacerPushbackExperimentEnabled()),
+      pushback_drop_frame_(IsPushbackDropFrameEnabled()),
       disable_pacer_emergency_stop_(IsPacerEmergencyStopDisabled()) {
   sequenced_checker_.Detach();
 }
@@ -76,18 +83,29 @@ absl::optional<TargetTransferRate> CongestionControlHandler::GetUpdate() {
       encoding_rate_ratio_ = std::min(encoding_rate_ratio_, encoding_ratio);
       encoding_rate_ratio_ = std::max(encoding_rate_ratio_, 0.0);
     }
-    new_outgoing.target_rate = new_outgoing.target_rate * encoding_rate_ratio_;
-    log_target_rate = new_outgoing.target_rate;
-    if (new_outgoing.target_rate < DataRate::kbps(50))
+    DataRate pushback_target_rate =
+        new_outgoing.target_rate * encoding_rate_ratio_;
+    if (pushback_drop_frame_) {
+      // Frames the congestion window leaves to be sent are reduced further.
+      new_outgoing.cwnd_reduce_ratio =
+          1.0 - (1.0 - new_outgoing.cwnd_reduce_ratio) * encoding_rate_ratio_;
+    } else {
+      new_outgoing.target_rate = pushback_target_rate;
+    }
+    log_target_rate = pushback_target_rate;
+    if (pushback_target_rate < DataRate::kbps(50))
       pause_encoding = true;
   } else if (!disable_pacer_emergency_stop_ &&
              pacer_expected_queue_ms_ > PacedSender::kMaxQueueLengthMs) {
     pause_encoding = true;
   }
-  if (pause_encoding)
+  if (pause_encoding) {
     new_outgoing.target_rate = DataRate::Zero();
+    new_outgoing.cwnd_reduce_ratio = 0;
+  }
   if (!last_reported_ ||
       last_reported_->target_rate != new_outgoing.target_rate ||
+      last_reported_->cwnd_reduce_ratio != new_outgoing.cwnd_reduce_ratio ||
       (!new_outgoing.target_rate.IsZero() &&
        (last_reported_->network_estimate.loss_rate_ratio !=
             new_outgoing.network_estimate.loss_rate_ratio ||
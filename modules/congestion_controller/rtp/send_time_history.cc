@@ -30,18 +30,30 @@ void SendTimeHistory::AddAndRemoveOld(const PacketFeedback& packet) {
   int64_t now_ms = clock_->TimeInMilliseconds();
   // Remove old.
   while (!history_.empty() &&
-         now_ms - history_.begin()->second.creation_time_ms >
-             packet_age_limit_ms_) {
+         now_ms - history_.front()->creation_time_ms > packet_age_limit_ms_) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    RemovePacketBytes(history_.begin()->second);
-    history_.erase(history_.begin());
+    RemovePacketBytes(*history_.front());
+    history_.pop_front();
+    ++first_seq_num_;
+    TrimFront();
   }
 
   // Add new.
   int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(packet.sequence_number);
   PacketFeedback packet_copy = packet;
   packet_copy.long_sequence_number = unwrapped_seq_num;
-  history_.insert(std::make_pair(unwrapped_seq_num, packet_copy));
+  if (history_.empty()) {
+    first_seq_num_ = unwrapped_seq_num;
+  } else if (unwrapped_seq_num < first_seq_num_) {
+    history_.insert(history_.begin(), first_seq_num_ - unwrapped_seq_num,
+                    absl::nullopt);
+    first_seq_num_ = unwrapped_seq_num;
+  }
+  const size_t index = unwrapped_seq_num - first_seq_num_;
+  if (index >= history_.size())
+    history_.resize(index + 1);
+  if (!history_[index])
+    history_[index].emplace(packet_copy);
   if (packet.send_time_ms >= 0) {
     AddPacketBytes(packet_copy);
     last_send_time_ms_ = std::max(last_send_time_ms_, packet.send_time_ms);
@@ -60,20 +72,21 @@ void SendTimeHistory::AddUntracked(size_t packet_size, int64_t send_time_ms) {
 bool SendTimeHistory::OnSentPacket(uint16_t sequence_number,
                                    int64_t send_time_ms) {
   int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  absl::optional<PacketFeedback>* entry = Find(unwrapped_seq_num);
+  if (!entry || !*entry)
     return false;
-  bool packet_retransmit = it->second.send_time_ms >= 0;
-  it->second.send_time_ms = send_time_ms;
+  PacketFeedback& packet = **entry;
+  bool packet_retransmit = packet.send_time_ms >= 0;
+  packet.send_time_ms = send_time_ms;
   last_send_time_ms_ = std::max(last_send_time_ms_, send_time_ms);
   if (!packet_retransmit)
-    AddPacketBytes(it->second);
+    AddPacketBytes(packet);
   if (pending_untracked_size_ > 0) {
     if (send_time_ms < last_untracked_send_time_ms_)
       RTC_LOG(LS_WARNING)
           << "appending acknowledged data for out of order packet. (Diff: "
           << last_untracked_send_time_ms_ - send_time_ms << " ms.)";
-    it->second.unacknowledged_data += pending_untracked_size_;
+    packet.unacknowledged_data += pending_untracked_size_;
     pending_untracked_size_ = 0;
   }
   return true;
@@ -83,11 +96,10 @@ absl::optional<PacketFeedback> SendTimeHistory::GetPacket(
     uint16_t sequence_number) const {
   int64_t unwrapped_seq_num =
       seq_num_unwrapper_.UnwrapWithoutUpdate(sequence_number);
-  absl::optional<PacketFeedback> optional_feedback;
-  auto it = history_.find(unwrapped_seq_num);
-  if (it != history_.end())
-    optional_feedback.emplace(it->second);
-  return optional_feedback;
+  const absl::optional<PacketFeedback>* entry = Find(unwrapped_seq_num);
+  if (!entry)
+    return absl::nullopt;
+  return *entry;
 }
 
 bool SendTimeHistory::GetFeedback(PacketFeedback* packet_feedback,
@@ -97,17 +109,19 @@ bool SendTimeHistory::GetFeedback(PacketFeedback* packet_feedback,
       seq_num_unwrapper_.Unwrap(packet_feedback->sequence_number);
   UpdateAckedSeqNum(unwrapped_seq_num);
   RTC_DCHECK_GE(*last_ack_seq_num_, 0);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  absl::optional<PacketFeedback>* entry = Find(unwrapped_seq_num);
+  if (!entry || !*entry)
     return false;
 
   // Save arrival_time not to overwrite it.
   int64_t arrival_time_ms = packet_feedback->arrival_time_ms;
-  *packet_feedback = it->second;
+  *packet_feedback = **entry;
   packet_feedback->arrival_time_ms = arrival_time_ms;
 
-  if (remove)
-    history_.erase(it);
+  if (remove) {
+    entry->reset();
+    TrimFront();
+  }
   return true;
 }
 
@@ -124,11 +138,32 @@ DataSize SendTimeHistory::GetOutstandingData(uint16_t local_net_id,
 absl::optional<int64_t> SendTimeHistory::GetFirstUnackedSendTime() const {
   if (!last_ack_seq_num_)
     return absl::nullopt;
-  auto it = history_.find(*last_ack_seq_num_);
-  if (it == history_.end() ||
-      it->second.send_time_ms == PacketFeedback::kNoSendTime)
+  const absl::optional<PacketFeedback>* entry = Find(*last_ack_seq_num_);
+  if (!entry || !*entry ||
+      (*entry)->send_time_ms == PacketFeedback::kNoSendTime)
     return absl::nullopt;
-  return it->second.send_time_ms;
+  return (*entry)->send_time_ms;
+}
+
+absl::optional<PacketFeedback>* SendTimeHistory::Find(
+    int64_t unwrapped_seq_num) {
+  if (unwrapped_seq_num < first_seq_num_ ||
+      unwrapped_seq_num - first_seq_num_ >=
+          static_cast<int64_t>(history_.size()))
+    return nullptr;
+  return &history_[unwrapped_seq_num - first_seq_num_];
+}
+
+const absl::optional<PacketFeedback>* SendTimeHistory::Find(
+    int64_t unwrapped_seq_num) const {
+  return const_cast<SendTimeHistory*>(this)->Find(unwrapped_seq_num);
+}
+
+void SendTimeHistory::TrimFront() {
+  while (!history_.empty() && !history_.front()) {
+    history_.pop_front();
+    ++first_seq_num_;
+  }
 }
 
 void SendTimeHistory::AddPacketBytes(const PacketFeedback& packet) {
@@ -160,13 +195,17 @@ void SendTimeHistory::UpdateAckedSeqNum(int64_t acked_seq_num) {
   if (last_ack_seq_num_ && *last_ack_seq_num_ >= acked_seq_num)
     return;
 
-  auto unacked_it = history_.begin();
+  int64_t unacked_seq_num = first_seq_num_;
   if (last_ack_seq_num_)
-    unacked_it = history_.lower_bound(*last_ack_seq_num_);
-
-  auto newly_acked_end = history_.upper_bound(acked_seq_num);
-  for (; unacked_it != newly_acked_end; ++unacked_it) {
-    RemovePacketBytes(unacked_it->second);
+    unacked_seq_num = std::max(unacked_seq_num, *last_ack_seq_num_);
+
+  const int64_t newly_acked_end = std::min<int64_t>(
+      acked_seq_num + 1, first_seq_num_ + history_.size());
+  for (; unacked_seq_num < newly_acked_end; ++unacked_seq_num) {
+    const absl::optional<PacketFeedback>& entry =
+        history_[unacked_seq_num - first_seq_num_];
+    if (entry)
+      RemovePacketBytes(*entry);
   }
   last_ack_seq_num_.emplace(acked_seq_num);
 }
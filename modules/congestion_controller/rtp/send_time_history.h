@@ -11,9 +11,11 @@
 #ifndef MODULES_CONGESTION_CONTROLLER_RTP_SEND_TIME_HISTORY_H_
 #define MODULES_CONGESTION_CONTROLLER_RTP_SEND_TIME_HISTORY_H_
 
+#include <deque>
 #include <map>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "api/units/data_size.h"
 #include "modules/include/module_common_types.h"
 #include "rtc_base/constructormagic.h"
@@ -52,6 +54,13 @@ class SendTimeHistory {
  private:
   using RemoteAndLocalNetworkId = std::pair<uint16_t, uint16_t>;
 
+  // Returns the entry for |unwrapped_seq_num|, or null if it is outside of
+  // |history_|. The entry holds no value if the packet is not in the history.
+  absl::optional<PacketFeedback>* Find(int64_t unwrapped_seq_num);
+  const absl::optional<PacketFeedback>* Find(int64_t unwrapped_seq_num) const;
+  // Removes the entries without a value from the front of |history_|.
+  void TrimFront();
+
   void AddPacketBytes(const PacketFeedback& packet);
   void RemovePacketBytes(const PacketFeedback& packet);
   void UpdateAckedSeqNum(int64_t acked_seq_num);
@@ -61,7 +70,11 @@ class SendTimeHistory {
   int64_t last_send_time_ms_ = -1;
   int64_t last_untracked_send_time_ms_ = -1;
   SequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketFeedback> history_;
+  // Packets by unwrapped sequence number, starting at |first_seq_num_|. Since
+  // sequence numbers are assigned in send order, this is a contiguous window
+  // and lookups don't need to search.
+  std::deque<absl::optional<PacketFeedback>> history_;
+  int64_t first_seq_num_ = 0;
   absl::optional<int64_t> last_ack_seq_num_;
   std::map<RemoteAndLocalNetworkId, size_t> in_flight_bytes_;
 
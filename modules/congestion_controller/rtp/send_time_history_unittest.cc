@@ -253,5 +253,25 @@ TEST_F(SendTimeHistoryTest, InterlievedGetAndRemove) {
   EXPECT_TRUE(history_.GetFeedback(&packet3, true));
   EXPECT_EQ(packets[2], packet3);
 }
+
+TEST_F(SendTimeHistoryTest, OutstandingDataWithGapsInSequenceNumbers) {
+  const PacedPacketInfo kPacingInfo;
+  // Sequence numbers 11 and 12 are never added, e.g. sent on another path.
+  AddPacketWithSendTime(10, 100, 1, kPacingInfo);
+  AddPacketWithSendTime(13, 200, 2, kPacingInfo);
+  AddPacketWithSendTime(14, 400, 3, kPacingInfo);
+  EXPECT_EQ(DataSize::bytes(700), history_.GetOutstandingData(0, 0));
+
+  PacketFeedback packet(0, 12);
+  EXPECT_FALSE(history_.GetFeedback(&packet, true));
+  // Packets up to the acknowledged one are no longer outstanding.
+  EXPECT_EQ(DataSize::bytes(600), history_.GetOutstandingData(0, 0));
+
+  packet = PacketFeedback(0, 14);
+  EXPECT_TRUE(history_.GetFeedback(&packet, true));
+  EXPECT_EQ(DataSize::Zero(), history_.GetOutstandingData(0, 0));
+  EXPECT_FALSE(history_.GetPacket(14));
+  EXPECT_EQ(2, history_.GetPacket(13)->send_time_ms);
+}
 }  // namespace test
 }  // namespace webrtc
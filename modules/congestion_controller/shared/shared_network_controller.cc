@@ -0,0 +1,198 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/shared/shared_network_controller.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+namespace {
+// The scale factor of a controller is only changed between its own target
+// rate updates if the share of the group rate changed by at least this much.
+constexpr double kMinScaleChange = 0.05;
+
+template <typename Unit>
+Unit Scale(Unit value, double factor) {
+  return value.IsFinite() ? value * factor : value;
+}
+}  // namespace
+
+// The current estimates of the controllers in a group.
+class SharedNetworkControllerFactory::Group : public rtc::RefCountInterface {
+ public:
+  int AddMember() {
+    rtc::CritScope lock(&crit_);
+    int id = next_id_++;
+    estimates_bps_[id] = 0;
+    return id;
+  }
+
+  void RemoveMember(int id) {
+    rtc::CritScope lock(&crit_);
+    estimates_bps_.erase(id);
+  }
+
+  void SetEstimate(int id, DataRate estimate) {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(estimates_bps_.count(id));
+    estimates_bps_[id] = estimate.IsFinite() ? estimate.bps() : 0;
+  }
+
+  // Returns the factor by which the estimate of |id| is scaled to get its
+  // share of the group rate.
+  double GetScaleFactor(int id) const {
+    rtc::CritScope lock(&crit_);
+    int64_t max_bps = 0;
+    int64_t sum_bps = 0;
+    for (const auto& kv : estimates_bps_) {
+      max_bps = std::max(max_bps, kv.second);
+      sum_bps += kv.second;
+    }
+    auto it = estimates_bps_.find(id);
+    if (it == estimates_bps_.end() || it->second == 0 || sum_bps == 0)
+      return 1.0;
+    // share = max * estimate / sum, relative to the estimate.
+    return static_cast<double>(max_bps) / sum_bps;
+  }
+
+ private:
+  rtc::CriticalSection crit_;
+  std::map<int, int64_t> estimates_bps_ RTC_GUARDED_BY(crit_);
+  int next_id_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+// Wraps the controller of one transport in a group.
+class SharedNetworkControllerFactory::Controller
+    : public NetworkControllerInterface {
+ public:
+  Controller(std::unique_ptr<NetworkControllerInterface> controller,
+             rtc::scoped_refptr<Group> group)
+      : controller_(std::move(controller)),
+        group_(std::move(group)),
+        id_(group_->AddMember()) {}
+
+  ~Controller() override { group_->RemoveMember(id_); }
+
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override {
+    return Share(controller_->OnNetworkAvailability(msg));
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override {
+    return Share(controller_->OnNetworkRouteChange(msg));
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override {
+    return Share(controller_->OnProcessInterval(msg));
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override {
+    return Share(controller_->OnRemoteBitrateReport(msg));
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override {
+    return Share(controller_->OnRoundTripTimeUpdate(msg));
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override {
+    return Share(controller_->OnSentPacket(msg));
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override {
+    return Share(controller_->OnStreamsConfig(msg));
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override {
+    return Share(controller_->OnTargetRateConstraints(msg));
+  }
+  NetworkControlUpdate OnTransportLossReport(
+      TransportLossReport msg) override {
+    return Share(controller_->OnTransportLossReport(msg));
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override {
+    return Share(controller_->OnTransportPacketsFeedback(msg));
+  }
+
+ private:
+  // Scales the update of the wrapped controller to its share of the group
+  // rate. If the share changed since the last update, the last target rate,
+  // pacer config and congestion window are scaled again, so that controllers
+  // follow changes of the other controllers' estimates.
+  NetworkControlUpdate Share(NetworkControlUpdate update) {
+    if (update.target_rate) {
+      last_target_rate_ = update.target_rate;
+      group_->SetEstimate(id_, update.target_rate->target_rate);
+    }
+    if (update.pacer_config)
+      last_pacer_config_ = update.pacer_config;
+    if (update.congestion_window)
+      last_congestion_window_ = update.congestion_window;
+
+    double scale_factor = group_->GetScaleFactor(id_);
+    if (std::abs(scale_factor - scale_factor_) >= kMinScaleChange) {
+      update.target_rate = last_target_rate_;
+      update.pacer_config = last_pacer_config_;
+      update.congestion_window = last_congestion_window_;
+      scale_factor_ = scale_factor;
+    } else if (update.target_rate) {
+      scale_factor_ = scale_factor;
+    }
+
+    if (update.target_rate) {
+      update.target_rate->target_rate =
+          Scale(update.target_rate->target_rate, scale_factor_);
+    }
+    if (update.pacer_config) {
+      update.pacer_config->data_window =
+          Scale(update.pacer_config->data_window, scale_factor_);
+      update.pacer_config->pad_window =
+          Scale(update.pacer_config->pad_window, scale_factor_);
+    }
+    if (update.congestion_window) {
+      update.congestion_window =
+          Scale(*update.congestion_window, scale_factor_);
+    }
+    return update;
+  }
+
+  const std::unique_ptr<NetworkControllerInterface> controller_;
+  const rtc::scoped_refptr<Group> group_;
+  const int id_;
+  double scale_factor_ = 1.0;
+  absl::optional<TargetTransferRate> last_target_rate_;
+  absl::optional<PacerConfig> last_pacer_config_;
+  absl::optional<DataSize> last_congestion_window_;
+};
+
+SharedNetworkControllerFactory::SharedNetworkControllerFactory(
+    std::unique_ptr<NetworkControllerFactoryInterface> factory)
+    : factory_(std::move(factory)),
+      group_(new rtc::RefCountedObject<Group>()) {
+  RTC_DCHECK(factory_);
+}
+
+SharedNetworkControllerFactory::~SharedNetworkControllerFactory() = default;
+
+std::unique_ptr<NetworkControllerInterface>
+SharedNetworkControllerFactory::Create(NetworkControllerConfig config) {
+  return absl::make_unique<Controller>(factory_->Create(config), group_);
+}
+
+TimeDelta SharedNetworkControllerFactory::GetProcessInterval() const {
+  return factory_->GetProcessInterval();
+}
+
+}  // namespace webrtc
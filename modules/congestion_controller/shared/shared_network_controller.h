@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_SHARED_SHARED_NETWORK_CONTROLLER_H_
+#define MODULES_CONGESTION_CONTROLLER_SHARED_SHARED_NETWORK_CONTROLLER_H_
+
+#include <memory>
+
+#include "api/transport/network_control.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/scoped_ref_ptr.h"
+
+namespace webrtc {
+
+// Creates network controllers for transports that share a bottleneck, such as
+// several PeerConnections from a server to the same client. Each controller
+// wraps one created by the given factory, but its target rate, pacing rate and
+// congestion window are scaled down so that all the controllers of the group
+// together send no more than the highest rate estimated by any one of them.
+// The rate is divided in proportion to the controllers' own estimates. This
+// keeps the controllers from overshooting the shared link while competing
+// with each other.
+//
+// The controllers created by one factory form a group; use a factory per
+// remote host, or per configured group of transports. The controllers may be
+// used on different threads.
+class SharedNetworkControllerFactory
+    : public NetworkControllerFactoryInterface {
+ public:
+  explicit SharedNetworkControllerFactory(
+      std::unique_ptr<NetworkControllerFactoryInterface> factory);
+  ~SharedNetworkControllerFactory() override;
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override;
+  TimeDelta GetProcessInterval() const override;
+
+ private:
+  class Controller;
+  class Group;
+
+  const std::unique_ptr<NetworkControllerFactoryInterface> factory_;
+  const rtc::scoped_refptr<Group> group_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_SHARED_SHARED_NETWORK_CONTROLLER_H_
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/shared/shared_network_controller.h"
+
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// Reports the target rate set by the test on every process interval.
+class FakeNetworkController : public NetworkControllerInterface {
+ public:
+  explicit FakeNetworkController(DataRate* target_rate)
+      : target_rate_(target_rate) {}
+
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override {
+    NetworkControlUpdate update;
+    update.target_rate = TargetTransferRate();
+    update.target_rate->at_time = msg.at_time;
+    update.target_rate->target_rate = *target_rate_;
+    update.pacer_config = PacerConfig();
+    update.pacer_config->at_time = msg.at_time;
+    update.pacer_config->time_window = TimeDelta::seconds(1);
+    update.pacer_config->data_window = *target_rate_ * TimeDelta::seconds(1);
+    return update;
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback) override {
+    return NetworkControlUpdate();
+  }
+
+ private:
+  DataRate* const target_rate_;
+};
+
+// Creates controllers reporting the rates in |target_rates|, in order.
+class FakeNetworkControllerFactory : public NetworkControllerFactoryInterface {
+ public:
+  explicit FakeNetworkControllerFactory(DataRate* target_rates)
+      : target_rates_(target_rates) {}
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig) override {
+    return absl::make_unique<FakeNetworkController>(
+        &target_rates_[num_created_++]);
+  }
+  TimeDelta GetProcessInterval() const override {
+    return TimeDelta::ms(25);
+  }
+
+ private:
+  DataRate* const target_rates_;
+  int num_created_ = 0;
+};
+
+ProcessInterval Process() {
+  ProcessInterval msg;
+  msg.at_time = Timestamp::ms(1000);
+  return msg;
+}
+
+}  // namespace
+
+class SharedNetworkControllerTest : public ::testing::Test {
+ protected:
+  SharedNetworkControllerTest()
+      : target_rates_{DataRate::kbps(600), DataRate::kbps(300)},
+        factory_(absl::make_unique<FakeNetworkControllerFactory>(
+            target_rates_)) {}
+
+  DataRate target_rates_[2];
+  SharedNetworkControllerFactory factory_;
+};
+
+TEST_F(SharedNetworkControllerTest, SingleControllerIsNotScaled) {
+  auto controller = factory_.Create(NetworkControllerConfig());
+  NetworkControlUpdate update = controller->OnProcessInterval(Process());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(600), update.target_rate->target_rate);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(DataRate::kbps(600), update.pacer_config->data_rate());
+  EXPECT_EQ(25, factory_.GetProcessInterval().ms());
+}
+
+TEST_F(SharedNetworkControllerTest, ControllersShareHighestEstimate) {
+  auto first = factory_.Create(NetworkControllerConfig());
+  auto second = factory_.Create(NetworkControllerConfig());
+  first->OnProcessInterval(Process());
+
+  // 900 kbps estimated in total, scaled down to the highest estimate.
+  NetworkControlUpdate update = second->OnProcessInterval(Process());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(200), update.target_rate->target_rate);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(DataRate::kbps(200), update.pacer_config->data_rate());
+
+  update = first->OnProcessInterval(Process());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(400), update.target_rate->target_rate);
+}
+
+TEST_F(SharedNetworkControllerTest, ShareIsUpdatedWithoutNewEstimate) {
+  auto first = factory_.Create(NetworkControllerConfig());
+  first->OnProcessInterval(Process());
+  {
+    auto second = factory_.Create(NetworkControllerConfig());
+    second->OnProcessInterval(Process());
+    NetworkControlUpdate update = first->OnSentPacket(SentPacket());
+    ASSERT_TRUE(update.target_rate);
+    EXPECT_EQ(DataRate::kbps(400), update.target_rate->target_rate);
+    // Not repeated while the share is unchanged.
+    EXPECT_FALSE(first->OnSentPacket(SentPacket()).target_rate);
+  }
+
+  // The other controller is gone, so the full estimate is used again.
+  NetworkControlUpdate update = first->OnSentPacket(SentPacket());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(600), update.target_rate->target_rate);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(DataRate::kbps(600), update.pacer_config->data_rate());
+}
+
+}  // namespace test
+}  // namespace webrtc
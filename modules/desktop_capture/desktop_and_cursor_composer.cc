@@ -60,15 +60,26 @@ void AlphaBlend(uint8_t* dest,
 }
 
 // DesktopFrame wrapper that draws mouse on a frame and restores original
-// content before releasing the underlying frame.
+// content before releasing the underlying frame. Only the pixels under the
+// cursor are touched, and only the cursor rect and |previous_cursor_rect| are
+// added to the updated region.
 class DesktopFrameWithCursor : public DesktopFrame {
  public:
   // Takes ownership of |frame|.
   DesktopFrameWithCursor(std::unique_ptr<DesktopFrame> frame,
                          const MouseCursor& cursor,
-                         const DesktopVector& position);
+                         const DesktopVector& position,
+                         const DesktopRect& previous_cursor_rect);
   ~DesktopFrameWithCursor() override;
 
+  // The area of the frame the cursor was drawn on.
+  DesktopRect cursor_rect() const {
+    DesktopRect rect = DesktopRect::MakeSize(
+        restore_frame_ ? restore_frame_->size() : DesktopSize());
+    rect.Translate(restore_position_);
+    return rect;
+  }
+
  private:
   const std::unique_ptr<DesktopFrame> original_frame_;
 
@@ -81,7 +92,8 @@ class DesktopFrameWithCursor : public DesktopFrame {
 DesktopFrameWithCursor::DesktopFrameWithCursor(
     std::unique_ptr<DesktopFrame> frame,
     const MouseCursor& cursor,
-    const DesktopVector& position)
+    const DesktopVector& position,
+    const DesktopRect& previous_cursor_rect)
     : DesktopFrame(frame->size(),
                    frame->stride(),
                    frame->data(),
@@ -89,6 +101,12 @@ DesktopFrameWithCursor::DesktopFrameWithCursor(
       original_frame_(std::move(frame)) {
   MoveFrameInfoFrom(original_frame_.get());
 
+  // The previous frame showed the cursor over content that is restored now.
+  DesktopRect previous_rect = previous_cursor_rect;
+  previous_rect.IntersectWith(DesktopRect::MakeSize(size()));
+  if (!previous_rect.is_empty())
+    mutable_updated_region()->AddRect(previous_rect);
+
   DesktopVector image_pos = position.subtract(cursor.hotspot());
   DesktopRect target_rect = DesktopRect::MakeSize(cursor.image()->size());
   target_rect.Translate(image_pos);
@@ -104,6 +122,8 @@ DesktopFrameWithCursor::DesktopFrameWithCursor(
   restore_frame_->CopyPixelsFrom(*this, target_rect.top_left(),
                                  DesktopRect::MakeSize(restore_frame_->size()));
 
+  mutable_updated_region()->AddRect(target_rect);
+
   // Blit the cursor.
   uint8_t* target_rect_data = reinterpret_cast<uint8_t*>(data()) +
                               target_rect.top() * stride() +
@@ -168,6 +188,7 @@ void DesktopAndCursorComposer::SetExcludedWindow(WindowId window) {
 void DesktopAndCursorComposer::OnCaptureResult(
     DesktopCapturer::Result result,
     std::unique_ptr<DesktopFrame> frame) {
+  bool cursor_drawn = false;
   if (frame && cursor_) {
     if (frame->rect().Contains(cursor_position_) &&
         !desktop_capturer_->IsOccluded(cursor_position_)) {
@@ -184,10 +205,22 @@ void DesktopAndCursorComposer::OnCaptureResult(
       relative_position.set(relative_position.x() * scale,
                             relative_position.y() * scale);
 #endif
-      frame = absl::make_unique<DesktopFrameWithCursor>(
-          std::move(frame), *cursor_, relative_position);
+      auto frame_with_cursor = absl::make_unique<DesktopFrameWithCursor>(
+          std::move(frame), *cursor_, relative_position, previous_cursor_rect_);
+      previous_cursor_rect_ = frame_with_cursor->cursor_rect();
+      frame = std::move(frame_with_cursor);
+      cursor_drawn = true;
     }
   }
+  if (frame && !cursor_drawn && !previous_cursor_rect_.is_empty()) {
+    // The cursor is no longer drawn, but the area it was last drawn on must
+    // still be updated, so that it doesn't linger on the receiving side.
+    DesktopRect previous_rect = previous_cursor_rect_;
+    previous_rect.IntersectWith(DesktopRect::MakeSize(frame->size()));
+    if (!previous_rect.is_empty())
+      frame->mutable_updated_region()->AddRect(previous_rect);
+    previous_cursor_rect_ = DesktopRect();
+  }
 
   callback_->OnCaptureResult(result, std::move(frame));
 }
@@ -74,6 +74,8 @@ class RTC_EXPORT DesktopAndCursorComposer
 
   std::unique_ptr<MouseCursor> cursor_;
   DesktopVector cursor_position_;
+  // Area the cursor was drawn on in the last frame, relative to the frame.
+  DesktopRect previous_cursor_rect_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(DesktopAndCursorComposer);
 };
@@ -317,4 +317,41 @@ TEST_F(DesktopAndCursorComposerTest, CursorIncluded) {
   }
 }
 
+TEST_F(DesktopAndCursorComposerTest, UpdatesCurrentAndPreviousCursorRects) {
+  const DesktopRect kFirstCursorRect =
+      DesktopRect::MakeXYWH(50, 50, kCursorWidth, kCursorHeight);
+  const DesktopRect kSecondCursorRect =
+      DesktopRect::MakeXYWH(20, 30, kCursorWidth, kCursorHeight);
+
+  fake_screen_->SetNextFrame(std::unique_ptr<DesktopFrame>(CreateTestFrame()));
+  fake_cursor_->SetState(MouseCursorMonitor::INSIDE,
+                         kFirstCursorRect.top_left());
+  blender_.CaptureFrame();
+  ASSERT_TRUE(frame_);
+  EXPECT_TRUE(frame_->updated_region().Equals(DesktopRegion(kFirstCursorRect)));
+
+  fake_screen_->SetNextFrame(std::unique_ptr<DesktopFrame>(CreateTestFrame()));
+  fake_cursor_->SetState(MouseCursorMonitor::INSIDE,
+                         kSecondCursorRect.top_left());
+  blender_.CaptureFrame();
+  ASSERT_TRUE(frame_);
+  DesktopRegion expected(kFirstCursorRect);
+  expected.AddRect(kSecondCursorRect);
+  EXPECT_TRUE(frame_->updated_region().Equals(expected));
+
+  // Moving the cursor out of the frame still updates its last position.
+  fake_screen_->SetNextFrame(std::unique_ptr<DesktopFrame>(CreateTestFrame()));
+  fake_cursor_->SetState(MouseCursorMonitor::OUTSIDE,
+                         DesktopVector(kScreenWidth + 10, 0));
+  blender_.CaptureFrame();
+  ASSERT_TRUE(frame_);
+  EXPECT_TRUE(
+      frame_->updated_region().Equals(DesktopRegion(kSecondCursorRect)));
+
+  fake_screen_->SetNextFrame(std::unique_ptr<DesktopFrame>(CreateTestFrame()));
+  blender_.CaptureFrame();
+  ASSERT_TRUE(frame_);
+  EXPECT_TRUE(frame_->updated_region().is_empty());
+}
+
 }  // namespace webrtc
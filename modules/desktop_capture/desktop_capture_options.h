@@ -99,6 +99,14 @@ class RTC_EXPORT DesktopCaptureOptions {
     detect_updated_region_ = detect_updated_region;
   }
 
+  // Flag that should be set to compare whole rows of blocks before comparing
+  // individual blocks when detecting the updated region. Only used if
+  // detect_updated_region() is true.
+  bool use_hierarchical_differ() const { return use_hierarchical_differ_; }
+  void set_use_hierarchical_differ(bool use_hierarchical_differ) {
+    use_hierarchical_differ_ = use_hierarchical_differ;
+  }
+
 #if defined(WEBRTC_WIN)
   bool allow_use_magnification_api() const {
     return allow_use_magnification_api_;
@@ -142,6 +150,7 @@ class RTC_EXPORT DesktopCaptureOptions {
 #endif
   bool disable_effects_ = true;
   bool detect_updated_region_ = false;
+  bool use_hierarchical_differ_ = false;
 #if defined(WEBRTC_USE_PIPEWIRE)
   bool allow_pipewire_ = false;
 #endif
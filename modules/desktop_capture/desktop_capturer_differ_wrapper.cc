@@ -24,6 +24,23 @@ namespace webrtc {
 
 namespace {
 
+// Returns true if any of the |height| lines of |width_bytes| bytes starting at
+// |old_buffer| and |new_buffer| differ.
+bool LinesDifference(const uint8_t* old_buffer,
+                     const uint8_t* new_buffer,
+                     int width_bytes,
+                     int height,
+                     int stride) {
+  for (int i = 0; i < height; i++) {
+    if (memcmp(old_buffer, new_buffer, width_bytes) != 0) {
+      return true;
+    }
+    old_buffer += stride;
+    new_buffer += stride;
+  }
+  return false;
+}
+
 // Returns true if (0, 0) - (|width|, |height|) vector in |old_buffer| and
 // |new_buffer| are equal. |width| should be less than 32
 // (defined by kBlockSize), otherwise BlockDifference() should be used.
@@ -33,21 +50,15 @@ bool PartialBlockDifference(const uint8_t* old_buffer,
                             int height,
                             int stride) {
   RTC_DCHECK_LT(width, kBlockSize);
-  const int width_bytes = width * DesktopFrame::kBytesPerPixel;
-  for (int i = 0; i < height; i++) {
-    if (memcmp(old_buffer, new_buffer, width_bytes) != 0) {
-      return true;
-    }
-    old_buffer += stride;
-    new_buffer += stride;
-  }
-  return false;
+  return LinesDifference(old_buffer, new_buffer,
+                         width * DesktopFrame::kBytesPerPixel, height, stride);
 }
 
 // Compares columns in the range of [|left|, |right|), in a row in the
 // range of [|top|, |top| + |height|), starts from |old_buffer| and
 // |new_buffer|, and outputs updated regions into |output|. |stride| is the
-// DesktopFrame::stride().
+// DesktopFrame::stride(). If |hierarchical| is true, the whole row is compared
+// line by line first, and the blocks are only compared if the row differs.
 void CompareRow(const uint8_t* old_buffer,
                 const uint8_t* new_buffer,
                 const int left,
@@ -55,10 +66,16 @@ void CompareRow(const uint8_t* old_buffer,
                 const int top,
                 const int bottom,
                 const int stride,
+                const bool hierarchical,
                 DesktopRegion* const output) {
   const int block_x_offset = kBlockSize * DesktopFrame::kBytesPerPixel;
   const int width = right - left;
   const int height = bottom - top;
+  if (hierarchical &&
+      !LinesDifference(old_buffer, new_buffer,
+                       width * DesktopFrame::kBytesPerPixel, height, stride)) {
+    return;
+  }
   const int block_count = (width - 1) / kBlockSize;
   const int last_block_width = width - block_count * kBlockSize;
   RTC_DCHECK_GT(last_block_width, 0);
@@ -113,6 +130,7 @@ void CompareRow(const uint8_t* old_buffer,
 void CompareFrames(const DesktopFrame& old_frame,
                    const DesktopFrame& new_frame,
                    DesktopRect rect,
+                   bool hierarchical,
                    DesktopRegion* const output) {
   RTC_DCHECK(old_frame.size().equals(new_frame.size()));
   RTC_DCHECK_EQ(old_frame.stride(), new_frame.stride());
@@ -131,21 +149,28 @@ void CompareFrames(const DesktopFrame& old_frame,
   // The last row may have a different height, so we handle it separately.
   for (int y = 0; y < y_block_count; y++) {
     CompareRow(prev_block_row_start, curr_block_row_start, rect.left(),
-               rect.right(), top, top + kBlockSize, old_frame.stride(), output);
+               rect.right(), top, top + kBlockSize, old_frame.stride(),
+               hierarchical, output);
     top += kBlockSize;
     prev_block_row_start += block_y_stride;
     curr_block_row_start += block_y_stride;
   }
   CompareRow(prev_block_row_start, curr_block_row_start, rect.left(),
              rect.right(), top, top + last_y_block_height, old_frame.stride(),
-             output);
+             hierarchical, output);
 }
 
 }  // namespace
 
 DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
     std::unique_ptr<DesktopCapturer> base_capturer)
-    : base_capturer_(std::move(base_capturer)) {
+    : DesktopCapturerDifferWrapper(std::move(base_capturer), false) {}
+
+DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
+    std::unique_ptr<DesktopCapturer> base_capturer,
+    bool hierarchical_differ)
+    : base_capturer_(std::move(base_capturer)),
+      hierarchical_differ_(hierarchical_differ) {
   RTC_DCHECK(base_capturer_);
 }
 
@@ -207,7 +232,7 @@ void DesktopCapturerDifferWrapper::OnCaptureResult(
     DesktopRegion hints;
     hints.Swap(frame->mutable_updated_region());
     for (DesktopRegion::Iterator it(hints); !it.IsAtEnd(); it.Advance()) {
-      CompareFrames(*last_frame_, *frame, it.rect(),
+      CompareFrames(*last_frame_, *frame, it.rect(), hierarchical_differ_,
                     frame->mutable_updated_region());
     }
   } else {
@@ -38,6 +38,12 @@ class DesktopCapturerDifferWrapper : public DesktopCapturer,
   explicit DesktopCapturerDifferWrapper(
       std::unique_ptr<DesktopCapturer> base_capturer);
 
+  // If |hierarchical_differ| is true, each row of blocks is compared as a whole
+  // first, and only rows containing changes are compared block by block. This
+  // is faster for large, mostly static frames.
+  DesktopCapturerDifferWrapper(std::unique_ptr<DesktopCapturer> base_capturer,
+                               bool hierarchical_differ);
+
   ~DesktopCapturerDifferWrapper() override;
 
   // DesktopCapturer interface.
@@ -57,6 +63,7 @@ class DesktopCapturerDifferWrapper : public DesktopCapturer,
                        std::unique_ptr<DesktopFrame> frame) override;
 
   const std::unique_ptr<DesktopCapturer> base_capturer_;
+  const bool hierarchical_differ_;
   DesktopCapturer::Callback* callback_;
   std::unique_ptr<SharedDesktopFrame> last_frame_;
 };
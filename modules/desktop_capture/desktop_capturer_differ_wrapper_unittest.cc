@@ -152,7 +152,8 @@ void ExecuteCapturer(DesktopCapturerDifferWrapper* capturer,
 void ExecuteDifferWrapperTest(bool with_hints,
                               bool enlarge_updated_region,
                               bool random_updated_region,
-                              bool check_result) {
+                              bool check_result,
+                              bool hierarchical_differ) {
   const bool updated_region_should_exactly_match =
       with_hints && !enlarge_updated_region && !random_updated_region;
   BlackWhiteDesktopFramePainter frame_painter;
@@ -160,7 +161,7 @@ void ExecuteDifferWrapperTest(bool with_hints,
   frame_generator.set_desktop_frame_painter(&frame_painter);
   std::unique_ptr<FakeDesktopCapturer> fake(new FakeDesktopCapturer());
   fake->set_frame_generator(&frame_generator);
-  DesktopCapturerDifferWrapper capturer(std::move(fake));
+  DesktopCapturerDifferWrapper capturer(std::move(fake), hierarchical_differ);
   MockDesktopCapturerCallback callback;
   frame_generator.set_provide_updated_region_hints(with_hints);
   frame_generator.set_enlarge_updated_region(enlarge_updated_region);
@@ -224,23 +225,32 @@ void ExecuteDifferWrapperTest(bool with_hints,
 }  // namespace
 
 TEST(DesktopCapturerDifferWrapperTest, CaptureWithoutHints) {
-  ExecuteDifferWrapperTest(false, false, false, true);
+  ExecuteDifferWrapperTest(false, false, false, true, false);
 }
 
 TEST(DesktopCapturerDifferWrapperTest, CaptureWithHints) {
-  ExecuteDifferWrapperTest(true, false, false, true);
+  ExecuteDifferWrapperTest(true, false, false, true, false);
 }
 
 TEST(DesktopCapturerDifferWrapperTest, CaptureWithEnlargedHints) {
-  ExecuteDifferWrapperTest(true, true, false, true);
+  ExecuteDifferWrapperTest(true, true, false, true, false);
 }
 
 TEST(DesktopCapturerDifferWrapperTest, CaptureWithRandomHints) {
-  ExecuteDifferWrapperTest(true, false, true, true);
+  ExecuteDifferWrapperTest(true, false, true, true, false);
 }
 
 TEST(DesktopCapturerDifferWrapperTest, CaptureWithEnlargedAndRandomHints) {
-  ExecuteDifferWrapperTest(true, true, true, true);
+  ExecuteDifferWrapperTest(true, true, true, true, false);
+}
+
+TEST(DesktopCapturerDifferWrapperTest, CaptureWithoutHintsHierarchical) {
+  ExecuteDifferWrapperTest(false, false, false, true, true);
+}
+
+TEST(DesktopCapturerDifferWrapperTest,
+     CaptureWithEnlargedAndRandomHintsHierarchical) {
+  ExecuteDifferWrapperTest(true, true, true, true, true);
 }
 
 // When hints are provided, DesktopCapturerDifferWrapper has a slightly better
@@ -258,32 +268,39 @@ TEST(DesktopCapturerDifferWrapperTest, CaptureWithEnlargedAndRandomHints) {
 // [       OK ] DISABLED_CaptureWithEnlargedAndRandomHintsPerf (6347 ms)
 TEST(DesktopCapturerDifferWrapperTest, DISABLED_CaptureWithoutHintsPerf) {
   int64_t started = rtc::TimeMillis();
-  ExecuteDifferWrapperTest(false, false, false, false);
+  ExecuteDifferWrapperTest(false, false, false, false, false);
   ASSERT_LE(rtc::TimeMillis() - started, 15000);
 }
 
 TEST(DesktopCapturerDifferWrapperTest, DISABLED_CaptureWithHintsPerf) {
   int64_t started = rtc::TimeMillis();
-  ExecuteDifferWrapperTest(true, false, false, false);
+  ExecuteDifferWrapperTest(true, false, false, false, false);
   ASSERT_LE(rtc::TimeMillis() - started, 15000);
 }
 
 TEST(DesktopCapturerDifferWrapperTest, DISABLED_CaptureWithEnlargedHintsPerf) {
   int64_t started = rtc::TimeMillis();
-  ExecuteDifferWrapperTest(true, true, false, false);
+  ExecuteDifferWrapperTest(true, true, false, false, false);
   ASSERT_LE(rtc::TimeMillis() - started, 15000);
 }
 
 TEST(DesktopCapturerDifferWrapperTest, DISABLED_CaptureWithRandomHintsPerf) {
   int64_t started = rtc::TimeMillis();
-  ExecuteDifferWrapperTest(true, false, true, false);
+  ExecuteDifferWrapperTest(true, false, true, false, false);
   ASSERT_LE(rtc::TimeMillis() - started, 15000);
 }
 
 TEST(DesktopCapturerDifferWrapperTest,
      DISABLED_CaptureWithEnlargedAndRandomHintsPerf) {
   int64_t started = rtc::TimeMillis();
-  ExecuteDifferWrapperTest(true, true, true, false);
+  ExecuteDifferWrapperTest(true, true, true, false, false);
+  ASSERT_LE(rtc::TimeMillis() - started, 15000);
+}
+
+TEST(DesktopCapturerDifferWrapperTest,
+     DISABLED_CaptureWithoutHintsHierarchicalPerf) {
+  int64_t started = rtc::TimeMillis();
+  ExecuteDifferWrapperTest(false, false, false, false, true);
   ASSERT_LE(rtc::TimeMillis() - started, 15000);
 }
 
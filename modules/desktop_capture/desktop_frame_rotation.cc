@@ -106,6 +106,12 @@ void RotateDesktopFrame(const DesktopFrame& source,
     return;
   }
 
+  // Rotating a rect by 0 degrees onto itself leaves it unchanged.
+  if (&source == target && rotation == Rotation::CLOCK_WISE_0 &&
+      target_rect.equals(source_rect)) {
+    return;
+  }
+
   int result = libyuv::ARGBRotate(
       source.GetFrameDataAtPos(source_rect.top_left()), source.stride(),
       target->GetFrameDataAtPos(target_rect.top_left()), target->stride(),
@@ -86,4 +86,19 @@ TEST(BlockDifferenceTestFirst, BlockDifference) {
   }
 }
 
+TEST(VectorDifferenceTest, DetectsDifferenceAtEveryByte) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+  EXPECT_FALSE(VectorDifference(block1, block2));
+
+  // Every byte of the vector must be covered by the selected implementation.
+  for (int i = 0; i < kBlockSize * kBytesPerPixel; ++i) {
+    block2[i] += 1;
+    EXPECT_TRUE(VectorDifference(block1, block2)) << "Byte " << i;
+    block2[i] -= 1;
+  }
+  EXPECT_FALSE(VectorDifference(block1, block2));
+}
+
 }  // namespace webrtc
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/differ_vector_neon.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+
+namespace {
+
+// Returns the bitwise difference of 16 bytes at |image1| and |image2|.
+inline uint8x16_t Difference(const uint8_t* image1, const uint8_t* image2) {
+  return veorq_u8(vld1q_u8(image1), vld1q_u8(image2));
+}
+
+inline bool IsNonZero(uint8x16_t acc) {
+  const uint64x2_t acc64 = vreinterpretq_u64_u8(acc);
+  return (vgetq_lane_u64(acc64, 0) | vgetq_lane_u64(acc64, 1)) != 0;
+}
+
+}  // namespace
+
+extern bool VectorDifference_NEON_W16(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  uint8x16_t acc = Difference(image1, image2);
+  for (int offset = 16; offset < 64; offset += 16) {
+    acc = vorrq_u8(acc, Difference(image1 + offset, image2 + offset));
+  }
+  return IsNonZero(acc);
+}
+
+extern bool VectorDifference_NEON_W32(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  uint8x16_t acc = Difference(image1, image2);
+  for (int offset = 16; offset < 128; offset += 16) {
+    acc = vorrq_u8(acc, Difference(image1 + offset, image2 + offset));
+  }
+  return IsNonZero(acc);
+}
+
+}  // namespace webrtc
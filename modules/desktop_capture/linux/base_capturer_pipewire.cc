@@ -10,8 +10,12 @@
 
 #include "modules/desktop_capture/linux/base_capturer_pipewire.h"
 
+#include <errno.h>
 #include <gio/gunixfdlist.h>
 #include <glib-object.h>
+#include <linux/dma-buf.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
 
 #include <spa/param/format-utils.h>
 #include <spa/param/props.h>
@@ -39,6 +43,39 @@ const char kScreenCastInterfaceName[] = "org.freedesktop.portal.ScreenCast";
 
 const int kBytesPerPixel = 4;
 
+// Maximum number of damage rectangles requested per buffer. Compositors merge
+// the damage into fewer, larger rectangles when there are more.
+const int kMaxDamageRects = 16;
+
+#ifndef SPA_TYPE_META__VideoDamage
+#define SPA_TYPE_META__VideoDamage SPA_TYPE_META_BASE "VideoDamage"
+#endif
+
+namespace {
+
+// Layout of one entry of the damage metadata. The list ends at the first entry
+// with an empty size or at the end of the metadata.
+struct DamageRect {
+  int32_t x;
+  int32_t y;
+  uint32_t width;
+  uint32_t height;
+};
+
+// Brackets CPU access to a DMA-BUF so that the exporter can flush caches.
+void SyncDmaBuf(int fd, uint64_t start_or_end) {
+  struct dma_buf_sync sync = {};
+  sync.flags = start_or_end | DMA_BUF_SYNC_READ;
+  while (ioctl(fd, DMA_BUF_IOCTL_SYNC, &sync) == -1) {
+    if (errno != EINTR && errno != EAGAIN) {
+      RTC_LOG(LS_WARNING) << "Failed to synchronize DMA-BUF: " << errno;
+      return;
+    }
+  }
+}
+
+}  // namespace
+
 // static
 void BaseCapturerPipeWire::OnStateChanged(void* data,
                                           pw_remote_state old_state,
@@ -114,8 +151,8 @@ void BaseCapturerPipeWire::OnStreamFormatChanged(void* data,
   uint8_t buffer[1024] = {};
   auto builder = spa_pod_builder{buffer, sizeof(buffer)};
 
-  // Setup buffers and meta header for new format.
-  const struct spa_pod* params[2];
+  // Setup buffers, meta header and damage metadata for new format.
+  const struct spa_pod* params[3];
   params[0] = reinterpret_cast<spa_pod*>(spa_pod_builder_object(
       &builder,
       // id to enumerate buffer requirements
@@ -144,8 +181,18 @@ void BaseCapturerPipeWire::OnStreamFormatChanged(void* data,
       // Size: size of the metadata, specified as integer (i)
       ":", that->pw_core_type_->param_meta.size, "i",
       sizeof(struct spa_meta_header)));
+  params[2] = reinterpret_cast<spa_pod*>(spa_pod_builder_object(
+      &builder, that->pw_core_type_->param.idMeta,
+      that->pw_core_type_->param_meta.Meta,
+      // Type: damage regions, so that unchanged parts of the screen are not
+      // copied
+      ":", that->pw_core_type_->param_meta.type, "I",
+      that->pw_type_->meta_video_damage,
+      // Size: room for up to kMaxDamageRects rectangles
+      ":", that->pw_core_type_->param_meta.size, "i",
+      sizeof(DamageRect) * kMaxDamageRects));
 
-  pw_stream_finish_format(that->pw_stream_, /*res=*/0, params, /*n_params=*/2);
+  pw_stream_finish_format(that->pw_stream_, /*res=*/0, params, /*n_params=*/3);
 }
 
 // static
@@ -200,8 +247,11 @@ BaseCapturerPipeWire::~BaseCapturerPipeWire() {
     pw_loop_destroy(pw_loop_);
   }
 
-  if (current_frame_) {
-    free(current_frame_);
+  {
+    rtc::CritScope lock(&current_frame_lock_);
+    if (current_frame_) {
+      free(current_frame_);
+    }
   }
 
   if (start_request_signal_id_) {
@@ -289,6 +339,8 @@ void BaseCapturerPipeWire::InitPipeWireTypes() {
   spa_type_media_subtype_map(map, &pw_type_->media_subtype);
   spa_type_format_video_map(map, &pw_type_->format_video);
   spa_type_video_format_map(map, &pw_type_->video_format);
+  pw_type_->meta_video_damage =
+      spa_type_map_get_id(map, SPA_TYPE_META__VideoDamage);
 }
 
 void BaseCapturerPipeWire::CreateReceivingStream() {
@@ -348,14 +400,10 @@ void BaseCapturerPipeWire::CreateReceivingStream() {
 
 void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
   spa_buffer* spaBuffer = buffer->buffer;
-  void* src = nullptr;
-
-  if (!(src = spaBuffer->datas[0].data)) {
-    return;
-  }
+  spa_data* data = &spaBuffer->datas[0];
+  uint32_t maxSize = data->maxsize;
 
-  uint32_t maxSize = spaBuffer->datas[0].maxsize;
-  int32_t srcStride = spaBuffer->datas[0].chunk->stride;
+  int32_t srcStride = data->chunk->stride;
   if (srcStride != (desktop_size_.width() * kBytesPerPixel)) {
     RTC_LOG(LS_ERROR) << "Got buffer with stride different from screen stride: "
                       << srcStride
@@ -364,21 +412,91 @@ void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
     return;
   }
 
+  const DesktopRect frame_rect = DesktopRect::MakeSize(desktop_size_);
+  DesktopRegion damage;
+  if (!GetBufferDamage(spaBuffer, &damage)) {
+    damage.SetRect(frame_rect);
+  }
+
+  rtc::CritScope lock(&current_frame_lock_);
   if (!current_frame_) {
     current_frame_ = static_cast<uint8_t*>(malloc(maxSize));
+    // Nothing was copied yet, so the first buffer is needed in full.
+    damage.SetRect(frame_rect);
   }
   RTC_DCHECK(current_frame_ != nullptr);
 
+  // Nothing changed since the previous buffer, so there is nothing to map or
+  // copy.
+  if (damage.is_empty()) {
+    return;
+  }
+
+  // MemPtr and MemFd buffers are mapped by the stream. DMA-BUFs are not, so
+  // map them here for the duration of the copy.
+  if (data->type == pw_core_type_->data.DmaBuf) {
+    const size_t map_size = maxSize + data->mapoffset;
+    uint8_t* map = static_cast<uint8_t*>(mmap(
+        nullptr, map_size, PROT_READ, MAP_PRIVATE, data->fd, /*offset=*/0));
+    if (map == MAP_FAILED) {
+      RTC_LOG(LS_ERROR) << "Failed to mmap the DMA-BUF: " << errno;
+      return;
+    }
+    SyncDmaBuf(data->fd, DMA_BUF_SYNC_START);
+    CopyDamagedRegion(map + data->mapoffset, damage);
+    SyncDmaBuf(data->fd, DMA_BUF_SYNC_END);
+    munmap(map, map_size);
+  } else {
+    const uint8_t* src = static_cast<const uint8_t*>(data->data);
+    if (!src) {
+      return;
+    }
+    CopyDamagedRegion(src, damage);
+  }
+  damage_region_.AddRegion(damage);
+}
+
+bool BaseCapturerPipeWire::GetBufferDamage(spa_buffer* buffer,
+                                           DesktopRegion* damage) const {
+  const DesktopRect frame_rect = DesktopRect::MakeSize(desktop_size_);
+  for (uint32_t i = 0; i < buffer->n_metas; ++i) {
+    const spa_meta& meta = buffer->metas[i];
+    if (meta.type != pw_type_->meta_video_damage || !meta.data) {
+      continue;
+    }
+    const DamageRect* rects = static_cast<const DamageRect*>(meta.data);
+    const size_t num_rects = meta.size / sizeof(DamageRect);
+    for (size_t j = 0; j < num_rects; ++j) {
+      if (rects[j].width == 0 || rects[j].height == 0) {
+        break;
+      }
+      DesktopRect rect = DesktopRect::MakeXYWH(rects[j].x, rects[j].y,
+                                               rects[j].width, rects[j].height);
+      rect.IntersectWith(frame_rect);
+      damage->AddRect(rect);
+    }
+    return true;
+  }
+  return false;
+}
+
+void BaseCapturerPipeWire::CopyDamagedRegion(const uint8_t* src,
+                                             const DesktopRegion& damage) {
+  const int stride = desktop_size_.width() * kBytesPerPixel;
   // If both sides decided to go with the RGBx format we need to convert it to
   // BGRx to match color format expected by WebRTC.
-  if (spa_video_format_->format == pw_type_->video_format.RGBx) {
-    uint8_t* tempFrame = static_cast<uint8_t*>(malloc(maxSize));
-    std::memcpy(tempFrame, src, maxSize);
-    ConvertRGBxToBGRx(tempFrame, maxSize);
-    std::memcpy(current_frame_, tempFrame, maxSize);
-    free(tempFrame);
-  } else {
-    std::memcpy(current_frame_, src, maxSize);
+  const bool convert = spa_video_format_->format == pw_type_->video_format.RGBx;
+  for (DesktopRegion::Iterator it(damage); !it.IsAtEnd(); it.Advance()) {
+    const DesktopRect& rect = it.rect();
+    const size_t offset = rect.top() * stride + rect.left() * kBytesPerPixel;
+    const size_t row_bytes = rect.width() * kBytesPerPixel;
+    for (int y = 0; y < rect.height(); ++y) {
+      uint8_t* dst_row = current_frame_ + offset + y * stride;
+      std::memcpy(dst_row, src + offset + y * stride, row_bytes);
+      if (convert) {
+        ConvertRGBxToBGRx(dst_row, row_bytes);
+      }
+    }
   }
 }
 
@@ -811,19 +929,33 @@ void BaseCapturerPipeWire::CaptureFrame() {
     return;
   }
 
+  rtc::CritScope lock(&current_frame_lock_);
   if (!current_frame_) {
     callback_->OnCaptureResult(Result::ERROR_TEMPORARY, nullptr);
     return;
   }
 
-  std::unique_ptr<DesktopFrame> result(new BasicDesktopFrame(desktop_size_));
-  result->CopyPixelsFrom(
-      current_frame_, (desktop_size_.width() * kBytesPerPixel),
-      DesktopRect::MakeWH(desktop_size_.width(), desktop_size_.height()));
-  if (!result) {
-    callback_->OnCaptureResult(Result::ERROR_TEMPORARY, nullptr);
-    return;
+  // Reuse the previous frame and only copy what changed since, unless the
+  // consumer still holds on to it.
+  if (!last_frame_ || last_frame_->IsShared() ||
+      !last_frame_->size().equals(desktop_size_)) {
+    last_frame_ = SharedDesktopFrame::Wrap(
+        absl::make_unique<BasicDesktopFrame>(desktop_size_));
+    damage_region_.SetRect(DesktopRect::MakeSize(desktop_size_));
+  }
+
+  const int stride = desktop_size_.width() * kBytesPerPixel;
+  for (DesktopRegion::Iterator it(damage_region_); !it.IsAtEnd();
+       it.Advance()) {
+    const DesktopRect& rect = it.rect();
+    last_frame_->CopyPixelsFrom(
+        current_frame_ + rect.top() * stride + rect.left() * kBytesPerPixel,
+        stride, rect);
   }
+
+  std::unique_ptr<DesktopFrame> result = last_frame_->Share();
+  result->mutable_updated_region()->Swap(&damage_region_);
+  damage_region_.Clear();
   callback_->OnCaptureResult(Result::SUCCESS, std::move(result));
 }
 
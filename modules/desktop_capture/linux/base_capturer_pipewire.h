@@ -16,9 +16,15 @@
 #include <pipewire/pipewire.h>
 #include <spa/param/video/format-utils.h>
 
+#include <memory>
+
 #include "modules/desktop_capture/desktop_capture_options.h"
 #include "modules/desktop_capture/desktop_capturer.h"
+#include "modules/desktop_capture/desktop_region.h"
+#include "modules/desktop_capture/shared_desktop_frame.h"
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -28,6 +34,9 @@ class PipeWireType {
   spa_type_media_subtype media_subtype;
   spa_type_format_video format_video;
   spa_type_video_format video_format;
+  // Id of the damage metadata, which lists the regions of the buffer that
+  // changed since the previous one.
+  uint32_t meta_video_damage;
 };
 
 class BaseCapturerPipeWire : public DesktopCapturer {
@@ -81,7 +90,15 @@ class BaseCapturerPipeWire : public DesktopCapturer {
   DesktopSize desktop_size_ = {};
   DesktopCaptureOptions options_ = {};
 
-  uint8_t* current_frame_ = nullptr;
+  // |current_frame_| is written on the PipeWire thread and read in
+  // CaptureFrame(). |damage_region_| is the part of it that changed since the
+  // last CaptureFrame().
+  rtc::CriticalSection current_frame_lock_;
+  uint8_t* current_frame_ RTC_GUARDED_BY(current_frame_lock_) = nullptr;
+  DesktopRegion damage_region_ RTC_GUARDED_BY(current_frame_lock_);
+  // Frame last returned by CaptureFrame(). It is updated in place with the
+  // damaged regions unless the consumer still holds a reference to it.
+  std::unique_ptr<SharedDesktopFrame> last_frame_;
   Callback* callback_ = nullptr;
 
   bool portal_init_failed_ = false;
@@ -92,6 +109,11 @@ class BaseCapturerPipeWire : public DesktopCapturer {
 
   void CreateReceivingStream();
   void HandleBuffer(pw_buffer* buffer);
+  // Fills |damage| with the regions the compositor reported as changed in
+  // |buffer|. Returns false if the buffer carries no damage metadata.
+  bool GetBufferDamage(spa_buffer* buffer, DesktopRegion* damage) const;
+  void CopyDamagedRegion(const uint8_t* src, const DesktopRegion& damage)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(current_frame_lock_);
 
   void ConvertRGBxToBGRx(uint8_t* frame, uint32_t size);
 
@@ -25,7 +25,6 @@
 #include "modules/desktop_capture/desktop_geometry.h"
 #include "modules/desktop_capture/linux/x_server_pixel_buffer.h"
 #include "modules/desktop_capture/screen_capture_frame_queue.h"
-#include "modules/desktop_capture/screen_capturer_helper.h"
 #include "modules/desktop_capture/shared_desktop_frame.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -34,9 +33,15 @@
 
 namespace webrtc {
 
-ScreenCapturerX11::ScreenCapturerX11() {
-  helper_.SetLogGridSize(4);
-}
+namespace {
+
+// Above this number of damage rectangles, their bounding box is captured
+// instead, which costs fewer round trips than many small fragments.
+const int kMaxDamageRects = 32;
+
+}  // namespace
+
+ScreenCapturerX11::ScreenCapturerX11() = default;
 
 ScreenCapturerX11::~ScreenCapturerX11() {
   options_.x_display()->RemoveEventHandler(ConfigureNotify, this);
@@ -143,7 +148,13 @@ void ScreenCapturerX11::CaptureFrame() {
   TRACE_EVENT0("webrtc", "ScreenCapturerX11::CaptureFrame");
   int64_t capture_start_time_nanos = rtc::TimeNanos();
 
-  queue_.MoveToNextFrame();
+  // While the consumer has released the current frame, keep capturing into
+  // it so that only the damaged portions need to be copied. Otherwise move on
+  // to the next frame, which SynchronizeFrame() brings up to date.
+  reuse_current_frame_ = use_damage_ && queue_.current_frame() &&
+                         !queue_.current_frame()->IsShared();
+  if (!reuse_current_frame_)
+    queue_.MoveToNextFrame();
   RTC_DCHECK(!queue_.current_frame() || !queue_.current_frame()->IsShared());
 
   // Process XEvents for XDamage and cursor shape tracking.
@@ -163,6 +174,7 @@ void ScreenCapturerX11::CaptureFrame() {
   // Note that we can't reallocate other buffers at this point, since the caller
   // may still be reading from them.
   if (!queue_.current_frame()) {
+    reuse_current_frame_ = false;
     queue_.ReplaceCurrentFrame(
         SharedDesktopFrame::Wrap(std::unique_ptr<DesktopFrame>(
             new BasicDesktopFrame(x_server_pixel_buffer_.window_size()))));
@@ -175,7 +187,11 @@ void ScreenCapturerX11::CaptureFrame() {
     return;
   }
 
-  last_invalid_region_ = result->updated_region();
+  if (reuse_current_frame_) {
+    last_invalid_region_.AddRegion(result->updated_region());
+  } else {
+    last_invalid_region_ = result->updated_region();
+  }
   result->set_capture_time_ms((rtc::TimeNanos() - capture_start_time_nanos) /
                               rtc::kNumNanosecsPerMillisec);
   callback_->OnCaptureResult(Result::SUCCESS, std::move(result));
@@ -212,57 +228,50 @@ std::unique_ptr<DesktopFrame> ScreenCapturerX11::CaptureScreen() {
   std::unique_ptr<SharedDesktopFrame> frame = queue_.current_frame()->Share();
   RTC_DCHECK(x_server_pixel_buffer_.window_size().equals(frame->size()));
 
-  // Pass the screen size to the helper, so it can clip the invalid region if it
-  // expands that region to a grid.
-  helper_.set_size_most_recent(frame->size());
-
-  // In the DAMAGE case, ensure the frame is up-to-date with the previous frame
-  // if any.  If there isn't a previous frame, that means a screen-resolution
-  // change occurred, and |invalid_rects| will be updated to include the whole
-  // screen.
-  if (use_damage_ && queue_.previous_frame())
+  // In the DAMAGE case only the damaged portions need to be captured, as long
+  // as the frame already holds the previous capture: either because it is
+  // being reused, or after SynchronizeFrame() has brought it up to date with
+  // the previous frame. If there isn't a previous frame, that means a
+  // screen-resolution change occurred and the whole screen is captured.
+  const bool capture_damage =
+      use_damage_ && (reuse_current_frame_ || queue_.previous_frame());
+  if (capture_damage && !reuse_current_frame_)
     SynchronizeFrame();
 
   DesktopRegion* updated_region = frame->mutable_updated_region();
 
-  x_server_pixel_buffer_.Synchronize();
-  if (use_damage_ && queue_.previous_frame()) {
+  if (capture_damage) {
     // Atomically fetch and clear the damage region.
     XDamageSubtract(display(), damage_handle_, None, damage_region_);
     int rects_num = 0;
     XRectangle bounds;
     XRectangle* rects = XFixesFetchRegionAndBounds(display(), damage_region_,
                                                    &rects_num, &bounds);
-    for (int i = 0; i < rects_num; ++i) {
-      updated_region->AddRect(DesktopRect::MakeXYWH(
-          rects[i].x, rects[i].y, rects[i].width, rects[i].height));
+    if (rects_num > kMaxDamageRects) {
+      updated_region->SetRect(DesktopRect::MakeXYWH(
+          bounds.x, bounds.y, bounds.width, bounds.height));
+    } else {
+      for (int i = 0; i < rects_num; ++i) {
+        updated_region->AddRect(DesktopRect::MakeXYWH(
+            rects[i].x, rects[i].y, rects[i].width, rects[i].height));
+      }
     }
     XFree(rects);
-    helper_.InvalidateRegion(*updated_region);
-
-    // Capture the damaged portions of the desktop.
-    helper_.TakeInvalidRegion(updated_region);
 
     // Clip the damaged portions to the current screen size, just in case some
     // spurious XDamage notifications were received for a previous (larger)
     // screen size.
     updated_region->IntersectWith(
         DesktopRect::MakeSize(x_server_pixel_buffer_.window_size()));
-
-    for (DesktopRegion::Iterator it(*updated_region); !it.IsAtEnd();
-         it.Advance()) {
-      if (!x_server_pixel_buffer_.CaptureRect(it.rect(), frame.get()))
-        return nullptr;
-    }
   } else {
     // Doing full-screen polling, or this is the first capture after a
     // screen-resolution change.  In either case, need a full-screen capture.
-    DesktopRect screen_rect = DesktopRect::MakeSize(frame->size());
-    if (!x_server_pixel_buffer_.CaptureRect(screen_rect, frame.get()))
-      return nullptr;
-    updated_region->SetRect(screen_rect);
+    updated_region->SetRect(DesktopRect::MakeSize(frame->size()));
   }
 
+  if (!x_server_pixel_buffer_.CaptureRegion(*updated_region, frame.get()))
+    return nullptr;
+
   return std::move(frame);
 }
 
@@ -271,7 +280,6 @@ void ScreenCapturerX11::ScreenConfigurationChanged() {
   // Make sure the frame buffers will be reallocated.
   queue_.Reset();
 
-  helper_.ClearInvalidRegion();
   if (!x_server_pixel_buffer_.Init(display(), DefaultRootWindow(display()))) {
     RTC_LOG(LS_ERROR) << "Failed to initialize pixel buffer after screen "
                          "configuration change.";
@@ -284,9 +292,6 @@ void ScreenCapturerX11::SynchronizeFrame() {
   // previous buffer at this time so thread access complaints are false
   // positives.
 
-  // TODO(hclam): We can reduce the amount of copying here by subtracting
-  // |capturer_helper_|s region from |last_invalid_region_|.
-  // http://crbug.com/92354
   RTC_DCHECK(queue_.previous_frame());
 
   DesktopFrame* current = queue_.current_frame();
@@ -24,7 +24,6 @@
 #include "modules/desktop_capture/linux/shared_x_display.h"
 #include "modules/desktop_capture/linux/x_server_pixel_buffer.h"
 #include "modules/desktop_capture/screen_capture_frame_queue.h"
-#include "modules/desktop_capture/screen_capturer_helper.h"
 #include "modules/desktop_capture/shared_desktop_frame.h"
 #include "rtc_base/constructormagic.h"
 
@@ -105,17 +104,16 @@ class ScreenCapturerX11 : public DesktopCapturer,
   // Access to the X Server's pixel buffer.
   XServerPixelBuffer x_server_pixel_buffer_;
 
-  // A thread-safe list of invalid rectangles, and the size of the most
-  // recently captured screen.
-  ScreenCapturerHelper helper_;
-
   // Queue of the frames buffers.
   ScreenCaptureFrameQueue<SharedDesktopFrame> queue_;
 
-  // Invalid region from the previous capture. This is used to synchronize the
-  // current with the last buffer used.
+  // Invalid region since the current frame was last switched to. This is used
+  // to synchronize the next buffer with the last one used.
   DesktopRegion last_invalid_region_;
 
+  // True if the current capture reuses the frame of the previous capture.
+  bool reuse_current_frame_ = false;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(ScreenCapturerX11);
 };
 
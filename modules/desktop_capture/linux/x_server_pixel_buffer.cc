@@ -16,6 +16,8 @@
 #include <sys/ipc.h>
 #include <sys/shm.h>
 
+#include <algorithm>
+
 #include "modules/desktop_capture/desktop_frame.h"
 #include "modules/desktop_capture/linux/window_list_utils.h"
 #include "modules/desktop_capture/linux/x_error_trap.h"
@@ -314,17 +316,69 @@ bool XServerPixelBuffer::CaptureRect(const DesktopRect& rect,
   RTC_DCHECK_LE(rect.right(), window_rect_.width());
   RTC_DCHECK_LE(rect.bottom(), window_rect_.height());
 
-  XImage* image;
-  uint8_t* data;
+  if (shm_segment_info_ && shm_pixmap_) {
+    XCopyArea(display_, window_, shm_pixmap_, shm_gc_, rect.left(), rect.top(),
+              rect.width(), rect.height(), rect.left(), rect.top());
+    XSync(display_, False);
+  }
 
-  if (shm_segment_info_ && (shm_pixmap_ || xshm_get_image_succeeded_)) {
-    if (shm_pixmap_) {
+  return BlitRect(rect, frame);
+}
+
+bool XServerPixelBuffer::CaptureRegion(const DesktopRegion& region,
+                                       DesktopFrame* frame) {
+  if (region.is_empty())
+    return true;
+
+  if (shm_segment_info_ && shm_pixmap_) {
+    // Queue all the copies before waiting for the server.
+    for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+      const DesktopRect& rect = it.rect();
       XCopyArea(display_, window_, shm_pixmap_, shm_gc_, rect.left(),
                 rect.top(), rect.width(), rect.height(), rect.left(),
                 rect.top());
-      XSync(display_, False);
     }
+    XSync(display_, False);
+  } else if (shm_segment_info_) {
+    // XShmGetImage() always transfers whole rows, so restrict the image to the
+    // band of rows spanned by |region| while fetching it.
+    int top = window_rect_.height();
+    int bottom = 0;
+    for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+      top = std::min(top, it.rect().top());
+      bottom = std::max(bottom, it.rect().bottom());
+    }
+    RTC_DCHECK_LE(bottom, window_rect_.height());
+
+    char* const data = x_shm_image_->data;
+    const int height = x_shm_image_->height;
+    x_shm_image_->data += top * x_shm_image_->bytes_per_line;
+    x_shm_image_->height = bottom - top;
+    {
+      // XShmGetImage can fail if the display is being reconfigured.
+      XErrorTrap error_trap(display_);
+      xshm_get_image_succeeded_ =
+          XShmGetImage(display_, window_, x_shm_image_, 0, top, AllPlanes);
+    }
+    x_shm_image_->data = data;
+    x_shm_image_->height = height;
+  }
 
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    RTC_DCHECK_LE(it.rect().right(), window_rect_.width());
+    RTC_DCHECK_LE(it.rect().bottom(), window_rect_.height());
+    if (!BlitRect(it.rect(), frame))
+      return false;
+  }
+  return true;
+}
+
+bool XServerPixelBuffer::BlitRect(const DesktopRect& rect,
+                                  DesktopFrame* frame) {
+  XImage* image;
+  uint8_t* data;
+
+  if (shm_segment_info_ && (shm_pixmap_ || xshm_get_image_succeeded_)) {
     image = x_shm_image_;
     data = reinterpret_cast<uint8_t*>(image->data) +
            rect.top() * image->bytes_per_line +
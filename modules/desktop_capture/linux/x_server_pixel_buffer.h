@@ -17,6 +17,7 @@
 #include <X11/extensions/XShm.h>
 
 #include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
 #include "rtc_base/constructormagic.h"
 
 namespace webrtc {
@@ -60,7 +61,17 @@ class XServerPixelBuffer {
   // that |rect| is not larger than window_size().
   bool CaptureRect(const DesktopRect& rect, DesktopFrame* frame);
 
+  // Captures |region| into |frame|. Unlike Synchronize() followed by
+  // CaptureRect() for each rectangle, this transfers only the rows spanned by
+  // |region| from the X server and waits for the server once. The caller must
+  // ensure that |region| is within window_size().
+  bool CaptureRegion(const DesktopRegion& region, DesktopFrame* frame);
+
  private:
+  // Copies |rect| into |frame| from the shared memory image once it is up to
+  // date, or fetches it with XGetImage() otherwise.
+  bool BlitRect(const DesktopRect& rect, DesktopFrame* frame);
+
   void ReleaseSharedMemorySegment();
 
   void InitShm(const XWindowAttributes& attributes);
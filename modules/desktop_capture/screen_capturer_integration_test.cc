@@ -27,9 +27,12 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/strings/string_builder.h"
 #include "rtc_base/third_party/base64/base64.h"
+#include "rtc_base/timeutils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
 
 #if defined(WEBRTC_WIN)
 #include "modules/desktop_capture/win/screen_capturer_win_directx.h"
@@ -153,6 +156,46 @@ class ScreenCapturerIntegrationTest : public testing::Test {
     TestCaptureUpdatedRegion({capturer_.get()});
   }
 
+  // Measures the time CaptureFrame() takes after a rectangle covering a given
+  // fraction of the drawable region has been redrawn, so that incremental
+  // capturers can be compared against full-screen copies.
+  void TestCaptureLatencyByDamagedFraction() {
+    const int kFramesPerFraction = 30;
+    std::unique_ptr<ScreenDrawer> drawer = ScreenDrawer::Create();
+    if (!drawer || drawer->DrawableRegion().is_empty()) {
+      RTC_LOG(LS_WARNING)
+          << "No ScreenDrawer implementation for current platform.";
+      return;
+    }
+    const DesktopRect drawable = drawer->DrawableRegion();
+
+    capturer_->Start(&callback_);
+    // The first frame is always a full-screen capture.
+    ASSERT_TRUE(CaptureFrame(capturer_.get()));
+
+    for (int percent : {1, 5, 10, 25, 50, 100}) {
+      // A band of rows across the drawable region covering |percent| of it.
+      const DesktopRect rect = DesktopRect::MakeXYWH(
+          drawable.left(), drawable.top(), drawable.width(),
+          std::max(1, drawable.height() * percent / 100));
+      int64_t total_time_us = 0;
+      for (int i = 0; i < kFramesPerFraction; i++) {
+        const uint8_t value = (i & 1) ? 0x40 : 0xc0;
+        drawer->DrawRectangle(rect, RgbaColor(value, value, value));
+        drawer->WaitForPendingDraws();
+        const int64_t start_time_us = rtc::TimeMicros();
+        ASSERT_TRUE(CaptureFrame(capturer_.get()));
+        total_time_us += rtc::TimeMicros() - start_time_us;
+      }
+      rtc::StringBuilder trace;
+      trace << "damaged_" << percent << "_percent";
+      test::PrintResult("capture_latency", "", trace.str(),
+                        static_cast<double>(total_time_us) /
+                            kFramesPerFraction / rtc::kNumMicrosecsPerMillisec,
+                        "ms", false);
+    }
+  }
+
 #if defined(WEBRTC_WIN)
   // Enable allow_directx_capturer in DesktopCaptureOptions, but let
   // DesktopCapturer::CreateScreenCapturer() to decide whether a DirectX
@@ -295,6 +338,12 @@ TEST_F(ScreenCapturerIntegrationTest, MAYBE_CaptureUpdatedRegion) {
   TestCaptureUpdatedRegion();
 }
 
+// Benchmark rather than a test, run manually on a machine with a real display.
+TEST_F(ScreenCapturerIntegrationTest,
+       DISABLED_CaptureLatencyByDamagedFraction) {
+  TestCaptureLatencyByDamagedFraction();
+}
+
 #if defined(WEBRTC_WIN)
 // ScreenCapturerWinGdi randomly returns blank screen, the root cause is still
 // unknown. Bug, https://bugs.chromium.org/p/webrtc/issues/detail?id=6843.
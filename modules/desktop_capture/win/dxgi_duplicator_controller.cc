@@ -15,10 +15,13 @@
 #include <algorithm>
 #include <string>
 
+#include "absl/memory/memory.h"
 #include "modules/desktop_capture/desktop_capture_types.h"
 #include "modules/desktop_capture/win/dxgi_frame.h"
 #include "modules/desktop_capture/win/screen_capture_utils.h"
+#include "rtc_base/atomicops.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/timeutils.h"
 #include "system_wrappers/include/sleep.h"
@@ -289,6 +292,7 @@ bool DxgiDuplicatorController::DoInitialize() {
 void DxgiDuplicatorController::Deinitialize() {
   desktop_rect_ = DesktopRect();
   duplicators_.clear();
+  adapter_queues_.clear();
   display_configuration_monitor_.Reset();
 }
 
@@ -338,12 +342,47 @@ bool DxgiDuplicatorController::DoDuplicateUnlocked(Context* context,
 
 bool DxgiDuplicatorController::DoDuplicateAll(Context* context,
                                               SharedDesktopFrame* target) {
-  for (size_t i = 0; i < duplicators_.size(); i++) {
-    if (!duplicators_[i].Duplicate(&context->contexts[i], target)) {
-      return false;
+  if (duplicators_.size() < 2) {
+    for (size_t i = 0; i < duplicators_.size(); i++) {
+      if (!duplicators_[i].Duplicate(&context->contexts[i], target)) {
+        return false;
+      }
     }
+    return true;
   }
-  return true;
+
+  // Each adapter has its own D3D device, so the adapters are duplicated in
+  // parallel, the first one on this thread. They write to disjoint parts of
+  // the frame, so each writes through its own SharedDesktopFrame sharing the
+  // pixels of |target|, and their updated regions are merged afterwards.
+  while (adapter_queues_.size() < duplicators_.size() - 1) {
+    adapter_queues_.push_back(
+        absl::make_unique<rtc::TaskQueue>("DxgiAdapterDuplicator"));
+  }
+  std::vector<std::unique_ptr<SharedDesktopFrame>> frames(duplicators_.size());
+  // Not a std::vector<bool>, whose elements can't be written concurrently.
+  std::vector<char> results(duplicators_.size(), false);
+  volatile int pending = static_cast<int>(duplicators_.size()) - 1;
+  rtc::Event done(false, false);
+  for (size_t i = 1; i < duplicators_.size(); i++) {
+    frames[i] = target->Share();
+    frames[i]->mutable_updated_region()->Clear();
+    adapter_queues_[i - 1]->PostTask([this, context, &frames, &results,
+                                      &pending, &done, i] {
+      results[i] =
+          duplicators_[i].Duplicate(&context->contexts[i], frames[i].get());
+      if (rtc::AtomicOps::Decrement(&pending) == 0) {
+        done.Set();
+      }
+    });
+  }
+  bool result = duplicators_[0].Duplicate(&context->contexts[0], target);
+  done.Wait(rtc::Event::kForever);
+  for (size_t i = 1; i < duplicators_.size(); i++) {
+    result = result && results[i];
+    target->mutable_updated_region()->AddRegion(frames[i]->updated_region());
+  }
+  return result;
 }
 
 bool DxgiDuplicatorController::DoDuplicateOne(Context* context,
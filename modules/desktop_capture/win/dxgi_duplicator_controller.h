@@ -14,6 +14,7 @@
 #include <D3DCommon.h>
 
 #include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,7 @@
 #include "modules/desktop_capture/win/dxgi_frame.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/task_queue.h"
 
 namespace webrtc {
 
@@ -175,7 +177,7 @@ class DxgiDuplicatorController {
                            int monitor_id,
                            SharedDesktopFrame* target);
 
-  // Captures all monitors.
+  // Captures all monitors, those of different adapters in parallel.
   bool DoDuplicateAll(Context* context, SharedDesktopFrame* target);
 
   // Captures one monitor.
@@ -227,6 +229,8 @@ class DxgiDuplicatorController {
   DesktopRect desktop_rect_;
   DesktopVector dpi_;
   std::vector<DxgiAdapterDuplicator> duplicators_;
+  // Runs DoDuplicateAll() for all but the first of |duplicators_|.
+  std::vector<std::unique_ptr<rtc::TaskQueue>> adapter_queues_;
   D3dInfo d3d_info_;
   DisplayConfigurationMonitor display_configuration_monitor_;
   // A number to indicate how many succeeded duplications have been performed.
@@ -51,7 +51,7 @@ BitrateProber::~BitrateProber() = default;
 
 BitrateProber::BitrateProber(RtcEventLog* event_log)
     : probing_state_(ProbingState::kDisabled),
-      next_probe_time_ms_(-1),
+      next_probe_time_us_(-1),
       next_cluster_id_(0),
       event_log_(event_log) {
   SetEnabled(true);
@@ -80,7 +80,7 @@ void BitrateProber::OnIncomingPacket(size_t packet_size) {
       packet_size >=
           std::min<size_t>(RecommendedMinProbeSize(), kMinProbePacketSize)) {
     // Send next probe right away.
-    next_probe_time_ms_ = -1;
+    next_probe_time_us_ = -1;
     probing_state_ = ProbingState::kActive;
   }
 }
@@ -119,22 +119,29 @@ void BitrateProber::CreateProbeCluster(int bitrate_bps, int64_t now_ms) {
 }
 
 int BitrateProber::TimeUntilNextProbe(int64_t now_ms) {
+  int64_t time_until_probe_us = TimeUntilNextProbeUs(now_ms * 1000);
+  if (time_until_probe_us < 0)
+    return -1;
+  return static_cast<int>((time_until_probe_us + 999) / 1000);
+}
+
+int64_t BitrateProber::TimeUntilNextProbeUs(int64_t now_us) {
   // Probing is not active or probing is already complete.
   if (probing_state_ != ProbingState::kActive || clusters_.empty())
     return -1;
 
-  int time_until_probe_ms = 0;
-  if (next_probe_time_ms_ >= 0) {
-    time_until_probe_ms = next_probe_time_ms_ - now_ms;
-    if (time_until_probe_ms < -kMaxProbeDelayMs) {
+  int64_t time_until_probe_us = 0;
+  if (next_probe_time_us_ >= 0) {
+    time_until_probe_us = next_probe_time_us_ - now_us;
+    if (time_until_probe_us < -kMaxProbeDelayMs * 1000) {
       RTC_DLOG(LS_WARNING) << "Probe delay too high"
-                           << " (next_ms:" << next_probe_time_ms_
-                           << ", now_ms: " << now_ms << ")";
+                           << " (next_us:" << next_probe_time_us_
+                           << ", now_us: " << now_us << ")";
       return -1;
     }
   }
 
-  return std::max(time_until_probe_ms, 0);
+  return std::max<int64_t>(time_until_probe_us, 0);
 }
 
 PacedPacketInfo BitrateProber::CurrentCluster() const {
@@ -153,18 +160,22 @@ size_t BitrateProber::RecommendedMinProbeSize() const {
 }
 
 void BitrateProber::ProbeSent(int64_t now_ms, size_t bytes) {
+  ProbeSentUs(now_ms * 1000, bytes);
+}
+
+void BitrateProber::ProbeSentUs(int64_t now_us, size_t bytes) {
   RTC_DCHECK(probing_state_ == ProbingState::kActive);
   RTC_DCHECK_GT(bytes, 0);
 
   if (!clusters_.empty()) {
     ProbeCluster* cluster = &clusters_.front();
     if (cluster->sent_probes == 0) {
-      RTC_DCHECK_EQ(cluster->time_started_ms, -1);
-      cluster->time_started_ms = now_ms;
+      RTC_DCHECK_EQ(cluster->time_started_us, -1);
+      cluster->time_started_us = now_us;
     }
     cluster->sent_bytes += static_cast<int>(bytes);
     cluster->sent_probes += 1;
-    next_probe_time_ms_ = GetNextProbeTime(*cluster);
+    next_probe_time_us_ = GetNextProbeTimeUs(*cluster);
     if (cluster->sent_bytes >= cluster->pace_info.probe_cluster_min_bytes &&
         cluster->sent_probes >= cluster->pace_info.probe_cluster_min_probes) {
       clusters_.pop();
@@ -174,16 +185,16 @@ void BitrateProber::ProbeSent(int64_t now_ms, size_t bytes) {
   }
 }
 
-int64_t BitrateProber::GetNextProbeTime(const ProbeCluster& cluster) {
+int64_t BitrateProber::GetNextProbeTimeUs(const ProbeCluster& cluster) {
   RTC_CHECK_GT(cluster.pace_info.send_bitrate_bps, 0);
-  RTC_CHECK_GE(cluster.time_started_ms, 0);
+  RTC_CHECK_GE(cluster.time_started_us, 0);
 
   // Compute the time delta from the cluster start to ensure probe bitrate stays
-  // close to the target bitrate. Result is in milliseconds.
-  int64_t delta_ms =
-      (8000ll * cluster.sent_bytes + cluster.pace_info.send_bitrate_bps / 2) /
-      cluster.pace_info.send_bitrate_bps;
-  return cluster.time_started_ms + delta_ms;
+  // close to the target bitrate. Result is in microseconds.
+  int64_t delta_us = (8000000ll * cluster.sent_bytes +
+                      cluster.pace_info.send_bitrate_bps / 2) /
+                     cluster.pace_info.send_bitrate_bps;
+  return cluster.time_started_us + delta_us;
 }
 
 }  // namespace webrtc
@@ -45,9 +45,15 @@ class BitrateProber {
   void CreateProbeCluster(int bitrate_bps, int64_t now_ms);
 
   // Returns the number of milliseconds until the next probe should be sent to
-  // get accurate probing.
+  // get accurate probing, rounded up so that the probe is due once that time
+  // has passed.
   int TimeUntilNextProbe(int64_t now_ms);
 
+  // Same as TimeUntilNextProbe(), but with microsecond precision. At high
+  // probe bitrates the time between probes is only a few milliseconds, and
+  // rounding it to whole milliseconds skews the probed bitrate.
+  int64_t TimeUntilNextProbeUs(int64_t now_us);
+
   // Information about the current probing cluster.
   PacedPacketInfo CurrentCluster() const;
 
@@ -60,6 +66,7 @@ class BitrateProber {
   // the last packet in probe. |probe_size| is the total size of all packets
   // in probe.
   void ProbeSent(int64_t now_ms, size_t probe_size);
+  void ProbeSentUs(int64_t now_us, size_t probe_size);
 
  private:
   enum class ProbingState {
@@ -83,11 +90,11 @@ class BitrateProber {
     int sent_probes = 0;
     int sent_bytes = 0;
     int64_t time_created_ms = -1;
-    int64_t time_started_ms = -1;
+    int64_t time_started_us = -1;
     int retries = 0;
   };
 
-  int64_t GetNextProbeTime(const ProbeCluster& cluster);
+  int64_t GetNextProbeTimeUs(const ProbeCluster& cluster);
 
   ProbingState probing_state_;
 
@@ -97,7 +104,7 @@ class BitrateProber {
   std::queue<ProbeCluster> clusters_;
 
   // Time the next probe should be sent when in kActive state.
-  int64_t next_probe_time_ms_;
+  int64_t next_probe_time_us_;
 
   int next_cluster_id_;
   RtcEventLog* const event_log_;
@@ -163,6 +163,31 @@ TEST(BitrateProberTest, HighBitrateProbing) {
   EXPECT_FALSE(prober.IsProbing());
 }
 
+TEST(BitrateProberTest, ProbesAreScheduledWithMicrosecondPrecision) {
+  BitrateProber prober;
+  constexpr int kBitrateBps = 5000000;  // 5 Mbps.
+  constexpr int kPacketSizeBytes = 1200;
+  // 1920 us between packets, which would be rounded to 2 ms.
+  constexpr int64_t kProbeDeltaUs = kPacketSizeBytes * 8000000ll / kBitrateBps;
+
+  int64_t now_us = 0;
+  prober.CreateProbeCluster(kBitrateBps, now_us / 1000);
+  prober.OnIncomingPacket(kPacketSizeBytes);
+  ASSERT_TRUE(prober.IsProbing());
+  EXPECT_EQ(0, prober.TimeUntilNextProbeUs(now_us));
+  const int64_t start_us = now_us;
+  int num_probes = 0;
+  while (prober.IsProbing()) {
+    now_us += prober.TimeUntilNextProbeUs(now_us);
+    EXPECT_EQ(start_us + num_probes * kProbeDeltaUs, now_us);
+    prober.ProbeSentUs(now_us, kPacketSizeBytes);
+    ++num_probes;
+  }
+  double bitrate =
+      kPacketSizeBytes * (num_probes - 1) * 8 * 1e6 / (now_us - start_us);
+  EXPECT_NEAR(kBitrateBps, bitrate, kBitrateBps * 0.001);
+}
+
 TEST(BitrateProberTest, ProbeClusterTimeout) {
   BitrateProber prober;
   constexpr int kBitrateBps = 300000;  // 300 kbps
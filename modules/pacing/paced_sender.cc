@@ -27,6 +27,8 @@
 namespace {
 // Time limit in milliseconds between packet bursts.
 const int64_t kDefaultMinPacketLimitMs = 5;
+// Time after capture at which droppable packets are dropped rather than sent.
+const int64_t kDefaultPacketDeadlineMs = 500;
 const int64_t kCongestedPacketIntervalMs = 500;
 const int64_t kPausedProcessIntervalMs = kCongestedPacketIntervalMs;
 const int64_t kMaxElapsedTimeMs = 2000;
@@ -52,7 +54,12 @@ PacedSender::PacedSender(const Clock* clock,
       send_padding_if_silent_(
           field_trial::IsEnabled("WebRTC-Pacer-PadInSilence")),
       video_blocks_audio_(!field_trial::IsDisabled("WebRTC-Pacer-BlockAudio")),
+      lock_free_insert_(
+          field_trial::IsEnabled("WebRTC-Pacer-LockFreeInsert")),
       min_packet_limit_ms_("", kDefaultMinPacketLimitMs),
+      drop_expired_packets_(
+          field_trial::IsEnabled("WebRTC-Pacer-DropExpiredPackets")),
+      packet_deadline_ms_("deadline", kDefaultPacketDeadlineMs),
       last_timestamp_ms_(clock_->TimeInMilliseconds()),
       paused_(false),
       media_budget_(0),
@@ -67,6 +74,8 @@ PacedSender::PacedSender(const Clock* clock,
       last_send_time_us_(clock->TimeInMicroseconds()),
       first_sent_packet_ms_(-1),
       packets_(clock->TimeInMicroseconds()),
+      incoming_packets_count_(0),
+      incoming_packets_bytes_(0),
       packet_counter_(0),
       pacing_factor_(kDefaultPaceMultiplier),
       queue_time_limit(kMaxQueueLengthMs),
@@ -77,6 +86,8 @@ PacedSender::PacedSender(const Clock* clock,
   }
   ParseFieldTrial({&min_packet_limit_ms_},
                   field_trial::FindFullName("WebRTC-Pacer-MinPacketLimitMs"));
+  ParseFieldTrial({&packet_deadline_ms_},
+                  field_trial::FindFullName("WebRTC-Pacer-DropExpiredPackets"));
   UpdateBudgetWithElapsedTime(min_packet_limit_ms_);
 }
 
@@ -90,6 +101,7 @@ void PacedSender::CreateProbeCluster(int bitrate_bps) {
 void PacedSender::Pause() {
   {
     rtc::CritScope cs(&critsect_);
+    DrainIncomingPackets();
     if (!paused_)
       RTC_LOG(LS_INFO) << "PacedSender paused.";
     paused_ = true;
@@ -105,6 +117,7 @@ void PacedSender::Pause() {
 void PacedSender::Resume() {
   {
     rtc::CritScope cs(&critsect_);
+    DrainIncomingPackets();
     if (paused_)
       RTC_LOG(LS_INFO) << "PacedSender resumed.";
     paused_ = false;
@@ -148,6 +161,7 @@ int64_t PacedSender::TimeMilliseconds() const {
 
 void PacedSender::SetProbingEnabled(bool enabled) {
   rtc::CritScope cs(&critsect_);
+  DrainIncomingPackets();
   RTC_CHECK_EQ(0, packet_counter_);
   prober_.SetEnabled(enabled);
 }
@@ -193,21 +207,55 @@ void PacedSender::InsertPacket(RtpPacketSender::Priority priority,
                                int64_t capture_time_ms,
                                size_t bytes,
                                bool retransmission) {
+  if (lock_free_insert_) {
+    incoming_packets_count_.fetch_add(1, std::memory_order_relaxed);
+    incoming_packets_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    incoming_packets_.Push({priority, ssrc, sequence_number, capture_time_ms,
+                            clock_->TimeInMilliseconds(), bytes,
+                            retransmission});
+    return;
+  }
   rtc::CritScope cs(&critsect_);
+  EnqueuePacket(priority, ssrc, sequence_number, capture_time_ms,
+                TimeMilliseconds(), bytes, retransmission);
+}
+
+void PacedSender::EnqueuePacket(RtpPacketSender::Priority priority,
+                                uint32_t ssrc,
+                                uint16_t sequence_number,
+                                int64_t capture_time_ms,
+                                int64_t enqueue_time_ms,
+                                size_t bytes,
+                                bool retransmission) {
   RTC_DCHECK(pacing_bitrate_kbps_ > 0)
       << "SetPacingRate must be called before InsertPacket.";
 
-  int64_t now_ms = TimeMilliseconds();
   prober_.OnIncomingPacket(bytes);
 
   if (capture_time_ms < 0)
-    capture_time_ms = now_ms;
+    capture_time_ms = enqueue_time_ms;
 
-  packets_.Push(RoundRobinPacketQueue::Packet(
-      priority, ssrc, sequence_number, capture_time_ms, now_ms, bytes,
+  packets_.Push(PooledPacketQueue::Packet(
+      priority, ssrc, sequence_number, capture_time_ms, enqueue_time_ms, bytes,
       retransmission, packet_counter_++));
 }
 
+void PacedSender::DrainIncomingPackets() {
+  if (!lock_free_insert_ || incoming_packets_.Empty())
+    return;
+  // Packets are stamped on the inserting threads, so their order in the queue
+  // may not match their timestamps. |packets_| requires monotonic enqueue
+  // times, so clamp each one to the latest time seen so far.
+  incoming_packets_.PopAll([this](IncomingPacket packet) {
+    incoming_packets_count_.fetch_sub(1, std::memory_order_relaxed);
+    incoming_packets_bytes_.fetch_sub(packet.bytes, std::memory_order_relaxed);
+    last_timestamp_ms_ = std::max(last_timestamp_ms_, packet.insert_time_ms);
+    EnqueuePacket(packet.priority, packet.ssrc, packet.sequence_number,
+                  packet.capture_time_ms, last_timestamp_ms_, packet.bytes,
+                  packet.retransmission);
+  });
+}
+
 void PacedSender::SetAccountForAudioPackets(bool account_for_audio) {
   rtc::CritScope cs(&critsect_);
   account_for_audio_ = account_for_audio;
@@ -216,8 +264,10 @@ void PacedSender::SetAccountForAudioPackets(bool account_for_audio) {
 int64_t PacedSender::ExpectedQueueTimeMs() const {
   rtc::CritScope cs(&critsect_);
   RTC_DCHECK_GT(pacing_bitrate_kbps_, 0);
-  return static_cast<int64_t>(packets_.SizeInBytes() * 8 /
-                              pacing_bitrate_kbps_);
+  uint64_t queue_size_bytes =
+      packets_.SizeInBytes() +
+      incoming_packets_bytes_.load(std::memory_order_relaxed);
+  return static_cast<int64_t>(queue_size_bytes * 8 / pacing_bitrate_kbps_);
 }
 
 absl::optional<int64_t> PacedSender::GetApplicationLimitedRegionStartTime() {
@@ -229,7 +279,8 @@ absl::optional<int64_t> PacedSender::GetApplicationLimitedRegionStartTime() {
 
 size_t PacedSender::QueueSizePackets() const {
   rtc::CritScope cs(&critsect_);
-  return packets_.SizeInPackets();
+  return packets_.SizeInPackets() +
+         incoming_packets_count_.load(std::memory_order_relaxed);
 }
 
 int64_t PacedSender::FirstSentPacketTimeMs() const {
@@ -249,8 +300,8 @@ int64_t PacedSender::QueueInMs() const {
 
 int64_t PacedSender::TimeUntilNextProcess() {
   rtc::CritScope cs(&critsect_);
-  int64_t elapsed_time_us =
-      clock_->TimeInMicroseconds() - time_last_process_us_;
+  int64_t now_us = clock_->TimeInMicroseconds();
+  int64_t elapsed_time_us = now_us - time_last_process_us_;
   int64_t elapsed_time_ms = (elapsed_time_us + 500) / 1000;
   // When paused we wake up every 500 ms to send a padding packet to ensure
   // we won't get stuck in the paused state due to no feedback being received.
@@ -258,17 +309,25 @@ int64_t PacedSender::TimeUntilNextProcess() {
     return std::max<int64_t>(kPausedProcessIntervalMs - elapsed_time_ms, 0);
 
   if (prober_.IsProbing()) {
-    int64_t ret = prober_.TimeUntilNextProbe(TimeMilliseconds());
-    if (ret > 0 || (ret == 0 && !probing_send_failure_))
-      return ret;
+    // The probe time is rounded to the nearest millisecond, so a probe is sent
+    // at most half a millisecond early or late. Since the prober schedules
+    // probes relative to the start of the cluster, the errors don't add up.
+    int64_t ret_us = prober_.TimeUntilNextProbeUs(now_us);
+    if (ret_us >= 500 || (ret_us >= 0 && !probing_send_failure_))
+      return (ret_us + 500) / 1000;
   }
   return std::max<int64_t>(min_packet_limit_ms_ - elapsed_time_ms, 0);
 }
 
 int64_t PacedSender::UpdateTimeAndGetElapsedMs(int64_t now_us) {
   int64_t elapsed_time_ms = (now_us - time_last_process_us_ + 500) / 1000;
-  time_last_process_us_ = now_us;
+  // Only advance by the whole milliseconds accounted for, so that the rounding
+  // error is carried over to the next call instead of being lost. Otherwise
+  // the budgets drift from the pacing rate when processing isn't aligned to
+  // whole milliseconds.
+  time_last_process_us_ += elapsed_time_ms * 1000;
   if (elapsed_time_ms > kMaxElapsedTimeMs) {
+    time_last_process_us_ = now_us;
     RTC_LOG(LS_WARNING) << "Elapsed time (" << elapsed_time_ms
                         << " ms) longer than expected, limiting to "
                         << kMaxElapsedTimeMs << " ms";
@@ -295,6 +354,7 @@ bool PacedSender::ShouldSendKeepalive(int64_t now_us) const {
 
 void PacedSender::Process() {
   rtc::CritScope cs(&critsect_);
+  DrainIncomingPackets();
   int64_t now_us = clock_->TimeInMicroseconds();
   int64_t elapsed_time_ms = UpdateTimeAndGetElapsedMs(now_us);
   if (ShouldSendKeepalive(now_us)) {
@@ -384,7 +444,7 @@ void PacedSender::Process() {
   if (is_probing) {
     probing_send_failure_ = bytes_sent == 0;
     if (!probing_send_failure_)
-      prober_.ProbeSent(TimeMilliseconds(), bytes_sent);
+      prober_.ProbeSentUs(clock_->TimeInMicroseconds(), bytes_sent);
   }
   if (alr_detector_)
     alr_detector_->OnBytesSent(bytes_sent, now_us / 1000);
@@ -396,12 +456,20 @@ void PacedSender::ProcessThreadAttached(ProcessThread* process_thread) {
   process_thread_ = process_thread;
 }
 
-const RoundRobinPacketQueue::Packet* PacedSender::GetPendingPacket(
+const PooledPacketQueue::Packet* PacedSender::GetPendingPacket(
     const PacedPacketInfo& pacing_info) {
   // Since we need to release the lock in order to send, we first pop the
   // element from the priority queue but keep it in storage, so that we can
   // reinsert it if send fails.
-  const RoundRobinPacketQueue::Packet* packet = &packets_.BeginPop();
+  const PooledPacketQueue::Packet* packet = &packets_.BeginPop();
+  while (IsExpired(*packet)) {
+    // Sending the packet now would only add to the latency of the packets
+    // behind it.
+    packets_.FinalizePop(*packet);
+    if (packets_.Empty())
+      return nullptr;
+    packet = &packets_.BeginPop();
+  }
   bool audio_packet = packet->priority == kHighPriority;
   bool apply_pacing =
       !audio_packet || account_for_audio_ || video_blocks_audio_;
@@ -414,7 +482,16 @@ const RoundRobinPacketQueue::Packet* PacedSender::GetPendingPacket(
   return packet;
 }
 
-void PacedSender::OnPacketSent(const RoundRobinPacketQueue::Packet* packet) {
+bool PacedSender::IsExpired(const PooledPacketQueue::Packet& packet) const {
+  // Packets without a capture time are never dropped.
+  if (!drop_expired_packets_ || packet.priority != kDroppablePriority ||
+      packet.capture_time_ms <= 0) {
+    return false;
+  }
+  return TimeMilliseconds() - packet.capture_time_ms > packet_deadline_ms_;
+}
+
+void PacedSender::OnPacketSent(const PooledPacketQueue::Packet* packet) {
   if (first_sent_packet_ms_ == -1)
     first_sent_packet_ms_ = TimeMilliseconds();
   bool audio_packet = packet->priority == kHighPriority;
@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <atomic>
 #include <memory>
 
 #include "absl/types/optional.h"
@@ -20,11 +21,12 @@
 #include "modules/pacing/bitrate_prober.h"
 #include "modules/pacing/interval_budget.h"
 #include "modules/pacing/pacer.h"
-#include "modules/pacing/round_robin_packet_queue.h"
+#include "modules/pacing/pooled_packet_queue.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/mpsc_queue.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -144,6 +146,29 @@ class PacedSender : public Pacer {
   void SetQueueTimeLimit(int limit_ms);
 
  private:
+  // A packet inserted while |lock_free_insert_| is enabled, waiting to be
+  // moved into |packets_| by the pacer.
+  struct IncomingPacket {
+    RtpPacketSender::Priority priority;
+    uint32_t ssrc;
+    uint16_t sequence_number;
+    int64_t capture_time_ms;
+    int64_t insert_time_ms;
+    size_t bytes;
+    bool retransmission;
+  };
+
+  void EnqueuePacket(RtpPacketSender::Priority priority,
+                     uint32_t ssrc,
+                     uint16_t sequence_number,
+                     int64_t capture_time_ms,
+                     int64_t enqueue_time_ms,
+                     size_t bytes,
+                     bool retransmission)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  // Moves packets from |incoming_packets_| into |packets_|.
+  void DrainIncomingPackets() RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+
   int64_t UpdateTimeAndGetElapsedMs(int64_t now_us)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   bool ShouldSendKeepalive(int64_t at_time_us) const
@@ -155,10 +180,14 @@ class PacedSender : public Pacer {
   void UpdateBudgetWithBytesSent(size_t bytes)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
 
-  const RoundRobinPacketQueue::Packet* GetPendingPacket(
+  const PooledPacketQueue::Packet* GetPendingPacket(
       const PacedPacketInfo& pacing_info)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
-  void OnPacketSent(const RoundRobinPacketQueue::Packet* packet)
+  // Returns true if |packet| is droppable and has been queued past its
+  // deadline.
+  bool IsExpired(const PooledPacketQueue::Packet& packet) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  void OnPacketSent(const PooledPacketQueue::Packet* packet)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   void OnPaddingSent(size_t padding_sent)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
@@ -173,7 +202,15 @@ class PacedSender : public Pacer {
   const bool drain_large_queues_;
   const bool send_padding_if_silent_;
   const bool video_blocks_audio_;
+  // When enabled, InsertPacket() pushes onto |incoming_packets_| without
+  // taking |critsect_|, and the packets are moved into |packets_| the next
+  // time the pacer state is accessed under the lock.
+  const bool lock_free_insert_;
   FieldTrialParameter<int> min_packet_limit_ms_;
+  // When enabled, packets with kDroppablePriority are dropped instead of sent
+  // once more than |packet_deadline_ms_| has passed since their capture.
+  const bool drop_expired_packets_;
+  FieldTrialParameter<int> packet_deadline_ms_;
 
   rtc::CriticalSection critsect_;
   // TODO(webrtc:9716): Remove this when we are certain clocks are monotonic.
@@ -201,7 +238,12 @@ class PacedSender : public Pacer {
   int64_t last_send_time_us_ RTC_GUARDED_BY(critsect_);
   int64_t first_sent_packet_ms_ RTC_GUARDED_BY(critsect_);
 
-  RoundRobinPacketQueue packets_ RTC_GUARDED_BY(critsect_);
+  PooledPacketQueue packets_ RTC_GUARDED_BY(critsect_);
+  MpscQueue<IncomingPacket> incoming_packets_;
+  // Size of |incoming_packets_|, so that queue size queries don't need to
+  // drain it.
+  std::atomic<size_t> incoming_packets_count_;
+  std::atomic<size_t> incoming_packets_bytes_;
   uint64_t packet_counter_ RTC_GUARDED_BY(critsect_);
 
   int64_t congestion_window_bytes_ RTC_GUARDED_BY(critsect_) =
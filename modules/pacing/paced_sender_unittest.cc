@@ -274,6 +274,63 @@ TEST_F(PacedSenderFieldTrialTest, BudgetDoesNotAffectAudioInTrial) {
   ProcessNext(&pacer);
 }
 
+TEST_F(PacedSenderFieldTrialTest, LockFreeInsertKeepsPriorityOrder) {
+  ScopedFieldTrials trial("WebRTC-Pacer-LockFreeInsert/Enabled/");
+  EXPECT_CALL(callback_, TimeToSendPadding).Times(0);
+  PacedSender pacer(&clock_, &callback_, nullptr);
+  pacer.SetPacingRates(10000000, 0);
+  InsertPacket(&pacer, &video);
+  InsertPacket(&pacer, &audio);
+  // Packets not yet drained by the pacer are still reported.
+  EXPECT_EQ(2u, pacer.QueueSizePackets());
+
+  testing::InSequence in_sequence;
+  EXPECT_CALL(callback_, TimeToSendPacket(audio.ssrc, _, _, _, _))
+      .WillOnce(Return(true));
+  EXPECT_CALL(callback_, TimeToSendPacket(video.ssrc, _, _, _, _))
+      .WillOnce(Return(true));
+  ProcessNext(&pacer);
+  EXPECT_EQ(0u, pacer.QueueSizePackets());
+}
+
+TEST_F(PacedSenderFieldTrialTest, DropsExpiredDroppablePacketsInTrial) {
+  ScopedFieldTrials trial("WebRTC-Pacer-DropExpiredPackets/Enabled,deadline:100/");
+  EXPECT_CALL(callback_, TimeToSendPadding).Times(0);
+  PacedSender pacer(&clock_, &callback_, nullptr);
+  pacer.SetPacingRates(10000000, 0);
+  MediaStream fec{/*priority*/ PacedSender::kDroppablePriority,
+                  /*ssrc*/ 5555, /*packet_size*/ 1000, /*seq_num*/ 1000};
+  InsertPacket(&pacer, &fec);
+  InsertPacket(&pacer, &video);
+  clock_.AdvanceTimeMilliseconds(200);
+
+  // The droppable packet is past its deadline, the video packet is not
+  // droppable.
+  EXPECT_CALL(callback_, TimeToSendPacket(fec.ssrc, _, _, _, _)).Times(0);
+  EXPECT_CALL(callback_, TimeToSendPacket(video.ssrc, _, _, _, _))
+      .WillOnce(Return(true));
+  ProcessNext(&pacer);
+  EXPECT_EQ(0u, pacer.QueueSizePackets());
+
+  // Droppable packets within the deadline are sent.
+  InsertPacket(&pacer, &fec);
+  EXPECT_CALL(callback_, TimeToSendPacket(fec.ssrc, _, _, _, _))
+      .WillOnce(Return(true));
+  ProcessNext(&pacer);
+}
+
+TEST_F(PacedSenderFieldTrialTest, DroppablePacketsAreSentLateByDefault) {
+  PacedSender pacer(&clock_, &callback_, nullptr);
+  pacer.SetPacingRates(10000000, 0);
+  MediaStream fec{/*priority*/ PacedSender::kDroppablePriority,
+                  /*ssrc*/ 5555, /*packet_size*/ 1000, /*seq_num*/ 1000};
+  InsertPacket(&pacer, &fec);
+  clock_.AdvanceTimeMilliseconds(1000);
+  EXPECT_CALL(callback_, TimeToSendPacket(fec.ssrc, _, _, _, _))
+      .WillOnce(Return(true));
+  ProcessNext(&pacer);
+}
+
 TEST_F(PacedSenderTest, FirstSentPacketTimeIsSet) {
   uint16_t sequence_number = 1234;
   const uint32_t kSsrc = 12345;
@@ -536,6 +593,35 @@ TEST_F(PacedSenderTest, VerifyAverageBitrateVaryingMediaPayload) {
               1);
 }
 
+TEST_F(PacedSenderTest, VerifyAverageBitrateWithSubMillisecondProcessing) {
+  uint32_t ssrc = 12345;
+  uint16_t sequence_number = 1234;
+  int64_t capture_time_ms = 56789;
+  // Processing isn't aligned to whole milliseconds, so the elapsed time is
+  // rounded differently on every call.
+  const int kTimeStepUs = 1400;
+  const int64_t kBitrateWindow = 10000;
+  PacedSenderPadding callback;
+  send_bucket_.reset(new PacedSender(&clock_, &callback, nullptr));
+  send_bucket_->SetProbingEnabled(false);
+  send_bucket_->SetPacingRates(kTargetBitrateBps * kPaceMultiplier,
+                               kTargetBitrateBps);
+
+  // Media packet to allow padding to be sent.
+  send_bucket_->InsertPacket(PacedSender::kNormalPriority, ssrc,
+                             sequence_number++, capture_time_ms, 250, false);
+  size_t media_bytes = 250;
+  int64_t start_time = clock_.TimeInMilliseconds();
+  while (clock_.TimeInMilliseconds() - start_time < kBitrateWindow) {
+    clock_.AdvanceTimeMicroseconds(kTimeStepUs);
+    send_bucket_->Process();
+  }
+  EXPECT_NEAR(kTargetBitrateBps / 1000,
+              static_cast<int>(8 * (media_bytes + callback.padding_sent()) /
+                               kBitrateWindow),
+              1);
+}
+
 TEST_F(PacedSenderTest, Priority) {
   uint32_t ssrc_low_priority = 12345;
   uint32_t ssrc = 12346;
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "modules/pacing/pooled_packet_queue.h"
+#include "modules/pacing/round_robin_packet_queue.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+const int64_t kStartTimeUs = 1000000;
+const size_t kQueuedPackets = 10000;
+const uint32_t kNumStreams = 20;
+
+// Keeps |kQueuedPackets| packets in the queue, spread over |kNumStreams|
+// streams, while cycling packets through it. Returns the average time per
+// push and pop pair, in nanoseconds.
+template <typename Queue>
+double MeasurePushPop(int iterations) {
+  Queue queue(kStartTimeUs);
+  int64_t now_ms = kStartTimeUs / 1000;
+  uint64_t enqueue_order = 0;
+  auto push = [&]() {
+    uint32_t ssrc = static_cast<uint32_t>(enqueue_order % kNumStreams);
+    RtpPacketSender::Priority priority = (enqueue_order % 10 == 0)
+                                             ? RtpPacketSender::kHighPriority
+                                             : RtpPacketSender::kNormalPriority;
+    queue.Push(typename Queue::Packet(
+        priority, ssrc, static_cast<uint16_t>(enqueue_order), now_ms, now_ms,
+        1200, enqueue_order % 16 == 0, enqueue_order));
+    ++enqueue_order;
+  };
+  for (size_t i = 0; i < kQueuedPackets; ++i)
+    push();
+
+  int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i) {
+    if (i % 100 == 0) {
+      ++now_ms;
+      queue.UpdateQueueTime(now_ms);
+    }
+    const typename Queue::Packet& packet = queue.BeginPop();
+    queue.FinalizePop(packet);
+    push();
+  }
+  int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  EXPECT_EQ(kQueuedPackets, queue.SizeInPackets());
+  return static_cast<double>(elapsed_ns) / iterations;
+}
+
+int Iterations() {
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? 10000 : 1000000;
+}
+
+}  // namespace
+
+TEST(PacketQueuePerformanceTest, RoundRobinPacketQueue) {
+  double ns_per_packet = MeasurePushPop<RoundRobinPacketQueue>(Iterations());
+  test::PrintResult("packet_queue_push_pop", "", "round_robin_packet_queue",
+                    ns_per_packet, "ns", false);
+}
+
+TEST(PacketQueuePerformanceTest, PooledPacketQueue) {
+  double ns_per_packet = MeasurePushPop<PooledPacketQueue>(Iterations());
+  test::PrintResult("packet_queue_push_pop", "", "pooled_packet_queue",
+                    ns_per_packet, "ns", false);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,315 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pooled_packet_queue.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+constexpr PooledPacketQueue::Index PooledPacketQueue::kInvalidIndex;
+constexpr size_t PooledPacketQueue::kNumPacketClasses;
+constexpr size_t PooledPacketQueue::kMaxLeadingBytes;
+
+PooledPacketQueue::Packet::Packet(RtpPacketSender::Priority priority,
+                                  uint32_t ssrc,
+                                  uint16_t seq_number,
+                                  int64_t capture_time_ms,
+                                  int64_t enqueue_time_ms,
+                                  size_t length_in_bytes,
+                                  bool retransmission,
+                                  uint64_t enqueue_order)
+    : priority(priority),
+      ssrc(ssrc),
+      sequence_number(seq_number),
+      capture_time_ms(capture_time_ms),
+      enqueue_time_ms(enqueue_time_ms),
+      bytes(length_in_bytes),
+      retransmission(retransmission),
+      enqueue_order(enqueue_order) {}
+
+PooledPacketQueue::Packet::Packet(const Packet& other) = default;
+
+PooledPacketQueue::Packet::~Packet() {}
+
+PooledPacketQueue::Node::Node(const Packet& packet)
+    : packet(packet),
+      raw_enqueue_time_ms(packet.enqueue_time_ms),
+      next_in_class(kInvalidIndex),
+      prev_in_queue(kInvalidIndex),
+      next_in_queue(kInvalidIndex) {}
+
+PooledPacketQueue::Stream::Stream(uint32_t ssrc) : ssrc(ssrc) {}
+
+PooledPacketQueue::PooledPacketQueue(int64_t start_time_us)
+    : time_last_updated_ms_(start_time_us / 1000) {}
+
+PooledPacketQueue::~PooledPacketQueue() {}
+
+size_t PooledPacketQueue::PacketClass(const Packet& packet) {
+  // Lower ordinal means higher priority, and retransmissions go before other
+  // packets of the same priority.
+  size_t priority = static_cast<size_t>(packet.priority);
+  RTC_DCHECK_LT(priority * 2 + 1, kNumPacketClasses);
+  return priority * 2 + (packet.retransmission ? 0 : 1);
+}
+
+PooledPacketQueue::Index PooledPacketQueue::AllocateNode(
+    const Packet& packet) {
+  if (free_list_ == kInvalidIndex) {
+    RTC_CHECK_LT(nodes_.size(), kInvalidIndex);
+    nodes_.emplace_back(packet);
+    return static_cast<Index>(nodes_.size() - 1);
+  }
+  Index index = free_list_;
+  free_list_ = nodes_[index].next_in_class;
+  nodes_[index] = Node(packet);
+  return index;
+}
+
+void PooledPacketQueue::FreeNode(Index index) {
+  nodes_[index].next_in_class = free_list_;
+  free_list_ = index;
+}
+
+size_t PooledPacketQueue::GetOrCreateStream(uint32_t ssrc) {
+  auto it = std::lower_bound(
+      stream_index_.begin(), stream_index_.end(), ssrc,
+      [](const std::pair<uint32_t, size_t>& entry, uint32_t ssrc) {
+        return entry.first < ssrc;
+      });
+  if (it != stream_index_.end() && it->first == ssrc)
+    return it->second;
+  streams_.emplace_back(ssrc);
+  stream_index_.insert(it, std::make_pair(ssrc, streams_.size() - 1));
+  return streams_.size() - 1;
+}
+
+PooledPacketQueue::Index PooledPacketQueue::TopOfStream(
+    const Stream& stream) const {
+  for (const ClassList& list : stream.classes) {
+    if (list.head != kInvalidIndex)
+      return list.head;
+  }
+  return kInvalidIndex;
+}
+
+void PooledPacketQueue::Schedule(Stream* stream,
+                                 RtpPacketSender::Priority priority) {
+  if (!stream->scheduled) {
+    scheduled_streams_.push_back(stream - streams_.data());
+    stream->scheduled = true;
+  }
+  stream->scheduled_priority = priority;
+  stream->scheduled_bytes = stream->bytes;
+  stream->schedule_order = next_schedule_order_++;
+}
+
+void PooledPacketQueue::Unschedule(Stream* stream) {
+  RTC_DCHECK(stream->scheduled);
+  size_t position = stream - streams_.data();
+  auto it = std::find(scheduled_streams_.begin(), scheduled_streams_.end(),
+                      position);
+  RTC_CHECK(it != scheduled_streams_.end());
+  *it = scheduled_streams_.back();
+  scheduled_streams_.pop_back();
+  stream->scheduled = false;
+}
+
+size_t PooledPacketQueue::GetHighestPriorityStream() const {
+  RTC_CHECK(!scheduled_streams_.empty());
+  size_t best = scheduled_streams_[0];
+  for (size_t position : scheduled_streams_) {
+    const Stream& candidate = streams_[position];
+    const Stream& current = streams_[best];
+    if (std::make_tuple(candidate.scheduled_priority, candidate.scheduled_bytes,
+                        candidate.schedule_order) <
+        std::make_tuple(current.scheduled_priority, current.scheduled_bytes,
+                        current.schedule_order)) {
+      best = position;
+    }
+  }
+  return best;
+}
+
+void PooledPacketQueue::Push(const Packet& packet_to_insert) {
+  Stream* stream = &streams_[GetOrCreateStream(packet_to_insert.ssrc)];
+
+  // Note that RtpPacketSender::Priority uses lower ordinal for higher
+  // priority, so reschedule the stream if the incoming packet raises it.
+  if (!stream->scheduled ||
+      packet_to_insert.priority < stream->scheduled_priority) {
+    Schedule(stream, packet_to_insert.priority);
+  }
+
+  Index index = AllocateNode(packet_to_insert);
+  Node& node = nodes_[index];
+
+  // In order to figure out how much time a packet has spent in the queue while
+  // not in a paused state, we subtract the total amount of time the queue has
+  // been paused so far, and when the packet is popped we subtract the total
+  // amount of time the queue has been paused at that moment.
+  UpdateQueueTime(node.packet.enqueue_time_ms);
+  node.packet.enqueue_time_ms -= pause_time_sum_ms_;
+
+  // Enqueue times are monotonic, so appending keeps the queue-wide list sorted.
+  node.prev_in_queue = newest_;
+  if (newest_ != kInvalidIndex)
+    nodes_[newest_].next_in_queue = index;
+  else
+    oldest_ = index;
+  newest_ = index;
+
+  // Enqueue order is increasing, so appending keeps each class list sorted.
+  ClassList& list = stream->classes[PacketClass(node.packet)];
+  if (list.tail != kInvalidIndex)
+    nodes_[list.tail].next_in_class = index;
+  else
+    list.head = index;
+  list.tail = index;
+
+  size_packets_ += 1;
+  size_bytes_ += node.packet.bytes;
+}
+
+const PooledPacketQueue::Packet& PooledPacketQueue::BeginPop() {
+  RTC_CHECK(!pop_packet_);
+
+  pop_stream_ = GetHighestPriorityStream();
+  Stream& stream = streams_[pop_stream_];
+  pop_index_ = TopOfStream(stream);
+  RTC_CHECK_NE(pop_index_, kInvalidIndex);
+
+  Node& node = nodes_[pop_index_];
+  ClassList& list = stream.classes[PacketClass(node.packet)];
+  RTC_DCHECK_EQ(list.head, pop_index_);
+  list.head = node.next_in_class;
+  if (list.head == kInvalidIndex)
+    list.tail = kInvalidIndex;
+  node.next_in_class = kInvalidIndex;
+
+  // Return a copy, since pushes may grow |nodes_| before the pop is finished.
+  pop_packet_.emplace(node.packet);
+  return *pop_packet_;
+}
+
+void PooledPacketQueue::CancelPop(const Packet& packet) {
+  RTC_CHECK(pop_packet_);
+  Stream& stream = streams_[pop_stream_];
+  Node& node = nodes_[pop_index_];
+  // The popped packet was first in its class, so put it back at the front.
+  ClassList& list = stream.classes[PacketClass(node.packet)];
+  node.next_in_class = list.head;
+  list.head = pop_index_;
+  if (list.tail == kInvalidIndex)
+    list.tail = pop_index_;
+  pop_packet_.reset();
+  pop_index_ = kInvalidIndex;
+}
+
+void PooledPacketQueue::FinalizePop(const Packet& packet) {
+  if (Empty())
+    return;
+  RTC_CHECK(pop_packet_);
+  Stream* stream = &streams_[pop_stream_];
+  Unschedule(stream);
+  const Packet& popped = *pop_packet_;
+
+  // Calculate the total amount of time spent by this packet in the queue
+  // while in a non-paused state. See Push().
+  int64_t time_in_non_paused_state_ms =
+      time_last_updated_ms_ - popped.enqueue_time_ms - pause_time_sum_ms_;
+  queue_time_sum_ms_ -= time_in_non_paused_state_ms;
+
+  Node& node = nodes_[pop_index_];
+  if (node.prev_in_queue != kInvalidIndex)
+    nodes_[node.prev_in_queue].next_in_queue = node.next_in_queue;
+  else
+    oldest_ = node.next_in_queue;
+  if (node.next_in_queue != kInvalidIndex)
+    nodes_[node.next_in_queue].prev_in_queue = node.prev_in_queue;
+  else
+    newest_ = node.prev_in_queue;
+  FreeNode(pop_index_);
+
+  // Limit |bytes| to be within kMaxLeadingBytes of the stream that has sent
+  // the most, so that a stream sending at a lower rate does not build up a
+  // too large budget. See RoundRobinPacketQueue::FinalizePop().
+  stream->bytes =
+      std::max(stream->bytes + popped.bytes, max_bytes_ - kMaxLeadingBytes);
+  max_bytes_ = std::max(max_bytes_, stream->bytes);
+
+  size_bytes_ -= popped.bytes;
+  size_packets_ -= 1;
+  RTC_CHECK(size_packets_ > 0 || queue_time_sum_ms_ == 0);
+
+  // If there are packets left to be sent, schedule the stream again.
+  Index top = TopOfStream(*stream);
+  if (top != kInvalidIndex)
+    Schedule(stream, nodes_[top].packet.priority);
+
+  pop_packet_.reset();
+  pop_index_ = kInvalidIndex;
+}
+
+bool PooledPacketQueue::Empty() const {
+  RTC_CHECK((!scheduled_streams_.empty() && size_packets_ > 0) ||
+            (scheduled_streams_.empty() && size_packets_ == 0));
+  return scheduled_streams_.empty();
+}
+
+size_t PooledPacketQueue::SizeInPackets() const {
+  return size_packets_;
+}
+
+uint64_t PooledPacketQueue::SizeInBytes() const {
+  return size_bytes_;
+}
+
+int64_t PooledPacketQueue::OldestEnqueueTimeMs() const {
+  if (Empty())
+    return 0;
+  RTC_CHECK_NE(oldest_, kInvalidIndex);
+  return nodes_[oldest_].raw_enqueue_time_ms;
+}
+
+void PooledPacketQueue::UpdateQueueTime(int64_t timestamp_ms) {
+  RTC_CHECK_GE(timestamp_ms, time_last_updated_ms_);
+  if (timestamp_ms == time_last_updated_ms_)
+    return;
+
+  int64_t delta_ms = timestamp_ms - time_last_updated_ms_;
+
+  if (paused_) {
+    pause_time_sum_ms_ += delta_ms;
+  } else {
+    queue_time_sum_ms_ += delta_ms * size_packets_;
+  }
+
+  time_last_updated_ms_ = timestamp_ms;
+}
+
+void PooledPacketQueue::SetPauseState(bool paused, int64_t timestamp_ms) {
+  if (paused_ == paused)
+    return;
+  UpdateQueueTime(timestamp_ms);
+  paused_ = paused;
+}
+
+int64_t PooledPacketQueue::AverageQueueTimeMs() const {
+  if (Empty())
+    return 0;
+  return queue_time_sum_ms_ / size_packets_;
+}
+
+}  // namespace webrtc
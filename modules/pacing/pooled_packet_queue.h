@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_POOLED_PACKET_QUEUE_H_
+#define MODULES_PACING_POOLED_PACKET_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+
+namespace webrtc {
+
+// Packet queue with the same scheduling as RoundRobinPacketQueue: streams are
+// served in order of priority and then of bytes sent, and within a stream
+// packets are ordered by priority, retransmission and enqueue order.
+//
+// Queued packets are stored in a pooled arena of nodes linked by index, so once
+// the pool has grown to the high-water mark of the queue, pushing and popping
+// packets does not allocate. Streams are looked up through a sorted, flat SSRC
+// index.
+class PooledPacketQueue {
+ public:
+  explicit PooledPacketQueue(int64_t start_time_us);
+  ~PooledPacketQueue();
+
+  struct Packet {
+    Packet(RtpPacketSender::Priority priority,
+           uint32_t ssrc,
+           uint16_t seq_number,
+           int64_t capture_time_ms,
+           int64_t enqueue_time_ms,
+           size_t length_in_bytes,
+           bool retransmission,
+           uint64_t enqueue_order);
+    Packet(const Packet& other);
+    ~Packet();
+
+    RtpPacketSender::Priority priority;
+    uint32_t ssrc;
+    uint16_t sequence_number;
+    int64_t capture_time_ms;  // Absolute time of frame capture.
+    int64_t enqueue_time_ms;  // Absolute time of pacer queue entry.
+    size_t bytes;
+    bool retransmission;
+    uint64_t enqueue_order;
+  };
+
+  void Push(const Packet& packet);
+  // The returned reference stays valid until CancelPop() or FinalizePop(),
+  // even if more packets are pushed in the meantime.
+  const Packet& BeginPop();
+  void CancelPop(const Packet& packet);
+  void FinalizePop(const Packet& packet);
+
+  bool Empty() const;
+  size_t SizeInPackets() const;
+  uint64_t SizeInBytes() const;
+
+  int64_t OldestEnqueueTimeMs() const;
+  int64_t AverageQueueTimeMs() const;
+  void UpdateQueueTime(int64_t timestamp_ms);
+  void SetPauseState(bool paused, int64_t timestamp_ms);
+
+ private:
+  using Index = uint32_t;
+  static constexpr Index kInvalidIndex = 0xFFFFFFFF;
+  // One packet class per combination of priority and retransmission flag,
+  // ordered so that lower class values are sent first.
+  static constexpr size_t kNumPacketClasses = 10;
+  static constexpr size_t kMaxLeadingBytes = 1400;
+
+  struct Node {
+    explicit Node(const Packet& packet);
+    Packet packet;
+    // Enqueue time before the paused time is subtracted.
+    int64_t raw_enqueue_time_ms;
+    // Links within the packet class list of the packet's stream.
+    Index next_in_class;
+    // Links in the queue-wide list ordered by enqueue time.
+    Index prev_in_queue;
+    Index next_in_queue;
+  };
+
+  struct ClassList {
+    Index head = kInvalidIndex;
+    Index tail = kInvalidIndex;
+  };
+
+  struct Stream {
+    explicit Stream(uint32_t ssrc);
+
+    uint32_t ssrc;
+    size_t bytes = 0;
+    ClassList classes[kNumPacketClasses];
+
+    // Scheduling key, valid while |scheduled| is true. Streams are served in
+    // order of (priority, bytes, schedule_order).
+    bool scheduled = false;
+    RtpPacketSender::Priority scheduled_priority =
+        RtpPacketSender::kNormalPriority;
+    size_t scheduled_bytes = 0;
+    uint64_t schedule_order = 0;
+  };
+
+  static size_t PacketClass(const Packet& packet);
+
+  Index AllocateNode(const Packet& packet);
+  void FreeNode(Index index);
+
+  // Returns the position of the stream in |streams_|.
+  size_t GetOrCreateStream(uint32_t ssrc);
+  // Returns the index of the next packet to send from |stream|.
+  Index TopOfStream(const Stream& stream) const;
+  void Schedule(Stream* stream, RtpPacketSender::Priority priority);
+  void Unschedule(Stream* stream);
+  size_t GetHighestPriorityStream() const;
+
+  std::vector<Node> nodes_;
+  Index free_list_ = kInvalidIndex;
+
+  // Queue-wide list of packets in enqueue order, used to find the oldest
+  // enqueue time.
+  Index oldest_ = kInvalidIndex;
+  Index newest_ = kInvalidIndex;
+
+  std::vector<Stream> streams_;
+  // SSRC to position in |streams_|, sorted by SSRC.
+  std::vector<std::pair<uint32_t, size_t>> stream_index_;
+  // Positions in |streams_| of the streams that have packets to send.
+  std::vector<size_t> scheduled_streams_;
+  uint64_t next_schedule_order_ = 0;
+
+  int64_t time_last_updated_ms_;
+  absl::optional<Packet> pop_packet_;
+  Index pop_index_ = kInvalidIndex;
+  size_t pop_stream_ = 0;
+
+  bool paused_ = false;
+  size_t size_packets_ = 0;
+  size_t size_bytes_ = 0;
+  size_t max_bytes_ = kMaxLeadingBytes;
+  int64_t queue_time_sum_ms_ = 0;
+  int64_t pause_time_sum_ms_ = 0;
+};
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_POOLED_PACKET_QUEUE_H_
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pooled_packet_queue.h"
+
+#include "modules/pacing/round_robin_packet_queue.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const int64_t kStartTimeUs = 1000000;
+
+RtpPacketSender::Priority RandomPriority(Random* random) {
+  switch (random->Rand(2)) {
+    case 0:
+      return RtpPacketSender::kHighPriority;
+    case 1:
+      return RtpPacketSender::kNormalPriority;
+    default:
+      return RtpPacketSender::kLowPriority;
+  }
+}
+
+}  // namespace
+
+TEST(PooledPacketQueueTest, SendsHigherPriorityFirst) {
+  PooledPacketQueue queue(kStartTimeUs);
+  queue.Push(PooledPacketQueue::Packet(RtpPacketSender::kLowPriority, 1, 10,
+                                       0, 1000, 100, false, 0));
+  queue.Push(PooledPacketQueue::Packet(RtpPacketSender::kNormalPriority, 1, 11,
+                                       0, 1000, 100, false, 1));
+  queue.Push(PooledPacketQueue::Packet(RtpPacketSender::kNormalPriority, 1, 12,
+                                       0, 1000, 100, true, 2));
+  queue.Push(PooledPacketQueue::Packet(RtpPacketSender::kHighPriority, 2, 20,
+                                       0, 1000, 100, false, 3));
+  EXPECT_EQ(4u, queue.SizeInPackets());
+  EXPECT_EQ(400u, queue.SizeInBytes());
+
+  const uint16_t kExpectedOrder[] = {20, 12, 11, 10};
+  for (uint16_t expected : kExpectedOrder) {
+    const PooledPacketQueue::Packet& packet = queue.BeginPop();
+    EXPECT_EQ(expected, packet.sequence_number);
+    queue.FinalizePop(packet);
+  }
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(PooledPacketQueueTest, CancelPopRestoresPacket) {
+  PooledPacketQueue queue(kStartTimeUs);
+  queue.Push(PooledPacketQueue::Packet(RtpPacketSender::kNormalPriority, 1, 10,
+                                       0, 1000, 100, false, 0));
+  queue.Push(PooledPacketQueue::Packet(RtpPacketSender::kNormalPriority, 1, 11,
+                                       0, 1001, 100, false, 1));
+  const PooledPacketQueue::Packet& packet = queue.BeginPop();
+  EXPECT_EQ(10, packet.sequence_number);
+  queue.CancelPop(packet);
+  EXPECT_EQ(2u, queue.SizeInPackets());
+  EXPECT_EQ(1000, queue.OldestEnqueueTimeMs());
+  EXPECT_EQ(10, queue.BeginPop().sequence_number);
+}
+
+TEST(PooledPacketQueueTest, PoppedPacketSurvivesPushes) {
+  PooledPacketQueue queue(kStartTimeUs);
+  queue.Push(PooledPacketQueue::Packet(RtpPacketSender::kNormalPriority, 1, 10,
+                                       0, 1000, 100, false, 0));
+  const PooledPacketQueue::Packet& packet = queue.BeginPop();
+  // Grow the pool while the pop is in progress.
+  for (uint16_t i = 0; i < 100; ++i) {
+    queue.Push(PooledPacketQueue::Packet(RtpPacketSender::kNormalPriority, 2,
+                                         i, 0, 1000, 100, false, i + 1));
+  }
+  EXPECT_EQ(10, packet.sequence_number);
+  EXPECT_EQ(1u, packet.ssrc);
+  queue.FinalizePop(packet);
+  EXPECT_EQ(100u, queue.SizeInPackets());
+}
+
+// Runs a random sequence of operations on both queues and verifies that they
+// send packets in the same order.
+TEST(PooledPacketQueueTest, MatchesRoundRobinPacketQueue) {
+  Random random(0x1234);
+  PooledPacketQueue pooled(kStartTimeUs);
+  RoundRobinPacketQueue reference(kStartTimeUs);
+  int64_t now_ms = kStartTimeUs / 1000;
+  uint64_t enqueue_order = 0;
+  bool paused = false;
+  for (int i = 0; i < 20000; ++i) {
+    now_ms += random.Rand(1);
+    int action = random.Rand(9);
+    if (action < 5) {
+      RtpPacketSender::Priority priority = RandomPriority(&random);
+      uint32_t ssrc = 1000 + random.Rand(7);
+      uint16_t seq = static_cast<uint16_t>(i);
+      size_t bytes = 50 + random.Rand(1200);
+      bool retransmission = random.Rand(4) == 0;
+      pooled.Push(PooledPacketQueue::Packet(priority, ssrc, seq, now_ms,
+                                            now_ms, bytes, retransmission,
+                                            enqueue_order));
+      reference.Push(RoundRobinPacketQueue::Packet(priority, ssrc, seq, now_ms,
+                                                   now_ms, bytes,
+                                                   retransmission,
+                                                   enqueue_order));
+      ++enqueue_order;
+    } else if (action < 8) {
+      ASSERT_EQ(reference.Empty(), pooled.Empty());
+      if (pooled.Empty())
+        continue;
+      pooled.UpdateQueueTime(now_ms);
+      reference.UpdateQueueTime(now_ms);
+      const PooledPacketQueue::Packet& pooled_packet = pooled.BeginPop();
+      const RoundRobinPacketQueue::Packet& reference_packet =
+          reference.BeginPop();
+      ASSERT_EQ(reference_packet.ssrc, pooled_packet.ssrc);
+      ASSERT_EQ(reference_packet.sequence_number,
+                pooled_packet.sequence_number);
+      if (action == 7) {
+        pooled.CancelPop(pooled_packet);
+        reference.CancelPop(reference_packet);
+      } else {
+        pooled.FinalizePop(pooled_packet);
+        reference.FinalizePop(reference_packet);
+      }
+    } else {
+      paused = !paused;
+      pooled.SetPauseState(paused, now_ms);
+      reference.SetPauseState(paused, now_ms);
+    }
+    ASSERT_EQ(reference.SizeInPackets(), pooled.SizeInPackets());
+    ASSERT_EQ(reference.SizeInBytes(), pooled.SizeInBytes());
+    ASSERT_EQ(reference.OldestEnqueueTimeMs(), pooled.OldestEnqueueTimeMs());
+    ASSERT_EQ(reference.AverageQueueTimeMs(), pooled.AverageQueueTimeMs());
+  }
+}
+
+}  // namespace webrtc
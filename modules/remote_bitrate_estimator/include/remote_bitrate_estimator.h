@@ -51,6 +51,12 @@ struct ReceiveBandwidthEstimatorStats {};
 
 class RemoteBitrateEstimator : public CallStatsObserver, public Module {
  public:
+  struct ReceivedPacket {
+    int64_t arrival_time_ms;
+    size_t payload_size;
+    RTPHeader header;
+  };
+
   ~RemoteBitrateEstimator() override {}
 
   // Called for each incoming packet. Updates the incoming payload bitrate
@@ -62,6 +68,11 @@ class RemoteBitrateEstimator : public CallStatsObserver, public Module {
                               size_t payload_size,
                               const RTPHeader& header) = 0;
 
+  // Same as calling IncomingPacket() for each of |packets|, in order, but
+  // estimators may update their state and notify the observer once per batch
+  // rather than once per packet.
+  virtual void IncomingPackets(const std::vector<ReceivedPacket>& packets);
+
   // Removes all data for |ssrc|.
   virtual void RemoveStream(uint32_t ssrc) = 0;
 
@@ -81,6 +92,12 @@ class RemoteBitrateEstimator : public CallStatsObserver, public Module {
   static const int64_t kStreamTimeOutMs = 2000;
 };
 
+inline void RemoteBitrateEstimator::IncomingPackets(
+    const std::vector<ReceivedPacket>& packets) {
+  for (const ReceivedPacket& packet : packets)
+    IncomingPacket(packet.arrival_time_ms, packet.payload_size, packet.header);
+}
+
 inline bool RemoteBitrateEstimator::GetStats(
     ReceiveBandwidthEstimatorStats* output) const {
   return false;
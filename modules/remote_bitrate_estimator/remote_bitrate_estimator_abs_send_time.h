@@ -79,6 +79,7 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
   void IncomingPacket(int64_t arrival_time_ms,
                       size_t payload_size,
                       const RTPHeader& header) override;
+  void IncomingPackets(const std::vector<ReceivedPacket>& packets) override;
   // This class relies on Process() being called periodically (at least once
   // every other second) for streams to be timed out properly. Therefore it
   // shouldn't be detached from the ProcessThread except if it's about to be
@@ -100,10 +101,15 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
 
   static void AddCluster(std::list<Cluster>* clusters, Cluster* cluster);
 
-  void IncomingPacketInfo(int64_t arrival_time_ms,
+  // Updates the estimator with a received packet. Returns true and sets
+  // |target_bitrate_bps| if the estimate should be signaled to the observer.
+  bool IncomingPacketInfo(int64_t now_ms,
+                          int64_t arrival_time_ms,
                           uint32_t send_time_24bits,
                           size_t payload_size,
-                          uint32_t ssrc);
+                          uint32_t ssrc,
+                          uint32_t* target_bitrate_bps)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&crit_);
 
   void ComputeClusters(std::list<Cluster>* clusters) const;
 
@@ -289,4 +289,47 @@ TEST_F(RemoteBitrateEstimatorAbsSendTimeTest, ProbingIgnoresSmallPackets) {
   EXPECT_TRUE(bitrate_observer_->updated());
   EXPECT_NEAR(bitrate_observer_->latest_bitrate(), 800000u, 10000);
 }
+
+TEST_F(RemoteBitrateEstimatorAbsSendTimeTest, BatchedPacketsGiveSameEstimate) {
+  testing::TestBitrateObserver batch_observer;
+  RemoteBitrateEstimatorAbsSendTime batch_estimator(&batch_observer, &clock_);
+  const int kFramerate = 50;
+  const int kPacketsPerFrame = 5;
+  const uint32_t kFrameIntervalAbsSendTime = AbsSendTime(1, kFramerate);
+  uint32_t absolute_send_time = 0;
+  clock_.AdvanceTimeMilliseconds(1000);
+  // Long enough for the estimate to be initialized.
+  for (int i = 0; i < 6 * kFramerate; ++i) {
+    // The packets of a frame are all handled at the same time, one at a time
+    // by |bitrate_estimator_| and as one batch by |batch_estimator|.
+    int64_t now_ms = clock_.TimeInMilliseconds();
+    std::vector<RemoteBitrateEstimator::ReceivedPacket> batch;
+    for (int j = 0; j < kPacketsPerFrame; ++j) {
+      RemoteBitrateEstimator::ReceivedPacket packet;
+      packet.arrival_time_ms = now_ms - kPacketsPerFrame + j;
+      packet.payload_size = 1000;
+      packet.header.ssrc = kDefaultSsrc;
+      packet.header.extension.hasAbsoluteSendTime = true;
+      packet.header.extension.absoluteSendTime = absolute_send_time;
+      bitrate_estimator_->IncomingPacket(packet.arrival_time_ms,
+                                         packet.payload_size, packet.header);
+      batch.push_back(packet);
+    }
+    batch_estimator.IncomingPackets(batch);
+    clock_.AdvanceTimeMilliseconds(1000 / kFramerate);
+    absolute_send_time =
+        AddAbsSendTime(absolute_send_time, kFrameIntervalAbsSendTime);
+  }
+
+  std::vector<uint32_t> ssrcs;
+  uint32_t bitrate_bps = 0;
+  ASSERT_TRUE(bitrate_estimator_->LatestEstimate(&ssrcs, &bitrate_bps));
+  std::vector<uint32_t> batch_ssrcs;
+  uint32_t batch_bitrate_bps = 0;
+  ASSERT_TRUE(batch_estimator.LatestEstimate(&batch_ssrcs, &batch_bitrate_bps));
+  EXPECT_EQ(ssrcs, batch_ssrcs);
+  EXPECT_EQ(bitrate_bps, batch_bitrate_bps);
+  EXPECT_TRUE(batch_observer.updated());
+  EXPECT_EQ(bitrate_bps, batch_observer.latest_bitrate());
+}
 }  // namespace webrtc
@@ -389,6 +389,9 @@ class RtpPacketSender {
     kHighPriority = 0,    // Pass through; will be sent immediately.
     kNormalPriority = 2,  // Put in back of the line.
     kLowPriority = 3,     // Put in back of the low priority line.
+    // Put in back of the droppable line. May be dropped by the pacer rather
+    // than sent late, e.g. FEC and enhancement layer packets.
+    kDroppablePriority = 4,
   };
   // Low priority packets are mixed with the normal priority packets
   // while we are paused.
@@ -24,11 +24,40 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/mod_ops.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
 
 namespace {
 // Transport header size in bytes. Assume UDP/IPv4 as a reasonable minimum.
 constexpr size_t kTransportOverhead = 28;
+
+// The number of packet mask combinations kept by an encoder. Encoders see few
+// distinct combinations, so the cache is simply cleared when it is full.
+constexpr size_t kMaxCachedPacketMasks = 64;
+
+// XORs the |size| bytes at |src| into |dst|.
+void XorBytes(const uint8_t* src, size_t size, uint8_t* dst) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 16 <= size; i += 16) {
+    __m128i* d = reinterpret_cast<__m128i*>(&dst[i]);
+    const __m128i* s = reinterpret_cast<const __m128i*>(&src[i]);
+    _mm_storeu_si128(d, _mm_xor_si128(_mm_loadu_si128(d), _mm_loadu_si128(s)));
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  for (; i + 16 <= size; i += 16) {
+    vst1q_u8(&dst[i], veorq_u8(vld1q_u8(&dst[i]), vld1q_u8(&src[i])));
+  }
+#endif
+  for (; i < size; ++i) {
+    dst[i] ^= src[i];
+  }
+}
 }  // namespace
 
 ForwardErrorCorrection::Packet::Packet() : length(0), data(), ref_count_(0) {}
@@ -154,12 +183,9 @@ int ForwardErrorCorrection::EncodeFec(const PacketList& media_packets,
     fec_packets->push_back(&generated_fec_packets_[i]);
   }
 
-  internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
   packet_mask_size_ = internal::PacketMaskSize(num_media_packets);
-  memset(packet_masks_, 0, num_fec_packets * packet_mask_size_);
-  internal::GeneratePacketMasks(num_media_packets, num_fec_packets,
-                                num_important_packets, use_unequal_protection,
-                                &mask_table, packet_masks_);
+  GetPacketMasks(num_media_packets, num_fec_packets, num_important_packets,
+                 use_unequal_protection, fec_mask_type);
 
   // Adapt packet masks to missing media packets.
   int num_mask_bits = InsertZerosInPacketMasks(media_packets, num_fec_packets);
@@ -195,6 +221,32 @@ int ForwardErrorCorrection::NumFecPackets(int num_media_packets,
   return num_fec_packets;
 }
 
+void ForwardErrorCorrection::GetPacketMasks(int num_media_packets,
+                                            int num_fec_packets,
+                                            int num_important_packets,
+                                            bool use_unequal_protection,
+                                            FecMaskType fec_mask_type) {
+  const size_t masks_size = num_fec_packets * packet_mask_size_;
+  const PacketMaskKey key(num_media_packets, num_fec_packets,
+                          num_important_packets, use_unequal_protection,
+                          fec_mask_type);
+  auto it = packet_mask_cache_.find(key);
+  if (it == packet_mask_cache_.end()) {
+    if (packet_mask_cache_.size() >= kMaxCachedPacketMasks) {
+      packet_mask_cache_.clear();
+    }
+    std::vector<uint8_t> masks(masks_size, 0);
+    internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
+    internal::GeneratePacketMasks(num_media_packets, num_fec_packets,
+                                  num_important_packets,
+                                  use_unequal_protection, &mask_table,
+                                  masks.data());
+    it = packet_mask_cache_.emplace(key, std::move(masks)).first;
+  }
+  RTC_DCHECK_EQ(it->second.size(), masks_size);
+  memcpy(packet_masks_, it->second.data(), masks_size);
+}
+
 void ForwardErrorCorrection::GenerateFecPayloads(
     const PacketList& media_packets,
     size_t num_fec_packets) {
@@ -610,9 +662,7 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   // XOR the payload.
   RTC_DCHECK_LE(kRtpHeaderSize + payload_length, sizeof(src.data));
   RTC_DCHECK_LE(dst_offset + payload_length, sizeof(dst->data));
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst->data[dst_offset + i] ^= src.data[kRtpHeaderSize + i];
-  }
+  XorBytes(&src.data[kRtpHeaderSize], payload_length, &dst->data[dst_offset]);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
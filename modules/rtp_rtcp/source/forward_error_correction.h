@@ -14,7 +14,9 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <list>
+#include <map>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 #include "modules/include/module_fec_types.h"
@@ -252,6 +254,14 @@ class ForwardErrorCorrection {
   int InsertZerosInPacketMasks(const PacketList& media_packets,
                                size_t num_fec_packets);
 
+  // Writes the packet masks for the given parameters to |packet_masks_|,
+  // generating them only the first time these parameters are seen.
+  void GetPacketMasks(int num_media_packets,
+                      int num_fec_packets,
+                      int num_important_packets,
+                      bool use_unequal_protection,
+                      FecMaskType fec_mask_type);
+
   // Writes FEC payloads and some recovery fields in the FEC headers.
   void GenerateFecPayloads(const PacketList& media_packets,
                            size_t num_fec_packets);
@@ -344,6 +354,12 @@ class ForwardErrorCorrection {
   uint8_t packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   uint8_t tmp_packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   size_t packet_mask_size_;
+
+  // Packet masks generated by earlier calls to EncodeFec(), keyed by the
+  // number of media, FEC and important packets, whether unequal protection is
+  // used and the mask type.
+  using PacketMaskKey = std::tuple<int, int, int, bool, FecMaskType>;
+  std::map<PacketMaskKey, std::vector<uint8_t>> packet_mask_cache_;
 };
 
 // Classes derived from FecHeader{Reader,Writer} encapsulate the
@@ -0,0 +1,444 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures how many streams an SFU can forward per core, when it parses the
+// layer information of every packet and forwards a subset of the spatial and
+// temporal layers, in the way of test::LayerFilteringTransport. Layer
+// information is read either from the VP8/VP9 payload descriptor or from the
+// generic frame descriptor header extension.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtp_format_vp8.h"
+#include "modules/rtp_rtcp/source/rtp_format_vp9.h"
+#include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
+#include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor_extension.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint8_t kPayloadType = 96;
+constexpr int kGenericDescriptorExtensionId = 1;
+constexpr int kNumStreams = 20;
+constexpr int kFramerate = 30;
+constexpr int kNumPictures = 10 * kFramerate;
+constexpr int kNumTemporalLayers = 3;
+constexpr int kNumSpatialLayers = 3;
+
+// Bytes per layer frame of a 720p stream at roughly 1.5 Mbps.
+constexpr size_t kVp8FrameSize[kNumTemporalLayers] = {9000, 5000, 4000};
+constexpr size_t kVp9FrameSize[kNumSpatialLayers] = {700, 1800, 4500};
+
+enum class LayerInfoSource { kPayloadDescriptor, kGenericFrameDescriptor };
+
+struct Stream {
+  VideoCodecType codec;
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+};
+
+// Temporal layer of each picture, in the 0212 pattern.
+int TemporalIdx(int picture) {
+  static const int kPattern[] = {0, 2, 1, 2};
+  return kPattern[picture % 4];
+}
+
+// Distance to the picture that |picture| references in the 0212 pattern.
+int ReferenceDistance(int picture) {
+  static const int kDistance[] = {4, 1, 2, 1};
+  return kDistance[picture % 4];
+}
+
+// Packetizes one layer frame and appends its packets to |stream|, with a
+// generic frame descriptor built from |descriptor|.
+void AppendLayerFrame(const RtpHeaderExtensionMap& extensions,
+                      RtpPacketizer* packetizer,
+                      uint32_t ssrc,
+                      uint32_t timestamp,
+                      uint16_t* sequence_number,
+                      RtpGenericFrameDescriptor descriptor,
+                      Stream* stream) {
+  const size_t num_packets = packetizer->NumPackets();
+  for (size_t i = 0; i < num_packets; ++i) {
+    RtpPacketToSend packet(&extensions);
+    packet.SetPayloadType(kPayloadType);
+    packet.SetSsrc(ssrc);
+    packet.SetTimestamp(timestamp);
+    packet.SetSequenceNumber((*sequence_number)++);
+    descriptor.SetFirstPacketInSubFrame(i == 0);
+    descriptor.SetLastPacketInSubFrame(i == num_packets - 1);
+    packet.SetExtension<RtpGenericFrameDescriptorExtension>(descriptor);
+    RTC_CHECK(packetizer->NextPacket(&packet));
+    stream->packets.push_back(packet.Buffer());
+  }
+}
+
+// Creates a VP8 stream with three temporal layers.
+Stream CreateVp8Stream(const RtpHeaderExtensionMap& extensions,
+                       uint32_t ssrc) {
+  Stream stream;
+  stream.codec = kVideoCodecVP8;
+  RtpPacketizer::PayloadSizeLimits limits;
+  uint16_t sequence_number = 0;
+  for (int picture = 0; picture < kNumPictures; ++picture) {
+    const int temporal_idx = TemporalIdx(picture);
+    // All frames are delta frames, which is what the P bit of the first
+    // payload byte tells the depacketizer.
+    std::vector<uint8_t> payload(kVp8FrameSize[temporal_idx], 0x01);
+
+    RTPVideoHeaderVP8 vp8;
+    vp8.InitRTPVideoHeaderVP8();
+    vp8.pictureId = (1000 + picture) & 0x7FFF;
+    vp8.tl0PicIdx = (picture / 4) & 0xFF;
+    vp8.temporalIdx = temporal_idx;
+    vp8.layerSync = false;
+    vp8.nonReference = temporal_idx == kNumTemporalLayers - 1;
+    RtpPacketizerVp8 packetizer(payload, limits, vp8);
+
+    RtpGenericFrameDescriptor descriptor;
+    descriptor.SetFirstPacketInSubFrame(true);
+    descriptor.SetFirstSubFrameInFrame(true);
+    descriptor.SetLastSubFrameInFrame(true);
+    descriptor.SetTemporalLayer(temporal_idx);
+    descriptor.SetSpatialLayersBitmask(1);
+    descriptor.SetFrameId(static_cast<uint16_t>(picture));
+    if (picture > 0)
+      descriptor.AddFrameDependencyDiff(ReferenceDistance(picture));
+
+    AppendLayerFrame(extensions, &packetizer, ssrc, 3000 * picture,
+                     &sequence_number, descriptor, &stream);
+  }
+  return stream;
+}
+
+// Creates a VP9 stream with three spatial and three temporal layers, where
+// every spatial layer frame is predicted from the one below it.
+Stream CreateVp9Stream(const RtpHeaderExtensionMap& extensions,
+                       uint32_t ssrc) {
+  Stream stream;
+  stream.codec = kVideoCodecVP9;
+  RtpPacketizer::PayloadSizeLimits limits;
+  uint16_t sequence_number = 0;
+  for (int picture = 0; picture < kNumPictures; ++picture) {
+    const int temporal_idx = TemporalIdx(picture);
+    for (int spatial_idx = 0; spatial_idx < kNumSpatialLayers; ++spatial_idx) {
+      std::vector<uint8_t> payload(kVp9FrameSize[spatial_idx], 0x55);
+
+      RTPVideoHeaderVP9 vp9;
+      vp9.InitRTPVideoHeaderVP9();
+      vp9.picture_id = (1000 + picture) & 0x7FFF;
+      vp9.tl0_pic_idx = (picture / 4) & 0xFF;
+      vp9.temporal_idx = temporal_idx;
+      vp9.spatial_idx = spatial_idx;
+      vp9.inter_pic_predicted = picture > 0;
+      vp9.inter_layer_predicted = spatial_idx > 0;
+      vp9.gof_idx = picture % 4;
+      vp9.num_spatial_layers = kNumSpatialLayers;
+      vp9.end_of_picture = spatial_idx == kNumSpatialLayers - 1;
+      vp9.gof.SetGofInfoVP9(kTemporalStructureMode3);
+      if (picture == 0 && spatial_idx == 0) {
+        vp9.ss_data_available = true;
+        vp9.spatial_layer_resolution_present = true;
+        for (int i = 0; i < kNumSpatialLayers; ++i) {
+          vp9.width[i] = 320 << i;
+          vp9.height[i] = 180 << i;
+        }
+      }
+      RtpPacketizerVp9 packetizer(payload, limits, vp9);
+
+      RtpGenericFrameDescriptor descriptor;
+      descriptor.SetFirstPacketInSubFrame(true);
+      descriptor.SetFirstSubFrameInFrame(spatial_idx == 0);
+      descriptor.SetLastSubFrameInFrame(spatial_idx == kNumSpatialLayers - 1);
+      descriptor.SetTemporalLayer(temporal_idx);
+      // The layer frame is used by its own and all higher spatial layers.
+      descriptor.SetSpatialLayersBitmask(static_cast<uint8_t>(
+          ((1 << kNumSpatialLayers) - 1) & ~((1 << spatial_idx) - 1)));
+      descriptor.SetFrameId(
+          static_cast<uint16_t>(picture * kNumSpatialLayers + spatial_idx));
+      if (picture > 0) {
+        descriptor.AddFrameDependencyDiff(ReferenceDistance(picture) *
+                                          kNumSpatialLayers);
+      }
+      if (spatial_idx > 0)
+        descriptor.AddFrameDependencyDiff(1);
+
+      AppendLayerFrame(extensions, &packetizer, ssrc, 3000 * picture,
+                       &sequence_number, descriptor, &stream);
+    }
+  }
+  return stream;
+}
+
+// Writes |picture_id| to the 15 bit picture ID of the VP8 or VP9 payload
+// descriptor at the start of |payload|.
+void SetPictureId(VideoCodecType codec, uint8_t* payload, uint16_t picture_id) {
+  uint8_t* field;
+  if (codec == kVideoCodecVP8) {
+    // X bit in the first byte, then I bit in the extension byte.
+    RTC_DCHECK(payload[0] & 0x80);
+    RTC_DCHECK(payload[1] & 0x80);
+    field = payload + 2;
+  } else {
+    // I bit in the first byte.
+    RTC_DCHECK(payload[0] & 0x80);
+    field = payload + 1;
+  }
+  RTC_DCHECK(field[0] & 0x80);  // M bit, i.e. a 15 bit picture ID.
+  ByteWriter<uint16_t>::WriteBigEndian(field, 0x8000 | picture_id);
+}
+
+// Forwards the spatial and temporal layers of one stream up to the selected
+// ones. Unlike test::LayerFilteringTransport, dropped packets are not sent
+// as padding, so sequence numbers are rewritten to be continuous. When the
+// layer information comes from the payload descriptor, picture IDs are also
+// rewritten to be continuous over dropped pictures, since a receiver takes a
+// gap in them for a lost picture. With the generic frame descriptor the
+// dependencies are explicit, and gaps in frame IDs are fine.
+class LayerForwarder {
+ public:
+  LayerForwarder(VideoCodecType codec,
+                 LayerInfoSource source,
+                 const RtpHeaderExtensionMap* extensions,
+                 int selected_sl,
+                 int selected_tl)
+      : codec_(codec),
+        source_(source),
+        selected_sl_(selected_sl),
+        selected_tl_(selected_tl),
+        depacketizer_(codec == kVideoCodecVP8
+                          ? static_cast<RtpDepacketizer*>(
+                                new RtpDepacketizerVp8())
+                          : new RtpDepacketizerVp9()),
+        packet_(extensions) {}
+
+  // Returns the forwarded packet, or null if |incoming| is dropped. The
+  // returned packet is valid until the next call.
+  const RtpPacketReceived* Forward(const rtc::CopyOnWriteBuffer& incoming) {
+    // The outgoing packet is a copy, in which the headers are rewritten.
+    if (!packet_.Parse(incoming.cdata(), incoming.size()))
+      return nullptr;
+    bool forward;
+    bool set_marker;
+    if (source_ == LayerInfoSource::kPayloadDescriptor) {
+      forward = ParsePayloadDescriptor(&set_marker);
+    } else {
+      forward = ParseGenericFrameDescriptor(&set_marker);
+    }
+    if (!forward)
+      return nullptr;
+
+    packet_.SetSequenceNumber(next_sequence_number_++);
+    if (set_marker)
+      packet_.SetMarker(true);
+    return &packet_;
+  }
+
+ private:
+  bool ParsePayloadDescriptor(bool* set_marker) {
+    RtpDepacketizer::ParsedPayload parsed;
+    rtc::ArrayView<const uint8_t> payload = packet_.payload();
+    if (!depacketizer_->Parse(&parsed, payload.data(), payload.size()))
+      return false;
+
+    int temporal_idx;
+    int spatial_idx;
+    int picture_id;
+    bool non_ref_for_inter_layer_pred;
+    bool end_of_frame;
+    if (codec_ == kVideoCodecVP8) {
+      const auto& vp8 =
+          absl::get<RTPVideoHeaderVP8>(parsed.video_header().video_type_header);
+      temporal_idx = vp8.temporalIdx;
+      spatial_idx = 0;
+      picture_id = vp8.pictureId;
+      non_ref_for_inter_layer_pred = false;
+      end_of_frame = false;
+    } else {
+      const auto& vp9 =
+          absl::get<RTPVideoHeaderVP9>(parsed.video_header().video_type_header);
+      temporal_idx = vp9.temporal_idx;
+      spatial_idx = vp9.spatial_idx;
+      picture_id = vp9.picture_id;
+      non_ref_for_inter_layer_pred = vp9.non_ref_for_inter_layer_pred;
+      end_of_frame = vp9.end_of_frame;
+    }
+
+    if (temporal_idx != kNoTemporalIdx && temporal_idx > selected_tl_) {
+      // The whole picture is dropped.
+      if (picture_id != last_dropped_picture_id_) {
+        last_dropped_picture_id_ = picture_id;
+        ++dropped_pictures_;
+      }
+      return false;
+    }
+    if (spatial_idx > selected_sl_ ||
+        (spatial_idx < selected_sl_ && non_ref_for_inter_layer_pred)) {
+      return false;
+    }
+
+    *set_marker = spatial_idx == selected_sl_ && end_of_frame;
+    if (dropped_pictures_ > 0) {
+      SetPictureId(codec_, packet_.SetPayloadSize(packet_.payload_size()),
+                   (picture_id - dropped_pictures_) & 0x7FFF);
+    }
+    return true;
+  }
+
+  bool ParseGenericFrameDescriptor(bool* set_marker) {
+    RtpGenericFrameDescriptor descriptor;
+    if (!packet_.GetExtension<RtpGenericFrameDescriptorExtension>(&descriptor))
+      return false;
+    // The layers are only given in the first packet of each layer frame.
+    if (descriptor.FirstPacketInSubFrame()) {
+      forward_subframe_ =
+          descriptor.TemporalLayer() <= selected_tl_ &&
+          (descriptor.SpatialLayersBitmask() & (1 << selected_sl_)) != 0;
+      last_subframe_in_selection_ =
+          descriptor.SpatialLayer() == selected_sl_;
+    }
+    *set_marker =
+        last_subframe_in_selection_ && descriptor.LastPacketInSubFrame();
+    return forward_subframe_;
+  }
+
+  const VideoCodecType codec_;
+  const LayerInfoSource source_;
+  const int selected_sl_;
+  const int selected_tl_;
+  const std::unique_ptr<RtpDepacketizer> depacketizer_;
+  RtpPacketReceived packet_;
+  uint16_t next_sequence_number_ = 0;
+  int last_dropped_picture_id_ = -1;
+  int dropped_pictures_ = 0;
+  bool forward_subframe_ = false;
+  bool last_subframe_in_selection_ = false;
+};
+
+struct ForwardingResult {
+  double ns_per_packet = 0;
+  double streams_per_core = 0;
+  int64_t forwarded_packets = 0;
+};
+
+// Forwards the packets of all |streams|, interleaved, |iterations| times.
+ForwardingResult MeasureForwarding(const std::vector<Stream>& streams,
+                                   const RtpHeaderExtensionMap& extensions,
+                                   LayerInfoSource source,
+                                   int selected_sl,
+                                   int selected_tl,
+                                   int iterations) {
+  std::vector<std::unique_ptr<LayerForwarder>> forwarders;
+  size_t max_packets = 0;
+  size_t total_packets = 0;
+  for (const Stream& stream : streams) {
+    forwarders.emplace_back(new LayerForwarder(stream.codec, source,
+                                               &extensions, selected_sl,
+                                               selected_tl));
+    max_packets = std::max(max_packets, stream.packets.size());
+    total_packets += stream.packets.size();
+  }
+
+  ForwardingResult result;
+  size_t forwarded_bytes = 0;
+  int64_t start_ns = rtc::TimeNanos();
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    for (size_t i = 0; i < max_packets; ++i) {
+      for (size_t s = 0; s < streams.size(); ++s) {
+        if (i >= streams[s].packets.size())
+          continue;
+        const RtpPacketReceived* packet =
+            forwarders[s]->Forward(streams[s].packets[i]);
+        if (packet) {
+          ++result.forwarded_packets;
+          forwarded_bytes += packet->size();
+        }
+      }
+    }
+  }
+  int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  EXPECT_GT(forwarded_bytes, 0u);
+
+  const double packets = static_cast<double>(total_packets) * iterations;
+  result.ns_per_packet = elapsed_ns / packets;
+  // Each stream carries |kNumPictures| pictures at |kFramerate|.
+  const double packets_per_stream_per_second =
+      static_cast<double>(total_packets) / streams.size() * kFramerate /
+      kNumPictures;
+  result.streams_per_core =
+      1e9 / (result.ns_per_packet * packets_per_stream_per_second);
+  return result;
+}
+
+int Iterations() {
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? 1 : 20;
+}
+
+void RunForwardingTest(VideoCodecType codec,
+                       const std::string& name,
+                       int selected_sl,
+                       int selected_tl) {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<RtpGenericFrameDescriptorExtension>(
+      kGenericDescriptorExtensionId);
+  std::vector<Stream> streams;
+  for (int i = 0; i < kNumStreams; ++i) {
+    const uint32_t ssrc = 1000 + i;
+    streams.push_back(codec == kVideoCodecVP8
+                          ? CreateVp8Stream(extensions, ssrc)
+                          : CreateVp9Stream(extensions, ssrc));
+  }
+
+  ForwardingResult payload_descriptor = MeasureForwarding(
+      streams, extensions, LayerInfoSource::kPayloadDescriptor, selected_sl,
+      selected_tl, Iterations());
+  ForwardingResult generic_descriptor = MeasureForwarding(
+      streams, extensions, LayerInfoSource::kGenericFrameDescriptor,
+      selected_sl, selected_tl, Iterations());
+  // Both ways of reading the layers must forward the same packets.
+  EXPECT_EQ(payload_descriptor.forwarded_packets,
+            generic_descriptor.forwarded_packets);
+
+  test::PrintResult("sfu_layer_forwarding", "_payload_descriptor", name,
+                    payload_descriptor.ns_per_packet, "ns/packet", false);
+  test::PrintResult("sfu_layer_forwarding", "_generic_descriptor", name,
+                    generic_descriptor.ns_per_packet, "ns/packet", false);
+  test::PrintResult("sfu_streams_per_core", "_payload_descriptor", name,
+                    payload_descriptor.streams_per_core, "streams", false);
+  test::PrintResult("sfu_streams_per_core", "_generic_descriptor", name,
+                    generic_descriptor.streams_per_core, "streams", false);
+}
+
+}  // namespace
+
+// Forwards the two lowest of three temporal layers.
+TEST(LayerForwardingPerformanceTest, Vp8TemporalLayers) {
+  RunForwardingTest(kVideoCodecVP8, "vp8_l1t3_to_l1t2", 0, 1);
+}
+
+// Forwards the two lowest of three spatial layers, and the two lowest of
+// three temporal layers.
+TEST(LayerForwardingPerformanceTest, Vp9SvcLayers) {
+  RunForwardingTest(kVideoCodecVP9, "vp9_l3t3_to_l2t2", 1, 1);
+}
+
+}  // namespace webrtc
@@ -367,6 +367,11 @@ ReceiveStatisticsImpl::~ReceiveStatisticsImpl() {
 }
 
 void ReceiveStatisticsImpl::OnRtpPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUNS_SERIALIZED(&packet_race_checker_);
+  if (last_packet_statistician_ && last_packet_ssrc_ == packet.Ssrc()) {
+    last_packet_statistician_->OnRtpPacket(packet);
+    return;
+  }
   StreamStatisticianImpl* impl;
   {
     rtc::CritScope cs(&receive_statistics_lock_);
@@ -384,6 +389,8 @@ void ReceiveStatisticsImpl::OnRtpPacket(const RtpPacketReceived& packet) {
   // this whole ReceiveStatisticsImpl is destroyed. StreamStatisticianImpl has
   // it's own locking so don't hold receive_statistics_lock_ (potential
   // deadlock).
+  last_packet_statistician_ = impl;
+  last_packet_ssrc_ = packet.Ssrc();
   impl->OnRtpPacket(packet);
 }
 
@@ -20,6 +20,7 @@
 #include "absl/types/optional.h"
 #include "modules/include/module_common_types_public.h"
 #include "rtc_base/criticalsection.h"
+#include "rtc_base/race_checker.h"
 #include "rtc_base/rate_statistics.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -136,6 +137,13 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
   int max_reordering_threshold_ RTC_GUARDED_BY(receive_statistics_lock_);
   std::map<uint32_t, StreamStatisticianImpl*> statisticians_
       RTC_GUARDED_BY(receive_statistics_lock_);
+  // The statistician of the previous packet passed to OnRtpPacket. Packets of
+  // a stream mostly come in a row, so it saves looking up |statisticians_|
+  // under |receive_statistics_lock_| for every packet.
+  rtc::RaceChecker packet_race_checker_;
+  StreamStatisticianImpl* last_packet_statistician_
+      RTC_GUARDED_BY(packet_race_checker_) = nullptr;
+  uint32_t last_packet_ssrc_ RTC_GUARDED_BY(packet_race_checker_) = 0;
 
   RtcpStatisticsCallback* const rtcp_stats_callback_;
   StreamDataCountersCallback* const rtp_stats_callback_;
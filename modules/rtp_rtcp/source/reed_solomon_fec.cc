@@ -0,0 +1,252 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+// Arithmetic in GF(2^8) with the primitive polynomial x^8+x^4+x^3+x^2+1.
+constexpr int kPrimitivePolynomial = 0x11d;
+
+class GaloisField {
+ public:
+  GaloisField() {
+    int x = 1;
+    for (int i = 0; i < 255; ++i) {
+      exp_[i] = exp_[i + 255] = static_cast<uint8_t>(x);
+      log_[x] = static_cast<uint8_t>(i);
+      x <<= 1;
+      if (x & 0x100)
+        x ^= kPrimitivePolynomial;
+    }
+    log_[0] = 0;
+    for (int a = 0; a < 256; ++a) {
+      for (int b = 0; b < 256; ++b) {
+        mul_[a][b] = (a == 0 || b == 0) ? 0 : exp_[log_[a] + log_[b]];
+      }
+    }
+  }
+
+  uint8_t Multiply(uint8_t a, uint8_t b) const { return mul_[a][b]; }
+  uint8_t Inverse(uint8_t a) const {
+    RTC_DCHECK_NE(a, 0);
+    return exp_[255 - log_[a]];
+  }
+
+  // Adds |coefficient| times the |size| bytes at |src| to |dst|.
+  void MultiplyAdd(uint8_t coefficient,
+                   const uint8_t* src,
+                   size_t size,
+                   uint8_t* dst) const {
+    if (coefficient == 0)
+      return;
+    // One table row holds the products of |coefficient| with every byte value,
+    // so each byte costs a single lookup.
+    const uint8_t* row = mul_[coefficient];
+    for (size_t i = 0; i < size; ++i) {
+      dst[i] ^= row[src[i]];
+    }
+  }
+
+ private:
+  uint8_t exp_[510];
+  uint8_t log_[256];
+  uint8_t mul_[256][256];
+};
+
+const GaloisField& Field() {
+  static const GaloisField* const field = new GaloisField();
+  return *field;
+}
+
+// Copies |packet| to |dst| prefixed by its length, zero padded to |size|.
+void WriteProtectedPacket(rtc::ArrayView<const uint8_t> packet,
+                          size_t size,
+                          std::vector<uint8_t>* dst) {
+  dst->assign(size, 0);
+  ByteWriter<uint16_t>::WriteBigEndian(dst->data(), packet.size());
+  memcpy(dst->data() + ReedSolomonFec::kLengthFieldSize, packet.data(),
+         packet.size());
+}
+
+}  // namespace
+
+constexpr size_t ReedSolomonFec::kMaxCodeLength;
+constexpr size_t ReedSolomonFec::kLengthFieldSize;
+
+ReedSolomonFec::ReedSolomonFec(size_t num_media_packets,
+                               size_t num_fec_packets)
+    : num_media_packets_(num_media_packets), num_fec_packets_(num_fec_packets) {
+  RTC_DCHECK_GT(num_media_packets_, 0);
+  RTC_DCHECK_LE(num_media_packets_ + num_fec_packets_, kMaxCodeLength);
+}
+
+ReedSolomonFec::~ReedSolomonFec() = default;
+
+uint8_t ReedSolomonFec::Coefficient(size_t fec_index,
+                                    size_t media_index) const {
+  // Cauchy matrix 1 / (x_i + y_j), with x_i = i and y_j = num_fec + j all
+  // distinct. Every square submatrix of it is invertible.
+  return Field().Inverse(
+      static_cast<uint8_t>(fec_index ^ (num_fec_packets_ + media_index)));
+}
+
+std::vector<std::vector<uint8_t>> ReedSolomonFec::Encode(
+    const std::vector<rtc::ArrayView<const uint8_t>>& media_packets) const {
+  RTC_DCHECK_EQ(media_packets.size(), num_media_packets_);
+  size_t max_length = 0;
+  for (const auto& packet : media_packets) {
+    RTC_DCHECK(!packet.empty());
+    RTC_DCHECK_LE(packet.size(), 0xffff);
+    max_length = std::max(max_length, packet.size());
+  }
+  const size_t fec_length = kLengthFieldSize + max_length;
+
+  const GaloisField& field = Field();
+  std::vector<std::vector<uint8_t>> fec_packets(
+      num_fec_packets_, std::vector<uint8_t>(fec_length, 0));
+  std::vector<uint8_t> protected_packet;
+  for (size_t j = 0; j < num_media_packets_; ++j) {
+    // Only the length field and the packet itself are non-zero.
+    const size_t size = kLengthFieldSize + media_packets[j].size();
+    WriteProtectedPacket(media_packets[j], size, &protected_packet);
+    for (size_t i = 0; i < num_fec_packets_; ++i) {
+      field.MultiplyAdd(Coefficient(i, j), protected_packet.data(), size,
+                        fec_packets[i].data());
+    }
+  }
+  return fec_packets;
+}
+
+bool ReedSolomonFec::Decode(
+    std::vector<std::vector<uint8_t>>* media_packets,
+    const std::vector<bool>& media_received,
+    const std::vector<std::vector<uint8_t>>& fec_packets,
+    const std::vector<bool>& fec_received) const {
+  RTC_DCHECK(media_packets);
+  RTC_DCHECK_EQ(media_packets->size(), num_media_packets_);
+  RTC_DCHECK_EQ(media_received.size(), num_media_packets_);
+  RTC_DCHECK_EQ(fec_packets.size(), num_fec_packets_);
+  RTC_DCHECK_EQ(fec_received.size(), num_fec_packets_);
+
+  std::vector<size_t> missing;
+  for (size_t j = 0; j < num_media_packets_; ++j) {
+    if (!media_received[j])
+      missing.push_back(j);
+  }
+  if (missing.empty())
+    return true;
+  std::vector<size_t> rows;
+  for (size_t i = 0; i < num_fec_packets_ && rows.size() < missing.size();
+       ++i) {
+    if (fec_received[i])
+      rows.push_back(i);
+  }
+  if (rows.size() < missing.size())
+    return false;
+
+  const size_t num_missing = missing.size();
+  const size_t fec_length = fec_packets[rows[0]].size();
+  const GaloisField& field = Field();
+
+  // Remove the contribution of the received media packets from the FEC
+  // packets, leaving the missing packets multiplied by |matrix|.
+  std::vector<std::vector<uint8_t>> syndromes;
+  for (size_t row : rows) {
+    if (fec_packets[row].size() != fec_length) {
+      RTC_LOG(LS_WARNING) << "FEC packets of different lengths.";
+      return false;
+    }
+    syndromes.push_back(fec_packets[row]);
+  }
+  std::vector<uint8_t> protected_packet;
+  for (size_t j = 0; j < num_media_packets_; ++j) {
+    if (!media_received[j])
+      continue;
+    const std::vector<uint8_t>& packet = (*media_packets)[j];
+    const size_t size = kLengthFieldSize + packet.size();
+    if (size > fec_length) {
+      RTC_LOG(LS_WARNING) << "Media packet longer than the FEC packets.";
+      return false;
+    }
+    WriteProtectedPacket(packet, size, &protected_packet);
+    for (size_t a = 0; a < num_missing; ++a) {
+      field.MultiplyAdd(Coefficient(rows[a], j), protected_packet.data(), size,
+                        syndromes[a].data());
+    }
+  }
+
+  // Invert the square Cauchy submatrix with Gauss-Jordan elimination.
+  std::vector<std::vector<uint8_t>> matrix(num_missing,
+                                           std::vector<uint8_t>(num_missing));
+  std::vector<std::vector<uint8_t>> inverse(
+      num_missing, std::vector<uint8_t>(num_missing, 0));
+  for (size_t a = 0; a < num_missing; ++a) {
+    for (size_t b = 0; b < num_missing; ++b)
+      matrix[a][b] = Coefficient(rows[a], missing[b]);
+    inverse[a][a] = 1;
+  }
+  for (size_t col = 0; col < num_missing; ++col) {
+    size_t pivot = col;
+    while (matrix[pivot][col] == 0)
+      ++pivot;
+    RTC_DCHECK_LT(pivot, num_missing);
+    std::swap(matrix[pivot], matrix[col]);
+    std::swap(inverse[pivot], inverse[col]);
+    const uint8_t scale = field.Inverse(matrix[col][col]);
+    for (size_t b = 0; b < num_missing; ++b) {
+      matrix[col][b] = field.Multiply(scale, matrix[col][b]);
+      inverse[col][b] = field.Multiply(scale, inverse[col][b]);
+    }
+    for (size_t a = 0; a < num_missing; ++a) {
+      const uint8_t factor = matrix[a][col];
+      if (a == col || factor == 0)
+        continue;
+      field.MultiplyAdd(factor, matrix[col].data(), num_missing,
+                        matrix[a].data());
+      field.MultiplyAdd(factor, inverse[col].data(), num_missing,
+                        inverse[a].data());
+    }
+  }
+
+  std::vector<std::vector<uint8_t>> recovered(
+      num_missing, std::vector<uint8_t>(fec_length, 0));
+  for (size_t b = 0; b < num_missing; ++b) {
+    for (size_t a = 0; a < num_missing; ++a) {
+      field.MultiplyAdd(inverse[b][a], syndromes[a].data(), fec_length,
+                        recovered[b].data());
+    }
+    const size_t length =
+        ByteReader<uint16_t>::ReadBigEndian(recovered[b].data());
+    if (length == 0 || kLengthFieldSize + length > fec_length) {
+      RTC_LOG(LS_WARNING) << "Recovered media packet has invalid length.";
+      return false;
+    }
+  }
+  for (size_t b = 0; b < num_missing; ++b) {
+    const uint8_t* data = recovered[b].data();
+    const size_t length = ByteReader<uint16_t>::ReadBigEndian(data);
+    (*media_packets)[missing[b]].assign(data + kLengthFieldSize,
+                                        data + kLengthFieldSize + length);
+  }
+  return true;
+}
+
+}  // namespace webrtc
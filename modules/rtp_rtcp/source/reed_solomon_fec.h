@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Systematic Reed-Solomon erasure code over GF(2^8), using a Cauchy matrix to
+// generate the FEC packets. Unlike the XOR-based codes in
+// ForwardErrorCorrection, the code is MDS: all the media packets can be
+// recovered from any |num_media_packets| of the media and FEC packets,
+// regardless of which packets were lost.
+//
+// The FEC packets also protect the media packet lengths, so each FEC packet is
+// kLengthFieldSize bytes longer than the longest media packet it protects.
+class ReedSolomonFec {
+ public:
+  // The code is defined for at most this many media and FEC packets in total.
+  static constexpr size_t kMaxCodeLength = 256;
+  static constexpr size_t kLengthFieldSize = 2;
+
+  ReedSolomonFec(size_t num_media_packets, size_t num_fec_packets);
+  ~ReedSolomonFec();
+
+  size_t num_media_packets() const { return num_media_packets_; }
+  size_t num_fec_packets() const { return num_fec_packets_; }
+
+  // Generates |num_fec_packets| FEC packets protecting |media_packets|, which
+  // must hold |num_media_packets| non-empty packets.
+  std::vector<std::vector<uint8_t>> Encode(
+      const std::vector<rtc::ArrayView<const uint8_t>>& media_packets) const;
+
+  // Recovers the media packets that were not received. |media_packets| and
+  // |media_received| have |num_media_packets| entries, and the entries of
+  // packets that were not received are overwritten when recovered.
+  // |fec_packets| and |fec_received| likewise have |num_fec_packets| entries.
+  // Returns false, leaving |media_packets| unchanged, if fewer FEC packets
+  // than lost media packets were received.
+  bool Decode(std::vector<std::vector<uint8_t>>* media_packets,
+              const std::vector<bool>& media_received,
+              const std::vector<std::vector<uint8_t>>& fec_packets,
+              const std::vector<bool>& fec_received) const;
+
+ private:
+  // The coefficient of media packet |media_index| in FEC packet |fec_index|.
+  uint8_t Coefficient(size_t fec_index, size_t media_index) const;
+
+  const size_t num_media_packets_;
+  const size_t num_fec_packets_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_H_
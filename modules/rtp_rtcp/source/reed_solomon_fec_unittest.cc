@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec.h"
+
+#include <vector>
+
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint32_t kMinPacketLength = 12;
+constexpr uint32_t kMaxPacketLength = 1200;
+
+std::vector<std::vector<uint8_t>> CreateMediaPackets(size_t num_packets,
+                                                     Random* random) {
+  std::vector<std::vector<uint8_t>> packets(num_packets);
+  for (auto& packet : packets) {
+    packet.resize(random->Rand(kMinPacketLength, kMaxPacketLength));
+    for (uint8_t& byte : packet)
+      byte = random->Rand<uint8_t>();
+  }
+  return packets;
+}
+
+std::vector<rtc::ArrayView<const uint8_t>> ToArrayViews(
+    const std::vector<std::vector<uint8_t>>& packets) {
+  return std::vector<rtc::ArrayView<const uint8_t>>(packets.begin(),
+                                                    packets.end());
+}
+
+// Loses the packets whose bits are set in |loss_pattern|, media packets
+// first, and returns whether ReedSolomonFec recovered all of them.
+bool RecoversLossPattern(const ReedSolomonFec& fec,
+                         const std::vector<std::vector<uint8_t>>& media,
+                         const std::vector<std::vector<uint8_t>>& fec_packets,
+                         uint32_t loss_pattern) {
+  const size_t num_media = fec.num_media_packets();
+  std::vector<std::vector<uint8_t>> received_media = media;
+  std::vector<bool> media_received(num_media);
+  std::vector<bool> fec_received(fec.num_fec_packets());
+  for (size_t i = 0; i < num_media + fec.num_fec_packets(); ++i) {
+    const bool received = (loss_pattern & (1u << i)) == 0;
+    if (i < num_media) {
+      media_received[i] = received;
+      if (!received)
+        received_media[i].clear();
+    } else {
+      fec_received[i - num_media] = received;
+    }
+  }
+  return fec.Decode(&received_media, media_received, fec_packets,
+                    fec_received) &&
+         received_media == media;
+}
+
+// Returns whether XOR FEC with the |packet_masks| recovers all media packets
+// from the loss in |loss_pattern|, decoding iteratively like
+// ForwardErrorCorrection does.
+bool XorRecoversLossPattern(const uint8_t* packet_masks,
+                            size_t num_media,
+                            size_t num_fec,
+                            uint32_t loss_pattern) {
+  const size_t mask_size = internal::PacketMaskSize(num_media);
+  std::vector<bool> media_lost(num_media);
+  for (size_t j = 0; j < num_media; ++j)
+    media_lost[j] = (loss_pattern & (1u << j)) != 0;
+  bool recovered_any = true;
+  while (recovered_any) {
+    recovered_any = false;
+    for (size_t i = 0; i < num_fec; ++i) {
+      if (loss_pattern & (1u << (num_media + i)))
+        continue;
+      int num_lost = 0;
+      size_t lost_index = 0;
+      for (size_t j = 0; j < num_media; ++j) {
+        const bool protected_by_fec =
+            packet_masks[i * mask_size + j / 8] & (0x80 >> (j % 8));
+        if (protected_by_fec && media_lost[j]) {
+          ++num_lost;
+          lost_index = j;
+        }
+      }
+      if (num_lost == 1) {
+        media_lost[lost_index] = false;
+        recovered_any = true;
+      }
+    }
+  }
+  for (bool lost : media_lost) {
+    if (lost)
+      return false;
+  }
+  return true;
+}
+
+int CountBits(uint32_t value) {
+  int count = 0;
+  for (; value; value &= value - 1)
+    ++count;
+  return count;
+}
+
+}  // namespace
+
+TEST(ReedSolomonFecTest, NoLoss) {
+  Random random(0x123456789);
+  ReedSolomonFec fec(5, 2);
+  auto media = CreateMediaPackets(5, &random);
+  auto fec_packets = fec.Encode(ToArrayViews(media));
+  ASSERT_EQ(2u, fec_packets.size());
+  EXPECT_TRUE(RecoversLossPattern(fec, media, fec_packets, 0));
+}
+
+TEST(ReedSolomonFecTest, RecoversAnyLossOfUpToNumFecPackets) {
+  constexpr size_t kNumMedia = 8;
+  constexpr size_t kNumFec = 3;
+  Random random(0x123456789);
+  ReedSolomonFec fec(kNumMedia, kNumFec);
+  auto media = CreateMediaPackets(kNumMedia, &random);
+  auto fec_packets = fec.Encode(ToArrayViews(media));
+
+  for (uint32_t loss = 0; loss < (1u << (kNumMedia + kNumFec)); ++loss) {
+    if (CountBits(loss) <= static_cast<int>(kNumFec)) {
+      EXPECT_TRUE(RecoversLossPattern(fec, media, fec_packets, loss))
+          << "Loss pattern " << loss;
+    }
+  }
+}
+
+TEST(ReedSolomonFecTest, FailsWhenTooManyPacketsAreLost) {
+  Random random(0x123456789);
+  ReedSolomonFec fec(4, 2);
+  auto media = CreateMediaPackets(4, &random);
+  auto fec_packets = fec.Encode(ToArrayViews(media));
+
+  std::vector<std::vector<uint8_t>> received_media = media;
+  received_media[0].clear();
+  received_media[1].clear();
+  received_media[2].clear();
+  EXPECT_FALSE(fec.Decode(&received_media, {false, false, false, true},
+                          fec_packets, {true, true}));
+  EXPECT_TRUE(received_media[0].empty());
+}
+
+// Compares the loss patterns the MDS code recovers to those recovered by XOR
+// FEC using the bursty mask tables, at the same overhead.
+TEST(ReedSolomonFecTest, RecoversMoreLossPatternsThanBurstyXorMasks) {
+  constexpr size_t kNumMedia = 12;
+  constexpr size_t kNumFec = 4;
+  Random random(0x123456789);
+  ReedSolomonFec fec(kNumMedia, kNumFec);
+  auto media = CreateMediaPackets(kNumMedia, &random);
+  auto fec_packets = fec.Encode(ToArrayViews(media));
+
+  uint8_t packet_masks[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize] = {};
+  internal::PacketMaskTable mask_table(kFecMaskBursty, kNumMedia);
+  internal::GeneratePacketMasks(kNumMedia, kNumFec, 0, false, &mask_table,
+                                packet_masks);
+
+  int num_patterns = 0;
+  int num_recovered_rs = 0;
+  int num_recovered_xor = 0;
+  for (uint32_t loss = 0; loss < (1u << (kNumMedia + kNumFec)); ++loss) {
+    if (CountBits(loss) > static_cast<int>(kNumFec))
+      continue;
+    ++num_patterns;
+    if (RecoversLossPattern(fec, media, fec_packets, loss))
+      ++num_recovered_rs;
+    if (XorRecoversLossPattern(packet_masks, kNumMedia, kNumFec, loss))
+      ++num_recovered_xor;
+  }
+  EXPECT_EQ(num_patterns, num_recovered_rs);
+  EXPECT_LT(num_recovered_xor, num_recovered_rs);
+}
+
+}  // namespace webrtc
@@ -165,8 +165,11 @@ void RTCPReceiver::IncomingPacket(const uint8_t* packet, size_t packet_size) {
   }
 
   PacketInformation packet_information;
-  if (!ParseCompoundPacket(packet, packet + packet_size, &packet_information))
+  if (!ParseFeedbackOnlyPacket(packet, packet + packet_size,
+                               &packet_information) &&
+      !ParseCompoundPacket(packet, packet + packet_size, &packet_information)) {
     return;
+  }
   TriggerCallbacksFromRtcpPacket(packet_information);
 }
 
@@ -361,7 +364,8 @@ bool RTCPReceiver::ParseCompoundPacket(const uint8_t* packet_begin,
             HandleSrReq(rtcp_block, packet_information);
             break;
           case rtcp::TransportFeedback::kFeedbackMessageType:
-            HandleTransportFeedback(rtcp_block, packet_information);
+            if (!HandleTransportFeedback(rtcp_block, packet_information))
+              ++num_skipped_packets_;
             break;
           default:
             ++num_skipped_packets_;
@@ -377,7 +381,8 @@ bool RTCPReceiver::ParseCompoundPacket(const uint8_t* packet_begin,
             HandleFir(rtcp_block, packet_information);
             break;
           case rtcp::Remb::kFeedbackMessageType:
-            HandlePsfbApp(rtcp_block, packet_information);
+            if (!HandlePsfbApp(rtcp_block, packet_information))
+              ++num_skipped_packets_;
             break;
           default:
             ++num_skipped_packets_;
@@ -409,6 +414,49 @@ bool RTCPReceiver::ParseCompoundPacket(const uint8_t* packet_begin,
   return true;
 }
 
+bool RTCPReceiver::ParseFeedbackOnlyPacket(
+    const uint8_t* packet_begin,
+    const uint8_t* packet_end,
+    PacketInformation* packet_information) {
+  // Check the types of all blocks first. Malformed packets are left to
+  // ParseCompoundPacket, which accounts for them.
+  CommonHeader rtcp_block;
+  for (const uint8_t* next_block = packet_begin; next_block != packet_end;
+       next_block = rtcp_block.NextPacket()) {
+    if (!rtcp_block.Parse(next_block, packet_end - next_block))
+      return false;
+    bool is_transport_feedback =
+        rtcp_block.type() == rtcp::Rtpfb::kPacketType &&
+        rtcp_block.fmt() == rtcp::TransportFeedback::kFeedbackMessageType;
+    bool is_remb = rtcp_block.type() == rtcp::Psfb::kPacketType &&
+                   rtcp_block.fmt() == rtcp::Remb::kFeedbackMessageType;
+    if (!is_transport_feedback && !is_remb)
+      return false;
+  }
+
+  size_t num_skipped_packets = 0;
+  for (const uint8_t* next_block = packet_begin; next_block != packet_end;
+       next_block = rtcp_block.NextPacket()) {
+    bool parsed = rtcp_block.Parse(next_block, packet_end - next_block);
+    RTC_DCHECK(parsed);
+    bool handled = rtcp_block.type() == rtcp::Rtpfb::kPacketType
+                       ? HandleTransportFeedback(rtcp_block, packet_information)
+                       : HandlePsfbApp(rtcp_block, packet_information);
+    if (!handled)
+      ++num_skipped_packets;
+  }
+
+  rtc::CritScope lock(&rtcp_receiver_lock_);
+  num_skipped_packets_ += num_skipped_packets;
+  if (packet_type_counter_.first_packet_time_ms == -1)
+    packet_type_counter_.first_packet_time_ms = clock_->TimeInMilliseconds();
+  if (packet_type_counter_observer_) {
+    packet_type_counter_observer_->RtcpPacketTypesCounterUpdated(
+        main_ssrc_, packet_type_counter_);
+  }
+  return true;
+}
+
 void RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
                                       PacketInformation* packet_information) {
   rtcp::SenderReport sender_report;
@@ -867,16 +915,15 @@ void RTCPReceiver::HandleSrReq(const CommonHeader& rtcp_block,
   packet_information->packet_type_flags |= kRtcpSrReq;
 }
 
-void RTCPReceiver::HandlePsfbApp(const CommonHeader& rtcp_block,
+bool RTCPReceiver::HandlePsfbApp(const CommonHeader& rtcp_block,
                                  PacketInformation* packet_information) {
   rtcp::Remb remb;
-  if (remb.Parse(rtcp_block)) {
-    packet_information->packet_type_flags |= kRtcpRemb;
-    packet_information->receiver_estimated_max_bitrate_bps = remb.bitrate_bps();
-    return;
-  }
+  if (!remb.Parse(rtcp_block))
+    return false;
 
-  ++num_skipped_packets_;
+  packet_information->packet_type_flags |= kRtcpRemb;
+  packet_information->receiver_estimated_max_bitrate_bps = remb.bitrate_bps();
+  return true;
 }
 
 void RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
@@ -916,18 +963,17 @@ void RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
   }
 }
 
-void RTCPReceiver::HandleTransportFeedback(
+bool RTCPReceiver::HandleTransportFeedback(
     const CommonHeader& rtcp_block,
     PacketInformation* packet_information) {
   std::unique_ptr<rtcp::TransportFeedback> transport_feedback(
       new rtcp::TransportFeedback());
-  if (!transport_feedback->Parse(rtcp_block)) {
-    ++num_skipped_packets_;
-    return;
-  }
+  if (!transport_feedback->Parse(rtcp_block))
+    return false;
 
   packet_information->packet_type_flags |= kRtcpTransportFeedback;
   packet_information->transport_feedback = std::move(transport_feedback);
+  return true;
 }
 
 void RTCPReceiver::NotifyTmmbrUpdated() {
@@ -128,6 +128,13 @@ class RTCPReceiver {
   bool ParseCompoundPacket(const uint8_t* packet_begin,
                            const uint8_t* packet_end,
                            PacketInformation* packet_information);
+  // Transport feedback and REMB don't depend on the state of the receiver, so
+  // packets consisting only of them are parsed without holding
+  // |rtcp_receiver_lock_|. Returns false, without parsing anything, if the
+  // packet has any other blocks.
+  bool ParseFeedbackOnlyPacket(const uint8_t* packet_begin,
+                               const uint8_t* packet_end,
+                               PacketInformation* packet_information);
 
   void TriggerCallbacksFromRtcpPacket(
       const PacketInformation& packet_information);
@@ -184,9 +191,9 @@ class RTCPReceiver {
                  PacketInformation* packet_information)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
 
-  void HandlePsfbApp(const rtcp::CommonHeader& rtcp_block,
-                     PacketInformation* packet_information)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
+  // Returns false if the block is malformed.
+  static bool HandlePsfbApp(const rtcp::CommonHeader& rtcp_block,
+                            PacketInformation* packet_information);
 
   void HandleTmmbr(const rtcp::CommonHeader& rtcp_block,
                    PacketInformation* packet_information)
@@ -204,9 +211,9 @@ class RTCPReceiver {
                  PacketInformation* packet_information)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
 
-  void HandleTransportFeedback(const rtcp::CommonHeader& rtcp_block,
-                               PacketInformation* packet_information)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
+  // Returns false if the block is malformed.
+  static bool HandleTransportFeedback(const rtcp::CommonHeader& rtcp_block,
+                                      PacketInformation* packet_information);
 
   Clock* const clock_;
   const bool receiver_only_;
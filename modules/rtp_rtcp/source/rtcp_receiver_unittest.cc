@@ -1182,6 +1182,28 @@ TEST_F(RtcpReceiverTest, ReceivesTransportFeedback) {
   InjectRtcpPacket(packet);
 }
 
+TEST_F(RtcpReceiverTest, ReceivesTransportFeedbackAfterReceiverReport) {
+  rtcp::ReceiverReport rr;
+  rr.SetSenderSsrc(kSenderSsrc);
+  rtcp::TransportFeedback packet;
+  packet.SetMediaSsrc(kReceiverMainSsrc);
+  packet.SetSenderSsrc(kSenderSsrc);
+  packet.SetBase(1, 1000);
+  packet.AddReceivedPacket(1, 1000);
+  rtcp::CompoundPacket compound;
+  compound.Append(&rr);
+  compound.Append(&packet);
+
+  EXPECT_CALL(rtp_rtcp_impl_, OnReceivedRtcpReportBlocks(IsEmpty()));
+  EXPECT_CALL(bandwidth_observer_,
+              OnReceivedRtcpReceiverReport(IsEmpty(), _, _));
+  EXPECT_CALL(
+      transport_feedback_observer_,
+      OnTransportFeedback(
+          Property(&rtcp::TransportFeedback::media_ssrc, kReceiverMainSsrc)));
+  InjectRtcpPacket(compound);
+}
+
 TEST_F(RtcpReceiverTest, ReceivesRemb) {
   const uint32_t kBitrateBps = 500000;
   rtcp::Remb remb;
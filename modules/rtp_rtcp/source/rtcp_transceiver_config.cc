@@ -58,6 +58,10 @@ bool RtcpTransceiverConfig::Validate() const {
                       << "ms between reports should be positive.";
     return false;
   }
+  if (max_report_blocks == 0) {
+    RTC_LOG(LS_ERROR) << debug_id << "max report blocks should be positive.";
+    return false;
+  }
   if (schedule_periodic_compound_packets && !task_queue) {
     RTC_LOG(LS_ERROR) << debug_id
                       << "missing task queue for periodic compound packets";
@@ -90,6 +90,13 @@ struct RtcpTransceiverConfig {
   // Period between periodic compound packets.
   int report_period_ms = 1000;
 
+  // Maximum number of report blocks in a periodic compound packet. Report
+  // blocks for more remote streams than fit into one receiver report (31) are
+  // put into several receiver reports, which are packed into as few packets
+  // of |max_packet_size| as possible. Remote streams beyond the maximum are
+  // reported in the following compound packets.
+  size_t max_report_blocks = 31;
+
   //
   // Flags for features and experiments.
   //
@@ -10,6 +10,7 @@
 
 #include "modules/rtp_rtcp/source/rtcp_transceiver_impl.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -343,14 +344,28 @@ void RtcpTransceiverImpl::SchedulePeriodicCompoundPackets(int64_t delay_ms) {
     config_.task_queue->PostTask(std::move(task));
 }
 
-void RtcpTransceiverImpl::CreateCompoundPacket(PacketSender* sender) {
+void RtcpTransceiverImpl::CreateCompoundPacket(PacketSender* sender,
+                                               size_t max_report_blocks) {
   RTC_DCHECK(sender->IsEmpty());
   const uint32_t sender_ssrc = config_.feedback_ssrc;
   int64_t now_us = rtc::TimeMicros();
-  rtcp::ReceiverReport receiver_report;
-  receiver_report.SetSenderSsrc(sender_ssrc);
-  receiver_report.SetReportBlocks(CreateReportBlocks(now_us));
-  sender->AppendPacket(receiver_report);
+  std::vector<rtcp::ReportBlock> report_blocks =
+      CreateReportBlocks(now_us, max_report_blocks);
+  // Put the receiver reports first, so that when the compound packet is split
+  // over several packets, each of them but the last starts with a receiver
+  // report.
+  auto first_block = report_blocks.begin();
+  do {
+    size_t num_blocks =
+        std::min<size_t>(report_blocks.end() - first_block,
+                         rtcp::ReceiverReport::kMaxNumberOfReportBlocks);
+    rtcp::ReceiverReport receiver_report;
+    receiver_report.SetSenderSsrc(sender_ssrc);
+    receiver_report.SetReportBlocks(std::vector<rtcp::ReportBlock>(
+        first_block, first_block + num_blocks));
+    sender->AppendPacket(receiver_report);
+    first_block += num_blocks;
+  } while (first_block != report_blocks.end());
 
   if (!config_.cname.empty()) {
     rtcp::Sdes sdes;
@@ -383,7 +398,7 @@ void RtcpTransceiverImpl::SendPeriodicCompoundPacket() {
     config_.outgoing_transport->SendRtcp(packet.data(), packet.size());
   };
   PacketSender sender(send_packet, config_.max_packet_size);
-  CreateCompoundPacket(&sender);
+  CreateCompoundPacket(&sender, config_.max_report_blocks);
   sender.Send();
 }
 
@@ -395,8 +410,13 @@ void RtcpTransceiverImpl::SendImmediateFeedback(
   PacketSender sender(send_packet, config_.max_packet_size);
   // Compound mode requires every sent rtcp packet to be compound, i.e. start
   // with a sender or receiver report.
-  if (config_.rtcp_mode == RtcpMode::kCompound)
-    CreateCompoundPacket(&sender);
+  // Feedback is sent in a single packet, so limit the report blocks to one
+  // receiver report.
+  if (config_.rtcp_mode == RtcpMode::kCompound) {
+    CreateCompoundPacket(
+        &sender, std::min(config_.max_report_blocks,
+                          rtcp::ReceiverReport::kMaxNumberOfReportBlocks));
+  }
 
   sender.AppendPacket(rtcp_packet);
   sender.Send();
@@ -407,14 +427,12 @@ void RtcpTransceiverImpl::SendImmediateFeedback(
 }
 
 std::vector<rtcp::ReportBlock> RtcpTransceiverImpl::CreateReportBlocks(
-    int64_t now_us) {
+    int64_t now_us,
+    size_t max_report_blocks) {
   if (!config_.receive_statistics)
     return {};
-  // TODO(danilchap): Support sending more than
-  // |ReceiverReport::kMaxNumberOfReportBlocks| per compound rtcp packet.
   std::vector<rtcp::ReportBlock> report_blocks =
-      config_.receive_statistics->RtcpReportBlocks(
-          rtcp::ReceiverReport::kMaxNumberOfReportBlocks);
+      config_.receive_statistics->RtcpReportBlocks(max_report_blocks);
   uint32_t last_sr = 0;
   uint32_t last_delay = 0;
   for (rtcp::ReportBlock& report_block : report_blocks) {
@@ -82,12 +82,14 @@ class RtcpTransceiverImpl {
   void SchedulePeriodicCompoundPackets(int64_t delay_ms);
   // Creates compound RTCP packet, as defined in
   // https://tools.ietf.org/html/rfc5506#section-2
-  void CreateCompoundPacket(PacketSender* sender);
+  // with report blocks for up to |max_report_blocks| remote streams.
+  void CreateCompoundPacket(PacketSender* sender, size_t max_report_blocks);
   // Sends RTCP packets.
   void SendPeriodicCompoundPacket();
   void SendImmediateFeedback(const rtcp::RtcpPacket& rtcp_packet);
   // Generate Report Blocks to be send in Sender or Receiver Report.
-  std::vector<rtcp::ReportBlock> CreateReportBlocks(int64_t now_us);
+  std::vector<rtcp::ReportBlock> CreateReportBlocks(int64_t now_us,
+                                                    size_t max_report_blocks);
 
   const RtcpTransceiverConfig config_;
 
@@ -48,6 +48,7 @@ using ::webrtc::SaturatedUsToCompactNtp;
 using ::webrtc::TimeMicrosToNtp;
 using ::webrtc::rtcp::Bye;
 using ::webrtc::rtcp::CompoundPacket;
+using ::webrtc::rtcp::ReceiverReport;
 using ::webrtc::rtcp::ReportBlock;
 using ::webrtc::rtcp::SenderReport;
 using ::webrtc::test::RtcpPacketParser;
@@ -487,6 +488,59 @@ TEST(RtcpTransceiverImplTest, ReceiverReportUsesReceiveStatistics) {
             kMediaSsrc);
 }
 
+TEST(RtcpTransceiverImplTest,
+     SplitsReportBlocksOverSeveralReceiverReportsAndPackets) {
+  const size_t kMaxReportBlocks = 64;
+  const size_t kNumReportBlocks = 60;
+  MockReceiveStatisticsProvider receive_statistics;
+  std::vector<ReportBlock> report_blocks(kNumReportBlocks);
+  for (size_t i = 0; i < kNumReportBlocks; ++i)
+    report_blocks[i].SetMediaSsrc(1000 + i);
+  EXPECT_CALL(receive_statistics, RtcpReportBlocks(kMaxReportBlocks))
+      .WillOnce(Return(report_blocks));
+
+  RtcpTransceiverConfig config;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  config.receive_statistics = &receive_statistics;
+  config.max_report_blocks = kMaxReportBlocks;
+  config.schedule_periodic_compound_packets = false;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  rtcp_transceiver.SendCompoundPacket();
+
+  // 31 report blocks are put into the first receiver report, and the
+  // remaining 29 into a second one that doesn't fit into the same packet.
+  EXPECT_EQ(transport.num_packets(), 2);
+  EXPECT_EQ(rtcp_parser.receiver_report()->num_packets(), 2);
+  ASSERT_THAT(rtcp_parser.receiver_report()->report_blocks(), SizeIs(29));
+  EXPECT_EQ(rtcp_parser.receiver_report()->report_blocks()[28].source_ssrc(),
+            1000u + kNumReportBlocks - 1);
+}
+
+TEST(RtcpTransceiverImplTest, FeedbackReportsAtMostOneReceiverReportOfBlocks) {
+  MockReceiveStatisticsProvider receive_statistics;
+  EXPECT_CALL(receive_statistics,
+              RtcpReportBlocks(ReceiverReport::kMaxNumberOfReportBlocks))
+      .WillOnce(Return(std::vector<ReportBlock>()));
+
+  RtcpTransceiverConfig config;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  config.receive_statistics = &receive_statistics;
+  config.max_report_blocks = 64;
+  config.schedule_periodic_compound_packets = false;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  rtcp_transceiver.SendPictureLossIndication(/*ssrc=*/1234);
+
+  EXPECT_EQ(transport.num_packets(), 1);
+  EXPECT_EQ(rtcp_parser.receiver_report()->num_packets(), 1);
+  EXPECT_EQ(rtcp_parser.pli()->num_packets(), 1);
+}
+
 TEST(RtcpTransceiverImplTest, MultipleObserversOnSameSsrc) {
   const uint32_t kRemoteSsrc = 12345;
   StrictMock<MockMediaReceiverRtcpObserver> observer1;
@@ -1131,4 +1131,48 @@ TYPED_TEST(RtpFecTest, FecRecoveryNonConsecutivePacketsWrap) {
   EXPECT_FALSE(this->IsRecoveryComplete());
 }
 
+
+// The packet masks are generated once per set of parameters and reused, so
+// encoding the same packets again must produce the same FEC packets, also after
+// encoding with other parameters in between.
+TYPED_TEST(RtpFecTest, EncodeFecWithReusedPacketMasks) {
+  constexpr int kNumImportantPackets = 0;
+  constexpr bool kUseUnequalProtection = false;
+  constexpr uint8_t kProtectionFactor = 255;
+
+  this->media_packets_ =
+      this->media_packet_generator_.ConstructMediaPackets(kMaxMediaPackets);
+
+  EXPECT_EQ(
+      0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                              kNumImportantPackets, kUseUnequalProtection,
+                              kFecMaskBursty, &this->generated_fec_packets_));
+  ForwardErrorCorrection::PacketList first_fec_packets;
+  for (const auto* fec_packet : this->generated_fec_packets_) {
+    first_fec_packets.emplace_back(
+        new ForwardErrorCorrection::Packet(*fec_packet));
+  }
+  ASSERT_FALSE(first_fec_packets.empty());
+
+  this->generated_fec_packets_.clear();
+  EXPECT_EQ(
+      0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor / 2,
+                              kNumImportantPackets, kUseUnequalProtection,
+                              kFecMaskRandom, &this->generated_fec_packets_));
+
+  this->generated_fec_packets_.clear();
+  EXPECT_EQ(
+      0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                              kNumImportantPackets, kUseUnequalProtection,
+                              kFecMaskBursty, &this->generated_fec_packets_));
+  ASSERT_EQ(first_fec_packets.size(), this->generated_fec_packets_.size());
+  auto first_it = first_fec_packets.begin();
+  for (const auto* fec_packet : this->generated_fec_packets_) {
+    ASSERT_EQ((*first_it)->length, fec_packet->length);
+    EXPECT_EQ(0, memcmp((*first_it)->data, fec_packet->data,
+                        fec_packet->length));
+    ++first_it;
+  }
+}
+
 }  // namespace webrtc
@@ -122,6 +122,7 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   payload_offset_ = packet.payload_offset_;
   extensions_ = packet.extensions_;
   extension_entries_ = packet.extension_entries_;
+  one_byte_entry_positions_ = packet.one_byte_entry_positions_;
   extensions_size_ = packet.extensions_size_;
   buffer_.SetData(packet.data(), packet.headers_size());
   // Reset payload and padding.
@@ -276,8 +277,7 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
   const uint16_t extension_info_offset = rtc::dchecked_cast<uint16_t>(
       extensions_offset + extensions_size_ + extension_header_size);
   const uint8_t extension_info_length = rtc::dchecked_cast<uint8_t>(length);
-  extension_entries_.emplace_back(id, extension_info_length,
-                                  extension_info_offset);
+  AddExtensionInfo(id, extension_info_length, extension_info_offset);
 
   extensions_size_ = new_extensions_size;
 
@@ -389,7 +389,7 @@ void RtpPacket::Clear() {
   payload_size_ = 0;
   padding_size_ = 0;
   extensions_size_ = 0;
-  extension_entries_.clear();
+  ClearExtensionInfos();
 
   memset(WriteAt(0), 0, kFixedHeaderSize);
   buffer_.SetSize(kFixedHeaderSize);
@@ -429,7 +429,7 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   }
 
   extensions_size_ = 0;
-  extension_entries_.clear();
+  ClearExtensionInfos();
   if (has_extension) {
     /* RTP header extension, RFC 3550.
      0                   1                   2                   3
@@ -515,6 +515,10 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
 }
 
 const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
+  if (id > 0 && id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+    uint8_t position = one_byte_entry_positions_[id];
+    return position > 0 ? &extension_entries_[position - 1] : nullptr;
+  }
   for (const ExtensionInfo& extension : extension_entries_) {
     if (extension.id == id) {
       return &extension;
@@ -524,15 +528,29 @@ const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
 }
 
 RtpPacket::ExtensionInfo& RtpPacket::FindOrCreateExtensionInfo(int id) {
-  for (ExtensionInfo& extension : extension_entries_) {
-    if (extension.id == id) {
-      return extension;
-    }
+  const ExtensionInfo* extension = FindExtensionInfo(id);
+  if (extension != nullptr) {
+    return const_cast<ExtensionInfo&>(*extension);
+  }
+  return AddExtensionInfo(rtc::dchecked_cast<uint8_t>(id), 0, 0);
+}
+
+RtpPacket::ExtensionInfo& RtpPacket::AddExtensionInfo(uint8_t id,
+                                                       uint8_t length,
+                                                       uint16_t offset) {
+  extension_entries_.emplace_back(id, length, offset);
+  if (id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+    one_byte_entry_positions_[id] =
+        rtc::dchecked_cast<uint8_t>(extension_entries_.size());
   }
-  extension_entries_.emplace_back(id);
   return extension_entries_.back();
 }
 
+void RtpPacket::ClearExtensionInfos() {
+  extension_entries_.clear();
+  one_byte_entry_positions_.fill(0);
+}
+
 rtc::ArrayView<const uint8_t> RtpPacket::FindExtension(
     ExtensionType type) const {
   uint8_t id = extensions_.GetId(type);
@@ -10,10 +10,12 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_H_
 
+#include <array>
 #include <vector>
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
+#include "api/rtpparameters.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/copyonwritebuffer.h"
@@ -154,6 +156,10 @@ class RtpPacket {
   // with the specified id if not found.
   ExtensionInfo& FindOrCreateExtensionInfo(int id);
 
+  // Appends an entry to |extension_entries_| and indexes it.
+  ExtensionInfo& AddExtensionInfo(uint8_t id, uint8_t length, uint16_t offset);
+  void ClearExtensionInfos();
+
   // Allocates and returns place to store rtp header extension.
   // Returns empty arrayview on failure.
   rtc::ArrayView<uint8_t> AllocateRawExtension(int id, size_t length);
@@ -179,6 +185,12 @@ class RtpPacket {
 
   ExtensionManager extensions_;
   std::vector<ExtensionInfo> extension_entries_;
+  // Position + 1 in |extension_entries_| of the entry for each one-byte header
+  // id, or 0 if there is none. Extensions are looked up for every received
+  // packet, and nearly all of them have one-byte ids, so this saves searching
+  // |extension_entries_|. Entries with larger ids are searched.
+  std::array<uint8_t, RtpExtension::kOneByteHeaderExtensionMaxId + 1>
+      one_byte_entry_positions_ = {};
   size_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
 };
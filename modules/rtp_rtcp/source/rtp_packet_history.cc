@@ -36,6 +36,7 @@ size_t SizeDiff(size_t packet_size, size_t size) {
 }  // namespace
 
 constexpr size_t RtpPacketHistory::kMaxCapacity;
+constexpr size_t RtpPacketHistory::kMaxRingSize;
 constexpr int64_t RtpPacketHistory::kMinPacketDurationMs;
 constexpr int RtpPacketHistory::kMinPacketDurationRtt;
 constexpr int RtpPacketHistory::kPacketCullingDelayFactor;
@@ -54,7 +55,10 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock)
     : clock_(clock),
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
-      rtt_ms_(-1) {}
+      rtt_ms_(-1),
+      memory_account_("RtpPacketHistory"),
+      num_stored_packets_(0),
+      end_seqno_(0) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -75,6 +79,11 @@ RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
   return mode_;
 }
 
+void RtpPacketHistory::SetMemoryBudget(absl::optional<size_t> budget_bytes) {
+  rtc::CritScope cs(&lock_);
+  memory_account_.set_budget_bytes(budget_bytes);
+}
+
 void RtpPacketHistory::SetRtt(int64_t rtt_ms) {
   rtc::CritScope cs(&lock_);
   RTC_DCHECK_GE(rtt_ms, 0);
@@ -95,18 +104,25 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
 
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
-  StoredPacket& stored_packet = packet_history_[rtp_seq_no];
+  if (!MakeRoomFor(rtp_seq_no)) {
+    // It is an error if this happens. But it can happen if the sequence
+    // numbers for some reason restart without that the history has been reset.
+    RTC_LOG(LS_WARNING) << "Sequence number " << rtp_seq_no
+                        << " older than packet history, purging history.";
+    Reset();
+    MakeRoomFor(rtp_seq_no);
+  }
+  StoredPacket& stored_packet =
+      packet_history_[rtp_seq_no & (packet_history_.size() - 1)];
   RTC_DCHECK(stored_packet.packet == nullptr);
   if (stored_packet.packet) {
-    // It is an error if this happen. But it can happen if the sequence numbers
-    // for some reason restart without that the history has been reset.
-    auto size_iterator = packet_size_.find(stored_packet.packet->size());
-    if (size_iterator != packet_size_.end() &&
-        size_iterator->second == stored_packet.packet->SequenceNumber()) {
-      packet_size_.erase(size_iterator);
-    }
+    // As above, this is an error.
+    RemovePacket(&stored_packet);
+    MakeRoomFor(rtp_seq_no);
   }
   stored_packet.packet = std::move(packet);
+  ++num_stored_packets_;
+  memory_account_.Add(stored_packet.packet->capacity());
 
   if (stored_packet.packet->capture_time_ms() <= 0) {
     stored_packet.packet->set_capture_time_ms(now_ms);
@@ -115,12 +131,12 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   stored_packet.storage_type = type;
   stored_packet.times_retransmitted = 0;
 
-  if (!start_seqno_) {
-    start_seqno_ = rtp_seq_no;
-  }
   // Store the sequence number of the last send packet with this size.
   if (type != StorageType::kDontRetransmit) {
-    packet_size_[stored_packet.packet->size()] = rtp_seq_no;
+    size_t size = stored_packet.packet->size();
+    if (size >= seqno_by_size_.size())
+      seqno_by_size_.resize(size + 1, -1);
+    seqno_by_size_[size] = rtp_seq_no;
   }
 }
 
@@ -132,29 +148,28 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   }
 
   int64_t now_ms = clock_->TimeInMilliseconds();
-  StoredPacketIterator rtp_it = packet_history_.find(sequence_number);
-  if (rtp_it == packet_history_.end()) {
+  StoredPacket* packet = GetStoredPacket(sequence_number);
+  if (packet == nullptr) {
     return nullptr;
   }
 
-  StoredPacket& packet = rtp_it->second;
-  if (!VerifyRtt(rtp_it->second, now_ms)) {
+  if (!VerifyRtt(*packet, now_ms)) {
     return nullptr;
   }
 
-  if (packet.send_time_ms) {
-    ++packet.times_retransmitted;
+  if (packet->send_time_ms) {
+    ++packet->times_retransmitted;
   }
 
   // Update send-time and return copy of packet instance.
-  packet.send_time_ms = now_ms;
+  packet->send_time_ms = now_ms;
 
-  if (packet.storage_type == StorageType::kDontRetransmit) {
+  if (packet->storage_type == StorageType::kDontRetransmit) {
     // Non retransmittable packet, so call must come from paced sender.
     // Remove from history and return actual packet instance.
-    return RemovePacket(rtp_it);
+    return RemovePacket(packet);
   }
-  return absl::make_unique<RtpPacketToSend>(*packet.packet);
+  return absl::make_unique<RtpPacketToSend>(*packet->packet);
 }
 
 absl::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
@@ -164,16 +179,16 @@ absl::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
     return absl::nullopt;
   }
 
-  auto rtp_it = packet_history_.find(sequence_number);
-  if (rtp_it == packet_history_.end()) {
+  const StoredPacket* packet = GetStoredPacket(sequence_number);
+  if (packet == nullptr) {
     return absl::nullopt;
   }
 
-  if (!VerifyRtt(rtp_it->second, clock_->TimeInMilliseconds())) {
+  if (!VerifyRtt(*packet, clock_->TimeInMilliseconds())) {
     return absl::nullopt;
   }
 
-  return StoredPacketToPacketState(rtp_it->second);
+  return StoredPacketToPacketState(*packet);
 }
 
 bool RtpPacketHistory::VerifyRtt(const RtpPacketHistory::StoredPacket& packet,
@@ -196,81 +211,102 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetBestFittingPacket(
     size_t packet_length) const {
   // TODO(sprang): Make this smarter, taking retransmit count etc into account.
   rtc::CritScope cs(&lock_);
-  if (packet_length < kMinPacketRequestBytes || packet_size_.empty()) {
+  if (packet_length < kMinPacketRequestBytes || seqno_by_size_.empty()) {
     return nullptr;
   }
 
-  auto size_iter_upper = packet_size_.upper_bound(packet_length);
-  auto size_iter_lower = size_iter_upper;
-  if (size_iter_upper == packet_size_.end()) {
-    --size_iter_upper;
+  // Find the closest size not larger than |packet_length|, and the closest
+  // size larger than it.
+  absl::optional<size_t> lower_size;
+  for (size_t size = std::min(packet_length, seqno_by_size_.size() - 1);;
+       --size) {
+    if (seqno_by_size_[size] >= 0) {
+      lower_size = size;
+      break;
+    }
+    if (size == 0)
+      break;
   }
-  if (size_iter_lower != packet_size_.begin()) {
-    --size_iter_lower;
+  absl::optional<size_t> upper_size;
+  for (size_t size = packet_length + 1; size < seqno_by_size_.size(); ++size) {
+    if (seqno_by_size_[size] >= 0) {
+      upper_size = size;
+      break;
+    }
   }
-  const size_t upper_bound_diff =
-      SizeDiff(size_iter_upper->first, packet_length);
-  const size_t lower_bound_diff =
-      SizeDiff(size_iter_lower->first, packet_length);
-
-  const uint16_t seq_no = upper_bound_diff < lower_bound_diff
-                              ? size_iter_upper->second
-                              : size_iter_lower->second;
-  auto history_it = packet_history_.find(seq_no);
-  if (history_it == packet_history_.end()) {
-    RTC_LOG(LS_ERROR) << "Can't find packet in history with seq_no" << seq_no;
-    RTC_DCHECK(false);
+  if (!lower_size && !upper_size) {
     return nullptr;
   }
-  if (!history_it->second.packet) {
-    RTC_LOG(LS_ERROR) << "Packet pointer is null in history for seq_no"
-                      << seq_no;
+
+  size_t best_size;
+  if (!lower_size) {
+    best_size = *upper_size;
+  } else if (!upper_size) {
+    best_size = *lower_size;
+  } else {
+    best_size = SizeDiff(*upper_size, packet_length) <
+                        SizeDiff(*lower_size, packet_length)
+                    ? *upper_size
+                    : *lower_size;
+  }
+  const uint16_t seq_no = static_cast<uint16_t>(seqno_by_size_[best_size]);
+  const StoredPacket* stored_packet = GetStoredPacket(seq_no);
+  if (stored_packet == nullptr) {
+    RTC_LOG(LS_ERROR) << "Can't find packet in history with seq_no" << seq_no;
     RTC_DCHECK(false);
     return nullptr;
   }
-  RtpPacketToSend* best_packet = history_it->second.packet.get();
-  return absl::make_unique<RtpPacketToSend>(*best_packet);
+  return absl::make_unique<RtpPacketToSend>(*stored_packet->packet);
 }
 
 void RtpPacketHistory::Reset() {
   packet_history_.clear();
-  packet_size_.clear();
+  num_stored_packets_ = 0;
+  memory_account_.Subtract(memory_account_.bytes());
+  seqno_by_size_.clear();
   start_seqno_.reset();
+  end_seqno_ = 0;
 }
 
 void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   int64_t packet_duration_ms =
       std::max(kMinPacketDurationRtt * rtt_ms_, kMinPacketDurationMs);
-  while (!packet_history_.empty()) {
-    auto stored_packet_it = packet_history_.find(*start_seqno_);
-    RTC_DCHECK(stored_packet_it != packet_history_.end());
+  while (num_stored_packets_ > 0) {
+    StoredPacket* stored_packet = GetStoredPacket(*start_seqno_);
+    RTC_DCHECK(stored_packet);
 
-    if (packet_history_.size() >= kMaxCapacity) {
+    if (num_stored_packets_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
-      RemovePacket(stored_packet_it);
+      RemovePacket(stored_packet);
       continue;
     }
 
-    const StoredPacket& stored_packet = stored_packet_it->second;
-    if (!stored_packet.send_time_ms) {
+    if (!stored_packet->send_time_ms) {
       // Don't remove packets that have not been sent.
       return;
     }
 
-    if (*stored_packet.send_time_ms + packet_duration_ms > now_ms) {
+    if (memory_account_.IsOverBudget()) {
+      // Over the memory budget, remove the packet even if it might still be
+      // retransmitted.
+      RemovePacket(stored_packet);
+      continue;
+    }
+
+    if (*stored_packet->send_time_ms + packet_duration_ms > now_ms) {
       // Don't cull packets too early to avoid failed retransmission requests.
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (num_stored_packets_ >= number_to_store_ ||
         (mode_ == StorageMode::kStoreAndCull &&
-         *stored_packet.send_time_ms +
+         *stored_packet->send_time_ms +
                  (packet_duration_ms * kPacketCullingDelayFactor) <=
              now_ms)) {
       // Too many packets in history, or this packet has timed out. Remove it
       // and continue.
-      RemovePacket(stored_packet_it);
+      RemovePacket(stored_packet);
     } else {
       // No more packets can be removed right now.
       return;
@@ -278,31 +314,107 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   }
 }
 
+RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
+    uint16_t sequence_number) {
+  const RtpPacketHistory* const_this = this;
+  return const_cast<StoredPacket*>(const_this->GetStoredPacket(sequence_number));
+}
+
+const RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
+    uint16_t sequence_number) const {
+  if (!start_seqno_)
+    return nullptr;
+  // Offsets wrap around, so anything older than |start_seqno_| ends up
+  // beyond the end of the stored span.
+  uint16_t offset = sequence_number - *start_seqno_;
+  uint16_t span = end_seqno_ - *start_seqno_;
+  if (offset >= span)
+    return nullptr;
+  const StoredPacket& stored_packet =
+      packet_history_[sequence_number & (packet_history_.size() - 1)];
+  if (!stored_packet.packet)
+    return nullptr;
+  RTC_DCHECK_EQ(stored_packet.packet->SequenceNumber(), sequence_number);
+  return &stored_packet;
+}
+
+bool RtpPacketHistory::MakeRoomFor(uint16_t sequence_number) {
+  if (!start_seqno_) {
+    if (packet_history_.empty()) {
+      size_t size = 16;
+      while (size < number_to_store_ && size < kMaxRingSize)
+        size *= 2;
+      packet_history_.resize(size);
+    }
+    start_seqno_ = sequence_number;
+    end_seqno_ = sequence_number + 1;
+    return true;
+  }
+  uint16_t offset = sequence_number - *start_seqno_;
+  uint16_t span = end_seqno_ - *start_seqno_;
+  if (offset < span)
+    return true;
+  if (offset >= 0x8000) {
+    // Older than the oldest stored packet, e.g. reordered on the way in. Move
+    // the start back if the span still fits in the ring.
+    uint16_t new_span = end_seqno_ - sequence_number;
+    if (new_span > kMaxRingSize)
+      return false;
+    while (new_span > packet_history_.size())
+      ResizeRing(packet_history_.size() * 2);
+    start_seqno_ = sequence_number;
+    return true;
+  }
+  // Grow the ring if the new span does not fit, and drop the oldest packets
+  // if it is already at its largest.
+  while (static_cast<size_t>(offset) >= packet_history_.size() &&
+         packet_history_.size() < kMaxRingSize) {
+    ResizeRing(packet_history_.size() * 2);
+  }
+  while (num_stored_packets_ > 0 &&
+         static_cast<uint16_t>(sequence_number - *start_seqno_) >=
+             packet_history_.size()) {
+    RemovePacket(GetStoredPacket(*start_seqno_));
+  }
+  if (num_stored_packets_ == 0)
+    start_seqno_ = sequence_number;
+  end_seqno_ = sequence_number + 1;
+  return true;
+}
+
+void RtpPacketHistory::ResizeRing(size_t size) {
+  std::vector<StoredPacket> new_history(size);
+  for (StoredPacket& stored_packet : packet_history_) {
+    if (stored_packet.packet) {
+      new_history[stored_packet.packet->SequenceNumber() & (size - 1)] =
+          std::move(stored_packet);
+    }
+  }
+  packet_history_.swap(new_history);
+}
+
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
-    StoredPacketIterator packet_it) {
+    StoredPacket* stored_packet) {
   // Move the packet out from the StoredPacket container.
   std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_it->second.packet);
-  // Erase the packet from the map, and capture iterator to the next one.
-  StoredPacketIterator next_it = packet_history_.erase(packet_it);
-
-  // |next_it| now points to the next element, or to the end. If the end,
-  // check if we can wrap around.
-  if (next_it == packet_history_.end()) {
-    next_it = packet_history_.begin();
-  }
+      std::move(stored_packet->packet);
+  --num_stored_packets_;
+  memory_account_.Subtract(rtp_packet->capacity());
+  const uint16_t seq_no = rtp_packet->SequenceNumber();
 
-  // Update |start_seq_no| to the new oldest item.
-  if (next_it != packet_history_.end()) {
-    start_seqno_ = next_it->first;
-  } else {
+  if (num_stored_packets_ == 0) {
     start_seqno_.reset();
+  } else if (seq_no == *start_seqno_) {
+    // Update |start_seq_no| to the new oldest item.
+    uint16_t next = seq_no + 1;
+    while (!packet_history_[next & (packet_history_.size() - 1)].packet)
+      ++next;
+    start_seqno_ = next;
   }
 
-  auto size_iterator = packet_size_.find(rtp_packet->size());
-  if (size_iterator != packet_size_.end() &&
-      size_iterator->second == rtp_packet->SequenceNumber()) {
-    packet_size_.erase(size_iterator);
+  size_t size = rtp_packet->size();
+  if (size < seqno_by_size_.size() && seqno_by_size_[size] == seq_no) {
+    seqno_by_size_[size] = -1;
   }
 
   return rtp_packet;
@@ -11,13 +11,13 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <map>
 #include <memory>
 #include <vector>
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/criticalsection.h"
+#include "rtc_base/memory/memory_account.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -65,6 +65,11 @@ class RtpPacketHistory {
   void SetStorePacketsStatus(StorageMode mode, size_t number_to_store);
   StorageMode GetStorageMode() const;
 
+  // Limits the memory used by the stored packets. When over the budget, the
+  // oldest packets that have been sent are dropped, even if they are still
+  // within the retransmission window.
+  void SetMemoryBudget(absl::optional<size_t> budget_bytes);
+
   // Set RTT, used to avoid premature retransmission and to prevent over-writing
   // a packet in the history before we are reasonably sure it has been received.
   void SetRtt(int64_t rtt_ms);
@@ -110,7 +115,10 @@ class RtpPacketHistory {
     std::unique_ptr<RtpPacketToSend> packet;
   };
 
-  using StoredPacketIterator = std::map<uint16_t, StoredPacket>::iterator;
+  // Size of the ring of stored packets when fully grown. This is a power of
+  // two, so that slots stay consistent across sequence number wraparound, and
+  // at least |kMaxCapacity|.
+  static constexpr size_t kMaxRingSize = 16384;
 
   // Helper method used by GetPacketAndSetSendTime() and GetPacketState() to
   // check if packet has too recently been sent.
@@ -118,9 +126,21 @@ class RtpPacketHistory {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void CullOldPackets(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the stored packet with |sequence_number|, or null if there is
+  // none.
+  StoredPacket* GetStoredPacket(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket* GetStoredPacket(uint16_t sequence_number) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Makes room in the ring for |sequence_number|, growing it or dropping the
+  // oldest packets as needed. Returns false if |sequence_number| is too far
+  // behind the oldest packet in the history to fit.
+  bool MakeRoomFor(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void ResizeRing(size_t size) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   // Removes the packet from the history, and context/mapping that has been
   // stored. Returns the RTP packet instance contained within the StoredPacket.
-  std::unique_ptr<RtpPacketToSend> RemovePacket(StoredPacketIterator packet)
+  std::unique_ptr<RtpPacketToSend> RemovePacket(StoredPacket* packet)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   static PacketState StoredPacketToPacketState(
       const StoredPacket& stored_packet);
@@ -130,14 +150,22 @@ class RtpPacketHistory {
   size_t number_to_store_ RTC_GUARDED_BY(lock_);
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   int64_t rtt_ms_ RTC_GUARDED_BY(lock_);
+  // Memory held by the stored packets.
+  rtc::MemoryAccount memory_account_;
 
-  // Map from rtp sequence numbers to stored packet.
-  std::map<uint16_t, StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
-  std::map<size_t, uint16_t> packet_size_ RTC_GUARDED_BY(lock_);
+  // Ring of stored packets, indexed by sequence number modulo its size. The
+  // size is a power of two, grown on demand up to |kMaxRingSize|.
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  size_t num_stored_packets_ RTC_GUARDED_BY(lock_);
 
-  // The earliest packet in the history. This might not be the lowest sequence
-  // number, in case there is a wraparound.
+  // The earliest packet in the history, and one past the newest. These might
+  // not be ordered numerically, in case there is a wraparound.
   absl::optional<uint16_t> start_seqno_ RTC_GUARDED_BY(lock_);
+  uint16_t end_seqno_ RTC_GUARDED_BY(lock_);
+
+  // Sequence number of the last retransmittable packet stored with each size,
+  // indexed by packet size. Used by GetBestFittingPacket(); -1 means none.
+  std::vector<int> seqno_by_size_ RTC_GUARDED_BY(lock_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketHistory);
 };
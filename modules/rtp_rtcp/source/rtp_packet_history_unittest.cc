@@ -99,6 +99,36 @@ TEST_F(RtpPacketHistoryTest, StartSeqResetAfterReset) {
   EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 2)));
 }
 
+TEST_F(RtpPacketHistoryTest, KeepsPacketsWhenGrowingBeyondInitialSize) {
+  const size_t kNumPackets = 500;
+  hist_.SetStorePacketsStatus(StorageMode::kStore, kNumPackets);
+  // Store unsent packets, across the sequence number wraparound, so that none
+  // of them can be culled.
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       kAllowRetransmission, absl::nullopt);
+  }
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    absl::optional<RtpPacketHistory::PacketState> state =
+        hist_.GetPacketState(To16u(kStartSeqNum + i));
+    ASSERT_TRUE(state);
+    EXPECT_EQ(To16u(kStartSeqNum + i), state->rtp_sequence_number);
+  }
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + kNumPackets)));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum - 1)));
+}
+
+TEST_F(RtpPacketHistoryTest, StoresReorderedOlderPacket) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 2)),
+                     kAllowRetransmission, absl::nullopt);
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), kAllowRetransmission,
+                     absl::nullopt);
+  EXPECT_TRUE(hist_.GetPacketState(kStartSeqNum));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 1)));
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 2)));
+}
+
 TEST_F(RtpPacketHistoryTest, NoStoreStatus) {
   EXPECT_EQ(StorageMode::kDisabled, hist_.GetStorageMode());
   std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kStartSeqNum);
@@ -303,6 +333,29 @@ TEST_F(RtpPacketHistoryTest, RemovesOldestSentPacketWhenAtMaxSize) {
   EXPECT_TRUE(hist_.GetPacketState(kStartSeqNum + 1));
 }
 
+TEST_F(RtpPacketHistoryTest, RemovesOldestSentPacketsWhenOverMemoryBudget) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 10);
+  const size_t kPacketBytes = CreateRtpPacket(kStartSeqNum)->capacity();
+  hist_.SetMemoryBudget(3 * kPacketBytes);
+
+  // Unsent packets are kept even when over the budget.
+  for (size_t i = 0; i < 4; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       kAllowRetransmission, absl::nullopt);
+  }
+  EXPECT_TRUE(hist_.GetPacketState(kStartSeqNum));
+
+  // Once sent, the oldest packets are removed before storing a new packet
+  // until the history is within the budget, even though they are within the
+  // retransmission window.
+  for (size_t i = 0; i < 4; ++i)
+    EXPECT_TRUE(hist_.GetPacketAndSetSendTime(To16u(kStartSeqNum + i)));
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 4)),
+                     kAllowRetransmission, fake_clock_.TimeInMilliseconds());
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum));
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 1)));
+}
+
 TEST_F(RtpPacketHistoryTest, RemovesOldestPacketWhenAtMaxCapacity) {
   // Tests the absolute upper bound on number of stored packets. Don't allow
   // storing more than this, even if packets have not yet been sent.
@@ -827,4 +827,68 @@ TEST(RtpPacketTest, CreateAndParseColorSpaceExtensionWithoutHdrMetadata) {
   TestCreateAndParseColorSpaceExtension(/*with_hdr_metadata=*/false);
 }
 
+TEST(RtpPacketTest, ReparsingDropsPreviousExtensions) {
+  RtpPacketReceived::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+  RtpPacketReceived packet(&extensions);
+  EXPECT_TRUE(packet.Parse(kPacketWithTOAndAL, sizeof(kPacketWithTOAndAL)));
+  EXPECT_TRUE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_TRUE(packet.HasExtension<AudioLevel>());
+
+  EXPECT_TRUE(packet.Parse(kPacketWithTO, sizeof(kPacketWithTO)));
+  EXPECT_TRUE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_FALSE(packet.HasExtension<AudioLevel>());
+}
+
+// Disabled by default and only intended to be run manually, to measure the
+// cost of parsing a video packet and reading the extensions the receive path
+// reads.
+TEST(RtpPacketTest, DISABLED_PerformanceParseAndReadExtensions) {
+  constexpr int kNumIterations = 10000000;
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(1);
+  extensions.Register<AbsoluteSendTime>(3);
+  extensions.Register<TransportSequenceNumber>(5);
+  extensions.Register<PlayoutDelayLimits>(6);
+  extensions.Register<VideoTimingExtension>(7);
+  extensions.Register<RtpMid>(kRtpMidExtensionId);
+  RtpPacketToSend send_packet(&extensions);
+  send_packet.SetPayloadType(kPayloadType);
+  send_packet.SetSequenceNumber(kSeqNum);
+  send_packet.SetTimestamp(kTimestamp);
+  send_packet.SetSsrc(kSsrc);
+  ASSERT_TRUE(send_packet.SetExtension<TransmissionOffset>(kTimeOffset));
+  ASSERT_TRUE(send_packet.SetExtension<AbsoluteSendTime>(0x123456));
+  ASSERT_TRUE(send_packet.SetExtension<TransportSequenceNumber>(kSeqNum));
+  ASSERT_TRUE(
+      send_packet.SetExtension<PlayoutDelayLimits>(PlayoutDelay{100, 200}));
+  VideoSendTiming send_timing;
+  send_timing.encode_start_delta_ms = 1;
+  send_timing.pacer_exit_delta_ms = 4;
+  send_timing.flags = VideoSendTiming::kTriggeredByTimer;
+  ASSERT_TRUE(send_packet.SetExtension<VideoTimingExtension>(send_timing));
+  ASSERT_TRUE(send_packet.SetExtension<RtpMid>(kMid));
+  send_packet.SetPayloadSize(1000);
+
+  RtpPacketReceived packet(&extensions);
+  int64_t sum = 0;
+  for (int i = 0; i < kNumIterations; ++i) {
+    ASSERT_TRUE(packet.Parse(send_packet.Buffer()));
+    uint16_t transport_sequence_number;
+    uint32_t send_time;
+    int32_t time_offset;
+    PlayoutDelay playout_delay;
+    VideoSendTiming timing;
+    ASSERT_TRUE(packet.GetExtension<TransportSequenceNumber>(
+        &transport_sequence_number));
+    ASSERT_TRUE(packet.GetExtension<AbsoluteSendTime>(&send_time));
+    ASSERT_TRUE(packet.GetExtension<TransmissionOffset>(&time_offset));
+    ASSERT_TRUE(packet.GetExtension<PlayoutDelayLimits>(&playout_delay));
+    ASSERT_TRUE(packet.GetExtension<VideoTimingExtension>(&timing));
+    sum += transport_sequence_number + send_time + time_offset;
+  }
+  EXPECT_NE(0, sum);
+}
+
 }  // namespace webrtc
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <list>
+#include <memory>
+
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+#include "test/testsupport/microbenchmark.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSsrc = 0x12345678;
+constexpr size_t kPayloadSize = 1100;
+
+}  // namespace
+
+TEST(RtpRtcpMicrobenchmark, RtpPacketParse) {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<TransmissionOffset>(1);
+  extensions.Register<AbsoluteSendTime>(2);
+  extensions.Register<TransportSequenceNumber>(3);
+
+  RtpPacketToSend packet(&extensions);
+  packet.SetPayloadType(96);
+  packet.SetSequenceNumber(4321);
+  packet.SetTimestamp(0x11223344);
+  packet.SetSsrc(kSsrc);
+  packet.SetExtension<TransmissionOffset>(42);
+  packet.SetExtension<AbsoluteSendTime>(0x123456);
+  packet.SetExtension<TransportSequenceNumber>(77);
+  memset(packet.AllocatePayload(kPayloadSize), 0xab, kPayloadSize);
+  const rtc::CopyOnWriteBuffer raw = packet.Buffer();
+
+  RtpPacketReceived received(&extensions);
+  test::RunMicrobenchmark("RtpPacket_Parse", [&] {
+    bool parsed = received.Parse(raw.cdata(), raw.size());
+    test::DoNotOptimizeAway(&parsed);
+  });
+  EXPECT_TRUE(received.Parse(raw.cdata(), raw.size()));
+  EXPECT_TRUE(received.HasExtension<TransportSequenceNumber>());
+}
+
+TEST(RtpRtcpMicrobenchmark, UlpfecEncode) {
+  constexpr int kNumMediaPackets = 10;
+  constexpr uint8_t kProtectionFactor = 127;
+
+  Random random(0xabcdef);
+  test::fec::MediaPacketGenerator generator(kPayloadSize, kPayloadSize, kSsrc,
+                                            &random);
+  const ForwardErrorCorrection::PacketList media_packets =
+      generator.ConstructMediaPackets(kNumMediaPackets);
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec(kSsrc);
+
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  test::RunMicrobenchmark("ForwardErrorCorrection_EncodeFec", [&] {
+    fec_packets.clear();
+    fec->EncodeFec(media_packets, kProtectionFactor, 0, false, kFecMaskBursty,
+                   &fec_packets);
+    test::DoNotOptimizeAway(&fec_packets);
+  });
+  EXPECT_FALSE(fec_packets.empty());
+}
+
+}  // namespace webrtc
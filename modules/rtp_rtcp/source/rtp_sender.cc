@@ -715,7 +715,10 @@ bool RTPSender::SendPacketToNetwork(const RtpPacketToSend& packet,
   int bytes_sent = -1;
   if (transport_) {
     UpdateRtpOverhead(packet);
-    bytes_sent = transport_->SendRtp(packet.data(), packet.size(), options)
+    // Share the packet buffer with the transport rather than copying it. By
+    // the time it is protected and sent, |packet| has usually been released,
+    // so SRTP can work in place in the tail room left by AllocatePacket().
+    bytes_sent = transport_->SendRtpBuffer(packet.Buffer(), options)
                      ? static_cast<int>(packet.size())
                      : -1;
     if (event_log_ && bytes_sent > 0) {
@@ -1193,6 +1196,21 @@ bool RTPSender::AssignSequenceNumber(RtpPacketToSend* packet) {
   rtc::CritScope lock(&send_critsect_);
   if (!sending_media_)
     return false;
+  AssignSequenceNumberLocked(packet);
+  return true;
+}
+
+bool RTPSender::AssignSequenceNumbers(
+    rtc::ArrayView<const std::unique_ptr<RtpPacketToSend>> packets) {
+  rtc::CritScope lock(&send_critsect_);
+  if (!sending_media_)
+    return false;
+  for (const auto& packet : packets)
+    AssignSequenceNumberLocked(packet.get());
+  return true;
+}
+
+void RTPSender::AssignSequenceNumberLocked(RtpPacketToSend* packet) {
   RTC_DCHECK(packet->Ssrc() == ssrc_);
   packet->SetSequenceNumber(sequence_number_++);
 
@@ -1205,7 +1223,6 @@ bool RTPSender::AssignSequenceNumber(RtpPacketToSend* packet) {
   last_rtp_timestamp_ = packet->Timestamp();
   last_timestamp_time_ms_ = clock_->TimeInMilliseconds();
   capture_time_ms_ = packet->capture_time_ms();
-  return true;
 }
 
 bool RTPSender::UpdateTransportSequenceNumber(RtpPacketToSend* packet,
@@ -1367,21 +1384,21 @@ static std::unique_ptr<RtpPacketToSend> CreateRtxPacket(
             ? kRtpExtensionRepairedRtpStreamId
             : source_extension;
 
-    // Empty extensions should be supported, so not checking |source.empty()|.
-    if (!packet.HasExtension(source_extension)) {
-      continue;
-    }
-
+    // Look the extension up once. Empty extensions can't be allocated in the
+    // destination yet (webrtc:7990), so they are skipped along with missing
+    // ones.
     rtc::ArrayView<const uint8_t> source =
         packet.FindExtension(source_extension);
+    if (source.empty()) {
+      continue;
+    }
 
     rtc::ArrayView<uint8_t> destination =
         rtx_packet->AllocateExtension(destination_extension, source.size());
 
     // Could happen if any:
-    // 1. Extension has 0 length.
-    // 2. Extension is not registered in destination.
-    // 3. Allocating extension in destination failed.
+    // 1. Extension is not registered in destination.
+    // 2. Allocating extension in destination failed.
     if (destination.empty() || source.size() != destination.size()) {
       continue;
     }
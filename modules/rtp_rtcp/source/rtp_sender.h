@@ -175,6 +175,10 @@ class RTPSender {
   // Save packet's fields to generate padding that doesn't break media stream.
   // Return false if sending was turned off.
   bool AssignSequenceNumber(RtpPacketToSend* packet);
+  // Same as above for consecutive packets, e.g. all packets of a video frame,
+  // taking the send lock once. Either all or none of the packets get one.
+  bool AssignSequenceNumbers(
+      rtc::ArrayView<const std::unique_ptr<RtpPacketToSend>> packets);
 
   // Used for padding and FEC packets only.
   size_t RtpHeaderLength() const;
@@ -259,6 +263,8 @@ class RTPSender {
 
   bool UpdateTransportSequenceNumber(RtpPacketToSend* packet, int* packet_id)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(send_critsect_);
+  void AssignSequenceNumberLocked(RtpPacketToSend* packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(send_critsect_);
 
   void UpdateRtpStats(const RtpPacketToSend& packet,
                       bool is_rtx,
@@ -173,7 +173,9 @@ RTPSenderVideo::RTPSenderVideo(Clock* clock,
       frame_encryptor_(frame_encryptor),
       require_frame_encryption_(require_frame_encryption),
       generic_descriptor_auth_experiment_(
-          field_trial::IsEnabled("WebRTC-GenericDescriptorAuth")) {}
+          field_trial::IsEnabled("WebRTC-GenericDescriptorAuth")),
+      droppable_packets_experiment_(
+          field_trial::IsEnabled("WebRTC-Pacer-DropExpiredPackets")) {}
 
 RTPSenderVideo::~RTPSenderVideo() {}
 
@@ -209,12 +211,12 @@ RtpUtility::Payload* RTPSenderVideo::CreateVideoPayload(
 }
 
 void RTPSenderVideo::SendVideoPacket(std::unique_ptr<RtpPacketToSend> packet,
-                                     StorageType storage) {
+                                     StorageType storage,
+                                     RtpPacketSender::Priority priority) {
   // Remember some values about the packet before sending it away.
   size_t packet_size = packet->size();
   uint16_t seq_num = packet->SequenceNumber();
-  if (!rtp_sender_->SendToNetwork(std::move(packet), storage,
-                                  RtpPacketSender::kLowPriority)) {
+  if (!rtp_sender_->SendToNetwork(std::move(packet), storage, priority)) {
     RTC_LOG(LS_WARNING) << "Failed to send video packet " << seq_num;
     return;
   }
@@ -225,6 +227,7 @@ void RTPSenderVideo::SendVideoPacket(std::unique_ptr<RtpPacketToSend> packet,
 void RTPSenderVideo::SendVideoPacketAsRedMaybeWithUlpfec(
     std::unique_ptr<RtpPacketToSend> media_packet,
     StorageType media_packet_storage,
+    RtpPacketSender::Priority media_packet_priority,
     bool protect_media_packet) {
   uint16_t media_seq_num = media_packet->SequenceNumber();
 
@@ -259,7 +262,7 @@ void RTPSenderVideo::SendVideoPacketAsRedMaybeWithUlpfec(
   // Send |red_packet| instead of |packet| for allocated sequence number.
   size_t red_packet_size = red_packet->size();
   if (rtp_sender_->SendToNetwork(std::move(red_packet), media_packet_storage,
-                                 RtpPacketSender::kLowPriority)) {
+                                 media_packet_priority)) {
     rtc::CritScope cs(&stats_crit_);
     video_bitrate_.Update(red_packet_size, clock_->TimeInMilliseconds());
   } else {
@@ -274,7 +277,7 @@ void RTPSenderVideo::SendVideoPacketAsRedMaybeWithUlpfec(
     rtp_packet->set_capture_time_ms(media_packet->capture_time_ms());
     uint16_t fec_sequence_number = rtp_packet->SequenceNumber();
     if (rtp_sender_->SendToNetwork(std::move(rtp_packet), fec_storage,
-                                   RtpPacketSender::kLowPriority)) {
+                                   FecPriority())) {
       rtc::CritScope cs(&stats_crit_);
       fec_bitrate_.Update(fec_packet->length(), clock_->TimeInMilliseconds());
     } else {
@@ -287,13 +290,15 @@ void RTPSenderVideo::SendVideoPacketAsRedMaybeWithUlpfec(
 void RTPSenderVideo::SendVideoPacketWithFlexfec(
     std::unique_ptr<RtpPacketToSend> media_packet,
     StorageType media_packet_storage,
+    RtpPacketSender::Priority media_packet_priority,
     bool protect_media_packet) {
   RTC_DCHECK(flexfec_sender_);
 
   if (protect_media_packet)
     flexfec_sender_->AddRtpPacketAndGenerateFec(*media_packet);
 
-  SendVideoPacket(std::move(media_packet), media_packet_storage);
+  SendVideoPacket(std::move(media_packet), media_packet_storage,
+                  media_packet_priority);
 
   if (flexfec_sender_->FecAvailable()) {
     std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
@@ -302,7 +307,7 @@ void RTPSenderVideo::SendVideoPacketWithFlexfec(
       size_t packet_length = fec_packet->size();
       uint16_t seq_num = fec_packet->SequenceNumber();
       if (rtp_sender_->SendToNetwork(std::move(fec_packet), kDontRetransmit,
-                                     RtpPacketSender::kLowPriority)) {
+                                     FecPriority())) {
         rtc::CritScope cs(&stats_crit_);
         fec_bitrate_.Update(packet_length, clock_->TimeInMilliseconds());
       } else {
@@ -312,6 +317,11 @@ void RTPSenderVideo::SendVideoPacketWithFlexfec(
   }
 }
 
+RtpPacketSender::Priority RTPSenderVideo::FecPriority() const {
+  return droppable_packets_experiment_ ? RtpPacketSender::kDroppablePriority
+                                       : RtpPacketSender::kLowPriority;
+}
+
 void RTPSenderVideo::SetUlpfecConfig(int red_payload_type,
                                      int ulpfec_payload_type) {
   // Sanity check. Per the definition of UlpfecConfig (see config.h),
@@ -544,12 +554,22 @@ bool RTPSenderVideo::SendVideo(enum VideoCodecType video_type,
   const uint8_t temporal_id = GetTemporalId(*video_header);
   StorageType storage = GetStorageType(temporal_id, retransmission_settings,
                                        expected_retransmission_time_ms);
+  // Enhancement layer frames are not referenced by the base layer, so they
+  // may be dropped by the pacer if they can't be sent in time.
+  const RtpPacketSender::Priority priority =
+      droppable_packets_experiment_ && temporal_id != kNoTemporalIdx &&
+              temporal_id > 0
+          ? RtpPacketSender::kDroppablePriority
+          : RtpPacketSender::kLowPriority;
   size_t num_packets = packetizer->NumPackets();
 
   if (num_packets == 0)
     return false;
 
-  bool first_frame = first_frame_sent_();
+  // Packetize the whole frame first, so that the sequence numbers are
+  // assigned under one lock.
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  packets.reserve(num_packets);
   for (size_t i = 0; i < num_packets; ++i) {
     std::unique_ptr<RtpPacketToSend> packet;
     int expected_payload_capacity;
@@ -574,8 +594,14 @@ bool RTPSenderVideo::SendVideo(enum VideoCodecType video_type,
     if (!packetizer->NextPacket(packet.get()))
       return false;
     RTC_DCHECK_LE(packet->payload_size(), expected_payload_capacity);
-    if (!rtp_sender_->AssignSequenceNumber(packet.get()))
-      return false;
+    packets.push_back(std::move(packet));
+  }
+  if (!rtp_sender_->AssignSequenceNumbers(packets))
+    return false;
+
+  bool first_frame = first_frame_sent_();
+  for (size_t i = 0; i < num_packets; ++i) {
+    std::unique_ptr<RtpPacketToSend> packet = std::move(packets[i]);
 
     // No FEC protection for upper temporal layers, if used.
     bool protect_packet = temporal_id == 0 || temporal_id == kNoTemporalIdx;
@@ -595,12 +621,13 @@ bool RTPSenderVideo::SendVideo(enum VideoCodecType video_type,
     if (flexfec_enabled()) {
       // TODO(brandtr): Remove the FlexFEC code path when FlexfecSender
       // is wired up to PacedSender instead.
-      SendVideoPacketWithFlexfec(std::move(packet), storage, protect_packet);
+      SendVideoPacketWithFlexfec(std::move(packet), storage, priority,
+                                 protect_packet);
     } else if (red_enabled) {
-      SendVideoPacketAsRedMaybeWithUlpfec(std::move(packet), storage,
+      SendVideoPacketAsRedMaybeWithUlpfec(std::move(packet), storage, priority,
                                           protect_packet);
     } else {
-      SendVideoPacket(std::move(packet), storage);
+      SendVideoPacket(std::move(packet), storage, priority);
     }
 
     if (first_frame) {
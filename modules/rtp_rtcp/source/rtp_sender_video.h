@@ -102,18 +102,25 @@ class RTPSenderVideo {
   size_t CalculateFecPacketOverhead() const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   void SendVideoPacket(std::unique_ptr<RtpPacketToSend> packet,
-                       StorageType storage);
+                       StorageType storage,
+                       RtpPacketSender::Priority priority);
 
   void SendVideoPacketAsRedMaybeWithUlpfec(
       std::unique_ptr<RtpPacketToSend> media_packet,
       StorageType media_packet_storage,
+      RtpPacketSender::Priority media_packet_priority,
       bool protect_media_packet);
 
   // TODO(brandtr): Remove the FlexFEC functions when FlexfecSender has been
   // moved to PacedSender.
-  void SendVideoPacketWithFlexfec(std::unique_ptr<RtpPacketToSend> media_packet,
-                                  StorageType media_packet_storage,
-                                  bool protect_media_packet);
+  void SendVideoPacketWithFlexfec(
+      std::unique_ptr<RtpPacketToSend> media_packet,
+      StorageType media_packet_storage,
+      RtpPacketSender::Priority media_packet_priority,
+      bool protect_media_packet);
+
+  // Returns the pacer priority of FEC packets.
+  RtpPacketSender::Priority FecPriority() const;
 
   bool red_enabled() const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_) {
     return red_payload_type_ >= 0;
@@ -173,6 +180,9 @@ class RTPSenderVideo {
   bool require_frame_encryption_;
   // Set to true if the generic descriptor should be authenticated.
   const bool generic_descriptor_auth_experiment_;
+  // Set to true if FEC and enhancement layer packets may be dropped by the
+  // pacer when they can't be sent before their deadline.
+  const bool droppable_packets_experiment_;
 };
 
 }  // namespace webrtc
@@ -11,6 +11,7 @@
 #include "modules/utility/source/process_thread_impl.h"
 
 #include <string>
+#include <vector>
 
 #include "modules/include/module.h"
 #include "rtc_base/checks.h"
@@ -99,7 +100,7 @@ void ProcessThreadImpl::WakeUp(Module* module) {
     rtc::CritScope lock(&lock_);
     for (ModuleCallback& m : modules_) {
       if (m.module == module)
-        m.next_callback = kCallProcessImmediately;
+        Reschedule(&m, kCallProcessImmediately);
     }
   }
   wake_up_.Set();
@@ -140,6 +141,8 @@ void ProcessThreadImpl::RegisterModule(Module* module,
   {
     rtc::CritScope lock(&lock_);
     modules_.push_back(ModuleCallback(module, from));
+    schedule_.insert(std::make_pair(modules_.back().next_callback,
+                                    &modules_.back()));
   }
 
   // Wake the thread calling ProcessThreadImpl::Process() to update the
@@ -154,6 +157,10 @@ void ProcessThreadImpl::DeRegisterModule(Module* module) {
 
   {
     rtc::CritScope lock(&lock_);
+    for (ModuleCallback& m : modules_) {
+      if (m.module == module)
+        schedule_.erase(std::make_pair(m.next_callback, &m));
+    }
     modules_.remove_if(
         [&module](const ModuleCallback& m) { return m.module == module; });
   }
@@ -162,6 +169,15 @@ void ProcessThreadImpl::DeRegisterModule(Module* module) {
   module->ProcessThreadAttached(nullptr);
 }
 
+void ProcessThreadImpl::Reschedule(ModuleCallback* module,
+                                   int64_t next_callback) {
+  // A module that is missing from |schedule_| is being processed, and is put
+  // back with its |next_callback| when done.
+  if (schedule_.erase(std::make_pair(module->next_callback, module)) > 0)
+    schedule_.insert(std::make_pair(next_callback, module));
+  module->next_callback = next_callback;
+}
+
 // static
 bool ProcessThreadImpl::Run(void* obj) {
   return static_cast<ProcessThreadImpl*>(obj)->Process();
@@ -176,33 +192,42 @@ bool ProcessThreadImpl::Process() {
     rtc::CritScope lock(&lock_);
     if (stop_)
       return false;
-    for (ModuleCallback& m : modules_) {
+    // Take the due modules out of the schedule first, so that each of them is
+    // processed at most once per wake up. Newly registered modules (0) and
+    // modules that asked to be woken up (kCallProcessImmediately) sort first.
+    std::vector<ModuleCallback*> due_modules;
+    while (!schedule_.empty() && schedule_.begin()->first <= now) {
+      due_modules.push_back(schedule_.begin()->second);
+      schedule_.erase(schedule_.begin());
+    }
+    for (ModuleCallback* m : due_modules) {
       // TODO(tommi): Would be good to measure the time TimeUntilNextProcess
       // takes and dcheck if it takes too long (e.g. >=10ms).  Ideally this
       // operation should not require taking a lock, so querying all modules
       // should run in a matter of nanoseconds.
-      if (m.next_callback == 0)
-        m.next_callback = GetNextCallbackTime(m.module, now);
+      if (m->next_callback == 0)
+        m->next_callback = GetNextCallbackTime(m->module, now);
 
-      if (m.next_callback <= now ||
-          m.next_callback == kCallProcessImmediately) {
+      if (m->next_callback <= now ||
+          m->next_callback == kCallProcessImmediately) {
         {
           TRACE_EVENT2("webrtc", "ModuleProcess", "function",
-                       m.location.function_name(), "file",
-                       m.location.file_and_line());
-          m.module->Process();
+                       m->location.function_name(), "file",
+                       m->location.file_and_line());
+          m->module->Process();
         }
         // Use a new 'now' reference to calculate when the next callback
         // should occur.  We'll continue to use 'now' above for the baseline
         // of calculating how long we should wait, to reduce variance.
         int64_t new_now = rtc::TimeMillis();
-        m.next_callback = GetNextCallbackTime(m.module, new_now);
+        m->next_callback = GetNextCallbackTime(m->module, new_now);
       }
-
-      if (m.next_callback < next_checkpoint)
-        next_checkpoint = m.next_callback;
+      schedule_.insert(std::make_pair(m->next_callback, m));
     }
 
+    if (!schedule_.empty() && schedule_.begin()->first < next_checkpoint)
+      next_checkpoint = schedule_.begin()->first;
+
     while (!queue_.empty()) {
       rtc::QueuedTask* task = queue_.front();
       queue_.pop();
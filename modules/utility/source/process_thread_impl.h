@@ -15,6 +15,8 @@
 #include <list>
 #include <memory>
 #include <queue>
+#include <set>
+#include <utility>
 
 #include "modules/include/module.h"
 #include "modules/utility/include/process_thread.h"
@@ -65,6 +67,13 @@ class ProcessThreadImpl : public ProcessThread {
   };
 
   typedef std::list<ModuleCallback> ModuleList;
+  // The registered modules ordered by |next_callback|, so that a wake up only
+  // visits the modules that are due instead of all of them.
+  typedef std::set<std::pair<int64_t, ModuleCallback*>> Schedule;
+
+  // Moves |module| to |next_callback| in |schedule_|.
+  void Reschedule(ModuleCallback* module, int64_t next_callback)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   // Warning: For some reason, if |lock_| comes immediately before |modules_|
   // with the current class layout, we will  start to have mysterious crashes
@@ -80,6 +89,7 @@ class ProcessThreadImpl : public ProcessThread {
   std::unique_ptr<rtc::PlatformThread> thread_;
 
   ModuleList modules_;
+  Schedule schedule_ RTC_GUARDED_BY(lock_);
   std::queue<rtc::QueuedTask*> queue_;
   bool stop_;
   const char* thread_name_;
@@ -297,6 +297,38 @@ TEST(ProcessThreadImpl, WakeUp) {
   EXPECT_LE(diff, 100u);
 }
 
+// Tests that waking up one module doesn't process, or query, other modules
+// that aren't due yet.
+TEST(ProcessThreadImpl, WakeUpProcessesOnlyThatModule) {
+  ProcessThreadImpl thread("ProcessThread");
+  thread.Start();
+
+  rtc::Event started;
+  rtc::Event called;
+
+  MockModule idle_module;
+  MockModule module;
+  EXPECT_CALL(idle_module, TimeUntilNextProcess()).WillOnce(Return(100000));
+  EXPECT_CALL(idle_module, Process()).Times(0);
+  EXPECT_CALL(module, TimeUntilNextProcess())
+      .WillOnce(DoAll(SetEvent(&started), Return(100000)))
+      .WillOnce(Return(100000));
+  EXPECT_CALL(module, Process()).WillOnce(SetEvent(&called));
+
+  EXPECT_CALL(idle_module, ProcessThreadAttached(&thread)).Times(1);
+  EXPECT_CALL(module, ProcessThreadAttached(&thread)).Times(1);
+  thread.RegisterModule(&idle_module, RTC_FROM_HERE);
+  thread.RegisterModule(&module, RTC_FROM_HERE);
+
+  EXPECT_TRUE(started.Wait(kEventWaitTimeout));
+  thread.WakeUp(&module);
+  EXPECT_TRUE(called.Wait(kEventWaitTimeout));
+
+  EXPECT_CALL(idle_module, ProcessThreadAttached(nullptr)).Times(1);
+  EXPECT_CALL(module, ProcessThreadAttached(nullptr)).Times(1);
+  thread.Stop();
+}
+
 // Tests that we can post a task that gets run straight away on the worker
 // thread.
 TEST(ProcessThreadImpl, PostTask) {
@@ -0,0 +1,223 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/linux/v4l2_buffer_pool.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/refcountedobject.h"
+#include "third_party/libyuv/include/libyuv.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+V4l2BufferPool::V4l2BufferPool(int device_fd) : device_fd_(device_fd) {}
+
+V4l2BufferPool::~V4l2BufferPool() {
+  for (const Buffer& buffer : buffers_) {
+    munmap(buffer.start, buffer.length);
+    if (buffer.dmabuf_fd >= 0)
+      close(buffer.dmabuf_fd);
+  }
+}
+
+bool V4l2BufferPool::Allocate(int count, bool export_dmabuf) {
+  RTC_DCHECK(buffers_.empty());
+  struct v4l2_requestbuffers rbuffer;
+  memset(&rbuffer, 0, sizeof(v4l2_requestbuffers));
+
+  rbuffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  rbuffer.memory = V4L2_MEMORY_MMAP;
+  rbuffer.count = count;
+
+  if (ioctl(device_fd_, VIDIOC_REQBUFS, &rbuffer) < 0) {
+    RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = " << errno;
+    return false;
+  }
+
+  if (rbuffer.count > static_cast<unsigned int>(count))
+    rbuffer.count = count;
+
+  // Map the buffers
+  for (unsigned int i = 0; i < rbuffer.count; i++) {
+    struct v4l2_buffer buffer;
+    memset(&buffer, 0, sizeof(v4l2_buffer));
+    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+    buffer.index = i;
+
+    if (ioctl(device_fd_, VIDIOC_QUERYBUF, &buffer) < 0) {
+      return false;
+    }
+
+    void* start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, device_fd_, buffer.m.offset);
+    if (MAP_FAILED == start) {
+      return false;
+    }
+
+    int dmabuf_fd = -1;
+    if (export_dmabuf) {
+      struct v4l2_exportbuffer expbuf;
+      memset(&expbuf, 0, sizeof(expbuf));
+      expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      expbuf.index = i;
+      expbuf.flags = O_CLOEXEC | O_RDONLY;
+      if (ioctl(device_fd_, VIDIOC_EXPBUF, &expbuf) == 0) {
+        dmabuf_fd = expbuf.fd;
+      } else {
+        RTC_LOG(LS_INFO) << "Could not export buffer " << i
+                         << " as DMABUF. errno = " << errno;
+      }
+    }
+    buffers_.push_back({start, buffer.length, dmabuf_fd});
+
+    if (ioctl(device_fd_, VIDIOC_QBUF, &buffer) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void V4l2BufferPool::Stop() {
+  rtc::CritScope lock(&crit_);
+  stopped_ = true;
+}
+
+int V4l2BufferPool::NumOutstanding() const {
+  rtc::CritScope lock(&crit_);
+  return num_outstanding_;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> V4l2BufferPool::WrapBuffer(
+    int index,
+    size_t bytes_used,
+    int width,
+    int height,
+    VideoType video_type) {
+  RTC_DCHECK_LT(index, buffers_.size());
+  if (video_type != VideoType::kMJPEG &&
+      CalcBufferSize(video_type, width, height) != bytes_used) {
+    RTC_LOG(LS_ERROR) << "Wrong incoming frame length.";
+    rtc::CritScope lock(&crit_);
+    QueueBuffer(index);
+    return nullptr;
+  }
+  {
+    rtc::CritScope lock(&crit_);
+    ++num_outstanding_;
+  }
+  rtc::scoped_refptr<V4l2BufferPool> pool(this);
+  if (video_type == VideoType::kI420) {
+    const uint8_t* y_plane = static_cast<const uint8_t*>(buffers_[index].start);
+    const int stride_uv = (width + 1) / 2;
+    const uint8_t* u_plane = y_plane + width * height;
+    const uint8_t* v_plane = u_plane + stride_uv * ((height + 1) / 2);
+    return WrapI420Buffer(width, height, y_plane, width, u_plane, stride_uv,
+                          v_plane, stride_uv,
+                          [pool, index] { pool->Requeue(index); });
+  }
+  return new rtc::RefCountedObject<V4l2FrameBuffer>(pool, index, bytes_used,
+                                                    width, height, video_type);
+}
+
+void V4l2BufferPool::Requeue(int index) {
+  rtc::CritScope lock(&crit_);
+  RTC_DCHECK_GT(num_outstanding_, 0);
+  --num_outstanding_;
+  QueueBuffer(index);
+}
+
+void V4l2BufferPool::QueueBuffer(int index) {
+  // Hold |crit_| across the ioctl, so that Stop() returning guarantees that
+  // the device fd is no longer used.
+  if (stopped_)
+    return;
+  struct v4l2_buffer buffer;
+  memset(&buffer, 0, sizeof(v4l2_buffer));
+  buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  buffer.memory = V4L2_MEMORY_MMAP;
+  buffer.index = index;
+  if (ioctl(device_fd_, VIDIOC_QBUF, &buffer) == -1) {
+    RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+  }
+}
+
+V4l2FrameBuffer::V4l2FrameBuffer(rtc::scoped_refptr<V4l2BufferPool> pool,
+                                 int index,
+                                 size_t bytes_used,
+                                 int width,
+                                 int height,
+                                 VideoType video_type)
+    : pool_(std::move(pool)),
+      index_(index),
+      bytes_used_(bytes_used),
+      width_(width),
+      height_(height),
+      video_type_(video_type) {}
+
+V4l2FrameBuffer::~V4l2FrameBuffer() {
+  pool_->Requeue(index_);
+}
+
+VideoFrameBuffer::Type V4l2FrameBuffer::type() const {
+  return Type::kNative;
+}
+
+int V4l2FrameBuffer::width() const {
+  return width_;
+}
+
+int V4l2FrameBuffer::height() const {
+  return height_;
+}
+
+int V4l2FrameBuffer::dmabuf_fd() const {
+  return pool_->buffer(index_).dmabuf_fd;
+}
+
+const uint8_t* V4l2FrameBuffer::data() const {
+  return static_cast<const uint8_t*>(pool_->buffer(index_).start);
+}
+
+rtc::scoped_refptr<I420BufferInterface> V4l2FrameBuffer::ToI420() {
+  rtc::CritScope lock(&crit_);
+  if (i420_buffer_)
+    return i420_buffer_;
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+  const int conversion_result = libyuv::ConvertToI420(
+      data(), bytes_used_, buffer->MutableDataY(), buffer->StrideY(),
+      buffer->MutableDataU(), buffer->StrideU(), buffer->MutableDataV(),
+      buffer->StrideV(), 0, 0,  // No Cropping
+      width_, height_, width_, height_, libyuv::kRotate0,
+      ConvertVideoType(video_type_));
+  if (conversion_result < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to convert capture frame from type "
+                      << static_cast<int>(video_type_) << " to I420.";
+    return nullptr;
+  }
+  i420_buffer_ = buffer;
+  return i420_buffer_;
+}
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CAPTURE_LINUX_V4L2_BUFFER_POOL_H_
+#define MODULES_VIDEO_CAPTURE_LINUX_V4L2_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/video/video_frame_buffer.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+// The memory-mapped capture buffers of a V4L2 device. The pool is shared by
+// the capture module and the frames wrapping its buffers: a buffer handed out
+// in a frame is queued back to the driver only when the frame is released,
+// and the mappings stay valid until the last such frame is gone, even if the
+// capture has been stopped in the meantime.
+class V4l2BufferPool : public rtc::RefCountInterface {
+ public:
+  struct Buffer {
+    void* start;
+    size_t length;
+    // DMABUF file descriptor exported for the buffer, or -1.
+    int dmabuf_fd;
+  };
+
+  // |device_fd| is not owned, and must stay open until Stop() is called.
+  explicit V4l2BufferPool(int device_fd);
+
+  // Requests, maps and queues up to |count| buffers. With |export_dmabuf|,
+  // also exports each buffer as a DMABUF if the driver supports it.
+  bool Allocate(int count, bool export_dmabuf);
+
+  // Stops queueing released buffers back to the driver. Must be called before
+  // the device is closed.
+  void Stop();
+
+  size_t size() const { return buffers_.size(); }
+  const Buffer& buffer(int index) const { return buffers_[index]; }
+
+  // Number of dequeued buffers that are still referenced by frames.
+  int NumOutstanding() const;
+
+  // Wraps dequeued buffer |index| in a frame buffer without copying it. I420
+  // data is exposed as is, other formats are converted to I420 on first use.
+  // The buffer is queued back to the driver when the returned frame buffer is
+  // released. Returns null, and queues the buffer right away, if the data
+  // can not be wrapped.
+  rtc::scoped_refptr<VideoFrameBuffer> WrapBuffer(int index,
+                                                  size_t bytes_used,
+                                                  int width,
+                                                  int height,
+                                                  VideoType video_type);
+
+  // Queues buffer |index|, previously handed out by WrapBuffer(), back to the
+  // driver unless stopped.
+  void Requeue(int index);
+
+ protected:
+  ~V4l2BufferPool() override;
+
+ private:
+  void QueueBuffer(int index) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  const int device_fd_;
+  std::vector<Buffer> buffers_;
+  rtc::CriticalSection crit_;
+  bool stopped_ RTC_GUARDED_BY(crit_) = false;
+  int num_outstanding_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+// A frame buffer wrapping a V4L2 buffer in a format other than I420, such as
+// YUYV or MJPEG. The data is converted to I420 the first time it is needed,
+// so that frames dropped before encoding or rendering are never converted.
+class V4l2FrameBuffer : public VideoFrameBuffer {
+ public:
+  V4l2FrameBuffer(rtc::scoped_refptr<V4l2BufferPool> pool,
+                  int index,
+                  size_t bytes_used,
+                  int width,
+                  int height,
+                  VideoType video_type);
+
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+  // DMABUF file descriptor of the wrapped V4L2 buffer, or -1 if it was not
+  // exported. Valid for the lifetime of this object.
+  int dmabuf_fd() const;
+  const uint8_t* data() const;
+  size_t size() const { return bytes_used_; }
+  VideoType video_type() const { return video_type_; }
+
+ protected:
+  ~V4l2FrameBuffer() override;
+
+ private:
+  const rtc::scoped_refptr<V4l2BufferPool> pool_;
+  const int index_;
+  const size_t bytes_used_;
+  const int width_;
+  const int height_;
+  const VideoType video_type_;
+  rtc::CriticalSection crit_;
+  rtc::scoped_refptr<I420BufferInterface> i420_buffer_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CAPTURE_LINUX_V4L2_BUFFER_POOL_H_
@@ -25,12 +25,34 @@
 
 #include "media/base/videocommon.h"
 #include "modules/video_capture/video_capture.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/refcountedobject.h"
 #include "rtc_base/scoped_ref_ptr.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace videocapturemodule {
+namespace {
+
+struct ZeroCopyConfig {
+  bool enabled = false;
+  bool export_dmabuf = false;
+};
+
+ZeroCopyConfig GetZeroCopyConfig() {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialFlag dmabuf("dmabuf");
+  ParseFieldTrial({&enabled, &dmabuf},
+                  field_trial::FindFullName("WebRTC-V4L2ZeroCopyCapture"));
+  ZeroCopyConfig config;
+  config.enabled = enabled.Get();
+  config.export_dmabuf = enabled.Get() && dmabuf.Get();
+  return config;
+}
+
+}  // namespace
+
 rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
     const char* deviceUniqueId) {
   rtc::scoped_refptr<VideoCaptureModuleV4L2> implementation(
@@ -46,13 +68,13 @@ VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
     : VideoCaptureImpl(),
       _deviceId(-1),
       _deviceFd(-1),
-      _buffersAllocatedByDevice(-1),
+      _zeroCopy(GetZeroCopyConfig().enabled),
+      _exportDmabuf(GetZeroCopyConfig().export_dmabuf),
       _currentWidth(-1),
       _currentHeight(-1),
       _currentFrameRate(-1),
       _captureStarted(false),
-      _captureVideoType(VideoType::kI420),
-      _pool(NULL) {}
+      _captureVideoType(VideoType::kI420) {}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   int len = strlen((const char*)deviceUniqueIdUTF8);
@@ -281,61 +303,18 @@ int32_t VideoCaptureModuleV4L2::StopCapture() {
 // critical section protected by the caller
 
 bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
-  struct v4l2_requestbuffers rbuffer;
-  memset(&rbuffer, 0, sizeof(v4l2_requestbuffers));
-
-  rbuffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-  rbuffer.memory = V4L2_MEMORY_MMAP;
-  rbuffer.count = kNoOfV4L2Bufffers;
-
-  if (ioctl(_deviceFd, VIDIOC_REQBUFS, &rbuffer) < 0) {
-    RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = " << errno;
+  _pool = new rtc::RefCountedObject<V4l2BufferPool>(_deviceFd);
+  if (!_pool->Allocate(kNoOfV4L2Bufffers, _exportDmabuf)) {
+    _pool = nullptr;
     return false;
   }
-
-  if (rbuffer.count > kNoOfV4L2Bufffers)
-    rbuffer.count = kNoOfV4L2Bufffers;
-
-  _buffersAllocatedByDevice = rbuffer.count;
-
-  // Map the buffers
-  _pool = new Buffer[rbuffer.count];
-
-  for (unsigned int i = 0; i < rbuffer.count; i++) {
-    struct v4l2_buffer buffer;
-    memset(&buffer, 0, sizeof(v4l2_buffer));
-    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    buffer.memory = V4L2_MEMORY_MMAP;
-    buffer.index = i;
-
-    if (ioctl(_deviceFd, VIDIOC_QUERYBUF, &buffer) < 0) {
-      return false;
-    }
-
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
-
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
-      return false;
-    }
-
-    _pool[i].length = buffer.length;
-
-    if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
-      return false;
-    }
-  }
   return true;
 }
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
+  // Buffers still held by frames are unmapped when those are released.
+  _pool->Stop();
+  _pool = nullptr;
 
   // turn off stream
   enum v4l2_buf_type type;
@@ -397,12 +376,28 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
     frameInfo.height = _currentHeight;
     frameInfo.videoType = _captureVideoType;
 
-    // convert to to I420 if needed
-    IncomingFrame((unsigned char*)_pool[buf.index].start, buf.bytesused,
-                  frameInfo);
-    // enqueue the buffer again
-    if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
-      RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+    const V4l2BufferPool::Buffer& buffer = _pool->buffer(buf.index);
+    if (_zeroCopy) {
+      // The wrapped buffer returns to the driver once released. Copy instead
+      // if consumers already hold all but one buffer, so that capture never
+      // stalls on a frame that is kept around.
+      const bool copy =
+          _pool->NumOutstanding() + 1 >= static_cast<int>(_pool->size());
+      rtc::scoped_refptr<VideoFrameBuffer> frame_buffer = _pool->WrapBuffer(
+          buf.index, buf.bytesused, _currentWidth, _currentHeight,
+          _captureVideoType);
+      if (frame_buffer && (copy || !DeliverFrameBuffer(frame_buffer))) {
+        IncomingFrame(static_cast<unsigned char*>(buffer.start),
+                      buf.bytesused, frameInfo);
+      }
+    } else {
+      // convert to to I420 if needed
+      IncomingFrame(static_cast<unsigned char*>(buffer.start), buf.bytesused,
+                    frameInfo);
+      // enqueue the buffer again
+      if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
+        RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      }
     }
   }
   usleep(0);
@@ -16,10 +16,12 @@
 #include <memory>
 
 #include "common_types.h"  // NOLINT(build/include)
+#include "modules/video_capture/linux/v4l2_buffer_pool.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "modules/video_capture/video_capture_impl.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/platform_thread.h"
+#include "rtc_base/scoped_ref_ptr.h"
 
 namespace webrtc {
 namespace videocapturemodule {
@@ -48,17 +50,17 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t _deviceId;
   int32_t _deviceFd;
 
-  int32_t _buffersAllocatedByDevice;
+  // With "WebRTC-V4L2ZeroCopyCapture", dequeued buffers are delivered wrapped
+  // in frames instead of being converted and copied on the capture thread.
+  const bool _zeroCopy;
+  const bool _exportDmabuf;
+
   int32_t _currentWidth;
   int32_t _currentHeight;
   int32_t _currentFrameRate;
   bool _captureStarted;
   VideoType _captureVideoType;
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool;
+  rtc::scoped_refptr<V4l2BufferPool> _pool;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
@@ -205,6 +205,23 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   return 0;
 }
 
+bool VideoCaptureImpl::DeliverFrameBuffer(
+    const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+    int64_t captureTime /*=0*/) {
+  rtc::CritScope cs(&_apiCs);
+  if (apply_rotation_ && _rotateFrame != kVideoRotation_0)
+    return false;
+
+  TRACE_EVENT1("webrtc", "VC::DeliverFrameBuffer", "capture_time",
+               captureTime);
+  VideoFrame captureFrame(buffer, 0, rtc::TimeMillis(), _rotateFrame);
+  captureFrame.set_ntp_time_ms(captureTime);
+
+  DeliverCapturedFrame(captureFrame);
+
+  return true;
+}
+
 int32_t VideoCaptureImpl::StartCapture(
     const VideoCaptureCapability& capability) {
   _requestedCapability = capability;
@@ -88,6 +88,11 @@ class VideoCaptureImpl : public VideoCaptureModule,
   VideoCaptureImpl();
   ~VideoCaptureImpl() override;
   int32_t DeliverCapturedFrame(VideoFrame& captureFrame);
+  // Delivers a frame wrapping |buffer| as is. Returns false, without
+  // delivering anything, if the frame would have to be rotated by the capture
+  // module; the data must then go through IncomingFrame() instead.
+  bool DeliverFrameBuffer(const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
+                          int64_t captureTime = 0);
 
   char* _deviceUniqueId;  // current Device unique name;
   rtc::CriticalSection _apiCs;
@@ -11,6 +11,7 @@
 
 #include "modules/video_coding/codecs/h264/h264_encoder_impl.h"
 
+#include <algorithm>
 #include <limits>
 #include <string>
 
@@ -21,11 +22,14 @@
 
 #include "absl/strings/match.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "modules/video_coding/utility/encoder_thread_budget.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "modules/video_coding/utility/simulcast_utility.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/timeutils.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
@@ -47,21 +51,48 @@ enum H264EncoderImplEvent {
   kH264EncoderEventMax = 16,
 };
 
+// Enables multithreaded encoding, where each thread codes one slice of the
+// frame. Parameters:
+//  max_threads - upper limit on the threads of each layer.
+//  single_nal_unit - also use threads in packetization mode 0, where OpenH264
+//                    spreads its size-limited slices over the threads.
+const char kOpenH264SliceThreadingFieldTrial[] =
+    "WebRTC-OpenH264SliceThreading";
+
+struct SliceThreadingConfig {
+  bool enabled = false;
+  int max_threads = 8;
+  bool single_nal_unit = false;
+};
+
+SliceThreadingConfig GetSliceThreadingConfig() {
+  SliceThreadingConfig config;
+  const std::string trial_string =
+      field_trial::FindFullName(kOpenH264SliceThreadingFieldTrial);
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<int> max_threads("max_threads", config.max_threads);
+  FieldTrialParameter<bool> single_nal_unit("single_nal_unit",
+                                            config.single_nal_unit);
+  ParseFieldTrial({&enabled, &max_threads, &single_nal_unit}, trial_string);
+  config.enabled = enabled.Get();
+  config.max_threads = std::max(1, max_threads.Get());
+  config.single_nal_unit = single_nal_unit.Get();
+  return config;
+}
+
 int NumberOfThreads(int width, int height, int number_of_cores) {
   // TODO(hbos): In Chromium, multiple threads do not work with sandbox on Mac,
-  // see crbug.com/583348. Until further investigated, only use one thread.
-  //  if (width * height >= 1920 * 1080 && number_of_cores > 8) {
-  //    return 8;  // 8 threads for 1080p on high perf machines.
-  //  } else if (width * height > 1280 * 960 && number_of_cores >= 6) {
-  //    return 3;  // 3 threads for 1080p.
-  //  } else if (width * height > 640 * 480 && number_of_cores >= 3) {
-  //    return 2;  // 2 threads for qHD/HD.
-  //  } else {
-  //    return 1;  // 1 thread for VGA or less.
-  //  }
-  // TODO(sprang): Also check sSliceArgument.uiSliceNum om GetEncoderPrams(),
-  //               before enabling multithreading here.
-  return 1;
+  // see crbug.com/583348. Until further investigated, only use one thread
+  // unless slice threading is enabled by field trial.
+  if (width * height >= 1920 * 1080 && number_of_cores > 8) {
+    return 8;  // 8 threads for 1080p on high perf machines.
+  } else if (width * height > 1280 * 960 && number_of_cores >= 6) {
+    return 3;  // 3 threads for 1080p.
+  } else if (width * height > 640 * 480 && number_of_cores >= 3) {
+    return 2;  // 2 threads for qHD/HD.
+  } else {
+    return 1;  // 1 thread for VGA or less.
+  }
 }
 
 FrameType ConvertToVideoFrameType(EVideoFrameType type) {
@@ -93,9 +124,11 @@ FrameType ConvertToVideoFrameType(EVideoFrameType type) {
 // start codes) is copied to the |encoded_image->_buffer| and the |frag_header|
 // is updated to point to each fragment, with offsets and lengths set as to
 // exclude the start codes.
-static void RtpFragmentize(EncodedImage* encoded_image,
-                           std::unique_ptr<uint8_t[]>* encoded_image_buffer,
-                           const VideoFrameBuffer& frame_buffer,
+static void RtpFragmentize(
+    EncodedImage* encoded_image,
+    rtc::scoped_refptr<EncodedImageBuffer>* encoded_image_buffer,
+    EncodedImageBufferPool* encoded_image_buffer_pool,
+    const VideoFrameBuffer& frame_buffer,
                            SFrameBSInfo* info,
                            RTPFragmentationHeader* frag_header) {
   // Calculate minimum buffer size required to hold encoded data.
@@ -126,8 +159,12 @@ static void RtpFragmentize(EncodedImage* encoded_image,
           << ", encoded bytes: " << required_capacity << ".";
       new_capacity = required_capacity;
     }
-    encoded_image->set_buffer(new uint8_t[new_capacity], new_capacity);
-    encoded_image_buffer->reset(encoded_image->_buffer);
+    // Drop the old buffer first, so that the pool may reuse it.
+    *encoded_image_buffer = nullptr;
+    *encoded_image_buffer =
+        encoded_image_buffer_pool->CreateBuffer(new_capacity);
+    encoded_image->set_buffer((*encoded_image_buffer)->data(),
+                              (*encoded_image_buffer)->capacity());
   }
 
   // Iterate layers and NAL units, note each NAL unit as a fragment and copy
@@ -165,6 +202,7 @@ H264EncoderImpl::H264EncoderImpl(const cricket::VideoCodec& codec)
     : packetization_mode_(H264PacketizationMode::SingleNalUnit),
       max_payload_size_(0),
       number_of_cores_(0),
+      acquired_threads_(0),
       encoded_image_callback_(nullptr),
       has_reported_init_(false),
       has_reported_error_(false) {
@@ -271,6 +309,11 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
     configurations_[i].max_frame_rate = static_cast<float>(codec_.maxFramerate);
     configurations_[i].frame_dropping_on = codec_.H264()->frameDroppingOn;
     configurations_[i].key_frame_interval = codec_.H264()->keyFrameInterval;
+    // Layers are initialized from the highest resolution down, so that the
+    // top layer gets its threads first from the budget shared with other
+    // encoders.
+    configurations_[i].num_threads = AcquireThreads(
+        configurations_[i].width, configurations_[i].height);
 
     // Create downscaled image buffers.
     if (i > 0) {
@@ -303,8 +346,10 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
     const size_t new_capacity =
         CalcBufferSize(VideoType::kI420, codec_.simulcastStream[idx].width,
                        codec_.simulcastStream[idx].height);
-    encoded_images_[i].set_buffer(new uint8_t[new_capacity], new_capacity);
-    encoded_image_buffers_[i].reset(encoded_images_[i]._buffer);
+    encoded_image_buffers_[i] =
+        encoded_image_buffer_pool_.CreateBuffer(new_capacity);
+    encoded_images_[i].set_buffer(encoded_image_buffers_[i]->data(),
+                                  encoded_image_buffers_[i]->capacity());
     encoded_images_[i]._completeFrame = true;
     encoded_images_[i]._encodedWidth = codec_.simulcastStream[idx].width;
     encoded_images_[i]._encodedHeight = codec_.simulcastStream[idx].height;
@@ -328,6 +373,10 @@ int32_t H264EncoderImpl::Release() {
   }
   downscaled_buffers_.clear();
   configurations_.clear();
+  if (acquired_threads_ > 0) {
+    EncoderThreadBudget::Get()->Release(acquired_threads_);
+    acquired_threads_ = 0;
+  }
   encoded_images_.clear();
   encoded_image_buffers_.clear();
   pictures_.clear();
@@ -515,7 +564,8 @@ int32_t H264EncoderImpl::Encode(const VideoFrame& input_frame,
     // |encoded_image_|.
     RTPFragmentationHeader frag_header;
     RtpFragmentize(&encoded_images_[i], &encoded_image_buffers_[i],
-                   *frame_buffer, &info, &frag_header);
+                   &encoded_image_buffer_pool_, *frame_buffer, &info,
+                   &frag_header);
 
     // Encoder can skip frames to save bandwidth in which case
     // |encoded_images_[i]._length| == 0.
@@ -567,12 +617,11 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams(size_t i) const {
   // |keyFrameInterval| - number of frames
   encoder_params.uiIntraPeriod = configurations_[i].key_frame_interval;
   encoder_params.uiMaxNalSize = 0;
-  // Threading model: use auto.
+  // Threading model:
   //  0: auto (dynamic imp. internal encoder)
   //  1: single thread (default value)
   // >1: number of threads
-  encoder_params.iMultipleThreadIdc = NumberOfThreads(
-      encoder_params.iPicWidth, encoder_params.iPicHeight, number_of_cores_);
+  encoder_params.iMultipleThreadIdc = configurations_[i].num_threads;
   // The base spatial layer 0 is the only one we use.
   encoder_params.sSpatialLayers[0].iVideoWidth = encoder_params.iPicWidth;
   encoder_params.sSpatialLayers[0].iVideoHeight = encoder_params.iPicHeight;
@@ -596,10 +645,12 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams(size_t i) const {
       break;
     case H264PacketizationMode::NonInterleaved:
       // When uiSliceMode = SM_FIXEDSLCNUM_SLICE, uiSliceNum = 0 means auto
-      // design it with cpu core number.
+      // design it with cpu core number. Use one slice per thread, so that
+      // the threads encode in parallel.
       // TODO(sprang): Set to 0 when we understand why the rate controller borks
       //               when uiSliceNum > 1.
-      encoder_params.sSpatialLayers[0].sSliceArgument.uiSliceNum = 1;
+      encoder_params.sSpatialLayers[0].sSliceArgument.uiSliceNum =
+          configurations_[i].num_threads;
       encoder_params.sSpatialLayers[0].sSliceArgument.uiSliceMode =
           SM_FIXEDSLCNUM_SLICE;
       break;
@@ -607,6 +658,20 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams(size_t i) const {
   return encoder_params;
 }
 
+int H264EncoderImpl::AcquireThreads(int width, int height) {
+  const SliceThreadingConfig config = GetSliceThreadingConfig();
+  if (!config.enabled)
+    return 1;
+  if (packetization_mode_ == H264PacketizationMode::SingleNalUnit &&
+      !config.single_nal_unit) {
+    return 1;
+  }
+  const int threads = EncoderThreadBudget::Get()->Acquire(std::min(
+      config.max_threads, NumberOfThreads(width, height, number_of_cores_)));
+  acquired_threads_ += threads;
+  return threads;
+}
+
 void H264EncoderImpl::ReportInit() {
   if (has_reported_init_)
     return;
@@ -17,6 +17,7 @@
 
 #include "api/video/i420_buffer.h"
 #include "common_video/h264/h264_bitstream_parser.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
 #include "modules/video_coding/utility/quality_scaler.h"
 
@@ -39,6 +40,8 @@ class H264EncoderImpl : public H264Encoder {
     uint32_t max_bps = 0;
     bool frame_dropping_on = false;
     int key_frame_interval = 0;
+    // OpenH264 threads, each of which encodes one slice of the frame.
+    int num_threads = 1;
 
     void SetStreamState(bool send_stream);
   };
@@ -79,6 +82,9 @@ class H264EncoderImpl : public H264Encoder {
 
  private:
   SEncParamExt CreateEncoderParams(size_t i) const;
+  // Returns the number of threads to encode a layer of the given resolution
+  // with, taken from the thread budget shared by all encoders.
+  int AcquireThreads(int width, int height);
 
   webrtc::H264BitstreamParser h264_bitstream_parser_;
   // Reports statistics with histograms.
@@ -90,12 +96,15 @@ class H264EncoderImpl : public H264Encoder {
   std::vector<rtc::scoped_refptr<I420Buffer>> downscaled_buffers_;
   std::vector<LayerConfig> configurations_;
   std::vector<EncodedImage> encoded_images_;
-  std::vector<std::unique_ptr<uint8_t[]>> encoded_image_buffers_;
+  std::vector<rtc::scoped_refptr<EncodedImageBuffer>> encoded_image_buffers_;
+  EncodedImageBufferPool encoded_image_buffer_pool_;
 
   VideoCodec codec_;
   H264PacketizationMode packetization_mode_;
   size_t max_payload_size_;
   int32_t number_of_cores_;
+  // Threads acquired from EncoderThreadBudget for all layers.
+  int acquired_threads_;
   EncodedImageCallback* encoded_image_callback_;
 
   bool has_reported_init_;
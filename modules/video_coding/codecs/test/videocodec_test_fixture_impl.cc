@@ -509,6 +509,17 @@ void VideoCodecTestFixtureImpl::AnalyzeAllFrames(
     stats_.PrintFrameStatistics();
   }
 
+  if (!config_.frame_stats_csv_path.empty()) {
+    const std::string csv = stats_.FrameStatisticsToCsv();
+    rtc::File csv_file = rtc::File::Create(config_.frame_stats_csv_path);
+    RTC_CHECK(csv_file.IsOpen())
+        << "Failed to open " << config_.frame_stats_csv_path;
+    RTC_CHECK_EQ(csv.size(),
+                 csv_file.Write(reinterpret_cast<const uint8_t*>(csv.data()),
+                                csv.size()));
+    csv_file.Close();
+  }
+
   cpu_process_time_->Print();
   printf("\n");
 }
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/memory/memory.h"
@@ -18,6 +19,7 @@
 #include "media/engine/internaldecoderfactory.h"
 #include "media/engine/internalencoderfactory.h"
 #include "media/engine/simulcast_encoder_adapter.h"
+#include "modules/video_coding/codecs/test/videocodec_test_parallel.h"
 #include "modules/video_coding/utility/vp8_header_parser.h"
 #include "modules/video_coding/utility/vp9_uncompressed_header_parser.h"
 #include "test/gtest.h"
@@ -88,6 +90,26 @@ void PrintRdPerf(std::map<size_t, std::vector<VideoStatistics>> rd_stats) {
     }
   }
 }
+
+// Prints the encode and decode speed of each layer for two runs, |a| and |b|.
+void PrintSpeedComparison(const char* a_name,
+                          const std::vector<VideoStatistics>& a_stats,
+                          const char* b_name,
+                          const std::vector<VideoStatistics>& b_stats) {
+  printf("--> Speed, %s (a) vs %s (b)\n", a_name, b_name);
+  printf("%5s %6s %11s %12s %9s %9s %9s %9s %7s %7s\n", "width", "height",
+         "spatial_idx", "temporal_idx", "enc_fps_a", "enc_fps_b", "dec_fps_a",
+         "dec_fps_b", "psnr_a", "psnr_b");
+  const size_t num_layers = std::min(a_stats.size(), b_stats.size());
+  for (size_t i = 0; i < num_layers; ++i) {
+    const VideoStatistics& a = a_stats[i];
+    const VideoStatistics& b = b_stats[i];
+    printf("%5zu %6zu %11zu %12zu %9.2f %9.2f %9.2f %9.2f %7.2f %7.2f\n",
+           a.width, a.height, a.spatial_idx, a.temporal_idx, a.enc_speed_fps,
+           b.enc_speed_fps, a.dec_speed_fps, b.dec_speed_fps, a.avg_psnr,
+           b.avg_psnr);
+  }
+}
 }  // namespace
 
 #if defined(RTC_ENABLE_VP9)
@@ -460,6 +482,67 @@ TEST(VideoCodecTestLibvpx, DISABLED_MultiresVP8RdPerf) {
   PrintRdPerf(rd_stats);
 }
 
+// Compares the encode speed of simulcast with one libvpx multi-resolution
+// encoder, where each layer reuses the motion analysis of the layer below, to
+// simulcast with an independent encoder per layer.
+TEST(VideoCodecTestLibvpx, DISABLED_MultiresVP8EncodeSpeed) {
+  auto config = CreateConfig();
+  config.filename = "FourPeople_1280x720_30";
+  config.filepath = ResourcePath(config.filename, "yuv");
+  config.num_frames = 300;
+  config.SetCodecSettings(cricket::kVp8CodecName, 3, 1, 3, true, true, false,
+                          1280, 720);
+  std::vector<RateProfile> rate_profiles = {{1500, 30, config.num_frames}};
+
+  auto shared_fixture = CreateVideoCodecTestFixture(config);
+  shared_fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+  std::vector<VideoStatistics> shared_stats =
+      shared_fixture->GetStats().SliceAndCalcLayerVideoStatistic(
+          kNumFirstFramesToSkipAtRdPerfAnalysis, config.num_frames - 1);
+
+  InternalEncoderFactory internal_encoder_factory;
+  auto independent_fixture = CreateVideoCodecTestFixture(
+      config, absl::make_unique<InternalDecoderFactory>(),
+      absl::make_unique<FunctionVideoEncoderFactory>([&]() {
+        return absl::make_unique<SimulcastEncoderAdapter>(
+            &internal_encoder_factory, SdpVideoFormat(cricket::kVp8CodecName));
+      }));
+  independent_fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+  std::vector<VideoStatistics> independent_stats =
+      independent_fixture->GetStats().SliceAndCalcLayerVideoStatistic(
+          kNumFirstFramesToSkipAtRdPerfAnalysis, config.num_frames - 1);
+
+  EXPECT_EQ(shared_stats.size(), independent_stats.size());
+  PrintSpeedComparison("shared analysis", shared_stats, "independent encoders",
+                       independent_stats);
+}
+
+// Compares VP9 SVC encode and decode speed on one core to that with all
+// cores, which enables tiles and row-based multithreading.
+TEST(VideoCodecTestLibvpx, DISABLED_SvcVP9MultithreadedSpeed) {
+  auto config = CreateConfig();
+  config.filename = "FourPeople_1280x720_30";
+  config.filepath = ResourcePath(config.filename, "yuv");
+  config.num_frames = 300;
+  config.SetCodecSettings(cricket::kVp9CodecName, 1, 3, 3, true, true, false,
+                          1280, 720);
+  std::vector<RateProfile> rate_profiles = {{1500, 30, config.num_frames}};
+
+  std::vector<VideoStatistics> stats[2];
+  for (bool use_single_core : {true, false}) {
+    config.use_single_core = use_single_core;
+    auto fixture = CreateVideoCodecTestFixture(config);
+    fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+    stats[use_single_core ? 0 : 1] =
+        fixture->GetStats().SliceAndCalcLayerVideoStatistic(
+            kNumFirstFramesToSkipAtRdPerfAnalysis, config.num_frames - 1);
+  }
+
+  PrintSpeedComparison("single core", stats[0], "all cores", stats[1]);
+}
+
+// The bitrate points run in parallel, so the speed columns are not comparable
+// to a run of a single point.
 TEST(VideoCodecTestLibvpx, DISABLED_SvcVP9RdPerf) {
   auto config = CreateConfig();
   config.filename = "FourPeople_1280x720_30";
@@ -470,17 +553,20 @@ TEST(VideoCodecTestLibvpx, DISABLED_SvcVP9RdPerf) {
                           1280, 720);
   const auto frame_checker = absl::make_unique<QpFrameChecker>();
   config.encoded_frame_checker = frame_checker.get();
-  auto fixture = CreateVideoCodecTestFixture(config);
 
-  std::map<size_t, std::vector<VideoStatistics>> rd_stats;
+  std::vector<VideoCodecTestJob> jobs;
   for (size_t bitrate_kbps : kBitrateRdPerfKbps) {
-    std::vector<RateProfile> rate_profiles = {
-        {bitrate_kbps, 30, config.num_frames}};
-
-    fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+    VideoCodecTestJob job;
+    job.config = config;
+    job.rate_profiles = {{bitrate_kbps, 30, config.num_frames}};
+    jobs.push_back(job);
+  }
+  auto fixtures = RunVideoCodecTestsInParallel(jobs);
 
-    rd_stats[bitrate_kbps] =
-        fixture->GetStats().SliceAndCalcLayerVideoStatistic(
+  std::map<size_t, std::vector<VideoStatistics>> rd_stats;
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    rd_stats[jobs[i].rate_profiles[0].target_kbps] =
+        fixtures[i]->GetStats().SliceAndCalcLayerVideoStatistic(
             kNumFirstFramesToSkipAtRdPerfAnalysis, config.num_frames - 1);
   }
 
@@ -8,18 +8,27 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
+
+#include <string>
 #include <vector>
 
 #include "api/test/create_videocodec_test_fixture.h"
 #include "media/base/mediaconstants.h"
 #include "modules/video_coding/codecs/test/videocodec_test_fixture_impl.h"
+#include "rtc_base/checks.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 #include "test/testsupport/fileutils.h"
+#include "third_party/libyuv/include/libyuv/scale.h"
 
 namespace webrtc {
 namespace test {
 
 namespace {
+
+using VideoStatistics = VideoCodecTestStats::VideoStatistics;
+
 // Codec settings.
 const int kCifWidth = 352;
 const int kCifHeight = 288;
@@ -34,6 +43,82 @@ VideoCodecTestFixture::Config CreateConfig() {
   config.use_single_core = true;
   return config;
 }
+
+const char kSliceThreadingFieldTrial[] =
+    "WebRTC-OpenH264SliceThreading/Enabled/";
+const size_t kNumSpeedTestFrames = 300;
+const size_t kNumFirstFramesToSkip = 30;
+
+// Writes the first |num_frames| of the 720p clip |filename|, scaled to
+// |width|x|height|, to a temporary file and returns its path.
+std::string CreateScaledClip(const std::string& filename,
+                             int width,
+                             int height,
+                             size_t num_frames) {
+  const int kSrcWidth = 1280;
+  const int kSrcHeight = 720;
+  const size_t src_size = kSrcWidth * kSrcHeight * 3 / 2;
+  const size_t dst_size = width * height * 3 / 2;
+  std::vector<uint8_t> src(src_size);
+  std::vector<uint8_t> dst(dst_size);
+  const std::string path = TempFilename(OutputPath(), filename);
+  FILE* in = fopen(ResourcePath(filename, "yuv").c_str(), "rb");
+  FILE* out = fopen(path.c_str(), "wb");
+  RTC_CHECK(in);
+  RTC_CHECK(out);
+  for (size_t i = 0; i < num_frames; ++i) {
+    if (fread(src.data(), 1, src_size, in) != src_size) {
+      rewind(in);
+      RTC_CHECK_EQ(src_size, fread(src.data(), 1, src_size, in));
+    }
+    const uint8_t* src_u = src.data() + kSrcWidth * kSrcHeight;
+    const uint8_t* src_v = src_u + kSrcWidth * kSrcHeight / 4;
+    uint8_t* dst_u = dst.data() + width * height;
+    uint8_t* dst_v = dst_u + width * height / 4;
+    libyuv::I420Scale(src.data(), kSrcWidth, src_u, kSrcWidth / 2, src_v,
+                      kSrcWidth / 2, kSrcWidth, kSrcHeight, dst.data(), width,
+                      dst_u, width / 2, dst_v, width / 2, width, height,
+                      libyuv::kFilterBox);
+    RTC_CHECK_EQ(dst_size, fwrite(dst.data(), 1, dst_size, out));
+  }
+  fclose(in);
+  fclose(out);
+  return path;
+}
+
+// Encodes and decodes |filepath| at |width|x|height| on one core, and on all
+// cores with slice threading, and prints the speed per core of both.
+void RunSliceThreadingSpeedTest(const std::string& filepath,
+                                int width,
+                                int height) {
+  ScopedFieldTrials field_trials(kSliceThreadingFieldTrial);
+  auto config = CreateConfig();
+  config.filename = "FourPeople_1280x720_30";
+  config.filepath = filepath;
+  config.num_frames = kNumSpeedTestFrames;
+  config.SetCodecSettings(cricket::kH264CodecName, 1, 1, 1, false, false,
+                          false, width, height);
+  const size_t target_kbps = width * height >= 1920 * 1080 ? 4000 : 2000;
+  std::vector<RateProfile> rate_profiles = {
+      {target_kbps, 30, config.num_frames}};
+
+  printf("--> OpenH264 speed at %dx%d\n", width, height);
+  printf("%5s %9s %13s %9s %13s %7s %8s\n", "cores", "enc_fps",
+         "enc_fps/core", "dec_fps", "dec_fps/core", "psnr", "bitrate");
+  for (bool use_single_core : {true, false}) {
+    config.use_single_core = use_single_core;
+    auto fixture = CreateVideoCodecTestFixture(config);
+    fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+    const VideoStatistics stats =
+        fixture->GetStats().SliceAndCalcAggregatedVideoStatistic(
+            kNumFirstFramesToSkip, config.num_frames - 1);
+    const size_t cores = config.NumberOfCores();
+    printf("%5zu %9.2f %13.2f %9.2f %13.2f %7.2f %8zu\n", cores,
+           stats.enc_speed_fps, stats.enc_speed_fps / cores,
+           stats.dec_speed_fps, stats.dec_speed_fps / cores, stats.avg_psnr,
+           stats.bitrate_kbps);
+  }
+}
 }  // namespace
 
 TEST(VideoCodecTestOpenH264, ConstantHighBitrate) {
@@ -82,5 +167,19 @@ TEST(VideoCodecTestOpenH264, SingleNalUnit) {
                    &bs_thresholds);
 }
 
+// Encode speed per core at 720p and 1080p, without and with slice threading.
+// The 1080p clip is the 720p one, scaled up.
+TEST(VideoCodecTestOpenH264, DISABLED_SliceThreadingSpeed720p) {
+  RunSliceThreadingSpeedTest(ResourcePath("FourPeople_1280x720_30", "yuv"),
+                             1280, 720);
+}
+
+TEST(VideoCodecTestOpenH264, DISABLED_SliceThreadingSpeed1080p) {
+  const std::string filepath = CreateScaledClip(
+      "FourPeople_1280x720_30", 1920, 1080, kNumSpeedTestFrames);
+  RunSliceThreadingSpeedTest(filepath, 1920, 1080);
+  RemoveFile(filepath);
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/test/videocodec_test_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "absl/memory/memory.h"
+#include "modules/video_coding/codecs/test/videocodec_test_fixture_impl.h"
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+struct WorkerContext {
+  const std::vector<VideoCodecTestJob>* jobs;
+  std::vector<std::unique_ptr<VideoCodecTestFixture>>* fixtures;
+  std::atomic<size_t> next_job{0};
+};
+
+void RunJob(const VideoCodecTestJob& job, VideoCodecTestFixture* fixture) {
+  fixture->RunTest(
+      job.rate_profiles, job.rc_thresholds ? &*job.rc_thresholds : nullptr,
+      job.quality_thresholds ? &*job.quality_thresholds : nullptr,
+      job.bs_thresholds ? &*job.bs_thresholds : nullptr);
+}
+
+void RunWorker(void* obj) {
+  WorkerContext* context = static_cast<WorkerContext*>(obj);
+  for (size_t i = context->next_job++; i < context->jobs->size();
+       i = context->next_job++) {
+    RunJob((*context->jobs)[i], (*context->fixtures)[i].get());
+  }
+}
+
+}  // namespace
+
+std::vector<std::unique_ptr<VideoCodecTestFixture>>
+RunVideoCodecTestsInParallel(const std::vector<VideoCodecTestJob>& jobs,
+                             size_t max_concurrency) {
+  std::vector<std::unique_ptr<VideoCodecTestFixture>> fixtures;
+  for (const VideoCodecTestJob& job : jobs) {
+    fixtures.push_back(
+        absl::make_unique<VideoCodecTestFixtureImpl>(job.config));
+  }
+
+  if (max_concurrency == 0)
+    max_concurrency = std::max<size_t>(1, CpuInfo::DetectNumberOfCores());
+  const size_t num_workers = std::min(max_concurrency, jobs.size());
+
+  WorkerContext context;
+  context.jobs = &jobs;
+  context.fixtures = &fixtures;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> workers;
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers.push_back(absl::make_unique<rtc::PlatformThread>(
+        &RunWorker, &context, "VideoCodecTestWorker"));
+    workers.back()->Start();
+  }
+  for (auto& worker : workers)
+    worker->Stop();
+  return fixtures;
+}
+
+}  // namespace test
+}  // namespace webrtc
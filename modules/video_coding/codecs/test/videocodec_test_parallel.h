@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_PARALLEL_H_
+#define MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_PARALLEL_H_
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/test/videocodec_test_fixture.h"
+
+namespace webrtc {
+namespace test {
+
+// One point of a codec qualification sweep, e.g. a clip at a bitrate.
+struct VideoCodecTestJob {
+  VideoCodecTestFixture::Config config;
+  std::vector<RateProfile> rate_profiles;
+  // Thresholds are only verified if set.
+  absl::optional<std::vector<RateControlThresholds>> rc_thresholds;
+  absl::optional<std::vector<QualityThresholds>> quality_thresholds;
+  absl::optional<BitstreamThresholds> bs_thresholds;
+};
+
+// Runs |jobs| with at most |max_concurrency| jobs at a time, or one job per
+// core if |max_concurrency| is 0. Every job gets its own fixture and codec
+// task queue. Returns the fixtures in the order of |jobs|, so that the stats
+// of each job can be inspected with GetStats().
+// Jobs compete for cores, so encode times and CPU usage measured with
+// |measure_cpu| are only meaningful when jobs run one at a time.
+std::vector<std::unique_ptr<VideoCodecTestFixture>>
+RunVideoCodecTestsInParallel(const std::vector<VideoCodecTestJob>& jobs,
+                             size_t max_concurrency = 0);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_PARALLEL_H_
@@ -16,6 +16,7 @@
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
 #include "test/statistics.h"
 
 namespace webrtc {
@@ -105,6 +106,28 @@ void VideoCodecTestStatsImpl::PrintFrameStatistics() {
   }
 }
 
+std::string VideoCodecTestStatsImpl::FrameStatisticsToCsv() {
+  rtc::StringBuilder csv;
+  csv << "frame_number,spatial_idx,temporal_idx,frame_type,rtp_timestamp,"
+         "target_bitrate_kbps,length_bytes,qp,encode_time_us,decode_time_us,"
+         "decoded_width,decoded_height,psnr,psnr_y,psnr_u,psnr_v,ssim\n";
+  for (size_t frame_num = 0; frame_num < layer_stats_[0].size(); ++frame_num) {
+    for (const auto& it : layer_stats_) {
+      const FrameStatistics& frame_stat = it.second[frame_num];
+      csv << frame_stat.frame_number << "," << frame_stat.spatial_idx << ","
+          << frame_stat.temporal_idx << "," << frame_stat.frame_type << ","
+          << frame_stat.rtp_timestamp << "," << frame_stat.target_bitrate_kbps
+          << "," << frame_stat.length_bytes << "," << frame_stat.qp << ","
+          << frame_stat.encode_time_us << "," << frame_stat.decode_time_us
+          << "," << frame_stat.decoded_width << ","
+          << frame_stat.decoded_height << "," << frame_stat.psnr << ","
+          << frame_stat.psnr_y << "," << frame_stat.psnr_u << ","
+          << frame_stat.psnr_v << "," << frame_stat.ssim << "\n";
+    }
+  }
+  return csv.Release();
+}
+
 size_t VideoCodecTestStatsImpl::Size(size_t spatial_idx) {
   return layer_stats_[spatial_idx].size();
 }
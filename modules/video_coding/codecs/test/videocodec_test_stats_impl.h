@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "api/test/videocodec_test_stats.h"  // NOLINT(build/include)
@@ -44,6 +45,10 @@ class VideoCodecTestStatsImpl : public VideoCodecTestStats {
 
   void PrintFrameStatistics() override;
 
+  // Returns the statistics of all frames as CSV, with a header row followed by
+  // one row per frame and spatial layer.
+  std::string FrameStatisticsToCsv();
+
   size_t Size(size_t spatial_idx) override;
 
   void Clear() override;
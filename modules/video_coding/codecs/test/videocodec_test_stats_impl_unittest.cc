@@ -10,6 +10,9 @@
 
 #include "modules/video_coding/codecs/test/videocodec_test_stats_impl.h"
 
+#include <algorithm>
+#include <string>
+
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -55,5 +58,18 @@ TEST(StatsTest, AddFrameLayering) {
   }
 }
 
+TEST(StatsTest, FrameStatisticsToCsv) {
+  VideoCodecTestStatsImpl stats;
+  for (size_t i = 0; i < 2; ++i) {
+    stats.AddFrame(FrameStatistics(i, kTimestamp + i, 0));
+    stats.GetFrame(i, 0)->length_bytes = 1000 + i;
+  }
+  const std::string csv = stats.FrameStatisticsToCsv();
+  EXPECT_EQ(3, std::count(csv.begin(), csv.end(), '\n'));
+  EXPECT_EQ(0u, csv.find("frame_number,spatial_idx,"));
+  EXPECT_NE(std::string::npos, csv.find("\n1,0,0,"));
+  EXPECT_NE(std::string::npos, csv.find(",1001,"));
+}
+
 }  // namespace test
 }  // namespace webrtc
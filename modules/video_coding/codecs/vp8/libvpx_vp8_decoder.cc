@@ -24,6 +24,8 @@
 #include "modules/video_coding/codecs/vp8/libvpx_vp8_decoder.h"
 #include "modules/video_coding/include/video_error_codes.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/numerics/exp_filter.h"
 #include "rtc_base/scoped_ref_ptr.h"
 #include "rtc_base/timeutils.h"
@@ -44,6 +46,25 @@ constexpr long kDecodeDeadlineRealtime = 1;  // NOLINT
 
 const char kVp8PostProcArmFieldTrial[] = "WebRTC-VP8-Postproc-Config-Arm";
 
+// Max number of decoded frames that can be pending in the application before
+// new frames are dropped. Configurable through the field trial
+// "WebRTC-VP8-DecoderBufferPool/max_buffers:N/".
+constexpr int kDefaultMaxNumberOfBuffers = 300;
+const char kVp8DecoderBufferPoolFieldTrial[] = "WebRTC-VP8-DecoderBufferPool";
+
+size_t GetMaxNumberOfBuffers() {
+  FieldTrialParameter<int> max_buffers("max_buffers",
+                                       kDefaultMaxNumberOfBuffers);
+  ParseFieldTrial({&max_buffers},
+                  field_trial::FindFullName(kVp8DecoderBufferPoolFieldTrial));
+  if (max_buffers.Get() <= 0) {
+    RTC_LOG(LS_WARNING) << "Invalid max number of VP8 decoder buffers: "
+                        << max_buffers.Get();
+    return kDefaultMaxNumberOfBuffers;
+  }
+  return max_buffers.Get();
+}
+
 void GetPostProcParamsFromFieldTrialGroup(
     LibvpxVp8Decoder::DeblockParams* deblock_params) {
   std::string group =
@@ -98,7 +119,7 @@ class LibvpxVp8Decoder::QpSmoother {
 LibvpxVp8Decoder::LibvpxVp8Decoder()
     : use_postproc_arm_(
           webrtc::field_trial::IsEnabled(kVp8PostProcArmFieldTrial)),
-      buffer_pool_(false, 300 /* max_number_of_buffers*/),
+      buffer_pool_(false, GetMaxNumberOfBuffers()),
       decode_complete_callback_(NULL),
       inited_(false),
       decoder_(NULL),
@@ -106,6 +127,8 @@ LibvpxVp8Decoder::LibvpxVp8Decoder()
       last_frame_width_(0),
       last_frame_height_(0),
       key_frame_required_(true),
+      num_returned_frames_(0),
+      num_pool_exhausted_frames_(0),
       qp_smoother_(use_postproc_arm_ ? new QpSmoother() : nullptr) {
   if (use_postproc_arm_)
     GetPostProcParamsFromFieldTrialGroup(&deblock_);
@@ -304,10 +327,14 @@ int LibvpxVp8Decoder::ReturnFrame(const vpx_image_t* img,
   // Allocate memory for decoded image.
   rtc::scoped_refptr<I420Buffer> buffer =
       buffer_pool_.CreateBuffer(img->d_w, img->d_h);
+  ++num_returned_frames_;
   if (!buffer.get()) {
     // Pool has too many pending frames.
     RTC_HISTOGRAM_BOOLEAN("WebRTC.Video.LibvpxVp8Decoder.TooManyPendingFrames",
                           1);
+    if (num_pool_exhausted_frames_++ == 0) {
+      RTC_LOG(LS_WARNING) << "Decoder buffer pool exhausted, dropping frame.";
+    }
     return WEBRTC_VIDEO_CODEC_NO_OUTPUT;
   }
 
@@ -349,6 +376,17 @@ int LibvpxVp8Decoder::Release() {
     decoder_ = NULL;
   }
   buffer_pool_.Release();
+  if (num_returned_frames_ > 0) {
+    RTC_HISTOGRAM_COUNTS_1000(
+        "WebRTC.Video.LibvpxVp8Decoder.PoolExhaustedFramesPerMille",
+        static_cast<int>(num_pool_exhausted_frames_ * 1000 /
+                         num_returned_frames_));
+    RTC_LOG(LS_INFO) << "VP8 decoder dropped " << num_pool_exhausted_frames_
+                     << " of " << num_returned_frames_
+                     << " frames due to buffer pool exhaustion.";
+  }
+  num_returned_frames_ = 0;
+  num_pool_exhausted_frames_ = 0;
   inited_ = false;
   return ret_val;
 }
@@ -65,6 +65,10 @@ class LibvpxVp8Decoder : public VideoDecoder {
   int last_frame_width_;
   int last_frame_height_;
   bool key_frame_required_;
+  // Decoded frames since InitDecode, and how many of them were dropped because
+  // |buffer_pool_| had no free buffer.
+  int64_t num_returned_frames_;
+  int64_t num_pool_exhausted_frames_;
   DeblockParams deblock_;
   const std::unique_ptr<QpSmoother> qp_smoother_;
 };
@@ -27,11 +27,13 @@
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/codecs/vp8/libvpx_vp8_encoder.h"
 #include "modules/video_coding/include/video_error_codes.h"
+#include "modules/video_coding/utility/encoder_thread_budget.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "modules/video_coding/utility/simulcast_utility.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/timeutils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/field_trial.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
@@ -41,6 +43,7 @@ namespace webrtc {
 namespace {
 const char kVp8TrustedRateControllerFieldTrial[] =
     "WebRTC-LibvpxVp8TrustedRateController";
+const char kVp8AdaptiveSpeedFieldTrial[] = "WebRTC-LibvpxVp8AdaptiveSpeed";
 #if defined(WEBRTC_IOS)
 const char kVP8IosMaxNumberOfThreadFieldTrial[] =
     "WebRTC-VP8IosMaxNumberOfThread";
@@ -52,6 +55,16 @@ const char kVP8IosMaxNumberOfThreadFieldTrialParameter[] = "max_thread";
 constexpr int kLowVp8QpThreshold = 29;
 constexpr int kHighVp8QpThreshold = 95;
 
+// Adaptive speed: the share of the frame interval spent encoding, averaged
+// over a window of frames, is kept between these limits by changing the
+// speed offset.
+constexpr int kSpeedWindowFrames = 30;
+constexpr int kHighEncodeUsagePercent = 85;
+constexpr int kLowEncodeUsagePercent = 50;
+constexpr int kMaxSpeedOffset = 6;
+// Fastest setting of VP8E_SET_CPUUSED.
+constexpr int kMaxCpuSpeed = -16;
+
 constexpr int kTokenPartitions = VP8_ONE_TOKENPARTITION;
 constexpr uint32_t kVp832ByteAlign = 32u;
 
@@ -164,17 +177,23 @@ LibvpxVp8Encoder::LibvpxVp8Encoder(std::unique_ptr<LibvpxInterface> interface)
       experimental_cpu_speed_config_arm_(CpuSpeedExperiment::GetConfigs()),
       trusted_rate_controller_(
           field_trial::IsEnabled(kVp8TrustedRateControllerFieldTrial)),
+      adaptive_speed_(field_trial::IsEnabled(kVp8AdaptiveSpeedFieldTrial)),
       encoded_complete_callback_(nullptr),
       inited_(false),
       timestamp_(0),
       qp_max_(56),  // Setting for max quantizer.
       cpu_speed_default_(-6),
       number_of_cores_(0),
+      acquired_threads_(0),
+      speed_offset_(0),
+      window_encode_time_us_(0),
+      window_frames_(0),
       rc_max_intra_target_(0),
       key_frame_request_(kMaxSimulcastStreams, false) {
   temporal_layers_.reserve(kMaxSimulcastStreams);
   raw_images_.reserve(kMaxSimulcastStreams);
   encoded_images_.reserve(kMaxSimulcastStreams);
+  encoded_image_buffers_.reserve(kMaxSimulcastStreams);
   send_stream_.reserve(kMaxSimulcastStreams);
   cpu_speed_.assign(kMaxSimulcastStreams, cpu_speed_default_);
   encoders_.reserve(kMaxSimulcastStreams);
@@ -189,11 +208,8 @@ LibvpxVp8Encoder::~LibvpxVp8Encoder() {
 int LibvpxVp8Encoder::Release() {
   int ret_val = WEBRTC_VIDEO_CODEC_OK;
 
-  while (!encoded_images_.empty()) {
-    EncodedImage& image = encoded_images_.back();
-    delete[] image._buffer;
-    encoded_images_.pop_back();
-  }
+  encoded_images_.clear();
+  encoded_image_buffers_.clear();
   while (!encoders_.empty()) {
     vpx_codec_ctx_t& encoder = encoders_.back();
     if (inited_) {
@@ -211,6 +227,10 @@ int LibvpxVp8Encoder::Release() {
     raw_images_.pop_back();
   }
   temporal_layers_.clear();
+  if (acquired_threads_ > 0) {
+    EncoderThreadBudget::Get()->Release(acquired_threads_);
+    acquired_threads_ = 0;
+  }
   inited_ = false;
   return ret_val;
 }
@@ -358,6 +378,7 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   }
 
   encoded_images_.resize(number_of_streams);
+  encoded_image_buffers_.resize(number_of_streams);
   encoders_.resize(number_of_streams);
   configurations_.resize(number_of_streams);
   downsampling_factors_.resize(number_of_streams);
@@ -365,6 +386,9 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   send_stream_.resize(number_of_streams);
   send_stream_[0] = true;  // For non-simulcast case.
   cpu_speed_.resize(number_of_streams);
+  speed_offset_ = 0;
+  window_encode_time_us_ = 0;
+  window_frames_ = 0;
   std::fill(key_frame_request_.begin(), key_frame_request_.end(), false);
 
   int idx = number_of_streams - 1;
@@ -381,13 +405,14 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
     downsampling_factors_[number_of_streams - 1].den = 1;
   }
   for (int i = 0; i < number_of_streams; ++i) {
-    // allocate memory for encoded image
-    if (encoded_images_[i]._buffer != NULL) {
-      delete[] encoded_images_[i]._buffer;
-    }
+    // allocate memory for encoded image, reusing buffers released by a
+    // previous InitEncode() when possible.
     size_t frame_capacity =
         CalcBufferSize(VideoType::kI420, codec_.width, codec_.height);
-    encoded_images_[i].set_buffer(new uint8_t[frame_capacity], frame_capacity);
+    encoded_image_buffers_[i] =
+        encoded_image_buffer_pool_.CreateBuffer(frame_capacity);
+    encoded_images_[i].set_buffer(encoded_image_buffers_[i]->data(),
+                                  encoded_image_buffers_[i]->capacity());
     encoded_images_[i]._completeFrame = true;
   }
   // populate encoder configuration with default values
@@ -459,10 +484,11 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   configurations_[0].g_w = inst->width;
   configurations_[0].g_h = inst->height;
 
-  // Determine number of threads based on the image size and #cores.
-  // TODO(fbarchard): Consider number of Simulcast layers.
-  configurations_[0].g_threads = NumberOfThreads(
-      configurations_[0].g_w, configurations_[0].g_h, number_of_cores);
+  // Determine number of threads based on the image size and #cores, within
+  // the budget shared with other encoders. Layers are initialized from the
+  // highest resolution down, so that the top layer gets its threads first.
+  configurations_[0].g_threads =
+      AcquireThreads(configurations_[0].g_w, configurations_[0].g_h);
 
   // Creating a wrapper to the image - setting image data to NULL.
   // Actual pointer will be set in encode. Setting align to 1, as it
@@ -499,8 +525,8 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
     configurations_[i].g_w = inst->simulcastStream[stream_idx].width;
     configurations_[i].g_h = inst->simulcastStream[stream_idx].height;
 
-    // Use 1 thread for lower resolutions.
-    configurations_[i].g_threads = 1;
+    configurations_[i].g_threads =
+        AcquireThreads(configurations_[i].g_w, configurations_[i].g_h);
 
     configurations_[i].rc_dropframe_thresh = FrameDropThreshold(stream_idx);
 
@@ -556,6 +582,42 @@ int LibvpxVp8Encoder::GetCpuSpeed(int width, int height) {
 #endif
 }
 
+int LibvpxVp8Encoder::AcquireThreads(int width, int height) {
+  const int threads = EncoderThreadBudget::Get()->Acquire(
+      NumberOfThreads(width, height, number_of_cores_));
+  acquired_threads_ += threads;
+  return threads;
+}
+
+void LibvpxVp8Encoder::UpdateSpeedOffset(int64_t encode_time_us) {
+  window_encode_time_us_ += encode_time_us;
+  if (++window_frames_ < kSpeedWindowFrames)
+    return;
+  const int64_t average_encode_time_us =
+      window_encode_time_us_ / window_frames_;
+  const int64_t frame_interval_us =
+      rtc::kNumMicrosecsPerSec / std::max<uint32_t>(codec_.maxFramerate, 1);
+  window_encode_time_us_ = 0;
+  window_frames_ = 0;
+
+  int speed_offset = speed_offset_;
+  if (average_encode_time_us * 100 >
+      frame_interval_us * kHighEncodeUsagePercent) {
+    speed_offset = std::min(speed_offset + 1, kMaxSpeedOffset);
+  } else if (average_encode_time_us * 100 <
+             frame_interval_us * kLowEncodeUsagePercent) {
+    speed_offset = std::max(speed_offset - 1, 0);
+  }
+  if (speed_offset == speed_offset_)
+    return;
+  speed_offset_ = speed_offset;
+  for (size_t i = 0; i < encoders_.size(); ++i) {
+    libvpx_->codec_control(
+        &encoders_[i], VP8E_SET_CPUUSED,
+        std::max(kMaxCpuSpeed, cpu_speed_[i] - speed_offset_));
+  }
+}
+
 int LibvpxVp8Encoder::NumberOfThreads(int width, int height, int cpus) {
 #if defined(WEBRTC_ANDROID)
   if (width * height >= 320 * 180) {
@@ -610,6 +672,10 @@ int LibvpxVp8Encoder::InitAndSetControlSettings() {
   flags |= VPX_CODEC_USE_OUTPUT_PARTITION;
 
   if (encoders_.size() > 1) {
+    // A multi-resolution encoder encodes the layers from the lowest
+    // resolution up, and reuses the motion analysis of each layer as a
+    // starting point for the next higher one. See
+    // VideoCodecTestLibvpx.DISABLED_MultiresVP8EncodeSpeed for the savings.
     int error = libvpx_->codec_enc_init_multi(
         &encoders_[0], vpx_codec_vp8_cx(), &configurations_[0],
         encoders_.size(), flags, &downsampling_factors_[0]);
@@ -725,7 +791,15 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
   raw_images_[0].stride[VPX_PLANE_U] = input_image->StrideU();
   raw_images_[0].stride[VPX_PLANE_V] = input_image->StrideV();
 
+  // |raw_images_| go from highest to lowest resolution. Images below the
+  // lowest resolution stream that is sent are not needed, since libvpx skips
+  // encoding streams without target bitrate.
+  size_t num_images = 1;
   for (size_t i = 1; i < encoders_.size(); ++i) {
+    if (send_stream_[encoders_.size() - 1 - i])
+      num_images = i + 1;
+  }
+  for (size_t i = 1; i < num_images; ++i) {
     // Scale the image down a number of times by downsampling factor
     libyuv::I420Scale(
         raw_images_[i - 1].planes[VPX_PLANE_Y],
@@ -820,6 +894,7 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
 
   int error = WEBRTC_VIDEO_CODEC_OK;
   int num_tries = 0;
+  int64_t encode_time_us = 0;
   // If the first try returns WEBRTC_VIDEO_CODEC_TARGET_BITRATE_OVERSHOOT
   // the frame must be reencoded with the same parameters again because
   // target bitrate is exceeded and encoder state has been reset.
@@ -830,8 +905,10 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     // Note we must pass 0 for |flags| field in encode call below since they are
     // set above in |libvpx_interface_->vpx_codec_control_| function for each
     // encoder/spatial layer.
+    const int64_t encode_start_us = rtc::TimeMicros();
     error = libvpx_->codec_encode(&encoders_[0], &raw_images_[0], timestamp_,
                                   duration, 0, VPX_DL_REALTIME);
+    encode_time_us += rtc::TimeMicros() - encode_start_us;
     // Reset specific intra frame thresholds, following the key frame.
     if (send_key_frame) {
       libvpx_->codec_control(&(encoders_[0]), VP8E_SET_MAX_INTRA_BITRATE_PCT,
@@ -844,6 +921,8 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
   }
   // TODO(sprang): Shouldn't we use the frame timestamp instead?
   timestamp_ += duration;
+  if (adaptive_speed_)
+    UpdateSpeedOffset(encode_time_us);
   return error;
 }
 
@@ -882,11 +961,13 @@ int LibvpxVp8Encoder::GetEncodedPartitions(const VideoFrame& input_image) {
           size_t length = encoded_images_[encoder_idx]._length;
           if (pkt->data.frame.sz + length >
               encoded_images_[encoder_idx].capacity()) {
-            uint8_t* buffer = new uint8_t[pkt->data.frame.sz + length];
-            memcpy(buffer, encoded_images_[encoder_idx]._buffer, length);
-            delete[] encoded_images_[encoder_idx]._buffer;
+            encoded_image_buffers_[encoder_idx] =
+                encoded_image_buffer_pool_.GrowBuffer(
+                    encoded_image_buffers_[encoder_idx], length,
+                    pkt->data.frame.sz + length);
             encoded_images_[encoder_idx].set_buffer(
-                buffer, pkt->data.frame.sz + length);
+                encoded_image_buffers_[encoder_idx]->data(),
+                encoded_image_buffers_[encoder_idx]->capacity());
           }
           memcpy(&encoded_images_[encoder_idx]._buffer[length],
                  pkt->data.frame.buf, pkt->data.frame.sz);
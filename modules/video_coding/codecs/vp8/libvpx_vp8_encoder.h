@@ -19,6 +19,7 @@
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp8_temporal_layers.h"
 #include "common_types.h"  // NOLINT(build/include)
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/codecs/vp8/libvpx_interface.h"
 #include "modules/video_coding/include/video_codec_interface.h"
@@ -82,11 +83,19 @@ class LibvpxVp8Encoder : public VideoEncoder {
 
   uint32_t FrameDropThreshold(size_t spatial_idx) const;
 
+  // Acquires threads for a layer from the process-wide thread budget.
+  int AcquireThreads(int width, int height);
+
+  // Speeds up the encoder when encoding takes too large a share of the frame
+  // interval, and slows it down again when there is headroom.
+  void UpdateSpeedOffset(int64_t encode_time_us);
+
   const std::unique_ptr<LibvpxInterface> libvpx_;
 
   const absl::optional<std::vector<CpuSpeedExperiment::Config>>
       experimental_cpu_speed_config_arm_;
   const bool trusted_rate_controller_;
+  const bool adaptive_speed_;
 
   EncodedImageCallback* encoded_complete_callback_;
   VideoCodec codec_;
@@ -95,6 +104,12 @@ class LibvpxVp8Encoder : public VideoEncoder {
   int qp_max_;
   int cpu_speed_default_;
   int number_of_cores_;
+  // Threads acquired from EncoderThreadBudget for all layers.
+  int acquired_threads_;
+  // Added to the magnitude of |cpu_speed_| by UpdateSpeedOffset().
+  int speed_offset_;
+  int64_t window_encode_time_us_;
+  int window_frames_;
   uint32_t rc_max_intra_target_;
   std::vector<std::unique_ptr<Vp8TemporalLayers>> temporal_layers_;
   std::vector<bool> key_frame_request_;
@@ -102,6 +117,9 @@ class LibvpxVp8Encoder : public VideoEncoder {
   std::vector<int> cpu_speed_;
   std::vector<vpx_image_t> raw_images_;
   std::vector<EncodedImage> encoded_images_;
+  // Backing storage for |encoded_images_|.
+  std::vector<rtc::scoped_refptr<EncodedImageBuffer>> encoded_image_buffers_;
+  EncodedImageBufferPool encoded_image_buffer_pool_;
   std::vector<vpx_codec_ctx_t> encoders_;
   std::vector<vpx_codec_enc_cfg_t> configurations_;
   std::vector<vpx_rational_t> downsampling_factors_;
@@ -19,10 +19,12 @@
 #include "common_video/test/utilities.h"
 #include "modules/video_coding/codecs/test/video_codec_unittest.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
+#include "modules/video_coding/codecs/vp8/libvpx_vp8_decoder.h"
 #include "modules/video_coding/codecs/vp8/libvpx_vp8_encoder.h"
 #include "modules/video_coding/codecs/vp8/test/mock_libvpx_interface.h"
 #include "modules/video_coding/utility/vp8_header_parser.h"
 #include "rtc_base/timeutils.h"
+#include "test/field_trial.h"
 #include "test/video_codec_settings.h"
 
 namespace webrtc {
@@ -234,6 +236,44 @@ TEST_F(TestVp8Impl, DecodedColorSpaceEqualsEncodedColorSpace) {
   EXPECT_EQ(color_space, *decoded_frame->color_space());
 }
 
+TEST_F(TestVp8Impl, DecoderDropsFramesWhenBufferPoolIsExhausted) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-VP8-DecoderBufferPool/max_buffers:1/");
+  LibvpxVp8Decoder decoder;
+  NiceMock<MockDecodedImageCallback> callback;
+  std::vector<VideoFrame> pending_frames;
+  EXPECT_CALL(callback, Decoded(_, _, _))
+      .WillRepeatedly(Invoke([&pending_frames](VideoFrame& frame,
+                                               absl::optional<int32_t>,
+                                               absl::optional<uint8_t>) {
+        pending_frames.push_back(frame);
+      }));
+  decoder.RegisterDecodeCompleteCallback(&callback);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder.InitDecode(&codec_settings_, 1));
+
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  EncodeAndWaitForFrame(*NextInputFrame(), &encoded_frame, &codec_specific_info,
+                        /*keyframe=*/true);
+  encoded_frame._frameType = kVideoFrameKey;
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder.Decode(encoded_frame, false, nullptr, -1));
+  ASSERT_EQ(1u, pending_frames.size());
+
+  // The only buffer is still held by the application.
+  EncodeAndWaitForFrame(*NextInputFrame(), &encoded_frame, &codec_specific_info);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_NO_OUTPUT,
+            decoder.Decode(encoded_frame, false, nullptr, -1));
+  EXPECT_EQ(1u, pending_frames.size());
+
+  // Once it is returned the pool can be used again.
+  pending_frames.clear();
+  EncodeAndWaitForFrame(*NextInputFrame(), &encoded_frame, &codec_specific_info);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder.Decode(encoded_frame, false, nullptr, -1));
+  EXPECT_EQ(1u, pending_frames.size());
+}
+
 TEST_F(TestVp8Impl, ChecksSimulcastSettings) {
   codec_settings_.numberOfSimulcastStreams = 2;
   // Reslutions are not scaled by 2, temporal layers do not match.
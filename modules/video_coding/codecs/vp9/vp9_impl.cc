@@ -541,7 +541,12 @@ int VP9EncoderImpl::NumberOfThreads(int width,
                                     int number_of_cores) {
   // Keep the number of encoder threads equal to the possible number of column
   // tiles, which is (1, 2, 4, 8). See comments below for VP9E_SET_TILE_COLUMNS.
-  if (width * height >= 1280 * 720 && number_of_cores > 4) {
+  // The resolution is that of the top spatial layer, which dominates the
+  // encode time. With row-based multithreading, 1080p and above can use more
+  // threads than it has tile columns.
+  if (width * height >= 1920 * 1080 && number_of_cores > 8) {
+    return 8;
+  } else if (width * height >= 1280 * 720 && number_of_cores > 4) {
     return 4;
   } else if (width * height >= 640 * 360 && number_of_cores > 2) {
     return 2;
@@ -678,7 +683,10 @@ int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
   // log2 unit: e.g., 0 = 1 tile column, 1 = 2 tile columns, 2 = 4 tile columns.
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
-  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, (config_->g_threads >> 1));
+  int log2_tile_columns = 0;
+  while ((2u << log2_tile_columns) <= config_->g_threads)
+    ++log2_tile_columns;
+  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, log2_tile_columns);
 
   // Turn on row-based multithreading.
   vpx_codec_control(encoder_, VP9E_SET_ROW_MT, 1);
@@ -1398,6 +1406,12 @@ int VP9DecoderImpl::InitDecode(const VideoCodec* inst, int number_of_cores) {
     return WEBRTC_VIDEO_CODEC_MEMORY;
   }
 
+#if defined(VPX_CTRL_VP9D_SET_ROW_MT)
+  // Decode the rows of each tile in parallel too, so that streams with few
+  // tile columns still use the decoder threads.
+  vpx_codec_control(decoder_, VP9D_SET_ROW_MT, 1);
+#endif
+
   if (!frame_buffer_pool_.InitializeVpxUsePool(decoder_)) {
     return WEBRTC_VIDEO_CODEC_MEMORY;
   }
@@ -62,6 +62,7 @@ FrameBuffer::FrameBuffer(Clock* clock,
       num_frames_buffered_(0),
       stopped_(false),
       protection_mode_(kProtectionNack),
+      decode_ahead_ms_(0),
       stats_callback_(stats_callback),
       last_log_non_decoded_ms_(-kLogNonDecodedIntervalMs) {}
 
@@ -92,28 +93,13 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
       // acquire the lock unnecessarily.
       frames_to_decode_.clear();
 
-      // |frame_it| points to the first frame after the
-      // |last_decoded_frame_it_|.
-      auto frame_it = frames_.end();
-      if (last_decoded_frame_it_ == frames_.end()) {
-        frame_it = frames_.begin();
-      } else {
-        frame_it = last_decoded_frame_it_;
-        ++frame_it;
-      }
-
-      // |continuous_end_it| points to the first frame after the
-      // |last_continuous_frame_it_|.
-      auto continuous_end_it = last_continuous_frame_it_;
-      if (continuous_end_it != frames_.end())
-        ++continuous_end_it;
-
-      for (; frame_it != continuous_end_it && frame_it != frames_.end();
-           ++frame_it) {
-        if (!frame_it->second.continuous ||
-            frame_it->second.num_missing_decodable > 0) {
-          continue;
-        }
+      // Only continuous frames with all their references decoded can start a
+      // superframe, and |decodable_frames_| holds exactly those in order.
+      for (const VideoLayerFrameId& id : decodable_frames_) {
+        auto frame_it = frames_.find(id);
+        RTC_DCHECK(frame_it != frames_.end());
+        RTC_DCHECK(frame_it->second.continuous);
+        RTC_DCHECK_EQ(frame_it->second.num_missing_decodable, 0U);
 
         EncodedFrame* frame = frame_it->second.frame.get();
 
@@ -179,6 +165,13 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
           frame->SetRenderTime(
               timing_->RenderTimeMs(frame->Timestamp(), now_ms));
         }
+        // A zero render time means the sender asked for a zero playout delay,
+        // so the frame is rendered as soon as it is decoded. There is no
+        // deadline to miss, and no reason to skip ahead to a later frame.
+        if (frame->RenderTime() == 0) {
+          wait_ms = 0;
+          break;
+        }
         wait_ms = timing_->MaxWaitingTime(frame->RenderTime(), now_ms);
 
         // This will cause the frame buffer to prefer high framerate rather
@@ -189,6 +182,7 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
         if (wait_ms < -kMaxAllowedFrameDelayMs)
           continue;
 
+        wait_ms -= decode_ahead_ms_;
         break;
       }
     }  // rtc::Critscope lock(&crit_);
@@ -295,6 +289,13 @@ void FrameBuffer::SetProtectionMode(VCMVideoProtection mode) {
   protection_mode_ = mode;
 }
 
+void FrameBuffer::SetDecodeAheadMs(int64_t decode_ahead_ms) {
+  TRACE_EVENT0("webrtc", "FrameBuffer::SetDecodeAheadMs");
+  RTC_DCHECK_GE(decode_ahead_ms, 0);
+  rtc::CritScope lock(&crit_);
+  decode_ahead_ms_ = decode_ahead_ms;
+}
+
 void FrameBuffer::Start() {
   TRACE_EVENT0("webrtc", "FrameBuffer::Start");
   rtc::CritScope lock(&crit_);
@@ -476,6 +477,7 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
 
     if (last_continuous_frame_it_->first < frame->first)
       last_continuous_frame_it_ = frame;
+    MaybeAddDecodableFrame(frame);
 
     // Loop through all dependent frames, and if that frame no longer has
     // any unfulfilled dependencies then that frame is continuous as well.
@@ -505,10 +507,16 @@ void FrameBuffer::PropagateDecodability(const FrameInfo& info) {
     if (ref_info != frames_.end()) {
       RTC_DCHECK_GT(ref_info->second.num_missing_decodable, 0U);
       --ref_info->second.num_missing_decodable;
+      MaybeAddDecodableFrame(ref_info);
     }
   }
 }
 
+void FrameBuffer::MaybeAddDecodableFrame(FrameMap::const_iterator frame) {
+  if (frame->second.continuous && frame->second.num_missing_decodable == 0)
+    decodable_frames_.insert(frame->first);
+}
+
 void FrameBuffer::AdvanceLastDecodedFrame(FrameMap::iterator decoded) {
   TRACE_EVENT0("webrtc", "FrameBuffer::AdvanceLastDecodedFrame");
   if (last_decoded_frame_it_ == frames_.end()) {
@@ -520,6 +528,10 @@ void FrameBuffer::AdvanceLastDecodedFrame(FrameMap::iterator decoded) {
   --num_frames_buffered_;
   ++num_frames_history_;
 
+  // Neither |decoded| nor any frame before it can be decoded anymore.
+  decodable_frames_.erase(decodable_frames_.begin(),
+                          decodable_frames_.upper_bound(decoded->first));
+
   // First, delete non-decoded frames from the history.
   while (last_decoded_frame_it_ != decoded) {
     if (last_decoded_frame_it_->second.frame)
@@ -661,6 +673,7 @@ void FrameBuffer::ClearFramesAndHistory() {
   last_decoded_frame_it_ = frames_.end();
   last_continuous_frame_it_ = frames_.end();
   frames_to_decode_.clear();
+  decodable_frames_.clear();
   num_frames_history_ = 0;
   num_frames_buffered_ = 0;
 }
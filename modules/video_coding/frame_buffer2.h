@@ -14,6 +14,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -69,6 +70,12 @@ class FrameBuffer {
   //                 implemented.
   void SetProtectionMode(VCMVideoProtection mode);
 
+  // Allows frames to be returned from NextFrame() up to |decode_ahead_ms|
+  // before they would otherwise be due for decoding. Used for pipelined
+  // decoding, where the decoder may hold several frames in flight and
+  // rendering is scheduled by the render time rather than by decode time.
+  void SetDecodeAheadMs(int64_t decode_ahead_ms);
+
   // Start the frame buffer, has no effect if the frame buffer is started.
   // The frame buffer is started upon construction.
   void Start();
@@ -136,6 +143,11 @@ class FrameBuffer {
   void PropagateDecodability(const FrameInfo& info)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Adds |frame| to |decodable_frames_| if it is continuous and all the frames
+  // it references have been decoded.
+  void MaybeAddDecodableFrame(FrameMap::const_iterator frame)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Advances |last_decoded_frame_it_| to |decoded| and removes old
   // frame info.
   void AdvanceLastDecodedFrame(FrameMap::iterator decoded)
@@ -176,10 +188,16 @@ class FrameBuffer {
   FrameMap::iterator last_decoded_frame_it_ RTC_GUARDED_BY(crit_);
   FrameMap::iterator last_continuous_frame_it_ RTC_GUARDED_BY(crit_);
   std::vector<FrameMap::iterator> frames_to_decode_ RTC_GUARDED_BY(crit_);
+  // Continuous frames after |last_decoded_frame_it_| whose references have all
+  // been decoded, in decode order. This is kept up to date as frames become
+  // continuous and decoded, so that NextFrame() only has to consider these
+  // instead of scanning every buffered frame.
+  std::set<VideoLayerFrameId> decodable_frames_ RTC_GUARDED_BY(crit_);
   int num_frames_history_ RTC_GUARDED_BY(crit_);
   int num_frames_buffered_ RTC_GUARDED_BY(crit_);
   bool stopped_ RTC_GUARDED_BY(crit_);
   VCMVideoProtection protection_mode_ RTC_GUARDED_BY(crit_);
+  int64_t decode_ahead_ms_ RTC_GUARDED_BY(crit_);
   VCMReceiveStatisticsCallback* const stats_callback_;
   int64_t last_log_non_decoded_ms_ RTC_GUARDED_BY(crit_);
 
@@ -21,6 +21,7 @@
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -264,6 +265,24 @@ TEST_F(TestFrameBuffer2, WaitForFrame) {
   CheckFrame(0, pid, 0);
 }
 
+TEST_F(TestFrameBuffer2, DecodeAheadReturnsFrameBeforeItIsDue) {
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  buffer_->SetDecodeAheadMs(2 * kFps1);
+  InsertFrame(pid, 0, ts, false, true);
+  ExtractFrame();
+  CheckFrame(0, pid, 0);
+
+  // Without decode ahead the second frame would not be returned until about
+  // one second later, when it is due for decoding.
+  const int64_t start_ms = rtc::TimeMillis();
+  ExtractFrame(2 * kFps1);
+  InsertFrame(pid + 1, 0, ts + kFps1, false, true, pid);
+  CheckFrame(1, pid + 1, 0);
+  EXPECT_LT(rtc::TimeMillis() - start_ms, kFps1 / 2);
+}
+
 TEST_F(TestFrameBuffer2, OneSuperFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
@@ -299,6 +318,27 @@ TEST_F(TestFrameBuffer2, ZeroPlayoutDelay) {
   EXPECT_EQ(0, frames_[0]->RenderTimeMs());
 }
 
+TEST_F(TestFrameBuffer2, ZeroPlayoutDelayDoesNotSkipFrames) {
+  VCMTiming timing(&clock_);
+  buffer_.reset(
+      new FrameBuffer(&clock_, &jitter_estimator_, &timing, &stats_callback_));
+  const PlayoutDelay kPlayoutDelayMs = {0, 0};
+  for (int i = 0; i < 3; ++i) {
+    std::unique_ptr<FrameObjectFake> test_frame(new FrameObjectFake());
+    test_frame->id.picture_id = i;
+    test_frame->SetTimestamp(i * kFps10 * 90);
+    test_frame->SetPlayoutDelay(kPlayoutDelayMs);
+    buffer_->InsertFrame(std::move(test_frame));
+  }
+  // All the frames are independently decodable and overdue, but none is
+  // dropped in favor of a later one.
+  clock_.AdvanceTimeMilliseconds(1000);
+  for (int i = 0; i < 3; ++i) {
+    ExtractFrame(0, false);
+    CheckFrame(i, i, 0);
+  }
+}
+
 // Flaky test, see bugs.webrtc.org/7068.
 TEST_F(TestFrameBuffer2, DISABLED_OneUnorderedSuperFrame) {
   uint16_t pid = Rand();
@@ -354,6 +394,28 @@ TEST_F(TestFrameBuffer2, MissingFrame) {
   CheckNoFrame(2);
 }
 
+TEST_F(TestFrameBuffer2, LateReferenceMakesBufferedFramesDecodable) {
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+  const int kNumFrames = 50;
+
+  InsertFrame(pid, 0, ts, false, true);
+  for (int i = 2; i < kNumFrames; ++i)
+    InsertFrame(pid + i, 0, ts + i * kFps10, false, true, pid + i - 1);
+  ExtractFrame();
+  CheckFrame(0, pid, 0);
+  ExtractFrame();
+  CheckNoFrame(1);
+
+  // The missing frame makes the whole chain continuous, and each frame then
+  // becomes decodable once the one before it is decoded.
+  InsertFrame(pid + 1, 0, ts + kFps10, false, true, pid);
+  for (int i = 1; i < kNumFrames; ++i) {
+    ExtractFrame();
+    CheckFrame(i + 1, pid + i, 0);
+  }
+}
+
 TEST_F(TestFrameBuffer2, OneLayerStream) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
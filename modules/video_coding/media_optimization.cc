@@ -27,6 +27,7 @@ MediaOptimization::MediaOptimization(Clock* clock)
     : clock_(clock),
       max_bit_rate_(0),
       max_frame_rate_(0),
+      cwnd_reduce_ratio_(0),
       frame_dropper_(),
       incoming_frame_rate_(0) {
   memset(incoming_frame_times_, -1, sizeof(incoming_frame_times_));
@@ -64,11 +65,26 @@ uint32_t MediaOptimization::SetTargetRates(uint32_t target_bitrate) {
     framerate = max_frame_rate_;
   }
 
-  frame_dropper_.SetRates(target_video_bitrate_kbps, framerate);
+  // The encoder keeps its target, but the frame dropper only lets through the
+  // share of the frames that the congestion window leaves room for.
+  frame_dropper_.SetRates(
+      target_video_bitrate_kbps * static_cast<float>(1.0 - cwnd_reduce_ratio_),
+      framerate);
 
   return video_target_bitrate;
 }
 
+void MediaOptimization::SetCongestionWindowReduceRatio(
+    double cwnd_reduce_ratio) {
+  rtc::CritScope lock(&crit_sect_);
+  cwnd_reduce_ratio_ = std::min(std::max(cwnd_reduce_ratio, 0.0), 1.0);
+}
+
+bool MediaOptimization::IsCongestionWindowFull() {
+  rtc::CritScope lock(&crit_sect_);
+  return cwnd_reduce_ratio_ > 0;
+}
+
 uint32_t MediaOptimization::InputFrameRate() {
   rtc::CritScope lock(&crit_sect_);
   return InputFrameRateInternal();
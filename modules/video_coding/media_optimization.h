@@ -41,6 +41,11 @@ class MediaOptimization {
   // Input: |target bitrate| - the encoder target bitrate in bits/s.
   uint32_t SetTargetRates(uint32_t target_bitrate);
 
+  // Sets the fraction of frames that should be dropped because the congestion
+  // window is full. Takes effect on the next call to SetTargetRates().
+  void SetCongestionWindowReduceRatio(double cwnd_reduce_ratio);
+  bool IsCongestionWindowFull();
+
   void EnableFrameDropper(bool enable);
   bool DropFrame();
 
@@ -67,6 +72,7 @@ class MediaOptimization {
   Clock* const clock_ RTC_GUARDED_BY(crit_sect_);
   int32_t max_bit_rate_ RTC_GUARDED_BY(crit_sect_);
   float max_frame_rate_ RTC_GUARDED_BY(crit_sect_);
+  double cwnd_reduce_ratio_ RTC_GUARDED_BY(crit_sect_);
   FrameDropper frame_dropper_ RTC_GUARDED_BY(crit_sect_);
   float incoming_frame_rate_ RTC_GUARDED_BY(crit_sect_);
   int64_t incoming_frame_times_[kFrameCountHistorySize] RTC_GUARDED_BY(
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/media_optimization.h"
+
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace media_optimization {
+namespace {
+
+const uint32_t kTargetBitrateBps = 300000;
+const uint32_t kFrameRate = 30;
+// Frames encoded at exactly the target bitrate.
+const size_t kFrameSizeBytes = kTargetBitrateBps / 8 / kFrameRate;
+
+}  // namespace
+
+class MediaOptimizationTest : public ::testing::Test {
+ protected:
+  // Note: simulated clock starts at 1 seconds, since zero is a special case
+  // for the incoming frame rate.
+  MediaOptimizationTest() : clock_(1000), media_opt_(&clock_) {
+    media_opt_.SetEncodingData(0, kTargetBitrateBps, kFrameRate);
+    media_opt_.EnableFrameDropper(true);
+  }
+
+  // Runs |num_frames| frames through the frame dropper, encoding the frames
+  // that are not dropped at the target bitrate, and returns the number of
+  // dropped frames.
+  int RunFrames(int num_frames) {
+    int num_dropped = 0;
+    for (int i = 0; i < num_frames; ++i) {
+      clock_.AdvanceTimeMilliseconds(1000 / kFrameRate);
+      if (media_opt_.DropFrame()) {
+        ++num_dropped;
+      } else {
+        media_opt_.UpdateWithEncodedData(kFrameSizeBytes, kVideoFrameDelta);
+      }
+    }
+    return num_dropped;
+  }
+
+  SimulatedClock clock_;
+  MediaOptimization media_opt_;
+};
+
+TEST_F(MediaOptimizationTest, NoDropsAtTargetBitrate) {
+  media_opt_.SetTargetRates(kTargetBitrateBps);
+  EXPECT_FALSE(media_opt_.IsCongestionWindowFull());
+  EXPECT_EQ(0, RunFrames(10 * kFrameRate));
+}
+
+TEST_F(MediaOptimizationTest, DropsFramesInProportionToCwndReduceRatio) {
+  media_opt_.SetCongestionWindowReduceRatio(0.5);
+  // The encoder target is not reduced by the congestion window.
+  EXPECT_EQ(kTargetBitrateBps, media_opt_.SetTargetRates(kTargetBitrateBps));
+  EXPECT_TRUE(media_opt_.IsCongestionWindowFull());
+  RunFrames(2 * kFrameRate);  // Fill the frame dropper.
+  const int kNumFrames = 10 * kFrameRate;
+  EXPECT_NEAR(kNumFrames / 2, RunFrames(kNumFrames), kNumFrames / 10);
+
+  media_opt_.SetCongestionWindowReduceRatio(0);
+  media_opt_.SetTargetRates(kTargetBitrateBps);
+  RunFrames(2 * kFrameRate);  // Drain the frame dropper.
+  EXPECT_EQ(0, RunFrames(kNumFrames));
+}
+
+}  // namespace media_optimization
+}  // namespace webrtc
@@ -65,6 +65,7 @@ NackModule::NackModule(Clock* clock,
       initialized_(false),
       rtt_ms_(kDefaultRttMs),
       newest_seq_num_(0),
+      first_unsent_seq_num_(0),
       next_process_time_ms_(-1),
       send_nack_delay_ms_(GetSendNackDelay()) {
   RTC_DCHECK(clock_);
@@ -238,6 +239,11 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
     }
   }
 
+  // The new packets are newer than all packets in the list, so only an empty
+  // list can leave |first_unsent_seq_num_| stale.
+  if (nack_list_.empty())
+    first_unsent_seq_num_ = seq_num_start;
+
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
     // Do not send nack for packets that are already recovered by FEC or RTX
     if (recovered_list_.find(seq_num) != recovered_list_.end())
@@ -254,7 +260,9 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   int64_t now_ms = clock_->TimeInMilliseconds();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
+  auto it = consider_timestamp ? nack_list_.begin()
+                               : nack_list_.lower_bound(first_unsent_seq_num_);
+  bool found_unsent = false;
   while (it != nack_list_.end()) {
     bool delay_timed_out =
         now_ms - it->second.created_at_time >= send_nack_delay_ms_;
@@ -276,8 +284,15 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
       }
       continue;
     }
+    if (!consider_timestamp && !found_unsent &&
+        it->second.sent_at_time == -1) {
+      first_unsent_seq_num_ = it->first;
+      found_unsent = true;
+    }
     ++it;
   }
+  if (!consider_timestamp && !found_unsent)
+    first_unsent_seq_num_ = newest_seq_num_ + 1;
   return nack_batch;
 }
 
@@ -91,6 +91,10 @@ class NackModule : public Module {
   // synchronized access.
   std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
       RTC_GUARDED_BY(crit_);
+  // All packets in |nack_list_| older than this have been nacked at least
+  // once, so GetNackBatch(kSeqNumOnly), which runs for every received packet,
+  // only visits the packets from this one on.
+  uint16_t first_unsent_seq_num_ RTC_GUARDED_BY(crit_);
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
       RTC_GUARDED_BY(crit_);
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
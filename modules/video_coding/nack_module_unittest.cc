@@ -292,6 +292,41 @@ TEST_F(TestNackModule, SendNackWithoutDelay) {
   EXPECT_EQ(99u, sent_nacks_.size());
 }
 
+TEST_F(TestNackModule, NacksPacketAgainOnlyAfterRtt) {
+  nack_module_.UpdateRtt(100);
+  nack_module_.OnReceivedPacket(0, false, false);
+  nack_module_.OnReceivedPacket(2, false, false);
+  EXPECT_EQ(1u, sent_nacks_.size());
+
+  // Newer packets don't nack packet 1 again, only passing the RTT does.
+  for (uint16_t seq_num = 3; seq_num < 10; ++seq_num)
+    nack_module_.OnReceivedPacket(seq_num, false, false);
+  nack_module_.Process();
+  EXPECT_EQ(1u, sent_nacks_.size());
+  clock_->AdvanceTimeMilliseconds(100);
+  nack_module_.Process();
+  ASSERT_EQ(2u, sent_nacks_.size());
+  EXPECT_EQ(1, sent_nacks_[1]);
+}
+
+// Receives packets with 10% loss and nothing retransmitted, over a link with
+// a long RTT so that the nack list stays large.
+TEST_F(TestNackModule, DISABLED_PerformanceLossyLink) {
+  const int kNumPackets = 1000000;
+  const int kPacketIntervalMs = 2;
+  const int kProcessIntervalMs = 20;
+  nack_module_.UpdateRtt(1000);
+  for (int i = 0; i < kNumPackets; ++i) {
+    if (i % 10 != 5)
+      nack_module_.OnReceivedPacket(static_cast<uint16_t>(i), false, false);
+    clock_->AdvanceTimeMilliseconds(kPacketIntervalMs);
+    if (i % (kProcessIntervalMs / kPacketIntervalMs) == 0)
+      nack_module_.Process();
+  }
+  EXPECT_EQ(0, keyframes_requested_);
+  EXPECT_GT(sent_nacks_.size(), static_cast<size_t>(kNumPackets / 10));
+}
+
 class TestNackModuleWithFieldTrial : public ::testing::Test,
                                      public NackSender,
                                      public KeyFrameRequestSender {
@@ -31,6 +31,21 @@
 
 namespace webrtc {
 namespace video_coding {
+namespace {
+
+// Returns the index of the lowest set bit of |x|, which must not be zero.
+int LowestSetBit(uint64_t x) {
+  int n = 0;
+  for (int shift = 32; shift > 0; shift >>= 1) {
+    if ((x & ((uint64_t{1} << shift) - 1)) == 0) {
+      n += shift;
+      x >>= shift;
+    }
+  }
+  return n;
+}
+
+}  // namespace
 
 rtc::scoped_refptr<PacketBuffer> PacketBuffer::Create(
     Clock* clock,
@@ -122,7 +137,7 @@ bool PacketBuffer::InsertPacket(VCMPacket* packet) {
     data_buffer_[index] = *packet;
     packet->dataPtr = nullptr;
 
-    UpdateMissingPackets(packet->seqNum);
+    missing_packets_.OnPacketReceived(packet->seqNum);
 
     int64_t now_ms = clock_->TimeInMilliseconds();
     last_received_packet_ms_ = now_ms;
@@ -171,11 +186,7 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   first_seq_num_ = seq_num;
 
   is_cleared_to_first_seq_num_ = true;
-  auto clear_to_it = missing_packets_.upper_bound(seq_num);
-  if (clear_to_it != missing_packets_.begin()) {
-    --clear_to_it;
-    missing_packets_.erase(missing_packets_.begin(), clear_to_it);
-  }
+  missing_packets_.EraseAllButNewestAtOrBefore(seq_num);
 }
 
 void PacketBuffer::Clear() {
@@ -190,15 +201,14 @@ void PacketBuffer::Clear() {
   is_cleared_to_first_seq_num_ = false;
   last_received_packet_ms_.reset();
   last_received_keyframe_packet_ms_.reset();
-  newest_inserted_seq_num_.reset();
-  missing_packets_.clear();
+  missing_packets_.Clear();
 }
 
 void PacketBuffer::PaddingReceived(uint16_t seq_num) {
   std::vector<std::unique_ptr<RtpFrameObject>> found_frames;
   {
     rtc::CritScope lock(&crit_);
-    UpdateMissingPackets(seq_num);
+    missing_packets_.OnPacketReceived(seq_num);
     found_frames = FindFrames(static_cast<uint16_t>(seq_num + 1));
   }
 
@@ -383,8 +393,8 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
 
         // If this is not a keyframe, make sure there are no gaps in the
         // packet sequence numbers up until this point.
-        if (!is_h264_keyframe && missing_packets_.upper_bound(start_seq_num) !=
-                                     missing_packets_.begin()) {
+        if (!is_h264_keyframe &&
+            missing_packets_.AnyAtOrBefore(start_seq_num)) {
           uint16_t stop_index = (index + 1) % size_;
           while (start_index != stop_index) {
             sequence_buffer_[start_index].frame_created = false;
@@ -395,8 +405,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
         }
       }
 
-      missing_packets_.erase(missing_packets_.begin(),
-                             missing_packets_.upper_bound(seq_num));
+      missing_packets_.EraseAtOrBefore(seq_num);
 
       found_frames.emplace_back(
           new RtpFrameObject(this, start_seq_num, seq_num, frame_size,
@@ -487,41 +496,201 @@ int PacketBuffer::Release() const {
   return count;
 }
 
-void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
+void PacketBuffer::OnTimestampReceived(uint32_t rtp_timestamp) {
+  if (rtp_timestamps_history_.Insert(rtp_timestamp))
+    ++unique_frames_seen_;
+}
+
+constexpr int PacketBuffer::MissingPackets::kMaxPaddingAge;
+constexpr int PacketBuffer::MissingPackets::kWindowBits;
+constexpr int PacketBuffer::MissingPackets::kNumWords;
+
+PacketBuffer::MissingPackets::MissingPackets() {
+  static_assert(kMaxPaddingAge < (1 << kWindowBits),
+                "The bitmap must cover kMaxPaddingAge packets.");
+  bits_.fill(0);
+}
+
+void PacketBuffer::MissingPackets::OnPacketReceived(uint16_t seq_num) {
   if (!newest_inserted_seq_num_)
     newest_inserted_seq_num_ = seq_num;
 
-  const int kMaxPaddingAge = 1000;
   if (AheadOf(seq_num, *newest_inserted_seq_num_)) {
     uint16_t old_seq_num = seq_num - kMaxPaddingAge;
-    auto erase_to = missing_packets_.lower_bound(old_seq_num);
-    missing_packets_.erase(missing_packets_.begin(), erase_to);
+    EraseBefore(old_seq_num);
 
     // Guard against inserting a large amount of missing packets if there is a
     // jump in the sequence number.
-    if (AheadOf(old_seq_num, *newest_inserted_seq_num_))
-      *newest_inserted_seq_num_ = old_seq_num;
+    uint16_t missing_seq_num = *newest_inserted_seq_num_;
+    if (AheadOf(old_seq_num, missing_seq_num))
+      missing_seq_num = old_seq_num;
 
-    ++*newest_inserted_seq_num_;
-    while (AheadOf(seq_num, *newest_inserted_seq_num_)) {
-      missing_packets_.insert(*newest_inserted_seq_num_);
-      ++*newest_inserted_seq_num_;
-    }
+    newest_inserted_seq_num_ = seq_num;
+    for (++missing_seq_num; missing_seq_num != seq_num; ++missing_seq_num)
+      Insert(missing_seq_num);
   } else {
-    missing_packets_.erase(seq_num);
+    Erase(seq_num);
   }
 }
 
-void PacketBuffer::OnTimestampReceived(uint32_t rtp_timestamp) {
-  const size_t kMaxTimestampsHistory = 1000;
-  if (rtp_timestamps_history_set_.insert(rtp_timestamp).second) {
-    rtp_timestamps_history_queue_.push(rtp_timestamp);
-    ++unique_frames_seen_;
-    if (rtp_timestamps_history_set_.size() > kMaxTimestampsHistory) {
-      uint32_t discarded_timestamp = rtp_timestamps_history_queue_.front();
-      rtp_timestamps_history_set_.erase(discarded_timestamp);
-      rtp_timestamps_history_queue_.pop();
+void PacketBuffer::MissingPackets::Clear() {
+  newest_inserted_seq_num_.reset();
+  bits_.fill(0);
+  size_ = 0;
+}
+
+bool PacketBuffer::MissingPackets::AnyAtOrBefore(uint16_t seq_num) const {
+  return AnyOf([seq_num](uint16_t missing_seq_num) {
+    return !AheadOf(missing_seq_num, seq_num);
+  });
+}
+
+void PacketBuffer::MissingPackets::EraseAtOrBefore(uint16_t seq_num) {
+  EraseIf([seq_num](uint16_t missing_seq_num) {
+    return !AheadOf(missing_seq_num, seq_num);
+  });
+}
+
+void PacketBuffer::MissingPackets::EraseAllButNewestAtOrBefore(
+    uint16_t seq_num) {
+  absl::optional<uint16_t> newest;
+  AnyOf([seq_num, &newest](uint16_t missing_seq_num) {
+    if (!AheadOf(missing_seq_num, seq_num) &&
+        (!newest || AheadOf(missing_seq_num, *newest))) {
+      newest = missing_seq_num;
+    }
+    return false;
+  });
+  if (newest)
+    EraseBefore(*newest);
+}
+
+void PacketBuffer::MissingPackets::Insert(uint16_t seq_num) {
+  int bit = seq_num & ((1 << kWindowBits) - 1);
+  uint64_t mask = uint64_t{1} << (bit % 64);
+  if (!(bits_[bit / 64] & mask)) {
+    bits_[bit / 64] |= mask;
+    ++size_;
+  }
+}
+
+void PacketBuffer::MissingPackets::Erase(uint16_t seq_num) {
+  // Only packets before the newest inserted one, and at most |kMaxPaddingAge|
+  // back, can be missing.
+  uint16_t age = *newest_inserted_seq_num_ - seq_num;
+  if (age == 0 || age > kMaxPaddingAge)
+    return;
+  int bit = seq_num & ((1 << kWindowBits) - 1);
+  uint64_t mask = uint64_t{1} << (bit % 64);
+  if (bits_[bit / 64] & mask) {
+    bits_[bit / 64] &= ~mask;
+    --size_;
+  }
+}
+
+void PacketBuffer::MissingPackets::EraseBefore(uint16_t seq_num) {
+  EraseIf([seq_num](uint16_t missing_seq_num) {
+    return AheadOf(seq_num, missing_seq_num);
+  });
+}
+
+template <typename Fn>
+void PacketBuffer::MissingPackets::EraseIf(Fn fn) {
+  for (int word = 0; size_ > 0 && word < kNumWords; ++word) {
+    uint64_t remaining = bits_[word];
+    while (remaining) {
+      uint64_t lowest = remaining & (~remaining + 1);
+      remaining &= remaining - 1;
+      int bit = word * 64 + LowestSetBit(lowest);
+      if (fn(SeqNumAtBit(bit))) {
+        bits_[word] &= ~lowest;
+        --size_;
+      }
+    }
+  }
+}
+
+template <typename Fn>
+bool PacketBuffer::MissingPackets::AnyOf(Fn fn) const {
+  for (int word = 0; size_ > 0 && word < kNumWords; ++word) {
+    uint64_t remaining = bits_[word];
+    while (remaining) {
+      uint64_t lowest = remaining & (~remaining + 1);
+      remaining &= remaining - 1;
+      int bit = word * 64 + LowestSetBit(lowest);
+      if (fn(SeqNumAtBit(bit)))
+        return true;
+    }
+  }
+  return false;
+}
+
+uint16_t PacketBuffer::MissingPackets::SeqNumAtBit(int bit) const {
+  // All missing packets are within the window before the newest inserted one.
+  const uint16_t kWindowMask = (1 << kWindowBits) - 1;
+  uint16_t newest = *newest_inserted_seq_num_;
+  return newest - ((newest - bit) & kWindowMask);
+}
+
+constexpr size_t PacketBuffer::TimestampHistory::kMaxTimestampsHistory;
+constexpr int PacketBuffer::TimestampHistory::kTableBits;
+constexpr size_t PacketBuffer::TimestampHistory::kTableSize;
+
+PacketBuffer::TimestampHistory::TimestampHistory() {
+  static_assert(kTableSize >= 2 * kMaxTimestampsHistory,
+                "The hash table must be at most half full.");
+  table_used_.fill(false);
+}
+
+bool PacketBuffer::TimestampHistory::Insert(uint32_t rtp_timestamp) {
+  size_t index = Find(rtp_timestamp);
+  if (table_used_[index])
+    return false;
+
+  if (ring_size_ == kMaxTimestampsHistory) {
+    EraseFromTable(ring_[ring_start_]);
+    ring_start_ = (ring_start_ + 1) % kMaxTimestampsHistory;
+    --ring_size_;
+    // Erasing may have moved entries around in the table.
+    index = Find(rtp_timestamp);
+  }
+  table_[index] = rtp_timestamp;
+  table_used_[index] = true;
+  ring_[(ring_start_ + ring_size_) % kMaxTimestampsHistory] = rtp_timestamp;
+  ++ring_size_;
+  return true;
+}
+
+size_t PacketBuffer::TimestampHistory::Hash(uint32_t rtp_timestamp) {
+  // Fibonacci hashing, using the top bits of the product.
+  return (rtp_timestamp * 2654435769u) >> (32 - kTableBits);
+}
+
+size_t PacketBuffer::TimestampHistory::Find(uint32_t rtp_timestamp) const {
+  size_t index = Hash(rtp_timestamp);
+  while (table_used_[index] && table_[index] != rtp_timestamp)
+    index = (index + 1) & (kTableSize - 1);
+  return index;
+}
+
+void PacketBuffer::TimestampHistory::EraseFromTable(uint32_t rtp_timestamp) {
+  size_t index = Find(rtp_timestamp);
+  RTC_DCHECK(table_used_[index]);
+  table_used_[index] = false;
+  // Move back the entries following in the same probe sequence, so that no
+  // tombstones are needed.
+  size_t next = (index + 1) & (kTableSize - 1);
+  while (table_used_[next]) {
+    size_t home = Hash(table_[next]);
+    // Move the entry if its home slot isn't in (index, next].
+    if (((next - home) & (kTableSize - 1)) >=
+        ((next - index) & (kTableSize - 1))) {
+      table_[index] = table_[next];
+      table_used_[index] = true;
+      table_used_[next] = false;
+      index = next;
     }
+    next = (next + 1) & (kTableSize - 1);
   }
 }
 
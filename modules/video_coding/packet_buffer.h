@@ -11,9 +11,10 @@
 #ifndef MODULES_VIDEO_CODING_PACKET_BUFFER_H_
 #define MODULES_VIDEO_CODING_PACKET_BUFFER_H_
 
+#include <stdint.h>
+
+#include <array>
 #include <memory>
-#include <queue>
-#include <set>
 #include <vector>
 
 #include "modules/include/module_common_types.h"
@@ -99,6 +100,77 @@ class PacketBuffer {
     bool frame_created = false;
   };
 
+  // Sequence numbers of the packets not received yet, going back
+  // |kMaxPaddingAge| packets from the newest inserted one. They are kept in a
+  // bitmap indexed by sequence number, so that no memory is allocated per
+  // packet.
+  class MissingPackets {
+   public:
+    MissingPackets();
+
+    // Marks |seq_num| as received, and any packets skipped between the newest
+    // inserted one and |seq_num| as missing.
+    void OnPacketReceived(uint16_t seq_num);
+    void Clear();
+
+    // Returns true if any packet at or before |seq_num| is missing.
+    bool AnyAtOrBefore(uint16_t seq_num) const;
+    // Forgets all missing packets at or before |seq_num|.
+    void EraseAtOrBefore(uint16_t seq_num);
+    // Forgets all missing packets at or before |seq_num|, except the newest
+    // of them.
+    void EraseAllButNewestAtOrBefore(uint16_t seq_num);
+
+   private:
+    static constexpr int kMaxPaddingAge = 1000;
+    static constexpr int kWindowBits = 10;
+    static constexpr int kNumWords = (1 << kWindowBits) / 64;
+
+    void Insert(uint16_t seq_num);
+    void Erase(uint16_t seq_num);
+    // Forgets all missing packets before |seq_num|.
+    void EraseBefore(uint16_t seq_num);
+    // Calls |fn| with each missing sequence number, and erases it if |fn|
+    // returns true.
+    template <typename Fn>
+    void EraseIf(Fn fn);
+    template <typename Fn>
+    bool AnyOf(Fn fn) const;
+    uint16_t SeqNumAtBit(int bit) const;
+
+    absl::optional<uint16_t> newest_inserted_seq_num_;
+    std::array<uint64_t, kNumWords> bits_;
+    size_t size_ = 0;
+  };
+
+  // The last |kMaxTimestampsHistory| unique RTP timestamps, in a ring buffer
+  // in insertion order, with an open addressing hash table for lookups.
+  class TimestampHistory {
+   public:
+    TimestampHistory();
+
+    // Adds |rtp_timestamp| to the history and returns true if it's not in it
+    // already.
+    bool Insert(uint32_t rtp_timestamp);
+
+   private:
+    static constexpr size_t kMaxTimestampsHistory = 1000;
+    static constexpr int kTableBits = 11;
+    static constexpr size_t kTableSize = size_t{1} << kTableBits;
+
+    static size_t Hash(uint32_t rtp_timestamp);
+    // Returns the table index of |rtp_timestamp|, or of the empty slot where
+    // it would be inserted.
+    size_t Find(uint32_t rtp_timestamp) const;
+    void EraseFromTable(uint32_t rtp_timestamp);
+
+    std::array<uint32_t, kMaxTimestampsHistory> ring_;
+    size_t ring_start_ = 0;
+    size_t ring_size_ = 0;
+    std::array<uint32_t, kTableSize> table_;
+    std::array<bool, kTableSize> table_used_;
+  };
+
   Clock* const clock_;
 
   // Tries to expand the buffer.
@@ -126,9 +198,6 @@ class PacketBuffer {
   // Virtual for testing.
   virtual void ReturnFrame(RtpFrameObject* frame);
 
-  void UpdateMissingPackets(uint16_t seq_num)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
-
   // Counts unique received timestamps and updates |unique_frames_seen_|.
   void OnTimestampReceived(uint32_t rtp_timestamp)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -165,18 +234,14 @@ class PacketBuffer {
 
   int unique_frames_seen_ RTC_GUARDED_BY(crit_);
 
-  absl::optional<uint16_t> newest_inserted_seq_num_ RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_
-      RTC_GUARDED_BY(crit_);
+  MissingPackets missing_packets_ RTC_GUARDED_BY(crit_);
 
   // Indicates if we should require SPS, PPS, and IDR for a particular
   // RTP timestamp to treat the corresponding frame as a keyframe.
   const bool sps_pps_idr_is_h264_keyframe_;
 
   // Stores several last seen unique timestamps for quick search.
-  std::set<uint32_t> rtp_timestamps_history_set_ RTC_GUARDED_BY(crit_);
-  // Stores the same unique timestamps in the order of insertion.
-  std::queue<uint32_t> rtp_timestamps_history_queue_ RTC_GUARDED_BY(crit_);
+  TimestampHistory rtp_timestamps_history_ RTC_GUARDED_BY(crit_);
 
   mutable volatile int ref_count_ = 0;
 };
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encoder_thread_budget.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+EncoderThreadBudget* EncoderThreadBudget::Get() {
+  static EncoderThreadBudget* const budget =
+      new EncoderThreadBudget(CpuInfo::DetectNumberOfCores());
+  return budget;
+}
+
+EncoderThreadBudget::EncoderThreadBudget(int max_threads)
+    : max_threads_(std::max(max_threads, 1)), threads_in_use_(0) {}
+
+int EncoderThreadBudget::Acquire(int threads) {
+  RTC_DCHECK_GE(threads, 1);
+  rtc::CritScope cs(&crit_);
+  const int granted =
+      std::max(1, std::min(threads, max_threads_ - threads_in_use_));
+  threads_in_use_ += granted;
+  return granted;
+}
+
+void EncoderThreadBudget::Release(int threads) {
+  rtc::CritScope cs(&crit_);
+  RTC_DCHECK_GE(threads_in_use_, threads);
+  threads_in_use_ -= threads;
+}
+
+int EncoderThreadBudget::threads_in_use() const {
+  rtc::CritScope cs(&crit_);
+  return threads_in_use_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_ENCODER_THREAD_BUDGET_H_
+#define MODULES_VIDEO_CODING_UTILITY_ENCODER_THREAD_BUDGET_H_
+
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Limits the total number of software encoder threads, so that many encoders
+// running at once don't oversubscribe the machine. Encoders acquire threads
+// for each of their layers in InitEncode() and release them in Release().
+// Thread safe.
+class EncoderThreadBudget {
+ public:
+  // Returns the budget shared by all VP8 and H.264 encoders in the process,
+  // which has one thread per core.
+  static EncoderThreadBudget* Get();
+
+  explicit EncoderThreadBudget(int max_threads);
+
+  // Grants up to |threads| threads, but always at least one, since every
+  // encoder needs a thread to make progress even if the budget is used up.
+  int Acquire(int threads);
+  void Release(int threads);
+
+  int threads_in_use() const;
+
+ private:
+  const int max_threads_;
+  rtc::CriticalSection crit_;
+  int threads_in_use_ RTC_GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(EncoderThreadBudget);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_ENCODER_THREAD_BUDGET_H_
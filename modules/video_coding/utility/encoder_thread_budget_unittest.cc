@@ -0,0 +1,37 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encoder_thread_budget.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(EncoderThreadBudgetTest, GrantsThreadsUntilBudgetIsUsedUp) {
+  EncoderThreadBudget budget(8);
+  EXPECT_EQ(3, budget.Acquire(3));
+  EXPECT_EQ(3, budget.Acquire(3));
+  EXPECT_EQ(2, budget.Acquire(3));
+  EXPECT_EQ(8, budget.threads_in_use());
+}
+
+TEST(EncoderThreadBudgetTest, GrantsOneThreadWhenBudgetIsUsedUp) {
+  EncoderThreadBudget budget(2);
+  EXPECT_EQ(2, budget.Acquire(2));
+  EXPECT_EQ(1, budget.Acquire(3));
+  EXPECT_EQ(3, budget.threads_in_use());
+
+  budget.Release(1);
+  budget.Release(2);
+  EXPECT_EQ(0, budget.threads_in_use());
+  EXPECT_EQ(2, budget.Acquire(3));
+}
+
+}  // namespace webrtc
@@ -82,6 +82,12 @@ class VideoSender {
       VideoBitrateAllocator* bitrate_allocator,
       VideoBitrateAllocationObserver* bitrate_updated_callback);
 
+  // Sets the fraction of frames to drop before encoding because the congestion
+  // window is full. Applied by the next SetChannelParameters() call. While
+  // non-zero, frames are dropped even if the encoder has a trusted rate
+  // controller.
+  void SetCongestionWindowReduceRatio(double cwnd_reduce_ratio);
+
   // Updates the channel parameters with a new bitrate allocation, but using the
   // current targit_bitrate, loss rate and rtt. That is, the distribution or
   // caps may be updated to a change to a new VideoCodec or allocation mode.
@@ -9,6 +9,7 @@
  */
 
 #include <cstring>
+#include <deque>
 #include <map>
 #include <set>
 #include <utility>
@@ -16,7 +17,9 @@
 #include "common_video/h264/h264_common.h"
 #include "modules/video_coding/frame_object.h"
 #include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
@@ -263,6 +266,28 @@ TEST_F(TestPacketBuffer, HasHistoryOfUniqueFrames) {
   ASSERT_EQ(kNumFrames + 1, packet_buffer_->GetUniqueFramesSeen());
 }
 
+TEST_F(TestPacketBuffer, KeepsHistoryOfUniqueFramesAfterManyEvictions) {
+  const int kNumFrames = 3000;
+  const int kRequiredHistoryLength = 1000;
+  const uint16_t seq_num = Rand();
+
+  for (int i = 0; i < kNumFrames; ++i) {
+    EXPECT_TRUE(Insert(seq_num + i, kKeyFrame, kFirst, kNotLast, 0, nullptr,
+                       3000 * i));
+  }
+  ASSERT_EQ(kNumFrames, packet_buffer_->GetUniqueFramesSeen());
+
+  for (int i = kNumFrames - kRequiredHistoryLength; i < kNumFrames; ++i) {
+    EXPECT_TRUE(Insert(seq_num + i, kKeyFrame, kFirst, kNotLast, 0, nullptr,
+                       3000 * i));
+  }
+  ASSERT_EQ(kNumFrames, packet_buffer_->GetUniqueFramesSeen());
+
+  EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kNotLast, 0, nullptr,
+                     3000 * (kNumFrames - kRequiredHistoryLength - 1)));
+  ASSERT_EQ(kNumFrames + 1, packet_buffer_->GetUniqueFramesSeen());
+}
+
 TEST_F(TestPacketBuffer, ExpandBuffer) {
   const uint16_t seq_num = Rand();
 
@@ -978,5 +1003,63 @@ TEST_F(TestPacketBufferH264SpsPpsIdrIsKeyframe, SpsPpsIdrIsKeyframe) {
   EXPECT_EQ(kVideoFrameKey, frames_from_callback_[kSeqNum]->frame_type());
 }
 
+class CountingFrameCallback : public OnReceivedFrameCallback {
+ public:
+  void OnReceivedFrame(std::unique_ptr<RtpFrameObject> frame) override {
+    ++num_frames;
+  }
+
+  int num_frames = 0;
+};
+
+// Inserts the packets of a 60 fps stream at about 1500 packets/s, with some
+// lost packets recovered a few packets later, and logs the time spent.
+TEST(PacketBufferPerformanceTest, InsertPacketsOfHighRateStream) {
+  const int kNumFrames = 60 * 60;
+  const int kPacketsPerFrame = 25;
+  const int kLossPeriod = 97;
+  const int kRecoveryDelayPackets = 10;
+  SimulatedClock clock(0);
+  CountingFrameCallback callback;
+  rtc::scoped_refptr<PacketBuffer> packet_buffer(
+      PacketBuffer::Create(&clock, 512, 2048, &callback));
+
+  auto insert = [&packet_buffer](int i) {
+    int frame = i / kPacketsPerFrame;
+    VCMPacket packet;
+    packet.codec = kVideoCodecGeneric;
+    packet.timestamp = 1500 * frame;
+    packet.seqNum = static_cast<uint16_t>(i);
+    packet.frameType = frame == 0 ? kVideoFrameKey : kVideoFrameDelta;
+    packet.is_first_packet_in_frame = i % kPacketsPerFrame == 0;
+    packet.is_last_packet_in_frame =
+        i % kPacketsPerFrame == kPacketsPerFrame - 1;
+    packet.sizeBytes = 0;
+    packet.dataPtr = nullptr;
+    EXPECT_TRUE(packet_buffer->InsertPacket(&packet));
+  };
+
+  // Pairs of the packet index to recover at and the lost packet index.
+  std::deque<std::pair<int, int>> lost;
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumFrames * kPacketsPerFrame; ++i) {
+    if (i % kLossPeriod == kLossPeriod - 1) {
+      lost.emplace_back(i + kRecoveryDelayPackets, i);
+    } else {
+      insert(i);
+    }
+    while (!lost.empty() && lost.front().first == i) {
+      insert(lost.front().second);
+      lost.pop_front();
+    }
+    clock.AdvanceTimeMicroseconds(666);
+  }
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+
+  EXPECT_EQ(kNumFrames, callback.num_frames);
+  RTC_LOG(LS_INFO) << "Inserted " << kNumFrames * kPacketsPerFrame
+                   << " packets in " << elapsed_us << " us.";
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
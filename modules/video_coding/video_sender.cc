@@ -10,6 +10,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <algorithm>
 #include <vector>
 
 #include "api/video/video_bitrate_allocation.h"
@@ -209,6 +210,10 @@ void VideoSender::UpdateChannelParameters(
   }
 }
 
+void VideoSender::SetCongestionWindowReduceRatio(double cwnd_reduce_ratio) {
+  _mediaOpt.SetCongestionWindowReduceRatio(cwnd_reduce_ratio);
+}
+
 int32_t VideoSender::SetChannelParameters(
     uint32_t target_bitrate_bps,
     VideoBitrateAllocator* bitrate_allocator,
@@ -284,10 +289,12 @@ int32_t VideoSender::AddVideoFrame(
   }
 
   // Frame dropping is enabled iff frame dropping has been requested, and
-  // frame dropping is not force-disabled, and rate controller is not trusted.
+  // frame dropping is not force-disabled, and rate controller is not trusted
+  // or the congestion window asks for frames to be dropped.
   const bool frame_dropping_enabled =
       frame_dropper_requested_ && !force_disable_frame_dropper_ &&
-      !encoder_info->has_trusted_rate_controller;
+      (!encoder_info->has_trusted_rate_controller ||
+       _mediaOpt.IsCongestionWindowFull());
   _mediaOpt.EnableFrameDropper(frame_dropping_enabled);
 
   if (_mediaOpt.DropFrame()) {
@@ -312,9 +319,12 @@ int32_t VideoSender::AddVideoFrame(
   const VideoFrameBuffer::Type buffer_type =
       converted_frame.video_frame_buffer()->type();
   const bool is_buffer_type_supported =
-      buffer_type == VideoFrameBuffer::Type::kI420 ||
-      (buffer_type == VideoFrameBuffer::Type::kNative &&
-       encoder_info->supports_native_handle);
+      buffer_type == VideoFrameBuffer::Type::kNative
+          ? encoder_info->supports_native_handle
+          : std::find(encoder_info->supported_input_buffer_types.begin(),
+                      encoder_info->supported_input_buffer_types.end(),
+                      buffer_type) !=
+                encoder_info->supported_input_buffer_types.end();
   if (!is_buffer_type_supported) {
     // This module only supports software encoding.
     // TODO(pbos): Offload conversion from the encoder thread.
@@ -329,6 +339,7 @@ int32_t VideoSender::AddVideoFrame(
                                  converted_frame.timestamp(),
                                  converted_frame.render_time_ms(),
                                  converted_frame.rotation());
+    converted_frame.set_update_rect(videoFrame.update_rect());
   }
   int32_t ret =
       _encoder->Encode(converted_frame, codecSpecificInfo, next_frame_types);
@@ -13,6 +13,7 @@
 
 #include "api/test/mock_video_encoder.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video_codecs/vp8_temporal_layers.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/mock/mock_vcm_callbacks.h"
@@ -35,6 +36,7 @@ using ::testing::NiceMock;
 using ::testing::Pointee;
 using ::testing::Return;
 using ::testing::FloatEq;
+using ::testing::Invoke;
 using std::vector;
 using webrtc::test::FrameGenerator;
 
@@ -390,6 +392,38 @@ TEST_F(TestVideoSenderWithMockEncoder,
   AddFrame();
 }
 
+TEST_F(TestVideoSenderWithMockEncoder, ConvertsUnsupportedBufferTypeToI420) {
+  VideoFrameBuffer::Type encoded_type = VideoFrameBuffer::Type::kNative;
+  EXPECT_CALL(encoder_, Encode(_, _, _))
+      .WillOnce(Invoke([&encoded_type](const VideoFrame& frame,
+                                       const CodecSpecificInfo*,
+                                       const std::vector<FrameType>*) {
+        encoded_type = frame.video_frame_buffer()->type();
+        return 0;
+      }));
+  VideoFrame frame(NV12Buffer::Create(settings_.width, settings_.height),
+                   kVideoRotation_0, 0);
+  sender_->AddVideoFrame(frame, nullptr, VideoEncoder::EncoderInfo());
+  EXPECT_EQ(VideoFrameBuffer::Type::kI420, encoded_type);
+}
+
+TEST_F(TestVideoSenderWithMockEncoder, PassesSupportedBufferTypeToEncoder) {
+  VideoFrameBuffer::Type encoded_type = VideoFrameBuffer::Type::kNative;
+  EXPECT_CALL(encoder_, Encode(_, _, _))
+      .WillOnce(Invoke([&encoded_type](const VideoFrame& frame,
+                                       const CodecSpecificInfo*,
+                                       const std::vector<FrameType>*) {
+        encoded_type = frame.video_frame_buffer()->type();
+        return 0;
+      }));
+  VideoEncoder::EncoderInfo info;
+  info.supported_input_buffer_types.push_back(VideoFrameBuffer::Type::kNV12);
+  VideoFrame frame(NV12Buffer::Create(settings_.width, settings_.height),
+                   kVideoRotation_0, 0);
+  sender_->AddVideoFrame(frame, nullptr, info);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12, encoded_type);
+}
+
 class TestVideoSenderWithVp8 : public TestVideoSender {
  public:
   TestVideoSenderWithVp8()
@@ -30,6 +30,10 @@ static const size_t kPacketLenSize = sizeof(PacketLength);
 static const size_t kPacketLenOffset = 2;
 static const size_t kBufSize = kMaxPacketSize + kStunHeaderSize;
 static const size_t kTurnChannelDataHdrSize = 4;
+// The maximum size of the plaintext of a TLS record.
+static const size_t kMaxCoalescedSize = 16 * 1024;
+
+enum { MSG_FLUSH_COALESCED };
 
 inline bool IsStunMessage(uint16_t msg_type) {
   // The first two bits of a channel data message are 0b01.
@@ -52,6 +56,20 @@ AsyncStunTCPSocket* AsyncStunTCPSocket::Create(
 AsyncStunTCPSocket::AsyncStunTCPSocket(rtc::AsyncSocket* socket, bool listen)
     : rtc::AsyncTCPSocketBase(socket, listen, kBufSize) {}
 
+AsyncStunTCPSocket::~AsyncStunTCPSocket() {
+  if (thread_)
+    thread_->Clear(this);
+}
+
+void AsyncStunTCPSocket::set_send_coalescing_window_ms(int window_ms) {
+  if (!thread_)
+    thread_ = rtc::Thread::Current();
+  RTC_DCHECK(thread_->IsCurrent());
+  coalescing_window_ms_ = window_ms;
+  if (coalescing_window_ms_ <= 0 && flush_pending_)
+    FlushCoalescedPackets();
+}
+
 int AsyncStunTCPSocket::Send(const void* pv,
                              size_t cb,
                              const rtc::PacketOptions& options) {
@@ -61,7 +79,7 @@ int AsyncStunTCPSocket::Send(const void* pv,
   }
 
   // If we are blocking on send, then silently drop this packet
-  if (!IsOutBufferEmpty())
+  if (!IsOutBufferEmpty() && !flush_pending_)
     return static_cast<int>(cb);
 
   int pad_bytes;
@@ -71,6 +89,9 @@ int AsyncStunTCPSocket::Send(const void* pv,
   if (cb != expected_pkt_len)
     return -1;
 
+  if (coalescing_window_ms_ > 0)
+    return SendCoalesced(pv, cb, pad_bytes, options);
+
   AppendToOutBuffer(pv, cb);
 
   RTC_DCHECK(pad_bytes < 4);
@@ -91,6 +112,66 @@ int AsyncStunTCPSocket::Send(const void* pv,
   return static_cast<int>(cb);
 }
 
+int AsyncStunTCPSocket::SendCoalesced(const void* pv,
+                                      size_t cb,
+                                      int pad_bytes,
+                                      const rtc::PacketOptions& options) {
+  size_t size = cb + pad_bytes;
+  if (flush_pending_ && pending_size_ + size > kMaxCoalescedSize) {
+    // Start a new record rather than splitting the packet over two.
+    FlushCoalescedPackets();
+    if (!IsOutBufferEmpty())
+      return static_cast<int>(cb);
+  }
+
+  AppendToOutBuffer(pv, cb);
+  RTC_DCHECK(pad_bytes < 4);
+  char padding[4] = {0};
+  AppendToOutBuffer(padding, pad_bytes);
+  pending_size_ += size;
+  pending_sent_packets_.emplace_back(options.packet_id, -1);
+
+  if (pending_size_ >= kMaxCoalescedSize) {
+    FlushCoalescedPackets();
+  } else if (!flush_pending_) {
+    flush_pending_ = true;
+    thread_->PostDelayed(RTC_FROM_HERE, coalescing_window_ms_, this,
+                         MSG_FLUSH_COALESCED);
+  }
+  return static_cast<int>(cb);
+}
+
+void AsyncStunTCPSocket::FlushCoalescedPackets() {
+  if (flush_pending_) {
+    thread_->Clear(this, MSG_FLUSH_COALESCED);
+    flush_pending_ = false;
+  }
+  pending_size_ = 0;
+  std::vector<rtc::SentPacket> sent_packets;
+  sent_packets.swap(pending_sent_packets_);
+  if (sent_packets.empty())
+    return;
+
+  // Nothing of the pending packets has been written yet, so they can all be
+  // dropped if no progress is made, like a single packet.
+  if (!IsOutBufferEmpty() && FlushOutBuffer() <= 0) {
+    ClearOutBuffer();
+    return;
+  }
+
+  int64_t now = rtc::TimeMillis();
+  for (rtc::SentPacket& sent_packet : sent_packets) {
+    sent_packet.send_time_ms = now;
+    SignalSentPacket(this, sent_packet);
+  }
+}
+
+void AsyncStunTCPSocket::OnMessage(rtc::Message* msg) {
+  RTC_DCHECK(msg->message_id == MSG_FLUSH_COALESCED);
+  flush_pending_ = false;
+  FlushCoalescedPackets();
+}
+
 void AsyncStunTCPSocket::ProcessInput(char* data, size_t* len) {
   rtc::SocketAddress remote_addr(GetRemoteAddress());
   // STUN packet - First 4 bytes. Total header size is 20 bytes.
@@ -103,26 +184,27 @@ void AsyncStunTCPSocket::ProcessInput(char* data, size_t* len) {
   // |         Channel Number        |            Length             |
   // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
-  while (true) {
-    // We need at least 4 bytes to read the STUN or ChannelData packet length.
-    if (*len < kPacketLenOffset + kPacketLenSize)
-      return;
-
+  // Signal all complete packets, and move the rest to the front only once.
+  size_t processed = 0;
+  // We need at least 4 bytes to read the STUN or ChannelData packet length.
+  while (*len - processed >= kPacketLenOffset + kPacketLenSize) {
     int pad_bytes;
-    size_t expected_pkt_len = GetExpectedLength(data, *len, &pad_bytes);
+    size_t expected_pkt_len =
+        GetExpectedLength(data + processed, *len - processed, &pad_bytes);
     size_t actual_length = expected_pkt_len + pad_bytes;
 
-    if (*len < actual_length) {
-      return;
+    if (*len - processed < actual_length) {
+      break;
     }
 
-    SignalReadPacket(this, data, expected_pkt_len, remote_addr,
+    SignalReadPacket(this, data + processed, expected_pkt_len, remote_addr,
                      rtc::TimeMicros());
+    processed += actual_length;
+  }
 
-    *len -= actual_length;
-    if (*len > 0) {
-      memmove(data, data + actual_length, *len);
-    }
+  *len -= processed;
+  if (processed > 0 && *len > 0) {
+    memmove(data, data + processed, *len);
   }
 }
 
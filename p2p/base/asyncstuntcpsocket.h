@@ -12,16 +12,21 @@
 #define P2P_BASE_ASYNCSTUNTCPSOCKET_H_
 
 #include <stddef.h>
+#include <vector>
 
 #include "rtc_base/asyncpacketsocket.h"
 #include "rtc_base/asyncsocket.h"
 #include "rtc_base/asynctcpsocket.h"
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/messagehandler.h"
+#include "rtc_base/network/sent_packet.h"
 #include "rtc_base/socketaddress.h"
+#include "rtc_base/thread.h"
 
 namespace cricket {
 
-class AsyncStunTCPSocket : public rtc::AsyncTCPSocketBase {
+class AsyncStunTCPSocket : public rtc::AsyncTCPSocketBase,
+                           public rtc::MessageHandler {
  public:
   // Binds and connects |socket| and creates AsyncTCPSocket for
   // it. Takes ownership of |socket|. Returns NULL if bind() or
@@ -31,6 +36,15 @@ class AsyncStunTCPSocket : public rtc::AsyncTCPSocketBase {
                                     const rtc::SocketAddress& remote_address);
 
   AsyncStunTCPSocket(rtc::AsyncSocket* socket, bool listen);
+  ~AsyncStunTCPSocket() override;
+
+  // When |window_ms| is positive, packets sent within |window_ms| of each
+  // other are written to the socket together, so that e.g. a TLS socket puts
+  // them in a single record. The write happens earlier if the pending
+  // packets fill a TLS record. Packets are written one by one by default.
+  // Must be called on the thread that the socket is used on.
+  void set_send_coalescing_window_ms(int window_ms);
+  int send_coalescing_window_ms() const { return coalescing_window_ms_; }
 
   int Send(const void* pv,
            size_t cb,
@@ -38,12 +52,32 @@ class AsyncStunTCPSocket : public rtc::AsyncTCPSocketBase {
   void ProcessInput(char* data, size_t* len) override;
   void HandleIncomingConnection(rtc::AsyncSocket* socket) override;
 
+  // MessageHandler implementation.
+  void OnMessage(rtc::Message* msg) override;
+
  private:
   // This method returns the message hdr + length written in the header.
   // This method also returns the number of padding bytes needed/added to the
   // turn message. |pad_bytes| should be used only when |is_turn| is true.
   size_t GetExpectedLength(const void* data, size_t len, int* pad_bytes);
 
+  // Adds a packet to the pending ones, and writes them if the window is over.
+  int SendCoalesced(const void* pv,
+                    size_t cb,
+                    int pad_bytes,
+                    const rtc::PacketOptions& options);
+  // Writes the pending packets and signals SignalSentPacket for them.
+  void FlushCoalescedPackets();
+
+  int coalescing_window_ms_ = 0;
+  rtc::Thread* thread_ = nullptr;
+  // True while |outbuf_| only holds packets of which nothing has been written
+  // yet, and a flush is scheduled.
+  bool flush_pending_ = false;
+  // The size of the pending packets, including their padding.
+  size_t pending_size_ = 0;
+  std::vector<rtc::SentPacket> pending_sent_packets_;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(AsyncStunTCPSocket);
 };
 
@@ -16,6 +16,7 @@
 
 #include "p2p/base/asyncstuntcpsocket.h"
 #include "rtc_base/asyncsocket.h"
+#include "rtc_base/gunit.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
@@ -55,6 +56,8 @@ static unsigned char kTurnChannelDataMessageWithOddLength[] = {
 
 static const rtc::SocketAddress kClientAddr("11.11.11.11", 0);
 static const rtc::SocketAddress kServerAddr("22.22.22.22", 0);
+static const int kCoalescingWindowMs = 10;
+static const int kTimeoutMs = 1000;
 
 class AsyncStunTCPSocketTest : public testing::Test,
                                public sigslot::has_slots<> {
@@ -279,4 +282,63 @@ TEST_F(AsyncStunTCPSocketTest, SignalSentPacketNotFiredWhenPacketNotSent) {
   EXPECT_EQ(0, sent_packets_);
 }
 
+// Test that packets sent within the coalescing window are written together
+// when it is over, and that all of them are reported as sent.
+TEST_F(AsyncStunTCPSocketTest, CoalescesPacketsWithinWindow) {
+  send_socket_->set_send_coalescing_window_ms(kCoalescingWindowMs);
+  rtc::PacketOptions options;
+  EXPECT_EQ(static_cast<int>(sizeof(kStunMessageWithZeroLength)),
+            send_socket_->Send(kStunMessageWithZeroLength,
+                               sizeof(kStunMessageWithZeroLength), options));
+  EXPECT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessageWithOddLength)),
+            send_socket_->Send(kTurnChannelDataMessageWithOddLength,
+                               sizeof(kTurnChannelDataMessageWithOddLength),
+                               options));
+  EXPECT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessage)),
+            send_socket_->Send(kTurnChannelDataMessage,
+                               sizeof(kTurnChannelDataMessage), options));
+  EXPECT_EQ(0, sent_packets_);
+
+  EXPECT_EQ_WAIT(3u, recv_packets_.size(), kTimeoutMs);
+  EXPECT_EQ(3, sent_packets_);
+  EXPECT_TRUE(CheckData(kStunMessageWithZeroLength,
+                        sizeof(kStunMessageWithZeroLength)));
+  EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                        sizeof(kTurnChannelDataMessageWithOddLength)));
+  EXPECT_TRUE(
+      CheckData(kTurnChannelDataMessage, sizeof(kTurnChannelDataMessage)));
+}
+
+// Test that pending packets are written without waiting for the window once
+// they fill a TLS record.
+TEST_F(AsyncStunTCPSocketTest, FlushesCoalescedPacketsWhenRecordIsFull) {
+  send_socket_->set_send_coalescing_window_ms(kTimeoutMs);
+  // A ChannelData message of 4 kB, without padding.
+  unsigned char packet[4096] = {0x40, 0x00, 0x0F, 0xFC};
+  rtc::PacketOptions options;
+  for (int i = 0; i < 3; ++i) {
+    send_socket_->Send(packet, sizeof(packet), options);
+  }
+  EXPECT_EQ(0, sent_packets_);
+  send_socket_->Send(packet, sizeof(packet), options);
+  EXPECT_EQ(4, sent_packets_);
+  vss_->ProcessMessagesUntilIdle();
+  EXPECT_EQ(4u, recv_packets_.size());
+}
+
+// Test that disabling coalescing writes the pending packets.
+TEST_F(AsyncStunTCPSocketTest, DisablingCoalescingFlushesPendingPackets) {
+  send_socket_->set_send_coalescing_window_ms(kTimeoutMs);
+  rtc::PacketOptions options;
+  send_socket_->Send(kStunMessageWithZeroLength,
+                     sizeof(kStunMessageWithZeroLength), options);
+  EXPECT_EQ(0, sent_packets_);
+  send_socket_->set_send_coalescing_window_ms(0);
+  EXPECT_EQ(1, sent_packets_);
+  ASSERT_TRUE(
+      Send(kStunMessageWithZeroLength, sizeof(kStunMessageWithZeroLength)));
+  EXPECT_EQ(2, sent_packets_);
+  EXPECT_EQ(2u, recv_packets_.size());
+}
+
 }  // namespace cricket
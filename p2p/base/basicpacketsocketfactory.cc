@@ -187,7 +187,13 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateClientTcpSocket(
   // Finally, wrap that socket in a TCP or STUN TCP packet socket.
   AsyncPacketSocket* tcp_socket;
   if (tcp_options.opts & PacketSocketFactory::OPT_STUN) {
-    tcp_socket = new cricket::AsyncStunTCPSocket(socket, false);
+    cricket::AsyncStunTCPSocket* stun_socket =
+        new cricket::AsyncStunTCPSocket(socket, false);
+    if (tcp_options.send_coalescing_window_ms > 0) {
+      stun_socket->set_send_coalescing_window_ms(
+          tcp_options.send_coalescing_window_ms);
+    }
+    tcp_socket = stun_socket;
   } else {
     tcp_socket = new AsyncTCPSocket(socket, false);
   }
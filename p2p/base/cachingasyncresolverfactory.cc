@@ -0,0 +1,303 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/cachingasyncresolverfactory.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/asyncinvoker.h"
+#include "rtc_base/bind.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/ipaddress.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+
+// The lookups in progress and the cached results, shared by all the factories
+// created with CreateSharedInstance().
+class CachingAsyncResolverFactory::Cache : public rtc::RefCountInterface,
+                                           public sigslot::has_slots<> {
+ public:
+  struct Result {
+    int error = 0;
+    // At most one address of each family, like GetResolvedAddress returns.
+    std::vector<rtc::IPAddress> addresses;
+  };
+
+  Cache(std::unique_ptr<AsyncResolverFactory> factory, int cache_ttl_ms);
+  ~Cache() override;
+
+  // Returns true and sets |result| if |hostname| has a cached result.
+  // Otherwise joins or starts the lookup of |hostname|, and calls
+  // OnLookupDone on |resolver| when it completes.
+  bool Lookup(const rtc::SocketAddress& addr,
+              const std::string& hostname,
+              CachingResolver* resolver,
+              Result* result);
+  // Stops waiting for the lookup of |hostname| on behalf of |resolver|.
+  void CancelLookup(const std::string& hostname, CachingResolver* resolver);
+
+  int num_lookups() const;
+
+ private:
+  struct CacheEntry {
+    Result result;
+    int64_t expiration_ms;
+  };
+  struct PendingLookup {
+    rtc::AsyncResolverInterface* resolver;
+    std::vector<CachingResolver*> waiters;
+  };
+
+  void OnResolverDone(rtc::AsyncResolverInterface* resolver);
+
+  const std::unique_ptr<AsyncResolverFactory> factory_;
+  const int cache_ttl_ms_;
+  rtc::CriticalSection crit_;
+  std::map<std::string, CacheEntry> entries_ RTC_GUARDED_BY(crit_);
+  std::map<std::string, PendingLookup> pending_lookups_ RTC_GUARDED_BY(crit_);
+  int num_lookups_ RTC_GUARDED_BY(crit_) = 0;
+  rtc::AsyncInvoker invoker_;
+};
+
+// The resolver handed out by Create(). It waits for the shared lookup of its
+// hostname and signals completion on the thread that started it.
+class CachingAsyncResolverFactory::CachingResolver
+    : public rtc::AsyncResolverInterface {
+ public:
+  explicit CachingResolver(rtc::scoped_refptr<Cache> cache)
+      : cache_(std::move(cache)) {}
+
+  void Start(const rtc::SocketAddress& addr) override;
+  bool GetResolvedAddress(int family, rtc::SocketAddress* addr) const override;
+  int GetError() const override;
+  void Destroy(bool wait) override;
+
+  // Called by |cache_| with its lock held, on the thread of the lookup.
+  void OnLookupDone(const Cache::Result& result);
+
+ private:
+  ~CachingResolver() override = default;
+
+  void SetResult(const Cache::Result& result);
+
+  const rtc::scoped_refptr<Cache> cache_;
+  rtc::SocketAddress addr_;
+  std::string hostname_;
+  rtc::Thread* thread_ = nullptr;
+  bool pending_ = false;
+  Cache::Result result_;
+  rtc::AsyncInvoker invoker_;
+};
+
+CachingAsyncResolverFactory::Cache::Cache(
+    std::unique_ptr<AsyncResolverFactory> factory,
+    int cache_ttl_ms)
+    : factory_(std::move(factory)), cache_ttl_ms_(cache_ttl_ms) {
+  RTC_DCHECK(factory_);
+}
+
+CachingAsyncResolverFactory::Cache::~Cache() {
+  // Every resolver holds a reference, so nobody is waiting anymore.
+  rtc::CritScope lock(&crit_);
+  for (auto& kv : pending_lookups_) {
+    RTC_DCHECK(kv.second.waiters.empty());
+    kv.second.resolver->SignalDone.disconnect(this);
+    kv.second.resolver->Destroy(false);
+  }
+}
+
+bool CachingAsyncResolverFactory::Cache::Lookup(
+    const rtc::SocketAddress& addr,
+    const std::string& hostname,
+    CachingResolver* resolver,
+    Result* result) {
+  rtc::AsyncResolverInterface* lookup_resolver = nullptr;
+  {
+    rtc::CritScope lock(&crit_);
+    int64_t now = rtc::TimeMillis();
+    auto entry = entries_.find(hostname);
+    if (entry != entries_.end()) {
+      if (now < entry->second.expiration_ms) {
+        *result = entry->second.result;
+        return true;
+      }
+      entries_.erase(entry);
+    }
+    auto pending = pending_lookups_.find(hostname);
+    if (pending != pending_lookups_.end()) {
+      pending->second.waiters.push_back(resolver);
+      return false;
+    }
+    lookup_resolver = factory_->Create();
+    pending_lookups_[hostname] = {lookup_resolver, {resolver}};
+    ++num_lookups_;
+  }
+  // Started without the lock held, since the resolver may be done right away.
+  lookup_resolver->SignalDone.connect(this, &Cache::OnResolverDone);
+  lookup_resolver->Start(addr);
+  return false;
+}
+
+void CachingAsyncResolverFactory::Cache::CancelLookup(
+    const std::string& hostname,
+    CachingResolver* resolver) {
+  rtc::CritScope lock(&crit_);
+  auto pending = pending_lookups_.find(hostname);
+  if (pending == pending_lookups_.end()) {
+    return;
+  }
+  // The lookup itself continues, so that its result is cached for others.
+  std::vector<CachingResolver*>& waiters = pending->second.waiters;
+  waiters.erase(std::remove(waiters.begin(), waiters.end(), resolver),
+                waiters.end());
+}
+
+int CachingAsyncResolverFactory::Cache::num_lookups() const {
+  rtc::CritScope lock(&crit_);
+  return num_lookups_;
+}
+
+void CachingAsyncResolverFactory::Cache::OnResolverDone(
+    rtc::AsyncResolverInterface* resolver) {
+  Result result;
+  result.error = resolver->GetError();
+  if (result.error == 0) {
+    for (int family : {AF_INET, AF_INET6}) {
+      rtc::SocketAddress resolved;
+      if (resolver->GetResolvedAddress(family, &resolved)) {
+        result.addresses.push_back(resolved.ipaddr());
+      }
+    }
+  }
+
+  {
+    rtc::CritScope lock(&crit_);
+    auto pending = std::find_if(
+        pending_lookups_.begin(), pending_lookups_.end(),
+        [resolver](const std::pair<const std::string, PendingLookup>& kv) {
+          return kv.second.resolver == resolver;
+        });
+    RTC_DCHECK(pending != pending_lookups_.end());
+    if (pending != pending_lookups_.end()) {
+      // Failures are not cached; the name may not have been announced yet.
+      if (result.error == 0 && !result.addresses.empty()) {
+        entries_[pending->first] = {result,
+                                    rtc::TimeMillis() + cache_ttl_ms_};
+      }
+      RTC_LOG(LS_VERBOSE) << "Resolved hostname for "
+                          << pending->second.waiters.size()
+                          << " resolvers, error " << result.error;
+      for (CachingResolver* waiter : pending->second.waiters) {
+        waiter->OnLookupDone(result);
+      }
+      pending_lookups_.erase(pending);
+    }
+  }
+
+  resolver->SignalDone.disconnect(this);
+  invoker_.AsyncInvoke<void>(
+      RTC_FROM_HERE, rtc::Thread::Current(),
+      rtc::Bind(&rtc::AsyncResolverInterface::Destroy, resolver, false));
+}
+
+void CachingAsyncResolverFactory::CachingResolver::Start(
+    const rtc::SocketAddress& addr) {
+  RTC_DCHECK(!pending_);
+  addr_ = addr;
+  hostname_ = addr.HostAsURIString();
+  thread_ = rtc::Thread::Current();
+  pending_ = true;
+  Cache::Result result;
+  if (cache_->Lookup(addr_, hostname_, this, &result)) {
+    // Signal asynchronously, as an actual lookup would.
+    OnLookupDone(result);
+  }
+}
+
+bool CachingAsyncResolverFactory::CachingResolver::GetResolvedAddress(
+    int family,
+    rtc::SocketAddress* addr) const {
+  if (result_.error != 0) {
+    return false;
+  }
+  for (const rtc::IPAddress& ip : result_.addresses) {
+    if (ip.family() == family) {
+      *addr = addr_;
+      addr->SetResolvedIP(ip);
+      return true;
+    }
+  }
+  return false;
+}
+
+int CachingAsyncResolverFactory::CachingResolver::GetError() const {
+  return result_.error;
+}
+
+void CachingAsyncResolverFactory::CachingResolver::Destroy(bool wait) {
+  if (pending_) {
+    cache_->CancelLookup(hostname_, this);
+  }
+  delete this;
+}
+
+void CachingAsyncResolverFactory::CachingResolver::OnLookupDone(
+    const Cache::Result& result) {
+  invoker_.AsyncInvoke<void>(
+      RTC_FROM_HERE, thread_,
+      rtc::Bind(&CachingResolver::SetResult, this, result));
+}
+
+void CachingAsyncResolverFactory::CachingResolver::SetResult(
+    const Cache::Result& result) {
+  pending_ = false;
+  result_ = result;
+  SignalDone(this);
+}
+
+CachingAsyncResolverFactory::CachingAsyncResolverFactory(
+    std::unique_ptr<AsyncResolverFactory> factory,
+    int cache_ttl_ms)
+    : cache_(new rtc::RefCountedObject<Cache>(std::move(factory),
+                                              cache_ttl_ms)) {}
+
+CachingAsyncResolverFactory::CachingAsyncResolverFactory(
+    rtc::scoped_refptr<Cache> cache)
+    : cache_(std::move(cache)) {}
+
+CachingAsyncResolverFactory::~CachingAsyncResolverFactory() = default;
+
+std::unique_ptr<CachingAsyncResolverFactory>
+CachingAsyncResolverFactory::CreateSharedInstance() const {
+  return std::unique_ptr<CachingAsyncResolverFactory>(
+      new CachingAsyncResolverFactory(cache_));
+}
+
+rtc::AsyncResolverInterface* CachingAsyncResolverFactory::Create() {
+  return new CachingResolver(cache_);
+}
+
+int CachingAsyncResolverFactory::num_lookups() const {
+  return cache_->num_lookups();
+}
+
+}  // namespace webrtc
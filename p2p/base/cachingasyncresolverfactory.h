@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_CACHINGASYNCRESOLVERFACTORY_H_
+#define P2P_BASE_CACHINGASYNCRESOLVERFACTORY_H_
+
+#include <memory>
+
+#include "api/asyncresolverfactory.h"
+#include "rtc_base/asyncresolverinterface.h"
+#include "rtc_base/scoped_ref_ptr.h"
+
+namespace webrtc {
+
+// An AsyncResolverFactory that resolves hostnames with the resolvers of
+// another factory, but only once per hostname: resolvers that start while a
+// lookup of the same hostname is in progress wait for its result, and
+// successful results are cached for |cache_ttl_ms|. This keeps the mDNS
+// hostnames of remote host candidates from being resolved again by every
+// session when many sessions start at once.
+//
+// The lookups and the cache can be shared with the factories returned by
+// CreateSharedInstance(), e.g. one for each PeerConnection. These may be used
+// on different threads; each resolver signals completion on the thread it was
+// started on.
+class CachingAsyncResolverFactory : public AsyncResolverFactory {
+ public:
+  // mDNS names are only announced for the lifetime of a session, so results
+  // are not kept for long by default.
+  static const int kDefaultCacheTtlMs = 10000;
+
+  explicit CachingAsyncResolverFactory(
+      std::unique_ptr<AsyncResolverFactory> factory,
+      int cache_ttl_ms = kDefaultCacheTtlMs);
+  ~CachingAsyncResolverFactory() override;
+
+  // Returns a factory that shares its lookups and cache with this one.
+  std::unique_ptr<CachingAsyncResolverFactory> CreateSharedInstance() const;
+
+  // The caller should call Destroy on the returned object to delete it.
+  rtc::AsyncResolverInterface* Create() override;
+
+  // The number of lookups started with the wrapped factory.
+  int num_lookups() const;
+
+ private:
+  class Cache;
+  class CachingResolver;
+
+  explicit CachingAsyncResolverFactory(rtc::scoped_refptr<Cache> cache);
+
+  const rtc::scoped_refptr<Cache> cache_;
+};
+
+}  // namespace webrtc
+
+#endif  // P2P_BASE_CACHINGASYNCRESOLVERFACTORY_H_
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/cachingasyncresolverfactory.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/mockasyncresolver.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/socketaddress.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/virtualsocketserver.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+
+namespace {
+
+const int kDefaultTimeout = 1000;
+
+}  // namespace
+
+class CachingAsyncResolverFactoryTest : public testing::Test,
+                                        public sigslot::has_slots<> {
+ public:
+  CachingAsyncResolverFactoryTest()
+      : vss_(new rtc::VirtualSocketServer()), thread_(vss_.get()) {
+    auto factory = absl::make_unique<MockAsyncResolverFactory>();
+    mock_factory_ = factory.get();
+    factory_ =
+        absl::make_unique<CachingAsyncResolverFactory>(std::move(factory));
+    // The lookup completes only when the test signals it.
+    ON_CALL(mock_resolver_, Start(_)).WillByDefault(Return());
+    ON_CALL(second_mock_resolver_, Start(_)).WillByDefault(Return());
+  }
+
+  ~CachingAsyncResolverFactoryTest() override {
+    for (rtc::AsyncResolverInterface* resolver : resolvers_) {
+      resolver->Destroy(false);
+    }
+  }
+
+  rtc::AsyncResolverInterface* StartResolver(
+      CachingAsyncResolverFactory* factory,
+      const rtc::SocketAddress& addr) {
+    rtc::AsyncResolverInterface* resolver = factory->Create();
+    resolver->SignalDone.connect(this,
+                                 &CachingAsyncResolverFactoryTest::OnDone);
+    resolvers_.push_back(resolver);
+    resolver->Start(addr);
+    return resolver;
+  }
+
+  void CompleteLookup(const rtc::IPAddress& ip) {
+    rtc::SocketAddress resolved(ip, 0);
+    EXPECT_CALL(mock_resolver_, GetError()).WillRepeatedly(Return(0));
+    EXPECT_CALL(mock_resolver_, GetResolvedAddress(ip.family(), _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(resolved), Return(true)));
+    mock_resolver_.SignalDone(&mock_resolver_);
+  }
+
+  void OnDone(rtc::AsyncResolverInterface* resolver) { ++num_done_; }
+
+ protected:
+  std::unique_ptr<rtc::VirtualSocketServer> vss_;
+  rtc::AutoSocketServerThread thread_;
+  NiceMock<rtc::MockAsyncResolver> mock_resolver_;
+  NiceMock<rtc::MockAsyncResolver> second_mock_resolver_;
+  MockAsyncResolverFactory* mock_factory_;
+  std::unique_ptr<CachingAsyncResolverFactory> factory_;
+  std::vector<rtc::AsyncResolverInterface*> resolvers_;
+  int num_done_ = 0;
+};
+
+TEST_F(CachingAsyncResolverFactoryTest, ConcurrentResolversShareOneLookup) {
+  EXPECT_CALL(*mock_factory_, Create()).WillOnce(Return(&mock_resolver_));
+  std::unique_ptr<CachingAsyncResolverFactory> other_factory =
+      factory_->CreateSharedInstance();
+
+  rtc::SocketAddress addr("host.local", 1000);
+  rtc::AsyncResolverInterface* resolver1 = StartResolver(factory_.get(), addr);
+  rtc::AsyncResolverInterface* resolver2 = StartResolver(
+      other_factory.get(), rtc::SocketAddress("host.local", 2000));
+  EXPECT_EQ(1, factory_->num_lookups());
+
+  rtc::IPAddress ip(0x01020304);
+  CompleteLookup(ip);
+  ASSERT_EQ_WAIT(2, num_done_, kDefaultTimeout);
+
+  rtc::SocketAddress resolved;
+  EXPECT_EQ(0, resolver1->GetError());
+  ASSERT_TRUE(resolver1->GetResolvedAddress(AF_INET, &resolved));
+  EXPECT_EQ(ip, resolved.ipaddr());
+  EXPECT_EQ(1000, resolved.port());
+  ASSERT_TRUE(resolver2->GetResolvedAddress(AF_INET, &resolved));
+  EXPECT_EQ(ip, resolved.ipaddr());
+  EXPECT_EQ(2000, resolved.port());
+  EXPECT_FALSE(resolver1->GetResolvedAddress(AF_INET6, &resolved));
+}
+
+TEST_F(CachingAsyncResolverFactoryTest, ResultIsCached) {
+  EXPECT_CALL(*mock_factory_, Create()).WillOnce(Return(&mock_resolver_));
+  rtc::SocketAddress addr("host.local", 1000);
+  StartResolver(factory_.get(), addr);
+  CompleteLookup(rtc::IPAddress(0x01020304));
+  ASSERT_EQ_WAIT(1, num_done_, kDefaultTimeout);
+
+  // Completes without another lookup, but still asynchronously.
+  StartResolver(factory_.get(), addr);
+  EXPECT_EQ(1, num_done_);
+  EXPECT_EQ_WAIT(2, num_done_, kDefaultTimeout);
+  EXPECT_EQ(1, factory_->num_lookups());
+}
+
+TEST_F(CachingAsyncResolverFactoryTest, FailureIsNotCached) {
+  EXPECT_CALL(*mock_factory_, Create())
+      .WillOnce(Return(&mock_resolver_))
+      .WillOnce(Return(&second_mock_resolver_));
+  rtc::SocketAddress addr("host.local", 1000);
+  rtc::AsyncResolverInterface* resolver = StartResolver(factory_.get(), addr);
+  EXPECT_CALL(mock_resolver_, GetError()).WillRepeatedly(Return(-1));
+  mock_resolver_.SignalDone(&mock_resolver_);
+  ASSERT_EQ_WAIT(1, num_done_, kDefaultTimeout);
+  EXPECT_EQ(-1, resolver->GetError());
+
+  StartResolver(factory_.get(), addr);
+  EXPECT_EQ(2, factory_->num_lookups());
+}
+
+TEST_F(CachingAsyncResolverFactoryTest, DestroyedResolverIsNotSignaled) {
+  EXPECT_CALL(*mock_factory_, Create()).WillOnce(Return(&mock_resolver_));
+  rtc::SocketAddress addr("host.local", 1000);
+  StartResolver(factory_.get(), addr);
+  StartResolver(factory_.get(), addr);
+  resolvers_.back()->Destroy(false);
+  resolvers_.pop_back();
+
+  CompleteLookup(rtc::IPAddress(0x01020304));
+  ASSERT_EQ_WAIT(1, num_done_, kDefaultTimeout);
+  // Give a signal to the destroyed resolver a chance to be delivered.
+  rtc::Thread::Current()->ProcessMessages(0);
+  EXPECT_EQ(1, num_done_);
+}
+
+}  // namespace webrtc
@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string.h>
+
 #include <algorithm>
 #include <memory>
 #include <utility>
@@ -28,6 +30,8 @@
 #include "rtc_base/sslstreamadapter.h"
 #include "rtc_base/stream.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace cricket {
 
@@ -76,6 +80,16 @@ rtc::StreamResult StreamInterfaceChannel::Read(void* buffer,
   if (state_ == rtc::SS_OPENING)
     return rtc::SR_BLOCK;
 
+  if (pending_packet_) {
+    size_t size = std::min(buffer_len, pending_packet_size_);
+    memcpy(buffer, pending_packet_, size);
+    if (read) {
+      *read = size;
+    }
+    pending_packet_ = nullptr;
+    return rtc::SR_SUCCESS;
+  }
+
   if (!packets_.ReadFront(buffer, buffer_len, read)) {
     return rtc::SR_BLOCK;
   }
@@ -100,6 +114,21 @@ rtc::StreamResult StreamInterfaceChannel::Write(const void* data,
 }
 
 bool StreamInterfaceChannel::OnPacketReceived(const char* data, size_t size) {
+  RTC_DCHECK(!pending_packet_);
+  if (packets_.size() == 0) {
+    // The SSL stream normally reads the packet while handling the read event,
+    // so hand it over without copying it into the queue first.
+    pending_packet_ = data;
+    pending_packet_size_ = size;
+    SignalEvent(this, rtc::SE_READ, 0);
+    if (!pending_packet_) {
+      return true;
+    }
+    pending_packet_ = nullptr;
+    bool ret = packets_.WriteBack(data, size, NULL);
+    RTC_CHECK(ret) << "Failed to write packet to queue.";
+    return ret;
+  }
   // We force a read event here to ensure that we don't overflow our queue.
   bool ret = packets_.WriteBack(data, size, NULL);
   RTC_CHECK(ret) << "Failed to write packet to queue.";
@@ -114,6 +143,7 @@ rtc::StreamState StreamInterfaceChannel::GetState() const {
 }
 
 void StreamInterfaceChannel::Close() {
+  pending_packet_ = nullptr;
   packets_.Clear();
   state_ = rtc::SS_CLOSED;
 }
@@ -631,6 +661,13 @@ void DtlsTransport::OnDtlsEvent(rtc::StreamInterface* dtls, int sig, int err) {
     if (dtls_->GetState() == rtc::SS_OPEN) {
       // The check for OPEN shouldn't be necessary but let's make
       // sure we don't accidentally frob the state if it's closed.
+      if (handshake_start_time_ms_) {
+        // Media can be sent this long after the ice transport became writable.
+        RTC_HISTOGRAM_COUNTS_10000(
+            "WebRTC.PeerConnection.DtlsHandshakeTimeMs",
+            static_cast<int>(rtc::TimeMillis() - *handshake_start_time_ms_));
+        handshake_start_time_ms_.reset();
+      }
       set_dtls_state(DTLS_TRANSPORT_CONNECTED);
       set_writable(true);
     }
@@ -696,6 +733,7 @@ void DtlsTransport::MaybeStartDtls() {
       return;
     }
     RTC_LOG(LS_INFO) << ToString() << ": DtlsTransport: Started DTLS handshake";
+    handshake_start_time_ms_ = rtc::TimeMillis();
     set_dtls_state(DTLS_TRANSPORT_CONNECTING);
     // Now that the handshake has started, we can process a cached ClientHello
     // (if one exists).
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/crypto/cryptooptions.h"
 #include "p2p/base/dtlstransportinternal.h"
 #include "p2p/base/icetransportinternal.h"
@@ -56,6 +57,11 @@ class StreamInterfaceChannel : public rtc::StreamInterface {
  private:
   IceTransportInternal* ice_transport_;  // owned by DtlsTransport
   rtc::StreamState state_;
+  // The packet being signaled by OnPacketReceived(). It is read directly from
+  // the caller's buffer, and only copied into |packets_| if it's not read
+  // while signaling.
+  const char* pending_packet_ = nullptr;
+  size_t pending_packet_size_ = 0;
   rtc::BufferQueue packets_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(StreamInterfaceChannel);
@@ -241,6 +247,10 @@ class DtlsTransport : public DtlsTransportInternal {
   // ice transport became writable, or before a remote fingerprint was received.
   rtc::Buffer cached_client_hello_;
 
+  // Time the DTLS handshake was started, which is when the ice transport first
+  // became writable, for reporting how long the handshake delays media.
+  absl::optional<int64_t> handshake_start_time_ms_;
+
   bool receiving_ = false;
   bool writable_ = false;
 
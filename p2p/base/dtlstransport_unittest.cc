@@ -11,7 +11,9 @@
 #include <algorithm>
 #include <memory>
 #include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "p2p/base/dtlstransport.h"
 #include "p2p/base/fakeicetransport.h"
@@ -24,6 +26,7 @@
 #include "rtc_base/ssladapter.h"
 #include "rtc_base/sslidentity.h"
 #include "rtc_base/sslstreamadapter.h"
+#include "system_wrappers/include/metrics.h"
 
 #define MAYBE_SKIP_TEST(feature)                                  \
   if (!(rtc::SSLStreamAdapter::feature())) {                      \
@@ -421,6 +424,16 @@ TEST_F(DtlsTransportTest, TestTransferDtls) {
   TestTransfer(1000, 100, /*srtp=*/false);
 }
 
+// Test that the time from the start to the end of the DTLS handshake is
+// reported by both endpoints.
+TEST_F(DtlsTransportTest, TestHandshakeTimeIsReported) {
+  webrtc::metrics::Reset();
+  PrepareDtls(rtc::KT_DEFAULT);
+  ASSERT_TRUE(Connect());
+  EXPECT_EQ(2, webrtc::metrics::NumSamples(
+                   "WebRTC.PeerConnection.DtlsHandshakeTimeMs"));
+}
+
 // Connect with DTLS, combine multiple DTLS records into one packet.
 // Our DTLS implementation doesn't do this, but other implementations may;
 // see https://tools.ietf.org/html/rfc6347#section-4.1.1.
@@ -737,4 +750,44 @@ INSTANTIATE_TEST_CASE_P(
                                             CALLER_RECEIVES_FINGERPRINT}),
         ::testing::Bool()));
 
+class StreamReader : public sigslot::has_slots<> {
+ public:
+  void OnEvent(rtc::StreamInterface* stream, int events, int error) {
+    if (!read_on_event_) {
+      return;
+    }
+    char buffer[64];
+    size_t read;
+    while (stream->Read(buffer, sizeof(buffer), &read, nullptr) ==
+           rtc::SR_SUCCESS) {
+      packets_.emplace_back(buffer, read);
+    }
+  }
+
+  bool read_on_event_ = true;
+  std::vector<std::string> packets_;
+};
+
+// Packets are read while the read event is signaled, and packets that aren't
+// read then stay queued until the next read.
+TEST(StreamInterfaceChannelTest, ReadsPacketsInOrder) {
+  FakeIceTransport ice_transport("fake", 0);
+  StreamInterfaceChannel channel(&ice_transport);
+  StreamReader reader;
+  channel.SignalEvent.connect(&reader, &StreamReader::OnEvent);
+
+  EXPECT_TRUE(channel.OnPacketReceived("first", 5));
+  EXPECT_EQ(std::vector<std::string>{"first"}, reader.packets_);
+
+  reader.read_on_event_ = false;
+  EXPECT_TRUE(channel.OnPacketReceived("second", 6));
+  EXPECT_TRUE(channel.OnPacketReceived("third", 5));
+  EXPECT_EQ(1u, reader.packets_.size());
+
+  reader.read_on_event_ = true;
+  EXPECT_TRUE(channel.OnPacketReceived("fourth", 6));
+  EXPECT_EQ((std::vector<std::string>{"first", "second", "third", "fourth"}),
+            reader.packets_);
+}
+
 }  // namespace cricket
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <set>
 #include <utility>
 
@@ -34,6 +35,13 @@ namespace {
 // The minimum improvement in RTT that justifies a switch.
 const int kMinImprovement = 10;
 
+// The time of a connection that only a state change can make pingable.
+const int64_t kNoPingCheck = std::numeric_limits<int64_t>::max();
+
+// The ping check queue is rebuilt without its dropped entries once it holds
+// this many entries per connection.
+const size_t kMaxPingChecksPerConnection = 4;
+
 bool IsRelayRelay(const cricket::Connection* conn) {
   return conn->local_candidate().type() == cricket::RELAY_PORT_TYPE &&
          conn->remote_candidate().type() == cricket::RELAY_PORT_TYPE;
@@ -190,7 +198,9 @@ void P2PTransportChannel::AddAllocatorSession(
 
 void P2PTransportChannel::AddConnection(Connection* connection) {
   connections_.push_back(connection);
+  connection_set_.insert(connection);
   unpinged_connections_.insert(connection);
+  SchedulePingCheck(connection, 0);
   connection->set_remote_ice_mode(remote_ice_mode_);
   connection->set_receiving_timeout(config_.receiving_timeout);
   connection->set_unwritable_timeout(config_.ice_unwritable_timeout);
@@ -463,6 +473,8 @@ void P2PTransportChannel::SetRemoteIceParameters(
     conn->MaybeSetRemoteIceParametersAndGeneration(
         ice_params, static_cast<int>(remote_ice_parameters_.size() - 1));
   }
+  // The remote passwords may have changed which connections are pingable.
+  ping_schedule_stale_ = true;
   // Updating the remote ICE candidate generation could change the sort order.
   RequestSortAndStateUpdate("remote candidate generation maybe changed");
 }
@@ -488,6 +500,9 @@ void P2PTransportChannel::SetIceConfig(const IceConfig& config) {
     }
   }
 
+  // The ping intervals below decide when connections become pingable.
+  ping_schedule_stale_ = true;
+
   if (config_.backup_connection_ping_interval !=
       config.backup_connection_ping_interval) {
     config_.backup_connection_ping_interval =
@@ -1266,9 +1281,7 @@ bool P2PTransportChannel::CreateConnection(PortInterface* port,
 }
 
 bool P2PTransportChannel::FindConnection(Connection* connection) const {
-  std::vector<Connection*>::const_iterator citer =
-      std::find(connections_.begin(), connections_.end(), connection);
-  return citer != connections_.end();
+  return connection_set_.count(connection) > 0;
 }
 
 uint32_t P2PTransportChannel::GetRemoteCandidateGeneration(
@@ -1692,15 +1705,20 @@ void P2PTransportChannel::SortConnectionsAndUpdateState(
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
   // TODO(honghaiz): Don't sort;  Just use std::max_element in the right places.
-  std::stable_sort(connections_.begin(), connections_.end(),
-                   [this](const Connection* a, const Connection* b) {
-                     int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
-                     if (cmp != 0) {
-                       return cmp > 0;
-                     }
-                     // Otherwise, sort based on latency estimate.
-                     return a->rtt() < b->rtt();
-                   });
+  auto is_better = [this](const Connection* a, const Connection* b) {
+    int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
+    if (cmp != 0) {
+      return cmp > 0;
+    }
+    // Otherwise, sort based on latency estimate.
+    return a->rtt() < b->rtt();
+  };
+  // Most state changes do not change the order, so check that with a single
+  // linear pass before sorting. A stable sort leaves a sorted list unchanged,
+  // so skipping it gives the same order.
+  if (!std::is_sorted(connections_.begin(), connections_.end(), is_better)) {
+    std::stable_sort(connections_.begin(), connections_.end(), is_better);
+  }
 
   RTC_LOG(LS_VERBOSE) << "Sorting " << connections_.size()
                       << " available connections";
@@ -1825,6 +1843,7 @@ void P2PTransportChannel::SwitchSelectedConnection(Connection* conn) {
   // destroyed, so don't use it.
   Connection* old_selected_connection = selected_connection_;
   selected_connection_ = conn;
+  ping_schedule_stale_ = true;
   LogCandidatePairConfig(conn, webrtc::IceCandidatePairConfigType::kSelected);
   network_route_.reset();
   if (old_selected_connection) {
@@ -2026,51 +2045,131 @@ bool P2PTransportChannel::IsBackupConnection(const Connection* conn) const {
 // how a TCP connection is kicked into reconnecting on the active side.
 bool P2PTransportChannel::IsPingable(const Connection* conn,
                                      int64_t now) const {
+  return NextPingableTime(conn, now) <= now;
+}
+
+int64_t P2PTransportChannel::NextPingableTime(const Connection* conn,
+                                              int64_t now) const {
   const Candidate& remote = conn->remote_candidate();
   // We should never get this far with an empty remote ufrag.
   RTC_DCHECK(!remote.username().empty());
   if (remote.username().empty() || remote.password().empty()) {
     // If we don't have an ICE ufrag and pwd, there's no way we can ping.
-    return false;
+    return kNoPingCheck;
   }
 
   // A failed connection will not be pinged.
   if (conn->state() == IceCandidatePairState::FAILED) {
-    return false;
+    return kNoPingCheck;
   }
 
   // An never connected connection cannot be written to at all, so pinging is
   // out of the question. However, if it has become WRITABLE, it is in the
   // reconnecting state so ping is needed.
   if (!conn->connected() && !conn->writable()) {
-    return false;
+    return kNoPingCheck;
   }
 
   // If the channel is weakly connected, ping all connections.
   if (weak()) {
-    return true;
+    return now;
   }
 
   // Always ping active connections regardless whether the channel is completed
   // or not, but backup connections are pinged at a slower rate.
   if (IsBackupConnection(conn)) {
-    return conn->rtt_samples() == 0 ||
-           (now >= conn->last_ping_response_received() +
-                       config_.backup_connection_ping_interval_or_default());
+    if (conn->rtt_samples() == 0) {
+      return now;
+    }
+    return conn->last_ping_response_received() +
+           config_.backup_connection_ping_interval_or_default();
   }
   // Don't ping inactive non-backup connections.
   if (!conn->active()) {
-    return false;
+    return kNoPingCheck;
   }
 
   // Do ping unwritable, active connections.
   if (!conn->writable()) {
-    return true;
+    return now;
   }
 
   // Ping writable, active connections if it's been long enough since the last
-  // ping.
-  return WritableConnectionPastPingInterval(conn, now);
+  // ping. A stable connection is pinged at the higher rate as soon as a ping
+  // response is missing, which happens without any state change.
+  int64_t next_ping_time =
+      conn->last_ping_sent() + CalculateActiveWritablePingInterval(conn, now);
+  int64_t unstable_time = conn->unstable_time();
+  if (next_ping_time > now && unstable_time > 0 && conn->stable(now)) {
+    next_ping_time = std::min(next_ping_time, unstable_time);
+  }
+  return next_ping_time;
+}
+
+void P2PTransportChannel::SchedulePingCheck(Connection* conn,
+                                            int64_t time_ms) {
+  next_ping_check_ms_[conn] = time_ms;
+  if (time_ms == kNoPingCheck) {
+    return;
+  }
+  ping_check_queue_.push({time_ms, conn});
+  if (ping_check_queue_.size() >
+      kMaxPingChecksPerConnection * next_ping_check_ms_.size()) {
+    decltype(ping_check_queue_) live_checks;
+    for (const auto& kv : next_ping_check_ms_) {
+      if (kv.second != kNoPingCheck) {
+        live_checks.push({kv.second, kv.first});
+      }
+    }
+    ping_check_queue_.swap(live_checks);
+  }
+}
+
+void P2PTransportChannel::UpdatePingableConnections(int64_t now) {
+  // The pingability of every connection depends on the channel state, so start
+  // over when it changes.
+  if (ping_schedule_stale_ || ping_schedule_weak_ != weak() ||
+      ping_schedule_state_ != state_) {
+    ping_schedule_stale_ = false;
+    ping_schedule_weak_ = weak();
+    ping_schedule_state_ = state_;
+    pingable_connections_.clear();
+    next_ping_check_ms_.clear();
+    ping_check_queue_ = decltype(ping_check_queue_)();
+    for (Connection* conn : connections_) {
+      SchedulePingCheck(conn, now);
+    }
+  }
+
+  // Pinging a connection makes it wait for its next ping interval.
+  std::vector<Connection*> no_longer_pingable;
+  for (Connection* conn : pingable_connections_) {
+    if (!IsPingable(conn, now)) {
+      no_longer_pingable.push_back(conn);
+    }
+  }
+  for (Connection* conn : no_longer_pingable) {
+    pingable_connections_.erase(conn);
+    SchedulePingCheck(conn, NextPingableTime(conn, now));
+  }
+
+  while (!ping_check_queue_.empty() && ping_check_queue_.top().time_ms <= now) {
+    PingCheck check = ping_check_queue_.top();
+    ping_check_queue_.pop();
+    auto it = next_ping_check_ms_.find(check.connection);
+    if (it == next_ping_check_ms_.end() || it->second != check.time_ms) {
+      // The connection was destroyed or rescheduled.
+      continue;
+    }
+    int64_t next_pingable_time = NextPingableTime(check.connection, now);
+    if (next_pingable_time <= now) {
+      it->second = kNoPingCheck;
+      pingable_connections_.insert(check.connection);
+    } else {
+      pingable_connections_.erase(check.connection);
+      SchedulePingCheck(check.connection, next_pingable_time);
+    }
+  }
 }
 
 bool P2PTransportChannel::WritableConnectionPastPingInterval(
@@ -2102,6 +2201,7 @@ int P2PTransportChannel::CalculateActiveWritablePingInterval(
 // Returns the next pingable connection to ping.
 Connection* P2PTransportChannel::FindNextPingableConnection() {
   int64_t now = rtc::TimeMillis();
+  UpdatePingableConnections(now);
 
   // Rule 1: Selected connection takes priority over non-selected ones.
   if (selected_connection_ && selected_connection_->connected() &&
@@ -2142,7 +2242,7 @@ Connection* P2PTransportChannel::FindNextPingableConnection() {
   // Rule 3: Triggered checks have priority over non-triggered connections.
   // Rule 3.1: Among triggered checks, oldest takes precedence.
   Connection* oldest_triggered_check =
-      FindOldestConnectionNeedingTriggeredCheck(now);
+      FindOldestConnectionNeedingTriggeredCheck();
   if (oldest_triggered_check) {
     return oldest_triggered_check;
   }
@@ -2154,20 +2254,21 @@ Connection* P2PTransportChannel::FindNextPingableConnection() {
   // Otherwise, treat everything as unpinged.
   // TODO(honghaiz): Instead of adding two separate vectors, we can add a state
   // "pinged" to filter out unpinged connections.
-  if (std::find_if(unpinged_connections_.begin(), unpinged_connections_.end(),
-                   [this, now](Connection* conn) {
-                     return this->IsPingable(conn, now);
-                   }) == unpinged_connections_.end()) {
+  std::vector<Connection*> pingable_connections;
+  std::copy_if(pingable_connections_.begin(), pingable_connections_.end(),
+               std::back_inserter(pingable_connections),
+               [this](Connection* conn) {
+                 return unpinged_connections_.count(conn) > 0;
+               });
+  if (pingable_connections.empty()) {
     unpinged_connections_.insert(pinged_connections_.begin(),
                                  pinged_connections_.end());
     pinged_connections_.clear();
+    pingable_connections.assign(pingable_connections_.begin(),
+                                pingable_connections_.end());
   }
 
   // Among un-pinged pingable connections, "more pingable" takes precedence.
-  std::vector<Connection*> pingable_connections;
-  std::copy_if(unpinged_connections_.begin(), unpinged_connections_.end(),
-               std::back_inserter(pingable_connections),
-               [this, now](Connection* conn) { return IsPingable(conn, now); });
   auto iter =
       std::max_element(pingable_connections.begin(), pingable_connections.end(),
                        [this](Connection* conn1, Connection* conn2) {
@@ -2272,6 +2373,9 @@ void P2PTransportChannel::OnConnectionStateChange(Connection* connection) {
     MaybeStopPortAllocatorSessions();
   }
 
+  // The new state may make the connection pingable.
+  SchedulePingCheck(connection, 0);
+
   // We have to unroll the stack before doing this because we may be changing
   // the state of connections while sorting.
   RequestSortAndStateUpdate("candidate pair state changed");
@@ -2291,6 +2395,9 @@ void P2PTransportChannel::OnConnectionDestroyed(Connection* connection) {
   RTC_DCHECK(iter != connections_.end());
   pinged_connections_.erase(*iter);
   unpinged_connections_.erase(*iter);
+  pingable_connections_.erase(*iter);
+  next_ping_check_ms_.erase(*iter);
+  connection_set_.erase(*iter);
   connections_.erase(iter);
 
   RTC_LOG(LS_INFO) << ToString() << ": Removed connection " << connection
@@ -2411,21 +2518,30 @@ void P2PTransportChannel::OnReadyToSend(Connection* connection) {
 // received a ping but have not sent a ping since receiving it
 // (last_ping_received > last_ping_sent).  But we shouldn't do
 // triggered checks if the connection is already writable.
-Connection* P2PTransportChannel::FindOldestConnectionNeedingTriggeredCheck(
-    int64_t now) {
+// Only looks at |pingable_connections_|, so UpdatePingableConnections() must
+// have been called first.
+Connection* P2PTransportChannel::FindOldestConnectionNeedingTriggeredCheck() {
   Connection* oldest_needing_triggered_check = nullptr;
-  for (auto* conn : connections_) {
-    if (!IsPingable(conn, now)) {
-      continue;
-    }
+  for (auto* conn : pingable_connections_) {
     bool needs_triggered_check =
         (!conn->writable() &&
          conn->last_ping_received() > conn->last_ping_sent());
-    if (needs_triggered_check &&
-        (!oldest_needing_triggered_check ||
-         (conn->last_ping_received() <
-          oldest_needing_triggered_check->last_ping_received()))) {
+    if (!needs_triggered_check) {
+      continue;
+    }
+    if (!oldest_needing_triggered_check ||
+        conn->last_ping_received() <
+            oldest_needing_triggered_check->last_ping_received()) {
       oldest_needing_triggered_check = conn;
+    } else if (conn->last_ping_received() ==
+               oldest_needing_triggered_check->last_ping_received()) {
+      // On a tie, the connection that comes first in |connections_| wins.
+      Connection* oldest = oldest_needing_triggered_check;
+      oldest_needing_triggered_check =
+          *std::find_if(connections_.begin(), connections_.end(),
+                        [conn, oldest](Connection* c) {
+                          return c == conn || c == oldest;
+                        });
     }
   }
 
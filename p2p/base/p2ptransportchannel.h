@@ -21,10 +21,14 @@
 #define P2P_BASE_P2PTRANSPORTCHANNEL_H_
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
+#include <queue>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "api/asyncresolverfactory.h"
@@ -267,6 +271,15 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   void RememberRemoteCandidate(const Candidate& remote_candidate,
                                PortInterface* origin_port);
   bool IsPingable(const Connection* conn, int64_t now) const;
+  // Returns the earliest time at which |conn| is pingable, which is at or
+  // before |now| if it is pingable now. Connections that can only become
+  // pingable through a state change return the maximum int64_t value.
+  int64_t NextPingableTime(const Connection* conn, int64_t now) const;
+  // Schedules |conn| to have its pingability re-evaluated at |time_ms|.
+  void SchedulePingCheck(Connection* conn, int64_t time_ms);
+  // Brings |pingable_connections_| up to date with the connections that are
+  // pingable at |now|, evaluating only the connections that are due.
+  void UpdatePingableConnections(int64_t now);
   // Whether a writable connection is past its ping interval and needs to be
   // pinged again.
   bool WritableConnectionPastPingInterval(const Connection* conn,
@@ -335,7 +348,7 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   void PruneConnections();
   bool IsBackupConnection(const Connection* conn) const;
 
-  Connection* FindOldestConnectionNeedingTriggeredCheck(int64_t now);
+  Connection* FindOldestConnectionNeedingTriggeredCheck();
   // Between |conn1| and |conn2|, this function returns the one which should
   // be pinged first.
   Connection* MorePingable(Connection* conn1, Connection* conn2);
@@ -397,9 +410,37 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   // connections as |connections_|. These 2 sets maintain whether a
   // connection should be pinged next or not.
   std::vector<Connection*> connections_;
+  // The same connections as |connections_|, for the membership check done
+  // for every received packet.
+  std::unordered_set<Connection*> connection_set_;
   std::set<Connection*> pinged_connections_;
   std::set<Connection*> unpinged_connections_;
 
+  // The connections that were pingable at the last call to
+  // UpdatePingableConnections().
+  std::unordered_set<Connection*> pingable_connections_;
+  // A min-heap of the times at which connections that are not pingable need
+  // to be re-evaluated. Entries are dropped lazily: an entry is only live if
+  // its time matches the connection's entry in |next_ping_check_ms_|.
+  struct PingCheck {
+    int64_t time_ms;
+    Connection* connection;
+    bool operator>(const PingCheck& other) const {
+      return time_ms > other.time_ms;
+    }
+  };
+  std::priority_queue<PingCheck,
+                      std::vector<PingCheck>,
+                      std::greater<PingCheck>>
+      ping_check_queue_;
+  std::unordered_map<Connection*, int64_t> next_ping_check_ms_;
+  // The channel state the schedule was computed with. The pingability of
+  // every connection depends on it, so all of them are re-evaluated when it
+  // changes.
+  bool ping_schedule_stale_ = true;
+  bool ping_schedule_weak_ = true;
+  IceTransportState ping_schedule_state_ = IceTransportState::STATE_INIT;
+
   Connection* selected_connection_ = nullptr;
 
   std::vector<RemoteCandidate> remote_candidates_;
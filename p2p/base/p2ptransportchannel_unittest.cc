@@ -2878,6 +2878,38 @@ TEST_F(P2PTransportChannelMultihomedTest, TestPingBackupConnectionRate) {
   DestroyChannels();
 }
 
+// Test that lowering the backup ping interval takes effect right away, even
+// though the backup connection was already waiting for the old interval.
+TEST_F(P2PTransportChannelMultihomedTest, TestLowerBackupPingInterval) {
+  AddAddress(0, kPublicAddrs[0]);
+  AddAddress(1, kAlternateAddrs[1]);
+  AddAddress(1, kPublicAddrs[1]);
+
+  // Use only local ports for simplicity.
+  SetAllocatorFlags(0, kOnlyLocalPorts);
+  SetAllocatorFlags(1, kOnlyLocalPorts);
+
+  // Create channels and let them go writable, as usual.
+  CreateChannels();
+  EXPECT_TRUE_WAIT_MARGIN(ep1_ch1()->receiving() && ep1_ch1()->writable() &&
+                              ep2_ch1()->receiving() && ep2_ch1()->writable(),
+                          1000, 1000);
+  ep2_ch1()->SetIceConfig(CreateIceConfig(2000, GATHER_ONCE, 60000));
+  ASSERT_TRUE_WAIT(ep2_ch1()->GetState() == IceTransportState::STATE_COMPLETED,
+                   1000);
+  const std::vector<Connection*>& connections = ep2_ch1()->connections();
+  ASSERT_EQ(2U, connections.size());
+  Connection* backup_conn = connections[1];
+  EXPECT_TRUE_WAIT(backup_conn->writable(), kMediumTimeout);
+
+  int64_t last_ping_sent_ms = backup_conn->last_ping_sent();
+  ep2_ch1()->SetIceConfig(CreateIceConfig(2000, GATHER_ONCE, 500));
+  EXPECT_TRUE_WAIT(last_ping_sent_ms < backup_conn->last_ping_sent(),
+                   kDefaultTimeout);
+
+  DestroyChannels();
+}
+
 TEST_F(P2PTransportChannelMultihomedTest, TestGetState) {
   rtc::ScopedFakeClock clock;
   AddAddress(0, kAlternateAddrs[0]);
@@ -32,6 +32,9 @@ struct PacketSocketTcpOptions {
   // An optional custom SSL certificate verifier that an API user can provide to
   // inject their own certificate verification logic.
   SSLCertificateVerifier* tls_cert_verifier = nullptr;
+  // If positive, and OPT_STUN is set, packets sent within this many
+  // milliseconds of each other are written to the socket together.
+  int send_coalescing_window_ms = 0;
 };
 
 class AsyncPacketSocket;
@@ -1591,6 +1591,14 @@ bool Connection::stable(int64_t now) const {
   return rtt_converged() && !missing_responses(now);
 }
 
+int64_t Connection::unstable_time() const {
+  if (pings_since_last_response_.empty()) {
+    return 0;
+  }
+  // See missing_responses().
+  return pings_since_last_response_[0].sent_time + 2 * rtt() + 1;
+}
+
 std::string Connection::ToDebugId() const {
   return rtc::ToHex(reinterpret_cast<uintptr_t>(this));
 }
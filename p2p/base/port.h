@@ -15,6 +15,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -301,7 +302,10 @@ class Port : public PortInterface,
 
   // Returns a map containing all of the connections of this port, keyed by the
   // remote address.
-  typedef std::map<rtc::SocketAddress, Connection*> AddressMap;
+  typedef std::unordered_map<rtc::SocketAddress,
+                             Connection*,
+                             rtc::SocketAddressHash>
+      AddressMap;
   const AddressMap& connections() { return connections_; }
 
   // Returns the connection to the given address or NULL if none exists.
@@ -743,6 +747,9 @@ class Connection : public CandidatePairInterface,
   }
 
   bool stable(int64_t now) const;
+  // Returns the time at which this connection stops being stable unless a ping
+  // response arrives first, or 0 if no ping is awaiting a response.
+  int64_t unstable_time() const;
 
  protected:
   enum { MSG_DELETE = 0, MSG_FIRST_AVAILABLE };
@@ -87,6 +87,12 @@ enum {
   // Exclude link-local network interfaces
   // from considertaion after adapter enumeration.
   PORTALLOCATOR_DISABLE_LINK_LOCAL_NETWORKS = 0x10000,
+
+  // When specified, each network runs all of its allocation phases (UDP,
+  // relay, TCP) right away instead of step_delay() apart, so that STUN and
+  // TURN allocations on all networks start at once. Allocators may bound the
+  // number of networks that gather at the same time.
+  PORTALLOCATOR_ENABLE_PARALLEL_GATHERING = 0x20000,
 };
 
 // Defines various reasons that have caused ICE regathering.
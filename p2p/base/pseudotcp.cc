@@ -14,7 +14,6 @@
 #include <stdio.h>
 #include <algorithm>
 #include <cstdint>
-#include <memory>
 #include <set>
 
 #include "rtc_base/bytebuffer.h"
@@ -113,6 +112,14 @@ const uint32_t DEF_ACK_DELAY = 100;  // 100 milliseconds
 
 const uint8_t FLAG_CTL = 0x02;
 const uint8_t FLAG_RST = 0x04;
+// The payload of the segment is a list of SACK blocks rather than data. Each
+// block is the 32-bit sequence numbers of the first byte and of the byte
+// after the last one of a range received out of order. Only sent on ACKs to
+// peers that sent the SACK-permitted option.
+const uint8_t FLAG_SACK = 0x08;
+
+const uint32_t SACK_BLOCK_SIZE = 8;
+const uint32_t MAX_SACK_BLOCKS = 4;
 
 const uint8_t CTL_CONNECT = 0;
 
@@ -121,6 +128,7 @@ const uint8_t TCP_OPT_EOL = 0;        // End of list.
 const uint8_t TCP_OPT_NOOP = 1;       // No-op.
 const uint8_t TCP_OPT_MSS = 2;        // Maximum segment size.
 const uint8_t TCP_OPT_WND_SCALE = 3;  // Window scale factor.
+const uint8_t TCP_OPT_SACK_PERMITTED = 4;  // Selective acknowledgments.
 
 const long DEFAULT_TIMEOUT =
     4000;  // If there are no pending clocks, wake up every 4 seconds
@@ -245,6 +253,10 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
   m_dup_acks = 0;
   m_recover = 0;
 
+  m_sack_enabled = false;
+  m_sack_high = 0;
+  m_sack_rexmit_nxt = 0;
+
   m_ts_recent = m_ts_lastack = 0;
 
   m_rx_rto = DEF_RTO;
@@ -253,6 +265,7 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
   m_use_nagling = true;
   m_ack_delay = DEF_ACK_DELAY;
   m_support_wnd_scale = true;
+  m_support_sack = true;
 }
 
 PseudoTcp::~PseudoTcp() {}
@@ -515,28 +528,34 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
 
   uint32_t now = Now();
 
-  std::unique_ptr<uint8_t[]> buffer(new uint8_t[MAX_PACKET]);
-  long_to_bytes(m_conv, buffer.get());
-  long_to_bytes(seq, buffer.get() + 4);
-  long_to_bytes(m_rcv_nxt, buffer.get() + 8);
-  buffer[12] = 0;
-  buffer[13] = flags;
-  short_to_bytes(static_cast<uint16_t>(m_rcv_wnd >> m_rwnd_scale),
-                 buffer.get() + 14);
-
-  // Timestamp computations
-  long_to_bytes(now, buffer.get() + 16);
-  long_to_bytes(m_ts_recent, buffer.get() + 20);
-  m_ts_lastack = m_rcv_nxt;
-
+  m_packet_buf.EnsureCapacity(
+      HEADER_SIZE + std::max(len, MAX_SACK_BLOCKS * SACK_BLOCK_SIZE));
+  uint8_t* buffer = m_packet_buf.data();
+  uint32_t payload_len = len;
   if (len) {
     size_t bytes_read = 0;
     rtc::StreamResult result =
-        m_sbuf.ReadOffset(buffer.get() + HEADER_SIZE, len, offset, &bytes_read);
+        m_sbuf.ReadOffset(buffer + HEADER_SIZE, len, offset, &bytes_read);
     RTC_DCHECK(result == rtc::SR_SUCCESS);
     RTC_DCHECK(static_cast<uint32_t>(bytes_read) == len);
+  } else if (flags == 0 && m_sack_enabled && !m_rlist.empty()) {
+    payload_len = writeSackBlocks(buffer + HEADER_SIZE);
+    flags |= FLAG_SACK;
   }
 
+  long_to_bytes(m_conv, buffer);
+  long_to_bytes(seq, buffer + 4);
+  long_to_bytes(m_rcv_nxt, buffer + 8);
+  buffer[12] = 0;
+  buffer[13] = flags;
+  short_to_bytes(static_cast<uint16_t>(m_rcv_wnd >> m_rwnd_scale),
+                 buffer + 14);
+
+  // Timestamp computations
+  long_to_bytes(now, buffer + 16);
+  long_to_bytes(m_ts_recent, buffer + 20);
+  m_ts_lastack = m_rcv_nxt;
+
 #if _DEBUGMSG >= _DBG_VERBOSE
   RTC_LOG(LS_INFO) << "<-- <CONV=" << m_conv
                    << "><FLG=" << static_cast<unsigned>(flags)
@@ -548,7 +567,7 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
 #endif  // _DEBUGMSG
 
   IPseudoTcpNotify::WriteResult wres = m_notify->TcpWritePacket(
-      this, reinterpret_cast<char*>(buffer.get()), len + HEADER_SIZE);
+      this, reinterpret_cast<char*>(buffer), payload_len + HEADER_SIZE);
   // Note: When len is 0, this is an ACK packet.  We don't read the return value
   // for those, and thus we won't retry.  So go ahead and treat the packet as a
   // success (basically simulate as if it were dropped), which will prevent our
@@ -666,6 +685,14 @@ bool PseudoTcp::process(Segment& seg) {
     return false;
   }
 
+  // A SACK payload only carries acknowledgments.
+  if (seg.flags & FLAG_SACK) {
+    if (m_sack_enabled) {
+      applySackBlocks(seg.data, seg.len);
+    }
+    seg.len = 0;
+  }
+
   // Check for control data
   bool bConnect = false;
   if (seg.flags & FLAG_CTL) {
@@ -770,6 +797,8 @@ bool PseudoTcp::process(Segment& seg) {
           closedown(ECONNABORTED);
           return false;
         }
+        m_sack_rexmit_nxt = std::max(
+            m_sack_rexmit_nxt, m_slist.front().seq + m_slist.front().len);
         m_cwnd += m_mss - std::min(nAcked, m_cwnd);
       }
     } else {
@@ -801,13 +830,18 @@ bool PseudoTcp::process(Segment& seg) {
           return false;
         }
         m_recover = m_snd_nxt;
+        m_sack_rexmit_nxt = m_slist.front().seq + m_slist.front().len;
         uint32_t nInFlight = m_snd_nxt - m_snd_una;
         m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
         // RTC_LOG(LS_INFO) << "m_ssthresh: " << m_ssthresh << "  nInFlight: "
         // << nInFlight << "  m_mss: " << m_mss;
         m_cwnd = m_ssthresh + 3 * m_mss;
       } else if (m_dup_acks > 3) {
-        m_cwnd += m_mss;
+        // Each duplicate ACK means that a segment has left the network. With
+        // SACK, use that to repair the next hole rather than send new data.
+        if (!m_sack_enabled || !retransmitNextHole(now)) {
+          m_cwnd += m_mss;
+        }
       }
     } else {
       m_dup_acks = 0;
@@ -1188,6 +1222,10 @@ void PseudoTcp::disableWindowScale() {
   m_support_wnd_scale = false;
 }
 
+void PseudoTcp::disableSack() {
+  m_support_sack = false;
+}
+
 void PseudoTcp::queueConnectMessage() {
   rtc::ByteBufferWriter buf(rtc::ByteBuffer::ORDER_NETWORK);
 
@@ -1197,6 +1235,10 @@ void PseudoTcp::queueConnectMessage() {
     buf.WriteUInt8(1);
     buf.WriteUInt8(m_rwnd_scale);
   }
+  if (m_support_sack) {
+    buf.WriteUInt8(TCP_OPT_SACK_PERMITTED);
+    buf.WriteUInt8(0);
+  }
   m_snd_wnd = static_cast<uint32_t>(buf.Length());
   queue(buf.Data(), static_cast<uint32_t>(buf.Length()), true);
 }
@@ -1259,6 +1301,9 @@ void PseudoTcp::applyOption(char kind, const char* data, uint32_t len) {
       return;
     }
     applyWindowScaleOption(data[0]);
+  } else if (kind == TCP_OPT_SACK_PERMITTED) {
+    // http://www.ietf.org/rfc/rfc2018.txt
+    m_sack_enabled = m_support_sack;
   }
 }
 
@@ -1266,6 +1311,65 @@ void PseudoTcp::applyWindowScaleOption(uint8_t scale_factor) {
   m_swnd_scale = scale_factor;
 }
 
+uint32_t PseudoTcp::writeSackBlocks(uint8_t* buf) const {
+  // |m_rlist| is sorted by sequence number, but its segments may overlap or
+  // be adjacent. Report the lowest ranges, which are the first the peer has
+  // to repair.
+  uint32_t blocks = 0;
+  RList::const_iterator it = m_rlist.begin();
+  while (it != m_rlist.end() && blocks < MAX_SACK_BLOCKS) {
+    uint32_t start = it->seq;
+    uint32_t end = it->seq + it->len;
+    for (++it; it != m_rlist.end() && it->seq <= end; ++it) {
+      end = std::max(end, it->seq + it->len);
+    }
+    long_to_bytes(start, buf + blocks * SACK_BLOCK_SIZE);
+    long_to_bytes(end, buf + blocks * SACK_BLOCK_SIZE + 4);
+    ++blocks;
+  }
+  return blocks * SACK_BLOCK_SIZE;
+}
+
+void PseudoTcp::applySackBlocks(const char* data, uint32_t len) {
+  for (uint32_t pos = 0; pos + SACK_BLOCK_SIZE <= len;
+       pos += SACK_BLOCK_SIZE) {
+    uint32_t start = bytes_to_long(data + pos);
+    uint32_t end = bytes_to_long(data + pos + 4);
+    if (start < m_snd_una || end <= start || end > m_snd_nxt) {
+      continue;
+    }
+    m_sack_high = std::max(m_sack_high, end);
+    for (SSegment& sseg : m_slist) {
+      if (sseg.seq >= end) {
+        break;
+      }
+      if (sseg.xmit > 0 && sseg.seq >= start && sseg.seq + sseg.len <= end) {
+        sseg.bSacked = true;
+      }
+    }
+  }
+}
+
+bool PseudoTcp::retransmitNextHole(uint32_t now) {
+  for (SList::iterator it = m_slist.begin(); it != m_slist.end(); ++it) {
+    if (it->seq >= m_sack_high || it->xmit == 0) {
+      return false;
+    }
+    if (it->bSacked || it->seq < m_sack_rexmit_nxt) {
+      continue;
+    }
+#if _DEBUGMSG >= _DBG_NORMAL
+    RTC_LOG(LS_INFO) << "sack retransmit";
+#endif  // _DEBUGMSG
+    if (!transmit(it, now)) {
+      return false;
+    }
+    m_sack_rexmit_nxt = it->seq + it->len;
+    return true;
+  }
+  return false;
+}
+
 void PseudoTcp::resizeSendBuffer(uint32_t new_size) {
   m_sbuf_len = new_size;
   m_sbuf.SetCapacity(new_size);
@@ -15,6 +15,7 @@
 #include <stdint.h>
 #include <list>
 
+#include "rtc_base/buffer.h"
 #include "rtc_base/stream.h"
 #include "rtc_base/system/rtc_export.h"
 
@@ -128,11 +129,13 @@ class RTC_EXPORT PseudoTcp {
 
   struct SSegment {
     SSegment(uint32_t s, uint32_t l, bool c)
-        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c) {}
+        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c), bSacked(false) {}
     uint32_t seq, len;
     // uint32_t tstamp;
     uint8_t xmit;
     bool bCtrl;
+    // Whether the peer has selectively acknowledged the segment.
+    bool bSacked;
   };
   typedef std::list<SSegment> SList;
 
@@ -175,6 +178,14 @@ class RTC_EXPORT PseudoTcp {
   // support for testing backward compatibility.
   void disableWindowScale();
 
+  // This method is only used in tests, to disable selective acknowledgment
+  // support for testing backward compatibility.
+  void disableSack();
+
+  // This method is used in test only to query whether selective
+  // acknowledgments have been negotiated with the peer.
+  bool isSackEnabled() const { return m_sack_enabled; }
+
  private:
   // Queue the connect message with TCP options.
   void queueConnectMessage();
@@ -188,6 +199,18 @@ class RTC_EXPORT PseudoTcp {
   // Apply window scale option.
   void applyWindowScaleOption(uint8_t scale_factor);
 
+  // Write the SACK blocks of the out-of-order data in |m_rlist| to |buf|.
+  // Returns the number of bytes written.
+  uint32_t writeSackBlocks(uint8_t* buf) const;
+
+  // Mark the segments covered by the SACK blocks in |data| as received.
+  void applySackBlocks(const char* data, uint32_t len);
+
+  // During fast recovery, retransmit the first segment that hasn't been
+  // retransmitted yet, and that the peer reported missing.
+  // Returns false if there is no such segment.
+  bool retransmitNextHole(uint32_t now);
+
   // Resize the send buffer with |new_size| in bytes.
   void resizeSendBuffer(uint32_t new_size);
 
@@ -217,6 +240,9 @@ class RTC_EXPORT PseudoTcp {
   uint32_t m_sbuf_len, m_snd_nxt, m_snd_wnd, m_lastsend, m_snd_una;
   uint8_t m_swnd_scale;  // Window scale factor.
   rtc::FifoBuffer m_sbuf;
+  // Packet being written onto the network, kept to avoid an allocation per
+  // packet.
+  rtc::Buffer m_packet_buf;
 
   // Maximum segment size, estimated protocol level, largest segment sent
   uint32_t m_mss, m_msslevel, m_largest, m_mtu_advise;
@@ -235,6 +261,13 @@ class RTC_EXPORT PseudoTcp {
   uint32_t m_recover;
   uint32_t m_t_ack;
 
+  // Selective acknowledgments (RFC 2018). |m_sack_high| is the end of the
+  // highest block reported by the peer, and holes below |m_sack_rexmit_nxt|
+  // have already been retransmitted in the current recovery.
+  bool m_sack_enabled;
+  uint32_t m_sack_high;
+  uint32_t m_sack_rexmit_nxt;
+
   // Configuration options
   bool m_use_nagling;
   uint32_t m_ack_delay;
@@ -242,6 +275,10 @@ class RTC_EXPORT PseudoTcp {
   // This is used by unit tests to test backward compatibility of
   // PseudoTcp implementations that don't support window scaling.
   bool m_support_wnd_scale;
+
+  // This is used by unit tests to test backward compatibility of
+  // PseudoTcp implementations that don't support selective acknowledgments.
+  bool m_support_sack;
 };
 
 }  // namespace cricket
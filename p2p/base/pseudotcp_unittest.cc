@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
 #include <string.h>
 #include <algorithm>
 #include <cstddef>
@@ -40,6 +41,10 @@ class PseudoTcpForTest : public cricket::PseudoTcp {
   bool isReceiveBufferFull() const { return PseudoTcp::isReceiveBufferFull(); }
 
   void disableWindowScale() { PseudoTcp::disableWindowScale(); }
+
+  void disableSack() { PseudoTcp::disableSack(); }
+
+  bool isSackEnabled() const { return PseudoTcp::isSackEnabled(); }
 };
 
 class PseudoTcpTestBase : public testing::Test,
@@ -100,6 +105,8 @@ class PseudoTcpTestBase : public testing::Test,
   }
   void DisableRemoteWindowScale() { remote_.disableWindowScale(); }
   void DisableLocalWindowScale() { local_.disableWindowScale(); }
+  void DisableRemoteSack() { remote_.disableSack(); }
+  void DisableLocalSack() { local_.disableSack(); }
 
  protected:
   int Connect() {
@@ -233,7 +240,8 @@ class PseudoTcpTestBase : public testing::Test,
 
 class PseudoTcpTest : public PseudoTcpTestBase {
  public:
-  void TestTransfer(int size) {
+  // Returns the duration of the transfer in milliseconds.
+  int32_t TestTransfer(int size) {
     uint32_t start;
     int32_t elapsed;
     size_t received;
@@ -264,6 +272,7 @@ class PseudoTcpTest : public PseudoTcpTestBase {
               memcmp(send_stream_.GetBuffer(), recv_stream_.GetBuffer(), size));
     RTC_LOG(LS_INFO) << "Transferred " << received << " bytes in " << elapsed
                      << " ms (" << size * 8 / elapsed << " Kbps)";
+    return elapsed;
   }
 
  private:
@@ -868,6 +877,83 @@ TEST_F(PseudoTcpTestReceiveWindow, TestSetReceiveWindowSize) {
   EXPECT_EQ(100000u, EstimateReceiveWindowSize());
 }
 
+// Test that selective acknowledgments are negotiated when both sides support
+// them, and that data survives loss while they are in use.
+TEST_F(PseudoTcpTest, TestSendWithLossAndSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(10);
+  TestTransfer(100000);
+  EXPECT_TRUE(local_.isSackEnabled());
+  EXPECT_TRUE(remote_.isSackEnabled());
+}
+
+// Test sending data with loss to a receiver that doesn't support SACK.
+TEST_F(PseudoTcpTest, TestSendWithLossRemoteNoSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  DisableRemoteSack();
+  TestTransfer(100000);
+  EXPECT_FALSE(local_.isSackEnabled());
+  EXPECT_FALSE(remote_.isSackEnabled());
+}
+
+// Test sending data with loss from a sender that doesn't support SACK.
+TEST_F(PseudoTcpTest, TestSendWithLossLocalNoSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  DisableLocalSack();
+  TestTransfer(100000);
+  EXPECT_FALSE(local_.isSackEnabled());
+  EXPECT_FALSE(remote_.isSackEnabled());
+}
+
+// Network conditions for the transfer benchmark.
+struct TransferProfile {
+  int delay;
+  int loss;
+  bool sack;
+};
+
+class PseudoTcpBenchmark : public PseudoTcpTest,
+                           public testing::WithParamInterface<TransferProfile> {
+};
+
+// Measures the throughput of a transfer with a large window, with and without
+// SACK. Run with --gtest_also_run_disabled_tests.
+TEST_P(PseudoTcpBenchmark, DISABLED_Transfer) {
+  const TransferProfile& profile = GetParam();
+  const int kSize = 300000;
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(profile.delay);
+  SetLoss(profile.loss);
+  SetOptSndBuf(1024 * 1024);
+  SetLocalOptRcvBuf(1024 * 1024);
+  SetRemoteOptRcvBuf(1024 * 1024);
+  if (!profile.sack) {
+    DisableLocalSack();
+    DisableRemoteSack();
+  }
+  int32_t elapsed = TestTransfer(kSize);
+  printf("delay %d ms, loss %d%%, sack %d: %d Kbps\n", profile.delay,
+         profile.loss, profile.sack, kSize * 8 / std::max(elapsed, 1));
+}
+
+INSTANTIATE_TEST_CASE_P(PseudoTcpBenchmarks,
+                        PseudoTcpBenchmark,
+                        testing::Values(TransferProfile{0, 0, true},
+                                        TransferProfile{50, 0, true},
+                                        TransferProfile{50, 1, false},
+                                        TransferProfile{50, 1, true},
+                                        TransferProfile{50, 5, false},
+                                        TransferProfile{50, 5, true},
+                                        TransferProfile{100, 2, false},
+                                        TransferProfile{100, 2, true}));
+
 /* Test sending data with mismatched MTUs. We should detect this and reduce
 // our packet size accordingly.
 // TODO(?): This doesn't actually work right now. The current code
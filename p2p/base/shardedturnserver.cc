@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/shardedturnserver.h"
+
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/basicpacketsocketfactory.h"
+#include "rtc_base/asyncsocket.h"
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/socketserver.h"
+
+namespace cricket {
+
+namespace {
+
+const int kListenBacklog = 5;
+
+}  // namespace
+
+ShardedTurnServer::ShardedTurnServer(size_t num_shards)
+    : num_shards_(num_shards) {
+  RTC_DCHECK_GT(num_shards, 0);
+}
+
+ShardedTurnServer::~ShardedTurnServer() {
+  Stop();
+}
+
+bool ShardedTurnServer::Start(const rtc::SocketAddress& internal_address,
+                              ProtocolType proto,
+                              const rtc::IPAddress& external_ip,
+                              const ConfigureCallback& configure) {
+  RTC_DCHECK(shards_.empty());
+  RTC_DCHECK(proto == PROTO_UDP || proto == PROTO_TCP);
+  internal_address_ = internal_address;
+  shards_.resize(num_shards_);
+  for (size_t i = 0; i < num_shards_; ++i) {
+    Shard* shard = &shards_[i];
+    shard->thread = rtc::Thread::CreateWithSocketServer();
+    shard->thread->SetName("TurnShard" + std::to_string(i), nullptr);
+    shard->thread->Start();
+    const bool started = shard->thread->Invoke<bool>(RTC_FROM_HERE, [&] {
+      return StartShard(shard, i, proto, external_ip, configure);
+    });
+    if (!started) {
+      Stop();
+      return false;
+    }
+  }
+  return true;
+}
+
+void ShardedTurnServer::Stop() {
+  for (Shard& shard : shards_) {
+    if (!shard.thread)
+      continue;
+    shard.thread->Invoke<void>(RTC_FROM_HERE, [&] { shard.server.reset(); });
+    shard.thread->Stop();
+  }
+  shards_.clear();
+}
+
+rtc::Thread* ShardedTurnServer::shard_thread(size_t shard) {
+  return shard < shards_.size() ? shards_[shard].thread.get() : nullptr;
+}
+
+size_t ShardedTurnServer::NumAllocations(size_t shard) {
+  RTC_DCHECK_LT(shard, shards_.size());
+  Shard* s = &shards_[shard];
+  return s->thread->Invoke<size_t>(
+      RTC_FROM_HERE, [s] { return s->server->allocations().size(); });
+}
+
+bool ShardedTurnServer::StartShard(Shard* shard,
+                                   size_t index,
+                                   ProtocolType proto,
+                                   const rtc::IPAddress& external_ip,
+                                   const ConfigureCallback& configure) {
+  RTC_DCHECK(shard->thread->IsCurrent());
+  shard->server = absl::make_unique<TurnServer>(shard->thread.get());
+  if (configure)
+    configure(index, shard->server.get());
+
+  rtc::AsyncSocket* socket =
+      shard->thread->socketserver()->CreateAsyncSocket(
+          internal_address_.family(),
+          proto == PROTO_UDP ? SOCK_DGRAM : SOCK_STREAM);
+  if (!socket)
+    return false;
+  if (num_shards_ > 1 && socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1)) {
+    RTC_LOG(LS_ERROR) << "Failed to enable SO_REUSEPORT for TURN shard "
+                      << index;
+    delete socket;
+    return false;
+  }
+  if (socket->Bind(internal_address_) ||
+      (proto == PROTO_TCP && socket->Listen(kListenBacklog))) {
+    RTC_LOG(LS_ERROR) << "Failed to listen at "
+                      << internal_address_.ToString() << " for TURN shard "
+                      << index << ", error=" << socket->GetError();
+    delete socket;
+    return false;
+  }
+  // Later shards bind the port picked for the first one.
+  internal_address_ = socket->GetLocalAddress();
+
+  if (proto == PROTO_UDP) {
+    shard->server->AddInternalSocket(new rtc::AsyncUDPSocket(socket),
+                                     PROTO_UDP);
+  } else {
+    shard->server->AddInternalServerSocket(socket, PROTO_TCP);
+  }
+  shard->server->SetExternalSocketFactory(
+      new rtc::BasicPacketSocketFactory(shard->thread.get()),
+      rtc::SocketAddress(external_ip, 0));
+  return true;
+}
+
+}  // namespace cricket
@@ -0,0 +1,91 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHARDEDTURNSERVER_H_
+#define P2P_BASE_SHARDEDTURNSERVER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "p2p/base/portinterface.h"
+#include "p2p/base/turnserver.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/ipaddress.h"
+#include "rtc_base/socketaddress.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+
+// Runs several TurnServer instances, each on its own thread, so that relaying
+// can use more than one core. All the shards listen on the same internal
+// address with SO_REUSEPORT, and the kernel spreads the clients over them by
+// hashing the source and destination addresses. All packets of a client thus
+// reach the same shard, which owns that client's allocation, and the shards do
+// not share any state.
+//
+// SO_REUSEPORT is only supported on POSIX platforms; Start() fails where it is
+// not available, unless a single shard is used.
+class ShardedTurnServer {
+ public:
+  // Configures the TurnServer of a shard, e.g. its realm, software and auth
+  // hook. Called on the thread of the shard before it starts listening. Hooks
+  // that are shared by several shards must be thread safe.
+  typedef std::function<void(size_t shard, TurnServer* server)>
+      ConfigureCallback;
+
+  explicit ShardedTurnServer(size_t num_shards);
+  ~ShardedTurnServer();
+
+  // Starts the shards. They listen on |internal_address| with |proto|, which
+  // must be PROTO_UDP or PROTO_TCP, and create relayed addresses on
+  // |external_ip|. If the port of |internal_address| is 0, the shards share
+  // the port picked for the first one. Returns false, with all shards
+  // stopped, if one of them fails to bind its socket.
+  bool Start(const rtc::SocketAddress& internal_address,
+             ProtocolType proto,
+             const rtc::IPAddress& external_ip,
+             const ConfigureCallback& configure);
+  // Destroys the servers on their threads and stops the threads.
+  void Stop();
+
+  size_t num_shards() const { return num_shards_; }
+  // The address the shards listen on, valid after a successful Start().
+  const rtc::SocketAddress& internal_address() const {
+    return internal_address_;
+  }
+  // Returns the thread of |shard|, or null if the shards are not running.
+  rtc::Thread* shard_thread(size_t shard);
+  // Returns the number of allocations of |shard|. Blocks on its thread.
+  size_t NumAllocations(size_t shard);
+
+ private:
+  struct Shard {
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<TurnServer> server;
+  };
+
+  // Runs on the thread of |shard|. Creates its server and listening socket.
+  bool StartShard(Shard* shard,
+                  size_t index,
+                  ProtocolType proto,
+                  const rtc::IPAddress& external_ip,
+                  const ConfigureCallback& configure);
+
+  const size_t num_shards_;
+  rtc::SocketAddress internal_address_;
+  std::vector<Shard> shards_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ShardedTurnServer);
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_SHARDEDTURNSERVER_H_
@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/shardedturnserver.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/physicalsocketserver.h"
+#include "rtc_base/testclient.h"
+#include "test/gtest.h"
+
+namespace cricket {
+
+namespace {
+
+const rtc::SocketAddress kLoopbackAddress("127.0.0.1", 0);
+
+// Counts the STUN messages received by one shard. Runs on the shard thread.
+class CountingObserver : public StunMessageObserver {
+ public:
+  explicit CountingObserver(int* count) : count_(count) {}
+  void ReceivedMessage(const TurnMessage* msg) override { ++*count_; }
+  void ReceivedChannelData(const char* data, size_t size) override {}
+
+ private:
+  int* const count_;
+};
+
+}  // namespace
+
+class ShardedTurnServerTest : public testing::Test {
+ public:
+  ShardedTurnServerTest() : thread_(&ss_) {}
+
+  // Sends a binding request from a new client and checks that the response
+  // reflects the address of the client.
+  void ExpectBindingResponse(const rtc::SocketAddress& server_address) {
+    rtc::TestClient client(absl::WrapUnique(
+        rtc::AsyncUDPSocket::Create(&ss_, kLoopbackAddress)));
+    StunMessage request;
+    request.SetType(STUN_BINDING_REQUEST);
+    request.SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    client.SendTo(buf.Data(), buf.Length(), server_address);
+
+    std::unique_ptr<rtc::TestClient::Packet> packet =
+        client.NextPacket(rtc::TestClient::kTimeoutMs);
+    ASSERT_TRUE(packet);
+    StunMessage response;
+    rtc::ByteBufferReader reader(packet->buf, packet->size);
+    ASSERT_TRUE(response.Read(&reader));
+    EXPECT_EQ(STUN_BINDING_RESPONSE, response.type());
+    EXPECT_EQ(request.transaction_id(), response.transaction_id());
+    const StunAddressAttribute* mapped_address =
+        response.GetAddress(STUN_ATTR_XOR_MAPPED_ADDRESS);
+    ASSERT_TRUE(mapped_address);
+    EXPECT_EQ(client.address(), mapped_address->GetAddress());
+  }
+
+ protected:
+  rtc::PhysicalSocketServer ss_;
+  rtc::AutoSocketServerThread thread_;
+};
+
+TEST_F(ShardedTurnServerTest, SingleShardAnswersBindingRequests) {
+  ShardedTurnServer server(1);
+  ASSERT_TRUE(server.Start(kLoopbackAddress, PROTO_UDP,
+                           kLoopbackAddress.ipaddr(), nullptr));
+  EXPECT_NE(0, server.internal_address().port());
+  ExpectBindingResponse(server.internal_address());
+  EXPECT_EQ(0u, server.NumAllocations(0));
+  server.Stop();
+  EXPECT_EQ(nullptr, server.shard_thread(0));
+}
+
+#if defined(WEBRTC_LINUX)
+// Relies on SO_REUSEPORT spreading the clients over the shards.
+TEST_F(ShardedTurnServerTest, ShardsShareThePortAndSplitTheClients) {
+  constexpr size_t kNumShards = 2;
+  constexpr int kNumClients = 32;
+  std::vector<int> messages_per_shard(kNumShards, 0);
+  ShardedTurnServer server(kNumShards);
+  ASSERT_TRUE(server.Start(
+      kLoopbackAddress, PROTO_UDP, kLoopbackAddress.ipaddr(),
+      [&messages_per_shard](size_t shard, TurnServer* turn_server) {
+        turn_server->set_software("shard");
+        turn_server->SetStunMessageObserver(
+            absl::make_unique<CountingObserver>(&messages_per_shard[shard]));
+      }));
+  EXPECT_EQ(kNumShards, server.num_shards());
+
+  for (int i = 0; i < kNumClients; ++i) {
+    ExpectBindingResponse(server.internal_address());
+  }
+
+  int total_messages = 0;
+  for (size_t shard = 0; shard < kNumShards; ++shard) {
+    // The counters are only touched on the shard threads.
+    const int messages = server.shard_thread(shard)->Invoke<int>(
+        RTC_FROM_HERE, [&] { return messages_per_shard[shard]; });
+    EXPECT_GT(messages, 0) << "shard " << shard;
+    total_messages += messages;
+  }
+  EXPECT_EQ(kNumClients, total_messages);
+}
+#endif  // defined(WEBRTC_LINUX)
+
+}  // namespace cricket
@@ -60,7 +60,6 @@ const char STUN_ERROR_REASON_SERVER_ERROR[] = "Server Error";
 
 const char TURN_MAGIC_COOKIE_VALUE[] = {'\x72', '\xC6', '\x4B', '\xC6'};
 const char EMPTY_TRANSACTION_ID[] = "0000000000000000";
-const uint32_t STUN_FINGERPRINT_XOR_VALUE = 0x5354554E;
 
 // StunMessage
 
@@ -224,33 +223,11 @@ bool StunMessage::ValidateMessageIntegrity(const char* data,
     return false;
   }
 
-  // Getting length of the message to calculate Message Integrity.
-  size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
-  if (size > mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize) {
-    // Stun message has other attributes after message integrity.
-    // Adjust the length parameter in stun message to calculate HMAC.
-    size_t extra_offset =
-        size - (mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize);
-    size_t new_adjusted_len = size - extra_offset - kStunHeaderSize;
-
-    // Writing new length of the STUN message @ Message Length in temp buffer.
-    //      0                   1                   2                   3
-    //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    //     |0 0|     STUN Message Type     |         Message Length        |
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
-  }
-
   char hmac[kStunMessageIntegritySize];
-  size_t ret =
-      rtc::ComputeHmac(rtc::DIGEST_SHA_1, password.c_str(), password.size(),
-                       temp_data.get(), mi_pos, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac))
+  if (!ComputeStunMessageIntegrity(data, current_pos, password.c_str(),
+                                   password.size(), hmac)) {
     return false;
+  }
 
   // Comparing the calculated HMAC with the one present in the message.
   return memcmp(data + current_pos + kStunAttributeHeaderSize, hmac,
@@ -277,10 +254,8 @@ bool StunMessage::AddMessageIntegrity(const char* key, size_t keylen) {
   int msg_len_for_hmac = static_cast<int>(
       buf.Length() - kStunAttributeHeaderSize - msg_integrity_attr->length());
   char hmac[kStunMessageIntegritySize];
-  size_t ret = rtc::ComputeHmac(rtc::DIGEST_SHA_1, key, keylen, buf.Data(),
-                                msg_len_for_hmac, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
+  if (!ComputeStunMessageIntegrity(buf.Data(), msg_len_for_hmac, key, keylen,
+                                   hmac)) {
     RTC_LOG(LS_ERROR) << "HMAC computation failed. Message-Integrity "
                          "has dummy value.";
     return false;
@@ -1027,6 +1002,34 @@ bool ComputeStunCredentialHash(const std::string& username,
   return true;
 }
 
+bool ComputeStunMessageIntegrity(const char* data,
+                                 size_t mi_pos,
+                                 const char* key,
+                                 size_t key_len,
+                                 char* hmac) {
+  RTC_DCHECK_GE(mi_pos, kStunHeaderSize);
+  // Hash a copy of the header, with the message length written to end right
+  // after the MESSAGE-INTEGRITY attribute, followed by the attributes
+  // before it.
+  //      0                   1                   2                   3
+  //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  //     |0 0|     STUN Message Type     |         Message Length        |
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  char header[kStunHeaderSize];
+  memcpy(header, data, kStunHeaderSize);
+  rtc::SetBE16(header + 2,
+               static_cast<uint16_t>(mi_pos - kStunHeaderSize +
+                                     kStunAttributeHeaderSize +
+                                     kStunMessageIntegritySize));
+  const void* inputs[] = {header, data + kStunHeaderSize};
+  const size_t input_lengths[] = {kStunHeaderSize, mi_pos - kStunHeaderSize};
+  size_t ret = rtc::ComputeHmacSha1(key, key_len, inputs, input_lengths, 2,
+                                    hmac, kStunMessageIntegritySize);
+  RTC_DCHECK_EQ(ret, kStunMessageIntegritySize);
+  return ret == kStunMessageIntegritySize;
+}
+
 std::unique_ptr<StunAttribute> CopyStunAttribute(
     const StunAttribute& attribute,
     rtc::ByteBufferWriter* tmp_buffer_ptr) {
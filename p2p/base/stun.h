@@ -119,6 +119,9 @@ const size_t kStunLegacyTransactionIdLength = 16;
 // STUN Message Integrity HMAC length.
 const size_t kStunMessageIntegritySize = 20;
 
+// The value XORed with the CRC-32 of a message to form its FINGERPRINT.
+const uint32_t STUN_FINGERPRINT_XOR_VALUE = 0x5354554E;
+
 class StunAddressAttribute;
 class StunAttribute;
 class StunByteStringAttribute;
@@ -492,6 +495,18 @@ bool ComputeStunCredentialHash(const std::string& username,
                                const std::string& password,
                                std::string* hash);
 
+// Computes the MESSAGE-INTEGRITY value, as specified in RFC 5389 section
+// 15.4, of the STUN message in |data| whose MESSAGE-INTEGRITY attribute
+// starts at offset |mi_pos|. The HMAC covers the message up to that attribute,
+// with the length in the header adjusted to end right after it, and is
+// computed without copying the message. Writes kStunMessageIntegritySize
+// bytes to |hmac|.
+bool ComputeStunMessageIntegrity(const char* data,
+                                 size_t mi_pos,
+                                 const char* key,
+                                 size_t key_len,
+                                 char* hmac);
+
 // Make a copy af |attribute| and return a new StunAttribute.
 //   This is useful if you don't care about what kind of attribute you
 //   are handling.
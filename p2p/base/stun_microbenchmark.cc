@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/bytebuffer.h"
+#include "test/gtest.h"
+#include "test/testsupport/microbenchmark.h"
+
+namespace cricket {
+
+namespace {
+
+constexpr char kTransactionId[] = "0123456789ab";
+constexpr char kUsername[] = "remoteufrag:localufrag";
+constexpr char kPassword[] = "abcdefghijklmnopqrstuv";
+
+// Builds a binding request like the ones sent for ICE connectivity checks.
+std::unique_ptr<StunMessage> CreateBindingRequest() {
+  auto message = absl::make_unique<StunMessage>();
+  message->SetType(STUN_BINDING_REQUEST);
+  message->SetTransactionID(kTransactionId);
+  auto username = StunAttribute::CreateByteString(STUN_ATTR_USERNAME);
+  username->CopyBytes(kUsername);
+  message->AddAttribute(std::move(username));
+  auto priority = StunAttribute::CreateUInt32(STUN_ATTR_PRIORITY);
+  priority->SetValue(0x6e7f1eff);
+  message->AddAttribute(std::move(priority));
+  message->AddMessageIntegrity(kPassword);
+  message->AddFingerprint();
+  return message;
+}
+
+}  // namespace
+
+TEST(StunMicrobenchmark, WriteBindingRequest) {
+  std::unique_ptr<StunMessage> message = CreateBindingRequest();
+  webrtc::test::RunMicrobenchmark("StunMessage_Write", [&] {
+    rtc::ByteBufferWriter buffer;
+    message->Write(&buffer);
+    webrtc::test::DoNotOptimizeAway(buffer.Data());
+  });
+}
+
+TEST(StunMicrobenchmark, ReadBindingRequest) {
+  rtc::ByteBufferWriter written;
+  ASSERT_TRUE(CreateBindingRequest()->Write(&written));
+
+  bool read_all = true;
+  webrtc::test::RunMicrobenchmark("StunMessage_Read", [&] {
+    rtc::ByteBufferReader buffer(written.Data(), written.Length());
+    StunMessage message;
+    read_all &= message.Read(&buffer);
+  });
+  EXPECT_TRUE(read_all);
+  EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+      written.Data(), written.Length(), kPassword));
+}
+
+}  // namespace cricket
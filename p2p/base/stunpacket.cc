@@ -0,0 +1,274 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/stunpacket.h"
+
+#include <string.h>
+
+#include "rtc_base/byteorder.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/crc32.h"
+
+namespace cricket {
+
+namespace {
+
+const size_t kStunXorAddressHeaderSize = 4;
+const size_t kStunFingerprintAttrSize = kStunAttributeHeaderSize + 4;
+
+size_t PaddedLength(size_t length) {
+  return (length + 3) & ~static_cast<size_t>(3);
+}
+
+// Writes the mask that XOR-MAPPED-ADDRESS and friends apply to the address:
+// the magic cookie followed by the transaction ID, in network byte order.
+void GetXorMask(const char* transaction_id, uint8_t mask[16]) {
+  rtc::SetBE32(mask, kStunMagicCookie);
+  memcpy(mask + kStunMagicCookieLength, transaction_id,
+         kStunTransactionIdLength);
+}
+
+}  // namespace
+
+StunPacketWriter::StunPacketWriter(char* buffer,
+                                   size_t capacity,
+                                   int type,
+                                   const char* transaction_id)
+    : buffer_(buffer), capacity_(capacity), size_(kStunHeaderSize) {
+  RTC_DCHECK_GE(capacity, kStunHeaderSize);
+  rtc::SetBE16(buffer_, static_cast<uint16_t>(type));
+  rtc::SetBE16(buffer_ + 2, 0);
+  rtc::SetBE32(buffer_ + 4, kStunMagicCookie);
+  memcpy(buffer_ + kStunTransactionIdOffset, transaction_id,
+         kStunTransactionIdLength);
+}
+
+char* StunPacketWriter::AppendAttribute(int type, size_t length) {
+  size_t padded_length = PaddedLength(length);
+  if (length > 0xFFFF ||
+      capacity_ - size_ < kStunAttributeHeaderSize + padded_length) {
+    return nullptr;
+  }
+  char* attr = buffer_ + size_;
+  rtc::SetBE16(attr, static_cast<uint16_t>(type));
+  rtc::SetBE16(attr + 2, static_cast<uint16_t>(length));
+  char* value = attr + kStunAttributeHeaderSize;
+  memset(value + length, 0, padded_length - length);
+  size_ += kStunAttributeHeaderSize + padded_length;
+  rtc::SetBE16(buffer_ + 2, static_cast<uint16_t>(size_ - kStunHeaderSize));
+  return value;
+}
+
+bool StunPacketWriter::AddUInt32(int type, uint32_t value) {
+  char* data = AppendAttribute(type, sizeof(value));
+  if (!data)
+    return false;
+  rtc::SetBE32(data, value);
+  return true;
+}
+
+bool StunPacketWriter::AddUInt64(int type, uint64_t value) {
+  char* data = AppendAttribute(type, sizeof(value));
+  if (!data)
+    return false;
+  rtc::SetBE64(data, value);
+  return true;
+}
+
+bool StunPacketWriter::AddBytes(int type, const void* bytes, size_t length) {
+  char* data = AppendAttribute(type, length);
+  if (!data)
+    return false;
+  if (length > 0)
+    memcpy(data, bytes, length);
+  return true;
+}
+
+bool StunPacketWriter::AddXorAddress(int type,
+                                     const rtc::SocketAddress& address) {
+  uint8_t family;
+  uint8_t ip[16];
+  size_t ip_size;
+  const rtc::IPAddress& ipaddr = address.ipaddr();
+  if (ipaddr.family() == AF_INET) {
+    in_addr v4addr = ipaddr.ipv4_address();
+    family = STUN_ADDRESS_IPV4;
+    ip_size = sizeof(v4addr);
+    memcpy(ip, &v4addr, ip_size);
+  } else if (ipaddr.family() == AF_INET6) {
+    in6_addr v6addr = ipaddr.ipv6_address();
+    family = STUN_ADDRESS_IPV6;
+    ip_size = sizeof(v6addr);
+    memcpy(ip, &v6addr, ip_size);
+  } else {
+    return false;
+  }
+  char* data = AppendAttribute(type, kStunXorAddressHeaderSize + ip_size);
+  if (!data)
+    return false;
+  uint8_t mask[16];
+  GetXorMask(buffer_ + kStunTransactionIdOffset, mask);
+  data[0] = 0;
+  data[1] = family;
+  rtc::SetBE16(data + 2, address.port() ^ (kStunMagicCookie >> 16));
+  for (size_t i = 0; i < ip_size; ++i) {
+    data[kStunXorAddressHeaderSize + i] = ip[i] ^ mask[i];
+  }
+  return true;
+}
+
+bool StunPacketWriter::AddMessageIntegrity(const char* key, size_t key_len) {
+  size_t mi_pos = size_;
+  char* data = AppendAttribute(STUN_ATTR_MESSAGE_INTEGRITY,
+                               kStunMessageIntegritySize);
+  if (!data)
+    return false;
+  // The header length already ends right after MESSAGE-INTEGRITY.
+  if (!ComputeStunMessageIntegrity(buffer_, mi_pos, key, key_len, data)) {
+    size_ = mi_pos;
+    rtc::SetBE16(buffer_ + 2, static_cast<uint16_t>(size_ - kStunHeaderSize));
+    return false;
+  }
+  return true;
+}
+
+bool StunPacketWriter::AddFingerprint() {
+  char* data = AppendAttribute(STUN_ATTR_FINGERPRINT, 4);
+  if (!data)
+    return false;
+  uint32_t crc = rtc::ComputeCrc32(buffer_, size_ - kStunFingerprintAttrSize);
+  rtc::SetBE32(data, crc ^ STUN_FINGERPRINT_XOR_VALUE);
+  return true;
+}
+
+StunPacketReader::StunPacketReader() : data_(nullptr), size_(0) {}
+
+bool StunPacketReader::Parse(const char* data, size_t size) {
+  data_ = nullptr;
+  size_ = 0;
+  if (size < kStunHeaderSize || size % 4 != 0 ||
+      rtc::GetBE16(data) & 0xC000 ||
+      rtc::GetBE16(data + 2) != size - kStunHeaderSize ||
+      rtc::GetBE32(data + 4) != kStunMagicCookie) {
+    return false;
+  }
+  size_t pos = kStunHeaderSize;
+  while (pos < size) {
+    if (size - pos < kStunAttributeHeaderSize)
+      return false;
+    size_t length = PaddedLength(rtc::GetBE16(data + pos + 2));
+    if (size - pos - kStunAttributeHeaderSize < length)
+      return false;
+    pos += kStunAttributeHeaderSize + length;
+  }
+  data_ = data;
+  size_ = size;
+  return true;
+}
+
+int StunPacketReader::type() const {
+  RTC_DCHECK(data_);
+  return rtc::GetBE16(data_);
+}
+
+const char* StunPacketReader::FindAttribute(int type, size_t* length) const {
+  RTC_DCHECK(data_);
+  size_t pos = kStunHeaderSize;
+  while (pos < size_) {
+    size_t attr_length = rtc::GetBE16(data_ + pos + 2);
+    if (rtc::GetBE16(data_ + pos) == type) {
+      *length = attr_length;
+      return data_ + pos + kStunAttributeHeaderSize;
+    }
+    pos += kStunAttributeHeaderSize + PaddedLength(attr_length);
+  }
+  return nullptr;
+}
+
+bool StunPacketReader::HasAttribute(int type) const {
+  size_t length;
+  return FindAttribute(type, &length) != nullptr;
+}
+
+bool StunPacketReader::GetBytes(int type,
+                                const char** bytes,
+                                size_t* length) const {
+  *bytes = FindAttribute(type, length);
+  return *bytes != nullptr;
+}
+
+bool StunPacketReader::GetUInt32(int type, uint32_t* value) const {
+  size_t length;
+  const char* data = FindAttribute(type, &length);
+  if (!data || length != sizeof(*value))
+    return false;
+  *value = rtc::GetBE32(data);
+  return true;
+}
+
+bool StunPacketReader::GetUInt64(int type, uint64_t* value) const {
+  size_t length;
+  const char* data = FindAttribute(type, &length);
+  if (!data || length != sizeof(*value))
+    return false;
+  *value = rtc::GetBE64(data);
+  return true;
+}
+
+bool StunPacketReader::GetXorAddress(int type,
+                                     rtc::SocketAddress* address) const {
+  size_t length;
+  const char* data = FindAttribute(type, &length);
+  if (!data || length < kStunXorAddressHeaderSize)
+    return false;
+  uint8_t family = data[1];
+  size_t ip_size = length - kStunXorAddressHeaderSize;
+  if (!(family == STUN_ADDRESS_IPV4 && ip_size == sizeof(in_addr)) &&
+      !(family == STUN_ADDRESS_IPV6 && ip_size == sizeof(in6_addr))) {
+    return false;
+  }
+  uint8_t mask[16];
+  GetXorMask(transaction_id(), mask);
+  uint8_t ip[16];
+  for (size_t i = 0; i < ip_size; ++i) {
+    ip[i] = data[kStunXorAddressHeaderSize + i] ^ mask[i];
+  }
+  uint16_t port = rtc::GetBE16(data + 2) ^ (kStunMagicCookie >> 16);
+  if (family == STUN_ADDRESS_IPV4) {
+    in_addr v4addr;
+    memcpy(&v4addr, ip, sizeof(v4addr));
+    *address = rtc::SocketAddress(rtc::IPAddress(v4addr), port);
+  } else {
+    in6_addr v6addr;
+    memcpy(&v6addr, ip, sizeof(v6addr));
+    *address = rtc::SocketAddress(rtc::IPAddress(v6addr), port);
+  }
+  return true;
+}
+
+bool StunPacketReader::ValidateMessageIntegrity(const char* key,
+                                                size_t key_len) const {
+  size_t length;
+  const char* value = FindAttribute(STUN_ATTR_MESSAGE_INTEGRITY, &length);
+  if (!value || length != kStunMessageIntegritySize)
+    return false;
+  size_t mi_pos = value - kStunAttributeHeaderSize - data_;
+  char hmac[kStunMessageIntegritySize];
+  if (!ComputeStunMessageIntegrity(data_, mi_pos, key, key_len, hmac))
+    return false;
+  return memcmp(value, hmac, sizeof(hmac)) == 0;
+}
+
+bool StunPacketReader::ValidateFingerprint() const {
+  RTC_DCHECK(data_);
+  return StunMessage::ValidateFingerprint(data_, size_);
+}
+
+}  // namespace cricket
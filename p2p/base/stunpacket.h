@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_STUNPACKET_H_
+#define P2P_BASE_STUNPACKET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "p2p/base/stun.h"
+#include "rtc_base/socketaddress.h"
+
+namespace cricket {
+
+// StunPacketWriter and StunPacketReader encode and decode RFC 5389 messages
+// directly in a caller-provided buffer, without the attribute objects and
+// heap allocations of StunMessage. They are meant for the Binding Requests
+// and Binding Success Responses of ICE connectivity checks, which a server
+// with many connections sends and receives at a high rate. StunMessage
+// remains the general-purpose representation, e.g. for legacy messages.
+
+// Appends attributes to a STUN message in |buffer|. MESSAGE-INTEGRITY and
+// FINGERPRINT are computed over the buffer in place, so they must be added
+// last, in that order. An Add method returns false, and leaves the message
+// unchanged, if the attribute does not fit in the buffer.
+class StunPacketWriter {
+ public:
+  // Starts a message of |type| with the |kStunTransactionIdLength| bytes at
+  // |transaction_id|. |capacity| must be at least kStunHeaderSize.
+  StunPacketWriter(char* buffer,
+                   size_t capacity,
+                   int type,
+                   const char* transaction_id);
+
+  bool AddUInt32(int type, uint32_t value);
+  bool AddUInt64(int type, uint64_t value);
+  bool AddBytes(int type, const void* bytes, size_t length);
+  // Adds an attribute without a value, e.g. USE-CANDIDATE.
+  bool AddFlag(int type) { return AddBytes(type, nullptr, 0); }
+  bool AddXorAddress(int type, const rtc::SocketAddress& address);
+  bool AddMessageIntegrity(const char* key, size_t key_len);
+  bool AddFingerprint();
+
+  const char* data() const { return buffer_; }
+  size_t size() const { return size_; }
+
+ private:
+  // Appends the header of an attribute with |length| bytes of value, and
+  // zeroes its padding. Returns the position of the value, or null if the
+  // attribute does not fit.
+  char* AppendAttribute(int type, size_t length);
+
+  char* const buffer_;
+  const size_t capacity_;
+  size_t size_;
+};
+
+// Finds the attributes of a STUN message in place. The message data must
+// outlive the reader. Attribute lookups scan the message, which is cheap for
+// the handful of attributes of a connectivity check.
+class StunPacketReader {
+ public:
+  StunPacketReader();
+
+  // Returns true if |data| is a STUN message with the RFC 5389 magic cookie,
+  // a length that matches |size|, and attributes that fit in the message.
+  bool Parse(const char* data, size_t size);
+
+  int type() const;
+  // Returns the |kStunTransactionIdLength| bytes of the transaction ID.
+  const char* transaction_id() const {
+    return data_ + kStunTransactionIdOffset;
+  }
+
+  bool HasAttribute(int type) const;
+  // Sets |bytes| to the value of the first attribute of |type| and |length|
+  // to its unpadded length.
+  bool GetBytes(int type, const char** bytes, size_t* length) const;
+  bool GetUInt32(int type, uint32_t* value) const;
+  bool GetUInt64(int type, uint64_t* value) const;
+  bool GetXorAddress(int type, rtc::SocketAddress* address) const;
+
+  // Checks the MESSAGE-INTEGRITY attribute against |key| without copying
+  // the message.
+  bool ValidateMessageIntegrity(const char* key, size_t key_len) const;
+  bool ValidateFingerprint() const;
+
+ private:
+  const char* FindAttribute(int type, size_t* length) const;
+
+  const char* data_;
+  size_t size_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_STUNPACKET_H_
@@ -25,6 +25,7 @@
 #include "rtc_base/nethelpers.h"
 #include "rtc_base/socketaddress.h"
 #include "rtc_base/strings/string_builder.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace cricket {
 
@@ -48,6 +49,14 @@ inline bool IsTurnChannelData(uint16_t msg_type) {
   return ((msg_type & 0xC000) == 0x4000);  // MSB are 0b01
 }
 
+// Returns the send coalescing window of TCP and TLS sockets, e.g. 5 with
+// "WebRTC-TurnTcpSendCoalescing/5/", or 0 to send packets one by one.
+static int GetSendCoalescingWindowMsInFieldTrial() {
+  return static_cast<int>(::strtoul(
+      webrtc::field_trial::FindFullName("WebRTC-TurnTcpSendCoalescing").c_str(),
+      nullptr, 10));
+}
+
 static int GetRelayPreference(cricket::ProtocolType proto) {
   switch (proto) {
     case cricket::PROTO_TCP:
@@ -376,6 +385,8 @@ bool TurnPort::CreateTurnClientSocket() {
     tcp_options.tls_alpn_protocols = tls_alpn_protocols_;
     tcp_options.tls_elliptic_curves = tls_elliptic_curves_;
     tcp_options.tls_cert_verifier = tls_cert_verifier_;
+    tcp_options.send_coalescing_window_ms =
+        GetSendCoalescingWindowMsInFieldTrial();
     socket_ = socket_factory()->CreateClientTcpSocket(
         rtc::SocketAddress(Network()->GetBestIP(), 0), server_address_.address,
         proxy(), user_agent(), tcp_options);
@@ -19,6 +19,7 @@
 #include "p2p/base/stun.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/bytebuffer.h"
+#include "rtc_base/byteorder.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
@@ -530,9 +531,15 @@ void TurnServer::SendStun(TurnServerConnection* conn, StunMessage* msg) {
 
 void TurnServer::Send(TurnServerConnection* conn,
                       const rtc::ByteBufferWriter& buf) {
+  Send(conn, buf.Data(), buf.Length());
+}
+
+void TurnServer::Send(TurnServerConnection* conn,
+                      const char* data,
+                      size_t size) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   rtc::PacketOptions options;
-  conn->socket()->SendTo(buf.Data(), buf.Length(), conn->src(), options);
+  conn->socket()->SendTo(data, size, conn->src(), options);
 }
 
 void TurnServer::OnAllocationDestroyed(TurnServerAllocation* allocation) {
@@ -594,6 +601,13 @@ bool TurnServerConnection::operator<(const TurnServerConnection& c) const {
   return std::tie(src_, dst_, proto_) < std::tie(c.src_, c.dst_, c.proto_);
 }
 
+size_t TurnServerConnection::Hash() const {
+  size_t hash = src_.Hash();
+  hash = hash * 31 + dst_.Hash();
+  hash = hash * 31 + proto_;
+  return hash;
+}
+
 std::string TurnServerConnection::ToString() const {
   const char* const kProtos[] = {
       "unknown", "udp", "tcp", "ssltcp"
@@ -612,19 +626,19 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
       thread_(thread),
       conn_(conn),
       external_socket_(socket),
-      key_(key) {
+      key_(key),
+      relay_in_place_(
+          external_socket_->SetRecvHeadroom(TURN_CHANNEL_HEADER_SIZE)) {
   external_socket_->SignalReadPacket.connect(
       this, &TurnServerAllocation::OnExternalPacket);
 }
 
 TurnServerAllocation::~TurnServerAllocation() {
-  for (ChannelList::iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    delete *it;
+  for (Channel* channel : channels_) {
+    delete channel;
   }
-  for (PermissionList::iterator it = perms_.begin();
-       it != perms_.end(); ++it) {
-    delete *it;
+  for (const auto& perm : perms_) {
+    delete perm.second;
   }
   thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
   RTC_LOG(LS_INFO) << ToString() << ": Allocation destroyed";
@@ -807,7 +821,11 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
     channel1 = new Channel(thread_, channel_id, peer_attr->GetAddress());
     channel1->SignalDestroyed.connect(this,
         &TurnServerAllocation::OnChannelDestroyed);
-    channels_.push_back(channel1);
+    size_t index = channel_id - kMinChannelNumber;
+    if (index >= channels_.size())
+      channels_.resize(index + 1, nullptr);
+    channels_[index] = channel1;
+    channels_by_peer_[channel1->peer()] = channel1;
   } else {
     channel1->Refresh();
   }
@@ -848,7 +866,15 @@ void TurnServerAllocation::OnExternalPacket(
     const int64_t& /* packet_time_us */) {
   RTC_DCHECK(external_socket_.get() == socket);
   Channel* channel = FindChannel(addr);
-  if (channel) {
+  if (channel && relay_in_place_) {
+    // There is a channel bound to this address. Write the ChannelData header
+    // into the headroom that the socket reserved in front of the packet and
+    // send it without copying the payload.
+    char* message = const_cast<char*>(data) - TURN_CHANNEL_HEADER_SIZE;
+    rtc::SetBE16(message, static_cast<uint16_t>(channel->id()));
+    rtc::SetBE16(message + 2, static_cast<uint16_t>(size));
+    server_->Send(&conn_, message, size + TURN_CHANNEL_HEADER_SIZE);
+  } else if (channel) {
     // There is a channel bound to this address. Send as a channel message.
     rtc::ByteBufferWriter buf;
     buf.WriteUInt16(channel->id());
@@ -895,7 +921,7 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
     perm = new Permission(thread_, addr);
     perm->SignalDestroyed.connect(
         this, &TurnServerAllocation::OnPermissionDestroyed);
-    perms_.push_back(perm);
+    perms_[addr] = perm;
   } else {
     perm->Refresh();
   }
@@ -903,32 +929,21 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
 
 TurnServerAllocation::Permission* TurnServerAllocation::FindPermission(
     const rtc::IPAddress& addr) const {
-  for (PermissionList::const_iterator it = perms_.begin();
-       it != perms_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  PermissionMap::const_iterator it = perms_.find(addr);
+  return (it != perms_.end()) ? it->second : NULL;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     int channel_id) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->id() == channel_id)
-      return *it;
-  }
-  return NULL;
+  // Unsigned wrap-around also rejects numbers below the valid range.
+  size_t index = static_cast<size_t>(channel_id - kMinChannelNumber);
+  return (index < channels_.size()) ? channels_[index] : NULL;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     const rtc::SocketAddress& addr) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  ChannelPeerMap::const_iterator it = channels_by_peer_.find(addr);
+  return (it != channels_by_peer_.end()) ? it->second : NULL;
 }
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
@@ -959,16 +974,19 @@ void TurnServerAllocation::OnMessage(rtc::Message* msg) {
 }
 
 void TurnServerAllocation::OnPermissionDestroyed(Permission* perm) {
-  PermissionList::iterator it = std::find(perms_.begin(), perms_.end(), perm);
-  RTC_DCHECK(it != perms_.end());
+  PermissionMap::iterator it = perms_.find(perm->peer());
+  RTC_DCHECK(it != perms_.end() && it->second == perm);
   perms_.erase(it);
 }
 
 void TurnServerAllocation::OnChannelDestroyed(Channel* channel) {
-  ChannelList::iterator it =
-      std::find(channels_.begin(), channels_.end(), channel);
-  RTC_DCHECK(it != channels_.end());
-  channels_.erase(it);
+  size_t index = channel->id() - kMinChannelNumber;
+  RTC_DCHECK(index < channels_.size() && channels_[index] == channel);
+  channels_[index] = nullptr;
+  while (!channels_.empty() && !channels_.back())
+    channels_.pop_back();
+  RTC_DCHECK_EQ(channels_by_peer_.count(channel->peer()), 1);
+  channels_by_peer_.erase(channel->peer());
 }
 
 TurnServerAllocation::Permission::Permission(rtc::Thread* thread,
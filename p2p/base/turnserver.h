@@ -11,11 +11,11 @@
 #ifndef P2P_BASE_TURNSERVER_H_
 #define P2P_BASE_TURNSERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -45,6 +45,11 @@ const int TURN_SERVER_PORT = 3478;
 // Encapsulates the client's connection to the server.
 class TurnServerConnection {
  public:
+  // Hash function for using connections as keys of unordered containers.
+  struct Hasher {
+    size_t operator()(const TurnServerConnection& c) const { return c.Hash(); }
+  };
+
   TurnServerConnection() : proto_(PROTO_UDP), socket_(NULL) {}
   TurnServerConnection(const rtc::SocketAddress& src,
                        ProtocolType proto,
@@ -53,6 +58,7 @@ class TurnServerConnection {
   rtc::AsyncPacketSocket* socket() { return socket_; }
   bool operator==(const TurnServerConnection& t) const;
   bool operator<(const TurnServerConnection& t) const;
+  size_t Hash() const;
   std::string ToString() const;
 
  private:
@@ -95,8 +101,18 @@ class TurnServerAllocation : public rtc::MessageHandler,
  private:
   class Channel;
   class Permission;
-  typedef std::list<Permission*> PermissionList;
-  typedef std::list<Channel*> ChannelList;
+  struct IPAddressHash {
+    size_t operator()(const rtc::IPAddress& ip) const { return rtc::HashIP(ip); }
+  };
+  typedef std::unordered_map<rtc::IPAddress, Permission*, IPAddressHash>
+      PermissionMap;
+  // Indexed by channel number minus the lowest valid one. Clients number
+  // their channels from the bottom of the range, so this stays small.
+  typedef std::vector<Channel*> ChannelArray;
+  typedef std::unordered_map<rtc::SocketAddress,
+                             Channel*,
+                             rtc::SocketAddressHash>
+      ChannelPeerMap;
 
   void HandleAllocateRequest(const TurnMessage* msg);
   void HandleRefreshRequest(const TurnMessage* msg);
@@ -137,8 +153,14 @@ class TurnServerAllocation : public rtc::MessageHandler,
   std::string username_;
   std::string origin_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  // True if |external_socket_| leaves room for a ChannelData header in front
+  // of received packets, so that they can be relayed without a copy.
+  bool relay_in_place_;
+  // Permissions by peer IP address.
+  PermissionMap perms_;
+  // Channels by channel number, and by peer address for packets from peers.
+  ChannelArray channels_;
+  ChannelPeerMap channels_by_peer_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -173,7 +195,9 @@ class StunMessageObserver {
 // Not yet wired up: TCP support.
 class TurnServer : public sigslot::has_slots<> {
  public:
-  typedef std::map<TurnServerConnection, std::unique_ptr<TurnServerAllocation>>
+  typedef std::unordered_map<TurnServerConnection,
+                             std::unique_ptr<TurnServerAllocation>,
+                             TurnServerConnection::Hasher>
       AllocationMap;
 
   explicit TurnServer(rtc::Thread* thread);
@@ -299,6 +323,7 @@ class TurnServer : public sigslot::has_slots<> {
 
   void SendStun(TurnServerConnection* conn, StunMessage* msg);
   void Send(TurnServerConnection* conn, const rtc::ByteBufferWriter& buf);
+  void Send(TurnServerConnection* conn, const char* data, size_t size);
 
   void OnAllocationDestroyed(TurnServerAllocation* allocation);
   void DestroyInternalSocket(rtc::AsyncPacketSocket* socket);
@@ -0,0 +1,246 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/udpsocketdemuxer.h"
+
+#include <string.h>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/stun.h"
+#include "p2p/base/stunpacket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace cricket {
+
+// The socket a port sends through. It forwards everything to the shared
+// socket, except the signals about sent packets, which only concern the port
+// that sent them.
+class UDPSocketDemuxer::PortSocket : public rtc::AsyncPacketSocket {
+ public:
+  explicit PortSocket(UDPSocketDemuxer* demuxer) : demuxer_(demuxer) {}
+
+  rtc::SocketAddress GetLocalAddress() const override {
+    return demuxer_->socket_->GetLocalAddress();
+  }
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return demuxer_->socket_->GetRemoteAddress();
+  }
+  int Send(const void* pv,
+           size_t cb,
+           const rtc::PacketOptions& options) override {
+    RTC_NOTREACHED();
+    return -1;
+  }
+  int SendTo(const void* pv,
+             size_t cb,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options) override {
+    demuxer_->sending_socket_ = this;
+    int sent = demuxer_->socket_->SendTo(pv, cb, addr, options);
+    demuxer_->sending_socket_ = nullptr;
+    return sent;
+  }
+  int SendToBatch(const void* const* buffers,
+                  const size_t* lengths,
+                  const rtc::PacketOptions* options,
+                  size_t count,
+                  const rtc::SocketAddress& addr) override {
+    demuxer_->sending_socket_ = this;
+    int sent =
+        demuxer_->socket_->SendToBatch(buffers, lengths, options, count, addr);
+    demuxer_->sending_socket_ = nullptr;
+    return sent;
+  }
+  // The shared socket stays open until the demuxer is destroyed.
+  int Close() override { return 0; }
+  State GetState() const override { return demuxer_->socket_->GetState(); }
+  int GetOption(rtc::Socket::Option opt, int* value) override {
+    return demuxer_->socket_->GetOption(opt, value);
+  }
+  int SetOption(rtc::Socket::Option opt, int value) override {
+    return demuxer_->socket_->SetOption(opt, value);
+  }
+  int GetError() const override { return demuxer_->socket_->GetError(); }
+  void SetError(int error) override { demuxer_->socket_->SetError(error); }
+
+ private:
+  UDPSocketDemuxer* const demuxer_;
+};
+
+// A UDPPort that owns the socket it sends through and leaves the demuxer when
+// it is deleted, which BasicPortAllocatorSession does without signaling.
+class UDPSocketDemuxer::DemuxedPort : public UDPPort {
+ public:
+  DemuxedPort(UDPSocketDemuxer* demuxer,
+              std::unique_ptr<PortSocket> socket,
+              rtc::Thread* thread,
+              rtc::PacketSocketFactory* factory,
+              rtc::Network* network,
+              const std::string& username,
+              const std::string& password,
+              const std::string& origin,
+              bool emit_local_for_anyaddress)
+      : UDPPort(thread,
+                factory,
+                network,
+                socket.get(),
+                username,
+                password,
+                origin,
+                emit_local_for_anyaddress),
+        demuxer_(demuxer),
+        socket_(std::move(socket)) {}
+  ~DemuxedPort() override { demuxer_->RemovePort(this); }
+
+  using UDPPort::Init;
+  PortSocket* socket() const { return socket_.get(); }
+
+ private:
+  UDPSocketDemuxer* const demuxer_;
+  const std::unique_ptr<PortSocket> socket_;
+};
+
+UDPSocketDemuxer::UDPSocketDemuxer(
+    std::unique_ptr<rtc::AsyncPacketSocket> socket)
+    : socket_(std::move(socket)) {
+  RTC_DCHECK(socket_);
+  socket_->SignalReadPacket.connect(this, &UDPSocketDemuxer::OnReadPacket);
+  socket_->SignalSentPacket.connect(this, &UDPSocketDemuxer::OnSentPacket);
+  socket_->SignalReadyToSend.connect(this, &UDPSocketDemuxer::OnReadyToSend);
+}
+
+UDPSocketDemuxer::~UDPSocketDemuxer() {
+  RTC_DCHECK(ports_.empty()) << "Ports must be deleted before the demuxer.";
+}
+
+std::unique_ptr<UDPPort> UDPSocketDemuxer::CreatePort(
+    rtc::Thread* thread,
+    rtc::PacketSocketFactory* factory,
+    rtc::Network* network,
+    const std::string& username,
+    const std::string& password,
+    const std::string& origin,
+    bool emit_local_for_anyaddress,
+    absl::optional<int> stun_keepalive_interval) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  auto port = absl::make_unique<DemuxedPort>(
+      this, absl::make_unique<PortSocket>(this), thread, factory, network,
+      username, password, origin, emit_local_for_anyaddress);
+  // Registered before Init(), so that a failed port leaves the demuxer again.
+  ports_.insert(port.get());
+  ufrag_ports_[username] = port.get();
+  port->set_stun_keepalive_delay(stun_keepalive_interval);
+  if (!port->Init()) {
+    return nullptr;
+  }
+  port->SignalConnectionCreated.connect(this,
+                                        &UDPSocketDemuxer::OnConnectionCreated);
+  return std::move(port);
+}
+
+void UDPSocketDemuxer::OnReadPacket(rtc::AsyncPacketSocket* socket,
+                                    const char* data,
+                                    size_t size,
+                                    const rtc::SocketAddress& remote_addr,
+                                    const int64_t& packet_time_us) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(socket == socket_.get());
+  DemuxedPort* port = FindPortForBindingRequest(data, size);
+  if (port) {
+    // The remote address may have moved to another port, e.g. after an ICE
+    // restart.
+    remote_ports_[remote_addr] = port;
+  } else {
+    auto it = remote_ports_.find(remote_addr);
+    if (it == remote_ports_.end()) {
+      RTC_LOG(LS_VERBOSE) << "Dropping a packet of " << size
+                          << " bytes from unknown address "
+                          << remote_addr.ToSensitiveString();
+      return;
+    }
+    port = it->second;
+  }
+  port->HandleIncomingPacket(port->socket(), data, size, remote_addr,
+                             packet_time_us);
+}
+
+void UDPSocketDemuxer::OnSentPacket(rtc::AsyncPacketSocket* socket,
+                                    const rtc::SentPacket& sent_packet) {
+  if (sending_socket_)
+    sending_socket_->SignalSentPacket(sending_socket_, sent_packet);
+}
+
+void UDPSocketDemuxer::OnReadyToSend(rtc::AsyncPacketSocket* socket) {
+  for (DemuxedPort* port : ports_) {
+    port->socket()->SignalReadyToSend(port->socket());
+  }
+}
+
+void UDPSocketDemuxer::OnConnectionCreated(Port* port, Connection* connection) {
+  // Responses to the checks of the connection come from its remote address.
+  // Keep an address that a Binding Request already associated with a port.
+  remote_ports_.insert(std::make_pair(connection->remote_candidate().address(),
+                                      static_cast<DemuxedPort*>(port)));
+}
+
+void UDPSocketDemuxer::RemovePort(DemuxedPort* port) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  ports_.erase(port);
+  for (auto it = ufrag_ports_.begin(); it != ufrag_ports_.end();) {
+    if (it->second == port) {
+      it = ufrag_ports_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = remote_ports_.begin(); it != remote_ports_.end();) {
+    if (it->second == port) {
+      it = remote_ports_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+UDPSocketDemuxer::DemuxedPort* UDPSocketDemuxer::FindPortForBindingRequest(
+    const char* data,
+    size_t size) {
+  StunPacketReader reader;
+  if (!reader.Parse(data, size) || reader.type() != STUN_BINDING_REQUEST)
+    return nullptr;
+  const char* username;
+  size_t username_length;
+  if (!reader.GetBytes(STUN_ATTR_USERNAME, &username, &username_length))
+    return nullptr;
+  // The USERNAME of a check is "<local ufrag>:<remote ufrag>".
+  const char* colon =
+      static_cast<const char*>(memchr(username, ':', username_length));
+  if (!colon)
+    return nullptr;
+  return FindPortByUfrag(std::string(username, colon - username));
+}
+
+UDPSocketDemuxer::DemuxedPort* UDPSocketDemuxer::FindPortByUfrag(
+    const std::string& ufrag) {
+  auto it = ufrag_ports_.find(ufrag);
+  if (it != ufrag_ports_.end() && it->second->username_fragment() == ufrag)
+    return it->second;
+  for (DemuxedPort* port : ports_) {
+    if (port->username_fragment() == ufrag) {
+      ufrag_ports_[ufrag] = port;
+      return port;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace cricket
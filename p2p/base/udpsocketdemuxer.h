@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_UDPSOCKETDEMUXER_H_
+#define P2P_BASE_UDPSOCKETDEMUXER_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "absl/types/optional.h"
+#include "p2p/base/stunport.h"
+#include "rtc_base/asyncpacketsocket.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/socketaddress.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread_checker.h"
+
+namespace cricket {
+
+// Lets the host UDPPorts of many PortAllocatorSessions, e.g. those of all the
+// PeerConnections of a media server, share a single UDP socket, so that the
+// number of file descriptors and poll registrations does not grow with the
+// number of peers.
+//
+// A packet received on the socket is given to the port whose ICE ufrag is the
+// local part of the USERNAME of a STUN Binding Request, which also associates
+// the source address with that port. Other packets go to the port associated
+// with their source address, either by an earlier request or because the port
+// created a connection to it. Packets from unknown addresses are dropped.
+//
+// Each port sends through its own AsyncPacketSocket that forwards to the
+// shared socket, so that SignalSentPacket only reaches the port that sent
+// the packet. Socket options, e.g. DSCP, are shared by all the ports.
+//
+// The ports don't gather server reflexive candidates, since a server with a
+// shared socket normally has a public address. All methods must be called on
+// the network thread, and the demuxer must outlive the ports it creates.
+class UDPSocketDemuxer : public sigslot::has_slots<> {
+ public:
+  explicit UDPSocketDemuxer(std::unique_ptr<rtc::AsyncPacketSocket> socket);
+  ~UDPSocketDemuxer() override;
+
+  rtc::AsyncPacketSocket* socket() const { return socket_.get(); }
+
+  // Creates a host UDPPort with the given ICE credentials on the shared
+  // socket. The port is removed from the demuxer when it is deleted.
+  std::unique_ptr<UDPPort> CreatePort(
+      rtc::Thread* thread,
+      rtc::PacketSocketFactory* factory,
+      rtc::Network* network,
+      const std::string& username,
+      const std::string& password,
+      const std::string& origin,
+      bool emit_local_for_anyaddress,
+      absl::optional<int> stun_keepalive_interval);
+
+  size_t num_ports() const { return ports_.size(); }
+  size_t num_remote_addresses() const { return remote_ports_.size(); }
+
+ private:
+  class DemuxedPort;
+  class PortSocket;
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us);
+  void OnSentPacket(rtc::AsyncPacketSocket* socket,
+                    const rtc::SentPacket& sent_packet);
+  void OnReadyToSend(rtc::AsyncPacketSocket* socket);
+  void OnConnectionCreated(Port* port, Connection* connection);
+  // Called by a port when it is deleted.
+  void RemovePort(DemuxedPort* port);
+
+  // Returns the port that receives the STUN Binding Request in |data|, or
+  // null if |data| is not a Binding Request for one of the ports.
+  DemuxedPort* FindPortForBindingRequest(const char* data, size_t size);
+  // Returns the port with the local ICE ufrag |ufrag|. Ports may change their
+  // ufrag after they are created, e.g. when a pooled session is taken.
+  DemuxedPort* FindPortByUfrag(const std::string& ufrag);
+
+  rtc::ThreadChecker thread_checker_;
+  std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  // The socket of the port that is currently sending, if any.
+  PortSocket* sending_socket_ = nullptr;
+  std::unordered_set<DemuxedPort*> ports_;
+  std::unordered_map<std::string, DemuxedPort*> ufrag_ports_;
+  std::unordered_map<rtc::SocketAddress, DemuxedPort*, rtc::SocketAddressHash>
+      remote_ports_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(UDPSocketDemuxer);
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_UDPSOCKETDEMUXER_H_
@@ -0,0 +1,249 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/udpsocketdemuxer.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/basicpacketsocketfactory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/network.h"
+#include "rtc_base/virtualsocketserver.h"
+
+namespace cricket {
+
+namespace {
+
+const rtc::SocketAddress kServerAddr("11.11.11.11", 3478);
+const rtc::SocketAddress kClientAddr1("22.22.22.22", 0);
+const rtc::SocketAddress kClientAddr2("33.33.33.33", 0);
+const char kUfrag1[] = "ufrag1";
+const char kUfrag2[] = "ufrag2";
+const char kPassword1[] = "password1password1pass";
+const char kPassword2[] = "password2password2pass";
+const int kTimeoutMs = 1000;
+const int kShortTimeoutMs = 100;
+
+class SentPacketCounter : public sigslot::has_slots<> {
+ public:
+  explicit SentPacketCounter(PortInterface* port) {
+    port->SignalSentPacket.connect(this, &SentPacketCounter::OnSentPacket);
+  }
+  int count() const { return count_; }
+
+ private:
+  void OnSentPacket(const rtc::SentPacket& sent_packet) { ++count_; }
+
+  int count_ = 0;
+};
+
+}  // namespace
+
+class UDPSocketDemuxerTest : public testing::Test,
+                             public sigslot::has_slots<> {
+ public:
+  UDPSocketDemuxerTest()
+      : ss_(new rtc::VirtualSocketServer()),
+        thread_(ss_.get()),
+        network_("unittest", "unittest", kServerAddr.ipaddr(), 32),
+        socket_factory_(rtc::Thread::Current()),
+        demuxer_(absl::WrapUnique(socket_factory_.CreateUdpSocket(
+            kServerAddr,
+            kServerAddr.port(),
+            kServerAddr.port()))) {
+    network_.AddIP(kServerAddr.ipaddr());
+  }
+
+  std::unique_ptr<UDPPort> CreatePort(const std::string& ufrag,
+                                      const std::string& password) {
+    std::unique_ptr<UDPPort> port = demuxer_.CreatePort(
+        rtc::Thread::Current(), &socket_factory_, &network_, ufrag, password,
+        std::string(), false, absl::nullopt);
+    port->SetIceRole(ICEROLE_CONTROLLED);
+    port->PrepareAddress();
+    port->SignalUnknownAddress.connect(this,
+                                       &UDPSocketDemuxerTest::OnUnknownAddress);
+    return port;
+  }
+
+  std::unique_ptr<rtc::AsyncPacketSocket> CreateClientSocket(
+      const rtc::SocketAddress& address) {
+    std::unique_ptr<rtc::AsyncPacketSocket> socket(
+        socket_factory_.CreateUdpSocket(address, 0, 0));
+    socket->SignalReadPacket.connect(this,
+                                     &UDPSocketDemuxerTest::OnClientPacket);
+    return socket;
+  }
+
+  // Sends the connectivity check of a client to the port with |ufrag|.
+  void SendBindingRequest(rtc::AsyncPacketSocket* socket,
+                          const std::string& ufrag,
+                          const std::string& password) {
+    IceMessage request;
+    request.SetType(STUN_BINDING_REQUEST);
+    request.SetTransactionID("0123456789ab");
+    request.AddAttribute(absl::make_unique<StunByteStringAttribute>(
+        STUN_ATTR_USERNAME, ufrag + ":rfrag"));
+    request.AddAttribute(
+        absl::make_unique<StunUInt32Attribute>(STUN_ATTR_PRIORITY, 100));
+    request.AddMessageIntegrity(password);
+    request.AddFingerprint();
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    socket->SendTo(buf.Data(), buf.Length(), kServerAddr, rtc::PacketOptions());
+  }
+
+  void OnUnknownAddress(PortInterface* port,
+                        const rtc::SocketAddress& address,
+                        ProtocolType proto,
+                        IceMessage* msg,
+                        const std::string& remote_ufrag,
+                        bool port_muxed) {
+    unknown_address_port_ = port;
+    unknown_address_ = address;
+  }
+
+  void OnClientPacket(rtc::AsyncPacketSocket* socket,
+                      const char* data,
+                      size_t size,
+                      const rtc::SocketAddress& remote_addr,
+                      const int64_t& packet_time_us) {
+    ++client_packets_;
+  }
+
+  void ListenForData(Connection* connection) {
+    connection->SignalReadPacket.connect(
+        this, &UDPSocketDemuxerTest::OnConnectionReadPacket);
+  }
+
+  void OnConnectionReadPacket(Connection* connection,
+                              const char* data,
+                              size_t size,
+                              int64_t packet_time_us) {
+    read_connection_ = connection;
+  }
+
+ protected:
+  std::unique_ptr<rtc::VirtualSocketServer> ss_;
+  rtc::AutoSocketServerThread thread_;
+  rtc::Network network_;
+  rtc::BasicPacketSocketFactory socket_factory_;
+  UDPSocketDemuxer demuxer_;
+  PortInterface* unknown_address_port_ = nullptr;
+  rtc::SocketAddress unknown_address_;
+  Connection* read_connection_ = nullptr;
+  int client_packets_ = 0;
+};
+
+TEST_F(UDPSocketDemuxerTest, PortsShareTheSocket) {
+  std::unique_ptr<UDPPort> port1 = CreatePort(kUfrag1, kPassword1);
+  std::unique_ptr<UDPPort> port2 = CreatePort(kUfrag2, kPassword2);
+  ASSERT_EQ(1u, port1->Candidates().size());
+  ASSERT_EQ(1u, port2->Candidates().size());
+  EXPECT_EQ(kServerAddr, port1->Candidates()[0].address());
+  EXPECT_EQ(kServerAddr, port2->Candidates()[0].address());
+  EXPECT_EQ(2u, demuxer_.num_ports());
+}
+
+TEST_F(UDPSocketDemuxerTest, RoutesBindingRequestsByUfrag) {
+  std::unique_ptr<UDPPort> port1 = CreatePort(kUfrag1, kPassword1);
+  std::unique_ptr<UDPPort> port2 = CreatePort(kUfrag2, kPassword2);
+  std::unique_ptr<rtc::AsyncPacketSocket> client1 =
+      CreateClientSocket(kClientAddr1);
+  std::unique_ptr<rtc::AsyncPacketSocket> client2 =
+      CreateClientSocket(kClientAddr2);
+
+  SendBindingRequest(client2.get(), kUfrag2, kPassword2);
+  EXPECT_EQ_WAIT(port2.get(), unknown_address_port_, kTimeoutMs);
+  EXPECT_EQ(client2->GetLocalAddress(), unknown_address_);
+
+  SendBindingRequest(client1.get(), kUfrag1, kPassword1);
+  EXPECT_EQ_WAIT(port1.get(), unknown_address_port_, kTimeoutMs);
+  EXPECT_EQ(client1->GetLocalAddress(), unknown_address_);
+  EXPECT_EQ(2u, demuxer_.num_remote_addresses());
+}
+
+TEST_F(UDPSocketDemuxerTest, RoutesDataByRemoteAddress) {
+  std::unique_ptr<UDPPort> port1 = CreatePort(kUfrag1, kPassword1);
+  std::unique_ptr<UDPPort> port2 = CreatePort(kUfrag2, kPassword2);
+  std::unique_ptr<rtc::AsyncPacketSocket> client =
+      CreateClientSocket(kClientAddr1);
+
+  Candidate remote;
+  remote.set_protocol(UDP_PROTOCOL_NAME);
+  remote.set_address(client->GetLocalAddress());
+  Connection* connection =
+      port2->CreateConnection(remote, PortInterface::ORIGIN_MESSAGE);
+  ASSERT_TRUE(connection != nullptr);
+  ListenForData(connection);
+  EXPECT_EQ(1u, demuxer_.num_remote_addresses());
+
+  const char kData[] = "media";
+  client->SendTo(kData, sizeof(kData), kServerAddr, rtc::PacketOptions());
+  EXPECT_EQ_WAIT(connection, read_connection_, kTimeoutMs);
+
+  // Only the port that sends is told about the sent packet.
+  SentPacketCounter port1_sent_packets(port1.get());
+  SentPacketCounter port2_sent_packets(port2.get());
+  EXPECT_EQ(static_cast<int>(sizeof(kData)),
+            connection->Send(kData, sizeof(kData), rtc::PacketOptions()));
+  EXPECT_EQ(0, port1_sent_packets.count());
+  EXPECT_EQ(1, port2_sent_packets.count());
+  EXPECT_EQ_WAIT(1, client_packets_, kTimeoutMs);
+}
+
+TEST_F(UDPSocketDemuxerTest, DropsPacketsFromUnknownAddresses) {
+  std::unique_ptr<UDPPort> port = CreatePort(kUfrag1, kPassword1);
+  std::unique_ptr<rtc::AsyncPacketSocket> client =
+      CreateClientSocket(kClientAddr1);
+
+  // A request for an unknown ufrag does not associate the address either.
+  SendBindingRequest(client.get(), "unknown", kPassword1);
+  const char kData[] = "media";
+  client->SendTo(kData, sizeof(kData), kServerAddr, rtc::PacketOptions());
+  rtc::Thread::Current()->ProcessMessages(kShortTimeoutMs);
+  EXPECT_EQ(nullptr, unknown_address_port_);
+  EXPECT_EQ(0u, demuxer_.num_remote_addresses());
+}
+
+TEST_F(UDPSocketDemuxerTest, DeletedPortLeavesTheDemuxer) {
+  std::unique_ptr<UDPPort> port1 = CreatePort(kUfrag1, kPassword1);
+  std::unique_ptr<UDPPort> port2 = CreatePort(kUfrag2, kPassword2);
+  std::unique_ptr<rtc::AsyncPacketSocket> client =
+      CreateClientSocket(kClientAddr1);
+  SendBindingRequest(client.get(), kUfrag1, kPassword1);
+  EXPECT_EQ_WAIT(port1.get(), unknown_address_port_, kTimeoutMs);
+  EXPECT_EQ(1u, demuxer_.num_remote_addresses());
+
+  port1.reset();
+  EXPECT_EQ(1u, demuxer_.num_ports());
+  EXPECT_EQ(0u, demuxer_.num_remote_addresses());
+
+  unknown_address_port_ = nullptr;
+  SendBindingRequest(client.get(), kUfrag1, kPassword1);
+  rtc::Thread::Current()->ProcessMessages(kShortTimeoutMs);
+  EXPECT_EQ(nullptr, unknown_address_port_);
+}
+
+TEST_F(UDPSocketDemuxerTest, FollowsUfragChanges) {
+  std::unique_ptr<UDPPort> port = CreatePort(kUfrag1, kPassword1);
+  std::unique_ptr<rtc::AsyncPacketSocket> client =
+      CreateClientSocket(kClientAddr1);
+  // As when a pooled session is taken with new ICE credentials.
+  port->SetIceParameters(0, kUfrag2, kPassword2);
+  SendBindingRequest(client.get(), kUfrag2, kPassword2);
+  EXPECT_EQ_WAIT(port.get(), unknown_address_port_, kTimeoutMs);
+}
+
+}  // namespace cricket
@@ -23,9 +23,11 @@
 #include "p2p/base/tcpport.h"
 #include "p2p/base/turnport.h"
 #include "p2p/base/udpport.h"
+#include "p2p/base/udpsocketdemuxer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/timeutils.h"
 #include "system_wrappers/include/metrics.h"
 
 using rtc::CreateRandomId;
@@ -47,6 +49,8 @@ const int PHASE_TCP = 2;
 
 const int kNumPhases = 3;
 
+const char* const kPhaseNames[kNumPhases] = {"Udp", "Relay", "Tcp"};
+
 // Gets protocol priority: UDP > TCP > SSLTCP == TLS.
 int GetProtocolPriority(cricket::ProtocolType protocol) {
   switch (protocol) {
@@ -351,6 +355,7 @@ void BasicPortAllocatorSession::StopGettingPorts() {
 void BasicPortAllocatorSession::ClearGettingPorts() {
   RTC_DCHECK_RUN_ON(network_thread_);
   network_thread_->Clear(this, MSG_ALLOCATE);
+  pending_sequences_.clear();
   for (uint32_t i = 0; i < sequences_.size(); ++i) {
     sequences_[i]->Stop();
   }
@@ -553,7 +558,8 @@ bool BasicPortAllocatorSession::CandidatesAllocationDone() const {
   }
 
   // Check that all port allocation sequences are complete (not running).
-  if (std::any_of(sequences_.begin(), sequences_.end(),
+  if (!pending_sequences_.empty() ||
+      std::any_of(sequences_.begin(), sequences_.end(),
                   [](const AllocationSequence* sequence) {
                     return sequence->state() == AllocationSequence::kRunning;
                   })) {
@@ -810,8 +816,8 @@ void BasicPortAllocatorSession::DoAllocate(bool disable_equivalent) {
       sequence->SignalPortAllocationComplete.connect(
           this, &BasicPortAllocatorSession::OnPortAllocationComplete);
       sequence->Init();
-      sequence->Start();
       sequences_.push_back(sequence);
+      StartSequence(sequence);
       done_signal_needed = true;
     }
   }
@@ -884,7 +890,7 @@ void BasicPortAllocatorSession::AddAllocatedPort(Port* port,
   port->set_send_retransmit_count_attribute(
       (flags() & PORTALLOCATOR_ENABLE_STUN_RETRANSMIT_ATTRIBUTE) != 0);
 
-  PortData data(port, seq);
+  PortData data(port, seq, seq ? seq->phase() : 0);
   ports_.push_back(data);
 
   port->SignalCandidateReady.connect(
@@ -1029,6 +1035,8 @@ void BasicPortAllocatorSession::OnPortComplete(Port* port) {
 
   // Moving to COMPLETE state.
   data->set_complete();
+  MaybeRecordPhaseTime(data->sequence(), data->phase());
+  MaybeStartPendingSequences();
   // Send candidate allocation complete signal if this was the last port.
   MaybeSignalCandidatesAllocationDone();
 }
@@ -1047,6 +1055,8 @@ void BasicPortAllocatorSession::OnPortError(Port* port) {
   // SignalAddressError is currently sent from StunPort/TurnPort.
   // But this signal itself is generic.
   data->set_error();
+  MaybeRecordPhaseTime(data->sequence(), data->phase());
+  MaybeStartPendingSequences();
   // Send candidate allocation complete signal if this was the last port.
   MaybeSignalCandidatesAllocationDone();
 }
@@ -1109,10 +1119,89 @@ bool BasicPortAllocatorSession::CandidatePairable(const Candidate& c,
 void BasicPortAllocatorSession::OnPortAllocationComplete(
     AllocationSequence* seq) {
   RTC_DCHECK_RUN_ON(network_thread_);
+  MaybeStartPendingSequences();
   // Send candidate allocation complete signal if all ports are done.
   MaybeSignalCandidatesAllocationDone();
 }
 
+void BasicPortAllocatorSession::StartSequence(AllocationSequence* sequence) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (flags() & PORTALLOCATOR_ENABLE_PARALLEL_GATHERING) {
+    int gathering = std::count_if(
+        sequences_.begin(), sequences_.end(),
+        [this](const AllocationSequence* s) { return IsSequenceGathering(s); });
+    if (gathering >= allocator_->max_parallel_gathering_networks()) {
+      RTC_LOG(LS_INFO) << "Delaying allocation on "
+                       << sequence->network()->ToString() << ", " << gathering
+                       << " networks are gathering";
+      pending_sequences_.push_back(sequence);
+      return;
+    }
+  }
+  sequence->Start();
+}
+
+void BasicPortAllocatorSession::MaybeStartPendingSequences() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  while (!pending_sequences_.empty()) {
+    int gathering = std::count_if(
+        sequences_.begin(), sequences_.end(),
+        [this](const AllocationSequence* s) { return IsSequenceGathering(s); });
+    if (gathering >= allocator_->max_parallel_gathering_networks())
+      return;
+    AllocationSequence* sequence = pending_sequences_.front();
+    pending_sequences_.erase(pending_sequences_.begin());
+    // Skip the sequences of networks that went away in the meantime.
+    if (!sequence->network_failed())
+      sequence->Start();
+  }
+}
+
+bool BasicPortAllocatorSession::IsSequenceGathering(
+    const AllocationSequence* sequence) const {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (sequence->state() == AllocationSequence::kRunning)
+    return true;
+  if (sequence->state() == AllocationSequence::kInit)
+    return false;
+  return std::any_of(ports_.begin(), ports_.end(),
+                     [sequence](const PortData& data) {
+                       return data.sequence() == sequence && data.inprogress();
+                     });
+}
+
+void BasicPortAllocatorSession::MaybeRecordPhaseTime(
+    AllocationSequence* sequence,
+    int phase) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!sequence)
+    return;
+  // Wait until the phase has created all of its ports.
+  if (sequence->state() == AllocationSequence::kRunning &&
+      sequence->phase() <= phase) {
+    return;
+  }
+  bool has_ports = false;
+  for (const PortData& data : ports_) {
+    if (data.sequence() != sequence || data.phase() != phase)
+      continue;
+    if (data.inprogress())
+      return;
+    has_ports = true;
+  }
+  if (!has_ports)
+    return;
+  // The time from the start of the sequence until the phase has gathered all
+  // of its candidates, which includes the step delays before the phase.
+  int elapsed_ms =
+      static_cast<int>(rtc::TimeMillis() - sequence->start_time_ms());
+  RTC_HISTOGRAMS_COUNTS_100000(
+      phase,
+      std::string("WebRTC.PeerConnection.IceGatheringPhaseTimeMs.") +
+          kPhaseNames[phase],
+      elapsed_ms);
+}
+
 void BasicPortAllocatorSession::MaybeSignalCandidatesAllocationDone() {
   RTC_DCHECK_RUN_ON(network_thread_);
   if (CandidatesAllocationDone()) {
@@ -1296,6 +1385,7 @@ void AllocationSequence::DisableEquivalentPhases(rtc::Network* network,
 
 void AllocationSequence::Start() {
   state_ = kRunning;
+  start_time_ms_ = rtc::TimeMillis();
   session_->network_thread()->Post(RTC_FROM_HERE, this, MSG_ALLOCATION_PHASE);
   // Take a snapshot of the best IP, so that when DisableEquivalentPhases is
   // called next time, we enable all phases if the best IP has since changed.
@@ -1314,11 +1404,9 @@ void AllocationSequence::OnMessage(rtc::Message* msg) {
   RTC_DCHECK(rtc::Thread::Current() == session_->network_thread());
   RTC_DCHECK(msg->message_id == MSG_ALLOCATION_PHASE);
 
-  const char* const PHASE_NAMES[kNumPhases] = {"Udp", "Relay", "Tcp"};
-
   // Perform all of the phases in the current step.
   RTC_LOG(LS_INFO) << network_->ToString()
-                   << ": Allocation Phase=" << PHASE_NAMES[phase_];
+                   << ": Allocation Phase=" << kPhaseNames[phase_];
 
   switch (phase_) {
     case PHASE_UDP:
@@ -1339,17 +1427,26 @@ void AllocationSequence::OnMessage(rtc::Message* msg) {
       RTC_NOTREACHED();
   }
 
+  const int done_phase = phase_;
   if (state() == kRunning) {
     ++phase_;
-    session_->network_thread()->PostDelayed(RTC_FROM_HERE,
-                                            session_->allocator()->step_delay(),
-                                            this, MSG_ALLOCATION_PHASE);
+    if (IsFlagSet(PORTALLOCATOR_ENABLE_PARALLEL_GATHERING)) {
+      // Yield between the phases so that other networks can start theirs.
+      session_->network_thread()->Post(RTC_FROM_HERE, this,
+                                       MSG_ALLOCATION_PHASE);
+    } else {
+      session_->network_thread()->PostDelayed(
+          RTC_FROM_HERE, session_->allocator()->step_delay(), this,
+          MSG_ALLOCATION_PHASE);
+    }
   } else {
     // If all phases in AllocationSequence are completed, no allocation
     // steps needed further. Canceling  pending signal.
     session_->network_thread()->Clear(this, MSG_ALLOCATION_PHASE);
     SignalPortAllocationComplete(this);
   }
+  // All the ports of the phase may have finished gathering already.
+  session_->MaybeRecordPhaseTime(this, done_phase);
 }
 
 void AllocationSequence::CreateUDPPorts() {
@@ -1363,6 +1460,20 @@ void AllocationSequence::CreateUDPPorts() {
   std::unique_ptr<UDPPort> port;
   bool emit_local_candidate_for_anyaddress =
       !IsFlagSet(PORTALLOCATOR_DISABLE_DEFAULT_LOCAL_CANDIDATE);
+  UDPSocketDemuxer* demuxer = session_->allocator()->udp_socket_demuxer();
+  if (demuxer && demuxer->socket()->GetLocalAddress().ipaddr() ==
+                     network_->GetBestIP()) {
+    port = demuxer->CreatePort(
+        session_->network_thread(), session_->socket_factory(), network_,
+        session_->username(), session_->password(),
+        session_->allocator()->origin(), emit_local_candidate_for_anyaddress,
+        session_->allocator()->stun_candidate_keepalive_interval());
+    // The demuxer hands the port its packets, and the port does not gather a
+    // STUN candidate.
+    if (port)
+      session_->AddAllocatedPort(port.release(), this, true);
+    return;
+  }
   if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET) && udp_socket_) {
     port = UDPPort::Create(
         session_->network_thread(), session_->socket_factory(), network_,
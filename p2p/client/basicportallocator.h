@@ -27,6 +27,12 @@
 
 namespace cricket {
 
+class UDPSocketDemuxer;
+
+// The number of networks that gather candidates at the same time with
+// PORTALLOCATOR_ENABLE_PARALLEL_GATHERING, unless set otherwise.
+const int kDefaultMaxParallelGatheringNetworks = 4;
+
 class RTC_EXPORT BasicPortAllocator : public PortAllocator {
  public:
   // note: The (optional) relay_port_factory is owned by caller
@@ -79,6 +85,31 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
     return relay_port_factory_;
   }
 
+  // If set, sessions create their UDP host port on the shared socket of
+  // |demuxer| instead of a socket of their own, on the network with the IP
+  // the socket is bound to. The demuxer must outlive the sessions.
+  void set_udp_socket_demuxer(UDPSocketDemuxer* demuxer) {
+    CheckRunOnValidThreadIfInitialized();
+    udp_socket_demuxer_ = demuxer;
+  }
+  UDPSocketDemuxer* udp_socket_demuxer() const {
+    CheckRunOnValidThreadIfInitialized();
+    return udp_socket_demuxer_;
+  }
+
+  // With PORTALLOCATOR_ENABLE_PARALLEL_GATHERING, a session gathers on at
+  // most this many networks at a time; the others start as soon as one of
+  // them has no port gathering candidates anymore.
+  void set_max_parallel_gathering_networks(int max_networks) {
+    CheckRunOnValidThreadIfInitialized();
+    RTC_DCHECK_GT(max_networks, 0);
+    max_parallel_gathering_networks_ = max_networks;
+  }
+  int max_parallel_gathering_networks() const {
+    CheckRunOnValidThreadIfInitialized();
+    return max_parallel_gathering_networks_;
+  }
+
  private:
   void Construct();
 
@@ -98,6 +129,9 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
 
   // This instance is created if caller does pass a factory.
   std::unique_ptr<RelayPortFactoryInterface> default_relay_port_factory_;
+
+  UDPSocketDemuxer* udp_socket_demuxer_ = nullptr;
+  int max_parallel_gathering_networks_ = kDefaultMaxParallelGatheringNetworks;
 };
 
 struct PortConfiguration;
@@ -159,11 +193,13 @@ class RTC_EXPORT BasicPortAllocatorSession : public PortAllocatorSession,
   class PortData {
    public:
     PortData() {}
-    PortData(Port* port, AllocationSequence* seq)
-        : port_(port), sequence_(seq) {}
+    PortData(Port* port, AllocationSequence* seq, int phase)
+        : port_(port), sequence_(seq), phase_(phase) {}
 
     Port* port() const { return port_; }
     AllocationSequence* sequence() const { return sequence_; }
+    // The allocation phase of |sequence_| that created the port.
+    int phase() const { return phase_; }
     bool has_pairable_candidate() const { return has_pairable_candidate_; }
     bool complete() const { return state_ == STATE_COMPLETE; }
     bool error() const { return state_ == STATE_ERROR; }
@@ -203,6 +239,7 @@ class RTC_EXPORT BasicPortAllocatorSession : public PortAllocatorSession,
     };
     Port* port_ = nullptr;
     AllocationSequence* sequence_ = nullptr;
+    int phase_ = 0;
     bool has_pairable_candidate_ = false;
     State state_ = STATE_INPROGRESS;
   };
@@ -227,6 +264,16 @@ class RTC_EXPORT BasicPortAllocatorSession : public PortAllocatorSession,
   void OnPortDestroyed(PortInterface* port);
   void MaybeSignalCandidatesAllocationDone();
   void OnPortAllocationComplete(AllocationSequence* seq);
+  // Starts |sequence| now, or once fewer networks are gathering if parallel
+  // gathering is bounded.
+  void StartSequence(AllocationSequence* sequence);
+  void MaybeStartPendingSequences();
+  // Returns true if |sequence| is allocating ports or has ports that are
+  // still gathering candidates.
+  bool IsSequenceGathering(const AllocationSequence* sequence) const;
+  // Records how long |phase| of |sequence| took, once all of its ports have
+  // finished gathering.
+  void MaybeRecordPhaseTime(AllocationSequence* sequence, int phase);
   PortData* FindPort(Port* port);
   std::vector<rtc::Network*> GetNetworks();
   std::vector<rtc::Network*> GetFailedNetworks();
@@ -268,6 +315,8 @@ class RTC_EXPORT BasicPortAllocatorSession : public PortAllocatorSession,
   bool allocation_sequences_created_;
   std::vector<PortConfiguration*> configs_;
   std::vector<AllocationSequence*> sequences_;
+  // Sequences waiting for parallel gathering to start them, in order.
+  std::vector<AllocationSequence*> pending_sequences_;
   std::vector<PortData> ports_;
   uint32_t candidate_filter_ = CF_ALL;
   // Whether to prune low-priority ports, taken from the port allocator.
@@ -344,6 +393,10 @@ class AllocationSequence : public rtc::MessageHandler,
 
   State state() const { return state_; }
   rtc::Network* network() const { return network_; }
+  // The phase that is running or runs next.
+  int phase() const { return phase_; }
+  // When Start() was called, used to time the phases.
+  int64_t start_time_ms() const { return start_time_ms_; }
 
   bool network_failed() const { return network_failed_; }
   void set_network_failed() { network_failed_ = true; }
@@ -406,6 +459,7 @@ class AllocationSequence : public rtc::MessageHandler,
   UDPPort* udp_port_;
   std::vector<Port*> relay_ports_;
   int phase_;
+  int64_t start_time_ms_ = 0;
 };
 
 }  // namespace cricket
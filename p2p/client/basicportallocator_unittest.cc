@@ -1173,6 +1173,56 @@ TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithOneSecondStepDelay) {
   session_->StopGettingPorts();
 }
 
+// Tests that parallel gathering runs all the phases without the step delay,
+// and records how long each phase took.
+TEST_F(BasicPortAllocatorTest, TestParallelGatheringIgnoresStepDelay) {
+  AddInterface(kClientAddr);
+  allocator_->set_step_delay(kDefaultStepDelay);
+  allocator_->set_flags(allocator().flags() |
+                        PORTALLOCATOR_ENABLE_PARALLEL_GATHERING);
+  ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  // With the step delay, the TCP phase alone would start after 2 seconds.
+  ASSERT_TRUE_SIMULATED_WAIT(candidate_allocation_done_, kDefaultStepDelay,
+                             fake_clock);
+  EXPECT_EQ(7U, candidates_.size());
+  EXPECT_EQ(4U, ports_.size());
+  EXPECT_TRUE(HasCandidate(candidates_, "relay", "udp", kRelayUdpIntAddr));
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "tcp", kClientAddr));
+  EXPECT_EQ(1, webrtc::metrics::NumSamples(
+                   "WebRTC.PeerConnection.IceGatheringPhaseTimeMs.Udp"));
+  EXPECT_EQ(1, webrtc::metrics::NumSamples(
+                   "WebRTC.PeerConnection.IceGatheringPhaseTimeMs.Relay"));
+  EXPECT_EQ(1, webrtc::metrics::NumSamples(
+                   "WebRTC.PeerConnection.IceGatheringPhaseTimeMs.Tcp"));
+}
+
+// Tests that parallel gathering starts a network only when fewer than the
+// maximum number of networks are gathering.
+TEST_F(BasicPortAllocatorTest, TestParallelGatheringBoundsNetworks) {
+  AddInterface(kClientAddr, "net1");
+  AddInterface(kClientAddr2, "net2");
+  allocator_->set_flags(allocator().flags() |
+                        PORTALLOCATOR_ENABLE_PARALLEL_GATHERING);
+  allocator_->set_max_parallel_gathering_networks(1);
+  ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  ASSERT_TRUE_SIMULATED_WAIT(candidate_allocation_done_,
+                             kDefaultAllocationTimeout, fake_clock);
+  ASSERT_EQ(8U, ports_.size());
+  // All the ports of one network are ready before those of the other one.
+  const rtc::Network* first_network = ports_[0]->Network();
+  auto first_of_second_network = std::find_if(
+      ports_.begin(), ports_.end(), [first_network](PortInterface* port) {
+        return port->Network() != first_network;
+      });
+  EXPECT_EQ(4, first_of_second_network - ports_.begin());
+  EXPECT_TRUE(std::all_of(first_of_second_network, ports_.end(),
+                          [first_network](PortInterface* port) {
+                            return port->Network() != first_network;
+                          }));
+}
+
 TEST_F(BasicPortAllocatorTest, TestSetupVideoRtpPortsWithNormalSendBuffers) {
   AddInterface(kClientAddr);
   ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP, CN_VIDEO));
@@ -524,9 +524,28 @@ void BaseChannel::OnPacketReceived(bool rtcp,
     return;
   }
 
-  invoker_.AsyncInvoke<void>(
-      RTC_FROM_HERE, worker_thread_,
-      Bind(&BaseChannel::ProcessPacket, this, rtcp, packet, packet_time_us));
+  bool post_task;
+  {
+    rtc::CritScope cs(&received_packets_crit_);
+    post_task = received_packets_.empty();
+    received_packets_.push_back({rtcp, packet, packet_time_us});
+  }
+  if (post_task) {
+    invoker_.AsyncInvoke<void>(RTC_FROM_HERE, worker_thread_,
+                               [this] { ProcessReceivedPackets_w(); });
+  }
+}
+
+void BaseChannel::ProcessReceivedPackets_w() {
+  RTC_DCHECK(worker_thread_->IsCurrent());
+  {
+    rtc::CritScope cs(&received_packets_crit_);
+    packets_to_process_.swap(received_packets_);
+  }
+  for (const ReceivedPacket& received : packets_to_process_) {
+    ProcessPacket(received.rtcp, received.packet, received.packet_time_us);
+  }
+  packets_to_process_.clear();
 }
 
 void BaseChannel::ProcessPacket(bool rtcp,
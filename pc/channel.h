@@ -242,6 +242,8 @@ class BaseChannel : public ChannelInterface,
   void ProcessPacket(bool rtcp,
                      const rtc::CopyOnWriteBuffer& packet,
                      int64_t packet_time_us);
+  // Processes all packets queued by OnPacketReceived().
+  void ProcessReceivedPackets_w();
 
   void EnableMedia_w();
   void DisableMedia_w();
@@ -299,6 +301,12 @@ class BaseChannel : public ChannelInterface,
   bool RegisterRtpDemuxerSink();
 
  private:
+  struct ReceivedPacket {
+    bool rtcp;
+    rtc::CopyOnWriteBuffer packet;
+    int64_t packet_time_us;
+  };
+
   bool ConnectToRtpTransport();
   void DisconnectFromRtpTransport();
   void SignalSentPacket_n(const rtc::SentPacket& sent_packet);
@@ -313,6 +321,15 @@ class BaseChannel : public ChannelInterface,
   rtc::AsyncInvoker invoker_;
   sigslot::signal1<ChannelInterface*> SignalFirstPacketReceived_;
 
+  // Packets received on the network thread and not yet processed on the
+  // worker thread. A task to process them is posted only when the first
+  // packet is queued, so a burst of packets costs a single thread hop.
+  rtc::CriticalSection received_packets_crit_;
+  std::vector<ReceivedPacket> received_packets_
+      RTC_GUARDED_BY(received_packets_crit_);
+  // Swapped with |received_packets_|, to reuse the allocations of both.
+  std::vector<ReceivedPacket> packets_to_process_;
+
   const std::string content_name_;
 
   // Won't be set when using raw packet transports. SDP-specific thing.
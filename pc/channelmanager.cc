@@ -163,12 +163,14 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
     const std::string& content_name,
     bool srtp_required,
     const webrtc::CryptoOptions& crypto_options,
-    const AudioOptions& options) {
+    const AudioOptions& options,
+    rtc::Thread* network_thread) {
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<VoiceChannel*>(RTC_FROM_HERE, [&] {
       return CreateVoiceChannel(call, media_config, rtp_transport,
                                 media_transport, signaling_thread, content_name,
-                                srtp_required, crypto_options, options);
+                                srtp_required, crypto_options, options,
+                                network_thread);
     });
   }
 
@@ -186,7 +188,8 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
   }
 
   auto voice_channel = absl::make_unique<VoiceChannel>(
-      worker_thread_, network_thread_, signaling_thread, media_engine_.get(),
+      worker_thread_, network_thread ? network_thread : network_thread_,
+      signaling_thread, media_engine_.get(),
       absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options);
 
@@ -230,12 +233,13 @@ VideoChannel* ChannelManager::CreateVideoChannel(
     const std::string& content_name,
     bool srtp_required,
     const webrtc::CryptoOptions& crypto_options,
-    const VideoOptions& options) {
+    const VideoOptions& options,
+    rtc::Thread* network_thread) {
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<VideoChannel*>(RTC_FROM_HERE, [&] {
       return CreateVideoChannel(call, media_config, rtp_transport,
                                 signaling_thread, content_name, srtp_required,
-                                crypto_options, options);
+                                crypto_options, options, network_thread);
     });
   }
 
@@ -253,8 +257,8 @@ VideoChannel* ChannelManager::CreateVideoChannel(
   }
 
   auto video_channel = absl::make_unique<VideoChannel>(
-      worker_thread_, network_thread_, signaling_thread,
-      absl::WrapUnique(media_channel), content_name, srtp_required,
+      worker_thread_, network_thread ? network_thread : network_thread_,
+      signaling_thread, absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options);
 
   // TODO(sukhanov): Add media_transport support for video channel.
@@ -296,11 +300,13 @@ RtpDataChannel* ChannelManager::CreateRtpDataChannel(
     rtc::Thread* signaling_thread,
     const std::string& content_name,
     bool srtp_required,
-    const webrtc::CryptoOptions& crypto_options) {
+    const webrtc::CryptoOptions& crypto_options,
+    rtc::Thread* network_thread) {
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<RtpDataChannel*>(RTC_FROM_HERE, [&] {
       return CreateRtpDataChannel(media_config, rtp_transport, signaling_thread,
-                                  content_name, srtp_required, crypto_options);
+                                  content_name, srtp_required, crypto_options,
+                                  network_thread);
     });
   }
 
@@ -313,8 +319,8 @@ RtpDataChannel* ChannelManager::CreateRtpDataChannel(
   }
 
   auto data_channel = absl::make_unique<RtpDataChannel>(
-      worker_thread_, network_thread_, signaling_thread,
-      absl::WrapUnique(media_channel), content_name, srtp_required,
+      worker_thread_, network_thread ? network_thread : network_thread_,
+      signaling_thread, absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options);
   data_channel->Init_w(rtp_transport);
 
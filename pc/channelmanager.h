@@ -88,7 +88,9 @@ class ChannelManager final {
 
   // The operations below all occur on the worker thread.
   // ChannelManager retains ownership of the created channels, so clients should
-  // call the appropriate Destroy*Channel method when done.
+  // call the appropriate Destroy*Channel method when done. The channels run on
+  // |network_thread|, which must be the thread of |rtp_transport|; if null,
+  // network_thread() is used.
 
   // Creates a voice channel, to be associated with the specified session.
   VoiceChannel* CreateVoiceChannel(
@@ -100,7 +102,8 @@ class ChannelManager final {
       const std::string& content_name,
       bool srtp_required,
       const webrtc::CryptoOptions& crypto_options,
-      const AudioOptions& options);
+      const AudioOptions& options,
+      rtc::Thread* network_thread = nullptr);
   // Destroys a voice channel created by CreateVoiceChannel.
   void DestroyVoiceChannel(VoiceChannel* voice_channel);
 
@@ -114,7 +117,8 @@ class ChannelManager final {
                                    const std::string& content_name,
                                    bool srtp_required,
                                    const webrtc::CryptoOptions& crypto_options,
-                                   const VideoOptions& options);
+                                   const VideoOptions& options,
+                                   rtc::Thread* network_thread = nullptr);
   // Destroys a video channel created by CreateVideoChannel.
   void DestroyVideoChannel(VideoChannel* video_channel);
 
@@ -124,7 +128,8 @@ class ChannelManager final {
       rtc::Thread* signaling_thread,
       const std::string& content_name,
       bool srtp_required,
-      const webrtc::CryptoOptions& crypto_options);
+      const webrtc::CryptoOptions& crypto_options,
+      rtc::Thread* network_thread = nullptr);
   // Destroys a data channel created by CreateRtpDataChannel.
   void DestroyRtpDataChannel(RtpDataChannel* data_channel);
 
@@ -0,0 +1,677 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/datagram_media_transport.h"
+
+#include <openssl/evp.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "api/transport/goog_cc_factory.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Same defaults as for the RTP path, see BitrateConstraints.
+constexpr int kMinBitrateBps = 30000;
+constexpr int kStartBitrateBps = 300000;
+
+constexpr size_t kNonceSize = 12;
+constexpr uint8_t kCallerNonceTag = 1;
+constexpr uint8_t kCalleeNonceTag = 2;
+
+TargetRateConstraints MakeConstraints() {
+  TargetRateConstraints constraints;
+  constraints.at_time = Timestamp::ms(rtc::TimeMillis());
+  constraints.min_data_rate = DataRate::bps(kMinBitrateBps);
+  constraints.starting_rate = DataRate::bps(kStartBitrateBps);
+  return constraints;
+}
+
+rtc::CopyOnWriteBuffer FinishDatagram(const rtc::ByteBufferWriter& writer) {
+  // Reserve space for the tag, which is appended on the network thread.
+  return rtc::CopyOnWriteBuffer(writer.Data(), writer.Length(),
+                                writer.Length() +
+                                    DatagramMediaTransport::kTagSize);
+}
+
+}  // namespace
+
+// AES-256-GCM protection of the datagram bodies. The header is authenticated
+// but not encrypted, and the nonce is the role of the sender followed by the
+// packet number, so that it is never reused for a key.
+class DatagramMediaTransport::Cipher {
+ public:
+  Cipher(const std::string& key, bool is_caller)
+      : seal_context_(EVP_CIPHER_CTX_new()),
+        open_context_(EVP_CIPHER_CTX_new()),
+        local_nonce_tag_(is_caller ? kCallerNonceTag : kCalleeNonceTag),
+        remote_nonce_tag_(is_caller ? kCalleeNonceTag : kCallerNonceTag) {
+    RTC_CHECK_EQ(kKeySize, key.size());
+    const uint8_t* key_data = reinterpret_cast<const uint8_t*>(key.data());
+    RTC_CHECK(seal_context_ && open_context_);
+    RTC_CHECK(EVP_EncryptInit_ex(seal_context_, EVP_aes_256_gcm(), nullptr,
+                                 key_data, nullptr));
+    RTC_CHECK(EVP_DecryptInit_ex(open_context_, EVP_aes_256_gcm(), nullptr,
+                                 key_data, nullptr));
+  }
+
+  ~Cipher() {
+    EVP_CIPHER_CTX_free(seal_context_);
+    EVP_CIPHER_CTX_free(open_context_);
+  }
+
+  // Encrypts the body of |datagram| in place and appends the tag.
+  bool Seal(uint32_t packet_number, rtc::CopyOnWriteBuffer* datagram) {
+    uint8_t nonce[kNonceSize];
+    MakeNonce(local_nonce_tag_, packet_number, nonce);
+    uint8_t* data = datagram->data();
+    const int body_size =
+        static_cast<int>(datagram->size() - media_datagram::kHeaderSize);
+    int length;
+    uint8_t tag[kTagSize];
+    if (!EVP_EncryptInit_ex(seal_context_, nullptr, nullptr, nullptr, nonce) ||
+        !EVP_EncryptUpdate(seal_context_, nullptr, &length, data,
+                           media_datagram::kHeaderSize) ||
+        !EVP_EncryptUpdate(seal_context_, data + media_datagram::kHeaderSize,
+                           &length, data + media_datagram::kHeaderSize,
+                           body_size) ||
+        !EVP_EncryptFinal_ex(seal_context_, data + datagram->size(),
+                             &length) ||
+        !EVP_CIPHER_CTX_ctrl(seal_context_, EVP_CTRL_GCM_GET_TAG, kTagSize,
+                             tag)) {
+      return false;
+    }
+    datagram->AppendData(tag, kTagSize);
+    return true;
+  }
+
+  // Authenticates |datagram| and decrypts its body into |body|.
+  bool Open(uint32_t packet_number,
+            rtc::ArrayView<const uint8_t> datagram,
+            rtc::Buffer* body) {
+    if (datagram.size() < media_datagram::kHeaderSize + kTagSize)
+      return false;
+    const size_t body_size =
+        datagram.size() - media_datagram::kHeaderSize - kTagSize;
+    body->SetSize(body_size);
+    uint8_t nonce[kNonceSize];
+    MakeNonce(remote_nonce_tag_, packet_number, nonce);
+    int length;
+    if (!EVP_DecryptInit_ex(open_context_, nullptr, nullptr, nullptr, nonce) ||
+        !EVP_DecryptUpdate(open_context_, nullptr, &length, datagram.data(),
+                           media_datagram::kHeaderSize)) {
+      return false;
+    }
+    if (body_size > 0 &&
+        !EVP_DecryptUpdate(open_context_, body->data(), &length,
+                           datagram.data() + media_datagram::kHeaderSize,
+                           static_cast<int>(body_size))) {
+      return false;
+    }
+    uint8_t tag[kTagSize];
+    memcpy(tag, datagram.data() + datagram.size() - kTagSize, kTagSize);
+    return EVP_CIPHER_CTX_ctrl(open_context_, EVP_CTRL_GCM_SET_TAG, kTagSize,
+                               tag) &&
+           EVP_DecryptFinal_ex(open_context_, body->data() + body_size,
+                               &length) > 0;
+  }
+
+ private:
+  static void MakeNonce(uint8_t nonce_tag,
+                        uint32_t packet_number,
+                        uint8_t nonce[kNonceSize]) {
+    memset(nonce, 0, kNonceSize);
+    nonce[0] = nonce_tag;
+    nonce[8] = static_cast<uint8_t>(packet_number >> 24);
+    nonce[9] = static_cast<uint8_t>(packet_number >> 16);
+    nonce[10] = static_cast<uint8_t>(packet_number >> 8);
+    nonce[11] = static_cast<uint8_t>(packet_number);
+  }
+
+  EVP_CIPHER_CTX* const seal_context_;
+  EVP_CIPHER_CTX* const open_context_;
+  const uint8_t local_nonce_tag_;
+  const uint8_t remote_nonce_tag_;
+};
+
+constexpr size_t DatagramMediaTransport::kMaxDatagramSize;
+constexpr size_t DatagramMediaTransport::kKeySize;
+constexpr size_t DatagramMediaTransport::kTagSize;
+
+DatagramMediaTransport::DatagramMediaTransport(
+    rtc::PacketTransportInternal* packet_transport,
+    rtc::Thread* network_thread,
+    const MediaTransportSettings& settings,
+    NetworkControllerFactoryInterface* controller_factory)
+    : packet_transport_(packet_transport),
+      network_thread_(network_thread),
+      cipher_(settings.pre_shared_key
+                  ? absl::make_unique<Cipher>(*settings.pre_shared_key,
+                                              settings.is_caller)
+                  : nullptr),
+      max_body_size_(kMaxDatagramSize - media_datagram::kHeaderSize -
+                     (cipher_ ? kTagSize : 0)),
+      owned_event_log_(settings.event_log
+                           ? nullptr
+                           : absl::make_unique<RtcEventLogNullImpl>()),
+      process_interval_(TimeDelta::Zero()),
+      transport_feedback_adapter_(Clock::GetRealTimeClock()),
+      remote_estimator_proxy_(Clock::GetRealTimeClock(), this) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  RTC_DCHECK(packet_transport_);
+  if (!cipher_) {
+    RTC_LOG(LS_WARNING) << "No pre-shared key, media datagrams are sent "
+                           "unencrypted.";
+  }
+
+  GoogCcFeedbackNetworkControllerFactory default_controller_factory(
+      settings.event_log ? settings.event_log : owned_event_log_.get());
+  if (!controller_factory)
+    controller_factory = &default_controller_factory;
+  NetworkControllerConfig config;
+  config.constraints = MakeConstraints();
+  controller_ = controller_factory->Create(config);
+  process_interval_ = controller_factory->GetProcessInterval();
+
+  packet_transport_->SignalReadPacket.connect(
+      this, &DatagramMediaTransport::OnReadPacket);
+  packet_transport_->SignalSentPacket.connect(
+      this, &DatagramMediaTransport::OnSentPacket);
+  packet_transport_->SignalWritableState.connect(
+      this, &DatagramMediaTransport::OnWritableState);
+  packet_transport_->SignalNetworkRouteChanged.connect(
+      this, &DatagramMediaTransport::OnNetworkRouteChanged);
+  OnWritableState(packet_transport_);
+  OnNetworkRouteChanged(packet_transport_->network_route());
+
+  invoker_.AsyncInvokeDelayed<void>(
+      RTC_FROM_HERE, network_thread_,
+      [this] {
+        RTC_DCHECK_RUN_ON(network_thread_);
+        OnProcessInterval();
+      },
+      process_interval_.ms());
+}
+
+DatagramMediaTransport::~DatagramMediaTransport() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  packet_transport_->SignalReadPacket.disconnect(this);
+  packet_transport_->SignalSentPacket.disconnect(this);
+  packet_transport_->SignalWritableState.disconnect(this);
+  packet_transport_->SignalNetworkRouteChanged.disconnect(this);
+}
+
+RTCError DatagramMediaTransport::SendAudioFrame(
+    uint64_t channel_id,
+    MediaTransportEncodedAudioFrame frame) {
+  if (frame.encoded_data().size() + media_datagram::kMaxAudioFrameOverhead >
+      max_body_size_) {
+    return RTCError(RTCErrorType::INVALID_RANGE, "Audio frame too large.");
+  }
+  rtc::ByteBufferWriter writer(nullptr, kMaxDatagramSize);
+  media_datagram::WriteHeader({media_datagram::Type::kAudio, 0}, &writer);
+  media_datagram::WriteAudioFrame(channel_id, frame, &writer);
+  SendDatagrams({FinishDatagram(writer)});
+  return RTCError::OK();
+}
+
+RTCError DatagramMediaTransport::SendVideoFrame(
+    uint64_t channel_id,
+    const MediaTransportEncodedVideoFrame& frame) {
+  if (frame.referenced_frame_ids().size() >
+      media_datagram::kMaxReferencedFrames) {
+    return RTCError(RTCErrorType::INVALID_PARAMETER,
+                    "Too many referenced frames.");
+  }
+  const size_t frame_size = frame.encoded_image().size();
+  const size_t max_fragment_size =
+      max_body_size_ - media_datagram::kMaxVideoFragmentOverhead;
+  Datagrams datagrams;
+  datagrams.reserve(std::max<size_t>(
+      1, (frame_size + max_fragment_size - 1) / max_fragment_size));
+  size_t offset = 0;
+  do {
+    rtc::ByteBufferWriter writer(nullptr, kMaxDatagramSize);
+    media_datagram::WriteHeader({media_datagram::Type::kVideo, 0}, &writer);
+    offset = media_datagram::WriteVideoFragment(channel_id, frame, offset,
+                                                max_body_size_, &writer);
+    datagrams.push_back(FinishDatagram(writer));
+  } while (offset < frame_size);
+  SendDatagrams(std::move(datagrams));
+  return RTCError::OK();
+}
+
+void DatagramMediaTransport::SetKeyFrameRequestCallback(
+    MediaTransportKeyFrameRequestCallback* callback) {
+  rtc::CritScope lock(&sink_lock_);
+  key_frame_callback_ = callback;
+}
+
+RTCError DatagramMediaTransport::RequestKeyFrame(uint64_t channel_id) {
+  rtc::ByteBufferWriter writer(nullptr, kMaxDatagramSize);
+  media_datagram::WriteHeader({media_datagram::Type::kKeyFrameRequest, 0},
+                              &writer);
+  media_datagram::WriteChannelId(channel_id, &writer);
+  SendDatagrams({FinishDatagram(writer)});
+  return RTCError::OK();
+}
+
+void DatagramMediaTransport::SetReceiveAudioSink(
+    MediaTransportAudioSinkInterface* sink) {
+  rtc::CritScope lock(&sink_lock_);
+  audio_sink_ = sink;
+}
+
+void DatagramMediaTransport::SetReceiveVideoSink(
+    MediaTransportVideoSinkInterface* sink) {
+  rtc::CritScope lock(&sink_lock_);
+  video_sink_ = sink;
+}
+
+void DatagramMediaTransport::AddTargetTransferRateObserver(
+    TargetTransferRateObserver* observer) {
+  rtc::CritScope lock(&sink_lock_);
+  RTC_DCHECK(std::find(target_rate_observers_.begin(),
+                       target_rate_observers_.end(),
+                       observer) == target_rate_observers_.end());
+  target_rate_observers_.push_back(observer);
+  if (latest_target_rate_)
+    observer->OnTargetTransferRate(*latest_target_rate_);
+}
+
+void DatagramMediaTransport::RemoveTargetTransferRateObserver(
+    TargetTransferRateObserver* observer) {
+  rtc::CritScope lock(&sink_lock_);
+  auto it = std::find(target_rate_observers_.begin(),
+                      target_rate_observers_.end(), observer);
+  if (it == target_rate_observers_.end()) {
+    RTC_LOG(LS_ERROR) << "Attempt to remove an unknown target rate observer.";
+    return;
+  }
+  target_rate_observers_.erase(it);
+}
+
+absl::optional<TargetTransferRate>
+DatagramMediaTransport::GetLatestTargetTransferRate() {
+  rtc::CritScope lock(&sink_lock_);
+  return latest_target_rate_;
+}
+
+size_t DatagramMediaTransport::GetAudioPacketOverhead() const {
+  return kMaxDatagramSize - max_body_size_ +
+         media_datagram::kMaxAudioFrameOverhead;
+}
+
+void DatagramMediaTransport::SetNetworkChangeCallback(
+    MediaTransportNetworkChangeCallback* callback) {
+  rtc::CritScope lock(&sink_lock_);
+  network_change_callback_ = callback;
+  if (network_change_callback_ && network_route_)
+    network_change_callback_->OnNetworkRouteChanged(*network_route_);
+}
+
+void DatagramMediaTransport::SetMediaTransportStateCallback(
+    MediaTransportStateCallback* callback) {
+  rtc::CritScope lock(&sink_lock_);
+  state_callback_ = callback;
+  invoker_.AsyncInvoke<void>(RTC_FROM_HERE, network_thread_, [this] {
+    RTC_DCHECK_RUN_ON(network_thread_);
+    OnStateChanged();
+  });
+}
+
+RTCError DatagramMediaTransport::SendData(
+    int channel_id,
+    const SendDataParams& params,
+    const rtc::CopyOnWriteBuffer& buffer) {
+  // The channel id and message type take at most 6 bytes.
+  if (buffer.size() + 6 > max_body_size_) {
+    return RTCError(RTCErrorType::INVALID_RANGE,
+                    "Data message does not fit in a datagram.");
+  }
+  rtc::ByteBufferWriter writer(nullptr, kMaxDatagramSize);
+  media_datagram::WriteHeader({media_datagram::Type::kData, 0}, &writer);
+  media_datagram::WriteDataMessage(channel_id, params.type, buffer, &writer);
+  SendDatagrams({FinishDatagram(writer)});
+  return RTCError::OK();
+}
+
+RTCError DatagramMediaTransport::CloseChannel(int channel_id) {
+  rtc::ByteBufferWriter writer(nullptr, kMaxDatagramSize);
+  media_datagram::WriteHeader({media_datagram::Type::kDataChannelClose, 0},
+                              &writer);
+  media_datagram::WriteChannelId(channel_id, &writer);
+  SendDatagrams({FinishDatagram(writer)});
+  // Nothing is queued, so the channel is closed once the datagram is sent.
+  invoker_.AsyncInvoke<void>(RTC_FROM_HERE, network_thread_,
+                             [this, channel_id] {
+                               rtc::CritScope lock(&sink_lock_);
+                               if (data_sink_)
+                                 data_sink_->OnChannelClosed(channel_id);
+                             });
+  return RTCError::OK();
+}
+
+void DatagramMediaTransport::SetDataSink(DataChannelSink* sink) {
+  rtc::CritScope lock(&sink_lock_);
+  data_sink_ = sink;
+}
+
+bool DatagramMediaTransport::SendTransportFeedback(
+    rtcp::TransportFeedback* packet) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  rtc::Buffer feedback = packet->Build();
+  if (feedback.size() > max_body_size_) {
+    RTC_LOG(LS_WARNING) << "Dropping oversized transport feedback.";
+    return false;
+  }
+  rtc::ByteBufferWriter writer(nullptr, kMaxDatagramSize);
+  media_datagram::WriteHeader({media_datagram::Type::kFeedback, 0}, &writer);
+  writer.WriteBytes(reinterpret_cast<const char*>(feedback.data()),
+                    feedback.size());
+  SendDatagram(FinishDatagram(writer));
+  return true;
+}
+
+void DatagramMediaTransport::SendDatagrams(Datagrams datagrams) {
+  if (network_thread_->IsCurrent()) {
+    RTC_DCHECK_RUN_ON(network_thread_);
+    for (rtc::CopyOnWriteBuffer& datagram : datagrams)
+      SendDatagram(std::move(datagram));
+    return;
+  }
+  // Hand over the buffers without sharing them, so that writing the header
+  // and tag does not copy them.
+  auto posted_datagrams = std::make_shared<Datagrams>(std::move(datagrams));
+  invoker_.AsyncInvoke<void>(RTC_FROM_HERE, network_thread_,
+                             [this, posted_datagrams] {
+                               RTC_DCHECK_RUN_ON(network_thread_);
+                               for (rtc::CopyOnWriteBuffer& datagram :
+                                    *posted_datagrams) {
+                                 SendDatagram(std::move(datagram));
+                               }
+                             });
+}
+
+void DatagramMediaTransport::SendDatagram(rtc::CopyOnWriteBuffer datagram) {
+  if (state_ == MediaTransportState::kClosed)
+    return;
+  if (next_packet_number_ == std::numeric_limits<uint32_t>::max()) {
+    // The next packet number would repeat a nonce.
+    RTC_LOG(LS_ERROR) << "Packet numbers exhausted, closing media transport.";
+    SetState(MediaTransportState::kClosed);
+    return;
+  }
+  const uint32_t packet_number = next_packet_number_++;
+  uint8_t* header = datagram.data();
+  header[1] = static_cast<uint8_t>(packet_number >> 24);
+  header[2] = static_cast<uint8_t>(packet_number >> 16);
+  header[3] = static_cast<uint8_t>(packet_number >> 8);
+  header[4] = static_cast<uint8_t>(packet_number);
+  if (cipher_ && !cipher_->Seal(packet_number, &datagram)) {
+    RTC_LOG(LS_ERROR) << "Failed to encrypt media datagram.";
+    return;
+  }
+
+  const uint16_t sequence_number = static_cast<uint16_t>(packet_number);
+  transport_feedback_adapter_.AddPacket(0, sequence_number, datagram.size(),
+                                        PacedPacketInfo());
+  rtc::PacketOptions options;
+  options.packet_id = sequence_number;
+  options.info_signaled_after_sent.included_in_feedback = true;
+  options.info_signaled_after_sent.packet_size_bytes = datagram.size();
+  packet_transport_->SendPacket(datagram.data<char>(), datagram.size(),
+                                options, 0);
+}
+
+void DatagramMediaTransport::OnReadPacket(
+    rtc::PacketTransportInternal* transport,
+    const char* data,
+    size_t size,
+    const int64_t& packet_time_us,
+    int flags) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  rtc::ArrayView<const uint8_t> datagram(
+      reinterpret_cast<const uint8_t*>(data), size);
+  media_datagram::Header header;
+  if (!media_datagram::ReadHeader(datagram, &header))
+    return;
+
+  rtc::ArrayView<const uint8_t> body = datagram.subview(
+      media_datagram::kHeaderSize);
+  if (cipher_) {
+    if (!cipher_->Open(header.packet_number, datagram, &receive_buffer_)) {
+      RTC_LOG(LS_WARNING) << "Dropping media datagram that failed "
+                             "authentication.";
+      return;
+    }
+    body = receive_buffer_;
+  }
+
+  RTPHeader rtp_header;
+  rtp_header.extension.hasTransportSequenceNumber = true;
+  rtp_header.extension.transportSequenceNumber =
+      static_cast<uint16_t>(header.packet_number);
+  const int64_t arrival_time_us =
+      packet_time_us >= 0 ? packet_time_us : rtc::TimeMicros();
+  remote_estimator_proxy_.IncomingPacket(arrival_time_us / 1000, size,
+                                         rtp_header);
+
+  rtc::ByteBufferReader reader(reinterpret_cast<const char*>(body.data()),
+                               body.size());
+  OnDatagram(header.type, &reader);
+}
+
+void DatagramMediaTransport::OnDatagram(media_datagram::Type type,
+                                        rtc::ByteBufferReader* reader) {
+  bool valid = false;
+  switch (type) {
+    case media_datagram::Type::kAudio: {
+      uint64_t channel_id;
+      absl::optional<MediaTransportEncodedAudioFrame> frame;
+      valid = media_datagram::ReadAudioFrame(reader, &channel_id, &frame);
+      if (valid) {
+        rtc::CritScope lock(&sink_lock_);
+        if (audio_sink_)
+          audio_sink_->OnData(channel_id, std::move(*frame));
+      }
+      break;
+    }
+    case media_datagram::Type::kVideo: {
+      uint64_t channel_id;
+      absl::optional<MediaTransportEncodedVideoFrame> frame;
+      valid = video_frame_assembler_.InsertFragment(reader, &channel_id,
+                                                    &frame);
+      if (valid && frame) {
+        rtc::CritScope lock(&sink_lock_);
+        if (video_sink_)
+          video_sink_->OnData(channel_id, std::move(*frame));
+      }
+      break;
+    }
+    case media_datagram::Type::kKeyFrameRequest: {
+      uint64_t channel_id;
+      valid = media_datagram::ReadChannelId(reader, &channel_id);
+      if (valid) {
+        rtc::CritScope lock(&sink_lock_);
+        if (key_frame_callback_)
+          key_frame_callback_->OnKeyFrameRequested(channel_id);
+      }
+      break;
+    }
+    case media_datagram::Type::kData: {
+      int channel_id;
+      DataMessageType message_type;
+      rtc::CopyOnWriteBuffer data;
+      valid = media_datagram::ReadDataMessage(reader, &channel_id,
+                                              &message_type, &data);
+      if (valid) {
+        rtc::CritScope lock(&sink_lock_);
+        if (data_sink_)
+          data_sink_->OnDataReceived(channel_id, message_type, data);
+      }
+      break;
+    }
+    case media_datagram::Type::kDataChannelClose: {
+      uint64_t channel_id;
+      valid = media_datagram::ReadChannelId(reader, &channel_id);
+      if (valid) {
+        rtc::CritScope lock(&sink_lock_);
+        if (data_sink_) {
+          data_sink_->OnChannelClosing(static_cast<int>(channel_id));
+          data_sink_->OnChannelClosed(static_cast<int>(channel_id));
+        }
+      }
+      break;
+    }
+    case media_datagram::Type::kFeedback: {
+      std::unique_ptr<rtcp::TransportFeedback> feedback =
+          rtcp::TransportFeedback::ParseFrom(
+              reinterpret_cast<const uint8_t*>(reader->Data()),
+              reader->Length());
+      valid = feedback != nullptr;
+      if (valid) {
+        absl::optional<TransportPacketsFeedback> feedback_msg =
+            transport_feedback_adapter_.ProcessTransportFeedback(*feedback);
+        if (feedback_msg)
+          PostUpdates(controller_->OnTransportPacketsFeedback(*feedback_msg));
+      }
+      break;
+    }
+  }
+  if (!valid)
+    RTC_LOG(LS_WARNING) << "Dropping malformed media datagram.";
+}
+
+void DatagramMediaTransport::OnSentPacket(
+    rtc::PacketTransportInternal* transport,
+    const rtc::SentPacket& sent_packet) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  absl::optional<SentPacket> packet_msg =
+      transport_feedback_adapter_.ProcessSentPacket(sent_packet);
+  if (packet_msg)
+    PostUpdates(controller_->OnSentPacket(*packet_msg));
+}
+
+void DatagramMediaTransport::OnWritableState(
+    rtc::PacketTransportInternal* transport) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (state_ == MediaTransportState::kClosed)
+    return;
+  NetworkAvailability msg;
+  msg.at_time = Timestamp::ms(rtc::TimeMillis());
+  msg.network_available = transport->writable();
+  PostUpdates(controller_->OnNetworkAvailability(msg));
+  SetState(transport->writable() ? MediaTransportState::kWritable
+                                 : MediaTransportState::kPending);
+}
+
+void DatagramMediaTransport::OnNetworkRouteChanged(
+    absl::optional<rtc::NetworkRoute> network_route) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!network_route || !network_route->connected)
+    return;
+  {
+    rtc::CritScope lock(&sink_lock_);
+    const bool changed =
+        !network_route_ ||
+        network_route_->local_network_id != network_route->local_network_id ||
+        network_route_->remote_network_id != network_route->remote_network_id;
+    network_route_ = network_route;
+    if (network_change_callback_)
+      network_change_callback_->OnNetworkRouteChanged(*network_route);
+    if (!changed)
+      return;
+  }
+  transport_feedback_adapter_.SetNetworkIds(network_route->local_network_id,
+                                            network_route->remote_network_id);
+  NetworkRouteChange msg;
+  msg.at_time = Timestamp::ms(rtc::TimeMillis());
+  msg.constraints = MakeConstraints();
+  PostUpdates(controller_->OnNetworkRouteChange(msg));
+}
+
+void DatagramMediaTransport::OnProcessInterval() {
+  ProcessInterval msg;
+  msg.at_time = Timestamp::ms(rtc::TimeMillis());
+  PostUpdates(controller_->OnProcessInterval(msg));
+  if (remote_estimator_proxy_.TimeUntilNextProcess() <= 0)
+    remote_estimator_proxy_.Process();
+  invoker_.AsyncInvokeDelayed<void>(
+      RTC_FROM_HERE, network_thread_,
+      [this] {
+        RTC_DCHECK_RUN_ON(network_thread_);
+        OnProcessInterval();
+      },
+      process_interval_.ms());
+}
+
+void DatagramMediaTransport::PostUpdates(const NetworkControlUpdate& update) {
+  // Without a pacer, only the target rate is used.
+  if (!update.target_rate)
+    return;
+  rtc::CritScope lock(&sink_lock_);
+  latest_target_rate_ = update.target_rate;
+  for (TargetTransferRateObserver* observer : target_rate_observers_)
+    observer->OnTargetTransferRate(*update.target_rate);
+}
+
+void DatagramMediaTransport::SetState(MediaTransportState state) {
+  if (state_ == state)
+    return;
+  state_ = state;
+  OnStateChanged();
+}
+
+void DatagramMediaTransport::OnStateChanged() {
+  rtc::CritScope lock(&sink_lock_);
+  if (state_callback_)
+    state_callback_->OnStateChanged(state_);
+}
+
+DatagramMediaTransportFactory::DatagramMediaTransportFactory(
+    NetworkControllerFactoryInterface* controller_factory)
+    : controller_factory_(controller_factory) {}
+
+DatagramMediaTransportFactory::~DatagramMediaTransportFactory() = default;
+
+RTCErrorOr<std::unique_ptr<MediaTransportInterface>>
+DatagramMediaTransportFactory::CreateMediaTransport(
+    rtc::PacketTransportInternal* packet_transport,
+    rtc::Thread* network_thread,
+    const MediaTransportSettings& settings) {
+  if (!packet_transport || !network_thread) {
+    return RTCError(RTCErrorType::INVALID_PARAMETER,
+                    "A packet transport and a network thread are required.");
+  }
+  if (settings.pre_shared_key &&
+      settings.pre_shared_key->size() != DatagramMediaTransport::kKeySize) {
+    return RTCError(RTCErrorType::INVALID_PARAMETER,
+                    "Unsupported pre-shared key size.");
+  }
+  return network_thread->Invoke<std::unique_ptr<MediaTransportInterface>>(
+      RTC_FROM_HERE, [&] {
+        return absl::make_unique<DatagramMediaTransport>(
+            packet_transport, network_thread, settings, controller_factory_);
+      });
+}
+
+}  // namespace webrtc
@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_DATAGRAM_MEDIA_TRANSPORT_H_
+#define PC_DATAGRAM_MEDIA_TRANSPORT_H_
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/media_transport_interface.h"
+#include "api/transport/network_control.h"
+#include "logging/rtc_event_log/rtc_event_log.h"
+#include "modules/congestion_controller/rtp/transport_feedback_adapter.h"
+#include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
+#include "modules/remote_bitrate_estimator/remote_estimator_proxy.h"
+#include "p2p/base/packettransportinternal.h"
+#include "pc/media_datagram.h"
+#include "rtc_base/asyncinvoker.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Implementation of MediaTransportInterface that sends encoded frames, data
+// channel messages and congestion control feedback as datagrams directly on a
+// packet transport, typically the ICE transport of a JsepTransport. See
+// pc/media_datagram.h for the wire format.
+//
+// There is no RTP, RTCP or SRTP: a datagram carries a 5 byte header and, if a
+// pre-shared key is set, a 16 byte AES-GCM tag. The send rate is estimated by
+// a NetworkControllerInterface from transport wide feedback on all datagrams.
+// Frames are sent as soon as they are serialized, without pacing, and data
+// channel messages are sent unreliably regardless of their SendDataParams.
+//
+// Must be created and destroyed on |network_thread|. The other methods may be
+// called on any thread; callbacks are made on |network_thread|.
+class DatagramMediaTransport : public MediaTransportInterface,
+                               public TransportFeedbackSenderInterface,
+                               public sigslot::has_slots<> {
+ public:
+  // Upper bound of the size of the datagrams, including header and tag.
+  static constexpr size_t kMaxDatagramSize = 1200;
+  static constexpr size_t kKeySize = 32;
+  static constexpr size_t kTagSize = 16;
+
+  // If set, |settings.pre_shared_key| must be |kKeySize| bytes. Each side
+  // encrypts with a nonce that includes its role, so both may use the same
+  // key. |controller_factory| is only used during construction; if null, the
+  // feedback based GoogCC controller is used.
+  DatagramMediaTransport(
+      rtc::PacketTransportInternal* packet_transport,
+      rtc::Thread* network_thread,
+      const MediaTransportSettings& settings,
+      NetworkControllerFactoryInterface* controller_factory);
+  ~DatagramMediaTransport() override;
+
+  // MediaTransportInterface.
+  RTCError SendAudioFrame(uint64_t channel_id,
+                          MediaTransportEncodedAudioFrame frame) override;
+  RTCError SendVideoFrame(
+      uint64_t channel_id,
+      const MediaTransportEncodedVideoFrame& frame) override;
+  void SetKeyFrameRequestCallback(
+      MediaTransportKeyFrameRequestCallback* callback) override;
+  RTCError RequestKeyFrame(uint64_t channel_id) override;
+  void SetReceiveAudioSink(MediaTransportAudioSinkInterface* sink) override;
+  void SetReceiveVideoSink(MediaTransportVideoSinkInterface* sink) override;
+  void AddTargetTransferRateObserver(
+      TargetTransferRateObserver* observer) override;
+  void RemoveTargetTransferRateObserver(
+      TargetTransferRateObserver* observer) override;
+  absl::optional<TargetTransferRate> GetLatestTargetTransferRate() override;
+  size_t GetAudioPacketOverhead() const override;
+  void SetNetworkChangeCallback(
+      MediaTransportNetworkChangeCallback* callback) override;
+  void SetMediaTransportStateCallback(
+      MediaTransportStateCallback* callback) override;
+  RTCError SendData(int channel_id,
+                    const SendDataParams& params,
+                    const rtc::CopyOnWriteBuffer& buffer) override;
+  RTCError CloseChannel(int channel_id) override;
+  void SetDataSink(DataChannelSink* sink) override;
+
+  // TransportFeedbackSenderInterface, used by the receive side estimator
+  // proxy.
+  bool SendTransportFeedback(rtcp::TransportFeedback* packet) override;
+
+ private:
+  class Cipher;
+
+  // Serialized datagrams, with space for the header but without packet number
+  // or tag.
+  using Datagrams = std::vector<rtc::CopyOnWriteBuffer>;
+
+  void SendDatagrams(Datagrams datagrams);
+  void SendDatagram(rtc::CopyOnWriteBuffer datagram)
+      RTC_RUN_ON(network_thread_);
+
+  void OnReadPacket(rtc::PacketTransportInternal* transport,
+                    const char* data,
+                    size_t size,
+                    const int64_t& packet_time_us,
+                    int flags);
+  void OnSentPacket(rtc::PacketTransportInternal* transport,
+                    const rtc::SentPacket& sent_packet);
+  void OnWritableState(rtc::PacketTransportInternal* transport);
+  void OnNetworkRouteChanged(absl::optional<rtc::NetworkRoute> network_route);
+
+  void OnDatagram(media_datagram::Type type, rtc::ByteBufferReader* reader)
+      RTC_RUN_ON(network_thread_);
+  void OnProcessInterval() RTC_RUN_ON(network_thread_);
+  void PostUpdates(const NetworkControlUpdate& update)
+      RTC_RUN_ON(network_thread_);
+  void SetState(MediaTransportState state) RTC_RUN_ON(network_thread_);
+  void OnStateChanged() RTC_RUN_ON(network_thread_);
+
+  rtc::PacketTransportInternal* const packet_transport_;
+  rtc::Thread* const network_thread_;
+  const std::unique_ptr<Cipher> cipher_;
+  const size_t max_body_size_;
+  // Used if the settings have no event log, since GoogCC requires one.
+  const std::unique_ptr<RtcEventLog> owned_event_log_;
+
+  std::unique_ptr<NetworkControllerInterface> controller_
+      RTC_GUARDED_BY(network_thread_);
+  TimeDelta process_interval_ RTC_GUARDED_BY(network_thread_);
+  TransportFeedbackAdapter transport_feedback_adapter_;
+  RemoteEstimatorProxy remote_estimator_proxy_;
+  uint32_t next_packet_number_ RTC_GUARDED_BY(network_thread_) = 0;
+  MediaTransportState state_ RTC_GUARDED_BY(network_thread_) =
+      MediaTransportState::kPending;
+  media_datagram::VideoFrameAssembler video_frame_assembler_
+      RTC_GUARDED_BY(network_thread_);
+  // Decrypted body of the datagram being received.
+  rtc::Buffer receive_buffer_ RTC_GUARDED_BY(network_thread_);
+
+  rtc::CriticalSection sink_lock_;
+  MediaTransportAudioSinkInterface* audio_sink_ RTC_GUARDED_BY(sink_lock_) =
+      nullptr;
+  MediaTransportVideoSinkInterface* video_sink_ RTC_GUARDED_BY(sink_lock_) =
+      nullptr;
+  DataChannelSink* data_sink_ RTC_GUARDED_BY(sink_lock_) = nullptr;
+  MediaTransportKeyFrameRequestCallback* key_frame_callback_
+      RTC_GUARDED_BY(sink_lock_) = nullptr;
+  MediaTransportStateCallback* state_callback_ RTC_GUARDED_BY(sink_lock_) =
+      nullptr;
+  MediaTransportNetworkChangeCallback* network_change_callback_
+      RTC_GUARDED_BY(sink_lock_) = nullptr;
+  absl::optional<rtc::NetworkRoute> network_route_ RTC_GUARDED_BY(sink_lock_);
+  std::vector<TargetTransferRateObserver*> target_rate_observers_
+      RTC_GUARDED_BY(sink_lock_);
+  absl::optional<TargetTransferRate> latest_target_rate_
+      RTC_GUARDED_BY(sink_lock_);
+
+  rtc::AsyncInvoker invoker_;
+};
+
+// Creates DatagramMediaTransports, with |controller_factory| for congestion
+// control if set.
+class DatagramMediaTransportFactory : public MediaTransportFactory {
+ public:
+  explicit DatagramMediaTransportFactory(
+      NetworkControllerFactoryInterface* controller_factory = nullptr);
+  ~DatagramMediaTransportFactory() override;
+
+  RTCErrorOr<std::unique_ptr<MediaTransportInterface>> CreateMediaTransport(
+      rtc::PacketTransportInternal* packet_transport,
+      rtc::Thread* network_thread,
+      const MediaTransportSettings& settings) override;
+
+ private:
+  NetworkControllerFactoryInterface* const controller_factory_;
+};
+
+}  // namespace webrtc
+
+#endif  // PC_DATAGRAM_MEDIA_TRANSPORT_H_
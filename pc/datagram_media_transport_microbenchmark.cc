@@ -0,0 +1,268 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "p2p/base/fakepackettransport.h"
+#include "pc/datagram_media_transport.h"
+#include "pc/srtpsession.h"
+#include "pc/srtptestutil.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/sslstreamadapter.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+#include "test/testsupport/microbenchmark.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kVideoFrameSize = 8000;
+constexpr size_t kAudioFrameSize = 100;
+constexpr uint32_t kSsrc = 0x12345678;
+// Size of the generic video payload header, see rtp_format_video_generic.h.
+constexpr size_t kGenericHeaderSize = 1;
+// Auth tag of SRTP_AES128_CM_SHA1_80.
+constexpr size_t kSrtpAuthTagSize = 10;
+
+// Counts the packets arriving on a packet transport.
+class WireCounter : public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(rtc::PacketTransportInternal* transport,
+                    const char* data,
+                    size_t size,
+                    const int64_t& packet_time_us,
+                    int flags) {
+    bytes += size;
+  }
+  int64_t bytes = 0;
+};
+
+class FrameCounter : public MediaTransportAudioSinkInterface,
+                     public MediaTransportVideoSinkInterface {
+ public:
+  void OnData(uint64_t channel_id,
+              MediaTransportEncodedAudioFrame frame) override {
+    ++frames;
+  }
+  void OnData(uint64_t channel_id,
+              MediaTransportEncodedVideoFrame frame) override {
+    ++frames;
+  }
+  int64_t frames = 0;
+};
+
+void PrintBytesPerFrame(const std::string& trace,
+                        int64_t bytes,
+                        int64_t frames) {
+  ASSERT_GT(frames, 0);
+  test::PrintResult("bytes_on_wire_per_frame", "", trace,
+                    static_cast<double>(bytes) / frames, "bytes", false);
+}
+
+// Sends frames between two DatagramMediaTransports connected by fake packet
+// transports, on the current thread.
+class DatagramPath {
+ public:
+  DatagramPath()
+      : caller_packet_transport_("caller"), callee_packet_transport_("callee") {
+    const std::string key(DatagramMediaTransport::kKeySize, 'k');
+    MediaTransportSettings settings;
+    settings.pre_shared_key = key;
+    DatagramMediaTransportFactory factory;
+    settings.is_caller = true;
+    caller_ = factory
+                  .CreateMediaTransport(&caller_packet_transport_,
+                                        rtc::Thread::Current(), settings)
+                  .MoveValue();
+    settings.is_caller = false;
+    callee_ = factory
+                  .CreateMediaTransport(&callee_packet_transport_,
+                                        rtc::Thread::Current(), settings)
+                  .MoveValue();
+    caller_packet_transport_.SetDestination(&callee_packet_transport_, false);
+    callee_packet_transport_.SignalReadPacket.connect(
+        &wire_counter_, &WireCounter::OnReadPacket);
+    callee_->SetReceiveAudioSink(&frame_counter_);
+    callee_->SetReceiveVideoSink(&frame_counter_);
+  }
+
+  ~DatagramPath() {
+    callee_->SetReceiveAudioSink(nullptr);
+    callee_->SetReceiveVideoSink(nullptr);
+  }
+
+  MediaTransportInterface* caller() { return caller_.get(); }
+  int64_t bytes() const { return wire_counter_.bytes; }
+  int64_t frames() const { return frame_counter_.frames; }
+
+ private:
+  rtc::FakePacketTransport caller_packet_transport_;
+  rtc::FakePacketTransport callee_packet_transport_;
+  std::unique_ptr<MediaTransportInterface> caller_;
+  std::unique_ptr<MediaTransportInterface> callee_;
+  WireCounter wire_counter_;
+  FrameCounter frame_counter_;
+};
+
+// Sends frames as SRTP protected RTP packets with a transport sequence number,
+// the way the RTP path does, and depacketizes them again. Packets are no
+// larger than the datagrams of DatagramMediaTransport.
+class RtpPath {
+ public:
+  RtpPath() {
+    extensions_.Register<TransportSequenceNumber>(1);
+    RTC_CHECK(send_session_.SetSend(rtc::SRTP_AES128_CM_SHA1_80,
+                                    rtc::kTestKey1, rtc::kTestKeyLen,
+                                    std::vector<int>()));
+    RTC_CHECK(receive_session_.SetRecv(rtc::SRTP_AES128_CM_SHA1_80,
+                                       rtc::kTestKey1, rtc::kTestKeyLen,
+                                       std::vector<int>()));
+  }
+
+  // Sends |frame| in as many packets as needed, with |header_size| bytes of
+  // payload header in each.
+  void SendFrame(const std::vector<uint8_t>& frame, size_t header_size) {
+    received_frame_.clear();
+    size_t offset = 0;
+    do {
+      RtpPacketToSend packet(&extensions_,
+                             DatagramMediaTransport::kMaxDatagramSize);
+      packet.SetPayloadType(96);
+      packet.SetSequenceNumber(sequence_number_++);
+      packet.SetTimestamp(timestamp_);
+      packet.SetSsrc(kSsrc);
+      packet.SetExtension<TransportSequenceNumber>(
+          transport_sequence_number_++);
+      const size_t fragment_size =
+          std::min(frame.size() - offset, packet.MaxPayloadSize() -
+                                              kSrtpAuthTagSize - header_size);
+      uint8_t* payload = packet.AllocatePayload(header_size + fragment_size);
+      memset(payload, 0, header_size);
+      memcpy(payload + header_size, frame.data() + offset, fragment_size);
+      offset += fragment_size;
+      packet.SetMarker(offset == frame.size());
+
+      rtc::CopyOnWriteBuffer buffer(packet.data(), packet.size(),
+                                    packet.size() + kSrtpAuthTagSize);
+      int length = 0;
+      RTC_CHECK(send_session_.ProtectRtp(buffer.data(),
+                                         static_cast<int>(buffer.size()),
+                                         static_cast<int>(buffer.capacity()),
+                                         &length));
+      buffer.SetSize(length);
+      bytes_ += length;
+      Receive(&buffer, header_size);
+    } while (offset < frame.size());
+    timestamp_ += 3000;
+    if (received_frame_.size() == frame.size())
+      ++frames_;
+  }
+
+  int64_t bytes() const { return bytes_; }
+  int64_t frames() const { return frames_; }
+
+ private:
+  void Receive(rtc::CopyOnWriteBuffer* buffer, size_t header_size) {
+    int length = 0;
+    RTC_CHECK(receive_session_.UnprotectRtp(
+        buffer->data(), static_cast<int>(buffer->size()), &length));
+    buffer->SetSize(length);
+    RtpPacketReceived packet(&extensions_);
+    RTC_CHECK(packet.Parse(*buffer));
+    uint16_t transport_sequence_number;
+    RTC_CHECK(packet.GetExtension<TransportSequenceNumber>(
+        &transport_sequence_number));
+    rtc::ArrayView<const uint8_t> payload = packet.payload();
+    received_frame_.insert(received_frame_.end(),
+                           payload.begin() + header_size, payload.end());
+  }
+
+  RtpHeaderExtensionMap extensions_;
+  cricket::SrtpSession send_session_;
+  cricket::SrtpSession receive_session_;
+  uint16_t sequence_number_ = 0;
+  uint16_t transport_sequence_number_ = 0;
+  uint32_t timestamp_ = 0;
+  std::vector<uint8_t> received_frame_;
+  int64_t bytes_ = 0;
+  int64_t frames_ = 0;
+};
+
+}  // namespace
+
+TEST(DatagramMediaTransportMicrobenchmark, SendVideoFrame) {
+  std::vector<uint8_t> payload(kVideoFrameSize, 0xab);
+  EncodedImage image(payload.data(), payload.size(), payload.size());
+  image._frameType = kVideoFrameDelta;
+
+  DatagramPath datagram_path;
+  int64_t frame_id = 0;
+  test::RunMicrobenchmark("DatagramMediaTransport_SendVideoFrame", [&] {
+    image.SetTimestamp(static_cast<uint32_t>(frame_id * 3000));
+    datagram_path.caller()->SendVideoFrame(
+        1, MediaTransportEncodedVideoFrame(frame_id, {frame_id - 1}, 96,
+                                           image));
+    ++frame_id;
+  });
+  EXPECT_EQ(frame_id, datagram_path.frames());
+  PrintBytesPerFrame("DatagramMediaTransport_VideoFrame",
+                     datagram_path.bytes(), datagram_path.frames());
+
+  RtpPath rtp_path;
+  int64_t num_rtp_frames = 0;
+  test::RunMicrobenchmark("SrtpRtp_SendVideoFrame", [&] {
+    rtp_path.SendFrame(payload, kGenericHeaderSize);
+    ++num_rtp_frames;
+  });
+  EXPECT_EQ(num_rtp_frames, rtp_path.frames());
+  PrintBytesPerFrame("SrtpRtp_VideoFrame", rtp_path.bytes(),
+                     rtp_path.frames());
+}
+
+TEST(DatagramMediaTransportMicrobenchmark, SendAudioFrame) {
+  const std::vector<uint8_t> payload(kAudioFrameSize, 0xab);
+
+  DatagramPath datagram_path;
+  int sequence_number = 0;
+  test::RunMicrobenchmark("DatagramMediaTransport_SendAudioFrame", [&] {
+    datagram_path.caller()->SendAudioFrame(
+        1, MediaTransportEncodedAudioFrame(
+               48000, sequence_number * 960, 960, sequence_number,
+               MediaTransportEncodedAudioFrame::FrameType::kSpeech, 111,
+               payload));
+    ++sequence_number;
+  });
+  EXPECT_EQ(sequence_number, datagram_path.frames());
+  PrintBytesPerFrame("DatagramMediaTransport_AudioFrame",
+                     datagram_path.bytes(), datagram_path.frames());
+
+  RtpPath rtp_path;
+  int64_t num_rtp_frames = 0;
+  test::RunMicrobenchmark("SrtpRtp_SendAudioFrame", [&] {
+    rtp_path.SendFrame(payload, 0);
+    ++num_rtp_frames;
+  });
+  EXPECT_EQ(num_rtp_frames, rtp_path.frames());
+  PrintBytesPerFrame("SrtpRtp_AudioFrame", rtp_path.bytes(),
+                     rtp_path.frames());
+}
+
+}  // namespace webrtc
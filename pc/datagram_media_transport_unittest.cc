@@ -0,0 +1,280 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/datagram_media_transport.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "p2p/base/fakepackettransport.h"
+#include "rtc_base/gunit.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::_;
+
+constexpr int kTimeoutMs = 1000;
+
+class MockAudioSink : public MediaTransportAudioSinkInterface {
+ public:
+  MOCK_METHOD2(OnData, void(uint64_t, MediaTransportEncodedAudioFrame));
+};
+
+class MockVideoSink : public MediaTransportVideoSinkInterface {
+ public:
+  MOCK_METHOD2(OnData, void(uint64_t, MediaTransportEncodedVideoFrame));
+};
+
+class MockKeyFrameRequestCallback
+    : public MediaTransportKeyFrameRequestCallback {
+ public:
+  MOCK_METHOD1(OnKeyFrameRequested, void(uint64_t));
+};
+
+class MockDataChannelSink : public DataChannelSink {
+ public:
+  MOCK_METHOD3(OnDataReceived,
+               void(int, DataMessageType, const rtc::CopyOnWriteBuffer&));
+  MOCK_METHOD1(OnChannelClosing, void(int));
+  MOCK_METHOD1(OnChannelClosed, void(int));
+};
+
+class StateRecorder : public MediaTransportStateCallback {
+ public:
+  void OnStateChanged(MediaTransportState state) override {
+    states.push_back(state);
+  }
+  std::vector<MediaTransportState> states;
+};
+
+class TargetRateRecorder : public TargetTransferRateObserver {
+ public:
+  void OnTargetTransferRate(TargetTransferRate target_rate) override {
+    ++num_updates;
+  }
+  int num_updates = 0;
+};
+
+MediaTransportSettings MakeSettings(bool is_caller, const std::string& key) {
+  MediaTransportSettings settings;
+  settings.is_caller = is_caller;
+  settings.pre_shared_key = key;
+  return settings;
+}
+
+std::vector<uint8_t> MakePayload(size_t size) {
+  std::vector<uint8_t> payload(size);
+  for (size_t i = 0; i < size; ++i)
+    payload[i] = static_cast<uint8_t>(i * 13);
+  return payload;
+}
+
+}  // namespace
+
+class DatagramMediaTransportTest : public ::testing::Test {
+ protected:
+  DatagramMediaTransportTest()
+      : caller_packet_transport_("caller"),
+        callee_packet_transport_("callee") {}
+
+  void CreateTransports(const std::string& caller_key,
+                        const std::string& callee_key) {
+    DatagramMediaTransportFactory factory;
+    caller_ = factory
+                  .CreateMediaTransport(&caller_packet_transport_,
+                                        rtc::Thread::Current(),
+                                        MakeSettings(true, caller_key))
+                  .MoveValue();
+    callee_ = factory
+                  .CreateMediaTransport(&callee_packet_transport_,
+                                        rtc::Thread::Current(),
+                                        MakeSettings(false, callee_key))
+                  .MoveValue();
+  }
+
+  void Connect() {
+    caller_packet_transport_.SetDestination(&callee_packet_transport_, false);
+  }
+
+  const std::string kKey = std::string(DatagramMediaTransport::kKeySize, 'k');
+
+  rtc::FakePacketTransport caller_packet_transport_;
+  rtc::FakePacketTransport callee_packet_transport_;
+  std::unique_ptr<MediaTransportInterface> caller_;
+  std::unique_ptr<MediaTransportInterface> callee_;
+};
+
+TEST_F(DatagramMediaTransportTest, RejectsInvalidKey) {
+  DatagramMediaTransportFactory factory;
+  EXPECT_FALSE(factory
+                   .CreateMediaTransport(&caller_packet_transport_,
+                                         rtc::Thread::Current(),
+                                         MakeSettings(true, "short key"))
+                   .ok());
+}
+
+TEST_F(DatagramMediaTransportTest, SendsAudioFrame) {
+  CreateTransports(kKey, kKey);
+  Connect();
+  NiceMock<MockAudioSink> sink;
+  callee_->SetReceiveAudioSink(&sink);
+
+  const std::vector<uint8_t> payload = MakePayload(80);
+  EXPECT_CALL(sink, OnData(4, _))
+      .WillOnce(Invoke([&](uint64_t, MediaTransportEncodedAudioFrame frame) {
+        EXPECT_EQ(48000, frame.sampling_rate_hz());
+        EXPECT_EQ(480, frame.starting_sample_index());
+        EXPECT_EQ(480, frame.samples_per_channel());
+        EXPECT_EQ(1, frame.sequence_number());
+        EXPECT_EQ(111, frame.payload_type());
+        EXPECT_THAT(frame.encoded_data(), ElementsAreArray(payload));
+      }));
+  MediaTransportEncodedAudioFrame frame(
+      48000, 480, 480, 1, MediaTransportEncodedAudioFrame::FrameType::kSpeech,
+      111, payload);
+  ASSERT_TRUE(caller_->SendAudioFrame(4, frame).ok());
+
+  // Nothing is readable on the wire.
+  const rtc::CopyOnWriteBuffer* datagram =
+      caller_packet_transport_.last_sent_packet();
+  EXPECT_LE(datagram->size(), media_datagram::kHeaderSize +
+                                 media_datagram::kMaxAudioFrameOverhead +
+                                 payload.size() +
+                                 DatagramMediaTransport::kTagSize);
+  EXPECT_EQ(std::string::npos,
+            std::string(datagram->data<char>(), datagram->size())
+                .find(std::string(payload.begin(), payload.begin() + 8)));
+  callee_->SetReceiveAudioSink(nullptr);
+}
+
+TEST_F(DatagramMediaTransportTest, SendsLargeVideoFrame) {
+  CreateTransports(kKey, kKey);
+  Connect();
+  NiceMock<MockVideoSink> sink;
+  callee_->SetReceiveVideoSink(&sink);
+
+  std::vector<uint8_t> payload = MakePayload(20000);
+  EncodedImage image(payload.data(), payload.size(), payload.size());
+  image._frameType = kVideoFrameKey;
+  image.SetTimestamp(3000);
+  EXPECT_CALL(sink, OnData(2, _))
+      .WillOnce(Invoke([&](uint64_t, MediaTransportEncodedVideoFrame frame) {
+        EXPECT_EQ(10, frame.frame_id());
+        EXPECT_THAT(frame.referenced_frame_ids(), ElementsAre(9));
+        EXPECT_EQ(kVideoFrameKey, frame.encoded_image()._frameType);
+        EXPECT_EQ(3000u, frame.encoded_image().Timestamp());
+        EXPECT_THAT(rtc::ArrayView<const uint8_t>(
+                        frame.encoded_image()._buffer,
+                        frame.encoded_image().size()),
+                    ElementsAreArray(payload));
+      }));
+  ASSERT_TRUE(
+      caller_
+          ->SendVideoFrame(2, MediaTransportEncodedVideoFrame(10, {9}, 96,
+                                                              image))
+          .ok());
+  EXPECT_LE(caller_packet_transport_.last_sent_packet()->size(),
+            DatagramMediaTransport::kMaxDatagramSize);
+  callee_->SetReceiveVideoSink(nullptr);
+}
+
+TEST_F(DatagramMediaTransportTest, SendsKeyFrameRequest) {
+  CreateTransports(kKey, kKey);
+  Connect();
+  MockKeyFrameRequestCallback callback;
+  caller_->SetKeyFrameRequestCallback(&callback);
+  EXPECT_CALL(callback, OnKeyFrameRequested(3));
+  ASSERT_TRUE(callee_->RequestKeyFrame(3).ok());
+  caller_->SetKeyFrameRequestCallback(nullptr);
+}
+
+TEST_F(DatagramMediaTransportTest, SendsDataAndClosesChannel) {
+  CreateTransports(kKey, kKey);
+  Connect();
+  MockDataChannelSink caller_sink;
+  MockDataChannelSink callee_sink;
+  caller_->SetDataSink(&caller_sink);
+  callee_->SetDataSink(&callee_sink);
+
+  const rtc::CopyOnWriteBuffer message("message", 7);
+  EXPECT_CALL(callee_sink,
+              OnDataReceived(5, DataMessageType::kBinary, message));
+  SendDataParams params;
+  params.type = DataMessageType::kBinary;
+  ASSERT_TRUE(caller_->SendData(5, params, message).ok());
+
+  EXPECT_CALL(callee_sink, OnChannelClosing(5));
+  EXPECT_CALL(callee_sink, OnChannelClosed(5));
+  EXPECT_CALL(caller_sink, OnChannelClosed(5));
+  ASSERT_TRUE(caller_->CloseChannel(5).ok());
+  rtc::Thread::Current()->ProcessMessages(0);
+
+  caller_->SetDataSink(nullptr);
+  callee_->SetDataSink(nullptr);
+}
+
+TEST_F(DatagramMediaTransportTest, FollowsWritableState) {
+  CreateTransports(kKey, kKey);
+  StateRecorder states;
+  caller_->SetMediaTransportStateCallback(&states);
+  EXPECT_EQ_WAIT(1u, states.states.size(), kTimeoutMs);
+
+  Connect();
+  caller_packet_transport_.SetDestination(nullptr, false);
+  EXPECT_THAT(states.states,
+              ElementsAre(MediaTransportState::kPending,
+                          MediaTransportState::kWritable,
+                          MediaTransportState::kPending));
+  caller_->SetMediaTransportStateCallback(nullptr);
+}
+
+TEST_F(DatagramMediaTransportTest, DropsDatagramsWithWrongKey) {
+  CreateTransports(kKey, std::string(DatagramMediaTransport::kKeySize, 'x'));
+  Connect();
+  MockKeyFrameRequestCallback callback;
+  caller_->SetKeyFrameRequestCallback(&callback);
+  EXPECT_CALL(callback, OnKeyFrameRequested(_)).Times(0);
+  ASSERT_TRUE(callee_->RequestKeyFrame(3).ok());
+  caller_->SetKeyFrameRequestCallback(nullptr);
+}
+
+TEST_F(DatagramMediaTransportTest, ReportsTargetRate) {
+  CreateTransports(kKey, kKey);
+  TargetRateRecorder observer;
+  caller_->AddTargetTransferRateObserver(&observer);
+  Connect();
+
+  NiceMock<MockAudioSink> sink;
+  callee_->SetReceiveAudioSink(&sink);
+  const std::vector<uint8_t> payload = MakePayload(100);
+  for (int i = 0; i < 20; ++i) {
+    caller_->SendAudioFrame(
+        1, MediaTransportEncodedAudioFrame(
+               48000, i * 480, 480, i,
+               MediaTransportEncodedAudioFrame::FrameType::kSpeech, 111,
+               payload));
+    rtc::Thread::Current()->ProcessMessages(10);
+  }
+  EXPECT_TRUE_WAIT(observer.num_updates > 0, kTimeoutMs);
+  EXPECT_TRUE(caller_->GetLatestTargetTransferRate());
+
+  callee_->SetReceiveAudioSink(nullptr);
+  caller_->RemoveTargetTransferRateObserver(&observer);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,305 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/media_datagram.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace media_datagram {
+
+namespace {
+
+constexpr uint8_t kTypeMarker = 0xe0;
+constexpr uint8_t kTypeMask = 0x1f;
+constexpr uint8_t kMaxType = static_cast<uint8_t>(Type::kFeedback);
+
+// Flags of the first video fragment.
+constexpr uint8_t kKeyFrameFlag = 0x01;
+constexpr uint8_t kRotationShift = 1;
+constexpr uint8_t kRotationMask = 0x06;
+
+// Maximum size of a video frame accepted from the network.
+constexpr uint64_t kMaxVideoFrameSize = 16 * 1024 * 1024;
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+uint8_t RotationToWire(VideoRotation rotation) {
+  return static_cast<uint8_t>(rotation / 90);
+}
+
+VideoRotation RotationFromWire(uint8_t value) {
+  switch (value) {
+    case 1:
+      return kVideoRotation_90;
+    case 2:
+      return kVideoRotation_180;
+    case 3:
+      return kVideoRotation_270;
+    default:
+      return kVideoRotation_0;
+  }
+}
+
+void WriteData(rtc::ArrayView<const uint8_t> data,
+               rtc::ByteBufferWriter* writer) {
+  writer->WriteBytes(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+}  // namespace
+
+void WriteHeader(const Header& header, rtc::ByteBufferWriter* writer) {
+  writer->WriteUInt8(kTypeMarker | static_cast<uint8_t>(header.type));
+  writer->WriteUInt32(header.packet_number);
+}
+
+bool ReadHeader(rtc::ArrayView<const uint8_t> datagram, Header* header) {
+  if (datagram.size() < kHeaderSize)
+    return false;
+  if ((datagram[0] & ~kTypeMask) != kTypeMarker)
+    return false;
+  const uint8_t type = datagram[0] & kTypeMask;
+  if (type > kMaxType)
+    return false;
+  header->type = static_cast<Type>(type);
+  header->packet_number = (datagram[1] << 24) | (datagram[2] << 16) |
+                          (datagram[3] << 8) | datagram[4];
+  return true;
+}
+
+void WriteAudioFrame(uint64_t channel_id,
+                     const MediaTransportEncodedAudioFrame& frame,
+                     rtc::ByteBufferWriter* writer) {
+  writer->WriteUVarint(channel_id);
+  writer->WriteUInt8(static_cast<uint8_t>(frame.payload_type()));
+  writer->WriteUInt8(
+      frame.frame_type() ==
+              MediaTransportEncodedAudioFrame::FrameType::kSpeech
+          ? 0
+          : 1);
+  writer->WriteUVarint(frame.sampling_rate_hz());
+  writer->WriteUInt32(static_cast<uint32_t>(frame.starting_sample_index()));
+  writer->WriteUVarint(frame.samples_per_channel());
+  writer->WriteUInt16(static_cast<uint16_t>(frame.sequence_number()));
+  WriteData(frame.encoded_data(), writer);
+}
+
+bool ReadAudioFrame(rtc::ByteBufferReader* reader,
+                    uint64_t* channel_id,
+                    absl::optional<MediaTransportEncodedAudioFrame>* frame) {
+  uint8_t payload_type;
+  uint8_t frame_type;
+  uint64_t sampling_rate_hz;
+  uint32_t starting_sample_index;
+  uint64_t samples_per_channel;
+  uint16_t sequence_number;
+  if (!reader->ReadUVarint(channel_id) || !reader->ReadUInt8(&payload_type) ||
+      !reader->ReadUInt8(&frame_type) ||
+      !reader->ReadUVarint(&sampling_rate_hz) ||
+      !reader->ReadUInt32(&starting_sample_index) ||
+      !reader->ReadUVarint(&samples_per_channel) ||
+      !reader->ReadUInt16(&sequence_number)) {
+    return false;
+  }
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(reader->Data());
+  frame->emplace(
+      static_cast<int>(sampling_rate_hz),
+      static_cast<int>(starting_sample_index),
+      static_cast<int>(samples_per_channel), sequence_number,
+      frame_type == 0
+          ? MediaTransportEncodedAudioFrame::FrameType::kSpeech
+          : MediaTransportEncodedAudioFrame::FrameType::
+                kDiscontinuousTransmission,
+      payload_type, std::vector<uint8_t>(data, data + reader->Length()));
+  return true;
+}
+
+size_t WriteVideoFragment(uint64_t channel_id,
+                          const MediaTransportEncodedVideoFrame& frame,
+                          size_t offset,
+                          size_t max_body_size,
+                          rtc::ByteBufferWriter* writer) {
+  RTC_DCHECK_GT(max_body_size, kMaxVideoFragmentOverhead);
+  RTC_DCHECK_LE(frame.referenced_frame_ids().size(), kMaxReferencedFrames);
+  const EncodedImage& image = frame.encoded_image();
+  const size_t start_length = writer->Length();
+  writer->WriteUVarint(channel_id);
+  writer->WriteUVarint(ZigZagEncode(frame.frame_id()));
+  writer->WriteUVarint(image.size());
+  writer->WriteUVarint(offset);
+  if (offset == 0) {
+    writer->WriteUInt8(static_cast<uint8_t>(frame.payload_type()));
+    writer->WriteUInt8(
+        (image._frameType == kVideoFrameKey ? kKeyFrameFlag : 0) |
+        (RotationToWire(image.rotation_) << kRotationShift));
+    writer->WriteUInt32(image.Timestamp());
+    writer->WriteUVarint(ZigZagEncode(image.capture_time_ms_));
+    writer->WriteUVarint(image._encodedWidth);
+    writer->WriteUVarint(image._encodedHeight);
+    writer->WriteUInt8(static_cast<uint8_t>(image.content_type_));
+    writer->WriteUInt8(
+        static_cast<uint8_t>(frame.referenced_frame_ids().size()));
+    for (int64_t referenced_frame_id : frame.referenced_frame_ids()) {
+      writer->WriteUVarint(
+          ZigZagEncode(frame.frame_id() - referenced_frame_id));
+    }
+  }
+  const size_t fragment_size =
+      std::min(image.size() - offset,
+               max_body_size - (writer->Length() - start_length));
+  WriteData(rtc::ArrayView<const uint8_t>(image._buffer + offset,
+                                          fragment_size),
+            writer);
+  return offset + fragment_size;
+}
+
+void WriteChannelId(uint64_t channel_id, rtc::ByteBufferWriter* writer) {
+  writer->WriteUVarint(channel_id);
+}
+
+bool ReadChannelId(rtc::ByteBufferReader* reader, uint64_t* channel_id) {
+  return reader->ReadUVarint(channel_id);
+}
+
+void WriteDataMessage(int channel_id,
+                      DataMessageType type,
+                      const rtc::CopyOnWriteBuffer& data,
+                      rtc::ByteBufferWriter* writer) {
+  writer->WriteUVarint(static_cast<uint32_t>(channel_id));
+  writer->WriteUInt8(static_cast<uint8_t>(type));
+  WriteData(rtc::ArrayView<const uint8_t>(data.cdata(), data.size()), writer);
+}
+
+bool ReadDataMessage(rtc::ByteBufferReader* reader,
+                     int* channel_id,
+                     DataMessageType* type,
+                     rtc::CopyOnWriteBuffer* data) {
+  uint64_t id;
+  uint8_t message_type;
+  if (!reader->ReadUVarint(&id) || !reader->ReadUInt8(&message_type) ||
+      message_type > static_cast<uint8_t>(DataMessageType::kControl)) {
+    return false;
+  }
+  *channel_id = static_cast<int>(id);
+  *type = static_cast<DataMessageType>(message_type);
+  data->SetData(reader->Data(), reader->Length());
+  return true;
+}
+
+VideoFrameAssembler::PartialFrame::PartialFrame() = default;
+VideoFrameAssembler::PartialFrame::~PartialFrame() = default;
+
+VideoFrameAssembler::VideoFrameAssembler() = default;
+VideoFrameAssembler::~VideoFrameAssembler() = default;
+
+bool VideoFrameAssembler::InsertFragment(
+    rtc::ByteBufferReader* reader,
+    uint64_t* channel_id,
+    absl::optional<MediaTransportEncodedVideoFrame>* frame) {
+  uint64_t frame_id;
+  uint64_t frame_size;
+  uint64_t offset;
+  if (!reader->ReadUVarint(channel_id) || !reader->ReadUVarint(&frame_id) ||
+      !reader->ReadUVarint(&frame_size) || !reader->ReadUVarint(&offset) ||
+      frame_size > kMaxVideoFrameSize || offset > frame_size) {
+    return false;
+  }
+  const FrameKey key(*channel_id, ZigZagDecode(frame_id));
+  auto it = partial_frames_.find(key);
+  if (it == partial_frames_.end()) {
+    if (partial_frames_.size() == kMaxPartialFrames) {
+      partial_frames_.erase(arrival_order_.front());
+      arrival_order_.pop_front();
+    }
+    it = partial_frames_.emplace(key, PartialFrame()).first;
+    it->second.data.resize(frame_size);
+    arrival_order_.push_back(key);
+  }
+  PartialFrame& partial = it->second;
+  if (partial.data.size() != frame_size)
+    return false;
+
+  if (offset == 0) {
+    uint8_t payload_type;
+    uint8_t flags;
+    uint32_t rtp_timestamp;
+    uint64_t capture_time_ms;
+    uint64_t width;
+    uint64_t height;
+    uint8_t content_type;
+    uint8_t num_references;
+    if (!reader->ReadUInt8(&payload_type) || !reader->ReadUInt8(&flags) ||
+        !reader->ReadUInt32(&rtp_timestamp) ||
+        !reader->ReadUVarint(&capture_time_ms) ||
+        !reader->ReadUVarint(&width) || !reader->ReadUVarint(&height) ||
+        !reader->ReadUInt8(&content_type) ||
+        !reader->ReadUInt8(&num_references) ||
+        num_references > kMaxReferencedFrames) {
+      return false;
+    }
+    std::vector<int64_t> referenced_frame_ids;
+    for (uint8_t i = 0; i < num_references; ++i) {
+      uint64_t delta;
+      if (!reader->ReadUVarint(&delta))
+        return false;
+      referenced_frame_ids.push_back(key.second - ZigZagDecode(delta));
+    }
+    partial.has_metadata = true;
+    partial.payload_type = payload_type;
+    partial.referenced_frame_ids = std::move(referenced_frame_ids);
+    EncodedImage& image = partial.encoded_image;
+    image._frameType =
+        (flags & kKeyFrameFlag) ? kVideoFrameKey : kVideoFrameDelta;
+    image.rotation_ =
+        RotationFromWire((flags & kRotationMask) >> kRotationShift);
+    image.SetTimestamp(rtp_timestamp);
+    image.capture_time_ms_ = ZigZagDecode(capture_time_ms);
+    image._encodedWidth = static_cast<uint32_t>(width);
+    image._encodedHeight = static_cast<uint32_t>(height);
+    image.content_type_ = static_cast<VideoContentType>(content_type);
+    image._completeFrame = true;
+  }
+
+  const size_t fragment_size = reader->Length();
+  if (fragment_size > frame_size - offset)
+    return false;
+  if (partial.fragment_offsets.insert(offset).second && fragment_size > 0) {
+    memcpy(partial.data.data() + offset, reader->Data(), fragment_size);
+    partial.received_bytes += fragment_size;
+  }
+  if (!partial.has_metadata || partial.received_bytes < frame_size)
+    return true;
+
+  EncodedImage image = partial.encoded_image;
+  image.set_buffer(partial.data.data(), partial.data.size());
+  image.set_size(partial.data.size());
+  frame->emplace(key.second, std::move(partial.referenced_frame_ids),
+                 partial.payload_type, image);
+  // The frame copies the data, since the buffer is released below.
+  (*frame)->Retain();
+  partial_frames_.erase(it);
+  arrival_order_.erase(
+      std::find(arrival_order_.begin(), arrival_order_.end(), key));
+  return true;
+}
+
+}  // namespace media_datagram
+}  // namespace webrtc
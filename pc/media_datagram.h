@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_MEDIA_DATAGRAM_H_
+#define PC_MEDIA_DATAGRAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/media_transport_interface.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/copyonwritebuffer.h"
+
+namespace webrtc {
+
+// Wire format of DatagramMediaTransport. Every datagram starts with
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |1 1 1|  type   |                 packet number                 |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |    (cont.)    |  body ...
+//   +-+-+-+-+-+-+-+-+
+//
+// The first byte is in the 224-255 range, which RFC 7983 leaves unused by
+// STUN, DTLS, TURN and RTP, so that the datagrams can share an ICE transport
+// with them. The packet number is incremented for every datagram sent. It is
+// both the nonce of the AEAD that protects the body and the transport wide
+// sequence number for congestion control feedback.
+//
+// Unlike RTP, media is framed once per frame rather than once per packet:
+// an audio frame is a single datagram, and a video frame is split into
+// fragments of which only the first carries the frame metadata.
+namespace media_datagram {
+
+enum class Type : uint8_t {
+  kAudio = 0,
+  kVideo = 1,
+  kKeyFrameRequest = 2,
+  kData = 3,
+  kDataChannelClose = 4,
+  kFeedback = 5,
+};
+
+constexpr size_t kHeaderSize = 5;
+// Upper bound of the body bytes that precede the payload of an audio frame,
+// for channel ids below 2^14.
+constexpr size_t kMaxAudioFrameOverhead = 16;
+// Same limit as for the frames of the jitter buffer.
+constexpr size_t kMaxReferencedFrames = 5;
+// Upper bound of the body bytes that precede the payload of a video fragment.
+constexpr size_t kMaxVideoFragmentOverhead = 70 + 10 * kMaxReferencedFrames;
+
+struct Header {
+  Type type;
+  uint32_t packet_number;
+};
+
+void WriteHeader(const Header& header, rtc::ByteBufferWriter* writer);
+// Returns false if |datagram| is not a media datagram.
+bool ReadHeader(rtc::ArrayView<const uint8_t> datagram, Header* header);
+
+void WriteAudioFrame(uint64_t channel_id,
+                     const MediaTransportEncodedAudioFrame& frame,
+                     rtc::ByteBufferWriter* writer);
+bool ReadAudioFrame(rtc::ByteBufferReader* reader,
+                    uint64_t* channel_id,
+                    absl::optional<MediaTransportEncodedAudioFrame>* frame);
+
+// Writes the fragment of |frame| that starts at |offset|, using at most
+// |max_body_size| bytes, and returns the offset of the next fragment. The
+// frame is complete once the returned offset equals its size.
+size_t WriteVideoFragment(uint64_t channel_id,
+                          const MediaTransportEncodedVideoFrame& frame,
+                          size_t offset,
+                          size_t max_body_size,
+                          rtc::ByteBufferWriter* writer);
+
+// Used for key frame requests and for closing data channels.
+void WriteChannelId(uint64_t channel_id, rtc::ByteBufferWriter* writer);
+bool ReadChannelId(rtc::ByteBufferReader* reader, uint64_t* channel_id);
+
+void WriteDataMessage(int channel_id,
+                      DataMessageType type,
+                      const rtc::CopyOnWriteBuffer& data,
+                      rtc::ByteBufferWriter* writer);
+bool ReadDataMessage(rtc::ByteBufferReader* reader,
+                     int* channel_id,
+                     DataMessageType* type,
+                     rtc::CopyOnWriteBuffer* data);
+
+// Reassembles video frames from their fragments. Fragments may arrive in any
+// order. Incomplete frames are dropped once |kMaxPartialFrames| newer ones
+// are in progress.
+class VideoFrameAssembler {
+ public:
+  static constexpr size_t kMaxPartialFrames = 16;
+
+  VideoFrameAssembler();
+  ~VideoFrameAssembler();
+
+  // Returns false if the fragment is malformed. Sets |frame| when the
+  // fragment completes a frame.
+  bool InsertFragment(rtc::ByteBufferReader* reader,
+                      uint64_t* channel_id,
+                      absl::optional<MediaTransportEncodedVideoFrame>* frame);
+
+ private:
+  struct PartialFrame {
+    PartialFrame();
+    ~PartialFrame();
+
+    std::vector<uint8_t> data;
+    // Offsets of the fragments received so far, to ignore duplicates.
+    std::set<size_t> fragment_offsets;
+    size_t received_bytes = 0;
+    // Set by the first fragment.
+    bool has_metadata = false;
+    int payload_type = 0;
+    EncodedImage encoded_image;
+    std::vector<int64_t> referenced_frame_ids;
+  };
+  using FrameKey = std::pair<uint64_t, int64_t>;
+
+  std::map<FrameKey, PartialFrame> partial_frames_;
+  // Keys of |partial_frames_| in order of their first fragment.
+  std::deque<FrameKey> arrival_order_;
+};
+
+}  // namespace media_datagram
+}  // namespace webrtc
+
+#endif  // PC_MEDIA_DATAGRAM_H_
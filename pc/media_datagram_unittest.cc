@@ -0,0 +1,224 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/media_datagram.h"
+
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace media_datagram {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+constexpr size_t kMaxBodySize = 300;
+
+rtc::ArrayView<const uint8_t> View(const rtc::ByteBufferWriter& writer) {
+  return rtc::ArrayView<const uint8_t>(
+      reinterpret_cast<const uint8_t*>(writer.Data()), writer.Length());
+}
+
+std::vector<uint8_t> MakePayload(size_t size) {
+  std::vector<uint8_t> payload(size);
+  for (size_t i = 0; i < size; ++i)
+    payload[i] = static_cast<uint8_t>(i * 7);
+  return payload;
+}
+
+// Splits |frame| into the bodies of its fragments.
+std::vector<std::vector<char>> Fragment(
+    uint64_t channel_id,
+    const MediaTransportEncodedVideoFrame& frame) {
+  std::vector<std::vector<char>> fragments;
+  size_t offset = 0;
+  do {
+    rtc::ByteBufferWriter writer;
+    offset = WriteVideoFragment(channel_id, frame, offset, kMaxBodySize,
+                                &writer);
+    EXPECT_LE(writer.Length(), kMaxBodySize);
+    fragments.emplace_back(writer.Data(), writer.Data() + writer.Length());
+  } while (offset < frame.encoded_image().size());
+  return fragments;
+}
+
+bool Insert(VideoFrameAssembler* assembler,
+            const std::vector<char>& fragment,
+            uint64_t* channel_id,
+            absl::optional<MediaTransportEncodedVideoFrame>* frame) {
+  rtc::ByteBufferReader reader(fragment.data(), fragment.size());
+  return assembler->InsertFragment(&reader, channel_id, frame);
+}
+
+}  // namespace
+
+TEST(MediaDatagramTest, ReadsHeader) {
+  rtc::ByteBufferWriter writer;
+  WriteHeader({Type::kVideo, 0x12345678}, &writer);
+  EXPECT_EQ(kHeaderSize, writer.Length());
+
+  Header header;
+  ASSERT_TRUE(ReadHeader(View(writer), &header));
+  EXPECT_EQ(Type::kVideo, header.type);
+  EXPECT_EQ(0x12345678u, header.packet_number);
+}
+
+TEST(MediaDatagramTest, RejectsOtherPackets) {
+  Header header;
+  // RTP.
+  const uint8_t rtp[] = {0x80, 0x60, 0x00, 0x01, 0x00};
+  EXPECT_FALSE(ReadHeader(rtp, &header));
+  // DTLS.
+  const uint8_t dtls[] = {0x17, 0xfe, 0xfd, 0x00, 0x00};
+  EXPECT_FALSE(ReadHeader(dtls, &header));
+  // Unknown type.
+  const uint8_t unknown[] = {0xff, 0x00, 0x00, 0x00, 0x00};
+  EXPECT_FALSE(ReadHeader(unknown, &header));
+  // Truncated.
+  const uint8_t truncated[] = {0xe0, 0x00};
+  EXPECT_FALSE(ReadHeader(truncated, &header));
+}
+
+TEST(MediaDatagramTest, AudioFrameRoundTrip) {
+  const std::vector<uint8_t> payload = MakePayload(60);
+  MediaTransportEncodedAudioFrame sent(
+      48000, 960 * 3, 960, 65535,
+      MediaTransportEncodedAudioFrame::FrameType::kDiscontinuousTransmission,
+      111, payload);
+  rtc::ByteBufferWriter writer;
+  WriteAudioFrame(3, sent, &writer);
+  EXPECT_LE(writer.Length(), payload.size() + kMaxAudioFrameOverhead);
+
+  rtc::ByteBufferReader reader(writer.Data(), writer.Length());
+  uint64_t channel_id;
+  absl::optional<MediaTransportEncodedAudioFrame> received;
+  ASSERT_TRUE(ReadAudioFrame(&reader, &channel_id, &received));
+  ASSERT_TRUE(received);
+  EXPECT_EQ(3u, channel_id);
+  EXPECT_EQ(48000, received->sampling_rate_hz());
+  EXPECT_EQ(960 * 3, received->starting_sample_index());
+  EXPECT_EQ(960, received->samples_per_channel());
+  EXPECT_EQ(65535, received->sequence_number());
+  EXPECT_EQ(
+      MediaTransportEncodedAudioFrame::FrameType::kDiscontinuousTransmission,
+      received->frame_type());
+  EXPECT_EQ(111, received->payload_type());
+  EXPECT_THAT(received->encoded_data(), ElementsAreArray(payload));
+}
+
+TEST(MediaDatagramTest, ReassemblesReorderedVideoFragments) {
+  std::vector<uint8_t> payload = MakePayload(1000);
+  EncodedImage image(payload.data(), payload.size(), payload.size());
+  image._frameType = kVideoFrameKey;
+  image.SetTimestamp(90000);
+  image.capture_time_ms_ = 1234;
+  image._encodedWidth = 640;
+  image._encodedHeight = 360;
+  image.rotation_ = kVideoRotation_270;
+  image.content_type_ = VideoContentType::SCREENSHARE;
+  MediaTransportEncodedVideoFrame sent(1000, {998, 999}, 100, image);
+
+  std::vector<std::vector<char>> fragments = Fragment(5, sent);
+  ASSERT_GT(fragments.size(), 3u);
+
+  VideoFrameAssembler assembler;
+  uint64_t channel_id;
+  absl::optional<MediaTransportEncodedVideoFrame> received;
+  // Last fragment first, and a duplicate.
+  ASSERT_TRUE(Insert(&assembler, fragments.back(), &channel_id, &received));
+  ASSERT_TRUE(Insert(&assembler, fragments.back(), &channel_id, &received));
+  for (size_t i = 0; i + 1 < fragments.size(); ++i) {
+    EXPECT_FALSE(received);
+    ASSERT_TRUE(Insert(&assembler, fragments[i], &channel_id, &received));
+  }
+  // The received frame owns its payload.
+  const std::vector<uint8_t> expected = payload;
+  payload.assign(payload.size(), 0);
+
+  ASSERT_TRUE(received);
+  EXPECT_EQ(5u, channel_id);
+  EXPECT_EQ(1000, received->frame_id());
+  EXPECT_THAT(received->referenced_frame_ids(), ElementsAre(998, 999));
+  EXPECT_EQ(100, received->payload_type());
+  const EncodedImage& received_image = received->encoded_image();
+  EXPECT_EQ(kVideoFrameKey, received_image._frameType);
+  EXPECT_EQ(90000u, received_image.Timestamp());
+  EXPECT_EQ(1234, received_image.capture_time_ms_);
+  EXPECT_EQ(640u, received_image._encodedWidth);
+  EXPECT_EQ(360u, received_image._encodedHeight);
+  EXPECT_EQ(kVideoRotation_270, received_image.rotation_);
+  EXPECT_EQ(VideoContentType::SCREENSHARE, received_image.content_type_);
+  EXPECT_THAT(rtc::ArrayView<const uint8_t>(received_image._buffer,
+                                            received_image.size()),
+              ElementsAreArray(expected));
+}
+
+TEST(MediaDatagramTest, DropsOldestIncompleteFrame) {
+  std::vector<uint8_t> payload = MakePayload(500);
+  EncodedImage image(payload.data(), payload.size(), payload.size());
+  VideoFrameAssembler assembler;
+  uint64_t channel_id;
+  absl::optional<MediaTransportEncodedVideoFrame> received;
+
+  std::vector<std::vector<char>> first_fragments =
+      Fragment(1, MediaTransportEncodedVideoFrame(0, {}, 100, image));
+  ASSERT_TRUE(
+      Insert(&assembler, first_fragments[0], &channel_id, &received));
+  for (int64_t frame_id = 1;
+       frame_id <= static_cast<int64_t>(VideoFrameAssembler::kMaxPartialFrames);
+       ++frame_id) {
+    std::vector<std::vector<char>> fragments =
+        Fragment(1, MediaTransportEncodedVideoFrame(frame_id, {}, 100, image));
+    ASSERT_TRUE(Insert(&assembler, fragments[0], &channel_id, &received));
+  }
+
+  // The first frame was dropped, so its remaining fragments start over.
+  for (size_t i = 1; i < first_fragments.size(); ++i) {
+    ASSERT_TRUE(
+        Insert(&assembler, first_fragments[i], &channel_id, &received));
+  }
+  EXPECT_FALSE(received);
+}
+
+TEST(MediaDatagramTest, RejectsTruncatedVideoFragment) {
+  std::vector<uint8_t> payload = MakePayload(100);
+  EncodedImage image(payload.data(), payload.size(), payload.size());
+  std::vector<std::vector<char>> fragments =
+      Fragment(1, MediaTransportEncodedVideoFrame(7, {6}, 100, image));
+  ASSERT_EQ(1u, fragments.size());
+
+  VideoFrameAssembler assembler;
+  uint64_t channel_id;
+  absl::optional<MediaTransportEncodedVideoFrame> received;
+  std::vector<char> truncated(fragments[0].begin(), fragments[0].begin() + 6);
+  EXPECT_FALSE(Insert(&assembler, truncated, &channel_id, &received));
+  EXPECT_FALSE(received);
+}
+
+TEST(MediaDatagramTest, DataMessageRoundTrip) {
+  rtc::ByteBufferWriter writer;
+  WriteDataMessage(9, DataMessageType::kBinary,
+                   rtc::CopyOnWriteBuffer("hello", 5), &writer);
+
+  rtc::ByteBufferReader reader(writer.Data(), writer.Length());
+  int channel_id;
+  DataMessageType type;
+  rtc::CopyOnWriteBuffer data;
+  ASSERT_TRUE(ReadDataMessage(&reader, &channel_id, &type, &data));
+  EXPECT_EQ(9, channel_id);
+  EXPECT_EQ(DataMessageType::kBinary, type);
+  EXPECT_EQ(rtc::CopyOnWriteBuffer("hello", 5), data);
+}
+
+}  // namespace media_datagram
+}  // namespace webrtc
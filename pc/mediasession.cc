@@ -11,6 +11,7 @@
 #include "pc/mediasession.h"
 
 #include <algorithm>  // For std::find_if, std::sort.
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
@@ -1412,6 +1413,59 @@ MediaSessionDescriptionFactory::video_rtp_header_extensions() const {
   return extensions;
 }
 
+template <class C>
+class MediaSessionDescriptionFactory::OfferedCodecsCache {
+ public:
+  // |offer_codecs| are all the codecs of the offer, with their payload types.
+  explicit OfferedCodecsCache(const std::vector<C>& offer_codecs)
+      : offer_codecs_(offer_codecs) {}
+
+  // Returns the codecs of |current_codecs| that are still offered, followed
+  // by the other codecs of |supported_codecs| that are offered. Media sections
+  // mostly share their codecs and direction, so the result is usually found
+  // in the cache instead of being matched codec by codec again.
+  const std::vector<C>& Get(const std::vector<C>& current_codecs,
+                            const std::vector<C>& supported_codecs) {
+    for (const Entry& entry : entries_) {
+      if (entry.supported_codecs == &supported_codecs &&
+          entry.current_codecs == current_codecs) {
+        return entry.offered_codecs;
+      }
+    }
+    entries_.push_back(Entry());
+    Entry& entry = entries_.back();
+    entry.current_codecs = current_codecs;
+    entry.supported_codecs = &supported_codecs;
+    for (const C& codec : current_codecs) {
+      if (FindMatchingCodec<C>(current_codecs, offer_codecs_, codec, nullptr))
+        entry.offered_codecs.push_back(codec);
+    }
+    C found_codec;
+    for (const C& codec : supported_codecs) {
+      if (FindMatchingCodec<C>(supported_codecs, offer_codecs_, codec,
+                               &found_codec) &&
+          !FindMatchingCodec<C>(supported_codecs, entry.offered_codecs, codec,
+                                nullptr)) {
+        // Use the |found_codec| from |offer_codecs_| because it has the
+        // correctly mapped payload type.
+        entry.offered_codecs.push_back(found_codec);
+      }
+    }
+    return entry.offered_codecs;
+  }
+
+ private:
+  struct Entry {
+    std::vector<C> current_codecs;
+    const std::vector<C>* supported_codecs;
+    std::vector<C> offered_codecs;
+  };
+
+  const std::vector<C>& offer_codecs_;
+  // A deque, so that the returned references stay valid as entries are added.
+  std::deque<Entry> entries_;
+};
+
 std::unique_ptr<SessionDescription> MediaSessionDescriptionFactory::CreateOffer(
     const MediaSessionOptions& session_options,
     const SessionDescription* current_description) const {
@@ -1451,6 +1505,9 @@ std::unique_ptr<SessionDescription> MediaSessionDescriptionFactory::CreateOffer(
   GetRtpHdrExtsToOffer(current_active_contents, &audio_rtp_extensions,
                        &video_rtp_extensions);
 
+  OfferedCodecsCache<AudioCodec> audio_codecs_cache(offer_audio_codecs);
+  OfferedCodecsCache<VideoCodec> video_codecs_cache(offer_video_codecs);
+
   auto offer = absl::make_unique<SessionDescription>();
 
   // Iterate through the media description options, matching with existing media
@@ -1471,7 +1528,7 @@ std::unique_ptr<SessionDescription> MediaSessionDescriptionFactory::CreateOffer(
       case MEDIA_TYPE_AUDIO:
         if (!AddAudioContentForOffer(
                 media_description_options, session_options, current_content,
-                current_description, audio_rtp_extensions, offer_audio_codecs,
+                current_description, audio_rtp_extensions, &audio_codecs_cache,
                 &current_streams, offer.get(), &ice_credentials)) {
           return nullptr;
         }
@@ -1479,7 +1536,7 @@ std::unique_ptr<SessionDescription> MediaSessionDescriptionFactory::CreateOffer(
       case MEDIA_TYPE_VIDEO:
         if (!AddVideoContentForOffer(
                 media_description_options, session_options, current_content,
-                current_description, video_rtp_extensions, offer_video_codecs,
+                current_description, video_rtp_extensions, &video_codecs_cache,
                 &current_streams, offer.get(), &ice_credentials)) {
           return nullptr;
         }
@@ -1988,42 +2045,25 @@ bool MediaSessionDescriptionFactory::AddAudioContentForOffer(
     const ContentInfo* current_content,
     const SessionDescription* current_description,
     const RtpHeaderExtensions& audio_rtp_extensions,
-    const AudioCodecs& audio_codecs,
+    OfferedCodecsCache<AudioCodec>* codecs_cache,
     StreamParamsVec* current_streams,
     SessionDescription* desc,
     IceCredentialsIterator* ice_credentials) const {
-  // Filter audio_codecs (which includes all codecs, with correctly remapped
-  // payload types) based on transceiver direction.
+  // Filter the offered codecs (which include all codecs, with correctly
+  // remapped payload types) based on transceiver direction.
   const AudioCodecs& supported_audio_codecs =
       GetAudioCodecsForOffer(media_description_options.direction);
 
-  AudioCodecs filtered_codecs;
-  // Add the codecs from current content if it exists and is not rejected nor
-  // recycled.
+  // Start with the codecs from current content if it exists and is not
+  // rejected nor recycled.
+  AudioCodecs current_codecs;
   if (current_content && !current_content->rejected &&
       current_content->name == media_description_options.mid) {
     RTC_CHECK(IsMediaContentOfType(current_content, MEDIA_TYPE_AUDIO));
-    const AudioContentDescription* acd =
-        current_content->media_description()->as_audio();
-    for (const AudioCodec& codec : acd->codecs()) {
-      if (FindMatchingCodec<AudioCodec>(acd->codecs(), audio_codecs, codec,
-                                        nullptr)) {
-        filtered_codecs.push_back(codec);
-      }
-    }
-  }
-  // Add other supported audio codecs.
-  AudioCodec found_codec;
-  for (const AudioCodec& codec : supported_audio_codecs) {
-    if (FindMatchingCodec<AudioCodec>(supported_audio_codecs, audio_codecs,
-                                      codec, &found_codec) &&
-        !FindMatchingCodec<AudioCodec>(supported_audio_codecs, filtered_codecs,
-                                       codec, nullptr)) {
-      // Use the |found_codec| from |audio_codecs| because it has the correctly
-      // mapped payload type.
-      filtered_codecs.push_back(found_codec);
-    }
+    current_codecs = current_content->media_description()->as_audio()->codecs();
   }
+  const AudioCodecs& filtered_codecs =
+      codecs_cache->Get(current_codecs, supported_audio_codecs);
 
   cricket::SecurePolicy sdes_policy =
       IsDtlsActive(current_content, current_description) ? cricket::SEC_DISABLED
@@ -2062,7 +2102,7 @@ bool MediaSessionDescriptionFactory::AddVideoContentForOffer(
     const ContentInfo* current_content,
     const SessionDescription* current_description,
     const RtpHeaderExtensions& video_rtp_extensions,
-    const VideoCodecs& video_codecs,
+    OfferedCodecsCache<VideoCodec>* codecs_cache,
     StreamParamsVec* current_streams,
     SessionDescription* desc,
     IceCredentialsIterator* ice_credentials) const {
@@ -2075,33 +2115,16 @@ bool MediaSessionDescriptionFactory::AddVideoContentForOffer(
   GetSupportedVideoSdesCryptoSuiteNames(session_options.crypto_options,
                                         &crypto_suites);
 
-  VideoCodecs filtered_codecs;
-  // Add the codecs from current content if it exists and is not rejected nor
-  // recycled.
+  // Start with the codecs from current content if it exists and is not
+  // rejected nor recycled.
+  VideoCodecs current_codecs;
   if (current_content && !current_content->rejected &&
       current_content->name == media_description_options.mid) {
     RTC_CHECK(IsMediaContentOfType(current_content, MEDIA_TYPE_VIDEO));
-    const VideoContentDescription* vcd =
-        current_content->media_description()->as_video();
-    for (const VideoCodec& codec : vcd->codecs()) {
-      if (FindMatchingCodec<VideoCodec>(vcd->codecs(), video_codecs, codec,
-                                        nullptr)) {
-        filtered_codecs.push_back(codec);
-      }
-    }
-  }
-  // Add other supported video codecs.
-  VideoCodec found_codec;
-  for (const VideoCodec& codec : video_codecs_) {
-    if (FindMatchingCodec<VideoCodec>(video_codecs_, video_codecs, codec,
-                                      &found_codec) &&
-        !FindMatchingCodec<VideoCodec>(video_codecs_, filtered_codecs, codec,
-                                       nullptr)) {
-      // Use the |found_codec| from |video_codecs| because it has the correctly
-      // mapped payload type.
-      filtered_codecs.push_back(found_codec);
-    }
+    current_codecs = current_content->media_description()->as_video()->codecs();
   }
+  const VideoCodecs& filtered_codecs =
+      codecs_cache->Get(current_codecs, video_codecs_);
 
   if (!CreateMediaContentOffer(
           media_description_options, session_options, filtered_codecs,
@@ -174,6 +174,11 @@ class MediaSessionDescriptionFactory {
       const SessionDescription* current_description) const;
 
  private:
+  // Computes the codecs offered in a media section, remembering the result
+  // for the other media sections of the same offer.
+  template <class C>
+  class OfferedCodecsCache;
+
   const AudioCodecs& GetAudioCodecsForOffer(
       const webrtc::RtpTransceiverDirection& direction) const;
   const AudioCodecs& GetAudioCodecsForAnswer(
@@ -222,7 +227,7 @@ class MediaSessionDescriptionFactory {
       const ContentInfo* current_content,
       const SessionDescription* current_description,
       const RtpHeaderExtensions& audio_rtp_extensions,
-      const AudioCodecs& audio_codecs,
+      OfferedCodecsCache<AudioCodec>* codecs_cache,
       StreamParamsVec* current_streams,
       SessionDescription* desc,
       IceCredentialsIterator* ice_credentials) const;
@@ -233,7 +238,7 @@ class MediaSessionDescriptionFactory {
       const ContentInfo* current_content,
       const SessionDescription* current_description,
       const RtpHeaderExtensions& video_rtp_extensions,
-      const VideoCodecs& video_codecs,
+      OfferedCodecsCache<VideoCodec>* codecs_cache,
       StreamParamsVec* current_streams,
       SessionDescription* desc,
       IceCredentialsIterator* ice_credentials) const;
@@ -962,6 +962,39 @@ TEST_F(MediaSessionDescriptionFactoryTest, TestCreateOfferContentOrder) {
   EXPECT_TRUE(IsMediaContentOfType(&offer3->contents()[2], MEDIA_TYPE_AUDIO));
 }
 
+// Media sections of the same type and direction are offered the same codecs,
+// both in an initial offer and in a renegotiation.
+TEST_F(MediaSessionDescriptionFactoryTest,
+       TestCreateOfferWithManyMediaSectionsOfSameType) {
+  MediaSessionOptions opts;
+  for (const char* mid : {"audio1", "audio2", "audio3"}) {
+    AddMediaDescriptionOptions(MEDIA_TYPE_AUDIO, mid,
+                               RtpTransceiverDirection::kSendRecv, kActive,
+                               &opts);
+  }
+  for (const char* mid : {"video1", "video2", "video3"}) {
+    AddMediaDescriptionOptions(MEDIA_TYPE_VIDEO, mid,
+                               RtpTransceiverDirection::kSendRecv, kActive,
+                               &opts);
+  }
+  std::unique_ptr<SessionDescription> offer = f1_.CreateOffer(opts, nullptr);
+  ASSERT_TRUE(offer);
+  std::unique_ptr<SessionDescription> updated_offer =
+      f1_.CreateOffer(opts, offer.get());
+  ASSERT_TRUE(updated_offer);
+  for (const SessionDescription* desc : {offer.get(), updated_offer.get()}) {
+    ASSERT_EQ(6u, desc->contents().size());
+    for (const char* mid : {"audio1", "audio2", "audio3"}) {
+      EXPECT_EQ(f1_.audio_sendrecv_codecs(),
+                desc->GetContentDescriptionByName(mid)->as_audio()->codecs());
+    }
+    for (const char* mid : {"video1", "video2", "video3"}) {
+      EXPECT_EQ(f1_.video_codecs(),
+                desc->GetContentDescriptionByName(mid)->as_video()->codecs());
+    }
+  }
+}
+
 // Create a typical audio answer, and ensure it matches what we expect.
 TEST_F(MediaSessionDescriptionFactoryTest, TestCreateAudioAnswer) {
   f1_.set_secure(SEC_ENABLED);
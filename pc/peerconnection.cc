@@ -51,6 +51,7 @@
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/stringencode.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/timeutils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
 #include "system_wrappers/include/field_trial.h"
@@ -820,9 +821,11 @@ void ExtractSharedMediaSessionOptions(
 }
 
 PeerConnection::PeerConnection(PeerConnectionFactory* factory,
+                               rtc::Thread* network_thread,
                                std::unique_ptr<RtcEventLog> event_log,
                                std::unique_ptr<Call> call)
     : factory_(factory),
+      network_thread_(network_thread),
       event_log_(std::move(event_log)),
       rtcp_cname_(GenerateRtcpCname()),
       local_streams_(StreamCollection::Create()),
@@ -889,6 +892,7 @@ bool PeerConnection::Initialize(
     const PeerConnectionInterface::RTCConfiguration& configuration,
     PeerConnectionDependencies dependencies) {
   TRACE_EVENT0("webrtc", "PeerConnection::Initialize");
+  call_setup_times_.created_ms = rtc::TimeMillis();
 
   RTCError config_error = ValidateConfiguration(configuration);
   if (!config_error.ok()) {
@@ -1008,7 +1012,8 @@ bool PeerConnection::Initialize(
   transport_controller_->SignalDtlsHandshakeError.connect(
       this, &PeerConnection::OnTransportControllerDtlsHandshakeError);
 
-  sctp_factory_ = factory_->CreateSctpTransportInternalFactory();
+  sctp_factory_ =
+      factory_->CreateSctpTransportInternalFactory(network_thread());
 
   stats_.reset(new StatsCollector(this));
   stats_collector_ = RTCStatsCollector::Create(this);
@@ -1840,6 +1845,7 @@ void PeerConnection::CreateOffer(CreateSessionDescriptionObserver* observer,
 
   cricket::MediaSessionOptions session_options;
   GetOptionsForOffer(options, &session_options);
+  NoteCallSetupStage(&call_setup_times_.create_offer_ms);
   webrtc_session_desc_factory_->CreateOffer(observer, options, session_options);
 }
 
@@ -1953,6 +1959,7 @@ void PeerConnection::CreateAnswer(CreateSessionDescriptionObserver* observer,
   cricket::MediaSessionOptions session_options;
   GetOptionsForAnswer(options, &session_options);
 
+  NoteCallSetupStage(&call_setup_times_.create_answer_ms);
   webrtc_session_desc_factory_->CreateAnswer(observer, session_options);
 }
 
@@ -2023,6 +2030,7 @@ void PeerConnection::SetLocalDescription(
   }
   RTC_DCHECK(local_description());
 
+  NoteCallSetupStage(&call_setup_times_.set_local_description_ms);
   PostSetSessionDescriptionSuccess(observer);
 
   // MaybeStartGathering needs to be called after posting
@@ -2371,6 +2379,7 @@ void PeerConnection::SetRemoteDescription(
     ReportNegotiatedSdpSemantics(*remote_description());
   }
 
+  NoteCallSetupStage(&call_setup_times_.set_remote_description_ms);
   observer->OnSetRemoteDescriptionComplete(RTCError::OK());
   NoteUsageEvent(UsageEvent::SET_REMOTE_DESCRIPTION_CALLED);
 }
@@ -3736,6 +3745,10 @@ void PeerConnection::SetIceConnectionState(IceConnectionState new_state) {
              PeerConnectionInterface::kIceConnectionClosed);
 
   ice_connection_state_ = new_state;
+  if (new_state == kIceConnectionConnected ||
+      new_state == kIceConnectionCompleted) {
+    NoteCallSetupStage(&call_setup_times_.ice_connected_ms);
+  }
   Observer()->OnIceConnectionChange(ice_connection_state_);
 }
 
@@ -3758,6 +3771,13 @@ void PeerConnection::SetConnectionState(
   if (IsClosed())
     return;
   connection_state_ = new_state;
+  if (new_state == PeerConnectionState::kConnected &&
+      !call_setup_times_.connected_ms) {
+    NoteCallSetupStage(&call_setup_times_.connected_ms);
+    RTC_HISTOGRAM_COUNTS_10000(
+        "WebRTC.PeerConnection.TimeToConnectedMs",
+        *call_setup_times_.connected_ms - call_setup_times_.created_ms);
+  }
   Observer()->OnConnectionChange(new_state);
 }
 
@@ -3768,6 +3788,8 @@ void PeerConnection::OnIceGatheringChange(
     return;
   }
   ice_gathering_state_ = new_state;
+  if (new_state == kIceGatheringComplete)
+    NoteCallSetupStage(&call_setup_times_.ice_gathering_complete_ms);
   Observer()->OnIceGatheringChange(ice_gathering_state_);
 }
 
@@ -5899,7 +5921,7 @@ cricket::VoiceChannel* PeerConnection::CreateVoiceChannel(
   cricket::VoiceChannel* voice_channel = channel_manager()->CreateVoiceChannel(
       call_.get(), configuration_.media_config, rtp_transport, media_transport,
       signaling_thread(), mid, SrtpRequired(), GetCryptoOptions(),
-      audio_options_);
+      audio_options_, network_thread());
   if (!voice_channel) {
     return nullptr;
   }
@@ -5921,7 +5943,7 @@ cricket::VideoChannel* PeerConnection::CreateVideoChannel(
   cricket::VideoChannel* video_channel = channel_manager()->CreateVideoChannel(
       call_.get(), configuration_.media_config, rtp_transport,
       signaling_thread(), mid, SrtpRequired(), GetCryptoOptions(),
-      video_options_);
+      video_options_, network_thread());
   if (!video_channel) {
     return nullptr;
   }
@@ -5968,7 +5990,7 @@ bool PeerConnection::CreateDataChannel(const std::string& mid) {
       RtpTransportInternal* rtp_transport = GetRtpTransport(mid);
       rtp_data_channel_ = channel_manager()->CreateRtpDataChannel(
           configuration_.media_config, rtp_transport, signaling_thread(), mid,
-          SrtpRequired(), GetCryptoOptions());
+          SrtpRequired(), GetCryptoOptions(), network_thread());
       if (!rtp_data_channel_) {
         return false;
       }
@@ -5983,6 +6005,11 @@ bool PeerConnection::CreateDataChannel(const std::string& mid) {
   return true;
 }
 
+CallSetupTimes PeerConnection::GetCallSetupTimes() const {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  return call_setup_times_;
+}
+
 Call::Stats PeerConnection::GetCallStats() {
   if (!worker_thread()->IsCurrent()) {
     return worker_thread()->Invoke<Call::Stats>(
@@ -6366,6 +6393,13 @@ void PeerConnection::NoteUsageEvent(UsageEvent event) {
   usage_event_accumulator_ |= static_cast<int>(event);
 }
 
+void PeerConnection::NoteCallSetupStage(
+    absl::optional<int64_t>* stage_time_ms) {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  if (!*stage_time_ms)
+    *stage_time_ms = rtc::TimeMillis();
+}
+
 void PeerConnection::ReportUsagePattern() const {
   RTC_DLOG(LS_INFO) << "Usage signature is " << usage_event_accumulator_;
   RTC_HISTOGRAM_ENUMERATION_SPARSE("WebRTC.PeerConnection.UsagePattern",
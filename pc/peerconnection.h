@@ -74,9 +74,12 @@ class PeerConnection : public PeerConnectionInternal,
     MAX_VALUE = 0x1000,
   };
 
-  explicit PeerConnection(PeerConnectionFactory* factory,
-                          std::unique_ptr<RtcEventLog> event_log,
-                          std::unique_ptr<Call> call);
+  // |network_thread| is the factory network thread this PeerConnection is
+  // pinned to.
+  PeerConnection(PeerConnectionFactory* factory,
+                 rtc::Thread* network_thread,
+                 std::unique_ptr<RtcEventLog> event_log,
+                 std::unique_ptr<Call> call);
 
   bool Initialize(
       const PeerConnectionInterface::RTCConfiguration& configuration,
@@ -207,9 +210,7 @@ class PeerConnection : public PeerConnectionInternal,
   void Close() override;
 
   // PeerConnectionInternal implementation.
-  rtc::Thread* network_thread() const override {
-    return factory_->network_thread();
-  }
+  rtc::Thread* network_thread() const override { return network_thread_; }
   rtc::Thread* worker_thread() const override {
     return factory_->worker_thread();
   }
@@ -256,6 +257,7 @@ class PeerConnection : public PeerConnectionInternal,
   std::map<std::string, cricket::TransportStats> GetTransportStatsByNames(
       const std::set<std::string>& transport_names) override;
   Call::Stats GetCallStats() override;
+  CallSetupTimes GetCallSetupTimes() const override;
 
   bool GetLocalCertificate(
       const std::string& transport_name,
@@ -930,6 +932,9 @@ class PeerConnection : public PeerConnectionInternal,
                                const std::set<cricket::MediaType>& media_types);
 
   void NoteUsageEvent(UsageEvent event);
+  // Sets |*stage_time_ms| to the current time, if the stage of call setup was
+  // not reached before.
+  void NoteCallSetupStage(absl::optional<int64_t>* stage_time_ms);
   void ReportUsagePattern() const;
 
   void OnSentPacket_w(const rtc::SentPacket& sent_packet);
@@ -999,6 +1004,7 @@ class PeerConnection : public PeerConnectionInternal,
   // PeerConnectionFactoryInterface all instances created using the raw pointer
   // will refer to the same reference count.
   rtc::scoped_refptr<PeerConnectionFactory> factory_;
+  rtc::Thread* const network_thread_;
   PeerConnectionObserver* observer_ = nullptr;
 
   // The EventLog needs to outlive |call_| (and any other object that uses it).
@@ -1146,6 +1152,7 @@ class PeerConnection : public PeerConnectionInternal,
   cricket::VideoOptions video_options_;
 
   int usage_event_accumulator_ = 0;
+  CallSetupTimes call_setup_times_;
   bool return_histogram_very_quickly_ = false;
 };
 
@@ -62,7 +62,7 @@ class PeerConnectionFactoryForJsepTest : public PeerConnectionFactory {
                               nullptr) {}
 
   std::unique_ptr<cricket::SctpTransportInternalFactory>
-  CreateSctpTransportInternalFactory() {
+  CreateSctpTransportInternalFactory(rtc::Thread* network_thread) {
     return absl::make_unique<FakeSctpTransportFactory>();
   }
 };
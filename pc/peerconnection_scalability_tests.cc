@@ -0,0 +1,345 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/create_peerconnection_factory.h"
+#include "api/datachannelinterface.h"
+#include "api/peerconnectioninterface.h"
+#include "api/video_codecs/builtin_video_decoder_factory.h"
+#include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "modules/audio_device/include/audio_device.h"
+#include "p2p/client/basicportallocator.h"
+#include "pc/peerconnection.h"
+#include "pc/peerconnectionwrapper.h"
+#include "pc/test/fakeaudiocapturemodule.h"
+#include "pc/test/framegeneratorcapturervideotracksource.h"
+#include "pc/test/mockpeerconnectionobservers.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/fakenetwork.h"
+#include "rtc_base/flags.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/location.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/socketaddress.h"
+#include "rtc_base/testcertificateverifier.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/timeutils.h"
+#include "rtc_base/virtualsocketserver.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+#if defined(WEBRTC_LINUX)
+#include <unistd.h>
+#endif
+
+WEBRTC_DEFINE_int(pc_scalability_num_pairs,
+                  4,
+                  "Number of loopback PeerConnection pairs to create.");
+WEBRTC_DEFINE_int(pc_scalability_audio_streams,
+                  1,
+                  "Number of audio tracks sent by each caller.");
+WEBRTC_DEFINE_int(pc_scalability_video_streams,
+                  1,
+                  "Number of video tracks sent by each caller.");
+WEBRTC_DEFINE_bool(pc_scalability_data_channel,
+                   true,
+                   "Open a data channel in each pair and send messages on it.");
+WEBRTC_DEFINE_int(pc_scalability_video_width, 320, "Width of sent video.");
+WEBRTC_DEFINE_int(pc_scalability_video_height, 180, "Height of sent video.");
+WEBRTC_DEFINE_int(pc_scalability_duration_ms,
+                  10000,
+                  "Time to measure once all pairs are connected.");
+
+namespace webrtc {
+
+namespace {
+static const int kDefaultTimeoutMs = 10000;
+static const int kPollIntervalMs = 100;
+static const rtc::SocketAddress kDefaultLocalAddress("1.1.1.1", 0);
+
+using RTCConfiguration = PeerConnectionInterface::RTCConfiguration;
+
+// Returns the resident set size of the process, or -1 if unknown.
+int64_t GetResidentSetBytes() {
+#if defined(WEBRTC_LINUX)
+  FILE* file = fopen("/proc/self/statm", "r");
+  if (!file)
+    return -1;
+  long total_pages = 0;
+  long resident_pages = 0;
+  const int fields = fscanf(file, "%ld %ld", &total_pages, &resident_pages);
+  fclose(file);
+  if (fields != 2)
+    return -1;
+  return static_cast<int64_t>(resident_pages) * sysconf(_SC_PAGESIZE);
+#else
+  return -1;
+#endif
+}
+
+double Percentile(std::vector<double> values, double percentile) {
+  if (values.empty())
+    return 0;
+  std::sort(values.begin(), values.end());
+  size_t index = static_cast<size_t>(percentile * (values.size() - 1) + 0.5);
+  return values[std::min(index, values.size() - 1)];
+}
+
+int64_t ThreadCpuTimeNanos(rtc::Thread* thread) {
+  return thread->Invoke<int64_t>(RTC_FROM_HERE,
+                                 [] { return rtc::GetThreadCpuTimeNanos(); });
+}
+
+}  // namespace
+
+// Load test measuring how the PeerConnection stack scales with the number of
+// PeerConnections. It creates --pc_scalability_num_pairs loopback pairs on a
+// shared factory and VirtualSocketServer, each caller sending the configured
+// audio, video and data channel streams to its callee. It then reports the
+// setup latency percentiles, the memory per PeerConnection, the CPU used per
+// stream and by each of the PeerConnection threads, and the cost of
+// getStats() calls. Results are printed using the perf test support, and
+// written as JSON when --isolated_script_test_perf_output is given.
+class PeerConnectionScalabilityTest : public ::testing::Test {
+ public:
+  PeerConnectionScalabilityTest()
+      : clock_(Clock::GetRealTimeClock()),
+        virtual_socket_server_(new rtc::VirtualSocketServer()),
+        network_thread_(new rtc::Thread(virtual_socket_server_.get())),
+        worker_thread_(rtc::Thread::Create()) {
+    network_thread_->SetName("PCNetworkThread", this);
+    worker_thread_->SetName("PCWorkerThread", this);
+    RTC_CHECK(network_thread_->Start());
+    RTC_CHECK(worker_thread_->Start());
+
+    pc_factory_ = CreatePeerConnectionFactory(
+        network_thread_.get(), worker_thread_.get(), rtc::Thread::Current(),
+        rtc::scoped_refptr<AudioDeviceModule>(FakeAudioCaptureModule::Create()),
+        CreateBuiltinAudioEncoderFactory(), CreateBuiltinAudioDecoderFactory(),
+        CreateBuiltinVideoEncoderFactory(), CreateBuiltinVideoDecoderFactory(),
+        nullptr /* audio_mixer */, nullptr /* audio_processing */);
+  }
+
+  ~PeerConnectionScalabilityTest() override {
+    data_channels_.clear();
+    pairs_.clear();
+    video_track_sources_.clear();
+  }
+
+ protected:
+  struct Pair {
+    std::unique_ptr<PeerConnectionWrapper> caller;
+    std::unique_ptr<PeerConnectionWrapper> callee;
+  };
+
+  std::unique_ptr<PeerConnectionWrapper> CreatePeerConnectionWrapper() {
+    auto* fake_network_manager = new rtc::FakeNetworkManager();
+    fake_network_manager->AddInterface(kDefaultLocalAddress);
+    fake_network_managers_.emplace_back(fake_network_manager);
+
+    auto observer = absl::make_unique<MockPeerConnectionObserver>();
+    PeerConnectionDependencies dependencies(observer.get());
+    dependencies.allocator =
+        absl::make_unique<cricket::BasicPortAllocator>(fake_network_manager);
+    dependencies.tls_cert_verifier =
+        absl::make_unique<rtc::TestCertificateVerifier>();
+
+    RTCConfiguration config;
+    config.sdp_semantics = SdpSemantics::kUnifiedPlan;
+    config.tcp_candidate_policy = PeerConnection::kTcpCandidatePolicyDisabled;
+    auto pc = pc_factory_->CreatePeerConnection(config, std::move(dependencies));
+    if (!pc)
+      return nullptr;
+    return absl::make_unique<PeerConnectionWrapper>(pc_factory_, pc,
+                                                    std::move(observer));
+  }
+
+  rtc::scoped_refptr<VideoTrackInterface> CreateVideoTrack() {
+    FrameGeneratorCapturerVideoTrackSource::Config config;
+    config.width = FLAG_pc_scalability_video_width;
+    config.height = FLAG_pc_scalability_video_height;
+    video_track_sources_.emplace_back(
+        new rtc::RefCountedObject<FrameGeneratorCapturerVideoTrackSource>(
+            config, clock_));
+    video_track_sources_.back()->Start();
+    return pc_factory_->CreateVideoTrack(rtc::CreateRandomUuid(),
+                                         video_track_sources_.back());
+  }
+
+  rtc::scoped_refptr<AudioTrackInterface> CreateAudioTrack() {
+    rtc::scoped_refptr<AudioSourceInterface> source =
+        pc_factory_->CreateAudioSource(cricket::AudioOptions());
+    return pc_factory_->CreateAudioTrack(rtc::CreateRandomUuid(), source);
+  }
+
+  // Creates a pair, negotiates it and waits until it is connected. Returns the
+  // time this took in ms, or a negative value on failure.
+  double SetUpPair() {
+    const int64_t start_us = rtc::TimeMicros();
+    Pair pair;
+    pair.caller = CreatePeerConnectionWrapper();
+    pair.callee = CreatePeerConnectionWrapper();
+    if (!pair.caller || !pair.callee)
+      return -1;
+
+    for (int i = 0; i < FLAG_pc_scalability_audio_streams; ++i)
+      pair.caller->AddTrack(CreateAudioTrack());
+    for (int i = 0; i < FLAG_pc_scalability_video_streams; ++i)
+      pair.caller->AddTrack(CreateVideoTrack());
+    if (FLAG_pc_scalability_data_channel)
+      data_channels_.push_back(pair.caller->CreateDataChannel("load"));
+
+    if (!pair.caller->ExchangeOfferAnswerWith(pair.callee.get()))
+      return -1;
+    PeerConnectionWrapper* caller = pair.caller.get();
+    PeerConnectionWrapper* callee = pair.callee.get();
+    EXPECT_TRUE_WAIT(caller->IsIceGatheringDone(), kDefaultTimeoutMs);
+    EXPECT_TRUE_WAIT(callee->IsIceGatheringDone(), kDefaultTimeoutMs);
+    for (const IceCandidateInterface* candidate :
+         caller->observer()->GetAllCandidates()) {
+      callee->pc()->AddIceCandidate(candidate);
+    }
+    for (const IceCandidateInterface* candidate :
+         callee->observer()->GetAllCandidates()) {
+      caller->pc()->AddIceCandidate(candidate);
+    }
+    EXPECT_TRUE_WAIT(caller->IsIceConnected() && callee->IsIceConnected(),
+                     kDefaultTimeoutMs);
+    if (!caller->IsIceConnected() || !callee->IsIceConnected())
+      return -1;
+
+    pairs_.push_back(std::move(pair));
+    return static_cast<double>(rtc::TimeMicros() - start_us) /
+           rtc::kNumMicrosecsPerMillisec;
+  }
+
+  void SendDataChannelMessages() {
+    for (const auto& data_channel : data_channels_) {
+      if (data_channel->state() == DataChannelInterface::kOpen)
+        data_channel->Send(DataBuffer("load test message"));
+    }
+  }
+
+  Clock* const clock_;
+  // |virtual_socket_server_| is used by |network_thread_| so it must be
+  // destroyed later.
+  std::unique_ptr<rtc::VirtualSocketServer> virtual_socket_server_;
+  std::unique_ptr<rtc::Thread> network_thread_;
+  std::unique_ptr<rtc::Thread> worker_thread_;
+  std::vector<std::unique_ptr<rtc::FakeNetworkManager>> fake_network_managers_;
+  // The |pc_factory_| uses |network_thread_| & |worker_thread_|, so it must be
+  // destroyed first.
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> pc_factory_;
+  std::vector<rtc::scoped_refptr<FrameGeneratorCapturerVideoTrackSource>>
+      video_track_sources_;
+  std::vector<Pair> pairs_;
+  std::vector<rtc::scoped_refptr<DataChannelInterface>> data_channels_;
+};
+
+TEST_F(PeerConnectionScalabilityTest, LoopbackPairs) {
+  const int num_pairs = FLAG_pc_scalability_num_pairs;
+  ASSERT_GT(num_pairs, 0);
+
+  const int64_t rss_before_bytes = GetResidentSetBytes();
+  std::vector<double> setup_times_ms;
+  for (int i = 0; i < num_pairs; ++i) {
+    const double setup_time_ms = SetUpPair();
+    ASSERT_GE(setup_time_ms, 0) << "Failed to connect pair " << i;
+    setup_times_ms.push_back(setup_time_ms);
+  }
+  const int64_t rss_after_bytes = GetResidentSetBytes();
+
+  // Let the streams ramp up before measuring.
+  rtc::Thread::Current()->ProcessMessages(1000);
+
+  const int64_t start_us = rtc::TimeMicros();
+  const int64_t start_process_cpu_ns = rtc::GetProcessCpuTimeNanos();
+  const int64_t start_signaling_cpu_ns = rtc::GetThreadCpuTimeNanos();
+  const int64_t start_network_cpu_ns = ThreadCpuTimeNanos(network_thread_.get());
+  const int64_t start_worker_cpu_ns = ThreadCpuTimeNanos(worker_thread_.get());
+
+  std::vector<double> get_stats_times_ms;
+  size_t next_pair = 0;
+  while (rtc::TimeMicros() - start_us <
+         FLAG_pc_scalability_duration_ms * rtc::kNumMicrosecsPerMillisec) {
+    rtc::Thread::Current()->ProcessMessages(kPollIntervalMs);
+    SendDataChannelMessages();
+    // Poll one PeerConnection at a time, like a client periodically
+    // collecting stats for each of its connections.
+    const int64_t stats_start_us = rtc::TimeMicros();
+    EXPECT_TRUE(pairs_[next_pair].caller->GetStats());
+    get_stats_times_ms.push_back(
+        static_cast<double>(rtc::TimeMicros() - stats_start_us) /
+        rtc::kNumMicrosecsPerMillisec);
+    next_pair = (next_pair + 1) % pairs_.size();
+  }
+
+  const double elapsed_ns = static_cast<double>(rtc::TimeMicros() - start_us) *
+                            rtc::kNumNanosecsPerMicrosec;
+  const double process_cpu_ns =
+      rtc::GetProcessCpuTimeNanos() - start_process_cpu_ns;
+  const double signaling_cpu_ns =
+      rtc::GetThreadCpuTimeNanos() - start_signaling_cpu_ns;
+  const double network_cpu_ns =
+      ThreadCpuTimeNanos(network_thread_.get()) - start_network_cpu_ns;
+  const double worker_cpu_ns =
+      ThreadCpuTimeNanos(worker_thread_.get()) - start_worker_cpu_ns;
+
+  const int streams_per_pair = FLAG_pc_scalability_audio_streams +
+                               FLAG_pc_scalability_video_streams +
+                               (FLAG_pc_scalability_data_channel ? 1 : 0);
+  const std::string trace = std::to_string(num_pairs) + "_pairs";
+
+  test::PrintResult("pc_scalability_setup_time_p50", "", trace,
+                    Percentile(setup_times_ms, 0.5), "ms", false);
+  test::PrintResult("pc_scalability_setup_time_p90", "", trace,
+                    Percentile(setup_times_ms, 0.9), "ms", false);
+  test::PrintResult("pc_scalability_setup_time_max", "", trace,
+                    Percentile(setup_times_ms, 1.0), "ms", false);
+  if (rss_before_bytes >= 0 && rss_after_bytes >= 0) {
+    test::PrintResult("pc_scalability_memory_per_peerconnection", "", trace,
+                      static_cast<double>(rss_after_bytes - rss_before_bytes) /
+                          (2 * num_pairs),
+                      "bytes", false);
+  }
+  test::PrintResult("pc_scalability_process_cpu", "", trace,
+                    100 * process_cpu_ns / elapsed_ns, "%", false);
+  if (streams_per_pair > 0) {
+    test::PrintResult(
+        "pc_scalability_cpu_per_stream", "", trace,
+        100 * process_cpu_ns / elapsed_ns / (num_pairs * streams_per_pair),
+        "%", false);
+  }
+  test::PrintResult("pc_scalability_signaling_thread_utilization", "", trace,
+                    100 * signaling_cpu_ns / elapsed_ns, "%", false);
+  test::PrintResult("pc_scalability_network_thread_utilization", "", trace,
+                    100 * network_cpu_ns / elapsed_ns, "%", false);
+  test::PrintResult("pc_scalability_worker_thread_utilization", "", trace,
+                    100 * worker_cpu_ns / elapsed_ns, "%", false);
+  test::PrintResult("pc_scalability_get_stats_time_p50", "", trace,
+                    Percentile(get_stats_times_ms, 0.5), "ms", false);
+  test::PrintResult("pc_scalability_get_stats_time_p90", "", trace,
+                    Percentile(get_stats_times_ms, 0.9), "ms", false);
+}
+
+}  // namespace webrtc
@@ -29,6 +29,9 @@
 #include "pc/rtpparametersconversion.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/timeutils.h"
 // Adding 'nogncheck' to disable the gn include headers check to support modular
 // WebRTC build targets.
 // TODO(zhihuang): This wouldn't be necessary if the interface and
@@ -94,6 +97,11 @@ CreateModularPeerConnectionFactory(
 rtc::scoped_refptr<PeerConnectionFactoryInterface>
 CreateModularPeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies) {
+  // Installed first, so that it also applies to the threads of the factory.
+  if (dependencies.thread_placement_policy) {
+    rtc::SetThreadPlacementPolicy(
+        std::move(dependencies.thread_placement_policy));
+  }
   rtc::scoped_refptr<PeerConnectionFactory> pc_factory(
       new rtc::RefCountedObject<PeerConnectionFactory>(
           std::move(dependencies)));
@@ -151,6 +159,19 @@ PeerConnectionFactory::PeerConnectionFactory(
     owned_network_thread_->SetName("pc_network_thread", nullptr);
     owned_network_thread_->Start();
     network_thread_ = owned_network_thread_.get();
+
+    // An injected network thread is kept as the only one, since the
+    // application may rely on all network activity happening there.
+    FieldTrialParameter<int> num_shards("shards", 1);
+    ParseFieldTrial({&num_shards},
+                    field_trial::FindFullName("WebRTC-NetworkThreadShards"));
+    for (int i = 1; i < num_shards; ++i) {
+      NetworkShard shard;
+      shard.thread = rtc::Thread::CreateWithSocketServer();
+      shard.thread->SetName("pc_network_thread", nullptr);
+      shard.thread->Start();
+      network_shards_.push_back(std::move(shard));
+    }
   }
 
   if (!worker_thread_) {
@@ -189,6 +210,10 @@ PeerConnectionFactory::PeerConnectionFactory(
   media_transport_factory_ = std::move(dependencies.media_transport_factory);
 }
 
+PeerConnectionFactory::NetworkShard::NetworkShard() = default;
+PeerConnectionFactory::NetworkShard::NetworkShard(NetworkShard&&) = default;
+PeerConnectionFactory::NetworkShard::~NetworkShard() = default;
+
 PeerConnectionFactory::~PeerConnectionFactory() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   channel_manager_.reset(nullptr);
@@ -197,6 +222,11 @@ PeerConnectionFactory::~PeerConnectionFactory() {
   // |default_socket_factory_| and |default_network_manager_|.
   default_socket_factory_ = nullptr;
   default_network_manager_ = nullptr;
+  for (NetworkShard& shard : network_shards_) {
+    shard.socket_factory = nullptr;
+    shard.network_manager = nullptr;
+  }
+  network_shards_.clear();
 
   if (wraps_current_thread_)
     rtc::ThreadManager::Instance()->UnwrapCurrentThread();
@@ -217,6 +247,16 @@ bool PeerConnectionFactory::Initialize() {
     return false;
   }
 
+  for (NetworkShard& shard : network_shards_) {
+    shard.network_manager = absl::make_unique<rtc::BasicNetworkManager>();
+    shard.socket_factory =
+        absl::make_unique<rtc::BasicPacketSocketFactory>(shard.thread.get());
+    // Same as what ChannelManager::Init() does for |network_thread_|.
+    shard.thread->Invoke<void>(RTC_FROM_HERE, [&shard] {
+      shard.thread->SetAllowBlockingCalls(false);
+    });
+  }
+
   channel_manager_ = absl::make_unique<cricket::ChannelManager>(
       std::move(media_engine_), absl::make_unique<cricket::RtpDataEngine>(),
       worker_thread_, network_thread_);
@@ -349,6 +389,36 @@ PeerConnectionFactory::CreatePeerConnection(
     PeerConnectionDependencies dependencies) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
 
+  // Pick the network thread this PeerConnection will be pinned to. An injected
+  // port allocator may be tied to |network_thread_|, so only PeerConnections
+  // using the default one are spread across the shards.
+  rtc::Thread* network_thread = network_thread_;
+  rtc::NetworkManager* network_manager = default_network_manager_.get();
+  rtc::PacketSocketFactory* socket_factory = default_socket_factory_.get();
+  if (!dependencies.allocator && !network_shards_.empty()) {
+    size_t index = next_network_shard_++ % (network_shards_.size() + 1);
+    if (index > 0) {
+      const NetworkShard& shard = network_shards_[index - 1];
+      network_thread = shard.thread.get();
+      network_manager = shard.network_manager.get();
+      socket_factory = shard.socket_factory.get();
+    }
+  }
+
+  // Reuse one certificate for the PeerConnections that would otherwise each
+  // generate their own, so that a burst of PeerConnections doesn't cost a key
+  // generation apiece.
+  PeerConnectionInterface::RTCConfiguration shared_certificate_configuration;
+  const PeerConnectionInterface::RTCConfiguration* pc_configuration =
+      &configuration;
+  if (configuration.certificates.empty() && !dependencies.cert_generator &&
+      field_trial::IsEnabled("WebRTC-ShareDtlsCertificate")) {
+    shared_certificate_configuration = configuration;
+    shared_certificate_configuration.certificates.push_back(
+        GetSharedCertificate());
+    pc_configuration = &shared_certificate_configuration;
+  }
+
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator =
@@ -356,11 +426,9 @@ PeerConnectionFactory::CreatePeerConnection(
                                                         network_thread_);
   }
   if (!dependencies.allocator) {
-    network_thread_->Invoke<void>(RTC_FROM_HERE, [this, &configuration,
-                                                  &dependencies]() {
+    network_thread->Invoke<void>(RTC_FROM_HERE, [&]() {
       dependencies.allocator = absl::make_unique<cricket::BasicPortAllocator>(
-          default_network_manager_.get(), default_socket_factory_.get(),
-          configuration.turn_customizer);
+          network_manager, socket_factory, configuration.turn_customizer);
     });
   }
 
@@ -368,7 +436,7 @@ PeerConnectionFactory::CreatePeerConnection(
   // |dependencies.async_resolver_factory| to a new
   // |rtc::BasicAsyncResolverFactory| if no factory is provided.
 
-  network_thread_->Invoke<void>(
+  network_thread->Invoke<void>(
       RTC_FROM_HERE,
       rtc::Bind(&cricket::PortAllocator::SetNetworkIgnoreMask,
                 dependencies.allocator.get(), options_.network_ignore_mask));
@@ -383,15 +451,30 @@ PeerConnectionFactory::CreatePeerConnection(
       rtc::Bind(&PeerConnectionFactory::CreateCall_w, this, event_log.get()));
 
   rtc::scoped_refptr<PeerConnection> pc(
-      new rtc::RefCountedObject<PeerConnection>(this, std::move(event_log),
-                                                std::move(call)));
+      new rtc::RefCountedObject<PeerConnection>(
+          this, network_thread, std::move(event_log), std::move(call)));
   ActionsBeforeInitializeForTesting(pc);
-  if (!pc->Initialize(configuration, std::move(dependencies))) {
+  if (!pc->Initialize(*pc_configuration, std::move(dependencies))) {
     return nullptr;
   }
   return PeerConnectionProxy::Create(signaling_thread(), pc);
 }
 
+rtc::scoped_refptr<rtc::RTCCertificate>
+PeerConnectionFactory::GetSharedCertificate() {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  // Replaced a day before it expires, so that PeerConnections using it don't
+  // outlive it.
+  static const uint64_t kExpirationMarginMs = 24 * 60 * 60 * 1000;
+  if (!shared_certificate_ ||
+      shared_certificate_->HasExpired(rtc::TimeUTCMillis() +
+                                      kExpirationMarginMs)) {
+    shared_certificate_ = rtc::RTCCertificateGenerator::GenerateCertificate(
+        rtc::KeyParams(), absl::nullopt);
+  }
+  return shared_certificate_;
+}
+
 rtc::scoped_refptr<MediaStreamInterface>
 PeerConnectionFactory::CreateLocalMediaStream(const std::string& stream_id) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
@@ -417,9 +500,10 @@ rtc::scoped_refptr<AudioTrackInterface> PeerConnectionFactory::CreateAudioTrack(
 }
 
 std::unique_ptr<cricket::SctpTransportInternalFactory>
-PeerConnectionFactory::CreateSctpTransportInternalFactory() {
+PeerConnectionFactory::CreateSctpTransportInternalFactory(
+    rtc::Thread* network_thread) {
 #ifdef HAVE_SCTP
-  return absl::make_unique<cricket::SctpTransportFactory>(network_thread());
+  return absl::make_unique<cricket::SctpTransportFactory>(network_thread);
 #else
   return nullptr;
 #endif
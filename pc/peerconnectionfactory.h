@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/media_transport_interface.h"
 #include "api/mediastreaminterface.h"
@@ -89,7 +90,7 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   void StopAecDump() override;
 
   virtual std::unique_ptr<cricket::SctpTransportInternalFactory>
-  CreateSctpTransportInternalFactory();
+  CreateSctpTransportInternalFactory(rtc::Thread* network_thread);
 
   virtual cricket::ChannelManager* channel_manager();
   virtual rtc::Thread* signaling_thread();
@@ -132,6 +133,21 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   virtual ~PeerConnectionFactory();
 
  private:
+  // An additional network thread, with the network manager and socket factory
+  // used by the default port allocators of the PeerConnections pinned to it.
+  struct NetworkShard {
+    NetworkShard();
+    NetworkShard(NetworkShard&&);
+    ~NetworkShard();
+
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<rtc::BasicNetworkManager> network_manager;
+    std::unique_ptr<rtc::BasicPacketSocketFactory> socket_factory;
+  };
+
+  // Returns the certificate shared by PeerConnections under the
+  // "WebRTC-ShareDtlsCertificate" field trial, generating it if needed.
+  rtc::scoped_refptr<rtc::RTCCertificate> GetSharedCertificate();
   std::unique_ptr<RtcEventLog> CreateRtcEventLog_w();
   std::unique_ptr<Call> CreateCall_w(RtcEventLog* event_log);
 
@@ -145,6 +161,14 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   std::unique_ptr<cricket::ChannelManager> channel_manager_;
   std::unique_ptr<rtc::BasicNetworkManager> default_network_manager_;
   std::unique_ptr<rtc::BasicPacketSocketFactory> default_socket_factory_;
+  // Extra network threads created when the "WebRTC-NetworkThreadShards" field
+  // trial is enabled and |network_thread_| is owned by the factory. Each
+  // PeerConnection is pinned, round-robin, to |network_thread_| or one of
+  // these, so that ICE, DTLS and SRTP for different PeerConnections can run on
+  // different cores.
+  std::vector<NetworkShard> network_shards_;
+  size_t next_network_shard_ = 0;
+  rtc::scoped_refptr<rtc::RTCCertificate> shared_certificate_;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine_;
   std::unique_ptr<webrtc::CallFactoryInterface> call_factory_;
   std::unique_ptr<RtcEventLogFactoryInterface> event_log_factory_;
@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "api/audio/audio_mixer.h"
 #include "api/audio_codecs/audio_decoder_factory.h"
 #include "api/audio_codecs/audio_encoder_factory.h"
@@ -36,6 +37,7 @@
 #include "pc/peerconnectionfactory.h"
 #include "pc/test/fakeaudiocapturemodule.h"
 #include "rtc_base/socketaddress.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 #ifdef WEBRTC_ANDROID
@@ -296,6 +298,26 @@ TEST_F(PeerConnectionFactoryTest, CreatePCUsingIceServers) {
   VerifyTurnServers(turn_servers);
 }
 
+TEST_F(PeerConnectionFactoryTest, PeerConnectionsShareCertificate) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-ShareDtlsCertificate/Enabled/");
+  PeerConnectionInterface::RTCConfiguration config;
+  rtc::scoped_refptr<PeerConnectionInterface> pc1 =
+      factory_->CreatePeerConnection(config, std::move(port_allocator_),
+                                     nullptr, &observer_);
+  ASSERT_TRUE(pc1);
+  rtc::scoped_refptr<PeerConnectionInterface> pc2 =
+      factory_->CreatePeerConnection(
+          config,
+          absl::make_unique<cricket::FakePortAllocator>(rtc::Thread::Current(),
+                                                        nullptr),
+          nullptr, &observer_);
+  ASSERT_TRUE(pc2);
+  ASSERT_EQ(1u, pc1->GetConfiguration().certificates.size());
+  EXPECT_EQ(pc1->GetConfiguration().certificates,
+            pc2->GetConfiguration().certificates);
+}
+
 // This test verifies creation of PeerConnection with valid STUN and TURN
 // configuration. Also verifies the list of URL's parsed correctly as expected.
 TEST_F(PeerConnectionFactoryTest, CreatePCUsingIceServersUrls) {
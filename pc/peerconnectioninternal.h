@@ -17,6 +17,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/peerconnectioninterface.h"
 #include "call/call.h"
 #include "pc/datachannel.h"
@@ -24,6 +25,20 @@
 
 namespace webrtc {
 
+// Times, from rtc::TimeMillis(), at which a peer connection first reached the
+// stages of call setup. Stages that have not been reached are unset.
+struct CallSetupTimes {
+  int64_t created_ms = 0;
+  absl::optional<int64_t> create_offer_ms;
+  absl::optional<int64_t> create_answer_ms;
+  absl::optional<int64_t> set_local_description_ms;
+  absl::optional<int64_t> set_remote_description_ms;
+  absl::optional<int64_t> ice_gathering_complete_ms;
+  absl::optional<int64_t> ice_connected_ms;
+  // ICE and DTLS are connected, so SRTP keys are set up.
+  absl::optional<int64_t> connected_ms;
+};
+
 // Internal interface for extra PeerConnection methods.
 class PeerConnectionInternal : public PeerConnectionInterface {
  public:
@@ -68,6 +83,8 @@ class PeerConnectionInternal : public PeerConnectionInterface {
 
   virtual Call::Stats GetCallStats() = 0;
 
+  virtual CallSetupTimes GetCallSetupTimes() const = 0;
+
   virtual bool GetLocalCertificate(
       const std::string& transport_name,
       rtc::scoped_refptr<rtc::RTCCertificate>* certificate) = 0;
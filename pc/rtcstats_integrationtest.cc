@@ -343,6 +343,8 @@ class RTCStatsReportVerifier {
     stats_types.insert(RTCInboundRTPStreamStats::kType);
     stats_types.insert(RTCOutboundRTPStreamStats::kType);
     stats_types.insert(RTCTransportStats::kType);
+    stats_types.insert(RTCThreadStats::kType);
+    stats_types.insert(RTCCallSetupStats::kType);
     return stats_types;
   }
 
@@ -396,6 +398,12 @@ class RTCStatsReportVerifier {
       } else if (stats.type() == RTCTransportStats::kType) {
         verify_successful &=
             VerifyRTCTransportStats(stats.cast_to<RTCTransportStats>());
+      } else if (stats.type() == RTCThreadStats::kType) {
+        verify_successful &=
+            VerifyRTCThreadStats(stats.cast_to<RTCThreadStats>());
+      } else if (stats.type() == RTCCallSetupStats::kType) {
+        verify_successful &=
+            VerifyRTCCallSetupStats(stats.cast_to<RTCCallSetupStats>());
       } else {
         EXPECT_TRUE(false) << "Unrecognized stats type: " << stats.type();
         verify_successful = false;
@@ -643,6 +651,34 @@ class RTCStatsReportVerifier {
     return verifier.ExpectAllMembersSuccessfullyTested();
   }
 
+  bool VerifyRTCThreadStats(const RTCThreadStats& thread) {
+    RTCStatsVerifier verifier(report_, &thread);
+    verifier.TestMemberIsDefined(thread.name);
+    verifier.TestMemberIsNonNegative<uint64_t>(thread.tasks_run);
+    verifier.TestMemberIsNonNegative<double>(thread.total_busy_time);
+    verifier.TestMemberIsNonNegative<double>(thread.total_queue_wait_time);
+    verifier.TestMemberIsNonNegative<double>(thread.max_task_duration);
+    return verifier.ExpectAllMembersSuccessfullyTested();
+  }
+
+  bool VerifyRTCCallSetupStats(const RTCCallSetupStats& call_setup) {
+    RTCStatsVerifier verifier(report_, &call_setup);
+    // One peer creates the offer and the other one the answer.
+    verifier.MarkMemberTested(call_setup.create_offer_time,
+                              call_setup.create_offer_time.is_defined() !=
+                                  call_setup.create_answer_time.is_defined());
+    verifier.MarkMemberTested(call_setup.create_answer_time, true);
+    verifier.TestMemberIsNonNegative<double>(
+        call_setup.set_local_description_time);
+    verifier.TestMemberIsNonNegative<double>(
+        call_setup.set_remote_description_time);
+    // Gathering may still be in progress when the stats are collected.
+    verifier.MarkMemberTested(call_setup.ice_gathering_complete_time, true);
+    verifier.TestMemberIsNonNegative<double>(call_setup.ice_connected_time);
+    verifier.TestMemberIsNonNegative<double>(call_setup.connected_time);
+    return verifier.ExpectAllMembersSuccessfullyTested();
+  }
+
   void VerifyRTCRTPStreamStats(const RTCRTPStreamStats& stream,
                                RTCStatsVerifier* verifier) {
     verifier->TestMemberIsDefined(stream.ssrc);
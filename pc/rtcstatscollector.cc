@@ -76,6 +76,10 @@ std::string RTCTransportStatsIDFromTransportChannel(
   return sb.str();
 }
 
+std::string RTCThreadStatsIDFromName(const char* name) {
+  return std::string("RTCThread_") + name;
+}
+
 std::string RTCInboundRTPStreamStatsIDFromSSRC(bool audio, uint32_t ssrc) {
   char buf[1024];
   rtc::SimpleStringBuilder sb(buf);
@@ -709,6 +713,13 @@ RTCStatsCollector::RequestInfo::RequestInfo(
                   nullptr,
                   std::move(selector)) {}
 
+RTCStatsCollector::RequestInfo::RequestInfo(
+    int64_t since_timestamp_us,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback)
+    : RequestInfo(FilterMode::kDelta, std::move(callback), nullptr, nullptr) {
+  since_timestamp_us_ = since_timestamp_us;
+}
+
 RTCStatsCollector::RequestInfo::RequestInfo(
     RTCStatsCollector::RequestInfo::FilterMode filter_mode,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback,
@@ -738,7 +749,8 @@ RTCStatsCollector::RTCStatsCollector(PeerConnectionInternal* pc,
       num_pending_partial_reports_(0),
       partial_report_timestamp_us_(0),
       cache_timestamp_us_(0),
-      cache_lifetime_us_(cache_lifetime_us) {
+      cache_lifetime_us_(cache_lifetime_us),
+      track_changes_(false) {
   RTC_DCHECK(pc_);
   RTC_DCHECK(signaling_thread_);
   RTC_DCHECK(worker_thread_);
@@ -769,6 +781,14 @@ void RTCStatsCollector::GetStatsReport(
   GetStatsReportInternal(RequestInfo(std::move(selector), std::move(callback)));
 }
 
+void RTCStatsCollector::GetStatsReportDelta(
+    int64_t since_timestamp_us,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  track_changes_ = true;
+  GetStatsReportInternal(RequestInfo(since_timestamp_us, std::move(callback)));
+}
+
 void RTCStatsCollector::GetStatsReportInternal(
     RTCStatsCollector::RequestInfo request) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
@@ -848,6 +868,8 @@ void RTCStatsCollector::ProducePartialResultsOnSignalingThread(
   ProduceMediaStreamStats_s(timestamp_us, report.get());
   ProduceMediaStreamTrackStats_s(timestamp_us, report.get());
   ProducePeerConnectionStats_s(timestamp_us, report.get());
+  ProduceThreadStats_s(timestamp_us, report.get());
+  ProduceCallSetupStats_s(timestamp_us, report.get());
 
   AddPartialResults(report);
 }
@@ -906,6 +928,8 @@ void RTCStatsCollector::AddPartialResults_s(
     // select the "webrtc_stats" category when recording traces.
     TRACE_EVENT_INSTANT1("webrtc_stats", "webrtc_stats", "report",
                          cached_report_->ToJson());
+    if (track_changes_)
+      UpdateChangeTimestamps(cached_report_);
 
     // Deliver report and clear |requests_|.
     std::vector<RequestInfo> requests;
@@ -914,6 +938,40 @@ void RTCStatsCollector::AddPartialResults_s(
   }
 }
 
+void RTCStatsCollector::UpdateChangeTimestamps(
+    rtc::scoped_refptr<const RTCStatsReport> report) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  // Stats objects that are gone are dropped along with the old map.
+  std::map<std::string, int64_t> change_timestamps_us;
+  for (const RTCStats& stats : *report) {
+    const RTCStats* previous =
+        tracked_report_ ? tracked_report_->Get(stats.id()) : nullptr;
+    auto it = change_timestamps_us_.find(stats.id());
+    // RTCStats::operator== ignores the timestamp, which every report updates.
+    if (previous && *previous == stats && it != change_timestamps_us_.end()) {
+      change_timestamps_us[stats.id()] = it->second;
+    } else {
+      change_timestamps_us[stats.id()] = report->timestamp_us();
+    }
+  }
+  change_timestamps_us_.swap(change_timestamps_us);
+  tracked_report_ = report;
+}
+
+rtc::scoped_refptr<RTCStatsReport> RTCStatsCollector::CreateDeltaReport(
+    int64_t since_timestamp_us) const {
+  RTC_DCHECK(tracked_report_);
+  rtc::scoped_refptr<RTCStatsReport> delta =
+      RTCStatsReport::Create(tracked_report_->timestamp_us());
+  for (const RTCStats& stats : *tracked_report_) {
+    auto it = change_timestamps_us_.find(stats.id());
+    RTC_DCHECK(it != change_timestamps_us_.end());
+    if (it->second > since_timestamp_us)
+      delta->AddStats(stats.copy());
+  }
+  return delta;
+}
+
 void RTCStatsCollector::DeliverCachedReport(
     rtc::scoped_refptr<const RTCStatsReport> cached_report,
     std::vector<RTCStatsCollector::RequestInfo> requests) {
@@ -924,6 +982,13 @@ void RTCStatsCollector::DeliverCachedReport(
   for (const RequestInfo& request : requests) {
     if (request.filter_mode() == RequestInfo::FilterMode::kAll) {
       request.callback()->OnStatsDelivered(cached_report);
+    } else if (request.filter_mode() == RequestInfo::FilterMode::kDelta) {
+      // The cached report may have been produced before changes were tracked.
+      // Otherwise |tracked_report_| is the most recent report.
+      if (!tracked_report_)
+        UpdateChangeTimestamps(cached_report);
+      request.callback()->OnStatsDelivered(
+          CreateDeltaReport(request.since_timestamp_us()));
     } else {
       bool filter_by_sender_selector;
       rtc::scoped_refptr<RtpSenderInternal> sender_selector;
@@ -1175,6 +1240,53 @@ void RTCStatsCollector::ProducePeerConnectionStats_s(
   report->AddStats(std::move(stats));
 }
 
+void RTCStatsCollector::ProduceThreadStats_s(
+    int64_t timestamp_us, RTCStatsReport* report) const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  const std::pair<const char*, rtc::Thread*> threads[] = {
+      {"signaling", signaling_thread_},
+      {"worker", worker_thread_},
+      {"network", network_thread_}};
+  for (const auto& thread : threads) {
+    // The load stats may be read on any thread.
+    rtc::MessageQueueLoadStats load = thread.second->GetLoadStats();
+    std::unique_ptr<RTCThreadStats> stats(new RTCThreadStats(
+        RTCThreadStatsIDFromName(thread.first), timestamp_us));
+    stats->name = thread.first;
+    stats->tasks_run = static_cast<uint64_t>(load.messages_dispatched);
+    stats->total_busy_time =
+        static_cast<double>(load.busy_time_us) / rtc::kNumMicrosecsPerSec;
+    stats->total_queue_wait_time =
+        static_cast<double>(load.queue_wait_time_us) / rtc::kNumMicrosecsPerSec;
+    stats->max_task_duration = static_cast<double>(load.max_dispatch_time_us) /
+                               rtc::kNumMicrosecsPerSec;
+    report->AddStats(std::move(stats));
+  }
+}
+
+void RTCStatsCollector::ProduceCallSetupStats_s(
+    int64_t timestamp_us, RTCStatsReport* report) const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  const CallSetupTimes times = pc_->GetCallSetupTimes();
+  std::unique_ptr<RTCCallSetupStats> stats(
+      new RTCCallSetupStats("RTCCallSetup", timestamp_us));
+  const std::pair<absl::optional<int64_t>, RTCStatsMember<double>*> stages[] =
+      {{times.create_offer_ms, &stats->create_offer_time},
+       {times.create_answer_ms, &stats->create_answer_time},
+       {times.set_local_description_ms, &stats->set_local_description_time},
+       {times.set_remote_description_ms, &stats->set_remote_description_time},
+       {times.ice_gathering_complete_ms, &stats->ice_gathering_complete_time},
+       {times.ice_connected_ms, &stats->ice_connected_time},
+       {times.connected_ms, &stats->connected_time}};
+  for (const auto& stage : stages) {
+    if (stage.first) {
+      *stage.second = static_cast<double>(*stage.first - times.created_ms) /
+                      rtc::kNumMillisecsPerSec;
+    }
+  }
+  report->AddStats(std::move(stats));
+}
+
 void RTCStatsCollector::ProduceRTPStreamStats_n(
     int64_t timestamp_us,
     const std::vector<RtpTransceiverStatsInfo>& transceiver_stats_infos,
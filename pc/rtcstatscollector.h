@@ -65,6 +65,15 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   // as: no RTP streams are received by selector). The result is empty.
   void GetStatsReport(rtc::scoped_refptr<RtpReceiverInternal> selector,
                       rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+  // Gets a recent stats report containing only the stats objects that have
+  // changed since the report with timestamp |since_timestamp_us|, so that a
+  // caller polling the stats only has to process the changes. Pass the
+  // timestamp of the previous report received, or 0 for all stats. Stats
+  // objects that no longer exist are not reported; their removal can only be
+  // seen by comparing the ids with those of a full report.
+  void GetStatsReportDelta(
+      int64_t since_timestamp_us,
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
   // Clears the cache's reference to the most recent stats report. Subsequently
   // calling |GetStatsReport| guarantees fresh stats.
   void ClearCachedStatsReport();
@@ -89,7 +98,7 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
  private:
   class RequestInfo {
    public:
-    enum class FilterMode { kAll, kSenderSelector, kReceiverSelector };
+    enum class FilterMode { kAll, kSenderSelector, kReceiverSelector, kDelta };
 
     // Constructs with FilterMode::kAll.
     explicit RequestInfo(
@@ -102,6 +111,9 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
     // applied even if |selector| is null, resulting in an empty report.
     RequestInfo(rtc::scoped_refptr<RtpReceiverInternal> selector,
                 rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+    // Constructs with FilterMode::kDelta.
+    RequestInfo(int64_t since_timestamp_us,
+                rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
 
     FilterMode filter_mode() const { return filter_mode_; }
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback() const {
@@ -115,6 +127,10 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
       RTC_DCHECK(filter_mode_ == FilterMode::kReceiverSelector);
       return receiver_selector_;
     }
+    int64_t since_timestamp_us() const {
+      RTC_DCHECK(filter_mode_ == FilterMode::kDelta);
+      return since_timestamp_us_;
+    }
 
    private:
     RequestInfo(FilterMode filter_mode,
@@ -126,6 +142,7 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback_;
     rtc::scoped_refptr<RtpSenderInternal> sender_selector_;
     rtc::scoped_refptr<RtpReceiverInternal> receiver_selector_;
+    int64_t since_timestamp_us_ = 0;
   };
 
   void GetStatsReportInternal(RequestInfo request);
@@ -151,6 +168,13 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   };
 
   void AddPartialResults_s(rtc::scoped_refptr<RTCStatsReport> partial_report);
+  // Records which stats objects of |report| differ from those of
+  // |tracked_report_| and makes |report| the tracked report.
+  void UpdateChangeTimestamps(rtc::scoped_refptr<const RTCStatsReport> report);
+  // Copies the stats objects of |tracked_report_| that have changed after
+  // |since_timestamp_us|.
+  rtc::scoped_refptr<RTCStatsReport> CreateDeltaReport(
+      int64_t since_timestamp_us) const;
   void DeliverCachedReport(
       rtc::scoped_refptr<const RTCStatsReport> cached_report,
       std::vector<RequestInfo> requests);
@@ -184,6 +208,12 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   // Produces |RTCPeerConnectionStats|.
   void ProducePeerConnectionStats_s(int64_t timestamp_us,
                                     RTCStatsReport* report) const;
+  // Produces |RTCThreadStats|.
+  void ProduceThreadStats_s(int64_t timestamp_us,
+                            RTCStatsReport* report) const;
+  // Produces |RTCCallSetupStats|.
+  void ProduceCallSetupStats_s(int64_t timestamp_us,
+                               RTCStatsReport* report) const;
   // Produces |RTCInboundRTPStreamStats| and |RTCOutboundRTPStreamStats|.
   void ProduceRTPStreamStats_n(
       int64_t timestamp_us,
@@ -245,6 +275,14 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   int64_t cache_lifetime_us_;
   rtc::scoped_refptr<const RTCStatsReport> cached_report_;
 
+  // Set by the first |GetStatsReportDelta|. From then on every new report is
+  // compared with the previous one, |tracked_report_|, and the timestamp of the
+  // report in which each stats object last changed is kept, by stats id, in
+  // |change_timestamps_us_|.
+  bool track_changes_;
+  rtc::scoped_refptr<const RTCStatsReport> tracked_report_;
+  std::map<std::string, int64_t> change_timestamps_us_;
+
   // Data recorded and maintained by the stats collector during its lifetime.
   // Some stats are produced from this record instead of other components.
   struct InternalRecord {
@@ -119,6 +119,12 @@ std::string IdForType(const RTCStatsReport* report) {
   }
 }
 
+// Returns the number of stats in a report, not counting |RTCThreadStats|,
+// which change whenever the threads run.
+size_t SizeWithoutThreadStats(const RTCStatsReport* report) {
+  return report->size() - report->GetStatsOfType<RTCThreadStats>().size();
+}
+
 std::unique_ptr<CertificateInfo> CreateFakeCertificateAndInfoFromDers(
     const std::vector<std::string>& ders) {
   RTC_CHECK(!ders.empty());
@@ -316,6 +322,13 @@ class RTCStatsCollectorWrapper {
     return WaitForReport(callback);
   }
 
+  rtc::scoped_refptr<const RTCStatsReport> GetStatsReportDelta(
+      int64_t since_timestamp_us) {
+    rtc::scoped_refptr<RTCStatsObtainer> callback = RTCStatsObtainer::Create();
+    stats_collector_->GetStatsReportDelta(since_timestamp_us, callback);
+    return WaitForReport(callback);
+  }
+
   rtc::scoped_refptr<const RTCStatsReport> GetFreshStatsReport() {
     stats_collector_->ClearCachedStatsReport();
     return GetStatsReport();
@@ -604,10 +617,13 @@ class RTCStatsCollectorTest : public testing::Test {
     //          |        |     |       |
     //          v        v     v       v
     // codec (send)     transport     codec (recv)     peer-connection
+    //
+    // The report also contains one thread per peer connection thread and the
+    // call setup.
 
     // Verify the stats graph is set up correctly.
     graph.full_report = stats_->GetStatsReport();
-    EXPECT_EQ(graph.full_report->size(), 9u);
+    EXPECT_EQ(graph.full_report->size(), 9u + 3u + 1u);
     EXPECT_TRUE(graph.full_report->Get(graph.send_codec_id));
     EXPECT_TRUE(graph.full_report->Get(graph.recv_codec_id));
     EXPECT_TRUE(graph.full_report->Get(graph.outbound_rtp_id));
@@ -688,6 +704,42 @@ TEST_F(RTCStatsCollectorTest, MultipleCallbacksWithInvalidatedCacheInBetween) {
   EXPECT_NE(c.get(), b.get());
 }
 
+TEST_F(RTCStatsCollectorTest, DeltaReportsContainChangedStats) {
+  rtc::scoped_refptr<DataChannel> dummy_channel = DataChannel::Create(
+      nullptr, cricket::DCT_NONE, "DummyChannel", InternalDataChannelInit());
+  pc_->SignalDataChannelCreated()(dummy_channel.get());
+
+  rtc::scoped_refptr<const RTCStatsReport> full = stats_->GetStatsReport();
+  rtc::scoped_refptr<const RTCStatsReport> delta =
+      stats_->GetStatsReportDelta(0);
+  EXPECT_EQ(full->timestamp_us(), delta->timestamp_us());
+  EXPECT_EQ(full->size(), delta->size());
+  EXPECT_TRUE(delta->Get("RTCPeerConnection"));
+
+  // Nothing has changed since the previous report.
+  fake_clock_.AdvanceTime(TimeDelta::ms(51));
+  int64_t previous_timestamp_us = delta->timestamp_us();
+  delta = stats_->GetStatsReportDelta(previous_timestamp_us);
+  EXPECT_GT(delta->timestamp_us(), previous_timestamp_us);
+  EXPECT_EQ(0u, SizeWithoutThreadStats(delta));
+
+  // Only the peer connection stats change when the channel is opened.
+  dummy_channel->SignalOpened(dummy_channel.get());
+  fake_clock_.AdvanceTime(TimeDelta::ms(51));
+  previous_timestamp_us = delta->timestamp_us();
+  delta = stats_->GetStatsReportDelta(previous_timestamp_us);
+  EXPECT_EQ(1u, SizeWithoutThreadStats(delta));
+  ASSERT_TRUE(delta->Get("RTCPeerConnection"));
+  EXPECT_EQ(1u, *delta->Get("RTCPeerConnection")
+                     ->cast_to<RTCPeerConnectionStats>()
+                     .data_channels_opened);
+
+  // The change is also reported relative to an older report.
+  delta = stats_->GetStatsReportDelta(full->timestamp_us());
+  EXPECT_EQ(1u, SizeWithoutThreadStats(delta));
+  EXPECT_TRUE(delta->Get("RTCPeerConnection"));
+}
+
 TEST_F(RTCStatsCollectorTest, CollectRTCCertificateStatsSingle) {
   const char kTransportName[] = "transport";
 
@@ -1847,6 +1899,41 @@ TEST_F(RTCStatsCollectorTest, CollectRTCOutboundRTPStreamStats_Video) {
   EXPECT_TRUE(report->Get(*expected_video.codec_id));
 }
 
+TEST_F(RTCStatsCollectorTest, CollectRTCThreadStats) {
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+  EXPECT_EQ(3u, report->GetStatsOfType<RTCThreadStats>().size());
+  for (const char* name : {"signaling", "worker", "network"}) {
+    const RTCStats* stats = report->Get(std::string("RTCThread_") + name);
+    ASSERT_TRUE(stats);
+    const RTCThreadStats& thread = stats->cast_to<RTCThreadStats>();
+    EXPECT_EQ(name, *thread.name);
+    EXPECT_TRUE(thread.tasks_run.is_defined());
+    EXPECT_GE(*thread.total_busy_time, 0.0);
+    EXPECT_GE(*thread.total_queue_wait_time, 0.0);
+    EXPECT_LE(*thread.max_task_duration, *thread.total_busy_time);
+  }
+}
+
+TEST_F(RTCStatsCollectorTest, CollectRTCCallSetupStats) {
+  CallSetupTimes times;
+  times.created_ms = 1000;
+  times.create_offer_ms = 1010;
+  times.set_local_description_ms = 1020;
+  times.set_remote_description_ms = 1500;
+  times.ice_connected_ms = 2000;
+  pc_->SetCallSetupTimes(times);
+
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+  RTCCallSetupStats expected("RTCCallSetup", report->timestamp_us());
+  expected.create_offer_time = 0.01;
+  expected.set_local_description_time = 0.02;
+  expected.set_remote_description_time = 0.5;
+  expected.ice_connected_time = 1.0;
+  ASSERT_TRUE(report->Get("RTCCallSetup"));
+  EXPECT_EQ(expected,
+            report->Get("RTCCallSetup")->cast_to<RTCCallSetupStats>());
+}
+
 TEST_F(RTCStatsCollectorTest, CollectRTCTransportStats) {
   const char kTransportName[] = "transport";
 
@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "api/mediastreamproxy.h"
 #include "api/mediastreamtrackproxy.h"
 #include "api/videosourceproxy.h"
@@ -24,6 +25,7 @@
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -63,8 +65,63 @@ void MaybeAttachFrameDecryptorToMediaChannel(
   }
 }
 
+std::unique_ptr<RtpSourcesSnapshot> MaybeCreateSourcesSnapshot(
+    rtc::Thread* worker_thread) {
+  if (!field_trial::IsEnabled("WebRTC-RtpSourcesSnapshot")) {
+    return nullptr;
+  }
+  return absl::make_unique<RtpSourcesSnapshot>(worker_thread);
+}
+
 }  // namespace
 
+RtpSourcesSnapshot::RtpSourcesSnapshot(rtc::Thread* worker_thread)
+    : worker_thread_(worker_thread) {
+  RTC_DCHECK(worker_thread_);
+}
+
+RtpSourcesSnapshot::~RtpSourcesSnapshot() = default;
+
+std::vector<RtpSource> RtpSourcesSnapshot::Get(
+    std::function<std::vector<RtpSource>()> get_sources) {
+  {
+    rtc::CritScope lock(&lock_);
+    if (sources_) {
+      if (!refresh_pending_) {
+        refresh_pending_ = true;
+        invoker_.AsyncInvoke<void>(
+            RTC_FROM_HERE, worker_thread_, [this, get_sources] {
+              std::vector<RtpSource> sources = get_sources();
+              rtc::CritScope lock(&lock_);
+              sources_ = std::move(sources);
+              refresh_pending_ = false;
+            });
+      }
+      return *sources_;
+    }
+  }
+  std::vector<RtpSource> sources =
+      worker_thread_->Invoke<std::vector<RtpSource>>(RTC_FROM_HERE,
+                                                     get_sources);
+  rtc::CritScope lock(&lock_);
+  sources_ = sources;
+  return sources;
+}
+
+void RtpSourcesSnapshot::Reset() {
+  bool refresh_pending;
+  {
+    rtc::CritScope lock(&lock_);
+    refresh_pending = refresh_pending_;
+  }
+  if (refresh_pending) {
+    invoker_.Flush(worker_thread_);
+  }
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK(!refresh_pending_);
+  sources_.reset();
+}
+
 AudioRtpReceiver::AudioRtpReceiver(rtc::Thread* worker_thread,
                                    std::string receiver_id,
                                    std::vector<std::string> stream_ids)
@@ -82,7 +139,8 @@ AudioRtpReceiver::AudioRtpReceiver(
       track_(AudioTrackProxy::Create(rtc::Thread::Current(),
                                      AudioTrack::Create(receiver_id, source_))),
       cached_track_enabled_(track_->enabled()),
-      attachment_id_(GenerateUniqueId()) {
+      attachment_id_(GenerateUniqueId()),
+      sources_snapshot_(MaybeCreateSourcesSnapshot(worker_thread)) {
   RTC_DCHECK(worker_thread_);
   RTC_DCHECK(track_->GetSource()->remote());
   track_->RegisterObserver(this);
@@ -179,6 +237,9 @@ void AudioRtpReceiver::Stop() {
   if (stopped_) {
     return;
   }
+  if (sources_snapshot_) {
+    sources_snapshot_->Reset();
+  }
   if (media_channel_ && ssrc_) {
     // Allow that SetOutputVolume fail. This is the normal case when the
     // underlying media channel has already been deleted.
@@ -196,6 +257,9 @@ void AudioRtpReceiver::SetupMediaChannel(uint32_t ssrc) {
   if (ssrc_ == ssrc) {
     return;
   }
+  if (sources_snapshot_) {
+    sources_snapshot_->Reset();
+  }
   if (ssrc_) {
     source_->Stop(media_channel_, *ssrc_);
   }
@@ -245,6 +309,12 @@ std::vector<RtpSource> AudioRtpReceiver::GetSources() const {
   if (!media_channel_ || !ssrc_ || stopped_) {
     return {};
   }
+  if (sources_snapshot_) {
+    cricket::VoiceMediaChannel* const media_channel = media_channel_;
+    const uint32_t ssrc = *ssrc_;
+    return sources_snapshot_->Get(
+        [media_channel, ssrc] { return media_channel->GetSources(ssrc); });
+  }
   return worker_thread_->Invoke<std::vector<RtpSource>>(
       RTC_FROM_HERE, [&] { return media_channel_->GetSources(*ssrc_); });
 }
@@ -275,6 +345,9 @@ void AudioRtpReceiver::SetObserver(RtpReceiverObserverInterface* observer) {
 void AudioRtpReceiver::SetMediaChannel(cricket::MediaChannel* media_channel) {
   RTC_DCHECK(media_channel == nullptr ||
              media_channel->media_type() == media_type());
+  if (sources_snapshot_) {
+    sources_snapshot_->Reset();
+  }
   media_channel_ = static_cast<cricket::VoiceMediaChannel*>(media_channel);
 }
 
@@ -308,7 +381,8 @@ VideoRtpReceiver::VideoRtpReceiver(
                                             worker_thread,
                                             source_),
               worker_thread))),
-      attachment_id_(GenerateUniqueId()) {
+      attachment_id_(GenerateUniqueId()),
+      sources_snapshot_(MaybeCreateSourcesSnapshot(worker_thread)) {
   RTC_DCHECK(worker_thread_);
   SetStreams(streams);
   source_->SetState(MediaSourceInterface::kLive);
@@ -374,6 +448,9 @@ void VideoRtpReceiver::Stop() {
   if (stopped_) {
     return;
   }
+  if (sources_snapshot_) {
+    sources_snapshot_->Reset();
+  }
   source_->SetState(MediaSourceInterface::kEnded);
   if (!media_channel_ || !ssrc_) {
     RTC_LOG(LS_WARNING) << "VideoRtpReceiver::Stop: No video channel exists.";
@@ -393,6 +470,9 @@ void VideoRtpReceiver::SetupMediaChannel(uint32_t ssrc) {
   if (ssrc_ == ssrc) {
     return;
   }
+  if (sources_snapshot_) {
+    sources_snapshot_->Reset();
+  }
   if (ssrc_) {
     SetSink(nullptr);
   }
@@ -451,6 +531,9 @@ void VideoRtpReceiver::SetObserver(RtpReceiverObserverInterface* observer) {
 void VideoRtpReceiver::SetMediaChannel(cricket::MediaChannel* media_channel) {
   RTC_DCHECK(media_channel == nullptr ||
              media_channel->media_type() == media_type());
+  if (sources_snapshot_) {
+    sources_snapshot_->Reset();
+  }
   media_channel_ = static_cast<cricket::VideoMediaChannel*>(media_channel);
 }
 
@@ -465,6 +548,12 @@ std::vector<RtpSource> VideoRtpReceiver::GetSources() const {
   if (!media_channel_ || !ssrc_ || stopped_) {
     return {};
   }
+  if (sources_snapshot_) {
+    cricket::VideoMediaChannel* const media_channel = media_channel_;
+    const uint32_t ssrc = *ssrc_;
+    return sources_snapshot_->Get(
+        [media_channel, ssrc] { return media_channel->GetSources(ssrc); });
+  }
   return worker_thread_->Invoke<std::vector<RtpSource>>(
       RTC_FROM_HERE, [&] { return media_channel_->GetSources(*ssrc_); });
 }
@@ -16,6 +16,8 @@
 #define PC_RTPRECEIVER_H_
 
 #include <stdint.h>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -32,6 +34,8 @@
 #include "media/base/videobroadcaster.h"
 #include "pc/remoteaudiosource.h"
 #include "pc/videotracksource.h"
+#include "rtc_base/asyncinvoker.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/refcountedobject.h"
 #include "rtc_base/scoped_ref_ptr.h"
 #include "rtc_base/thread.h"
@@ -78,6 +82,34 @@ class RtpReceiverInternal : public RtpReceiverInterface {
   virtual int AttachmentId() const = 0;
 };
 
+// Snapshot of the sources of a receiver, refreshed asynchronously on the worker
+// thread so that polling GetSources() doesn't block the signaling thread on
+// every call. Get() returns the sources as of the previous refresh and
+// requests the next one; only the first call after creation or Reset() waits
+// for the worker thread. Enabled with the "WebRTC-RtpSourcesSnapshot" field
+// trial.
+class RtpSourcesSnapshot {
+ public:
+  explicit RtpSourcesSnapshot(rtc::Thread* worker_thread);
+  ~RtpSourcesSnapshot();
+
+  // |get_sources| is called on the worker thread. It must stay valid until
+  // the next call to Reset().
+  std::vector<RtpSource> Get(
+      std::function<std::vector<RtpSource>()> get_sources);
+
+  // Waits for a pending refresh and drops the snapshot. Must be called before
+  // the media channel or the SSRC the sources are taken from change.
+  void Reset();
+
+ private:
+  rtc::Thread* const worker_thread_;
+  rtc::CriticalSection lock_;
+  absl::optional<std::vector<RtpSource>> sources_ RTC_GUARDED_BY(lock_);
+  bool refresh_pending_ RTC_GUARDED_BY(lock_) = false;
+  rtc::AsyncInvoker invoker_;
+};
+
 class AudioRtpReceiver : public ObserverInterface,
                          public AudioSourceInterface::AudioObserver,
                          public rtc::RefCountedObject<RtpReceiverInternal> {
@@ -160,6 +192,8 @@ class AudioRtpReceiver : public ObserverInterface,
   bool received_first_packet_ = false;
   int attachment_id_ = 0;
   rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor_;
+  // Null unless the "WebRTC-RtpSourcesSnapshot" field trial is enabled.
+  const std::unique_ptr<RtpSourcesSnapshot> sources_snapshot_;
 };
 
 class VideoRtpReceiver : public rtc::RefCountedObject<RtpReceiverInternal> {
@@ -257,6 +291,8 @@ class VideoRtpReceiver : public rtc::RefCountedObject<RtpReceiverInternal> {
   bool received_first_packet_ = false;
   int attachment_id_ = 0;
   rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor_;
+  // Null unless the "WebRTC-RtpSourcesSnapshot" field trial is enabled.
+  const std::unique_ptr<RtpSourcesSnapshot> sources_snapshot_;
 };
 
 }  // namespace webrtc
@@ -106,6 +106,39 @@ bool UnimplementedRtpParameterHasValue(const RtpParameters& parameters) {
   return false;
 }
 
+namespace {
+
+// Checks the sender state for a call to SetParameters() with |parameters|.
+RTCError CheckSetParameters(
+    bool stopped,
+    const absl::optional<std::string>& last_transaction_id,
+    const RtpParameters& parameters) {
+  if (stopped) {
+    return RTCError(RTCErrorType::INVALID_STATE);
+  }
+  if (!last_transaction_id) {
+    LOG_AND_RETURN_ERROR(
+        RTCErrorType::INVALID_STATE,
+        "Failed to set parameters since getParameters() has never been called"
+        " on this sender");
+  }
+  if (last_transaction_id != parameters.transaction_id) {
+    LOG_AND_RETURN_ERROR(
+        RTCErrorType::INVALID_MODIFICATION,
+        "Failed to set parameters since the transaction_id doesn't match"
+        " the last value returned from getParameters()");
+  }
+
+  if (UnimplementedRtpParameterHasValue(parameters)) {
+    LOG_AND_RETURN_ERROR(
+        RTCErrorType::UNSUPPORTED_PARAMETER,
+        "Attempted to set an unimplemented parameter of RtpParameters.");
+  }
+  return RTCError::OK();
+}
+
+}  // namespace
+
 LocalAudioSinkAdapter::LocalAudioSinkAdapter() : sink_(nullptr) {}
 
 LocalAudioSinkAdapter::~LocalAudioSinkAdapter() {
@@ -268,26 +301,10 @@ RtpParameters AudioRtpSender::GetParameters() {
 
 RTCError AudioRtpSender::SetParameters(const RtpParameters& parameters) {
   TRACE_EVENT0("webrtc", "AudioRtpSender::SetParameters");
-  if (stopped_) {
-    return RTCError(RTCErrorType::INVALID_STATE);
-  }
-  if (!last_transaction_id_) {
-    LOG_AND_RETURN_ERROR(
-        RTCErrorType::INVALID_STATE,
-        "Failed to set parameters since getParameters() has never been called"
-        " on this sender");
-  }
-  if (last_transaction_id_ != parameters.transaction_id) {
-    LOG_AND_RETURN_ERROR(
-        RTCErrorType::INVALID_MODIFICATION,
-        "Failed to set parameters since the transaction_id doesn't match"
-        " the last value returned from getParameters()");
-  }
-
-  if (UnimplementedRtpParameterHasValue(parameters)) {
-    LOG_AND_RETURN_ERROR(
-        RTCErrorType::UNSUPPORTED_PARAMETER,
-        "Attempted to set an unimplemented parameter of RtpParameters.");
+  RTCError error =
+      CheckSetParameters(stopped_, last_transaction_id_, parameters);
+  if (!error.ok()) {
+    return error;
   }
   if (!media_channel_) {
     auto result = cricket::ValidateRtpParameters(init_parameters_, parameters);
@@ -375,6 +392,9 @@ void AudioRtpSender::Stop() {
   if (stopped_) {
     return;
   }
+  if (pending_set_parameters_ > 0) {
+    invoker_.Flush(worker_thread_);
+  }
   if (track_) {
     track_->RemoveSink(sink_adapter_.get());
     track_->UnregisterObserver(this);
@@ -389,9 +409,48 @@ void AudioRtpSender::Stop() {
   stopped_ = true;
 }
 
+void AudioRtpSender::SetParametersAsync(
+    const RtpParameters& parameters,
+    std::function<void(RTCError)> callback) {
+  TRACE_EVENT0("webrtc", "AudioRtpSender::SetParametersAsync");
+  RTCError error =
+      CheckSetParameters(stopped_, last_transaction_id_, parameters);
+  if (!error.ok()) {
+    callback(std::move(error));
+    return;
+  }
+  if (!media_channel_) {
+    callback(SetParameters(parameters));
+    return;
+  }
+  last_transaction_id_.reset();
+  ++pending_set_parameters_;
+  rtc::Thread* const calling_thread = rtc::Thread::Current();
+  cricket::VoiceMediaChannel* const media_channel = media_channel_;
+  const uint32_t ssrc = ssrc_;
+  invoker_.AsyncInvoke<void>(
+      RTC_FROM_HERE, worker_thread_,
+      [this, calling_thread, media_channel, ssrc, parameters, callback] {
+        RTCError result =
+            media_channel->SetRtpSendParameters(ssrc, parameters);
+        // RTCError is move-only, so it's passed along as type and message.
+        RTCErrorType type = result.type();
+        std::string message = result.message();
+        invoker_.AsyncInvoke<void>(
+            RTC_FROM_HERE, calling_thread, [this, callback, type, message] {
+              --pending_set_parameters_;
+              callback(RTCError(type, message));
+            });
+      });
+}
+
 void AudioRtpSender::SetMediaChannel(cricket::MediaChannel* media_channel) {
   RTC_DCHECK(media_channel == nullptr ||
              media_channel->media_type() == media_type());
+  if (pending_set_parameters_ > 0) {
+    // Apply the pending parameters to the media channel they were set for.
+    invoker_.Flush(worker_thread_);
+  }
   media_channel_ = static_cast<cricket::VoiceMediaChannel*>(media_channel);
 }
 
@@ -522,26 +581,10 @@ RtpParameters VideoRtpSender::GetParameters() {
 
 RTCError VideoRtpSender::SetParameters(const RtpParameters& parameters) {
   TRACE_EVENT0("webrtc", "VideoRtpSender::SetParameters");
-  if (stopped_) {
-    return RTCError(RTCErrorType::INVALID_STATE);
-  }
-  if (!last_transaction_id_) {
-    LOG_AND_RETURN_ERROR(
-        RTCErrorType::INVALID_STATE,
-        "Failed to set parameters since getParameters() has never been called"
-        " on this sender");
-  }
-  if (last_transaction_id_ != parameters.transaction_id) {
-    LOG_AND_RETURN_ERROR(
-        RTCErrorType::INVALID_MODIFICATION,
-        "Failed to set parameters since the transaction_id doesn't match"
-        " the last value returned from getParameters()");
-  }
-
-  if (UnimplementedRtpParameterHasValue(parameters)) {
-    LOG_AND_RETURN_ERROR(
-        RTCErrorType::UNSUPPORTED_PARAMETER,
-        "Attempted to set an unimplemented parameter of RtpParameters.");
+  RTCError error =
+      CheckSetParameters(stopped_, last_transaction_id_, parameters);
+  if (!error.ok()) {
+    return error;
   }
   if (!media_channel_) {
     auto result = cricket::ValidateRtpParameters(init_parameters_, parameters);
@@ -623,6 +666,9 @@ void VideoRtpSender::Stop() {
   if (stopped_) {
     return;
   }
+  if (pending_set_parameters_ > 0) {
+    invoker_.Flush(worker_thread_);
+  }
   if (track_) {
     track_->UnregisterObserver(this);
   }
@@ -633,9 +679,48 @@ void VideoRtpSender::Stop() {
   stopped_ = true;
 }
 
+void VideoRtpSender::SetParametersAsync(
+    const RtpParameters& parameters,
+    std::function<void(RTCError)> callback) {
+  TRACE_EVENT0("webrtc", "VideoRtpSender::SetParametersAsync");
+  RTCError error =
+      CheckSetParameters(stopped_, last_transaction_id_, parameters);
+  if (!error.ok()) {
+    callback(std::move(error));
+    return;
+  }
+  if (!media_channel_) {
+    callback(SetParameters(parameters));
+    return;
+  }
+  last_transaction_id_.reset();
+  ++pending_set_parameters_;
+  rtc::Thread* const calling_thread = rtc::Thread::Current();
+  cricket::VideoMediaChannel* const media_channel = media_channel_;
+  const uint32_t ssrc = ssrc_;
+  invoker_.AsyncInvoke<void>(
+      RTC_FROM_HERE, worker_thread_,
+      [this, calling_thread, media_channel, ssrc, parameters, callback] {
+        RTCError result =
+            media_channel->SetRtpSendParameters(ssrc, parameters);
+        // RTCError is move-only, so it's passed along as type and message.
+        RTCErrorType type = result.type();
+        std::string message = result.message();
+        invoker_.AsyncInvoke<void>(
+            RTC_FROM_HERE, calling_thread, [this, callback, type, message] {
+              --pending_set_parameters_;
+              callback(RTCError(type, message));
+            });
+      });
+}
+
 void VideoRtpSender::SetMediaChannel(cricket::MediaChannel* media_channel) {
   RTC_DCHECK(media_channel == nullptr ||
              media_channel->media_type() == media_type());
+  if (pending_set_parameters_ > 0) {
+    // Apply the pending parameters to the media channel they were set for.
+    invoker_.Flush(worker_thread_);
+  }
   media_channel_ = static_cast<cricket::VideoMediaChannel*>(media_channel);
 }
 
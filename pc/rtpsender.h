@@ -15,6 +15,7 @@
 #ifndef PC_RTPSENDER_H_
 #define PC_RTPSENDER_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@
 #include "media/base/audiosource.h"
 #include "media/base/mediachannel.h"
 #include "pc/dtmfsender.h"
+#include "rtc_base/asyncinvoker.h"
 #include "rtc_base/criticalsection.h"
 
 namespace webrtc {
@@ -53,6 +55,14 @@ class RtpSenderInternal : public RtpSenderInterface {
 
   virtual void Stop() = 0;
 
+  // Like SetParameters(), but doesn't wait for the worker thread to apply the
+  // parameters to the media channel. |callback| is invoked on the current
+  // thread with the result, unless the sender is destroyed first. Errors found
+  // before the parameters are handed to the worker thread are passed to
+  // |callback| before this method returns.
+  virtual void SetParametersAsync(const RtpParameters& parameters,
+                                  std::function<void(RTCError)> callback) = 0;
+
   // Returns an ID that changes every time SetTrack() is called, but
   // otherwise remains constant. Used to generate IDs for stats.
   // The special value zero means that no track is attached.
@@ -150,6 +160,9 @@ class AudioRtpSender : public DtmfProviderInterface,
 
   void Stop() override;
 
+  void SetParametersAsync(const RtpParameters& parameters,
+                          std::function<void(RTCError)> callback) override;
+
   int AttachmentId() const override { return attachment_id_; }
 
   void SetMediaChannel(cricket::MediaChannel* media_channel) override;
@@ -184,6 +197,10 @@ class AudioRtpSender : public DtmfProviderInterface,
   std::unique_ptr<LocalAudioSinkAdapter> sink_adapter_;
   int attachment_id_ = 0;
   rtc::scoped_refptr<FrameEncryptorInterface> frame_encryptor_;
+  // The number of SetParametersAsync() calls that haven't completed. These
+  // must be flushed before the media channel is replaced.
+  int pending_set_parameters_ = 0;
+  rtc::AsyncInvoker invoker_;
 };
 
 class VideoRtpSender : public ObserverInterface,
@@ -241,6 +258,10 @@ class VideoRtpSender : public ObserverInterface,
   }
 
   void Stop() override;
+
+  void SetParametersAsync(const RtpParameters& parameters,
+                          std::function<void(RTCError)> callback) override;
+
   int AttachmentId() const override { return attachment_id_; }
 
   void SetMediaChannel(cricket::MediaChannel* media_channel) override;
@@ -266,6 +287,10 @@ class VideoRtpSender : public ObserverInterface,
   bool stopped_ = false;
   int attachment_id_ = 0;
   rtc::scoped_refptr<FrameEncryptorInterface> frame_encryptor_;
+  // The number of SetParametersAsync() calls that haven't completed. These
+  // must be flushed before the media channel is replaced.
+  int pending_set_parameters_ = 0;
+  rtc::AsyncInvoker invoker_;
 };
 
 }  // namespace webrtc
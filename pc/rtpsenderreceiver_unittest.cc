@@ -874,6 +874,41 @@ TEST_F(RtpSenderReceiverTest, SetAudioMaxSendBitrate) {
   DestroyAudioRtpSender();
 }
 
+TEST_F(RtpSenderReceiverTest, SetAudioMaxSendBitrateAsync) {
+  CreateAudioRtpSender();
+
+  webrtc::RtpParameters params = audio_rtp_sender_->GetParameters();
+  params.encodings[0].max_bitrate_bps = 1000;
+  absl::optional<RTCErrorType> result;
+  audio_rtp_sender_->SetParametersAsync(
+      params, [&result](RTCError error) { result = error.type(); });
+  // The parameters are applied on the worker thread, which is the current
+  // thread in this test, so nothing has happened yet.
+  EXPECT_FALSE(result);
+  EXPECT_TRUE_WAIT(result.has_value(), kDefaultTimeout);
+  EXPECT_EQ(RTCErrorType::NONE, *result);
+
+  params = voice_media_channel_->GetRtpSendParameters(kAudioSsrc);
+  EXPECT_EQ(1000, params.encodings[0].max_bitrate_bps);
+
+  DestroyAudioRtpSender();
+}
+
+TEST_F(RtpSenderReceiverTest,
+       AudioSenderSetParametersAsyncFailsImmediatelyOnStaleTransactionId) {
+  CreateAudioRtpSender();
+
+  webrtc::RtpParameters params = audio_rtp_sender_->GetParameters();
+  params.transaction_id = "stale";
+  absl::optional<RTCErrorType> result;
+  audio_rtp_sender_->SetParametersAsync(
+      params, [&result](RTCError error) { result = error.type(); });
+  ASSERT_TRUE(result);
+  EXPECT_EQ(RTCErrorType::INVALID_MODIFICATION, *result);
+
+  DestroyAudioRtpSender();
+}
+
 TEST_F(RtpSenderReceiverTest, SetAudioBitratePriority) {
   CreateAudioRtpSender();
 
@@ -23,9 +23,34 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 
+namespace {
+
+// The number of received packet buffers that are recycled. Buffers are
+// returned to the pool once the packet has been handed to the media engine,
+// so this bounds the memory kept by the pool rather than the number of packets
+// in flight.
+const size_t kReceiveBufferPoolSize = 64;
+
+}  // namespace
+
+RtpTransport::RtpTransport(bool rtcp_mux_enabled)
+    : rtcp_mux_enabled_(rtcp_mux_enabled),
+      receive_buffer_pool_(cricket::kMaxRtpPacketLen, kReceiveBufferPoolSize) {}
+
+RtpTransport::~RtpTransport() {
+  int64_t num_packets =
+      receive_buffer_pool_.hits() + receive_buffer_pool_.misses();
+  if (num_packets > 0) {
+    RTC_HISTOGRAM_PERCENTAGE(
+        "WebRTC.RtpTransport.ReceiveBufferPoolHitPercent",
+        static_cast<int>(receive_buffer_pool_.hits() * 100 / num_packets));
+  }
+}
+
 void RtpTransport::SetRtcpMuxEnabled(bool enable) {
   rtcp_mux_enabled_ = enable;
   MaybeSignalReadyToSend();
@@ -266,7 +291,7 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
     return;
   }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
+  rtc::CopyOnWriteBuffer packet = receive_buffer_pool_.Create(data, len);
   // Protect ourselves against crazy data.
   if (!cricket::IsValidRtpRtcpPacketSize(rtcp, packet.size())) {
     RTC_LOG(LS_ERROR) << "Dropping incoming "
@@ -15,6 +15,7 @@
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/sslstreamadapter.h"
+#include "rtc_base/timeutils.h"
 #include "system_wrappers/include/metrics.h"
 #include "third_party/libsrtp/include/srtp.h"
 #include "third_party/libsrtp/include/srtp_priv.h"
@@ -68,6 +69,13 @@ bool SrtpSession::UpdateRecv(int cs,
 
 bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  int64_t start_us = rtc::TimeMicros();
+  bool res = DoProtectRtp(p, in_len, max_len, out_len);
+  crypto_stats_.protect_time_us += rtc::TimeMicros() - start_us;
+  return res;
+}
+
+bool SrtpSession::DoProtectRtp(void* p, int in_len, int max_len, int* out_len) {
   if (!session_) {
     RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet: no SRTP Session";
     return false;
@@ -91,6 +99,7 @@ bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
     return false;
   }
   last_send_seq_num_ = seq_num;
+  ++crypto_stats_.protected_packets;
   return true;
 }
 
@@ -130,6 +139,13 @@ bool SrtpSession::ProtectRtcp(void* p, int in_len, int max_len, int* out_len) {
 
 bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  int64_t start_us = rtc::TimeMicros();
+  bool res = DoUnprotectRtp(p, in_len, out_len);
+  crypto_stats_.unprotect_time_us += rtc::TimeMicros() - start_us;
+  return res;
+}
+
+bool SrtpSession::DoUnprotectRtp(void* p, int in_len, int* out_len) {
   if (!session_) {
     RTC_LOG(LS_WARNING) << "Failed to unprotect SRTP packet: no SRTP Session";
     return false;
@@ -151,6 +167,7 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
                               static_cast<int>(err), kSrtpErrorCodeBoundary);
     return false;
   }
+  ++crypto_stats_.unprotected_packets;
   return true;
 }
 
@@ -172,6 +189,48 @@ bool SrtpSession::UnprotectRtcp(void* p, int in_len, int* out_len) {
   return true;
 }
 
+size_t SrtpSession::ProtectRtpBatch(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer*> packets) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  size_t num_protected = 0;
+  int64_t start_us = rtc::TimeMicros();
+  for (rtc::CopyOnWriteBuffer* packet : packets) {
+    int len = static_cast<int>(packet->size());
+    if (DoProtectRtp(packet->data(), len, static_cast<int>(packet->capacity()),
+                     &len)) {
+      packet->SetSize(len);
+      ++num_protected;
+    } else {
+      packet->Clear();
+    }
+  }
+  crypto_stats_.protect_time_us += rtc::TimeMicros() - start_us;
+  return num_protected;
+}
+
+size_t SrtpSession::UnprotectRtpBatch(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer*> packets) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  size_t num_unprotected = 0;
+  int64_t start_us = rtc::TimeMicros();
+  for (rtc::CopyOnWriteBuffer* packet : packets) {
+    int len = static_cast<int>(packet->size());
+    if (DoUnprotectRtp(packet->data(), len, &len)) {
+      packet->SetSize(len);
+      ++num_unprotected;
+    } else {
+      packet->Clear();
+    }
+  }
+  crypto_stats_.unprotect_time_us += rtc::TimeMicros() - start_us;
+  return num_unprotected;
+}
+
+SrtpSession::CryptoStats SrtpSession::crypto_stats() const {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  return crypto_stats_;
+}
+
 bool SrtpSession::GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   RTC_DCHECK(IsExternalAuthActive());
@@ -322,6 +381,9 @@ bool SrtpSession::DoSetKey(int type,
   rtp_auth_tag_len_ = policy.rtp.auth_tag_len;
   rtcp_auth_tag_len_ = policy.rtcp.auth_tag_len;
   external_auth_active_ = (policy.rtp.auth_type == EXTERNAL_HMAC_SHA1);
+  cipher_suite_ = cs;
+  key_.SetData(key, len);
+  extension_ids_ = extension_ids;
   return true;
 }
 
@@ -359,6 +421,14 @@ bool SrtpSession::UpdateKey(int type,
     return false;
   }
 
+  // srtp_update() would expand the same key again, and reallocate the stream
+  // template and every stream.
+  if (cs == cipher_suite_ && key && len == key_.size() &&
+      memcmp(key, key_.data(), len) == 0 && extension_ids == extension_ids_) {
+    RTC_LOG(LS_VERBOSE) << "SRTP session already uses the new parameters";
+    return true;
+  }
+
   return DoSetKey(type, cs, key, len, extension_ids);
 }
 
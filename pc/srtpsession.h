@@ -11,8 +11,12 @@
 #ifndef PC_SRTPSESSION_H_
 #define PC_SRTPSESSION_H_
 
+#include <stdint.h>
 #include <vector>
 
+#include "api/array_view.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/copyonwritebuffer.h"
 #include "rtc_base/scoped_ref_ptr.h"
 #include "rtc_base/thread_checker.h"
 
@@ -25,11 +29,22 @@ namespace cricket {
 // Class that wraps a libSRTP session.
 class SrtpSession {
  public:
+  // Time spent in libsrtp, for monitoring the crypto cost of a session.
+  struct CryptoStats {
+    int64_t protected_packets = 0;
+    int64_t protect_time_us = 0;
+    int64_t unprotected_packets = 0;
+    int64_t unprotect_time_us = 0;
+  };
+
   SrtpSession();
   ~SrtpSession();
 
   // Configures the session for sending data using the specified
   // cipher-suite and key. Receiving must be done by a separate session.
+  // Updating with the cipher-suite, key and encrypted header extension ids
+  // already in use keeps the libsrtp contexts and their key schedules, e.g.
+  // when the transport is set up again after an ICE restart.
   bool SetSend(int cs,
                const uint8_t* key,
                size_t len,
@@ -65,6 +80,15 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Protects/unprotects a batch of RTP packets in-place, which is cheaper than
+  // one call per packet when fanning out or draining a socket. Each packet
+  // must have room for the auth tag when protecting. Packets that fail are
+  // cleared, and the number of packets that succeeded is returned.
+  size_t ProtectRtpBatch(rtc::ArrayView<rtc::CopyOnWriteBuffer*> packets);
+  size_t UnprotectRtpBatch(rtc::ArrayView<rtc::CopyOnWriteBuffer*> packets);
+
+  CryptoStats crypto_stats() const;
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -99,6 +123,8 @@ class SrtpSession {
                  const uint8_t* key,
                  size_t len,
                  const std::vector<int>& extension_ids);
+  bool DoProtectRtp(void* data, int in_len, int max_len, int* out_len);
+  bool DoUnprotectRtp(void* data, int in_len, int* out_len);
   // Returns send stream current packet index from srtp db.
   bool GetSendStreamPacketIndex(void* data, int in_len, int64_t* index);
 
@@ -123,6 +149,11 @@ class SrtpSession {
   bool external_auth_active_ = false;
   bool external_auth_enabled_ = false;
   int decryption_failure_count_ = 0;
+  CryptoStats crypto_stats_;
+  // Parameters of the last successful key installation.
+  int cipher_suite_ = 0;
+  rtc::ZeroOnFreeBuffer<uint8_t> key_;
+  std::vector<int> extension_ids_;
   RTC_DISALLOW_COPY_AND_ASSIGN(SrtpSession);
 };
 
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <vector>
+
+#include "pc/srtpsession.h"
+#include "pc/srtptestutil.h"
+#include "rtc_base/byteorder.h"
+#include "rtc_base/sslstreamadapter.h"
+#include "test/gtest.h"
+#include "test/testsupport/microbenchmark.h"
+
+namespace rtc {
+
+namespace {
+
+constexpr size_t kRtpHeaderSize = 12;
+constexpr size_t kPayloadSize = 1100;
+// Room for the SRTP auth tag.
+constexpr size_t kMaxSrtpOverhead = 16;
+
+}  // namespace
+
+TEST(SrtpSessionMicrobenchmark, ProtectRtp) {
+  cricket::SrtpSession session;
+  ASSERT_TRUE(session.SetSend(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                              std::vector<int>()));
+
+  uint8_t plain_packet[kRtpHeaderSize + kPayloadSize] = {0x80, 0x00};
+  SetBE32(plain_packet + 8, 0x12345678);
+  memset(plain_packet + kRtpHeaderSize, 0xab, kPayloadSize);
+  uint8_t packet[sizeof(plain_packet) + kMaxSrtpOverhead];
+
+  // SRTP rejects reused sequence numbers, so every packet gets a new one.
+  uint16_t sequence_number = 0;
+  bool protected_all = true;
+  webrtc::test::RunMicrobenchmark("SrtpSession_ProtectRtp", [&] {
+    memcpy(packet, plain_packet, sizeof(plain_packet));
+    SetBE16(packet + 2, sequence_number++);
+    int out_len = 0;
+    protected_all &= session.ProtectRtp(packet, sizeof(plain_packet),
+                                        sizeof(packet), &out_len);
+  });
+  EXPECT_TRUE(protected_all);
+}
+
+}  // namespace rtc
@@ -12,6 +12,7 @@
 
 #include <string.h>
 #include <string>
+#include <vector>
 
 #include "media/base/fakertp.h"
 #include "pc/srtptestutil.h"
@@ -92,6 +93,32 @@ TEST_F(SrtpSessionTest, TestBadSetup) {
                            kEncryptedHeaderExtensionIds));
 }
 
+// Test that updating with the parameters in use keeps the session working,
+// while updating with another key takes effect.
+TEST_F(SrtpSessionTest, TestUpdateKeys) {
+  EXPECT_FALSE(s1_.UpdateSend(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                              kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s1_.SetSend(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s1_.UpdateSend(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                             kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.UpdateRecv(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                             kEncryptedHeaderExtensionIds));
+  TestProtectRtp(CS_AES_CM_128_HMAC_SHA1_80);
+  TestUnprotectRtp(CS_AES_CM_128_HMAC_SHA1_80);
+
+  // The receiver still uses the old key.
+  SetUp();
+  EXPECT_TRUE(s1_.UpdateSend(SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen,
+                             kEncryptedHeaderExtensionIds));
+  SetBE16(reinterpret_cast<uint8_t*>(rtp_packet_) + 2, 2);
+  TestProtectRtp(CS_AES_CM_128_HMAC_SHA1_80);
+  int out_len = 0;
+  EXPECT_FALSE(s2_.UnprotectRtp(rtp_packet_, rtp_len_, &out_len));
+}
+
 // Test that we fail keys of the wrong length.
 TEST_F(SrtpSessionTest, TestKeysTooShort) {
   EXPECT_FALSE(s1_.SetSend(SRTP_AES128_CM_SHA1_80, kTestKey1, 1,
@@ -124,6 +151,42 @@ TEST_F(SrtpSessionTest, TestProtect_AES_CM_128_HMAC_SHA1_32) {
   TestUnprotectRtcp(CS_AES_CM_128_HMAC_SHA1_32);
 }
 
+// Test that a batch of packets can be protected and unprotected, and that
+// packets failing to unprotect are cleared without affecting the others.
+TEST_F(SrtpSessionTest, TestProtectBatch) {
+  EXPECT_TRUE(s1_.SetSend(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  const size_t kNumPackets = 3;
+  const size_t kCapacity = sizeof(kPcmuFrame) + 10;
+  std::vector<CopyOnWriteBuffer> packets;
+  std::vector<CopyOnWriteBuffer*> packet_ptrs;
+  packets.reserve(kNumPackets);
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    packets.emplace_back(kPcmuFrame, sizeof(kPcmuFrame), kCapacity);
+    SetBE16(packets.back().data() + 2, static_cast<uint16_t>(i + 1));
+    packet_ptrs.push_back(&packets.back());
+  }
+  EXPECT_EQ(kNumPackets, s1_.ProtectRtpBatch(packet_ptrs));
+  for (const CopyOnWriteBuffer& packet : packets) {
+    EXPECT_EQ(kCapacity, packet.size());
+  }
+  EXPECT_EQ(static_cast<int64_t>(kNumPackets),
+            s1_.crypto_stats().protected_packets);
+
+  // Tamper with the middle packet.
+  packets[1].data()[sizeof(kPcmuFrame) - 1] ^= 0xff;
+  EXPECT_EQ(kNumPackets - 1, s2_.UnprotectRtpBatch(packet_ptrs));
+  EXPECT_EQ(sizeof(kPcmuFrame), packets[0].size());
+  EXPECT_EQ(0u, packets[1].size());
+  EXPECT_EQ(sizeof(kPcmuFrame), packets[2].size());
+  EXPECT_EQ(0, memcmp(packets[2].data() + 4, kPcmuFrame + 4,
+                      sizeof(kPcmuFrame) - 4));
+  EXPECT_EQ(static_cast<int64_t>(kNumPackets - 1),
+            s2_.crypto_stats().unprotected_packets);
+}
+
 TEST_F(SrtpSessionTest, TestGetSendStreamPacketIndex) {
   EXPECT_TRUE(s1_.SetSend(SRTP_AES128_CM_SHA1_32, kTestKey1, kTestKeyLen,
                           kEncryptedHeaderExtensionIds));
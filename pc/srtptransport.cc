@@ -124,6 +124,10 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   }
   rtc::PacketOptions updated_options = options;
   TRACE_EVENT0("webrtc", "SRTP Encode");
+  // Packets handed down from the RTP module share their buffer and usually
+  // have tail room for the auth tag already, in which case protection happens
+  // in place. Otherwise make room here, copying the packet once.
+  packet->EnsureCapacity(packet->size() + send_session_->GetSrtpOverhead());
   bool res;
   uint8_t* data = packet->data();
   int len = rtc::checked_cast<int>(packet->size());
@@ -454,6 +458,17 @@ bool SrtpTransport::GetSrtpOverhead(int* srtp_overhead) const {
   return true;
 }
 
+bool SrtpTransport::GetRtpCryptoStats(
+    cricket::SrtpSession::CryptoStats* send_stats,
+    cricket::SrtpSession::CryptoStats* recv_stats) const {
+  if (!IsSrtpActive()) {
+    return false;
+  }
+  *send_stats = send_session_->crypto_stats();
+  *recv_stats = recv_session_->crypto_stats();
+  return true;
+}
+
 void SrtpTransport::EnableExternalAuth() {
   RTC_DCHECK(!IsSrtpActive());
   external_auth_enabled_ = true;
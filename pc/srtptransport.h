@@ -99,6 +99,10 @@ class SrtpTransport : public RtpTransport {
   // Returns srtp overhead for rtp packets.
   bool GetSrtpOverhead(int* srtp_overhead) const;
 
+  // Returns the time spent protecting and unprotecting RTP packets.
+  bool GetRtpCryptoStats(cricket::SrtpSession::CryptoStats* send_stats,
+                         cricket::SrtpSession::CryptoStats* recv_stats) const;
+
   // Returns rtp auth params from srtp context.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
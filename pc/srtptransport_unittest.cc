@@ -403,6 +403,34 @@ INSTANTIATE_TEST_CASE_P(ExternalAuth,
                         SrtpTransportTestWithExternalAuth,
                         ::testing::Values(true, false));
 
+// A packet without tail room for the auth tag, e.g. one sharing its buffer
+// with the RTP module, gets room made for the tag instead of failing.
+TEST_F(SrtpTransportTest, SendRtpPacketWithoutTailRoom) {
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  rtc::CopyOnWriteBuffer rtp_packet(kPcmuFrame, sizeof(kPcmuFrame));
+  ASSERT_EQ(rtp_packet.size(), rtp_packet.capacity());
+  rtc::CopyOnWriteBuffer shared_packet = rtp_packet;
+
+  rtc::PacketOptions options;
+  ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&rtp_packet, options,
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(sizeof(kPcmuFrame) +
+                rtc::rtp_auth_tag_len(rtc::CS_AES_CM_128_HMAC_SHA1_80),
+            rtp_packet.size());
+  // The other reference to the buffer is left untouched.
+  EXPECT_EQ(0, memcmp(shared_packet.data(), kPcmuFrame, sizeof(kPcmuFrame)));
+  ASSERT_TRUE(rtp_sink2_.last_recv_rtp_packet().data());
+  EXPECT_EQ(0, memcmp(rtp_sink2_.last_recv_rtp_packet().data(), kPcmuFrame,
+                      sizeof(kPcmuFrame)));
+}
+
 // Test directly setting the params with bogus keys.
 TEST_F(SrtpTransportTest, TestSetParamsKeyTooShort) {
   std::vector<int> extension_ids;
@@ -269,6 +269,10 @@ class FakePeerConnectionBase : public PeerConnectionInternal {
 
   Call::Stats GetCallStats() override { return Call::Stats(); }
 
+  CallSetupTimes GetCallSetupTimes() const override {
+    return CallSetupTimes();
+  }
+
   bool GetLocalCertificate(
       const std::string& transport_name,
       rtc::scoped_refptr<rtc::RTCCertificate>* certificate) override {
@@ -192,6 +192,10 @@ class FakePeerConnectionForStats : public FakePeerConnectionBase {
 
   void SetCallStats(const Call::Stats& call_stats) { call_stats_ = call_stats; }
 
+  void SetCallSetupTimes(const CallSetupTimes& call_setup_times) {
+    call_setup_times_ = call_setup_times;
+  }
+
   void SetLocalCertificate(
       const std::string& transport_name,
       rtc::scoped_refptr<rtc::RTCCertificate> certificate) {
@@ -299,6 +303,10 @@ class FakePeerConnectionForStats : public FakePeerConnectionBase {
 
   Call::Stats GetCallStats() override { return call_stats_; }
 
+  CallSetupTimes GetCallSetupTimes() const override {
+    return call_setup_times_;
+  }
+
   bool GetLocalCertificate(
       const std::string& transport_name,
       rtc::scoped_refptr<rtc::RTCCertificate>* certificate) override {
@@ -374,6 +382,7 @@ class FakePeerConnectionForStats : public FakePeerConnectionBase {
   std::map<std::string, cricket::TransportStats> transport_stats_by_name_;
 
   Call::Stats call_stats_;
+  CallSetupTimes call_setup_times_;
 
   std::map<std::string, rtc::scoped_refptr<rtc::RTCCertificate>>
       local_certificates_by_transport_;
@@ -11,6 +11,7 @@
 #ifndef PC_TEST_MOCK_RTPSENDERINTERNAL_H_
 #define PC_TEST_MOCK_RTPSENDERINTERNAL_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,8 @@ class MockRtpSenderInternal : public RtpSenderInternal {
   MOCK_METHOD1(set_init_send_encodings,
                void(const std::vector<RtpEncodingParameters>&));
   MOCK_METHOD0(Stop, void());
+  MOCK_METHOD2(SetParametersAsync,
+               void(const RtpParameters&, std::function<void(RTCError)>));
   MOCK_CONST_METHOD0(AttachmentId, int());
 };
 
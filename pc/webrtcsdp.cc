@@ -117,6 +117,11 @@ static const char kLineTypeMedia = 'm';
 static const char kLineTypeConnection = 'c';
 static const char kLineTypeAttributes = 'a';
 
+// Estimated serialized sizes of the session level lines and of each media
+// section, used to reserve the buffer of SdpSerialize.
+static const size_t kSessionSerializeReserve = 512;
+static const size_t kMediaSectionSerializeReserve = 2048;
+
 // Attributes
 static const char kAttributeGroup[] = "group";
 static const char kAttributeMid[] = "mid";
@@ -484,13 +489,12 @@ static bool GetLine(const std::string& message,
   if (line_end == std::string::npos) {
     return false;
   }
-  // Update the new start position
-  *pos = line_end + 1;
-  if (line_end > 0 && (message.at(line_end - 1) == kReturnChar)) {
+  const size_t next_line_begin = line_end + 1;
+  if (line_end > line_begin && (message[line_end - 1] == kReturnChar)) {
     --line_end;
   }
-  *line = message.substr(line_begin, (line_end - line_begin));
-  const char* cline = line->c_str();
+  const char* cline = message.data() + line_begin;
+  const size_t line_length = line_end - line_begin;
   // RFC 4566
   // An SDP session description consists of a number of lines of text of
   // the form:
@@ -504,13 +508,17 @@ static bool GetLine(const std::string& message,
   //
   //   If a session has no meaningful name, the value "s= " SHOULD be used
   //   (i.e., a single space as the session name).
-  if (line->length() < 3 || !islower(cline[0]) ||
+  if (line_length < 3 || !islower(cline[0]) ||
       cline[1] != kSdpDelimiterEqualChar ||
       (cline[0] != kLineTypeSessionName &&
        cline[2] == kSdpDelimiterSpaceChar)) {
-    *pos = line_begin;
     return false;
   }
+  // The line is validated before it is copied, and assigned rather than
+  // constructed so that the caller's buffer is reused from line to line.
+  line->assign(cline, line_length);
+  // Update the new start position
+  *pos = next_line_begin;
   return true;
 }
 
@@ -845,6 +853,8 @@ std::string SdpSerialize(const JsepSessionDescription& jdesc) {
   }
 
   std::string message;
+  message.reserve(kSessionSerializeReserve +
+                  kMediaSectionSerializeReserve * desc->contents().size());
 
   // Session Description.
   AddLine(kSessionVersion, &message);
@@ -2800,22 +2810,9 @@ T GetCodecWithPayloadType(const std::vector<T>& codecs, int payload_type) {
 // Updates or creates a new codec entry in the audio description.
 template <class T, class U>
 void AddOrReplaceCodec(MediaContentDescription* content_desc, const U& codec) {
-  T* desc = static_cast<T*>(content_desc);
-  std::vector<U> codecs = desc->codecs();
-  bool found = false;
-  for (U& existing_codec : codecs) {
-    if (codec.id == existing_codec.id) {
-      // Overwrite existing codec with the new codec.
-      existing_codec = codec;
-      found = true;
-      break;
-    }
-  }
-  if (!found) {
-    desc->AddCodec(codec);
-    return;
-  }
-  desc->set_codecs(codecs);
+  // Replaced in place; copying the codec list for every rtpmap, fmtp and
+  // rtcp-fb line made parsing quadratic in the number of codecs.
+  static_cast<T*>(content_desc)->AddOrReplaceCodec(codec);
 }
 
 // Adds or updates existing codec corresponding to |payload_type| according
@@ -29,6 +29,23 @@ AsyncPacketSocket::AsyncPacketSocket() = default;
 
 AsyncPacketSocket::~AsyncPacketSocket() = default;
 
+int AsyncPacketSocket::SendToBatch(const void* const* buffers,
+                                   const size_t* lengths,
+                                   const PacketOptions* options,
+                                   size_t count,
+                                   const SocketAddress& addr) {
+  for (size_t i = 0; i < count; ++i) {
+    int sent = SendTo(buffers[i], lengths[i], addr, options[i]);
+    if (sent < 0)
+      return i > 0 ? static_cast<int>(i) : sent;
+  }
+  return static_cast<int>(count);
+}
+
+bool AsyncPacketSocket::SetRecvHeadroom(size_t bytes) {
+  return bytes == 0;
+}
+
 void CopySocketInformationToPacketInfo(size_t packet_size_bytes,
                                        const AsyncPacketSocket& socket_from,
                                        bool is_connectionless,
@@ -80,6 +80,24 @@ class AsyncPacketSocket : public sigslot::has_slots<> {
                      const SocketAddress& addr,
                      const PacketOptions& options) = 0;
 
+  // Sends |count| packets to |addr|, where packet i is |buffers[i]| of
+  // |lengths[i]| bytes sent with |options[i]|. Returns the number of packets
+  // sent, or a negative value if none could be sent. The default
+  // implementation calls SendTo for each packet; sockets that can hand a whole
+  // burst to the OS at once override it.
+  virtual int SendToBatch(const void* const* buffers,
+                          const size_t* lengths,
+                          const PacketOptions* options,
+                          size_t count,
+                          const SocketAddress& addr);
+
+  // Reserves |bytes| writable bytes in front of the data passed to
+  // SignalReadPacket, so that a receiver can prepend a header to a packet in
+  // place before forwarding it. The headroom belongs to the receiver for the
+  // duration of the callback only. Returns false if the socket does not
+  // support headroom, which is the default.
+  virtual bool SetRecvHeadroom(size_t bytes);
+
   // Close the socket.
   virtual int Close() = 0;
 
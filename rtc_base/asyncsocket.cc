@@ -17,6 +17,32 @@ AsyncSocket::AsyncSocket() {}
 
 AsyncSocket::~AsyncSocket() {}
 
+int AsyncSocket::RecvFromBatch(void* buffer,
+                               size_t packet_size,
+                               size_t count,
+                               size_t* lengths,
+                               SocketAddress* paddrs,
+                               int64_t* timestamps) {
+  RTC_DCHECK_GT(count, 0);
+  int received = RecvFrom(buffer, packet_size, &paddrs[0], &timestamps[0]);
+  if (received < 0)
+    return received;
+  lengths[0] = static_cast<size_t>(received);
+  return 1;
+}
+
+int AsyncSocket::SendToBatch(const void* const* buffers,
+                             const size_t* lengths,
+                             size_t count,
+                             const SocketAddress& addr) {
+  for (size_t i = 0; i < count; ++i) {
+    int sent = SendTo(buffers[i], lengths[i], addr);
+    if (sent < 0)
+      return i > 0 ? static_cast<int>(i) : sent;
+  }
+  return static_cast<int>(count);
+}
+
 AsyncSocketAdapter::AsyncSocketAdapter(AsyncSocket* socket) : socket_(nullptr) {
   Attach(socket);
 }
@@ -74,6 +100,23 @@ int AsyncSocketAdapter::RecvFrom(void* pv,
   return socket_->RecvFrom(pv, cb, paddr, timestamp);
 }
 
+int AsyncSocketAdapter::RecvFromBatch(void* buffer,
+                                      size_t packet_size,
+                                      size_t count,
+                                      size_t* lengths,
+                                      SocketAddress* paddrs,
+                                      int64_t* timestamps) {
+  return socket_->RecvFromBatch(buffer, packet_size, count, lengths, paddrs,
+                                timestamps);
+}
+
+int AsyncSocketAdapter::SendToBatch(const void* const* buffers,
+                                    const size_t* lengths,
+                                    size_t count,
+                                    const SocketAddress& addr) {
+  return socket_->SendToBatch(buffers, lengths, count, addr);
+}
+
 int AsyncSocketAdapter::Listen(int backlog) {
   return socket_->Listen(backlog);
 }
@@ -30,6 +30,31 @@ class AsyncSocket : public Socket {
 
   AsyncSocket* Accept(SocketAddress* paddr) override = 0;
 
+  // Receives up to |count| datagrams. Datagram i is written to
+  // |buffer| + i * |packet_size|, with its length, source address and receive
+  // timestamp (in microseconds, -1 if unknown) stored in |lengths[i]|,
+  // |paddrs[i]| and |timestamps[i]|. A length larger than |packet_size| means
+  // the datagram was truncated. Returns the number of datagrams received, or
+  // SOCKET_ERROR. The default implementation receives a single datagram using
+  // RecvFrom; implementations may override it to drain several datagrams with
+  // one system call.
+  virtual int RecvFromBatch(void* buffer,
+                            size_t packet_size,
+                            size_t count,
+                            size_t* lengths,
+                            SocketAddress* paddrs,
+                            int64_t* timestamps);
+
+  // Sends |count| datagrams to |addr|, where datagram i is |buffers[i]| of
+  // |lengths[i]| bytes. Returns the number of datagrams sent, which may be
+  // less than |count| if the socket would block, or SOCKET_ERROR if nothing
+  // was sent. The default implementation calls SendTo for each datagram;
+  // implementations may override it to send the batch with one system call.
+  virtual int SendToBatch(const void* const* buffers,
+                          const size_t* lengths,
+                          size_t count,
+                          const SocketAddress& addr);
+
   // SignalReadEvent and SignalWriteEvent use multi_threaded_local to allow
   // access concurrently from different thread.
   // For example SignalReadEvent::connect will be called in AsyncUDPSocket ctor
@@ -63,6 +88,16 @@ class AsyncSocketAdapter : public AsyncSocket, public sigslot::has_slots<> {
                size_t cb,
                SocketAddress* paddr,
                int64_t* timestamp) override;
+  int RecvFromBatch(void* buffer,
+                    size_t packet_size,
+                    size_t count,
+                    size_t* lengths,
+                    SocketAddress* paddrs,
+                    int64_t* timestamps) override;
+  int SendToBatch(const void* const* buffers,
+                  const size_t* lengths,
+                  size_t count,
+                  const SocketAddress& addr) override;
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* paddr) override;
   int Close() override;
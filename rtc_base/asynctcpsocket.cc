@@ -314,21 +314,21 @@ int AsyncTCPSocket::Send(const void* pv,
 void AsyncTCPSocket::ProcessInput(char* data, size_t* len) {
   SocketAddress remote_addr(GetRemoteAddress());
 
-  while (true) {
-    if (*len < kPacketLenSize)
-      return;
-
-    PacketLength pkt_len = rtc::GetBE16(data);
-    if (*len < kPacketLenSize + pkt_len)
-      return;
-
-    SignalReadPacket(this, data + kPacketLenSize, pkt_len, remote_addr,
-                     TimeMicros());
+  // Signal all complete packets, and move the rest to the front only once.
+  size_t processed = 0;
+  while (*len - processed >= kPacketLenSize) {
+    PacketLength pkt_len = rtc::GetBE16(data + processed);
+    if (*len - processed < kPacketLenSize + pkt_len)
+      break;
+
+    SignalReadPacket(this, data + processed + kPacketLenSize, pkt_len,
+                     remote_addr, TimeMicros());
+    processed += kPacketLenSize + pkt_len;
+  }
 
-    *len -= kPacketLenSize + pkt_len;
-    if (*len > 0) {
-      memmove(data, data + kPacketLenSize + pkt_len, *len);
-    }
+  *len -= processed;
+  if (processed > 0 && *len > 0) {
+    memmove(data, data + processed, *len);
   }
 }
 
@@ -11,6 +11,7 @@
 #include "rtc_base/asyncudpsocket.h"
 
 #include <stdint.h>
+#include <algorithm>
 #include <string>
 
 #include "rtc_base/checks.h"
@@ -86,6 +87,41 @@ int AsyncUDPSocket::SendTo(const void* pv,
   return ret;
 }
 
+int AsyncUDPSocket::SendToBatch(const void* const* buffers,
+                                const size_t* lengths,
+                                const rtc::PacketOptions* options,
+                                size_t count,
+                                const SocketAddress& addr) {
+  int64_t send_time_ms = rtc::TimeMillis();
+  int ret = socket_->SendToBatch(buffers, lengths, count, addr);
+  // Report every packet that was handed to the OS, as SendTo() does for a
+  // single packet. If nothing was sent, the first packet is reported to match
+  // the failure behavior of SendTo().
+  size_t reported =
+      ret > 0 ? static_cast<size_t>(ret) : std::min<size_t>(count, 1);
+  for (size_t i = 0; i < reported; ++i) {
+    rtc::SentPacket sent_packet(options[i].packet_id, send_time_ms,
+                                options[i].info_signaled_after_sent);
+    CopySocketInformationToPacketInfo(lengths[i], *this, true,
+                                      &sent_packet.info);
+    SignalSentPacket(this, sent_packet);
+  }
+  return ret;
+}
+
+bool AsyncUDPSocket::SetRecvHeadroom(size_t bytes) {
+  if (bytes != headroom_) {
+    delete[] buf_;
+    buf_ = new char[bytes + size_];
+    headroom_ = bytes;
+    if (!batch_lengths_.empty()) {
+      batch_buffer_.resize(headroom_ + batch_lengths_.size() *
+                                           (headroom_ + batch_packet_size_));
+    }
+  }
+  return true;
+}
+
 int AsyncUDPSocket::Close() {
   return socket_->Close();
 }
@@ -110,12 +146,38 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+void AsyncUDPSocket::SetRecvBatching(size_t max_packets,
+                                     size_t max_packet_size) {
+  RTC_DCHECK_GT(max_packets, 0);
+  if (max_packets <= 1) {
+    batch_packet_size_ = 0;
+    batch_buffer_.clear();
+    batch_lengths_.clear();
+    batch_addrs_.clear();
+    batch_timestamps_.clear();
+    return;
+  }
+  RTC_DCHECK_GT(max_packet_size, 0);
+  batch_packet_size_ = max_packet_size;
+  batch_buffer_.resize(headroom_ +
+                       max_packets * (headroom_ + max_packet_size));
+  batch_lengths_.resize(max_packets);
+  batch_addrs_.resize(max_packets);
+  batch_timestamps_.resize(max_packets);
+}
+
 void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
   RTC_DCHECK(socket_.get() == socket);
 
+  if (!batch_lengths_.empty()) {
+    OnReadBatchEvent();
+    return;
+  }
+
   SocketAddress remote_addr;
   int64_t timestamp;
-  int len = socket_->RecvFrom(buf_, size_, &remote_addr, &timestamp);
+  char* data = buf_ + headroom_;
+  int len = socket_->RecvFrom(data, size_, &remote_addr, &timestamp);
   if (len < 0) {
     // An error here typically means we got an ICMP error in response to our
     // send datagram, indicating the remote address was unreachable.
@@ -129,10 +191,41 @@ void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
 
   // TODO: Make sure that we got all of the packet.
   // If we did not, then we should resize our buffer to be large enough.
-  SignalReadPacket(this, buf_, static_cast<size_t>(len), remote_addr,
+  SignalReadPacket(this, data, static_cast<size_t>(len), remote_addr,
                    (timestamp > -1 ? timestamp : TimeMicros()));
 }
 
+void AsyncUDPSocket::OnReadBatchEvent() {
+  const size_t slot_size = headroom_ + batch_packet_size_;
+  int count = socket_->RecvFromBatch(
+      &batch_buffer_[headroom_], slot_size, batch_lengths_.size(),
+      batch_lengths_.data(), batch_addrs_.data(), batch_timestamps_.data());
+  if (count < 0) {
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] batched receive failed with error "
+                     << socket_->GetError();
+    return;
+  }
+
+  int64_t now = -1;
+  for (int i = 0; i < count; ++i) {
+    if (batch_lengths_[i] > batch_packet_size_) {
+      RTC_LOG(LS_WARNING) << "Dropping truncated datagram of "
+                          << batch_lengths_[i] << " bytes.";
+      continue;
+    }
+    int64_t timestamp = batch_timestamps_[i];
+    if (timestamp < 0) {
+      if (now < 0)
+        now = TimeMicros();
+      timestamp = now;
+    }
+    SignalReadPacket(this, &batch_buffer_[headroom_ + i * slot_size],
+                     batch_lengths_[i], batch_addrs_[i], timestamp);
+  }
+}
+
 void AsyncUDPSocket::OnWriteEvent(AsyncSocket* socket) {
   SignalReadyToSend(this);
 }
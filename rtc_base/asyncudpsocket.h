@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 #include <memory>
+#include <vector>
 
 #include "rtc_base/asyncpacketsocket.h"
 #include "rtc_base/asyncsocket.h"
@@ -47,6 +48,12 @@ class AsyncUDPSocket : public AsyncPacketSocket {
              size_t cb,
              const SocketAddress& addr,
              const rtc::PacketOptions& options) override;
+  int SendToBatch(const void* const* buffers,
+                  const size_t* lengths,
+                  const rtc::PacketOptions* options,
+                  size_t count,
+                  const SocketAddress& addr) override;
+  bool SetRecvHeadroom(size_t bytes) override;
   int Close() override;
 
   State GetState() const override;
@@ -55,15 +62,34 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Enables batched receive where up to |max_packets| datagrams are drained
+  // from the socket per read event, each up to |max_packet_size| bytes.
+  // Datagrams larger than |max_packet_size| are dropped. A |max_packets| of 1
+  // restores the default one-datagram-per-read behavior.
+  void SetRecvBatching(size_t max_packets, size_t max_packet_size);
+
  private:
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(AsyncSocket* socket);
+  // Drains several datagrams from the socket when batching is enabled.
+  void OnReadBatchEvent();
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(AsyncSocket* socket);
 
   std::unique_ptr<AsyncSocket> socket_;
   char* buf_;
   size_t size_;
+  // Bytes reserved in front of every received packet, see SetRecvHeadroom().
+  size_t headroom_ = 0;
+
+  // Storage used when batched receive is enabled. Slot i starts at
+  // headroom_ + i * (headroom_ + batch_packet_size_), so that every packet
+  // is preceded by headroom_ bytes that do not overlap the previous packet.
+  size_t batch_packet_size_ = 0;
+  std::vector<char> batch_buffer_;
+  std::vector<size_t> batch_lengths_;
+  std::vector<SocketAddress> batch_addrs_;
+  std::vector<int64_t> batch_timestamps_;
 };
 
 }  // namespace rtc
@@ -59,6 +59,18 @@ uint8_t WritePartialByte(uint8_t source,
   return (target & ~mask) | (source >> target_bit_offset);
 }
 
+// Counts the number of 0 bits before the highest 1 bit in |byte|, which must
+// not be 0.
+size_t CountLeadingZeroBits(uint8_t byte) {
+  RTC_DCHECK_NE(byte, 0);
+  size_t zero_bit_count = 0;
+  while ((byte & 0x80) == 0) {
+    zero_bit_count++;
+    byte <<= 1;
+  }
+  return zero_bit_count;
+}
+
 // Counts the number of bits used in the binary representation of val.
 size_t CountBits(uint64_t val) {
   size_t bit_count = 0;
@@ -163,30 +175,34 @@ bool BitBuffer::ReadExponentialGolomb(uint32_t* val) {
   if (!val) {
     return false;
   }
-  // Store off the current byte/bit offset, in case we want to restore them due
-  // to a failed parse.
-  size_t original_byte_offset = byte_offset_;
-  size_t original_bit_offset = bit_offset_;
-
-  // Count the number of leading 0 bits by peeking/consuming them one at a time.
+  // Count the number of leading 0 bits, a byte at a time. Values of more than
+  // 32 bits are not supported, so stop looking after that many 0 bits.
   size_t zero_bit_count = 0;
-  uint32_t peeked_bit;
-  while (PeekBits(&peeked_bit, 1) && peeked_bit == 0) {
-    zero_bit_count++;
-    ConsumeBits(1);
+  size_t byte_offset = byte_offset_;
+  size_t bit_offset = bit_offset_;
+  while (byte_offset < byte_count_ && zero_bit_count < 32) {
+    // The bits of the byte not read yet, in the highest bits.
+    const uint8_t bits =
+        static_cast<uint8_t>(bytes_[byte_offset] << bit_offset);
+    if (bits != 0) {
+      zero_bit_count += CountLeadingZeroBits(bits);
+      break;
+    }
+    zero_bit_count += 8 - bit_offset;
+    bit_offset = 0;
+    ++byte_offset;
   }
 
-  // We should either be at the end of the stream, or the next bit should be 1.
-  RTC_DCHECK(!PeekBits(&peeked_bit, 1) || peeked_bit == 1);
-
   // The bit count of the value is the number of zeros + 1. Make sure that many
   // bits fits in a uint32_t and that we have enough bits left for it, and then
   // read the value.
-  size_t value_bit_count = zero_bit_count + 1;
-  if (value_bit_count > 32 || !ReadBits(val, value_bit_count)) {
-    RTC_CHECK(Seek(original_byte_offset, original_bit_offset));
+  const size_t value_bit_count = zero_bit_count + 1;
+  if (value_bit_count > 32 ||
+      zero_bit_count + value_bit_count > RemainingBitCount()) {
     return false;
   }
+  RTC_CHECK(ConsumeBits(zero_bit_count));
+  RTC_CHECK(ReadBits(val, value_bit_count));
   *val -= 1;
   return true;
 }
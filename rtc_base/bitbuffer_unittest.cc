@@ -246,6 +246,37 @@ TEST(BitBufferTest, NoGolombOverread) {
   EXPECT_EQ(0x01FEu, decoded_val);
 }
 
+TEST(BitBufferTest, GolombValuesAtBitOffsets) {
+  for (size_t bit_offset = 0; bit_offset < 8; ++bit_offset) {
+    for (uint32_t val : {0u, 1u, 254u, 0x12345u, 0xFFFFFFFEu}) {
+      uint8_t bytes[16] = {0};
+      BitBufferWriter writer(bytes, sizeof(bytes));
+      ASSERT_TRUE(writer.ConsumeBits(bit_offset));
+      ASSERT_TRUE(writer.WriteExponentialGolomb(val));
+
+      BitBuffer buffer(bytes, sizeof(bytes));
+      ASSERT_TRUE(buffer.ConsumeBits(bit_offset));
+      uint32_t decoded_val;
+      ASSERT_TRUE(buffer.ReadExponentialGolomb(&decoded_val));
+      EXPECT_EQ(val, decoded_val);
+    }
+  }
+}
+
+TEST(BitBufferTest, FailedGolombReadKeepsOffset) {
+  // 37 leading zeros do not fit in a uint32_t.
+  const uint8_t bytes[] = {0xE0, 0x00, 0x00, 0x00, 0x00, 0x10, 0xFF, 0xFF};
+  BitBuffer buffer(bytes, sizeof(bytes));
+  ASSERT_TRUE(buffer.ConsumeBits(3));
+  uint32_t decoded_val;
+  EXPECT_FALSE(buffer.ReadExponentialGolomb(&decoded_val));
+  size_t byte_offset;
+  size_t bit_offset;
+  buffer.GetCurrentOffset(&byte_offset, &bit_offset);
+  EXPECT_EQ(0u, byte_offset);
+  EXPECT_EQ(3u, bit_offset);
+}
+
 TEST(BitBufferWriterTest, SymmetricReadWrite) {
   uint8_t bytes[16] = {0};
   BitBufferWriter buffer(bytes, 4);
@@ -20,6 +20,7 @@
 
 #include "api/array_view.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/buffer_memory_pool.h"
 #include "rtc_base/type_traits.h"
 #include "rtc_base/zero_memory.h"
 
@@ -88,7 +89,7 @@ class BufferT {
   BufferT(size_t size, size_t capacity)
       : size_(size),
         capacity_(std::max(size, capacity)),
-        data_(capacity_ > 0 ? new T[capacity_] : nullptr) {
+        data_(capacity_ > 0 ? Allocate(capacity_) : nullptr) {
     RTC_DCHECK(IsConsistent());
   }
 
@@ -367,7 +368,8 @@ class BufferT {
         extra_headroom ? std::max(capacity, capacity_ + capacity_ / 2)
                        : capacity;
 
-    std::unique_ptr<T[]> new_data(new T[new_capacity]);
+    std::unique_ptr<T[], internal::BufferMemoryDeleter> new_data(
+        Allocate(new_capacity));
     std::memcpy(new_data.get(), data_.get(), size_ * sizeof(T));
     MaybeZeroCompleteBuffer();
     data_ = std::move(new_data);
@@ -416,9 +418,13 @@ class BufferT {
 #endif
   }
 
+  static T* Allocate(size_t capacity) {
+    return static_cast<T*>(AllocateBufferMemory(capacity * sizeof(T)));
+  }
+
   size_t size_;
   size_t capacity_;
-  std::unique_ptr<T[]> data_;
+  std::unique_ptr<T[], internal::BufferMemoryDeleter> data_;
 };
 
 // By far the most common sort of buffer.
@@ -230,6 +230,11 @@ class CopyOnWriteBuffer {
   }
 
  private:
+  friend class CopyOnWriteBufferPool;
+
+  // Wraps |buffer|, which must not be referenced elsewhere.
+  explicit CopyOnWriteBuffer(scoped_refptr<RefCountedObject<Buffer>> buffer);
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects.
   void CloneDataIfReferenced(size_t new_capacity);
@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copyonwritebufferpool.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/refcountedobject.h"
+
+namespace rtc {
+
+// Intrusive stack of released buffers. Any thread may push; only the pool
+// takes buffers, and it takes all of them at once, so there is no ABA problem.
+class CopyOnWriteBufferPool::FreeList : public RefCountInterface {
+ public:
+  // Called when the last reference to |buffer| is dropped. Deletes |buffer|
+  // if the pool is gone.
+  void Push(PooledBuffer* buffer);
+  // Takes all pushed buffers, linked through |next_free|.
+  PooledBuffer* TakeAll() { return head_.exchange(nullptr); }
+  // Takes all pushed buffers, and makes later pushes delete the buffer.
+  PooledBuffer* Close() { return head_.exchange(Closed()); }
+
+ protected:
+  ~FreeList() override = default;
+
+ private:
+  static PooledBuffer* Closed() {
+    return reinterpret_cast<PooledBuffer*>(uintptr_t{1});
+  }
+
+  std::atomic<PooledBuffer*> head_{nullptr};
+};
+
+class CopyOnWriteBufferPool::PooledBuffer final
+    : public RefCountedObject<Buffer> {
+ public:
+  PooledBuffer(size_t capacity, scoped_refptr<FreeList> free_list)
+      : RefCountedObject<Buffer>(0, capacity),
+        free_list_(std::move(free_list)) {}
+  ~PooledBuffer() override = default;
+
+  RefCountReleaseStatus Release() const override {
+    const auto status = ref_count_.DecRef();
+    if (status == RefCountReleaseStatus::kDroppedLastRef) {
+      free_list_->Push(const_cast<PooledBuffer*>(this));
+    }
+    return status;
+  }
+
+  PooledBuffer* next_free = nullptr;
+
+ private:
+  const scoped_refptr<FreeList> free_list_;
+};
+
+void CopyOnWriteBufferPool::FreeList::Push(PooledBuffer* buffer) {
+  PooledBuffer* head = head_.load(std::memory_order_relaxed);
+  do {
+    if (head == Closed()) {
+      // This may drop the last reference to the free list itself, so it must
+      // not be touched after this.
+      delete buffer;
+      return;
+    }
+    buffer->next_free = head;
+  } while (!head_.compare_exchange_weak(head, buffer, std::memory_order_release,
+                                        std::memory_order_relaxed));
+}
+
+CopyOnWriteBufferPool::CopyOnWriteBufferPool(size_t buffer_capacity,
+                                             size_t max_buffers)
+    : buffer_capacity_(buffer_capacity),
+      max_buffers_(max_buffers),
+      free_list_(new RefCountedObject<FreeList>()) {
+  RTC_DCHECK_GT(buffer_capacity_, 0);
+}
+
+CopyOnWriteBufferPool::~CopyOnWriteBufferPool() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  for (PooledBuffer* buffer : free_buffers_) {
+    delete buffer;
+  }
+  PooledBuffer* buffer = free_list_->Close();
+  while (buffer) {
+    PooledBuffer* next = buffer->next_free;
+    delete buffer;
+    buffer = next;
+  }
+}
+
+CopyOnWriteBuffer CopyOnWriteBufferPool::CreateInternal(const uint8_t* data,
+                                                        size_t size) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  if (size > buffer_capacity_) {
+    ++misses_;
+    return CopyOnWriteBuffer(data, size);
+  }
+  if (free_buffers_.empty()) {
+    PooledBuffer* buffer = free_list_->TakeAll();
+    while (buffer) {
+      free_buffers_.push_back(buffer);
+      buffer = buffer->next_free;
+    }
+  }
+  scoped_refptr<RefCountedObject<Buffer>> buffer;
+  if (!free_buffers_.empty()) {
+    ++hits_;
+    buffer = free_buffers_.back();
+    free_buffers_.pop_back();
+  } else {
+    ++misses_;
+    if (num_buffers_ == max_buffers_) {
+      return CopyOnWriteBuffer(data, size);
+    }
+    ++num_buffers_;
+    buffer = new PooledBuffer(buffer_capacity_, free_list_);
+  }
+  buffer->SetData(data, size);
+  return CopyOnWriteBuffer(std::move(buffer));
+}
+
+}  // namespace rtc
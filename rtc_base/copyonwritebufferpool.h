@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_COPYONWRITEBUFFERPOOL_H_
+#define RTC_BASE_COPYONWRITEBUFFERPOOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+#include <vector>
+
+#include "rtc_base/buffer.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/scoped_ref_ptr.h"
+
+namespace rtc {
+
+// Recycles the memory of CopyOnWriteBuffers of up to |buffer_capacity| bytes,
+// such as received packets, to avoid an allocation per buffer. Create() must
+// be called on one thread at a time, but the buffers may be released on any
+// thread: when the last reference to a pooled buffer is dropped, the buffer is
+// pushed to a lock-free free list instead of being freed. At most
+// |max_buffers| buffers are pooled; when they are all in use, or the data
+// doesn't fit, Create() falls back to a regular allocation.
+//
+// Pooled buffers may outlive the pool; they are freed when released then.
+class CopyOnWriteBufferPool {
+ public:
+  CopyOnWriteBufferPool(size_t buffer_capacity, size_t max_buffers);
+  ~CopyOnWriteBufferPool();
+
+  // Returns a buffer holding a copy of |data|.
+  template <typename T,
+            typename std::enable_if<
+                internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
+  CopyOnWriteBuffer Create(const T* data, size_t size) {
+    return CreateInternal(reinterpret_cast<const uint8_t*>(data), size);
+  }
+
+  // The number of calls to Create() that reused a pooled buffer, and the
+  // number that had to allocate.
+  int64_t hits() const { return hits_; }
+  int64_t misses() const { return misses_; }
+
+ private:
+  class FreeList;
+  class PooledBuffer;
+
+  CopyOnWriteBuffer CreateInternal(const uint8_t* data, size_t size);
+
+  rtc::RaceChecker race_checker_;
+  const size_t buffer_capacity_;
+  const size_t max_buffers_;
+  const scoped_refptr<FreeList> free_list_;
+  // Buffers taken from |free_list_| and not handed out yet.
+  std::vector<PooledBuffer*> free_buffers_ RTC_GUARDED_BY(race_checker_);
+  size_t num_buffers_ RTC_GUARDED_BY(race_checker_) = 0;
+  int64_t hits_ = 0;
+  int64_t misses_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(CopyOnWriteBufferPool);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_COPYONWRITEBUFFERPOOL_H_
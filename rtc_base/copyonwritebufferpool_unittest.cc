@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copyonwritebufferpool.h"
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "test/gtest.h"
+
+namespace rtc {
+
+namespace {
+
+const uint8_t kTestData[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7};
+
+}  // namespace
+
+TEST(CopyOnWriteBufferPoolTest, ReusesReleasedBuffers) {
+  CopyOnWriteBufferPool pool(16, 4);
+  const uint8_t* data;
+  {
+    CopyOnWriteBuffer buffer = pool.Create(kTestData, sizeof(kTestData));
+    EXPECT_EQ(CopyOnWriteBuffer(kTestData), buffer);
+    EXPECT_EQ(16u, buffer.capacity());
+    data = buffer.cdata();
+  }
+  CopyOnWriteBuffer buffer = pool.Create(kTestData, 4);
+  EXPECT_EQ(CopyOnWriteBuffer(kTestData, 4), buffer);
+  EXPECT_EQ(data, buffer.cdata());
+  EXPECT_EQ(1, pool.hits());
+  EXPECT_EQ(1, pool.misses());
+}
+
+TEST(CopyOnWriteBufferPoolTest, DoesntReuseBuffersInUse) {
+  CopyOnWriteBufferPool pool(16, 4);
+  CopyOnWriteBuffer first = pool.Create(kTestData, sizeof(kTestData));
+  CopyOnWriteBuffer copy = first;
+  first.Clear();
+  CopyOnWriteBuffer second = pool.Create(kTestData, sizeof(kTestData));
+  EXPECT_NE(copy.cdata(), second.cdata());
+  EXPECT_EQ(0, pool.hits());
+}
+
+TEST(CopyOnWriteBufferPoolTest, AllocatesWhenFullOrTooLarge) {
+  CopyOnWriteBufferPool pool(4, 1);
+  CopyOnWriteBuffer large = pool.Create(kTestData, sizeof(kTestData));
+  EXPECT_EQ(CopyOnWriteBuffer(kTestData), large);
+  CopyOnWriteBuffer first = pool.Create(kTestData, 4);
+  CopyOnWriteBuffer second = pool.Create(kTestData, 4);
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first.cdata(), second.cdata());
+  EXPECT_EQ(0, pool.hits());
+  EXPECT_EQ(3, pool.misses());
+}
+
+TEST(CopyOnWriteBufferPoolTest, BuffersMayOutlivePool) {
+  std::unique_ptr<CopyOnWriteBufferPool> pool(new CopyOnWriteBufferPool(16, 4));
+  CopyOnWriteBuffer released = pool->Create(kTestData, sizeof(kTestData));
+  CopyOnWriteBuffer buffer = pool->Create(kTestData, sizeof(kTestData));
+  released.Clear();
+  pool.reset();
+  EXPECT_EQ(CopyOnWriteBuffer(kTestData), buffer);
+}
+
+TEST(CopyOnWriteBufferPoolTest, BuffersMayBeReleasedOnOtherThreads) {
+  CopyOnWriteBufferPool pool(16, 8);
+  for (int i = 0; i < 100; ++i) {
+    CopyOnWriteBuffer buffer = pool.Create(kTestData, sizeof(kTestData));
+    std::thread thread([buffer]() mutable { buffer.Clear(); });
+    buffer.Clear();
+    thread.join();
+  }
+  EXPECT_EQ(99, pool.hits());
+}
+
+}  // namespace rtc
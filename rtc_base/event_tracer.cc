@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -31,6 +32,8 @@
 // This is a guesstimate that should be enough in most cases.
 static const size_t kEventLoggerArgsStrBufferInitialSize = 256;
 static const size_t kTraceArgBufferLength = 32;
+// The TRACE_EVENT macros pass at most two arguments.
+static const int kMaxTraceArgs = 2;
 
 namespace webrtc {
 
@@ -103,9 +106,11 @@ class EventLogger final {
                      uint64_t timestamp,
                      int pid,
                      rtc::PlatformThreadId thread_id) {
-    std::vector<TraceArg> args(num_args);
+    RTC_DCHECK_LE(num_args, kMaxTraceArgs);
+    TraceEvent event = {name,      category_enabled, phase, {}, num_args,
+                        timestamp, pid,              thread_id};
     for (int i = 0; i < num_args; ++i) {
-      TraceArg& arg = args[i];
+      TraceArg& arg = event.args[i];
       arg.name = arg_names[i];
       arg.type = arg_types[i];
       arg.value.as_uint = arg_values[i];
@@ -120,8 +125,14 @@ class EventLogger final {
       }
     }
     rtc::CritScope lock(&crit_);
-    trace_events_.push_back(
-        {name, category_enabled, phase, args, timestamp, 1, thread_id});
+    if (max_events_ > 0 && trace_events_.size() == max_events_) {
+      // The flight recorder is full; replace the oldest event.
+      FreeArgs(&trace_events_[next_event_]);
+      trace_events_[next_event_] = event;
+      next_event_ = (next_event_ + 1) % max_events_;
+      return;
+    }
+    trace_events_.push_back(event);
   }
 
   // The TraceEvent format is documented here:
@@ -138,47 +149,7 @@ class EventLogger final {
         rtc::CritScope lock(&crit_);
         trace_events_.swap(events);
       }
-      std::string args_str;
-      args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
-      for (TraceEvent& e : events) {
-        args_str.clear();
-        if (!e.args.empty()) {
-          args_str += ", \"args\": {";
-          bool is_first_argument = true;
-          for (TraceArg& arg : e.args) {
-            if (!is_first_argument)
-              args_str += ",";
-            is_first_argument = false;
-            args_str += " \"";
-            args_str += arg.name;
-            args_str += "\": ";
-            args_str += TraceArgValueAsString(arg);
-
-            // Delete our copy of the string.
-            if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
-              delete[] arg.value.as_string;
-              arg.value.as_string = nullptr;
-            }
-          }
-          args_str += " }";
-        }
-        fprintf(output_file_,
-                "%s{ \"name\": \"%s\""
-                ", \"cat\": \"%s\""
-                ", \"ph\": \"%c\""
-                ", \"ts\": %" PRIu64
-                ", \"pid\": %d"
-#if defined(WEBRTC_WIN)
-                ", \"tid\": %lu"
-#else
-                ", \"tid\": %d"
-#endif  // defined(WEBRTC_WIN)
-                "%s"
-                "}\n",
-                has_logged_event ? "," : " ", e.name, e.category_enabled,
-                e.phase, e.timestamp, e.pid, e.tid, args_str.c_str());
-        has_logged_event = true;
-      }
+      WriteEvents(output_file_, &events, &has_logged_event);
       if (shutting_down)
         break;
     }
@@ -200,7 +171,7 @@ class EventLogger final {
       // bypassed while the logging thread is shutting down there may be some
       // stale events in the queue, hence the vector needs to be cleared to not
       // log events from a previous logging session (which may be days old).
-      trace_events_.clear();
+      ClearEvents();
     }
     // Enable event logging (fast-path). This should be disabled since starting
     // shouldn't be done twice.
@@ -212,6 +183,44 @@ class EventLogger final {
     TRACE_EVENT_INSTANT0("webrtc", "EventLogger::Start");
   }
 
+  // Records the most recent |max_events| in memory instead of writing events
+  // continuously; they are only written by DumpFlightRecorder.
+  void StartFlightRecorder(size_t max_events) {
+    RTC_DCHECK(thread_checker_.CalledOnValidThread());
+    RTC_DCHECK_GT(max_events, 0);
+    {
+      rtc::CritScope lock(&crit_);
+      ClearEvents();
+      trace_events_.reserve(max_events);
+      max_events_ = max_events;
+    }
+    RTC_CHECK_EQ(0,
+                 rtc::AtomicOps::CompareAndSwap(&g_event_logging_active, 0, 1));
+    flight_recorder_ = true;
+    TRACE_EVENT_INSTANT0("webrtc", "EventLogger::StartFlightRecorder");
+  }
+
+  // Writes the events recorded by the flight recorder, oldest first, and
+  // starts a new recording. May be called on any thread.
+  bool DumpFlightRecorder(FILE* file) {
+    std::vector<TraceEvent> events;
+    {
+      rtc::CritScope lock(&crit_);
+      if (max_events_ == 0)
+        return false;
+      std::rotate(trace_events_.begin(), trace_events_.begin() + next_event_,
+                  trace_events_.end());
+      next_event_ = 0;
+      events.swap(trace_events_);
+      trace_events_.reserve(max_events_);
+    }
+    bool has_logged_event = false;
+    fprintf(file, "{ \"traceEvents\": [\n");
+    WriteEvents(file, &events, &has_logged_event);
+    fprintf(file, "]}\n");
+    return true;
+  }
+
   void Stop() {
     RTC_DCHECK(thread_checker_.CalledOnValidThread());
     TRACE_EVENT_INSTANT0("webrtc", "EventLogger::Stop");
@@ -219,6 +228,13 @@ class EventLogger final {
     if (rtc::AtomicOps::CompareAndSwap(&g_event_logging_active, 1, 0) == 0)
       return;
 
+    if (flight_recorder_) {
+      flight_recorder_ = false;
+      rtc::CritScope lock(&crit_);
+      ClearEvents();
+      max_events_ = 0;
+      return;
+    }
     // Wake up logging thread to finish writing.
     shutdown_event_.Set();
     // Join the logging thread.
@@ -246,16 +262,76 @@ class EventLogger final {
                   "the uint field of that union.");
   };
 
+  // Fixed size, so that recording an event doesn't allocate.
   struct TraceEvent {
     const char* name;
     const unsigned char* category_enabled;
     char phase;
-    std::vector<TraceArg> args;
+    TraceArg args[kMaxTraceArgs];
+    int num_args;
     uint64_t timestamp;
     int pid;
     rtc::PlatformThreadId tid;
   };
 
+  // Deletes our copies of the string arguments of |event|.
+  static void FreeArgs(TraceEvent* event) {
+    for (int i = 0; i < event->num_args; ++i) {
+      TraceArg& arg = event->args[i];
+      if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
+        delete[] arg.value.as_string;
+        arg.value.as_string = nullptr;
+      }
+    }
+  }
+
+  void ClearEvents() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_) {
+    for (TraceEvent& e : trace_events_)
+      FreeArgs(&e);
+    trace_events_.clear();
+    next_event_ = 0;
+  }
+
+  // Writes |events| in the Chrome trace format and frees their arguments.
+  static void WriteEvents(FILE* file,
+                          std::vector<TraceEvent>* events,
+                          bool* has_logged_event) {
+    std::string args_str;
+    args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
+    for (TraceEvent& e : *events) {
+      args_str.clear();
+      if (e.num_args > 0) {
+        args_str += ", \"args\": {";
+        for (int i = 0; i < e.num_args; ++i) {
+          if (i > 0)
+            args_str += ",";
+          args_str += " \"";
+          args_str += e.args[i].name;
+          args_str += "\": ";
+          args_str += TraceArgValueAsString(e.args[i]);
+        }
+        args_str += " }";
+        FreeArgs(&e);
+      }
+      fprintf(file,
+              "%s{ \"name\": \"%s\""
+              ", \"cat\": \"%s\""
+              ", \"ph\": \"%c\""
+              ", \"ts\": %" PRIu64
+              ", \"pid\": %d"
+#if defined(WEBRTC_WIN)
+              ", \"tid\": %lu"
+#else
+              ", \"tid\": %d"
+#endif  // defined(WEBRTC_WIN)
+              "%s"
+              "}\n",
+              *has_logged_event ? "," : " ", e.name, e.category_enabled,
+              e.phase, e.timestamp, e.pid, e.tid, args_str.c_str());
+      *has_logged_event = true;
+    }
+  }
+
   static std::string TraceArgValueAsString(TraceArg arg) {
     std::string output;
 
@@ -318,6 +394,11 @@ class EventLogger final {
 
   rtc::CriticalSection crit_;
   std::vector<TraceEvent> trace_events_ RTC_GUARDED_BY(crit_);
+  // In flight recorder mode, the capacity of |trace_events_|, which is then
+  // used as a ring buffer with the oldest event at |next_event_|. 0 otherwise.
+  size_t max_events_ RTC_GUARDED_BY(crit_) = 0;
+  size_t next_event_ RTC_GUARDED_BY(crit_) = 0;
+  bool flight_recorder_ = false;
   rtc::PlatformThread logging_thread_;
   rtc::Event shutdown_event_;
   rtc::ThreadChecker thread_checker_;
@@ -390,6 +471,18 @@ bool StartInternalCapture(const char* filename) {
   return true;
 }
 
+void StartInternalFlightRecorder(size_t max_events) {
+  if (g_event_logger) {
+    g_event_logger->StartFlightRecorder(max_events);
+  }
+}
+
+bool DumpInternalFlightRecorder(FILE* file) {
+  if (!g_event_logger)
+    return false;
+  return g_event_logger->DumpFlightRecorder(file);
+}
+
 void StopInternalCapture() {
   if (g_event_logger) {
     g_event_logger->Stop();
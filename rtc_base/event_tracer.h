@@ -73,6 +73,13 @@ namespace tracing {
 void SetupInternalTracer();
 bool StartInternalCapture(const char* filename);
 void StartInternalCaptureToFile(FILE* file);
+// Records the most recent |max_events| trace events in memory instead of
+// writing them to a file as they happen, at a constant cost per event.
+// DumpInternalFlightRecorder writes them to |file| in the Chrome trace format
+// and starts a new recording; it returns false if the flight recorder isn't
+// running. StopInternalCapture stops the flight recorder too.
+void StartInternalFlightRecorder(size_t max_events);
+bool DumpInternalFlightRecorder(FILE* file);
 void StopInternalCapture();
 // Make sure we run this, this will tear down the internal tracing.
 void ShutdownInternalTracer();
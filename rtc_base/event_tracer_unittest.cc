@@ -10,6 +10,8 @@
 
 #include "rtc_base/event_tracer.h"
 
+#include <string>
+
 #include "rtc_base/trace_event.h"
 #include "test/gtest.h"
 
@@ -69,4 +71,34 @@ TEST(EventTracerTest, ScopedTraceEvent) {
   TestStatistics::Get()->Reset();
 }
 
+TEST(EventTracerTest, FlightRecorderDumpsMostRecentEvents) {
+  rtc::tracing::SetupInternalTracer();
+  FILE* file = tmpfile();
+  ASSERT_TRUE(file);
+  EXPECT_FALSE(rtc::tracing::DumpInternalFlightRecorder(file));
+
+  rtc::tracing::StartInternalFlightRecorder(2);
+  TRACE_EVENT_INSTANT0("webrtc", "FirstEvent");
+  TRACE_EVENT_INSTANT1("webrtc", "SecondEvent", "value", 2);
+  TRACE_EVENT_INSTANT0("webrtc", "ThirdEvent");
+  EXPECT_TRUE(rtc::tracing::DumpInternalFlightRecorder(file));
+  rtc::tracing::StopInternalCapture();
+  rtc::tracing::ShutdownInternalTracer();
+
+  rewind(file);
+  std::string trace;
+  char buffer[256];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    trace.append(buffer, read);
+  fclose(file);
+  EXPECT_EQ(std::string::npos, trace.find("FirstEvent"));
+  size_t second = trace.find("\"SecondEvent\"");
+  size_t third = trace.find("\"ThirdEvent\"");
+  ASSERT_NE(std::string::npos, second);
+  ASSERT_NE(std::string::npos, third);
+  EXPECT_LT(second, third);
+  EXPECT_NE(std::string::npos, trace.find("\"args\": { \"value\": 2 }"));
+}
+
 }  // namespace webrtc
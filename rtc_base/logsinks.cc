@@ -72,4 +72,91 @@ CallSessionFileRotatingLogSink::CallSessionFileRotatingLogSink(
 
 CallSessionFileRotatingLogSink::~CallSessionFileRotatingLogSink() {}
 
+AsyncLogSink::AsyncLogSink(LogSink* sink, size_t max_queued_messages)
+    : sink_(sink),
+      max_queued_messages_(max_queued_messages),
+      dropped_messages_(0),
+      stopped_(false),
+      wake_up_(false, false),
+      thread_(&AsyncLogSink::DeliverThread, this, "AsyncLogSink") {
+  RTC_DCHECK(sink_);
+  RTC_DCHECK_GT(max_queued_messages_, 0);
+  thread_.Start();
+}
+
+AsyncLogSink::~AsyncLogSink() {
+  {
+    CritScope cs(&crit_);
+    stopped_ = true;
+  }
+  wake_up_.Set();
+  thread_.Stop();
+  // Messages logged while the thread was stopping.
+  DeliverQueued();
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message) {
+  Enqueue(message, LS_NONE, nullptr);
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message,
+                                LoggingSeverity severity) {
+  Enqueue(message, severity, nullptr);
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message,
+                                LoggingSeverity severity,
+                                const char* tag) {
+  Enqueue(message, severity, tag);
+}
+
+int64_t AsyncLogSink::dropped_messages() const {
+  CritScope cs(&crit_);
+  return dropped_messages_;
+}
+
+void AsyncLogSink::Enqueue(const std::string& message,
+                           LoggingSeverity severity,
+                           const char* tag) {
+  bool was_empty;
+  {
+    CritScope cs(&crit_);
+    if (queue_.size() >= max_queued_messages_) {
+      ++dropped_messages_;
+      return;
+    }
+    was_empty = queue_.empty();
+    queue_.push_back(Message{message, severity, tag});
+  }
+  if (was_empty)
+    wake_up_.Set();
+}
+
+// static
+void AsyncLogSink::DeliverThread(void* obj) {
+  AsyncLogSink* self = static_cast<AsyncLogSink*>(obj);
+  while (self->DeliverQueued())
+    self->wake_up_.Wait(Event::kForever);
+}
+
+bool AsyncLogSink::DeliverQueued() {
+  std::vector<Message> messages;
+  bool stopped;
+  {
+    CritScope cs(&crit_);
+    messages.swap(queue_);
+    stopped = stopped_;
+  }
+  for (const Message& message : messages) {
+    if (message.tag) {
+      sink_->OnLogMessage(message.text, message.severity, message.tag);
+    } else if (message.severity != LS_NONE) {
+      sink_->OnLogMessage(message.text, message.severity);
+    } else {
+      sink_->OnLogMessage(message.text);
+    }
+  }
+  return !stopped;
+}
+
 }  // namespace rtc
@@ -14,10 +14,15 @@
 #include <stddef.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
 #include "rtc_base/filerotatingstream.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace rtc {
 
@@ -67,6 +72,57 @@ class CallSessionFileRotatingLogSink : public FileRotatingLogSink {
   RTC_DISALLOW_COPY_AND_ASSIGN(CallSessionFileRotatingLogSink);
 };
 
+// Log sink that forwards the messages to another sink on a thread of its own,
+// so that threads that log don't wait for slow sinks such as files. Logging
+// threads only append the message to a queue; when more than
+// |max_queued_messages| are waiting, further messages are dropped and counted
+// instead of blocking the logging thread. Add this sink, rather than |sink|,
+// with LogMessage::AddLogToStream.
+class AsyncLogSink : public LogSink {
+ public:
+  AsyncLogSink(LogSink* sink, size_t max_queued_messages);
+  // Delivers the queued messages before returning. Must be removed with
+  // LogMessage::RemoveLogToStream before destruction.
+  ~AsyncLogSink() override;
+
+  void OnLogMessage(const std::string& message) override;
+  void OnLogMessage(const std::string& message,
+                    LoggingSeverity severity) override;
+  void OnLogMessage(const std::string& message,
+                    LoggingSeverity severity,
+                    const char* tag) override;
+
+  // The number of messages dropped because the queue was full.
+  int64_t dropped_messages() const;
+
+ private:
+  struct Message {
+    std::string text;
+    // LS_NONE when the message was logged without a severity.
+    LoggingSeverity severity;
+    // Tags are static strings, see LogMessage.
+    const char* tag;
+  };
+
+  static void DeliverThread(void* obj);
+  void Enqueue(const std::string& message,
+               LoggingSeverity severity,
+               const char* tag);
+  // Delivers the queued messages; returns false once stopped.
+  bool DeliverQueued();
+
+  LogSink* const sink_;
+  const size_t max_queued_messages_;
+  rtc::CriticalSection crit_;
+  std::vector<Message> queue_ RTC_GUARDED_BY(crit_);
+  int64_t dropped_messages_ RTC_GUARDED_BY(crit_);
+  bool stopped_ RTC_GUARDED_BY(crit_);
+  Event wake_up_;
+  PlatformThread thread_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AsyncLogSink);
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_LOGSINKS_H_
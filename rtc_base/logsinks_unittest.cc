@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/logsinks.h"
+
+#include <string>
+#include <vector>
+
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread_types.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+// Records the messages and the thread they were delivered on. Optionally
+// blocks in the first call until released.
+class RecordingLogSink : public LogSink {
+ public:
+  explicit RecordingLogSink(bool block_first_message)
+      : block_first_message_(block_first_message),
+        entered_(false, false),
+        release_(false, false) {}
+
+  void OnLogMessage(const std::string& message) override {
+    {
+      CritScope cs(&crit_);
+      messages_.push_back(message);
+      thread_ = CurrentThreadId();
+    }
+    if (block_first_message_) {
+      block_first_message_ = false;
+      entered_.Set();
+      release_.Wait(Event::kForever);
+    }
+  }
+
+  std::vector<std::string> messages() const {
+    CritScope cs(&crit_);
+    return messages_;
+  }
+  PlatformThreadId thread() const {
+    CritScope cs(&crit_);
+    return thread_;
+  }
+
+  bool block_first_message_;
+  Event entered_;
+  Event release_;
+
+ private:
+  CriticalSection crit_;
+  std::vector<std::string> messages_ RTC_GUARDED_BY(crit_);
+  PlatformThreadId thread_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+}  // namespace
+
+TEST(AsyncLogSinkTest, DeliversMessagesOnItsOwnThread) {
+  RecordingLogSink sink(false);
+  {
+    AsyncLogSink async_sink(&sink, 10);
+    LogMessage::AddLogToStream(&async_sink, LS_INFO);
+    RTC_LOG(LS_INFO) << "first";
+    RTC_LOG(LS_WARNING) << "second";
+    LogMessage::RemoveLogToStream(&async_sink);
+  }
+  std::vector<std::string> messages = sink.messages();
+  ASSERT_EQ(2u, messages.size());
+  EXPECT_NE(std::string::npos, messages[0].find("first"));
+  EXPECT_NE(std::string::npos, messages[1].find("second"));
+  EXPECT_NE(CurrentThreadId(), sink.thread());
+}
+
+TEST(AsyncLogSinkTest, DropsMessagesWhenQueueIsFull) {
+  RecordingLogSink sink(true);
+  {
+    AsyncLogSink async_sink(&sink, 2);
+    LogMessage::AddLogToStream(&async_sink, LS_INFO);
+    RTC_LOG(LS_INFO) << "delivered";
+    // The sink blocks the delivery thread, so the next messages queue up.
+    ASSERT_TRUE(sink.entered_.Wait(Event::kForever));
+    for (int i = 0; i < 5; ++i)
+      RTC_LOG(LS_INFO) << "queued " << i;
+    LogMessage::RemoveLogToStream(&async_sink);
+    EXPECT_EQ(3, async_sink.dropped_messages());
+    sink.release_.Set();
+  }
+  std::vector<std::string> messages = sink.messages();
+  ASSERT_EQ(3u, messages.size());
+  EXPECT_NE(std::string::npos, messages[1].find("queued 0"));
+  EXPECT_NE(std::string::npos, messages[2].find("queued 1"));
+}
+
+}  // namespace rtc
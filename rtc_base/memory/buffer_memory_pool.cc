@@ -0,0 +1,226 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/buffer_memory_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+namespace {
+
+// Each block starts with a header holding its size class, padded to keep the
+// returned memory aligned.
+constexpr size_t kHeaderSize = alignof(std::max_align_t);
+static_assert(kHeaderSize >= sizeof(size_t), "");
+constexpr size_t kUnpooled = static_cast<size_t>(-1);
+
+constexpr size_t kMinBlockSize = 64;
+constexpr size_t kNumSizeClasses = 11;
+static_assert(kMinBlockSize << (kNumSizeClasses - 1) == kMaxPooledBufferSize,
+              "");
+
+// Limits on the memory cached for each size class.
+constexpr size_t kThreadCacheBytes = 256 * 1024;
+constexpr size_t kSharedCacheBytes = 4 * 1024 * 1024;
+
+std::atomic<bool> g_enabled(false);
+std::atomic<int64_t> g_pooled_allocations(0);
+std::atomic<int64_t> g_new_blocks(0);
+std::atomic<int64_t> g_pool_bytes(0);
+
+size_t BlockSize(size_t size_class) {
+  return kMinBlockSize << size_class;
+}
+
+size_t SizeClass(size_t size) {
+  size_t size_class = 0;
+  while (BlockSize(size_class) < size)
+    ++size_class;
+  return size_class;
+}
+
+size_t ThreadCacheCapacity(size_t size_class) {
+  return std::max<size_t>(4, kThreadCacheBytes / BlockSize(size_class));
+}
+
+size_t SharedCacheCapacity(size_t size_class) {
+  return kSharedCacheBytes / BlockSize(size_class);
+}
+
+void DeletePooledBlock(char* block, size_t size_class) {
+  g_pool_bytes.fetch_sub(BlockSize(size_class), std::memory_order_relaxed);
+  ::operator delete(block);
+}
+
+class SharedCache {
+ public:
+  // Moves up to |count| blocks of |size_class| to |blocks|.
+  void Take(size_t size_class, size_t count, std::vector<char*>* blocks) {
+    CritScope cs(&crit_);
+    std::vector<char*>& cached = blocks_[size_class];
+    count = std::min(count, cached.size());
+    blocks->insert(blocks->end(), cached.end() - count, cached.end());
+    cached.resize(cached.size() - count);
+    bytes_ -= count * BlockSize(size_class);
+  }
+
+  // Moves the blocks of |size_class| from index |first| on out of |blocks| to
+  // the cache. Blocks that don't fit are freed.
+  void Give(size_t size_class, std::vector<char*>* blocks, size_t first) {
+    size_t i = first;
+    {
+      CritScope cs(&crit_);
+      std::vector<char*>& cached = blocks_[size_class];
+      const size_t count = std::min(blocks->size() - first,
+                                    SharedCacheCapacity(size_class) -
+                                        cached.size());
+      cached.insert(cached.end(), blocks->begin() + first,
+                    blocks->begin() + first + count);
+      bytes_ += count * BlockSize(size_class);
+      i += count;
+    }
+    for (; i < blocks->size(); ++i)
+      DeletePooledBlock((*blocks)[i], size_class);
+    blocks->resize(first);
+  }
+
+  int64_t bytes() const {
+    CritScope cs(&crit_);
+    return bytes_;
+  }
+
+ private:
+  CriticalSection crit_;
+  std::vector<char*> blocks_[kNumSizeClasses] RTC_GUARDED_BY(crit_);
+  int64_t bytes_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+SharedCache* GetSharedCache() {
+  // Leaked so that threads exiting after static destruction can still return
+  // their blocks.
+  static SharedCache* const shared_cache = new SharedCache();
+  return shared_cache;
+}
+
+// Set when the cache of the current thread has been destroyed, after which the
+// thread allocates and frees pooled blocks without caching them.
+thread_local bool g_thread_cache_destroyed = false;
+
+class ThreadCache {
+ public:
+  ~ThreadCache() {
+    g_thread_cache_destroyed = true;
+    for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+      GetSharedCache()->Give(size_class, &blocks_[size_class], 0);
+    }
+  }
+
+  char* Allocate(size_t size_class) {
+    std::vector<char*>& blocks = blocks_[size_class];
+    if (blocks.empty()) {
+      GetSharedCache()->Take(size_class, ThreadCacheCapacity(size_class) / 2,
+                             &blocks);
+      if (blocks.empty())
+        return nullptr;
+    }
+    char* block = blocks.back();
+    blocks.pop_back();
+    return block;
+  }
+
+  void Free(char* block, size_t size_class) {
+    std::vector<char*>& blocks = blocks_[size_class];
+    blocks.push_back(block);
+    const size_t capacity = ThreadCacheCapacity(size_class);
+    if (blocks.size() > capacity) {
+      // Keep half of the blocks, so that a thread that only frees doesn't
+      // take the lock on every call.
+      GetSharedCache()->Give(size_class, &blocks, capacity / 2);
+    }
+  }
+
+ private:
+  std::vector<char*> blocks_[kNumSizeClasses];
+};
+
+ThreadCache* GetThreadCache() {
+  if (g_thread_cache_destroyed)
+    return nullptr;
+  static thread_local ThreadCache thread_cache;
+  return &thread_cache;
+}
+
+}  // namespace
+
+void EnableBufferMemoryPool(bool enable) {
+  g_enabled.store(enable, std::memory_order_relaxed);
+}
+
+void* AllocateBufferMemory(size_t size) {
+  char* block;
+  if (!g_enabled.load(std::memory_order_relaxed) ||
+      size > kMaxPooledBufferSize) {
+    block = static_cast<char*>(::operator new(kHeaderSize + size));
+    *reinterpret_cast<size_t*>(block) = kUnpooled;
+    return block + kHeaderSize;
+  }
+
+  g_pooled_allocations.fetch_add(1, std::memory_order_relaxed);
+  const size_t size_class = SizeClass(size);
+  ThreadCache* thread_cache = GetThreadCache();
+  block = thread_cache ? thread_cache->Allocate(size_class) : nullptr;
+  if (!block) {
+    g_new_blocks.fetch_add(1, std::memory_order_relaxed);
+    g_pool_bytes.fetch_add(BlockSize(size_class), std::memory_order_relaxed);
+    block =
+        static_cast<char*>(::operator new(kHeaderSize + BlockSize(size_class)));
+    *reinterpret_cast<size_t*>(block) = size_class;
+  }
+  RTC_DCHECK_EQ(size_class, *reinterpret_cast<size_t*>(block));
+  return block + kHeaderSize;
+}
+
+void FreeBufferMemory(void* memory) {
+  if (!memory)
+    return;
+  char* block = static_cast<char*>(memory) - kHeaderSize;
+  const size_t size_class = *reinterpret_cast<size_t*>(block);
+  if (size_class == kUnpooled) {
+    ::operator delete(block);
+    return;
+  }
+  RTC_DCHECK_LT(size_class, kNumSizeClasses);
+  ThreadCache* thread_cache = GetThreadCache();
+  if (thread_cache) {
+    thread_cache->Free(block, size_class);
+  } else {
+    DeletePooledBlock(block, size_class);
+  }
+}
+
+BufferMemoryPoolStats GetBufferMemoryPoolStats() {
+  BufferMemoryPoolStats stats;
+  stats.pooled_allocations =
+      g_pooled_allocations.load(std::memory_order_relaxed);
+  stats.new_blocks = g_new_blocks.load(std::memory_order_relaxed);
+  stats.pool_bytes = g_pool_bytes.load(std::memory_order_relaxed);
+  stats.shared_cache_bytes = GetSharedCache()->bytes();
+  return stats;
+}
+
+}  // namespace rtc
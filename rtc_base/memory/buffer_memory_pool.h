@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_BUFFER_MEMORY_POOL_H_
+#define RTC_BASE_MEMORY_BUFFER_MEMORY_POOL_H_
+
+// Memory for rtc::BufferT, and thereby rtc::CopyOnWriteBuffer and the RTP
+// packet classes, is allocated with AllocateBufferMemory(). By default this is
+// a plain heap allocation. When the pool is enabled, allocations of up to
+// kMaxPooledBufferSize bytes are rounded up to a power of two and recycled
+// through a small per-thread cache for each size, backed by a shared cache
+// that moves blocks from threads that free them to threads that allocate them.
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace rtc {
+
+constexpr size_t kMaxPooledBufferSize = 64 * 1024;
+
+// Enables or disables recycling of buffer memory. Memory allocated while the
+// pool is disabled is never recycled. Disabling the pool doesn't release the
+// cached memory.
+void EnableBufferMemoryPool(bool enable);
+
+// Allocates |size| bytes of uninitialized memory, which must be released with
+// FreeBufferMemory(). The memory is aligned like memory from operator new.
+void* AllocateBufferMemory(size_t size);
+
+// Releases memory allocated with AllocateBufferMemory(). |memory| may be null.
+void FreeBufferMemory(void* memory);
+
+struct BufferMemoryPoolStats {
+  // Number of allocations made while the pool was enabled.
+  int64_t pooled_allocations = 0;
+  // Number of those allocations that had to allocate a new block.
+  int64_t new_blocks = 0;
+  // Bytes in blocks owned by the pool, whether in use or cached.
+  int64_t pool_bytes = 0;
+  // Bytes in blocks cached in the shared cache, i.e. not counting the
+  // per-thread caches.
+  int64_t shared_cache_bytes = 0;
+};
+
+BufferMemoryPoolStats GetBufferMemoryPoolStats();
+
+namespace internal {
+
+struct BufferMemoryDeleter {
+  void operator()(void* memory) const { FreeBufferMemory(memory); }
+};
+
+}  // namespace internal
+}  // namespace rtc
+
+#endif  // RTC_BASE_MEMORY_BUFFER_MEMORY_POOL_H_
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/buffer_memory_pool.h"
+
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+class BufferMemoryPoolTest : public ::testing::Test {
+ protected:
+  BufferMemoryPoolTest() { EnableBufferMemoryPool(true); }
+  ~BufferMemoryPoolTest() override { EnableBufferMemoryPool(false); }
+};
+
+void FreeBlocks(void* blocks) {
+  for (void* block : *static_cast<std::vector<void*>*>(blocks))
+    FreeBufferMemory(block);
+}
+
+}  // namespace
+
+TEST_F(BufferMemoryPoolTest, ReusesFreedMemoryOfSameSizeClass) {
+  void* memory = AllocateBufferMemory(100);
+  FreeBufferMemory(memory);
+  const BufferMemoryPoolStats stats = GetBufferMemoryPoolStats();
+  EXPECT_EQ(memory, AllocateBufferMemory(128));
+  EXPECT_EQ(stats.new_blocks, GetBufferMemoryPoolStats().new_blocks);
+  EXPECT_EQ(stats.pooled_allocations + 1,
+            GetBufferMemoryPoolStats().pooled_allocations);
+  FreeBufferMemory(memory);
+}
+
+TEST_F(BufferMemoryPoolTest, DoesNotPoolLargeOrUnpooledAllocations) {
+  const BufferMemoryPoolStats stats = GetBufferMemoryPoolStats();
+  FreeBufferMemory(AllocateBufferMemory(kMaxPooledBufferSize + 1));
+  EnableBufferMemoryPool(false);
+  FreeBufferMemory(AllocateBufferMemory(100));
+  EXPECT_EQ(stats.pooled_allocations,
+            GetBufferMemoryPoolStats().pooled_allocations);
+}
+
+TEST_F(BufferMemoryPoolTest, ReusesMemoryFreedOnAnotherThread) {
+  constexpr size_t kSize = 32 * 1024;
+  std::vector<void*> blocks;
+  for (int i = 0; i < 4; ++i)
+    blocks.push_back(AllocateBufferMemory(kSize));
+
+  // The blocks are returned to the shared cache when the thread exits.
+  PlatformThread thread(&FreeBlocks, &blocks, "FreeBlocks");
+  thread.Start();
+  thread.Stop();
+
+  const BufferMemoryPoolStats stats = GetBufferMemoryPoolStats();
+  EXPECT_GE(stats.shared_cache_bytes, static_cast<int64_t>(4 * kSize));
+  for (int i = 0; i < 4; ++i)
+    blocks[i] = AllocateBufferMemory(kSize);
+  EXPECT_EQ(stats.new_blocks, GetBufferMemoryPoolStats().new_blocks);
+  FreeBlocks(&blocks);
+}
+
+}  // namespace rtc
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/memory_account.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+namespace {
+
+class AccountRegistry {
+ public:
+  void Register(MemoryAccount* account) {
+    CritScope cs(&crit_);
+    accounts_.push_back(account);
+  }
+
+  void Unregister(MemoryAccount* account) {
+    CritScope cs(&crit_);
+    auto it = std::find(accounts_.begin(), accounts_.end(), account);
+    RTC_DCHECK(it != accounts_.end());
+    accounts_.erase(it);
+  }
+
+  std::vector<MemoryAccountStats> GetStats() const {
+    CritScope cs(&crit_);
+    std::vector<MemoryAccountStats> stats(accounts_.size());
+    for (size_t i = 0; i < accounts_.size(); ++i) {
+      stats[i].component = accounts_[i]->component();
+      stats[i].bytes = accounts_[i]->bytes();
+      stats[i].peak_bytes = accounts_[i]->peak_bytes();
+      stats[i].budget_bytes = accounts_[i]->budget_bytes();
+    }
+    return stats;
+  }
+
+ private:
+  CriticalSection crit_;
+  std::vector<MemoryAccount*> accounts_ RTC_GUARDED_BY(crit_);
+};
+
+AccountRegistry* GetRegistry() {
+  static AccountRegistry* const registry = new AccountRegistry();
+  return registry;
+}
+
+}  // namespace
+
+constexpr int64_t MemoryAccount::kNoBudget;
+
+MemoryAccount::MemoryAccount(const char* component)
+    : component_(component),
+      bytes_(0),
+      peak_bytes_(0),
+      budget_bytes_(kNoBudget) {
+  GetRegistry()->Register(this);
+}
+
+MemoryAccount::~MemoryAccount() {
+  GetRegistry()->Unregister(this);
+}
+
+void MemoryAccount::Add(size_t bytes) {
+  const int64_t new_bytes = this->bytes() + static_cast<int64_t>(bytes);
+  bytes_.store(new_bytes, std::memory_order_relaxed);
+  if (new_bytes > peak_bytes())
+    peak_bytes_.store(new_bytes, std::memory_order_relaxed);
+}
+
+void MemoryAccount::Subtract(size_t bytes) {
+  RTC_DCHECK_GE(this->bytes(), static_cast<int64_t>(bytes));
+  bytes_.store(this->bytes() - static_cast<int64_t>(bytes),
+               std::memory_order_relaxed);
+}
+
+void MemoryAccount::set_budget_bytes(absl::optional<size_t> budget_bytes) {
+  budget_bytes_.store(
+      budget_bytes ? static_cast<int64_t>(*budget_bytes) : kNoBudget,
+      std::memory_order_relaxed);
+}
+
+absl::optional<size_t> MemoryAccount::budget_bytes() const {
+  const int64_t budget_bytes = budget_bytes_.load(std::memory_order_relaxed);
+  if (budget_bytes == kNoBudget)
+    return absl::nullopt;
+  return static_cast<size_t>(budget_bytes);
+}
+
+bool MemoryAccount::IsOverBudget(size_t additional_bytes) const {
+  const int64_t budget_bytes = budget_bytes_.load(std::memory_order_relaxed);
+  return budget_bytes != kNoBudget &&
+         bytes() + static_cast<int64_t>(additional_bytes) > budget_bytes;
+}
+
+std::vector<MemoryAccountStats> GetMemoryAccountStats() {
+  return GetRegistry()->GetStats();
+}
+
+}  // namespace rtc
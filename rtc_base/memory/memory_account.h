@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_MEMORY_ACCOUNT_H_
+#define RTC_BASE_MEMORY_MEMORY_ACCOUNT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/constructormagic.h"
+
+namespace rtc {
+
+// Tracks the memory held by one instance of a component, such as the packet
+// history of one stream, and optionally a budget for it. The component calls
+// Add() and Subtract() as it allocates and releases memory, and sheds memory
+// when IsOverBudget() returns true. All accounts are listed by
+// GetMemoryAccountStats().
+//
+// Add(), Subtract() and set_budget_bytes() must not be called concurrently,
+// but the account may be read on any thread.
+class MemoryAccount {
+ public:
+  // |component| must be a string literal, e.g. "RtpPacketHistory".
+  explicit MemoryAccount(const char* component);
+  ~MemoryAccount();
+
+  void Add(size_t bytes);
+  void Subtract(size_t bytes);
+
+  const char* component() const { return component_; }
+  int64_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+  int64_t peak_bytes() const {
+    return peak_bytes_.load(std::memory_order_relaxed);
+  }
+
+  void set_budget_bytes(absl::optional<size_t> budget_bytes);
+  absl::optional<size_t> budget_bytes() const;
+  // Returns true if adding |additional_bytes| would exceed the budget.
+  bool IsOverBudget(size_t additional_bytes = 0) const;
+
+ private:
+  static constexpr int64_t kNoBudget = -1;
+
+  const char* const component_;
+  std::atomic<int64_t> bytes_;
+  std::atomic<int64_t> peak_bytes_;
+  std::atomic<int64_t> budget_bytes_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MemoryAccount);
+};
+
+struct MemoryAccountStats {
+  std::string component;
+  int64_t bytes = 0;
+  int64_t peak_bytes = 0;
+  absl::optional<size_t> budget_bytes;
+};
+
+// Returns the current state of all existing accounts.
+std::vector<MemoryAccountStats> GetMemoryAccountStats();
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_MEMORY_MEMORY_ACCOUNT_H_
@@ -0,0 +1,70 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/memory_account.h"
+
+#include <string>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+const MemoryAccountStats* FindStats(
+    const std::vector<MemoryAccountStats>& stats,
+    const std::string& component) {
+  for (const MemoryAccountStats& account_stats : stats) {
+    if (account_stats.component == component)
+      return &account_stats;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(MemoryAccountTest, TracksCurrentAndPeakBytes) {
+  MemoryAccount account("Test");
+  account.Add(100);
+  account.Add(50);
+  account.Subtract(120);
+  EXPECT_EQ(30, account.bytes());
+  EXPECT_EQ(150, account.peak_bytes());
+}
+
+TEST(MemoryAccountTest, ChecksBudget) {
+  MemoryAccount account("Test");
+  account.Add(100);
+  EXPECT_FALSE(account.IsOverBudget(1000000));
+  account.set_budget_bytes(150);
+  EXPECT_FALSE(account.IsOverBudget());
+  EXPECT_FALSE(account.IsOverBudget(50));
+  EXPECT_TRUE(account.IsOverBudget(51));
+  account.set_budget_bytes(absl::nullopt);
+  EXPECT_FALSE(account.IsOverBudget(51));
+}
+
+TEST(MemoryAccountTest, ListsExistingAccounts) {
+  {
+    MemoryAccount account("MemoryAccountTest");
+    account.Add(10);
+    account.set_budget_bytes(20);
+    const std::vector<MemoryAccountStats> stats = GetMemoryAccountStats();
+    const MemoryAccountStats* account_stats =
+        FindStats(stats, "MemoryAccountTest");
+    ASSERT_TRUE(account_stats);
+    EXPECT_EQ(10, account_stats->bytes);
+    EXPECT_EQ(10, account_stats->peak_bytes);
+    EXPECT_EQ(20u, account_stats->budget_bytes);
+  }
+  EXPECT_FALSE(FindStats(GetMemoryAccountStats(), "MemoryAccountTest"));
+}
+
+}  // namespace rtc
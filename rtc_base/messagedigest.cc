@@ -10,6 +10,7 @@
 
 #include "rtc_base/messagedigest.h"
 
+#include <openssl/sha.h>
 #include <string.h>
 #include <cstdint>
 #include <memory>
@@ -178,4 +179,47 @@ std::string ComputeHmac(const std::string& alg,
   return output;
 }
 
+size_t ComputeHmacSha1(const void* key,
+                       size_t key_len,
+                       const void* const* inputs,
+                       const size_t* input_lengths,
+                       size_t count,
+                       void* output,
+                       size_t out_len) {
+  static_assert(kSha1DigestSize == SHA_DIGEST_LENGTH, "");
+  static_assert(kBlockSize == SHA_CBLOCK, "");
+  if (out_len < kSha1DigestSize) {
+    return 0;
+  }
+  // Same construction as ComputeHmac(), with the state kept on the stack.
+  uint8_t block[kBlockSize] = {0};
+  SHA_CTX ctx;
+  if (key_len > kBlockSize) {
+    SHA1_Init(&ctx);
+    SHA1_Update(&ctx, key, key_len);
+    SHA1_Final(block, &ctx);
+  } else {
+    memcpy(block, key, key_len);
+  }
+  uint8_t pad[kBlockSize];
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    pad[i] = 0x36 ^ block[i];
+  }
+  uint8_t inner[kSha1DigestSize];
+  SHA1_Init(&ctx);
+  SHA1_Update(&ctx, pad, kBlockSize);
+  for (size_t i = 0; i < count; ++i) {
+    SHA1_Update(&ctx, inputs[i], input_lengths[i]);
+  }
+  SHA1_Final(inner, &ctx);
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    pad[i] = 0x5c ^ block[i];
+  }
+  SHA1_Init(&ctx);
+  SHA1_Update(&ctx, pad, kBlockSize);
+  SHA1_Update(&ctx, inner, kSha1DigestSize);
+  SHA1_Final(static_cast<uint8_t*>(output), &ctx);
+  return kSha1DigestSize;
+}
+
 }  // namespace rtc
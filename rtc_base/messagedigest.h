@@ -124,6 +124,23 @@ bool ComputeHmac(const std::string& alg,
                  const std::string& input,
                  std::string* output);
 
+// Size of a SHA-1 digest, and thus of a SHA-1 HMAC.
+const size_t kSha1DigestSize = 20;
+
+// Computes the SHA-1 HMAC of the concatenation of |count| buffers, where
+// buffer i is |input_lengths[i]| bytes at |inputs[i]|, using |key_len| bytes
+// of |key|. Writes the HMAC to |output|, which is |out_len| bytes long.
+// Returns kSha1DigestSize if successful, or 0 if |out_len| was too small.
+// Unlike ComputeHmac() this does not allocate, and lets a message be hashed
+// in pieces instead of being copied into a single buffer first.
+size_t ComputeHmacSha1(const void* key,
+                       size_t key_len,
+                       const void* const* inputs,
+                       const size_t* input_lengths,
+                       size_t count,
+                       void* output,
+                       size_t out_len);
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_MESSAGEDIGEST_H_
@@ -146,6 +146,33 @@ TEST(MessageDigestTest, TestSha1Hmac) {
                         input.size(), output, sizeof(output) - 1));
 }
 
+// Checks ComputeHmacSha1() against ComputeHmac(), hashing the input in one or
+// more pieces.
+TEST(MessageDigestTest, TestSha1HmacInPieces) {
+  const std::string kInput =
+      "Test Using Larger Than Block-Size Key and Larger Than One Block-Size "
+      "Data";
+  const std::string kKeys[] = {std::string(20, '\x0b'), "Jefe",
+                               std::string(80, '\xaa')};
+  for (const std::string& key : kKeys) {
+    const std::string expected = ComputeHmac(DIGEST_SHA_1, key, kInput);
+    for (size_t split : {size_t{0}, size_t{20}, kInput.size()}) {
+      const void* inputs[] = {kInput.data(), kInput.data() + split};
+      const size_t lengths[] = {split, kInput.size() - split};
+      char output[kSha1DigestSize];
+      EXPECT_EQ(sizeof(output),
+                ComputeHmacSha1(key.data(), key.size(), inputs, lengths, 2,
+                                output, sizeof(output)));
+      EXPECT_EQ(expected, hex_encode(output, sizeof(output)));
+    }
+  }
+  const void* inputs[] = {kInput.data()};
+  const size_t lengths[] = {kInput.size()};
+  char output[kSha1DigestSize];
+  EXPECT_EQ(0U, ComputeHmacSha1("key", 3, inputs, lengths, 1, output,
+                                sizeof(output) - 1));
+}
+
 TEST(MessageDigestTest, TestBadHmac) {
   std::string output;
   EXPECT_FALSE(ComputeHmac("sha-9000", "key", "abc", &output));
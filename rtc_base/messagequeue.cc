@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 #include <algorithm>
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -45,8 +46,287 @@ class RTC_SCOPED_LOCKABLE MarkProcessingCritScope {
 
   RTC_DISALLOW_COPY_AND_ASSIGN(MarkProcessingCritScope);
 };
+
+// Returns the index of the lowest set bit of |x|, which must not be zero.
+int LowestSetBit(uint64_t x) {
+  int n = 0;
+  for (int shift = 32; shift > 0; shift >>= 1) {
+    if ((x & ((uint64_t{1} << shift) - 1)) == 0) {
+      n += shift;
+      x >>= shift;
+    }
+  }
+  return n;
+}
+
+// Returns how many slots after |start| the first set bit of |mask| is,
+// wrapping around, or -1 if no bit is set.
+int NextOccupiedOffset(uint64_t mask, int start) {
+  if (mask == 0)
+    return -1;
+  if (start != 0)
+    mask = (mask >> start) | (mask << (64 - start));
+  return LowestSetBit(mask);
+}
 }  // namespace
 
+//------------------------------------------------------------------
+// DelayedMessageQueue
+
+constexpr int DelayedMessageQueue::kSlotBits;
+constexpr int DelayedMessageQueue::kSlots;
+constexpr int DelayedMessageQueue::kLevels;
+constexpr int DelayedMessageQueue::kTriggeredList;
+constexpr int DelayedMessageQueue::kOverflowList;
+
+DelayedMessageQueue::DelayedMessageQueue() {
+  static_assert(kSlots <= 64, "Occupied slots must fit in uint64_t.");
+}
+
+DelayedMessageQueue::~DelayedMessageQueue() {
+  for (auto& handler_nodes : handler_nodes_) {
+    Node* node = handler_nodes.second;
+    while (node) {
+      Node* next = node->handler_next;
+      delete node;
+      node = next;
+    }
+  }
+}
+
+void DelayedMessageQueue::Push(const DelayedMessage& dmsg) {
+  // With nothing in the wheel, move it to the time the message was posted.
+  if (wheel_size_ == 0)
+    now_ms_ = dmsg.msTrigger_ - std::max<int64_t>(dmsg.cmsDelay_, 0);
+  Node* node = new Node(dmsg);
+  Place(node);
+  LinkHandler(node);
+  ++size_;
+  if (size_ == 1) {
+    next_trigger_ms_ = dmsg.msTrigger_;
+    next_trigger_valid_ = true;
+  } else if (next_trigger_valid_) {
+    next_trigger_ms_ = std::min(next_trigger_ms_, dmsg.msTrigger_);
+  }
+}
+
+int64_t DelayedMessageQueue::NextTriggerTime() const {
+  RTC_DCHECK(!empty());
+  if (!next_trigger_valid_) {
+    next_trigger_ms_ = ComputeNextTriggerTime();
+    next_trigger_valid_ = true;
+  }
+  return next_trigger_ms_;
+}
+
+void DelayedMessageQueue::PopTriggered(int64_t now_ms,
+                                       MessageList* messages) {
+  std::vector<Node*> triggered;
+  while (wheel_size_ > 0 && now_ms_ <= now_ms) {
+    int index = now_ms_ & (kSlots - 1);
+    if (index == 0)
+      Cascade(1);
+    while (Node* node = slots_[0][index]) {
+      Unlink(node);
+      triggered.push_back(node);
+    }
+    // Skip the empty slots, but stop at the end of the rotation so that the
+    // next level gets cascaded.
+    int offset = NextOccupiedOffset(occupied_slots_[0], index);
+    int step = kSlots - index;
+    if (offset > 0 && offset < step)
+      step = offset;
+    now_ms_ = std::min(now_ms_ + step, now_ms + 1);
+  }
+  for (Node* node = triggered_; node;) {
+    Node* next = node->next;
+    if (node->dmsg.msTrigger_ <= now_ms) {
+      Unlink(node);
+      triggered.push_back(node);
+    }
+    node = next;
+  }
+  if (triggered.empty())
+    return;
+
+  std::sort(triggered.begin(), triggered.end(),
+            [](const Node* a, const Node* b) { return b->dmsg < a->dmsg; });
+  for (Node* node : triggered) {
+    messages->push_back(node->dmsg.msg_);
+    UnlinkHandler(node);
+    delete node;
+  }
+  size_ -= triggered.size();
+  next_trigger_valid_ = false;
+}
+
+void DelayedMessageQueue::Clear(MessageHandler* phandler,
+                                uint32_t id,
+                                MessageList* removed) {
+  std::vector<Node*> matching;
+  if (phandler) {
+    auto it = handler_nodes_.find(phandler);
+    if (it == handler_nodes_.end())
+      return;
+    for (Node* node = it->second; node; node = node->handler_next) {
+      if (node->dmsg.msg_.Match(phandler, id))
+        matching.push_back(node);
+    }
+  } else {
+    for (auto& handler_nodes : handler_nodes_) {
+      for (Node* node = handler_nodes.second; node;
+           node = node->handler_next) {
+        if (node->dmsg.msg_.Match(phandler, id))
+          matching.push_back(node);
+      }
+    }
+  }
+  // Take all matching messages out before deleting any data, since that may
+  // clear this queue again.
+  MessageList messages;
+  for (Node* node : matching) {
+    Unlink(node);
+    UnlinkHandler(node);
+    if (next_trigger_valid_ && node->dmsg.msTrigger_ <= next_trigger_ms_)
+      next_trigger_valid_ = false;
+    messages.push_back(node->dmsg.msg_);
+    delete node;
+  }
+  size_ -= matching.size();
+  if (removed) {
+    removed->splice(removed->end(), messages);
+  } else {
+    for (Message& msg : messages)
+      delete msg.pdata;
+  }
+}
+
+DelayedMessageQueue::Node** DelayedMessageQueue::ListHead(int level,
+                                                          int slot) {
+  if (level == kTriggeredList)
+    return &triggered_;
+  if (level == kOverflowList)
+    return &overflow_;
+  return &slots_[level][slot];
+}
+
+void DelayedMessageQueue::Place(Node* node) {
+  int64_t trigger = node->dmsg.msTrigger_;
+  if (trigger < now_ms_) {
+    Link(node, kTriggeredList, 0);
+    return;
+  }
+  int64_t delta = trigger - now_ms_;
+  for (int level = 0; level < kLevels; ++level) {
+    if (delta < (int64_t{1} << (kSlotBits * (level + 1)))) {
+      Link(node, level, (trigger >> (kSlotBits * level)) & (kSlots - 1));
+      return;
+    }
+  }
+  Link(node, kOverflowList, 0);
+}
+
+void DelayedMessageQueue::Link(Node* node, int level, int slot) {
+  Node** head = ListHead(level, slot);
+  node->level = level;
+  node->slot = slot;
+  node->prev = nullptr;
+  node->next = *head;
+  if (*head)
+    (*head)->prev = node;
+  *head = node;
+  if (level >= 0 && level < kLevels)
+    occupied_slots_[level] |= uint64_t{1} << slot;
+  if (level != kTriggeredList)
+    ++wheel_size_;
+}
+
+void DelayedMessageQueue::Unlink(Node* node) {
+  Node** head = ListHead(node->level, node->slot);
+  if (node->prev)
+    node->prev->next = node->next;
+  else
+    *head = node->next;
+  if (node->next)
+    node->next->prev = node->prev;
+  if (node->level >= 0 && node->level < kLevels && !*head)
+    occupied_slots_[node->level] &= ~(uint64_t{1} << node->slot);
+  if (node->level != kTriggeredList)
+    --wheel_size_;
+}
+
+void DelayedMessageQueue::LinkHandler(Node* node) {
+  Node*& head = handler_nodes_[node->dmsg.msg_.phandler];
+  node->handler_prev = nullptr;
+  node->handler_next = head;
+  if (head)
+    head->handler_prev = node;
+  head = node;
+}
+
+void DelayedMessageQueue::UnlinkHandler(Node* node) {
+  if (node->handler_prev) {
+    node->handler_prev->handler_next = node->handler_next;
+  } else if (node->handler_next) {
+    handler_nodes_[node->dmsg.msg_.phandler] = node->handler_next;
+  } else {
+    handler_nodes_.erase(node->dmsg.msg_.phandler);
+  }
+  if (node->handler_next)
+    node->handler_next->handler_prev = node->handler_prev;
+}
+
+void DelayedMessageQueue::Cascade(int level) {
+  int index = (now_ms_ >> (kSlotBits * level)) & (kSlots - 1);
+  Replace(slots_[level][index]);
+  if (index != 0)
+    return;
+  if (level + 1 < kLevels) {
+    Cascade(level + 1);
+  } else {
+    // A full rotation of the top level; bring the overflow list closer.
+    Replace(overflow_);
+  }
+}
+
+void DelayedMessageQueue::Replace(Node* list) {
+  while (list) {
+    Node* next = list->next;
+    Unlink(list);
+    Place(list);
+    list = next;
+  }
+}
+
+int64_t DelayedMessageQueue::ComputeNextTriggerTime() const {
+  int64_t next_trigger_ms = std::numeric_limits<int64_t>::max();
+  auto scan_list = [&next_trigger_ms](const Node* node) {
+    for (; node; node = node->next)
+      next_trigger_ms = std::min(next_trigger_ms, node->dmsg.msTrigger_);
+  };
+  scan_list(triggered_);
+  for (int level = 0; level < kLevels; ++level) {
+    // Unless the wheel time is at the start of its span, the current slot of
+    // a higher level has already been cascaded, so it only holds messages a
+    // full rotation away.
+    int shift = kSlotBits * level;
+    int64_t position = now_ms_ >> shift;
+    if ((now_ms_ & ((int64_t{1} << shift) - 1)) != 0)
+      ++position;
+    int offset = NextOccupiedOffset(occupied_slots_[level],
+                                    position & (kSlots - 1));
+    if (offset < 0)
+      continue;
+    position += offset;
+    // No message in the slot triggers before the start of its time span.
+    if ((position << shift) >= next_trigger_ms)
+      continue;
+    scan_list(slots_[level][position & (kSlots - 1)]);
+  }
+  scan_list(overflow_);
+  return next_trigger_ms;
+}
+
 //------------------------------------------------------------------
 // MessageQueueManager
 
@@ -155,6 +435,10 @@ MessageQueue::MessageQueue(SocketServer* ss, bool init_queue)
       fInitialized_(false),
       fDestroyed_(false),
       stop_(0),
+      messages_dispatched_(0),
+      busy_time_us_(0),
+      queue_wait_time_us_(0),
+      max_dispatch_time_us_(0),
       ss_(ss) {
   RTC_DCHECK(ss);
   // Currently, MessageQueue holds a socket server, and is the base class for
@@ -274,13 +558,9 @@ bool MessageQueue::Get(Message* pmsg, int cmsWait, bool process_io) {
         // triggered and calculate the next trigger time.
         if (first_pass) {
           first_pass = false;
-          while (!dmsgq_.empty()) {
-            if (msCurrent < dmsgq_.top().msTrigger_) {
-              cmsDelayNext = TimeDiff(dmsgq_.top().msTrigger_, msCurrent);
-              break;
-            }
-            msgq_.push_back(dmsgq_.top().msg_);
-            dmsgq_.pop();
+          dmsgq_.PopTriggered(msCurrent, &msgq_);
+          if (!dmsgq_.empty()) {
+            cmsDelayNext = TimeDiff(dmsgq_.NextTriggerTime(), msCurrent);
           }
         }
         // Pull a message off the message queue, if available.
@@ -366,8 +646,10 @@ void MessageQueue::Post(const Location& posted_from,
     msg.phandler = phandler;
     msg.message_id = id;
     msg.pdata = pdata;
+    msg.ready_time_us = TimeMicros();
     if (time_sensitive) {
-      msg.ts_sensitive = TimeMillis() + kMaxMsgLatency;
+      msg.ts_sensitive =
+          msg.ready_time_us / kNumMicrosecsPerMillisec + kMaxMsgLatency;
     }
     msgq_.push_back(msg);
   }
@@ -414,7 +696,7 @@ void MessageQueue::DoDelayPost(const Location& posted_from,
   }
 
   // Keep thread safe
-  // Add to the priority queue. Gets sorted soonest first.
+  // Add to the delayed message queue. Gets sorted soonest first.
   // Signal for the multiplexer to return.
 
   {
@@ -424,8 +706,9 @@ void MessageQueue::DoDelayPost(const Location& posted_from,
     msg.phandler = phandler;
     msg.message_id = id;
     msg.pdata = pdata;
+    msg.ready_time_us = TimeMicros() + cmsDelay * kNumMicrosecsPerMillisec;
     DelayedMessage dmsg(cmsDelay, tstamp, dmsgq_next_num_, msg);
-    dmsgq_.push(dmsg);
+    dmsgq_.Push(dmsg);
     // If this message queue processes 1 message every millisecond for 50 days,
     // we will wrap this number.  Even then, only messages with identical times
     // will be misordered, and then only briefly.  This is probably ok.
@@ -442,7 +725,7 @@ int MessageQueue::GetDelay() {
     return 0;
 
   if (!dmsgq_.empty()) {
-    int delay = TimeUntil(dmsgq_.top().msTrigger_);
+    int delay = TimeUntil(dmsgq_.NextTriggerTime());
     if (delay < 0)
       delay = 0;
     return delay;
@@ -487,33 +770,50 @@ void MessageQueue::ClearInternal(MessageHandler* phandler,
     }
   }
 
-  // Remove from priority queue. Not directly iterable, so use this approach
+  // Remove from delayed message queue
 
-  PriorityQueue::container_type::iterator new_end = dmsgq_.container().begin();
-  for (PriorityQueue::container_type::iterator it = new_end;
-       it != dmsgq_.container().end(); ++it) {
-    if (it->msg_.Match(phandler, id)) {
-      if (removed) {
-        removed->push_back(it->msg_);
-      } else {
-        delete it->msg_.pdata;
-      }
-    } else {
-      *new_end++ = *it;
-    }
-  }
-  dmsgq_.container().erase(new_end, dmsgq_.container().end());
-  dmsgq_.reheap();
+  dmsgq_.Clear(phandler, id, removed);
+}
+
+MessageQueueLoadStats MessageQueue::GetLoadStats() const {
+  MessageQueueLoadStats stats;
+  stats.messages_dispatched =
+      messages_dispatched_.load(std::memory_order_relaxed);
+  stats.busy_time_us = busy_time_us_.load(std::memory_order_relaxed);
+  stats.queue_wait_time_us =
+      queue_wait_time_us_.load(std::memory_order_relaxed);
+  stats.max_dispatch_time_us =
+      max_dispatch_time_us_.load(std::memory_order_relaxed);
+  return stats;
 }
 
 void MessageQueue::Dispatch(Message* pmsg) {
   TRACE_EVENT2("webrtc", "MessageQueue::Dispatch", "src_file_and_line",
                pmsg->posted_from.file_and_line(), "src_func",
                pmsg->posted_from.function_name());
-  int64_t start_time = TimeMillis();
+  int64_t start_time_us = TimeMicros();
   pmsg->phandler->OnMessage(pmsg);
-  int64_t end_time = TimeMillis();
-  int64_t diff = TimeDiff(end_time, start_time);
+  int64_t end_time_us = TimeMicros();
+
+  // Only this thread updates the counters, so they need not be incremented
+  // atomically.
+  int64_t dispatch_time_us = end_time_us - start_time_us;
+  messages_dispatched_.store(
+      messages_dispatched_.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+  busy_time_us_.store(
+      busy_time_us_.load(std::memory_order_relaxed) + dispatch_time_us,
+      std::memory_order_relaxed);
+  if (pmsg->ready_time_us > 0 && start_time_us > pmsg->ready_time_us) {
+    queue_wait_time_us_.store(
+        queue_wait_time_us_.load(std::memory_order_relaxed) + start_time_us -
+            pmsg->ready_time_us,
+        std::memory_order_relaxed);
+  }
+  if (dispatch_time_us > max_dispatch_time_us_.load(std::memory_order_relaxed))
+    max_dispatch_time_us_.store(dispatch_time_us, std::memory_order_relaxed);
+
+  int64_t diff = dispatch_time_us / kNumMicrosecsPerMillisec;
   if (diff >= kSlowDispatchLoggingThreshold) {
     RTC_LOG(LS_INFO) << "Message took " << diff
                      << "ms to dispatch. Posted from: "
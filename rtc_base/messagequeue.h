@@ -14,9 +14,10 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <memory>
-#include <queue>
+#include <unordered_map>
 #include <vector>
 
 #include "rtc_base/constructormagic.h"
@@ -152,7 +153,11 @@ const uint32_t MQID_DISPOSE = static_cast<uint32_t>(-2);
 
 struct Message {
   Message()
-      : phandler(nullptr), message_id(0), pdata(nullptr), ts_sensitive(0) {}
+      : phandler(nullptr),
+        message_id(0),
+        pdata(nullptr),
+        ts_sensitive(0),
+        ready_time_us(0) {}
   inline bool Match(MessageHandler* handler, uint32_t id) const {
     return (handler == nullptr || handler == phandler) &&
            (id == MQID_ANY || id == message_id);
@@ -162,12 +167,15 @@ struct Message {
   uint32_t message_id;
   MessageData* pdata;
   int64_t ts_sensitive;
+  // Time at which the message could first be dispatched, or 0 if unknown.
+  // Used to measure how long messages wait in the queue.
+  int64_t ready_time_us;
 };
 
 typedef std::list<Message> MessageList;
 
-// DelayedMessage goes into a priority queue, sorted by trigger time.  Messages
-// with the same trigger time are processed in num_ (FIFO) order.
+// DelayedMessage goes into a DelayedMessageQueue, sorted by trigger time.
+// Messages with the same trigger time are processed in num_ (FIFO) order.
 
 class DelayedMessage {
  public:
@@ -188,6 +196,100 @@ class DelayedMessage {
   Message msg_;
 };
 
+// Holds the delayed messages of a MessageQueue in a hierarchical timer wheel
+// with millisecond resolution, so that inserting a message and clearing the
+// messages of a handler don't depend on the total number of delayed messages.
+// Level 0 has one slot per millisecond; each higher level has slots spanning a
+// whole rotation of the level below, and its messages are moved down a level
+// when their slot comes up. Messages further out than the top level are kept
+// in an overflow list. Not thread safe.
+class DelayedMessageQueue {
+ public:
+  DelayedMessageQueue();
+  ~DelayedMessageQueue();
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  void Push(const DelayedMessage& dmsg);
+
+  // Returns the earliest trigger time of the queued messages. Must not be
+  // called when empty.
+  int64_t NextTriggerTime() const;
+
+  // Appends the messages triggered at or before |now_ms| to |messages|, in
+  // trigger time and FIFO order, and removes them from the queue.
+  void PopTriggered(int64_t now_ms, MessageList* messages);
+
+  // Removes the messages matching |phandler| and |id|. They are appended to
+  // |removed| if not null, otherwise their data is deleted.
+  void Clear(MessageHandler* phandler, uint32_t id, MessageList* removed);
+
+ private:
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlots = 1 << kSlotBits;
+  static constexpr int kLevels = 5;
+  // Lists that aren't wheel slots. |kTriggeredList| holds messages whose
+  // trigger time had already passed the wheel time when pushed.
+  static constexpr int kTriggeredList = -1;
+  static constexpr int kOverflowList = kLevels;
+
+  struct Node {
+    explicit Node(const DelayedMessage& dmsg) : dmsg(dmsg) {}
+
+    DelayedMessage dmsg;
+    // The list the node is in, and its neighbours there.
+    int level = kTriggeredList;
+    int slot = 0;
+    Node* prev = nullptr;
+    Node* next = nullptr;
+    // Neighbours among the nodes with the same handler.
+    Node* handler_prev = nullptr;
+    Node* handler_next = nullptr;
+  };
+
+  Node** ListHead(int level, int slot);
+  // Puts |node| in the list matching its trigger time, relative to |now_ms_|.
+  void Place(Node* node);
+  void Link(Node* node, int level, int slot);
+  void Unlink(Node* node);
+  void LinkHandler(Node* node);
+  void UnlinkHandler(Node* node);
+  // Moves the nodes in the current slot of |level| down the wheel, and does
+  // the same for the next level up when that slot is the first one.
+  void Cascade(int level);
+  // Places the nodes of |list| again, relative to the current wheel time.
+  void Replace(Node* list);
+  int64_t ComputeNextTriggerTime() const;
+
+  // The wheel time, in milliseconds. Slots for times before it have been
+  // processed.
+  int64_t now_ms_ = 0;
+  size_t size_ = 0;
+  // Number of nodes in the wheel slots and the overflow list.
+  size_t wheel_size_ = 0;
+  uint64_t occupied_slots_[kLevels] = {};
+  Node* slots_[kLevels][kSlots] = {};
+  Node* triggered_ = nullptr;
+  Node* overflow_ = nullptr;
+  std::unordered_map<MessageHandler*, Node*> handler_nodes_;
+  mutable bool next_trigger_valid_ = false;
+  mutable int64_t next_trigger_ms_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DelayedMessageQueue);
+};
+
+// Counters of the messages dispatched by a MessageQueue, for spotting
+// overloaded threads.
+struct MessageQueueLoadStats {
+  int64_t messages_dispatched = 0;
+  // Total time spent in MessageHandler::OnMessage().
+  int64_t busy_time_us = 0;
+  // Total time messages spent waiting in the queue after becoming ready.
+  int64_t queue_wait_time_us = 0;
+  int64_t max_dispatch_time_us = 0;
+};
+
 class MessageQueue {
  public:
   static const int kForever = -1;
@@ -260,6 +362,9 @@ class MessageQueue {
   // Amount of time until the next message can be retrieved
   virtual int GetDelay();
 
+  // May be called on any thread.
+  MessageQueueLoadStats GetLoadStats() const;
+
   bool empty() const { return size() == 0u; }
   size_t size() const {
     CritScope cs(&crit_);  // msgq_.size() is not thread safe.
@@ -279,12 +384,6 @@ class MessageQueue {
   sigslot::signal0<> SignalQueueDestroyed;
 
  protected:
-  class PriorityQueue : public std::priority_queue<DelayedMessage> {
-   public:
-    container_type& container() { return c; }
-    void reheap() { make_heap(c.begin(), c.end(), comp); }
-  };
-
   void DoDelayPost(const Location& posted_from,
                    int64_t cmsDelay,
                    int64_t tstamp,
@@ -311,7 +410,7 @@ class MessageQueue {
   bool fPeekKeep_;
   Message msgPeek_;
   MessageList msgq_ RTC_GUARDED_BY(crit_);
-  PriorityQueue dmsgq_ RTC_GUARDED_BY(crit_);
+  DelayedMessageQueue dmsgq_ RTC_GUARDED_BY(crit_);
   uint32_t dmsgq_next_num_ RTC_GUARDED_BY(crit_);
   CriticalSection crit_;
   bool fInitialized_;
@@ -320,6 +419,12 @@ class MessageQueue {
  private:
   volatile int stop_;
 
+  // Updated by Dispatch() and read by GetLoadStats().
+  std::atomic<int64_t> messages_dispatched_;
+  std::atomic<int64_t> busy_time_us_;
+  std::atomic<int64_t> queue_wait_time_us_;
+  std::atomic<int64_t> max_dispatch_time_us_;
+
   // The SocketServer might not be owned by MessageQueue.
   SocketServer* const ss_;
   // Used if SocketServer ownership lies with |this|.
@@ -11,13 +11,18 @@
 #include "rtc_base/messagequeue.h"
 
 #include <functional>
+#include <map>
+#include <utility>
+#include <vector>
 
+#include "rtc_base/arraysize.h"
 #include "rtc_base/atomicops.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/nullsocketserver.h"
+#include "rtc_base/random.h"
 #include "rtc_base/refcount.h"
 #include "rtc_base/refcountedobject.h"
 #include "rtc_base/thread.h"
@@ -121,6 +126,45 @@ TEST_F(MessageQueueTest, DiposeHandlerWithPostedMessagePending) {
   EXPECT_TRUE(deleted);
 }
 
+// Unlike FakeClock, doesn't process all message queues when advanced, which
+// would wait for this test's queue to be processed.
+class ManualClock : public ClockInterface {
+ public:
+  int64_t TimeNanos() const override { return time_us * 1000; }
+  int64_t time_us = 1000000;
+};
+
+class ClockAdvancingMessageHandler : public MessageHandler {
+ public:
+  explicit ClockAdvancingMessageHandler(ManualClock* clock) : clock_(clock) {}
+  void OnMessage(Message* msg) override { clock_->time_us += msg->message_id; }
+
+ private:
+  ManualClock* const clock_;
+};
+
+TEST_F(MessageQueueTest, CountsLoadOfDispatchedMessages) {
+  ManualClock clock;
+  ClockInterface* prev_clock = SetClockForTesting(&clock);
+  ClockAdvancingMessageHandler handler(&clock);
+  // The message id is the number of microseconds the message takes.
+  Post(RTC_FROM_HERE, &handler, 5000);
+  Post(RTC_FROM_HERE, &handler, 2000);
+  clock.time_us += 3000;
+
+  Message msg;
+  while (Get(&msg, 0))
+    Dispatch(&msg);
+  SetClockForTesting(prev_clock);
+
+  MessageQueueLoadStats stats = GetLoadStats();
+  EXPECT_EQ(2, stats.messages_dispatched);
+  EXPECT_EQ(7000, stats.busy_time_us);
+  // The second message also waited for the first one to be dispatched.
+  EXPECT_EQ(3000 + 8000, stats.queue_wait_time_us);
+  EXPECT_EQ(5000, stats.max_dispatch_time_us);
+}
+
 struct UnwrapMainThreadScope {
   UnwrapMainThreadScope() : rewrap_(Thread::Current() != nullptr) {
     if (rewrap_)
@@ -233,5 +277,168 @@ TEST(MessageQueueManager, ClearReentrant) {
           new ScopedRefMessageData<RefCountedHandler>(inner_handler));
 }
 
+DelayedMessage MakeDelayedMessage(int64_t now_ms,
+                                  int64_t trigger_ms,
+                                  uint32_t num,
+                                  MessageHandler* handler = nullptr,
+                                  uint32_t id = 0) {
+  Message msg;
+  msg.phandler = handler;
+  msg.message_id = id;
+  return DelayedMessage(trigger_ms - now_ms, trigger_ms, num, msg);
+}
+
+TEST(DelayedMessageQueueTest, PopsInTriggerTimeAndFifoOrder) {
+  const int64_t kNowMs = 1000000;
+  // Spread over all levels of the wheel and the overflow list.
+  const int64_t kDelaysMs[] = {5000, 1, 300000, 0, int64_t{1} << 31, 70, 1};
+  DelayedMessageQueue queue;
+  for (uint32_t i = 0; i < arraysize(kDelaysMs); ++i) {
+    queue.Push(MakeDelayedMessage(kNowMs, kNowMs + kDelaysMs[i], i,
+                                  nullptr, i));
+  }
+  EXPECT_EQ(arraysize(kDelaysMs), queue.size());
+  EXPECT_EQ(kNowMs, queue.NextTriggerTime());
+
+  const std::vector<uint32_t> kExpectedIds = {3, 1, 6, 5, 0, 2, 4};
+  std::vector<uint32_t> ids;
+  MessageList messages;
+  queue.PopTriggered(kNowMs - 1, &messages);
+  EXPECT_TRUE(messages.empty());
+  for (size_t i = 0; i < kExpectedIds.size(); ++i) {
+    int64_t trigger_ms = queue.NextTriggerTime();
+    EXPECT_EQ(kNowMs + kDelaysMs[kExpectedIds[i]], trigger_ms);
+    queue.PopTriggered(trigger_ms - 1, &messages);
+    EXPECT_TRUE(messages.empty());
+    queue.PopTriggered(trigger_ms, &messages);
+    for (const Message& msg : messages)
+      ids.push_back(msg.message_id);
+    i += messages.size() - 1;
+    messages.clear();
+  }
+  EXPECT_EQ(kExpectedIds, ids);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(DelayedMessageQueueTest, PushesMessagesAlreadyTriggered) {
+  DelayedMessageQueue queue;
+  queue.Push(MakeDelayedMessage(0, 100, 0, nullptr, 0));
+  MessageList messages;
+  queue.PopTriggered(50, &messages);
+  EXPECT_TRUE(messages.empty());
+  // Posted with a trigger time before the last pop.
+  queue.Push(MakeDelayedMessage(50, 20, 1, nullptr, 1));
+  EXPECT_EQ(20, queue.NextTriggerTime());
+  queue.PopTriggered(60, &messages);
+  ASSERT_EQ(1u, messages.size());
+  EXPECT_EQ(1u, messages.front().message_id);
+  EXPECT_EQ(100, queue.NextTriggerTime());
+}
+
+TEST(DelayedMessageQueueTest, ClearsByHandlerAndId) {
+  EmptyHandler handler1;
+  EmptyHandler handler2;
+  DelayedMessageQueue queue;
+  uint32_t num = 0;
+  for (int64_t delay_ms : {10, 1000, 100000}) {
+    queue.Push(MakeDelayedMessage(0, delay_ms, num++, &handler1, 1));
+    queue.Push(MakeDelayedMessage(0, delay_ms, num++, &handler1, 2));
+    queue.Push(MakeDelayedMessage(0, delay_ms, num++, &handler2, 1));
+  }
+  MessageList removed;
+  queue.Clear(&handler1, 1, &removed);
+  EXPECT_EQ(3u, removed.size());
+  EXPECT_EQ(6u, queue.size());
+  removed.clear();
+  queue.Clear(nullptr, 1, &removed);
+  EXPECT_EQ(3u, removed.size());
+  for (const Message& msg : removed)
+    EXPECT_EQ(&handler2, msg.phandler);
+  EXPECT_EQ(3u, queue.size());
+  EXPECT_EQ(10, queue.NextTriggerTime());
+  queue.Clear(&handler1, MQID_ANY, nullptr);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(DelayedMessageQueueTest, MatchesSortedOrderForRandomTriggerTimes) {
+  webrtc::Random random(0x1234);
+  EmptyHandler handlers[8];
+  DelayedMessageQueue queue;
+  // Maps trigger time and posting order to the handler index.
+  std::map<std::pair<int64_t, uint32_t>, int> expected;
+  int64_t now_ms = 12345;
+  uint32_t num = 0;
+  for (int round = 0; round < 5000; ++round) {
+    for (int i = random.Rand(0, 5); i > 0; --i) {
+      int64_t trigger_ms = now_ms + random.Rand(0, 1 << random.Rand(0, 22));
+      int handler = random.Rand(0, 7);
+      queue.Push(MakeDelayedMessage(now_ms, trigger_ms, num,
+                                    &handlers[handler], num));
+      expected[std::make_pair(trigger_ms, num++)] = handler;
+    }
+    if (random.Rand(0, 50) == 0) {
+      int handler = random.Rand(0, 7);
+      MessageList removed;
+      queue.Clear(&handlers[handler], MQID_ANY, &removed);
+      size_t num_removed = 0;
+      for (auto it = expected.begin(); it != expected.end();) {
+        if (it->second == handler) {
+          it = expected.erase(it);
+          ++num_removed;
+        } else {
+          ++it;
+        }
+      }
+      EXPECT_EQ(num_removed, removed.size());
+    }
+    ASSERT_EQ(expected.size(), queue.size());
+    if (!expected.empty())
+      ASSERT_EQ(expected.begin()->first.first, queue.NextTriggerTime());
+
+    now_ms += random.Rand(0, 1 << random.Rand(0, 12));
+    MessageList messages;
+    queue.PopTriggered(now_ms, &messages);
+    for (const Message& msg : messages) {
+      ASSERT_FALSE(expected.empty());
+      ASSERT_LE(expected.begin()->first.first, now_ms);
+      EXPECT_EQ(expected.begin()->first.second, msg.message_id);
+      expected.erase(expected.begin());
+    }
+    ASSERT_TRUE(expected.empty() || expected.begin()->first.first > now_ms);
+  }
+}
+
+// Posts and clears delayed messages for many handlers, like the STUN and ICE
+// timers of many ports on a network thread, and logs the time spent.
+TEST(DelayedMessageQueueTest, PostDelayedAndClearManyHandlersPerformance) {
+  const int kNumHandlers = 5000;
+  const int kMessagesPerHandler = 4;
+  NullSocketServer nullss;
+  MessageQueue queue(&nullss, true);
+  std::vector<EmptyHandler> handlers(kNumHandlers);
+
+  int64_t start_us = TimeMicros();
+  for (int i = 0; i < kMessagesPerHandler; ++i) {
+    for (int j = 0; j < kNumHandlers; ++j) {
+      queue.PostDelayed(RTC_FROM_HERE, 100 + (i * kNumHandlers + j) % 50000,
+                        &handlers[j], i);
+    }
+  }
+  int64_t post_us = TimeMicros() - start_us;
+  EXPECT_EQ(static_cast<size_t>(kNumHandlers * kMessagesPerHandler),
+            queue.size());
+
+  start_us = TimeMicros();
+  for (EmptyHandler& handler : handlers)
+    queue.Clear(&handler);
+  int64_t clear_us = TimeMicros() - start_us;
+  EXPECT_TRUE(queue.empty());
+
+  RTC_LOG(LS_INFO) << "Posted " << kNumHandlers * kMessagesPerHandler
+                   << " delayed messages in " << post_us
+                   << " us, cleared them per handler in " << clear_us
+                   << " us.";
+}
+
 }  // namespace
 }  // namespace rtc
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MPSC_QUEUE_H_
+#define RTC_BASE_MPSC_QUEUE_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <utility>
+
+#include "rtc_base/constructormagic.h"
+
+namespace webrtc {
+
+// Unbounded multi-producer, single-consumer queue. Push() may be called
+// concurrently from any number of threads and never blocks. A single consumer
+// calls PopAll() to atomically take every element pushed so far; elements are
+// handed to the callback in the order they were pushed.
+//
+// Push() allocates a node per element, but takes no lock, so a producer is
+// never stalled behind the consumer.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(nullptr) {}
+  ~MpscQueue() {
+    PopAll([](T&&) {});
+  }
+
+  void Push(T value) {
+    Node* node = new Node(std::move(value));
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  // Calls |callback| with each queued element, oldest first. Returns the number
+  // of elements removed. Must only be called from the consumer.
+  template <typename Callback>
+  size_t PopAll(Callback callback) {
+    Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+    // The list is LIFO; reverse it to restore push order.
+    Node* reversed = nullptr;
+    while (node) {
+      Node* next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+    size_t count = 0;
+    while (reversed) {
+      Node* next = reversed->next;
+      callback(std::move(reversed->value));
+      delete reversed;
+      reversed = next;
+      ++count;
+    }
+    return count;
+  }
+
+  // Returns true if no elements are queued. The result may be stale by the
+  // time it is used if producers are active.
+  bool Empty() const {
+    return head_.load(std::memory_order_relaxed) == nullptr;
+  }
+
+ private:
+  struct Node {
+    explicit Node(T value) : value(std::move(value)), next(nullptr) {}
+    T value;
+    Node* next;
+  };
+
+  std::atomic<Node*> head_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MpscQueue);
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_MPSC_QUEUE_H_
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/mpsc_queue.h"
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const int kNumProducers = 4;
+const int kItemsPerProducer = 10000;
+
+struct ProducerContext {
+  MpscQueue<int>* queue;
+  int producer_id;
+};
+
+void Produce(void* obj) {
+  ProducerContext* context = static_cast<ProducerContext*>(obj);
+  for (int i = 0; i < kItemsPerProducer; ++i)
+    context->queue->Push(context->producer_id * kItemsPerProducer + i);
+}
+
+}  // namespace
+
+TEST(MpscQueueTest, PopAllReturnsElementsInPushOrder) {
+  MpscQueue<int> queue;
+  EXPECT_TRUE(queue.Empty());
+  queue.Push(1);
+  queue.Push(2);
+  queue.Push(3);
+  EXPECT_FALSE(queue.Empty());
+
+  std::vector<int> popped;
+  EXPECT_EQ(3u, queue.PopAll([&](int value) { popped.push_back(value); }));
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), popped);
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(0u, queue.PopAll([](int) {}));
+}
+
+TEST(MpscQueueTest, SupportsMoveOnlyTypes) {
+  MpscQueue<std::unique_ptr<int>> queue;
+  queue.Push(std::unique_ptr<int>(new int(17)));
+  int value = 0;
+  queue.PopAll([&](std::unique_ptr<int> element) { value = *element; });
+  EXPECT_EQ(17, value);
+}
+
+TEST(MpscQueueTest, ConcurrentProducersKeepPerProducerOrder) {
+  MpscQueue<int> queue;
+  std::vector<ProducerContext> contexts(kNumProducers);
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < kNumProducers; ++i) {
+    contexts[i] = {&queue, i};
+    threads.emplace_back(
+        new rtc::PlatformThread(&Produce, &contexts[i], "MpscProducer"));
+    threads.back()->Start();
+  }
+
+  std::vector<int> next_expected(kNumProducers, 0);
+  int total = 0;
+  auto consume = [&](int value) {
+    int producer = value / kItemsPerProducer;
+    EXPECT_EQ(next_expected[producer], value % kItemsPerProducer);
+    ++next_expected[producer];
+    ++total;
+  };
+  while (total < kNumProducers * kItemsPerProducer)
+    queue.PopAll(consume);
+
+  for (auto& thread : threads)
+    thread->Stop();
+  EXPECT_TRUE(queue.Empty());
+}
+
+}  // namespace webrtc
@@ -51,6 +51,9 @@ const uint32_t kSignalNetworksMessage = 2;
 
 // Fetch list of networks every two seconds.
 const int kNetworksUpdateIntervalMs = 2000;
+// With a network monitor, which signals network changes, the list is only
+// fetched as a fallback, every 30 seconds.
+const int kNetworksUpdateIntervalWithMonitorMs = 30000;
 
 const int kHighestNetworkPreference = 127;
 
@@ -955,8 +958,10 @@ void BasicNetworkManager::UpdateNetworksOnce() {
 
 void BasicNetworkManager::UpdateNetworksContinually() {
   UpdateNetworksOnce();
-  thread_->PostDelayed(RTC_FROM_HERE, kNetworksUpdateIntervalMs, this,
-                       kUpdateNetworksMessage);
+  thread_->PostDelayed(RTC_FROM_HERE,
+                       network_monitor_ ? kNetworksUpdateIntervalWithMonitorMs
+                                        : kNetworksUpdateIntervalMs,
+                       this, kUpdateNetworksMessage);
 }
 
 void BasicNetworkManager::DumpNetworks() {
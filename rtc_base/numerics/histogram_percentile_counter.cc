@@ -29,7 +29,7 @@ void HistogramPercentileCounter::Add(const HistogramPercentileCounter& other) {
   for (uint32_t value = 0; value < other.long_tail_boundary_; ++value) {
     Add(value, other.histogram_low_[value]);
   }
-  for (const auto& it : histogram_high_) {
+  for (const auto& it : other.histogram_high_) {
     Add(it.first, it.second);
   }
 }
@@ -42,3 +42,15 @@ TEST(HistogramPercentileCounterTest, HandlesEmptySequence) {
   counter.Add(1u);
   EXPECT_TRUE(counter.GetPercentile(0.5f));
 }
+
+TEST(HistogramPercentileCounterTest, AddsOtherCounterIncludingLongTail) {
+  rtc::HistogramPercentileCounter counter(10);
+  rtc::HistogramPercentileCounter other(10);
+  counter.Add(1u);
+  other.Add(5u);
+  other.Add(50u);
+  counter.Add(other);
+  EXPECT_EQ(1u, counter.GetPercentile(0.0f).value_or(0));
+  EXPECT_EQ(5u, counter.GetPercentile(0.5f).value_or(0));
+  EXPECT_EQ(50u, counter.GetPercentile(1.0f).value_or(0));
+}
@@ -12,7 +12,7 @@
 #define RTC_BASE_NUMERICS_MOVING_MEDIAN_FILTER_H_
 
 #include <stddef.h>
-#include <list>
+#include <vector>
 
 #include "rtc_base/checks.h"
 #include "rtc_base/constructormagic.h"
@@ -39,7 +39,10 @@ class MovingMedianFilter {
 
  private:
   PercentileFilter<T> percentile_filter_;
-  std::list<T> samples_;
+  // Ring buffer of the latest samples, allocated once. |next_index_| is where
+  // the next sample goes, which is the oldest one once the window is full.
+  std::vector<T> samples_;
+  size_t next_index_;
   size_t samples_stored_;
   const size_t window_size_;
 
@@ -48,20 +51,25 @@ class MovingMedianFilter {
 
 template <typename T>
 MovingMedianFilter<T>::MovingMedianFilter(size_t window_size)
-    : percentile_filter_(0.5f), samples_stored_(0), window_size_(window_size) {
+    : percentile_filter_(0.5f),
+      samples_(window_size),
+      next_index_(0),
+      samples_stored_(0),
+      window_size_(window_size) {
   RTC_CHECK_GT(window_size, 0);
 }
 
 template <typename T>
 void MovingMedianFilter<T>::Insert(const T& value) {
   percentile_filter_.Insert(value);
-  samples_.emplace_back(value);
-  ++samples_stored_;
-  if (samples_stored_ > window_size_) {
-    percentile_filter_.Erase(samples_.front());
-    samples_.pop_front();
-    --samples_stored_;
+  if (samples_stored_ == window_size_) {
+    percentile_filter_.Erase(samples_[next_index_]);
+  } else {
+    ++samples_stored_;
   }
+  samples_[next_index_] = value;
+  if (++next_index_ == window_size_)
+    next_index_ = 0;
 }
 
 template <typename T>
@@ -72,7 +80,7 @@ T MovingMedianFilter<T>::GetFilteredValue() const {
 template <typename T>
 void MovingMedianFilter<T>::Reset() {
   percentile_filter_.Reset();
-  samples_.clear();
+  next_index_ = 0;
   samples_stored_ = 0;
 }
 
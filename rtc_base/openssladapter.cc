@@ -343,8 +343,12 @@ int OpenSSLAdapter::BeginSSL() {
   // TODO(deadbeef): Do we want SSL_MODE_ENABLE_PARTIAL_WRITE? It doesn't
   // appear Send handles partial writes properly, though maybe we never notice
   // since we never send more than 16KB at once..
+  // SSL_MODE_RELEASE_BUFFERS frees the read and write buffers of idle
+  // connections, e.g. TURN-TLS allocations waiting for their next packet.
+  // BoringSSL always does this.
   SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE |
-                         SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+                         SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER |
+                         SSL_MODE_RELEASE_BUFFERS);
 
   // Enable SNI, if a hostname is supplied.
   if (!ssl_host_name_.empty()) {
@@ -27,6 +27,7 @@
 #include <signal.h>
 #include <sys/ioctl.h>
 #include <sys/select.h>
+#include <sys/socket.h>
 #include <sys/time.h>
 #include <unistd.h>
 #endif
@@ -42,6 +43,7 @@
 
 #include <algorithm>
 #include <map>
+#include <vector>
 
 #include "rtc_base/arraysize.h"
 #include "rtc_base/byteorder.h"
@@ -86,6 +88,27 @@ int64_t GetSocketRecvTimestamp(int socket) {
 }
 #endif
 
+#if defined(WEBRTC_LINUX)
+// UDP sockets ask the kernel to attach the receive time of each datagram as
+// an SCM_TIMESTAMPNS control message. Unlike SIOCGSTAMP, which costs a system
+// call and only reports the most recent datagram, this gives every datagram
+// of a recvmmsg batch its own receive time.
+const size_t kRecvTimestampControlSize = CMSG_SPACE(sizeof(timespec));
+
+int64_t GetControlMessageTimestamp(msghdr* header) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(header); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(header, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+      timespec ts;
+      memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+      return rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts.tv_sec) +
+             static_cast<int64_t>(ts.tv_nsec) / rtc::kNumNanosecsPerMicrosec;
+    }
+  }
+  return -1;
+}
+#endif
+
 #if defined(WEBRTC_WIN)
 typedef char* SockOptArg;
 #endif
@@ -140,6 +163,13 @@ bool PhysicalSocket::Create(int family, int type) {
   if (udp_) {
     SetEnabledEvents(DE_READ | DE_WRITE);
   }
+#if defined(WEBRTC_LINUX)
+  if (udp_ && s_ != INVALID_SOCKET) {
+    // Receive times fall back to SIOCGSTAMP if this fails.
+    int value = 1;
+    setsockopt(s_, SOL_SOCKET, SO_TIMESTAMPNS, &value, sizeof(value));
+  }
+#endif
   return s_ != INVALID_SOCKET;
 }
 
@@ -356,6 +386,42 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendToBatch(const void* const* buffers,
+                                const size_t* lengths,
+                                size_t count,
+                                const SocketAddress& addr) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  if (!udp_ || count <= 1)
+    return AsyncSocket::SendToBatch(buffers, lengths, count, addr);
+  sockaddr_storage saddr;
+  socklen_t len = static_cast<socklen_t>(addr.ToSockAddrStorage(&saddr));
+  std::vector<mmsghdr> headers(count);
+  std::vector<iovec> iovecs(count);
+  for (size_t i = 0; i < count; ++i) {
+    iovecs[i].iov_base = const_cast<void*>(buffers[i]);
+    iovecs[i].iov_len = lengths[i];
+    msghdr& header = headers[i].msg_hdr;
+    memset(&header, 0, sizeof(header));
+    header.msg_name = &saddr;
+    header.msg_namelen = len;
+    header.msg_iov = &iovecs[i];
+    header.msg_iovlen = 1;
+  }
+  // Suppress SIGPIPE, as in Send().
+  int sent = ::sendmmsg(s_, headers.data(), static_cast<unsigned>(count),
+                        MSG_NOSIGNAL);
+  UpdateLastError();
+  MaybeRemapSendError();
+  if ((sent >= 0 && sent < static_cast<int>(count)) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+#else
+  return AsyncSocket::SendToBatch(buffers, lengths, count, addr);
+#endif
+}
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
       ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
@@ -392,10 +458,33 @@ int PhysicalSocket::RecvFrom(void* buffer,
   sockaddr_storage addr_storage;
   socklen_t addr_len = sizeof(addr_storage);
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
-  int received = ::recvfrom(s_, static_cast<char*>(buffer),
-                            static_cast<int>(length), 0, addr, &addr_len);
-  if (timestamp) {
-    *timestamp = GetSocketRecvTimestamp(s_);
+  int received;
+#if defined(WEBRTC_LINUX)
+  if (udp_ && timestamp) {
+    iovec iov;
+    iov.iov_base = buffer;
+    iov.iov_len = length;
+    char control[kRecvTimestampControlSize];
+    msghdr header;
+    memset(&header, 0, sizeof(header));
+    header.msg_name = addr;
+    header.msg_namelen = addr_len;
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+    received = ::recvmsg(s_, &header, 0);
+    *timestamp = received >= 0 ? GetControlMessageTimestamp(&header) : -1;
+    if (*timestamp < 0)
+      *timestamp = GetSocketRecvTimestamp(s_);
+  } else
+#endif
+  {
+    received = ::recvfrom(s_, static_cast<char*>(buffer),
+                          static_cast<int>(length), 0, addr, &addr_len);
+    if (timestamp) {
+      *timestamp = GetSocketRecvTimestamp(s_);
+    }
   }
   UpdateLastError();
   if ((received >= 0) && (out_addr != nullptr))
@@ -411,6 +500,63 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+int PhysicalSocket::RecvFromBatch(void* buffer,
+                                  size_t packet_size,
+                                  size_t count,
+                                  size_t* lengths,
+                                  SocketAddress* paddrs,
+                                  int64_t* timestamps) {
+#if defined(WEBRTC_LINUX)
+  RTC_DCHECK_GT(count, 0);
+  if (!udp_ || count == 1) {
+    return AsyncSocket::RecvFromBatch(buffer, packet_size, count, lengths,
+                                      paddrs, timestamps);
+  }
+  std::vector<mmsghdr> headers(count);
+  std::vector<iovec> iovecs(count);
+  std::vector<sockaddr_storage> addr_storage(count);
+  std::vector<char> control(count * kRecvTimestampControlSize);
+  char* data = static_cast<char*>(buffer);
+  for (size_t i = 0; i < count; ++i) {
+    iovecs[i].iov_base = data + i * packet_size;
+    iovecs[i].iov_len = packet_size;
+    msghdr& header = headers[i].msg_hdr;
+    memset(&header, 0, sizeof(header));
+    header.msg_name = &addr_storage[i];
+    header.msg_namelen = sizeof(addr_storage[i]);
+    header.msg_iov = &iovecs[i];
+    header.msg_iovlen = 1;
+    header.msg_control = &control[i * kRecvTimestampControlSize];
+    header.msg_controllen = kRecvTimestampControlSize;
+  }
+  // MSG_TRUNC makes msg_len report the full datagram size, so truncation can
+  // be detected by the caller.
+  int received = ::recvmmsg(s_, headers.data(), static_cast<unsigned>(count),
+                            MSG_TRUNC, nullptr);
+  UpdateLastError();
+  if (received > 0) {
+    for (int i = 0; i < received; ++i) {
+      lengths[i] = headers[i].msg_len;
+      SocketAddressFromSockAddrStorage(addr_storage[i], &paddrs[i]);
+      timestamps[i] = GetControlMessageTimestamp(&headers[i].msg_hdr);
+    }
+    // Without SO_TIMESTAMPNS, SIOCGSTAMP only reports the receive time of the
+    // most recent datagram; the earlier ones in the batch leave it unset.
+    if (timestamps[received - 1] < 0)
+      timestamps[received - 1] = GetSocketRecvTimestamp(s_);
+  }
+  // UDP sockets always want to be notified about further reads.
+  EnableEvents(DE_READ);
+  if (received < 0 && !IsBlockingError(GetError())) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << GetError();
+  }
+  return received;
+#else
+  return AsyncSocket::RecvFromBatch(buffer, packet_size, count, lengths,
+                                    paddrs, timestamps);
+#endif
+}
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -554,6 +700,15 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
       return -1;
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_REUSEPORT:
+#if defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
     default:
       RTC_NOTREACHED();
       return -1;
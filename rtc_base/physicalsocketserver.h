@@ -163,6 +163,16 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+  int RecvFromBatch(void* buffer,
+                    size_t packet_size,
+                    size_t count,
+                    size_t* lengths,
+                    SocketAddress* paddrs,
+                    int64_t* timestamps) override;
+  int SendToBatch(const void* const* buffers,
+                  const size_t* lengths,
+                  size_t count,
+                  const SocketAddress& addr) override;
 
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* out_addr) override;
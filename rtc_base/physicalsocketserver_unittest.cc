@@ -11,7 +11,11 @@
 #include <signal.h>
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "rtc_base/arraysize.h"
+#include "rtc_base/asyncudpsocket.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/ipaddress.h"
 #include "rtc_base/logging.h"
@@ -459,6 +463,154 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
 }
 #endif
 
+TEST_F(PhysicalSocketTest, RecvFromBatchReceivesQueuedDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  const SocketAddress dest = receiver->GetLocalAddress();
+  const char kPackets[][8] = {"first", "second", "third"};
+  for (const char* packet : kPackets) {
+    ASSERT_EQ(static_cast<int>(strlen(packet)),
+              sender->SendTo(packet, strlen(packet), dest));
+  }
+
+  const size_t kBatchSize = 4;
+  const size_t kPacketSize = 16;
+  char buffer[kBatchSize * kPacketSize];
+  size_t lengths[kBatchSize];
+  SocketAddress addrs[kBatchSize];
+  int64_t timestamps[kBatchSize];
+  size_t total = 0;
+  // Loopback delivery is synchronous, but allow for the datagrams to be split
+  // over more than one call.
+  while (total < arraysize(kPackets)) {
+    int received = receiver->RecvFromBatch(buffer, kPacketSize, kBatchSize,
+                                           lengths, addrs, timestamps);
+    ASSERT_GT(received, 0);
+    for (int i = 0; i < received; ++i, ++total) {
+      EXPECT_EQ(std::string(kPackets[total]),
+                std::string(&buffer[i * kPacketSize], lengths[i]));
+      EXPECT_EQ(sender->GetLocalAddress(), addrs[i]);
+    }
+  }
+}
+
+#if defined(WEBRTC_LINUX)
+TEST_F(PhysicalSocketTest, RecvFromBatchTimestampsEveryDatagram) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  const SocketAddress dest = receiver->GetLocalAddress();
+  const size_t kNumPackets = 3;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    ASSERT_EQ(1, sender->SendTo("x", 1, dest));
+    Thread::SleepMs(10);
+  }
+
+  const size_t kPacketSize = 16;
+  char buffer[kNumPackets * kPacketSize];
+  size_t lengths[kNumPackets];
+  SocketAddress addrs[kNumPackets];
+  int64_t timestamps[kNumPackets];
+  ASSERT_EQ(static_cast<int>(kNumPackets),
+            receiver->RecvFromBatch(buffer, kPacketSize, kNumPackets, lengths,
+                                    addrs, timestamps));
+  // Each datagram has its own receive time, not only the last one.
+  EXPECT_GT(timestamps[0], -1);
+  EXPECT_GE(timestamps[1] - timestamps[0], 10000);
+  EXPECT_GE(timestamps[2] - timestamps[1], 10000);
+}
+#endif
+
+TEST_F(PhysicalSocketTest, SendToBatchSendsAllDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  const char* kPackets[] = {"a", "bb", "ccc"};
+  const void* buffers[arraysize(kPackets)];
+  size_t lengths[arraysize(kPackets)];
+  for (size_t i = 0; i < arraysize(kPackets); ++i) {
+    buffers[i] = kPackets[i];
+    lengths[i] = strlen(kPackets[i]);
+  }
+  EXPECT_EQ(static_cast<int>(arraysize(kPackets)),
+            sender->SendToBatch(buffers, lengths, arraysize(kPackets),
+                                receiver->GetLocalAddress()));
+
+  char buffer[8];
+  SocketAddress addr;
+  for (const char* packet : kPackets) {
+    int received = receiver->RecvFrom(buffer, sizeof(buffer), &addr, nullptr);
+    ASSERT_GT(received, 0);
+    EXPECT_EQ(std::string(packet), std::string(buffer, received));
+  }
+}
+
+// Writes a header into the headroom of every received packet, as a TURN
+// server relaying ChannelData does, and records the packet with its header.
+class HeadroomReceiver : public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    char* packet = const_cast<char*>(data) - 2;
+    packet[0] = '<';
+    packet[1] = '>';
+    packets.emplace_back(packet, size + 2);
+  }
+
+  std::vector<std::string> packets;
+};
+
+TEST_F(PhysicalSocketTest, AsyncUDPSocketRecvHeadroomPrecedesPackets) {
+  MAYBE_SKIP_IPV4;
+  for (size_t batch_size : {1, 4}) {
+    SCOPED_TRACE(batch_size);
+    AsyncSocket* socket = server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM);
+    std::unique_ptr<AsyncUDPSocket> receiver(
+        AsyncUDPSocket::Create(socket, SocketAddress(kIPv4Loopback, 0)));
+    ASSERT_TRUE(receiver);
+    std::unique_ptr<AsyncUDPSocket> sender(
+        AsyncUDPSocket::Create(server_.get(), SocketAddress(kIPv4Loopback, 0)));
+    ASSERT_TRUE(sender);
+    receiver->SetRecvBatching(batch_size, 16);
+    EXPECT_TRUE(receiver->SetRecvHeadroom(2));
+    HeadroomReceiver handler;
+    receiver->SignalReadPacket.connect(&handler,
+                                       &HeadroomReceiver::OnReadPacket);
+
+    const std::string kPackets[] = {"first", "second", "third"};
+    for (const std::string& packet : kPackets) {
+      ASSERT_EQ(static_cast<int>(packet.size()),
+                sender->SendTo(packet.data(), packet.size(),
+                               receiver->GetLocalAddress(), PacketOptions()));
+    }
+    // Loopback delivery is synchronous, so every read event finds a packet.
+    while (handler.packets.size() < arraysize(kPackets)) {
+      size_t received = handler.packets.size();
+      socket->SignalReadEvent(socket);
+      ASSERT_GT(handler.packets.size(), received);
+    }
+    for (size_t i = 0; i < arraysize(kPackets); ++i) {
+      EXPECT_EQ("<>" + kPackets[i], handler.packets[i]);
+    }
+  }
+}
+
 // Verify that if the socket was unable to be bound to a real network interface
 // (not loopback), Bind will return an error.
 TEST_F(PhysicalSocketTest,
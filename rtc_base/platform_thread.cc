@@ -19,6 +19,8 @@
 
 #include "rtc_base/atomicops.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_base/timeutils.h"
 
 namespace rtc {
@@ -35,6 +37,136 @@ struct ThreadAttributes {
   pthread_attr_t attr;
 };
 #endif  // defined(WEBRTC_WIN)
+
+#if defined(WEBRTC_WIN)
+typedef HANDLE ThreadHandle;
+#else
+typedef pthread_t ThreadHandle;
+#endif
+
+bool SetPriorityOfThread(ThreadHandle thread, ThreadPriority priority) {
+#if defined(WEBRTC_WIN)
+  return SetThreadPriority(thread, priority) != FALSE;
+#elif defined(__native_client__) || defined(WEBRTC_FUCHSIA)
+  // Setting thread priorities is not supported in NaCl or Fuchsia.
+  return true;
+#elif defined(WEBRTC_CHROMIUM_BUILD) && defined(WEBRTC_LINUX)
+  // TODO(tommi): Switch to the same mechanism as Chromium uses for changing
+  // thread priorities.
+  return true;
+#else
+#ifdef WEBRTC_THREAD_RR
+  const int policy = SCHED_RR;
+#else
+  const int policy = SCHED_FIFO;
+#endif
+  const int min_prio = sched_get_priority_min(policy);
+  const int max_prio = sched_get_priority_max(policy);
+  if (min_prio == -1 || max_prio == -1) {
+    return false;
+  }
+
+  if (max_prio - min_prio <= 2)
+    return false;
+
+  // Convert webrtc priority to system priorities:
+  sched_param param;
+  const int top_prio = max_prio - 1;
+  const int low_prio = min_prio + 1;
+  switch (priority) {
+    case kLowPriority:
+      param.sched_priority = low_prio;
+      break;
+    case kNormalPriority:
+      // The -1 ensures that the kHighPriority is always greater or equal to
+      // kNormalPriority.
+      param.sched_priority = (low_prio + top_prio - 1) / 2;
+      break;
+    case kHighPriority:
+      param.sched_priority = std::max(top_prio - 2, low_prio);
+      break;
+    case kHighestPriority:
+      param.sched_priority = std::max(top_prio - 1, low_prio);
+      break;
+    case kRealtimePriority:
+      param.sched_priority = top_prio;
+      break;
+  }
+  return pthread_setschedparam(thread, policy, &param) == 0;
+#endif  // defined(WEBRTC_WIN)
+}
+
+struct PlacementPolicyHolder {
+  CriticalSection crit;
+  std::unique_ptr<ThreadPlacementPolicy> policy RTC_GUARDED_BY(crit);
+};
+
+PlacementPolicyHolder* GetPlacementPolicyHolder() {
+  // Leaked, since threads may start during static destruction.
+  static PlacementPolicyHolder* const holder = new PlacementPolicyHolder();
+  return holder;
+}
+}  // namespace
+
+void SetThreadPlacementPolicy(std::unique_ptr<ThreadPlacementPolicy> policy) {
+  PlacementPolicyHolder* holder = GetPlacementPolicyHolder();
+  CritScope cs(&holder->crit);
+  holder->policy = std::move(policy);
+}
+
+void ApplyThreadPlacementPolicy(const char* thread_name) {
+  ThreadPlacement placement;
+  {
+    PlacementPolicyHolder* holder = GetPlacementPolicyHolder();
+    CritScope cs(&holder->crit);
+    if (!holder->policy)
+      return;
+    placement = holder->policy->GetThreadPlacement(thread_name);
+  }
+  if (!placement.cpus.empty())
+    SetCurrentThreadAffinity(placement.cpus);
+  if (placement.priority)
+    SetCurrentThreadPriority(*placement.priority);
+}
+
+bool SetCurrentThreadAffinity(const std::vector<int>& cpus) {
+#if defined(WEBRTC_WIN)
+  DWORD_PTR mask = 0;
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= static_cast<int>(sizeof(mask) * 8))
+      return false;
+    mask |= static_cast<DWORD_PTR>(1) << cpu;
+  }
+  if (cpus.empty())
+    mask = static_cast<DWORD_PTR>(-1);
+  return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+      return false;
+    CPU_SET(cpu, &set);
+  }
+  if (cpus.empty()) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      CPU_SET(cpu, &set);
+  }
+  // A pid of 0 refers to the calling thread.
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  // Mac and iOS only support affinity hints, which are ignored on most
+  // hardware.
+  return false;
+#endif
+}
+
+bool SetCurrentThreadPriority(ThreadPriority priority) {
+#if defined(WEBRTC_WIN)
+  return SetPriorityOfThread(GetCurrentThread(), priority);
+#else
+  return SetPriorityOfThread(pthread_self(), priority);
+#endif
 }
 
 PlatformThread::PlatformThread(ThreadRunFunctionDeprecated func,
@@ -162,9 +294,11 @@ void PlatformThread::Run() {
 
   if (run_function_) {
     SetPriority(priority_);
+    ApplyThreadPlacementPolicy(name_.c_str());
     run_function_(obj_);
     return;
   }
+  ApplyThreadPlacementPolicy(name_.c_str());
 
 // TODO(tommi): Delete the rest of this function when looping isn't supported.
 #if RTC_DCHECK_IS_ON
@@ -230,55 +364,7 @@ bool PlatformThread::SetPriority(ThreadPriority priority) {
   }
 #endif
 
-#if defined(WEBRTC_WIN)
-  return SetThreadPriority(thread_, priority) != FALSE;
-#elif defined(__native_client__) || defined(WEBRTC_FUCHSIA)
-  // Setting thread priorities is not supported in NaCl or Fuchsia.
-  return true;
-#elif defined(WEBRTC_CHROMIUM_BUILD) && defined(WEBRTC_LINUX)
-  // TODO(tommi): Switch to the same mechanism as Chromium uses for changing
-  // thread priorities.
-  return true;
-#else
-#ifdef WEBRTC_THREAD_RR
-  const int policy = SCHED_RR;
-#else
-  const int policy = SCHED_FIFO;
-#endif
-  const int min_prio = sched_get_priority_min(policy);
-  const int max_prio = sched_get_priority_max(policy);
-  if (min_prio == -1 || max_prio == -1) {
-    return false;
-  }
-
-  if (max_prio - min_prio <= 2)
-    return false;
-
-  // Convert webrtc priority to system priorities:
-  sched_param param;
-  const int top_prio = max_prio - 1;
-  const int low_prio = min_prio + 1;
-  switch (priority) {
-    case kLowPriority:
-      param.sched_priority = low_prio;
-      break;
-    case kNormalPriority:
-      // The -1 ensures that the kHighPriority is always greater or equal to
-      // kNormalPriority.
-      param.sched_priority = (low_prio + top_prio - 1) / 2;
-      break;
-    case kHighPriority:
-      param.sched_priority = std::max(top_prio - 2, low_prio);
-      break;
-    case kHighestPriority:
-      param.sched_priority = std::max(top_prio - 1, low_prio);
-      break;
-    case kRealtimePriority:
-      param.sched_priority = top_prio;
-      break;
-  }
-  return pthread_setschedparam(thread_, policy, &param) == 0;
-#endif  // defined(WEBRTC_WIN)
+  return SetPriorityOfThread(thread_, priority);
 }
 
 #if defined(WEBRTC_WIN)
@@ -14,8 +14,11 @@
 #ifndef WEBRTC_WIN
 #include <pthread.h>
 #endif
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "absl/types/optional.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/thread_checker.h"
@@ -44,6 +47,41 @@ enum ThreadPriority {
 #endif
 };
 
+// Where a thread runs. Threads of latency sensitive pipelines can be kept on
+// the cores of one NUMA node, or away from cores used by other processes.
+struct ThreadPlacement {
+  // The CPUs the thread may run on, numbered as by the OS. Empty for no
+  // restriction.
+  std::vector<int> cpus;
+  // Overrides the priority the thread was created with.
+  absl::optional<ThreadPriority> priority;
+};
+
+class ThreadPlacementPolicy {
+ public:
+  virtual ~ThreadPlacementPolicy() {}
+
+  // Called on each thread started by WebRTC before it runs any tasks, with
+  // the name of the thread, e.g. "pc_network_thread" or "EncoderQueue". May
+  // be called on any thread.
+  virtual ThreadPlacement GetThreadPlacement(const char* thread_name) = 0;
+};
+
+// Sets the policy applied to threads started after the call, replacing the
+// previous policy, if any. Null clears the policy. Threads that are already
+// running are not moved.
+void SetThreadPlacementPolicy(std::unique_ptr<ThreadPlacementPolicy> policy);
+
+// Applies the current policy, if any, to the calling thread. Called by
+// PlatformThread and rtc::Thread when they start.
+void ApplyThreadPlacementPolicy(const char* thread_name);
+
+// Restricts the calling thread to |cpus|, or lifts the restriction if |cpus|
+// is empty. Returns false if not supported or if a CPU is out of range.
+bool SetCurrentThreadAffinity(const std::vector<int>& cpus);
+
+bool SetCurrentThreadPriority(ThreadPriority priority);
+
 // Represents a simple worker thread.  The implementation must be assumed
 // to be single threaded, meaning that all methods of the class, must be
 // called from the same thread, including instantiation.
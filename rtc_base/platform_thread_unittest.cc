@@ -10,6 +10,9 @@
 
 #include "rtc_base/platform_thread.h"
 
+#include <string>
+#include <vector>
+
 #include "system_wrappers/include/sleep.h"
 #include "test/gtest.h"
 
@@ -41,6 +44,29 @@ void SetFlagRunFunction(void* obj) {
   *obj_as_bool = true;
 }
 
+// Records the CPU the thread runs on.
+void GetCpuRunFunction(void* obj) {
+#if defined(WEBRTC_LINUX)
+  *static_cast<int*>(obj) = sched_getcpu();
+#endif
+}
+
+class RecordingPlacementPolicy : public ThreadPlacementPolicy {
+ public:
+  explicit RecordingPlacementPolicy(std::vector<std::string>* thread_names)
+      : thread_names_(thread_names) {}
+
+  ThreadPlacement GetThreadPlacement(const char* thread_name) override {
+    thread_names_->push_back(thread_name);
+    ThreadPlacement placement;
+    placement.cpus = {0};
+    return placement;
+  }
+
+ private:
+  std::vector<std::string>* const thread_names_;
+};
+
 }  // namespace
 
 TEST(PlatformThreadTest, StartStopDeprecated) {
@@ -113,6 +139,22 @@ TEST(PlatformThreadTest, RunFunctionIsCalled) {
   EXPECT_TRUE(flag);
 }
 
+TEST(PlatformThreadTest, AppliesThreadPlacementPolicy) {
+  std::vector<std::string> thread_names;
+  SetThreadPlacementPolicy(std::unique_ptr<ThreadPlacementPolicy>(
+      new RecordingPlacementPolicy(&thread_names)));
+  int cpu = -1;
+  PlatformThread thread(&GetCpuRunFunction, &cpu, "PlacedThread");
+  thread.Start();
+  thread.Stop();
+  SetThreadPlacementPolicy(nullptr);
+
+  EXPECT_EQ(std::vector<std::string>{"PlacedThread"}, thread_names);
+#if defined(WEBRTC_LINUX)
+  EXPECT_EQ(0, cpu);
+#endif
+}
+
 // This test is disabled since it will cause a crash.
 // There might be a way to implement this as a death test, but it looks like
 // a death test requires an expression to be checked but does not allow a
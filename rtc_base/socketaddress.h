@@ -197,6 +197,13 @@ bool SocketAddressFromSockAddrStorage(const sockaddr_storage& saddr,
                                       SocketAddress* out);
 SocketAddress EmptySocketAddressWithFamily(int family);
 
+// Hash function for using SocketAddress as a key of unordered containers.
+struct SocketAddressHash {
+  size_t operator()(const SocketAddress& address) const {
+    return address.Hash();
+  }
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_SOCKETADDRESS_H_
@@ -14,6 +14,8 @@
 
 #include <string.h>
 
+#include <unordered_map>
+
 #include "rtc_base/ipaddress.h"
 #include "rtc_base/socketaddress.h"
 #include "test/gtest.h"
@@ -344,4 +346,20 @@ TEST(SocketAddressTest, TestToSensitiveString) {
 #endif  // defined(NDEBUG)
 }
 
+TEST(SocketAddressTest, TestHashAsUnorderedMapKey) {
+  std::unordered_map<SocketAddress, int, SocketAddressHash> map;
+  map[SocketAddress("1.2.3.4", 5678)] = 1;
+  map[SocketAddress("1.2.3.4", 5679)] = 2;
+  map[SocketAddress(kTestV6AddrString, 5678)] = 3;
+  map[SocketAddress("a.b.com", 5678)] = 4;
+  EXPECT_EQ(4u, map.size());
+
+  SocketAddress addr;
+  EXPECT_TRUE(addr.FromString("1.2.3.4:5678"));
+  EXPECT_EQ(1, map[addr]);
+  EXPECT_EQ(3, map[SocketAddress(IPAddress(kTestV6Addr), 5678)]);
+  EXPECT_EQ(4, map[SocketAddress("a.b.com", 5678)]);
+  EXPECT_EQ(0u, map.count(SocketAddress("b.b.com", 5678)));
+}
+
 }  // namespace rtc
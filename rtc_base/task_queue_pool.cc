@@ -0,0 +1,559 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// TaskQueue implementation that multiplexes all task queues of a given
+// priority onto a fixed pool of worker threads, instead of creating one thread
+// per queue. A queue with pending tasks is scheduled on one worker at a time,
+// which preserves the FIFO and sequencing guarantees of the TaskQueue API.
+// Each worker keeps a local run queue; idle workers steal scheduled queues
+// from the others.
+
+#include "rtc_base/task_queue.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/timeutils.h"
+
+namespace rtc {
+namespace {
+
+using Priority = TaskQueue::Priority;
+
+// Maximum number of tasks run from one queue before the worker moves on to
+// the next scheduled queue, so that a busy queue can't starve the others.
+constexpr int kMaxTasksPerSlice = 16;
+
+ThreadPriority TaskQueuePriorityToThreadPriority(Priority priority) {
+  switch (priority) {
+    case Priority::HIGH:
+      return kRealtimePriority;
+    case Priority::LOW:
+      return kLowPriority;
+    case Priority::NORMAL:
+      return kNormalPriority;
+    default:
+      RTC_NOTREACHED();
+      return kNormalPriority;
+  }
+  return kNormalPriority;
+}
+
+// The part of a task queue that is visible to the worker pool.
+class PooledQueue : public RefCountInterface {
+ public:
+  // Runs pending tasks on the current worker thread. Returns true if the queue
+  // still has tasks and should be scheduled again.
+  virtual bool RunTasks() = 0;
+  // Called when a delayed task timer of this queue is due. Moves the delayed
+  // tasks due at |now_ms| to the pending queue.
+  virtual void OnTimer(int64_t now_ms) = 0;
+
+ protected:
+  ~PooledQueue() override = default;
+};
+
+// A fixed set of worker threads running the task queues of one priority.
+class WorkerPool {
+ public:
+  static WorkerPool* Get(Priority priority);
+
+  WorkerPool(Priority priority, size_t num_workers);
+
+  // Makes |queue| runnable. Must only be called when the queue is not already
+  // scheduled.
+  void Schedule(scoped_refptr<PooledQueue> queue);
+  // Calls PooledQueue::OnTimer() on |queue| at |fire_at_ms|.
+  void ScheduleTimer(scoped_refptr<PooledQueue> queue, int64_t fire_at_ms);
+
+ private:
+  struct Worker {
+    Worker(WorkerPool* pool, size_t index, Priority priority);
+
+    WorkerPool* const pool;
+    const size_t index;
+    // Signaled when the worker is idle and should look for work again.
+    Event wake_up;
+    PlatformThread thread;
+
+    rtc::CriticalSection lock;
+    std::deque<scoped_refptr<PooledQueue>> run_queue RTC_GUARDED_BY(lock);
+  };
+
+  static void ThreadMain(void* context);
+  // Returns the worker running on the current thread, if it belongs to this
+  // pool.
+  Worker* CurrentWorker();
+
+  void ProcessQueues(Worker* worker);
+  scoped_refptr<PooledQueue> FindWork(Worker* worker);
+  // Fires due timers and returns the time until the next one, or
+  // Event::kForever if there is none.
+  int FireTimers();
+  void WakeUpIdleWorker();
+
+  static thread_local Worker* current_worker_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  rtc::CriticalSection lock_;
+  std::deque<scoped_refptr<PooledQueue>> injection_queue_
+      RTC_GUARDED_BY(lock_);
+  std::vector<Worker*> idle_workers_ RTC_GUARDED_BY(lock_);
+  std::multimap<int64_t, scoped_refptr<PooledQueue>> timers_
+      RTC_GUARDED_BY(lock_);
+};
+
+// static
+thread_local WorkerPool::Worker* WorkerPool::current_worker_ = nullptr;
+
+// static
+WorkerPool* WorkerPool::Get(Priority priority) {
+  // The pools are never destroyed, like other process-wide WebRTC state.
+  static const size_t kNumWorkers =
+      std::max<size_t>(2, std::thread::hardware_concurrency());
+  switch (priority) {
+    case Priority::HIGH: {
+      static WorkerPool* const high_pool =
+          new WorkerPool(Priority::HIGH, kNumWorkers);
+      return high_pool;
+    }
+    case Priority::LOW: {
+      static WorkerPool* const low_pool =
+          new WorkerPool(Priority::LOW, kNumWorkers);
+      return low_pool;
+    }
+    case Priority::NORMAL:
+    default: {
+      static WorkerPool* const normal_pool =
+          new WorkerPool(Priority::NORMAL, kNumWorkers);
+      return normal_pool;
+    }
+  }
+}
+
+WorkerPool::Worker::Worker(WorkerPool* pool, size_t index, Priority priority)
+    : pool(pool),
+      index(index),
+      wake_up(/*manual_reset=*/false, /*initially_signaled=*/false),
+      thread(&WorkerPool::ThreadMain,
+             this,
+             "TaskQueuePool",
+             TaskQueuePriorityToThreadPriority(priority)) {}
+
+WorkerPool::WorkerPool(Priority priority, size_t num_workers) {
+  for (size_t i = 0; i < num_workers; ++i)
+    workers_.push_back(absl::make_unique<Worker>(this, i, priority));
+  for (auto& worker : workers_)
+    worker->thread.Start();
+}
+
+void WorkerPool::Schedule(scoped_refptr<PooledQueue> queue) {
+  Worker* worker = CurrentWorker();
+  if (worker) {
+    // Keep the queue local to this worker, other workers may steal it.
+    CritScope lock(&worker->lock);
+    worker->run_queue.push_back(std::move(queue));
+  } else {
+    CritScope lock(&lock_);
+    injection_queue_.push_back(std::move(queue));
+  }
+  WakeUpIdleWorker();
+}
+
+void WorkerPool::ScheduleTimer(scoped_refptr<PooledQueue> queue,
+                               int64_t fire_at_ms) {
+  bool is_next_timer;
+  {
+    CritScope lock(&lock_);
+    auto it = timers_.emplace(fire_at_ms, std::move(queue));
+    is_next_timer = it == timers_.begin();
+  }
+  // Let an idle worker recompute how long to sleep.
+  if (is_next_timer)
+    WakeUpIdleWorker();
+}
+
+// static
+void WorkerPool::ThreadMain(void* context) {
+  Worker* worker = static_cast<Worker*>(context);
+  current_worker_ = worker;
+  worker->pool->ProcessQueues(worker);
+}
+
+WorkerPool::Worker* WorkerPool::CurrentWorker() {
+  return current_worker_ && current_worker_->pool == this ? current_worker_
+                                                          : nullptr;
+}
+
+void WorkerPool::ProcessQueues(Worker* worker) {
+  while (true) {
+    int wait_ms = FireTimers();
+    scoped_refptr<PooledQueue> queue = FindWork(worker);
+    if (!queue) {
+      // Register as idle before the final check for work, so that a queue
+      // scheduled after the check wakes us up.
+      {
+        CritScope lock(&lock_);
+        idle_workers_.push_back(worker);
+      }
+      queue = FindWork(worker);
+      if (!queue) {
+        worker->wake_up.Wait(wait_ms);
+      }
+      CritScope lock(&lock_);
+      idle_workers_.erase(
+          std::remove(idle_workers_.begin(), idle_workers_.end(), worker),
+          idle_workers_.end());
+      if (!queue)
+        continue;
+    }
+    if (queue->RunTasks()) {
+      CritScope lock(&worker->lock);
+      worker->run_queue.push_back(std::move(queue));
+    }
+  }
+}
+
+scoped_refptr<PooledQueue> WorkerPool::FindWork(Worker* worker) {
+  scoped_refptr<PooledQueue> queue;
+  {
+    CritScope lock(&worker->lock);
+    if (!worker->run_queue.empty()) {
+      queue = std::move(worker->run_queue.front());
+      worker->run_queue.pop_front();
+      return queue;
+    }
+  }
+  {
+    CritScope lock(&lock_);
+    if (!injection_queue_.empty()) {
+      queue = std::move(injection_queue_.front());
+      injection_queue_.pop_front();
+      return queue;
+    }
+  }
+  // Steal from the back of another worker's run queue, starting with the next
+  // worker to spread the load.
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker* victim = workers_[(worker->index + i) % workers_.size()].get();
+    CritScope lock(&victim->lock);
+    if (!victim->run_queue.empty()) {
+      queue = std::move(victim->run_queue.back());
+      victim->run_queue.pop_back();
+      return queue;
+    }
+  }
+  return queue;
+}
+
+int WorkerPool::FireTimers() {
+  std::vector<scoped_refptr<PooledQueue>> due_queues;
+  int64_t now_ms = TimeMillis();
+  int wait_ms = Event::kForever;
+  {
+    CritScope lock(&lock_);
+    auto it = timers_.begin();
+    for (; it != timers_.end() && it->first <= now_ms; ++it)
+      due_queues.push_back(std::move(it->second));
+    timers_.erase(timers_.begin(), it);
+    if (!timers_.empty())
+      wait_ms = static_cast<int>(timers_.begin()->first - now_ms);
+  }
+  for (auto& queue : due_queues)
+    queue->OnTimer(now_ms);
+  return wait_ms;
+}
+
+void WorkerPool::WakeUpIdleWorker() {
+  Worker* worker = nullptr;
+  {
+    CritScope lock(&lock_);
+    if (idle_workers_.empty())
+      return;
+    worker = idle_workers_.back();
+    idle_workers_.pop_back();
+  }
+  worker->wake_up.Set();
+}
+
+}  // namespace
+
+class TaskQueue::Impl : public PooledQueue {
+ public:
+  Impl(const char* queue_name, TaskQueue* queue, Priority priority);
+  ~Impl() override;
+
+  static TaskQueue::Impl* Current();
+  static TaskQueue* CurrentQueue();
+
+  // Used for DCHECKing the current queue.
+  bool IsCurrent() const;
+
+  template <class Closure,
+            typename std::enable_if<!std::is_convertible<
+                Closure,
+                std::unique_ptr<QueuedTask>>::value>::type* = nullptr>
+  void PostTask(Closure&& closure) {
+    PostTask(NewClosure(std::forward<Closure>(closure)));
+  }
+
+  void PostTask(std::unique_ptr<QueuedTask> task);
+  void PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                        std::unique_ptr<QueuedTask> reply,
+                        TaskQueue::Impl* reply_queue);
+
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task, uint32_t milliseconds);
+
+  // Drops all pending tasks and waits for a task running on another thread to
+  // finish. No tasks are run after this returns.
+  void Stop();
+
+  // PooledQueue implementation.
+  bool RunTasks() override;
+  void OnTimer(int64_t now_ms) override;
+
+ private:
+  using OrderId = uint64_t;
+
+  struct DelayedEntryTimeout {
+    int64_t next_fire_at_ms_{};
+    OrderId order_{};
+
+    bool operator<(const DelayedEntryTimeout& o) const {
+      return std::tie(next_fire_at_ms_, order_) <
+             std::tie(o.next_fire_at_ms_, o.order_);
+    }
+  };
+
+  // Set on a worker thread while it runs tasks of this queue.
+  static thread_local TaskQueue::Impl* thread_context_;
+
+  // The back pointer from the owner task queue object
+  // from this implementation detail.
+  TaskQueue* const queue_;
+  WorkerPool* const pool_;
+
+  // Signaled when a task that was running while Stop() was called finishes.
+  Event stopped_;
+
+  rtc::CriticalSection pending_lock_;
+  bool quit_ RTC_GUARDED_BY(pending_lock_) = false;
+  // True while the queue is in a run queue of the pool or running on a worker.
+  bool scheduled_ RTC_GUARDED_BY(pending_lock_) = false;
+  bool running_ RTC_GUARDED_BY(pending_lock_) = false;
+  OrderId delayed_order_ RTC_GUARDED_BY(pending_lock_) = 0;
+  std::queue<std::unique_ptr<QueuedTask>> pending_queue_
+      RTC_GUARDED_BY(pending_lock_);
+  std::map<DelayedEntryTimeout, std::unique_ptr<QueuedTask>> delayed_queue_
+      RTC_GUARDED_BY(pending_lock_);
+};
+
+// static
+thread_local TaskQueue::Impl* TaskQueue::Impl::thread_context_ = nullptr;
+
+TaskQueue::Impl::Impl(const char* queue_name,
+                      TaskQueue* queue,
+                      Priority priority)
+    : queue_(queue),
+      pool_(WorkerPool::Get(priority)),
+      stopped_(/*manual_reset=*/false, /*initially_signaled=*/false) {
+  RTC_DCHECK(queue_name);
+}
+
+TaskQueue::Impl::~Impl() {
+  RTC_DCHECK(!running_);
+}
+
+// static
+TaskQueue::Impl* TaskQueue::Impl::Current() {
+  return thread_context_;
+}
+
+// static
+TaskQueue* TaskQueue::Impl::CurrentQueue() {
+  TaskQueue::Impl* current = Current();
+  return current ? current->queue_ : nullptr;
+}
+
+bool TaskQueue::Impl::IsCurrent() const {
+  return thread_context_ == this;
+}
+
+void TaskQueue::Impl::PostTask(std::unique_ptr<QueuedTask> task) {
+  bool schedule = false;
+  {
+    CritScope lock(&pending_lock_);
+    if (quit_)
+      return;
+    pending_queue_.push(std::move(task));
+    if (!scheduled_) {
+      scheduled_ = true;
+      schedule = true;
+    }
+  }
+  if (schedule)
+    pool_->Schedule(this);
+}
+
+void TaskQueue::Impl::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                      uint32_t milliseconds) {
+  DelayedEntryTimeout delay;
+  delay.next_fire_at_ms_ = TimeMillis() + milliseconds;
+  {
+    CritScope lock(&pending_lock_);
+    if (quit_)
+      return;
+    delay.order_ = ++delayed_order_;
+    delayed_queue_[delay] = std::move(task);
+  }
+  pool_->ScheduleTimer(this, delay.next_fire_at_ms_);
+}
+
+void TaskQueue::Impl::PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                                       std::unique_ptr<QueuedTask> reply,
+                                       TaskQueue::Impl* reply_queue) {
+  QueuedTask* task_ptr = task.release();
+  QueuedTask* reply_task_ptr = reply.release();
+  PostTask([task_ptr, reply_task_ptr, reply_queue]() {
+    if (task_ptr->Run())
+      delete task_ptr;
+
+    reply_queue->PostTask(std::unique_ptr<QueuedTask>(reply_task_ptr));
+  });
+}
+
+void TaskQueue::Impl::Stop() {
+  RTC_DCHECK(!IsCurrent());
+  std::queue<std::unique_ptr<QueuedTask>> pending_queue;
+  std::map<DelayedEntryTimeout, std::unique_ptr<QueuedTask>> delayed_queue;
+  bool wait_for_running_task;
+  {
+    CritScope lock(&pending_lock_);
+    quit_ = true;
+    pending_queue.swap(pending_queue_);
+    delayed_queue.swap(delayed_queue_);
+    wait_for_running_task = running_;
+  }
+  // The tasks are deleted here, outside of the lock, in case their
+  // destructors post to other queues.
+  if (wait_for_running_task)
+    stopped_.Wait(Event::kForever);
+}
+
+bool TaskQueue::Impl::RunTasks() {
+  thread_context_ = this;
+  bool more_tasks = false;
+  for (int i = 0; i < kMaxTasksPerSlice; ++i) {
+    std::unique_ptr<QueuedTask> task;
+    {
+      CritScope lock(&pending_lock_);
+      if (quit_ || pending_queue_.empty())
+        break;
+      task = std::move(pending_queue_.front());
+      pending_queue_.pop();
+      running_ = true;
+    }
+    QueuedTask* release_ptr = task.release();
+    if (release_ptr->Run())
+      delete release_ptr;
+  }
+  {
+    CritScope lock(&pending_lock_);
+    if (running_ && quit_)
+      stopped_.Set();
+    running_ = false;
+    more_tasks = !quit_ && !pending_queue_.empty();
+    scheduled_ = more_tasks;
+  }
+  thread_context_ = nullptr;
+  return more_tasks;
+}
+
+void TaskQueue::Impl::OnTimer(int64_t now_ms) {
+  bool schedule = false;
+  {
+    CritScope lock(&pending_lock_);
+    auto it = delayed_queue_.begin();
+    for (; it != delayed_queue_.end() && it->first.next_fire_at_ms_ <= now_ms;
+         ++it) {
+      pending_queue_.push(std::move(it->second));
+    }
+    delayed_queue_.erase(delayed_queue_.begin(), it);
+    if (!pending_queue_.empty() && !scheduled_ && !quit_) {
+      scheduled_ = true;
+      schedule = true;
+    }
+  }
+  if (schedule)
+    pool_->Schedule(this);
+}
+
+// Boilerplate for the PIMPL pattern.
+TaskQueue::TaskQueue(const char* queue_name, Priority priority)
+    : impl_(new RefCountedObject<TaskQueue::Impl>(queue_name, this, priority)) {
+}
+
+TaskQueue::~TaskQueue() {
+  // The pool may still hold references to |impl_|, but it won't run any more
+  // tasks once stopped.
+  impl_->Stop();
+}
+
+// static
+TaskQueue* TaskQueue::Current() {
+  return TaskQueue::Impl::CurrentQueue();
+}
+
+// Used for DCHECKing the current queue.
+bool TaskQueue::IsCurrent() const {
+  return impl_->IsCurrent();
+}
+
+void TaskQueue::PostTask(std::unique_ptr<QueuedTask> task) {
+  return TaskQueue::impl_->PostTask(std::move(task));
+}
+
+void TaskQueue::PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                                 std::unique_ptr<QueuedTask> reply,
+                                 TaskQueue* reply_queue) {
+  return TaskQueue::impl_->PostTaskAndReply(std::move(task), std::move(reply),
+                                            reply_queue->impl_.get());
+}
+
+void TaskQueue::PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                                 std::unique_ptr<QueuedTask> reply) {
+  return TaskQueue::impl_->PostTaskAndReply(std::move(task), std::move(reply),
+                                            impl_.get());
+}
+
+void TaskQueue::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                uint32_t milliseconds) {
+  return TaskQueue::impl_->PostDelayedTask(std::move(task), milliseconds);
+}
+
+}  // namespace rtc
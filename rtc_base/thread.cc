@@ -31,6 +31,7 @@
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/nullsocketserver.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/timeutils.h"
 #include "rtc_base/trace_event.h"
 
@@ -340,6 +341,7 @@ void* Thread::PreRun(void* pv) {
   ThreadInit* init = static_cast<ThreadInit*>(pv);
   ThreadManager::Instance()->SetCurrentThread(init->thread);
   rtc::SetCurrentThreadName(init->thread->name_.c_str());
+  rtc::ApplyThreadPlacementPolicy(init->thread->name_.c_str());
 #if defined(WEBRTC_MAC)
   ScopedAutoReleasePool pool;
 #endif
@@ -403,6 +405,7 @@ void Thread::Send(const Location& posted_from,
     _SendMessage smsg;
     smsg.thread = current_thread;
     smsg.msg = msg;
+    smsg.msg.ready_time_us = TimeMicros();
     smsg.ready = &ready;
     sendlist_.push_back(smsg);
   }
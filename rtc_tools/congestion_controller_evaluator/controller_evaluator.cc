@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/congestion_controller_evaluator/controller_evaluator.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "modules/congestion_controller/rtp/transport_feedback_adapter.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "rtc_base/network/sent_packet.h"
+#include "rtc_base/rate_statistics.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+// TODO(holmer): Log the call config and use that here instead.
+constexpr uint32_t kDefaultStartBitrateBps = 300000;
+// The target rate is considered an overshoot when it exceeds the acknowledged
+// rate by this factor.
+constexpr double kOvershootFactor = 1.1;
+}  // namespace
+
+ControllerEvaluation EvaluateController(
+    const ParsedRtcEventLog& parsed_log,
+    NetworkControllerFactoryInterface* factory) {
+  std::multimap<int64_t, const LoggedRtpPacketOutgoing*> outgoing_rtp;
+  for (const auto& stream : parsed_log.outgoing_rtp_packets_by_ssrc()) {
+    for (const LoggedRtpPacketOutgoing& rtp_packet : stream.outgoing_packets) {
+      if (rtp_packet.rtp.header.extension.hasTransportSequenceNumber) {
+        outgoing_rtp.insert(
+            std::make_pair(rtp_packet.rtp.log_time_us(), &rtp_packet));
+      }
+    }
+  }
+  const std::vector<LoggedRtcpPacketTransportFeedback>& incoming_rtcp =
+      parsed_log.transport_feedbacks(kIncomingPacket);
+
+  SimulatedClock clock(0);
+  TransportFeedbackAdapter transport_feedback(&clock);
+  NetworkControllerConfig config;
+  config.constraints.at_time = Timestamp::us(clock.TimeInMicroseconds());
+  config.constraints.starting_rate = DataRate::bps(kDefaultStartBitrateBps);
+  std::unique_ptr<NetworkControllerInterface> controller =
+      factory->Create(config);
+  const TimeDelta process_interval = factory->GetProcessInterval();
+
+  constexpr int64_t kNever = std::numeric_limits<int64_t>::max();
+  auto rtp_iterator = outgoing_rtp.begin();
+  auto rtcp_iterator = incoming_rtcp.begin();
+  auto NextRtpTime = [&]() {
+    return rtp_iterator != outgoing_rtp.end() ? rtp_iterator->first : kNever;
+  };
+  auto NextRtcpTime = [&]() {
+    return rtcp_iterator != incoming_rtcp.end()
+               ? static_cast<int64_t>(rtcp_iterator->log_time_us())
+               : kNever;
+  };
+  int64_t next_process_time_us = std::min(NextRtpTime(), NextRtcpTime());
+  auto NextProcessTime = [&]() {
+    if (process_interval.IsInfinite() ||
+        (rtp_iterator == outgoing_rtp.end() &&
+         rtcp_iterator == incoming_rtcp.end())) {
+      return kNever;
+    }
+    return next_process_time_us;
+  };
+
+  ControllerEvaluation evaluation;
+  DataRate target_rate = config.constraints.starting_rate.value();
+  auto Apply = [&](const NetworkControlUpdate& update) {
+    if (update.target_rate)
+      target_rate = update.target_rate->target_rate;
+  };
+
+  RateStatistics acked_bitrate(250, 8000);
+  absl::optional<uint32_t> acked_bps;
+  int64_t first_feedback_us = -1;
+  int64_t last_time_us = -1;
+  double target_bits = 0;
+  int64_t overshoot_us = 0;
+  int64_t received_bytes = 0;
+  int64_t num_received = 0;
+  int64_t num_lost = 0;
+  double sum_delay_ms = 0;
+  int64_t min_delay_ms = kNever;
+
+  int64_t time_us =
+      std::min({NextRtpTime(), NextRtcpTime(), NextProcessTime()});
+  while (time_us != kNever) {
+    clock.AdvanceTimeMicroseconds(time_us - clock.TimeInMicroseconds());
+    // Integrate the target rate from the first feedback on, since the rate
+    // can't be compared to the acknowledged rate before that.
+    if (first_feedback_us >= 0) {
+      int64_t elapsed_us = time_us - last_time_us;
+      target_bits += target_rate.bps() * elapsed_us / 1e6;
+      if (acked_bps && target_rate.bps() > kOvershootFactor * *acked_bps)
+        overshoot_us += elapsed_us;
+    }
+    last_time_us = time_us;
+
+    if (time_us >= NextRtpTime()) {
+      const LoggedRtpPacketOutgoing& rtp_packet = *rtp_iterator->second;
+      uint16_t sequence_number =
+          rtp_packet.rtp.header.extension.transportSequenceNumber;
+      transport_feedback.AddPacket(rtp_packet.rtp.header.ssrc, sequence_number,
+                                   rtp_packet.rtp.total_length,
+                                   PacedPacketInfo());
+      rtc::SentPacket sent_packet(sequence_number,
+                                  rtp_packet.rtp.log_time_us() / 1000);
+      auto sent_msg = transport_feedback.ProcessSentPacket(sent_packet);
+      if (sent_msg)
+        Apply(controller->OnSentPacket(*sent_msg));
+      ++rtp_iterator;
+    }
+    if (time_us >= NextRtcpTime()) {
+      auto feedback_msg = transport_feedback.ProcessTransportFeedback(
+          rtcp_iterator->transport_feedback);
+      if (feedback_msg) {
+        Apply(controller->OnTransportPacketsFeedback(*feedback_msg));
+        if (first_feedback_us < 0)
+          first_feedback_us = time_us;
+        ++evaluation.num_feedbacks;
+        for (const PacketResult& packet :
+             feedback_msg->ReceivedWithSendInfo()) {
+          int64_t receive_time_ms = packet.receive_time.ms();
+          int64_t delay_ms = receive_time_ms - packet.sent_packet.send_time.ms();
+          sum_delay_ms += delay_ms;
+          min_delay_ms = std::min(min_delay_ms, delay_ms);
+          received_bytes += packet.sent_packet.size.bytes();
+          ++num_received;
+          acked_bitrate.Update(packet.sent_packet.size.bytes(),
+                               receive_time_ms);
+          acked_bps = acked_bitrate.Rate(receive_time_ms);
+        }
+        num_lost += feedback_msg->LostWithSendInfo().size();
+      }
+      ++rtcp_iterator;
+    }
+    if (time_us >= NextProcessTime()) {
+      ProcessInterval msg;
+      msg.at_time = Timestamp::us(time_us);
+      Apply(controller->OnProcessInterval(msg));
+      next_process_time_us += process_interval.us();
+    }
+    time_us = std::min({NextRtpTime(), NextRtcpTime(), NextProcessTime()});
+  }
+
+  if (first_feedback_us < 0 || last_time_us <= first_feedback_us)
+    return evaluation;
+  const double duration_s = (last_time_us - first_feedback_us) / 1e6;
+  evaluation.mean_target_rate_kbps = target_bits / duration_s / 1000;
+  evaluation.mean_acked_rate_kbps = received_bytes * 8 / duration_s / 1000;
+  if (target_bits > 0) {
+    evaluation.utilization =
+        evaluation.mean_acked_rate_kbps / evaluation.mean_target_rate_kbps;
+  }
+  evaluation.overshoot_fraction =
+      overshoot_us / static_cast<double>(last_time_us - first_feedback_us);
+  if (num_received > 0) {
+    evaluation.mean_queuing_delay_ms =
+        sum_delay_ms / num_received - min_delay_ms;
+  }
+  if (num_received + num_lost > 0) {
+    evaluation.loss_fraction =
+        num_lost / static_cast<double>(num_received + num_lost);
+  }
+  return evaluation;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_CONGESTION_CONTROLLER_EVALUATOR_CONTROLLER_EVALUATOR_H_
+#define RTC_TOOLS_CONGESTION_CONTROLLER_EVALUATOR_CONTROLLER_EVALUATOR_H_
+
+#include <stdint.h>
+
+#include "api/transport/network_control.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+
+namespace webrtc {
+
+// Metrics of a network controller replayed over the packets and transport
+// feedback of an event log. The delay and loss metrics describe the recorded
+// traffic, which the replayed controller can't affect; they are reported to
+// put the controller metrics in context.
+struct ControllerEvaluation {
+  int num_feedbacks = 0;
+  // The mean target rate over the duration of the feedback.
+  double mean_target_rate_kbps = 0;
+  // The rate at which the recorded packets were received.
+  double mean_acked_rate_kbps = 0;
+  // The received rate relative to the target rate.
+  double utilization = 0;
+  // The fraction of the time the target rate exceeded the acknowledged rate
+  // by more than 10%, i.e. the controller would likely have caused queuing.
+  double overshoot_fraction = 0;
+  // The mean one-way delay of received packets above the smallest one.
+  double mean_queuing_delay_ms = 0;
+  double loss_fraction = 0;
+};
+
+// Replays the outgoing packets with transport sequence numbers and the
+// incoming transport feedback of |parsed_log| through a controller created by
+// |factory|, in simulated time. Each call creates its own controller, so
+// calls for different logs may run concurrently if |factory| allows it.
+ControllerEvaluation EvaluateController(
+    const ParsedRtcEventLog& parsed_log,
+    NetworkControllerFactoryInterface* factory);
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_CONGESTION_CONTROLLER_EVALUATOR_CONTROLLER_EVALUATOR_H_
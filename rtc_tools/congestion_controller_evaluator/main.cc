@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "api/transport/goog_cc_factory.h"
+#include "logging/rtc_event_log/rtc_event_log.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "modules/congestion_controller/pcc/pcc_factory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/flags.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_tools/congestion_controller_evaluator/controller_evaluator.h"
+#include "system_wrappers/include/cpu_info.h"
+
+WEBRTC_DEFINE_string(controllers,
+                     "goog_cc,bbr,pcc",
+                     "Comma separated list of the controllers to evaluate: "
+                     "\"goog_cc\", \"bbr\" and \"pcc\".");
+WEBRTC_DEFINE_int(threads,
+                  0,
+                  "The number of logs to evaluate in parallel. Defaults to "
+                  "the number of cores.");
+WEBRTC_DEFINE_bool(help, false, "Prints this message.");
+
+namespace webrtc {
+namespace {
+
+std::vector<std::string> SplitControllers(const std::string& controllers) {
+  std::vector<std::string> names;
+  std::istringstream stream(controllers);
+  std::string name;
+  while (std::getline(stream, name, ','))
+    names.push_back(name);
+  return names;
+}
+
+std::unique_ptr<NetworkControllerFactoryInterface> CreateFactory(
+    const std::string& name,
+    RtcEventLog* event_log) {
+  if (name == "goog_cc")
+    return absl::make_unique<GoogCcNetworkControllerFactory>(event_log);
+  if (name == "bbr")
+    return absl::make_unique<BbrNetworkControllerFactory>();
+  if (name == "pcc")
+    return absl::make_unique<PccNetworkControllerFactory>();
+  return nullptr;
+}
+
+// Evaluates the controllers over the logs, taking the next unevaluated log
+// until all have been evaluated. Runs on several threads at once.
+class Evaluator {
+ public:
+  Evaluator(const std::vector<std::string>& files,
+            const std::vector<std::string>& controllers)
+      : files_(files),
+        controllers_(controllers),
+        results_(files.size()),
+        next_file_(0) {}
+
+  static void RunThread(void* obj) { static_cast<Evaluator*>(obj)->Run(); }
+
+  void PrintResults() const {
+    printf(
+        "log,controller,feedbacks,target_kbps,acked_kbps,utilization,"
+        "overshoot,queuing_delay_ms,loss\n");
+    for (size_t i = 0; i < files_.size(); ++i) {
+      if (results_[i].empty()) {
+        fprintf(stderr, "Failed to parse %s\n", files_[i].c_str());
+        continue;
+      }
+      for (size_t j = 0; j < controllers_.size(); ++j) {
+        const ControllerEvaluation& r = results_[i][j];
+        printf("%s,%s,%d,%.1f,%.1f,%.3f,%.3f,%.1f,%.4f\n", files_[i].c_str(),
+               controllers_[j].c_str(), r.num_feedbacks,
+               r.mean_target_rate_kbps, r.mean_acked_rate_kbps, r.utilization,
+               r.overshoot_fraction, r.mean_queuing_delay_ms, r.loss_fraction);
+      }
+    }
+  }
+
+ private:
+  void Run() {
+    RtcEventLogNullImpl null_event_log;
+    for (size_t i = next_file_++; i < files_.size(); i = next_file_++) {
+      ParsedRtcEventLog parsed_log;
+      if (!parsed_log.ParseFile(files_[i]))
+        continue;
+      // Each log has its own slot, so no locking is needed.
+      for (const std::string& name : controllers_) {
+        auto factory = CreateFactory(name, &null_event_log);
+        results_[i].push_back(EvaluateController(parsed_log, factory.get()));
+      }
+    }
+  }
+
+  const std::vector<std::string> files_;
+  const std::vector<std::string> controllers_;
+  std::vector<std::vector<ControllerEvaluation>> results_;
+  std::atomic<size_t> next_file_;
+};
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage =
+      "Replays the transport feedback of RtcEventLogs through network "
+      "controllers and prints CSV metrics for each log and controller.\n"
+      "Example usage:\n" +
+      program_name + " --controllers=goog_cc,bbr <log> [<log> ...]\n";
+  if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true) != 0 ||
+      FLAG_help || argc < 2) {
+    printf("%s", usage.c_str());
+    if (FLAG_help)
+      rtc::FlagList::Print(nullptr, false);
+    return 0;
+  }
+
+  std::vector<std::string> controllers =
+      webrtc::SplitControllers(FLAG_controllers);
+  webrtc::RtcEventLogNullImpl null_event_log;
+  for (const std::string& name : controllers) {
+    if (!webrtc::CreateFactory(name, &null_event_log)) {
+      fprintf(stderr, "Unknown controller %s\n", name.c_str());
+      return 1;
+    }
+  }
+  std::vector<std::string> files(argv + 1, argv + argc);
+
+  int num_threads = FLAG_threads > 0
+                        ? FLAG_threads
+                        : webrtc::CpuInfo::DetectNumberOfCores();
+  num_threads = std::min<int>(num_threads, files.size());
+  webrtc::Evaluator evaluator(files, controllers);
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(absl::make_unique<rtc::PlatformThread>(
+        &webrtc::Evaluator::RunThread, &evaluator, "Evaluator"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+  evaluator.PrintResults();
+  return 0;
+}
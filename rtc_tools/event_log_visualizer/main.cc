@@ -10,6 +10,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -200,6 +201,13 @@ WEBRTC_DEFINE_bool(protobuf_output,
                    false,
                    "Output charts as protobuf instead of python code.");
 
+WEBRTC_DEFINE_int(
+    max_points_per_series,
+    10000,
+    "Downsample each data series to at most this many points, keeping the "
+    "minimum and maximum of each group of consecutive points. 0 keeps all "
+    "points.");
+
 void SetAllPlotFlags(bool setting);
 
 int main(int argc, char* argv[]) {
@@ -278,6 +286,7 @@ int main(int argc, char* argv[]) {
   } else {
     collection.reset(new webrtc::PythonPlotCollection());
   }
+  collection->SetMaxPointsPerSeries(std::max(0, FLAG_max_points_per_series));
 
   if (FLAG_plot_incoming_packet_sizes) {
     analyzer.CreatePacketGraph(webrtc::kIncomingPacket,
@@ -11,11 +11,44 @@
 #include "rtc_tools/event_log_visualizer/plot_base.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
+void DownsampleTimeSeries(size_t max_points, TimeSeries* time_series) {
+  std::vector<TimeSeriesPoint>& points = time_series->points;
+  // Each bucket contributes up to two points, and the first and last points
+  // are always kept.
+  if (max_points < 4 || points.size() <= max_points)
+    return;
+  const size_t num_inner_points = points.size() - 2;
+  const size_t num_buckets = (max_points - 2) / 2;
+  const size_t bucket_size = (num_inner_points + num_buckets - 1) / num_buckets;
+
+  std::vector<TimeSeriesPoint> downsampled;
+  downsampled.reserve(max_points);
+  downsampled.push_back(points.front());
+  for (size_t begin = 1; begin <= num_inner_points; begin += bucket_size) {
+    const size_t end = std::min(begin + bucket_size, num_inner_points + 1);
+    size_t min_index = begin;
+    size_t max_index = begin;
+    for (size_t i = begin + 1; i < end; ++i) {
+      if (points[i].y < points[min_index].y)
+        min_index = i;
+      if (points[i].y > points[max_index].y)
+        max_index = i;
+    }
+    // Keep the original order of the points within the bucket.
+    downsampled.push_back(points[std::min(min_index, max_index)]);
+    if (min_index != max_index)
+      downsampled.push_back(points[std::max(min_index, max_index)]);
+  }
+  downsampled.push_back(points.back());
+  points = std::move(downsampled);
+}
+
 void Plot::SetXAxis(float min_value,
                     float max_value,
                     std::string label,
@@ -70,7 +103,12 @@ void Plot::SetTitle(std::string title) {
   title_ = title;
 }
 
+void Plot::SetMaxPointsPerSeries(size_t max_points) {
+  max_points_per_series_ = max_points;
+}
+
 void Plot::AppendTimeSeries(TimeSeries&& time_series) {
+  DownsampleTimeSeries(max_points_per_series_, &time_series);
   series_list_.emplace_back(std::move(time_series));
 }
 
@@ -80,7 +118,7 @@ void Plot::AppendIntervalSeries(IntervalSeries&& interval_series) {
 
 void Plot::AppendTimeSeriesIfNotEmpty(TimeSeries&& time_series) {
   if (time_series.points.size() > 0) {
-    series_list_.emplace_back(std::move(time_series));
+    AppendTimeSeries(std::move(time_series));
   }
 }
 
@@ -64,6 +64,13 @@ struct TimeSeries {
   std::vector<TimeSeriesPoint> points;
 };
 
+// Reduces |time_series| to at most |max_points| points, by splitting the
+// points into consecutive buckets and keeping the points with the smallest and
+// largest y-value of each bucket, plus the first and last point. This
+// preserves spikes and the visual envelope of the series. A |max_points| of
+// 0 disables downsampling.
+void DownsampleTimeSeries(size_t max_points, TimeSeries* time_series);
+
 struct Interval {
   Interval() = default;
   Interval(double begin, double end) : begin(begin), end(end) {}
@@ -140,6 +147,10 @@ class Plot {
   // Sets the title of the plot.
   void SetTitle(std::string title);
 
+  // Limits the number of points kept for each TimeSeries added after this
+  // call, see DownsampleTimeSeries(). 0 keeps all points.
+  void SetMaxPointsPerSeries(size_t max_points);
+
   // Add a new TimeSeries to the plot.
   void AppendTimeSeries(TimeSeries&& time_series);
 
@@ -160,6 +171,7 @@ class Plot {
   std::string title_;
   std::vector<TimeSeries> series_list_;
   std::vector<IntervalSeries> interval_list_;
+  size_t max_points_per_series_ = 0;
 };
 
 class PlotCollection {
@@ -168,8 +180,14 @@ class PlotCollection {
   virtual void Draw() = 0;
   virtual Plot* AppendNewPlot() = 0;
 
+  // Applies Plot::SetMaxPointsPerSeries() to plots appended after this call.
+  void SetMaxPointsPerSeries(size_t max_points) {
+    max_points_per_series_ = max_points;
+  }
+
  protected:
   std::vector<std::unique_ptr<Plot> > plots_;
+  size_t max_points_per_series_ = 0;
 };
 
 }  // namespace webrtc
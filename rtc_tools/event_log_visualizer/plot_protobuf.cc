@@ -85,6 +85,7 @@ void ProtobufPlotCollection::ExportProtobuf(
 
 Plot* ProtobufPlotCollection::AppendNewPlot() {
   Plot* plot = new ProtobufPlot();
+  plot->SetMaxPointsPerSeries(max_points_per_series_);
   plots_.push_back(std::unique_ptr<Plot>(plot));
   return plot;
 }
@@ -176,6 +176,7 @@ void PythonPlotCollection::Draw() {
 
 Plot* PythonPlotCollection::AppendNewPlot() {
   Plot* plot = new PythonPlot();
+  plot->SetMaxPointsPerSeries(max_points_per_series_);
   plots_.push_back(std::unique_ptr<Plot>(plot));
   return plot;
 }
@@ -80,7 +80,9 @@ int main(int argc, char* argv[]) {
       " Default: None\n"
       "  - yuv_directory: Where to write aligned YUV ref+test output files."
       " If not present, no files will be written."
-      " Default: None\n";
+      " Default: None\n"
+      "  - num_threads(int): The number of threads computing PSNR and SSIM,"
+      " or 0 for one thread per core. Default: 0\n";
 
   webrtc::test::CommandLineParser parser;
 
@@ -96,6 +98,7 @@ int main(int argc, char* argv[]) {
   parser.SetFlag("aligned_output_file", "");
   parser.SetFlag("yuv_directory", "");
   parser.SetFlag("chartjson_result_file", "");
+  parser.SetFlag("num_threads", "0");
   parser.SetFlag("help", "false");
 
   parser.ProcessFlags();
@@ -163,8 +166,11 @@ int main(int argc, char* argv[]) {
   const rtc::scoped_refptr<webrtc::test::Video> color_adjusted_test_video =
       AdjustColors(color_transformation, test_video);
 
-  results.frames = webrtc::test::RunAnalysis(
-      aligned_reference_video, color_adjusted_test_video, matching_indices);
+  const int num_threads =
+      strtol((parser.GetFlag("num_threads")).c_str(), nullptr, 10);
+  results.frames = webrtc::test::RunAnalysis(aligned_reference_video,
+                                             color_adjusted_test_video,
+                                             matching_indices, num_threads);
 
   const std::vector<webrtc::test::Cluster> clusters =
       webrtc::test::CalculateFrameClusters(matching_indices);
@@ -12,10 +12,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <memory>
 
+#include "absl/memory/memory.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "test/testsupport/perf_test.h"
 #include "third_party/libyuv/include/libyuv/compare.h"
 
@@ -57,21 +62,67 @@ std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
     const std::vector<size_t>& test_frame_indices) {
-  std::vector<AnalysisResult> results;
-  for (size_t i = 0; i < test_video->number_of_frames(); ++i) {
-    const rtc::scoped_refptr<I420BufferInterface>& test_frame =
-        test_video->GetFrame(i);
-    const rtc::scoped_refptr<I420BufferInterface>& reference_frame =
-        reference_video->GetFrame(i);
+  return RunAnalysis(reference_video, test_video, test_frame_indices,
+                     /*num_threads=*/1);
+}
+
+namespace {
+
+struct AnalysisContext {
+  const Video* reference_video;
+  const Video* test_video;
+  const std::vector<size_t>* test_frame_indices;
+  std::vector<AnalysisResult>* results;
+  std::atomic<size_t> next_frame{0};
+};
+
+void AnalyzeFrames(void* obj) {
+  AnalysisContext* context = static_cast<AnalysisContext*>(obj);
+  for (size_t i = context->next_frame++; i < context->results->size();
+       i = context->next_frame++) {
+    const rtc::scoped_refptr<I420BufferInterface> test_frame =
+        context->test_video->GetFrame(i);
+    const rtc::scoped_refptr<I420BufferInterface> reference_frame =
+        context->reference_video->GetFrame(i);
 
     // Fill in the result struct.
-    AnalysisResult result;
-    result.frame_number = test_frame_indices[i];
+    AnalysisResult& result = (*context->results)[i];
+    result.frame_number = (*context->test_frame_indices)[i];
     result.psnr_value = Psnr(reference_frame, test_frame);
     result.ssim_value = Ssim(reference_frame, test_frame);
-    results.push_back(result);
+  }
+}
+
+}  // namespace
+
+std::vector<AnalysisResult> RunAnalysis(
+    const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
+    const rtc::scoped_refptr<webrtc::test::Video>& test_video,
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads) {
+  std::vector<AnalysisResult> results(test_video->number_of_frames());
+  AnalysisContext context;
+  context.reference_video = reference_video.get();
+  context.test_video = test_video.get();
+  context.test_frame_indices = &test_frame_indices;
+  context.results = &results;
+
+  if (num_threads <= 0)
+    num_threads = CpuInfo::DetectNumberOfCores();
+  num_threads = std::min<int>(num_threads, results.size());
+  if (num_threads <= 1) {
+    AnalyzeFrames(&context);
+    return results;
   }
 
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(absl::make_unique<rtc::PlatformThread>(
+        &AnalyzeFrames, &context, "FrameAnalyzer"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
   return results;
 }
 
@@ -55,6 +55,14 @@ std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
     const std::vector<size_t>& test_frame_indices);
 
+// Same as above, but analyzes frames on |num_threads| threads, or on one thread
+// per core if |num_threads| is 0. The results are in frame order regardless.
+std::vector<AnalysisResult> RunAnalysis(
+    const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
+    const rtc::scoped_refptr<webrtc::test::Video>& test_video,
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads);
+
 // Compute PSNR for an I420 buffer (all planes). The max return value (in the
 // case where the test and reference frames are exactly the same) will be 48.
 double Psnr(const rtc::scoped_refptr<I420BufferInterface>& ref_buffer,
@@ -17,6 +17,8 @@
 #include <string>
 
 #include "rtc_tools/frame_analyzer/video_quality_analysis.h"
+#include "rtc_tools/frame_analyzer/video_temporal_aligner.h"
+#include "rtc_tools/video_file_reader.h"
 #include "test/gtest.h"
 #include "test/testsupport/fileutils.h"
 
@@ -182,5 +184,29 @@ TEST_F(VideoQualityAnalysisTest, GetTotalNumberOfSkippedFramesEmpty) {
   EXPECT_EQ(0, GetTotalNumberOfSkippedFrames({}));
 }
 
+TEST_F(VideoQualityAnalysisTest, RunAnalysisInParallelMatchesSingleThread) {
+  const rtc::scoped_refptr<Video> reference_video =
+      OpenYuvFile(ResourcePath("foreman_128x96", "yuv"), 128, 96);
+  ASSERT_TRUE(reference_video);
+  std::vector<size_t> indices;
+  for (size_t i = 0; i + 1 < reference_video->number_of_frames(); ++i)
+    indices.push_back(i + 1);
+  const rtc::scoped_refptr<Video> test_video =
+      ReorderVideo(reference_video, indices);
+  const rtc::scoped_refptr<Video> aligned_reference_video =
+      ReorderVideo(reference_video, std::vector<size_t>(indices.size(), 0));
+
+  const std::vector<AnalysisResult> expected = RunAnalysis(
+      aligned_reference_video, test_video, indices, /*num_threads=*/1);
+  const std::vector<AnalysisResult> results = RunAnalysis(
+      aligned_reference_video, test_video, indices, /*num_threads=*/4);
+  ASSERT_EQ(expected.size(), results.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(expected[i].frame_number, results[i].frame_number);
+    EXPECT_EQ(expected[i].psnr_value, results[i].psnr_value);
+    EXPECT_EQ(expected[i].ssim_value, results[i].ssim_value);
+  }
+}
+
 }  // namespace test
 }  // namespace webrtc
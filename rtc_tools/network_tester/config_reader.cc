@@ -44,6 +44,12 @@ absl::optional<ConfigReader::Config> ConfigReader::GetNextConfig() {
   config.packet_send_interval_ms = proto_config.packet_send_interval_ms();
   config.packet_size = proto_config.packet_size();
   config.execution_time_ms = proto_config.execution_time_ms();
+  config.num_flows =
+      proto_config.has_num_flows() ? proto_config.num_flows() : 1;
+  config.packets_per_send =
+      proto_config.has_packets_per_send() ? proto_config.packets_per_send() : 1;
+  RTC_DCHECK_GT(config.num_flows, 0);
+  RTC_DCHECK_GT(config.packets_per_send, 0);
   return config;
 #else
   return absl::nullopt;
@@ -36,6 +36,8 @@ class ConfigReader {
     int packet_send_interval_ms;
     int packet_size;
     int execution_time_ms;
+    int num_flows;
+    int packets_per_send;
   };
   explicit ConfigReader(const std::string& config_file_path);
   ~ConfigReader();
@@ -32,7 +32,7 @@ class SendPacketTask : public rtc::QueuedTask {
  private:
   bool Run() override {
     if (packet_sender_->IsSending()) {
-      packet_sender_->SendPacket();
+      packet_sender_->SendPackets();
       target_time_ms_ += packet_sender_->GetSendIntervalMs();
       int64_t delay_ms = std::max(static_cast<int64_t>(0),
                                   target_time_ms_ - rtc::TimeMillis());
@@ -58,8 +58,9 @@ class UpdateTestSettingTask : public rtc::QueuedTask {
   bool Run() override {
     auto config = config_reader_->GetNextConfig();
     if (config) {
-      packet_sender_->UpdateTestSetting((*config).packet_size,
-                                        (*config).packet_send_interval_ms);
+      packet_sender_->UpdateTestSetting(
+          (*config).packet_size, (*config).packet_send_interval_ms,
+          (*config).num_flows, (*config).packets_per_send);
       rtc::TaskQueue::Current()->PostDelayedTask(
           std::unique_ptr<QueuedTask>(this), (*config).execution_time_ms);
       return false;
@@ -78,7 +79,9 @@ PacketSender::PacketSender(TestController* test_controller,
                            const std::string& config_file_path)
     : packet_size_(0),
       send_interval_ms_(0),
-      sequence_number_(0),
+      num_flows_(1),
+      packets_per_send_(1),
+      sequence_numbers_(1, 0),
       sending_(false),
       config_file_path_(config_file_path),
       test_controller_(test_controller),
@@ -111,13 +114,18 @@ bool PacketSender::IsSending() const {
   return sending_;
 }
 
-void PacketSender::SendPacket() {
+void PacketSender::SendPackets() {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&worker_queue_checker_);
   NetworkTesterPacket packet;
   packet.set_type(NetworkTesterPacket::TEST_DATA);
-  packet.set_sequence_number(sequence_number_++);
-  packet.set_send_timestamp(rtc::TimeMicros());
-  test_controller_->SendData(packet, packet_size_);
+  for (int i = 0; i < packets_per_send_; ++i) {
+    for (int flow_id = 0; flow_id < num_flows_; ++flow_id) {
+      packet.set_flow_id(flow_id);
+      packet.set_sequence_number(sequence_numbers_[flow_id]++);
+      packet.set_send_timestamp(rtc::TimeMicros());
+      test_controller_->SendData(packet, packet_size_);
+    }
+  }
 }
 
 int64_t PacketSender::GetSendIntervalMs() const {
@@ -126,10 +134,17 @@ int64_t PacketSender::GetSendIntervalMs() const {
 }
 
 void PacketSender::UpdateTestSetting(size_t packet_size,
-                                     int64_t send_interval_ms) {
+                                     int64_t send_interval_ms,
+                                     int num_flows,
+                                     int packets_per_send) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&worker_queue_checker_);
   send_interval_ms_ = send_interval_ms;
   packet_size_ = packet_size;
+  num_flows_ = num_flows;
+  packets_per_send_ = packets_per_send;
+  // Sequence numbers of existing flows continue across settings.
+  if (sequence_numbers_.size() < static_cast<size_t>(num_flows))
+    sequence_numbers_.resize(num_flows, 0);
 }
 
 }  // namespace webrtc
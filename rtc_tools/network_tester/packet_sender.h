@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/ignore_wundef.h"
@@ -42,16 +43,23 @@ class PacketSender {
   void StopSending();
   bool IsSending() const;
 
-  void SendPacket();
+  // Sends |packets_per_send| packets on each flow, interleaving the flows.
+  void SendPackets();
 
   int64_t GetSendIntervalMs() const;
-  void UpdateTestSetting(size_t packet_size, int64_t send_interval_ms);
+  void UpdateTestSetting(size_t packet_size,
+                         int64_t send_interval_ms,
+                         int num_flows,
+                         int packets_per_send);
 
  private:
   rtc::SequencedTaskChecker worker_queue_checker_;
   size_t packet_size_ RTC_GUARDED_BY(worker_queue_checker_);
   int64_t send_interval_ms_ RTC_GUARDED_BY(worker_queue_checker_);
-  int64_t sequence_number_ RTC_GUARDED_BY(worker_queue_checker_);
+  int num_flows_ RTC_GUARDED_BY(worker_queue_checker_);
+  int packets_per_send_ RTC_GUARDED_BY(worker_queue_checker_);
+  // Next sequence number of each flow used so far.
+  std::vector<int64_t> sequence_numbers_ RTC_GUARDED_BY(worker_queue_checker_);
   bool sending_ RTC_GUARDED_BY(worker_queue_checker_);
   const std::string config_file_path_;
   TestController* const test_controller_;
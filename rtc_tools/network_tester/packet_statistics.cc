@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/network_tester/packet_statistics.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+#include "rtc_base/strings/string_builder.h"
+
+namespace webrtc {
+
+namespace {
+
+// Histograms are kept in units of 100 us, with values below one second in the
+// fixed size part of the histogram.
+constexpr int64_t kHistogramResolutionUs = 100;
+constexpr uint32_t kLongTailBoundary = 10000;
+// Delays are stored relative to the first packet of the flow. This offset
+// leaves room for packets that arrive faster than the first one.
+constexpr int64_t kDelayOffset = kLongTailBoundary;
+
+void AppendPercentiles(const char* name,
+                       uint32_t zero_point,
+                       rtc::HistogramPercentileCounter* histogram,
+                       rtc::SimpleStringBuilder* sb) {
+  *sb << ", " << name << "_ms";
+  for (float fraction : {0.5f, 0.95f, 0.99f, 1.0f}) {
+    absl::optional<uint32_t> value = histogram->GetPercentile(fraction);
+    sb->AppendFormat(" p%d=%.1f", static_cast<int>(fraction * 100),
+                     value ? (*value - zero_point) * kHistogramResolutionUs /
+                                 1000.0
+                           : 0.0);
+  }
+}
+
+}  // namespace
+
+PacketStatistics::FlowStatistics::FlowStatistics()
+    : delay(kLongTailBoundary), jitter(kLongTailBoundary) {}
+
+PacketStatistics::FlowStatistics::~FlowStatistics() = default;
+
+PacketStatistics::PacketStatistics() = default;
+
+PacketStatistics::~PacketStatistics() = default;
+
+void PacketStatistics::OnPacketReceived(int flow_id,
+                                        int64_t sequence_number,
+                                        int64_t send_time_us,
+                                        int64_t arrival_time_us,
+                                        size_t packet_size) {
+  FlowStatistics& flow = flows_[flow_id];
+  ++flow.packets_received;
+  flow.bytes_received += packet_size;
+  if (sequence_number < flow.highest_sequence_number)
+    ++flow.packets_reordered;
+  flow.highest_sequence_number =
+      std::max(flow.highest_sequence_number, sequence_number);
+
+  const int64_t transit_us = arrival_time_us - send_time_us;
+  if (!flow.first_transit_us)
+    flow.first_transit_us = transit_us;
+  const uint32_t delay = static_cast<uint32_t>(std::max<int64_t>(
+      0, (transit_us - *flow.first_transit_us) / kHistogramResolutionUs +
+             kDelayOffset));
+  flow.min_delay =
+      flow.packets_received == 1 ? delay : std::min(flow.min_delay, delay);
+  flow.delay.Add(delay);
+
+  if (flow.last_transit_us) {
+    const int64_t transit_delta_us = std::abs(transit_us - *flow.last_transit_us);
+    flow.jitter_us += (transit_delta_us - flow.jitter_us) / 16.0;
+    flow.jitter.Add(
+        static_cast<uint32_t>(flow.jitter_us / kHistogramResolutionUs));
+  }
+  flow.last_transit_us = transit_us;
+}
+
+std::string PacketStatistics::Summary() {
+  std::string summary;
+  char buffer[512];
+  for (auto& it : flows_) {
+    FlowStatistics& flow = it.second;
+    rtc::SimpleStringBuilder sb(buffer);
+    const int64_t packets_lost =
+        std::max<int64_t>(0, flow.highest_sequence_number + 1 -
+                                 flow.packets_received);
+    sb << "flow " << it.first << ": packets=" << flow.packets_received
+       << ", bytes=" << flow.bytes_received << ", lost=" << packets_lost
+       << ", reordered=" << flow.packets_reordered;
+    AppendPercentiles("delay", flow.min_delay, &flow.delay, &sb);
+    AppendPercentiles("jitter", 0, &flow.jitter, &sb);
+    sb << "\n";
+    summary += sb.str();
+  }
+  return summary;
+}
+
+bool PacketStatistics::WriteSummary(const std::string& file_path) {
+  std::ofstream stream(file_path, std::ios_base::out);
+  if (!stream.is_open())
+    return false;
+  stream << Summary();
+  return stream.good();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_NETWORK_TESTER_PACKET_STATISTICS_H_
+#define RTC_TOOLS_NETWORK_TESTER_PACKET_STATISTICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+
+#include "absl/types/optional.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/numerics/histogram_percentile_counter.h"
+
+namespace webrtc {
+
+// Aggregates received test packets into per flow one-way delay and jitter
+// histograms, so that high packet rate tests don't need to write every packet
+// to disk. Sender and receiver clocks are not synchronized, so the one-way
+// delay is reported relative to the smallest delay observed on the flow.
+// Not thread safe.
+class PacketStatistics {
+ public:
+  PacketStatistics();
+  ~PacketStatistics();
+
+  void OnPacketReceived(int flow_id,
+                        int64_t sequence_number,
+                        int64_t send_time_us,
+                        int64_t arrival_time_us,
+                        size_t packet_size);
+
+  // Returns one line per flow with packet counts and delay and jitter
+  // percentiles in milliseconds.
+  std::string Summary();
+  bool WriteSummary(const std::string& file_path);
+
+ private:
+  struct FlowStatistics {
+    FlowStatistics();
+    ~FlowStatistics();
+
+    int64_t packets_received = 0;
+    int64_t bytes_received = 0;
+    int64_t packets_reordered = 0;
+    int64_t highest_sequence_number = -1;
+    absl::optional<int64_t> first_transit_us;
+    absl::optional<int64_t> last_transit_us;
+    // Smallest value added to |delay|, used as the zero point when reporting.
+    uint32_t min_delay = 0;
+    // Interarrival jitter as defined in RFC 3550, section 6.4.1.
+    double jitter_us = 0;
+    rtc::HistogramPercentileCounter delay;
+    rtc::HistogramPercentileCounter jitter;
+  };
+
+  std::map<int, FlowStatistics> flows_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PacketStatistics);
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_NETWORK_TESTER_PACKET_STATISTICS_H_
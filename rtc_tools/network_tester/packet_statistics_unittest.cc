@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/network_tester/packet_statistics.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(PacketStatisticsTest, ReportsDelayRelativeToMinimumPerFlow) {
+  PacketStatistics statistics;
+  // Arbitrary clock offset between sender and receiver.
+  constexpr int64_t kClockOffsetUs = 123456789;
+  for (int64_t i = 0; i < 100; ++i) {
+    const int64_t send_time_us = i * 1000;
+    // Every tenth packet is delayed by 20 ms, the rest by 10 ms.
+    const int64_t delay_us = i % 10 == 9 ? 20000 : 10000;
+    statistics.OnPacketReceived(0, i, send_time_us,
+                                send_time_us + delay_us + kClockOffsetUs, 100);
+  }
+  statistics.OnPacketReceived(1, 0, 0, kClockOffsetUs, 200);
+  statistics.OnPacketReceived(1, 2, 0, kClockOffsetUs, 200);
+
+  const std::string summary = statistics.Summary();
+  EXPECT_NE(std::string::npos,
+            summary.find("flow 0: packets=100, bytes=10000, lost=0, "
+                         "reordered=0, delay_ms p50=0.0 p95=10.0 p99=10.0 "
+                         "p100=10.0"))
+      << summary;
+  EXPECT_NE(std::string::npos,
+            summary.find("flow 1: packets=2, bytes=400, lost=1, reordered=0"))
+      << summary;
+}
+
+TEST(PacketStatisticsTest, CountsReorderedPackets) {
+  PacketStatistics statistics;
+  statistics.OnPacketReceived(3, 1, 1000, 1000, 100);
+  statistics.OnPacketReceived(3, 0, 0, 1500, 100);
+  EXPECT_NE(std::string::npos,
+            statistics.Summary().find("lost=0, reordered=1"));
+}
+
+}  // namespace webrtc
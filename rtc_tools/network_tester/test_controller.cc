@@ -10,25 +10,32 @@
 
 #include "rtc_tools/network_tester/test_controller.h"
 
+#include <algorithm>
 #include <limits>
+#include <utility>
 
 #include "absl/types/optional.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/ipaddress.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/thread.h"
+#include "rtc_tools/network_tester/config_reader.h"
 
 namespace webrtc {
 
 TestController::TestController(int min_port,
                                int max_port,
                                const std::string& config_file_path,
-                               const std::string& log_file_path)
+                               const std::string& log_file_path,
+                               const std::string& packet_log_file_path)
     : socket_factory_(rtc::ThreadManager::Instance()->WrapCurrentThread()),
       config_file_path_(config_file_path),
-      packet_logger_(log_file_path),
+      log_file_path_(log_file_path),
       local_test_done_(false),
       remote_test_done_(false) {
   RTC_DCHECK_RUN_ON(&test_controller_thread_checker_);
+  if (!packet_log_file_path.empty())
+    packet_logger_.reset(new PacketLogger(packet_log_file_path));
   packet_sender_checker_.Detach();
   send_data_.fill(42);
   udp_socket_ =
@@ -62,7 +69,12 @@ void TestController::SendData(const NetworkTesterPacket& packet,
   packet.SerializeToArray(&send_data_[1], std::numeric_limits<char>::max());
   if (data_size && *data_size > packet_size)
     packet_size = *data_size;
-  udp_socket_->SendTo((const void*)send_data_.data(), packet_size,
+  rtc::AsyncPacketSocket* socket = udp_socket_.get();
+  if (packet.flow_id() > 0 &&
+      static_cast<size_t>(packet.flow_id()) <= flow_sockets_.size()) {
+    socket = flow_sockets_[packet.flow_id() - 1].get();
+  }
+  socket->SendTo((const void*)send_data_.data(), packet_size,
                       remote_address_, rtc::PacketOptions());
 }
 
@@ -98,16 +110,14 @@ void TestController::OnReadPacket(rtc::AsyncPacketSocket* socket,
       packet.set_type(NetworkTesterPacket::TEST_START);
       remote_address_ = remote_addr;
       SendData(packet, absl::nullopt);
-      packet_sender_.reset(new PacketSender(this, config_file_path_));
-      packet_sender_->StartSending();
+      StartPacketSender();
       rtc::CritScope scoped_lock(&local_test_done_lock_);
       local_test_done_ = false;
       remote_test_done_ = false;
       break;
     }
     case NetworkTesterPacket::TEST_START: {
-      packet_sender_.reset(new PacketSender(this, config_file_path_));
-      packet_sender_->StartSending();
+      StartPacketSender();
       rtc::CritScope scoped_lock(&local_test_done_lock_);
       local_test_done_ = false;
       remote_test_done_ = false;
@@ -116,15 +126,44 @@ void TestController::OnReadPacket(rtc::AsyncPacketSocket* socket,
     case NetworkTesterPacket::TEST_DATA: {
       packet.set_arrival_timestamp(packet_time_us);
       packet.set_packet_size(len);
-      packet_logger_.LogPacket(packet);
+      packet_statistics_.OnPacketReceived(
+          packet.flow_id(), packet.sequence_number(), packet.send_timestamp(),
+          packet_time_us, len);
+      if (packet_logger_)
+        packet_logger_->LogPacket(packet);
       break;
     }
     case NetworkTesterPacket::TEST_DONE: {
       remote_test_done_ = true;
+      if (!packet_statistics_.WriteSummary(log_file_path_))
+        RTC_LOG(LS_ERROR) << "Failed to write " << log_file_path_;
       break;
     }
     default: { RTC_NOTREACHED(); }
   }
 }
 
+void TestController::StartPacketSender() {
+  RTC_DCHECK_RUN_ON(&test_controller_thread_checker_);
+  packet_sender_.reset();
+  int num_flows = 1;
+  ConfigReader config_reader(config_file_path_);
+  while (absl::optional<ConfigReader::Config> config =
+             config_reader.GetNextConfig()) {
+    num_flows = std::max(num_flows, config->num_flows);
+  }
+  // Each flow gets its own local port, so that the flows are distinct on the
+  // network path.
+  while (flow_sockets_.size() + 1 < static_cast<size_t>(num_flows)) {
+    std::unique_ptr<rtc::AsyncPacketSocket> socket(
+        socket_factory_.CreateUdpSocket(
+            rtc::SocketAddress(rtc::GetAnyIP(AF_INET), 0), 0, 0));
+    RTC_CHECK(socket);
+    socket->SignalReadPacket.connect(this, &TestController::OnReadPacket);
+    flow_sockets_.push_back(std::move(socket));
+  }
+  packet_sender_.reset(new PacketSender(this, config_file_path_));
+  packet_sender_->StartSending();
+}
+
 }  // namespace webrtc
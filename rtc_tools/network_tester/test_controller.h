@@ -16,6 +16,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "p2p/base/basicpacketsocketfactory.h"
@@ -30,6 +31,7 @@
 #include "rtc_base/thread_checker.h"
 #include "rtc_tools/network_tester/packet_logger.h"
 #include "rtc_tools/network_tester/packet_sender.h"
+#include "rtc_tools/network_tester/packet_statistics.h"
 
 #ifdef WEBRTC_NETWORK_TESTER_PROTO
 RTC_PUSH_IGNORING_WUNDEF()
@@ -47,10 +49,14 @@ constexpr size_t kEthernetMtu = 1500;
 
 class TestController : public sigslot::has_slots<> {
  public:
+  // A summary of the received packets is written to |log_file_path| when the
+  // remote side is done. Every received packet is additionally logged to
+  // |packet_log_file_path| if it is not empty, see parse_packet_log.py.
   TestController(int min_port,
                  int max_port,
                  const std::string& config_file_path,
-                 const std::string& log_file_path);
+                 const std::string& log_file_path,
+                 const std::string& packet_log_file_path = "");
 
   void Run();
 
@@ -69,16 +75,24 @@ class TestController : public sigslot::has_slots<> {
                     size_t len,
                     const rtc::SocketAddress& remote_addr,
                     const int64_t& packet_time_us);
+  // Creates a socket for each flow of the test and starts sending.
+  void StartPacketSender();
+
   rtc::ThreadChecker test_controller_thread_checker_;
   rtc::SequencedTaskChecker packet_sender_checker_;
   rtc::BasicPacketSocketFactory socket_factory_;
   const std::string config_file_path_;
-  PacketLogger packet_logger_;
+  const std::string log_file_path_;
+  std::unique_ptr<PacketLogger> packet_logger_;
+  PacketStatistics packet_statistics_;
   rtc::CriticalSection local_test_done_lock_;
   bool local_test_done_ RTC_GUARDED_BY(local_test_done_lock_);
   bool remote_test_done_;
   std::array<char, kEthernetMtu> send_data_;
   std::unique_ptr<rtc::AsyncPacketSocket> udp_socket_;
+  // Sockets for flows other than the first, which uses |udp_socket_|. Only
+  // changed while no packet sender is running, and outlive |packet_sender_|.
+  std::vector<std::unique_ptr<rtc::AsyncPacketSocket>> flow_sockets_;
   rtc::SocketAddress remote_address_;
   std::unique_ptr<PacketSender> packet_sender_;
 
@@ -14,10 +14,16 @@
 #include <string>
 #include <vector>
 
+#if defined(WEBRTC_POSIX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "absl/strings/match.h"
 #include "absl/types/optional.h"
 #include "api/video/i420_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/refcountedobject.h"
 #include "rtc_base/string_to_number.h"
@@ -28,7 +34,10 @@ namespace test {
 
 namespace {
 
-// Common base class for .yuv and .y4m files.
+// Common base class for .yuv and .y4m files. On POSIX the file is memory
+// mapped, so that frames are copied straight from the page cache and
+// GetFrame() can be called from several threads without serializing on the
+// file position. Elsewhere reads go through |file_| under a lock.
 class VideoFile : public Video {
  public:
   VideoFile(int width,
@@ -38,9 +47,19 @@ class VideoFile : public Video {
       : width_(width),
         height_(height),
         frame_positions_(frame_positions),
-        file_(file) {}
+        file_(file) {
+#if defined(WEBRTC_POSIX)
+    MapFile();
+#endif
+  }
 
-  ~VideoFile() override { fclose(file_); }
+  ~VideoFile() override {
+#if defined(WEBRTC_POSIX)
+    if (mapped_data_)
+      munmap(const_cast<uint8_t*>(mapped_data_), mapped_size_);
+#endif
+    fclose(file_);
+  }
 
   size_t number_of_frames() const override { return frame_positions_.size(); }
   int width() const override { return width_; }
@@ -49,15 +68,29 @@ class VideoFile : public Video {
   rtc::scoped_refptr<I420BufferInterface> GetFrame(
       size_t frame_index) const override {
     RTC_CHECK_LT(frame_index, frame_positions_.size());
+    const int chroma_width = (width_ + 1) / 2;
+    const int chroma_height = (height_ + 1) / 2;
+
+#if defined(WEBRTC_POSIX)
+    if (mapped_data_ &&
+        frame_offsets_[frame_index] + FrameSize() <= mapped_size_) {
+      const uint8_t* data_y = mapped_data_ + frame_offsets_[frame_index];
+      const uint8_t* data_u = data_y + width_ * height_;
+      const uint8_t* data_v = data_u + chroma_width * chroma_height;
+      return I420Buffer::Copy(width_, height_, data_y, width_, data_u,
+                              chroma_width, data_v, chroma_width);
+    }
+#endif
 
+    rtc::CritScope cs(&file_lock_);
     fsetpos(file_, &frame_positions_[frame_index]);
     rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
     fread(reinterpret_cast<char*>(buffer->MutableDataY()), /* size= */ 1,
           width_ * height_, file_);
     fread(reinterpret_cast<char*>(buffer->MutableDataU()), /* size= */ 1,
-          buffer->ChromaWidth() * buffer->ChromaHeight(), file_);
+          chroma_width * chroma_height, file_);
     fread(reinterpret_cast<char*>(buffer->MutableDataV()), /* size= */ 1,
-          buffer->ChromaWidth() * buffer->ChromaHeight(), file_);
+          chroma_width * chroma_height, file_);
 
     if (ferror(file_) != 0) {
       RTC_LOG(LS_ERROR) << "Could not read YUV data for frame " << frame_index;
@@ -67,10 +100,42 @@ class VideoFile : public Video {
   }
 
  private:
+  size_t FrameSize() const {
+    return width_ * height_ + 2 * ((width_ + 1) / 2) * ((height_ + 1) / 2);
+  }
+
+#if defined(WEBRTC_POSIX)
+  void MapFile() {
+    rtc::CritScope cs(&file_lock_);
+    struct stat file_stat;
+    if (fstat(fileno(file_), &file_stat) != 0 || file_stat.st_size <= 0)
+      return;
+    void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE,
+                      fileno(file_), 0);
+    if (data == MAP_FAILED) {
+      RTC_LOG(LS_WARNING) << "Could not map video file, reading it instead";
+      return;
+    }
+    // Frames are usually read in order.
+    madvise(data, file_stat.st_size, MADV_SEQUENTIAL);
+    for (const fpos_t& position : frame_positions_) {
+      fsetpos(file_, &position);
+      frame_offsets_.push_back(ftello(file_));
+    }
+    mapped_data_ = static_cast<const uint8_t*>(data);
+    mapped_size_ = file_stat.st_size;
+  }
+
+  const uint8_t* mapped_data_ = nullptr;
+  size_t mapped_size_ = 0;
+  std::vector<size_t> frame_offsets_;
+#endif
+
   const int width_;
   const int height_;
   const std::vector<fpos_t> frame_positions_;
-  FILE* const file_;
+  rtc::CriticalSection file_lock_;
+  FILE* const file_ RTC_GUARDED_BY(file_lock_);
 };
 
 }  // namespace
@@ -22,8 +22,9 @@
 namespace webrtc {
 namespace test {
 
-// Iterable class representing a sequence of I420 buffers. This class is not
-// thread safe because it is expected to be backed by a file.
+// Iterable class representing a sequence of I420 buffers. The videos returned
+// by the functions below and by the aligners in rtc_tools/frame_analyzer/
+// support calling GetFrame() from several threads at once.
 class Video : public rtc::RefCountInterface {
  public:
   class Iterator {
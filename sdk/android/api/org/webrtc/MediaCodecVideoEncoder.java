@@ -746,6 +746,18 @@ public class MediaCodecVideoEncoder {
         VideoFrameDrawer.drawTexture(drawer, textureBuffer, new Matrix() /* renderMatrix */, width,
             height, 0 /* viewportX */, 0 /* viewportY */, width, height);
         eglBase.swapBuffers(TimeUnit.MICROSECONDS.toNanos(presentationTimestampUs));
+      } else if (buffer instanceof NV21Buffer) {
+        // Convert camera frames straight into the input buffer, without an intermediate I420
+        // buffer.
+        NV21Buffer nv21Buffer = (NV21Buffer) buffer;
+        ByteBuffer inputBuffer = mediaCodec.getInputBuffers()[bufferIndex];
+        if (colorFormat == CodecCapabilities.COLOR_FormatYUV420Planar) {
+          nv21Buffer.copyToI420(inputBuffer);
+        } else {
+          nv21Buffer.copyToNV12(inputBuffer);
+        }
+        int yuvSize = width * height * 3 / 2;
+        mediaCodec.queueInputBuffer(bufferIndex, 0, yuvSize, presentationTimestampUs, 0);
       } else {
         VideoFrame.I420Buffer i420Buffer = buffer.toI420();
         final int chromaHeight = (height + 1) / 2;
@@ -10,6 +10,10 @@
 
 package org.webrtc;
 
+import java.math.BigInteger;
+import java.nio.ByteBuffer;
+import java.nio.charset.Charset;
+import java.util.LinkedHashMap;
 import java.util.Map;
 
 /**
@@ -53,10 +57,137 @@ public class RTCStatsReport {
     return builder.toString();
   }
 
-  // TODO(bugs.webrtc.org/8557) Use ctor directly with full Map type.
-  @SuppressWarnings("unchecked")
+  // Tags of the member value types in the serialized report. They must match MemberTag in
+  // rtcstatscollectorcallbackwrapper.cc.
+  private static final int MEMBER_BOOL = 0;
+  private static final int MEMBER_INT32 = 1;
+  private static final int MEMBER_UINT32 = 2;
+  private static final int MEMBER_INT64 = 3;
+  private static final int MEMBER_UINT64 = 4;
+  private static final int MEMBER_DOUBLE = 5;
+  private static final int MEMBER_STRING = 6;
+  private static final int MEMBER_SEQUENCE_BOOL = 7;
+  private static final int MEMBER_SEQUENCE_INT32 = 8;
+  private static final int MEMBER_SEQUENCE_UINT32 = 9;
+  private static final int MEMBER_SEQUENCE_INT64 = 10;
+  private static final int MEMBER_SEQUENCE_UINT64 = 11;
+  private static final int MEMBER_SEQUENCE_DOUBLE = 12;
+  private static final int MEMBER_SEQUENCE_STRING = 13;
+
+  /**
+   * Creates the report from the serialized form written by the native code, which passes the
+   * whole report in one call instead of creating every stats object and member through JNI.
+   */
   @CalledByNative
-  private static RTCStatsReport create(long timestampUs, Map stats) {
+  private static RTCStatsReport createFromSerialized(byte[] data) {
+    ByteBuffer buffer = ByteBuffer.wrap(data);
+    final long timestampUs = buffer.getLong();
+    final int numStats = buffer.getInt();
+    Map<String, RTCStats> stats = new LinkedHashMap<>();
+    for (int i = 0; i < numStats; ++i) {
+      final String id = readString(buffer);
+      final String type = readString(buffer);
+      final long statsTimestampUs = buffer.getLong();
+      final int numMembers = buffer.getInt();
+      Map<String, Object> members = new LinkedHashMap<>();
+      for (int j = 0; j < numMembers; ++j) {
+        final String name = readString(buffer);
+        members.put(name, readMember(buffer));
+      }
+      stats.put(id, new RTCStats(statsTimestampUs, type, id, members));
+    }
     return new RTCStatsReport(timestampUs, stats);
   }
+
+  private static String readString(ByteBuffer buffer) {
+    byte[] bytes = new byte[buffer.getInt()];
+    buffer.get(bytes);
+    return new String(bytes, Charset.forName("UTF-8"));
+  }
+
+  private static BigInteger readUint64(ByteBuffer buffer) {
+    final long value = buffer.getLong();
+    BigInteger result = BigInteger.valueOf(value & Long.MAX_VALUE);
+    return value < 0 ? result.setBit(Long.SIZE - 1) : result;
+  }
+
+  // Values have the same types as RTCStats.getMembers() documents.
+  private static Object readMember(ByteBuffer buffer) {
+    final int tag = buffer.get();
+    switch (tag) {
+      case MEMBER_BOOL:
+        return buffer.get() != 0;
+      case MEMBER_INT32:
+        return buffer.getInt();
+      case MEMBER_UINT32:
+        return buffer.getInt() & 0xFFFFFFFFL;
+      case MEMBER_INT64:
+        return buffer.getLong();
+      case MEMBER_UINT64:
+        return readUint64(buffer);
+      case MEMBER_DOUBLE:
+        return buffer.getDouble();
+      case MEMBER_STRING:
+        return readString(buffer);
+      default:
+        return readSequence(tag, buffer);
+    }
+  }
+
+  private static Object[] readSequence(int tag, ByteBuffer buffer) {
+    final int length = buffer.getInt();
+    switch (tag) {
+      case MEMBER_SEQUENCE_BOOL: {
+        Boolean[] sequence = new Boolean[length];
+        for (int i = 0; i < length; ++i) {
+          sequence[i] = buffer.get() != 0;
+        }
+        return sequence;
+      }
+      case MEMBER_SEQUENCE_INT32: {
+        Integer[] sequence = new Integer[length];
+        for (int i = 0; i < length; ++i) {
+          sequence[i] = buffer.getInt();
+        }
+        return sequence;
+      }
+      case MEMBER_SEQUENCE_UINT32: {
+        Long[] sequence = new Long[length];
+        for (int i = 0; i < length; ++i) {
+          sequence[i] = buffer.getInt() & 0xFFFFFFFFL;
+        }
+        return sequence;
+      }
+      case MEMBER_SEQUENCE_INT64: {
+        Long[] sequence = new Long[length];
+        for (int i = 0; i < length; ++i) {
+          sequence[i] = buffer.getLong();
+        }
+        return sequence;
+      }
+      case MEMBER_SEQUENCE_UINT64: {
+        BigInteger[] sequence = new BigInteger[length];
+        for (int i = 0; i < length; ++i) {
+          sequence[i] = readUint64(buffer);
+        }
+        return sequence;
+      }
+      case MEMBER_SEQUENCE_DOUBLE: {
+        Double[] sequence = new Double[length];
+        for (int i = 0; i < length; ++i) {
+          sequence[i] = buffer.getDouble();
+        }
+        return sequence;
+      }
+      case MEMBER_SEQUENCE_STRING: {
+        String[] sequence = new String[length];
+        for (int i = 0; i < length; ++i) {
+          sequence[i] = readString(buffer);
+        }
+        return sequence;
+      }
+      default:
+        throw new IllegalArgumentException("Unknown stats member type: " + tag);
+    }
+  }
 }
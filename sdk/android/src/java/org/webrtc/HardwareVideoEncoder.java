@@ -589,6 +589,10 @@ class HardwareVideoEncoder implements VideoEncoder {
     I420 {
       @Override
       void fillBuffer(ByteBuffer dstBuffer, VideoFrame.Buffer srcBuffer) {
+        if (srcBuffer instanceof NV21Buffer) {
+          ((NV21Buffer) srcBuffer).copyToI420(dstBuffer);
+          return;
+        }
         VideoFrame.I420Buffer i420 = srcBuffer.toI420();
         YuvHelper.I420Copy(i420.getDataY(), i420.getStrideY(), i420.getDataU(), i420.getStrideU(),
             i420.getDataV(), i420.getStrideV(), dstBuffer, i420.getWidth(), i420.getHeight());
@@ -598,6 +602,10 @@ class HardwareVideoEncoder implements VideoEncoder {
     NV12 {
       @Override
       void fillBuffer(ByteBuffer dstBuffer, VideoFrame.Buffer srcBuffer) {
+        if (srcBuffer instanceof NV21Buffer) {
+          ((NV21Buffer) srcBuffer).copyToNV12(dstBuffer);
+          return;
+        }
         VideoFrame.I420Buffer i420 = srcBuffer.toI420();
         YuvHelper.I420ToNV12(i420.getDataY(), i420.getStrideY(), i420.getDataU(), i420.getStrideU(),
             i420.getDataV(), i420.getStrideV(), dstBuffer, i420.getWidth(), i420.getHeight());
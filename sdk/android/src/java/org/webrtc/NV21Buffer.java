@@ -64,7 +64,40 @@ public class NV21Buffer implements VideoFrame.Buffer {
     return newBuffer;
   }
 
+  /**
+   * Writes the frame to |dst| as tightly packed I420, like YuvHelper.I420Copy() does for the result
+   * of toI420(), but without the intermediate I420 buffer. |dst| must be a direct byte buffer.
+   */
+  void copyToI420(ByteBuffer dst) {
+    checkCapacity(dst);
+    nativeCopyToI420(data, width, height, dst);
+  }
+
+  /**
+   * Writes the frame to |dst| as tightly packed NV12, like YuvHelper.I420ToNV12() does for the
+   * result of toI420(), but without the intermediate I420 buffer. |dst| must be a direct byte
+   * buffer.
+   */
+  void copyToNV12(ByteBuffer dst) {
+    checkCapacity(dst);
+    nativeCopyToNV12(data, width, height, dst);
+  }
+
+  private void checkCapacity(ByteBuffer dst) {
+    final int chromaWidth = (width + 1) / 2;
+    final int chromaHeight = (height + 1) / 2;
+    final int minSize = width * height + chromaWidth * chromaHeight * 2;
+    if (dst.capacity() < minSize) {
+      throw new IllegalArgumentException("Expected destination buffer capacity to be at least "
+          + minSize + " was " + dst.capacity());
+    }
+  }
+
   private static native void nativeCropAndScale(int cropX, int cropY, int cropWidth, int cropHeight,
       int scaleWidth, int scaleHeight, byte[] src, int srcWidth, int srcHeight, ByteBuffer dstY,
       int dstStrideY, ByteBuffer dstU, int dstStrideU, ByteBuffer dstV, int dstStrideV);
+  private static native void nativeCopyToI420(
+      byte[] src, int srcWidth, int srcHeight, ByteBuffer dst);
+  private static native void nativeCopyToNV12(
+      byte[] src, int srcWidth, int srcHeight, ByteBuffer dst);
 }
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "third_party/libyuv/include/libyuv/convert.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
 
 #include "common_video/libyuv/include/webrtc_libyuv.h"
@@ -68,5 +69,63 @@ static void JNI_NV21Buffer_CropAndScale(JNIEnv* jni,
   jni->ReleaseByteArrayElements(j_src.obj(), src_bytes, JNI_ABORT);
 }
 
+static void JNI_NV21Buffer_CopyToI420(JNIEnv* jni,
+                                      const JavaParamRef<jbyteArray>& j_src,
+                                      jint src_width,
+                                      jint src_height,
+                                      const JavaParamRef<jobject>& j_dst) {
+  const int chroma_width = (src_width + 1) / 2;
+  const int chroma_height = (src_height + 1) / 2;
+
+  jboolean was_copy;
+  jbyte* src_bytes = jni->GetByteArrayElements(j_src.obj(), &was_copy);
+  RTC_DCHECK(!was_copy);
+  uint8_t const* src_y = reinterpret_cast<uint8_t const*>(src_bytes);
+  uint8_t const* src_vu = src_y + src_height * src_width;
+
+  uint8_t* dst_y =
+      static_cast<uint8_t*>(jni->GetDirectBufferAddress(j_dst.obj()));
+  uint8_t* dst_u = dst_y + src_height * src_width;
+  uint8_t* dst_v = dst_u + chroma_height * chroma_width;
+
+  libyuv::NV21ToI420(src_y, src_width, src_vu, src_width, dst_y, src_width,
+                     dst_u, chroma_width, dst_v, chroma_width, src_width,
+                     src_height);
+
+  jni->ReleaseByteArrayElements(j_src.obj(), src_bytes, JNI_ABORT);
+}
+
+static void JNI_NV21Buffer_CopyToNV12(JNIEnv* jni,
+                                      const JavaParamRef<jbyteArray>& j_src,
+                                      jint src_width,
+                                      jint src_height,
+                                      const JavaParamRef<jobject>& j_dst) {
+  const int chroma_width = (src_width + 1) / 2;
+  const int chroma_height = (src_height + 1) / 2;
+
+  jboolean was_copy;
+  jbyte* src_bytes = jni->GetByteArrayElements(j_src.obj(), &was_copy);
+  RTC_DCHECK(!was_copy);
+  uint8_t const* src_y = reinterpret_cast<uint8_t const*>(src_bytes);
+  uint8_t const* src_vu = src_y + src_height * src_width;
+
+  uint8_t* dst_y =
+      static_cast<uint8_t*>(jni->GetDirectBufferAddress(j_dst.obj()));
+  uint8_t* dst_uv = dst_y + src_height * src_width;
+
+  libyuv::CopyPlane(src_y, src_width, dst_y, src_width, src_width, src_height);
+  // NV12 only differs from NV21 in the order of U and V.
+  for (int y = 0; y < chroma_height; ++y) {
+    uint8_t const* src_row = src_vu + y * src_width;
+    uint8_t* dst_row = dst_uv + y * 2 * chroma_width;
+    for (int x = 0; x < 2 * chroma_width; x += 2) {
+      dst_row[x] = src_row[x + 1];
+      dst_row[x + 1] = src_row[x];
+    }
+  }
+
+  jni->ReleaseByteArrayElements(j_src.obj(), src_bytes, JNI_ABORT);
+}
+
 }  // namespace jni
 }  // namespace webrtc
@@ -10,14 +10,14 @@
 
 #include "sdk/android/src/jni/pc/rtcstatscollectorcallbackwrapper.h"
 
+#include <string.h>
 #include <string>
 #include <vector>
 
-#include "rtc_base/stringencode.h"
-#include "sdk/android/generated_external_classes_jni/jni/BigInteger_jni.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/checks.h"
 #include "sdk/android/generated_peerconnection_jni/jni/RTCStatsCollectorCallback_jni.h"
 #include "sdk/android/generated_peerconnection_jni/jni/RTCStatsReport_jni.h"
-#include "sdk/android/generated_peerconnection_jni/jni/RTCStats_jni.h"
 #include "sdk/android/native_api/jni/java_types.h"
 
 namespace webrtc {
@@ -25,103 +25,194 @@ namespace jni {
 
 namespace {
 
-ScopedJavaLocalRef<jobject> NativeToJavaBigInteger(JNIEnv* env, uint64_t u) {
-  return JNI_BigInteger::Java_BigInteger_ConstructorJMBI_JLS(
-      env, NativeToJavaString(env, rtc::ToString(u)));
+// Tags of the member value types in the serialized report. They must match
+// the constants in RTCStatsReport.java.
+enum class MemberTag : uint8_t {
+  kBool = 0,
+  kInt32 = 1,
+  kUint32 = 2,
+  kInt64 = 3,
+  kUint64 = 4,
+  kDouble = 5,
+  kString = 6,
+  kSequenceBool = 7,
+  kSequenceInt32 = 8,
+  kSequenceUint32 = 9,
+  kSequenceInt64 = 10,
+  kSequenceUint64 = 11,
+  kSequenceDouble = 12,
+  kSequenceString = 13,
+};
+
+void WriteString(rtc::ByteBufferWriter* writer, const std::string& str) {
+  writer->WriteUInt32(static_cast<uint32_t>(str.size()));
+  writer->WriteString(str);
 }
 
-ScopedJavaLocalRef<jobjectArray> NativeToJavaBigIntegerArray(
-    JNIEnv* env,
-    const std::vector<uint64_t>& container) {
-  return NativeToJavaObjectArray(
-      env, container, java_math_BigInteger_clazz(env), &NativeToJavaBigInteger);
+void WriteDouble(rtc::ByteBufferWriter* writer, double value) {
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(value), "");
+  memcpy(&bits, &value, sizeof(bits));
+  writer->WriteUInt64(bits);
 }
 
-ScopedJavaLocalRef<jobject> MemberToJava(
-    JNIEnv* env,
-    const RTCStatsMemberInterface& member) {
+template <typename T, typename Write>
+void WriteSequence(rtc::ByteBufferWriter* writer,
+                   const std::vector<T>& sequence,
+                   Write write) {
+  writer->WriteUInt32(static_cast<uint32_t>(sequence.size()));
+  for (const T& element : sequence)
+    write(writer, element);
+}
+
+void WriteBool(rtc::ByteBufferWriter* writer, bool value) {
+  writer->WriteUInt8(value ? 1 : 0);
+}
+
+void WriteInt32(rtc::ByteBufferWriter* writer, int32_t value) {
+  writer->WriteUInt32(static_cast<uint32_t>(value));
+}
+
+void WriteUint32(rtc::ByteBufferWriter* writer, uint32_t value) {
+  writer->WriteUInt32(value);
+}
+
+void WriteInt64(rtc::ByteBufferWriter* writer, int64_t value) {
+  writer->WriteUInt64(static_cast<uint64_t>(value));
+}
+
+void WriteUint64(rtc::ByteBufferWriter* writer, uint64_t value) {
+  writer->WriteUInt64(value);
+}
+
+void WriteMember(rtc::ByteBufferWriter* writer,
+                 const RTCStatsMemberInterface& member) {
+  WriteString(writer, member.name());
   switch (member.type()) {
     case RTCStatsMemberInterface::kBool:
-      return NativeToJavaBoolean(env, *member.cast_to<RTCStatsMember<bool>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kBool));
+      WriteBool(writer, *member.cast_to<RTCStatsMember<bool>>());
+      return;
 
     case RTCStatsMemberInterface::kInt32:
-      return NativeToJavaInteger(env,
-                                 *member.cast_to<RTCStatsMember<int32_t>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kInt32));
+      WriteInt32(writer, *member.cast_to<RTCStatsMember<int32_t>>());
+      return;
 
     case RTCStatsMemberInterface::kUint32:
-      return NativeToJavaLong(env, *member.cast_to<RTCStatsMember<uint32_t>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kUint32));
+      WriteUint32(writer, *member.cast_to<RTCStatsMember<uint32_t>>());
+      return;
 
     case RTCStatsMemberInterface::kInt64:
-      return NativeToJavaLong(env, *member.cast_to<RTCStatsMember<int64_t>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kInt64));
+      WriteInt64(writer, *member.cast_to<RTCStatsMember<int64_t>>());
+      return;
 
     case RTCStatsMemberInterface::kUint64:
-      return NativeToJavaBigInteger(
-          env, *member.cast_to<RTCStatsMember<uint64_t>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kUint64));
+      WriteUint64(writer, *member.cast_to<RTCStatsMember<uint64_t>>());
+      return;
 
     case RTCStatsMemberInterface::kDouble:
-      return NativeToJavaDouble(env, *member.cast_to<RTCStatsMember<double>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kDouble));
+      WriteDouble(writer, *member.cast_to<RTCStatsMember<double>>());
+      return;
 
     case RTCStatsMemberInterface::kString:
-      return NativeToJavaString(env,
-                                *member.cast_to<RTCStatsMember<std::string>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kString));
+      WriteString(writer, *member.cast_to<RTCStatsMember<std::string>>());
+      return;
 
     case RTCStatsMemberInterface::kSequenceBool:
-      return NativeToJavaBooleanArray(
-          env, *member.cast_to<RTCStatsMember<std::vector<bool>>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kSequenceBool));
+      WriteSequence(writer,
+                    *member.cast_to<RTCStatsMember<std::vector<bool>>>(),
+                    &WriteBool);
+      return;
 
     case RTCStatsMemberInterface::kSequenceInt32:
-      return NativeToJavaIntegerArray(
-          env, *member.cast_to<RTCStatsMember<std::vector<int32_t>>>());
-
-    case RTCStatsMemberInterface::kSequenceUint32: {
-      const std::vector<uint32_t>& v =
-          *member.cast_to<RTCStatsMember<std::vector<uint32_t>>>();
-      return NativeToJavaLongArray(env,
-                                   std::vector<int64_t>(v.begin(), v.end()));
-    }
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kSequenceInt32));
+      WriteSequence(writer,
+                    *member.cast_to<RTCStatsMember<std::vector<int32_t>>>(),
+                    &WriteInt32);
+      return;
+
+    case RTCStatsMemberInterface::kSequenceUint32:
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kSequenceUint32));
+      WriteSequence(writer,
+                    *member.cast_to<RTCStatsMember<std::vector<uint32_t>>>(),
+                    &WriteUint32);
+      return;
+
     case RTCStatsMemberInterface::kSequenceInt64:
-      return NativeToJavaLongArray(
-          env, *member.cast_to<RTCStatsMember<std::vector<int64_t>>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kSequenceInt64));
+      WriteSequence(writer,
+                    *member.cast_to<RTCStatsMember<std::vector<int64_t>>>(),
+                    &WriteInt64);
+      return;
 
     case RTCStatsMemberInterface::kSequenceUint64:
-      return NativeToJavaBigIntegerArray(
-          env, *member.cast_to<RTCStatsMember<std::vector<uint64_t>>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kSequenceUint64));
+      WriteSequence(writer,
+                    *member.cast_to<RTCStatsMember<std::vector<uint64_t>>>(),
+                    &WriteUint64);
+      return;
 
     case RTCStatsMemberInterface::kSequenceDouble:
-      return NativeToJavaDoubleArray(
-          env, *member.cast_to<RTCStatsMember<std::vector<double>>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kSequenceDouble));
+      WriteSequence(writer,
+                    *member.cast_to<RTCStatsMember<std::vector<double>>>(),
+                    &WriteDouble);
+      return;
 
     case RTCStatsMemberInterface::kSequenceString:
-      return NativeToJavaStringArray(
-          env, *member.cast_to<RTCStatsMember<std::vector<std::string>>>());
+      writer->WriteUInt8(static_cast<uint8_t>(MemberTag::kSequenceString));
+      WriteSequence(
+          writer, *member.cast_to<RTCStatsMember<std::vector<std::string>>>(),
+          &WriteString);
+      return;
   }
   RTC_NOTREACHED();
-  return nullptr;
 }
 
-ScopedJavaLocalRef<jobject> NativeToJavaRtcStats(JNIEnv* env,
-                                                 const RTCStats& stats) {
-  JavaMapBuilder builder(env);
-  for (auto* const member : stats.Members()) {
-    if (!member->is_defined())
-      continue;
-    builder.put(NativeToJavaString(env, member->name()),
-                MemberToJava(env, *member));
-  }
-  return Java_RTCStats_create(
-      env, stats.timestamp_us(), NativeToJavaString(env, stats.type()),
-      NativeToJavaString(env, stats.id()), builder.GetJavaMap());
-}
-
-ScopedJavaLocalRef<jobject> NativeToJavaRtcStatsReport(
+// Serializes the report, so that it can be passed to Java in a single call
+// instead of creating each stats object and member through JNI. The layout,
+// in network byte order, is
+//   report: int64 timestamp_us, uint32 number of stats, stats...
+//   stats: string id, string type, int64 timestamp_us,
+//          uint32 number of members, members...
+//   member: string name, uint8 MemberTag, value.
+// Strings are a uint32 length followed by the UTF-8 bytes, doubles are their
+// IEEE 754 bits and sequences are a uint32 length followed by the elements.
+ScopedJavaLocalRef<jbyteArray> SerializeRtcStatsReport(
     JNIEnv* env,
     const rtc::scoped_refptr<const RTCStatsReport>& report) {
-  ScopedJavaLocalRef<jobject> j_stats_map =
-      NativeToJavaMap(env, *report, [](JNIEnv* env, const RTCStats& stats) {
-        return std::make_pair(NativeToJavaString(env, stats.id()),
-                              NativeToJavaRtcStats(env, stats));
-      });
-  return Java_RTCStatsReport_create(env, report->timestamp_us(), j_stats_map);
+  rtc::ByteBufferWriter writer;
+  writer.WriteUInt64(static_cast<uint64_t>(report->timestamp_us()));
+  writer.WriteUInt32(static_cast<uint32_t>(report->size()));
+  for (const RTCStats& stats : *report) {
+    WriteString(&writer, stats.id());
+    WriteString(&writer, stats.type());
+    writer.WriteUInt64(static_cast<uint64_t>(stats.timestamp_us()));
+    std::vector<const RTCStatsMemberInterface*> members = stats.Members();
+    uint32_t num_defined_members = 0;
+    for (const auto* member : members) {
+      if (member->is_defined())
+        ++num_defined_members;
+    }
+    writer.WriteUInt32(num_defined_members);
+    for (const auto* member : members) {
+      if (member->is_defined())
+        WriteMember(&writer, *member);
+    }
+  }
+
+  ScopedJavaLocalRef<jbyteArray> j_report(
+      env, env->NewByteArray(writer.Length()));
+  env->SetByteArrayRegion(j_report.obj(), 0, writer.Length(),
+                          reinterpret_cast<const jbyte*>(writer.Data()));
+  return j_report;
 }
 
 }  // namespace
@@ -137,7 +228,9 @@ void RTCStatsCollectorCallbackWrapper::OnStatsDelivered(
     const rtc::scoped_refptr<const RTCStatsReport>& report) {
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
   Java_RTCStatsCollectorCallback_onStatsDelivered(
-      jni, j_callback_global_, NativeToJavaRtcStatsReport(jni, report));
+      jni, j_callback_global_,
+      Java_RTCStatsReport_createFromSerialized(
+          jni, SerializeRtcStatsReport(jni, report)));
 }
 
 }  // namespace jni
@@ -673,4 +673,71 @@ RTCTransportStats::RTCTransportStats(const RTCTransportStats& other)
 
 RTCTransportStats::~RTCTransportStats() {}
 
+// clang-format off
+WEBRTC_RTCSTATS_IMPL(RTCThreadStats, RTCStats, "thread",
+    &name,
+    &tasks_run,
+    &total_busy_time,
+    &total_queue_wait_time,
+    &max_task_duration);
+// clang-format on
+
+RTCThreadStats::RTCThreadStats(const std::string& id, int64_t timestamp_us)
+    : RTCThreadStats(std::string(id), timestamp_us) {}
+
+RTCThreadStats::RTCThreadStats(std::string&& id, int64_t timestamp_us)
+    : RTCStats(std::move(id), timestamp_us),
+      name("name"),
+      tasks_run("tasksRun"),
+      total_busy_time("totalBusyTime"),
+      total_queue_wait_time("totalQueueWaitTime"),
+      max_task_duration("maxTaskDuration") {}
+
+RTCThreadStats::RTCThreadStats(const RTCThreadStats& other)
+    : RTCStats(other.id(), other.timestamp_us()),
+      name(other.name),
+      tasks_run(other.tasks_run),
+      total_busy_time(other.total_busy_time),
+      total_queue_wait_time(other.total_queue_wait_time),
+      max_task_duration(other.max_task_duration) {}
+
+RTCThreadStats::~RTCThreadStats() {}
+
+// clang-format off
+WEBRTC_RTCSTATS_IMPL(RTCCallSetupStats, RTCStats, "call-setup",
+    &create_offer_time,
+    &create_answer_time,
+    &set_local_description_time,
+    &set_remote_description_time,
+    &ice_gathering_complete_time,
+    &ice_connected_time,
+    &connected_time);
+// clang-format on
+
+RTCCallSetupStats::RTCCallSetupStats(const std::string& id,
+                                     int64_t timestamp_us)
+    : RTCCallSetupStats(std::string(id), timestamp_us) {}
+
+RTCCallSetupStats::RTCCallSetupStats(std::string&& id, int64_t timestamp_us)
+    : RTCStats(std::move(id), timestamp_us),
+      create_offer_time("createOfferTime"),
+      create_answer_time("createAnswerTime"),
+      set_local_description_time("setLocalDescriptionTime"),
+      set_remote_description_time("setRemoteDescriptionTime"),
+      ice_gathering_complete_time("iceGatheringCompleteTime"),
+      ice_connected_time("iceConnectedTime"),
+      connected_time("connectedTime") {}
+
+RTCCallSetupStats::RTCCallSetupStats(const RTCCallSetupStats& other)
+    : RTCStats(other.id(), other.timestamp_us()),
+      create_offer_time(other.create_offer_time),
+      create_answer_time(other.create_answer_time),
+      set_local_description_time(other.set_local_description_time),
+      set_remote_description_time(other.set_remote_description_time),
+      ice_gathering_complete_time(other.ice_gathering_complete_time),
+      ice_connected_time(other.ice_connected_time),
+      connected_time(other.connected_time) {}
+
+RTCCallSetupStats::~RTCCallSetupStats() {}
+
 }  // namespace webrtc
@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtcstatsbinarywriter.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+void WriteUnsigned(uint64_t value, std::string* output) {
+  while (value >= 0x80) {
+    output->push_back(static_cast<char>(0x80 | (value & 0x7f)));
+    value >>= 7;
+  }
+  output->push_back(static_cast<char>(value));
+}
+
+void WriteSigned(int64_t value, std::string* output) {
+  // Zigzag encoding maps small negative and positive values to small unsigned
+  // values: 0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+  WriteUnsigned((static_cast<uint64_t>(value) << 1) ^
+                    static_cast<uint64_t>(value >> 63),
+                output);
+}
+
+void WriteDouble(double value, std::string* output) {
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(value), "");
+  memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i)
+    output->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+}
+
+template <typename T>
+const T& ValueOf(const RTCStatsMemberInterface& member) {
+  return *member.cast_to<RTCStatsMember<T>>();
+}
+
+}  // namespace
+
+RTCStatsBinaryWriter::RTCStatsBinaryWriter() = default;
+
+RTCStatsBinaryWriter::~RTCStatsBinaryWriter() = default;
+
+void RTCStatsBinaryWriter::WriteReport(const RTCStatsReport& report,
+                                       std::string* output) {
+  RTC_DCHECK(output);
+  RTC_DCHECK(new_strings_.empty());
+  RTC_DCHECK(body_.empty());
+  WriteUnsigned(report.size(), &body_);
+  for (const RTCStats& stats : report)
+    WriteStats(stats, report.timestamp_us());
+
+  WriteSigned(report.timestamp_us(), output);
+  WriteUnsigned(new_strings_.size(), output);
+  for (const std::string* value : new_strings_) {
+    WriteUnsigned(value->size(), output);
+    output->append(*value);
+  }
+  output->append(body_);
+  new_strings_.clear();
+  body_.clear();
+}
+
+void RTCStatsBinaryWriter::WriteStats(const RTCStats& stats,
+                                      int64_t report_timestamp_us) {
+  WriteString(stats.type());
+  WriteString(stats.id());
+  WriteSigned(stats.timestamp_us() - report_timestamp_us, &body_);
+  std::vector<const RTCStatsMemberInterface*> members = stats.Members();
+  size_t num_defined = 0;
+  for (const RTCStatsMemberInterface* member : members) {
+    if (member->is_defined())
+      ++num_defined;
+  }
+  WriteUnsigned(num_defined, &body_);
+  for (const RTCStatsMemberInterface* member : members) {
+    if (member->is_defined())
+      WriteMember(*member);
+  }
+}
+
+void RTCStatsBinaryWriter::WriteMember(const RTCStatsMemberInterface& member) {
+  WriteString(member.name());
+  body_.push_back(static_cast<char>(member.type()));
+  switch (member.type()) {
+    case RTCStatsMemberInterface::kBool:
+      body_.push_back(ValueOf<bool>(member) ? 1 : 0);
+      break;
+    case RTCStatsMemberInterface::kInt32:
+      WriteSigned(ValueOf<int32_t>(member), &body_);
+      break;
+    case RTCStatsMemberInterface::kUint32:
+      WriteUnsigned(ValueOf<uint32_t>(member), &body_);
+      break;
+    case RTCStatsMemberInterface::kInt64:
+      WriteSigned(ValueOf<int64_t>(member), &body_);
+      break;
+    case RTCStatsMemberInterface::kUint64:
+      WriteUnsigned(ValueOf<uint64_t>(member), &body_);
+      break;
+    case RTCStatsMemberInterface::kDouble:
+      WriteDouble(ValueOf<double>(member), &body_);
+      break;
+    case RTCStatsMemberInterface::kString:
+      WriteString(ValueOf<std::string>(member));
+      break;
+    case RTCStatsMemberInterface::kSequenceBool: {
+      const std::vector<bool>& values = ValueOf<std::vector<bool>>(member);
+      WriteUnsigned(values.size(), &body_);
+      for (bool value : values)
+        body_.push_back(value ? 1 : 0);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceInt32: {
+      const auto& values = ValueOf<std::vector<int32_t>>(member);
+      WriteUnsigned(values.size(), &body_);
+      for (int32_t value : values)
+        WriteSigned(value, &body_);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceUint32: {
+      const auto& values = ValueOf<std::vector<uint32_t>>(member);
+      WriteUnsigned(values.size(), &body_);
+      for (uint32_t value : values)
+        WriteUnsigned(value, &body_);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceInt64: {
+      const auto& values = ValueOf<std::vector<int64_t>>(member);
+      WriteUnsigned(values.size(), &body_);
+      for (int64_t value : values)
+        WriteSigned(value, &body_);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceUint64: {
+      const auto& values = ValueOf<std::vector<uint64_t>>(member);
+      WriteUnsigned(values.size(), &body_);
+      for (uint64_t value : values)
+        WriteUnsigned(value, &body_);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceDouble: {
+      const auto& values = ValueOf<std::vector<double>>(member);
+      WriteUnsigned(values.size(), &body_);
+      for (double value : values)
+        WriteDouble(value, &body_);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceString: {
+      const auto& values = ValueOf<std::vector<std::string>>(member);
+      WriteUnsigned(values.size(), &body_);
+      for (const std::string& value : values)
+        WriteString(value);
+      break;
+    }
+  }
+}
+
+void RTCStatsBinaryWriter::WriteString(const std::string& value) {
+  auto it = strings_.find(value);
+  if (it == strings_.end()) {
+    it = strings_.insert(std::make_pair(value, strings_.size())).first;
+    new_strings_.push_back(&it->first);
+  }
+  WriteUnsigned(it->second, &body_);
+}
+
+}  // namespace webrtc
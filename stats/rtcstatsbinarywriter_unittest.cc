@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtcstatsbinarywriter.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+class RTCBinaryTestStats : public RTCStats {
+ public:
+  WEBRTC_RTCSTATS_DECL();
+
+  RTCBinaryTestStats(const std::string& id, int64_t timestamp_us)
+      : RTCStats(id, timestamp_us),
+        integer("integer"),
+        string("string"),
+        numbers("numbers") {}
+
+  RTCStatsMember<int32_t> integer;
+  RTCStatsMember<std::string> string;
+  RTCStatsMember<std::vector<double>> numbers;
+};
+
+WEBRTC_RTCSTATS_IMPL(RTCBinaryTestStats,
+                     RTCStats,
+                     "binary",
+                     &integer,
+                     &string,
+                     &numbers);
+
+TEST(RTCStatsBinaryWriterTest, WritesReport) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(200);
+  std::unique_ptr<RTCBinaryTestStats> stats(new RTCBinaryTestStats("a", 199));
+  stats->integer = -2;
+  stats->string = "a";
+  report->AddStats(std::move(stats));
+
+  RTCStatsBinaryWriter writer;
+  std::string output;
+  writer.WriteReport(*report, &output);
+  const std::string expected(
+      "\x90\x03"             // Timestamp 200.
+      "\x04"                 // 4 new strings:
+      "\x06" "binary"        // 0
+      "\x01" "a"             // 1
+      "\x07" "integer"       // 2
+      "\x06" "string"        // 3
+      "\x01"                 // 1 stats object:
+      "\x00\x01\x01"         // type 0, id 1, timestamp -1
+      "\x02"                 // 2 members:
+      "\x02\x01\x03"         // "integer", kInt32, -2
+      "\x03\x06\x01",        // "string", kString, "a"
+      38);
+  EXPECT_EQ(expected, output);
+  EXPECT_EQ(4u, writer.num_strings());
+}
+
+TEST(RTCStatsBinaryWriterTest, WritesStringsOnce) {
+  RTCStatsBinaryWriter writer;
+  std::string first;
+  std::string second;
+  for (std::string* output : {&first, &second}) {
+    rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(0);
+    std::unique_ptr<RTCBinaryTestStats> stats(
+        new RTCBinaryTestStats("stats", 0));
+    stats->string = "value";
+    stats->numbers = std::vector<double>{1.0, 2.0};
+    report->AddStats(std::move(stats));
+    writer.WriteReport(*report, output);
+  }
+  // The second chunk has no new strings, and the stats are the same as in the
+  // first chunk.
+  const std::string body = second.substr(2);
+  EXPECT_EQ(std::string("\x00\x00", 2), second.substr(0, 2));
+  ASSERT_LT(body.size(), first.size());
+  EXPECT_EQ(body, first.substr(first.size() - body.size()));
+  EXPECT_EQ(5u, writer.num_strings());
+}
+
+}  // namespace webrtc
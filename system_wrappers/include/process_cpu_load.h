@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef SYSTEM_WRAPPERS_INCLUDE_PROCESS_CPU_LOAD_H_
+#define SYSTEM_WRAPPERS_INCLUDE_PROCESS_CPU_LOAD_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Measures the CPU load of the current process, as the fraction of the
+// capacity of all cores that it uses. The load is sampled lazily by the first
+// caller of GetLoad() after each update interval, so that many streams can
+// poll it cheaply without a thread of its own.
+class ProcessCpuLoad {
+ public:
+  // Returns the instance shared by the process, which updates once a second.
+  static ProcessCpuLoad* Get();
+
+  explicit ProcessCpuLoad(int64_t update_interval_ms);
+  ~ProcessCpuLoad();
+
+  // Returns the load over the last complete update interval, or nullopt until
+  // the first interval has completed.
+  absl::optional<float> GetLoad();
+
+ private:
+  const int64_t update_interval_ns_;
+  const int num_cores_;
+  rtc::CriticalSection crit_;
+  absl::optional<int64_t> last_sample_time_ns_ RTC_GUARDED_BY(crit_);
+  int64_t last_sample_cpu_time_ns_ RTC_GUARDED_BY(crit_) = 0;
+  absl::optional<float> load_ RTC_GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ProcessCpuLoad);
+};
+
+}  // namespace webrtc
+
+#endif  // SYSTEM_WRAPPERS_INCLUDE_PROCESS_CPU_LOAD_H_
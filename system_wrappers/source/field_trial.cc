@@ -10,7 +10,10 @@
 #include "system_wrappers/include/field_trial.h"
 
 #include <stddef.h>
+
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 // Simple field trial implementation, which allows client to
 // specify desired flags in InitFieldTrialsFromString.
@@ -20,14 +23,18 @@ namespace field_trial {
 static const char* trials_init_string = NULL;
 
 #ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
-std::string FindFullName(const std::string& name) {
-  if (trials_init_string == NULL)
-    return std::string();
+typedef std::unordered_map<std::string, std::string> TrialGroups;
 
-  std::string trials_string(trials_init_string);
-  if (trials_string.empty())
-    return std::string();
+// The groups of |trials_init_string|, parsed once when it is set since
+// FindFullName is called for every experiment check.
+static const TrialGroups* trial_groups = NULL;
+
+static const TrialGroups* ParseFieldTrials(const char* trials_c_string) {
+  TrialGroups* groups = new TrialGroups();
+  if (trials_c_string == NULL)
+    return groups;
 
+  const std::string trials_string(trials_c_string);
   static const char kPersistentStringSeparator = '/';
   size_t next_item = 0;
   while (next_item < trials_string.length()) {
@@ -47,16 +54,30 @@ std::string FindFullName(const std::string& name) {
                             field_value_end - field_name_end - 1);
     next_item = field_value_end + 1;
 
-    if (name == field_name)
-      return field_value;
+    // The first group given for a trial wins.
+    groups->emplace(std::move(field_name), std::move(field_value));
   }
-  return std::string();
+  return groups;
+}
+
+std::string FindFullName(const std::string& name) {
+  if (trial_groups == NULL)
+    return std::string();
+
+  auto it = trial_groups->find(name);
+  if (it == trial_groups->end())
+    return std::string();
+  return it->second;
 }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 
 // Optionally initialize field trial from a string.
 void InitFieldTrialsFromString(const char* trials_string) {
   trials_init_string = trials_string;
+#ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
+  delete trial_groups;
+  trial_groups = ParseFieldTrials(trials_string);
+#endif
 }
 
 const char* GetFieldTrialString() {
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "system_wrappers/include/field_trial.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace field_trial {
+namespace {
+
+class FieldTrialTest : public ::testing::Test {
+ protected:
+  FieldTrialTest() : previous_field_trials_(GetFieldTrialString()) {}
+  ~FieldTrialTest() override {
+    InitFieldTrialsFromString(previous_field_trials_);
+  }
+
+ private:
+  const char* const previous_field_trials_;
+};
+
+TEST_F(FieldTrialTest, FindsGroupOfEachTrial) {
+  InitFieldTrialsFromString("WebRTC-A/Enabled/WebRTC-B/Disabled,x:1/");
+  EXPECT_EQ("Enabled", FindFullName("WebRTC-A"));
+  EXPECT_EQ("Disabled,x:1", FindFullName("WebRTC-B"));
+  EXPECT_EQ("", FindFullName("WebRTC-C"));
+  EXPECT_TRUE(IsEnabled("WebRTC-A"));
+  EXPECT_TRUE(IsDisabled("WebRTC-B"));
+}
+
+TEST_F(FieldTrialTest, FirstGroupOfTrialWins) {
+  InitFieldTrialsFromString("WebRTC-A/Enabled/WebRTC-A/Disabled/");
+  EXPECT_EQ("Enabled", FindFullName("WebRTC-A"));
+}
+
+TEST_F(FieldTrialTest, IgnoresTrialsAfterMalformedTrial) {
+  InitFieldTrialsFromString("WebRTC-A/Enabled/WebRTC-B//WebRTC-C/Enabled/");
+  EXPECT_EQ("Enabled", FindFullName("WebRTC-A"));
+  EXPECT_EQ("", FindFullName("WebRTC-B"));
+  EXPECT_EQ("", FindFullName("WebRTC-C"));
+}
+
+TEST_F(FieldTrialTest, ReplacesTrialsWhenInitializedAgain) {
+  InitFieldTrialsFromString("WebRTC-A/Enabled/");
+  InitFieldTrialsFromString("WebRTC-B/Enabled/");
+  EXPECT_EQ("", FindFullName("WebRTC-A"));
+  EXPECT_EQ("Enabled", FindFullName("WebRTC-B"));
+  InitFieldTrialsFromString(nullptr);
+  EXPECT_EQ("", FindFullName("WebRTC-B"));
+}
+
+}  // namespace
+}  // namespace field_trial
+}  // namespace webrtc
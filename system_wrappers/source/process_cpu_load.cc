@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "system_wrappers/include/process_cpu_load.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+ProcessCpuLoad* ProcessCpuLoad::Get() {
+  static ProcessCpuLoad* const process_cpu_load = new ProcessCpuLoad(1000);
+  return process_cpu_load;
+}
+
+ProcessCpuLoad::ProcessCpuLoad(int64_t update_interval_ms)
+    : update_interval_ns_(update_interval_ms * rtc::kNumNanosecsPerMillisec),
+      num_cores_(std::max<int>(1, CpuInfo::DetectNumberOfCores())) {
+  RTC_DCHECK_GT(update_interval_ms, 0);
+}
+
+ProcessCpuLoad::~ProcessCpuLoad() = default;
+
+absl::optional<float> ProcessCpuLoad::GetLoad() {
+  const int64_t now_ns = rtc::TimeNanos();
+  rtc::CritScope cs(&crit_);
+  if (last_sample_time_ns_ &&
+      now_ns - *last_sample_time_ns_ < update_interval_ns_) {
+    return load_;
+  }
+  const int64_t cpu_time_ns = rtc::GetProcessCpuTimeNanos();
+  if (last_sample_time_ns_) {
+    load_ = static_cast<float>(cpu_time_ns - last_sample_cpu_time_ns_) /
+            ((now_ns - *last_sample_time_ns_) * num_cores_);
+  }
+  last_sample_time_ns_ = now_ns;
+  last_sample_cpu_time_ns_ = cpu_time_ns;
+  return load_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "system_wrappers/include/process_cpu_load.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+const int64_t kUpdateIntervalMs = 20;
+
+void SpinFor(int64_t duration_ms) {
+  const int64_t end_ms = rtc::TimeMillis() + duration_ms;
+  while (rtc::TimeMillis() < end_ms) {
+  }
+}
+
+}  // namespace
+
+TEST(ProcessCpuLoadTest, NoLoadBeforeFirstInterval) {
+  ProcessCpuLoad cpu_load(kUpdateIntervalMs);
+  EXPECT_FALSE(cpu_load.GetLoad());
+  EXPECT_FALSE(cpu_load.GetLoad());
+}
+
+TEST(ProcessCpuLoadTest, MeasuresBusyThread) {
+  ProcessCpuLoad cpu_load(kUpdateIntervalMs);
+  cpu_load.GetLoad();
+  SpinFor(2 * kUpdateIntervalMs);
+  absl::optional<float> load = cpu_load.GetLoad();
+  ASSERT_TRUE(load);
+  EXPECT_GT(*load, 0.0f);
+  // The load is kept until the next interval has passed.
+  EXPECT_EQ(load, cpu_load.GetLoad());
+}
+
+}  // namespace webrtc
@@ -11,6 +11,7 @@
 #include "test/rtp_file_reader.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #include <map>
 #include <string>
@@ -23,6 +24,13 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/system/arch.h"
 
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace webrtc {
 namespace test {
 
@@ -37,24 +45,141 @@ static uint16_t kPacketHeaderSize = 8;
     }                                       \
   } while (0)
 
-bool ReadUint32(uint32_t* out, FILE* file) {
+// Gives sequential access to the contents of a file, like stdio, but without
+// a library call per read: the file is memory-mapped where possible, and read
+// into memory in one go otherwise.
+class InputFile {
+ public:
+  InputFile() = default;
+  ~InputFile() {
+#if defined(WEBRTC_POSIX)
+    if (size_ > 0)
+      munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+  }
+
+  bool Open(const std::string& filename) {
+#if defined(WEBRTC_POSIX)
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+      close(fd);
+      return false;
+    }
+    if (file_stat.st_size > 0) {
+      void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd,
+                        0);
+      if (data == MAP_FAILED) {
+        close(fd);
+        return false;
+      }
+      data_ = static_cast<const uint8_t*>(data);
+      size_ = file_stat.st_size;
+    }
+    close(fd);
+    return true;
+#else
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == NULL)
+      return false;
+    uint8_t chunk[kMaxReadChunkSize];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+      buffer_.insert(buffer_.end(), chunk, chunk + read);
+    fclose(file);
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return true;
+#endif
+  }
+
+  // Copies up to |length| bytes to |out| and returns the number of bytes
+  // copied. Like fread, sets the end of file indicator on a short read.
+  size_t Read(void* out, size_t length) {
+    size_t available = position_ < size_ ? size_ - position_ : 0;
+    if (length > available) {
+      length = available;
+      eof_ = true;
+    }
+    if (length > 0)
+      memcpy(out, data_ + position_, length);
+    position_ += length;
+    return length;
+  }
+
+  // Like fgets: reads at most |size| - 1 bytes, up to and including a newline.
+  bool ReadLine(char* out, size_t size) {
+    if (size == 0 || position_ >= size_) {
+      eof_ = true;
+      return false;
+    }
+    size_t length = 0;
+    while (length + 1 < size && position_ < size_) {
+      char c = static_cast<char>(data_[position_++]);
+      out[length++] = c;
+      if (c == '\n')
+        break;
+    }
+    out[length] = '\0';
+    return true;
+  }
+
+  uint8_t ReadByte(bool* ok) {
+    if (position_ >= size_) {
+      eof_ = true;
+      *ok = false;
+      return 0;
+    }
+    return data_[position_++];
+  }
+
+  // Positions the file at |position|, which may be past the end of the file,
+  // and clears the end of file indicator. Like fseek, returns 0.
+  int Seek(size_t position) {
+    position_ = position;
+    eof_ = false;
+    return 0;
+  }
+  int Skip(size_t length) { return Seek(position_ + length); }
+
+  size_t position() const { return position_; }
+  bool eof() const { return eof_; }
+
+ private:
+#if !defined(WEBRTC_POSIX)
+  static const size_t kMaxReadChunkSize = 1 << 16;
+  std::vector<uint8_t> buffer_;
+#endif
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  size_t position_ = 0;
+  bool eof_ = false;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(InputFile);
+};
+
+bool ReadUint32(uint32_t* out, InputFile* file) {
   *out = 0;
   for (size_t i = 0; i < 4; ++i) {
     *out <<= 8;
-    uint8_t tmp;
-    if (fread(&tmp, 1, sizeof(uint8_t), file) != sizeof(uint8_t))
+    bool ok = true;
+    uint8_t tmp = file->ReadByte(&ok);
+    if (!ok)
       return false;
     *out |= tmp;
   }
   return true;
 }
 
-bool ReadUint16(uint16_t* out, FILE* file) {
+bool ReadUint16(uint16_t* out, InputFile* file) {
   *out = 0;
   for (size_t i = 0; i < 2; ++i) {
     *out <<= 8;
-    uint8_t tmp;
-    if (fread(&tmp, 1, sizeof(uint8_t), file) != sizeof(uint8_t))
+    bool ok = true;
+    uint8_t tmp = file->ReadByte(&ok);
+    if (!ok)
       return false;
     *out |= tmp;
   }
@@ -69,34 +194,27 @@ class RtpFileReaderImpl : public RtpFileReader {
 
 class InterleavedRtpFileReader : public RtpFileReaderImpl {
  public:
-  virtual ~InterleavedRtpFileReader() {
-    if (file_ != NULL) {
-      fclose(file_);
-      file_ = NULL;
-    }
-  }
+  virtual ~InterleavedRtpFileReader() {}
 
   virtual bool Init(const std::string& filename,
                     const std::set<uint32_t>& ssrc_filter) {
-    file_ = fopen(filename.c_str(), "rb");
-    if (file_ == NULL) {
+    if (!file_.Open(filename)) {
       printf("ERROR: Can't open file: %s\n", filename.c_str());
       return false;
     }
     return true;
   }
   virtual bool NextPacket(RtpPacket* packet) {
-    assert(file_ != NULL);
     packet->length = RtpPacket::kMaxPacketBufferSize;
     uint32_t len = 0;
-    TRY(ReadUint32(&len, file_));
+    TRY(ReadUint32(&len, &file_));
     if (packet->length < len) {
       FATAL() << "Packet is too large to fit: " << len << " bytes vs "
               << packet->length
               << " bytes allocated. Consider increasing the buffer "
                  "size";
     }
-    if (fread(packet->data, 1, len, file_) != len)
+    if (file_.Read(packet->data, len) != len)
       return false;
 
     packet->length = len;
@@ -107,7 +225,7 @@ class InterleavedRtpFileReader : public RtpFileReaderImpl {
   }
 
  private:
-  FILE* file_ = NULL;
+  InputFile file_;
   int64_t time_ms_ = 0;
 };
 
@@ -115,24 +233,18 @@ class InterleavedRtpFileReader : public RtpFileReaderImpl {
 // http://www.cs.columbia.edu/irt/software/rtptools/
 class RtpDumpReader : public RtpFileReaderImpl {
  public:
-  RtpDumpReader() : file_(NULL) {}
-  virtual ~RtpDumpReader() {
-    if (file_ != NULL) {
-      fclose(file_);
-      file_ = NULL;
-    }
-  }
+  RtpDumpReader() {}
+  virtual ~RtpDumpReader() {}
 
   bool Init(const std::string& filename,
             const std::set<uint32_t>& ssrc_filter) override {
-    file_ = fopen(filename.c_str(), "rb");
-    if (file_ == NULL) {
+    if (!file_.Open(filename)) {
       printf("ERROR: Can't open file: %s\n", filename.c_str());
       return false;
     }
 
     char firstline[kFirstLineLength + 1] = {0};
-    if (fgets(firstline, kFirstLineLength, file_) == NULL) {
+    if (!file_.ReadLine(firstline, kFirstLineLength)) {
       RTC_LOG(LS_INFO) << "Can't read from file";
       return false;
     }
@@ -156,11 +268,11 @@ class RtpDumpReader : public RtpFileReaderImpl {
     uint32_t source;
     uint16_t port;
     uint16_t padding;
-    TRY(ReadUint32(&start_sec, file_));
-    TRY(ReadUint32(&start_usec, file_));
-    TRY(ReadUint32(&source, file_));
-    TRY(ReadUint16(&port, file_));
-    TRY(ReadUint16(&padding, file_));
+    TRY(ReadUint32(&start_sec, &file_));
+    TRY(ReadUint32(&start_usec, &file_));
+    TRY(ReadUint32(&source, &file_));
+    TRY(ReadUint16(&port, &file_));
+    TRY(ReadUint16(&padding, &file_));
 
     return true;
   }
@@ -172,9 +284,9 @@ class RtpDumpReader : public RtpFileReaderImpl {
     uint16_t len;
     uint16_t plen;
     uint32_t offset;
-    TRY(ReadUint16(&len, file_));
-    TRY(ReadUint16(&plen, file_));
-    TRY(ReadUint32(&offset, file_));
+    TRY(ReadUint16(&len, &file_));
+    TRY(ReadUint16(&plen, &file_));
+    TRY(ReadUint32(&offset, &file_));
 
     // Use 'len' here because a 'plen' of 0 specifies rtcp.
     len -= kPacketHeaderSize;
@@ -184,7 +296,7 @@ class RtpDumpReader : public RtpFileReaderImpl {
               << " bytes allocated. Consider increasing the buffer "
                  "size";
     }
-    if (fread(rtp_data, 1, len, file_) != len) {
+    if (file_.Read(rtp_data, len) != len) {
       return false;
     }
 
@@ -195,7 +307,7 @@ class RtpDumpReader : public RtpFileReaderImpl {
   }
 
  private:
-  FILE* file_;
+  InputFile file_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtpDumpReader);
 };
@@ -242,8 +354,7 @@ const uint32_t kPcapBOMNoSwapOrder = 0xa1b2c3d4UL;
 class PcapReader : public RtpFileReaderImpl {
  public:
   PcapReader()
-      : file_(NULL),
-        swap_pcap_byte_order_(false),
+      : swap_pcap_byte_order_(false),
 #ifdef WEBRTC_ARCH_BIG_ENDIAN
         swap_network_byte_order_(false),
 #else
@@ -255,12 +366,7 @@ class PcapReader : public RtpFileReaderImpl {
         next_packet_it_() {
   }
 
-  virtual ~PcapReader() {
-    if (file_ != NULL) {
-      fclose(file_);
-      file_ = NULL;
-    }
-  }
+  virtual ~PcapReader() {}
 
   bool Init(const std::string& filename,
             const std::set<uint32_t>& ssrc_filter) override {
@@ -269,8 +375,7 @@ class PcapReader : public RtpFileReaderImpl {
 
   int Initialize(const std::string& filename,
                  const std::set<uint32_t>& ssrc_filter) {
-    file_ = fopen(filename.c_str(), "rb");
-    if (file_ == NULL) {
+    if (!file_.Open(filename)) {
       printf("ERROR: Can't open file: %s\n", filename.c_str());
       return kResultFail;
     }
@@ -281,9 +386,9 @@ class PcapReader : public RtpFileReaderImpl {
 
     int total_packet_count = 0;
     uint32_t stream_start_ms = 0;
-    int32_t next_packet_pos = ftell(file_);
+    int32_t next_packet_pos = file_.position();
     for (;;) {
-      TRY_PCAP(fseek(file_, next_packet_pos, SEEK_SET));
+      TRY_PCAP(file_.Seek(next_packet_pos));
       int result = ReadPacket(&next_packet_pos, stream_start_ms,
                               ++total_packet_count, ssrc_filter);
       if (result == kResultFail) {
@@ -296,7 +401,7 @@ class PcapReader : public RtpFileReaderImpl {
       }
     }
 
-    if (feof(file_) == 0) {
+    if (!file_.eof()) {
       printf("Failed reading file!\n");
       return kResultFail;
     }
@@ -353,7 +458,7 @@ class PcapReader : public RtpFileReaderImpl {
     if (*length < next_packet_it_->payload_length) {
       return -1;
     }
-    TRY_PCAP(fseek(file_, next_packet_it_->pos_in_file, SEEK_SET));
+    TRY_PCAP(file_.Seek(next_packet_it_->pos_in_file));
     TRY_PCAP(Read(data, next_packet_it_->payload_length));
     *length = next_packet_it_->payload_length;
     *time_ms = next_packet_it_->time_offset_ms;
@@ -433,13 +538,13 @@ class PcapReader : public RtpFileReaderImpl {
     TRY_PCAP(Read(&incl_len, false));
     TRY_PCAP(Read(&orig_len, false));
 
-    *next_packet_pos = ftell(file_) + incl_len;
+    *next_packet_pos = file_.position() + incl_len;
 
     RtpPacketMarker marker = {0};
     marker.packet_number = number;
     marker.time_offset_ms = CalcTimeDelta(ts_sec, ts_usec, stream_start_ms);
     TRY_PCAP(ReadPacketHeader(&marker));
-    marker.pos_in_file = ftell(file_);
+    marker.pos_in_file = file_.position();
 
     if (marker.payload_length > sizeof(read_buffer_)) {
       printf("Packet too large!\n");
@@ -471,7 +576,7 @@ class PcapReader : public RtpFileReaderImpl {
   }
 
   int ReadPacketHeader(RtpPacketMarker* marker) {
-    int32_t file_pos = ftell(file_);
+    int32_t file_pos = file_.position();
 
     // Check for BSD null/loopback frame header. The header is just 4 bytes in
     // native byte order, so we check for both versions as we don't care about
@@ -487,7 +592,7 @@ class PcapReader : public RtpFileReaderImpl {
       }
     }
 
-    TRY_PCAP(fseek(file_, file_pos, SEEK_SET));
+    TRY_PCAP(file_.Seek(file_pos));
 
     // Check for Ethernet II, IP frame header.
     uint16_t type;
@@ -572,7 +677,7 @@ class PcapReader : public RtpFileReaderImpl {
 
   int Read(uint32_t* out, bool expect_network_order) {
     uint32_t tmp = 0;
-    if (fread(&tmp, 1, sizeof(uint32_t), file_) != sizeof(uint32_t)) {
+    if (file_.Read(&tmp, sizeof(uint32_t)) != sizeof(uint32_t)) {
       return kResultFail;
     }
     if ((!expect_network_order && swap_pcap_byte_order_) ||
@@ -586,7 +691,7 @@ class PcapReader : public RtpFileReaderImpl {
 
   int Read(uint16_t* out, bool expect_network_order) {
     uint16_t tmp = 0;
-    if (fread(&tmp, 1, sizeof(uint16_t), file_) != sizeof(uint16_t)) {
+    if (file_.Read(&tmp, sizeof(uint16_t)) != sizeof(uint16_t)) {
       return kResultFail;
     }
     if ((!expect_network_order && swap_pcap_byte_order_) ||
@@ -598,7 +703,7 @@ class PcapReader : public RtpFileReaderImpl {
   }
 
   int Read(uint8_t* out, uint32_t count) {
-    if (fread(out, 1, count, file_) != count) {
+    if (file_.Read(out, count) != count) {
       return kResultFail;
     }
     return kResultSuccess;
@@ -606,7 +711,7 @@ class PcapReader : public RtpFileReaderImpl {
 
   int Read(int32_t* out, bool expect_network_order) {
     int32_t tmp = 0;
-    if (fread(&tmp, 1, sizeof(uint32_t), file_) != sizeof(uint32_t)) {
+    if (file_.Read(&tmp, sizeof(uint32_t)) != sizeof(uint32_t)) {
       return kResultFail;
     }
     if ((!expect_network_order && swap_pcap_byte_order_) ||
@@ -619,13 +724,13 @@ class PcapReader : public RtpFileReaderImpl {
   }
 
   int Skip(uint32_t length) {
-    if (fseek(file_, length, SEEK_CUR) != 0) {
+    if (file_.Skip(length) != 0) {
       return kResultFail;
     }
     return kResultSuccess;
   }
 
-  FILE* file_;
+  InputFile file_;
   bool swap_pcap_byte_order_;
   const bool swap_network_byte_order_;
   uint8_t read_buffer_[kMaxReadBufferSize];
@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/scenario/scenario_runner.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace test {
+
+ScenarioRunner::ScenarioRunner(int max_concurrency)
+    : max_concurrency_(max_concurrency > 0
+                           ? max_concurrency
+                           : std::max<int>(1, CpuInfo::DetectNumberOfCores())) {
+}
+
+ScenarioRunner::~ScenarioRunner() = default;
+
+void ScenarioRunner::AddJob(std::string name, std::function<void()> job) {
+  RTC_DCHECK(job);
+  jobs_.push_back({std::move(name), std::move(job)});
+}
+
+void ScenarioRunner::RunAll() {
+  {
+    rtc::CritScope cs(&crit_);
+    next_job_ = 0;
+  }
+  const int num_workers =
+      std::min<int>(max_concurrency_, static_cast<int>(jobs_.size()));
+  if (num_workers <= 1) {
+    while (RunNextJob()) {
+    }
+    return;
+  }
+  std::vector<std::unique_ptr<rtc::PlatformThread>> workers;
+  for (int i = 0; i < num_workers; ++i) {
+    workers.push_back(absl::make_unique<rtc::PlatformThread>(
+        &ScenarioRunner::RunWorker, this, "ScenarioWorker"));
+    workers.back()->Start();
+  }
+  for (auto& worker : workers)
+    worker->Stop();
+}
+
+void ScenarioRunner::RunWorker(void* obj) {
+  ScenarioRunner* runner = static_cast<ScenarioRunner*>(obj);
+  while (runner->RunNextJob()) {
+  }
+}
+
+bool ScenarioRunner::RunNextJob() {
+  const Job* job;
+  {
+    rtc::CritScope cs(&crit_);
+    if (next_job_ >= jobs_.size())
+      return false;
+    job = &jobs_[next_job_++];
+  }
+  // The rtc time functions might be overridden by a simulated time scenario.
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t start_ms = clock->TimeInMilliseconds();
+  job->function();
+  RTC_LOG(LS_INFO) << "Scenario job " << job->name << " finished in "
+                   << clock->TimeInMilliseconds() - start_ms << " ms";
+  return true;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef TEST_SCENARIO_SCENARIO_RUNNER_H_
+#define TEST_SCENARIO_SCENARIO_RUNNER_H_
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+
+namespace webrtc {
+namespace test {
+// ScenarioRunner runs independent scenario jobs, e.g. the points of a bitrate
+// or loss sweep, on a pool of worker threads. Each job is expected to create
+// and own its Scenario, so that jobs share no state. Note that field trials and
+// the clock used for event logs in simulated time are process global, jobs run
+// in parallel must therefore use the same field trials and should not enable
+// scenario logs together with simulated time.
+class ScenarioRunner {
+ public:
+  // Runs at most |max_concurrency| jobs at a time, or one job per core if
+  // |max_concurrency| is 0.
+  explicit ScenarioRunner(int max_concurrency = 0);
+  ~ScenarioRunner();
+
+  void AddJob(std::string name, std::function<void()> job);
+  // Runs all added jobs and returns when they have finished. Jobs are started
+  // in the order they were added.
+  void RunAll();
+
+  int max_concurrency() const { return max_concurrency_; }
+
+ private:
+  struct Job {
+    std::string name;
+    std::function<void()> function;
+  };
+  static void RunWorker(void* obj);
+  bool RunNextJob();
+
+  const int max_concurrency_;
+  std::vector<Job> jobs_;
+  rtc::CriticalSection crit_;
+  size_t next_job_ RTC_GUARDED_BY(crit_) = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScenarioRunner);
+};
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_SCENARIO_SCENARIO_RUNNER_H_
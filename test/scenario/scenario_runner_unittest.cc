@@ -0,0 +1,70 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/scenario/scenario_runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "rtc_base/event.h"
+#include "test/gtest.h"
+#include "test/scenario/scenario.h"
+
+namespace webrtc {
+namespace test {
+TEST(ScenarioRunnerTest, RunsAllJobsWithLimitedConcurrency) {
+  ScenarioRunner runner(3);
+  std::atomic<int> num_done(0);
+  std::atomic<int> num_running(0);
+  std::atomic<int> max_running(0);
+  for (int i = 0; i < 10; ++i) {
+    runner.AddJob("job" + std::to_string(i), [&] {
+      int running = ++num_running;
+      int prev_max = max_running.load();
+      while (running > prev_max &&
+             !max_running.compare_exchange_weak(prev_max, running)) {
+      }
+      rtc::Event wait(false, false);
+      wait.Wait(5);
+      --num_running;
+      ++num_done;
+    });
+  }
+  runner.RunAll();
+  EXPECT_EQ(10, num_done.load());
+  EXPECT_LE(max_running.load(), 3);
+  EXPECT_GE(max_running.load(), 1);
+}
+
+TEST(ScenarioRunnerTest, RunsSimulatedTimeScenariosInParallel) {
+  ScenarioRunner runner(2);
+  std::atomic<int> num_done(0);
+  for (int start_rate_kbps : {300, 1000}) {
+    runner.AddJob("rate" + std::to_string(start_rate_kbps), [&,
+                                                              start_rate_kbps] {
+      Scenario s("", /*real_time=*/false);
+      CallClientConfig config;
+      config.transport.rates.start_rate = DataRate::kbps(start_rate_kbps);
+      auto* alice = s.CreateClient("alice", config);
+      auto* bob = s.CreateClient("bob", config);
+      NetworkNodeConfig network_config;
+      auto alice_net = s.CreateSimulationNode(network_config);
+      auto bob_net = s.CreateSimulationNode(network_config);
+      auto route = s.CreateRoutes(alice, {alice_net}, bob, {bob_net});
+      s.CreateVideoStream(route->forward(), VideoStreamConfig());
+      s.RunFor(TimeDelta::seconds(1));
+      ++num_done;
+    });
+  }
+  runner.RunAll();
+  EXPECT_EQ(2, num_done.load());
+}
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/testsupport/microbenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/timeutils.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+constexpr int kWarmupIterations = 10;
+
+volatile const void* g_sink = nullptr;
+
+int64_t TimeIterationsNs(rtc::FunctionView<void()> op, int64_t iterations) {
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int64_t i = 0; i < iterations; ++i)
+    op();
+  return rtc::TimeNanos() - start_ns;
+}
+
+}  // namespace
+
+MicrobenchmarkResult RunMicrobenchmark(const std::string& name,
+                                       rtc::FunctionView<void()> op,
+                                       int num_repetitions,
+                                       int min_repetition_ms) {
+  RTC_DCHECK_GT(num_repetitions, 0);
+  RTC_DCHECK_GT(min_repetition_ms, 0);
+  TimeIterationsNs(op, kWarmupIterations);
+
+  // Grow the batch until it runs long enough for the clock resolution and
+  // loop overhead not to matter.
+  const int64_t min_repetition_ns =
+      min_repetition_ms * rtc::kNumNanosecsPerMillisec;
+  int64_t iterations = 1;
+  for (;;) {
+    const int64_t elapsed_ns = TimeIterationsNs(op, iterations);
+    if (elapsed_ns >= min_repetition_ns)
+      break;
+    iterations = elapsed_ns > 0
+                     ? std::max(iterations + 1,
+                                iterations * min_repetition_ns / elapsed_ns)
+                     : iterations * 10;
+  }
+
+  std::vector<double> ns_per_op;
+  ns_per_op.reserve(num_repetitions);
+  for (int i = 0; i < num_repetitions; ++i) {
+    ns_per_op.push_back(static_cast<double>(TimeIterationsNs(op, iterations)) /
+                        iterations);
+  }
+
+  MicrobenchmarkResult result;
+  result.iterations_per_repetition = iterations;
+  for (double value : ns_per_op)
+    result.mean_ns_per_op += value;
+  result.mean_ns_per_op /= num_repetitions;
+  for (double value : ns_per_op) {
+    result.stddev_ns_per_op +=
+        (value - result.mean_ns_per_op) * (value - result.mean_ns_per_op);
+  }
+  result.stddev_ns_per_op = std::sqrt(result.stddev_ns_per_op / num_repetitions);
+
+  PrintResultMeanAndError("microbenchmark", "", name, result.mean_ns_per_op,
+                          result.stddev_ns_per_op, "ns/op", false);
+  return result;
+}
+
+void DoNotOptimizeAway(const void* value) {
+  g_sink = value;
+}
+
+}  // namespace test
+}  // namespace webrtc
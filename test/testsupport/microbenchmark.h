@@ -0,0 +1,44 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_TESTSUPPORT_MICROBENCHMARK_H_
+#define TEST_TESTSUPPORT_MICROBENCHMARK_H_
+
+#include <string>
+
+#include "rtc_base/function_view.h"
+
+namespace webrtc {
+namespace test {
+
+struct MicrobenchmarkResult {
+  // Mean and standard deviation over all repetitions of the time per call.
+  double mean_ns_per_op = 0;
+  double stddev_ns_per_op = 0;
+  int64_t iterations_per_repetition = 0;
+};
+
+// Measures the time per call of |op|. After a warm-up, the number of calls
+// per repetition is calibrated to take roughly |min_repetition_ms|, and
+// |num_repetitions| repetitions are timed. The result is reported with
+// PrintResultMeanAndError() as "<name>" in ns/op, and is therefore included
+// in the JSON written by --isolated_script_test_perf_output.
+MicrobenchmarkResult RunMicrobenchmark(const std::string& name,
+                                       rtc::FunctionView<void()> op,
+                                       int num_repetitions = 10,
+                                       int min_repetition_ms = 50);
+
+// Keeps the compiler from optimizing away the computation of |value|.
+void DoNotOptimizeAway(const void* value);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_TESTSUPPORT_MICROBENCHMARK_H_
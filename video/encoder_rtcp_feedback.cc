@@ -10,45 +10,115 @@
 
 #include "video/encoder_rtcp_feedback.h"
 
+#include <algorithm>
+
 #include "api/video/video_stream_encoder_interface.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "system_wrappers/include/field_trial.h"
+#include "video/send_statistics_proxy.h"
 
 static const int kMinKeyFrameRequestIntervalMs = 300;
 
 namespace webrtc {
 
+EncoderRtcpFeedback::CoalescingConfig
+EncoderRtcpFeedback::CoalescingConfig::ParseFromFieldTrial() {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<bool> per_layer("per_layer", true);
+  FieldTrialParameter<int> max_window_ms("max_window_ms", 1000);
+  ParseFieldTrial({&enabled, &per_layer, &max_window_ms},
+                  field_trial::FindFullName("WebRTC-KeyFrameRequestCoalescing"));
+  CoalescingConfig config;
+  config.enabled = enabled.Get();
+  config.per_layer = per_layer.Get();
+  config.max_window_ms =
+      std::max(kMinKeyFrameRequestIntervalMs, max_window_ms.Get());
+  return config;
+}
+
 EncoderRtcpFeedback::EncoderRtcpFeedback(Clock* clock,
                                          const std::vector<uint32_t>& ssrcs,
-                                         VideoStreamEncoderInterface* encoder)
+                                         VideoStreamEncoderInterface* encoder,
+                                         RtcpRttStats* rtt_stats,
+                                         SendStatisticsProxy* stats_proxy)
     : clock_(clock),
       ssrcs_(ssrcs),
       video_stream_encoder_(encoder),
-      time_last_intra_request_ms_(-1) {
+      rtt_stats_(rtt_stats),
+      stats_proxy_(stats_proxy),
+      config_(CoalescingConfig::ParseFromFieldTrial()),
+      time_last_intra_request_ms_(ssrcs.size(), -1) {
   RTC_DCHECK(!ssrcs.empty());
 }
 
-bool EncoderRtcpFeedback::HasSsrc(uint32_t ssrc) {
-  for (uint32_t registered_ssrc : ssrcs_) {
-    if (registered_ssrc == ssrc) {
-      return true;
+EncoderRtcpFeedback::~EncoderRtcpFeedback() = default;
+
+size_t EncoderRtcpFeedback::StreamIndex(uint32_t ssrc) const {
+  for (size_t i = 0; i < ssrcs_.size(); ++i) {
+    if (ssrcs_[i] == ssrc) {
+      return i;
     }
   }
-  return false;
+  RTC_NOTREACHED();
+  return 0;
+}
+
+int64_t EncoderRtcpFeedback::CoalescingWindowMs() const {
+  if (!config_.enabled || !rtt_stats_)
+    return kMinKeyFrameRequestIntervalMs;
+  // A key frame sent less than one round trip ago may not have reached the
+  // receiver yet, so a request arriving within that time is most likely a
+  // duplicate of the one that triggered it.
+  const int64_t rtt_ms = rtt_stats_->LastProcessedRtt();
+  return std::min(config_.max_window_ms,
+                  std::max<int64_t>(kMinKeyFrameRequestIntervalMs, rtt_ms));
 }
 
 void EncoderRtcpFeedback::OnReceivedIntraFrameRequest(uint32_t ssrc) {
-  RTC_DCHECK(HasSsrc(ssrc));
+  const size_t stream_index = StreamIndex(ssrc);
+  const bool per_layer =
+      config_.enabled && config_.per_layer && ssrcs_.size() > 1;
+  const size_t slot = per_layer ? stream_index : 0;
+  const int64_t window_ms = CoalescingWindowMs();
+  bool coalesced = false;
   {
     int64_t now_ms = clock_->TimeInMilliseconds();
     rtc::CritScope lock(&crit_);
-    if (time_last_intra_request_ms_ + kMinKeyFrameRequestIntervalMs > now_ms) {
+    int64_t& time_last_request_ms = time_last_intra_request_ms_[slot];
+    if (time_last_request_ms >= 0 &&
+        time_last_request_ms + window_ms > now_ms) {
+      coalesced = true;
+    } else {
+      time_last_request_ms = now_ms;
+    }
+  }
+  if (stats_proxy_)
+    stats_proxy_->OnKeyFrameRequestReceived(coalesced);
+  if (coalesced)
+    return;
+
+  {
+    // Called under the lock so that the sender can be detached safely.
+    rtc::CritScope lock(&crit_);
+    if (key_frame_request_sender_) {
+      key_frame_request_sender_->RequestKeyFrame();
       return;
     }
-    time_last_intra_request_ms_ = now_ms;
   }
 
-  // Always produce key frame for all streams.
-  video_stream_encoder_->SendKeyFrame();
+  if (per_layer) {
+    video_stream_encoder_->SendKeyFrameForStream(stream_index);
+  } else {
+    // Produce key frame for all streams.
+    video_stream_encoder_->SendKeyFrame();
+  }
+}
+
+void EncoderRtcpFeedback::SetKeyFrameRequestSender(
+    KeyFrameRequestSender* sender) {
+  rtc::CritScope lock(&crit_);
+  key_frame_request_sender_ = sender;
 }
 
 }  // namespace webrtc
@@ -12,30 +12,66 @@
 
 #include <vector>
 
+#include "modules/include/module_common_types.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/criticalsection.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
 
+class SendStatisticsProxy;
 class VideoStreamEncoderInterface;
 
+// Turns PLI/FIR requests from the remote side into key frame requests to the
+// encoder. Requests arriving within a short window of a previous one are
+// coalesced, since the key frame triggered by the first request has not yet
+// reached the receivers that sent the others.
+//
+// With the "WebRTC-KeyFrameRequestCoalescing" field trial enabled, the window
+// is stretched to the round trip time and, for simulcast, requests are tracked
+// and forwarded per stream so that a receiver of one layer does not force key
+// frames on all of them.
 class EncoderRtcpFeedback : public RtcpIntraFrameObserver {
  public:
+  // |rtt_stats| and |stats_proxy| may be null.
   EncoderRtcpFeedback(Clock* clock,
                       const std::vector<uint32_t>& ssrcs,
-                      VideoStreamEncoderInterface* encoder);
+                      VideoStreamEncoderInterface* encoder,
+                      RtcpRttStats* rtt_stats,
+                      SendStatisticsProxy* stats_proxy);
+  ~EncoderRtcpFeedback() override;
+
   void OnReceivedIntraFrameRequest(uint32_t ssrc) override;
 
+  // When set, requests that survive coalescing are passed to |sender| instead
+  // of the encoder. Used when the stream forwards already encoded frames.
+  void SetKeyFrameRequestSender(KeyFrameRequestSender* sender);
+
  private:
-  bool HasSsrc(uint32_t ssrc);
+  struct CoalescingConfig {
+    static CoalescingConfig ParseFromFieldTrial();
+
+    bool enabled = false;
+    bool per_layer = true;
+    int64_t max_window_ms = 1000;
+  };
+
+  size_t StreamIndex(uint32_t ssrc) const;
+  int64_t CoalescingWindowMs() const;
 
   Clock* const clock_;
   const std::vector<uint32_t> ssrcs_;
   VideoStreamEncoderInterface* const video_stream_encoder_;
+  RtcpRttStats* const rtt_stats_;
+  SendStatisticsProxy* const stats_proxy_;
+  const CoalescingConfig config_;
 
   rtc::CriticalSection crit_;
-  int64_t time_last_intra_request_ms_ RTC_GUARDED_BY(crit_);
+  // Time of the last forwarded request per stream. Only the first entry is
+  // used unless requests are tracked per layer.
+  std::vector<int64_t> time_last_intra_request_ms_ RTC_GUARDED_BY(crit_);
+  KeyFrameRequestSender* key_frame_request_sender_ RTC_GUARDED_BY(crit_) =
+      nullptr;
 };
 
 }  // namespace webrtc
@@ -12,6 +12,7 @@
 
 #include <memory>
 
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "video/test/mock_video_stream_encoder.h"
@@ -19,6 +20,18 @@
 using ::testing::NiceMock;
 
 namespace webrtc {
+namespace {
+
+class FakeRttStats : public RtcpRttStats {
+ public:
+  void OnRttUpdate(int64_t rtt) override { rtt_ms_ = rtt; }
+  int64_t LastProcessedRtt() const override { return rtt_ms_; }
+
+ private:
+  int64_t rtt_ms_ = 0;
+};
+
+}  // namespace
 
 class VieKeyRequestTest : public ::testing::Test {
  public:
@@ -28,7 +41,9 @@ class VieKeyRequestTest : public ::testing::Test {
         encoder_rtcp_feedback_(
             &simulated_clock_,
             std::vector<uint32_t>(1, VieKeyRequestTest::kSsrc),
-            &encoder_) {}
+            &encoder_,
+            nullptr,
+            nullptr) {}
 
  protected:
   const uint32_t kSsrc = 1234;
@@ -57,4 +72,87 @@ TEST_F(VieKeyRequestTest, TooManyOnReceivedIntraFrameRequest) {
   encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
 }
 
+TEST_F(VieKeyRequestTest, RedirectsRequestsToKeyFrameRequestSender) {
+  class CountingSender : public KeyFrameRequestSender {
+   public:
+    void RequestKeyFrame() override { ++num_requests; }
+    int num_requests = 0;
+  } sender;
+  encoder_rtcp_feedback_.SetKeyFrameRequestSender(&sender);
+  // Requests are still coalesced before being redirected.
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
+  EXPECT_EQ(1, sender.num_requests);
+
+  encoder_rtcp_feedback_.SetKeyFrameRequestSender(nullptr);
+  EXPECT_CALL(encoder_, SendKeyFrame()).Times(1);
+  simulated_clock_.AdvanceTimeMilliseconds(300);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
+  EXPECT_EQ(1, sender.num_requests);
+}
+
+class KeyRequestCoalescingTest : public ::testing::Test {
+ public:
+  KeyRequestCoalescingTest()
+      : field_trials_("WebRTC-KeyFrameRequestCoalescing/Enabled/"),
+        simulated_clock_(123456789),
+        encoder_rtcp_feedback_(&simulated_clock_,
+                               {kSsrc0, kSsrc1, kSsrc2},
+                               &encoder_,
+                               &rtt_stats_,
+                               nullptr) {}
+
+ protected:
+  const uint32_t kSsrc0 = 1234;
+  const uint32_t kSsrc1 = 1235;
+  const uint32_t kSsrc2 = 1236;
+
+  test::ScopedFieldTrials field_trials_;
+  SimulatedClock simulated_clock_;
+  FakeRttStats rtt_stats_;
+  testing::StrictMock<MockVideoStreamEncoder> encoder_;
+  EncoderRtcpFeedback encoder_rtcp_feedback_;
+};
+
+TEST_F(KeyRequestCoalescingTest, RequestsKeyFramePerStream) {
+  EXPECT_CALL(encoder_, SendKeyFrameForStream(0)).Times(1);
+  EXPECT_CALL(encoder_, SendKeyFrameForStream(2)).Times(1);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc0);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc2);
+  // Coalesced with the requests above.
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc0);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc2);
+}
+
+TEST_F(KeyRequestCoalescingTest, CoalescesRequestsWithinRtt) {
+  rtt_stats_.OnRttUpdate(500);
+  EXPECT_CALL(encoder_, SendKeyFrameForStream(1)).Times(1);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc1);
+  simulated_clock_.AdvanceTimeMilliseconds(499);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc1);
+
+  EXPECT_CALL(encoder_, SendKeyFrameForStream(1)).Times(1);
+  simulated_clock_.AdvanceTimeMilliseconds(1);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc1);
+}
+
+TEST_F(KeyRequestCoalescingTest, WindowIsCappedForLargeRtt) {
+  rtt_stats_.OnRttUpdate(5000);
+  EXPECT_CALL(encoder_, SendKeyFrameForStream(0)).Times(2);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc0);
+  simulated_clock_.AdvanceTimeMilliseconds(1000);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc0);
+}
+
+TEST(KeyRequestCoalescingTrialTest, WholeStreamRequestsWhenPerLayerDisabled) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-KeyFrameRequestCoalescing/Enabled,per_layer:false/");
+  SimulatedClock clock(123456789);
+  testing::StrictMock<MockVideoStreamEncoder> encoder;
+  EncoderRtcpFeedback feedback(&clock, {1, 2}, &encoder, nullptr, nullptr);
+  EXPECT_CALL(encoder, SendKeyFrame()).Times(1);
+  feedback.OnReceivedIntraFrameRequest(2);
+  feedback.OnReceivedIntraFrameRequest(1);
+}
+
 }  // namespace webrtc
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/receive_pipeline_shards.h"
+
+#include <algorithm>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kMaxShards = 64;
+
+ReceivePipelineShards* CreateFromFieldTrial() {
+  FieldTrialParameter<int> shards("shards", 0);
+  ParseFieldTrial({&shards}, field_trial::FindFullName(
+                                 "WebRTC-Video-ReceivePipelineShards"));
+  if (shards.Get() <= 0)
+    return nullptr;
+  if (shards.Get() > kMaxShards) {
+    RTC_LOG(LS_WARNING) << "Too many receive pipeline shards: " << shards.Get()
+                        << ", using " << kMaxShards;
+  }
+  return new ReceivePipelineShards(std::min(shards.Get(), kMaxShards));
+}
+
+}  // namespace
+
+ReceivePipelineShards* ReceivePipelineShards::GetIfEnabled() {
+  // Leaked on purpose; receive streams may outlive static destruction order.
+  static ReceivePipelineShards* const shards = CreateFromFieldTrial();
+  return shards;
+}
+
+ReceivePipelineShards::ReceivePipelineShards(size_t num_shards) {
+  RTC_DCHECK_GT(num_shards, 0);
+  queues_.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    queues_.push_back(absl::make_unique<rtc::TaskQueue>(
+        "VideoReceivePipeline", rtc::TaskQueue::Priority::HIGH));
+  }
+}
+
+ReceivePipelineShards::~ReceivePipelineShards() = default;
+
+rtc::TaskQueue* ReceivePipelineShards::QueueForSsrc(uint32_t ssrc) {
+  return queues_[ssrc % queues_.size()].get();
+}
+
+}  // namespace webrtc
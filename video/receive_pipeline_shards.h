@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_RECEIVE_PIPELINE_SHARDS_H_
+#define VIDEO_RECEIVE_PIPELINE_SHARDS_H_
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/task_queue.h"
+
+namespace webrtc {
+
+// A fixed set of task queues on which video receive streams run
+// depacketization, frame assembly and reference finding, instead of doing that
+// work on the thread delivering RTP packets. Streams are assigned to a shard by
+// their remote SSRC, so all packets of one stream are handled in order on the
+// same queue while different streams can be processed in parallel.
+//
+// Enabled with the field trial "WebRTC-Video-ReceivePipelineShards/shards:N/",
+// where N is the number of task queues to use.
+class ReceivePipelineShards {
+ public:
+  // Returns the process wide instance, or null if the field trial is not
+  // enabled. The instance is created on first use and never destroyed.
+  static ReceivePipelineShards* GetIfEnabled();
+
+  explicit ReceivePipelineShards(size_t num_shards);
+  ~ReceivePipelineShards();
+
+  size_t num_shards() const { return queues_.size(); }
+  rtc::TaskQueue* QueueForSsrc(uint32_t ssrc);
+
+ private:
+  std::vector<std::unique_ptr<rtc::TaskQueue>> queues_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ReceivePipelineShards);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_RECEIVE_PIPELINE_SHARDS_H_
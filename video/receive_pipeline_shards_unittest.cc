@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/receive_pipeline_shards.h"
+
+#include <vector>
+
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(ReceivePipelineShardsTest, SameSsrcAlwaysMapsToSameQueue) {
+  ReceivePipelineShards shards(4);
+  EXPECT_EQ(4u, shards.num_shards());
+  for (uint32_t ssrc = 1000; ssrc < 1100; ++ssrc)
+    EXPECT_EQ(shards.QueueForSsrc(ssrc), shards.QueueForSsrc(ssrc));
+}
+
+TEST(ReceivePipelineShardsTest, SpreadsSsrcsOverAllQueues) {
+  ReceivePipelineShards shards(4);
+  std::vector<rtc::TaskQueue*> queues;
+  for (uint32_t ssrc = 1000; ssrc < 1004; ++ssrc)
+    queues.push_back(shards.QueueForSsrc(ssrc));
+  for (size_t i = 0; i < queues.size(); ++i) {
+    for (size_t j = i + 1; j < queues.size(); ++j)
+      EXPECT_NE(queues[i], queues[j]);
+  }
+}
+
+TEST(ReceivePipelineShardsTest, RunsTasksForOneSsrcInOrder) {
+  constexpr int kNumTasks = 100;
+  constexpr uint32_t kSsrc = 4711;
+  ReceivePipelineShards shards(2);
+  rtc::CriticalSection crit;
+  std::vector<int> order;
+  rtc::Event done(false, false);
+  for (int i = 0; i < kNumTasks; ++i) {
+    shards.QueueForSsrc(kSsrc)->PostTask([&, i]() {
+      rtc::CritScope lock(&crit);
+      order.push_back(i);
+      if (i == kNumTasks - 1)
+        done.Set();
+    });
+  }
+  ASSERT_TRUE(done.Wait(5000));
+  rtc::CritScope lock(&crit);
+  ASSERT_EQ(static_cast<size_t>(kNumTasks), order.size());
+  for (int i = 0; i < kNumTasks; ++i)
+    EXPECT_EQ(i, order[i]);
+}
+
+}  // namespace webrtc
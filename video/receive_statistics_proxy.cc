@@ -14,6 +14,7 @@
 #include <cmath>
 #include <utility>
 
+#include "modules/include/module_common_types_public.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -49,6 +50,9 @@ const int kHighVarianceThreshold = 2;
 // the clients.
 const int kMovingMaxWindowMs = 1000;
 
+// Smoothing factor, per decoded frame, of the QP quality score.
+const float kQpQualityFilterAlpha = 0.9f;
+
 // How large window we use to calculate the framerate/bitrate.
 const int kRateStatisticsWindowSizeMs = 1000;
 
@@ -77,6 +81,20 @@ std::string UmaSuffixForContentType(VideoContentType content_type) {
   return ss.str();
 }
 
+// Largest QP of the codec, or nullopt if the QP range of the codec is unknown.
+absl::optional<int> MaxQp(VideoCodecType codec_type) {
+  switch (codec_type) {
+    case kVideoCodecVP8:
+      return 127;
+    case kVideoCodecVP9:
+      return 255;
+    case kVideoCodecH264:
+      return 51;
+    default:
+      return absl::nullopt;
+  }
+}
+
 }  // namespace
 
 ReceiveStatisticsProxy::ReceiveStatisticsProxy(
@@ -108,6 +126,7 @@ ReceiveStatisticsProxy::ReceiveStatisticsProxy(
       total_byte_tracker_(100, 10u),  // bucket_interval_ms, bucket_count
       video_quality_observer_(
           new VideoQualityObserver(VideoContentType::UNSPECIFIED)),
+      qp_quality_filter_(kQpQualityFilterAlpha),
       interframe_delay_max_moving_(kMovingMaxWindowMs),
       freq_offset_counter_(clock, nullptr, kFreqOffsetProcessIntervalMs),
       first_report_block_time_ms_(-1),
@@ -246,6 +265,14 @@ void ReceiveStatisticsProxy::UpdateHistograms() {
     RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.DecodeTimeInMs", *decode_ms);
     log_stream << "WebRTC.Video.DecodeTimeInMs " << *decode_ms << '\n';
   }
+  absl::optional<int> receive_to_render_delay_ms =
+      receive_to_render_delay_counter_.Avg(kMinRequiredSamples);
+  if (receive_to_render_delay_ms) {
+    RTC_HISTOGRAM_COUNTS_10000("WebRTC.Video.ReceiveToRenderDelayInMs",
+                               *receive_to_render_delay_ms);
+    log_stream << "WebRTC.Video.ReceiveToRenderDelayInMs "
+               << *receive_to_render_delay_ms << '\n';
+  }
   absl::optional<int> jb_delay_ms =
       jitter_buffer_delay_counter_.Avg(kMinRequiredSamples);
   if (jb_delay_ms) {
@@ -725,6 +752,7 @@ void ReceiveStatisticsProxy::OnDecodedFrame(absl::optional<uint8_t> qp,
     // Reset the quality observer if content type is switched. This will
     // report stats for the previous part of the call.
     video_quality_observer_.reset(new VideoQualityObserver(content_type));
+    qp_quality_filter_.Reset(kQpQualityFilterAlpha);
   }
 
   video_quality_observer_->OnDecodedFrame(qp, width, height, now,
@@ -744,6 +772,13 @@ void ReceiveStatisticsProxy::OnDecodedFrame(absl::optional<uint8_t> qp,
     }
     *stats_.qp_sum += *qp;
     content_specific_stats->qp_counter.Add(*qp);
+    absl::optional<int> max_qp = MaxQp(last_codec_type_);
+    if (max_qp) {
+      float score = 100.0f * (1.0f - std::min<float>(*qp, *max_qp) / *max_qp);
+      qp_quality_filter_.Apply(1.0f, score);
+      stats_.qp_quality_score =
+          static_cast<int>(std::round(qp_quality_filter_.filtered()));
+    }
   } else if (stats_.qp_sum) {
     RTC_LOG(LS_WARNING)
         << "QP sum was already set and no QP was given for a frame.";
@@ -800,6 +835,39 @@ void ReceiveStatisticsProxy::OnRenderedFrame(const VideoFrame& frame) {
       content_specific_stats->e2e_delay_counter.Add(delay_ms);
     }
   }
+
+  // Frames are rendered in order, so receive times of older frames belong to
+  // frames that were dropped before rendering.
+  while (!frame_receive_times_ms_.empty() &&
+         IsNewerTimestamp(frame.timestamp(),
+                          frame_receive_times_ms_.front().first)) {
+    frame_receive_times_ms_.pop_front();
+  }
+  if (!frame_receive_times_ms_.empty() &&
+      frame_receive_times_ms_.front().first == frame.timestamp()) {
+    stats_.receive_to_render_delay_ms =
+        now_ms - frame_receive_times_ms_.front().second;
+    receive_to_render_delay_counter_.Add(stats_.receive_to_render_delay_ms);
+    frame_receive_times_ms_.pop_front();
+  }
+}
+
+void ReceiveStatisticsProxy::OnFrameReceived(uint32_t rtp_timestamp,
+                                             int64_t receive_time_ms) {
+  // Bounds the memory used if frames are never rendered.
+  static constexpr size_t kMaxFramesTracked = 300;
+  rtc::CritScope lock(&crit_);
+  // All spatial layers of a superframe share the timestamp and are rendered
+  // together once the last of them has been received.
+  if (!frame_receive_times_ms_.empty() &&
+      frame_receive_times_ms_.back().first == rtp_timestamp) {
+    frame_receive_times_ms_.back().second =
+        std::max(frame_receive_times_ms_.back().second, receive_time_ms);
+    return;
+  }
+  frame_receive_times_ms_.emplace_back(rtp_timestamp, receive_time_ms);
+  if (frame_receive_times_ms_.size() > kMaxFramesTracked)
+    frame_receive_times_ms_.pop_front();
 }
 
 void ReceiveStatisticsProxy::OnSyncOffsetUpdated(int64_t sync_offset_ms,
@@ -873,6 +941,13 @@ void ReceiveStatisticsProxy::OnPreDecode(VideoCodecType codec_type, int qp) {
   }
 }
 
+void ReceiveStatisticsProxy::OnDecodeCpuTimeMeasured(
+    int64_t decode_cpu_time_us) {
+  RTC_DCHECK_RUN_ON(&decode_thread_);
+  rtc::CritScope lock(&crit_);
+  stats_.total_decode_cpu_time_us += decode_cpu_time_us;
+}
+
 void ReceiveStatisticsProxy::OnStreamInactive() {
   // TODO(sprang): Figure out any other state that should be reset.
 
@@ -11,15 +11,18 @@
 #ifndef VIDEO_RECEIVE_STATISTICS_PROXY_H_
 #define VIDEO_RECEIVE_STATISTICS_PROXY_H_
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
 #include "call/video_receive_stream.h"
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "rtc_base/criticalsection.h"
+#include "rtc_base/numerics/exp_filter.h"
 #include "rtc_base/numerics/histogram_percentile_counter.h"
 #include "rtc_base/numerics/moving_max_counter.h"
 #include "rtc_base/numerics/sample_counter.h"
@@ -55,12 +58,16 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
                       int height,
                       VideoContentType content_type);
   void OnSyncOffsetUpdated(int64_t sync_offset_ms, double estimated_freq_khz);
+  // Records when the last packet of the frame with |rtp_timestamp| was
+  // received, for measuring its receive to render delay.
+  void OnFrameReceived(uint32_t rtp_timestamp, int64_t receive_time_ms);
   void OnRenderedFrame(const VideoFrame& frame);
   void OnIncomingPayloadType(int payload_type);
   void OnDecoderImplementationName(const char* implementation_name);
   void OnIncomingRate(unsigned int framerate, unsigned int bitrate_bps);
 
   void OnPreDecode(VideoCodecType codec_type, int qp);
+  void OnDecodeCpuTimeMeasured(int64_t decode_cpu_time_us);
 
   void OnUniqueFramesCounted(int num_unique_frames);
 
@@ -166,8 +173,14 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   rtc::SampleCounter target_delay_counter_ RTC_GUARDED_BY(crit_);
   rtc::SampleCounter current_delay_counter_ RTC_GUARDED_BY(crit_);
   rtc::SampleCounter delay_counter_ RTC_GUARDED_BY(crit_);
+  rtc::SampleCounter receive_to_render_delay_counter_ RTC_GUARDED_BY(crit_);
+  // Receive times of the frames not yet rendered, oldest first, as pairs of
+  // RTP timestamp and receive time.
+  std::deque<std::pair<uint32_t, int64_t>> frame_receive_times_ms_
+      RTC_GUARDED_BY(crit_);
   std::unique_ptr<VideoQualityObserver> video_quality_observer_
       RTC_GUARDED_BY(crit_);
+  rtc::ExpFilter qp_quality_filter_ RTC_GUARDED_BY(crit_);
   mutable rtc::MovingMaxCounter<int> interframe_delay_max_moving_
       RTC_GUARDED_BY(crit_);
   std::map<VideoContentType, ContentSpecificStats> content_specific_stats_
@@ -246,6 +246,23 @@ TEST_F(ReceiveStatisticsProxyTest, OnDecodedFrameWithoutQpResetsQpSum) {
   EXPECT_EQ(absl::nullopt, statistics_proxy_->GetStats().qp_sum);
 }
 
+TEST_F(ReceiveStatisticsProxyTest, OnDecodedFrameUpdatesQpQualityScore) {
+  EXPECT_EQ(absl::nullopt, statistics_proxy_->GetStats().qp_quality_score);
+  // The QP range of VP8 is 0..127.
+  statistics_proxy_->OnDecodedFrame(0u, kWidth, kHeight,
+                                    VideoContentType::UNSPECIFIED);
+  EXPECT_EQ(100, statistics_proxy_->GetStats().qp_quality_score);
+  // A frame of the worst quality lowers the score smoothly.
+  statistics_proxy_->OnDecodedFrame(127u, kWidth, kHeight,
+                                    VideoContentType::UNSPECIFIED);
+  EXPECT_EQ(90, statistics_proxy_->GetStats().qp_quality_score);
+  for (int i = 0; i < 100; ++i) {
+    statistics_proxy_->OnDecodedFrame(127u, kWidth, kHeight,
+                                      VideoContentType::UNSPECIFIED);
+  }
+  EXPECT_EQ(0, statistics_proxy_->GetStats().qp_quality_score);
+}
+
 TEST_F(ReceiveStatisticsProxyTest, OnRenderedFrameIncreasesFramesRendered) {
   EXPECT_EQ(0u, statistics_proxy_->GetStats().frames_rendered);
   webrtc::VideoFrame frame(webrtc::I420Buffer::Create(1, 1), 0, 0,
@@ -256,6 +273,32 @@ TEST_F(ReceiveStatisticsProxyTest, OnRenderedFrameIncreasesFramesRendered) {
   }
 }
 
+TEST_F(ReceiveStatisticsProxyTest, ReportsReceiveToRenderDelay) {
+  const uint32_t kRtpTimestamp = 90000;
+  const int64_t kDelayMs = 7;
+  EXPECT_EQ(-1, statistics_proxy_->GetStats().receive_to_render_delay_ms);
+
+  // The second frame is dropped before rendering.
+  statistics_proxy_->OnFrameReceived(kRtpTimestamp,
+                                     fake_clock_.TimeInMilliseconds());
+  statistics_proxy_->OnFrameReceived(kRtpTimestamp + 3000,
+                                     fake_clock_.TimeInMilliseconds());
+  fake_clock_.AdvanceTimeMilliseconds(kDelayMs);
+  statistics_proxy_->OnFrameReceived(kRtpTimestamp + 6000,
+                                     fake_clock_.TimeInMilliseconds());
+  fake_clock_.AdvanceTimeMilliseconds(kDelayMs);
+
+  webrtc::VideoFrame frame(webrtc::I420Buffer::Create(1, 1), kRtpTimestamp, 0,
+                           webrtc::kVideoRotation_0);
+  statistics_proxy_->OnRenderedFrame(frame);
+  EXPECT_EQ(2 * kDelayMs,
+            statistics_proxy_->GetStats().receive_to_render_delay_ms);
+
+  frame.set_timestamp(kRtpTimestamp + 6000);
+  statistics_proxy_->OnRenderedFrame(frame);
+  EXPECT_EQ(kDelayMs, statistics_proxy_->GetStats().receive_to_render_delay_ms);
+}
+
 TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsSsrc) {
   EXPECT_EQ(kRemoteSsrc, statistics_proxy_->GetStats().ssrc);
 }
@@ -174,6 +174,14 @@ static std::string Codec() {
   return static_cast<std::string>(FLAG_codec);
 }
 
+WEBRTC_DEFINE_bool(max_speed,
+                   false,
+                   "Deliver the packets as fast as possible instead of at "
+                   "the pace they were recorded, and print the throughput.");
+static bool MaxSpeed() {
+  return static_cast<bool>(FLAG_max_speed);
+}
+
 WEBRTC_DEFINE_bool(help, false, "Print this message.");
 }  // namespace flags
 
@@ -471,7 +479,9 @@ class RtpReplayer final {
   static void ReplayPackets(Call* call, test::RtpFileReader* rtp_reader) {
     int64_t replay_start_ms = -1;
     int num_packets = 0;
+    size_t num_bytes = 0;
     std::map<uint32_t, int> unknown_packets;
+    const int64_t start_us = rtc::TimeMicros();
     while (true) {
       int64_t now_ms = rtc::TimeMillis();
       if (replay_start_ms == -1) {
@@ -484,11 +494,12 @@ class RtpReplayer final {
       }
 
       int64_t deliver_in_ms = replay_start_ms + packet.time_ms - now_ms;
-      if (deliver_in_ms > 0) {
+      if (deliver_in_ms > 0 && !flags::MaxSpeed()) {
         SleepMs(deliver_in_ms);
       }
 
       ++num_packets;
+      num_bytes += packet.length;
       switch (call->Receiver()->DeliverPacket(
           webrtc::MediaType::VIDEO,
           rtc::CopyOnWriteBuffer(packet.data, packet.length),
@@ -518,6 +529,15 @@ class RtpReplayer final {
       }
     }
     fprintf(stderr, "num_packets: %d\n", num_packets);
+    if (flags::MaxSpeed()) {
+      const double elapsed_s = (rtc::TimeMicros() - start_us) / 1e6;
+      if (elapsed_s > 0) {
+        fprintf(stderr,
+                "Replayed %zu bytes in %.3f s: %.0f packets/s, %.1f Mbps\n",
+                num_bytes, elapsed_s, num_packets / elapsed_s,
+                num_bytes * 8 / elapsed_s / 1e6);
+      }
+    }
 
     for (std::map<uint32_t, int>::const_iterator it = unknown_packets.begin();
          it != unknown_packets.end(); ++it) {
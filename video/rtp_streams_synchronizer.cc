@@ -77,11 +77,9 @@ void RtpStreamsSynchronizer::Process() {
   }
   RTC_DCHECK(sync_.get());
 
-  absl::optional<Syncable::Info> audio_info = syncable_audio_->GetInfo();
-  if (!audio_info || !UpdateMeasurements(&audio_measurement_, *audio_info)) {
-    return;
-  }
-
+  // The video stream is checked first, so that the audio stream, whose info
+  // is read under the locks of its jitter buffer, is only queried when there
+  // is something to synchronize.
   int64_t last_video_receive_ms = video_measurement_.latest_receive_time_ms;
   absl::optional<Syncable::Info> video_info = syncable_video_->GetInfo();
   if (!video_info || !UpdateMeasurements(&video_measurement_, *video_info)) {
@@ -93,6 +91,11 @@ void RtpStreamsSynchronizer::Process() {
     return;
   }
 
+  absl::optional<Syncable::Info> audio_info = syncable_audio_->GetInfo();
+  if (!audio_info || !UpdateMeasurements(&audio_measurement_, *audio_info)) {
+    return;
+  }
+
   int relative_delay_ms;
   // Calculate how much later or earlier the audio stream is compared to video.
   if (!sync_->ComputeRelativeDelay(audio_measurement_, video_measurement_,
@@ -35,12 +35,14 @@
 #include "modules/video_coding/packet_buffer.h"
 #include "modules/video_coding/video_coding_impl.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/fallthrough.h"
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
+#include "video/receive_pipeline_shards.h"
 #include "video/receive_statistics_proxy.h"
 
 namespace webrtc {
@@ -50,6 +52,11 @@ namespace {
 //                 crbug.com/752886
 constexpr int kPacketBufferStartSize = 512;
 constexpr int kPacketBufferMaxSize = 2048;
+
+rtc::TaskQueue* GetPipelineQueue(uint32_t remote_ssrc) {
+  ReceivePipelineShards* shards = ReceivePipelineShards::GetIfEnabled();
+  return shards ? shards->QueueForSsrc(remote_ssrc) : nullptr;
+}
 }  // namespace
 
 std::unique_ptr<RtpRtcp> CreateRtpRtcpModule(
@@ -111,6 +118,7 @@ RtpVideoStreamReceiver::RtpVideoStreamReceiver(
                                     rtt_stats,
                                     receive_stats_proxy,
                                     packet_router)),
+      pipeline_queue_(GetPipelineQueue(config_.rtp.remote_ssrc)),
       complete_frame_callback_(complete_frame_callback),
       keyframe_request_sender_(keyframe_request_sender),
       has_received_frame_(false) {
@@ -178,6 +186,7 @@ RtpVideoStreamReceiver::RtpVideoStreamReceiver(
 
 RtpVideoStreamReceiver::~RtpVideoStreamReceiver() {
   RTC_DCHECK(secondary_sinks_.empty());
+  FlushPipeline();
 
   if (nack_module_) {
     process_thread_->DeRegisterModule(nack_module_.get());
@@ -231,8 +240,11 @@ int32_t RtpVideoStreamReceiver::OnReceivedPayloadData(
     const absl::optional<RtpGenericFrameDescriptor>& generic_descriptor,
     bool is_recovered) {
   WebRtcRTPHeader rtp_header_with_ntp = *rtp_header;
-  rtp_header_with_ntp.ntp_time_ms =
-      ntp_estimator_.Estimate(rtp_header->header.timestamp);
+  {
+    rtc::CritScope lock(&ntp_estimator_lock_);
+    rtp_header_with_ntp.ntp_time_ms =
+        ntp_estimator_.Estimate(rtp_header->header.timestamp);
+  }
 
   VCMPacket packet(payload_data, payload_size, rtp_header_with_ntp);
   if (nack_module_) {
@@ -347,7 +359,14 @@ void RtpVideoStreamReceiver::OnRtpPacket(const RtpPacketReceived& packet) {
     }
   }
 
-  ReceivePacket(packet);
+  if (pipeline_queue_) {
+    // The copy shares the packet buffer, so this doesn't copy the payload.
+    RtpPacketReceived pipeline_packet = packet;
+    pipeline_queue_->PostTask(
+        [this, pipeline_packet]() { ReceivePacket(pipeline_packet); });
+  } else {
+    ReceivePacket(packet);
+  }
 
   // Update receive statistics after ReceivePacket.
   // Receive statistics will be reset if the payload type changes (make sure
@@ -385,7 +404,7 @@ int32_t RtpVideoStreamReceiver::ResendPackets(const uint16_t* sequence_numbers,
 
 void RtpVideoStreamReceiver::OnReceivedFrame(
     std::unique_ptr<video_coding::RtpFrameObject> frame) {
-  RTC_DCHECK_RUN_ON(&network_tc_);
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&network_tc_);
   // Request a key frame as soon as possible.
   bool key_frame_requested = false;
   if (!has_received_frame_) {
@@ -558,7 +577,7 @@ void RtpVideoStreamReceiver::ReceivePacket(const RtpPacketReceived& packet) {
 
 void RtpVideoStreamReceiver::ParseAndHandleEncapsulatingHeader(
     const RtpPacketReceived& packet) {
-  RTC_DCHECK_CALLED_SEQUENTIALLY(&worker_task_checker_);
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&network_tc_);
   if (packet.PayloadType() == config_.rtp.red_payload_type &&
       packet.payload_size() > 0) {
     if (packet.payload()[0] == config_.rtp.ulpfec_payload_type) {
@@ -621,6 +640,7 @@ bool RtpVideoStreamReceiver::DeliverRtcp(const uint8_t* rtcp_packet,
       clock_->CurrentNtpInMilliseconds() - recieved_ntp.ToMs();
   // Don't use old SRs to estimate time.
   if (time_since_recieved <= 1) {
+    rtc::CritScope lock(&ntp_estimator_lock_);
     ntp_estimator_.UpdateRtcpTimestamp(rtt, ntp_secs, ntp_frac, rtp_timestamp);
   }
 
@@ -676,6 +696,17 @@ void RtpVideoStreamReceiver::StartReceive() {
 void RtpVideoStreamReceiver::StopReceive() {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&worker_task_checker_);
   receiving_ = false;
+  // Make sure no more frames are delivered once the stream is stopped.
+  FlushPipeline();
+}
+
+void RtpVideoStreamReceiver::FlushPipeline() {
+  if (!pipeline_queue_)
+    return;
+  RTC_DCHECK(!pipeline_queue_->IsCurrent());
+  rtc::Event done(false, false);
+  pipeline_queue_->PostTask([&done]() { done.Set(); });
+  done.Wait(rtc::Event::kForever);
 }
 
 void RtpVideoStreamReceiver::UpdateHistograms() {
@@ -39,8 +39,8 @@
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/sequenced_task_checker.h"
+#include "rtc_base/task_queue.h"
 #include "rtc_base/thread_annotations.h"
-#include "rtc_base/thread_checker.h"
 #include "video/buffered_frame_decryptor.h"
 
 namespace webrtc {
@@ -162,6 +162,8 @@ class RtpVideoStreamReceiver : public RecoveredPacketReceiver,
   // This function assumes that it's being called from only one thread.
   void ParseAndHandleEncapsulatingHeader(const RtpPacketReceived& packet);
   void NotifyReceiverOfEmptyPacket(uint16_t seq_num);
+  // Blocks until all packets posted to |pipeline_queue_| have been handled.
+  void FlushPipeline();
   void UpdateHistograms();
   bool IsRedEnabled() const;
   void InsertSpsPpsIntoTracker(uint8_t payload_type);
@@ -172,7 +174,10 @@ class RtpVideoStreamReceiver : public RecoveredPacketReceiver,
   PacketRouter* const packet_router_;
   ProcessThread* const process_thread_;
 
-  RemoteNtpTimeEstimator ntp_estimator_;
+  // Updated from RTCP on the worker thread and used by the receive pipeline,
+  // which may run on a different task queue.
+  rtc::CriticalSection ntp_estimator_lock_;
+  RemoteNtpTimeEstimator ntp_estimator_ RTC_GUARDED_BY(ntp_estimator_lock_);
 
   RtpHeaderExtensionMap rtp_header_extensions_;
   ReceiveStatistics* const rtp_receive_statistics_;
@@ -184,6 +189,10 @@ class RtpVideoStreamReceiver : public RecoveredPacketReceiver,
 
   const std::unique_ptr<RtpRtcp> rtp_rtcp_;
 
+  // If set, depacketization, frame assembly and reference finding for this
+  // stream run on this queue instead of on the thread calling OnRtpPacket.
+  rtc::TaskQueue* const pipeline_queue_;
+
   // Members for the new jitter buffer experiment.
   video_coding::OnCompleteFrameCallback* complete_frame_callback_;
   KeyFrameRequestSender* keyframe_request_sender_;
@@ -216,9 +225,9 @@ class RtpVideoStreamReceiver : public RecoveredPacketReceiver,
   absl::optional<int64_t> last_received_rtp_system_time_ms_
       RTC_GUARDED_BY(rtp_sources_lock_);
 
-  // Used to validate the buffered frame decryptor is always run on the correct
-  // thread.
-  rtc::ThreadChecker network_tc_;
+  // Used to validate that the receive pipeline, including the buffered frame
+  // decryptor, is always run on the correct thread or task queue.
+  rtc::SequencedTaskChecker network_tc_;
   // Handles incoming encrypted frames and forwards them to the
   // rtp_reference_finder if they are decryptable.
   std::unique_ptr<BufferedFrameDecryptor> buffered_frame_decryptor_
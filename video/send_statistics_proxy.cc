@@ -19,6 +19,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/mod_ops.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/strings/string_builder.h"
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
@@ -349,6 +350,45 @@ void SendStatisticsProxy::UmaSamplesContainer::UpdateHistograms(
                                encode_ms);
     log_stream << uma_prefix_ << "EncodeTimeInMs " << encode_ms << "\n";
   }
+  int capture_to_incoming_us =
+      capture_to_incoming_us_counter_.Avg(kMinRequiredMetricsSamples);
+  if (capture_to_incoming_us != -1) {
+    RTC_HISTOGRAMS_COUNTS_100000(
+        kIndex, uma_prefix_ + "FrameTimeline.CaptureToIncomingInUs",
+        capture_to_incoming_us);
+    log_stream << uma_prefix_ << "FrameTimeline.CaptureToIncomingInUs "
+               << capture_to_incoming_us << "\n";
+  }
+  int encoder_queue_us =
+      encoder_queue_us_counter_.Avg(kMinRequiredMetricsSamples);
+  if (encoder_queue_us != -1) {
+    RTC_HISTOGRAMS_COUNTS_100000(
+        kIndex, uma_prefix_ + "FrameTimeline.EncoderQueueInUs",
+        encoder_queue_us);
+    log_stream << uma_prefix_ << "FrameTimeline.EncoderQueueInUs "
+               << encoder_queue_us << "\n";
+  }
+  int pre_encode_us = pre_encode_us_counter_.Avg(kMinRequiredMetricsSamples);
+  if (pre_encode_us != -1) {
+    RTC_HISTOGRAMS_COUNTS_100000(
+        kIndex, uma_prefix_ + "FrameTimeline.PreEncodeInUs", pre_encode_us);
+    log_stream << uma_prefix_ << "FrameTimeline.PreEncodeInUs "
+               << pre_encode_us << "\n";
+  }
+  int encode_us = encode_us_counter_.Avg(kMinRequiredMetricsSamples);
+  if (encode_us != -1) {
+    RTC_HISTOGRAMS_COUNTS_100000(
+        kIndex, uma_prefix_ + "FrameTimeline.EncodeInUs", encode_us);
+    log_stream << uma_prefix_ << "FrameTimeline.EncodeInUs " << encode_us
+               << "\n";
+  }
+  int packetize_us = packetize_us_counter_.Avg(kMinRequiredMetricsSamples);
+  if (packetize_us != -1) {
+    RTC_HISTOGRAMS_COUNTS_100000(
+        kIndex, uma_prefix_ + "FrameTimeline.PacketizeInUs", packetize_us);
+    log_stream << uma_prefix_ << "FrameTimeline.PacketizeInUs "
+               << packetize_us << "\n";
+  }
   int key_frames_permille =
       key_frame_counter_.Permille(kMinRequiredMetricsSamples);
   if (key_frames_permille != -1) {
@@ -680,6 +720,32 @@ void SendStatisticsProxy::OnEncodedFrameTimeMeasured(int encode_time_ms,
   stats_.encode_usage_percent = encode_usage_percent;
 }
 
+void SendStatisticsProxy::OnFrameEncodeTimeline(
+    const FrameEncodeTimeline& timeline) {
+  rtc::CritScope lock(&crit_);
+  uma_container_->capture_to_incoming_us_counter_.Add(
+      rtc::saturated_cast<int>(timeline.capture_to_incoming_us));
+  uma_container_->encoder_queue_us_counter_.Add(
+      rtc::saturated_cast<int>(timeline.encoder_queue_us));
+  uma_container_->pre_encode_us_counter_.Add(
+      rtc::saturated_cast<int>(timeline.pre_encode_us));
+  uma_container_->encode_us_counter_.Add(
+      rtc::saturated_cast<int>(timeline.encode_us));
+  uma_container_->packetize_us_counter_.Add(
+      rtc::saturated_cast<int>(timeline.packetize_us));
+}
+
+void SendStatisticsProxy::OnEncodeCpuTimeMeasured(int64_t encode_cpu_time_us) {
+  rtc::CritScope lock(&crit_);
+  stats_.total_encode_cpu_time_us += encode_cpu_time_us;
+}
+
+void SendStatisticsProxy::OnPacketizeCpuTimeMeasured(
+    int64_t packetize_cpu_time_us) {
+  rtc::CritScope lock(&crit_);
+  stats_.total_packetize_cpu_time_us += packetize_cpu_time_us;
+}
+
 void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
   int64_t now_ms = clock_->TimeInMilliseconds();
   rtc::CritScope lock(&crit_);
@@ -779,6 +845,13 @@ void SendStatisticsProxy::OnInactiveSsrc(uint32_t ssrc) {
   stats->width = 0;
 }
 
+void SendStatisticsProxy::OnKeyFrameRequestReceived(bool coalesced) {
+  rtc::CritScope lock(&crit_);
+  ++stats_.key_frame_requests_received;
+  if (coalesced)
+    ++stats_.key_frame_requests_coalesced;
+}
+
 void SendStatisticsProxy::OnSetEncoderTargetRate(uint32_t bitrate_bps) {
   rtc::CritScope lock(&crit_);
   if (uma_container_->target_rate_updates_.last_ms == -1 && bitrate_bps == 0)
@@ -928,6 +1001,8 @@ void SendStatisticsProxy::OnSendEncodedImage(
 
   uma_container_->key_frame_counter_.Add(encoded_image._frameType ==
                                          kVideoFrameKey);
+  if (encoded_image._frameType == kVideoFrameKey)
+    ++stats_.key_frames_encoded;
 
   if (encoded_image.qp_ != -1) {
     if (!stats_.qp_sum)
@@ -53,6 +53,10 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
   void OnSendEncodedImage(const EncodedImage& encoded_image,
                           const CodecSpecificInfo* codec_info) override;
 
+  void OnFrameEncodeTimeline(const FrameEncodeTimeline& timeline) override;
+  void OnEncodeCpuTimeMeasured(int64_t encode_cpu_time_us) override;
+  void OnPacketizeCpuTimeMeasured(int64_t packetize_cpu_time_us) override;
+
   void OnEncoderImplementationChanged(
       const std::string& implementation_name) override;
 
@@ -73,6 +77,10 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
   void OnSuspendChange(bool is_suspended) override;
   void OnInactiveSsrc(uint32_t ssrc);
 
+  // Called for each PLI/FIR request, |coalesced| if it did not result in a key
+  // frame request to the encoder.
+  void OnKeyFrameRequestReceived(bool coalesced);
+
   // Used to indicate change in content type, which may require a change in
   // how stats are collected.
   void OnEncoderReconfigured(const VideoEncoderConfig& encoder_config,
@@ -278,6 +286,12 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
     SampleCounter sent_width_counter_;
     SampleCounter sent_height_counter_;
     SampleCounter encode_time_counter_;
+    // Samples of FrameEncodeTimeline, in microseconds.
+    SampleCounter capture_to_incoming_us_counter_;
+    SampleCounter encoder_queue_us_counter_;
+    SampleCounter pre_encode_us_counter_;
+    SampleCounter encode_us_counter_;
+    SampleCounter packetize_us_counter_;
     BoolSampleCounter key_frame_counter_;
     BoolSampleCounter quality_limited_frame_counter_;
     SampleCounter quality_downscales_counter_;
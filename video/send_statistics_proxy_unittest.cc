@@ -194,6 +194,15 @@ TEST_F(SendStatisticsProxyTest, Suspended) {
   EXPECT_FALSE(statistics_proxy_->GetStats().suspended);
 }
 
+TEST_F(SendStatisticsProxyTest, AccumulatesEncodeAndPacketizeCpuTime) {
+  statistics_proxy_->OnEncodeCpuTimeMeasured(1500);
+  statistics_proxy_->OnEncodeCpuTimeMeasured(2500);
+  statistics_proxy_->OnPacketizeCpuTimeMeasured(300);
+  VideoSendStream::Stats stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(4000, stats.total_encode_cpu_time_us);
+  EXPECT_EQ(300, stats.total_packetize_cpu_time_us);
+}
+
 TEST_F(SendStatisticsProxyTest, FrameCounts) {
   FrameCountObserver* observer = statistics_proxy_.get();
   for (const auto& ssrc : config_.rtp.ssrcs) {
@@ -326,6 +335,25 @@ TEST_F(SendStatisticsProxyTest, OnSendEncodedImageIncreasesFramesEncoded) {
   }
 }
 
+TEST_F(SendStatisticsProxyTest, OnSendEncodedImageCountsKeyFrames) {
+  EncodedImage encoded_image;
+  CodecSpecificInfo codec_info;
+  encoded_image._frameType = kVideoFrameKey;
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  encoded_image._frameType = kVideoFrameDelta;
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  EXPECT_EQ(1u, statistics_proxy_->GetStats().key_frames_encoded);
+}
+
+TEST_F(SendStatisticsProxyTest, OnKeyFrameRequestReceived) {
+  statistics_proxy_->OnKeyFrameRequestReceived(false);
+  statistics_proxy_->OnKeyFrameRequestReceived(true);
+  statistics_proxy_->OnKeyFrameRequestReceived(true);
+  VideoSendStream::Stats stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(3u, stats.key_frame_requests_received);
+  EXPECT_EQ(2u, stats.key_frame_requests_coalesced);
+}
+
 TEST_F(SendStatisticsProxyTest, OnSendEncodedImageIncreasesQpSum) {
   EncodedImage encoded_image;
   CodecSpecificInfo codec_info;
@@ -1023,6 +1051,38 @@ TEST_F(SendStatisticsProxyTest, InputResolutionHistogramsAreUpdated) {
   EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.InputHeightInPixels", kHeight));
 }
 
+TEST_F(SendStatisticsProxyTest, FrameEncodeTimelineHistogramsAreUpdated) {
+  VideoStreamEncoderObserver::FrameEncodeTimeline timeline;
+  timeline.capture_to_incoming_us = 100;
+  timeline.encoder_queue_us = 200;
+  timeline.pre_encode_us = 300;
+  timeline.encode_us = 4000;
+  timeline.packetize_us = 500;
+  for (int i = 0; i < SendStatisticsProxy::kMinRequiredMetricsSamples; ++i)
+    statistics_proxy_->OnFrameEncodeTimeline(timeline);
+
+  statistics_proxy_.reset();
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.Video.FrameTimeline.CaptureToIncomingInUs", 100));
+  EXPECT_EQ(
+      1, metrics::NumEvents("WebRTC.Video.FrameTimeline.EncoderQueueInUs", 200));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.FrameTimeline.PreEncodeInUs", 300));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.FrameTimeline.EncodeInUs", 4000));
+  EXPECT_EQ(1,
+            metrics::NumEvents("WebRTC.Video.FrameTimeline.PacketizeInUs", 500));
+}
+
+TEST_F(SendStatisticsProxyTest, FrameEncodeTimelineHistogramsNeedMinSamples) {
+  VideoStreamEncoderObserver::FrameEncodeTimeline timeline;
+  for (int i = 0; i < SendStatisticsProxy::kMinRequiredMetricsSamples - 1; ++i)
+    statistics_proxy_->OnFrameEncodeTimeline(timeline);
+
+  statistics_proxy_.reset();
+  EXPECT_EQ(0, metrics::NumSamples("WebRTC.Video.FrameTimeline.EncodeInUs"));
+}
+
 TEST_F(SendStatisticsProxyTest, SentResolutionHistogramsAreUpdated) {
   const int64_t kMaxEncodedFrameWindowMs = 800;
   const int kFps = 5;
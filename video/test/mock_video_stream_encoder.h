@@ -23,11 +23,13 @@ class MockVideoStreamEncoder : public VideoStreamEncoderInterface {
   MOCK_METHOD2(SetSink, void(EncoderSink*, bool));
   MOCK_METHOD1(SetStartBitrate, void(int));
   MOCK_METHOD0(SendKeyFrame, void());
-  MOCK_METHOD3(OnBitrateUpdated, void(uint32_t, uint8_t, int64_t));
+  MOCK_METHOD1(SendKeyFrameForStream, void(size_t));
+  MOCK_METHOD4(OnBitrateUpdated, void(uint32_t, uint8_t, int64_t, double));
   MOCK_METHOD1(OnFrame, void(const VideoFrame&));
   MOCK_METHOD1(SetBitrateAllocationObserver,
                void(VideoBitrateAllocationObserver*));
   MOCK_METHOD0(Stop, void());
+  MOCK_METHOD1(UpdateActiveLayers, void(const std::vector<bool>&));
 
   MOCK_METHOD2(MockedConfigureEncoder, void(const VideoEncoderConfig&, size_t));
   // gtest generates implicit copy which is not allowed on VideoEncoderConfig,
@@ -12,6 +12,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <set>
 #include <string>
 #include <utility>
@@ -38,6 +39,8 @@
 #include "modules/video_coding/timing.h"
 #include "modules/video_coding/utility/vp8_header_parser.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/platform_file.h"
@@ -53,6 +56,18 @@
 namespace webrtc {
 
 namespace {
+constexpr int kMaxDecodeAheadMs = 500;
+
+// Returns how far ahead of their decode time frames may be handed to the
+// decoder, as configured by the field trial
+// "WebRTC-Video-PipelinedDecode/decode_ahead_ms:N/". Zero means disabled.
+int GetDecodeAheadMs() {
+  FieldTrialParameter<int> decode_ahead_ms("decode_ahead_ms", 0);
+  ParseFieldTrial({&decode_ahead_ms},
+                  field_trial::FindFullName("WebRTC-Video-PipelinedDecode"));
+  return std::max(0, std::min(decode_ahead_ms.Get(), kMaxDecodeAheadMs));
+}
+
 VideoCodec CreateDecoderVideoCodec(const VideoReceiveStream::Decoder& decoder) {
   VideoCodec codec;
   memset(&codec, 0, sizeof(codec));
@@ -183,6 +198,21 @@ VideoReceiveStream::VideoReceiveStream(
   frame_buffer_.reset(new video_coding::FrameBuffer(
       clock_, jitter_estimator_.get(), timing_.get(), &stats_proxy_));
 
+  // In pipelined decode mode frames are passed to the decoder as soon as they
+  // are within the decode-ahead window, and IncomingVideoStream holds each
+  // decoded frame until its render time. Without prerenderer smoothing there
+  // is nothing to delay rendering, so the mode is not used.
+  const int decode_ahead_ms = GetDecodeAheadMs();
+  if (decode_ahead_ms > 0) {
+    if (config_.disable_prerenderer_smoothing) {
+      RTC_LOG(LS_WARNING) << "Pipelined decode requires prerenderer smoothing, "
+                             "ignoring decode ahead of "
+                          << decode_ahead_ms << " ms.";
+    } else {
+      frame_buffer_->SetDecodeAheadMs(decode_ahead_ms);
+    }
+  }
+
   process_thread_->RegisterModule(&rtp_stream_sync_, RTC_FROM_HERE);
 
   // Register with RtpStreamReceiverController.
@@ -329,6 +359,7 @@ void VideoReceiveStream::Stop() {
     // running.
     for (const Decoder& decoder : config_.decoders)
       video_receiver_.RegisterExternalDecoder(nullptr, decoder.payload_type);
+    paused_key_frame_.reset();
   }
 
   video_stream_decoder_.reset();
@@ -353,10 +384,9 @@ void VideoReceiveStream::RemoveSecondarySink(
 void VideoReceiveStream::OnFrame(const VideoFrame& video_frame) {
   int64_t sync_offset_ms;
   double estimated_freq_khz;
-  // TODO(tommi): GetStreamSyncOffsetInMs grabs three locks.  One inside the
-  // function itself, another in GetChannel() and a third in
-  // GetPlayoutTimestamp.  Seems excessive.  Anyhow, I'm assuming the function
-  // succeeds most of the time, which leads to grabbing a fourth lock.
+  // TODO(tommi): GetStreamSyncOffsetInMs grabs a lock inside the function
+  // itself; the audio playout timestamp is read without one. I'm assuming the
+  // function succeeds most of the time, which leads to grabbing a second lock.
   if (rtp_stream_sync_.GetStreamSyncOffsetInMs(
           video_frame.timestamp(), video_frame.render_time_ms(),
           &sync_offset_ms, &estimated_freq_khz)) {
@@ -389,6 +419,7 @@ void VideoReceiveStream::OnCompleteFrame(
   }
   last_complete_frame_time_ms_ = time_now_ms;
 
+  stats_proxy_.OnFrameReceived(frame->Timestamp(), frame->ReceivedTime());
   int64_t last_continuous_pid = frame_buffer_->InsertFrame(std::move(frame));
   if (last_continuous_pid != -1)
     rtp_video_stream_receiver_.FrameContinuous(last_continuous_pid);
@@ -438,6 +469,18 @@ bool VideoReceiveStream::Decode() {
   static const int kMaxWaitForFrameMs = 3000;
   static const int kMaxWaitForKeyFrameMs = 200;
 
+  bool decoding_paused;
+  {
+    rtc::CritScope lock(&encoded_frame_sink_crit_);
+    decoding_paused = decoding_paused_;
+  }
+  if (!decoding_paused && paused_key_frame_) {
+    // Shows the latest key frame received while paused until decoding can
+    // continue at a new key frame.
+    video_receiver_.Decode(paused_key_frame_.get());
+    paused_key_frame_.reset();
+  }
+
   int wait_ms = keyframe_required_ ? kMaxWaitForKeyFrameMs : kMaxWaitForFrameMs;
   std::unique_ptr<video_coding::EncodedFrame> frame;
   // TODO(philipel): Call NextFrame with |keyframe_required| argument when
@@ -462,7 +505,39 @@ bool VideoReceiveStream::Decode() {
     }
     stats_proxy_.OnPreDecode(frame->CodecSpecific()->codecType, qp);
 
-    int decode_result = video_receiver_.Decode(frame.get());
+    bool decode_frame = true;
+    {
+      rtc::CritScope lock(&encoded_frame_sink_crit_);
+      if (encoded_frame_sink_) {
+        encoded_frame_sink_->OnEncodedFrame(*frame);
+        decode_frame = decode_forwarded_frames_;
+      }
+    }
+    if (decoding_paused) {
+      // The decoder misses the frames skipped while paused, so decoding
+      // continues at the next key frame.
+      decode_frame = false;
+      skip_to_key_frame_ = true;
+    } else if (skip_to_key_frame_) {
+      if (frame->is_keyframe()) {
+        skip_to_key_frame_ = false;
+      } else {
+        decode_frame = false;
+        if (last_keyframe_request_ms_ + kMaxWaitForKeyFrameMs < now_ms) {
+          RequestKeyFrame();
+          last_keyframe_request_ms_ = now_ms;
+        }
+      }
+    }
+
+    int decode_result = WEBRTC_VIDEO_CODEC_OK;
+    if (decode_frame) {
+      const int64_t decode_start_cpu_ns = rtc::GetThreadCpuTimeNanos();
+      decode_result = video_receiver_.Decode(frame.get());
+      stats_proxy_.OnDecodeCpuTimeMeasured(
+          (rtc::GetThreadCpuTimeNanos() - decode_start_cpu_ns) /
+          rtc::kNumNanosecsPerMicrosec);
+    }
     if (decode_result == WEBRTC_VIDEO_CODEC_OK ||
         decode_result == WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME) {
       keyframe_required_ = false;
@@ -479,6 +554,9 @@ bool VideoReceiveStream::Decode() {
       RequestKeyFrame();
       last_keyframe_request_ms_ = now_ms;
     }
+
+    if (decoding_paused && frame->is_keyframe())
+      paused_key_frame_ = std::move(frame);
   } else {
     RTC_DCHECK_EQ(res, video_coding::FrameBuffer::ReturnReason::kTimeout);
     int64_t now_ms = clock_->TimeInMilliseconds();
@@ -499,7 +577,7 @@ bool VideoReceiveStream::Decode() {
         last_keyframe_packet_ms &&
         now_ms - *last_keyframe_packet_ms < kMaxWaitForKeyFrameMs;
 
-    if (stream_is_active && !receiving_keyframe) {
+    if (stream_is_active && !receiving_keyframe && !decoding_paused) {
       RTC_LOG(LS_WARNING) << "No decodable frame in " << wait_ms
                           << " ms, requesting keyframe.";
       RequestKeyFrame();
@@ -512,5 +590,19 @@ std::vector<webrtc::RtpSource> VideoReceiveStream::GetSources() const {
   return rtp_video_stream_receiver_.GetSources();
 }
 
+void VideoReceiveStream::SetEncodedFrameSink(EncodedFrameSinkInterface* sink,
+                                             bool decode_frames) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&worker_sequence_checker_);
+  rtc::CritScope lock(&encoded_frame_sink_crit_);
+  encoded_frame_sink_ = sink;
+  decode_forwarded_frames_ = !sink || decode_frames;
+}
+
+void VideoReceiveStream::SetDecodingPaused(bool paused) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&worker_sequence_checker_);
+  rtc::CritScope lock(&encoded_frame_sink_crit_);
+  decoding_paused_ = paused;
+}
+
 }  // namespace internal
 }  // namespace webrtc
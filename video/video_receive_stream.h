@@ -14,12 +14,14 @@
 #include <memory>
 #include <vector>
 
+#include "api/video/encoded_frame_sink_interface.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "call/syncable.h"
 #include "call/video_receive_stream.h"
 #include "modules/rtp_rtcp/include/flexfec_receiver.h"
 #include "modules/video_coding/frame_buffer2.h"
 #include "modules/video_coding/video_coding_impl.h"
+#include "rtc_base/criticalsection.h"
 #include "rtc_base/sequenced_task_checker.h"
 #include "system_wrappers/include/clock.h"
 #include "video/receive_statistics_proxy.h"
@@ -97,6 +99,10 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
 
   std::vector<webrtc::RtpSource> GetSources() const override;
 
+  void SetEncodedFrameSink(EncodedFrameSinkInterface* sink,
+                           bool decode_frames) override;
+  void SetDecodingPaused(bool paused) override;
+
  private:
   static void DecodeThreadFunction(void* ptr);
   bool Decode();
@@ -147,6 +153,20 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
 
   int64_t last_keyframe_request_ms_ = 0;
   int64_t last_complete_frame_time_ms_ = 0;
+
+  // Set when frames have been skipped while decoding was paused, after which
+  // only key frames are taken from the frame buffer until one is decoded.
+  bool skip_to_key_frame_ = false;
+  // The latest key frame received while decoding was paused.
+  std::unique_ptr<video_coding::EncodedFrame> paused_key_frame_;
+
+  // Set from the worker thread, used on the decode thread.
+  rtc::CriticalSection encoded_frame_sink_crit_;
+  EncodedFrameSinkInterface* encoded_frame_sink_
+      RTC_GUARDED_BY(encoded_frame_sink_crit_) = nullptr;
+  bool decode_forwarded_frames_ RTC_GUARDED_BY(encoded_frame_sink_crit_) =
+      true;
+  bool decoding_paused_ RTC_GUARDED_BY(encoded_frame_sink_crit_) = false;
 };
 }  // namespace internal
 }  // namespace webrtc
@@ -130,6 +130,9 @@ void VideoSendStream::UpdateActiveSimulcastLayers(
     const std::vector<bool> active_layers) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   RTC_LOG(LS_INFO) << "VideoSendStream::UpdateActiveSimulcastLayers";
+  // Suspends the encoding of inactive layers, without reconfiguring the
+  // encoder.
+  video_stream_encoder_->UpdateActiveLayers(active_layers);
   VideoSendStreamImpl* send_stream = send_stream_.get();
   worker_queue_->PostTask([this, send_stream, active_layers] {
     send_stream->UpdateActiveSimulcastLayers(active_layers);
@@ -185,6 +188,20 @@ VideoSendStream::Stats VideoSendStream::GetStats() {
   return stats_proxy_.GetStats();
 }
 
+void VideoSendStream::InjectEncodedImage(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo& codec_specific_info,
+    const RTPFragmentationHeader* fragmentation) {
+  // Called on an arbitrary thread, like frames from the encoder.
+  send_stream_->InjectEncodedImage(encoded_image, codec_specific_info,
+                                   fragmentation);
+}
+
+void VideoSendStream::SetKeyFrameRequestSender(KeyFrameRequestSender* sender) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  send_stream_->SetKeyFrameRequestSender(sender);
+}
+
 absl::optional<float> VideoSendStream::GetPacingFactorOverride() const {
   return send_stream_->configured_pacing_factor_;
 }
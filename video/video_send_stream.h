@@ -82,6 +82,10 @@ class VideoSendStream : public webrtc::VideoSendStream {
 
   void ReconfigureVideoEncoder(VideoEncoderConfig) override;
   Stats GetStats() override;
+  void InjectEncodedImage(const EncodedImage& encoded_image,
+                          const CodecSpecificInfo& codec_specific_info,
+                          const RTPFragmentationHeader* fragmentation) override;
+  void SetKeyFrameRequestSender(KeyFrameRequestSender* sender) override;
 
   void StopPermanentlyAndGetRtpStates(RtpStateMap* rtp_state_map,
                                       RtpPayloadStateMap* payload_state_map);
@@ -21,6 +21,7 @@
 #include "call/rtp_transport_controller_send_interface.h"
 #include "call/video_send_stream.h"
 #include "common_types.h"  // NOLINT(build/include)
+#include "common_video/h264/h264_common.h"
 #include "modules/pacing/paced_sender.h"
 #include "rtc_base/atomicops.h"
 #include "rtc_base/checks.h"
@@ -265,7 +266,9 @@ VideoSendStreamImpl::VideoSendStreamImpl(
       video_stream_encoder_(video_stream_encoder),
       encoder_feedback_(Clock::GetRealTimeClock(),
                         config_->rtp.ssrcs,
-                        video_stream_encoder),
+                        video_stream_encoder,
+                        call_stats,
+                        stats_proxy),
       bandwidth_observer_(transport->GetBandwidthObserver()),
       rtp_video_sender_(transport_->CreateRtpVideoSender(
           suspended_ssrcs,
@@ -440,7 +443,7 @@ void VideoSendStreamImpl::StopVideoSendStream() {
     check_encoder_activity_task_->Stop();
     check_encoder_activity_task_ = nullptr;
   }
-  video_stream_encoder_->OnBitrateUpdated(0, 0, 0);
+  video_stream_encoder_->OnBitrateUpdated(0, 0, 0, 0);
   stats_proxy_->OnSetEncoderTargetRate(0);
 }
 
@@ -623,6 +626,41 @@ EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImage(
   return result;
 }
 
+void VideoSendStreamImpl::InjectEncodedImage(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo& codec_specific_info,
+    const RTPFragmentationHeader* fragmentation) {
+  // The H264 packetizer needs the NALU boundaries, which the encoder normally
+  // provides. Forwarded frames are in Annex B format, so recover them from
+  // the start codes.
+  RTPFragmentationHeader h264_fragmentation;
+  if (!fragmentation && codec_specific_info.codecType == kVideoCodecH264) {
+    const std::vector<H264::NaluIndex> nalu_indices =
+        H264::FindNaluIndices(encoded_image._buffer, encoded_image._length);
+    if (nalu_indices.empty()) {
+      RTC_LOG(LS_WARNING) << "Dropping injected H264 frame without start code.";
+      return;
+    }
+    h264_fragmentation.VerifyAndAllocateFragmentationHeader(
+        nalu_indices.size());
+    for (size_t i = 0; i < nalu_indices.size(); ++i) {
+      h264_fragmentation.fragmentationOffset[i] =
+          nalu_indices[i].payload_start_offset;
+      h264_fragmentation.fragmentationLength[i] = nalu_indices[i].payload_size;
+      h264_fragmentation.fragmentationPlType[i] = 0;
+      h264_fragmentation.fragmentationTimeDiff[i] = 0;
+    }
+    fragmentation = &h264_fragmentation;
+  }
+  stats_proxy_->OnSendEncodedImage(encoded_image, &codec_specific_info);
+  OnEncodedImage(encoded_image, &codec_specific_info, fragmentation);
+}
+
+void VideoSendStreamImpl::SetKeyFrameRequestSender(
+    KeyFrameRequestSender* sender) {
+  encoder_feedback_.SetKeyFrameRequestSender(sender);
+}
+
 std::map<uint32_t, RtpState> VideoSendStreamImpl::GetRtpStates() const {
   return rtp_video_sender_->GetRtpStates();
 }
@@ -647,7 +685,7 @@ uint32_t VideoSendStreamImpl::OnBitrateUpdated(BitrateAllocationUpdate update) {
   video_stream_encoder_->OnBitrateUpdated(
       encoder_target_rate_bps_,
       rtc::dchecked_cast<uint8_t>(update.packet_loss_ratio * 256),
-      update.round_trip_time.ms());
+      update.round_trip_time.ms(), update.cwnd_reduce_ratio);
   stats_proxy_->OnSetEncoderTargetRate(encoder_target_rate_bps_);
   return rtp_video_sender_->GetProtectionBitrateBps();
 }
@@ -103,6 +103,13 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
 
   std::map<uint32_t, RtpPayloadState> GetRtpPayloadStates() const;
 
+  // Sends an already encoded frame as if it had been produced by the encoder.
+  // May be called on any thread.
+  void InjectEncodedImage(const EncodedImage& encoded_image,
+                          const CodecSpecificInfo& codec_specific_info,
+                          const RTPFragmentationHeader* fragmentation);
+  void SetKeyFrameRequestSender(KeyFrameRequestSender* sender);
+
   absl::optional<float> configured_pacing_factor_;
 
  private:
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <limits>
 #include <numeric>
+#include <string>
 #include <utility>
 
 #include "api/video/encoded_image.h"
@@ -23,6 +24,7 @@
 #include "modules/video_coding/include/video_coding.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/experiments/quality_scaling_experiment.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
@@ -41,9 +43,22 @@ namespace {
 const int64_t kFrameLogIntervalMs = 60000;
 const int kMinFramerateFps = 2;
 
+// Interval over which input slot drops are counted before the framerate
+// requested from the source is adjusted.
+const int64_t kInputBackpressureWindowMs = 1000;
+
+// Number of consecutive unchanged screenshare frames that are still encoded,
+// giving the encoder a chance to refine quality, before further unchanged
+// frames are skipped.
+const int kStaticFramesBeforeSkip = 3;
+
 // Time to keep a single cached pending frame in paused state.
 const int64_t kPendingFrameTimeoutMs = 1000;
 
+// Max number of frames handed to the encoder for which encode timestamps are
+// kept while waiting for the encoded image callback.
+const size_t kMaxFrameTimestamps = 30;
+
 const char kInitialFramedropFieldTrial[] = "WebRTC-InitialFramedrop";
 
 // The maximum number of frames to drop at beginning of stream
@@ -110,6 +125,17 @@ CpuOveruseOptions GetCpuOveruseOptions(
   return options;
 }
 
+// Returns the region changed by either of two consecutive frames.
+absl::optional<VideoFrame::UpdateRect> UnionUpdateRects(
+    const absl::optional<VideoFrame::UpdateRect>& first,
+    const absl::optional<VideoFrame::UpdateRect>& second) {
+  if (!first || !second)
+    return absl::nullopt;
+  VideoFrame::UpdateRect rect = *first;
+  rect.Union(*second);
+  return rect;
+}
+
 }  //  namespace
 
 // VideoSourceProxy is responsible ensuring thread safety between calls to
@@ -172,6 +198,22 @@ class VideoStreamEncoder::VideoSourceProxy {
     }
   }
 
+  // Caps the framerate requested from the source, independently of the
+  // adaptation state, or removes the cap if |fps| is unset.
+  void SetInputFramerateLimit(absl::optional<int> fps) {
+    // Called on the encoder task queue.
+    rtc::CritScope lock(&crit_);
+    if (fps == input_framerate_limit_)
+      return;
+    RTC_LOG(LS_INFO) << "Set input framerate limit: "
+                     << (fps ? std::to_string(*fps) : "none");
+    input_framerate_limit_ = fps;
+    if (source_) {
+      source_->AddOrUpdateSink(video_stream_encoder_,
+                               GetActiveSinkWantsInternal());
+    }
+  }
+
   rtc::VideoSinkWants GetActiveSinkWants() {
     rtc::CritScope lock(&crit_);
     return GetActiveSinkWantsInternal();
@@ -329,6 +371,10 @@ class VideoStreamEncoder::VideoSourceProxy {
     }
     // Limit to configured max framerate.
     wants.max_framerate_fps = std::min(max_framerate_, wants.max_framerate_fps);
+    if (input_framerate_limit_) {
+      wants.max_framerate_fps =
+          std::min(*input_framerate_limit_, wants.max_framerate_fps);
+    }
     return wants;
   }
 
@@ -339,6 +385,7 @@ class VideoStreamEncoder::VideoSourceProxy {
   DegradationPreference degradation_preference_ RTC_GUARDED_BY(&crit_);
   rtc::VideoSourceInterface<VideoFrame>* source_ RTC_GUARDED_BY(&crit_);
   int max_framerate_ RTC_GUARDED_BY(&crit_);
+  absl::optional<int> input_framerate_limit_ RTC_GUARDED_BY(&crit_);
 
   RTC_DISALLOW_COPY_AND_ASSIGN(VideoSourceProxy);
 };
@@ -371,7 +418,14 @@ VideoStreamEncoder::VideoStreamEncoder(
       encoder_paused_and_dropped_frame_(false),
       clock_(Clock::GetRealTimeClock()),
       degradation_preference_(DegradationPreference::DISABLED),
-      posted_frames_waiting_for_encode_(0),
+      input_frames_replaced_(0),
+      input_backpressure_enabled_(webrtc::field_trial::IsEnabled(
+          "WebRTC-Video-EncoderInputBackpressure")),
+      input_window_start_ms_(-1),
+      input_window_frames_(0),
+      input_window_replaced_(0),
+      static_frames_encoded_(0),
+      pending_key_frame_request_(false),
       last_captured_timestamp_(0),
       delta_ntp_internal_ms_(clock_->CurrentNtpInMilliseconds() -
                              clock_->TimeInMilliseconds()),
@@ -379,6 +433,7 @@ VideoStreamEncoder::VideoStreamEncoder(
       captured_frame_count_(0),
       dropped_frame_count_(0),
       pending_frame_post_time_us_(0),
+      pending_frame_dequeue_time_us_(0),
       bitrate_observer_(nullptr),
       encoder_queue_("EncoderQueue") {
   RTC_DCHECK(encoder_stats_observer);
@@ -509,12 +564,68 @@ void VideoStreamEncoder::ConfigureEncoderOnTaskQueue(
   }
 }
 
-// TODO(bugs.webrtc.org/8807): Currently this always does a hard
-// reconfiguration, but this isn't always necessary. Add in logic to only update
-// the VideoBitrateAllocator and call OnEncoderConfigurationChanged with a
-// "soft" reconfiguration.
+void VideoStreamEncoder::UpdateActiveLayers(
+    const std::vector<bool>& active_layers) {
+  if (!encoder_queue_.IsCurrent()) {
+    encoder_queue_.PostTask(
+        [this, active_layers] { UpdateActiveLayers(active_layers); });
+    return;
+  }
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  bool changed = false;
+  std::vector<VideoStream>& layers = encoder_config_.simulcast_layers;
+  for (size_t i = 0; i < std::min(layers.size(), active_layers.size()); ++i) {
+    if (layers[i].active != active_layers[i]) {
+      layers[i].active = active_layers[i];
+      changed = true;
+    }
+  }
+  // A pending reconfiguration picks up the new flags.
+  if (!changed || pending_encoder_reconfiguration_ || !encoder_ ||
+      !last_frame_info_) {
+    return;
+  }
+  RTC_LOG(LS_INFO) << "Active simulcast layers changed.";
+  ReconfigureActiveLayers();
+}
+
+void VideoStreamEncoder::ReconfigureActiveLayers() {
+  std::vector<VideoStream> streams =
+      encoder_config_.video_stream_factory->CreateEncoderStreams(
+          last_frame_info_->width, last_frame_info_->height, encoder_config_);
+  VideoCodec codec;
+  if (!VideoCodecInitializer::SetupCodec(encoder_config_, streams, &codec)) {
+    RTC_LOG(LS_ERROR) << "Failed to create encoder configuration.";
+  }
+
+  // Inactive layers get no bitrate from the new allocator, which makes the
+  // encoder skip them.
+  rate_allocator_ =
+      settings_.bitrate_allocator_factory->CreateVideoBitrateAllocator(codec);
+  RTC_CHECK(rate_allocator_) << "Failed to create bitrate allocator.";
+  if (encoder_config_.codec_type == kVideoCodecVP9) {
+    streams[0].max_bitrate_bps = std::min<int>(
+        streams[0].max_bitrate_bps, SvcRateAllocator::GetMaxBitrateBps(codec));
+    streams[0].min_bitrate_bps = codec.spatialLayers[0].minBitrate * 1000;
+    streams[0].target_bitrate_bps =
+        SvcRateAllocator::GetPaddingBitrateBps(codec);
+  }
+  video_sender_.UpdateChannelParameters(rate_allocator_.get(),
+                                        bitrate_observer_);
+
+  encoder_stats_observer_->OnEncoderReconfigured(encoder_config_, streams);
+  sink_->OnEncoderConfigurationChanged(
+      std::move(streams), encoder_config_.min_transmit_bitrate_bps);
+}
+
+// TODO(bugs.webrtc.org/8807): Changes to the active layers only are applied by
+// ReconfigureActiveLayers(). Other changes may also not need a hard
+// reconfiguration.
 void VideoStreamEncoder::ReconfigureEncoder() {
   RTC_DCHECK(pending_encoder_reconfiguration_);
+  // A reconfigured encoder starts from scratch.
+  accumulated_update_rect_.reset();
+  static_frames_encoded_ = 0;
   std::vector<VideoStream> streams =
       encoder_config_.video_stream_factory->CreateEncoderStreams(
           last_frame_info_->width, last_frame_info_->height, encoder_config_);
@@ -711,37 +822,112 @@ void VideoStreamEncoder::OnFrame(const VideoFrame& video_frame) {
   last_captured_timestamp_ = incoming_frame.ntp_time_ms();
 
   int64_t post_time_us = rtc::TimeMicros();
-  ++posted_frames_waiting_for_encode_;
 
-  encoder_queue_.PostTask(
-      [this, incoming_frame, post_time_us, log_stats]() {
-        RTC_DCHECK_RUN_ON(&encoder_queue_);
-        encoder_stats_observer_->OnIncomingFrame(incoming_frame.width(),
-                                                 incoming_frame.height());
-        ++captured_frame_count_;
-        const int posted_frames_waiting_for_encode =
-            posted_frames_waiting_for_encode_.fetch_sub(1);
-        RTC_DCHECK_GT(posted_frames_waiting_for_encode, 0);
-        if (posted_frames_waiting_for_encode == 1) {
-          MaybeEncodeVideoFrame(incoming_frame, post_time_us);
-        } else {
-          // There is a newer frame in flight. Do not encode this frame.
-          RTC_LOG(LS_VERBOSE)
-              << "Incoming frame dropped due to that the encoder is blocked.";
-          ++dropped_frame_count_;
-          encoder_stats_observer_->OnFrameDropped(
-              VideoStreamEncoderObserver::DropReason::kEncoderQueue);
-        }
-        if (log_stats) {
-          RTC_LOG(LS_INFO) << "Number of frames: captured "
-                           << captured_frame_count_
-                           << ", dropped (due to encoder blocked) "
-                           << dropped_frame_count_ << ", interval_ms "
-                           << kFrameLogIntervalMs;
-          captured_frame_count_ = 0;
-          dropped_frame_count_ = 0;
-        }
-      });
+  TRACE_EVENT_ASYNC_STEP0("webrtc", "Video", incoming_frame.render_time_ms(),
+                          "EncoderQueue");
+  // The replaced frame is released outside the lock, as that may hand its
+  // buffer back to the capturer.
+  absl::optional<InputFrame> replaced_frame;
+  bool post_task;
+  {
+    rtc::CritScope lock(&input_frame_crit_);
+    post_task = !input_frame_;
+    if (input_frame_) {
+      // The encoder has not yet picked up the previous frame, and never will.
+      ++input_frames_replaced_;
+      log_stats |= input_frame_->log_stats;
+      incoming_frame.set_update_rect(UnionUpdateRects(
+          input_frame_->frame.update_rect(), incoming_frame.update_rect()));
+      replaced_frame = std::move(input_frame_);
+    }
+    input_frame_.emplace(InputFrame{incoming_frame, post_time_us, log_stats});
+  }
+  if (post_task)
+    encoder_queue_.PostTask([this] { EncodeInputFrame(); });
+}
+
+void VideoStreamEncoder::EncodeInputFrame() {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  absl::optional<InputFrame> input_frame;
+  int frames_replaced;
+  {
+    rtc::CritScope lock(&input_frame_crit_);
+    input_frame = std::move(input_frame_);
+    input_frame_.reset();
+    frames_replaced = input_frames_replaced_;
+    input_frames_replaced_ = 0;
+  }
+  RTC_DCHECK(input_frame);
+  const VideoFrame& incoming_frame = input_frame->frame;
+  const int64_t dequeue_time_us = rtc::TimeMicros();
+  TRACE_EVENT_ASYNC_STEP0("webrtc", "Video", incoming_frame.render_time_ms(),
+                          "PreEncode");
+  if (frames_replaced > 0) {
+    RTC_LOG(LS_VERBOSE) << frames_replaced
+                        << " incoming frames dropped due to that the encoder "
+                           "is blocked.";
+  }
+  for (int i = 0; i < frames_replaced; ++i) {
+    encoder_stats_observer_->OnIncomingFrame(incoming_frame.width(),
+                                             incoming_frame.height());
+    encoder_stats_observer_->OnFrameDropped(
+        VideoStreamEncoderObserver::DropReason::kEncoderQueue);
+  }
+  encoder_stats_observer_->OnIncomingFrame(incoming_frame.width(),
+                                           incoming_frame.height());
+  captured_frame_count_ += frames_replaced + 1;
+  dropped_frame_count_ += frames_replaced;
+  UpdateInputBackpressure(frames_replaced + 1, frames_replaced);
+
+  MaybeEncodeVideoFrame(incoming_frame, input_frame->post_time_us,
+                        dequeue_time_us);
+
+  if (input_frame->log_stats) {
+    RTC_LOG(LS_INFO) << "Number of frames: captured " << captured_frame_count_
+                     << ", dropped (due to encoder blocked) "
+                     << dropped_frame_count_ << ", interval_ms "
+                     << kFrameLogIntervalMs;
+    captured_frame_count_ = 0;
+    dropped_frame_count_ = 0;
+  }
+}
+
+void VideoStreamEncoder::UpdateInputBackpressure(int frames_received,
+                                                 int frames_replaced) {
+  if (!input_backpressure_enabled_)
+    return;
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  if (input_window_start_ms_ < 0)
+    input_window_start_ms_ = now_ms;
+  input_window_frames_ += frames_received;
+  input_window_replaced_ += frames_replaced;
+  const int64_t elapsed_ms = now_ms - input_window_start_ms_;
+  if (elapsed_ms < kInputBackpressureWindowMs)
+    return;
+
+  if (input_window_replaced_ * 3 > input_window_frames_) {
+    // More than a third of the captured frames never reached the encoder. Ask
+    // the source for no more than the rate the encoder actually drains.
+    const int drained_fps = static_cast<int>(
+        (input_window_frames_ - input_window_replaced_) *
+        rtc::kNumMillisecsPerSec / elapsed_ms);
+    const int limit = std::max(kMinFramerateFps, drained_fps);
+    if (!input_framerate_limit_ || limit < *input_framerate_limit_)
+      input_framerate_limit_ = limit;
+  } else if (input_window_replaced_ == 0 && input_framerate_limit_) {
+    // The encoder keeps up; probe upwards until the limit no longer applies.
+    const int limit = (*input_framerate_limit_ * 3) / 2 + 1;
+    if (max_framerate_ <= 0 || limit >= max_framerate_) {
+      input_framerate_limit_.reset();
+    } else {
+      input_framerate_limit_ = limit;
+    }
+  }
+  source_proxy_->SetInputFramerateLimit(input_framerate_limit_);
+
+  input_window_start_ms_ = now_ms;
+  input_window_frames_ = 0;
+  input_window_replaced_ = 0;
 }
 
 void VideoStreamEncoder::OnDiscardedFrame() {
@@ -777,9 +963,13 @@ void VideoStreamEncoder::TraceFrameDropEnd() {
 }
 
 void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
-                                               int64_t time_when_posted_us) {
+                                               int64_t time_when_posted_us,
+                                               int64_t time_when_dequeued_us) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
 
+  accumulated_update_rect_ =
+      UnionUpdateRects(accumulated_update_rect_, video_frame.update_rect());
+
   if (!last_frame_info_ || video_frame.width() != last_frame_info_->width ||
       video_frame.height() != last_frame_info_->height ||
       video_frame.is_texture() != last_frame_info_->is_texture) {
@@ -823,6 +1013,7 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
         VideoFrameBuffer::Type::kNative) {
       pending_frame_ = video_frame;
       pending_frame_post_time_us_ = time_when_posted_us;
+      pending_frame_dequeue_time_us_ = time_when_dequeued_us;
     } else {
       // Ensure that any previously stored frame is dropped.
       pending_frame_.reset();
@@ -839,6 +1030,7 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
         TraceFrameDropStart();
       pending_frame_ = video_frame;
       pending_frame_post_time_us_ = time_when_posted_us;
+      pending_frame_dequeue_time_us_ = time_when_dequeued_us;
     } else {
       // Ensure that any previously stored frame is dropped.
       pending_frame_.reset();
@@ -848,11 +1040,24 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
   }
 
   pending_frame_.reset();
-  EncodeVideoFrame(video_frame, time_when_posted_us);
+
+  if (encoder_config_.content_type ==
+          VideoEncoderConfig::ContentType::kScreen &&
+      accumulated_update_rect_ && accumulated_update_rect_->IsEmpty() &&
+      static_frames_encoded_ >= kStaticFramesBeforeSkip &&
+      !pending_key_frame_request_) {
+    // Nothing changed since a frame that the encoder has already had the
+    // chance to refine, so encoding this one would only cost CPU and bits.
+    TRACE_EVENT0("webrtc", "VideoStreamEncoder::SkipStaticFrame");
+    return;
+  }
+
+  EncodeVideoFrame(video_frame, time_when_posted_us, time_when_dequeued_us);
 }
 
 void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
-                                          int64_t time_when_posted_us) {
+                                          int64_t time_when_posted_us,
+                                          int64_t time_when_dequeued_us) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
   TraceFrameDropEnd();
 
@@ -879,6 +1084,24 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
     out_frame.set_ntp_time_ms(video_frame.ntp_time_ms());
   }
 
+  // Scaling spreads changes across pixels, so only an empty update rect can
+  // be carried over to a cropped frame.
+  if (out_frame.video_frame_buffer() != video_frame.video_frame_buffer() &&
+      !(accumulated_update_rect_ && accumulated_update_rect_->IsEmpty())) {
+    out_frame.set_update_rect(absl::nullopt);
+  } else {
+    out_frame.set_update_rect(accumulated_update_rect_);
+  }
+  if (accumulated_update_rect_ && accumulated_update_rect_->IsEmpty()) {
+    ++static_frames_encoded_;
+  } else {
+    static_frames_encoded_ = 0;
+  }
+  // Set before the frame is handed over, as a frame dropped by the encoder
+  // resets it from OnDroppedFrame().
+  accumulated_update_rect_ = VideoFrame::UpdateRect{0, 0, 0, 0};
+  pending_key_frame_request_ = false;
+
   TRACE_EVENT_ASYNC_STEP0("webrtc", "Video", video_frame.render_time_ms(),
                           "Encode");
 
@@ -892,7 +1115,24 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   }
   encoder_info_ = info;
 
+  {
+    rtc::CritScope lock(&frame_timestamps_crit_);
+    if (frame_timestamps_.size() >= kMaxFrameTimestamps)
+      frame_timestamps_.pop_front();
+    frame_timestamps_.push_back(FrameTimestamps{
+        out_frame.timestamp(), video_frame.timestamp_us(), time_when_posted_us,
+        time_when_dequeued_us, rtc::TimeMicros()});
+  }
+
+  const int64_t encode_start_cpu_ns = rtc::GetThreadCpuTimeNanos();
+  nested_packetize_cpu_ns_ = 0;
   video_sender_.AddVideoFrame(out_frame, nullptr, encoder_info_);
+  // Software encoders deliver the encoded image synchronously, subtract the
+  // packetization time already reported from OnEncodedImage().
+  const int64_t encode_cpu_ns = rtc::GetThreadCpuTimeNanos() -
+                                encode_start_cpu_ns - nested_packetize_cpu_ns_;
+  encoder_stats_observer_->OnEncodeCpuTimeMeasured(
+      std::max<int64_t>(0, encode_cpu_ns) / rtc::kNumNanosecsPerMicrosec);
 }
 
 void VideoStreamEncoder::SendKeyFrame() {
@@ -902,9 +1142,24 @@ void VideoStreamEncoder::SendKeyFrame() {
   }
   RTC_DCHECK_RUN_ON(&encoder_queue_);
   TRACE_EVENT0("webrtc", "OnKeyFrameRequest");
+  pending_key_frame_request_ = true;
   video_sender_.IntraFrameRequest(0);
 }
 
+void VideoStreamEncoder::SendKeyFrameForStream(size_t stream_index) {
+  if (!encoder_queue_.IsCurrent()) {
+    encoder_queue_.PostTask(
+        [this, stream_index] { SendKeyFrameForStream(stream_index); });
+    return;
+  }
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  TRACE_EVENT1("webrtc", "OnKeyFrameRequest", "stream_index", stream_index);
+  pending_key_frame_request_ = true;
+  // The number of streams may have changed since the request was sent.
+  if (video_sender_.IntraFrameRequest(stream_index) != VCM_OK)
+    video_sender_.IntraFrameRequest(0);
+}
+
 EncodedImageCallback::Result VideoStreamEncoder::OnEncodedImage(
     const EncodedImage& encoded_image,
     const CodecSpecificInfo* codec_specific_info,
@@ -915,11 +1170,22 @@ EncodedImageCallback::Result VideoStreamEncoder::OnEncodedImage(
   encoder_stats_observer_->OnSendEncodedImage(encoded_image,
                                               codec_specific_info);
 
+  TRACE_EVENT_ASYNC_STEP0("webrtc", "Video", encoded_image.capture_time_ms_,
+                          "Packetize");
+  int64_t sink_start_us = rtc::TimeMicros();
+  const int64_t sink_start_cpu_ns = rtc::GetThreadCpuTimeNanos();
   EncodedImageCallback::Result result =
       sink_->OnEncodedImage(encoded_image, codec_specific_info, fragmentation);
 
   int64_t time_sent_us = rtc::TimeMicros();
+  const int64_t packetize_cpu_ns =
+      rtc::GetThreadCpuTimeNanos() - sink_start_cpu_ns;
+  if (encoder_queue_.IsCurrent())
+    nested_packetize_cpu_ns_ += packetize_cpu_ns;
+  encoder_stats_observer_->OnPacketizeCpuTimeMeasured(
+      packetize_cpu_ns / rtc::kNumNanosecsPerMicrosec);
   uint32_t timestamp = encoded_image.Timestamp();
+  ReportFrameEncodeTimeline(timestamp, sink_start_us, time_sent_us);
   const int qp = encoded_image.qp_;
   int64_t capture_time_us =
       encoded_image.capture_time_ms_ * rtc::kNumMicrosecsPerMillisec;
@@ -946,6 +1212,17 @@ EncodedImageCallback::Result VideoStreamEncoder::OnEncodedImage(
 }
 
 void VideoStreamEncoder::OnDroppedFrame(DropReason reason) {
+  // The changes in the dropped frame never reached the encoder, so the next
+  // frame must be treated as fully updated.
+  if (encoder_queue_.IsCurrent()) {
+    RTC_DCHECK_RUN_ON(&encoder_queue_);
+    accumulated_update_rect_.reset();
+  } else {
+    encoder_queue_.PostTask([this] {
+      RTC_DCHECK_RUN_ON(&encoder_queue_);
+      accumulated_update_rect_.reset();
+    });
+  }
   switch (reason) {
     case DropReason::kDroppedByMediaOptimizations:
       encoder_stats_observer_->OnFrameDropped(
@@ -970,12 +1247,14 @@ void VideoStreamEncoder::OnDroppedFrame(DropReason reason) {
 
 void VideoStreamEncoder::OnBitrateUpdated(uint32_t bitrate_bps,
                                           uint8_t fraction_lost,
-                                          int64_t round_trip_time_ms) {
+                                          int64_t round_trip_time_ms,
+                                          double cwnd_reduce_ratio) {
   if (!encoder_queue_.IsCurrent()) {
-    encoder_queue_.PostTask(
-        [this, bitrate_bps, fraction_lost, round_trip_time_ms] {
-          OnBitrateUpdated(bitrate_bps, fraction_lost, round_trip_time_ms);
-        });
+    encoder_queue_.PostTask([this, bitrate_bps, fraction_lost,
+                             round_trip_time_ms, cwnd_reduce_ratio] {
+      OnBitrateUpdated(bitrate_bps, fraction_lost, round_trip_time_ms,
+                       cwnd_reduce_ratio);
+    });
     return;
   }
   RTC_DCHECK_RUN_ON(&encoder_queue_);
@@ -983,7 +1262,8 @@ void VideoStreamEncoder::OnBitrateUpdated(uint32_t bitrate_bps,
 
   RTC_LOG(LS_VERBOSE) << "OnBitrateUpdated, bitrate " << bitrate_bps
                       << " packet loss " << static_cast<int>(fraction_lost)
-                      << " rtt " << round_trip_time_ms;
+                      << " rtt " << round_trip_time_ms << " cwnd_reduce_ratio "
+                      << cwnd_reduce_ratio;
   // On significant changes to BWE at the start of the call,
   // enable frame drops to quickly react to jumps in available bandwidth.
   if (encoder_start_bitrate_bps_ != 0 &&
@@ -998,6 +1278,7 @@ void VideoStreamEncoder::OnBitrateUpdated(uint32_t bitrate_bps,
     has_seen_first_significant_bwe_change_ = true;
   }
 
+  video_sender_.SetCongestionWindowReduceRatio(cwnd_reduce_ratio);
   video_sender_.SetChannelParameters(bitrate_bps, rate_allocator_.get(),
                                      bitrate_observer_);
 
@@ -1016,11 +1297,36 @@ void VideoStreamEncoder::OnBitrateUpdated(uint32_t bitrate_bps,
       !DropDueToSize(pending_frame_->size())) {
     int64_t pending_time_us = rtc::TimeMicros() - pending_frame_post_time_us_;
     if (pending_time_us < kPendingFrameTimeoutMs * 1000)
-      EncodeVideoFrame(*pending_frame_, pending_frame_post_time_us_);
+      EncodeVideoFrame(*pending_frame_, pending_frame_post_time_us_,
+                       pending_frame_dequeue_time_us_);
     pending_frame_.reset();
   }
 }
 
+void VideoStreamEncoder::ReportFrameEncodeTimeline(uint32_t rtp_timestamp,
+                                                   int64_t sink_start_us,
+                                                   int64_t sink_end_us) {
+  VideoStreamEncoderObserver::FrameEncodeTimeline timeline;
+  {
+    rtc::CritScope lock(&frame_timestamps_crit_);
+    // Not erased when found; simulcast layers of one frame share the
+    // timestamp and are delivered separately.
+    auto it = std::find_if(frame_timestamps_.begin(), frame_timestamps_.end(),
+                           [rtp_timestamp](const FrameTimestamps& frame) {
+                             return frame.rtp_timestamp == rtp_timestamp;
+                           });
+    if (it == frame_timestamps_.end())
+      return;
+    timeline.capture_to_incoming_us =
+        std::max<int64_t>(0, it->post_time_us - it->capture_time_us);
+    timeline.encoder_queue_us = it->dequeue_time_us - it->post_time_us;
+    timeline.pre_encode_us = it->encode_start_time_us - it->dequeue_time_us;
+    timeline.encode_us = sink_start_us - it->encode_start_time_us;
+    timeline.packetize_us = sink_end_us - sink_start_us;
+  }
+  encoder_stats_observer_->OnFrameEncodeTimeline(timeline);
+}
+
 bool VideoStreamEncoder::DropDueToSize(uint32_t pixel_count) const {
   if (initial_framedrop_ < kMaxInitialFramedrop &&
       encoder_start_bitrate_bps_ > 0) {
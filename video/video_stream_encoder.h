@@ -11,7 +11,7 @@
 #ifndef VIDEO_VIDEO_STREAM_ENCODER_H_
 #define VIDEO_VIDEO_STREAM_ENCODER_H_
 
-#include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -66,16 +66,19 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
 
   void ConfigureEncoder(VideoEncoderConfig config,
                         size_t max_data_payload_length) override;
+  void UpdateActiveLayers(const std::vector<bool>& active_layers) override;
 
   // Permanently stop encoding. After this method has returned, it is
   // guaranteed that no encoded frames will be delivered to the sink.
   void Stop() override;
 
   void SendKeyFrame() override;
+  void SendKeyFrameForStream(size_t stream_index) override;
 
   void OnBitrateUpdated(uint32_t bitrate_bps,
                         uint8_t fraction_lost,
-                        int64_t round_trip_time_ms) override;
+                        int64_t round_trip_time_ms,
+                        double cwnd_reduce_ratio) override;
 
  protected:
   // Used for testing. For example the |ScalingObserverInterface| methods must
@@ -103,6 +106,9 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   void ConfigureEncoderOnTaskQueue(VideoEncoderConfig config,
                                    size_t max_data_payload_length);
   void ReconfigureEncoder() RTC_RUN_ON(&encoder_queue_);
+  // Updates the bitrate allocation and the sink for the active layers of
+  // |encoder_config_|, without reinitializing the encoder.
+  void ReconfigureActiveLayers() RTC_RUN_ON(&encoder_queue_);
 
   void ConfigureQualityScaler();
 
@@ -110,11 +116,26 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   void OnFrame(const VideoFrame& video_frame) override;
   void OnDiscardedFrame() override;
 
+  // Takes the frame waiting in |input_frame_| and passes it on for encoding.
+  void EncodeInputFrame();
+  // Limits the framerate requested from the source while the encoder can not
+  // keep up with it, given the frames received and replaced in the input slot
+  // since the last call.
+  void UpdateInputBackpressure(int frames_received, int frames_replaced)
+      RTC_RUN_ON(&encoder_queue_);
+
   void MaybeEncodeVideoFrame(const VideoFrame& frame,
-                             int64_t time_when_posted_in_ms);
+                             int64_t time_when_posted_us,
+                             int64_t time_when_dequeued_us);
 
   void EncodeVideoFrame(const VideoFrame& frame,
-                        int64_t time_when_posted_in_ms);
+                        int64_t time_when_posted_us,
+                        int64_t time_when_dequeued_us);
+  // Reports the per-stage encode timeline of the frame with |rtp_timestamp|,
+  // given the time spent in the encoded image sink.
+  void ReportFrameEncodeTimeline(uint32_t rtp_timestamp,
+                                 int64_t sink_start_us,
+                                 int64_t sink_end_us);
   // Indicates wether frame should be dropped because the pixel count is too
   // large for the current bitrate configuration.
   bool DropDueToSize(uint32_t pixel_count) const RTC_RUN_ON(&encoder_queue_);
@@ -248,7 +269,33 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
 
   rtc::RaceChecker incoming_frame_race_checker_
       RTC_GUARDED_BY(incoming_frame_race_checker_);
-  std::atomic<int> posted_frames_waiting_for_encode_;
+  // Latest-frame-wins slot between the capturer and |encoder_queue_|. A
+  // frame that arrives while the previous one is still waiting replaces it,
+  // so that at most one captured frame is ever queued for encoding.
+  struct InputFrame {
+    VideoFrame frame;
+    int64_t post_time_us;
+    bool log_stats;
+  };
+  rtc::CriticalSection input_frame_crit_;
+  absl::optional<InputFrame> input_frame_ RTC_GUARDED_BY(input_frame_crit_);
+  int input_frames_replaced_ RTC_GUARDED_BY(input_frame_crit_);
+
+  // State of the "WebRTC-Video-EncoderInputBackpressure" experiment, which
+  // caps the framerate requested from the source to what the encoder drains.
+  const bool input_backpressure_enabled_;
+  int64_t input_window_start_ms_ RTC_GUARDED_BY(&encoder_queue_);
+  int input_window_frames_ RTC_GUARDED_BY(&encoder_queue_);
+  int input_window_replaced_ RTC_GUARDED_BY(&encoder_queue_);
+  absl::optional<int> input_framerate_limit_ RTC_GUARDED_BY(&encoder_queue_);
+
+  // Region changed since the last frame handed to the encoder, including
+  // changes in frames dropped in between, or nullopt if unknown.
+  absl::optional<VideoFrame::UpdateRect> accumulated_update_rect_
+      RTC_GUARDED_BY(&encoder_queue_);
+  // Consecutive unchanged frames handed to the encoder.
+  int static_frames_encoded_ RTC_GUARDED_BY(&encoder_queue_);
+  bool pending_key_frame_request_ RTC_GUARDED_BY(&encoder_queue_);
   // Used to make sure incoming time stamp is increasing for every frame.
   int64_t last_captured_timestamp_ RTC_GUARDED_BY(incoming_frame_race_checker_);
   // Delta used for translating between NTP and internal timestamps.
@@ -260,6 +307,23 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   int dropped_frame_count_ RTC_GUARDED_BY(&encoder_queue_);
   absl::optional<VideoFrame> pending_frame_ RTC_GUARDED_BY(&encoder_queue_);
   int64_t pending_frame_post_time_us_ RTC_GUARDED_BY(&encoder_queue_);
+  int64_t pending_frame_dequeue_time_us_ RTC_GUARDED_BY(&encoder_queue_);
+
+  // Timestamps of frames handed to the encoder, used to report the encode
+  // timeline when the encoded image is delivered on the encoder's thread.
+  struct FrameTimestamps {
+    uint32_t rtp_timestamp;
+    int64_t capture_time_us;
+    int64_t post_time_us;
+    int64_t dequeue_time_us;
+    int64_t encode_start_time_us;
+  };
+  rtc::CriticalSection frame_timestamps_crit_;
+  std::deque<FrameTimestamps> frame_timestamps_
+      RTC_GUARDED_BY(frame_timestamps_crit_);
+  // Packetization CPU time spent within the current encode call, when the
+  // encoder delivers on |encoder_queue_|. Only accessed on |encoder_queue_|.
+  int64_t nested_packetize_cpu_ns_ = 0;
 
   VideoBitrateAllocationObserver* bitrate_observer_
       RTC_GUARDED_BY(&encoder_queue_);
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/video_stream_forwarder.h"
+
+#include "modules/video_coding/codecs/interface/common_constants.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+struct TemporalLayerInfo {
+  int temporal_idx;
+  // True if layer |temporal_idx| can be decoded from this frame on, given
+  // that all lower layers are.
+  bool switch_up_point;
+};
+
+TemporalLayerInfo GetTemporalLayerInfo(const CodecSpecificInfo& info) {
+  switch (info.codecType) {
+    case kVideoCodecVP8:
+      if (info.codecSpecific.VP8.temporalIdx == kNoTemporalIdx)
+        break;
+      return {info.codecSpecific.VP8.temporalIdx,
+              info.codecSpecific.VP8.layerSync};
+    case kVideoCodecVP9:
+      if (info.codecSpecific.VP9.temporal_idx == kNoTemporalIdx)
+        break;
+      return {info.codecSpecific.VP9.temporal_idx,
+              info.codecSpecific.VP9.temporal_up_switch};
+    default:
+      break;
+  }
+  return {0, true};
+}
+
+}  // namespace
+
+VideoStreamForwarder::VideoStreamForwarder(VideoReceiveStream* source,
+                                           VideoSendStream* destination,
+                                           bool decode_source_frames)
+    : source_(source), destination_(destination) {
+  RTC_DCHECK(source_);
+  RTC_DCHECK(destination_);
+  source_->SetEncodedFrameSink(this, decode_source_frames);
+  destination_->SetKeyFrameRequestSender(this);
+  // Don't wait for the next periodic key frame of the remote sender.
+  source_->RequestKeyFrame();
+}
+
+VideoStreamForwarder::~VideoStreamForwarder() {
+  destination_->SetKeyFrameRequestSender(nullptr);
+  source_->SetEncodedFrameSink(nullptr, true);
+}
+
+void VideoStreamForwarder::SetMaxTemporalLayer(
+    absl::optional<int> max_temporal_layer) {
+  rtc::CritScope lock(&crit_);
+  max_temporal_layer_ = max_temporal_layer;
+  if (max_temporal_layer_ &&
+      (!forwarded_temporal_layer_ ||
+       *forwarded_temporal_layer_ > *max_temporal_layer_)) {
+    forwarded_temporal_layer_ = max_temporal_layer_;
+  }
+}
+
+void VideoStreamForwarder::OnEncodedFrame(
+    const video_coding::EncodedFrame& frame) {
+  const CodecSpecificInfo& codec_specific_info = *frame.CodecSpecific();
+  {
+    rtc::CritScope lock(&crit_);
+    if (frame.is_keyframe()) {
+      waiting_for_key_frame_ = false;
+      forwarded_temporal_layer_ = max_temporal_layer_;
+    }
+    bool forward = !waiting_for_key_frame_;
+    if (forward && forwarded_temporal_layer_) {
+      const TemporalLayerInfo layer = GetTemporalLayerInfo(codec_specific_info);
+      if (layer.temporal_idx > *forwarded_temporal_layer_) {
+        // Switch up one layer at a time, and only where the decoder of the
+        // forwarded stream can follow.
+        const bool allowed = !max_temporal_layer_ ||
+                             layer.temporal_idx <= *max_temporal_layer_;
+        forward = allowed && layer.switch_up_point &&
+                  layer.temporal_idx == *forwarded_temporal_layer_ + 1;
+        if (forward)
+          forwarded_temporal_layer_ = layer.temporal_idx;
+      }
+    }
+    if (!forward) {
+      ++frames_dropped_;
+      return;
+    }
+    ++frames_forwarded_;
+  }
+
+  EncodedImage encoded_image = frame.EncodedImage();
+  if (codec_specific_info.codecType != kVideoCodecVP9) {
+    // For other codecs the spatial index selects the simulcast stream of the
+    // send stream, and forwarded frames always go to the first one.
+    encoded_image.SetSpatialIndex(absl::nullopt);
+  }
+  destination_->InjectEncodedImage(encoded_image, codec_specific_info,
+                                   nullptr);
+}
+
+void VideoStreamForwarder::RequestKeyFrame() {
+  source_->RequestKeyFrame();
+}
+
+int VideoStreamForwarder::frames_forwarded() const {
+  rtc::CritScope lock(&crit_);
+  return frames_forwarded_;
+}
+
+int VideoStreamForwarder::frames_dropped() const {
+  rtc::CritScope lock(&crit_);
+  return frames_dropped_;
+}
+
+}  // namespace webrtc
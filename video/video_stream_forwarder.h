@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_VIDEO_STREAM_FORWARDER_H_
+#define VIDEO_VIDEO_STREAM_FORWARDER_H_
+
+#include "absl/types/optional.h"
+#include "api/video/encoded_frame_sink_interface.h"
+#include "call/video_receive_stream.h"
+#include "call/video_send_stream.h"
+#include "modules/include/module_common_types.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Forwards the encoded frames of a video receive stream to a video send
+// stream, typically of another call, without decoding and re-encoding them.
+// Key frame requests from the receivers of the send stream are passed on to
+// the remote sender of the receive stream.
+//
+// Temporal layers above a configurable limit are dropped. Lowering the limit
+// takes effect immediately; after raising it, the higher layers are resumed
+// at the next layer sync or key frame, so that the forwarded stream stays
+// decodable without requesting a key frame.
+//
+// Must be created and destroyed on the worker thread of both streams, which
+// must outlive it.
+class VideoStreamForwarder : public EncodedFrameSinkInterface,
+                             public KeyFrameRequestSender {
+ public:
+  // If |decode_source_frames| is false, the receive stream stops decoding and
+  // rendering while the forwarder is attached.
+  VideoStreamForwarder(VideoReceiveStream* source,
+                       VideoSendStream* destination,
+                       bool decode_source_frames);
+  ~VideoStreamForwarder() override;
+
+  // Forward temporal layers up to and including |max_temporal_layer|. Unset
+  // forwards all layers. May be called on any thread.
+  void SetMaxTemporalLayer(absl::optional<int> max_temporal_layer);
+
+  // Implements EncodedFrameSinkInterface. Called on the decode thread of the
+  // receive stream.
+  void OnEncodedFrame(const video_coding::EncodedFrame& frame) override;
+
+  // Implements KeyFrameRequestSender. Called on a network thread of the send
+  // stream.
+  void RequestKeyFrame() override;
+
+  int frames_forwarded() const;
+  int frames_dropped() const;
+
+ private:
+  VideoReceiveStream* const source_;
+  VideoSendStream* const destination_;
+
+  rtc::CriticalSection crit_;
+  // Nothing is forwarded before the first key frame, since the receivers of
+  // the send stream could not decode it.
+  bool waiting_for_key_frame_ RTC_GUARDED_BY(crit_) = true;
+  absl::optional<int> max_temporal_layer_ RTC_GUARDED_BY(crit_);
+  // The highest temporal layer currently forwarded, which trails
+  // |max_temporal_layer_| until a switch up point is seen.
+  absl::optional<int> forwarded_temporal_layer_ RTC_GUARDED_BY(crit_);
+  int frames_forwarded_ RTC_GUARDED_BY(crit_) = 0;
+  int frames_dropped_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_VIDEO_STREAM_FORWARDER_H_
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/video_stream_forwarder.h"
+
+#include <vector>
+
+#include "media/engine/fakewebrtccall.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Invoke;
+using ::testing::_;
+
+class MockVideoSendStream : public VideoSendStream {
+ public:
+  MOCK_METHOD1(UpdateActiveSimulcastLayers, void(const std::vector<bool>));
+  MOCK_METHOD0(Start, void());
+  MOCK_METHOD0(Stop, void());
+  MOCK_METHOD2(SetSource,
+               void(rtc::VideoSourceInterface<VideoFrame>*,
+                    const DegradationPreference&));
+  MOCK_METHOD1(ReconfigureVideoEncoder, void(VideoEncoderConfig));
+  MOCK_METHOD0(GetStats, Stats());
+  MOCK_METHOD3(InjectEncodedImage,
+               void(const EncodedImage&,
+                    const CodecSpecificInfo&,
+                    const RTPFragmentationHeader*));
+  MOCK_METHOD1(SetKeyFrameRequestSender, void(KeyFrameRequestSender*));
+};
+
+class TestFrame : public video_coding::EncodedFrame {
+ public:
+  TestFrame(uint32_t timestamp, bool key_frame, int temporal_idx, bool sync) {
+    SetTimestamp(timestamp);
+    num_references = key_frame ? 0 : 1;
+    CodecSpecificInfo info;
+    info.codecType = kVideoCodecVP8;
+    info.codecSpecific.VP8.temporalIdx = temporal_idx;
+    info.codecSpecific.VP8.layerSync = sync;
+    SetCodecSpecific(&info);
+  }
+
+  int64_t ReceivedTime() const override { return 0; }
+  int64_t RenderTime() const override { return _renderTimeMs; }
+};
+
+}  // namespace
+
+class VideoStreamForwarderTest : public ::testing::Test {
+ protected:
+  VideoStreamForwarderTest()
+      : receive_stream_(VideoReceiveStream::Config(nullptr)) {
+    EXPECT_CALL(send_stream_, SetKeyFrameRequestSender(_))
+        .WillRepeatedly(Invoke([this](KeyFrameRequestSender* sender) {
+          key_frame_request_sender_ = sender;
+        }));
+    EXPECT_CALL(send_stream_, InjectEncodedImage(_, _, _))
+        .WillRepeatedly(Invoke([this](const EncodedImage& image,
+                                      const CodecSpecificInfo& info,
+                                      const RTPFragmentationHeader*) {
+          injected_timestamps_.push_back(image.Timestamp());
+        }));
+  }
+
+  void Deliver(VideoStreamForwarder* forwarder,
+               uint32_t timestamp,
+               bool key_frame,
+               int temporal_idx,
+               bool sync) {
+    forwarder->OnEncodedFrame(
+        TestFrame(timestamp, key_frame, temporal_idx, sync));
+  }
+
+  cricket::FakeVideoReceiveStream receive_stream_;
+  ::testing::NiceMock<MockVideoSendStream> send_stream_;
+  KeyFrameRequestSender* key_frame_request_sender_ = nullptr;
+  std::vector<uint32_t> injected_timestamps_;
+};
+
+TEST_F(VideoStreamForwarderTest, AttachesAndDetachesFromStreams) {
+  {
+    VideoStreamForwarder forwarder(&receive_stream_, &send_stream_, false);
+    EXPECT_EQ(&forwarder, receive_stream_.encoded_frame_sink());
+    EXPECT_FALSE(receive_stream_.decode_frames());
+    EXPECT_EQ(&forwarder, key_frame_request_sender_);
+    EXPECT_EQ(1, receive_stream_.num_key_frame_requests());
+
+    // Key frame requests from the send side go to the remote sender.
+    key_frame_request_sender_->RequestKeyFrame();
+    EXPECT_EQ(2, receive_stream_.num_key_frame_requests());
+  }
+  EXPECT_EQ(nullptr, receive_stream_.encoded_frame_sink());
+  EXPECT_TRUE(receive_stream_.decode_frames());
+  EXPECT_EQ(nullptr, key_frame_request_sender_);
+}
+
+TEST_F(VideoStreamForwarderTest, ForwardsFromFirstKeyFrame) {
+  VideoStreamForwarder forwarder(&receive_stream_, &send_stream_, true);
+  Deliver(&forwarder, 1000, false, 0, false);
+  Deliver(&forwarder, 2000, true, 0, false);
+  Deliver(&forwarder, 3000, false, 1, false);
+  EXPECT_THAT(injected_timestamps_, ElementsAre(2000, 3000));
+  EXPECT_EQ(2, forwarder.frames_forwarded());
+  EXPECT_EQ(1, forwarder.frames_dropped());
+}
+
+TEST_F(VideoStreamForwarderTest, SwitchesTemporalLayersAtSyncFrames) {
+  VideoStreamForwarder forwarder(&receive_stream_, &send_stream_, true);
+  forwarder.SetMaxTemporalLayer(0);
+  Deliver(&forwarder, 1000, true, 0, false);
+  Deliver(&forwarder, 2000, false, 1, true);
+  EXPECT_THAT(injected_timestamps_, ElementsAre(1000));
+
+  // Raising the limit waits for a sync frame of the next layer.
+  forwarder.SetMaxTemporalLayer(absl::nullopt);
+  Deliver(&forwarder, 3000, false, 0, false);
+  Deliver(&forwarder, 4000, false, 1, false);
+  Deliver(&forwarder, 5000, false, 2, true);
+  Deliver(&forwarder, 6000, false, 1, true);
+  Deliver(&forwarder, 7000, false, 2, true);
+  EXPECT_THAT(injected_timestamps_, ElementsAre(1000, 3000, 6000, 7000));
+
+  // Lowering the limit takes effect immediately.
+  forwarder.SetMaxTemporalLayer(1);
+  Deliver(&forwarder, 8000, false, 2, false);
+  Deliver(&forwarder, 9000, false, 1, false);
+  EXPECT_THAT(injected_timestamps_,
+              ElementsAre(1000, 3000, 6000, 7000, 9000));
+}
+
+}  // namespace webrtc